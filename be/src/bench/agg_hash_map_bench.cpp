@@ -0,0 +1,378 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <benchmark/benchmark.h>
+
+#include "bench.h"
+#include "column/column_helper.h"
+#include "column/fixed_length_column.h"
+#include "exec/aggregate/agg_hash_variant.h"
+#include "exec/aggregate/agg_profile.h"
+#include "exprs/agg/aggregate.h"
+#include "exprs/agg/aggregate_factory.h"
+#include "runtime/mem_pool.h"
+#include "runtime/runtime_state.h"
+#include "simd/simd.h"
+#include "testutil/function_utils.h"
+#include "util/runtime_profile.h"
+
+namespace starrocks {
+
+using AggType = AggHashMapVariant::Type;
+
+// The layouts of the group by keys, every layout leads to one hash map of each phase.
+enum GroupByLayout {
+    INT8 = 0,             // tinyint
+    INT16,                // smallint
+    INT32,                // sparse int
+    INT32_DENSE,          // int within a dense range
+    INT64,                // sparse bigint
+    INT64_DENSE,          // bigint within a dense range
+    INT128,               // largeint
+    STRING,               // varchar
+    NULL_INT32,           // nullable int
+    NULL_STRING,          // nullable varchar
+    SERIALIZED,           // varchar and int
+    FX4,                  // two smallints
+    FX8,                  // two ints
+    FX16,                 // two bigints
+    INT32_TWO_LEVEL,      // int by the two level hash map
+    SERIALIZED_TWO_LEVEL, // varchar and int by the two level hash map
+    NUM_LAYOUTS           // the number of the layouts
+};
+
+struct GroupByLayoutDesc {
+    // the hash map of the streaming pre-aggregation and the blocking aggregation
+    AggType phase1_type;
+    AggType phase2_type;
+    std::vector<LogicalType> key_types;
+    bool nullable = false;
+    // the size of the fixed size keys
+    int fixed_byte_size = -1;
+};
+
+static GroupByLayoutDesc layout_desc_of(GroupByLayout layout) {
+    switch (layout) {
+    case INT8:
+        return {AggType::phase1_int8, AggType::phase2_int8, {TYPE_TINYINT}};
+    case INT16:
+        return {AggType::phase1_int16, AggType::phase2_int16, {TYPE_SMALLINT}};
+    case INT32:
+        return {AggType::phase1_int32, AggType::phase2_int32, {TYPE_INT}};
+    case INT32_DENSE:
+        return {AggType::phase1_int32_dense, AggType::phase2_int32_dense, {TYPE_INT}};
+    case INT64:
+        return {AggType::phase1_int64, AggType::phase2_int64, {TYPE_BIGINT}};
+    case INT64_DENSE:
+        return {AggType::phase1_int64_dense, AggType::phase2_int64_dense, {TYPE_BIGINT}};
+    case INT128:
+        return {AggType::phase1_int128, AggType::phase2_int128, {TYPE_LARGEINT}};
+    case STRING:
+        return {AggType::phase1_string, AggType::phase2_string, {TYPE_VARCHAR}};
+    case NULL_INT32:
+        return {AggType::phase1_null_int32, AggType::phase2_null_int32, {TYPE_INT}, true};
+    case NULL_STRING:
+        return {AggType::phase1_null_string, AggType::phase2_null_string, {TYPE_VARCHAR}, true};
+    case SERIALIZED:
+        return {AggType::phase1_slice, AggType::phase2_slice, {TYPE_VARCHAR, TYPE_INT}};
+    case FX4:
+        return {AggType::phase1_slice_fx4, AggType::phase2_slice_fx4, {TYPE_SMALLINT, TYPE_SMALLINT}, false, 4};
+    case FX8:
+        return {AggType::phase1_slice_fx8, AggType::phase2_slice_fx8, {TYPE_INT, TYPE_INT}, false, 8};
+    case FX16:
+        return {AggType::phase1_slice_fx16, AggType::phase2_slice_fx16, {TYPE_BIGINT, TYPE_BIGINT}, false, 16};
+    case INT32_TWO_LEVEL:
+        return {AggType::phase1_int32_two_level, AggType::phase2_int32_two_level, {TYPE_INT}};
+    case SERIALIZED_TWO_LEVEL:
+        return {AggType::phase1_slice_two_level, AggType::phase2_slice_two_level, {TYPE_VARCHAR, TYPE_INT}};
+    default:
+        CHECK(false) << "unknown group by layout " << layout;
+        return {};
+    }
+}
+
+// The numbers of the groups to benchmark, the distinct keys of tinyint and smallint are limited.
+static std::vector<int64_t> cardinalities_of(GroupByLayout layout) {
+    switch (layout) {
+    case INT8:
+        return {200};
+    case INT16:
+        return {1 << 15};
+    default:
+        return {1 << 10, 1 << 16, 1 << 20};
+    }
+}
+
+// Bijective mixing, so the different ids are always mapped to the different keys.
+static uint32_t mix32(uint32_t id) {
+    return id * 0x9E3779B1U;
+}
+
+static uint64_t mix64(uint64_t id) {
+    return id * 0x9E3779B97F4A7C15ULL;
+}
+
+// Aggregate sum(v) group by the keys of |layout|, the keys are generated from the ids within [0, cardinality).
+//
+// The blocking aggregation inserts all the keys into the hash map of phase 2. The streaming pre-aggregation inserts
+// the keys into the hash map of phase 1 until it has kStreamingMaxGroups groups, then only updates the states of
+// the existing groups and passes the other rows through, like the selective pre-aggregation of
+// AggregateStreamingSinkOperator.
+class AggHashMapBench {
+public:
+    static constexpr size_t kNumChunks = 64;
+    static constexpr size_t kStreamingMaxGroups = 1 << 14;
+    // the key of a group is saved before its agg states, see AllocateState in exec/aggregator.h
+    static constexpr size_t kStateOffset = 16;
+
+    AggHashMapBench(GroupByLayout layout, int64_t cardinality, BenchKeyGenerator::Distribution distribution)
+            : _layout(layout), _desc(layout_desc_of(layout)) {
+        TQueryOptions query_options;
+        query_options.batch_size = config::vector_chunk_size;
+        _runtime_state = std::make_shared<RuntimeState>(TUniqueId(), query_options, TQueryGlobals(), nullptr);
+        _runtime_state->init_instance_mem_tracker();
+        _profile = std::make_shared<RuntimeProfile>("AggHashMapBench");
+        _agg_stat = std::make_unique<AggStatistics>(_profile.get());
+        _func = get_aggregate_function("sum", TYPE_BIGINT, TYPE_BIGINT, false);
+        _agg_states.resize(kTestChunkSize);
+        _state_size = (kStateOffset + _func->size() + kStateAlign - 1) / kStateAlign * kStateAlign;
+
+        BenchKeyGenerator generator(distribution, cardinality);
+        for (size_t i = 0; i < kNumChunks; i++) {
+            Columns key_columns;
+            for (LogicalType key_type : _desc.key_types) {
+                key_columns.emplace_back(
+                        ColumnHelper::create_column(TypeDescriptor::from_logical_type(key_type), _desc.nullable));
+                key_columns.back()->reserve(kTestChunkSize);
+            }
+            auto value_column = Int64Column::create();
+            for (size_t row = 0; row < kTestChunkSize; row++) {
+                const int64_t id = generator.next();
+                if (_desc.nullable && generator.next_real() < kNullRate) {
+                    key_columns[0]->append_nulls(1);
+                } else {
+                    _append_key(key_columns, id);
+                }
+                value_column->append(id);
+            }
+            _key_columns.emplace_back(std::move(key_columns));
+            _value_columns.emplace_back(std::move(value_column));
+        }
+    }
+
+    // Aggregate all the chunks by the hash map of phase 2, return the number of the groups.
+    size_t blocking_aggregate() {
+        _init_hash_map(_desc.phase2_type);
+        for (size_t i = 0; i < kNumChunks; i++) {
+            _build_hash_map(i);
+            _update_states(i);
+        }
+        return _hash_map.size();
+    }
+
+    // Pre-aggregate all the chunks by the hash map of phase 1, return the number of the rows passed through.
+    size_t streaming_aggregate() {
+        _init_hash_map(_desc.phase1_type);
+        size_t num_passthrough_rows = 0;
+        for (size_t i = 0; i < kNumChunks; i++) {
+            if (_hash_map.size() < kStreamingMaxGroups) {
+                _build_hash_map(i);
+                _update_states(i);
+                continue;
+            }
+            _hash_map.visit([&](auto& hash_map_with_key) {
+                hash_map_with_key->build_hash_map_with_selection(kTestChunkSize, _key_columns[i], _mem_pool.get(),
+                                                                 AllocateFunc{this}, &_agg_states,
+                                                                 &_streaming_selection);
+            });
+            const size_t num_not_founds = SIMD::count_nonzero(_streaming_selection);
+            if (num_not_founds < kTestChunkSize) {
+                const Column* value_column = _value_columns[i].get();
+                _func->update_batch_selectively(_ctx(), kTestChunkSize, kStateOffset, &value_column,
+                                                _agg_states.data(), _streaming_selection);
+            }
+            if (num_not_founds > 0) {
+                ColumnPtr serialized_column;
+                _func->convert_to_serialize_format(_ctx(), {_value_columns[i]}, kTestChunkSize, &serialized_column);
+                num_passthrough_rows += num_not_founds;
+            }
+        }
+        return num_passthrough_rows;
+    }
+
+private:
+    static constexpr double kNullRate = 0.1;
+    static constexpr size_t kStateAlign = 16;
+
+    FunctionContext* _ctx() { return _function_utils.get_fn_ctx(); }
+
+    void _init_hash_map(AggType type) {
+        // the old hash map is released before the keys in its mem pool
+        _hash_map.init(_runtime_state.get(), type, _agg_stat.get());
+        _mem_pool = std::make_unique<MemPool>();
+        _hash_map.visit([&](auto& hash_map_with_key) {
+            if constexpr (is_combined_fixed_size_key<std::decay_t<decltype(*hash_map_with_key)>>) {
+                hash_map_with_key->has_null_column = false;
+                hash_map_with_key->fixed_byte_size = _desc.fixed_byte_size;
+            }
+        });
+    }
+
+    // Allocate the agg states like AllocateState in exec/aggregator.h, the key of a group is saved before its agg states.
+    struct AllocateFunc {
+        template <class KeyType>
+        AggDataPtr operator()(const KeyType& key) const {
+            AggDataPtr agg_state = bench->_mem_pool->allocate_aligned(bench->_state_size, kStateAlign);
+            if constexpr (!std::is_same_v<KeyType, std::nullptr_t>) {
+                static_assert(sizeof(KeyType) <= kStateOffset);
+                *reinterpret_cast<KeyType*>(agg_state) = key;
+            }
+            bench->_func->create(bench->_ctx(), agg_state + kStateOffset);
+            return agg_state;
+        }
+
+        AggHashMapBench* bench;
+    };
+
+    void _build_hash_map(size_t chunk_index) {
+        _hash_map.visit([&](auto& hash_map_with_key) {
+            hash_map_with_key->build_hash_map(kTestChunkSize, _key_columns[chunk_index], _mem_pool.get(),
+                                              AllocateFunc{this}, &_agg_states);
+        });
+    }
+
+    void _update_states(size_t chunk_index) {
+        const Column* value_column = _value_columns[chunk_index].get();
+        _func->update_batch(_ctx(), kTestChunkSize, kStateOffset, &value_column, _agg_states.data());
+    }
+
+    void _append_key(const Columns& columns, int64_t id) const {
+        switch (_layout) {
+        case INT8:
+            columns[0]->append_datum(Datum(static_cast<int8_t>(id - 100)));
+            break;
+        case INT16:
+            columns[0]->append_datum(Datum(static_cast<int16_t>(id - (1 << 14))));
+            break;
+        case INT32:
+        case NULL_INT32:
+        case INT32_TWO_LEVEL:
+            columns[0]->append_datum(Datum(static_cast<int32_t>(mix32(id))));
+            break;
+        case INT32_DENSE:
+            columns[0]->append_datum(Datum(static_cast<int32_t>(id)));
+            break;
+        case INT64:
+            columns[0]->append_datum(Datum(static_cast<int64_t>(mix64(id))));
+            break;
+        case INT64_DENSE:
+            columns[0]->append_datum(Datum(id));
+            break;
+        case INT128:
+            columns[0]->append_datum(Datum((static_cast<int128_t>(mix64(id)) << 64) | id));
+            break;
+        case STRING:
+        case NULL_STRING: {
+            const std::string key = std::to_string(mix64(id));
+            columns[0]->append_datum(Datum(Slice(key)));
+            break;
+        }
+        case SERIALIZED:
+        case SERIALIZED_TWO_LEVEL: {
+            const std::string key = std::to_string(mix64(id));
+            columns[0]->append_datum(Datum(Slice(key)));
+            columns[1]->append_datum(Datum(static_cast<int32_t>(id)));
+            break;
+        }
+        case FX4:
+            columns[0]->append_datum(Datum(static_cast<int16_t>(id & 0x7FFF)));
+            columns[1]->append_datum(Datum(static_cast<int16_t>(id >> 15)));
+            break;
+        case FX8:
+            columns[0]->append_datum(Datum(static_cast<int32_t>(mix32(id))));
+            columns[1]->append_datum(Datum(static_cast<int32_t>(id)));
+            break;
+        case FX16:
+            columns[0]->append_datum(Datum(static_cast<int64_t>(mix64(id))));
+            columns[1]->append_datum(Datum(id));
+            break;
+        default:
+            CHECK(false) << "unknown group by layout " << _layout;
+        }
+    }
+
+    const GroupByLayout _layout;
+    const GroupByLayoutDesc _desc;
+    std::shared_ptr<RuntimeState> _runtime_state;
+    std::shared_ptr<RuntimeProfile> _profile;
+    std::unique_ptr<AggStatistics> _agg_stat;
+    FunctionUtils _function_utils;
+    const AggregateFunction* _func = nullptr;
+    size_t _state_size = 0;
+
+    std::vector<Columns> _key_columns;
+    std::vector<ColumnPtr> _value_columns;
+
+    std::unique_ptr<MemPool> _mem_pool;
+    AggHashMapVariant _hash_map;
+    Buffer<AggDataPtr> _agg_states;
+    std::vector<uint8_t> _streaming_selection;
+};
+
+// Run with the args {group by layout, cardinality, key distribution}.
+static void Benchmark_Agg_Blocking(benchmark::State& state) {
+    AggHashMapBench bench(static_cast<GroupByLayout>(state.range(0)), state.range(1),
+                          static_cast<BenchKeyGenerator::Distribution>(state.range(2)));
+    size_t num_groups = 0;
+    for (auto _ : state) {
+        num_groups = bench.blocking_aggregate();
+    }
+    state.SetItemsProcessed(state.iterations() * AggHashMapBench::kNumChunks * kTestChunkSize);
+    state.counters["groups"] = num_groups;
+}
+
+// Run with the args {group by layout, cardinality, key distribution}.
+static void Benchmark_Agg_Streaming(benchmark::State& state) {
+    AggHashMapBench bench(static_cast<GroupByLayout>(state.range(0)), state.range(1),
+                          static_cast<BenchKeyGenerator::Distribution>(state.range(2)));
+    size_t num_passthrough_rows = 0;
+    for (auto _ : state) {
+        num_passthrough_rows = bench.streaming_aggregate();
+    }
+    state.SetItemsProcessed(state.iterations() * AggHashMapBench::kNumChunks * kTestChunkSize);
+    state.counters["passthrough_rows"] = num_passthrough_rows;
+}
+
+static void AggArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"layout", "cardinality", "distribution"});
+    for (int64_t layout = 0; layout < NUM_LAYOUTS; layout++) {
+        for (int64_t cardinality : cardinalities_of(static_cast<GroupByLayout>(layout))) {
+            b->Args({layout, cardinality, BenchKeyGenerator::UNIFORM});
+        }
+    }
+    // the skewed keys
+    for (int64_t layout : {INT64, STRING, SERIALIZED}) {
+        for (int64_t cardinality : cardinalities_of(static_cast<GroupByLayout>(layout))) {
+            b->Args({layout, cardinality, BenchKeyGenerator::ZIPF});
+        }
+    }
+}
+
+BENCHMARK(Benchmark_Agg_Blocking)->Apply(AggArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK(Benchmark_Agg_Streaming)->Apply(AggArgs)->Unit(benchmark::kMillisecond);
+
+} // namespace starrocks
+
+BENCHMARK_MAIN();
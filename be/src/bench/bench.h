@@ -16,6 +16,8 @@
 #include <gtest/gtest.h>
 #include <testutil/assert.h>
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <numeric>
 #include <random>
@@ -29,6 +31,36 @@ namespace starrocks {
 
 inline int kTestChunkSize = 4096;
 
+// Generate the ids of the benchmark keys reproducibly, the same seed always generates the same ids.
+// The ids are within [0, cardinality), distributed uniformly or by the Zipf's law with s = 1, i.e. the
+// probability of the id k is about 1 / ((k + 1) * ln(cardinality + 1)), so the small ids are much hotter.
+class BenchKeyGenerator {
+public:
+    enum Distribution { UNIFORM = 0, ZIPF = 1 };
+
+    BenchKeyGenerator(Distribution distribution, int64_t cardinality, uint32_t seed = 0)
+            : _distribution(distribution), _cardinality(cardinality), _rng(seed), _uniform_int(0, cardinality - 1) {}
+
+    int64_t next() {
+        if (_distribution == ZIPF) {
+            // the inverse transform sampling of the continuous approximation
+            const double x = std::pow(static_cast<double>(_cardinality + 1), next_real());
+            return std::min<int64_t>(static_cast<int64_t>(x) - 1, _cardinality - 1);
+        }
+        return _uniform_int(_rng);
+    }
+
+    // A random real number within [0, 1).
+    double next_real() { return _uniform_real(_rng); }
+
+private:
+    const Distribution _distribution;
+    const int64_t _cardinality;
+    std::mt19937_64 _rng;
+    std::uniform_int_distribution<int64_t> _uniform_int;
+    std::uniform_real_distribution<double> _uniform_real{0, 1};
+};
+
 class Bench {
 public:
     static ColumnPtr create_series_column(const TypeDescriptor& type_desc, int num_rows, bool nullable = true) {
@@ -445,6 +445,23 @@ static void BM_fullsort_varchar_column_incr(benchmark::State& state) {
     do_bench(state, FullSort, TYPE_VARCHAR, state.range(0), state.range(1));
 }
 
+// The integer keys are sorted by the radix sort by default, compare it with pdqsort
+static void do_bench_pdqsort(benchmark::State& state, SortParameters params) {
+    const int64_t radix_sort_threshold = config::sort_radix_sort_threshold;
+    config::sort_radix_sort_threshold = 0;
+    do_bench(state, FullSort, TYPE_INT, state.range(0), state.range(1), params);
+    config::sort_radix_sort_threshold = radix_sort_threshold;
+}
+static void BM_fullsort_notnull_pdqsort(benchmark::State& state) {
+    do_bench_pdqsort(state, SortParameters());
+}
+static void BM_fullsort_nullable_pdqsort(benchmark::State& state) {
+    do_bench_pdqsort(state, SortParameters::with_nullable(true));
+}
+static void BM_fullsort_low_card_colinc_pdqsort(benchmark::State& state) {
+    do_bench_pdqsort(state, SortParameters::with_low_card(true));
+}
+
 // Low cardinality
 static void BM_fullsort_low_card_colinc(benchmark::State& state) {
     do_bench(state, FullSort, TYPE_INT, state.range(0), state.range(1), SortParameters::with_low_card(true));
@@ -517,10 +534,13 @@ static void CustomArgsLimit(benchmark::internal::Benchmark* b) {
 BENCHMARK(BM_fullsort_notnull)->Apply(CustomArgsFull);
 BENCHMARK(BM_fullsort_nullable)->Apply(CustomArgsFull);
 BENCHMARK(BM_fullsort_varchar_column_incr)->Apply(CustomArgsFull);
+BENCHMARK(BM_fullsort_notnull_pdqsort)->Apply(CustomArgsFull);
+BENCHMARK(BM_fullsort_nullable_pdqsort)->Apply(CustomArgsFull);
 
 // Low-Cardinality Sort
 BENCHMARK(BM_fullsort_low_card_colinc)->Apply(CustomArgsFull);
 BENCHMARK(BM_fullsort_low_card_nullable)->Apply(CustomArgsFull);
+BENCHMARK(BM_fullsort_low_card_colinc_pdqsort)->Apply(CustomArgsFull);
 
 // TopN sort
 BENCHMARK(BM_topn_limit_heapsort)->Apply(CustomArgsLimit);
@@ -0,0 +1,371 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+#include "bench.h"
+#include "column/chunk.h"
+#include "column/column_helper.h"
+#include "common/object_pool.h"
+#include "exec/join_hash_map.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+#include "util/runtime_profile.h"
+
+namespace starrocks {
+
+// The layouts of the join keys, every layout leads to one JoinHashMapType.
+enum KeyLayout {
+    KEY8 = 0,   // tinyint
+    KEY16,      // smallint
+    KEY32,      // sparse int
+    DENSE32,    // int within a dense range
+    KEY64,      // sparse bigint
+    DENSE64,    // bigint within a dense range
+    KEY128,     // largeint
+    KEYDOUBLE,  // double
+    KEYSTRING,  // varchar
+    FIXED32,    // two smallints
+    FIXED64,    // two ints
+    FIXED128,   // two bigints
+    SERIALIZED, // varchar and int
+    NUM_LAYOUTS // the number of the layouts
+};
+
+static std::vector<LogicalType> key_types_of(KeyLayout layout) {
+    switch (layout) {
+    case KEY8:
+        return {TYPE_TINYINT};
+    case KEY16:
+        return {TYPE_SMALLINT};
+    case KEY32:
+    case DENSE32:
+        return {TYPE_INT};
+    case KEY64:
+    case DENSE64:
+        return {TYPE_BIGINT};
+    case KEY128:
+        return {TYPE_LARGEINT};
+    case KEYDOUBLE:
+        return {TYPE_DOUBLE};
+    case KEYSTRING:
+        return {TYPE_VARCHAR};
+    case FIXED32:
+        return {TYPE_SMALLINT, TYPE_SMALLINT};
+    case FIXED64:
+        return {TYPE_INT, TYPE_INT};
+    case FIXED128:
+        return {TYPE_BIGINT, TYPE_BIGINT};
+    case SERIALIZED:
+        return {TYPE_VARCHAR, TYPE_INT};
+    default:
+        CHECK(false) << "unknown key layout " << layout;
+        return {};
+    }
+}
+
+// The numbers of the build rows to benchmark, the distinct keys of tinyint and smallint are limited.
+static std::vector<int64_t> build_rows_of(KeyLayout layout) {
+    switch (layout) {
+    case KEY8:
+        return {100};
+    case KEY16:
+        return {1 << 14};
+    default:
+        return {1 << 12, 1 << 17, 1 << 22};
+    }
+}
+
+// Bijective mixing, so the different ids are always mapped to the different keys.
+static uint32_t mix32(uint32_t id) {
+    return id * 0x9E3779B1U;
+}
+
+static uint64_t mix64(uint64_t id) {
+    return id * 0x9E3779B97F4A7C15ULL;
+}
+
+// Join a probe table and a build table on the keys of |layout|.
+//
+// Every key is generated from an id, the build side has the ids within [0, num_build_rows) once, and the probe keys
+// match the build side by the match rate, the unmatched probe keys are generated from the ids out of the range.
+class HashJoinBench {
+public:
+    static constexpr size_t kNumProbeChunks = 64;
+
+    HashJoinBench(KeyLayout layout, int64_t num_build_rows, TJoinOp::type join_type)
+            : _layout(layout), _num_build_rows(num_build_rows) {
+        TQueryOptions query_options;
+        query_options.batch_size = config::vector_chunk_size;
+        _runtime_state = std::make_shared<RuntimeState>(TUniqueId(), query_options, TQueryGlobals(), nullptr);
+        _runtime_state->init_instance_mem_tracker();
+        _profile = std::make_shared<RuntimeProfile>("HashJoinBench");
+
+        // the probe tuple is 0 and the build tuple is 1, their slots are numbered sequentially
+        const auto key_types = key_types_of(layout);
+        _num_keys = key_types.size();
+        for (LogicalType key_type : key_types) {
+            _key_types.emplace_back(TypeDescriptor::from_logical_type(key_type));
+        }
+        TDescriptorTableBuilder desc_tbl_builder;
+        for (int tuple = 0; tuple < 2; tuple++) {
+            TTupleDescriptorBuilder tuple_desc_builder;
+            for (size_t i = 0; i < _num_keys; i++) {
+                tuple_desc_builder.add_slot(TSlotDescriptorBuilder()
+                                                    .type(_key_types[i])
+                                                    .column_name("k" + std::to_string(i))
+                                                    .column_pos(i)
+                                                    .nullable(false)
+                                                    .build());
+            }
+            tuple_desc_builder.build(&desc_tbl_builder);
+        }
+        DescriptorTbl* desc_tbl = nullptr;
+        CHECK(DescriptorTbl::create(_runtime_state.get(), &_pool, desc_tbl_builder.desc_tbl(), &desc_tbl,
+                                    config::vector_chunk_size)
+                      .ok());
+        const std::vector<bool> not_nullable{false};
+        _row_desc = std::make_unique<RowDescriptor>(*desc_tbl, std::vector<TTupleId>{0, 1},
+                                                    std::vector<bool>{false, false});
+        _probe_row_desc = std::make_unique<RowDescriptor>(*desc_tbl, std::vector<TTupleId>{0}, not_nullable);
+        _build_row_desc = std::make_unique<RowDescriptor>(*desc_tbl, std::vector<TTupleId>{1}, not_nullable);
+
+        _param.need_create_tuple_columns = false;
+        _param.join_type = join_type;
+        _param.row_desc = _row_desc.get();
+        _param.probe_row_desc = _probe_row_desc.get();
+        _param.build_row_desc = _build_row_desc.get();
+        // output the first probe key and the first build key
+        _param.output_slots.emplace(0);
+        _param.output_slots.emplace(_num_keys);
+        for (size_t i = 0; i < _num_keys; i++) {
+            _param.join_keys.emplace_back(JoinKeyDesc{&_key_types[i], false, nullptr});
+        }
+        _param.search_ht_timer = ADD_TIMER(_profile, "SearchHashTableTime");
+        _param.output_build_column_timer = ADD_TIMER(_profile, "OutputBuildColumnTime");
+        _param.output_probe_column_timer = ADD_TIMER(_profile, "OutputProbeColumnTime");
+        _param.output_tuple_column_timer = ADD_TIMER(_profile, "OutputTupleColumnTime");
+
+        // the build ids are shuffled, so the keys are not inserted in order
+        std::vector<int64_t> build_ids(num_build_rows);
+        std::iota(build_ids.begin(), build_ids.end(), 0);
+        std::shuffle(build_ids.begin(), build_ids.end(), std::mt19937_64(0));
+        for (size_t offset = 0; offset < build_ids.size(); offset += kTestChunkSize) {
+            const size_t end = std::min<size_t>(offset + kTestChunkSize, build_ids.size());
+            _build_chunks.emplace_back(_create_chunk(build_ids.data() + offset, end - offset, _num_keys));
+        }
+    }
+
+    // Generate the probe chunks, |match_rate| percent of the probe keys are in the build side.
+    void generate_probe_chunks(BenchKeyGenerator::Distribution distribution, int64_t match_rate) {
+        BenchKeyGenerator generator(distribution, _num_build_rows, 1);
+        std::vector<int64_t> probe_ids(kTestChunkSize);
+        for (size_t i = 0; i < kNumProbeChunks; i++) {
+            for (auto& id : probe_ids) {
+                const bool matched = generator.next_real() * 100 < match_rate;
+                id = matched ? generator.next() : _num_build_rows + generator.next();
+            }
+            _probe_chunks.emplace_back(_create_chunk(probe_ids.data(), probe_ids.size(), 0));
+        }
+    }
+
+    // Create the hash table of all the build chunks.
+    void build(JoinHashTable* hash_table) {
+        hash_table->create(_param);
+        for (const auto& chunk : _build_chunks) {
+            hash_table->append_chunk(_runtime_state.get(), chunk, _key_columns(chunk));
+        }
+        ASSERT_OK(hash_table->build(_runtime_state.get()));
+    }
+
+    // Probe all the probe chunks, return the number of the output rows.
+    size_t probe(JoinHashTable* hash_table) {
+        size_t num_output_rows = 0;
+        for (const auto& chunk : _probe_chunks) {
+            const Columns key_columns = _key_columns(chunk);
+            ChunkPtr probe_chunk = chunk;
+            bool has_remain = true;
+            while (has_remain) {
+                auto output_chunk = std::make_shared<Chunk>();
+                auto st = hash_table->probe(_runtime_state.get(), key_columns, &probe_chunk, &output_chunk,
+                                            &has_remain);
+                CHECK(st.ok()) << st;
+                num_output_rows += output_chunk->num_rows();
+            }
+        }
+        return num_output_rows;
+    }
+
+private:
+    ChunkPtr _create_chunk(const int64_t* ids, size_t num_rows, SlotId first_slot_id) const {
+        Columns columns;
+        for (size_t i = 0; i < _num_keys; i++) {
+            columns.emplace_back(ColumnHelper::create_column(_key_types[i], false));
+            columns.back()->reserve(num_rows);
+        }
+        for (size_t row = 0; row < num_rows; row++) {
+            _append_key(columns, ids[row]);
+        }
+        auto chunk = std::make_shared<Chunk>();
+        for (size_t i = 0; i < _num_keys; i++) {
+            chunk->append_column(std::move(columns[i]), first_slot_id + i);
+        }
+        return chunk;
+    }
+
+    void _append_key(const Columns& columns, int64_t id) const {
+        switch (_layout) {
+        case KEY8:
+            columns[0]->append_datum(Datum(static_cast<int8_t>(id - 100)));
+            break;
+        case KEY16:
+            columns[0]->append_datum(Datum(static_cast<int16_t>(id - (1 << 14))));
+            break;
+        case KEY32:
+            columns[0]->append_datum(Datum(static_cast<int32_t>(mix32(id))));
+            break;
+        case DENSE32:
+            columns[0]->append_datum(Datum(static_cast<int32_t>(id)));
+            break;
+        case KEY64:
+            columns[0]->append_datum(Datum(static_cast<int64_t>(mix64(id))));
+            break;
+        case DENSE64:
+            columns[0]->append_datum(Datum(id));
+            break;
+        case KEY128:
+            columns[0]->append_datum(Datum((static_cast<int128_t>(mix64(id)) << 64) | id));
+            break;
+        case KEYDOUBLE:
+            columns[0]->append_datum(Datum(static_cast<double>(id) + 0.5));
+            break;
+        case KEYSTRING: {
+            const std::string key = std::to_string(mix64(id));
+            columns[0]->append_datum(Datum(Slice(key)));
+            break;
+        }
+        case FIXED32:
+            columns[0]->append_datum(Datum(static_cast<int16_t>(id & 0x7FFF)));
+            columns[1]->append_datum(Datum(static_cast<int16_t>(id >> 15)));
+            break;
+        case FIXED64:
+            columns[0]->append_datum(Datum(static_cast<int32_t>(mix32(id))));
+            columns[1]->append_datum(Datum(static_cast<int32_t>(id)));
+            break;
+        case FIXED128:
+            columns[0]->append_datum(Datum(static_cast<int64_t>(mix64(id))));
+            columns[1]->append_datum(Datum(id));
+            break;
+        case SERIALIZED: {
+            const std::string key = std::to_string(mix64(id));
+            columns[0]->append_datum(Datum(Slice(key)));
+            columns[1]->append_datum(Datum(static_cast<int32_t>(id)));
+            break;
+        }
+        default:
+            CHECK(false) << "unknown key layout " << _layout;
+        }
+    }
+
+    Columns _key_columns(const ChunkPtr& chunk) const {
+        return Columns(chunk->columns().begin(), chunk->columns().begin() + _num_keys);
+    }
+
+    const KeyLayout _layout;
+    const int64_t _num_build_rows;
+    size_t _num_keys = 0;
+    std::shared_ptr<RuntimeState> _runtime_state;
+    std::shared_ptr<RuntimeProfile> _profile;
+    ObjectPool _pool;
+    std::vector<TypeDescriptor> _key_types;
+    std::unique_ptr<RowDescriptor> _row_desc;
+    std::unique_ptr<RowDescriptor> _probe_row_desc;
+    std::unique_ptr<RowDescriptor> _build_row_desc;
+    HashTableParam _param;
+    std::vector<ChunkPtr> _build_chunks;
+    std::vector<ChunkPtr> _probe_chunks;
+};
+
+// Run with the args {key layout, num_build_rows}.
+static void Benchmark_HashJoin_Build(benchmark::State& state) {
+    HashJoinBench bench(static_cast<KeyLayout>(state.range(0)), state.range(1), TJoinOp::INNER_JOIN);
+    for (auto _ : state) {
+        JoinHashTable hash_table;
+        bench.build(&hash_table);
+        state.PauseTiming();
+        hash_table.close();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+// Run with the args {key layout, num_build_rows, match rate in percent, key distribution, join type}.
+static void Benchmark_HashJoin_Probe(benchmark::State& state) {
+    HashJoinBench bench(static_cast<KeyLayout>(state.range(0)), state.range(1),
+                        static_cast<TJoinOp::type>(state.range(4)));
+    bench.generate_probe_chunks(static_cast<BenchKeyGenerator::Distribution>(state.range(3)), state.range(2));
+    JoinHashTable hash_table;
+    bench.build(&hash_table);
+    size_t num_output_rows = 0;
+    for (auto _ : state) {
+        num_output_rows += bench.probe(&hash_table);
+    }
+    hash_table.close();
+    state.SetItemsProcessed(state.iterations() * HashJoinBench::kNumProbeChunks * kTestChunkSize);
+    state.counters["output_rows"] = benchmark::Counter(num_output_rows, benchmark::Counter::kAvgIterations);
+}
+
+static void HashJoinBuildArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"layout", "build_rows"});
+    for (int64_t layout = 0; layout < NUM_LAYOUTS; layout++) {
+        for (int64_t num_build_rows : build_rows_of(static_cast<KeyLayout>(layout))) {
+            b->Args({layout, num_build_rows});
+        }
+    }
+}
+
+static void HashJoinProbeArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"layout", "build_rows", "match_rate", "distribution", "join_type"});
+    // every layout with the uniform keys
+    for (int64_t layout = 0; layout < NUM_LAYOUTS; layout++) {
+        for (int64_t num_build_rows : build_rows_of(static_cast<KeyLayout>(layout))) {
+            for (int64_t match_rate : {10, 50, 100}) {
+                b->Args({layout, num_build_rows, match_rate, BenchKeyGenerator::UNIFORM, TJoinOp::INNER_JOIN});
+            }
+        }
+    }
+    // the skewed keys
+    for (int64_t layout : {KEY64, SERIALIZED}) {
+        for (int64_t num_build_rows : build_rows_of(static_cast<KeyLayout>(layout))) {
+            b->Args({layout, num_build_rows, 50, BenchKeyGenerator::ZIPF, TJoinOp::INNER_JOIN});
+        }
+    }
+    // the other join types
+    for (int64_t join_type : {TJoinOp::LEFT_OUTER_JOIN, TJoinOp::LEFT_SEMI_JOIN, TJoinOp::LEFT_ANTI_JOIN}) {
+        b->Args({KEY64, 1 << 17, 50, BenchKeyGenerator::UNIFORM, join_type});
+    }
+}
+
+BENCHMARK(Benchmark_HashJoin_Build)->Apply(HashJoinBuildArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK(Benchmark_HashJoin_Probe)->Apply(HashJoinProbeArgs)->Unit(benchmark::kMillisecond);
+
+} // namespace starrocks
+
+BENCHMARK_MAIN();
@@ -0,0 +1,158 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "bench.h"
+#include "column/column_helper.h"
+#include "column/fixed_length_column.h"
+#include "exec/join_hash_map.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks {
+
+// Probe a join hash table of two int keys by random keys, with and without prefetching the buckets.
+// Run with the args {num_build_rows, serialized keys or fixed size keys, prefetch}.
+class JoinHashMapBench {
+public:
+    JoinHashMapBench(int64_t num_build_rows, bool serialized) : _serialized(serialized) {
+        TQueryOptions query_options;
+        query_options.batch_size = config::vector_chunk_size;
+        _runtime_state = std::make_shared<RuntimeState>(TUniqueId(), query_options, TQueryGlobals(), nullptr);
+        _runtime_state->init_instance_mem_tracker();
+        _int_type = TypeDescriptor(TYPE_INT);
+
+        _table_items.row_count = num_build_rows;
+        // the first row of the build columns is a placeholder
+        _table_items.key_columns.emplace_back(_create_build_column(num_build_rows, 1));
+        _table_items.key_columns.emplace_back(_create_build_column(num_build_rows, 7));
+        _table_items.join_keys.emplace_back(JoinKeyDesc{&_int_type, false, nullptr});
+        _table_items.join_keys.emplace_back(JoinKeyDesc{&_int_type, false, nullptr});
+        if (_serialized) {
+            SerializedJoinBuildFunc::prepare(_runtime_state.get(), &_table_items);
+            SerializedJoinBuildFunc::construct_hash_table(_runtime_state.get(), &_table_items, &_probe_state);
+            SerializedJoinProbeFunc::prepare(_runtime_state.get(), &_probe_state);
+        } else {
+            FixedSizeJoinBuildFunc<TYPE_BIGINT>::prepare(_runtime_state.get(), &_table_items);
+            FixedSizeJoinBuildFunc<TYPE_BIGINT>::construct_hash_table(_runtime_state.get(), &_table_items,
+                                                                       &_probe_state);
+            FixedSizeJoinProbeFunc<TYPE_BIGINT>::prepare(_runtime_state.get(), &_probe_state);
+        }
+        _probe_state.buckets.resize(kTestChunkSize);
+        _probe_state.next.resize(kTestChunkSize);
+
+        std::mt19937 rng(0);
+        std::uniform_int_distribution<int32_t> dist(0, num_build_rows - 1);
+        for (size_t i = 0; i < kNumProbeBatches; i++) {
+            auto keys = Int32Column::create();
+            for (size_t j = 0; j < kTestChunkSize; j++) {
+                keys->append(dist(rng));
+            }
+            Columns columns;
+            columns.emplace_back(_times_column(*keys, 1));
+            columns.emplace_back(_times_column(*keys, 7));
+            _probe_columns.emplace_back(std::move(columns));
+        }
+    }
+
+    // Look up the keys of all the probe batches and walk the chains, return the number of matched rows.
+    size_t probe() {
+        HashTableProbeState* probe_state = &_probe_state;
+        size_t num_matched = 0;
+        for (auto& columns : _probe_columns) {
+            probe_state->key_columns = &columns;
+            probe_state->probe_row_count = kTestChunkSize;
+            if (_serialized) {
+                SerializedJoinProbeFunc::lookup_init(_table_items, probe_state);
+                num_matched += _walk_chains<SerializedJoinProbeFunc>(_table_items.build_slice);
+            } else {
+                FixedSizeJoinProbeFunc<TYPE_BIGINT>::lookup_init(_table_items, probe_state);
+                num_matched += _walk_chains<FixedSizeJoinProbeFunc<TYPE_BIGINT>>(
+                        FixedSizeJoinBuildFunc<TYPE_BIGINT>::get_key_data(_table_items));
+            }
+        }
+        return num_matched;
+    }
+
+    static constexpr size_t kNumProbeBatches = 256;
+
+private:
+    template <class ProbeFunc, class BuildData>
+    size_t _walk_chains(const BuildData& build_data) {
+        const auto& probe_data = ProbeFunc::get_key_data(_probe_state);
+        size_t num_matched = 0;
+        for (size_t i = 0; i < _probe_state.probe_row_count; i++) {
+            for (uint32_t index = _probe_state.next[i]; index != 0; index = _table_items.next[index]) {
+                num_matched += ProbeFunc::equal(build_data[index], probe_data[i]);
+            }
+        }
+        return num_matched;
+    }
+
+    static ColumnPtr _create_build_column(int64_t num_rows, int32_t times) {
+        auto column = Int32Column::create();
+        column->append_default();
+        for (int32_t i = 0; i < num_rows; i++) {
+            column->append(i * times);
+        }
+        return column;
+    }
+
+    static ColumnPtr _times_column(const Int32Column& keys, int32_t times) {
+        auto column = Int32Column::create();
+        for (int32_t key : keys.get_data()) {
+            column->append(key * times);
+        }
+        return column;
+    }
+
+    bool _serialized;
+    std::shared_ptr<RuntimeState> _runtime_state;
+    TypeDescriptor _int_type;
+    JoinHashTableItems _table_items;
+    HashTableProbeState _probe_state;
+    std::vector<Columns> _probe_columns;
+};
+
+static void Benchmark_JoinHashMap_Probe(benchmark::State& state) {
+    const int64_t origin_min_bytes = config::join_hash_table_probe_prefetch_min_bytes;
+    config::join_hash_table_probe_prefetch_min_bytes = state.range(2) ? 0 : -1;
+    JoinHashMapBench bench(state.range(0), state.range(1));
+    size_t num_matched = 0;
+    for (auto _ : state) {
+        num_matched += bench.probe();
+    }
+    config::join_hash_table_probe_prefetch_min_bytes = origin_min_bytes;
+    benchmark::DoNotOptimize(num_matched);
+    state.SetItemsProcessed(state.iterations() * JoinHashMapBench::kNumProbeBatches * kTestChunkSize);
+}
+
+static void JoinHashMapProbeArgs(benchmark::internal::Benchmark* b) {
+    for (int64_t num_build_rows : {1 << 16, 1 << 20, 1 << 24}) {
+        for (int64_t serialized : {0, 1}) {
+            for (int64_t prefetch : {0, 1}) {
+                b->Args({num_build_rows, serialized, prefetch});
+            }
+        }
+    }
+}
+
+BENCHMARK(Benchmark_JoinHashMap_Probe)->Apply(JoinHashMapProbeArgs)->Unit(benchmark::kMillisecond);
+
+} // namespace starrocks
+
+BENCHMARK_MAIN();
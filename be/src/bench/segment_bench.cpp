@@ -0,0 +1,391 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <mutex>
+
+#include "bench.h"
+#include "fs/fs_memory.h"
+#include "runtime/mem_tracker.h"
+#include "storage/chunk_helper.h"
+#include "storage/chunk_iterator.h"
+#include "storage/column_predicate.h"
+#include "storage/olap_common.h"
+#include "storage/page_cache.h"
+#include "storage/rowset/segment.h"
+#include "storage/rowset/segment_options.h"
+#include "storage/rowset/segment_writer.h"
+#include "storage/seek_range.h"
+#include "storage/tablet_schema.h"
+#include "storage/types.h"
+
+namespace starrocks {
+
+// The value columns to benchmark, every encoding registered in EncodingInfoResolver for the types.
+struct ColumnEncoding {
+    LogicalType type;
+    EncodingTypePB encoding;
+};
+
+static const std::vector<ColumnEncoding> kColumnEncodings = {
+        {TYPE_INT, DEFAULT_ENCODING},      {TYPE_INT, BIT_SHUFFLE},        {TYPE_INT, FOR_ENCODING},
+        {TYPE_INT, INT_DICT_ENCODING},     {TYPE_INT, PLAIN_ENCODING},     {TYPE_BIGINT, DEFAULT_ENCODING},
+        {TYPE_BIGINT, BIT_SHUFFLE},        {TYPE_BIGINT, FOR_ENCODING},    {TYPE_BIGINT, INT_DICT_ENCODING},
+        {TYPE_BIGINT, PLAIN_ENCODING},     {TYPE_DOUBLE, DEFAULT_ENCODING}, {TYPE_DOUBLE, BIT_SHUFFLE},
+        {TYPE_DOUBLE, PLAIN_ENCODING},     {TYPE_DOUBLE, ALP_ENCODING},    {TYPE_VARCHAR, DEFAULT_ENCODING},
+        {TYPE_VARCHAR, DICT_ENCODING},     {TYPE_VARCHAR, PLAIN_ENCODING}, {TYPE_VARCHAR, PREFIX_ENCODING},
+        {TYPE_VARCHAR, FSST_ENCODING},
+};
+
+static const std::vector<CompressionTypePB> kCompressions = {NO_COMPRESSION, LZ4_FRAME, ZSTD, SNAPPY};
+
+// The index of the value column, the key column always has the zone map and the short key index, and the value
+// column always has the zone map.
+enum ValueColumnIndex { ZONE_MAP_ONLY = 0, BLOOM_FILTER, BITMAP_INDEX };
+
+// Write a segment of (k int, v <type>) duplicate key (k), and read it through SegmentIterator.
+//
+// k is the row id, and v is generated from the ids within [0, cardinality) uniformly. The segments are written into
+// a MemoryFileSystem, so the file IO is not measured, a cold read doesn't use the page cache, and a warm read finds
+// all the pages in the page cache.
+class SegmentBench {
+public:
+    static constexpr int64_t kNumRows = 1 << 20;
+    static constexpr int64_t kSeekRows = 100;
+
+    SegmentBench(const ColumnEncoding& column_encoding, CompressionTypePB compression, ValueColumnIndex index,
+                 int64_t cardinality)
+            : _column_encoding(column_encoding) {
+        _init_page_cache();
+
+        TabletSchemaPB schema_pb;
+        schema_pb.set_keys_type(DUP_KEYS);
+        schema_pb.set_num_short_key_columns(1);
+        schema_pb.set_num_rows_per_row_block(1024);
+        schema_pb.set_compression_type(compression);
+        ColumnPB* key = schema_pb.add_column();
+        key->set_unique_id(0);
+        key->set_name("k");
+        key->set_type("INT");
+        key->set_is_key(true);
+        key->set_is_nullable(false);
+        key->set_length(4);
+        key->set_index_length(4);
+        ColumnPB* value = schema_pb.add_column();
+        value->set_unique_id(1);
+        value->set_name("v");
+        value->set_type(_type_name(column_encoding.type));
+        value->set_is_key(false);
+        value->set_is_nullable(false);
+        value->set_aggregation("NONE");
+        value->set_length(column_encoding.type == TYPE_VARCHAR ? 64 : get_type_info(column_encoding.type)->size());
+        value->set_is_bf_column(index == BLOOM_FILTER);
+        value->set_has_bitmap_index(index == BITMAP_INDEX);
+        _tablet_schema = TabletSchema::create(schema_pb);
+        _schema = ChunkHelper::convert_schema(*_tablet_schema);
+        _key_schema = ChunkHelper::convert_schema(*_tablet_schema, {0});
+        _writer_opts.column_encodings[1] = column_encoding.encoding;
+
+        BenchKeyGenerator generator(BenchKeyGenerator::UNIFORM, cardinality);
+        for (int64_t offset = 0; offset < kNumRows; offset += kTestChunkSize) {
+            auto chunk = ChunkHelper::new_chunk(_schema, kTestChunkSize);
+            for (int64_t row = offset; row < std::min<int64_t>(offset + kTestChunkSize, kNumRows); row++) {
+                chunk->get_column_by_index(0)->append_datum(Datum(static_cast<int32_t>(row)));
+                _append_value(chunk->get_column_by_index(1).get(), generator.next());
+            }
+            _chunks.emplace_back(std::move(chunk));
+        }
+        // the value of the predicates, about kNumRows / cardinality rows match it
+        _predicate_operand = _operand(cardinality / 2);
+    }
+
+    ~SegmentBench() { _segment.reset(); }
+
+    // Write all the chunks into a new segment, return the size of the segment file.
+    uint64_t write() {
+        if (!_path.empty()) {
+            _segment.reset();
+            CHECK(_fs->delete_file(_path).ok());
+        }
+        // the pages are cached by the file names and the offsets, so every segment has a new file name
+        static std::atomic<int64_t> s_next_segment_id{0};
+        _path = "/segment_bench_" + std::to_string(s_next_segment_id++) + ".dat";
+        auto wfile = _fs->new_writable_file(_path);
+        CHECK(wfile.ok()) << wfile.status();
+        SegmentWriter writer(std::move(wfile).value(), 0, _tablet_schema.get(), _writer_opts);
+        _check(writer.init());
+        for (const auto& chunk : _chunks) {
+            _check(writer.append_chunk(*chunk));
+        }
+        uint64_t file_size = 0;
+        uint64_t index_size = 0;
+        uint64_t footer_position = 0;
+        _check(writer.finalize(&file_size, &index_size, &footer_position));
+        return file_size;
+    }
+
+    // Open the last written segment.
+    void open() {
+        auto segment = Segment::open(_fs, _path, 0, _tablet_schema);
+        CHECK(segment.ok()) << segment.status();
+        _segment = std::move(segment).value();
+    }
+
+    // Scan all the rows, filtered by `v = operand` if |filtered|, return the number of the rows read.
+    size_t scan(bool use_page_cache, bool filtered) {
+        std::unique_ptr<ColumnPredicate> predicate;
+        if (filtered) {
+            predicate.reset(
+                    new_column_eq_predicate(get_type_info(_column_encoding.type), 1, Slice(_predicate_operand)));
+        }
+        return _read(use_page_cache, {}, predicate.get());
+    }
+
+    // Read kSeekRows rows from each of |num_seeks| random keys, return the number of the rows read.
+    size_t seek(bool use_page_cache, size_t num_seeks) {
+        BenchKeyGenerator generator(BenchKeyGenerator::UNIFORM, kNumRows - kSeekRows);
+        size_t num_rows = 0;
+        for (size_t i = 0; i < num_seeks; i++) {
+            const auto start = static_cast<int32_t>(generator.next());
+            SeekRange range(SeekTuple(_key_schema, {Datum(start)}), SeekTuple(_key_schema, {Datum(start + kSeekRows)}));
+            range.set_inclusive_lower(true);
+            num_rows += _read(use_page_cache, {range}, nullptr);
+        }
+        return num_rows;
+    }
+
+private:
+    static void _init_page_cache() {
+        static std::once_flag s_once;
+        static std::unique_ptr<MemTracker> s_mem_tracker;
+        std::call_once(s_once, []() {
+            s_mem_tracker = std::make_unique<MemTracker>();
+            StoragePageCache::create_global_cache(s_mem_tracker.get(), 4L * 1024 * 1024 * 1024);
+        });
+    }
+
+    static std::string _type_name(LogicalType type) {
+        switch (type) {
+        case TYPE_INT:
+            return "INT";
+        case TYPE_BIGINT:
+            return "BIGINT";
+        case TYPE_DOUBLE:
+            return "DOUBLE";
+        case TYPE_VARCHAR:
+            return "VARCHAR";
+        default:
+            CHECK(false) << "unsupported type " << type;
+            return "";
+        }
+    }
+
+    static void _check(const Status& st) { CHECK(st.ok()) << st; }
+
+    void _append_value(Column* column, int64_t id) const {
+        switch (_column_encoding.type) {
+        case TYPE_INT:
+            column->append_datum(Datum(static_cast<int32_t>(id)));
+            break;
+        case TYPE_BIGINT:
+            column->append_datum(Datum(id * 1000003));
+            break;
+        case TYPE_DOUBLE:
+            // the decimals of the prices
+            column->append_datum(Datum(static_cast<double>(id) / 100));
+            break;
+        case TYPE_VARCHAR: {
+            const std::string value = "value_" + std::to_string(id);
+            column->append_datum(Datum(Slice(value)));
+            break;
+        }
+        default:
+            CHECK(false) << "unsupported type " << _column_encoding.type;
+        }
+    }
+
+    // The string of the value generated from |id|, as the operand of the predicates.
+    std::string _operand(int64_t id) const {
+        switch (_column_encoding.type) {
+        case TYPE_INT:
+            return std::to_string(id);
+        case TYPE_BIGINT:
+            return std::to_string(id * 1000003);
+        case TYPE_DOUBLE:
+            return std::to_string(static_cast<double>(id) / 100);
+        case TYPE_VARCHAR:
+            return "value_" + std::to_string(id);
+        default:
+            CHECK(false) << "unsupported type " << _column_encoding.type;
+            return "";
+        }
+    }
+
+    size_t _read(bool use_page_cache, std::vector<SeekRange> ranges, const ColumnPredicate* predicate) {
+        OlapReaderStatistics stats;
+        SegmentReadOptions opts;
+        opts.fs = _fs;
+        opts.stats = &stats;
+        opts.use_page_cache = use_page_cache;
+        opts.chunk_size = kTestChunkSize;
+        opts.ranges = std::move(ranges);
+        if (predicate != nullptr) {
+            opts.predicates[1].emplace_back(predicate);
+            opts.predicates_for_zone_map[1].emplace_back(predicate);
+        }
+        auto iter = _segment->new_iterator(_schema, opts);
+        if (iter.status().is_end_of_file()) {
+            // all the rows are filtered by the indexes
+            return 0;
+        }
+        CHECK(iter.ok()) << iter.status();
+        auto chunk = ChunkHelper::new_chunk(_schema, kTestChunkSize);
+        size_t num_rows = 0;
+        while (true) {
+            chunk->reset();
+            auto st = iter.value()->get_next(chunk.get());
+            if (st.is_end_of_file()) {
+                break;
+            }
+            _check(st);
+            num_rows += chunk->num_rows();
+        }
+        iter.value()->close();
+        return num_rows;
+    }
+
+    const ColumnEncoding _column_encoding;
+    std::shared_ptr<MemoryFileSystem> _fs = std::make_shared<MemoryFileSystem>();
+    std::shared_ptr<TabletSchema> _tablet_schema;
+    Schema _schema;
+    Schema _key_schema;
+    SegmentWriterOptions _writer_opts;
+    std::vector<ChunkPtr> _chunks;
+    std::string _predicate_operand;
+    std::string _path;
+    std::shared_ptr<Segment> _segment;
+};
+
+// Run with the args {column encoding, cardinality, compression, index}.
+static void Benchmark_Segment_Write(benchmark::State& state) {
+    SegmentBench bench(kColumnEncodings[state.range(0)], static_cast<CompressionTypePB>(state.range(2)),
+                       static_cast<ValueColumnIndex>(state.range(3)), state.range(1));
+    uint64_t file_size = 0;
+    for (auto _ : state) {
+        file_size = bench.write();
+    }
+    state.SetItemsProcessed(state.iterations() * SegmentBench::kNumRows);
+    state.counters["file_size"] = file_size;
+    state.counters["bytes_per_row"] = static_cast<double>(file_size) / SegmentBench::kNumRows;
+}
+
+// Run with the args {column encoding, cardinality, compression, index, warm page cache, filtered by v}.
+static void Benchmark_Segment_Scan(benchmark::State& state) {
+    SegmentBench bench(kColumnEncodings[state.range(0)], static_cast<CompressionTypePB>(state.range(2)),
+                       static_cast<ValueColumnIndex>(state.range(3)), state.range(1));
+    bench.write();
+    bench.open();
+    const bool use_page_cache = state.range(4);
+    const bool filtered = state.range(5);
+    if (use_page_cache) {
+        bench.scan(true, false);
+    }
+    size_t num_rows = 0;
+    for (auto _ : state) {
+        num_rows = bench.scan(use_page_cache, filtered);
+    }
+    state.SetItemsProcessed(state.iterations() * SegmentBench::kNumRows);
+    state.counters["output_rows"] = num_rows;
+}
+
+// Run with the args {column encoding, cardinality, compression, warm page cache}.
+static void Benchmark_Segment_Seek(benchmark::State& state) {
+    constexpr size_t kNumSeeks = 256;
+    SegmentBench bench(kColumnEncodings[state.range(0)], static_cast<CompressionTypePB>(state.range(2)),
+                       ZONE_MAP_ONLY, state.range(1));
+    bench.write();
+    bench.open();
+    const bool use_page_cache = state.range(3);
+    if (use_page_cache) {
+        bench.scan(true, false);
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bench.seek(use_page_cache, kNumSeeks));
+    }
+    state.SetItemsProcessed(state.iterations() * kNumSeeks);
+}
+
+static constexpr int64_t kLowCardinality = 1 << 8;
+static constexpr int64_t kHighCardinality = 1 << 20;
+
+static bool supports_indexes(LogicalType type) {
+    return type == TYPE_INT || type == TYPE_BIGINT || type == TYPE_VARCHAR;
+}
+
+static void SegmentWriteArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"encoding", "cardinality", "compression", "index"});
+    for (int64_t i = 0; i < static_cast<int64_t>(kColumnEncodings.size()); i++) {
+        for (int64_t cardinality : {kLowCardinality, kHighCardinality}) {
+            for (int64_t compression : kCompressions) {
+                b->Args({i, cardinality, compression, ZONE_MAP_ONLY});
+            }
+            if (supports_indexes(kColumnEncodings[i].type)) {
+                b->Args({i, cardinality, LZ4_FRAME, BLOOM_FILTER});
+                b->Args({i, cardinality, LZ4_FRAME, BITMAP_INDEX});
+            }
+        }
+    }
+}
+
+static void SegmentScanArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"encoding", "cardinality", "compression", "index", "warm", "filtered"});
+    for (int64_t i = 0; i < static_cast<int64_t>(kColumnEncodings.size()); i++) {
+        for (int64_t cardinality : {kLowCardinality, kHighCardinality}) {
+            for (int64_t warm : {0, 1}) {
+                // the full scans
+                for (int64_t compression : kCompressions) {
+                    b->Args({i, cardinality, compression, ZONE_MAP_ONLY, warm, 0});
+                }
+                // the predicate filtered scans
+                b->Args({i, cardinality, LZ4_FRAME, ZONE_MAP_ONLY, warm, 1});
+                if (supports_indexes(kColumnEncodings[i].type)) {
+                    b->Args({i, cardinality, LZ4_FRAME, BLOOM_FILTER, warm, 1});
+                    b->Args({i, cardinality, LZ4_FRAME, BITMAP_INDEX, warm, 1});
+                }
+            }
+        }
+    }
+}
+
+static void SegmentSeekArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"encoding", "cardinality", "compression", "warm"});
+    for (int64_t i = 0; i < static_cast<int64_t>(kColumnEncodings.size()); i++) {
+        for (int64_t compression : kCompressions) {
+            for (int64_t warm : {0, 1}) {
+                b->Args({i, kHighCardinality, compression, warm});
+            }
+        }
+    }
+}
+
+BENCHMARK(Benchmark_Segment_Write)->Apply(SegmentWriteArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK(Benchmark_Segment_Scan)->Apply(SegmentScanArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK(Benchmark_Segment_Seek)->Apply(SegmentSeekArgs)->Unit(benchmark::kMillisecond);
+
+} // namespace starrocks
+
+BENCHMARK_MAIN();
@@ -0,0 +1,176 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <benchmark/benchmark.h>
+
+#include "bench.h"
+#include "column/column_helper.h"
+#include "column/fixed_length_column.h"
+#include "exprs/agg/aggregate.h"
+#include "exprs/agg/aggregate_factory.h"
+#include "runtime/mem_pool.h"
+#include "testutil/function_utils.h"
+
+namespace starrocks {
+
+// The window functions over bigint.
+enum WindowFunctionKind {
+    FN_ROW_NUMBER = 0,
+    FN_RANK,
+    FN_DENSE_RANK,
+    FN_SUM,
+    FN_COUNT,
+    FN_AVG,
+    FN_MAX,
+    FN_MIN,
+    FN_NUM_FUNCTIONS // the number of the functions
+};
+
+static const char* const kFunctionNames[] = {"row_number", "rank", "dense_rank", "sum", "count", "avg", "max", "min"};
+
+// The frames evaluated by the analytic sink operator.
+enum WindowFrame {
+    // range between unbounded preceding and current row of the ranking functions, the peers share a rank
+    RANKING = 0,
+    // rows between unbounded preceding and current row, the frame grows by one row at a time
+    CUMULATIVE,
+    // rows between n preceding and n following, every frame is evaluated from scratch
+    SLIDING,
+    // rows between n preceding and n following, evaluated by removing the first row of the previous frame and
+    // adding the last row of the current frame, see Analytor::_support_removable_cumulatively
+    SLIDING_REMOVABLE,
+};
+
+// Evaluate a window function over the partitions of a bigint column, by the same calls of the function as Analytor
+// for every frame, the rows are ordered and the peer groups are of the same size.
+class WindowFunctionBench {
+public:
+    static constexpr int64_t kNumRows = 64 * 4096;
+
+    WindowFunctionBench(WindowFunctionKind function, WindowFrame frame, int64_t partition_rows, int64_t window_rows)
+            : _frame(frame), _partition_rows(partition_rows), _window_rows(window_rows) {
+        std::string name = kFunctionNames[function];
+        if (frame == SLIDING_REMOVABLE && (function == FN_MAX || function == FN_MIN)) {
+            // max/min are evaluated by the monotonic queues
+            name += "_sliding";
+        }
+        const LogicalType return_type = function == FN_AVG ? TYPE_DOUBLE : TYPE_BIGINT;
+        _func = get_window_function(name, TYPE_BIGINT, return_type, false);
+        CHECK(_func != nullptr) << "unknown window function " << name;
+        _state = _mem_pool.allocate_aligned(_func->size(), _func->alignof_size());
+        _func->create(_ctx(), _state);
+
+        BenchKeyGenerator generator(BenchKeyGenerator::UNIFORM, 1 << 20);
+        auto column = Int64Column::create();
+        column->reserve(kNumRows);
+        for (size_t i = 0; i < kNumRows; i++) {
+            column->append(generator.next());
+        }
+        _input_columns.emplace_back(std::move(column));
+        _result_column = ColumnHelper::create_column(TypeDescriptor(return_type), false);
+        _result_column->resize(kNumRows);
+    }
+
+    ~WindowFunctionBench() { _func->destroy(_ctx(), _state); }
+
+    // Evaluate the window function of all the rows, the results are written into the result column.
+    void evaluate() {
+        const Column* column = _input_columns[0].get();
+        FunctionContext* ctx = _ctx();
+        for (int64_t partition_start = 0; partition_start < kNumRows; partition_start += _partition_rows) {
+            const int64_t partition_end = std::min<int64_t>(partition_start + _partition_rows, kNumRows);
+            _func->reset(ctx, _input_columns, _state);
+            if (_frame == SLIDING_REMOVABLE) {
+                // the rows of the first frame except its last one
+                _func->update_batch_single_state_with_frame(ctx, _state, &column, partition_start, partition_end,
+                                                            partition_start,
+                                                            std::min(partition_start + _window_rows, partition_end));
+            }
+            for (int64_t i = partition_start; i < partition_end; i++) {
+                switch (_frame) {
+                case RANKING: {
+                    const int64_t peer_start = partition_start + (i - partition_start) / kPeerRows * kPeerRows;
+                    const int64_t peer_end = std::min(peer_start + kPeerRows, partition_end);
+                    _func->update_batch_single_state_with_frame(ctx, _state, &column, peer_start, peer_end, i, i + 1);
+                    break;
+                }
+                case CUMULATIVE:
+                    _func->update_batch_single_state_with_frame(ctx, _state, &column, partition_start, partition_end,
+                                                                i, i + 1);
+                    break;
+                case SLIDING:
+                    _func->reset(ctx, _input_columns, _state);
+                    _func->update_batch_single_state_with_frame(
+                            ctx, _state, &column, partition_start, partition_end,
+                            std::max(i - _window_rows, partition_start), std::min(i + _window_rows + 1, partition_end));
+                    break;
+                case SLIDING_REMOVABLE:
+                    _func->update_state_removable_cumulatively(ctx, _state, &column, i, partition_start, partition_end,
+                                                               -_window_rows, _window_rows, false, false);
+                    break;
+                }
+                _func->get_values(ctx, _state, _result_column.get(), i, i + 1);
+            }
+        }
+    }
+
+private:
+    static constexpr int64_t kPeerRows = 4;
+
+    FunctionContext* _ctx() { return _function_utils.get_fn_ctx(); }
+
+    const WindowFrame _frame;
+    const int64_t _partition_rows;
+    const int64_t _window_rows;
+    FunctionUtils _function_utils;
+    MemPool _mem_pool;
+    const AggregateFunction* _func = nullptr;
+    AggDataPtr _state = nullptr;
+    Columns _input_columns;
+    ColumnPtr _result_column;
+};
+
+// Run with the args {function, frame, partition_rows, window_rows}, the frame has window_rows preceding and
+// following rows for the sliding frames.
+static void Benchmark_WindowFunction(benchmark::State& state) {
+    WindowFunctionBench bench(static_cast<WindowFunctionKind>(state.range(0)), static_cast<WindowFrame>(state.range(1)),
+                              state.range(2), state.range(3));
+    for (auto _ : state) {
+        bench.evaluate();
+    }
+    state.SetItemsProcessed(state.iterations() * WindowFunctionBench::kNumRows);
+}
+
+static void WindowFunctionArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"function", "frame", "partition_rows", "window_rows"});
+    for (int64_t partition_rows : {16, 1024, 1 << 18}) {
+        for (int64_t function : {FN_ROW_NUMBER, FN_RANK, FN_DENSE_RANK}) {
+            b->Args({function, RANKING, partition_rows, 0});
+        }
+        for (int64_t function : {FN_SUM, FN_COUNT, FN_AVG, FN_MAX, FN_MIN}) {
+            b->Args({function, CUMULATIVE, partition_rows, 0});
+            for (int64_t window_rows : {2, 64}) {
+                b->Args({function, SLIDING, partition_rows, window_rows});
+                b->Args({function, SLIDING_REMOVABLE, partition_rows, window_rows});
+            }
+        }
+    }
+}
+
+BENCHMARK(Benchmark_WindowFunction)->Apply(WindowFunctionArgs)->Unit(benchmark::kMillisecond);
+
+} // namespace starrocks
+
+BENCHMARK_MAIN();
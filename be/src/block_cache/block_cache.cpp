@@ -21,6 +21,7 @@
 #include "common/logging.h"
 #include "common/statusor.h"
 #include "gutil/strings/substitute.h"
+#include "util/threadpool.h"
 
 namespace starrocks {
 
@@ -28,6 +29,8 @@ BlockCache::BlockCache() {
     _kv_cache = std::make_unique<FbCacheLib>();
 }
 
+BlockCache::~BlockCache() = default;
+
 BlockCache* BlockCache::instance() {
     static BlockCache cache;
     return &cache;
@@ -36,6 +39,14 @@ BlockCache* BlockCache::instance() {
 Status BlockCache::init(const CacheOptions& options) {
     // TODO: check block size limit
     _block_size = options.block_size;
+    if (options.async_write_threads > 0) {
+        RETURN_IF_ERROR(ThreadPoolBuilder("blockcache_write")
+                                .set_min_threads(0)
+                                .set_max_threads(options.async_write_threads)
+                                .set_idle_timeout(MonoDelta::FromMilliseconds(2000))
+                                .build(&_write_pool));
+        _async_write_buffer_size = options.async_write_buffer_size;
+    }
     return _kv_cache->init(options);
 }
 
@@ -66,6 +77,35 @@ Status BlockCache::write_cache(const CacheKey& cache_key, off_t offset, size_t s
     return Status::OK();
 }
 
+Status BlockCache::write_cache_async(const CacheKey& cache_key, off_t offset, size_t size, const char* buffer,
+                                     size_t ttl_seconds) {
+    if (_write_pool == nullptr) {
+        return write_cache(cache_key, offset, size, buffer, ttl_seconds);
+    }
+    if (_pending_write_bytes.fetch_add(size) + size > _async_write_buffer_size) {
+        _pending_write_bytes -= size;
+        return Status::ResourceBusy("too many pending block cache writes");
+    }
+    auto data = std::make_shared<std::string>(buffer, size);
+    Status st = _write_pool->submit_func([this, cache_key, offset, size, data, ttl_seconds] {
+        Status r = write_cache(cache_key, offset, size, data->data(), ttl_seconds);
+        LOG_IF(WARNING, !r.ok()) << "write block cache in background failed, errmsg: " << r.get_error_msg();
+        _pending_write_bytes -= size;
+    });
+    if (!st.ok()) {
+        _pending_write_bytes -= size;
+    }
+    return st;
+}
+
+StatusOr<KvCacheHandlePtr> BlockCache::read_block_handle(const CacheKey& cache_key, off_t offset) {
+    if (offset % _block_size != 0) {
+        return Status::InvalidArgument(strings::Substitute("offset must be aligned by block size $0", _block_size));
+    }
+    std::string block_key = fmt::format("{}/{}", cache_key, offset / _block_size);
+    return _kv_cache->read_cache_handle(block_key);
+}
+
 StatusOr<size_t> BlockCache::read_cache(const CacheKey& cache_key, off_t offset, size_t size, char* buffer) {
     if (!buffer) {
         return Status::InvalidArgument("invalid data buffer");
@@ -99,6 +139,11 @@ Status BlockCache::remove_cache(const CacheKey& cache_key, off_t offset, size_t
 }
 
 Status BlockCache::shutdown() {
+    if (_write_pool != nullptr) {
+        // flush the pending writes
+        _write_pool->wait();
+        _write_pool->shutdown();
+    }
     return _kv_cache->shutdown();
 }
 
@@ -14,15 +14,21 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "block_cache/kv_cache.h"
 #include "common/status.h"
 
 namespace starrocks {
 
+class ThreadPool;
+
 class BlockCache {
 public:
     typedef std::string CacheKey;
 
+    ~BlockCache();
+
     // Return a singleton block cache instance
     static BlockCache* instance();
 
@@ -33,13 +39,19 @@ public:
     Status write_cache(const CacheKey& cache_key, off_t offset, size_t size, const char* buffer,
                        size_t ttl_seconds = 0);
 
+    // Like `write_cache`, but the data is copied and written in background if `async_write_threads` is set,
+    // so the caller does not wait for the cache write. The write is dropped with ResourceBusy if the data
+    // waiting to be written exceeds `async_write_buffer_size`.
+    Status write_cache_async(const CacheKey& cache_key, off_t offset, size_t size, const char* buffer,
+                             size_t ttl_seconds = 0);
+
     // Read data from cache, it returns the data size if successful; otherwise the error status
     // will be returned. The offset and size must be aligned by block size.
     StatusOr<size_t> read_cache(const CacheKey& cache_key, off_t offset, size_t size, char* buffer);
 
-    // NOTICE: This function is not safe now, as the returned buffer may be evicted before visited
-    // by users. We need to implement it more safe by cachelib item handle.
-    Status read_cache_zero_copy(const CacheKey& cache_key, off_t offset, size_t size, const char** buf);
+    // Pin the block at offset and return its handle, the data of the block can be read without copy
+    // until the handle is destroyed. The offset must be aligned by block size.
+    StatusOr<KvCacheHandlePtr> read_block_handle(const CacheKey& cache_key, off_t offset);
 
     // Remove data from cache. The offset and size must be aligned by block size
     Status remove_cache(const CacheKey& cache_key, off_t offset, size_t size);
@@ -54,6 +66,10 @@ private:
 
     size_t _block_size = 0;
     std::unique_ptr<KvCache> _kv_cache;
+
+    std::unique_ptr<ThreadPool> _write_pool;
+    size_t _async_write_buffer_size = 0;
+    std::atomic<size_t> _pending_write_bytes{0};
 };
 
 } // namespace starrocks
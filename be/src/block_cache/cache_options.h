@@ -35,6 +35,10 @@ struct CacheOptions {
     bool checksum;
     size_t max_parcel_memory_mb;
     size_t max_concurrent_inserts;
+    // The number of threads writing cache in background, 0 means writing cache synchronously.
+    size_t async_write_threads = 0;
+    // The memory limit of the data waiting to be written in background.
+    size_t async_write_buffer_size = 0;
 };
 
 } // namespace starrocks
@@ -21,6 +21,19 @@
 
 namespace starrocks {
 
+// The item is pinned in cachelib as long as its read handle is held.
+class FbCacheLibHandle final : public KvCacheHandle {
+public:
+    explicit FbCacheLibHandle(FbCacheLib::ReadHandle handle) : _handle(std::move(handle)) {}
+
+    const char* data() const override { return reinterpret_cast<const char*>(_handle->getMemory()); }
+
+    size_t size() const override { return _handle->getSize(); }
+
+private:
+    FbCacheLib::ReadHandle _handle;
+};
+
 Status FbCacheLib::init(const CacheOptions& options) {
     Cache::Config config;
     config.setCacheSize(options.mem_space_size).setCacheName("default cache").setAccessConfig({25, 10}).validate();
@@ -82,6 +95,14 @@ StatusOr<size_t> FbCacheLib::read_cache(const std::string& key, char* value, siz
     return size;
 }
 
+StatusOr<KvCacheHandlePtr> FbCacheLib::read_cache_handle(const std::string& key) {
+    auto handle = _cache->find(key);
+    if (!handle) {
+        return Status::NotFound("not found cachelib item");
+    }
+    return std::make_unique<FbCacheLibHandle>(std::move(handle));
+}
+
 Status FbCacheLib::remove_cache(const std::string& key) {
     _cache->remove(key);
     return Status::OK();
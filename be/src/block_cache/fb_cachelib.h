@@ -48,6 +48,8 @@ public:
 
     StatusOr<size_t> read_cache(const std::string& key, char* value, size_t off, size_t size) override;
 
+    StatusOr<KvCacheHandlePtr> read_cache_handle(const std::string& key) override;
+
     Status remove_cache(const std::string& key) override;
 
     std::unordered_map<std::string, double> cache_stats() override;
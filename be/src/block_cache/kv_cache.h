@@ -14,11 +14,25 @@
 
 #pragma once
 
+#include <memory>
+
 #include "block_cache/cache_options.h"
 #include "common/status.h"
+#include "common/statusor.h"
 
 namespace starrocks {
 
+// A handle pinning a value in the cache, the value will not be evicted or freed until the handle is destroyed.
+class KvCacheHandle {
+public:
+    virtual ~KvCacheHandle() = default;
+
+    virtual const char* data() const = 0;
+
+    virtual size_t size() const = 0;
+};
+using KvCacheHandlePtr = std::unique_ptr<KvCacheHandle>;
+
 class KvCache {
 public:
     virtual ~KvCache() = default;
@@ -33,6 +47,9 @@ public:
     // will be returned.
     virtual StatusOr<size_t> read_cache(const std::string& key, char* value, size_t off, size_t size) = 0;
 
+    // Pin the value of key and return its handle to read it without copy, NotFound if not cached.
+    virtual StatusOr<KvCacheHandlePtr> read_cache_handle(const std::string& key) = 0;
+
     // Remove data from cache. The offset must be aligned by block size
     virtual Status remove_cache(const std::string& key) = 0;
 
@@ -14,6 +14,7 @@
 
 #include "column/chunk.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "column/column_helper.h"
@@ -43,6 +44,7 @@ Status Chunk::upgrade_if_overflow() {
             continue;
         }
     }
+    _expr_results.reset();
     return Status::OK();
 }
 
@@ -57,6 +59,7 @@ Status Chunk::downgrade() {
             continue;
         }
     }
+    _expr_results.reset();
     return Status::OK();
 }
 
@@ -110,6 +113,8 @@ void Chunk::reset() {
     }
     _delete_state = DEL_NOT_SATISFIED;
     _extra_data.reset();
+    _expr_results.reset();
+    _selection.reset();
 }
 
 void Chunk::swap_chunk(Chunk& other) {
@@ -120,12 +125,16 @@ void Chunk::swap_chunk(Chunk& other) {
     _tuple_id_to_index.swap(other._tuple_id_to_index);
     std::swap(_delete_state, other._delete_state);
     _extra_data.swap(other._extra_data);
+    _expr_results.swap(other._expr_results);
+    _selection.swap(other._selection);
+    std::swap(_num_selected_rows, other._num_selected_rows);
 }
 
 void Chunk::set_num_rows(size_t count) {
     for (ColumnPtr& c : _columns) {
         c->resize(count);
     }
+    _expr_results.reset();
 }
 
 std::string_view Chunk::get_column_name(size_t idx) const {
@@ -138,22 +147,26 @@ void Chunk::append_column(ColumnPtr column, const FieldPtr& field) {
     _cid_to_index[field->id()] = _columns.size();
     _columns.emplace_back(std::move(column));
     _schema->append(field);
+    _expr_results.reset();
     check_or_die();
 }
 
 void Chunk::append_column(ColumnPtr column, SlotId slot_id) {
     _slot_id_to_index[slot_id] = _columns.size();
     _columns.emplace_back(std::move(column));
+    _expr_results.reset();
     check_or_die();
 }
 
 void Chunk::update_column(ColumnPtr column, SlotId slot_id) {
     _columns[_slot_id_to_index[slot_id]] = std::move(column);
+    _expr_results.reset();
     check_or_die();
 }
 
 void Chunk::update_column_by_index(ColumnPtr column, size_t idx) {
     _columns[idx] = std::move(column);
+    _expr_results.reset();
     check_or_die();
 }
 
@@ -162,6 +175,7 @@ void Chunk::insert_column(size_t idx, ColumnPtr column, const FieldPtr& field) {
     _columns.emplace(_columns.begin() + idx, std::move(column));
     _schema->insert(idx, field);
     rebuild_cid_index();
+    _expr_results.reset();
     check_or_die();
 }
 
@@ -178,6 +192,7 @@ void Chunk::remove_column_by_index(size_t idx) {
         _schema->remove(idx);
         rebuild_cid_index();
     }
+    _expr_results.reset();
 }
 
 [[maybe_unused]] void Chunk::remove_columns_by_index(const std::vector<size_t>& indexes) {
@@ -264,40 +279,161 @@ std::unique_ptr<Chunk> Chunk::clone_unique() const {
     return chunk;
 }
 
+ChunkPtr Chunk::clone_with_shared_columns() const {
+    auto chunk = std::make_shared<Chunk>(_columns, _slot_id_to_index, _tuple_id_to_index, _extra_data);
+    chunk->_schema = _schema;
+    chunk->_cid_to_index = _cid_to_index;
+    chunk->_delete_state = _delete_state;
+    chunk->_owner_info = _owner_info;
+    chunk->_selection = _selection;
+    chunk->_num_selected_rows = _num_selected_rows;
+    return chunk;
+}
+
+void Chunk::_unshare_columns() {
+    for (size_t i = 0; i < _columns.size(); i++) {
+        if (_columns[i].use_count() == 1) {
+            continue;
+        }
+        // the same column may appear several times in a chunk, only the references out of this chunk count
+        const Column* column = _columns[i].get();
+        auto num_refs = std::count_if(_columns.begin(), _columns.end(),
+                                      [column](const ColumnPtr& c) { return c.get() == column; });
+        if (_columns[i].use_count() <= num_refs) {
+            continue;
+        }
+        ColumnPtr copy = column->clone_shared();
+        for (auto& c : _columns) {
+            if (c.get() == column) {
+                c = copy;
+            }
+        }
+    }
+}
+
 void Chunk::append_selective(const Chunk& src, const uint32_t* indexes, uint32_t from, uint32_t size) {
     DCHECK_EQ(_columns.size(), src.columns().size());
+    _unshare_columns();
     for (size_t i = 0; i < _columns.size(); ++i) {
         _columns[i]->append_selective(*src.columns()[i].get(), indexes, from, size);
     }
+    _expr_results.reset();
 }
 
 void Chunk::rolling_append_selective(Chunk& src, const uint32_t* indexes, uint32_t from, uint32_t size) {
     size_t num_columns = _columns.size();
     DCHECK_EQ(num_columns, src.columns().size());
+    _unshare_columns();
 
     for (size_t i = 0; i < num_columns; ++i) {
         _columns[i]->append_selective(*src.columns()[i].get(), indexes, from, size);
         src.columns()[i].reset();
     }
+    _expr_results.reset();
+    src._expr_results.reset();
 }
 
 size_t Chunk::filter(const Buffer<uint8_t>& selection, bool force) {
     if (!force && SIMD::count_zero(selection) == 0) {
         return num_rows();
     }
+    _unshare_columns();
     for (auto& column : _columns) {
         column->filter(selection);
     }
+    if (_expr_results != nullptr) {
+        for (auto& [_, column] : *_expr_results) {
+            column->filter(selection);
+        }
+    }
     return num_rows();
 }
 
+void Chunk::set_selection(FilterPtr selection) {
+    DCHECK(selection == nullptr || selection->size() == num_rows());
+    _selection = std::move(selection);
+    _num_selected_rows = _selection == nullptr ? 0 : SIMD::count_nonzero(*_selection);
+}
+
+void Chunk::materialize_selection() {
+    if (_selection == nullptr) {
+        return;
+    }
+    auto selection = std::move(_selection);
+    _selection = nullptr;
+    filter(*selection);
+}
+
+ChunkPtr Chunk::materialize_selection(const std::vector<SlotId>& slot_ids) const {
+    DCHECK(has_selection());
+    Buffer<uint32_t> indexes;
+    indexes.reserve(_num_selected_rows);
+    const auto& selection = *_selection;
+    for (uint32_t i = 0; i < selection.size(); i++) {
+        if (selection[i]) {
+            indexes.emplace_back(i);
+        }
+    }
+
+    auto chunk = std::make_shared<Chunk>();
+    for (auto slot_id : slot_ids) {
+        if (!is_slot_exist(slot_id) || chunk->is_slot_exist(slot_id)) {
+            continue;
+        }
+        const auto& column = get_column_by_slot_id(slot_id);
+        auto dst = column->clone_empty();
+        dst->append_selective(*column, indexes.data(), 0, indexes.size());
+        chunk->append_column(std::move(dst), slot_id);
+    }
+    return chunk;
+}
+
 size_t Chunk::filter_range(const Buffer<uint8_t>& selection, size_t from, size_t to) {
+    _unshare_columns();
     for (auto& column : _columns) {
         column->filter_range(selection, from, to);
     }
+    if (_expr_results != nullptr) {
+        for (auto& [_, column] : *_expr_results) {
+            column->filter_range(selection, from, to);
+        }
+    }
     return num_rows();
 }
 
+const ColumnPtr* Chunk::get_expr_result(uint64_t fingerprint) const {
+    if (_expr_results == nullptr) {
+        return nullptr;
+    }
+    auto iter = _expr_results->find(fingerprint);
+    // The columns may be modified without the chunk being aware of it.
+    if (iter == _expr_results->end() || iter->second->size() != num_rows()) {
+        return nullptr;
+    }
+    return &iter->second;
+}
+
+void Chunk::set_expr_result(uint64_t fingerprint, const ColumnPtr& column) {
+    if (column->is_constant() || column->size() != num_rows()) {
+        return;
+    }
+    // The result must not be filtered twice, by itself and its alias.
+    for (const auto& c : _columns) {
+        if (c == column) {
+            return;
+        }
+    }
+    if (_expr_results == nullptr) {
+        _expr_results = std::make_unique<ExprResults>();
+    }
+    for (const auto& [_, c] : *_expr_results) {
+        if (c == column) {
+            return;
+        }
+    }
+    _expr_results->emplace(fingerprint, column);
+}
+
 DatumTuple Chunk::get(size_t n) const {
     DatumTuple res;
     res.reserve(_columns.size());
@@ -411,17 +547,38 @@ void Chunk::merge(Chunk&& src) {
 
 void Chunk::append(const Chunk& src, size_t offset, size_t count) {
     DCHECK_EQ(num_columns(), src.num_columns());
+    _unshare_columns();
     const size_t n = src.num_columns();
     for (size_t i = 0; i < n; i++) {
         ColumnPtr& c = get_column_by_index(i);
         c->append(*src.get_column_by_index(i), offset, count);
     }
+    _expr_results.reset();
+}
+
+void Chunk::append(const std::vector<ChunkPtr>& srcs) {
+    _unshare_columns();
+    size_t total_rows = num_rows();
+    for (const auto& src : srcs) {
+        DCHECK_EQ(num_columns(), src->num_columns());
+        total_rows += src->num_rows();
+    }
+    for (auto& c : _columns) {
+        c->reserve(total_rows);
+    }
+    for (const auto& src : srcs) {
+        for (size_t i = 0; i < _columns.size(); i++) {
+            _columns[i]->append(*src->_columns[i], 0, src->num_rows());
+        }
+    }
+    _expr_results.reset();
 }
 
 void Chunk::append_safe(const Chunk& src, size_t offset, size_t count) {
     DCHECK_EQ(num_columns(), src.num_columns());
     const size_t n = src.num_columns();
     size_t cur_rows = num_rows();
+    _unshare_columns();
 
     for (size_t i = 0; i < n; i++) {
         ColumnPtr& c = get_column_by_index(i);
@@ -429,6 +586,7 @@ void Chunk::append_safe(const Chunk& src, size_t offset, size_t count) {
             c->append(*src.get_column_by_index(i), offset, count);
         }
     }
+    _expr_results.reset();
 }
 
 void Chunk::reserve(size_t cap) {
@@ -149,7 +149,10 @@ public:
     void reset_slot_id_to_index() { _slot_id_to_index.clear(); }
     size_t get_index_by_slot_id(SlotId slot_id) { return _slot_id_to_index[slot_id]; }
 
-    void set_columns(const Columns& columns) { _columns = columns; }
+    void set_columns(const Columns& columns) {
+        _columns = columns;
+        _expr_results.reset();
+    }
 
     // Create an empty chunk with the same meta and reserve it of size chunk _num_rows
     // not clone tuple column
@@ -166,6 +169,11 @@ public:
     // Create an empty chunk with the same meta and reserve it of specified size.
     ChunkUniquePtr clone_empty_with_tuple(size_t size) const;
     ChunkUniquePtr clone_unique() const;
+    // Create a chunk sharing the columns with this chunk, to hand a chunk to several consumers without copying.
+    // The columns of a chunk referenced out of it are copied on write by append/append_safe/append_selective/
+    // rolling_append_selective/filter/filter_range, other in-place modifications must only be done to the
+    // columns owned by the chunk.
+    ChunkPtr clone_with_shared_columns() const;
 
     void append(const Chunk& src) { append(src, 0, src.num_rows()); }
     void merge(Chunk&& src);
@@ -173,6 +181,9 @@ public:
     // Append |count| rows from |src|, started from |offset|, to the |this| chunk.
     void append(const Chunk& src, size_t offset, size_t count);
 
+    // Append all the rows of |srcs|, the columns are reserved for all of them at once.
+    void append(const std::vector<ChunkPtr>& srcs);
+
     // columns in chunk may have same column ptr
     // append_safe will check size of all columns in dest chunk
     // to ensure same column will not apppend repeatedly
@@ -209,6 +220,21 @@ public:
     // Return the number of rows after filter.
     size_t filter_range(const Buffer<uint8_t>& selection, size_t from, size_t to);
 
+    // The selection of a chunk marks the rows logically in it, the unselected rows are filtered out but not
+    // compacted yet, so that only the columns still needed are compacted later. Only the operators supporting
+    // it receive a chunk with a selection, see Operator::support_selection().
+    bool has_selection() const { return _selection != nullptr; }
+    const FilterPtr& selection() const { return _selection; }
+    // The n-th row is unselected if selection[n] is zero, the size of |selection| must be equal to the number
+    // of rows.
+    void set_selection(FilterPtr selection);
+    size_t num_selected_rows() const { return has_selection() ? _num_selected_rows : num_rows(); }
+    // Compact the columns to the selected rows and drop the selection, it's a no-op without a selection.
+    void materialize_selection();
+    // Return a new chunk of the selected rows of only the columns of |slot_ids|, the slots not in this chunk are
+    // ignored. This chunk is not changed.
+    ChunkPtr materialize_selection(const std::vector<SlotId>& slot_ids) const;
+
     // Return the data of n-th row.
     // This method is relatively slow and mainly used for unit tests now.
     DatumTuple get(size_t n) const;
@@ -288,8 +314,18 @@ public:
     void set_extra_data(ChunkExtraDataPtr data) { this->_extra_data = std::move(data); }
     bool has_extra_data() const { return this->_extra_data != nullptr; }
 
+    // The results of the exprs evaluated on this chunk, keyed by the fingerprints of the exprs, to be reused by
+    // the other exprs of the same fingerprint. They're filtered along with the chunk, and dropped by the other
+    // modifications of the chunk.
+    // Return nullptr if the result isn't there.
+    const ColumnPtr* get_expr_result(uint64_t fingerprint) const;
+    // Constant results and the aliases of the columns of this chunk are ignored.
+    void set_expr_result(uint64_t fingerprint, const ColumnPtr& column);
+
 private:
     void rebuild_cid_index();
+    // Copy the columns referenced out of this chunk before modifying them in place.
+    void _unshare_columns();
 
     Columns _columns;
     std::shared_ptr<Schema> _schema;
@@ -300,6 +336,12 @@ private:
     DelCondSatisfied _delete_state = DEL_NOT_SATISFIED;
     query_cache::owner_info _owner_info;
     ChunkExtraDataPtr _extra_data;
+
+    using ExprResults = phmap::flat_hash_map<uint64_t, ColumnPtr>;
+    std::unique_ptr<ExprResults> _expr_results;
+
+    FilterPtr _selection;
+    size_t _num_selected_rows = 0;
 };
 
 inline const ColumnPtr& Chunk::get_column_by_name(const std::string& column_name) const {
@@ -30,6 +30,7 @@
 #include "common/type_list.h"
 #include "gutil/dynamic_annotations.h"
 #include "runtime/current_thread.h"
+#include "util/cpu_info.h"
 
 namespace starrocks {
 
@@ -87,6 +88,15 @@ size_t column_reserved_size(const T* col) {
     }
 }
 
+// The pooled columns are bucketed by the rows reserved by them, so that a column with a large reserved buffer is
+// reused for a large chunk, rather than being handed to a small one while another large chunk has to grow from an
+// empty column.
+static constexpr size_t kColumnPoolNumSizeClasses = 3;
+
+inline size_t column_pool_size_class(size_t rows) {
+    return rows < 1024 ? 0 : (rows < 4096 ? 1 : 2);
+}
+
 template <typename T, size_t NITEM>
 struct ColumnPoolFreeBlock {
     int64_t nfree;
@@ -111,59 +121,67 @@ class CACHELINE_ALIGNED ColumnPool {
         static_assert(std::is_base_of<Column, T>::value, "Must_be_derived_of_Column");
 
     public:
-        explicit LocalPool(ColumnPool* pool) : _pool(pool) {
-            _curr_free.nfree = 0;
-            _curr_free.bytes = 0;
+        LocalPool(ColumnPool* pool, int numa_node) : _pool(pool), _numa_node(numa_node) {
+            for (auto& free : _curr_free) {
+                free.nfree = 0;
+                free.bytes = 0;
+            }
         }
 
         ~LocalPool() noexcept {
-            if (_curr_free.nfree > 0 && !_pool->_push_free_block(_curr_free)) {
-                for (size_t i = 0; i < _curr_free.nfree; i++) {
-                    ASAN_UNPOISON_MEMORY_REGION(_curr_free.ptrs[i], sizeof(T));
-                    delete _curr_free.ptrs[i];
+            for (size_t cls = 0; cls < kColumnPoolNumSizeClasses; cls++) {
+                auto& free = _curr_free[cls];
+                if (free.nfree > 0 && !_pool->_push_free_block(_numa_node, cls, free)) {
+                    for (size_t i = 0; i < free.nfree; i++) {
+                        ASAN_UNPOISON_MEMORY_REGION(free.ptrs[i], sizeof(T));
+                        delete free.ptrs[i];
+                    }
                 }
             }
             _pool->_clear_from_destructor_of_local_pool();
         }
 
-        T* get_object() {
-            if (_curr_free.nfree == 0) {
-                if (!_pool->_pop_free_block(&_curr_free)) {
-                    return nullptr;
+        // Prefer the columns of the size class of |chunk_size|, then the larger ones, which need no reallocation,
+        // and the smaller ones at last.
+        T* get_object(size_t chunk_size) {
+            const size_t target = column_pool_size_class(chunk_size);
+            for (size_t cls = target; cls < kColumnPoolNumSizeClasses; cls++) {
+                if (T* obj = _get_object(cls); obj != nullptr) {
+                    return obj;
                 }
             }
-            T* obj = _curr_free.ptrs[--_curr_free.nfree];
-            ASAN_UNPOISON_MEMORY_REGION(obj, sizeof(T));
-            auto bytes = column_bytes(obj);
-            _curr_free.bytes -= bytes;
-
-            tls_thread_status.mem_consume(bytes);
-            _pool->mem_tracker()->release(bytes);
-
-            return obj;
+            for (size_t cls = target; cls-- > 0;) {
+                if (T* obj = _get_object(cls); obj != nullptr) {
+                    return obj;
+                }
+            }
+            return nullptr;
         }
 
         void return_object(T* ptr, size_t chunk_size) {
-            if (UNLIKELY(column_reserved_size(ptr) > chunk_size)) {
+            const size_t reserved = column_reserved_size(ptr);
+            if (UNLIKELY(reserved > chunk_size)) {
                 delete ptr;
                 return;
             }
+            const size_t cls = column_pool_size_class(reserved);
+            auto& free = _curr_free[cls];
             auto bytes = column_bytes(ptr);
-            if (_curr_free.nfree < kBlockSize) {
+            if (free.nfree < kBlockSize) {
                 ASAN_POISON_MEMORY_REGION(ptr, sizeof(T));
-                _curr_free.ptrs[_curr_free.nfree++] = ptr;
-                _curr_free.bytes += bytes;
+                free.ptrs[free.nfree++] = ptr;
+                free.bytes += bytes;
 
                 tls_thread_status.mem_release(bytes);
                 _pool->mem_tracker()->consume(bytes);
 
                 return;
             }
-            if (_pool->_push_free_block(_curr_free)) {
+            if (_pool->_push_free_block(_numa_node, cls, free)) {
                 ASAN_POISON_MEMORY_REGION(ptr, sizeof(T));
-                _curr_free.nfree = 1;
-                _curr_free.ptrs[0] = ptr;
-                _curr_free.bytes = bytes;
+                free.nfree = 1;
+                free.ptrs[0] = ptr;
+                free.bytes = bytes;
 
                 tls_thread_status.mem_release(bytes);
                 _pool->mem_tracker()->consume(bytes);
@@ -175,13 +193,17 @@ class CACHELINE_ALIGNED ColumnPool {
 
         void release_large_columns(size_t limit) {
             size_t freed_bytes = 0;
-            for (size_t i = 0; i < _curr_free.nfree; i++) {
-                ASAN_UNPOISON_MEMORY_REGION(_curr_free.ptrs[i], sizeof(T));
-                freed_bytes += release_column_if_large(_curr_free.ptrs[i], limit);
-                ASAN_POISON_MEMORY_REGION(_curr_free.ptrs[i], sizeof(T));
+            for (auto& free : _curr_free) {
+                size_t block_freed_bytes = 0;
+                for (size_t i = 0; i < free.nfree; i++) {
+                    ASAN_UNPOISON_MEMORY_REGION(free.ptrs[i], sizeof(T));
+                    block_freed_bytes += release_column_if_large(free.ptrs[i], limit);
+                    ASAN_POISON_MEMORY_REGION(free.ptrs[i], sizeof(T));
+                }
+                free.bytes -= block_freed_bytes;
+                freed_bytes += block_freed_bytes;
             }
             if (freed_bytes > 0) {
-                _curr_free.bytes -= freed_bytes;
                 tls_thread_status.mem_consume(freed_bytes);
                 _pool->mem_tracker()->release(freed_bytes);
             }
@@ -190,8 +212,29 @@ class CACHELINE_ALIGNED ColumnPool {
         static void delete_local_pool(void* arg) { delete (LocalPool*)arg; }
 
     private:
+        T* _get_object(size_t cls) {
+            auto& free = _curr_free[cls];
+            if (free.nfree == 0) {
+                if (!_pool->_pop_free_block(_numa_node, cls, &free)) {
+                    return nullptr;
+                }
+            }
+            T* obj = free.ptrs[--free.nfree];
+            ASAN_UNPOISON_MEMORY_REGION(obj, sizeof(T));
+            auto bytes = column_bytes(obj);
+            free.bytes -= bytes;
+
+            tls_thread_status.mem_consume(bytes);
+            _pool->mem_tracker()->release(bytes);
+
+            return obj;
+        }
+
         ColumnPool* _pool;
-        FreeBlock _curr_free;
+        // The NUMA node of the thread when the local pool is created, the blocks of the central free list of the
+        // same node are preferred, so the reused columns are likely to be in the memory of the local node.
+        const int _numa_node;
+        FreeBlock _curr_free[kColumnPoolNumSizeClasses];
     };
 
 public:
@@ -203,13 +246,14 @@ public:
         return &p;
     }
 
+    // |chunk_size| is the expected rows of the column, the pooled column of the closest size class is returned.
     template <bool AllocOnEmpty = true>
-    T* get_column() {
+    T* get_column(size_t chunk_size = 0) {
         LocalPool* lp = _get_or_new_local_pool();
         if (UNLIKELY(lp == nullptr)) {
             return nullptr;
         }
-        T* ptr = lp->get_object();
+        T* ptr = lp->get_object(chunk_size);
         if (ptr == nullptr && AllocOnEmpty) {
             ptr = new (std::nothrow) T();
         }
@@ -232,13 +276,16 @@ public:
         free_ratio = std::min<double>(free_ratio, 1.0);
         int64_t now = butil::gettimeofday_s();
         std::vector<DynamicFreeBlock*> tmp;
-        if (now - _first_push_time > 3) {
-            //    ^^^^^^^^^^^^^^^^ read without lock by intention.
-            std::lock_guard<std::mutex> l(_free_blocks_lock);
-            int n = implicit_cast<int>(static_cast<base::identity_<int>::type>(
-                    static_cast<double>(_free_blocks.size()) * (1 - free_ratio)));
-            tmp.insert(tmp.end(), _free_blocks.begin() + n, _free_blocks.end());
-            _free_blocks.resize(n);
+        for (size_t i = 0; i < _num_central_free_lists(); i++) {
+            auto& list = _central_free_lists[i];
+            if (now - list.first_push_time > 3) {
+                //    ^^^^^^^^^^^^^^^^^^^^^ read without lock by intention.
+                std::lock_guard<std::mutex> l(list.lock);
+                int n = implicit_cast<int>(static_cast<base::identity_<int>::type>(
+                        static_cast<double>(list.blocks.size()) * (1 - free_ratio)));
+                tmp.insert(tmp.end(), list.blocks.begin() + n, list.blocks.end());
+                list.blocks.resize(n);
+            }
         }
         size_t freed_bytes = 0;
         for (DynamicFreeBlock* blk : tmp) {
@@ -273,18 +320,42 @@ public:
     ColumnPoolInfo describe_column_pool() {
         ColumnPoolInfo info;
         info.local_cnt = _nlocal.load(std::memory_order_relaxed);
-        if (_free_blocks.empty()) {
-            return info;
-        }
-        std::lock_guard<std::mutex> l(_free_blocks_lock);
-        for (DynamicFreeBlock* blk : _free_blocks) {
-            info.central_free_items += blk->nfree;
-            info.central_free_bytes += blk->bytes;
+        for (size_t i = 0; i < _num_central_free_lists(); i++) {
+            auto& list = _central_free_lists[i];
+            if (list.blocks.empty()) {
+                continue;
+            }
+            std::lock_guard<std::mutex> l(list.lock);
+            for (DynamicFreeBlock* blk : list.blocks) {
+                info.central_free_items += blk->nfree;
+                info.central_free_bytes += blk->bytes;
+            }
         }
         return info;
     }
 
 private:
+    // The central free list of a (NUMA node, size class) pair, protected by its own lock.
+    struct CentralFreeList {
+        std::mutex lock;
+        std::vector<DynamicFreeBlock*> blocks;
+        int64_t first_push_time = 0;
+    };
+
+    size_t _num_central_free_lists() const { return _num_numa_nodes * kColumnPoolNumSizeClasses; }
+
+    CentralFreeList& _central_free_list(int numa_node, size_t cls) {
+        return _central_free_lists[numa_node * kColumnPoolNumSizeClasses + cls];
+    }
+
+    int _current_numa_node() const {
+        if (_num_numa_nodes <= 1) {
+            return 0;
+        }
+        int node = CpuInfo::get_numa_node_of_core(CpuInfo::get_current_core());
+        return node >= 0 && node < _num_numa_nodes ? node : 0;
+    }
+
     static void _release_free_block(DynamicFreeBlock* blk) {
         for (size_t i = 0; i < blk->nfree; i++) {
             T* p = blk->ptrs[i];
@@ -299,7 +370,7 @@ private:
         if (LIKELY(lp != nullptr)) {
             return lp;
         }
-        lp = new (std::nothrow) LocalPool(this);
+        lp = new (std::nothrow) LocalPool(this, _current_numa_node());
         if (nullptr == lp) {
             return nullptr;
         }
@@ -327,11 +398,13 @@ private:
         // racing with new threads calling get_column().
 
         // Clear global free list.
-        _first_push_time = 0;
+        for (size_t i = 0; i < _num_central_free_lists(); i++) {
+            _central_free_lists[i].first_push_time = 0;
+        }
         release_free_columns(1.0);
     }
 
-    bool _push_free_block(const FreeBlock& blk) {
+    bool _push_free_block(int numa_node, size_t cls, const FreeBlock& blk) {
         auto* p = (DynamicFreeBlock*)malloc(offsetof(DynamicFreeBlock, ptrs) + sizeof(*blk.ptrs) * blk.nfree);
         if (UNLIKELY(p == nullptr)) {
             return false;
@@ -339,24 +412,27 @@ private:
         p->nfree = blk.nfree;
         p->bytes = blk.bytes;
         memcpy(p->ptrs, blk.ptrs, sizeof(*blk.ptrs) * blk.nfree);
-        std::lock_guard<std::mutex> l(_free_blocks_lock);
-        _first_push_time = _free_blocks.empty() ? butil::gettimeofday_s() : _first_push_time;
-        _free_blocks.push_back(p);
+        auto& list = _central_free_list(numa_node, cls);
+        std::lock_guard<std::mutex> l(list.lock);
+        list.first_push_time = list.blocks.empty() ? butil::gettimeofday_s() : list.first_push_time;
+        list.blocks.push_back(p);
         return true;
     }
 
-    bool _pop_free_block(FreeBlock* blk) {
-        if (_free_blocks.empty()) {
+    // Only the blocks of the same NUMA node are reused, a column of the remote memory is not worth reusing.
+    bool _pop_free_block(int numa_node, size_t cls, FreeBlock* blk) {
+        auto& list = _central_free_list(numa_node, cls);
+        if (list.blocks.empty()) {
             return false;
         }
-        _free_blocks_lock.lock();
-        if (_free_blocks.empty()) {
-            _free_blocks_lock.unlock();
+        list.lock.lock();
+        if (list.blocks.empty()) {
+            list.lock.unlock();
             return false;
         }
-        DynamicFreeBlock* p = _free_blocks.back();
-        _free_blocks.pop_back();
-        _free_blocks_lock.unlock();
+        DynamicFreeBlock* p = list.blocks.back();
+        list.blocks.pop_back();
+        list.lock.unlock();
         memcpy(blk->ptrs, p->ptrs, sizeof(*p->ptrs) * p->nfree);
         blk->nfree = p->nfree;
         blk->bytes = p->bytes;
@@ -365,7 +441,13 @@ private:
     }
 
 private:
-    ColumnPool() { _free_blocks.reserve(32); }
+    ColumnPool()
+            : _num_numa_nodes(std::max(1, CpuInfo::get_max_num_numa_nodes())),
+              _central_free_lists(new CentralFreeList[_num_numa_nodes * kColumnPoolNumSizeClasses]) {
+        for (size_t i = 0; i < _num_central_free_lists(); i++) {
+            _central_free_lists[i].blocks.reserve(32);
+        }
+    }
 
     ~ColumnPool() = default;
 
@@ -375,9 +457,8 @@ private:
     static std::atomic<long> _nlocal;       // NOLINT
     static std::mutex _change_thread_mutex; // NOLINT
 
-    mutable std::mutex _free_blocks_lock;
-    std::vector<DynamicFreeBlock*> _free_blocks;
-    int64_t _first_push_time = 0;
+    const int _num_numa_nodes;
+    std::unique_ptr<CentralFreeList[]> _central_free_lists;
 };
 
 using ColumnPoolList =
@@ -397,9 +478,9 @@ template <typename T>
 std::mutex ColumnPool<T>::_change_thread_mutex{}; // NOLINT
 
 template <typename T, bool AllocateOnEmpty = true>
-inline T* get_column() {
+inline T* get_column(size_t chunk_size = 0) {
     static_assert(InList<ColumnPool<T>, ColumnPoolList>::value, "Cannot use column pool");
-    return ColumnPool<T>::singleton()->template get_column<AllocateOnEmpty>();
+    return ColumnPool<T>::singleton()->template get_column<AllocateOnEmpty>(chunk_size);
 }
 
 template <typename T>
@@ -0,0 +1,99 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "util/slice.h"
+
+namespace starrocks {
+
+// StringView is a 16 bytes view of a string for the hot comparisons, e.g. sort keys. It holds the length and
+// the first 4 bytes of the string, and the rest of a string of at most 12 bytes inline, or the pointer to a
+// longer one. So most comparisons are decided by the prefixes without touching the string data, and the short
+// strings never touch it.
+//
+// The view of a long string is valid as long as the string data, e.g. the bytes of a BinaryColumn.
+class StringView {
+public:
+    static constexpr uint32_t kPrefixSize = 4;
+    static constexpr uint32_t kInlineSize = 12;
+
+    StringView() = default;
+
+    // Implicit, so that the views can be created from the slices of a BinaryColumn directly.
+    StringView(const Slice& slice) : _size(static_cast<uint32_t>(slice.size)) { // NOLINT
+        if (_size <= kInlineSize) {
+            memcpy(_data, slice.data, _size);
+        } else {
+            memcpy(_data, slice.data, kPrefixSize);
+            memcpy(_data + kPrefixSize, &slice.data, sizeof(slice.data));
+        }
+    }
+
+    uint32_t size() const { return _size; }
+    bool is_inline() const { return _size <= kInlineSize; }
+    const char* data() const { return is_inline() ? _data : _ptr(); }
+    Slice to_slice() const { return {data(), _size}; }
+
+    // The same as Slice::compare(), a negative, zero or positive value for less, equal or greater.
+    int compare(const StringView& rhs) const {
+        // the prefixes are padded with zeros, and they are compared as big endian integers to be lexicographical
+        uint32_t lhs_prefix = _load_prefix();
+        uint32_t rhs_prefix = rhs._load_prefix();
+        if (lhs_prefix != rhs_prefix) {
+            return lhs_prefix < rhs_prefix ? -1 : 1;
+        }
+        if (_size <= kPrefixSize && rhs._size <= kPrefixSize) {
+            return _size == rhs._size ? 0 : (_size < rhs._size ? -1 : 1);
+        }
+        return memcompare(data(), _size, rhs.data(), rhs._size);
+    }
+
+    bool operator==(const StringView& rhs) const {
+        // the size and the prefix
+        if (_size != rhs._size || memcmp(_data, rhs._data, kPrefixSize) != 0) {
+            return false;
+        }
+        if (is_inline()) {
+            return memcmp(_data + kPrefixSize, rhs._data + kPrefixSize, kInlineSize - kPrefixSize) == 0;
+        }
+        return memcmp(_ptr() + kPrefixSize, rhs._ptr() + kPrefixSize, _size - kPrefixSize) == 0;
+    }
+    bool operator!=(const StringView& rhs) const { return !(*this == rhs); }
+
+private:
+    uint32_t _load_prefix() const {
+        uint32_t prefix;
+        memcpy(&prefix, _data, sizeof(prefix));
+        return __builtin_bswap32(prefix);
+    }
+
+    const char* _ptr() const {
+        const char* ptr;
+        memcpy(&ptr, _data + kPrefixSize, sizeof(ptr));
+        return ptr;
+    }
+
+    uint32_t _size = 0;
+    // The prefix, followed by the rest of an inline string padded with zeros, or the pointer to a long string.
+    char _data[kInlineSize] = {};
+};
+
+static_assert(sizeof(StringView) == 16);
+
+} // namespace starrocks
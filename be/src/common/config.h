@@ -136,6 +136,11 @@ CONF_Int32(check_consistency_worker_count, "1");
 CONF_Int32(upload_worker_count, "1");
 // The count of thread to download.
 CONF_Int32(download_worker_count, "1");
+// The max number of the files transferred in parallel by an upload or download task of the backup and restore.
+CONF_mInt32(snapshot_loader_transfer_parallelism, "4");
+// The max total size of the files transferred in parallel by an upload or download task of the backup and restore,
+// a file larger than it is transferred alone.
+CONF_mInt64(snapshot_loader_max_inflight_bytes, "1073741824");
 // The count of thread to make snapshot.
 CONF_Int32(make_snapshot_worker_count, "5");
 // The count of thread to release snapshot.
@@ -156,6 +161,10 @@ CONF_mInt32(max_download_speed_kbps, "50000");
 CONF_mInt32(download_low_speed_limit_kbps, "50");
 // The download low speed time(seconds).
 CONF_mInt32(download_low_speed_time, "300");
+// The max bytes per second of all the downloads of the clones and the restores, 0 means unlimited.
+CONF_mInt64(replication_download_bytes_per_second, "0");
+// The max number of the files of a tablet downloaded in parallel by a clone task.
+CONF_mInt32(clone_download_parallelism, "4");
 // The sleep time for one second.
 CONF_Int32(sleep_one_second, "1");
 // The sleep time for five seconds.
@@ -204,6 +213,11 @@ CONF_Bool(compress_rowbatches, "true");
 // Compress ratio when shuffle row_batches in network, not in storage engine.
 // If ratio is less than this value, use uncompressed data instead.
 CONF_mDouble(rpc_compress_ratio_threshold, "1.1");
+// If true, the exchange sink chooses the compression type of every destination among none/LZ4/ZSTD adaptively,
+// by the compression ratio and the congestion of the destination, starting from the configured type.
+CONF_mBool(enable_exchange_adaptive_compression, "false");
+// The number of chunks sent to a destination between re-evaluating its adaptive compression type.
+CONF_mInt32(exchange_adaptive_compression_interval_chunks, "32");
 // Serialize and deserialize each returned row batch.
 CONF_Bool(serialize_batch, "false");
 // Interval between profile reports; in seconds.
@@ -215,6 +229,15 @@ CONF_mInt32(scanner_thread_pool_thread_num, "48");
 // Number of olap/external scanner thread pool size.
 CONF_Int32(scanner_thread_pool_queue_size, "102400");
 CONF_mDouble(scan_use_query_mem_ratio, "0.25");
+// Whether to limit the capacity of the scan chunk buffer by the consumption rate of drivers and the io time of
+// scan tasks, besides the memory usage of chunks.
+CONF_mBool(enable_chunk_buffer_feedback_capacity, "true");
+// The number of the following tablets whose segment metadata and first column pages are prefetched by
+// the olap scan in the background, when it starts to read a new tablet. 0 means disable the prefetching.
+CONF_mInt32(olap_scan_prefetch_tablet_num, "2");
+// The number of the chunks released by the consumers kept by an olap scan to reuse their columns for the next
+// chunks. 0 means disable the recycling.
+CONF_mInt32(olap_scan_recycled_chunk_num, "4");
 CONF_Int32(udf_thread_pool_size, "1");
 // Port on which to run StarRocks test backend.
 CONF_Int32(port, "20001");
@@ -235,6 +258,9 @@ CONF_mInt32(max_scan_key_num, "1024");
 CONF_mInt32(max_pushdown_conditions_per_column, "1024");
 // (Advanced) Maximum size of per-query receive-side buffer.
 CONF_mInt32(exchg_node_buffer_size_bytes, "10485760");
+// The min number of senders of a merging exchange to merge the sorted streams by a loser tree instead of the
+// cascade of two-way mergers. 0 means always merging by the cascade.
+CONF_mInt32(exchange_merge_loser_tree_min_senders, "16");
 // The block_size every block allocate for sorter.
 CONF_Int32(sorter_block_size, "8388608");
 
@@ -243,8 +269,29 @@ CONF_mInt64(column_dictionary_key_size_threshold, "0");
 // The memory_limitation_per_thread_for_schema_change unit GB.
 CONF_mInt32(memory_limitation_per_thread_for_schema_change, "2");
 CONF_mDouble(memory_ratio_for_sorting_schema_change, "0.8");
+// The max number of the threads converting the rowsets of the schema changes in parallel, shared by all the
+// schema change tasks, and the memory limitation of a task is split among its parallel rowsets. 1 or less converts
+// the rowsets of a task one by one.
+CONF_Int32(schema_change_parallel_rowset_threads, "4");
+// Whether the memory of the schema changes is counted into the memory of the loads, so that they share the memory
+// limit of the loads instead of growing beyond it.
+CONF_Bool(schema_change_share_load_memory, "false");
 
 CONF_mInt32(update_cache_expire_sec, "360");
+// The max number of primary key tablets whose primary index is loaded in background after BE starts,
+// the most recently written tablets are loaded first, 0 means disabled.
+CONF_Int32(primary_index_preload_tablet_num, "100");
+// Only the tablets written in this number of seconds before BE starts are preloaded.
+CONF_Int32(primary_index_preload_recent_write_sec, "3600");
+CONF_Int32(primary_index_preload_threads, "4");
+// Store the long keys of the in-memory primary index in an arena instead of one string per key,
+// it takes effect for the primary indexes loaded afterwards.
+CONF_mBool(enable_primary_index_compact_key, "true");
+// The number of threads to load the RowsetUpdateState of the next version of a primary key tablet while
+// the current version is being applied, so the applies of consecutive versions overlap. 0 means disabled.
+CONF_Int32(update_apply_prefetch_threads, "4");
+// The capacity in bytes of the cache of the delvecs read by the versions before the latest one, 0 means disabled.
+CONF_mInt64(versioned_del_vec_cache_capacity, "104857600");
 CONF_mInt32(file_descriptor_cache_clean_interval, "3600");
 CONF_mInt32(disk_stat_monitor_interval, "5");
 CONF_mInt32(profile_report_interval, "30");
@@ -268,6 +315,24 @@ CONF_mInt32(snapshot_expire_time_sec, "172800");
 CONF_mInt32(trash_file_expire_time_sec, "259200");
 //file descriptors cache, by default, cache 16384 descriptors
 CONF_Int32(file_descriptor_cache_capacity, "16384");
+// The number of file descriptors cached for the segment files of each data directory, the files of
+// a data directory only compete with each other for the descriptors. 0 means all the directories
+// share file_descriptor_cache_capacity.
+CONF_Int32(file_descriptor_cache_capacity_per_disk, "0");
+// Read the batched ranges of local files with io_uring if the kernel supports it, see `read_ranges_fully()`.
+CONF_Bool(enable_io_uring_read, "false");
+// The max number of reads in flight of the io_uring of each thread.
+CONF_Int32(io_uring_queue_depth, "64");
+// The reads of the segment data in the scans with direct io enabled, see `enable_scan_direct_io`, use the
+// aligned buffers of this size, at most direct_io_buffer_pool_capacity bytes of buffers are allocated.
+CONF_Int64(direct_io_buffer_size, "1048576");
+CONF_Int64(direct_io_buffer_pool_capacity, "268435456");
+// The direct io reads smaller than this are still buffered.
+CONF_mInt64(direct_io_min_read_size, "65536");
+// Record the latencies and the bytes of the reads and writes of the local, S3 and HDFS files, by the storage root
+// paths or the remote endpoints, and by the io purposes, into the metrics and the query profiles. It takes effect
+// on the files opened afterwards.
+CONF_mBool(enable_io_stats, "true");
 // minimum file descriptor number
 // modify them upon necessity
 CONF_Int32(min_file_descriptor_number, "60000");
@@ -278,6 +343,13 @@ CONF_Int64(index_stream_cache_capacity, "10737418240");
 CONF_mString(storage_page_cache_limit, "20%");
 // whether to disable page cache feature in storage
 CONF_mBool(disable_storage_page_cache, "false");
+// Whether the concurrent readers of the same page missing in the page cache, such as the concurrent queries scanning
+// the same hot tablets, wait for the first reader to read it into the page cache, instead of each reading it from file.
+CONF_mBool(enable_storage_page_cache_shared_read, "false");
+// If in (0, 1), the storage page cache is a segmented LRU, which admits the new pages to a probation segment and
+// only promotes the pages hit again to a protected segment of this ratio of the capacity, so a large scan reading
+// each page once can not flush the hot pages. 0 means plain LRU.
+CONF_Double(storage_page_cache_protected_ratio, "0");
 // whether to disable column pool
 CONF_Bool(disable_column_pool, "false");
 
@@ -303,6 +375,11 @@ CONF_mInt32(update_compaction_check_interval_seconds, "60");
 CONF_mInt32(update_compaction_num_threads_per_disk, "1");
 CONF_Int32(update_compaction_per_tablet_min_interval_seconds, "120"); // 2min
 CONF_mInt64(max_update_compaction_num_singleton_deltas, "1000");
+// The deleted rows of a primary key rowset are read and dropped again by every query scanning it, so every scan
+// adds `update_compaction_read_cost_per_scan` times the deleted bytes to the compaction score of the rowset, at
+// most `update_compaction_max_counted_scans` scans are counted. 0 disables it.
+CONF_mDouble(update_compaction_read_cost_per_scan, "0.1");
+CONF_mInt64(update_compaction_max_counted_scans, "1000");
 
 CONF_mInt32(repair_compaction_interval_seconds, "600"); // 10 min
 
@@ -320,6 +397,20 @@ CONF_mInt64(min_cumulative_compaction_failure_interval_sec, "30"); // 30s
 // This config can be set to 0, which means to forbid any compaction, for some special cases.
 CONF_mInt32(max_compaction_concurrency, "-1");
 
+// The max bytes per second read and written by the compactions on a disk, 0 means unlimited.
+CONF_mInt64(compaction_io_bytes_per_second_per_disk, "0");
+// The max ios per second issued by the compactions on a disk, 0 means unlimited.
+CONF_mInt64(compaction_io_count_per_second_per_disk, "0");
+// If the average io latency of the queries reading a disk exceeds this value, the compaction io budget of
+// the disk is reduced and the base compactions on it are paused until the latency drops, 0 means disabled.
+CONF_mInt64(compaction_query_io_latency_threshold_us, "0");
+// Link the input segments of a compaction of a duplicate key table into the output rowset without rewriting them,
+// if they are sorted by the first sort key without overlapping and there's no delete predicate to apply.
+CONF_mBool(enable_compaction_trivial_move, "true");
+// The average segment size of every input rowset must be at least this value for the trivial move,
+// so that the small segments are still merged.
+CONF_mInt64(compaction_trivial_move_min_segment_bytes, "67108864");
+
 // Threshold to logging compaction trace, in seconds.
 CONF_mInt32(compaction_trace_threshold, "60");
 
@@ -369,6 +460,37 @@ CONF_Int32(be_exit_after_disk_write_hang_second, "60");
 CONF_Double(dictionary_encoding_ratio, "0.7");
 // The minimum chunk size for dictionary encoding speculation
 CONF_Int32(dictionary_speculate_min_chunk_size, "10000");
+// Whether to use ALP encoding for the new written float/double columns of the default encoding.
+// NOTE: the segments written with it can not be read by the BE of old versions.
+CONF_mBool(enable_alp_float_encoding, "false");
+// Whether to use FSST encoding instead of plain encoding for the high-cardinality char/varchar columns
+// which are not suitable for dictionary encoding.
+// NOTE: the segments written with it can not be read by the BE of old versions.
+CONF_mBool(enable_fsst_string_encoding, "false");
+
+// Train a ZSTD dictionary per column per segment from the first data pages of at most zstd_dict_sample_size
+// bytes, if the average size of them is at most zstd_dict_max_page_size, and compress all pages of the column
+// with it. It only applies to the columns compressed by ZSTD.
+// NOTE: the segments written with it can not be read by the BE of old versions.
+CONF_mBool(enable_zstd_dict_compression, "false");
+CONF_mInt64(zstd_dict_sample_size, "1048576");
+CONF_mInt64(zstd_dict_max_page_size, "16384");
+CONF_mInt64(zstd_dict_max_size, "16384");
+// Whether to use INT_DICT_ENCODING for the integer/date columns of the default encoding, if the
+// first chunk written has no more than 256 distinct values.
+// NOTE: the segments written with it can not be read by the BE of old versions.
+CONF_mBool(enable_int_dict_encoding, "false");
+// If greater than 0, an n-gram bloom filter index with n-grams of this size is built besides the bloom
+// filter index for the char/varchar bloom filter columns, so that the pages can be skipped by `LIKE '%pattern%'`.
+// NOTE: the segments written with it can not be read by the BE of old versions.
+CONF_mInt32(ngram_bloom_filter_index_gram_size, "0");
+// Whether to build a full-text inverted index for the char/varchar bloom filter columns, which is used to
+// filter the rows by `LIKE` with a constant pattern.
+// NOTE: the segments written with it can not be read by the BE of old versions.
+CONF_mBool(enable_inverted_index, "false");
+// Whether to build zone maps for the scalar subfields of the ARRAY/MAP/STRUCT columns of the duplicate key tables,
+// the bloom filters of the subfields are built if they are bloom filter columns.
+CONF_mBool(enable_nested_column_zone_map, "true");
 
 // The maximum amount of data that can be processed by a stream load
 CONF_mInt64(streaming_load_max_mb, "102400");
@@ -376,6 +498,13 @@ CONF_mInt64(streaming_load_max_mb, "102400");
 // Therefore, it is necessary to limit the maximum number of
 // such data when using stream load to prevent excessive memory consumption.
 CONF_mInt64(streaming_load_max_batch_size_mb, "100");
+// The csv stream loads with the header "group_commit: true" and a body of at most this size are merged into
+// the group commit loads of the same table, other loads with the header are loaded as usual.
+CONF_mInt64(group_commit_max_body_bytes, "1048576");
+// A group commit load is committed when this time passed since it began ...
+CONF_mInt32(group_commit_interval_ms, "1000");
+// ... or this amount of data is buffered.
+CONF_mInt64(group_commit_max_bytes, "67108864");
 // The alive time of a TabletsChannel.
 // If the channel does not receive any data till this time,
 // the channel will be removed.
@@ -424,6 +553,14 @@ CONF_Int64(chunk_reserved_bytes_limit, "2147483648");
 // for pprof
 CONF_String(pprof_profile_dir, "${STARROCKS_HOME}/log");
 
+// The frequency in Hz the threads running queries are sampled by their cpu time, to attribute the cpu time to the
+// queries and operators, 0 disables the sampling. A prime avoids sampling in lockstep with periodic work.
+CONF_mInt32(query_cpu_profiler_frequency, "19");
+// The max number of the recent queries whose cpu samples are kept.
+CONF_mInt32(query_cpu_profiler_max_queries, "100");
+// The max number of the distinct stacks kept for a query, the samples of the other stacks are only counted.
+CONF_mInt32(query_cpu_profiler_max_stacks_per_query, "2000");
+
 // to forward compatibility, will be removed later
 CONF_mBool(enable_token_check, "true");
 
@@ -461,6 +598,12 @@ CONF_Int32(memory_max_alignment, "16");
 
 // write buffer size before flush
 CONF_mInt64(write_buffer_size, "104857600");
+// The memtable of a duplicate key table sorts the inserted rows into a sorted run once they reach this number,
+// and merges the sorted runs when it's flushed, rather than sorting all the rows at once. 0 means disable it.
+CONF_mInt64(memtable_sorted_run_rows, "131072");
+// Whether to flush the largest memtables of all the loads first when the load memory exceeds the limit,
+// rather than the memtable of the writer which happens to write.
+CONF_mBool(enable_memtable_flush_largest_first, "true");
 
 // Following 2 configs limit the memory consumption of load process on a Backend.
 // eg: memory limit to 80% of mem limit config but up to 100GB(default)
@@ -488,6 +631,16 @@ CONF_mInt32(priority_queue_remaining_tasks_increased_frequency, "512");
 
 // Sync tablet_meta when modifing meta.
 CONF_mBool(sync_tablet_meta, "false");
+// With sync_tablet_meta, the concurrent meta writes of a data dir are group committed: the first writer waits this
+// long for the others, and then writes all of their batches as one batch with one sync of the WAL. 0 disables it.
+CONF_mInt32(tablet_meta_group_commit_window_us, "200");
+// The max bytes of the batches group committed together.
+CONF_mInt64(tablet_meta_group_commit_max_bytes, "4194304");
+
+// The primary replica of a load streams a segment file to the secondary replicas in pieces of this size while the
+// segment is written, instead of sending the whole file after it's written. 0 disables it, all the replicas must
+// support it to enable it.
+CONF_mInt64(segment_replicate_piece_bytes, "0");
 
 // Default thrift rpc timeout ms.
 CONF_mInt32(thrift_rpc_timeout_ms, "5000");
@@ -511,6 +664,13 @@ CONF_Int32(routine_load_thread_pool_size, "10");
 // kafka reqeust timeout
 CONF_Int32(routine_load_kafka_timeout_second, "10");
 
+// The payload of a kafka message of csv format no smaller than this is passed to the scanner without copying.
+CONF_mInt64(routine_load_kafka_zero_copy_min_bytes, "65536");
+
+// The max number of scanners parsing the messages of a csv routine load task in parallel, bounded by the number
+// of the partitions consumed by the task. The rows of the messages are not loaded in order if it's larger than 1.
+CONF_mInt32(routine_load_kafka_parse_dop, "1");
+
 // pulsar reqeust timeout
 CONF_Int32(routine_load_pulsar_timeout_second, "10");
 
@@ -597,6 +757,27 @@ CONF_Bool(ignore_rowset_stale_unconsistent_delete, "false");
 // The chunk size for vector query engine
 CONF_Int32(vector_chunk_size, "4096");
 
+// Whether to evaluate the trees of numeric arithmetic and comparison exprs block by block in one pass,
+// instead of materializing an intermediate column for every node of the tree.
+CONF_mBool(enable_fused_arithmetic_expr, "false");
+
+// Whether to compute the function calls and casts appearing more than once in a fragment, e.g. in both the
+// conjuncts and the group by exprs, only once per chunk, and reuse the result.
+CONF_mBool(enable_expr_result_reuse, "false");
+
+// Whether to evaluate the branches calling functions of CASE WHEN and IF only on the rows selected by their
+// conditions, instead of the whole chunk.
+CONF_mBool(enable_selective_branch_evaluation, "true");
+
+// The OR'ed LIKE/REGEXP predicates with constant patterns on the same column are matched together in one pass
+// by a Hyperscan multi-pattern database, if there are at least this many of them. <= 0 means disabled.
+CONF_mInt32(multi_pattern_match_min_patterns, "3");
+
+// The rows filtered out by a SelectOperator are only marked in a selection of the chunk if the ratio of the
+// remaining rows is no less than this, and compacted by the later operators only for the columns they need.
+// A value greater than 1 means the rows are always compacted right away.
+CONF_mDouble(chunk_selection_min_density, "0.5");
+
 // Valid range: [0-1000].
 // `0` will disable late materialization.
 // `1000` will enable late materialization always.
@@ -609,12 +790,63 @@ CONF_Int32(metric_late_materialization_ratio, "1000");
 
 // Max batched bytes for each transmit request. (256KB)
 CONF_Int64(max_transmit_batched_bytes, "262144");
+// If true, the small chunks sent by the broadcast and random exchange are coalesced up to the chunk size
+// before serialized, so that they are sent in fewer and larger chunks.
+CONF_mBool(enable_exchange_coalesce_small_chunks, "true");
+// The max time in milliseconds that the coalesced chunks and the batched transmit requests of an exchange sink
+// wait for more data before sent, so that the results of the selective queries are still streamed.
+// 0 means they are sent only when they are large enough.
+CONF_mInt64(exchange_max_batch_latency_ms, "100");
 
 CONF_Int16(bitmap_max_filter_items, "30");
 
 // The bitmap max filter ratio, valid value range is: [0-1000].
 CONF_Int16(bitmap_max_filter_ratio, "1");
 
+// Whether to evaluate the arrived join runtime filter on the bitmap index dictionary of the column,
+// and skip the rows whose values can't pass the runtime filter.
+CONF_mBool(enable_runtime_filter_bitmap_index, "true");
+
+// Whether to skip evaluating the predicates on the data pages whose zone maps show that
+// all the rows of the page satisfy the predicates.
+CONF_mBool(enable_zone_map_skip_all_match_predicates, "true");
+
+// Whether to push down the comparisons between a struct subfield and a constant, e.g. `s.a = 1`, to the
+// storage layer, so that the zone maps and bloom filters of the subfield can be used to skip the pages.
+CONF_mBool(enable_struct_subfield_predicate_pushdown, "true");
+
+// Whether to evaluate the comparison predicates on the encoded FOR and bitshuffle pages before
+// reading the columns, so that only the selected rows are decoded.
+CONF_mBool(enable_encoded_page_predicate_evaluation, "true");
+
+// Whether the segments of a rowset share the dictionary of the char/varchar columns, so the codes of
+// a word are the same across the segments and the scans only translate the codes appended by each segment.
+CONF_mBool(enable_shared_segment_dictionary, "true");
+
+// Whether to keep the segment footers of each data dir in a cache file, so the segments can be opened
+// without reading their footers after a restart. The cache file is written with the tablet meta checkpoint.
+CONF_mBool(enable_segment_meta_cache, "true");
+// The max total size of the footers in the segment meta cache of each data dir.
+CONF_mInt64(segment_meta_cache_capacity, "1073741824");
+
+// Whether to encode the columns of the wide tables in parallel when writing segments. The columns are split
+// into groups of `segment_parallel_encode_columns_per_task` columns, and the groups are encoded on a pool of
+// `segment_column_encode_thread_num` threads, 0 means the number of cores.
+CONF_mBool(enable_segment_parallel_column_encode, "false");
+CONF_mInt32(segment_parallel_encode_columns_per_task, "16");
+CONF_Int32(segment_column_encode_thread_num, "0");
+
+// Whether to extract the frequent top-level fields of the JSON columns into typed subcolumns when writing
+// segments. The fields are chosen from the first chunk of each segment: at most `json_flat_max_subcolumns`
+// fields which appear with the same type in at least `json_flat_min_frequency` of the rows.
+CONF_mBool(enable_json_flat_storage, "false");
+CONF_mInt32(json_flat_max_subcolumns, "20");
+CONF_mDouble(json_flat_min_frequency, "0.8");
+
+// Whether get_json_int/double/string with a constant path walk the json strings with simdjson on-demand parser.
+// The fields skipped on demand are not validated, so a malformed string may return a value instead of NULL.
+CONF_mBool(enable_json_ondemand_extract, "true");
+
 CONF_Bool(bitmap_filter_enable_not_equal, "false");
 
 // Only 1 and 2 is valid.
@@ -666,6 +898,12 @@ CONF_mBool(enable_bitmap_union_disk_format_with_set, "false");
 // The number of scan threads pipeline engine.
 CONF_Int64(pipeline_scan_thread_pool_thread_num, "0");
 CONF_Int64(pipeline_connector_scan_thread_num_per_cpu, "8");
+// The maximum number of extra scan threads that can be started, when the scan threads are blocked by IO.
+// An extra thread is started only if a scan thread spent most of its last task waiting for IO while scan tasks are
+// queued, and it exits as soon as the IO-bound threads drop. 0 means disabled.
+CONF_Int64(pipeline_scan_thread_pool_max_io_elastic_threads, "0");
+// A scan task is regarded as IO-bound, if the ratio of its off-cpu time to its total time is at least this value.
+CONF_mDouble(pipeline_scan_io_bound_task_ratio, "0.5");
 // Queue size of scan thread pool for pipeline engine.
 CONF_Int64(pipeline_scan_thread_pool_queue_size, "102400");
 // The number of execution threads for pipeline engine.
@@ -680,15 +918,60 @@ CONF_Int64(pipeline_sink_io_thread_pool_queue_size, "102400");
 CONF_Int64(pipeline_sink_buffer_size, "64");
 // The degree of parallelism of brpc.
 CONF_Int64(pipeline_sink_brpc_dop, "64");
+// If true, the exchange sink sends the requests to a destination only within the byte credits granted by the
+// receiver, which is its share of the free receive buffer, besides the limit of pipeline_sink_brpc_dop.
+CONF_mBool(enable_exchange_credit_flow_control, "true");
+// If true, the pipeline level shuffle batches the rows of all the drivers of a remote destination into one chunk,
+// along with the driver of every row, and the receiver splits it into the drivers. It cuts the buffered chunks of
+// a channel from the dop of the destination to one. All the backends must support it before it's enabled.
+CONF_mBool(enable_exchange_receiver_side_split, "false");
 // Used to reject coming fragment instances, when the number of running drivers
 // exceeds it*pipeline_exec_thread_pool_thread_num.
 CONF_Int64(pipeline_max_num_drivers_per_exec_thread, "10240");
+// Whether to admit queries by memory reservations in QueryContextManager. A query waits in the admission queue,
+// until its reservation together with the memory demand of the admitted queries fits into the query pool.
+CONF_mBool(enable_query_mem_admission, "false");
+// The memory reserved by a query is query_admission_mem_reservation_ratio of its memory limit.
+CONF_mDouble(query_admission_mem_reservation_ratio, "0.1");
+// The ratio of the query pool limit which the admitted queries can reserve.
+CONF_mDouble(query_admission_query_pool_ratio, "0.9");
+// The queries are rejected, when the admission queue is longer than it or they wait longer than the timeout.
+CONF_mInt64(query_admission_max_queued_queries, "1024");
+CONF_mInt64(query_admission_wait_timeout_ms, "300000");
 CONF_mBool(pipeline_print_profile, "false");
+// Whether the drivers blocked by the source operators supporting readiness notification, such as exchange source,
+// local exchange source and scan operators, are woken up by notification instead of being polled continuously.
+CONF_Bool(enable_pipeline_driver_readiness_notification, "false");
+// The drivers waiting for readiness notification are still checked by the poller at this interval,
+// to handle cancellation, query expiration and the other conditions without notification.
+CONF_mInt64(pipeline_poller_notified_driver_check_interval_ms, "10");
+// Whether the idle drivers after CollectStatsSourceOperator in the passthrough state steal chunks from
+// the backlogged drivers, which re-balances the skewed input of the adaptive DOP pipeline at runtime.
+CONF_Bool(enable_pipeline_adaptive_dop_chunk_stealing, "false");
+// Whether to evaluate the conjuncts and limit of SelectNode directly above OlapScanNode in the scan io threads,
+// instead of SelectOperator and LimitOperator.
+CONF_mBool(enable_pipeline_scan_select_fusion, "false");
+// The target bytes of a chunk. If it is positive, OlapScan, ExchangeSink and ChunkAccumulate size chunks by
+// the observed row width, so that a chunk of wide rows is not larger than it. The chunk size of the query
+// is still the upper bound of the number of rows.
+CONF_mInt64(pipeline_target_chunk_bytes, "0");
 
 // The arguments of multilevel feedback pipeline_driver_queue. It prioritizes small queries over larger ones,
 // when the value of level_time_slice_base_ns is smaller and queue_ratio_of_adjacent_queue is larger.
 CONF_Int64(pipeline_driver_queue_level_time_slice_base_ns, "200000000");
 CONF_Double(pipeline_driver_queue_ratio_of_adjacent_queue, "1.2");
+// Whether to use WorkStealingDriverQueue for the pipeline executor without resource group,
+// which keeps a driver queue per executor thread and steals drivers from the others when the local one is empty.
+CONF_Bool(pipeline_driver_queue_enable_work_stealing, "false");
+// Whether the driver queue of each resource group has a short-query lane, which takes precedence over
+// the multi-level queues. The drivers of a query are put into this lane until the query has used
+// pipeline_short_query_lane_cpu_budget_ns CPU time, so that the short queries are not blocked by the big ones.
+CONF_Bool(enable_pipeline_wg_short_query_lane, "false");
+CONF_mInt64(pipeline_short_query_lane_cpu_budget_ns, "100000000");
+// Whether to bind the pipeline executor threads without resource group to NUMA nodes evenly,
+// and schedule the drivers of a fragment instance in the same NUMA node as possible.
+// It implies pipeline_driver_queue_enable_work_stealing.
+CONF_Bool(enable_pipeline_numa_aware_executor, "false");
 // 0 represents PriorityScanTaskQueue (by default), while 1 represents MultiLevelFeedScanTaskQueue.
 // - PriorityScanTaskQueue prioritizes scan tasks with lower committed times.
 // - MultiLevelFeedScanTaskQueue prioritizes scan tasks with shorter execution time.
@@ -698,6 +981,9 @@ CONF_Int64(pipeline_scan_queue_mode, "0");
 // when the value of level_time_slice_base_ns is smaller and queue_ratio_of_adjacent_queue is larger.
 CONF_Int64(pipeline_scan_queue_level_time_slice_base_ns, "100000000");
 CONF_Double(pipeline_scan_queue_ratio_of_adjacent_queue, "1.5");
+// The maximum number of scan tasks of the same disk, which are queued or running in the scan executor.
+// The exceeded tasks are pended until a task of the disk is finished. 0 means unlimited.
+CONF_mInt64(pipeline_scan_max_in_flight_tasks_per_disk, "0");
 
 /// For parallel scan on the single tablet.
 // These three configs are used to calculate the minimum number of rows picked up from a segment at one time.
@@ -752,17 +1038,59 @@ CONF_mInt32(parquet_buffer_stream_reserve_size, "1048576");
 CONF_mBool(parquet_coalesce_read_enable, "true");
 CONF_mInt32(parquet_header_max_size, "16384");
 CONF_Bool(parquet_late_materialization_enable, "true");
+// Filter the pages of the row groups by the min/max conjuncts with the page index (ColumnIndex/OffsetIndex),
+// and skip decoding the pages which cannot match.
+CONF_mBool(parquet_page_index_enable, "true");
+// Skip the row groups by the bloom filters of the columns with equal or in conjuncts.
+CONF_mBool(parquet_bloom_filter_enable, "true");
+// The capacity in bytes of the cache of the parquet footers, the orc file tails and the iceberg deleted positions,
+// which is shared by the scans of the external tables, 0 disables the cache.
+CONF_mInt64(file_meta_cache_capacity, "268435456");
+// Whether to encode the columns of the parquet files written by the file sinks and EXPORT in parallel. The columns
+// are encoded on a pool of `parquet_column_encode_thread_num` threads, 0 means the number of cores.
+CONF_mBool(enable_parquet_parallel_column_encode, "true");
+CONF_Int32(parquet_column_encode_thread_num, "0");
 
 CONF_Int32(io_coalesce_read_max_buffer_size, "8388608");
 CONF_Int32(io_coalesce_read_max_distance_size, "1048576");
+// When a coalesced buffer is read, the next buffers not read yet, at most this number of bytes, are read
+// together, the remote file systems fetch them in parallel. 0 means no prefetch.
+CONF_mInt64(io_coalesce_read_max_prefetch_size, "0");
 
 CONF_Int32(connector_io_tasks_per_scan_operator, "16");
+// Whether the JNI scanners read the next chunk in the background while the current chunk is converted and consumed.
+// The chunks are read on a pool of `jni_scanner_prefetch_thread_num` threads, 0 means the number of cores.
+CONF_mBool(jni_scanner_prefetch_enable, "true");
+CONF_Int32(jni_scanner_prefetch_thread_num, "0");
+// The small scan ranges of the external tables are read one after another by one data source, until their total
+// length reaches `connector_coalesce_scan_ranges_bytes` or their number reaches
+// `connector_coalesce_scan_ranges_max_num`, so that the setup of the scan is shared among the files.
+// The ranges are coalesced only if there are enough of them to keep all the io tasks busy. 0 disables it.
+CONF_mInt64(connector_coalesce_scan_ranges_bytes, "67108864");
+CONF_mInt32(connector_coalesce_scan_ranges_max_num, "64");
+// The next coalesced file not larger than `connector_small_file_prefetch_bytes` is read into memory in the
+// background while the current one is scanned, 0 disables the prefetching. The files are read on a pool of
+// `connector_small_file_prefetch_thread_num` threads, 0 means the number of cores.
+CONF_mInt64(connector_small_file_prefetch_bytes, "2097152");
+CONF_Int32(connector_small_file_prefetch_thread_num, "0");
+
+// A parquet or orc file range of a load larger than this is split into ranges of this size, which are scanned in
+// parallel and read the row groups or stripes starting in them. 0 disables the splitting.
+CONF_mInt64(file_scan_range_split_bytes, "268435456");
 CONF_Int32(io_tasks_per_scan_operator, "4");
 CONF_Bool(connector_chunk_source_accumulate_chunk_enable, "true");
 CONF_Bool(connector_dynamic_chunk_buffer_limiter_enable, "true");
 CONF_Bool(connector_min_max_predicate_from_runtime_filter_enable, "true");
 CONF_Bool(scan_node_always_shared_scan, "false");
+// Whether an olap scan operator steals unstarted morsels from the other scan operators, after its own morsels
+// are exhausted. It only takes effect when the morsels are distributed to the operators without the requirement of
+// tablet locality, that is, not for colocate or bucket shuffle plans.
+CONF_mBool(enable_pipeline_scan_morsel_stealing, "false");
 CONF_Bool(connector_scan_node_always_shared_scan, "true");
+// Hand out the scan ranges of lake tablets whose segments are in the local cache first, and prefetch the
+// uncached ones by the cache warmer in the meantime.
+CONF_mBool(enable_lake_cache_aware_scan, "false");
+CONF_mBool(lake_cache_aware_scan_prefetch, "true");
 
 // Enable output trace logs in aws-sdk-cpp for diagnosis purpose.
 // Once logging is enabled in your application, the SDK will generate log files in your current working directory
@@ -776,20 +1104,112 @@ CONF_String(aws_sdk_logging_trace_level, "trace");
 CONF_mInt64(experimental_s3_max_single_part_size, "16777216");
 // default: 16MB
 CONF_mInt64(experimental_s3_min_upload_part_size, "16777216");
+// The parts of a multipart upload are uploaded in parallel by at most s3_upload_parallel_threads threads,
+// each upload stream has at most this size of parts in flight. 0 means uploading the parts serially.
+CONF_mInt64(s3_upload_max_inflight_bytes, "67108864");
+CONF_Int32(s3_upload_parallel_threads, "16");
+CONF_mInt32(s3_upload_part_max_retries, "2");
+// The reads of S3 objects at least twice of this size are split into the parts of this size, which are fetched
+// in parallel by at most s3_read_parallel_threads threads. 0 means no split.
+CONF_mInt64(s3_read_part_size, "4194304");
+CONF_Int32(s3_read_parallel_threads, "16");
+
+// Send a duplicate of the HDFS and S3 reads slower than hedged_read_percentile of the recent reads,
+// at least hedged_read_min_threshold_ms, and take the first response.
+CONF_mBool(enable_hedged_read, "false");
+CONF_mDouble(hedged_read_percentile, "95");
+CONF_mInt64(hedged_read_min_threshold_ms, "50");
+// The duplicates are limited to this percentage of the reads.
+CONF_mInt64(hedged_read_budget_percent, "5");
+// The reads larger than this are not hedged, each attempt reads into its own buffer.
+CONF_mInt64(hedged_read_max_size, "16777216");
+CONF_Int32(hedged_read_threads, "64");
 
 CONF_Int64(max_load_dop, "16");
 
+// OlapTableSink gathers the rows of several input chunks for a node until they are no smaller than this before
+// sending them, so that narrow rows of many partitions are not sent in many tiny requests. 0 means sending the rows
+// once there are chunk_size of them.
+CONF_mInt64(tablet_sink_batch_bytes, "1048576");
+// The max number of the rows sent by OlapTableSink to a node in one request.
+CONF_mInt32(tablet_sink_max_batch_rows, "65536");
+// The number of the add chunk requests of a node channel in flight, if load_dop is not set by the query.
+CONF_mInt32(tablet_sink_max_in_flight_requests, "1");
+
 CONF_Bool(enable_load_colocate_mv, "false");
 
 CONF_Int64(meta_threshold_to_manual_compact, "10737418240"); // 10G
 CONF_Bool(manual_compact_before_data_dir_load, "false");
 
+// The bucket array of a join hash table larger than 16 times of this size is built sub table by sub table
+// of this size, so that the bucket chains are linked in the cache. 0 means building it directly.
+CONF_mInt64(join_hash_table_radix_build_sub_table_bytes, "262144");
+
+// The probe of a join hash table whose bucket array is larger than this size prefetches the buckets and
+// the first rows of the bucket chains ahead. A negative value disables the prefetch.
+CONF_mInt64(join_hash_table_probe_prefetch_min_bytes, "4194304");
+
+// The single int32/int64 join key whose range (max - min + 1) is within this multiple of the build row count
+// is mapped to the buckets directly by (key - min) instead of hashing it. 0 means disabled.
+CONF_mInt32(join_dense_range_direct_mapping_ratio, "2");
+
+// The nestloop inner join evaluates the join conjuncts comparing a probe column with a build column directly over
+// one probe row and a build chunk, and permutes only the matched build rows.
+CONF_mBool(enable_nljoin_block_predicate, "true");
+
+// The hash table of the left semi/anti joins without other join conjuncts keeps only the join keys of the
+// build rows, and links only the first build row of every distinct key, unless the join is spillable.
+CONF_mBool(enable_hash_join_key_only_build, "true");
+
+// The drivers of a finalizing blocking aggregation with group by aggregate their own input rows and merge the hash
+// tables by hash partitions of the groups, instead of shuffling the input rows by a local exchange. It saves the
+// shuffle of the rows if the groups are reduced well, but every driver may hold all the groups before merging.
+CONF_mBool(enable_agg_partitioned_merge, "false");
+
+// The states of the aggregations grouped by one int/bigint column, or several small integer columns packed into
+// 4 bytes, are mapped by a flat array indexed by the key if the first keys are in a small range, and the keys out
+// of the range are mapped by a hash map.
+CONF_mBool(enable_agg_dense_range_hash_map, "true");
+// The max number of the slots of the flat array above.
+CONF_mInt64(agg_dense_range_hash_map_max_slots, "65536");
+// Whether to keep the states of sum, count, min and max of numeric types of the hash aggregations in arrays
+// indexed by the group ids instead of in the state blobs of the groups.
+CONF_mBool(enable_agg_columnar_states, "true");
+// Whether to back the large hash tables of aggregations and joins and the chunks of the agg state pools by the
+// transparent huge pages, which takes effect if /sys/kernel/mm/transparent_hugepage/enabled is madvise or always.
+CONF_mBool(enable_hash_table_huge_pages, "true");
+// Whether to shuffle the sorted input of a partitioned analytic node by the partition columns if it's gathered into
+// one driver, so that the partitions are evaluated by all the drivers in parallel.
+CONF_mBool(enable_analytic_partition_wise_parallel, "true");
+// The min number of rows of a range sorted by the LSD radix sort instead of pdqsort in the full sort, if the sort key
+// is an integer, decimal, date or datetime. 0 to disable the radix sort.
+CONF_mInt64(sort_radix_sort_threshold, "4096");
+// Sort the rows by comparing the memcmp-able normalized keys instead of column by column in the full sort, if the
+// ORDER BY has more than one key and all the keys are integers, decimals, dates, datetimes or strings.
+CONF_mBool(enable_sort_normalized_keys, "true");
+// The bytes of a string encoded into the normalized key, the rows whose strings are equal on the prefix but longer
+// than it are tie-broken column by column. At most 254.
+CONF_mInt64(sort_normalized_key_string_prefix, "16");
+// The max number of threads merging the sorted runs of the full sorts in parallel, the sorted runs are split into
+// slices of disjoint key ranges, which are merged concurrently and output in order. 0 means merging the sorted runs
+// by the single source driver.
+CONF_Int32(sort_parallel_merge_threads, "16");
+// The min number of rows of a full sort to merge its sorted runs in parallel.
+CONF_mInt64(sort_parallel_merge_min_rows, "1000000");
+
 // size of grf generated by broadcast join below this limit, multiple rf copy will be delivered in passthrough
 // style, otherwise, rf will be relayed by other be.
 CONF_Int64(deliver_broadcast_rf_passthrough_bytes_limit, "131072");
 // in passthrough style, the number of inflight RPCs of parallel deliveries are issued is not exceeds this limit.
 CONF_Int64(deliver_broadcast_rf_passthrough_inflight_num, "10");
 CONF_Int64(send_rpc_runtime_filter_timeout_ms, "1000");
+// The bloom filter of the runtime filter sent to other nodes is folded in half repeatedly, as long as the ratio of
+// the set bits of the folded filter doesn't exceed this limit, which trades a few false positives for smaller
+// filters. 0 means never folding.
+CONF_mDouble(runtime_filter_fold_max_fill_ratio, "0.25");
+// The integer join runtime filter becomes an exact bitset over [min, max] of the build keys instead of a bloom
+// filter, if the bitset is not larger than the bloom filter.
+CONF_mBool(enable_runtime_filter_dense_bitset, "true");
 
 // enable optimized implementation of schema change
 CONF_Bool(enable_schema_change_v2, "true");
@@ -814,6 +1234,21 @@ CONF_Int64(lake_gc_metadata_check_interval, /*30 minutes=*/"1800");
 CONF_Int64(lake_gc_segment_check_interval, /*60 minutes=*/"3600");
 // This value should be much larger than the maximum timeout of loading/compaction/schema change jobs.
 CONF_Int64(lake_gc_segment_expire_seconds, /*3 days=*/"259200");
+// The max bytes per second loaded by the cache warmup of lake tablets, 0 means unlimited.
+CONF_mInt64(lake_cache_warmup_max_bytes_per_second, "0");
+// The file to record the lake tablets warmed up, which are warmed up again after restart.
+// Empty means not recorded.
+CONF_String(lake_cache_warmup_meta_file, "");
+// Keep the primary index of lake tablets in a PersistentIndex on the local disks, so it is
+// loaded from the local files instead of being rebuilt from all segments after eviction or restart.
+CONF_mBool(enable_lake_persistent_index, "false");
+// Split the horizontal compaction of a lake tablet into at most `lake_compaction_max_sub_ranges` ranges of the
+// first key column, which are merged concurrently into separate segments of the same output rowset. Every range
+// covers at least `lake_compaction_min_sub_range_bytes` bytes of the input, and 1 disables the split. The ranges
+// are merged on a pool of `lake_compaction_sub_range_thread_num` threads, 0 means the number of cores.
+CONF_mInt32(lake_compaction_max_sub_ranges, "4");
+CONF_mInt64(lake_compaction_min_sub_range_bytes, /*1GB=*/"1073741824");
+CONF_Int32(lake_compaction_sub_range_thread_num, "0");
 
 CONF_mBool(dependency_librdkafka_debug_enable, "false");
 
@@ -840,7 +1275,22 @@ CONF_Int32(jdbc_connection_idle_timeout_ms, "600000");
 
 // spill dirs
 CONF_String(spill_local_storage_dir, "spill");
+// The remote storage that the spilled files overflow to when the local disks are exhausted, e.g.
+// s3://bucket/spill, empty means spilling to the local disks only.
+CONF_String(spill_remote_storage_path, "");
+// The max bytes of the local spilled files of a query before overflowing to the remote storage, -1 means no limit.
+// It only works with spill_remote_storage_path.
+CONF_mInt64(spill_local_max_bytes_per_query, "-1");
 CONF_mBool(experimental_spill_skip_sync, "false");
+// The block compression of the spilled chunks: lz4, zstd or none. lz4 costs less cpu, while zstd saves more io.
+CONF_mString(spill_compression_type, "lz4");
+// Whether to encode the integers of the spilled chunks by streamvbyte before compressed.
+CONF_mBool(enable_spill_integer_encoding, "true");
+// The max chunks read ahead by every sorted run of a spilled partition while restoring it.
+CONF_mInt32(spill_restore_prefetch_chunks, "8");
+// The memory of the chunks read ahead by all the sorted runs of a spilled partition. Every run still reads
+// one chunk ahead when it's exceeded, which is required by the merge.
+CONF_mInt64(spill_restore_prefetch_bytes, "67108864");
 
 // Now, only get_info is processed by _async_thread_pool, and only needs a small number of threads.
 // The default value is set as the THREAD_POOL_SIZE of RoutineLoadTaskScheduler of FE.
@@ -882,14 +1332,43 @@ CONF_Int64(block_cache_max_concurrent_inserts, "1000000");
 // Once this is reached, requests will be rejected until the parcel memory usage gets under the limit.
 CONF_Int64(block_cache_max_parcel_memory_mb, "256");
 CONF_Bool(block_cache_report_stats, "false");
+// The number of threads filling block cache in background after the remote reads, so the scans do not wait for
+// the cache writes. 0 means filling block cache synchronously.
+CONF_Int64(block_cache_async_write_threads, "0");
+// The memory limit of the data waiting to be filled in background, the fills exceeding it are dropped.
+CONF_Int64(block_cache_async_write_buffer_size, "268435456");
 
 CONF_mInt64(l0_l1_merge_ratio, "10");
 CONF_mInt64(l0_max_file_size, "209715200"); // 200MB
 CONF_mInt64(l0_max_mem_usage, "67108864");  // 64MB
 CONF_mInt64(max_tmp_l1_num, "10");
+// Build a bloom filter for each shard of the L1 files of persistent index and keep it in memory, so the
+// lookups of the keys not in a shard, such as the inserts of new keys, skip reading the shard from disk.
+CONF_mBool(enable_pindex_bloom_filter, "true");
+// The false positive probability of the bloom filters of persistent index.
+CONF_mDouble(pindex_bloom_filter_fpp, "0.05");
+// The max number of threads probing the shards of the L1 files of persistent index concurrently for the batches
+// of at least pindex_parallel_probe_min_keys keys. 0 means probing the shards serially.
+CONF_Int32(pindex_parallel_probe_threads, "16");
+CONF_mInt64(pindex_parallel_probe_min_keys, "4096");
 
 // Used by query cache, cache entries are evicted when it exceeds its capacity(500MB in default)
 CONF_Int64(query_cache_capacity, "536870912");
+// Whether the query cache keeps the entries serialized and compressed by lz4, so that they take several times less
+// memory, at the cost of decompressing an entry on every hit.
+CONF_mBool(query_cache_compress_entries, "true");
+// Whether the compressed entries evicted from the query cache are written to the block cache, which is usually on
+// the local disks, and moved back to the memory when they are hit again. It takes effect only if the block cache is
+// enabled.
+CONF_mBool(query_cache_spill_to_block_cache, "false");
+
+// The root directory of the state tables of the incremental materialized views, every state table is kept in a
+// RocksDB instance under it.
+CONF_String(stream_state_table_dir, "${STARROCKS_HOME}/storage/stream_state");
+
+// Used by the hash joins with the build side digests to share the built hash tables across queries,
+// cache entries are evicted when it exceeds its capacity(1GB in default), 0 means disabled.
+CONF_Int64(join_hash_table_cache_capacity, "1073741824");
 
 // Used to limit buffer size of tablet send channel.
 CONF_mInt64(send_channel_buffer_limit, "67108864");
@@ -46,6 +46,7 @@
 #include "common/config.h"
 #include "common/minidump.h"
 #include "exec/workgroup/work_group.h"
+#include "runtime/exec_env.h"
 #include "runtime/memory/mem_chunk_allocator.h"
 #include "runtime/time_types.h"
 #include "runtime/user_function_cache.h"
@@ -89,6 +90,14 @@ private:
     size_t _freed_bytes = 0;
 };
 
+static bool under_memory_pressure() {
+    auto* tracker = ExecEnv::GetInstance()->process_mem_tracker();
+    if (tracker == nullptr || !tracker->has_limit()) {
+        return false;
+    }
+    return tracker->consumption() > tracker->limit() * config::memory_high_level / 100;
+}
+
 void gc_memory(void* arg_this) {
     using namespace starrocks;
     const static float kFreeRatio = 0.5;
@@ -100,7 +109,8 @@ void gc_memory(void* arg_this) {
 #if !defined(ADDRESS_SANITIZER) && !defined(LEAK_SANITIZER) && !defined(THREAD_SANITIZER) && !defined(USE_JEMALLOC)
         MallocExtension::instance()->MarkThreadBusy();
 #endif
-        ReleaseColumnPool releaser(kFreeRatio);
+        // Release all the idle columns of the column pools if the process memory exceeds memory_high_level.
+        ReleaseColumnPool releaser(under_memory_pressure() ? 1.0 : kFreeRatio);
         ForEach<ColumnPoolList>(releaser);
         LOG_IF(INFO, releaser.freed_bytes() > 0) << "Released " << releaser.freed_bytes() << " bytes from column pool";
 
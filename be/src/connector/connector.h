@@ -42,6 +42,12 @@ public:
     virtual Status get_next(RuntimeState* state, ChunkPtr* chunk) { return Status::OK(); }
     virtual bool has_any_predicate() const { return _has_any_predicate; }
 
+    // Whether the data source could read more scan ranges after its current ones, so that a batch of small scan
+    // ranges is read by one data source and shares its setup.
+    virtual bool can_add_scan_range() const { return false; }
+    // Read |scan_range| after the current scan ranges, it's called before open.
+    virtual void add_scan_range(const TScanRange& scan_range) {}
+
     // how many rows read from storage
     virtual int64_t raw_rows_read() const = 0;
     // how many rows returned after filtering.
@@ -22,6 +22,8 @@
 #include "exec/hdfs_scanner_text.h"
 #include "exec/jni_scanner.h"
 #include "exprs/expr.h"
+#include "runtime/current_thread.h"
+#include "runtime/exec_env.h"
 #include "storage/chunk_helper.h"
 
 namespace starrocks::connector {
@@ -45,7 +47,7 @@ DataSourcePtr HiveDataSourceProvider::create_data_source(const TScanRange& scan_
 // ================================
 
 HiveDataSource::HiveDataSource(const HiveDataSourceProvider* provider, const TScanRange& scan_range)
-        : _provider(provider), _scan_range(scan_range.hdfs_scan_range) {}
+        : _provider(provider), _scan_range(scan_range.hdfs_scan_range), _scan_ranges_bytes(_scan_range.length) {}
 
 Status HiveDataSource::_check_all_slots_nullable() {
     for (const auto* slot : _tuple_desc->slots()) {
@@ -66,7 +68,7 @@ Status HiveDataSource::open(RuntimeState* state) {
         return Status::RuntimeError("env 'JAVA_HOME' is not set");
     }
     const auto& hdfs_scan_node = _provider->_hdfs_scan_node;
-    if (_scan_range.file_length == 0) {
+    if (_scan_range.file_length == 0 && _next_scan_ranges.empty()) {
         _no_data = true;
         return Status::OK();
     }
@@ -87,18 +89,118 @@ Status HiveDataSource::open(RuntimeState* state) {
         _enable_populate_block_cache = state->query_options().enable_populate_block_cache;
     }
 
+    // the setup is shared by all the coalesced scan ranges.
     RETURN_IF_ERROR(_init_conjunct_ctxs(state));
     _init_tuples_and_slots(state);
     _init_counter(state);
+    COUNTER_UPDATE(_profile.coalesced_scan_ranges_counter, _next_scan_ranges.size());
+    return _open_scan_range(state);
+}
+
+bool HiveDataSource::can_add_scan_range() const {
+    return _scan_ranges_bytes < config::connector_coalesce_scan_ranges_bytes;
+}
+
+void HiveDataSource::add_scan_range(const TScanRange& scan_range) {
+    _next_scan_ranges.emplace_back(scan_range.hdfs_scan_range);
+    _scan_ranges_bytes += scan_range.hdfs_scan_range.length;
+}
+
+Status HiveDataSource::_open_scan_range(RuntimeState* state) {
+    _no_data = false;
+    if (_scan_range.file_length == 0) {
+        _no_data = true;
+        return Status::OK();
+    }
     RETURN_IF_ERROR(_init_partition_values());
     if (_filter_by_eval_partition_conjuncts) {
         _no_data = true;
         return Status::OK();
     }
     RETURN_IF_ERROR(_init_scanner(state));
+    _start_prefetch();
     return Status::OK();
 }
 
+Status HiveDataSource::_open_next_scan_range(RuntimeState* state) {
+    _close_scanner(state);
+    _file_contents = _wait_prefetch();
+    _scan_range = std::move(_next_scan_ranges[_next_scan_range_idx++]);
+    return _open_scan_range(state);
+}
+
+void HiveDataSource::_close_scanner(RuntimeState* state) {
+    if (_scanner == nullptr) {
+        return;
+    }
+    _scanner->close(state);
+    _closed_raw_rows_read += _scanner->raw_rows_read();
+    _closed_num_rows_read += _scanner->num_rows_read();
+    _closed_num_bytes_read += _scanner->num_bytes_read();
+    _closed_cpu_time_spent += _scanner->cpu_time_spent();
+    _scanner = nullptr;
+}
+
+void HiveDataSource::_start_prefetch() {
+    DCHECK(!_prefetch_future.valid());
+    if (_next_scan_range_idx >= _next_scan_ranges.size()) {
+        return;
+    }
+    const auto& scan_range = _next_scan_ranges[_next_scan_range_idx];
+    // only the files read by the native scanners, the ones read by JNI are opened by the java readers.
+    bool use_jni_reader = scan_range.__isset.use_hudi_jni_reader && scan_range.use_hudi_jni_reader;
+    if (use_jni_reader || scan_range.file_length <= 0 ||
+        scan_range.file_length > config::connector_small_file_prefetch_bytes) {
+        return;
+    }
+    auto path_or = _native_file_path(scan_range);
+    if (!path_or.ok()) {
+        return;
+    }
+
+    auto file = std::make_shared<PrefetchedFile>();
+    file->path = std::move(path_or.value());
+    file->file_size = scan_range.file_length;
+    const auto& hdfs_scan_node = _provider->_hdfs_scan_node;
+    FSOptions fs_options(hdfs_scan_node.__isset.cloud_configuration ? &hdfs_scan_node.cloud_configuration : nullptr);
+    auto promise = std::make_shared<std::promise<void>>();
+    MemTracker* mem_tracker = CurrentThread::mem_tracker();
+    auto prefetch = [file, fs_options, promise, mem_tracker]() {
+        SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(mem_tracker);
+        file->status = [&]() -> Status {
+            ASSIGN_OR_RETURN(auto fs, FileSystem::CreateUniqueFromString(file->path, fs_options));
+            ASSIGN_OR_RETURN(auto rf, fs->new_random_access_file(file->path));
+            auto contents = std::make_shared<std::string>();
+            contents->resize(file->file_size);
+            RETURN_IF_ERROR(rf->read_at_fully(0, contents->data(), file->file_size));
+            file->contents = std::move(contents);
+            return Status::OK();
+        }();
+        promise->set_value();
+    };
+    ThreadPool* pool = ExecEnv::GetInstance()->small_file_prefetch_pool();
+    // the file is read by the scanner as usual if the pool is full.
+    if (pool != nullptr && pool->submit_func(std::move(prefetch)).ok()) {
+        _prefetched_file = std::move(file);
+        _prefetch_future = promise->get_future();
+    }
+}
+
+std::shared_ptr<const std::string> HiveDataSource::_wait_prefetch() {
+    if (!_prefetch_future.valid()) {
+        return nullptr;
+    }
+    _prefetch_future.get();
+    auto file = std::move(_prefetched_file);
+    if (!file->status.ok()) {
+        // the scanner reads the file again and reports the error if any.
+        LOG(WARNING) << "failed to prefetch file " << file->path << ": " << file->status;
+        return nullptr;
+    }
+    COUNTER_UPDATE(_profile.prefetched_files_counter, 1);
+    return file->contents;
+}
+
 void HiveDataSource::_update_has_any_predicate() {
     auto f = [&]() {
         if (_conjunct_ctxs.size() > 0) return true;
@@ -135,6 +237,9 @@ Status HiveDataSource::_init_conjunct_ctxs(RuntimeState* state) {
 
 Status HiveDataSource::_init_partition_values() {
     if (!(_hive_table != nullptr && _has_partition_columns)) return Status::OK();
+    if (_scan_range.partition_id == _partition_values_id) return Status::OK();
+    _partition_values_id = -1;
+    _filter_by_eval_partition_conjuncts = false;
 
     auto* partition_desc = _hive_table->get_partition(_scan_range.partition_id);
     if (partition_desc == nullptr) {
@@ -170,6 +275,7 @@ Status HiveDataSource::_init_partition_values() {
             _filter_by_eval_partition_conjuncts = true;
         }
     }
+    _partition_values_id = _scan_range.partition_id;
     return Status::OK();
 }
 
@@ -255,6 +361,8 @@ void HiveDataSource::_init_counter(RuntimeState* state) {
     _profile.bytes_read_counter = ADD_COUNTER(_runtime_profile, "BytesRead", TUnit::BYTES);
 
     _profile.scan_ranges_counter = ADD_COUNTER(_runtime_profile, "ScanRanges", TUnit::UNIT);
+    _profile.coalesced_scan_ranges_counter = ADD_COUNTER(_runtime_profile, "CoalescedScanRanges", TUnit::UNIT);
+    _profile.prefetched_files_counter = ADD_COUNTER(_runtime_profile, "PrefetchedFiles", TUnit::UNIT);
 
     _profile.reader_init_timer = ADD_TIMER(_runtime_profile, "ReaderInit");
     _profile.open_file_timer = ADD_TIMER(_runtime_profile, "OpenFile");
@@ -312,6 +420,21 @@ static void build_nested_fields(const TypeDescriptor& type, const std::string& p
     }
 }
 
+StatusOr<std::string> HiveDataSource::_native_file_path(const THdfsScanRange& scan_range) const {
+    if (_hive_table == nullptr || !_hive_table->has_partition()) {
+        return scan_range.full_path;
+    }
+    auto* partition_desc = _hive_table->get_partition(scan_range.partition_id);
+    if (partition_desc == nullptr) {
+        return Status::InternalError(
+                fmt::format("Plan inconsistency. scan_range.partition_id = {} not found in partition description map",
+                            scan_range.partition_id));
+    }
+    std::filesystem::path file_path(partition_desc->location());
+    file_path /= scan_range.relative_path;
+    return file_path.native();
+}
+
 HdfsScanner* HiveDataSource::_create_hudi_jni_scanner() {
     const auto& scan_range = _scan_range;
     const auto* hudi_table = dynamic_cast<const HudiTableDescriptor*>(_hive_table);
@@ -377,20 +500,10 @@ HdfsScanner* HiveDataSource::_create_hudi_jni_scanner() {
 
 Status HiveDataSource::_init_scanner(RuntimeState* state) {
     const auto& scan_range = _scan_range;
-    std::string native_file_path = scan_range.full_path;
-    if (_hive_table != nullptr && _hive_table->has_partition()) {
-        auto* partition_desc = _hive_table->get_partition(scan_range.partition_id);
-        if (partition_desc == nullptr) {
-            return Status::InternalError(fmt::format(
-                    "Plan inconsistency. scan_range.partition_id = {} not found in partition description map",
-                    scan_range.partition_id));
-        }
-
+    std::string native_file_path;
+    {
         SCOPED_TIMER(_profile.open_file_timer);
-
-        std::filesystem::path file_path(partition_desc->location());
-        file_path /= scan_range.relative_path;
-        native_file_path = file_path.native();
+        ASSIGN_OR_RETURN(native_file_path, _native_file_path(scan_range));
     }
 
     const auto& hdfs_scan_node = _provider->_hdfs_scan_node;
@@ -406,6 +519,10 @@ Status HiveDataSource::_init_scanner(RuntimeState* state) {
     scanner_params.fs = _pool.add(fs.release());
     scanner_params.path = native_file_path;
     scanner_params.file_size = _scan_range.file_length;
+    if (_file_contents != nullptr && static_cast<int64_t>(_file_contents->size()) == _scan_range.file_length) {
+        scanner_params.file_contents = std::move(_file_contents);
+    }
+    _file_contents.reset();
     scanner_params.tuple_desc = _tuple_desc;
     scanner_params.materialize_slots = _materialize_slots;
     scanner_params.materialize_index_in_chunk = _materialize_index_in_chunk;
@@ -431,6 +548,13 @@ Status HiveDataSource::_init_scanner(RuntimeState* state) {
     }
     scanner_params.use_block_cache = _use_block_cache;
     scanner_params.enable_populate_block_cache = _enable_populate_block_cache;
+    if (scan_range.__isset.modification_time) {
+        scanner_params.modification_time = scan_range.modification_time;
+    }
+    // the data files of the lake formats are never rewritten in place
+    scanner_params.immutable_file = dynamic_cast<const IcebergTableDescriptor*>(_hive_table) != nullptr ||
+                                    dynamic_cast<const DeltaLakeTableDescriptor*>(_hive_table) != nullptr ||
+                                    dynamic_cast<const HudiTableDescriptor*>(_hive_table) != nullptr;
 
     HdfsScanner* scanner = nullptr;
     auto format = scan_range.file_format;
@@ -464,9 +588,9 @@ Status HiveDataSource::_init_scanner(RuntimeState* state) {
 }
 
 void HiveDataSource::close(RuntimeState* state) {
-    if (_scanner != nullptr) {
-        _scanner->close(state);
-    }
+    // the prefetching task uses the mem tracker of the query.
+    _wait_prefetch();
+    _close_scanner(state);
     Expr::close(_min_max_conjunct_ctxs, state);
     Expr::close(_partition_conjunct_ctxs, state);
     Expr::close(_scanner_conjunct_ctxs, state);
@@ -476,13 +600,25 @@ void HiveDataSource::close(RuntimeState* state) {
 }
 
 Status HiveDataSource::get_next(RuntimeState* state, ChunkPtr* chunk) {
-    if (_no_data) {
-        return Status::EndOfFile("no data");
+    while (true) {
+        if (!_no_data) {
+            _init_chunk(chunk, _runtime_state->chunk_size());
+            Status st;
+            do {
+                st = _scanner->get_next(state, chunk);
+            } while (st.ok() && (*chunk)->num_rows() == 0);
+            if (st.ok()) {
+                break;
+            }
+            if (!st.is_end_of_file()) {
+                return st;
+            }
+        }
+        if (_next_scan_range_idx >= _next_scan_ranges.size()) {
+            return Status::EndOfFile("no data");
+        }
+        RETURN_IF_ERROR(_open_next_scan_range(state));
     }
-    _init_chunk(chunk, _runtime_state->chunk_size());
-    do {
-        RETURN_IF_ERROR(_scanner->get_next(state, chunk));
-    } while ((*chunk)->num_rows() == 0);
 
     // The column order of chunk is required to be invariable. In order to simplify the logic of each scanner,
     // we force to reorder the columns of chunk, so scanner doesn't have to care about the column order anymore.
@@ -493,20 +629,20 @@ Status HiveDataSource::get_next(RuntimeState* state, ChunkPtr* chunk) {
 }
 
 int64_t HiveDataSource::raw_rows_read() const {
-    if (_scanner == nullptr) return 0;
-    return _scanner->raw_rows_read();
+    if (_scanner == nullptr) return _closed_raw_rows_read;
+    return _closed_raw_rows_read + _scanner->raw_rows_read();
 }
 int64_t HiveDataSource::num_rows_read() const {
-    if (_scanner == nullptr) return 0;
-    return _scanner->num_rows_read();
+    if (_scanner == nullptr) return _closed_num_rows_read;
+    return _closed_num_rows_read + _scanner->num_rows_read();
 }
 int64_t HiveDataSource::num_bytes_read() const {
-    if (_scanner == nullptr) return 0;
-    return _scanner->num_bytes_read();
+    if (_scanner == nullptr) return _closed_num_bytes_read;
+    return _closed_num_bytes_read + _scanner->num_bytes_read();
 }
 int64_t HiveDataSource::cpu_time_spent() const {
-    if (_scanner == nullptr) return 0;
-    return _scanner->cpu_time_spent();
+    if (_scanner == nullptr) return _closed_cpu_time_spent;
+    return _closed_cpu_time_spent + _scanner->cpu_time_spent();
 }
 
 } // namespace starrocks::connector
@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <future>
+
 #include "column/vectorized_fwd.h"
 #include "connector/connector.h"
 #include "exec/hdfs_scanner.h"
@@ -54,6 +56,9 @@ public:
     void close(RuntimeState* state) override;
     Status get_next(RuntimeState* state, ChunkPtr* chunk) override;
 
+    bool can_add_scan_range() const override;
+    void add_scan_range(const TScanRange& scan_range) override;
+
     int64_t raw_rows_read() const override;
     int64_t num_rows_read() const override;
     int64_t num_bytes_read() const override;
@@ -61,7 +66,12 @@ public:
 
 private:
     const HiveDataSourceProvider* _provider;
-    const THdfsScanRange _scan_range;
+    // The scan range being read.
+    THdfsScanRange _scan_range;
+    // The coalesced scan ranges read after the current one.
+    std::vector<THdfsScanRange> _next_scan_ranges;
+    size_t _next_scan_range_idx = 0;
+    int64_t _scan_ranges_bytes = 0;
 
     // ============= init func =============
     Status _init_conjunct_ctxs(RuntimeState* state);
@@ -72,6 +82,18 @@ private:
 
     Status _init_partition_values();
     Status _init_scanner(RuntimeState* state);
+    StatusOr<std::string> _native_file_path(const THdfsScanRange& scan_range) const;
+
+    // Open the scanner of the current scan range, or set _no_data if nothing is read from it.
+    Status _open_scan_range(RuntimeState* state);
+    // Close the current scanner and open the next coalesced scan range.
+    Status _open_next_scan_range(RuntimeState* state);
+    void _close_scanner(RuntimeState* state);
+
+    // Read the next coalesced file into memory in the background if it's small.
+    void _start_prefetch();
+    // Wait for the prefetched file, return nullptr if it's not prefetched or failed to read.
+    std::shared_ptr<const std::string> _wait_prefetch();
     HdfsScanner* _create_hudi_jni_scanner();
     Status _check_all_slots_nullable();
 
@@ -79,6 +101,23 @@ private:
     ObjectPool _pool;
     RuntimeState* _runtime_state = nullptr;
     HdfsScanner* _scanner = nullptr;
+    // The stats of the scanners of the scan ranges already read.
+    int64_t _closed_raw_rows_read = 0;
+    int64_t _closed_num_rows_read = 0;
+    int64_t _closed_num_bytes_read = 0;
+    int64_t _closed_cpu_time_spent = 0;
+
+    struct PrefetchedFile {
+        std::string path;
+        int64_t file_size = 0;
+        Status status;
+        std::shared_ptr<const std::string> contents;
+    };
+    std::shared_ptr<PrefetchedFile> _prefetched_file;
+    std::future<void> _prefetch_future;
+    // The contents of the file of the current scan range if it's prefetched.
+    std::shared_ptr<const std::string> _file_contents;
+
     bool _use_block_cache = false;
     bool _enable_populate_block_cache = false;
 
@@ -97,6 +136,8 @@ private:
     std::vector<ExprContext*> _partition_conjunct_ctxs;
     std::vector<ExprContext*> _partition_values;
     bool _has_partition_conjuncts = false;
+    // The partition whose values are in `_partition_values`, the consecutive scan ranges usually share it.
+    int64_t _partition_values_id = -1;
     bool _filter_by_eval_partition_conjuncts = false;
     bool _no_data = false;
 
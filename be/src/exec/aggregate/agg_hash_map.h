@@ -14,7 +14,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <limits>
 #include <type_traits>
 
 #include "column/column.h"
@@ -24,6 +26,7 @@
 #include "column/type_traits.h"
 #include "column/vectorized_fwd.h"
 #include "common/compiler_util.h"
+#include "common/config.h"
 #include "exec/aggregate/agg_hash_set.h"
 #include "exec/aggregate/agg_profile.h"
 #include "gutil/casts.h"
@@ -40,47 +43,104 @@ const constexpr int32_t prefetch_threhold = 8192;
 
 using AggDataPtr = uint8_t*;
 
+// The buckets are allocated by HugePageAllocator like the agg hash sets.
+template <typename K>
+using AggHashMapAllocator = HugePageAllocator<phmap::priv::Pair<const K, AggDataPtr>>;
+template <typename K, typename Hash, typename Eq = phmap::priv::hash_default_eq<K>>
+using AggFlatHashMap = phmap::flat_hash_map<K, AggDataPtr, Hash, Eq, AggHashMapAllocator<K>>;
+template <typename K, typename Hash, typename Eq = phmap::priv::hash_default_eq<K>, size_t N = 4>
+using AggParallelFlatHashMap = phmap::parallel_flat_hash_map<K, AggDataPtr, Hash, Eq, AggHashMapAllocator<K>, N>;
+
 // =====================
 // one level agg hash map
 template <PhmapSeed seed>
 using Int8AggHashMap = SmallFixedSizeHashMap<int8_t, AggDataPtr, seed>;
 template <PhmapSeed seed>
-using Int16AggHashMap = phmap::flat_hash_map<int16_t, AggDataPtr, StdHashWithSeed<int16_t, seed>>;
+using Int16AggHashMap = AggFlatHashMap<int16_t, StdHashWithSeed<int16_t, seed>>;
 template <PhmapSeed seed>
-using Int32AggHashMap = phmap::flat_hash_map<int32_t, AggDataPtr, StdHashWithSeed<int32_t, seed>>;
+using Int32AggHashMap = AggFlatHashMap<int32_t, StdHashWithSeed<int32_t, seed>>;
 template <PhmapSeed seed>
-using Int64AggHashMap = phmap::flat_hash_map<int64_t, AggDataPtr, StdHashWithSeed<int64_t, seed>>;
+using Int64AggHashMap = AggFlatHashMap<int64_t, StdHashWithSeed<int64_t, seed>>;
 template <PhmapSeed seed>
-using Int128AggHashMap = phmap::flat_hash_map<int128_t, AggDataPtr, Hash128WithSeed<seed>>;
+using Int128AggHashMap = AggFlatHashMap<int128_t, Hash128WithSeed<seed>>;
 template <PhmapSeed seed>
-using DateAggHashMap = phmap::flat_hash_map<DateValue, AggDataPtr, StdHashWithSeed<DateValue, seed>>;
+using DateAggHashMap = AggFlatHashMap<DateValue, StdHashWithSeed<DateValue, seed>>;
 template <PhmapSeed seed>
-using TimeStampAggHashMap = phmap::flat_hash_map<TimestampValue, AggDataPtr, StdHashWithSeed<TimestampValue, seed>>;
+using TimeStampAggHashMap = AggFlatHashMap<TimestampValue, StdHashWithSeed<TimestampValue, seed>>;
 template <PhmapSeed seed>
-using SliceAggHashMap = phmap::flat_hash_map<Slice, AggDataPtr, SliceHashWithSeed<seed>, SliceEqual>;
+using SliceAggHashMap = AggFlatHashMap<Slice, SliceHashWithSeed<seed>, SliceEqual>;
 
 // ==================
 // one level fixed size slice hash map
 template <PhmapSeed seed>
-using FixedSize4SliceAggHashMap = phmap::flat_hash_map<SliceKey4, AggDataPtr, FixedSizeSliceKeyHash<SliceKey4, seed>>;
+using FixedSize4SliceAggHashMap = AggFlatHashMap<SliceKey4, FixedSizeSliceKeyHash<SliceKey4, seed>>;
 template <PhmapSeed seed>
-using FixedSize8SliceAggHashMap = phmap::flat_hash_map<SliceKey8, AggDataPtr, FixedSizeSliceKeyHash<SliceKey8, seed>>;
+using FixedSize8SliceAggHashMap = AggFlatHashMap<SliceKey8, FixedSizeSliceKeyHash<SliceKey8, seed>>;
 template <PhmapSeed seed>
-using FixedSize16SliceAggHashMap =
-        phmap::flat_hash_map<SliceKey16, AggDataPtr, FixedSizeSliceKeyHash<SliceKey16, seed>>;
+using FixedSize16SliceAggHashMap = AggFlatHashMap<SliceKey16, FixedSizeSliceKeyHash<SliceKey16, seed>>;
 
 // =====================
 // two level agg hash map
 template <PhmapSeed seed>
-using Int32AggTwoLevelHashMap = phmap::parallel_flat_hash_map<int32_t, AggDataPtr, StdHashWithSeed<int32_t, seed>>;
+using Int32AggTwoLevelHashMap = AggParallelFlatHashMap<int32_t, StdHashWithSeed<int32_t, seed>>;
 
 // The SliceAggTwoLevelHashMap will have 2 ^ 4 = 16 sub map,
 // The 16 is same as PartitionedAggregationNode::PARTITION_FANOUT
 static constexpr uint8_t PHMAPN = 4;
 template <PhmapSeed seed>
-using SliceAggTwoLevelHashMap =
-        phmap::parallel_flat_hash_map<Slice, AggDataPtr, SliceHashWithSeed<seed>, SliceEqual,
-                                      phmap::priv::Allocator<phmap::priv::Pair<const Slice, AggDataPtr>>, PHMAPN>;
+using SliceAggTwoLevelHashMap = AggParallelFlatHashMap<Slice, SliceHashWithSeed<seed>, SliceEqual, PHMAPN>;
+
+// =====================
+// dense range agg hash map, see DenseRangeHashMap
+template <typename KeyType>
+struct IntegerKeyToInteger {
+    int64_t operator()(KeyType key) const { return static_cast<int64_t>(key); }
+};
+// The fixed size serialized keys of several small integer columns are packed into one integer.
+struct SliceKey4ToInteger {
+    int64_t operator()(const SliceKey4& key) const { return key.u.value; }
+};
+
+template <PhmapSeed seed>
+using Int32DenseAggHashMap =
+        DenseRangeHashMap<int32_t, AggDataPtr, Int32AggHashMap<seed>, IntegerKeyToInteger<int32_t>>;
+template <PhmapSeed seed>
+using Int64DenseAggHashMap =
+        DenseRangeHashMap<int64_t, AggDataPtr, Int64AggHashMap<seed>, IntegerKeyToInteger<int64_t>>;
+template <PhmapSeed seed>
+using FixedSize4SliceDenseAggHashMap =
+        DenseRangeHashMap<SliceKey4, AggDataPtr, FixedSize4SliceAggHashMap<seed>, SliceKey4ToInteger>;
+
+template <typename HashMap>
+struct IsDenseRangeHashMap : std::false_type {};
+template <typename KeyType, typename ValueType, typename FallbackMap, typename KeyToInteger>
+struct IsDenseRangeHashMap<DenseRangeHashMap<KeyType, ValueType, FallbackMap, KeyToInteger>> : std::true_type {};
+
+// Initialize the range of a DenseRangeHashMap by the min and max of the first non-null keys, it's a no-op for
+// other hash maps. |key_at(i)| returns the i-th key, and |nulls| may be nullptr if there is no null key.
+template <typename HashMap, typename KeyAt>
+void init_dense_range(HashMap& hash_map, size_t num_rows, const uint8_t* nulls, KeyAt&& key_at) {
+    if constexpr (IsDenseRangeHashMap<HashMap>::value) {
+        if (LIKELY(hash_map.range_inited())) {
+            return;
+        }
+        int64_t min_key = std::numeric_limits<int64_t>::max();
+        int64_t max_key = std::numeric_limits<int64_t>::min();
+        bool has_key = false;
+        for (size_t i = 0; i < num_rows; i++) {
+            if (nulls != nullptr && nulls[i]) {
+                continue;
+            }
+            int64_t key = typename HashMap::key_to_integer()(key_at(i));
+            min_key = std::min(min_key, key);
+            max_key = std::max(max_key, key);
+            has_key = true;
+        }
+        if (has_key) {
+            hash_map.init_range(min_key, max_key, config::agg_dense_range_hash_map_max_slots);
+        }
+    }
+}
 
 // This is just an empirical value based on benchmark, and you can tweak it if more proper value is found.
 static constexpr size_t AGG_HASH_MAP_DEFAULT_PREFETCH_DIST = 16;
@@ -176,6 +236,8 @@ struct AggHashMapWithOneNumberKeyWithNullable
                                          std::vector<uint8_t>* not_founds) {
         DCHECK(!key_columns[0]->is_nullable());
         auto column = down_cast<ColumnType*>(key_columns[0].get());
+        const auto& keys = column->get_data();
+        init_dense_range(this->hash_map, chunk_size, nullptr, [&](size_t i) { return keys[i]; });
 
         size_t bucket_count = this->hash_map.bucket_count();
 
@@ -216,6 +278,8 @@ struct AggHashMapWithOneNumberKeyWithNullable
             auto* nullable_column = down_cast<NullableColumn*>(key_columns[0].get());
             auto* data_column = down_cast<ColumnType*>(nullable_column->data_column().get());
             const auto& null_data = nullable_column->null_column_data();
+            const auto& keys = data_column->get_data();
+            init_dense_range(this->hash_map, chunk_size, null_data.data(), [&](size_t i) { return keys[i]; });
 
             // Shortcut: if nullable column has no nulls.
             if (!nullable_column->has_null()) {
@@ -723,6 +787,7 @@ struct AggHashMapWithSerializedKeyFixedSize
                 caches[i].key.u.size = slice_sizes[i];
             }
         }
+        init_dense_range(this->hash_map, chunk_size, nullptr, [&](size_t i) { return caches[i].key; });
         for (size_t i = 0; i < chunk_size; i++) {
             caches[i].hashval = this->hash_map.hash_function()(caches[i].key);
         }
@@ -768,6 +833,7 @@ struct AggHashMapWithSerializedKeyFixedSize
                 key[i].u.size = slice_sizes[i];
             }
         }
+        init_dense_range(this->hash_map, chunk_size, nullptr, [&](size_t i) { return key[i]; });
         for (size_t i = 0; i < chunk_size; ++i) {
             if constexpr (allocate_and_compute_state) {
                 auto iter = this->hash_map.lazy_emplace(key[i], [&](const auto& ctor) {
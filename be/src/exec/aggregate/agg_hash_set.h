@@ -20,6 +20,7 @@
 #include "column/type_traits.h"
 #include "gutil/casts.h"
 #include "runtime/mem_pool.h"
+#include "runtime/memory/huge_page_allocator.h"
 #include "runtime/runtime_state.h"
 #include "util/fixed_hash_map.h"
 #include "util/hash_util.hpp"
@@ -27,44 +28,49 @@
 
 namespace starrocks {
 
+// The buckets of the agg hash sets and maps are allocated by HugePageAllocator, so the large ones are backed by
+// the huge pages.
+template <typename T, typename Hash, typename Eq = phmap::priv::hash_default_eq<T>>
+using AggFlatHashSet = phmap::flat_hash_set<T, Hash, Eq, HugePageAllocator<T>>;
+template <typename T, typename Hash, typename Eq = phmap::priv::hash_default_eq<T>, size_t N = 4>
+using AggParallelFlatHashSet = phmap::parallel_flat_hash_set<T, Hash, Eq, HugePageAllocator<T>, N>;
+
 // =====================
 // one level agg hash set
 template <PhmapSeed seed>
 using Int8AggHashSet = SmallFixedSizeHashSet<int8_t, seed>;
 template <PhmapSeed seed>
-using Int16AggHashSet = phmap::flat_hash_set<int16_t, StdHashWithSeed<int16_t, seed>>;
+using Int16AggHashSet = AggFlatHashSet<int16_t, StdHashWithSeed<int16_t, seed>>;
 template <PhmapSeed seed>
-using Int32AggHashSet = phmap::flat_hash_set<int32_t, StdHashWithSeed<int32_t, seed>>;
+using Int32AggHashSet = AggFlatHashSet<int32_t, StdHashWithSeed<int32_t, seed>>;
 template <PhmapSeed seed>
-using Int64AggHashSet = phmap::flat_hash_set<int64_t, StdHashWithSeed<int64_t, seed>>;
+using Int64AggHashSet = AggFlatHashSet<int64_t, StdHashWithSeed<int64_t, seed>>;
 template <PhmapSeed seed>
-using Int128AggHashSet = phmap::flat_hash_set<int128_t, Hash128WithSeed<seed>>;
+using Int128AggHashSet = AggFlatHashSet<int128_t, Hash128WithSeed<seed>>;
 template <PhmapSeed seed>
-using DateAggHashSet = phmap::flat_hash_set<DateValue, StdHashWithSeed<DateValue, seed>>;
+using DateAggHashSet = AggFlatHashSet<DateValue, StdHashWithSeed<DateValue, seed>>;
 template <PhmapSeed seed>
-using TimeStampAggHashSet = phmap::flat_hash_set<TimestampValue, StdHashWithSeed<TimestampValue, seed>>;
+using TimeStampAggHashSet = AggFlatHashSet<TimestampValue, StdHashWithSeed<TimestampValue, seed>>;
 template <PhmapSeed seed>
-using SliceAggHashSet =
-        phmap::flat_hash_set<TSliceWithHash<seed>, THashOnSliceWithHash<seed>, TEqualOnSliceWithHash<seed>>;
+using SliceAggHashSet = AggFlatHashSet<TSliceWithHash<seed>, THashOnSliceWithHash<seed>, TEqualOnSliceWithHash<seed>>;
 
 // ==================
 // one level fixed size slice hash set
 template <PhmapSeed seed>
-using FixedSize4SliceAggHashSet = phmap::flat_hash_set<SliceKey4, FixedSizeSliceKeyHash<SliceKey4, seed>>;
+using FixedSize4SliceAggHashSet = AggFlatHashSet<SliceKey4, FixedSizeSliceKeyHash<SliceKey4, seed>>;
 template <PhmapSeed seed>
-using FixedSize8SliceAggHashSet = phmap::flat_hash_set<SliceKey8, FixedSizeSliceKeyHash<SliceKey8, seed>>;
+using FixedSize8SliceAggHashSet = AggFlatHashSet<SliceKey8, FixedSizeSliceKeyHash<SliceKey8, seed>>;
 template <PhmapSeed seed>
-using FixedSize16SliceAggHashSet = phmap::flat_hash_set<SliceKey16, FixedSizeSliceKeyHash<SliceKey16, seed>>;
+using FixedSize16SliceAggHashSet = AggFlatHashSet<SliceKey16, FixedSizeSliceKeyHash<SliceKey16, seed>>;
 
 // =====================
 // two level agg hash set
 template <PhmapSeed seed>
-using Int32AggTwoLevelHashSet = phmap::parallel_flat_hash_set<int32_t, StdHashWithSeed<int32_t, seed>>;
+using Int32AggTwoLevelHashSet = AggParallelFlatHashSet<int32_t, StdHashWithSeed<int32_t, seed>>;
 
 template <PhmapSeed seed>
 using SliceAggTwoLevelHashSet =
-        phmap::parallel_flat_hash_set<TSliceWithHash<seed>, THashOnSliceWithHash<seed>, TEqualOnSliceWithHash<seed>,
-                                      phmap::priv::Allocator<Slice>, 4>;
+        AggParallelFlatHashSet<TSliceWithHash<seed>, THashOnSliceWithHash<seed>, TEqualOnSliceWithHash<seed>, 4>;
 
 // ==============================================================
 
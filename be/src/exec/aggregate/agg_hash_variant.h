@@ -91,6 +91,20 @@ namespace starrocks {
     M(phase2_slice_fx8)              \
     M(phase2_slice_fx16)
 
+// The kinds only for hash maps, see DenseRangeHashMap.
+#define APPLY_FOR_AGG_MAP_VARIANT_ALL(M) \
+    APPLY_FOR_AGG_VARIANT_ALL(M)         \
+    M(phase1_int32_dense)                \
+    M(phase1_null_int32_dense)           \
+    M(phase1_int64_dense)                \
+    M(phase1_null_int64_dense)           \
+    M(phase1_slice_fx4_dense)            \
+    M(phase2_int32_dense)                \
+    M(phase2_null_int32_dense)           \
+    M(phase2_int64_dense)                \
+    M(phase2_null_int64_dense)           \
+    M(phase2_slice_fx4_dense)
+
 // Aggregate Hash maps
 
 // no-nullable single key maps:
@@ -157,6 +171,21 @@ using SerializedKeyTwoLevelAggHashMap = AggHashMapWithSerializedKey<SliceAggTwoL
 template <PhmapSeed seed>
 using Int32TwoLevelAggHashMapWithOneNumberKey = AggHashMapWithOneNumberKey<TYPE_INT, Int32AggTwoLevelHashMap<seed>>;
 
+// dense range key maps.
+template <PhmapSeed seed>
+using Int32DenseAggHashMapWithOneNumberKey = AggHashMapWithOneNumberKey<TYPE_INT, Int32DenseAggHashMap<seed>>;
+template <PhmapSeed seed>
+using NullInt32DenseAggHashMapWithOneNumberKey =
+        AggHashMapWithOneNullableNumberKey<TYPE_INT, Int32DenseAggHashMap<seed>>;
+template <PhmapSeed seed>
+using Int64DenseAggHashMapWithOneNumberKey = AggHashMapWithOneNumberKey<TYPE_BIGINT, Int64DenseAggHashMap<seed>>;
+template <PhmapSeed seed>
+using NullInt64DenseAggHashMapWithOneNumberKey =
+        AggHashMapWithOneNullableNumberKey<TYPE_BIGINT, Int64DenseAggHashMap<seed>>;
+template <PhmapSeed seed>
+using SerializedKeyFixedSize4DenseAggHashMap =
+        AggHashMapWithSerializedKeyFixedSize<FixedSize4SliceDenseAggHashMap<seed>>;
+
 // fixed slice key type.
 template <PhmapSeed seed>
 using SerializedKeyFixedSize4AggHashMap = AggHashMapWithSerializedKeyFixedSize<FixedSize4SliceAggHashMap<seed>>;
@@ -334,7 +363,17 @@ using AggHashMapWithKeyPtr = std::variant<
         std::unique_ptr<Int32TwoLevelAggHashMapWithOneNumberKey<PhmapSeed2>>,
         std::unique_ptr<SerializedKeyFixedSize4AggHashMap<PhmapSeed2>>,
         std::unique_ptr<SerializedKeyFixedSize8AggHashMap<PhmapSeed2>>,
-        std::unique_ptr<SerializedKeyFixedSize16AggHashMap<PhmapSeed2>>>;
+        std::unique_ptr<SerializedKeyFixedSize16AggHashMap<PhmapSeed2>>,
+        std::unique_ptr<Int32DenseAggHashMapWithOneNumberKey<PhmapSeed1>>,
+        std::unique_ptr<NullInt32DenseAggHashMapWithOneNumberKey<PhmapSeed1>>,
+        std::unique_ptr<Int64DenseAggHashMapWithOneNumberKey<PhmapSeed1>>,
+        std::unique_ptr<NullInt64DenseAggHashMapWithOneNumberKey<PhmapSeed1>>,
+        std::unique_ptr<SerializedKeyFixedSize4DenseAggHashMap<PhmapSeed1>>,
+        std::unique_ptr<Int32DenseAggHashMapWithOneNumberKey<PhmapSeed2>>,
+        std::unique_ptr<NullInt32DenseAggHashMapWithOneNumberKey<PhmapSeed2>>,
+        std::unique_ptr<Int64DenseAggHashMapWithOneNumberKey<PhmapSeed2>>,
+        std::unique_ptr<NullInt64DenseAggHashMapWithOneNumberKey<PhmapSeed2>>,
+        std::unique_ptr<SerializedKeyFixedSize4DenseAggHashMap<PhmapSeed2>>>;
 
 using AggHashSetWithKeyPtr = std::variant<
         std::unique_ptr<UInt8AggHashSetOfOneNumberKey<PhmapSeed1>>,
@@ -461,6 +500,17 @@ struct AggHashMapVariant {
         phase2_slice_fx4,
         phase2_slice_fx8,
         phase2_slice_fx16,
+
+        phase1_int32_dense,
+        phase1_null_int32_dense,
+        phase1_int64_dense,
+        phase1_null_int64_dense,
+        phase1_slice_fx4_dense,
+        phase2_int32_dense,
+        phase2_null_int32_dense,
+        phase2_int64_dense,
+        phase2_null_int64_dense,
+        phase2_slice_fx4_dense,
     };
 
     detail::AggHashMapWithKeyPtr hash_map_with_key;
@@ -17,6 +17,7 @@
 #include <type_traits>
 #include <variant>
 
+#include "common/config.h"
 #include "exec/aggregator.h"
 #include "exec/pipeline/aggregate/aggregate_blocking_sink_operator.h"
 #include "exec/pipeline/aggregate/aggregate_blocking_source_operator.h"
@@ -182,6 +183,9 @@ pipeline::OpFactories AggregateBlockingNode::_decompose_to_pipeline(pipeline::Op
         auto aggregator_factory = std::make_shared<AggFactory>(_tnode);
         AggrMode aggr_mode = should_cache ? (post_cache ? AM_BLOCKING_POST_CACHE : AM_BLOCKING_PRE_CACHE) : AM_DEFAULT;
         aggregator_factory->set_aggr_mode(aggr_mode);
+        if (_partitioned_merger != nullptr) {
+            aggregator_factory->set_partitioned_merger(_partitioned_merger);
+        }
         auto sink_operator = std::make_shared<SinkFactory>(context->next_operator_id(), id(), aggregator_factory);
         auto source_operator = std::make_shared<SourceFactory>(context->next_operator_id(), id(), aggregator_factory);
 
@@ -209,6 +213,16 @@ pipeline::OpFactories AggregateBlockingNode::_decompose_to_pipeline(pipeline::Op
     return ops_with_source;
 }
 
+bool AggregateBlockingNode::_could_merge_by_partitions(pipeline::PipelineBuilderContext* context,
+                                                       pipeline::OpFactories& ops_with_sink) {
+    if (!config::enable_agg_partitioned_merge || runtime_state()->enable_spill() || limit() != -1) {
+        return false;
+    }
+    // The query cache requires the results of each driver to be the results of its own tablets.
+    const size_t dop = context->source_operator(ops_with_sink)->degree_of_parallelism();
+    return dop > 1 && !context->should_interpolate_cache_operator(ops_with_sink[0], id());
+}
+
 pipeline::OpFactories AggregateBlockingNode::decompose_to_pipeline(pipeline::PipelineBuilderContext* context) {
     using namespace pipeline;
 
@@ -238,6 +252,10 @@ pipeline::OpFactories AggregateBlockingNode::decompose_to_pipeline(pipeline::Pip
         if (agg_node.need_finalize) {
             if (!has_group_by_keys) {
                 ops_with_sink = context->maybe_interpolate_local_passthrough_exchange(runtime_state(), ops_with_sink);
+            } else if (could_local_shuffle && _could_merge_by_partitions(context, ops_with_sink)) {
+                const size_t dop = context->source_operator(ops_with_sink)->degree_of_parallelism();
+                _partitioned_merger = std::make_shared<AggregatePartitionedMerger>(
+                        dop, agg_node.grouping_exprs.size(), runtime_state()->chunk_size());
             } else if (could_local_shuffle) {
                 ops_with_sink = try_interpolate_local_shuffle(ops_with_sink);
             }
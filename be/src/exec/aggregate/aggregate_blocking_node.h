@@ -15,6 +15,7 @@
 #pragma once
 
 #include "exec/aggregate/aggregate_base_node.h"
+#include "exec/aggregate/aggregate_partitioned_merger.h"
 #include "exec/exec_node.h"
 #include "exec/pipeline/operator.h"
 
@@ -36,5 +37,10 @@ private:
     template <class AggFactory, class SourceFactory, class SinkFactory>
     pipeline::OpFactories _decompose_to_pipeline(pipeline::OpFactories& ops_with_sink,
                                                  pipeline::PipelineBuilderContext* context);
+
+    // Whether the drivers merge their hash tables by partitions instead of a local shuffle before the aggregation.
+    bool _could_merge_by_partitions(pipeline::PipelineBuilderContext* context, pipeline::OpFactories& ops_with_sink);
+
+    AggregatePartitionedMergerPtr _partitioned_merger;
 };
 } // namespace starrocks
@@ -0,0 +1,82 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/aggregate/aggregate_partitioned_merger.h"
+
+#include <algorithm>
+
+#include "column/chunk.h"
+#include "column/column.h"
+
+namespace starrocks {
+
+AggregatePartitionedMerger::AggregatePartitionedMerger(size_t num_partitions, size_t num_key_columns,
+                                                       size_t chunk_size)
+        : _num_key_columns(num_key_columns), _chunk_size(chunk_size), _sinks(num_partitions) {
+    for (auto& sink : _sinks) {
+        sink.partitions.resize(num_partitions);
+        sink.partition_rows.resize(num_partitions);
+    }
+}
+
+void AggregatePartitionedMerger::add_chunk(int32_t sink, const ChunkPtr& chunk) {
+    DCHECK_LT(sink, _sinks.size());
+    DCHECK(!all_sinks_finished());
+    auto& sink_partitions = _sinks[sink];
+    const size_t num_rows = chunk->num_rows();
+    const size_t num_partitions = _sinks.size();
+
+    sink_partitions.hash_values.assign(num_rows, 0);
+    for (size_t i = 0; i < _num_key_columns; i++) {
+        chunk->get_column_by_index(i)->crc32_hash(sink_partitions.hash_values.data(), 0, num_rows);
+    }
+    for (auto& rows : sink_partitions.partition_rows) {
+        rows.clear();
+    }
+    for (uint32_t i = 0; i < num_rows; i++) {
+        // map the hash to [0, num_partitions) without modulo
+        size_t partition = (static_cast<uint64_t>(sink_partitions.hash_values[i]) * num_partitions) >> 32;
+        sink_partitions.partition_rows[partition].emplace_back(i);
+    }
+
+    for (size_t i = 0; i < num_partitions; i++) {
+        const auto& rows = sink_partitions.partition_rows[i];
+        auto& chunks = sink_partitions.partitions[i];
+        size_t offset = 0;
+        while (offset < rows.size()) {
+            if (chunks.empty() || chunks.back()->num_rows() >= _chunk_size) {
+                chunks.emplace_back(chunk->clone_empty_with_slot(_chunk_size));
+            }
+            size_t count = std::min(rows.size() - offset, _chunk_size - chunks.back()->num_rows());
+            chunks.back()->append_selective(*chunk, rows.data(), offset, count);
+            offset += count;
+        }
+    }
+}
+
+std::vector<ChunkPtr> AggregatePartitionedMerger::take_partition(size_t partition) {
+    DCHECK(all_sinks_finished());
+    DCHECK_LT(partition, _sinks.size());
+    std::vector<ChunkPtr> chunks;
+    for (auto& sink : _sinks) {
+        auto& sink_chunks = sink.partitions[partition];
+        for (auto& chunk : sink_chunks) {
+            chunks.emplace_back(std::move(chunk));
+        }
+        sink_chunks.clear();
+    }
+    return chunks;
+}
+
+} // namespace starrocks
@@ -0,0 +1,71 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+
+namespace starrocks {
+
+// AggregatePartitionedMerger merges the hash tables of all the drivers of a blocking aggregation partition by
+// partition, instead of shuffling the input rows to the drivers by a local exchange.
+//
+// Every sink driver aggregates its own input rows, then outputs the intermediate results of its hash table, which
+// are partitioned by the hash of the group by columns. Once all the sinks are finished, the i-th source driver
+// merges the i-th partition of all the sinks, so the groups merged by different drivers are disjoint.
+// Only the aggregated groups are partitioned and copied, rather than all the input rows.
+class AggregatePartitionedMerger {
+public:
+    // Both the number of the sink drivers and the number of the partitions are |num_partitions|, the first
+    // |num_key_columns| columns of the added chunks are group by columns.
+    AggregatePartitionedMerger(size_t num_partitions, size_t num_key_columns, size_t chunk_size);
+    ~AggregatePartitionedMerger() = default;
+
+    size_t num_partitions() const { return _sinks.size(); }
+
+    // Partition the rows of |chunk| added by the sink driver |sink|, it's only called by the sink driver.
+    void add_chunk(int32_t sink, const ChunkPtr& chunk);
+
+    // Called by each sink driver after all its rows have been added.
+    void finish_sink() { _num_finished_sinks.fetch_add(1, std::memory_order_acq_rel); }
+
+    bool all_sinks_finished() const {
+        return _num_finished_sinks.load(std::memory_order_acquire) == static_cast<int64_t>(_sinks.size());
+    }
+
+    // Take the chunks of |partition| added by all the sinks, it's only called once by the source driver of
+    // the partition after all the sinks are finished.
+    std::vector<ChunkPtr> take_partition(size_t partition);
+
+private:
+    struct SinkPartitions {
+        // The chunks of every partition, only the last one of them may be not full.
+        std::vector<std::vector<ChunkPtr>> partitions;
+        std::vector<uint32_t> hash_values;
+        std::vector<std::vector<uint32_t>> partition_rows;
+    };
+
+    const size_t _num_key_columns;
+    const size_t _chunk_size;
+    std::vector<SinkPartitions> _sinks;
+    std::atomic<int64_t> _num_finished_sinks = 0;
+};
+
+using AggregatePartitionedMergerPtr = std::shared_ptr<AggregatePartitionedMerger>;
+
+} // namespace starrocks
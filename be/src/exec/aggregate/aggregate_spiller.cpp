@@ -0,0 +1,136 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/aggregate/aggregate_spiller.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+
+#include "column/chunk.h"
+#include "exec/pipeline/query_context.h"
+#include "exec/spill/spiller.hpp"
+
+namespace starrocks {
+
+AggregateSpiller::AggregateSpiller(int32_t plan_node_id, ChunkBuilder chunk_builder, size_t num_key_columns)
+        : _plan_node_id(plan_node_id),
+          _chunk_builder(std::move(chunk_builder)),
+          _num_key_columns(num_key_columns),
+          _partitions(kNumPartitions),
+          _partition_rows(kNumPartitions) {}
+
+Status AggregateSpiller::prepare(RuntimeState* state, RuntimeProfile* profile) {
+    _state = state;
+    _metrics = SpillProcessMetrics(profile);
+    _spilled_partitions_counter = ADD_COUNTER(profile, "SpilledPartitionNum", TUnit::UNIT);
+
+    // Every partition has its own mem table, so split the mem table size among the partitions.
+    _spill_options.spill_file_size = std::max<size_t>(state->spill_mem_table_size() / kNumPartitions, 1 << 20);
+    // The flush tasks are executed synchronously, so one mem table is enough.
+    _spill_options.mem_table_pool_size = 1;
+    _spill_options.spill_type = SpillFormaterType::SPILL_BY_COMPRESSED_COLUMN;
+    _spill_options.path_provider_factory =
+            state->query_ctx()->spill_manager()->provider(fmt::format("agg-spill-{}", _plan_node_id));
+    _spill_options.chunk_builder = _chunk_builder;
+    return Status::OK();
+}
+
+Status AggregateSpiller::spill(const ChunkPtr& chunk) {
+    DCHECK(!_finished);
+    DCHECK(!chunk->is_empty());
+    const size_t num_rows = chunk->num_rows();
+    _hash_values.assign(num_rows, 0);
+    for (size_t i = 0; i < _num_key_columns; i++) {
+        chunk->get_column_by_index(i)->crc32_hash(_hash_values.data(), 0, num_rows);
+    }
+    for (auto& rows : _partition_rows) {
+        rows.clear();
+    }
+    // The rows have been shuffled to this aggregator by the hash of the same keys, so mix the hash to avoid
+    // the partitions correlating with the shuffle.
+    for (uint32_t i = 0; i < num_rows; i++) {
+        uint64_t mixed = static_cast<uint64_t>(_hash_values[i]) * 0x9E3779B97F4A7C15ULL;
+        _partition_rows[mixed >> (64 - kPartitionBits)].emplace_back(i);
+    }
+
+    for (size_t i = 0; i < kNumPartitions; i++) {
+        const auto& rows = _partition_rows[i];
+        if (rows.empty()) {
+            continue;
+        }
+        if (_partitions[i] == nullptr) {
+            ASSIGN_OR_RETURN(_partitions[i], _create_spiller());
+            COUNTER_UPDATE(_spilled_partitions_counter, 1);
+        }
+        ChunkPtr part = chunk;
+        if (rows.size() != num_rows) {
+            part = chunk->clone_empty_with_slot(rows.size());
+            part->append_selective(*chunk, rows.data(), 0, rows.size());
+        }
+        RETURN_IF_ERROR(_partitions[i]->spill(_state, part, _executor, EmptyMemGuard()));
+    }
+    _spilled_rows += num_rows;
+    return Status::OK();
+}
+
+Status AggregateSpiller::finish() {
+    if (_finished) {
+        return Status::OK();
+    }
+    _finished = true;
+    for (auto& spiller : _partitions) {
+        if (spiller != nullptr) {
+            RETURN_IF_ERROR(spiller->flush(_state, _executor, EmptyMemGuard()));
+        }
+    }
+    return Status::OK();
+}
+
+Status AggregateSpiller::restore_next_partition(const std::function<Status(const ChunkPtr&)>& consumer) {
+    DCHECK(_finished);
+    while (has_pending_partition()) {
+        // the spilled files are deleted when the spiller is released
+        auto spiller = std::move(_partitions[_next_partition++]);
+        if (spiller == nullptr) {
+            continue;
+        }
+        RETURN_IF_ERROR(spiller->set_flush_all_call_back([]() { return Status::OK(); }, _state, _executor,
+                                                         EmptyMemGuard()));
+        while (true) {
+            RETURN_IF_ERROR(_state->check_mem_limit("AggregateSpiller"));
+            auto chunk_st = spiller->restore(_state, _executor, EmptyMemGuard());
+            if (chunk_st.status().is_end_of_file()) {
+                break;
+            }
+            RETURN_IF_ERROR(chunk_st.status());
+            if (!chunk_st.value()->is_empty()) {
+                RETURN_IF_ERROR(consumer(chunk_st.value()));
+            }
+        }
+        break;
+    }
+    return Status::OK();
+}
+
+StatusOr<std::shared_ptr<Spiller>> AggregateSpiller::_create_spiller() {
+    // Not created by SpillerFactory::create, which holds the spillers until the factory is closed,
+    // so that the spilled files of a partition are deleted as soon as the partition is restored.
+    auto spiller = std::make_shared<Spiller>(_spill_options, _spill_factory);
+    RETURN_IF_ERROR(spiller->prepare(_state));
+    spiller->set_metrics(_metrics);
+    return spiller;
+}
+
+} // namespace starrocks
@@ -0,0 +1,86 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "common/statusor.h"
+#include "exec/spill/executor.h"
+#include "exec/spill/spiller.h"
+#include "exec/spill/spiller_factory.h"
+#include "util/runtime_profile.h"
+
+namespace starrocks {
+
+// AggregateSpiller spills the intermediate results of a blocking aggregation.
+//
+// The spilled chunks consist of the group by columns followed by the serialized agg states. The rows are hash
+// partitioned by the group by columns, so the rows of the same group are always in the same partition, and the
+// partitions can be merged back into the hash table and output one by one.
+//
+// The spilled chunks are written and read synchronously in the caller thread.
+class AggregateSpiller {
+public:
+    static constexpr size_t kPartitionBits = 4;
+    static constexpr size_t kNumPartitions = 1 << kPartitionBits;
+
+    // |chunk_builder| creates the chunks of the same layout as the spilled ones, the first |num_key_columns|
+    // columns of them are group by columns.
+    AggregateSpiller(int32_t plan_node_id, ChunkBuilder chunk_builder, size_t num_key_columns);
+    ~AggregateSpiller() = default;
+
+    Status prepare(RuntimeState* state, RuntimeProfile* profile);
+
+    bool spilled() const { return _spilled_rows > 0; }
+
+    // Partition the rows of |chunk| and spill them.
+    Status spill(const ChunkPtr& chunk);
+
+    // Flush all the partitions, then they can be restored, it's idempotent.
+    Status finish();
+
+    bool has_pending_partition() const { return _next_partition < _partitions.size(); }
+
+    // Restore all the chunks of the next spilled partition by |consumer|, and delete its spilled files.
+    Status restore_next_partition(const std::function<Status(const ChunkPtr&)>& consumer);
+
+private:
+    StatusOr<std::shared_ptr<Spiller>> _create_spiller();
+
+    const int32_t _plan_node_id;
+    ChunkBuilder _chunk_builder;
+    const size_t _num_key_columns;
+
+    RuntimeState* _state = nullptr;
+    SyncTaskExecutor _executor;
+    std::shared_ptr<SpillerFactory> _spill_factory = make_spilled_factory();
+    SpilledOptions _spill_options;
+    SpillProcessMetrics _metrics;
+    RuntimeProfile::Counter* _spilled_partitions_counter = nullptr;
+
+    // The spiller of a partition is created when any row of it is spilled.
+    std::vector<std::shared_ptr<Spiller>> _partitions;
+    size_t _next_partition = 0;
+    size_t _spilled_rows = 0;
+    bool _finished = false;
+
+    std::vector<uint32_t> _hash_values;
+    std::vector<std::vector<uint32_t>> _partition_rows;
+};
+
+} // namespace starrocks
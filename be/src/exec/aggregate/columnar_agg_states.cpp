@@ -0,0 +1,339 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/aggregate/columnar_agg_states.h"
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "column/type_traits.h"
+#include "gutil/casts.h"
+
+namespace starrocks {
+
+namespace {
+
+// The data and the null flags of the |column|, the null flags are null if there is no null.
+template <typename CppType>
+std::pair<const CppType*, const uint8_t*> unpack_column(const Column* column) {
+    const uint8_t* nulls = nullptr;
+    if (column->is_nullable()) {
+        const auto* nullable = down_cast<const NullableColumn*>(column);
+        if (nullable->has_null()) {
+            nulls = nullable->immutable_null_column_data().data();
+        }
+        column = nullable->data_column().get();
+    }
+    return {reinterpret_cast<const CppType*>(column->raw_data()), nulls};
+}
+
+// The new results of the column |dst| extended by |num_rows| rows.
+template <LogicalType LT>
+struct ExtendedResults {
+    ExtendedResults(Column* dst, size_t num_rows) {
+        Column* data_column = dst;
+        if (dst->is_nullable()) {
+            nullable = down_cast<NullableColumn*>(dst);
+            data_column = nullable->mutable_data_column();
+            auto& null_data = nullable->null_column_data();
+            null_data.resize(null_data.size() + num_rows);
+            nulls = null_data.data() + null_data.size() - num_rows;
+        }
+        auto& data = down_cast<RunTimeColumnType<LT>*>(data_column)->get_data();
+        data.resize(data.size() + num_rows);
+        values = data.data() + data.size() - num_rows;
+    }
+
+    RunTimeCppType<LT>* values = nullptr;
+    // nullptr if |dst| isn't nullable.
+    uint8_t* nulls = nullptr;
+    NullableColumn* nullable = nullptr;
+};
+
+struct SumOp {
+    template <LogicalType LT>
+    static RunTimeCppType<LT> init() {
+        return RunTimeCppType<LT>{};
+    }
+    template <typename T, typename U>
+    static void apply(T& acc, const U& value) {
+        acc += value;
+    }
+};
+
+struct MinOp {
+    template <LogicalType LT>
+    static RunTimeCppType<LT> init() {
+        return RunTimeTypeLimits<LT>::max_value();
+    }
+    template <typename T>
+    static void apply(T& acc, const T& value) {
+        acc = std::min<T>(acc, value);
+    }
+};
+
+struct MaxOp {
+    template <LogicalType LT>
+    static RunTimeCppType<LT> init() {
+        return RunTimeTypeLimits<LT>::min_value();
+    }
+    template <typename T>
+    static void apply(T& acc, const T& value) {
+        acc = std::max<T>(acc, value);
+    }
+};
+
+// The states of sum, min and max, whose intermediate result is the same as the final result, so the intermediate
+// results are merged by the same op as the input rows.
+template <LogicalType ArgLT, LogicalType ResultLT, typename Op>
+class ArithmeticState final : public ColumnarAggStates::State {
+public:
+    using ArgCppType = RunTimeCppType<ArgLT>;
+    using ResultCppType = RunTimeCppType<ResultLT>;
+
+    explicit ArithmeticState(bool is_nullable) : _is_nullable(is_nullable) {}
+
+    void add_group() override {
+        _values.emplace_back(Op::template init<ResultLT>());
+        if (_is_nullable) {
+            _has_values.emplace_back(0);
+        }
+    }
+
+    void update(const Column* column, const uint32_t* group_ids, size_t num_rows, const uint8_t* selection) override {
+        auto [data, nulls] = unpack_column<ArgCppType>(column);
+        _scatter(data, nulls, group_ids, num_rows, selection);
+    }
+
+    void merge(const Column* column, const uint32_t* group_ids, size_t num_rows, const uint8_t* selection) override {
+        auto [data, nulls] = unpack_column<ResultCppType>(column);
+        _scatter(data, nulls, group_ids, num_rows, selection);
+    }
+
+    void output(const uint32_t* group_ids, size_t num_rows, Column* dst) const override {
+        ExtendedResults<ResultLT> results(dst, num_rows);
+        for (size_t i = 0; i < num_rows; i++) {
+            results.values[i] = _values[group_ids[i]];
+        }
+        if (results.nulls != nullptr) {
+            bool has_null = false;
+            for (size_t i = 0; i < num_rows; i++) {
+                results.nulls[i] = _is_nullable && !_has_values[group_ids[i]];
+                has_null |= results.nulls[i];
+            }
+            results.nullable->set_has_null(has_null);
+        }
+    }
+
+    void output_range(uint32_t first_group_id, size_t num_rows, Column* dst) const override {
+        ExtendedResults<ResultLT> results(dst, num_rows);
+        memcpy(results.values, _values.data() + first_group_id, num_rows * sizeof(ResultCppType));
+        if (results.nulls != nullptr) {
+            bool has_null = false;
+            for (size_t i = 0; i < num_rows; i++) {
+                results.nulls[i] = _is_nullable && !_has_values[first_group_id + i];
+                has_null |= results.nulls[i];
+            }
+            results.nullable->set_has_null(has_null);
+        }
+    }
+
+    void reset() override {
+        Buffer<ResultCppType>().swap(_values);
+        std::vector<uint8_t>().swap(_has_values);
+    }
+
+    size_t memory_usage() const override {
+        return _values.capacity() * sizeof(ResultCppType) + _has_values.capacity();
+    }
+
+private:
+    template <typename T>
+    void _scatter(const T* data, const uint8_t* nulls, const uint32_t* group_ids, size_t num_rows,
+                  const uint8_t* selection) {
+        ResultCppType* values = _values.data();
+        if (nulls == nullptr && selection == nullptr) {
+            for (size_t i = 0; i < num_rows; i++) {
+                Op::apply(values[group_ids[i]], static_cast<ResultCppType>(data[i]));
+            }
+            if (_is_nullable) {
+                for (size_t i = 0; i < num_rows; i++) {
+                    _has_values[group_ids[i]] = 1;
+                }
+            }
+            return;
+        }
+        for (size_t i = 0; i < num_rows; i++) {
+            if ((nulls != nullptr && nulls[i]) || (selection != nullptr && selection[i])) {
+                continue;
+            }
+            Op::apply(values[group_ids[i]], static_cast<ResultCppType>(data[i]));
+            if (_is_nullable) {
+                _has_values[group_ids[i]] = 1;
+            }
+        }
+    }
+
+    const bool _is_nullable;
+    Buffer<ResultCppType> _values;
+    std::vector<uint8_t> _has_values;
+};
+
+// The states of count, whose intermediate results are merged by sum.
+class CountState final : public ColumnarAggStates::State {
+public:
+    void add_group() override { _counts.emplace_back(0); }
+
+    void update(const Column* column, const uint32_t* group_ids, size_t num_rows, const uint8_t* selection) override {
+        // count(*) has no input column, and count(col) only counts the non-null rows.
+        const uint8_t* nulls = nullptr;
+        if (column != nullptr && column->is_nullable() && column->has_null()) {
+            nulls = down_cast<const NullableColumn*>(column)->immutable_null_column_data().data();
+        }
+        int64_t* counts = _counts.data();
+        if (nulls == nullptr && selection == nullptr) {
+            for (size_t i = 0; i < num_rows; i++) {
+                counts[group_ids[i]]++;
+            }
+            return;
+        }
+        for (size_t i = 0; i < num_rows; i++) {
+            bool skipped = (nulls != nullptr && nulls[i]) || (selection != nullptr && selection[i]);
+            counts[group_ids[i]] += !skipped;
+        }
+    }
+
+    void merge(const Column* column, const uint32_t* group_ids, size_t num_rows, const uint8_t* selection) override {
+        auto [data, nulls] = unpack_column<int64_t>(column);
+        int64_t* counts = _counts.data();
+        for (size_t i = 0; i < num_rows; i++) {
+            if ((nulls != nullptr && nulls[i]) || (selection != nullptr && selection[i])) {
+                continue;
+            }
+            counts[group_ids[i]] += data[i];
+        }
+    }
+
+    void output(const uint32_t* group_ids, size_t num_rows, Column* dst) const override {
+        ExtendedResults<TYPE_BIGINT> results(dst, num_rows);
+        for (size_t i = 0; i < num_rows; i++) {
+            results.values[i] = _counts[group_ids[i]];
+        }
+    }
+
+    void output_range(uint32_t first_group_id, size_t num_rows, Column* dst) const override {
+        ExtendedResults<TYPE_BIGINT> results(dst, num_rows);
+        memcpy(results.values, _counts.data() + first_group_id, num_rows * sizeof(int64_t));
+    }
+
+    void reset() override { Buffer<int64_t>().swap(_counts); }
+
+    size_t memory_usage() const override { return _counts.capacity() * sizeof(int64_t); }
+
+private:
+    Buffer<int64_t> _counts;
+};
+
+template <typename Op>
+std::unique_ptr<ColumnarAggStates::State> create_arithmetic_state(LogicalType arg_type, LogicalType result_type,
+                                                                  bool is_nullable) {
+#define CREATE_ARITHMETIC_STATE(ARG_TYPE, RESULT_TYPE)                                    \
+    if (arg_type == ARG_TYPE && result_type == RESULT_TYPE) {                             \
+        return std::make_unique<ArithmeticState<ARG_TYPE, RESULT_TYPE, Op>>(is_nullable); \
+    }
+
+    if constexpr (std::is_same_v<Op, SumOp>) {
+        CREATE_ARITHMETIC_STATE(TYPE_TINYINT, TYPE_BIGINT)
+        CREATE_ARITHMETIC_STATE(TYPE_SMALLINT, TYPE_BIGINT)
+        CREATE_ARITHMETIC_STATE(TYPE_INT, TYPE_BIGINT)
+        CREATE_ARITHMETIC_STATE(TYPE_BIGINT, TYPE_BIGINT)
+        CREATE_ARITHMETIC_STATE(TYPE_LARGEINT, TYPE_LARGEINT)
+        CREATE_ARITHMETIC_STATE(TYPE_FLOAT, TYPE_DOUBLE)
+        CREATE_ARITHMETIC_STATE(TYPE_DOUBLE, TYPE_DOUBLE)
+    } else {
+        CREATE_ARITHMETIC_STATE(TYPE_TINYINT, TYPE_TINYINT)
+        CREATE_ARITHMETIC_STATE(TYPE_SMALLINT, TYPE_SMALLINT)
+        CREATE_ARITHMETIC_STATE(TYPE_INT, TYPE_INT)
+        CREATE_ARITHMETIC_STATE(TYPE_BIGINT, TYPE_BIGINT)
+        CREATE_ARITHMETIC_STATE(TYPE_LARGEINT, TYPE_LARGEINT)
+        CREATE_ARITHMETIC_STATE(TYPE_FLOAT, TYPE_FLOAT)
+        CREATE_ARITHMETIC_STATE(TYPE_DOUBLE, TYPE_DOUBLE)
+    }
+#undef CREATE_ARITHMETIC_STATE
+    return nullptr;
+}
+
+} // namespace
+
+std::unique_ptr<ColumnarAggStates::State> ColumnarAggStates::create_state(const std::string& fn_name,
+                                                                          LogicalType arg_type,
+                                                                          LogicalType result_type,
+                                                                          LogicalType serde_type, bool is_nullable) {
+    // The results are output as both the final and the intermediate results.
+    if (result_type != serde_type) {
+        return nullptr;
+    }
+    if (fn_name == "count") {
+        return result_type == TYPE_BIGINT && !is_nullable ? std::make_unique<CountState>() : nullptr;
+    } else if (fn_name == "sum") {
+        return create_arithmetic_state<SumOp>(arg_type, result_type, is_nullable);
+    } else if (fn_name == "min") {
+        return create_arithmetic_state<MinOp>(arg_type, result_type, is_nullable);
+    } else if (fn_name == "max") {
+        return create_arithmetic_state<MaxOp>(arg_type, result_type, is_nullable);
+    }
+    return nullptr;
+}
+
+bool ColumnarAggStates::empty() const {
+    return std::all_of(_states.begin(), _states.end(), [](const auto& state) { return state == nullptr; });
+}
+
+void ColumnarAggStates::get_group_ids(const AggDataPtr* agg_states, size_t num_rows, const uint8_t* selection,
+                                      uint32_t* group_ids) {
+    if (selection == nullptr) {
+        for (size_t i = 0; i < num_rows; i++) {
+            group_ids[i] = group_id(agg_states[i]);
+        }
+        return;
+    }
+    // The states of the selected rows are not allocated.
+    for (size_t i = 0; i < num_rows; i++) {
+        group_ids[i] = selection[i] ? 0 : group_id(agg_states[i]);
+    }
+}
+
+void ColumnarAggStates::reset() {
+    for (auto& state : _states) {
+        if (state != nullptr) {
+            state->reset();
+        }
+    }
+    _num_groups = 0;
+}
+
+size_t ColumnarAggStates::memory_usage() const {
+    size_t usage = 0;
+    for (const auto& state : _states) {
+        if (state != nullptr) {
+            usage += state->memory_usage();
+        }
+    }
+    return usage;
+}
+
+} // namespace starrocks
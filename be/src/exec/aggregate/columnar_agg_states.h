@@ -0,0 +1,110 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "exprs/agg/aggregate.h"
+#include "types/logical_type.h"
+
+namespace starrocks {
+
+// ColumnarAggStates keeps the states of the simple aggregate functions of a hash aggregation, i.e. sum, count, min
+// and max of numeric types, in arrays indexed by the id of the group, instead of in the state blob of every group.
+// The rows of a chunk are scattered into the arrays by tight loops with one virtual call per chunk instead of per
+// row, and the results are copied out of the arrays, as a whole range if the groups are output in allocation order.
+//
+// The id of a group is assigned when the state blob of the group is allocated, and stored in the blob right after
+// the group by keys, see Aggregator.
+class ColumnarAggStates {
+public:
+    // The group by keys take the first 16 bytes of the state blob.
+    static constexpr size_t kGroupIdOffset = 16;
+    static constexpr size_t kHeaderSize = kGroupIdOffset + sizeof(uint32_t);
+
+    // The states of one aggregate function of all the groups.
+    class State {
+    public:
+        virtual ~State() = default;
+
+        // Append the initial state of a new group.
+        virtual void add_group() = 0;
+        // Update the states of |group_ids| by the rows of the input |column|, the rows with a non-zero |selection|
+        // are skipped if |selection| is not null.
+        virtual void update(const Column* column, const uint32_t* group_ids, size_t num_rows,
+                            const uint8_t* selection) = 0;
+        // Same as update, but the rows are the intermediate results.
+        virtual void merge(const Column* column, const uint32_t* group_ids, size_t num_rows,
+                           const uint8_t* selection) = 0;
+        // Append the results of |group_ids| to |dst|, which are the same for finalize and serialize.
+        virtual void output(const uint32_t* group_ids, size_t num_rows, Column* dst) const = 0;
+        // Append the results of the groups [first_group_id, first_group_id + num_rows) to |dst|.
+        virtual void output_range(uint32_t first_group_id, size_t num_rows, Column* dst) const = 0;
+        virtual void reset() = 0;
+        virtual size_t memory_usage() const = 0;
+    };
+
+    // Create the columnar states of the function, nullptr if the function isn't supported.
+    // |count(*)| has no argument, |arg_type| is TYPE_NULL then.
+    static std::unique_ptr<State> create_state(const std::string& fn_name, LogicalType arg_type,
+                                               LogicalType result_type, LogicalType serde_type, bool is_nullable);
+
+    explicit ColumnarAggStates(size_t num_functions) : _states(num_functions) {}
+
+    void set_state(size_t fn_index, std::unique_ptr<State> state) { _states[fn_index] = std::move(state); }
+    bool empty() const;
+    bool is_columnar(size_t fn_index) const { return _states[fn_index] != nullptr; }
+    State* state(size_t fn_index) const { return _states[fn_index].get(); }
+
+    // Assign the id of a new group to the state blob |agg_state|.
+    void add_group(AggDataPtr agg_state) {
+        for (auto& state : _states) {
+            if (state != nullptr) {
+                state->add_group();
+            }
+        }
+        uint32_t group_id = _num_groups++;
+        memcpy(agg_state + kGroupIdOffset, &group_id, sizeof(group_id));
+    }
+
+    static uint32_t group_id(ConstAggDataPtr agg_state) {
+        uint32_t group_id;
+        memcpy(&group_id, agg_state + kGroupIdOffset, sizeof(group_id));
+        return group_id;
+    }
+
+    // Fill |group_ids| by the state blobs of |agg_states|, the rows with a non-zero |selection| are skipped if
+    // |selection| is not null.
+    static void get_group_ids(const AggDataPtr* agg_states, size_t num_rows, const uint8_t* selection,
+                              uint32_t* group_ids);
+
+    // Drop the states of all the groups.
+    void reset();
+    size_t memory_usage() const;
+
+private:
+    // Indexed by the aggregate functions, nullptr for the functions whose states are in the state blobs.
+    std::vector<std::unique_ptr<State>> _states;
+    uint32_t _num_groups = 0;
+};
+
+using ColumnarAggStatesPtr = std::unique_ptr<ColumnarAggStates>;
+
+} // namespace starrocks
@@ -19,6 +19,7 @@
 #include <variant>
 
 #include "column/chunk.h"
+#include "common/config.h"
 #include "common/status.h"
 #include "exec/exec_node.h"
 #include "exec/pipeline/operator.h"
@@ -26,8 +27,10 @@
 #include "gen_cpp/PlanNodes_types.h"
 #include "runtime/current_thread.h"
 #include "runtime/descriptors.h"
+#include "runtime/memory/huge_page_allocator.h"
 #include "types/logical_type.h"
 #include "udf/java/utils.h"
+#include "util/defer_op.h"
 
 namespace starrocks {
 
@@ -206,6 +209,7 @@ Status Aggregator::prepare(RuntimeState* state, ObjectPool* pool, RuntimeProfile
     VLOG_ROW << "has_nullable_key " << _has_nullable_key;
 
     _tmp_agg_states.resize(_state->chunk_size());
+    _tmp_group_ids.resize(_state->chunk_size());
 
     auto& aggregate_functions = _params->aggregate_functions;
     size_t agg_size = aggregate_functions.size();
@@ -305,23 +309,27 @@ Status Aggregator::prepare(RuntimeState* state, ObjectPool* pool, RuntimeProfile
         }
     }
 
-    _mem_pool = std::make_unique<MemPool>();
+    // the chunks of the agg states grow up to the huge pages to reduce the TLB misses of updating them
+    _mem_pool = config::enable_hash_table_huge_pages ? std::make_unique<MemPool>(kHugePageSize)
+                                                     : std::make_unique<MemPool>();
 
-    _agg_states_total_size = 16;
+    _init_columnar_agg_states();
+    // the group id of the columnar agg states follows the group by keys
+    _agg_states_total_size = _columnar_agg_states != nullptr ? ColumnarAggStates::kHeaderSize : 16;
     // compute agg state total size and offsets
     for (int i = 0; i < _agg_fn_ctxs.size(); ++i) {
+        // the columnar agg states take no space in the state blob
+        if (_is_columnar_agg(i)) {
+            continue;
+        }
+        size_t state_align_size = _agg_functions[i]->alignof_size();
+        // We need pad the previous aggregate_state so that this aggregate_state will be aligned.
+        // Add padding by rounding up '_agg_states_total_size' to be a multiplier of state_align_size.
+        _agg_states_total_size =
+                (_agg_states_total_size + state_align_size - 1) / state_align_size * state_align_size;
         _agg_states_offsets[i] = _agg_states_total_size;
         _agg_states_total_size += _agg_functions[i]->size();
-        _max_agg_state_align_size = std::max(_max_agg_state_align_size, _agg_functions[i]->alignof_size());
-
-        // If not the last aggregate_state, we need pad it so that next aggregate_state will be aligned.
-        if (i + 1 < _agg_fn_ctxs.size()) {
-            size_t next_state_align_size = _agg_functions[i + 1]->alignof_size();
-            // Extend total_size to next alignment requirement
-            // Add padding by rounding up '_agg_states_total_size' to be a multiplier of next_state_align_size.
-            _agg_states_total_size = (_agg_states_total_size + next_state_align_size - 1) / next_state_align_size *
-                                     next_state_align_size;
-        }
+        _max_agg_state_align_size = std::max(_max_agg_state_align_size, state_align_size);
     }
     // we need to allocate contiguous memory, so we need some alignment operations
     _max_agg_state_align_size = std::max(_max_agg_state_align_size, HashTableKeyAllocator::aligned);
@@ -470,6 +478,7 @@ void Aggregator::close(RuntimeState* state) {
     } else {
         agg_close();
     }
+    _spiller.reset();
 }
 
 bool Aggregator::is_chunk_buffer_empty() {
@@ -576,9 +585,22 @@ Status Aggregator::compute_batch_agg_states(Chunk* chunk, size_t chunk_size) {
     bool use_intermediate = _use_intermediate_as_input();
     auto& agg_expr_ctxs = use_intermediate ? _intermediate_agg_expr_ctxs : _agg_expr_ctxs;
 
+    if (_columnar_agg_states != nullptr) {
+        ColumnarAggStates::get_group_ids(_tmp_agg_states.data(), chunk_size, nullptr, _tmp_group_ids.data());
+    }
     for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
         // evaluate arguments at i-th agg function
         RETURN_IF_ERROR(evaluate_agg_input_column(chunk, agg_expr_ctxs[i], i));
+        if (_is_columnar_agg(i)) {
+            auto* columnar_state = _columnar_agg_states->state(i);
+            if (!_is_merge_funcs[i] && !use_intermediate) {
+                columnar_state->update(_agg_input_raw_columns[i][0], _tmp_group_ids.data(), chunk_size, nullptr);
+            } else {
+                const Column* column = _agg_input_columns[i][0].get();
+                columnar_state->merge(column, _tmp_group_ids.data(), column->size(), nullptr);
+            }
+            continue;
+        }
         // batch call update or merge
         if (!_is_merge_funcs[i] && !use_intermediate) {
             _agg_functions[i]->update_batch(_agg_fn_ctxs[i], chunk_size, _agg_states_offsets[i],
@@ -597,9 +619,24 @@ Status Aggregator::compute_batch_agg_states_with_selection(Chunk* chunk, size_t
     bool use_intermediate = _use_intermediate_as_input();
     auto& agg_expr_ctxs = use_intermediate ? _intermediate_agg_expr_ctxs : _agg_expr_ctxs;
 
+    if (_columnar_agg_states != nullptr) {
+        ColumnarAggStates::get_group_ids(_tmp_agg_states.data(), chunk_size, _streaming_selection.data(),
+                                         _tmp_group_ids.data());
+    }
     for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
         RETURN_IF_ERROR(evaluate_agg_input_column(chunk, agg_expr_ctxs[i], i));
 
+        if (_is_columnar_agg(i)) {
+            auto* columnar_state = _columnar_agg_states->state(i);
+            if (!_is_merge_funcs[i] && !use_intermediate) {
+                columnar_state->update(_agg_input_raw_columns[i][0], _tmp_group_ids.data(), chunk_size,
+                                       _streaming_selection.data());
+            } else {
+                const Column* column = _agg_input_columns[i][0].get();
+                columnar_state->merge(column, _tmp_group_ids.data(), column->size(), _streaming_selection.data());
+            }
+            continue;
+        }
         if (!_is_merge_funcs[i] && !use_intermediate) {
             _agg_functions[i]->update_batch_selectively(_agg_fn_ctxs[i], chunk_size, _agg_states_offsets[i],
                                                         _agg_input_raw_columns[i].data(), _tmp_agg_states.data(),
@@ -823,6 +860,11 @@ Columns Aggregator::_create_group_by_columns(size_t num_rows) {
 
 void Aggregator::_serialize_to_chunk(ConstAggDataPtr __restrict state, const Columns& agg_result_columns) {
     for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+        if (_is_columnar_agg(i)) {
+            uint32_t group_id = ColumnarAggStates::group_id(state);
+            _columnar_agg_states->state(i)->output(&group_id, 1, agg_result_columns[i].get());
+            continue;
+        }
         _agg_functions[i]->serialize_to_column(_agg_fn_ctxs[i], state + _agg_states_offsets[i],
                                                agg_result_columns[i].get());
     }
@@ -830,6 +872,11 @@ void Aggregator::_serialize_to_chunk(ConstAggDataPtr __restrict state, const Col
 
 void Aggregator::_finalize_to_chunk(ConstAggDataPtr __restrict state, const Columns& agg_result_columns) {
     for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+        if (_is_columnar_agg(i)) {
+            uint32_t group_id = ColumnarAggStates::group_id(state);
+            _columnar_agg_states->state(i)->output(&group_id, 1, agg_result_columns[i].get());
+            continue;
+        }
         _agg_functions[i]->finalize_to_column(_agg_fn_ctxs[i], state + _agg_states_offsets[i],
                                               agg_result_columns[i].get());
     }
@@ -837,6 +884,9 @@ void Aggregator::_finalize_to_chunk(ConstAggDataPtr __restrict state, const Colu
 
 void Aggregator::_destroy_state(AggDataPtr __restrict state) {
     for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+        if (_is_columnar_agg(i)) {
+            continue;
+        }
         _agg_functions[i]->destroy(_agg_fn_ctxs[i], state + _agg_states_offsets[i]);
     }
 }
@@ -1040,6 +1090,36 @@ void Aggregator::_init_agg_hash_variant(HashVariantType& hash_variant) {
             }
         }
     }
+    // The integer keys of the hash maps may be mapped by flat arrays if they are in small ranges.
+    if constexpr (std::is_same_v<HashVariantType, AggHashMapVariant>) {
+        if (config::enable_agg_dense_range_hash_map) {
+            switch (type) {
+#define CONVERT_TO_DENSE_RANGE_TYPE(NAME)           \
+    case HashVariantType::Type::NAME:               \
+        type = HashVariantType::Type::NAME##_dense; \
+        break;
+                CONVERT_TO_DENSE_RANGE_TYPE(phase1_int32);
+                CONVERT_TO_DENSE_RANGE_TYPE(phase1_null_int32);
+                CONVERT_TO_DENSE_RANGE_TYPE(phase1_int64);
+                CONVERT_TO_DENSE_RANGE_TYPE(phase1_null_int64);
+                CONVERT_TO_DENSE_RANGE_TYPE(phase2_int32);
+                CONVERT_TO_DENSE_RANGE_TYPE(phase2_null_int32);
+                CONVERT_TO_DENSE_RANGE_TYPE(phase2_int64);
+                CONVERT_TO_DENSE_RANGE_TYPE(phase2_null_int64);
+#undef CONVERT_TO_DENSE_RANGE_TYPE
+            case HashVariantType::Type::phase1_slice_fx4:
+            case HashVariantType::Type::phase2_slice_fx4:
+                // the nullable columns may be serialized into the keys of different sizes
+                if (!has_null_column) {
+                    type = _aggr_phase == AggrPhase1 ? HashVariantType::Type::phase1_slice_fx4_dense
+                                                     : HashVariantType::Type::phase2_slice_fx4_dense;
+                }
+                break;
+            default:
+                break;
+            }
+        }
+    }
     VLOG_ROW << "hash type is "
              << static_cast<typename std::underlying_type<typename HashVariantType::Type>::type>(type);
     hash_variant.init(_state, type, _agg_stat);
@@ -1127,14 +1207,23 @@ Status Aggregator::convert_hash_map_to_chunk(int32_t chunk_size, ChunkPtr* chunk
 
         {
             SCOPED_TIMER(_agg_stat->agg_append_timer);
+            if (_columnar_agg_states != nullptr) {
+                TRY_CATCH_BAD_ALLOC(_output_columnar_agg_states(read_index, agg_result_columns));
+            }
             if (!use_intermediate) {
                 for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+                    if (_is_columnar_agg(i)) {
+                        continue;
+                    }
                     TRY_CATCH_BAD_ALLOC(_agg_functions[i]->batch_finalize(_agg_fn_ctxs[i], read_index, _tmp_agg_states,
                                                                           _agg_states_offsets[i],
                                                                           agg_result_columns[i].get()));
                 }
             } else {
                 for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+                    if (_is_columnar_agg(i)) {
+                        continue;
+                    }
                     TRY_CATCH_BAD_ALLOC(_agg_functions[i]->batch_serialize(_agg_fn_ctxs[i], read_index, _tmp_agg_states,
                                                                            _agg_states_offsets[i],
                                                                            agg_result_columns[i].get()));
@@ -1258,6 +1347,169 @@ void Aggregator::convert_hash_set_to_chunk(int32_t chunk_size, ChunkPtr* chunk)
     });
 }
 
+Status Aggregator::prepare_spill(RuntimeState* state, RuntimeProfile* runtime_profile, int32_t plan_node_id) {
+    if (!state->enable_spill() || is_none_group_by_exprs() || _limit != -1 || _aggr_mode != AM_DEFAULT) {
+        return Status::OK();
+    }
+    _spiller = std::make_unique<AggregateSpiller>(
+            plan_node_id, [this]() { return _create_spilled_chunk(); }, _group_by_expr_ctxs.size());
+    return _spiller->prepare(state, runtime_profile);
+}
+
+size_t Aggregator::revocable_mem_bytes() const {
+    return _is_only_group_by_columns ? hash_set_memory_usage() : hash_map_memory_usage();
+}
+
+Status Aggregator::spill_hash_table() {
+    DCHECK(_spiller != nullptr);
+    return _output_intermediate_hash_table([this](const ChunkPtr& chunk) { return _spiller->spill(chunk); });
+}
+
+Status Aggregator::_output_intermediate_hash_table(const std::function<Status(const ChunkPtr&)>& consumer) {
+    if (_hash_table_size() == 0) {
+        return Status::OK();
+    }
+
+    // the intermediate rows are not returned
+    const int64_t num_rows_returned = _num_rows_returned;
+    _is_outputting_intermediate = true;
+    DeferOp defer([&]() {
+        _is_outputting_intermediate = false;
+        _num_rows_returned = num_rows_returned;
+        _is_ht_eos = false;
+    });
+
+    _begin_hash_table_iteration();
+    _is_ht_eos = false;
+    while (!_is_ht_eos) {
+        ChunkPtr chunk;
+        if (_is_only_group_by_columns) {
+            convert_hash_set_to_chunk(_state->chunk_size(), &chunk);
+        } else {
+            RETURN_IF_ERROR(convert_hash_map_to_chunk(_state->chunk_size(), &chunk));
+        }
+        if (!chunk->is_empty()) {
+            RETURN_IF_ERROR(consumer(chunk));
+        }
+    }
+    return _reset_hash_table();
+}
+
+Status Aggregator::finish_spill() {
+    if (!spilled()) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(spill_hash_table());
+    RETURN_IF_ERROR(_spiller->finish());
+    return restore_next_spilled_partition();
+}
+
+Status Aggregator::restore_next_spilled_partition() {
+    DCHECK(_spiller != nullptr);
+    RETURN_IF_ERROR(_reset_hash_table());
+    while (_hash_table_size() == 0 && _spiller->has_pending_partition()) {
+        RETURN_IF_ERROR(
+                _spiller->restore_next_partition([this](const ChunkPtr& chunk) { return _merge_spilled_chunk(chunk); }));
+    }
+    _begin_hash_table_iteration();
+    _is_ht_eos = _hash_table_size() == 0;
+    return Status::OK();
+}
+
+Status Aggregator::finish_partitioned_sink(int32_t driver_sequence) {
+    DCHECK(_partitioned_merger != nullptr);
+    DeferOp defer([&]() { _partitioned_merger->finish_sink(); });
+    return _output_intermediate_hash_table([&](const ChunkPtr& chunk) {
+        _partitioned_merger->add_chunk(driver_sequence, chunk);
+        return Status::OK();
+    });
+}
+
+Status Aggregator::merge_partition(int32_t driver_sequence) {
+    DCHECK(_partitioned_merger != nullptr);
+    DCHECK_EQ(_hash_table_size(), 0);
+    for (const auto& chunk : _partitioned_merger->take_partition(driver_sequence)) {
+        RETURN_IF_ERROR(_state->check_mem_limit("AggregatePartitionedMerge"));
+        RETURN_IF_ERROR(_merge_spilled_chunk(chunk));
+    }
+    _begin_hash_table_iteration();
+    _is_ht_eos = _hash_table_size() == 0;
+    return Status::OK();
+}
+
+void Aggregator::_begin_hash_table_iteration() {
+    _num_rows_processed = 0;
+    if (_is_only_group_by_columns) {
+        _hash_set_variant.visit([&](auto& hash_set_with_key) { _it_hash = hash_set_with_key->hash_set.begin(); });
+    } else {
+        _it_hash = _state_allocator.begin();
+    }
+}
+
+Status Aggregator::_reset_hash_table() {
+    // Note: we must free agg_states object before _mem_pool free_all;
+    if (!_is_only_group_by_columns) {
+        _release_agg_memory();
+    }
+    _mem_pool->free_all();
+    if (_is_only_group_by_columns) {
+        TRY_CATCH_BAD_ALLOC(_init_agg_hash_variant(_hash_set_variant));
+    } else {
+        TRY_CATCH_BAD_ALLOC(_init_agg_hash_variant(_hash_map_variant));
+    }
+    _state_allocator.reset();
+    _it_hash.reset();
+    _num_rows_processed = 0;
+    return Status::OK();
+}
+
+Status Aggregator::_merge_spilled_chunk(const ChunkPtr& chunk) {
+    SCOPED_TIMER(_agg_stat->agg_compute_timer);
+    const size_t num_rows = chunk->num_rows();
+    // the spilled chunks are not larger than the chunks output by the hash table.
+    DCHECK_LE(num_rows, _state->chunk_size());
+    for (size_t i = 0; i < _group_by_columns.size(); i++) {
+        _group_by_columns[i] = chunk->get_column_by_index(i);
+    }
+
+    if (_is_only_group_by_columns) {
+        TRY_CATCH_BAD_ALLOC(build_hash_set(num_rows));
+        TRY_CATCH_BAD_ALLOC(try_convert_to_two_level_set());
+        return Status::OK();
+    }
+
+    TRY_CATCH_BAD_ALLOC(build_hash_map(num_rows));
+    TRY_CATCH_BAD_ALLOC(try_convert_to_two_level_map());
+    if (_columnar_agg_states != nullptr) {
+        ColumnarAggStates::get_group_ids(_tmp_agg_states.data(), num_rows, nullptr, _tmp_group_ids.data());
+    }
+    for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+        const Column* column = chunk->get_column_by_index(_group_by_columns.size() + i).get();
+        if (_is_columnar_agg(i)) {
+            _columnar_agg_states->state(i)->merge(column, _tmp_group_ids.data(), num_rows, nullptr);
+            continue;
+        }
+        TRY_CATCH_BAD_ALLOC(_agg_functions[i]->merge_batch(_agg_fn_ctxs[i], num_rows, _agg_states_offsets[i], column,
+                                                           _tmp_agg_states.data()));
+    }
+    return check_has_error();
+}
+
+ChunkUniquePtr Aggregator::_create_spilled_chunk() {
+    // the same layout as the chunks output by the hash table with intermediate agg states.
+    auto chunk = std::make_unique<Chunk>();
+    const auto& slots = _intermediate_tuple_desc->slots();
+    Columns group_by_columns = _create_group_by_columns(_state->chunk_size());
+    for (size_t i = 0; i < group_by_columns.size(); i++) {
+        chunk->append_column(std::move(group_by_columns[i]), slots[i]->id());
+    }
+    Columns agg_result_columns = _create_agg_result_columns(_state->chunk_size(), true);
+    for (size_t i = 0; i < agg_result_columns.size(); i++) {
+        chunk->append_column(std::move(agg_result_columns[i]), slots[group_by_columns.size() + i]->id());
+    }
+    return chunk;
+}
+
 void Aggregator::_release_agg_memory() {
     // If all function states are of POD type,
     // then we don't have to traverse the hash table to call destroy method.
@@ -1268,21 +1520,69 @@ void Aggregator::_release_agg_memory() {
         if (hash_map_with_key != nullptr && !skip_destroy) {
             auto null_data_ptr = hash_map_with_key->get_null_key_data();
             if (null_data_ptr != nullptr) {
-                for (int i = 0; i < _agg_functions.size(); i++) {
-                    _agg_functions[i]->destroy(_agg_fn_ctxs[i], null_data_ptr + _agg_states_offsets[i]);
-                }
+                _destroy_state(null_data_ptr);
             }
             auto it = _state_allocator.begin();
             auto end = _state_allocator.end();
 
             while (it != end) {
-                for (int i = 0; i < _agg_functions.size(); i++) {
-                    _agg_functions[i]->destroy(_agg_fn_ctxs[i], it.value() + _agg_states_offsets[i]);
-                }
+                _destroy_state(it.value());
                 it.next();
             }
         }
     });
+    if (_columnar_agg_states != nullptr) {
+        _columnar_agg_states->reset();
+    }
+}
+
+void Aggregator::_init_columnar_agg_states() {
+    _columnar_agg_states.reset();
+    if (!config::enable_agg_columnar_states || !_support_columnar_agg_states() || _group_by_expr_ctxs.empty()) {
+        return;
+    }
+    auto& aggregate_functions = _params->aggregate_functions;
+    auto columnar_agg_states = std::make_unique<ColumnarAggStates>(aggregate_functions.size());
+    for (size_t i = 0; i < aggregate_functions.size(); i++) {
+        const TFunction& fn = aggregate_functions[i].nodes[0].fn;
+        const AggFunctionTypes& types = _agg_fn_types[i];
+        // the columnar agg states output the same nullable results for finalize and serialize.
+        if (fn.arg_types.size() > 1 || (types.has_nullable_child && !types.is_nullable)) {
+            continue;
+        }
+        LogicalType arg_type = fn.arg_types.empty() ? TYPE_NULL : TypeDescriptor::from_thrift(fn.arg_types[0]).type;
+        columnar_agg_states->set_state(
+                i, ColumnarAggStates::create_state(fn.name.function_name, arg_type, types.result_type.type,
+                                                   types.serde_type.type, types.has_nullable_child));
+    }
+    if (!columnar_agg_states->empty()) {
+        _columnar_agg_states = std::move(columnar_agg_states);
+    }
+}
+
+void Aggregator::_output_columnar_agg_states(size_t num_rows, const Columns& agg_result_columns) {
+    if (num_rows == 0) {
+        return;
+    }
+    uint32_t* group_ids = _tmp_group_ids.data();
+    ColumnarAggStates::get_group_ids(_tmp_agg_states.data(), num_rows, nullptr, group_ids);
+    // The groups are iterated in the allocation order, so their ids are contiguous except the null key,
+    // and the results could be copied as a whole range.
+    bool is_contiguous = true;
+    for (size_t i = 1; i < num_rows; i++) {
+        is_contiguous &= group_ids[i] == group_ids[0] + i;
+    }
+    for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+        if (!_is_columnar_agg(i)) {
+            continue;
+        }
+        auto* columnar_state = _columnar_agg_states->state(i);
+        if (is_contiguous) {
+            columnar_state->output_range(group_ids[0], num_rows, agg_result_columns[i].get());
+        } else {
+            columnar_state->output(group_ids, num_rows, agg_result_columns[i].get());
+        }
+    }
 }
 
 } // namespace starrocks
@@ -28,6 +28,9 @@
 #include "column/vectorized_fwd.h"
 #include "common/statusor.h"
 #include "exec/aggregate/agg_hash_variant.h"
+#include "exec/aggregate/aggregate_partitioned_merger.h"
+#include "exec/aggregate/aggregate_spiller.h"
+#include "exec/aggregate/columnar_agg_states.h"
 #include "exec/aggregate/agg_profile.h"
 #include "exec/pipeline/context_with_dependency.h"
 #include "exprs/agg/aggregate_factory.h"
@@ -240,7 +243,10 @@ public:
     AggrPhase get_aggr_phase() { return _aggr_phase; }
 
     bool is_hash_set() { return _is_only_group_by_columns; }
-    const int64_t hash_map_memory_usage() const { return _hash_map_variant.reserved_memory_usage(mem_pool()); }
+    const int64_t hash_map_memory_usage() const {
+        int64_t usage = _hash_map_variant.reserved_memory_usage(mem_pool());
+        return _columnar_agg_states == nullptr ? usage : usage + _columnar_agg_states->memory_usage();
+    }
     const int64_t hash_set_memory_usage() const { return _hash_set_variant.reserved_memory_usage(mem_pool()); }
 
     TStreamingPreaggregationMode::type streaming_preaggregation_mode() { return _streaming_preaggregation_mode; }
@@ -307,6 +313,33 @@ public:
     // refill_op: pre-cache agg operator, Aggregator's holder.
     Status reset_state(RuntimeState* state, const std::vector<ChunkPtr>& refill_chunks, pipeline::Operator* refill_op);
 
+    // Spilling is only supported by the blocking aggregation with group by and without limit. Once anything is
+    // spilled, all the intermediate results are spilled when the sink is done, and merged back into the hash table
+    // one partition at a time.
+    Status prepare_spill(RuntimeState* state, RuntimeProfile* runtime_profile, int32_t plan_node_id);
+    bool is_spillable() const { return _spiller != nullptr; }
+    bool spilled() const { return _spiller != nullptr && _spiller->spilled(); }
+    // The memory which can be released by spill_hash_table.
+    size_t revocable_mem_bytes() const;
+    // Spill the intermediate results of the hash table, then reset the hash table.
+    Status spill_hash_table();
+    // Called when the sink is done, if anything has been spilled, spill the remaining hash table and
+    // merge the first spilled partition into the hash table.
+    Status finish_spill();
+    bool has_pending_spilled_partition() const { return _spiller != nullptr && _spiller->has_pending_partition(); }
+    // Merge the next spilled partition into the hash table after the hash table has been output.
+    Status restore_next_spilled_partition();
+
+    // The drivers of the blocking aggregation merge their hash tables by partitions, instead of being fed by
+    // a local shuffle exchange, see AggregatePartitionedMerger.
+    void set_partitioned_merger(AggregatePartitionedMergerPtr merger) { _partitioned_merger = std::move(merger); }
+    const AggregatePartitionedMergerPtr& partitioned_merger() const { return _partitioned_merger; }
+    // Called when the sink of |driver_sequence| is done, output the intermediate results of the hash table to
+    // the partitioned merger, then reset the hash table.
+    Status finish_partitioned_sink(int32_t driver_sequence);
+    // Merge the |driver_sequence|-th partition of all the sinks into the hash table, after all of them are done.
+    Status merge_partition(int32_t driver_sequence);
+
 #ifdef NDEBUG
     static constexpr size_t two_level_memory_threshold = 33554432; // 32M, L3 Cache
     static constexpr size_t streaming_hash_table_size_threshold = 10000000;
@@ -371,6 +404,11 @@ protected:
     std::vector<const AggregateFunction*> _agg_functions;
     // agg state when no group by columns
     AggDataPtr _single_agg_state = nullptr;
+    // The states of the simple agg functions kept in arrays instead of the state blobs of the groups,
+    // nullptr if no function is kept in this way.
+    ColumnarAggStatesPtr _columnar_agg_states;
+    // The group ids of the rows to update the columnar agg states.
+    Buffer<uint32_t> _tmp_group_ids;
     // The expr used to evaluate agg input columns
     // one agg function could have multi input exprs
     std::vector<std::vector<ExprContext*>> _agg_expr_ctxs;
@@ -414,6 +452,11 @@ protected:
 
     AggStatistics* _agg_stat;
 
+    std::unique_ptr<AggregateSpiller> _spiller;
+    AggregatePartitionedMergerPtr _partitioned_merger;
+    // Output the serialized agg states of the hash table to spill or to merge by partitions.
+    bool _is_outputting_intermediate = false;
+
 public:
     void build_hash_map(size_t chunk_size, bool agg_group_by_with_limit = false);
     void build_hash_map_with_selection(size_t chunk_size);
@@ -438,7 +481,7 @@ protected:
     }
 
     bool _use_intermediate_as_output() {
-        return _aggr_mode == AM_STREAMING_PRE_CACHE || _aggr_mode == AM_BLOCKING_PRE_CACHE || !_needs_finalize;
+        return _is_outputting_intermediate || _aggr_mode == AM_STREAMING_PRE_CACHE || _aggr_mode == AM_BLOCKING_PRE_CACHE || !_needs_finalize;
     }
 
     Status _reset_state(RuntimeState* state);
@@ -473,6 +516,28 @@ protected:
 
     void _release_agg_memory();
 
+    // Whether the states of the simple agg functions could be kept by ColumnarAggStates, false for the aggregators
+    // managing the agg states by themselves.
+    virtual bool _support_columnar_agg_states() const { return true; }
+    void _init_columnar_agg_states();
+    bool _is_columnar_agg(size_t i) const {
+        return _columnar_agg_states != nullptr && _columnar_agg_states->is_columnar(i);
+    }
+    // Output the columnar agg states of the groups in _tmp_agg_states[0, num_rows).
+    void _output_columnar_agg_states(size_t num_rows, const Columns& agg_result_columns);
+
+    size_t _hash_table_size() const {
+        return _is_only_group_by_columns ? _hash_set_variant.size() : _hash_map_variant.size();
+    }
+    void _begin_hash_table_iteration();
+    // Release the agg states and the keys, and create an empty hash table.
+    Status _reset_hash_table();
+    // Output all the intermediate results of the hash table to |consumer|, then reset the hash table.
+    Status _output_intermediate_hash_table(const std::function<Status(const ChunkPtr&)>& consumer);
+    // Merge the intermediate results output by _output_intermediate_hash_table into the hash table.
+    Status _merge_spilled_chunk(const ChunkPtr& chunk);
+    ChunkUniquePtr _create_spilled_chunk();
+
     template <class HashMapWithKey>
     friend struct AllocateState;
 };
@@ -481,7 +546,13 @@ template <class HashMapWithKey>
 inline AggDataPtr AllocateState<HashMapWithKey>::operator()(const typename HashMapWithKey::KeyType& key) {
     AggDataPtr agg_state = aggregator->_state_allocator.allocate();
     *reinterpret_cast<typename HashMapWithKey::KeyType*>(agg_state) = key;
+    if (aggregator->_columnar_agg_states != nullptr) {
+        aggregator->_columnar_agg_states->add_group(agg_state);
+    }
     for (int i = 0; i < aggregator->_agg_fn_ctxs.size(); i++) {
+        if (aggregator->_is_columnar_agg(i)) {
+            continue;
+        }
         aggregator->_agg_functions[i]->create(aggregator->_agg_fn_ctxs[i],
                                               agg_state + aggregator->_agg_states_offsets[i]);
     }
@@ -491,7 +562,13 @@ inline AggDataPtr AllocateState<HashMapWithKey>::operator()(const typename HashM
 template <class HashMapWithKey>
 inline AggDataPtr AllocateState<HashMapWithKey>::operator()(std::nullptr_t) {
     AggDataPtr agg_state = aggregator->_state_allocator.allocate_null_key_data();
+    if (aggregator->_columnar_agg_states != nullptr) {
+        aggregator->_columnar_agg_states->add_group(agg_state);
+    }
     for (int i = 0; i < aggregator->_agg_fn_ctxs.size(); i++) {
+        if (aggregator->_is_columnar_agg(i)) {
+            continue;
+        }
         aggregator->_agg_functions[i]->create(aggregator->_agg_fn_ctxs[i],
                                               agg_state + aggregator->_agg_states_offsets[i]);
     }
@@ -511,16 +588,21 @@ public:
         }
         auto aggregator = std::make_shared<T>(convert_to_aggregator_params(_tnode));
         aggregator->set_aggr_mode(_aggr_mode);
+        if (_partitioned_merger != nullptr) {
+            aggregator->set_partitioned_merger(_partitioned_merger);
+        }
         _aggregators[id] = aggregator;
         return aggregator;
     }
 
     void set_aggr_mode(AggrMode aggr_mode) { _aggr_mode = aggr_mode; }
+    void set_partitioned_merger(AggregatePartitionedMergerPtr merger) { _partitioned_merger = std::move(merger); }
 
 private:
     const TPlanNode& _tnode;
     std::unordered_map<size_t, Ptr> _aggregators;
     AggrMode _aggr_mode = AggrMode::AM_DEFAULT;
+    AggregatePartitionedMergerPtr _partitioned_merger;
 };
 
 using AggregatorFactory = AggregatorFactoryBase<Aggregator>;
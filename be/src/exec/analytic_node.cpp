@@ -19,6 +19,7 @@
 #include <memory>
 
 #include "column/chunk.h"
+#include "common/config.h"
 #include "exec/pipeline/analysis/analytic_sink_operator.h"
 #include "exec/pipeline/analysis/analytic_source_operator.h"
 #include "exec/pipeline/hash_partition_context.h"
@@ -65,6 +66,10 @@ AnalyticNode::AnalyticNode(ObjectPool* pool, const TPlanNode& tnode, const Descr
 Status AnalyticNode::init(const TPlanNode& tnode, RuntimeState* state) {
     RETURN_IF_ERROR(ExecNode::init(tnode, state));
     DCHECK(_conjunct_ctxs.empty());
+    if (state != nullptr && state->enable_pipeline_engine()) {
+        RETURN_IF_ERROR(Expr::create_expr_trees(_pool, tnode.analytic_node.partition_exprs, &_partition_expr_ctxs,
+                                                state));
+    }
 
     return Status::OK();
 }
@@ -342,6 +347,15 @@ pipeline::OpFactories AnalyticNode::decompose_to_pipeline(pipeline::PipelineBuil
     }
 
     upstream_source_op = context->source_operator(ops_with_sink);
+    if (!_partition_expr_ctxs.empty() && upstream_source_op->degree_of_parallelism() == 1 &&
+        config::enable_analytic_partition_wise_parallel) {
+        // The sorted input is gathered into one driver, e.g. the sort isn't aware of the analytic partitions.
+        // Shuffling it by the partition columns keeps both the order of the rows and the rows of a partition in one
+        // driver, so the partitions can be evaluated by all the drivers in parallel.
+        ops_with_sink = context->maybe_interpolate_local_shuffle_exchange(runtime_state(), ops_with_sink,
+                                                                          _partition_expr_ctxs);
+        upstream_source_op = context->source_operator(ops_with_sink);
+    }
     auto degree_of_parallelism = upstream_source_op->degree_of_parallelism();
 
     AnalytorFactoryPtr analytor_factory =
@@ -44,6 +44,8 @@ private:
     // Tuple descriptor for storing results of analytic fn evaluation.
     const TupleDescriptor* _result_tuple_desc;
     AnalytorPtr _analytor = nullptr;
+    // The partition exprs to shuffle the sorted input gathered into one driver in the pipeline engine.
+    std::vector<ExprContext*> _partition_expr_ctxs;
 
     Status _get_next_for_unbounded_frame(RuntimeState* state, ChunkPtr* chunk, bool* eos);
     Status _get_next_for_unbounded_preceding_range_frame(RuntimeState* state, ChunkPtr* chunk, bool* eos);
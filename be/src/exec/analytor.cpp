@@ -14,6 +14,7 @@
 
 #include "exec/analytor.h"
 
+#include <algorithm>
 #include <cmath>
 #include <ios>
 #include <memory>
@@ -80,6 +81,32 @@ Analytor::Analytor(const TPlanNode& tnode, const RowDescriptor& child_row_desc,
     }
 }
 
+bool Analytor::_is_sliding_rows_frame() const {
+    // Keep consistent with the frames processed by AnalyticSinkOperator::_process_by_partition_for_sliding_frame.
+    const TAnalyticNode& analytic_node = _tnode.analytic_node;
+    if (!analytic_node.__isset.window || analytic_node.window.type == TAnalyticWindowType::RANGE) {
+        return false;
+    }
+    const TAnalyticWindow& window = analytic_node.window;
+    return window.__isset.window_start ||
+           (window.__isset.window_end && window.window_end.type != TAnalyticWindowBoundaryType::CURRENT_ROW);
+}
+
+bool Analytor::_support_removable_cumulatively(const TFunction& fn) const {
+    const std::string& name = fn.name.function_name;
+    if (name == "sum" || name == "avg" || name == "count") {
+        return true;
+    }
+    // max/min are evaluated by the monotonic queues, which don't support all the types.
+    if ((name == "max" || name == "min") && fn.binary_type == TFunctionBinaryType::BUILTIN && !fn.arg_types.empty()) {
+        const TypeDescriptor return_type = TypeDescriptor::from_thrift(fn.ret_type);
+        const TypeDescriptor arg_type = TypeDescriptor::from_thrift(fn.arg_types[0]);
+        return get_window_function(name + "_sliding", arg_type.type, return_type.type, true, fn.binary_type,
+                                   _state->func_version()) != nullptr;
+    }
+    return false;
+}
+
 Status Analytor::prepare(RuntimeState* state, ObjectPool* pool, RuntimeProfile* runtime_profile) {
     _state = state;
 
@@ -108,6 +135,14 @@ Status Analytor::prepare(RuntimeState* state, ObjectPool* pool, RuntimeProfile*
 
     bool has_outer_join_child = analytic_node.__isset.has_outer_join_child && analytic_node.has_outer_join_child;
 
+    // The sliding frames are evaluated by updating the states removably and cumulatively if all the functions
+    // support it, otherwise every frame is evaluated from scratch.
+    _support_cumulative_algo = state->enable_pipeline_engine() && _is_sliding_rows_frame() &&
+                               std::all_of(analytic_node.analytic_functions.begin(),
+                                           analytic_node.analytic_functions.end(), [&](const TExpr& desc) {
+                                               return _support_removable_cumulatively(desc.nodes[0].fn);
+                                           });
+
     _has_lead_lag_function = false;
     for (int i = 0; i < agg_size; ++i) {
         const TExpr& desc = analytic_node.analytic_functions[i];
@@ -133,12 +168,6 @@ Status Analytor::prepare(RuntimeState* state, ObjectPool* pool, RuntimeProfile*
             _need_partition_materializing = true;
         }
 
-        if (fn.name.function_name == "sum" || fn.name.function_name == "avg" || fn.name.function_name == "count") {
-            if (state->enable_pipeline_engine()) {
-                _support_cumulative_algo = true;
-            }
-        }
-
         bool is_input_nullable = false;
         if (fn.name.function_name == "count" || fn.name.function_name == "row_number" ||
             fn.name.function_name == "rank" || fn.name.function_name == "dense_rank" ||
@@ -177,6 +206,9 @@ Status Analytor::prepare(RuntimeState* state, ObjectPool* pool, RuntimeProfile*
                 // to find right AggregateFunction to support ignore nulls.
                 real_fn_name += "_in";
             }
+            if (_support_cumulative_algo && (real_fn_name == "max" || real_fn_name == "min")) {
+                real_fn_name += "_sliding";
+            }
             func = get_window_function(real_fn_name, arg_type.type, return_type.type, is_input_nullable, fn.binary_type,
                                        state->func_version());
             if (func == nullptr) {
@@ -277,6 +277,11 @@ private:
     bool _support_cumulative_algo = false;
 
 private:
+    // Whether the frame is a rows frame evaluated as a sliding frame, e.g. "rows between m preceding and n following".
+    bool _is_sliding_rows_frame() const;
+    // Whether the window function |fn| over sliding frames supports update_state_removable_cumulatively.
+    bool _support_removable_cumulatively(const TFunction& fn) const;
+
     void _append_column(size_t chunk_size, Column* dst_column, ColumnPtr& src_column);
     void _update_window_batch_normal(int64_t peer_group_start, int64_t peer_group_end, int64_t frame_start,
                                      int64_t frame_end);
@@ -138,6 +138,11 @@ public:
 
     virtual bool has_pending_data() { return false; }
 
+    // The sorted output kept in memory after done(), which could be split and merged in parallel instead of
+    // get_next(), nullptr if not supported. The chunks sliced from it must be passed to materialize_output().
+    virtual const SortedRuns* sorted_runs() const { return nullptr; }
+    virtual StatusOr<ChunkUniquePtr> materialize_output(ChunkUniquePtr chunk) { return chunk; }
+
     const std::shared_ptr<Spiller>& spiller() const { return _spiller; }
 
     size_t revocable_mem_bytes() const { return _revocable_mem_bytes; }
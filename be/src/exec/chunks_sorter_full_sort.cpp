@@ -283,6 +283,15 @@ Status ChunksSorterFullSort::get_next(ChunkPtr* chunk, bool* eos) {
     return Status::OK();
 }
 
+StatusOr<ChunkUniquePtr> ChunksSorterFullSort::materialize_output(ChunkUniquePtr chunk) {
+    if (!_early_materialized_slots.empty()) {
+        ChunkPtr materialized = _late_materialize(std::move(chunk));
+        chunk = std::make_unique<Chunk>(materialized->columns(), materialized->get_slot_id_to_index_map());
+    }
+    RETURN_IF_ERROR(chunk->downgrade());
+    return chunk;
+}
+
 size_t ChunksSorterFullSort::get_output_rows() const {
     return _merged_runs.num_rows();
 }
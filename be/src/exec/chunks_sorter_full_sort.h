@@ -56,6 +56,9 @@ public:
 
     int64_t mem_usage() const override;
 
+    const SortedRuns* sorted_runs() const override { return &_merged_runs; }
+    StatusOr<ChunkUniquePtr> materialize_output(ChunkUniquePtr chunk) override;
+
     void setup_runtime(starrocks::RuntimeProfile* profile, MemTracker* parent_mem_tracker) override;
 
 private:
@@ -76,8 +76,13 @@ Status ChunksSorterTopn::update(RuntimeState* state, const ChunkPtr& chunk) {
     // cached chunks can be dropped, so it can reduce the memory usage.
     // TopN caches _limit or _size_of_chunk_batch primitive chunks,
     // performs sorting once, and discards extra rows
-
-    if (_limit > 0 && (chunk_number >= _limit || chunk_number >= _max_buffered_chunks)) {
+    //
+    // If the runtime filter is required, sort as soon as there are enough rows for the first time,
+    // so that the boundary of top-n can be published to the scan as early as possible.
+    bool build_first_runtime_filter = _runtime_filter_required && !_init_merged_segment &&
+                                      _raw_chunks.size_of_rows >= _get_number_of_rows_to_sort();
+    if (_limit > 0 &&
+        (chunk_number >= _limit || chunk_number >= _max_buffered_chunks || build_first_runtime_filter)) {
         RETURN_IF_ERROR(_sort_chunks(state));
     }
 
@@ -108,9 +113,14 @@ Status ChunksSorterTopn::done(RuntimeState* state) {
 }
 
 std::vector<JoinRuntimeFilter*>* ChunksSorterTopn::runtime_filters(ObjectPool* pool) {
+    _runtime_filter_required = true;
     if (!_init_merged_segment) {
         return nullptr;
     }
+    // The boundary is changed only when _merged_segment is changed, so needn't publish the same runtime filter again.
+    if (!_runtime_filter.empty() && _runtime_filter_merged_segment_version == _merged_segment_version) {
+        return nullptr;
+    }
 
     const size_t max_value_row_id = _get_number_of_rows_to_sort() - 1;
     const auto& order_by_column = _merged_segment.order_by_columns[0];
@@ -133,6 +143,7 @@ std::vector<JoinRuntimeFilter*>* ChunksSorterTopn::runtime_filters(ObjectPool* p
                 (*_sort_exprs)[0]->root()->type().type, false, detail::SortRuntimeFilterUpdater(),
                 _runtime_filter.back(), order_by_column, current_max_value_row_id, _sort_desc.descs[0].asc_order());
     }
+    _runtime_filter_merged_segment_version = _merged_segment_version;
 
     return &_runtime_filter;
 }
@@ -373,6 +384,7 @@ Status ChunksSorterTopn::_merge_sort_data_as_merged_segment(RuntimeState* state,
         RETURN_IF_ERROR(_hybrid_sort_first_time(state, new_permutation.second, segments));
         _init_merged_segment = true;
     }
+    _merged_segment_version++;
 
     // Include release memory's time in _merge_timer.
     Permutation().swap(new_permutation.first);
@@ -144,6 +144,11 @@ private:
     const TTopNType::type _topn_type;
 
     std::vector<JoinRuntimeFilter*> _runtime_filter;
+    // Set when runtime_filters() is called, which means the runtime filter is required by the sink.
+    bool _runtime_filter_required = false;
+    // Increased whenever _merged_segment is updated, used to skip publishing the unchanged runtime filter.
+    int64_t _merged_segment_version = 0;
+    int64_t _runtime_filter_merged_segment_version = -1;
 
     RuntimeProfile::Counter* _sort_filter_rows = nullptr;
     RuntimeProfile::Counter* _sort_filter_timer = nullptr;
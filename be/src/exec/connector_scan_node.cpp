@@ -14,6 +14,7 @@
 
 #include "exec/connector_scan_node.h"
 
+#include <algorithm>
 #include <atomic>
 #include <memory>
 
@@ -23,6 +24,9 @@
 #include "exec/stream/scan/stream_scan_operator.h"
 #include "runtime/current_thread.h"
 #include "runtime/exec_env.h"
+#include "runtime/stream_load/load_stream_mgr.h"
+#include "storage/lake/cache_warmer.h"
+#include "storage/lake/tablet.h"
 #include "util/priority_thread_pool.hpp"
 
 namespace starrocks {
@@ -567,7 +571,7 @@ Status ConnectorScanNode::close(RuntimeState* state) {
 }
 
 Status ConnectorScanNode::set_scan_ranges(const std::vector<TScanRangeParams>& scan_ranges) {
-    _scan_ranges = scan_ranges;
+    _scan_ranges = _split_columnar_file_scan_ranges(_split_stream_load_scan_ranges(scan_ranges));
     if (!accept_empty_scan_ranges() && scan_ranges.size() == 0) {
         // If scan ranges size is zero,
         // it means data source provider does not support reading by scan ranges.
@@ -595,4 +599,140 @@ bool ConnectorScanNode::always_shared_scan() const {
     return config::connector_scan_node_always_shared_scan;
 }
 
+StatusOr<pipeline::MorselQueuePtr> ConnectorScanNode::convert_scan_range_to_morsel_queue(
+        const std::vector<TScanRangeParams>& scan_ranges, int node_id, int32_t pipeline_dop,
+        bool enable_tablet_internal_parallel, TTabletInternalParallelMode::type tablet_internal_parallel_mode,
+        size_t num_total_scan_ranges) {
+    if (_connector_type == connector::ConnectorType::LAKE && config::enable_lake_cache_aware_scan &&
+        ExecEnv::GetInstance()->lake_tablet_manager() != nullptr) {
+        return ScanNode::convert_scan_range_to_morsel_queue(
+                _order_lake_scan_ranges_by_cache(scan_ranges), node_id, pipeline_dop, enable_tablet_internal_parallel,
+                tablet_internal_parallel_mode, num_total_scan_ranges);
+    }
+    if (_connector_type == connector::ConnectorType::FILE) {
+        auto split_scan_ranges = _split_columnar_file_scan_ranges(_split_stream_load_scan_ranges(scan_ranges));
+        return ScanNode::convert_scan_range_to_morsel_queue(split_scan_ranges, node_id, pipeline_dop,
+                                                            enable_tablet_internal_parallel,
+                                                            tablet_internal_parallel_mode, split_scan_ranges.size());
+    }
+    return ScanNode::convert_scan_range_to_morsel_queue(scan_ranges, node_id, pipeline_dop,
+                                                        enable_tablet_internal_parallel, tablet_internal_parallel_mode,
+                                                        num_total_scan_ranges);
+}
+
+std::vector<TScanRangeParams> ConnectorScanNode::_split_stream_load_scan_ranges(
+        const std::vector<TScanRangeParams>& scan_ranges) {
+    if (_connector_type != connector::ConnectorType::FILE || scan_ranges.size() != 1 ||
+        !scan_ranges[0].scan_range.__isset.broker_scan_range) {
+        return scan_ranges;
+    }
+    const auto& broker_scan_range = scan_ranges[0].scan_range.broker_scan_range;
+    if (broker_scan_range.ranges.size() != 1) {
+        return scan_ranges;
+    }
+    // Only the plain csv without enclose and escape can be split at the row delimiters, and the header must be
+    // skipped by a single scanner.
+    const auto& range = broker_scan_range.ranges[0];
+    const auto& params = broker_scan_range.params;
+    if (range.file_type != TFileType::FILE_STREAM || range.format_type != TFileFormatType::FORMAT_CSV_PLAIN ||
+        (params.__isset.enclose && params.enclose != 0) || (params.__isset.escape && params.escape != 0) ||
+        (params.__isset.skip_header && params.skip_header > 0)) {
+        return scan_ranges;
+    }
+    auto pipe = ExecEnv::GetInstance()->load_stream_mgr()->get(range.load_id);
+    if (pipe == nullptr || pipe->num_parsers() <= 1) {
+        return scan_ranges;
+    }
+    return std::vector<TScanRangeParams>(pipe->num_parsers(), scan_ranges[0]);
+}
+
+std::vector<TScanRangeParams> ConnectorScanNode::_split_columnar_file_scan_ranges(
+        const std::vector<TScanRangeParams>& scan_ranges) {
+    const int64_t split_bytes = config::file_scan_range_split_bytes;
+    if (_connector_type != connector::ConnectorType::FILE || split_bytes <= 0) {
+        return scan_ranges;
+    }
+    // The readers only read the row groups or stripes starting in the range, so the file can be split anywhere.
+    auto splittable = [split_bytes](const TBrokerRangeDesc& range) {
+        return (range.format_type == TFileFormatType::FORMAT_PARQUET ||
+                range.format_type == TFileFormatType::FORMAT_ORC) &&
+               range.file_type != TFileType::FILE_STREAM && range.size > split_bytes;
+    };
+    std::vector<TScanRangeParams> split_scan_ranges;
+    for (const auto& scan_range : scan_ranges) {
+        if (!scan_range.scan_range.__isset.broker_scan_range ||
+            std::none_of(scan_range.scan_range.broker_scan_range.ranges.begin(),
+                         scan_range.scan_range.broker_scan_range.ranges.end(), splittable)) {
+            split_scan_ranges.emplace_back(scan_range);
+            continue;
+        }
+        // the ranges not split are kept in the original scan range
+        TScanRangeParams rest = scan_range;
+        auto& rest_ranges = rest.scan_range.broker_scan_range.ranges;
+        rest_ranges.clear();
+        for (const auto& range : scan_range.scan_range.broker_scan_range.ranges) {
+            if (!splittable(range)) {
+                rest_ranges.emplace_back(range);
+                continue;
+            }
+            for (int64_t offset = 0; offset < range.size; offset += split_bytes) {
+                TBrokerRangeDesc split_range = range;
+                split_range.__set_start_offset(range.start_offset + offset);
+                split_range.__set_size(std::min(split_bytes, range.size - offset));
+                TScanRangeParams split_scan_range = rest;
+                split_scan_range.scan_range.broker_scan_range.ranges = {std::move(split_range)};
+                split_scan_ranges.emplace_back(std::move(split_scan_range));
+            }
+        }
+        if (!rest_ranges.empty()) {
+            split_scan_ranges.emplace_back(std::move(rest));
+        }
+    }
+    return split_scan_ranges;
+}
+
+std::vector<TScanRangeParams> ConnectorScanNode::_order_lake_scan_ranges_by_cache(
+        const std::vector<TScanRangeParams>& scan_ranges) {
+    auto* tablet_mgr = ExecEnv::GetInstance()->lake_tablet_manager();
+    std::vector<std::pair<double, const TScanRangeParams*>> ranges;
+    std::vector<lake::CacheWarmupTask> prefetches;
+    ranges.reserve(scan_ranges.size());
+    for (const auto& scan_range : scan_ranges) {
+        // The ranges whose residency is unknown are handed out last, and not prefetched.
+        double cached_ratio = -1;
+        if (scan_range.scan_range.__isset.internal_scan_range) {
+            const auto& range = scan_range.scan_range.internal_scan_range;
+            int64_t version = strtol(range.version.c_str(), nullptr, 10);
+            auto residency = [&]() -> StatusOr<lake::TabletCacheResidency> {
+                ASSIGN_OR_RETURN(auto tablet, tablet_mgr->get_tablet(range.tablet_id));
+                return tablet.get_cache_residency(version);
+            }();
+            if (residency.ok()) {
+                cached_ratio = residency->cached_ratio();
+                if (cached_ratio < 1) {
+                    prefetches.push_back({.tablet_id = range.tablet_id, .version = version, .record = false});
+                }
+            } else {
+                VLOG(2) << "Fail to get the cache residency of tablet " << range.tablet_id << ": "
+                        << residency.status();
+            }
+        }
+        ranges.emplace_back(cached_ratio, &scan_range);
+    }
+    std::stable_sort(ranges.begin(), ranges.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    auto* warmer = ExecEnv::GetInstance()->lake_cache_warmer();
+    if (config::lake_cache_aware_scan_prefetch && warmer != nullptr && !prefetches.empty()) {
+        auto st = warmer->submit(std::move(prefetches));
+        LOG_IF(WARNING, !st.ok()) << "Fail to prefetch the uncached lake tablets: " << st;
+    }
+
+    std::vector<TScanRangeParams> ordered;
+    ordered.reserve(ranges.size());
+    for (const auto& [_, scan_range] : ranges) {
+        ordered.emplace_back(*scan_range);
+    }
+    return ordered;
+}
+
 } // namespace starrocks
@@ -51,7 +51,22 @@ public:
     int io_tasks_per_scan_operator() const override;
     bool always_shared_scan() const override;
 
+    StatusOr<pipeline::MorselQueuePtr> convert_scan_range_to_morsel_queue(
+            const std::vector<TScanRangeParams>& scan_ranges, int node_id, int32_t pipeline_dop,
+            bool enable_tablet_internal_parallel, TTabletInternalParallelMode::type tablet_internal_parallel_mode,
+            size_t num_total_scan_ranges) override;
+
 private:
+    // Order the scan ranges of lake tablets by the ratio of the cached segments, in descending order,
+    // and submit the uncached tablets to the cache warmer.
+    std::vector<TScanRangeParams> _order_lake_scan_ranges_by_cache(const std::vector<TScanRangeParams>& scan_ranges);
+    // Split the scan range of a stream load into several ones parsing the same pipe in parallel,
+    // if it's allowed by the load, see StreamLoadPipe::read_records.
+    std::vector<TScanRangeParams> _split_stream_load_scan_ranges(const std::vector<TScanRangeParams>& scan_ranges);
+    // Split the large parquet and orc file ranges of a load at config::file_scan_range_split_bytes, so that a few
+    // large files can be scanned in parallel at row group or stripe granularity.
+    std::vector<TScanRangeParams> _split_columnar_file_scan_ranges(const std::vector<TScanRangeParams>& scan_ranges);
+
     RuntimeState* _runtime_state = nullptr;
     connector::DataSourceProviderPtr _data_source_provider = nullptr;
     connector::ConnectorType _connector_type;
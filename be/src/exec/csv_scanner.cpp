@@ -357,7 +357,8 @@ Status CSVScanner::_parse_csv(Chunk* chunk) {
     csv::Converter::Options options{.invalid_field_as_null = !_strict_mode};
 
     for (size_t num_rows = chunk->num_rows(); num_rows < capacity; /**/) {
-        status = _curr_reader->next_record(&record);
+        fields.clear();
+        status = _curr_reader->next_record(&record, &fields);
         if (status.is_end_of_file()) {
             break;
         } else if (!status.ok()) {
@@ -367,9 +368,6 @@ Status CSVScanner::_parse_csv(Chunk* chunk) {
             continue;
         }
 
-        fields.clear();
-        _curr_reader->split_record(record, &fields);
-
         if (fields.size() != _num_fields_in_csv) {
             if (_counter->num_rows_filtered++ < 50) {
                 std::stringstream error_msg;
@@ -33,25 +33,23 @@ void ExceptHashSet<HashSet>::build_set(RuntimeState* state, const ChunkPtr& chun
                                        const std::vector<ExprContext*>& exprs, MemPool* pool,
                                        BufferState* buffer_state) {
     size_t chunk_size = chunk->num_rows();
+    _evaluate_columns(chunk, exprs, buffer_state);
     buffer_state->slice_sizes.assign(state->chunk_size(), 0);
 
-    size_t cur_max_one_row_size = _get_max_serialize_size(chunk, exprs);
+    size_t cur_max_one_row_size = _get_max_serialize_size(buffer_state);
     if (UNLIKELY(cur_max_one_row_size > buffer_state->max_one_row_size)) {
         buffer_state->max_one_row_size = cur_max_one_row_size;
         buffer_state->mem_pool.clear();
         buffer_state->buffer = buffer_state->mem_pool.allocate(buffer_state->max_one_row_size * state->chunk_size());
     }
 
-    _serialize_columns(chunk, exprs, chunk_size, buffer_state);
+    _serialize_columns(chunk_size, buffer_state);
 
     for (size_t i = 0; i < chunk_size; ++i) {
-        ExceptSliceFlag key(buffer_state->buffer + i * buffer_state->max_one_row_size, buffer_state->slice_sizes[i]);
-        _hash_set->lazy_emplace(key, [&](const auto& ctor) {
-            uint8_t* pos = pool->allocate(key.slice.size);
-            memcpy(pos, key.slice.data, key.slice.size);
-            ctor(pos, key.slice.size);
-        });
+        SerializedSetKey key(buffer_state->buffer + i * buffer_state->max_one_row_size, buffer_state->slice_sizes[i]);
+        _hash_set->lazy_emplace(key, [&](const auto& ctor) { ctor(key, pool); });
     }
+    buffer_state->key_columns.clear();
 }
 
 template <typename HashSet>
@@ -64,9 +62,10 @@ template <typename HashSet>
 Status ExceptHashSet<HashSet>::erase_duplicate_row(RuntimeState* state, const ChunkPtr& chunk,
                                                    const std::vector<ExprContext*>& exprs, BufferState* buffer_state) {
     size_t chunk_size = chunk->num_rows();
+    _evaluate_columns(chunk, exprs, buffer_state);
     buffer_state->slice_sizes.assign(state->chunk_size(), 0);
 
-    size_t cur_max_one_row_size = _get_max_serialize_size(chunk, exprs);
+    size_t cur_max_one_row_size = _get_max_serialize_size(buffer_state);
     if (UNLIKELY(cur_max_one_row_size > buffer_state->max_one_row_size)) {
         buffer_state->max_one_row_size = cur_max_one_row_size;
         buffer_state->mem_pool.clear();
@@ -77,15 +76,16 @@ Status ExceptHashSet<HashSet>::erase_duplicate_row(RuntimeState* state, const Ch
         RETURN_IF_LIMIT_EXCEEDED(state, "Except, while probe hash table.");
     }
 
-    _serialize_columns(chunk, exprs, chunk_size, buffer_state);
+    _serialize_columns(chunk_size, buffer_state);
 
     for (size_t i = 0; i < chunk_size; ++i) {
-        ExceptSliceFlag key(buffer_state->buffer + i * buffer_state->max_one_row_size, buffer_state->slice_sizes[i]);
+        SerializedSetKey key(buffer_state->buffer + i * buffer_state->max_one_row_size, buffer_state->slice_sizes[i]);
         auto iter = _hash_set->find(key);
         if (iter != _hash_set->end()) {
-            iter->deleted = true;
+            iter->set_flag(kDeleted);
         }
     }
+    buffer_state->key_columns.clear();
 
     return Status::OK();
 }
@@ -120,10 +120,18 @@ int64_t ExceptHashSet<HashSet>::mem_usage(BufferState* buffer_state) {
 }
 
 template <typename HashSet>
-size_t ExceptHashSet<HashSet>::_get_max_serialize_size(const ChunkPtr& chunk, const std::vector<ExprContext*>& exprs) {
-    size_t max_size = 0;
+void ExceptHashSet<HashSet>::_evaluate_columns(const ChunkPtr& chunk, const std::vector<ExprContext*>& exprs,
+                                               BufferState* buffer_state) {
+    buffer_state->key_columns.clear();
     for (auto expr : exprs) {
-        ColumnPtr key_column = EVALUATE_NULL_IF_ERROR(expr, expr->root(), chunk.get());
+        buffer_state->key_columns.emplace_back(EVALUATE_NULL_IF_ERROR(expr, expr->root(), chunk.get()));
+    }
+}
+
+template <typename HashSet>
+size_t ExceptHashSet<HashSet>::_get_max_serialize_size(const BufferState* buffer_state) {
+    size_t max_size = 0;
+    for (const auto& key_column : buffer_state->key_columns) {
         max_size += key_column->max_one_element_serialize_size();
         if (!key_column->is_nullable()) {
             max_size += sizeof(bool);
@@ -133,11 +141,8 @@ size_t ExceptHashSet<HashSet>::_get_max_serialize_size(const ChunkPtr& chunk, co
 }
 
 template <typename HashSet>
-void ExceptHashSet<HashSet>::_serialize_columns(const ChunkPtr& chunk, const std::vector<ExprContext*>& exprs,
-                                                size_t chunk_size, BufferState* buffer_state) {
-    for (auto expr : exprs) {
-        ColumnPtr key_column = EVALUATE_NULL_IF_ERROR(expr, expr->root(), chunk.get());
-
+void ExceptHashSet<HashSet>::_serialize_columns(size_t chunk_size, BufferState* buffer_state) {
+    for (const auto& key_column : buffer_state->key_columns) {
         // The serialized buffer is always nullable.
         if (key_column->is_nullable()) {
             key_column->serialize_batch(buffer_state->buffer, buffer_state->slice_sizes, chunk_size,
@@ -149,6 +154,6 @@ void ExceptHashSet<HashSet>::_serialize_columns(const ChunkPtr& chunk, const std
     }
 }
 
-template class ExceptHashSet<phmap::flat_hash_set<ExceptSliceFlag, ExceptSliceFlagHash, ExceptSliceFlagEqual>>;
+template class ExceptHashSet<phmap::flat_hash_set<SerializedSetKey, SerializedSetKeyHash, SerializedSetKeyEqual>>;
 
 } // namespace starrocks
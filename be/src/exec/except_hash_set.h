@@ -16,6 +16,7 @@
 
 #include "column/chunk.h"
 #include "column/column_hash.h"
+#include "exec/serialized_set_key.h"
 #include "exprs/expr_context.h"
 #include "runtime/mem_pool.h"
 #include "util/phmap/phmap.h"
@@ -24,38 +25,15 @@
 
 namespace starrocks {
 
-class ExceptSliceFlag;
-struct ExceptSliceFlagEqual;
-struct ExceptSliceFlagHash;
-
-class ExceptSliceFlag {
-public:
-    ExceptSliceFlag(const uint8_t* d, size_t n) : slice(d, n) {}
-
-    Slice slice;
-    mutable bool deleted{false};
-};
-
-struct ExceptSliceFlagEqual {
-    bool operator()(const ExceptSliceFlag& x, const ExceptSliceFlag& y) const {
-        return memequal(x.slice.data, x.slice.size, y.slice.data, y.slice.size);
-    }
-};
-
-struct ExceptSliceFlagHash {
-    static const uint32_t CRC_SEED = 0x811C9DC5;
-    std::size_t operator()(const ExceptSliceFlag& sliceMayUnneed) const {
-        const Slice& slice = sliceMayUnneed.slice;
-        return crc_hash_64(slice.data, slice.size, CRC_SEED);
-    }
-};
-
+// The flag of a key is kDeleted once any row of the other children has the key, see erase_duplicate_row.
 template <typename HashSet>
 class ExceptHashSet {
 public:
     using Iterator = typename HashSet::iterator;
     using KeyVector = std::vector<Slice>;
 
+    static constexpr uint16_t kDeleted = 1;
+
     /// Used to allocate memory for serializing columns to the key.
     struct BufferState {
     public:
@@ -63,6 +41,7 @@ public:
 
     public:
         size_t max_one_row_size{8};
+        Columns key_columns;
         Buffer<uint32_t> slice_sizes;
 
         MemPool mem_pool;
@@ -89,16 +68,18 @@ public:
     int64_t mem_usage(BufferState* buffer_state);
 
 private:
-    size_t _get_max_serialize_size(const ChunkPtr& chunk, const std::vector<ExprContext*>& exprs);
-    void _serialize_columns(const ChunkPtr& chunk, const std::vector<ExprContext*>& exprs, size_t chunk_size,
-                            BufferState* buffer_state);
+    // Evaluate the key columns of |chunk| into the buffer state once for both sizing and serializing.
+    static void _evaluate_columns(const ChunkPtr& chunk, const std::vector<ExprContext*>& exprs,
+                                  BufferState* buffer_state);
+    static size_t _get_max_serialize_size(const BufferState* buffer_state);
+    static void _serialize_columns(size_t chunk_size, BufferState* buffer_state);
 
 private:
     std::unique_ptr<HashSet> _hash_set;
 };
 
 using ExceptHashSerializeSet =
-        ExceptHashSet<phmap::flat_hash_set<ExceptSliceFlag, ExceptSliceFlagHash, ExceptSliceFlagEqual>>;
+        ExceptHashSet<phmap::flat_hash_set<SerializedSetKey, SerializedSetKeyHash, SerializedSetKeyEqual>>;
 using ExceptBufferState = ExceptHashSerializeSet::BufferState;
 
 } // namespace starrocks
@@ -265,7 +265,15 @@ Status FileScanner::create_sequential_file(const TBrokerRangeDesc& range_desc, c
         if (params.__isset.non_blocking_read) {
             non_blocking_read = params.non_blocking_read;
         }
+        // The pipe is parsed by several scanners in parallel, read complete records only.
+        std::string record_delimiter;
+        if (pipe->num_parsers() > 1 && range_desc.format_type == TFileFormatType::FORMAT_CSV_PLAIN) {
+            record_delimiter = params.__isset.multi_row_delimiter
+                                       ? params.multi_row_delimiter
+                                       : std::string(1, static_cast<char>(params.row_delimiter));
+        }
         auto stream = std::make_shared<StreamLoadPipeInputStream>(std::move(pipe), non_blocking_read);
+        stream->set_record_delimiter(std::move(record_delimiter));
         src_file = std::make_shared<SequentialFile>(std::move(stream), "stream-load-pipe");
         break;
     }
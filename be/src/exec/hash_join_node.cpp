@@ -502,6 +502,14 @@ pipeline::OpFactories HashJoinNode::decompose_to_pipeline(pipeline::PipelineBuil
     }
     lhs_operators.emplace_back(std::move(probe_op));
 
+    // The build side can be spilled only when every HashJoinProbeOperator probes the hash table of its own
+    // HashJoinBuildOperator, then the probe rows of the spilled partitions can be spilled by the same HashJoiner.
+    size_t num_left_partitions = context->source_operator(lhs_operators)->degree_of_parallelism();
+    hash_joiner_factory->set_spillable(runtime_state()->enable_spill() &&
+                                       _distribution_mode != TJoinDistributionMode::BROADCAST &&
+                                       _join_type != TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN &&
+                                       num_left_partitions == num_right_partitions);
+
     // Use ChunkAccumulateOperator, when any following condition occurs:
     // - not left outer join,
     // - left outer join, with conjuncts or runtime filters.
@@ -0,0 +1,416 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/hash_join_spiller.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+
+#include "column/chunk.h"
+#include "column/column_helper.h"
+#include "column/nullable_column.h"
+#include "exec/pipeline/query_context.h"
+#include "exec/spill/spiller.hpp"
+#include "gutil/casts.h"
+
+namespace starrocks {
+
+HashJoinSpiller::HashJoinSpiller(int32_t plan_node_id, const RowDescriptor& build_row_desc,
+                                 const RowDescriptor& probe_row_desc, KeysEvaluator build_keys_evaluator,
+                                 KeysEvaluator probe_keys_evaluator)
+        : _plan_node_id(plan_node_id),
+          _build_row_desc(build_row_desc),
+          _probe_row_desc(probe_row_desc),
+          _build_keys_evaluator(std::move(build_keys_evaluator)),
+          _probe_keys_evaluator(std::move(probe_keys_evaluator)),
+          _partition_rows(kNumPartitions) {}
+
+Status HashJoinSpiller::prepare(RuntimeState* state, RuntimeProfile* profile) {
+    _state = state;
+    _metrics = SpillProcessMetrics(profile);
+    _spilled_partitions_counter = ADD_COUNTER(profile, "SpilledPartitionNum", TUnit::UNIT);
+    _repartitions_counter = ADD_COUNTER(profile, "SpillRepartitionNum", TUnit::UNIT);
+
+    auto path_provider_factory =
+            state->query_ctx()->spill_manager()->provider(fmt::format("hash-join-spill-{}", _plan_node_id));
+    const size_t chunk_size = state->chunk_size();
+    auto init_options = [&](SpilledOptions* options, const RowDescriptor* row_desc) {
+        // Every partition has its own mem table, so split the mem table size among the partitions.
+        options->spill_file_size = std::max<size_t>(state->spill_mem_table_size() / kNumPartitions, 1 << 20);
+        // The flush tasks are executed synchronously, so one mem table is enough.
+        options->mem_table_pool_size = 1;
+        options->spill_type = SpillFormaterType::SPILL_BY_COMPRESSED_COLUMN;
+        options->path_provider_factory = path_provider_factory;
+        options->chunk_builder = [row_desc, chunk_size]() { return _new_chunk(*row_desc, chunk_size); };
+    };
+    init_options(&_build_spill_options, &_build_row_desc);
+    init_options(&_probe_spill_options, &_probe_row_desc);
+
+    _partitions.resize(kNumPartitions);
+    for (auto& partition : _partitions) {
+        partition = std::make_unique<Partition>();
+    }
+    return Status::OK();
+}
+
+void HashJoinSpiller::set_mem_budget(size_t budget) {
+    _mem_budget = budget;
+    _max_partition_bytes = std::max<size_t>(budget, std::max<int64_t>(_state->spill_operator_min_bytes(), 0));
+}
+
+Status HashJoinSpiller::append_build_chunk(const ChunkPtr& chunk, const Columns& key_columns) {
+    DCHECK(!chunk->is_empty());
+    ASSIGN_OR_RETURN(auto normalized, _normalize_chunk(chunk, _build_row_desc));
+    _build_rows += normalized->num_rows();
+    _compute_partitions(key_columns, normalized->num_rows(), 0);
+    for (size_t i = 0; i < kNumPartitions; i++) {
+        auto part = _partition_chunk(normalized, i);
+        if (part == nullptr) {
+            continue;
+        }
+        auto& partition = _partitions[i];
+        if (partition->spilled) {
+            partition->spilled_build_rows += part->num_rows();
+            partition->spilled_build_bytes += part->memory_usage();
+            RETURN_IF_ERROR(_spill_chunk(partition->build_spiller.get(), part));
+        } else {
+            size_t bytes = part->memory_usage();
+            partition->mem_bytes += bytes;
+            _mem_bytes += bytes;
+            partition->build_chunks.emplace_back(std::move(part));
+        }
+    }
+    return _spill_in_memory_partitions();
+}
+
+Status HashJoinSpiller::finish_build(std::vector<ChunkPtr>* chunks) {
+    for (auto& partition : _partitions) {
+        if (partition->spilled) {
+            RETURN_IF_ERROR(_flush(partition->build_spiller.get()));
+        } else {
+            for (auto& chunk : partition->build_chunks) {
+                chunks->emplace_back(std::move(chunk));
+            }
+            partition->build_chunks.clear();
+            partition->mem_bytes = 0;
+        }
+    }
+    _mem_bytes = 0;
+    return Status::OK();
+}
+
+StatusOr<ChunkPtr> HashJoinSpiller::append_probe_chunk(const ChunkPtr& chunk, const Columns& key_columns) {
+    DCHECK(!_probe_finished);
+    if (!spilled()) {
+        return chunk;
+    }
+    const size_t num_rows = chunk->num_rows();
+    _compute_partitions(key_columns, num_rows, 0);
+
+    size_t num_spilled_rows = 0;
+    for (size_t i = 0; i < kNumPartitions; i++) {
+        if (_partitions[i]->spilled) {
+            num_spilled_rows += _partition_rows[i].size();
+        }
+    }
+    if (num_spilled_rows == 0) {
+        return chunk;
+    }
+
+    ASSIGN_OR_RETURN(auto normalized, _normalize_chunk(chunk, _probe_row_desc));
+    std::vector<uint32_t> in_memory_rows;
+    in_memory_rows.reserve(num_rows - num_spilled_rows);
+    for (size_t i = 0; i < kNumPartitions; i++) {
+        auto& partition = _partitions[i];
+        if (!partition->spilled) {
+            in_memory_rows.insert(in_memory_rows.end(), _partition_rows[i].begin(), _partition_rows[i].end());
+            continue;
+        }
+        auto part = _partition_chunk(normalized, i);
+        if (part != nullptr) {
+            partition->spilled_probe_rows += part->num_rows();
+            RETURN_IF_ERROR(_spill_chunk(partition->probe_spiller.get(), part));
+        }
+    }
+    if (in_memory_rows.empty()) {
+        return nullptr;
+    }
+    // keep the order of the rows
+    std::sort(in_memory_rows.begin(), in_memory_rows.end());
+    ChunkPtr remain = normalized->clone_empty_with_slot(in_memory_rows.size());
+    remain->append_selective(*normalized, in_memory_rows.data(), 0, in_memory_rows.size());
+    return remain;
+}
+
+Status HashJoinSpiller::finish_probe() {
+    if (_probe_finished) {
+        return Status::OK();
+    }
+    _probe_finished = true;
+    for (auto it = _partitions.rbegin(); it != _partitions.rend(); ++it) {
+        auto& partition = *it;
+        if (!partition->spilled) {
+            continue;
+        }
+        RETURN_IF_ERROR(_flush(partition->probe_spiller.get()));
+        _pending_partitions.emplace_back(std::move(partition));
+    }
+    _partitions.clear();
+    return Status::OK();
+}
+
+Status HashJoinSpiller::next_partition(std::vector<ChunkPtr>* chunks) {
+    DCHECK(_probe_finished);
+    // release the spilled files of the previous partition
+    _current_partition.reset();
+    _restoring_probe = false;
+    while (!_pending_partitions.empty()) {
+        auto partition = std::move(_pending_partitions.back());
+        _pending_partitions.pop_back();
+        if (partition->spilled_build_bytes > _max_partition_bytes && partition->level + 1 < kMaxLevel) {
+            RETURN_IF_ERROR(_repartition(std::move(partition)));
+            continue;
+        }
+        _current_partition = std::move(partition);
+        break;
+    }
+    if (_current_partition == nullptr) {
+        return Status::InternalError("no spilled partition of hash join to restore");
+    }
+
+    RETURN_IF_ERROR(_restore_all(_current_partition->build_spiller.get(), [chunks](ChunkPtr&& chunk) {
+        chunks->emplace_back(std::move(chunk));
+        return Status::OK();
+    }));
+    return Status::OK();
+}
+
+StatusOr<ChunkPtr> HashJoinSpiller::restore_probe_chunk() {
+    DCHECK(_current_partition != nullptr);
+    auto* spiller = _current_partition->probe_spiller.get();
+    if (!spiller->spilled()) {
+        return nullptr;
+    }
+    if (!_restoring_probe) {
+        _restoring_probe = true;
+        RETURN_IF_ERROR(spiller->set_flush_all_call_back([]() { return Status::OK(); }, _state, _executor,
+                                                         EmptyMemGuard()));
+    }
+    return _restore_chunk(spiller);
+}
+
+void HashJoinSpiller::_compute_partitions(const Columns& key_columns, size_t num_rows, int level) {
+    _hash_values.assign(num_rows, 0);
+    for (const auto& column : key_columns) {
+        column->crc32_hash(_hash_values.data(), 0, num_rows);
+    }
+    for (auto& rows : _partition_rows) {
+        rows.clear();
+    }
+    // The rows have been shuffled to this HashJoiner by the hash of the same keys, so mix the hash
+    // to avoid the partitions correlating with the shuffle, and use the higher bits for the higher levels.
+    const int shift = 64 - kPartitionBits * (level + 1);
+    for (uint32_t i = 0; i < num_rows; i++) {
+        uint64_t mixed = static_cast<uint64_t>(_hash_values[i]) * 0x9E3779B97F4A7C15ULL;
+        _partition_rows[(mixed >> shift) & (kNumPartitions - 1)].emplace_back(i);
+    }
+}
+
+ChunkPtr HashJoinSpiller::_partition_chunk(const ChunkPtr& chunk, size_t i) const {
+    const auto& rows = _partition_rows[i];
+    if (rows.empty()) {
+        return nullptr;
+    }
+    if (rows.size() == chunk->num_rows()) {
+        return chunk;
+    }
+    ChunkPtr part = chunk->clone_empty_with_slot(rows.size());
+    part->append_selective(*chunk, rows.data(), 0, rows.size());
+    return part;
+}
+
+StatusOr<ChunkPtr> HashJoinSpiller::_normalize_chunk(const ChunkPtr& chunk, const RowDescriptor& row_desc) {
+    const size_t num_rows = chunk->num_rows();
+    auto normalized = std::make_shared<Chunk>();
+    for (const auto* tuple_desc : row_desc.tuple_descriptors()) {
+        for (const auto* slot : tuple_desc->slots()) {
+            ColumnPtr column = chunk->get_column_by_slot_id(slot->id());
+            if (column->is_constant()) {
+                const auto* const_column = down_cast<const ConstColumn*>(column.get());
+                auto data_column = const_column->data_column()->clone_empty();
+                data_column->append_value_multiple_times(*const_column->data_column(), 0, num_rows);
+                column = std::move(data_column);
+            }
+            if (slot->is_nullable() && !column->is_nullable()) {
+                column = NullableColumn::create(column, NullColumn::create(num_rows, 0));
+            } else if (!slot->is_nullable() && column->is_nullable()) {
+                if (column->has_null()) {
+                    return Status::InternalError(
+                            fmt::format("unexpected null value of non-nullable slot {} in hash join", slot->id()));
+                }
+                column = down_cast<NullableColumn*>(column.get())->data_column();
+            }
+            normalized->append_column(std::move(column), slot->id());
+        }
+    }
+    return normalized;
+}
+
+ChunkUniquePtr HashJoinSpiller::_new_chunk(const RowDescriptor& row_desc, size_t capacity) {
+    auto chunk = std::make_unique<Chunk>();
+    for (const auto* tuple_desc : row_desc.tuple_descriptors()) {
+        for (const auto* slot : tuple_desc->slots()) {
+            auto column = ColumnHelper::create_column(slot->type(), slot->is_nullable());
+            column->reserve(capacity);
+            chunk->append_column(std::move(column), slot->id());
+        }
+    }
+    return chunk;
+}
+
+StatusOr<std::shared_ptr<Spiller>> HashJoinSpiller::_create_spiller(const SpilledOptions& options) {
+    // Not created by SpillerFactory::create, which holds the spillers until the factory is closed,
+    // so that the spilled files of a partition are deleted as soon as the partition is joined.
+    auto spiller = std::make_shared<Spiller>(options, _spill_factory);
+    RETURN_IF_ERROR(spiller->prepare(_state));
+    spiller->set_metrics(_metrics);
+    return spiller;
+}
+
+Status HashJoinSpiller::_spill_partition(Partition* partition) {
+    DCHECK(!partition->spilled);
+    ASSIGN_OR_RETURN(partition->build_spiller, _create_spiller(_build_spill_options));
+    ASSIGN_OR_RETURN(partition->probe_spiller, _create_spiller(_probe_spill_options));
+    partition->spilled = true;
+    _num_spilled_partitions++;
+    COUNTER_UPDATE(_spilled_partitions_counter, 1);
+
+    for (auto& chunk : partition->build_chunks) {
+        partition->spilled_build_rows += chunk->num_rows();
+        partition->spilled_build_bytes += chunk->memory_usage();
+        RETURN_IF_ERROR(_spill_chunk(partition->build_spiller.get(), chunk));
+        chunk.reset();
+    }
+    partition->build_chunks.clear();
+    _mem_bytes -= partition->mem_bytes;
+    partition->mem_bytes = 0;
+    return Status::OK();
+}
+
+Status HashJoinSpiller::_spill_in_memory_partitions() {
+    while (_mem_bytes > _mem_budget) {
+        Partition* largest = nullptr;
+        for (auto& partition : _partitions) {
+            if (!partition->spilled && partition->mem_bytes > 0 &&
+                (largest == nullptr || partition->mem_bytes > largest->mem_bytes)) {
+                largest = partition.get();
+            }
+        }
+        if (largest == nullptr) {
+            break;
+        }
+        RETURN_IF_ERROR(_spill_partition(largest));
+    }
+    return Status::OK();
+}
+
+Status HashJoinSpiller::_spill_chunk(Spiller* spiller, const ChunkPtr& chunk) {
+    return spiller->spill(_state, chunk, _executor, EmptyMemGuard());
+}
+
+Status HashJoinSpiller::_flush(Spiller* spiller) {
+    return spiller->flush(_state, _executor, EmptyMemGuard());
+}
+
+Status HashJoinSpiller::_restore_all(Spiller* spiller, const std::function<Status(ChunkPtr&&)>& consumer) {
+    if (!spiller->spilled()) {
+        return Status::OK();
+    }
+    // trigger the first restore task
+    RETURN_IF_ERROR(
+            spiller->set_flush_all_call_back([]() { return Status::OK(); }, _state, _executor, EmptyMemGuard()));
+    while (true) {
+        ASSIGN_OR_RETURN(auto chunk, _restore_chunk(spiller));
+        if (chunk == nullptr) {
+            break;
+        }
+        RETURN_IF_ERROR(consumer(std::move(chunk)));
+    }
+    return Status::OK();
+}
+
+StatusOr<ChunkPtr> HashJoinSpiller::_restore_chunk(Spiller* spiller) {
+    RETURN_IF_ERROR(_state->check_mem_limit("HashJoinSpiller"));
+    auto chunk_st = spiller->restore(_state, _executor, EmptyMemGuard());
+    if (chunk_st.status().is_end_of_file()) {
+        return nullptr;
+    }
+    return chunk_st;
+}
+
+Status HashJoinSpiller::_repartition(PartitionPtr partition) {
+    COUNTER_UPDATE(_repartitions_counter, 1);
+    const int level = partition->level + 1;
+    std::vector<PartitionPtr> children(kNumPartitions);
+    for (auto& child : children) {
+        child = std::make_unique<Partition>();
+        child->level = level;
+        child->spilled = true;
+        ASSIGN_OR_RETURN(child->build_spiller, _create_spiller(_build_spill_options));
+        ASSIGN_OR_RETURN(child->probe_spiller, _create_spiller(_probe_spill_options));
+    }
+
+    Columns key_columns;
+    RETURN_IF_ERROR(_restore_all(partition->build_spiller.get(), [&](ChunkPtr&& chunk) {
+        _build_keys_evaluator(chunk, &key_columns);
+        _compute_partitions(key_columns, chunk->num_rows(), level);
+        for (size_t i = 0; i < kNumPartitions; i++) {
+            auto part = _partition_chunk(chunk, i);
+            if (part != nullptr) {
+                children[i]->spilled_build_rows += part->num_rows();
+                children[i]->spilled_build_bytes += part->memory_usage();
+                RETURN_IF_ERROR(_spill_chunk(children[i]->build_spiller.get(), part));
+            }
+        }
+        return Status::OK();
+    }));
+    RETURN_IF_ERROR(_restore_all(partition->probe_spiller.get(), [&](ChunkPtr&& chunk) {
+        _probe_keys_evaluator(chunk, &key_columns);
+        _compute_partitions(key_columns, chunk->num_rows(), level);
+        for (size_t i = 0; i < kNumPartitions; i++) {
+            auto part = _partition_chunk(chunk, i);
+            if (part != nullptr) {
+                children[i]->spilled_probe_rows += part->num_rows();
+                RETURN_IF_ERROR(_spill_chunk(children[i]->probe_spiller.get(), part));
+            }
+        }
+        return Status::OK();
+    }));
+    // the spilled files of the partition are deleted here
+    partition.reset();
+
+    for (auto it = children.rbegin(); it != children.rend(); ++it) {
+        auto& child = *it;
+        if (child->spilled_build_rows == 0 && child->spilled_probe_rows == 0) {
+            continue;
+        }
+        RETURN_IF_ERROR(_flush(child->build_spiller.get()));
+        RETURN_IF_ERROR(_flush(child->probe_spiller.get()));
+        _pending_partitions.emplace_back(std::move(child));
+    }
+    return Status::OK();
+}
+
+} // namespace starrocks
@@ -0,0 +1,159 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "common/statusor.h"
+#include "exec/spill/executor.h"
+#include "exec/spill/spiller.h"
+#include "exec/spill/spiller_factory.h"
+#include "runtime/descriptors.h"
+#include "util/runtime_profile.h"
+
+namespace starrocks {
+
+// HashJoinSpiller does grace hash join for the build side and probe side of one HashJoiner.
+//
+// Once spilling starts, the rows of both sides are hash partitioned by the join keys. A partition stays in memory
+// until the in-memory build rows exceed the memory budget, then the largest in-memory partitions are spilled, and
+// the later build rows of the spilled partitions are spilled directly.
+// After the build side is finished, the in-memory partitions are joined as usual, while the probe rows of the
+// spilled partitions are spilled too. Then the spilled partitions are joined one by one, and a partition whose build
+// rows are still too large is re-partitioned by the next bits of the hash, up to kMaxLevel levels.
+//
+// The spilled chunks are written and read synchronously in the caller thread.
+class HashJoinSpiller {
+public:
+    static constexpr size_t kPartitionBits = 4;
+    static constexpr size_t kNumPartitions = 1 << kPartitionBits;
+    static constexpr int kMaxLevel = 3;
+
+    // Evaluate the join keys of |chunk| into |key_columns|.
+    using KeysEvaluator = std::function<void(const ChunkPtr& chunk, Columns* key_columns)>;
+
+    HashJoinSpiller(int32_t plan_node_id, const RowDescriptor& build_row_desc, const RowDescriptor& probe_row_desc,
+                    KeysEvaluator build_keys_evaluator, KeysEvaluator probe_keys_evaluator);
+    ~HashJoinSpiller() = default;
+
+    Status prepare(RuntimeState* state, RuntimeProfile* profile);
+
+    // Keep at most |budget| bytes of build rows in memory, partitions exceeding
+    // max(budget, spill_operator_min_bytes) after spilling are re-partitioned before joined.
+    void set_mem_budget(size_t budget);
+
+    // Whether any partition has been spilled.
+    bool spilled() const { return _num_spilled_partitions > 0; }
+
+    // The memory of the in-memory build rows.
+    size_t mem_usage() const { return _mem_bytes; }
+
+    // The number of the build rows, including the spilled ones.
+    size_t build_rows() const { return _build_rows; }
+
+    // Partition the build rows of |chunk|, |key_columns| are the join keys of |chunk|.
+    Status append_build_chunk(const ChunkPtr& chunk, const Columns& key_columns);
+
+    // Flush the spilled build rows, and move the rows of the in-memory partitions to |chunks|.
+    Status finish_build(std::vector<ChunkPtr>* chunks);
+
+    // Spill the probe rows of |chunk| belonging to the spilled partitions, return the remaining rows,
+    // or nullptr if all the rows are spilled.
+    StatusOr<ChunkPtr> append_probe_chunk(const ChunkPtr& chunk, const Columns& key_columns);
+
+    // Flush the spilled probe rows, then the spilled partitions are ready to be joined, it's idempotent.
+    Status finish_probe();
+
+    bool has_pending_partition() const { return !_pending_partitions.empty(); }
+
+    // Restore the build rows of the next spilled partition into |chunks|.
+    Status next_partition(std::vector<ChunkPtr>* chunks);
+
+    // Restore the next probe chunk of the current partition, nullptr if all of them are restored.
+    StatusOr<ChunkPtr> restore_probe_chunk();
+
+private:
+    struct Partition {
+        int level = 0;
+        bool spilled = false;
+        // The build rows of an in-memory partition.
+        std::vector<ChunkPtr> build_chunks;
+        size_t mem_bytes = 0;
+        size_t spilled_build_bytes = 0;
+        size_t spilled_build_rows = 0;
+        size_t spilled_probe_rows = 0;
+        std::shared_ptr<Spiller> build_spiller;
+        std::shared_ptr<Spiller> probe_spiller;
+    };
+    using PartitionPtr = std::unique_ptr<Partition>;
+
+    // Compute the partition of every row into _partition_rows by the |level|-th bits of the hash of |key_columns|.
+    void _compute_partitions(const Columns& key_columns, size_t num_rows, int level);
+
+    // The rows of |chunk| belonging to the partition |i| computed by _compute_partitions.
+    ChunkPtr _partition_chunk(const ChunkPtr& chunk, size_t i) const;
+
+    // Spilled chunks must have the same layout as the chunks created by the chunk builder of the spiller.
+    static StatusOr<ChunkPtr> _normalize_chunk(const ChunkPtr& chunk, const RowDescriptor& row_desc);
+    static ChunkUniquePtr _new_chunk(const RowDescriptor& row_desc, size_t capacity);
+
+    StatusOr<std::shared_ptr<Spiller>> _create_spiller(const SpilledOptions& options);
+    Status _spill_partition(Partition* partition);
+    Status _spill_in_memory_partitions();
+    Status _spill_chunk(Spiller* spiller, const ChunkPtr& chunk);
+    Status _flush(Spiller* spiller);
+    // Read all the chunks spilled by |spiller|, it's a no-op if nothing is spilled.
+    Status _restore_all(Spiller* spiller, const std::function<Status(ChunkPtr&&)>& consumer);
+    StatusOr<ChunkPtr> _restore_chunk(Spiller* spiller);
+    // Split the partition into kNumPartitions sub partitions by the next bits of the hash.
+    Status _repartition(PartitionPtr partition);
+
+    const int32_t _plan_node_id;
+    const RowDescriptor& _build_row_desc;
+    const RowDescriptor& _probe_row_desc;
+    KeysEvaluator _build_keys_evaluator;
+    KeysEvaluator _probe_keys_evaluator;
+
+    RuntimeState* _state = nullptr;
+    SyncTaskExecutor _executor;
+    std::shared_ptr<SpillerFactory> _spill_factory = make_spilled_factory();
+    SpilledOptions _build_spill_options;
+    SpilledOptions _probe_spill_options;
+    SpillProcessMetrics _metrics;
+    RuntimeProfile::Counter* _spilled_partitions_counter = nullptr;
+    RuntimeProfile::Counter* _repartitions_counter = nullptr;
+
+    size_t _mem_budget = 0;
+    size_t _max_partition_bytes = 0;
+    size_t _mem_bytes = 0;
+    size_t _build_rows = 0;
+    size_t _num_spilled_partitions = 0;
+    bool _probe_finished = false;
+
+    // The partitions of level 0.
+    std::vector<PartitionPtr> _partitions;
+    // The spilled partitions waiting to be joined, the last one is joined first.
+    std::vector<PartitionPtr> _pending_partitions;
+    PartitionPtr _current_partition;
+    bool _restoring_probe = false;
+
+    std::vector<uint32_t> _hash_values;
+    std::vector<std::vector<uint32_t>> _partition_rows;
+};
+
+} // namespace starrocks
@@ -21,11 +21,14 @@
 #include "column/column_helper.h"
 #include "column/fixed_length_column.h"
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
+#include "exec/join_hash_table_cache.h"
 #include "exprs/column_ref.h"
 #include "exprs/expr.h"
 #include "exprs/runtime_filter_bank.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/current_thread.h"
+#include "runtime/exec_env.h"
 #include "runtime/runtime_filter_worker.h"
 #include "simd/simd.h"
 #include "util/debug_util.h"
@@ -36,6 +39,7 @@ namespace starrocks {
 HashJoiner::HashJoiner(const HashJoinerParam& param)
         : _hash_join_node(param._hash_join_node),
           _pool(param._pool),
+          _node_id(param._node_id),
           _join_type(param._hash_join_node.join_op),
           _is_null_safes(param._is_null_safes),
           _build_expr_ctxs(param._build_expr_ctxs),
@@ -49,6 +53,7 @@ HashJoiner::HashJoiner(const HashJoinerParam& param)
           _probe_node_type(param._probe_node_type),
           _build_conjunct_ctxs_is_empty(param._build_conjunct_ctxs_is_empty),
           _output_slots(param._output_slots),
+          _spillable(param._spillable),
           _build_runtime_filters(param._build_runtime_filters.begin(), param._build_runtime_filters.end()) {
     _is_push_down = param._hash_join_node.is_push_down;
     if (_join_type == TJoinOp::LEFT_ANTI_JOIN && param._hash_join_node.is_rewritten_from_not_in) {
@@ -59,6 +64,9 @@ HashJoiner::HashJoiner(const HashJoinerParam& param)
     if (param._hash_join_node.__isset.build_runtime_filters_from_planner) {
         _build_runtime_filters_from_planner = param._hash_join_node.build_runtime_filters_from_planner;
     }
+    if (param._hash_join_node.__isset.build_side_digest) {
+        _build_side_digest = param._hash_join_node.build_side_digest;
+    }
 }
 
 Status HashJoiner::prepare_builder(RuntimeState* state, RuntimeProfile* runtime_profile) {
@@ -90,6 +98,21 @@ Status HashJoiner::prepare_builder(RuntimeState* state, RuntimeProfile* runtime_
     _probe_column_count = _ht.get_probe_column_count();
     _build_column_count = _ht.get_build_column_count();
 
+    _lookup_cached_build_data(runtime_profile);
+
+    if (_spillable && state->enable_spill()) {
+        auto keys_evaluator = [this](const std::vector<ExprContext*>& expr_ctxs) {
+            return [this, &expr_ctxs](const ChunkPtr& chunk, Columns* key_columns) {
+                _prepare_key_columns(*key_columns, chunk, expr_ctxs);
+            };
+        };
+        _spiller = std::make_unique<HashJoinSpiller>(_node_id, _build_row_descriptor,
+                                                     _probe_row_descriptor, keys_evaluator(_build_expr_ctxs),
+                                                     keys_evaluator(_probe_expr_ctxs));
+        RETURN_IF_ERROR(_spiller->prepare(state, runtime_profile));
+        _need_spill = state->spill_mode() == TSpillMode::FORCE;
+    }
+
     return Status::OK();
 }
 
@@ -146,6 +169,12 @@ void HashJoiner::_init_hash_table_param(HashTableParam* param) {
             param->join_keys.emplace_back(JoinKeyDesc{&expr->type(), _is_null_safes[i], nullptr});
         }
     }
+
+    // The spilled build rows are re-joined from the build chunk of the hash table, which needs all the columns
+    bool is_left_semi_or_anti = _join_type == TJoinOp::LEFT_SEMI_JOIN || _join_type == TJoinOp::LEFT_ANTI_JOIN ||
+                                _join_type == TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN;
+    param->key_only_build = config::enable_hash_join_key_only_build && is_left_semi_or_anti &&
+                            _other_join_conjunct_ctxs.empty() && !(_spillable && _runtime_state->enable_spill());
 }
 Status HashJoiner::append_chunk_to_ht(RuntimeState* state, const ChunkPtr& chunk) {
     if (_phase != HashJoinPhase::BUILD) {
@@ -154,6 +183,23 @@ Status HashJoiner::append_chunk_to_ht(RuntimeState* state, const ChunkPtr& chunk
     if (!chunk || chunk->is_empty()) {
         return Status::OK();
     }
+    if (_cached_build_data != nullptr) {
+        return Status::OK();
+    }
+    if (_need_spill && !_is_spilling) {
+        RETURN_IF_ERROR(_start_spill(state));
+    }
+    if (_is_spilling) {
+        {
+            SCOPED_TIMER(_build_conjunct_evaluate_timer);
+            _prepare_key_columns(_key_columns, chunk, _build_expr_ctxs);
+        }
+        return _spiller->append_build_chunk(chunk, _key_columns);
+    }
+    return _append_chunk_to_ht(state, chunk);
+}
+
+Status HashJoiner::_append_chunk_to_ht(RuntimeState* state, const ChunkPtr& chunk) {
     if (UNLIKELY(_ht.get_row_count() + chunk->num_rows() >= UINT32_MAX)) {
         return Status::NotSupported(strings::Substitute("row count of right table in hash join > $0", UINT32_MAX));
     }
@@ -171,6 +217,15 @@ Status HashJoiner::append_chunk_to_ht(RuntimeState* state, const ChunkPtr& chunk
 
 Status HashJoiner::build_ht(RuntimeState* state) {
     if (_phase == HashJoinPhase::BUILD) {
+        if (_is_spilling) {
+            // build the hash table of the in-memory partitions
+            std::vector<ChunkPtr> chunks;
+            RETURN_IF_ERROR(_spiller->finish_build(&chunks));
+            for (auto& chunk : chunks) {
+                RETURN_IF_ERROR(_append_chunk_to_ht(state, chunk));
+                chunk.reset();
+            }
+        }
         RETURN_IF_ERROR(_build(state));
         COUNTER_SET(_build_buckets_counter, static_cast<int64_t>(_ht.get_bucket_size()));
     }
@@ -202,13 +257,37 @@ bool HashJoiner::has_output() const {
     return false;
 }
 
-void HashJoiner::push_chunk(RuntimeState* state, ChunkPtr&& chunk) {
+size_t HashJoiner::revocable_mem_bytes() {
+    if (_spiller == nullptr || _phase != HashJoinPhase::BUILD) {
+        return 0;
+    }
+    return _is_spilling ? _spiller->mem_usage() : _ht.mem_usage();
+}
+
+Status HashJoiner::push_chunk(RuntimeState* state, ChunkPtr&& chunk) {
     DCHECK(chunk && !chunk->is_empty());
     DCHECK(!_probe_input_chunk);
 
-    _probe_input_chunk = std::move(chunk);
-    _ht_has_remain = true;
-    _prepare_probe_key_columns();
+    if (_spilled()) {
+        // spill the probe rows of the spilled partitions, they are joined after the in-memory partitions.
+        {
+            SCOPED_TIMER(_probe_conjunct_evaluate_timer);
+            _prepare_key_columns(_key_columns, chunk, _probe_expr_ctxs);
+        }
+        ASSIGN_OR_RETURN(auto remain_chunk, _spiller->append_probe_chunk(chunk, _key_columns));
+        if (remain_chunk == nullptr) {
+            return Status::OK();
+        }
+        if (remain_chunk == chunk) {
+            _probe_input_chunk = std::move(chunk);
+            _ht_has_remain = true;
+            return Status::OK();
+        }
+        chunk = std::move(remain_chunk);
+    }
+
+    _set_probe_input_chunk(std::move(chunk));
+    return Status::OK();
 }
 
 StatusOr<ChunkPtr> HashJoiner::pull_chunk(RuntimeState* state) {
@@ -236,14 +315,23 @@ StatusOr<ChunkPtr> HashJoiner::_pull_probe_output_chunk(RuntimeState* state) {
     }
 
     if (_phase == HashJoinPhase::POST_PROBE) {
+        if (_spill_round_probing) {
+            ASSIGN_OR_RETURN(auto probe_chunk, _spiller->restore_probe_chunk());
+            if (probe_chunk != nullptr) {
+                _set_probe_input_chunk(std::move(probe_chunk));
+                return _pull_probe_output_chunk(state);
+            }
+            _spill_round_probing = false;
+        }
+
         if (!_need_post_probe()) {
-            enter_eos_phase();
+            RETURN_IF_ERROR(_finish_post_probe(state));
             return chunk;
         }
 
         TRY_CATCH_BAD_ALLOC(RETURN_IF_ERROR(_ht.probe_remain(state, &chunk, &_ht_has_remain)));
         if (!_ht_has_remain) {
-            enter_eos_phase();
+            RETURN_IF_ERROR(_finish_post_probe(state));
         }
 
         RETURN_IF_ERROR(_filter_post_probe_output_chunk(chunk));
@@ -256,6 +344,7 @@ StatusOr<ChunkPtr> HashJoiner::_pull_probe_output_chunk(RuntimeState* state) {
 
 void HashJoiner::close(RuntimeState* state) {
     _ht.close();
+    _spiller.reset();
 }
 
 Status HashJoiner::create_runtime_filters(RuntimeState* state) {
@@ -263,6 +352,10 @@ Status HashJoiner::create_runtime_filters(RuntimeState* state) {
         return Status::OK();
     }
 
+    if (_spilled()) {
+        return _create_spilled_runtime_filters();
+    }
+
     uint64_t runtime_join_filter_pushdown_limit = 1024000;
     if (state->query_options().__isset.runtime_join_filter_pushdown_limit) {
         runtime_join_filter_pushdown_limit = state->query_options().runtime_join_filter_pushdown_limit;
@@ -288,6 +381,15 @@ Status HashJoiner::create_runtime_filters(RuntimeState* state) {
     return _create_runtime_bloom_filters(state, runtime_join_filter_pushdown_limit);
 }
 
+Status HashJoiner::_create_spilled_runtime_filters() {
+    // The hash table only contains the in-memory partitions, so the runtime filters can't be built from it.
+    for (auto* rf_desc : _build_runtime_filters) {
+        rf_desc->set_is_pipeline(true);
+        _runtime_bloom_filter_build_params.emplace_back();
+    }
+    return Status::OK();
+}
+
 void HashJoiner::reference_hash_table(HashJoiner* src_join_builder) {
     _ht = src_join_builder->_ht.clone_readable_table();
     _ht.set_probe_profile(_search_ht_timer, _output_probe_column_timer, _output_tuple_column_timer);
@@ -350,7 +452,96 @@ bool HashJoiner::_has_null(const ColumnPtr& column) {
 
 Status HashJoiner::_build(RuntimeState* state) {
     SCOPED_TIMER(_build_ht_timer);
+    if (_cached_build_data != nullptr) {
+        return _ht.attach_build_data(state, std::move(_cached_build_data));
+    }
     TRY_CATCH_BAD_ALLOC(RETURN_IF_ERROR(_ht.build(state)));
+    if (!_is_spilling) {
+        _populate_cached_build_data();
+    }
+    return Status::OK();
+}
+
+void HashJoiner::_lookup_cached_build_data(RuntimeProfile* runtime_profile) {
+    auto* cache = ExecEnv::GetInstance()->join_hash_table_cache();
+    if (_build_side_digest.empty() || cache == nullptr) {
+        return;
+    }
+    auto build_data = cache->lookup(_build_side_digest);
+    if (build_data != nullptr && _ht.is_compatible_build_data(*build_data)) {
+        _cached_build_data = std::move(build_data);
+    }
+    runtime_profile->add_info_string("HashTableCache", _cached_build_data != nullptr ? "Hit" : "Miss");
+}
+
+void HashJoiner::_populate_cached_build_data() {
+    auto* cache = ExecEnv::GetInstance()->join_hash_table_cache();
+    if (_build_side_digest.empty() || cache == nullptr) {
+        return;
+    }
+    cache->populate(_build_side_digest, _ht.build_data(), _ht.mem_usage());
+}
+
+void HashJoiner::_reset_hash_table() {
+    _ht.close();
+    HashTableParam param;
+    _init_hash_table_param(&param);
+    _ht.create(param);
+}
+
+Status HashJoiner::_start_spill(RuntimeState* state) {
+    DCHECK(_spiller != nullptr);
+    _is_spilling = true;
+    // Keep half of the memory of the hash table for the in-memory partitions, unless spilling is forced.
+    _spiller->set_mem_budget(state->spill_mode() == TSpillMode::FORCE ? 0 : _ht.mem_usage() / 2);
+
+    // move the build rows of the hash table to the partitions, the first row is reserved by the hash table.
+    ChunkPtr build_chunk = _ht.get_build_chunk();
+    const size_t num_rows = build_chunk->num_rows();
+    const size_t chunk_size = state->chunk_size();
+    Columns key_columns;
+    for (size_t offset = kHashJoinKeyColumnOffset; offset < num_rows; offset += chunk_size) {
+        size_t count = std::min(chunk_size, num_rows - offset);
+        ChunkPtr chunk = build_chunk->clone_empty_with_slot(count);
+        chunk->append(*build_chunk, offset, count);
+        _prepare_key_columns(key_columns, chunk, _build_expr_ctxs);
+        RETURN_IF_ERROR(_spiller->append_build_chunk(chunk, key_columns));
+    }
+    build_chunk.reset();
+    _reset_hash_table();
+    return Status::OK();
+}
+
+Status HashJoiner::_build_spilled_partition(RuntimeState* state) {
+    std::vector<ChunkPtr> chunks;
+    RETURN_IF_ERROR(_spiller->next_partition(&chunks));
+    _reset_hash_table();
+    for (auto& chunk : chunks) {
+        RETURN_IF_ERROR(_append_chunk_to_ht(state, chunk));
+        chunk.reset();
+    }
+    return _build(state);
+}
+
+Status HashJoiner::_finish_post_probe(RuntimeState* state) {
+    if (!_spilled()) {
+        enter_eos_phase();
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(_spiller->finish_probe());
+    while (_spiller->has_pending_partition()) {
+        RETURN_IF_ERROR(_build_spilled_partition(state));
+        // the probe rows of the partition can't produce any output.
+        if (_ht.get_row_count() == 0 &&
+            (_join_type == TJoinOp::INNER_JOIN || _join_type == TJoinOp::LEFT_SEMI_JOIN ||
+             _join_type == TJoinOp::RIGHT_SEMI_JOIN || _join_type == TJoinOp::RIGHT_ANTI_JOIN ||
+             _join_type == TJoinOp::RIGHT_OUTER_JOIN)) {
+            continue;
+        }
+        _spill_round_probing = true;
+        return Status::OK();
+    }
+    enter_eos_phase();
     return Status::OK();
 }
 
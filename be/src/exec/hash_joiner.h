@@ -22,6 +22,7 @@
 #include "common/statusor.h"
 #include "exec/exec_node.h"
 #include "exec/hash_join_node.h"
+#include "exec/hash_join_spiller.h"
 #include "exec/join_hash_map.h"
 #include "exec/pipeline/context_with_dependency.h"
 #include "exec/pipeline/runtime_filter_types.h"
@@ -109,6 +110,8 @@ struct HashJoinerParam {
     std::set<SlotId> _output_slots;
 
     const TJoinDistributionMode::type _distribution_mode;
+    // Whether the build side can be spilled, only when the prober is the builder itself.
+    bool _spillable = false;
 };
 
 class HashJoiner final : public pipeline::ContextWithDependency {
@@ -148,8 +151,12 @@ public:
     // build phase
     Status append_chunk_to_ht(RuntimeState* state, const ChunkPtr& chunk);
     Status build_ht(RuntimeState* state);
+    // Spill the build rows from the next appended chunk on.
+    void mark_need_spill() { _need_spill = _spiller != nullptr; }
+    // The memory of the build rows which can be released by spilling.
+    size_t revocable_mem_bytes();
     // probe phase
-    void push_chunk(RuntimeState* state, ChunkPtr&& chunk);
+    Status push_chunk(RuntimeState* state, ChunkPtr&& chunk);
     StatusOr<ChunkPtr> pull_chunk(RuntimeState* state);
 
     pipeline::RuntimeInFilters& get_runtime_in_filters() { return _runtime_in_filters; }
@@ -157,7 +164,7 @@ public:
     pipeline::OptRuntimeBloomFilterBuildParams& get_runtime_bloom_filter_build_params() {
         return _runtime_bloom_filter_build_params;
     }
-    size_t get_ht_row_count() { return _ht.get_row_count(); }
+    size_t get_ht_row_count() { return _spilled() ? _spiller->build_rows() : _ht.get_row_count(); }
 
     Status create_runtime_filters(RuntimeState* state);
 
@@ -212,6 +219,11 @@ private:
             return;
         }
 
+        // the spilled partitions are not empty.
+        if (_spilled()) {
+            return;
+        }
+
         // special cases of short-circuit break.
         if (_ht.get_row_count() == 0 &&
             (_join_type == TJoinOp::INNER_JOIN || _join_type == TJoinOp::LEFT_SEMI_JOIN ||
@@ -236,6 +248,25 @@ private:
     }
 
     Status _build(RuntimeState* state);
+    // Look up the build data of the same build side from JoinHashTableCache.
+    void _lookup_cached_build_data(RuntimeProfile* runtime_profile);
+    void _populate_cached_build_data();
+    Status _append_chunk_to_ht(RuntimeState* state, const ChunkPtr& chunk);
+    void _reset_hash_table();
+
+    bool _spilled() const { return _spiller != nullptr && _spiller->spilled(); }
+    // Move the build rows of the hash table to the spiller.
+    Status _start_spill(RuntimeState* state);
+    // Build the hash table from the build rows of the next spilled partition.
+    Status _build_spilled_partition(RuntimeState* state);
+    // Called when the probe of the current hash table is done, starts to join the next spilled partition if any,
+    // otherwise enters EOS phase.
+    Status _finish_post_probe(RuntimeState* state);
+    void _set_probe_input_chunk(ChunkPtr&& chunk) {
+        _probe_input_chunk = std::move(chunk);
+        _ht_has_remain = true;
+        _prepare_probe_key_columns();
+    }
     Status _probe(RuntimeState* state, ScopedTimer<MonotonicStopWatch>& probe_timer, ChunkPtr* chunk, bool& eos);
 
     StatusOr<ChunkPtr> _pull_probe_output_chunk(RuntimeState* state);
@@ -318,6 +349,8 @@ private:
         return Status::OK();
     }
 
+    Status _create_spilled_runtime_filters();
+
     Status _create_runtime_bloom_filters(RuntimeState* state, int64_t limit) {
         for (auto* rf_desc : _build_runtime_filters) {
             rf_desc->set_is_pipeline(true);
@@ -342,6 +375,7 @@ private:
 private:
     const THashJoinNode& _hash_join_node;
     ObjectPool* _pool;
+    const TPlanNodeId _node_id;
 
     RuntimeState* _runtime_state = nullptr;
 
@@ -367,6 +401,7 @@ private:
     const TPlanNodeType::type _probe_node_type;
     const bool _build_conjunct_ctxs_is_empty;
     const std::set<SlotId>& _output_slots;
+    const bool _spillable;
 
     pipeline::RuntimeInFilters _runtime_in_filters;
     pipeline::RuntimeBloomFilters _build_runtime_filters;
@@ -377,6 +412,19 @@ private:
 
     JoinHashTable _ht;
 
+    // The digest of the build side to share the hash table across queries, empty if not shared.
+    std::string _build_side_digest;
+    // The build data of the same build side cached by another query, the build rows are discarded and
+    // the hash table is attached to it if found.
+    std::shared_ptr<const JoinHashTableItems> _cached_build_data;
+
+    // Grace hash join of the partitions spilled, it's created only if the HashJoiner is spillable.
+    std::unique_ptr<HashJoinSpiller> _spiller;
+    bool _need_spill = false;
+    bool _is_spilling = false;
+    // Probing the rows of a restored spilled partition.
+    bool _spill_round_probing = false;
+
     Columns _key_columns;
     // lifetime of string-typed key columns must exceed HashJoiner's lifetime, because slices in the hash of runtime
     // in-filter constructed from string-typed key columns reference the memory of this column, and the in-filter's
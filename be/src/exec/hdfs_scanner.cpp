@@ -16,6 +16,8 @@
 
 #include "column/column_helper.h"
 #include "exec/exec_node.h"
+#include "formats/file_meta_cache.h"
+#include "io/array_input_stream.h"
 #include "io/compressed_input_stream.h"
 #include "util/compression/stream_compression.h"
 
@@ -52,6 +54,16 @@ public:
         return Status::OK();
     }
 
+    Status read_ranges_fully(const std::vector<io::ReadRange>& ranges) override {
+        SCOPED_RAW_TIMER(&_stats->io_ns);
+        _stats->io_count += ranges.size();
+        RETURN_IF_ERROR(_stream->read_ranges_fully(ranges));
+        for (const auto& r : ranges) {
+            _stats->bytes_read += r.count;
+        }
+        return Status::OK();
+    }
+
 private:
     std::shared_ptr<io::SeekableInputStream> _stream;
     HdfsScanStats* _stats;
@@ -128,6 +140,11 @@ Status HdfsScanner::_build_scanner_context() {
     ctx.timezone = _runtime_state->timezone();
     ctx.iceberg_schema = _scanner_params.iceberg_schema;
     ctx.stats = &_stats;
+    if (FileMetaCache::instance()->enabled() && !_scanner_params.path.empty() && !ctx.scan_ranges.empty() &&
+        (_scanner_params.modification_time > 0 || _scanner_params.immutable_file)) {
+        ctx.file_meta_cache_key = FileMetaCache::cache_key(_scanner_params.path, ctx.scan_ranges[0]->file_length,
+                                                           _scanner_params.modification_time);
+    }
 
     return Status::OK();
 }
@@ -194,7 +211,13 @@ uint64_t HdfsScanner::exit_pending_queue() {
 
 Status HdfsScanner::open_random_access_file() {
     CHECK(_file == nullptr) << "File has already been opened";
-    ASSIGN_OR_RETURN(_raw_file, _scanner_params.fs->new_random_access_file(_scanner_params.path))
+    const auto& contents = _scanner_params.file_contents;
+    if (contents != nullptr) {
+        auto stream = std::make_shared<io::ArrayInputStream>(contents->data(), contents->size());
+        _raw_file = std::make_unique<RandomAccessFile>(std::move(stream), _scanner_params.path);
+    } else {
+        ASSIGN_OR_RETURN(_raw_file, _scanner_params.fs->new_random_access_file(_scanner_params.path))
+    }
     _raw_file->set_size(_scanner_params.file_size);
 
     std::shared_ptr<io::SeekableInputStream> input_stream = _raw_file->stream();
@@ -211,7 +234,9 @@ Status HdfsScanner::open_random_access_file() {
 
     // if block cache
     // input_stream = CacheInputStream(input_stream)
-    if (_scanner_params.use_block_cache && _compression_type == CompressionTypePB::NO_COMPRESSION) {
+    // the file in memory is not cached again.
+    if (_scanner_params.use_block_cache && _compression_type == CompressionTypePB::NO_COMPRESSION &&
+        contents == nullptr) {
         _cache_input_stream = std::make_shared<io::CacheInputStream>(_raw_file->filename(), input_stream);
         _cache_input_stream->set_enable_populate_cache(_scanner_params.enable_populate_block_cache);
         input_stream = _cache_input_stream;
@@ -45,6 +45,8 @@ struct HdfsScanStats {
     int64_t column_read_ns = 0;
     int64_t column_convert_ns = 0;
     int64_t reader_init_ns = 0;
+    // the footers found in FileMetaCache
+    int64_t footer_cache_hit = 0;
 
     // parquet only!
     // read & decode
@@ -60,12 +62,23 @@ struct HdfsScanStats {
     int64_t group_chunk_read_ns = 0;
     int64_t group_dict_filter_ns = 0;
     int64_t group_dict_decode_ns = 0;
+    int64_t group_dict_filter_groups = 0;
     // late materialization
     int64_t skip_read_rows = 0;
+    // page index
+    int64_t page_index_ns = 0;
+    int64_t page_index_filter_rows = 0;
+    // bloom filter
+    int64_t bloom_filter_ns = 0;
+    int64_t bloom_filter_groups = 0;
 
     // ORC only!
     int64_t delete_build_ns = 0;
     int64_t delete_file_per_scan = 0;
+    // the deleted positions found in FileMetaCache
+    int64_t delete_cache_hit = 0;
+    // the rows of the lazy columns which are not decoded since they are filtered out
+    int64_t late_materialize_skip_rows = 0;
 
     int64_t get_cpu_time_ns() const {
         return expr_filter_ns + column_convert_ns + column_read_ns + reader_init_ns - io_ns;
@@ -96,6 +109,9 @@ struct HdfsScanProfile {
     RuntimeProfile::Counter* block_cache_write_timer = nullptr;
     RuntimeProfile::Counter* block_cache_write_fail_counter = nullptr;
     RuntimeProfile::Counter* block_cache_write_fail_bytes = nullptr;
+
+    RuntimeProfile::Counter* coalesced_scan_ranges_counter = nullptr;
+    RuntimeProfile::Counter* prefetched_files_counter = nullptr;
 };
 
 struct HdfsScannerParams {
@@ -119,6 +135,8 @@ struct HdfsScannerParams {
     std::string path;
     // The file size. -1 means unknown.
     int64_t file_size = -1;
+    // The contents of the whole file if it's read into memory in advance, then it's read from them instead of `fs`.
+    std::shared_ptr<const std::string> file_contents;
 
     const TupleDescriptor* tuple_desc = nullptr;
 
@@ -157,6 +175,11 @@ struct HdfsScannerParams {
 
     bool use_block_cache = false;
     bool enable_populate_block_cache = false;
+
+    // The modification time of the file, 0 if unknown.
+    int64_t modification_time = 0;
+    // The file is never rewritten, e.g. the data files of iceberg, so it's identified by the path and size.
+    bool immutable_file = false;
 };
 
 struct HdfsScannerContext {
@@ -204,6 +227,9 @@ struct HdfsScannerContext {
 
     HdfsScanStats* stats = nullptr;
 
+    // The key of the file in FileMetaCache, empty if the meta of the file should not be cached.
+    std::string file_meta_cache_key;
+
     // set column names from file.
     // and to update not_existed slots and conjuncts.
     // and to update `conjunct_ctxs_by_slot` field.
@@ -250,6 +276,7 @@ public:
     int64_t raw_rows_read() const { return _stats.raw_rows_read; }
     int64_t num_rows_read() const { return _stats.num_rows_read; }
     int64_t cpu_time_spent() const { return _stats.get_cpu_time_ns(); }
+    const HdfsScanStats& stats() const { return _stats; }
     void set_keep_priority(bool v) { _keep_priority = v; }
     bool keep_priority() const { return _keep_priority; }
     void update_counter();
@@ -18,6 +18,7 @@
 
 #include "exec/exec_node.h"
 #include "exec/iceberg/iceberg_delete_builder.h"
+#include "formats/file_meta_cache.h"
 #include "formats/orc/fill_function.h"
 #include "formats/orc/orc_chunk_reader.h"
 #include "formats/orc/orc_input_stream.h"
@@ -303,7 +304,20 @@ Status HdfsOrcScanner::do_open(RuntimeState* runtime_state) {
     std::unique_ptr<orc::Reader> reader;
     try {
         orc::ReaderOptions options;
+        // the file tail is read and parsed by the reader if it's not cached
+        FileMetaCache::OrcTailPtr tail;
+        if (!_scanner_ctx.file_meta_cache_key.empty()) {
+            tail = FileMetaCache::instance()->lookup_orc_tail(_scanner_ctx.file_meta_cache_key);
+        }
+        if (tail != nullptr) {
+            options.setSerializedFileTail(*tail);
+            _stats.footer_cache_hit++;
+        }
         reader = orc::createReader(std::move(input_stream), options);
+        if (tail == nullptr && !_scanner_ctx.file_meta_cache_key.empty()) {
+            FileMetaCache::instance()->insert_orc_tail(_scanner_ctx.file_meta_cache_key,
+                                                       reader->getSerializedFileTail());
+        }
     } catch (std::exception& e) {
         auto s = strings::Substitute("HdfsOrcScanner::do_open failed. reason = $0", e.what());
         LOG(WARNING) << s;
@@ -393,7 +407,7 @@ Status HdfsOrcScanner::do_get_next(RuntimeState* runtime_state, ChunkPtr* chunk)
         {
             SCOPED_RAW_TIMER(&_stats.column_read_ns);
             RETURN_IF_ERROR(_orc_reader->read_next(&position));
-            row_delete_filter = _orc_reader->get_row_delete_filter(_need_skip_rowids);
+            row_delete_filter = _orc_reader->get_row_delete_filter(_need_skip_rowids.get());
             // read num values is how many rows actually read before doing dict filtering.
             read_num_values = position.num_values;
             RETURN_IF_ERROR(_orc_reader->apply_dict_filter_eval_cache(_orc_row_reader_filter->_dict_filter_eval_cache,
@@ -464,17 +478,42 @@ Status HdfsOrcScanner::do_get_next(RuntimeState* runtime_state, ChunkPtr* chunk)
         if (chunk_size == 0) {
             continue;
         }
+        // Only the rows between the first and the last selected rows of the lazy columns are decoded,
+        // the leading rows are skipped by seeking, and the trailing rows are never read.
+        if (has_used_dict_filter) {
+            _lazy_filter.assign(read_num_values, 0);
+            for (size_t i = 0, j = 0; i < read_num_values; i++) {
+                if (_dict_filter[i]) {
+                    _lazy_filter[i] = _chunk_filter[j++];
+                }
+            }
+        } else {
+            _lazy_filter.assign(_chunk_filter.begin(), _chunk_filter.end());
+        }
+        DCHECK_EQ(read_num_values, _lazy_filter.size());
+        size_t first = 0;
+        while (!_lazy_filter[first]) {
+            first++;
+        }
+        size_t last = read_num_values;
+        while (!_lazy_filter[last - 1]) {
+            last--;
+        }
+        _stats.late_materialize_skip_rows += read_num_values - (last - first);
         {
             SCOPED_RAW_TIMER(&_stats.column_read_ns);
-            RETURN_IF_ERROR(_orc_reader->lazy_seek_to(position.row_in_stripe));
-            RETURN_IF_ERROR(_orc_reader->lazy_read_next(read_num_values));
+            RETURN_IF_ERROR(_orc_reader->lazy_seek_to(position.row_in_stripe + first));
+            RETURN_IF_ERROR(_orc_reader->lazy_read_next(last - first));
         }
         {
             SCOPED_RAW_TIMER(&_stats.column_convert_ns);
-            if (has_used_dict_filter) {
-                _orc_reader->lazy_filter_on_cvb(&_dict_filter);
+            if (last != read_num_values) {
+                _lazy_filter.resize(last);
             }
-            _orc_reader->lazy_filter_on_cvb(&_chunk_filter);
+            if (first != 0) {
+                _lazy_filter.erase(_lazy_filter.begin(), _lazy_filter.begin() + first);
+            }
+            _orc_reader->lazy_filter_on_cvb(&_lazy_filter);
             StatusOr<ChunkPtr> ret = _orc_reader->get_lazy_chunk();
             RETURN_IF_ERROR(ret);
             Chunk& ret_ck = *(ret.value());
@@ -492,11 +531,28 @@ Status HdfsOrcScanner::do_init(RuntimeState* runtime_state, const HdfsScannerPar
     // todo: build predicate hook and ranges hook.
     if (!scanner_params.deletes.empty()) {
         SCOPED_RAW_TIMER(&_stats.delete_build_ns);
-        IcebergDeleteBuilder iceberg_delete_builder(scanner_params.fs, scanner_params.path,
-                                                    scanner_params.conjunct_ctxs, scanner_params.materialize_slots,
-                                                    &_need_skip_rowids);
-        for (const auto& tdelete_file : scanner_params.deletes) {
-            RETURN_IF_ERROR(iceberg_delete_builder.build_orc(runtime_state->timezone(), *tdelete_file));
+        // the deleted positions are shared by the scans of the data file with the same delete files
+        std::string cache_key;
+        if (FileMetaCache::instance()->enabled()) {
+            cache_key = IcebergDeleteBuilder::cache_key(scanner_params.path, scanner_params.deletes);
+            _need_skip_rowids = FileMetaCache::instance()->lookup_position_deletes(cache_key);
+        }
+        if (_need_skip_rowids != nullptr) {
+            _stats.delete_cache_hit++;
+        } else {
+            auto need_skip_rowids = std::make_shared<Roaring>();
+            IcebergDeleteBuilder iceberg_delete_builder(scanner_params.fs, scanner_params.path,
+                                                        scanner_params.conjunct_ctxs, scanner_params.materialize_slots,
+                                                        need_skip_rowids.get());
+            for (const auto& tdelete_file : scanner_params.deletes) {
+                RETURN_IF_ERROR(iceberg_delete_builder.build_orc(runtime_state->timezone(), *tdelete_file));
+            }
+            need_skip_rowids->runOptimize();
+            need_skip_rowids->shrinkToFit();
+            if (!cache_key.empty()) {
+                FileMetaCache::instance()->insert_position_deletes(cache_key, need_skip_rowids);
+            }
+            _need_skip_rowids = std::move(need_skip_rowids);
         }
         _stats.delete_file_per_scan += scanner_params.deletes.size();
     }
@@ -509,15 +565,25 @@ static const std::string kORCProfileSectionPrefix = "ORC";
 void HdfsOrcScanner::do_update_counter(HdfsScanProfile* profile) {
     RuntimeProfile::Counter* delete_build_timer = nullptr;
     RuntimeProfile::Counter* delete_file_per_scan_counter = nullptr;
+    RuntimeProfile::Counter* footer_cache_hit_counter = nullptr;
+    RuntimeProfile::Counter* late_materialize_skip_rows_counter = nullptr;
+    RuntimeProfile::Counter* delete_cache_hit_counter = nullptr;
     RuntimeProfile* root = profile->runtime_profile;
 
     ADD_COUNTER(root, kORCProfileSectionPrefix, TUnit::UNIT);
 
     delete_build_timer = ADD_CHILD_TIMER(root, "DeleteBuildTimer", kORCProfileSectionPrefix);
     delete_file_per_scan_counter = ADD_CHILD_COUNTER(root, "DeleteFilesPerScan", TUnit::UNIT, kORCProfileSectionPrefix);
+    footer_cache_hit_counter = ADD_CHILD_COUNTER(root, "FooterCacheHit", TUnit::UNIT, kORCProfileSectionPrefix);
+    late_materialize_skip_rows_counter =
+            ADD_CHILD_COUNTER(root, "LateMaterializeSkipRows", TUnit::UNIT, kORCProfileSectionPrefix);
+    delete_cache_hit_counter = ADD_CHILD_COUNTER(root, "DeleteCacheHit", TUnit::UNIT, kORCProfileSectionPrefix);
 
     COUNTER_UPDATE(delete_build_timer, _stats.delete_build_ns);
     COUNTER_UPDATE(delete_file_per_scan_counter, _stats.delete_file_per_scan);
+    COUNTER_UPDATE(footer_cache_hit_counter, _stats.footer_cache_hit);
+    COUNTER_UPDATE(late_materialize_skip_rows_counter, _stats.late_materialize_skip_rows);
+    COUNTER_UPDATE(delete_cache_hit_counter, _stats.delete_cache_hit);
 }
 
 } // namespace starrocks
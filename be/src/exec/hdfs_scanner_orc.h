@@ -17,6 +17,7 @@
 #include <orc/OrcFile.hh>
 
 #include "exec/hdfs_scanner.h"
+#include "formats/file_meta_cache.h"
 #include "formats/orc/orc_chunk_reader.h"
 
 namespace starrocks {
@@ -52,7 +53,10 @@ private:
     std::shared_ptr<OrcRowReaderFilter> _orc_row_reader_filter;
     Filter _dict_filter;
     Filter _chunk_filter;
-    std::set<std::int64_t> _need_skip_rowids;
+    // the filter of the lazy columns of all the rows read by the active columns
+    Filter _lazy_filter;
+    // the deleted positions of the iceberg data file, nullptr if none
+    FileMetaCache::PositionDeletesPtr _need_skip_rowids;
 };
 
 } // namespace starrocks
@@ -34,12 +34,21 @@ void HdfsParquetScanner::do_update_counter(HdfsScanProfile* profile) {
 
     // reader init
     RuntimeProfile::Counter* footer_read_timer = nullptr;
+    RuntimeProfile::Counter* footer_cache_hit = nullptr;
     RuntimeProfile::Counter* column_reader_init_timer = nullptr;
 
     // dict filter
     RuntimeProfile::Counter* group_chunk_read_timer = nullptr;
     RuntimeProfile::Counter* group_dict_filter_timer = nullptr;
     RuntimeProfile::Counter* group_dict_decode_timer = nullptr;
+    RuntimeProfile::Counter* group_dict_filter_groups = nullptr;
+
+    // page index
+    RuntimeProfile::Counter* page_index_timer = nullptr;
+    RuntimeProfile::Counter* page_index_filter_rows = nullptr;
+    // bloom filter
+    RuntimeProfile::Counter* bloom_filter_timer = nullptr;
+    RuntimeProfile::Counter* bloom_filter_groups = nullptr;
 
     RuntimeProfile* root = profile->runtime_profile;
     ADD_COUNTER(root, kParquetProfileSectionPrefix, TUnit::UNIT);
@@ -52,11 +61,19 @@ void HdfsParquetScanner::do_update_counter(HdfsScanProfile* profile) {
 
     page_read_timer = ADD_CHILD_TIMER(root, "PageReadTime", kParquetProfileSectionPrefix);
     footer_read_timer = ADD_CHILD_TIMER(root, "ReaderInitFooterRead", kParquetProfileSectionPrefix);
+    footer_cache_hit = ADD_CHILD_COUNTER(root, "ReaderInitFooterCacheHit", TUnit::UNIT, kParquetProfileSectionPrefix);
     column_reader_init_timer = ADD_CHILD_TIMER(root, "ReaderInitColumnReaderInit", kParquetProfileSectionPrefix);
 
     group_chunk_read_timer = ADD_CHILD_TIMER(root, "GroupChunkRead", kParquetProfileSectionPrefix);
     group_dict_filter_timer = ADD_CHILD_TIMER(root, "GroupDictFilter", kParquetProfileSectionPrefix);
     group_dict_decode_timer = ADD_CHILD_TIMER(root, "GroupDictDecode", kParquetProfileSectionPrefix);
+    group_dict_filter_groups =
+            ADD_CHILD_COUNTER(root, "GroupDictFilterGroups", TUnit::UNIT, kParquetProfileSectionPrefix);
+
+    page_index_timer = ADD_CHILD_TIMER(root, "PageIndexFilter", kParquetProfileSectionPrefix);
+    page_index_filter_rows = ADD_CHILD_COUNTER(root, "PageIndexFilterRows", TUnit::UNIT, kParquetProfileSectionPrefix);
+    bloom_filter_timer = ADD_CHILD_TIMER(root, "BloomFilterFilter", kParquetProfileSectionPrefix);
+    bloom_filter_groups = ADD_CHILD_COUNTER(root, "BloomFilterFilterGroups", TUnit::UNIT, kParquetProfileSectionPrefix);
 
     COUNTER_UPDATE(request_bytes_read, _stats.request_bytes_read);
     COUNTER_UPDATE(request_bytes_read_uncompressed, _stats.request_bytes_read_uncompressed);
@@ -64,10 +81,16 @@ void HdfsParquetScanner::do_update_counter(HdfsScanProfile* profile) {
     COUNTER_UPDATE(level_decode_timer, _stats.level_decode_ns);
     COUNTER_UPDATE(page_read_timer, _stats.page_read_ns);
     COUNTER_UPDATE(footer_read_timer, _stats.footer_read_ns);
+    COUNTER_UPDATE(footer_cache_hit, _stats.footer_cache_hit);
     COUNTER_UPDATE(column_reader_init_timer, _stats.column_reader_init_ns);
     COUNTER_UPDATE(group_chunk_read_timer, _stats.group_chunk_read_ns);
     COUNTER_UPDATE(group_dict_filter_timer, _stats.group_dict_filter_ns);
     COUNTER_UPDATE(group_dict_decode_timer, _stats.group_dict_decode_ns);
+    COUNTER_UPDATE(group_dict_filter_groups, _stats.group_dict_filter_groups);
+    COUNTER_UPDATE(page_index_timer, _stats.page_index_ns);
+    COUNTER_UPDATE(page_index_filter_rows, _stats.page_index_filter_rows);
+    COUNTER_UPDATE(bloom_filter_timer, _stats.bloom_filter_ns);
+    COUNTER_UPDATE(bloom_filter_groups, _stats.bloom_filter_groups);
 }
 
 Status HdfsParquetScanner::do_open(RuntimeState* runtime_state) {
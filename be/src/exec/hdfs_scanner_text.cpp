@@ -50,10 +50,15 @@ public:
 
     Status next_record(Record* record);
 
+    Status next_record(Record* record, Fields* fields);
+
 protected:
     Status _fill_buffer() override;
 
 private:
+    // Consume |record| of the current scan range.
+    void _consume(const Record& record);
+
     RandomAccessFile* _file;
     size_t _offset = 0;
     size_t _remain_length = 0;
@@ -77,16 +82,29 @@ Status HdfsScannerCSVReader::next_record(Record* record) {
         return Status::EndOfFile("");
     }
     RETURN_IF_ERROR(CSVReader::next_record(record));
+    _consume(*record);
+    return Status::OK();
+}
+
+Status HdfsScannerCSVReader::next_record(Record* record, Fields* fields) {
+    if (_should_stop_next) {
+        return Status::EndOfFile("");
+    }
+    RETURN_IF_ERROR(CSVReader::next_record(record, fields));
+    _consume(*record);
+    return Status::OK();
+}
+
+void HdfsScannerCSVReader::_consume(const Record& record) {
     // We should still read if remain_length is zero(we stop right at row delimiter)
     // because next scan range will skip a record till row delimiter.
     // so it's current reader's responsibility to consume this record.
-    size_t consume = record->size + _row_delimiter_length;
+    size_t consume = record.size + _row_delimiter_length;
     if (_remain_length < consume) {
         _should_stop_next = true;
     } else {
         _remain_length -= consume;
     }
-    return Status::OK();
 }
 
 Status HdfsScannerCSVReader::_fill_buffer() {
@@ -241,7 +259,8 @@ Status HdfsTextScanner::parse_csv(int chunk_size, ChunkPtr* chunk) {
     options.invalid_field_as_null = true;
 
     for (size_t num_rows = chunk->get()->num_rows(); num_rows < chunk_size; /**/) {
-        status = down_cast<HdfsScannerCSVReader*>(_reader.get())->next_record(&record);
+        fields.clear();
+        status = down_cast<HdfsScannerCSVReader*>(_reader.get())->next_record(&record, &fields);
         if (status.is_end_of_file()) {
             if (_current_range_index == _scanner_params.scan_ranges.size() - 1) {
                 break;
@@ -257,9 +276,6 @@ Status HdfsTextScanner::parse_csv(int chunk_size, ChunkPtr* chunk) {
             return status;
         }
 
-        fields.clear();
-        _reader->split_record(record, &fields);
-
         if (!validate_utf8(record.data, record.size)) {
             continue;
         }
@@ -14,6 +14,9 @@
 
 #include "exec/iceberg/iceberg_delete_builder.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "column/vectorized_fwd.h"
 #include "formats/orc/orc_chunk_reader.h"
 #include "formats/orc/orc_input_stream.h"
@@ -35,7 +38,7 @@ static const IcebergColumnMeta k_delete_file_pos{
         .id = INT32_MAX - 102, .col_name = "pos", .type = TPrimitiveType::BIGINT};
 
 Status ORCPositionDeleteBuilder::build(const std::string& timezone, const std::string& delete_file_path,
-                                       int64_t file_length, std::set<int64_t>* need_skip_rowids) {
+                                       int64_t file_length, Roaring* need_skip_rowids) {
     std::vector<SlotDescriptor*> slot_descriptors{&(IcebergDeleteFileMeta::get_delete_file_path_slot()),
                                                   &(IcebergDeleteFileMeta::get_delete_file_pos_slot())};
 
@@ -94,11 +97,34 @@ Status ORCPositionDeleteBuilder::build(const std::string& timezone, const std::s
                 continue;
             }
 
-            need_skip_rowids->emplace(position_col->get_data()[row]);
+            int64_t pos = position_col->get_data()[row];
+            if (pos < 0 || pos > std::numeric_limits<uint32_t>::max()) {
+                auto str = strings::Substitute("invalid position $0 in delete file $1", pos, delete_file_path);
+                LOG(WARNING) << str;
+                return Status::InternalError(str);
+            }
+            need_skip_rowids->add(static_cast<uint32_t>(pos));
         }
     }
 }
 
+std::string IcebergDeleteBuilder::cache_key(const std::string& datafile_path,
+                                            const std::vector<const TIcebergDeleteFile*>& delete_files) {
+    std::vector<std::string> files;
+    files.reserve(delete_files.size());
+    for (const auto* delete_file : delete_files) {
+        files.emplace_back(strings::Substitute("$0:$1", delete_file->full_path, delete_file->length));
+    }
+    std::sort(files.begin(), files.end());
+    std::string key = datafile_path;
+    for (const auto& file : files) {
+        // the paths never contain '\0'
+        key.push_back('\0');
+        key.append(file);
+    }
+    return key;
+}
+
 SlotDescriptor IcebergDeleteFileMeta::gen_slot_helper(const IcebergColumnMeta& meta) {
     TSlotDescriptor desc;
     desc.__set_id(meta.id);
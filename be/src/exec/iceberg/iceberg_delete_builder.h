@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <roaring/roaring.hh>
+
 #include "common/status.h"
 #include "fs/fs.h"
 #include "gutil/strings/substitute.h"
@@ -28,7 +30,7 @@ public:
     virtual ~PositionDeleteBuilder() = default;
 
     virtual Status build(const std::string& timezone, const std::string& file_path, int64_t file_length,
-                         std::set<int64_t>* need_skip_rowids) = 0;
+                         Roaring* need_skip_rowids) = 0;
 };
 
 class ORCPositionDeleteBuilder : public PositionDeleteBuilder {
@@ -38,7 +40,7 @@ public:
     ~ORCPositionDeleteBuilder() override = default;
 
     Status build(const std::string& timezone, const std::string& delete_file_path, int64_t file_length,
-                 std::set<int64_t>* need_skip_rowids) override;
+                 Roaring* need_skip_rowids) override;
 
 private:
     FileSystem* _fs;
@@ -48,7 +50,7 @@ private:
 class IcebergDeleteBuilder {
 public:
     IcebergDeleteBuilder(FileSystem* fs, std::string datafile_path, std::vector<ExprContext*> conjunct_ctxs,
-                         std::vector<SlotDescriptor*> materialize_slots, std::set<std::int64_t>* need_skip_rowids)
+                         std::vector<SlotDescriptor*> materialize_slots, Roaring* need_skip_rowids)
             : _fs(fs),
               _datafile_path(std::move(datafile_path)),
               _conjunct_ctxs(std::move(conjunct_ctxs)),
@@ -56,6 +58,11 @@ public:
               _need_skip_rowids(need_skip_rowids) {}
     ~IcebergDeleteBuilder() = default;
 
+    // The key of the deleted positions of |datafile_path| in FileMetaCache. The delete files are never rewritten,
+    // so they are identified by their paths and lengths, and the key doesn't depend on their order.
+    static std::string cache_key(const std::string& datafile_path,
+                                 const std::vector<const TIcebergDeleteFile*>& delete_files);
+
     Status build_orc(const std::string& timezone, const TIcebergDeleteFile& delete_file) {
         if (delete_file.file_content == TIcebergFileContent::POSITION_DELETES) {
             return ORCPositionDeleteBuilder(_fs, _datafile_path)
@@ -72,7 +79,7 @@ private:
     std::string _datafile_path;
     std::vector<ExprContext*> _conjunct_ctxs;
     std::vector<SlotDescriptor*> _materialize_slots;
-    std::set<std::int64_t>* _need_skip_rowids;
+    Roaring* _need_skip_rowids;
 };
 
 class IcebergDeleteFileMeta {
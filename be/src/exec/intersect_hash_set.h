@@ -16,6 +16,7 @@
 
 #include "column/chunk.h"
 #include "column/column_hash.h"
+#include "exec/serialized_set_key.h"
 #include "exprs/expr_context.h"
 #include "runtime/mem_pool.h"
 #include "util/phmap/phmap.h"
@@ -23,31 +24,7 @@
 
 namespace starrocks {
 
-class IntersectSliceFlag;
-struct IntersectSliceFlagEqual;
-
-class IntersectSliceFlag {
-public:
-    IntersectSliceFlag(const uint8_t* d, size_t n) : slice(d, n) {}
-
-    Slice slice;
-    mutable uint16_t hit_times{0};
-};
-
-struct IntersectSliceFlagEqual {
-    bool operator()(const IntersectSliceFlag& x, const IntersectSliceFlag& y) const {
-        return memequal(x.slice.data, x.slice.size, y.slice.data, y.slice.size);
-    }
-};
-
-struct IntersectSliceFlagHash {
-    static const uint32_t CRC_SEED = 0x811C9DC5;
-    std::size_t operator()(const IntersectSliceFlag& sliceMayUnneed) const {
-        const Slice& slice = sliceMayUnneed.slice;
-        return crc_hash_64(slice.data, slice.size, CRC_SEED);
-    }
-};
-
+// The flag of a key is the number of the children having hit it in order, see refine_intersect_row.
 template <typename HashSet>
 class IntersectHashSet {
 public:
@@ -75,12 +52,16 @@ public:
     int64_t mem_usage() const;
 
 private:
-    void _serialize_columns(const ChunkPtr& chunkPtr, const std::vector<ExprContext*>& exprs, size_t chunk_size);
+    // Evaluate the key columns of |chunkPtr| into _key_columns once for both sizing and serializing.
+    void _evaluate_columns(const ChunkPtr& chunkPtr, const std::vector<ExprContext*>& exprs);
+
+    void _serialize_columns(size_t chunk_size);
 
-    size_t _get_max_serialize_size(const ChunkPtr& chunkPtr, const std::vector<ExprContext*>& exprs);
+    size_t _get_max_serialize_size() const;
 
     std::unique_ptr<HashSet> _hash_set;
 
+    Columns _key_columns;
     Buffer<uint32_t> _slice_sizes;
     size_t _max_one_row_size = 8;
     std::unique_ptr<MemPool> _mem_pool;
@@ -88,6 +69,6 @@ private:
 };
 
 using IntersectHashSerializeSet =
-        IntersectHashSet<phmap::flat_hash_set<IntersectSliceFlag, IntersectSliceFlagHash, IntersectSliceFlagEqual>>;
+        IntersectHashSet<phmap::flat_hash_set<SerializedSetKey, SerializedSetKeyHash, SerializedSetKeyEqual>>;
 
 } // namespace starrocks
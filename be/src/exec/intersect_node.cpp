@@ -176,8 +176,8 @@ Status IntersectNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos)
     int32_t read_index = 0;
     _remained_keys.resize(runtime_state()->chunk_size());
     while (_hash_set_iterator != _hash_set->end() && read_index < runtime_state()->chunk_size()) {
-        if (_hash_set_iterator->hit_times == _intersect_times) {
-            _remained_keys[read_index] = _hash_set_iterator->slice;
+        if (_hash_set_iterator->flag() == _intersect_times) {
+            _remained_keys[read_index] = _hash_set_iterator->slice();
             ++read_index;
         }
         ++_hash_set_iterator;
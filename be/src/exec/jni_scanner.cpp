@@ -18,9 +18,13 @@
 #include "column/map_column.h"
 #include "column/struct_column.h"
 #include "column/type_traits.h"
+#include "common/config.h"
 #include "fmt/core.h"
+#include "runtime/current_thread.h"
+#include "runtime/exec_env.h"
 #include "udf/java/java_udf.h"
 #include "util/defer_op.h"
+#include "util/threadpool.h"
 
 namespace starrocks {
 
@@ -50,6 +54,10 @@ Status JniScanner::do_open(RuntimeState* state) {
     SCOPED_RAW_TIMER(&_stats.reader_init_ns);
     _jni_env->CallVoidMethod(_jni_scanner_obj, _jni_scanner_open);
     RETURN_IF_ERROR(_check_jni_exception(_jni_env, "Failed to open the off-heap table scanner."));
+    _prefetch_enabled = config::jni_scanner_prefetch_enable;
+    if (_prefetch_enabled) {
+        _start_prefetch();
+    }
     return Status::OK();
 }
 
@@ -57,9 +65,14 @@ void JniScanner::do_update_counter(HdfsScanProfile* profile) {}
 
 void JniScanner::do_close(RuntimeState* runtime_state) noexcept {
     JNIEnv* _jni_env = JVMFunctionHelper::getInstance().getEnv();
+    Status status;
+    long chunk_meta = 0;
+    if (_wait_prefetch(&status, &chunk_meta) && status.ok()) {
+        _release_off_heap_table(_jni_env, chunk_meta);
+    }
     _jni_env->CallVoidMethod(_jni_scanner_obj, _jni_scanner_close);
     _check_jni_exception(_jni_env, "Failed to close the off-heap table scanner.");
-    _jni_env->DeleteLocalRef(_jni_scanner_obj);
+    _jni_env->DeleteGlobalRef(_jni_scanner_obj);
     _jni_env->DeleteLocalRef(_jni_scanner_cls);
 }
 
@@ -77,6 +90,8 @@ Status JniScanner::_init_jni_method(JNIEnv* _jni_env) {
     DCHECK(_jni_scanner_release_column != nullptr);
     _jni_scanner_release_table = _jni_env->GetMethodID(_jni_scanner_cls, "releaseOffHeapTable", "()V");
     DCHECK(_jni_scanner_release_table != nullptr);
+    _jni_scanner_release_table_by_address = _jni_env->GetMethodID(_jni_scanner_cls, "releaseOffHeapTable", "(J)V");
+    DCHECK(_jni_scanner_release_table_by_address != nullptr);
     RETURN_IF_ERROR(_check_jni_exception(_jni_env, "Failed to init off-heap table jni methods."));
 
     return Status::OK();
@@ -120,11 +135,14 @@ Status JniScanner::_init_jni_table_scanner(JNIEnv* _jni_env, RuntimeState* runti
     LOG(INFO) << message;
 
     int fetch_size = runtime_state->chunk_size();
-    _jni_scanner_obj = _jni_env->NewObject(_jni_scanner_cls, scanner_constructor, fetch_size, hashmap_object);
+    jobject scanner_obj = _jni_env->NewObject(_jni_scanner_cls, scanner_constructor, fetch_size, hashmap_object);
     _jni_env->DeleteLocalRef(hashmap_object);
 
-    DCHECK(_jni_scanner_obj != nullptr);
+    DCHECK(scanner_obj != nullptr);
     RETURN_IF_ERROR(_check_jni_exception(_jni_env, "Failed to initialize a scanner instance."));
+    // the scanner is called by the prefetch threads too, a local reference is only valid in the current thread
+    _jni_scanner_obj = _jni_env->NewGlobalRef(scanner_obj);
+    _jni_env->DeleteLocalRef(scanner_obj);
 
     return Status::OK();
 }
@@ -139,6 +157,33 @@ Status JniScanner::_get_next_chunk(JNIEnv* _jni_env, long* chunk_meta) {
     return Status::OK();
 }
 
+void JniScanner::_start_prefetch() {
+    DCHECK(!_prefetch_future.valid());
+    auto promise = std::make_shared<std::promise<void>>();
+    _prefetch_future = promise->get_future();
+    MemTracker* mem_tracker = CurrentThread::mem_tracker();
+    auto prefetch = [this, promise, mem_tracker]() {
+        SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(mem_tracker);
+        JNIEnv* env = JVMFunctionHelper::getInstance().getEnv();
+        _prefetch_status = _get_next_chunk(env, &_prefetch_chunk_meta);
+        promise->set_value();
+    };
+    ThreadPool* pool = ExecEnv::GetInstance()->jni_scanner_prefetch_pool();
+    if (pool == nullptr || !pool->submit_func(prefetch).ok()) {
+        prefetch();
+    }
+}
+
+bool JniScanner::_wait_prefetch(Status* status, long* chunk_meta) {
+    if (!_prefetch_future.valid()) {
+        return false;
+    }
+    _prefetch_future.get();
+    *status = std::move(_prefetch_status);
+    *chunk_meta = _prefetch_chunk_meta;
+    return true;
+}
+
 template <LogicalType type, typename CppType>
 Status JniScanner::_append_primitive_data(const FillColumnArgs& args) {
     char* column_ptr = static_cast<char*>(next_chunk_meta_as_ptr());
@@ -186,12 +231,12 @@ Status JniScanner::_append_decimal_data(const FillColumnArgs& args) {
         if (args.nulls && args.nulls[i]) {
             // NULL
         } else {
-            std::string decimal_str(column_ptr + offset_ptr[i], column_ptr + offset_ptr[i + 1]);
+            const char* decimal_str = column_ptr + offset_ptr[i];
+            size_t decimal_len = offset_ptr[i + 1] - offset_ptr[i];
             CppType cpp_val;
-            if (DecimalV3Cast::from_string<CppType>(&cpp_val, precision, scale, decimal_str.data(),
-                                                    decimal_str.size())) {
-                return Status::DataQualityError(
-                        fmt::format("Invalid value occurs in column[{}], value is [{}]", args.slot_name, decimal_str));
+            if (DecimalV3Cast::from_string<CppType>(&cpp_val, precision, scale, decimal_str, decimal_len)) {
+                return Status::DataQualityError(fmt::format("Invalid value occurs in column[{}], value is [{}]",
+                                                            args.slot_name, std::string(decimal_str, decimal_len)));
             }
             runtime_data[i] = cpp_val;
         }
@@ -212,11 +257,12 @@ Status JniScanner::_append_date_data(const FillColumnArgs& args) {
         if (args.nulls && args.nulls[i]) {
             // NULL
         } else {
-            std::string date_str(column_ptr + offset_ptr[i], column_ptr + offset_ptr[i + 1]);
+            const char* date_str = column_ptr + offset_ptr[i];
+            size_t date_len = offset_ptr[i + 1] - offset_ptr[i];
             DateValue dv;
-            if (!dv.from_string(date_str.c_str(), date_str.size())) {
+            if (!dv.from_string(date_str, date_len)) {
                 return Status::DataQualityError(fmt::format("Invalid date value occurs on column[{}], value is [{}]",
-                                                            args.slot_name, date_str));
+                                                            args.slot_name, std::string(date_str, date_len)));
             }
             runtime_data[i] = dv;
         }
@@ -237,10 +283,10 @@ Status JniScanner::_append_datetime_data(const FillColumnArgs& args) {
         if (args.nulls && args.nulls[i]) {
             // NULL
         } else {
-            std::string origin_str(column_ptr + offset_ptr[i], column_ptr + offset_ptr[i + 1]);
-            std::string datetime_str = origin_str.substr(0, origin_str.find('.'));
+            std::string_view origin_str(column_ptr + offset_ptr[i], offset_ptr[i + 1] - offset_ptr[i]);
+            std::string_view datetime_str = origin_str.substr(0, origin_str.find('.'));
             TimestampValue tsv;
-            if (!tsv.from_datetime_format_str(datetime_str.c_str(), datetime_str.size(), "%Y-%m-%d %H:%i:%s")) {
+            if (!tsv.from_datetime_format_str(datetime_str.data(), datetime_str.size(), "%Y-%m-%d %H:%i:%s")) {
                 return Status::DataQualityError(fmt::format(
                         "Invalid datetime value occurs on column[{}], value is [{}]", args.slot_name, origin_str));
             }
@@ -429,6 +475,9 @@ Status JniScanner::_fill_chunk(JNIEnv* _jni_env, ChunkPtr* chunk) {
                             .column = column.get(),
                             .must_nullable = true};
         RETURN_IF_ERROR(_fill_column(&args));
+        if (_prefetch_enabled) {
+            continue;
+        }
         _jni_env->CallVoidMethod(_jni_scanner_obj, _jni_scanner_release_column, col_idx);
         RETURN_IF_ERROR(_check_jni_exception(
                 _jni_env, "Failed to call the releaseOffHeapColumnVector method of off-heap table scanner."));
@@ -436,8 +485,12 @@ Status JniScanner::_fill_chunk(JNIEnv* _jni_env, ChunkPtr* chunk) {
     return Status::OK();
 }
 
-Status JniScanner::_release_off_heap_table(JNIEnv* _jni_env) {
-    _jni_env->CallVoidMethod(_jni_scanner_obj, _jni_scanner_release_table);
+Status JniScanner::_release_off_heap_table(JNIEnv* _jni_env, long chunk_meta) {
+    if (_prefetch_enabled) {
+        _jni_env->CallVoidMethod(_jni_scanner_obj, _jni_scanner_release_table_by_address, chunk_meta);
+    } else {
+        _jni_env->CallVoidMethod(_jni_scanner_obj, _jni_scanner_release_table);
+    }
     RETURN_IF_ERROR(
             _check_jni_exception(_jni_env, "Failed to call the releaseOffHeapTable method of off-heap table scanner."));
     return Status::OK();
@@ -445,11 +498,19 @@ Status JniScanner::_release_off_heap_table(JNIEnv* _jni_env) {
 
 Status JniScanner::do_get_next(RuntimeState* runtime_state, ChunkPtr* chunk) {
     JNIEnv* _jni_env = JVMFunctionHelper::getInstance().getEnv();
-    long chunk_meta;
-    RETURN_IF_ERROR(_get_next_chunk(_jni_env, &chunk_meta));
+    long chunk_meta = 0;
+    Status status;
+    if (!_wait_prefetch(&status, &chunk_meta)) {
+        status = _get_next_chunk(_jni_env, &chunk_meta);
+    }
+    RETURN_IF_ERROR(status);
     reset_chunk_meta(chunk_meta);
-    Status status = _fill_chunk(_jni_env, chunk);
-    RETURN_IF_ERROR(_release_off_heap_table(_jni_env));
+    // the first element of the chunk meta is the number of rows, 0 means the end of file
+    if (_prefetch_enabled && _chunk_meta_ptr[0] > 0) {
+        _start_prefetch();
+    }
+    status = _fill_chunk(_jni_env, chunk);
+    RETURN_IF_ERROR(_release_off_heap_table(_jni_env, chunk_meta));
 
     // ====== conjunct evaluation ======
     // important to add columns before evaluation
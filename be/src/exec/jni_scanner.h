@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <future>
+
 #include "column/chunk.h"
 #include "common/logging.h"
 #include "common/status.h"
@@ -57,6 +59,11 @@ private:
 
     Status _get_next_chunk(JNIEnv* _jni_env, long* chunk_meta);
 
+    // Read the next chunk on the prefetch pool, it's read in the current thread if the pool is full.
+    void _start_prefetch();
+    // Wait for the prefetched chunk if any, return false if nothing is prefetched.
+    bool _wait_prefetch(Status* status, long* chunk_meta);
+
     template <LogicalType type, typename CppType>
     Status _append_primitive_data(const FillColumnArgs& args);
 
@@ -76,7 +83,7 @@ private:
 
     Status _fill_chunk(JNIEnv* _jni_env, ChunkPtr* chunk);
 
-    Status _release_off_heap_table(JNIEnv* _jni_env);
+    Status _release_off_heap_table(JNIEnv* _jni_env, long chunk_meta);
 
     jclass _jni_scanner_cls;
     jobject _jni_scanner_obj;
@@ -85,11 +92,19 @@ private:
     jmethodID _jni_scanner_close;
     jmethodID _jni_scanner_release_column;
     jmethodID _jni_scanner_release_table;
+    jmethodID _jni_scanner_release_table_by_address;
 
     std::map<std::string, std::string> _jni_scanner_params;
     std::string _jni_scanner_factory_class;
     Filter _chunk_filter;
 
+    // Whether the next chunk is read in the background while the current one is converted. The off-heap table of a
+    // chunk is released as a whole after it's converted then, since the java scanner has moved to the next table.
+    bool _prefetch_enabled = false;
+    std::future<void> _prefetch_future;
+    Status _prefetch_status;
+    long _prefetch_chunk_meta = 0;
+
 private:
     long* _chunk_meta_ptr;
     int _chunk_meta_index;
@@ -17,6 +17,8 @@
 #include <column/chunk.h>
 #include <runtime/descriptors.h>
 
+#include <limits>
+
 #include "column/vectorized_fwd.h"
 #include "exec/hash_join_node.h"
 #include "serde/column_array_serde.h"
@@ -64,26 +66,28 @@ void SerializedJoinBuildFunc::construct_hash_table(RuntimeState* state, JoinHash
     // serialize and build hash table
     uint32_t quo = row_count / state->chunk_size();
     uint32_t rem = row_count % state->chunk_size();
+    const uint32_t radix_bits = JoinHashMapHelper::calc_radix_bits(table_items->bucket_size);
 
     if (!null_columns.empty()) {
         for (size_t i = 0; i < quo; i++) {
             _build_nullable_columns(table_items, probe_state, data_columns, null_columns, 1 + state->chunk_size() * i,
-                                    state->chunk_size(), &ptr);
+                                    state->chunk_size(), radix_bits, &ptr);
         }
         _build_nullable_columns(table_items, probe_state, data_columns, null_columns, 1 + state->chunk_size() * quo,
-                                rem, &ptr);
+                                rem, radix_bits, &ptr);
     } else {
         for (size_t i = 0; i < quo; i++) {
             _build_columns(table_items, probe_state, data_columns, 1 + state->chunk_size() * i, state->chunk_size(),
-                           &ptr);
+                           radix_bits, &ptr);
         }
-        _build_columns(table_items, probe_state, data_columns, 1 + state->chunk_size() * quo, rem, &ptr);
+        _build_columns(table_items, probe_state, data_columns, 1 + state->chunk_size() * quo, rem, radix_bits, &ptr);
     }
+    JoinHashMapHelper::link_rows_by_radix(table_items, radix_bits);
 }
 
 void SerializedJoinBuildFunc::_build_columns(JoinHashTableItems* table_items, HashTableProbeState* probe_state,
                                              const Columns& data_columns, uint32_t start, uint32_t count,
-                                             uint8_t** ptr) {
+                                             uint32_t radix_bits, uint8_t** ptr) {
     for (size_t i = 0; i < count; i++) {
         table_items->build_slice[start + i] = JoinHashMapHelper::get_hash_key(data_columns, start + i, *ptr);
         probe_state->buckets[i] = JoinHashMapHelper::calc_bucket_num<Slice>(table_items->build_slice[start + i],
@@ -92,14 +96,14 @@ void SerializedJoinBuildFunc::_build_columns(JoinHashTableItems* table_items, Ha
     }
 
     for (size_t i = 0; i < count; i++) {
-        table_items->next[start + i] = table_items->first[probe_state->buckets[i]];
-        table_items->first[probe_state->buckets[i]] = start + i;
+        JoinHashMapHelper::add_row(table_items, radix_bits, start + i, probe_state->buckets[i]);
     }
 }
 
 void SerializedJoinBuildFunc::_build_nullable_columns(JoinHashTableItems* table_items, HashTableProbeState* probe_state,
                                                       const Columns& data_columns, const NullColumns& null_columns,
-                                                      uint32_t start, uint32_t count, uint8_t** ptr) {
+                                                      uint32_t start, uint32_t count, uint32_t radix_bits,
+                                                      uint8_t** ptr) {
     for (uint32_t i = 0; i < count; i++) {
         probe_state->is_nulls[i] = null_columns[0]->get_data()[start + i];
     }
@@ -120,8 +124,9 @@ void SerializedJoinBuildFunc::_build_nullable_columns(JoinHashTableItems* table_
 
     for (size_t i = 0; i < count; i++) {
         if (probe_state->is_nulls[i] == 0) {
-            table_items->next[start + i] = table_items->first[probe_state->buckets[i]];
-            table_items->first[probe_state->buckets[i]] = start + i;
+            JoinHashMapHelper::add_row(table_items, radix_bits, start + i, probe_state->buckets[i]);
+        } else if (radix_bits > 0) {
+            table_items->next[start + i] = JoinHashMapHelper::RADIX_NULL_BUCKET;
         }
     }
 }
@@ -173,9 +178,8 @@ void SerializedJoinProbeFunc::_probe_column(const JoinHashTableItems& table_item
         ptr += probe_state->probe_slice[i].size;
     }
 
-    for (uint32_t i = 0; i < row_count; i++) {
-        probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-    }
+    JoinHashMapHelper::lookup_chain_heads<Slice>(table_items, table_items.build_slice.data(), nullptr, probe_state,
+                                                 row_count);
 }
 
 void SerializedJoinProbeFunc::_probe_nullable_column(const JoinHashTableItems& table_items,
@@ -203,11 +207,13 @@ void SerializedJoinProbeFunc::_probe_nullable_column(const JoinHashTableItems& t
         if (probe_state->is_nulls[i] == 0) {
             probe_state->buckets[i] =
                     JoinHashMapHelper::calc_bucket_num<Slice>(probe_state->probe_slice[i], table_items.bucket_size);
-            probe_state->next[i] = table_items.first[probe_state->buckets[i]];
         } else {
-            probe_state->next[i] = 0;
+            probe_state->buckets[i] = 0;
         }
     }
+
+    JoinHashMapHelper::lookup_chain_heads<Slice>(table_items, table_items.build_slice.data(),
+                                                 probe_state->is_nulls.data(), probe_state, row_count);
 }
 
 JoinHashTable JoinHashTable::clone_readable_table() {
@@ -265,6 +271,7 @@ void JoinHashTable::create(const HashTableParam& param) {
     _table_items->build_chunk = std::make_shared<Chunk>();
     _table_items->with_other_conjunct = param.with_other_conjunct;
     _table_items->join_type = param.join_type;
+    _table_items->key_only = param.key_only_build;
     _table_items->row_desc = param.row_desc;
     if (_table_items->join_type == TJoinOp::RIGHT_SEMI_JOIN || _table_items->join_type == TJoinOp::RIGHT_ANTI_JOIN ||
         _table_items->join_type == TJoinOp::RIGHT_OUTER_JOIN) {
@@ -323,6 +330,16 @@ void JoinHashTable::create(const HashTableParam& param) {
                 hash_table_slot.need_output = false;
             }
 
+            if (_table_items->key_only) {
+                hash_table_slot.need_build = false;
+                for (const auto& key_desc : param.join_keys) {
+                    if (key_desc.col_ref != nullptr && key_desc.col_ref->slot_id() == slot->id()) {
+                        hash_table_slot.need_build = true;
+                        break;
+                    }
+                }
+            }
+
             _table_items->build_slots.emplace_back(hash_table_slot);
             ColumnPtr column = ColumnHelper::create_column(slot->type(), slot->is_nullable());
             if (slot->is_nullable()) {
@@ -404,6 +421,41 @@ Status JoinHashTable::build(RuntimeState* state) {
     return Status::OK();
 }
 
+bool JoinHashTable::is_compatible_build_data(const JoinHashTableItems& build_data) const {
+    const auto& chunk = *_table_items->build_chunk;
+    const auto& other_chunk = *build_data.build_chunk;
+    if (chunk.num_columns() != other_chunk.num_columns() ||
+        chunk.get_slot_id_to_index_map() != other_chunk.get_slot_id_to_index_map()) {
+        return false;
+    }
+    for (size_t i = 0; i < chunk.num_columns(); i++) {
+        if (chunk.get_column_by_index(i)->is_nullable() != other_chunk.get_column_by_index(i)->is_nullable()) {
+            return false;
+        }
+    }
+    // The build rows except the keys are dropped from the key only build data
+    if (build_data.key_only && !_table_items->key_only) {
+        return false;
+    }
+    // The descriptors referred by build_data may have been released with its query, so only check the data.
+    return _table_items->join_keys.size() == build_data.key_columns.size();
+}
+
+Status JoinHashTable::attach_build_data(RuntimeState* state, std::shared_ptr<const JoinHashTableItems> build_data) {
+    DCHECK(is_compatible_build_data(*build_data));
+    _table_items->build_chunk = build_data->build_chunk;
+    _table_items->key_columns = build_data->key_columns;
+    _table_items->first = build_data->first;
+    _table_items->next = build_data->next;
+    _table_items->build_slice = build_data->build_slice;
+    _table_items->build_key_column = build_data->build_key_column;
+    _table_items->bucket_size = build_data->bucket_size;
+    _table_items->row_count = build_data->row_count;
+    _table_items->has_large_column = build_data->has_large_column;
+    _table_items->shared_build_data = std::move(build_data);
+    return reset_probe_state(state);
+}
+
 Status JoinHashTable::reset_probe_state(starrocks::RuntimeState* state) {
     _hash_map_type = _choose_join_hash_map();
     switch (_hash_map_type) {
@@ -459,6 +511,10 @@ void JoinHashTable::append_chunk(RuntimeState* state, const ChunkPtr& chunk, con
     Columns& columns = _table_items->build_chunk->columns();
 
     for (size_t i = 0; i < _table_items->build_column_count; i++) {
+        if (!_table_items->build_slots[i].need_build) {
+            // Only the placeholder row
+            continue;
+        }
         SlotDescriptor* slot = _table_items->build_slots[i].slot;
         ColumnPtr& column = chunk->get_column_by_slot_id(slot->id());
 
@@ -566,6 +622,46 @@ Status JoinHashTable::_upgrade_key_columns_if_overflow() {
     return Status::OK();
 }
 
+template <LogicalType LT>
+bool JoinHashTable::_is_dense_range_key() {
+    using CppType = RunTimeCppType<LT>;
+    using UnsignedType = std::make_unsigned_t<CppType>;
+    const int32_t max_ratio = config::join_dense_range_direct_mapping_ratio;
+    if (max_ratio <= 0) {
+        return false;
+    }
+
+    const auto& key_column = _table_items->key_columns[0];
+    const auto& data =
+            down_cast<const RunTimeColumnType<LT>*>(ColumnHelper::get_data_column(key_column.get()))->get_data();
+    const uint8_t* nulls = nullptr;
+    if (key_column->is_nullable()) {
+        nulls = down_cast<const NullableColumn*>(key_column.get())->null_column()->get_data().data();
+    }
+    // the first row is reserved by the hash table
+    CppType min_key = std::numeric_limits<CppType>::max();
+    CppType max_key = std::numeric_limits<CppType>::lowest();
+    for (size_t i = 1; i < _table_items->row_count + 1; i++) {
+        if (nulls == nullptr || nulls[i] == 0) {
+            min_key = std::min(min_key, data[i]);
+            max_key = std::max(max_key, data[i]);
+        }
+    }
+    if (min_key > max_key) {
+        // all the keys are null
+        return false;
+    }
+
+    const uint64_t range = static_cast<UnsignedType>(max_key) - static_cast<UnsignedType>(min_key) + 1ULL;
+    if (range == 0 || range >= JoinHashMapHelper::MAX_BUCKET_SIZE ||
+        range > static_cast<uint64_t>(_table_items->row_count) * max_ratio) {
+        return false;
+    }
+    _table_items->bucket_size = range;
+    _table_items->dense_min_key = min_key;
+    return true;
+}
+
 JoinHashMapType JoinHashTable::_choose_join_hash_map() {
     if (_table_items->row_count == 0) {
         return JoinHashMapType::empty;
@@ -589,9 +685,9 @@ JoinHashMapType JoinHashTable::_choose_join_hash_map() {
         case LogicalType::TYPE_SMALLINT:
             return JoinHashMapType::key16;
         case LogicalType::TYPE_INT:
-            return JoinHashMapType::key32;
+            return _is_dense_range_key<TYPE_INT>() ? JoinHashMapType::dense32 : JoinHashMapType::key32;
         case LogicalType::TYPE_BIGINT:
-            return JoinHashMapType::key64;
+            return _is_dense_range_key<TYPE_BIGINT>() ? JoinHashMapType::dense64 : JoinHashMapType::key64;
         case LogicalType::TYPE_LARGEINT:
             return JoinHashMapType::key128;
         case LogicalType::TYPE_FLOAT:
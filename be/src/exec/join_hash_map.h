@@ -20,12 +20,15 @@
 #include <runtime/descriptors.h>
 #include <runtime/runtime_state.h>
 
+#include <algorithm>
 #include <cstdint>
 
 #include "column/chunk.h"
 #include "column/column_hash.h"
 #include "column/column_helper.h"
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
+#include "runtime/memory/huge_page_allocator.h"
 #include "util/phmap/phmap.h"
 
 #if defined(__aarch64__)
@@ -55,7 +58,9 @@ class ColumnRef;
     M(slice)                       \
     M(fixed32)                     \
     M(fixed64)                     \
-    M(fixed128)
+    M(fixed128)                    \
+    M(dense32)                     \
+    M(dense64)
 
 enum class JoinHashMapType {
     empty,
@@ -77,7 +82,9 @@ enum class JoinHashMapType {
     slice,
     fixed32, // 4 bytes
     fixed64, // 8 bytes
-    fixed128 // 16 bytes
+    fixed128, // 16 bytes
+    dense32,  // int32 keys within a dense range
+    dense64   // int64 keys within a dense range
 };
 
 enum class JoinMatchFlag { NORMAL, ALL_NOT_MATCH, ALL_MATCH_ONE, MOST_MATCH_ONE };
@@ -91,6 +98,8 @@ struct JoinKeyDesc {
 struct HashTableSlotDescriptor {
     SlotDescriptor* slot;
     bool need_output;
+    // Whether the column is appended to the build chunk, only the key columns are appended if key_only.
+    bool need_build = true;
 };
 
 struct JoinHashTableItems {
@@ -109,12 +118,15 @@ struct JoinHashTableItems {
     // the list of keys in a bucket.
     // A paper (https://dare.uva.nl/search?identifier=5ccbb60a-38b8-4eeb-858a-e7735dd37487) talks
     // about the bucket-chained hash table of this kind.
-    Buffer<uint32_t> first;
-    Buffer<uint32_t> next;
+    // The large ones are backed by the huge pages to reduce the TLB misses of the random accesses.
+    HugePageBuffer<uint32_t> first;
+    HugePageBuffer<uint32_t> next;
     Buffer<Slice> build_slice;
     ColumnPtr build_key_column;
     uint32_t bucket_size = 0;
     uint32_t row_count = 0; // real row count
+    // The min key of the dense range direct mapping, the bucket of a key is (key - dense_min_key).
+    int64_t dense_min_key = 0;
     size_t build_column_count = 0;
     size_t probe_column_count = 0;
     bool with_other_conjunct = false;
@@ -122,6 +134,12 @@ struct JoinHashTableItems {
     bool left_to_nullable = false;
     bool right_to_nullable = false;
     bool has_large_column = false;
+    // Only the join keys of the build rows are kept, and the chains link only the first build row of every
+    // distinct key, for the left semi/anti joins which only need the existence of the keys.
+    bool key_only = false;
+    // The build data shared from the hash table built by another query, build_slice refers to its build_pool.
+    // Only the data of it can be accessed, the descriptors and counters it referred may have been released.
+    std::shared_ptr<const JoinHashTableItems> shared_build_data;
 
     TJoinOp::type join_type = TJoinOp::INNER_JOIN;
 
@@ -218,6 +236,8 @@ struct HashTableParam {
     std::set<SlotId> output_slots;
     std::set<SlotId> predicate_slots;
     std::vector<JoinKeyDesc> join_keys;
+    // Build the hash table key only, see JoinHashTableItems::key_only.
+    bool key_only_build = false;
 
     RuntimeProfile::Counter* search_ht_timer = nullptr;
     RuntimeProfile::Counter* output_build_column_timer = nullptr;
@@ -288,6 +308,120 @@ public:
         }
     }
 
+    // The bucket of a null row saved in "JoinHashTableItems.next" by the radix build.
+    const static uint32_t RADIX_NULL_BUCKET = UINT32_MAX;
+    const static uint32_t MIN_RADIX_BITS = 4;
+    const static uint32_t MAX_RADIX_BITS = 10;
+
+    // A huge bucket array is partitioned into 2^radix_bits sub tables by the high bits of the bucket index,
+    // 0 means linking the rows into the bucket chains directly.
+    static uint32_t calc_radix_bits(uint32_t bucket_size) {
+        const int64_t sub_table_bytes = config::join_hash_table_radix_build_sub_table_bytes;
+        if (sub_table_bytes <= 0) {
+            return 0;
+        }
+        const int64_t bucket_bytes = static_cast<int64_t>(bucket_size) * sizeof(uint32_t);
+        uint32_t radix_bits = 0;
+        while ((sub_table_bytes << radix_bits) < bucket_bytes && radix_bits < MAX_RADIX_BITS) {
+            radix_bits++;
+        }
+        return radix_bits >= MIN_RADIX_BITS ? radix_bits : 0;
+    }
+
+    // Save the bucket of the row, or link it into the bucket chain if not radix build.
+    static void add_row(JoinHashTableItems* table_items, uint32_t radix_bits, uint32_t row, uint32_t bucket_num) {
+        if (radix_bits > 0) {
+            table_items->next[row] = bucket_num;
+        } else {
+            table_items->next[row] = table_items->first[bucket_num];
+            table_items->first[bucket_num] = row;
+        }
+    }
+
+    // Link the rows whose buckets are saved in "JoinHashTableItems.next" by add_row into the bucket chains,
+    // one sub table after another, so that the random writes of "first" hit the cache.
+    // The rows of every sub table are linked in the row order, so the chains are the same as linked directly.
+    static void link_rows_by_radix(JoinHashTableItems* table_items, uint32_t radix_bits) {
+        if (radix_bits == 0) {
+            return;
+        }
+        auto& first = table_items->first;
+        auto& next = table_items->next;
+        const uint32_t row_count = table_items->row_count;
+        const uint32_t num_partitions = 1U << radix_bits;
+        const uint32_t shift = __builtin_ctz(table_items->bucket_size) - radix_bits;
+
+        std::vector<uint32_t> offsets(num_partitions + 1, 0);
+        for (uint32_t i = 1; i < row_count + 1; i++) {
+            if (next[i] != RADIX_NULL_BUCKET) {
+                offsets[(next[i] >> shift) + 1]++;
+            }
+        }
+        for (uint32_t i = 0; i < num_partitions; i++) {
+            offsets[i + 1] += offsets[i];
+        }
+        Buffer<uint32_t> rows(offsets[num_partitions]);
+        for (uint32_t i = 1; i < row_count + 1; i++) {
+            if (next[i] != RADIX_NULL_BUCKET) {
+                rows[offsets[next[i] >> shift]++] = i;
+            } else {
+                next[i] = 0;
+            }
+        }
+        for (uint32_t row : rows) {
+            const uint32_t bucket_num = next[row];
+            next[row] = first[bucket_num];
+            first[bucket_num] = row;
+        }
+    }
+
+    // The distance in rows of prefetching the buckets ahead of the lookups.
+    const static uint32_t PROBE_PREFETCH_DISTANCE = 16;
+
+    static bool need_probe_prefetch(const JoinHashTableItems& table_items) {
+        const int64_t min_bytes = config::join_hash_table_probe_prefetch_min_bytes;
+        return min_bytes >= 0 && static_cast<int64_t>(table_items.bucket_size) * sizeof(uint32_t) > min_bytes;
+    }
+
+    // Look up the first rows of the bucket chains of the probe rows into "HashTableProbeState.next" by the buckets
+    // computed in "HashTableProbeState.buckets", the rows whose |is_nulls| are set have no chains.
+    // For a huge hash table, the buckets are prefetched PROBE_PREFETCH_DISTANCE rows ahead, and the build keys and
+    // the next rows of the chain heads are prefetched as soon as they are known, so that the probe walking the
+    // chains of the whole batch later does not stall on the memory.
+    template <typename CppType>
+    static void lookup_chain_heads(const JoinHashTableItems& table_items, const CppType* build_keys,
+                                   const uint8_t* is_nulls, HashTableProbeState* probe_state, uint32_t row_count) {
+        const auto& first = table_items.first;
+        const auto& buckets = probe_state->buckets;
+        auto& next = probe_state->next;
+        if (!need_probe_prefetch(table_items)) {
+            for (uint32_t i = 0; i < row_count; i++) {
+                next[i] = (is_nulls != nullptr && is_nulls[i] != 0) ? 0 : first[buckets[i]];
+            }
+            return;
+        }
+
+        const uint32_t prefetch_rows = std::min(row_count, PROBE_PREFETCH_DISTANCE);
+        for (uint32_t i = 0; i < prefetch_rows; i++) {
+            __builtin_prefetch(&first[buckets[i]]);
+        }
+        for (uint32_t i = 0; i < row_count; i++) {
+            if (i + PROBE_PREFETCH_DISTANCE < row_count) {
+                __builtin_prefetch(&first[buckets[i + PROBE_PREFETCH_DISTANCE]]);
+            }
+            if (is_nulls != nullptr && is_nulls[i] != 0) {
+                next[i] = 0;
+                continue;
+            }
+            const uint32_t head = first[buckets[i]];
+            next[i] = head;
+            if (head != 0) {
+                __builtin_prefetch(&build_keys[head]);
+                __builtin_prefetch(&table_items.next[head]);
+            }
+        }
+    }
+
     static Slice get_hash_key(const Columns& key_columns, size_t row_idx, uint8_t* buffer) {
         size_t byte_size = 0;
         for (const auto& key_column : key_columns) {
@@ -339,6 +473,22 @@ public:
                                      HashTableProbeState* probe_state);
 };
 
+// For the int32/int64 keys within a dense range [min, max], the buckets are indexed by (key - min) directly,
+// so neither hash nor key comparison is needed, and the chains only link the duplicated keys.
+template <LogicalType LT>
+class DenseRangeDirectMappingJoinBuildFunc {
+public:
+    using CppType = typename RunTimeTypeTraits<LT>::CppType;
+    using ColumnType = typename RunTimeTypeTraits<LT>::ColumnType;
+
+    static void prepare(RuntimeState* runtime, JoinHashTableItems* table_items);
+    static const Buffer<CppType>& get_key_data(const JoinHashTableItems& table_items) {
+        return JoinBuildFunc<LT>::get_key_data(table_items);
+    }
+    static void construct_hash_table(RuntimeState* state, JoinHashTableItems* table_items,
+                                     HashTableProbeState* probe_state);
+};
+
 template <LogicalType LT>
 class FixedSizeJoinBuildFunc {
 public:
@@ -355,11 +505,11 @@ public:
 
 private:
     static void _build_columns(JoinHashTableItems* table_items, HashTableProbeState* probe_state,
-                               const Columns& data_columns, uint32_t start, uint32_t count);
+                               const Columns& data_columns, uint32_t start, uint32_t count, uint32_t radix_bits);
 
     static void _build_nullable_columns(JoinHashTableItems* table_items, HashTableProbeState* probe_state,
                                         const Columns& data_columns, const NullColumns& null_columns, uint32_t start,
-                                        uint32_t count);
+                                        uint32_t count, uint32_t radix_bits);
 };
 
 class SerializedJoinBuildFunc {
@@ -371,11 +521,12 @@ public:
 
 private:
     static void _build_columns(JoinHashTableItems* table_items, HashTableProbeState* probe_state,
-                               const Columns& data_columns, uint32_t start, uint32_t count, uint8_t** ptr);
+                               const Columns& data_columns, uint32_t start, uint32_t count, uint32_t radix_bits,
+                               uint8_t** ptr);
 
     static void _build_nullable_columns(JoinHashTableItems* table_items, HashTableProbeState* probe_state,
                                         const Columns& data_columns, const NullColumns& null_columns, uint32_t start,
-                                        uint32_t count, uint8_t** ptr);
+                                        uint32_t count, uint32_t radix_bits, uint8_t** ptr);
 };
 
 template <LogicalType LT>
@@ -402,6 +553,21 @@ public:
     static bool equal(const CppType& x, const CppType& y) { return true; }
 };
 
+template <LogicalType LT>
+class DenseRangeDirectMappingJoinProbeFunc {
+public:
+    using CppType = typename RunTimeTypeTraits<LT>::CppType;
+    using ColumnType = typename RunTimeTypeTraits<LT>::ColumnType;
+
+    static void prepare(RuntimeState* state, HashTableProbeState* probe_state) {}
+    // The keys out of the range have no chains.
+    static void lookup_init(const JoinHashTableItems& table_items, HashTableProbeState* probe_state);
+    static const Buffer<CppType>& get_key_data(const HashTableProbeState& probe_state) {
+        return JoinProbeFunc<LT>::get_key_data(probe_state);
+    }
+    static bool equal(const CppType& x, const CppType& y) { return true; }
+};
+
 template <LogicalType LT>
 class FixedSizeJoinProbeFunc {
 public:
@@ -558,6 +724,9 @@ public:
     void probe_remain(RuntimeState* state, ChunkPtr* chunk, bool* has_remain);
 
 private:
+    // Unlink the build rows whose keys are duplicated with the previous rows of the same chain.
+    void _remove_duplicated_build_keys();
+
     void _probe_output(ChunkPtr* probe_chunk, ChunkPtr* chunk);
     void _probe_tuple_output(ChunkPtr* probe_chunk, ChunkPtr* chunk);
     void _probe_null_output(ChunkPtr* chunk, size_t count);
@@ -668,6 +837,8 @@ private:
 #define JoinHashMapForDirectMapping(LT) JoinHashMap<LT, DirectMappingJoinBuildFunc<LT>, DirectMappingJoinProbeFunc<LT>>
 #define JoinHashMapForFixedSizeKey(LT) JoinHashMap<LT, FixedSizeJoinBuildFunc<LT>, FixedSizeJoinProbeFunc<LT>>
 #define JoinHashMapForSerializedKey(LT) JoinHashMap<LT, SerializedJoinBuildFunc, SerializedJoinProbeFunc>
+#define JoinHashMapForDenseRange(LT) \
+    JoinHashMap<LT, DenseRangeDirectMappingJoinBuildFunc<LT>, DenseRangeDirectMappingJoinProbeFunc<LT>>
 
 class JoinHashTable {
 public:
@@ -692,6 +863,14 @@ public:
 
     Status build(RuntimeState* state);
     Status reset_probe_state(RuntimeState* state);
+
+    // The build data of the built hash table, which can be shared by the hash tables of the same build side.
+    std::shared_ptr<const JoinHashTableItems> build_data() const { return _table_items; }
+    // Whether the build columns and the join keys of |build_data| have the same layout as this.
+    bool is_compatible_build_data(const JoinHashTableItems& build_data) const;
+    // Share |build_data| of the same build side read-only instead of building this hash table, the probe
+    // related items of this are kept.
+    Status attach_build_data(RuntimeState* state, std::shared_ptr<const JoinHashTableItems> build_data);
     Status probe(RuntimeState* state, const Columns& key_columns, ChunkPtr* probe_chunk, ChunkPtr* chunk, bool* eos);
     Status probe_remain(RuntimeState* state, ChunkPtr* chunk, bool* eos);
 
@@ -711,6 +890,9 @@ public:
 
 private:
     JoinHashMapType _choose_join_hash_map();
+    // Whether the keys of the single int key column are within a dense range, and save the min key if so.
+    template <LogicalType LT>
+    bool _is_dense_range_key();
     static size_t _get_size_of_fixed_and_contiguous_type(LogicalType data_type);
 
     Status _upgrade_key_columns_if_overflow();
@@ -743,6 +925,8 @@ private:
     std::unique_ptr<JoinHashMapForFixedSizeKey(TYPE_INT)> _fixed32 = nullptr;
     std::unique_ptr<JoinHashMapForFixedSizeKey(TYPE_BIGINT)> _fixed64 = nullptr;
     std::unique_ptr<JoinHashMapForFixedSizeKey(TYPE_LARGEINT)> _fixed128 = nullptr;
+    std::unique_ptr<JoinHashMapForDenseRange(TYPE_INT)> _dense32 = nullptr;
+    std::unique_ptr<JoinHashMapForDenseRange(TYPE_BIGINT)> _dense64 = nullptr;
 
     JoinHashMapType _hash_map_type = JoinHashMapType::empty;
     bool _need_create_tuple_columns = true;
@@ -54,23 +54,25 @@ template <LogicalType LT>
 void JoinBuildFunc<LT>::construct_hash_table(RuntimeState* state, JoinHashTableItems* table_items,
                                              HashTableProbeState* probe_state) {
     auto& data = get_key_data(*table_items);
+    const uint32_t radix_bits = JoinHashMapHelper::calc_radix_bits(table_items->bucket_size);
     if (table_items->key_columns[0]->is_nullable()) {
         auto* nullable_column = ColumnHelper::as_raw_column<NullableColumn>(table_items->key_columns[0]);
         auto& null_array = nullable_column->null_column()->get_data();
         for (size_t i = 1; i < table_items->row_count + 1; i++) {
             if (null_array[i] == 0) {
                 uint32_t bucket_num = JoinHashMapHelper::calc_bucket_num<CppType>(data[i], table_items->bucket_size);
-                table_items->next[i] = table_items->first[bucket_num];
-                table_items->first[bucket_num] = i;
+                JoinHashMapHelper::add_row(table_items, radix_bits, i, bucket_num);
+            } else if (radix_bits > 0) {
+                table_items->next[i] = JoinHashMapHelper::RADIX_NULL_BUCKET;
             }
         }
     } else {
         for (size_t i = 1; i < table_items->row_count + 1; i++) {
             uint32_t bucket_num = JoinHashMapHelper::calc_bucket_num<CppType>(data[i], table_items->bucket_size);
-            table_items->next[i] = table_items->first[bucket_num];
-            table_items->first[bucket_num] = i;
+            JoinHashMapHelper::add_row(table_items, radix_bits, i, bucket_num);
         }
     }
+    JoinHashMapHelper::link_rows_by_radix(table_items, radix_bits);
 }
 
 template <LogicalType LT>
@@ -118,6 +120,39 @@ void DirectMappingJoinBuildFunc<LT>::construct_hash_table(RuntimeState* state, J
     }
 }
 
+template <LogicalType LT>
+void DenseRangeDirectMappingJoinBuildFunc<LT>::prepare(RuntimeState* runtime, JoinHashTableItems* table_items) {
+    // bucket_size is computed by JoinHashTable::_is_dense_range_key
+    table_items->first.resize(table_items->bucket_size, 0);
+    table_items->next.resize(table_items->row_count + 1, 0);
+}
+
+template <LogicalType LT>
+void DenseRangeDirectMappingJoinBuildFunc<LT>::construct_hash_table(RuntimeState* state,
+                                                                    JoinHashTableItems* table_items,
+                                                                    HashTableProbeState* probe_state) {
+    using UnsignedType = std::make_unsigned_t<CppType>;
+    const auto min_key = static_cast<UnsignedType>(table_items->dense_min_key);
+    auto& data = get_key_data(*table_items);
+    if (table_items->key_columns[0]->is_nullable()) {
+        auto* nullable_column = ColumnHelper::as_raw_column<NullableColumn>(table_items->key_columns[0]);
+        auto& null_array = nullable_column->null_column()->get_data();
+        for (size_t i = 1; i < table_items->row_count + 1; i++) {
+            if (null_array[i] == 0) {
+                size_t bucket_num = static_cast<UnsignedType>(data[i]) - min_key;
+                table_items->next[i] = table_items->first[bucket_num];
+                table_items->first[bucket_num] = i;
+            }
+        }
+    } else {
+        for (size_t i = 1; i < table_items->row_count + 1; i++) {
+            size_t bucket_num = static_cast<UnsignedType>(data[i]) - min_key;
+            table_items->next[i] = table_items->first[bucket_num];
+            table_items->first[bucket_num] = i;
+        }
+    }
+}
+
 template <LogicalType LT>
 void FixedSizeJoinBuildFunc<LT>::prepare(RuntimeState* state, JoinHashTableItems* table_items) {
     table_items->bucket_size = JoinHashMapHelper::calc_bucket_size(table_items->row_count + 1);
@@ -151,25 +186,29 @@ void FixedSizeJoinBuildFunc<LT>::construct_hash_table(RuntimeState* state, JoinH
     // serialize and build hash table
     uint32_t quo = row_count / state->chunk_size();
     uint32_t rem = row_count % state->chunk_size();
+    const uint32_t radix_bits = JoinHashMapHelper::calc_radix_bits(table_items->bucket_size);
 
     if (!null_columns.empty()) {
         for (size_t i = 0; i < quo; i++) {
             _build_nullable_columns(table_items, probe_state, data_columns, null_columns, 1 + state->chunk_size() * i,
-                                    state->chunk_size());
+                                    state->chunk_size(), radix_bits);
         }
         _build_nullable_columns(table_items, probe_state, data_columns, null_columns, 1 + state->chunk_size() * quo,
-                                rem);
+                                rem, radix_bits);
     } else {
         for (size_t i = 0; i < quo; i++) {
-            _build_columns(table_items, probe_state, data_columns, 1 + state->chunk_size() * i, state->chunk_size());
+            _build_columns(table_items, probe_state, data_columns, 1 + state->chunk_size() * i, state->chunk_size(),
+                           radix_bits);
         }
-        _build_columns(table_items, probe_state, data_columns, 1 + state->chunk_size() * quo, rem);
+        _build_columns(table_items, probe_state, data_columns, 1 + state->chunk_size() * quo, rem, radix_bits);
     }
+    JoinHashMapHelper::link_rows_by_radix(table_items, radix_bits);
 }
 
 template <LogicalType LT>
 void FixedSizeJoinBuildFunc<LT>::_build_columns(JoinHashTableItems* table_items, HashTableProbeState* probe_state,
-                                                const Columns& data_columns, uint32_t start, uint32_t count) {
+                                                const Columns& data_columns, uint32_t start, uint32_t count,
+                                                uint32_t radix_bits) {
     JoinHashMapHelper::serialize_fixed_size_key_column<LT>(data_columns, table_items->build_key_column.get(), start,
                                                            count);
 
@@ -177,8 +216,7 @@ void FixedSizeJoinBuildFunc<LT>::_build_columns(JoinHashTableItems* table_items,
     JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items->bucket_size, &probe_state->buckets, start, count);
 
     for (uint32_t i = 0; i < count; i++) {
-        table_items->next[start + i] = table_items->first[probe_state->buckets[i]];
-        table_items->first[probe_state->buckets[i]] = start + i;
+        JoinHashMapHelper::add_row(table_items, radix_bits, start + i, probe_state->buckets[i]);
     }
 }
 
@@ -186,7 +224,7 @@ template <LogicalType LT>
 void FixedSizeJoinBuildFunc<LT>::_build_nullable_columns(JoinHashTableItems* table_items,
                                                          HashTableProbeState* probe_state, const Columns& data_columns,
                                                          const NullColumns& null_columns, uint32_t start,
-                                                         uint32_t count) {
+                                                         uint32_t count, uint32_t radix_bits) {
     for (uint32_t i = 0; i < count; i++) {
         probe_state->is_nulls[i] = null_columns[0]->get_data()[start + i];
     }
@@ -203,8 +241,9 @@ void FixedSizeJoinBuildFunc<LT>::_build_nullable_columns(JoinHashTableItems* tab
 
     for (size_t i = 0; i < count; i++) {
         if (probe_state->is_nulls[i] == 0) {
-            table_items->next[start + i] = table_items->first[probe_state->buckets[i]];
-            table_items->first[probe_state->buckets[i]] = start + i;
+            JoinHashMapHelper::add_row(table_items, radix_bits, start + i, probe_state->buckets[i]);
+        } else if (radix_bits > 0) {
+            table_items->next[start + i] = JoinHashMapHelper::RADIX_NULL_BUCKET;
         }
     }
 }
@@ -260,32 +299,25 @@ void JoinProbeFunc<LT>::lookup_init(const JoinHashTableItems& table_items, HashT
     size_t probe_row_count = probe_state->probe_row_count;
     auto& data = get_key_data(*probe_state);
     JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items.bucket_size, &probe_state->buckets, 0, data.size());
+    const CppType* build_keys = JoinBuildFunc<LT>::get_key_data(table_items).data();
 
     if ((*probe_state->key_columns)[0]->is_nullable()) {
         auto* nullable_column = ColumnHelper::as_raw_column<NullableColumn>((*probe_state->key_columns)[0]);
 
         if (nullable_column->has_null()) {
             auto& null_array = nullable_column->null_column()->get_data();
-            for (size_t i = 0; i < probe_row_count; i++) {
-                if (null_array[i] == 0) {
-                    probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-                } else {
-                    probe_state->next[i] = 0;
-                }
-            }
+            JoinHashMapHelper::lookup_chain_heads<CppType>(table_items, build_keys, null_array.data(), probe_state,
+                                                           probe_row_count);
             probe_state->null_array = &nullable_column->null_column()->get_data();
         } else {
-            for (size_t i = 0; i < probe_row_count; i++) {
-                probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-            }
+            JoinHashMapHelper::lookup_chain_heads<CppType>(table_items, build_keys, nullptr, probe_state,
+                                                           probe_row_count);
             probe_state->null_array = nullptr;
         }
         return;
     }
 
-    for (size_t i = 0; i < probe_row_count; i++) {
-        probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-    }
+    JoinHashMapHelper::lookup_chain_heads<CppType>(table_items, build_keys, nullptr, probe_state, probe_row_count);
     probe_state->null_array = nullptr;
 }
 
@@ -300,6 +332,32 @@ const Buffer<typename JoinProbeFunc<LT>::CppType>& JoinProbeFunc<LT>::get_key_da
     return ColumnHelper::as_raw_column<ColumnType>((*probe_state.key_columns)[0])->get_data();
 }
 
+template <LogicalType LT>
+void DenseRangeDirectMappingJoinProbeFunc<LT>::lookup_init(const JoinHashTableItems& table_items,
+                                                           HashTableProbeState* probe_state) {
+    using UnsignedType = std::make_unsigned_t<CppType>;
+    const auto min_key = static_cast<UnsignedType>(table_items.dense_min_key);
+    const uint32_t bucket_size = table_items.bucket_size;
+    size_t probe_row_count = probe_state->probe_row_count;
+    auto& data = get_key_data(*probe_state);
+
+    // the key is in the range iff (key - min_key) < bucket_size in the unsigned arithmetic
+    const uint8_t* nulls = nullptr;
+    probe_state->null_array = nullptr;
+    if ((*probe_state->key_columns)[0]->is_nullable()) {
+        auto* nullable_column = ColumnHelper::as_raw_column<NullableColumn>((*probe_state->key_columns)[0]);
+        if (nullable_column->has_null()) {
+            nulls = nullable_column->null_column()->get_data().data();
+            probe_state->null_array = &nullable_column->null_column()->get_data();
+        }
+    }
+    for (size_t i = 0; i < probe_row_count; i++) {
+        const UnsignedType offset = static_cast<UnsignedType>(data[i]) - min_key;
+        const bool in_range = offset < bucket_size && (nulls == nullptr || nulls[i] == 0);
+        probe_state->next[i] = in_range ? table_items.first[offset] : 0;
+    }
+}
+
 template <LogicalType LT>
 void FixedSizeJoinProbeFunc<LT>::lookup_init(const JoinHashTableItems& table_items, HashTableProbeState* probe_state) {
     // prepare columns
@@ -344,9 +402,8 @@ void FixedSizeJoinProbeFunc<LT>::_probe_column(const JoinHashTableItems& table_i
     const auto& data = get_key_data(*probe_state);
     JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items.bucket_size, &probe_state->buckets, 0, row_count);
 
-    for (uint32_t i = 0; i < row_count; i++) {
-        probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-    }
+    const CppType* build_keys = FixedSizeJoinBuildFunc<LT>::get_key_data(table_items).data();
+    JoinHashMapHelper::lookup_chain_heads<CppType>(table_items, build_keys, nullptr, probe_state, row_count);
 }
 
 template <LogicalType LT>
@@ -369,13 +426,8 @@ void FixedSizeJoinProbeFunc<LT>::_probe_nullable_column(const JoinHashTableItems
     const auto& data = get_key_data(*probe_state);
     JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items.bucket_size, &probe_state->buckets, 0, row_count);
 
-    for (uint32_t i = 0; i < row_count; i++) {
-        if (probe_state->is_nulls[i] == 0) {
-            probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-        } else {
-            probe_state->next[i] = 0;
-        }
-    }
+    const CppType* build_keys = FixedSizeJoinBuildFunc<LT>::get_key_data(table_items).data();
+    JoinHashMapHelper::lookup_chain_heads<CppType>(table_items, build_keys, probe_state->is_nulls.data(), probe_state, row_count);
 }
 
 template <LogicalType LT, class BuildFunc, class ProbeFunc>
@@ -405,6 +457,39 @@ void JoinHashMap<LT, BuildFunc, ProbeFunc>::probe_prepare(RuntimeState* state) {
 template <LogicalType LT, class BuildFunc, class ProbeFunc>
 void JoinHashMap<LT, BuildFunc, ProbeFunc>::build(RuntimeState* state) {
     BuildFunc().construct_hash_table(state, _table_items, _probe_state);
+    if (_table_items->key_only) {
+        _remove_duplicated_build_keys();
+    }
+}
+
+template <LogicalType LT, class BuildFunc, class ProbeFunc>
+void JoinHashMap<LT, BuildFunc, ProbeFunc>::_remove_duplicated_build_keys() {
+    const auto& build_data = BuildFunc().get_key_data(*_table_items);
+    const auto& first = _table_items->first;
+    auto& next = _table_items->next;
+    for (uint32_t bucket = 0; bucket < _table_items->bucket_size; bucket++) {
+        uint32_t prev = first[bucket];
+        if (prev == 0) {
+            continue;
+        }
+        uint32_t index = next[prev];
+        while (index != 0) {
+            // The rows before |index| in the chain have distinct keys
+            bool duplicated = false;
+            for (uint32_t i = first[bucket]; i != index; i = next[i]) {
+                if (ProbeFunc().equal(build_data[i], build_data[index])) {
+                    duplicated = true;
+                    break;
+                }
+            }
+            if (duplicated) {
+                next[prev] = next[index];
+            } else {
+                prev = index;
+            }
+            index = next[index];
+        }
+    }
 }
 
 template <LogicalType LT, class BuildFunc, class ProbeFunc>
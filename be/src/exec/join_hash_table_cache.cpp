@@ -0,0 +1,54 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "exec/join_hash_table_cache.h"
+
+#include <algorithm>
+
+#include "exec/join_hash_map.h"
+#include "util/defer_op.h"
+
+namespace starrocks {
+
+using CachedBuildData = std::shared_ptr<const JoinHashTableItems>;
+
+JoinHashTableCache::JoinHashTableCache(size_t capacity) : _capacity(capacity), _cache(capacity) {}
+
+static void delete_cache_entry(const CacheKey& key, void* value) {
+    delete reinterpret_cast<CachedBuildData*>(value);
+}
+
+void JoinHashTableCache::populate(const std::string& digest, CachedBuildData build_data, size_t mem_usage) {
+    if (!is_cacheable(mem_usage)) {
+        return;
+    }
+    auto* value = new CachedBuildData(std::move(build_data));
+    // zero-charge cache entry can not be purged in LRU cache.
+    auto* handle = _cache.insert(digest, value, std::max<size_t>(mem_usage, 1), &delete_cache_entry);
+    if (handle != nullptr) {
+        _cache.release(handle);
+    }
+}
+
+CachedBuildData JoinHashTableCache::lookup(const std::string& digest) {
+    auto* handle = _cache.lookup(digest);
+    if (handle == nullptr) {
+        return nullptr;
+    }
+    DeferOp defer([this, handle]() { _cache.release(handle); });
+    return *reinterpret_cast<CachedBuildData*>(_cache.value(handle));
+}
+
+} // namespace starrocks
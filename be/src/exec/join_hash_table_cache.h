@@ -0,0 +1,56 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "util/lru_cache.h"
+
+namespace starrocks {
+
+struct JoinHashTableItems;
+
+// JoinHashTableCache caches the build data of the hash tables built by the hash joins across queries, by the
+// digests of their build sides computed by FE, which cover the plans of the build sides, the build join keys,
+// and the versions of the scanned tablets. A later hash join of the same digest shares the cached build data
+// read-only instead of building the hash table again.
+//
+// The hash joins building the same digest at the same time don't wait for each other, every one of them builds
+// its own hash table, and the last populated one is kept.
+class JoinHashTableCache {
+public:
+    explicit JoinHashTableCache(size_t capacity);
+    ~JoinHashTableCache() = default;
+
+    // Only the build data not larger than a shard of the cache is populated, otherwise it evicts the whole shard.
+    bool is_cacheable(size_t mem_usage) const { return mem_usage <= _capacity / kNumShards; }
+
+    void populate(const std::string& digest, std::shared_ptr<const JoinHashTableItems> build_data, size_t mem_usage);
+    // Return nullptr if missed.
+    std::shared_ptr<const JoinHashTableItems> lookup(const std::string& digest);
+
+    size_t memory_usage() { return _cache.get_memory_usage(); }
+    size_t capacity() { return _cache.get_capacity(); }
+    size_t lookup_count() { return _cache.get_lookup_count(); }
+    size_t hit_count() { return _cache.get_hit_count(); }
+
+private:
+    const size_t _capacity;
+    ShardedLRUCache _cache;
+};
+
+} // namespace starrocks
@@ -512,10 +512,13 @@ Status JsonReader::_read_rows(Chunk* chunk, int32_t rows_to_read, int32_t* rows_
 }
 
 Status JsonReader::_construct_row_without_jsonpath(simdjson::ondemand::object* row, Chunk* chunk) {
-    _parsed_columns.assign(chunk->num_columns(), false);
+    // Whether the keys of this json object are the same as the previous one, then the columns without data are the
+    // same too. It's reset if this object fails to be constructed.
+    bool same_keys = _missing_columns_valid;
+    _missing_columns_valid = false;
+    uint32_t key_index = 0;
 
     try {
-        uint32_t key_index = 0;
         for (auto field : *row) {
             int column_index;
             std::string_view key = field.unescaped_key();
@@ -547,6 +550,7 @@ Status JsonReader::_construct_row_without_jsonpath(simdjson::ondemand::object* r
                     continue;
                 }
             } else {
+                same_keys = false;
                 // look up key in the slot dict.
                 auto itr = _slot_desc_dict.find(key);
                 if (itr == _slot_desc_dict.end()) {
@@ -571,17 +575,18 @@ Status JsonReader::_construct_row_without_jsonpath(simdjson::ondemand::object* r
                     _prev_parsed_position[key_index].key = key;
                     _prev_parsed_position[key_index].column_index = column_index;
                     _prev_parsed_position[key_index].type = slot_desc->type();
+                    _prev_parsed_position[key_index].appender =
+                            get_adaptive_nullable_column_appender(slot_desc->type());
                 }
             }
 
             DCHECK(column_index >= 0);
-            _parsed_columns[column_index] = true;
             auto& column = chunk->get_column_by_index(column_index);
             simdjson::ondemand::value val = field.value();
 
             // construct column with value.
-            RETURN_IF_ERROR(_construct_column(val, column.get(), _prev_parsed_position[key_index].type,
-                                              _prev_parsed_position[key_index].key));
+            const auto& item = _prev_parsed_position[key_index];
+            RETURN_IF_ERROR(item.appender(column.get(), item.type, item.key, &val, !_strict_mode));
 
             key_index++;
         }
@@ -591,20 +596,35 @@ Status JsonReader::_construct_row_without_jsonpath(simdjson::ondemand::object* r
         return Status::DataQualityError(err_msg);
     }
 
+    if (!same_keys || key_index != _prev_num_keys) {
+        _parsed_columns.assign(chunk->num_columns(), false);
+        for (uint32_t i = 0; i < key_index; i++) {
+            if (_prev_parsed_position[i].column_index >= 0) {
+                _parsed_columns[_prev_parsed_position[i].column_index] = true;
+            }
+        }
+        _missing_columns.clear();
+        for (int i = 0; i < chunk->num_columns(); i++) {
+            if (!_parsed_columns[i]) {
+                _missing_columns.push_back(i);
+            }
+        }
+        _prev_num_keys = key_index;
+    }
+    _missing_columns_valid = true;
+
     // append null to the column without data.
-    for (int i = 0; i < chunk->num_columns(); i++) {
-        if (!_parsed_columns[i]) {
-            auto& column = chunk->get_column_by_index(i);
-            if (UNLIKELY(i == _op_col_index)) {
-                // special treatment for __op column, fill default value '0' rather than null
-                if (column->is_binary()) {
-                    std::ignore = column->append_strings(std::vector{Slice{"0"}});
-                } else {
-                    column->append_datum(Datum((uint8_t)0));
-                }
+    for (int i : _missing_columns) {
+        auto& column = chunk->get_column_by_index(i);
+        if (UNLIKELY(i == _op_col_index)) {
+            // special treatment for __op column, fill default value '0' rather than null
+            if (column->is_binary()) {
+                std::ignore = column->append_strings(std::vector{Slice{"0"}});
             } else {
-                column->append_nulls(1);
+                column->append_datum(Datum((uint8_t)0));
             }
+        } else {
+            column->append_nulls(1);
         }
     }
     return Status::OK();
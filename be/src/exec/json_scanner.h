@@ -20,6 +20,7 @@
 #include "common/compiler_util.h"
 #include "exec/file_scanner.h"
 #include "exprs/json_functions.h"
+#include "formats/json/nullable_column.h"
 #include "fs/fs.h"
 #include "runtime/stream_load/load_stream_mgr.h"
 #include "simdjson.h"
@@ -95,11 +96,15 @@ public:
     struct PreviousParsedItem {
         PreviousParsedItem(const std::string_view& key) : key(key), column_index(-1) {}
         PreviousParsedItem(const std::string_view& key, int column_index, const TypeDescriptor& type)
-                : key(key), type(type), column_index(column_index) {}
+                : key(key),
+                  type(type),
+                  column_index(column_index),
+                  appender(get_adaptive_nullable_column_appender(type)) {}
 
         std::string key;
         TypeDescriptor type;
         int column_index;
+        JsonValueAppender appender = nullptr;
     };
 
 private:
@@ -142,6 +147,11 @@ private:
     std::vector<PreviousParsedItem> _prev_parsed_position;
     // record the parsed column index for current json object
     std::vector<uint8_t> _parsed_columns;
+    // The columns without data of the previous parsed json object, they are the same for the current json object
+    // if all the keys of the current one hit _prev_parsed_position.
+    std::vector<int> _missing_columns;
+    uint32_t _prev_num_keys = 0;
+    bool _missing_columns_valid = false;
     // record the "__op" column's index
     int _op_col_index;
 
@@ -94,6 +94,8 @@ public:
         return starrocks::ScanNode::io_tasks_per_scan_operator();
     }
 
+    bool support_morsel_stealing() const override { return true; }
+
     const std::vector<ExprContext*>& bucket_exprs() const { return _bucket_exprs; }
 
 private:
@@ -46,6 +46,17 @@ static Expr* get_root_expr(ExprContext* ctx) {
     return ctx->root();
 }
 
+// Whether |expr| compares a subfield of a struct slot with a constant, e.g. `s.a = 1`, which can be
+// evaluated by the storage layer with the zone map and bloom filter of the subfield.
+static bool is_subfield_cmp_predicate(const Expr* expr) {
+    if (expr->node_type() != TExprNodeType::BINARY_PRED || expr->get_num_children() != 2) {
+        return false;
+    }
+    const Expr* l = expr->get_child(0);
+    return l->node_type() == TExprNodeType::SUBFIELD_EXPR && l->get_num_children() == 1 &&
+           l->get_child(0)->is_slotref() && expr->get_child(1)->is_constant();
+}
+
 template <typename ValueType>
 static bool check_decimal_overflow(int precision, const ValueType& value) {
     if constexpr (is_decimal<ValueType>) {
@@ -750,7 +761,9 @@ void OlapScanConjunctsManager::build_column_expr_predicates() {
         // otherwise we don't need this limitation.
         const SlotDescriptor* slot_desc = slots[index];
         LogicalType ltype = slot_desc->type().type;
-        if (!is_scalar_logical_type(ltype)) continue;
+        bool is_subfield_pred = ltype == TYPE_STRUCT && config::enable_struct_subfield_predicate_pushdown &&
+                                is_subfield_cmp_predicate(ctx->root());
+        if (!is_scalar_logical_type(ltype) && !is_subfield_pred) continue;
         // disable on float/double type because min/max value may lose precision
         // The fix should be on storage layer, and this is just a temporary fix.
         if (ltype == LogicalType::TYPE_FLOAT || ltype == LogicalType::TYPE_DOUBLE) continue;
@@ -14,6 +14,7 @@
 
 #include "exec/orc_scanner.h"
 
+#include <limits>
 #include <memory>
 
 #include "column/array_column.h"
@@ -200,6 +201,12 @@ Status ORCScanner::_open_next_orc_reader() {
         _next_range++;
         _orc_reader->set_read_chunk_size(_max_chunk_size);
         _orc_reader->set_current_file_name(file_name);
+        // a range split from the file only reads the stripes starting in it
+        if (range_desc.size > 0 && (range_desc.start_offset > 0 || range_desc.size < file_size)) {
+            _orc_reader->set_read_range(range_desc.start_offset, range_desc.size);
+        } else {
+            _orc_reader->set_read_range(0, std::numeric_limits<uint64_t>::max());
+        }
         st = _orc_reader->init(std::move(inStream));
         if (st.is_end_of_file()) {
             LOG(WARNING) << "Failed to init orc reader. filename: " << file_name << ", status: " << st.to_string();
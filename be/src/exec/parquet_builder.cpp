@@ -17,16 +17,21 @@
 #include <arrow/buffer.h>
 #include <arrow/io/file.h>
 #include <arrow/io/interfaces.h>
+#include <fmt/format.h>
 #include <parquet/arrow/writer.h>
 #include <parquet/exception.h>
 
 #include "column/chunk.h"
 #include "column/column_helper.h"
+#include "common/config.h"
 #include "common/logging.h"
 #include "exprs/column_ref.h"
 #include "exprs/expr.h"
+#include "runtime/current_thread.h"
 #include "runtime/exec_env.h"
+#include "util/countdown_latch.h"
 #include "util/priority_thread_pool.hpp"
+#include "util/threadpool.h"
 
 namespace starrocks {
 
@@ -100,7 +105,7 @@ Status ParquetBuilder::_init(const ParquetBuilderOptions& options, const std::ve
     }
 
     _output_stream = std::make_shared<ParquetOutputStream>(std::move(_writable_file));
-    _buffered_values_estimate.reserve(_schema->field_count());
+    _buffered_values_estimate.resize(_schema->field_count(), 0);
     _file_writer = ::parquet::ParquetFileWriter::Open(_output_stream, _schema, _properties);
     return Status::OK();
 }
@@ -224,7 +229,6 @@ void ParquetBuilder::_generate_rg_writer() {
 }
 
 #define DISPATCH_PARQUET_NUMERIC_WRITER(WRITER, COLUMN_TYPE, NATIVE_TYPE)                                         \
-    ParquetBuilder::_generate_rg_writer();                                                                        \
     parquet::WRITER* col_writer = static_cast<parquet::WRITER*>(_rg_writer->column(i));                           \
     col_writer->WriteBatch(                                                                                       \
             num_rows, nullable ? def_level.data() : nullptr, nullptr,                                             \
@@ -236,24 +240,67 @@ Status ParquetBuilder::add_chunk(Chunk* chunk) {
         return Status::OK();
     }
 
-    size_t num_rows = chunk->num_rows();
-    for (size_t i = 0; i < chunk->num_columns(); i++) {
-        const auto& col = chunk->get_column_by_index(i);
-        bool nullable = col->is_nullable();
-        auto null_column = nullable && down_cast<NullableColumn*>(col.get())->has_null()
-                                   ? down_cast<NullableColumn*>(col.get())->null_column()
-                                   : nullptr;
-        const auto data_column = ColumnHelper::get_data_column(col.get());
-
-        std::vector<int16_t> def_level(num_rows, 1);
-        if (null_column != nullptr) {
-            auto nulls = null_column->get_data();
-            for (size_t j = 0; j < num_rows; j++) {
-                def_level[j] = nulls[j] == 0;
-            }
+    _generate_rg_writer();
+    const size_t num_columns = chunk->num_columns();
+    ThreadPool* pool = nullptr;
+    if (config::enable_parquet_parallel_column_encode && num_columns >= 2) {
+        pool = ExecEnv::GetInstance()->parquet_column_encode_pool();
+    }
+    if (pool == nullptr) {
+        for (size_t i = 0; i < num_columns; i++) {
+            RETURN_IF_ERROR(_write_column(chunk, i));
         }
+        _check_size();
+        return Status::OK();
+    }
 
-        const auto type = _output_expr_ctxs[i]->root()->type().type;
+    // The column chunks of a buffered row group are encoded and compressed into their own buffers, which are
+    // written into the file in column order when the row group is flushed, so the columns can be written
+    // concurrently, and the file is the same as the one written serially.
+    std::vector<Status> results(num_columns);
+    CountDownLatch latch(num_columns - 1);
+    MemTracker* mem_tracker = CurrentThread::mem_tracker();
+    for (size_t i = 1; i < num_columns; i++) {
+        auto st = pool->submit_func([&, i]() {
+            SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(mem_tracker);
+            results[i] = _write_column(chunk, i);
+            latch.count_down();
+        });
+        if (!st.ok()) {
+            // The pool is full or shutting down, encode the column in the current thread.
+            results[i] = _write_column(chunk, i);
+            latch.count_down();
+        }
+    }
+    results[0] = _write_column(chunk, 0);
+    latch.wait();
+    for (const auto& st : results) {
+        RETURN_IF_ERROR(st);
+    }
+    _check_size();
+    return Status::OK();
+}
+
+Status ParquetBuilder::_write_column(Chunk* chunk, size_t i) {
+    const size_t num_rows = chunk->num_rows();
+    const auto& col = chunk->get_column_by_index(i);
+    bool nullable = col->is_nullable();
+    auto null_column = nullable && down_cast<NullableColumn*>(col.get())->has_null()
+                               ? down_cast<NullableColumn*>(col.get())->null_column()
+                               : nullptr;
+    const auto data_column = ColumnHelper::get_data_column(col.get());
+
+    std::vector<int16_t> def_level(num_rows, 1);
+    if (null_column != nullptr) {
+        const auto& nulls = null_column->get_data();
+        for (size_t j = 0; j < num_rows; j++) {
+            def_level[j] = nulls[j] == 0;
+        }
+    }
+
+    const auto type = _output_expr_ctxs[i]->root()->type().type;
+    // the exceptions can't be thrown out of the threads of the encode pool
+    try {
         switch (type) {
         case TYPE_BOOLEAN: {
             DISPATCH_PARQUET_NUMERIC_WRITER(BoolWriter, BooleanColumn, bool)
@@ -279,9 +326,9 @@ Status ParquetBuilder::add_chunk(Chunk* chunk) {
             return Status::InvalidArgument("Unsupported type");
         }
         }
+    } catch (const ::parquet::ParquetException& e) {
+        return Status::InternalError(fmt::format("Failed to write parquet column {}: {}", i, e.what()));
     }
-
-    _check_size();
     return Status::OK();
 }
 
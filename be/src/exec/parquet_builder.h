@@ -90,6 +90,8 @@ private:
     void _init_properties(const ParquetBuilderOptions& options);
     Status _init_schema(const std::vector<std::string>& file_column_names);
     void _generate_rg_writer();
+    // Write the |i|-th column of |chunk| into the current row group, it's thread safe for different columns.
+    Status _write_column(Chunk* chunk, size_t i);
     void _flush_row_group();
     size_t _get_rg_written_bytes();
     void _check_size();
@@ -17,9 +17,11 @@
 #include <utility>
 
 #include "column/chunk.h"
+#include "common/config.h"
 #include "common/statusor.h"
 #include "exec/pipeline/adaptive/adaptive_dop_param.h"
 #include "exec/pipeline/adaptive/utils.h"
+#include "gutil/casts.h"
 
 namespace starrocks::pipeline {
 
@@ -85,7 +87,8 @@ std::string PassthroughState::name() const {
 PassthroughState::PassthroughState(CollectStatsContext* const ctx)
         : CollectStatsState(ctx),
           _in_chunk_queue_per_driver_seq(ctx->_max_dop),
-          _unpluging_per_driver_seq(ctx->_max_dop) {}
+          _unpluging_per_driver_seq(ctx->_max_dop),
+          _enable_chunk_stealing(config::enable_pipeline_adaptive_dop_chunk_stealing) {}
 
 bool PassthroughState::need_input(int32_t driver_seq) const {
     return _in_chunk_queue_per_driver_seq[driver_seq].size_approx() < MAX_PASSTHROUGH_CHUNKS_PER_DRIVER_SEQ;
@@ -97,6 +100,10 @@ Status PassthroughState::push_chunk(int32_t driver_seq, ChunkPtr chunk) {
 }
 
 bool PassthroughState::has_output(int32_t driver_seq) const {
+    return _has_own_output(driver_seq) || _has_stealable_chunks(driver_seq);
+}
+
+bool PassthroughState::_has_own_output(int32_t driver_seq) const {
     const auto& buffer_chunk_queue = _ctx->_buffer_chunk_queue(driver_seq);
     if (!buffer_chunk_queue.empty()) {
         return true;
@@ -131,10 +138,47 @@ StatusOr<ChunkPtr> PassthroughState::pull_chunk(int32_t driver_seq) {
 
     auto& passthrough_chunk_queue = _in_chunk_queue_per_driver_seq[driver_seq];
     ChunkPtr chunk = nullptr;
-    passthrough_chunk_queue.try_dequeue(chunk);
+    if (!passthrough_chunk_queue.try_dequeue(chunk) && _enable_chunk_stealing) {
+        chunk = _steal_chunk(driver_seq);
+    }
     return chunk;
 }
 
+bool PassthroughState::_has_stealable_chunks(int32_t driver_seq) const {
+    if (!_enable_chunk_stealing) {
+        return false;
+    }
+
+    const int32_t dop = _ctx->_downstream_dop;
+    for (int32_t i = 1; i < dop; i++) {
+        const int32_t victim_seq = (driver_seq + i) % dop;
+        if (_in_chunk_queue_per_driver_seq[victim_seq].size_approx() >= UNPLUG_THRESHOLD_PER_DRIVER_SEQ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+ChunkPtr PassthroughState::_steal_chunk(int32_t driver_seq) {
+    // Only the concurrent in-chunk queues are stolen, since the buffer chunk queues of BlockState
+    // are only accessed by their own driver.
+    const int32_t dop = _ctx->_downstream_dop;
+    for (int32_t i = 1; i < dop; i++) {
+        const int32_t victim_seq = (driver_seq + i) % dop;
+        auto& victim_queue = _in_chunk_queue_per_driver_seq[victim_seq];
+        if (victim_queue.size_approx() < UNPLUG_THRESHOLD_PER_DRIVER_SEQ) {
+            continue;
+        }
+
+        ChunkPtr chunk = nullptr;
+        if (victim_queue.try_dequeue(chunk)) {
+            _num_stolen_chunks.fetch_add(1, std::memory_order_relaxed);
+            return chunk;
+        }
+    }
+    return nullptr;
+}
+
 Status PassthroughState::set_finishing(int32_t driver_seq) {
     return Status::OK();
 }
@@ -146,7 +190,9 @@ bool PassthroughState::is_downstream_finished(int32_t driver_seq) const {
 
     const auto& buffer_chunk_queue = _ctx->_buffer_chunk_queue(driver_seq);
     const auto& passthrough_chunk_queue = _in_chunk_queue_per_driver_seq[driver_seq];
-    return buffer_chunk_queue.empty() && passthrough_chunk_queue.size_approx() <= 0;
+    // Keep the finished driver alive to help the other backlogged drivers.
+    return buffer_chunk_queue.empty() && passthrough_chunk_queue.size_approx() <= 0 &&
+           !_has_stealable_chunks(driver_seq);
 }
 bool PassthroughState::is_upstream_finished(int32_t driver_seq) const {
     return _ctx->_is_finished_per_driver_seq[driver_seq];
@@ -271,6 +317,10 @@ bool CollectStatsContext::is_upstream_finished(int32_t driver_seq) const {
     return _state_ref()->is_upstream_finished(driver_seq);
 }
 
+int64_t CollectStatsContext::num_stolen_chunks() const {
+    return down_cast<const PassthroughState*>(_get_state(CollectStatsStateEnum::PASSTHROUGH))->num_stolen_chunks();
+}
+
 bool CollectStatsContext::is_downstream_ready() const {
     return _state_ref() != _get_state(CollectStatsStateEnum::BLOCK);
 }
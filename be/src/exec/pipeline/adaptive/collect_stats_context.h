@@ -47,6 +47,8 @@ enum class CollectStatsStateEnum { BLOCK = 0, PASSTHROUGH, ROUND_ROBIN };
 ///   when BlockState receives max_block_rows_per_driver_seq*DOP rows and SourceOp hasn't been not EOS.
 ///   - It doesn't adjust DOP of pipeline#2,
 ///   - and passes chunks from the i-th pipeline#1 driver to the i-th pipeline#2 driver.
+///   - If enable_pipeline_adaptive_dop_chunk_stealing is true, the idle pipeline#2 driver steals chunks from
+///     the backlogged queues of the other drivers, so that the skewed input is re-balanced at runtime.
 /// - RoundRobinState is transformed to,
 ///   when SourceOp has been EOS before BlockState receives max_block_rows_per_driver_seq*DOP rows.
 ///   - It adjust DOP of pipeline#2 to compute_max_le_power2(num_rows/max_block_rows_per_driver_seq),
@@ -77,6 +79,7 @@ public:
     void incr_sinker() { ++_upstream_dop; }
 
     const int64_t max_output_amplification_factor() const { return _max_output_amplification_factor; }
+    int64_t num_stolen_chunks() const;
 
 private:
     using BufferChunkQueue = std::queue<ChunkPtr>;
@@ -170,13 +173,23 @@ public:
     StatusOr<ChunkPtr> pull_chunk(int32_t driver_seq) override;
     Status set_finishing(int32_t driver_seq) override;
 
+    int64_t num_stolen_chunks() const { return _num_stolen_chunks; }
+
 private:
+    bool _has_own_output(int32_t driver_seq) const;
+    // Whether the queue of any other driver is backlogged, that is, its consumer cannot keep up with its producer.
+    bool _has_stealable_chunks(int32_t driver_seq) const;
+    ChunkPtr _steal_chunk(int32_t driver_seq);
+
     static constexpr size_t MAX_PASSTHROUGH_CHUNKS_PER_DRIVER_SEQ = 32;
     static constexpr size_t UNPLUG_THRESHOLD_PER_DRIVER_SEQ = MAX_PASSTHROUGH_CHUNKS_PER_DRIVER_SEQ / 2;
 
     using ChunkQueue = moodycamel::ConcurrentQueue<ChunkPtr>;
     std::vector<ChunkQueue> _in_chunk_queue_per_driver_seq;
     mutable std::vector<uint8_t> _unpluging_per_driver_seq;
+
+    const bool _enable_chunk_stealing;
+    std::atomic<int64_t> _num_stolen_chunks = 0;
 };
 
 class RoundRobinState final : public CollectStatsState {
@@ -29,6 +29,9 @@ void CollectStatsSourceOperator::close(RuntimeState* state) {
     Operator::close(state);
 
     _unique_metrics->add_info_string("State", _ctx->readable_state());
+    if (const int64_t num_stolen_chunks = _ctx->num_stolen_chunks(); num_stolen_chunks > 0) {
+        _unique_metrics->add_info_string("NumStolenChunks", std::to_string(num_stolen_chunks));
+    }
 }
 
 bool CollectStatsSourceOperator::need_input() const {
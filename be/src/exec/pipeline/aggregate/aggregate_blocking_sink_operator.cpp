@@ -16,6 +16,7 @@
 
 #include <variant>
 
+#include "exec/pipeline/query_context.h"
 #include "runtime/current_thread.h"
 
 namespace starrocks::pipeline {
@@ -23,6 +24,7 @@ namespace starrocks::pipeline {
 Status AggregateBlockingSinkOperator::prepare(RuntimeState* state) {
     RETURN_IF_ERROR(Operator::prepare(state));
     RETURN_IF_ERROR(_aggregator->prepare(state, state->obj_pool(), _unique_metrics.get()));
+    RETURN_IF_ERROR(_aggregator->prepare_spill(state, _unique_metrics.get(), _plan_node_id));
     return _aggregator->open(state);
 }
 
@@ -35,6 +37,16 @@ void AggregateBlockingSinkOperator::close(RuntimeState* state) {
 
 Status AggregateBlockingSinkOperator::set_finishing(RuntimeState* state) {
     _is_finished = true;
+    RETURN_IF_ERROR(_aggregator->finish_spill());
+
+    if (_aggregator->partitioned_merger() != nullptr) {
+        // The source merges the partition of all the sinks into the hash table later
+        COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_map_variant().size());
+        RETURN_IF_ERROR(_aggregator->finish_partitioned_sink(_driver_sequence));
+        COUNTER_UPDATE(_aggregator->input_row_count(), _aggregator->num_input_rows());
+        _aggregator->sink_complete();
+        return Status::OK();
+    }
 
     if (!_aggregator->is_none_group_by_exprs()) {
         COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_map_variant().size());
@@ -106,6 +118,26 @@ Status AggregateBlockingSinkOperator::push_chunk(RuntimeState* state, const Chun
     _aggregator->update_num_input_rows(chunk_size);
     RETURN_IF_ERROR(_aggregator->check_has_error());
 
+    return _spill_if_needed(state);
+}
+
+Status AggregateBlockingSinkOperator::_spill_if_needed(RuntimeState* state) {
+    if (!_aggregator->is_spillable()) {
+        return Status::OK();
+    }
+    bool force_spill = state->spill_mode() == TSpillMode::FORCE &&
+                       _aggregator->revocable_mem_bytes() > state->spill_mem_table_size();
+    if (need_mark_spill() || force_spill) {
+        RETURN_IF_ERROR(_aggregator->spill_hash_table());
+        if (need_mark_spill()) {
+            // The memory has been released, let the driver decide whether to spill again by the memory of the query.
+            state->query_ctx()->spill_manager()->release_spilled_bytes(_marked_spill_bytes);
+            _marked_spill_bytes = 0;
+            _marked_need_spill = false;
+        }
+    }
+    set_revocable_mem_bytes(_aggregator->revocable_mem_bytes());
     return Status::OK();
 }
+
 } // namespace starrocks::pipeline
@@ -43,7 +43,19 @@ public:
     Status push_chunk(RuntimeState* state, const ChunkPtr& chunk) override;
     Status reset_state(RuntimeState* state, const std::vector<ChunkPtr>& refill_chunks) override;
 
+    void mark_need_spill() override {
+        Operator::mark_need_spill();
+        _marked_spill_bytes = revocable_mem_bytes();
+    }
+
+    // the restored partitions are aggregated again.
+    double spill_cost() const override { return 2.0; }
+
 private:
+    // Spill the hash table if the operator is marked to spill, or the hash table is larger than the mem table
+    // in the FORCE spill mode.
+    Status _spill_if_needed(RuntimeState* state);
+
     // It is used to perform aggregation algorithms shared by
     // AggregateBlockingSourceOperator. It is
     // - prepared at SinkOperator::prepare(),
@@ -52,6 +64,8 @@ private:
     AggregatorPtr _aggregator = nullptr;
     // Whether prev operator has no output
     bool _is_finished = false;
+    // The bytes added to the pending spilled bytes of QuerySpillManager when marked to spill.
+    size_t _marked_spill_bytes = 0;
 };
 
 class AggregateBlockingSinkOperatorFactory final : public OperatorFactory {
@@ -21,11 +21,18 @@
 namespace starrocks::pipeline {
 
 bool AggregateBlockingSourceOperator::has_output() const {
-    return _aggregator->is_sink_complete() && !_aggregator->is_ht_eos();
+    if (!_aggregator->is_sink_complete()) {
+        return false;
+    }
+    if (_aggregator->partitioned_merger() != nullptr && !_partition_merged) {
+        return _aggregator->partitioned_merger()->all_sinks_finished();
+    }
+    return !_aggregator->is_ht_eos();
 }
 
 bool AggregateBlockingSourceOperator::is_finished() const {
-    return _aggregator->is_sink_complete() && _aggregator->is_ht_eos();
+    bool merged = _aggregator->partitioned_merger() == nullptr || _partition_merged;
+    return _aggregator->is_sink_complete() && merged && _aggregator->is_ht_eos();
 }
 
 Status AggregateBlockingSourceOperator::set_finished(RuntimeState* state) {
@@ -40,6 +47,11 @@ void AggregateBlockingSourceOperator::close(RuntimeState* state) {
 StatusOr<ChunkPtr> AggregateBlockingSourceOperator::pull_chunk(RuntimeState* state) {
     RETURN_IF_CANCELLED(state);
 
+    if (_aggregator->partitioned_merger() != nullptr && !_partition_merged) {
+        RETURN_IF_ERROR(_aggregator->merge_partition(_driver_sequence));
+        _partition_merged = true;
+    }
+
     const auto chunk_size = state->chunk_size();
     ChunkPtr chunk = std::make_shared<Chunk>();
 
@@ -49,6 +61,11 @@ StatusOr<ChunkPtr> AggregateBlockingSourceOperator::pull_chunk(RuntimeState* sta
         RETURN_IF_ERROR(_aggregator->convert_hash_map_to_chunk(chunk_size, &chunk));
     }
 
+    // the hash table of the current spilled partition has been output
+    if (_aggregator->is_ht_eos() && _aggregator->has_pending_spilled_partition()) {
+        RETURN_IF_ERROR(_aggregator->restore_next_spilled_partition());
+    }
+
     const int64_t old_size = chunk->num_rows();
     eval_runtime_bloom_filters(chunk.get());
 
@@ -47,6 +47,8 @@ private:
     // - reffed at constructor() of both sink and source operator,
     // - unreffed at close() of both sink and source operator.
     AggregatorPtr _aggregator = nullptr;
+    // Whether the partition of this driver has been merged into the hash table, see AggregatePartitionedMerger.
+    bool _partition_merged = false;
 };
 
 class AggregateBlockingSourceOperatorFactory final : public SourceOperatorFactory {
@@ -14,6 +14,7 @@
 
 #include "aggregate_distinct_blocking_sink_operator.h"
 
+#include "exec/pipeline/query_context.h"
 #include "runtime/current_thread.h"
 
 namespace starrocks::pipeline {
@@ -21,6 +22,7 @@ namespace starrocks::pipeline {
 Status AggregateDistinctBlockingSinkOperator::prepare(RuntimeState* state) {
     RETURN_IF_ERROR(Operator::prepare(state));
     RETURN_IF_ERROR(_aggregator->prepare(state, state->obj_pool(), _unique_metrics.get()));
+    RETURN_IF_ERROR(_aggregator->prepare_spill(state, _unique_metrics.get(), _plan_node_id));
     return _aggregator->open(state);
 }
 
@@ -33,6 +35,7 @@ void AggregateDistinctBlockingSinkOperator::close(RuntimeState* state) {
 
 Status AggregateDistinctBlockingSinkOperator::set_finishing(RuntimeState* state) {
     _is_finished = true;
+    RETURN_IF_ERROR(_aggregator->finish_spill());
 
     COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_set_variant().size());
 
@@ -73,11 +76,31 @@ Status AggregateDistinctBlockingSinkOperator::push_chunk(RuntimeState* state, co
         }
     }
 
-    return Status::OK();
+    return _spill_if_needed(state);
 }
 Status AggregateDistinctBlockingSinkOperator::reset_state(RuntimeState* state,
                                                           const std::vector<ChunkPtr>& refill_chunks) {
     _is_finished = false;
     return _aggregator->reset_state(state, refill_chunks, this);
 }
+
+Status AggregateDistinctBlockingSinkOperator::_spill_if_needed(RuntimeState* state) {
+    if (!_aggregator->is_spillable()) {
+        return Status::OK();
+    }
+    bool force_spill = state->spill_mode() == TSpillMode::FORCE &&
+                       _aggregator->revocable_mem_bytes() > state->spill_mem_table_size();
+    if (need_mark_spill() || force_spill) {
+        RETURN_IF_ERROR(_aggregator->spill_hash_table());
+        if (need_mark_spill()) {
+            // The memory has been released, let the driver decide whether to spill again by the memory of the query.
+            state->query_ctx()->spill_manager()->release_spilled_bytes(_marked_spill_bytes);
+            _marked_spill_bytes = 0;
+            _marked_need_spill = false;
+        }
+    }
+    set_revocable_mem_bytes(_aggregator->revocable_mem_bytes());
+    return Status::OK();
+}
+
 } // namespace starrocks::pipeline
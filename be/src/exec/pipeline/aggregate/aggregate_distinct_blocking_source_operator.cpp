@@ -42,6 +42,11 @@ StatusOr<ChunkPtr> AggregateDistinctBlockingSourceOperator::pull_chunk(RuntimeSt
     ChunkPtr chunk = std::make_shared<Chunk>();
     _aggregator->convert_hash_set_to_chunk(chunk_size, &chunk);
 
+    // the hash table of the current spilled partition has been output
+    if (_aggregator->is_ht_eos() && _aggregator->has_pending_spilled_partition()) {
+        RETURN_IF_ERROR(_aggregator->restore_next_spilled_partition());
+    }
+
     const int64_t old_size = chunk->num_rows();
     eval_runtime_bloom_filters(chunk.get());
 
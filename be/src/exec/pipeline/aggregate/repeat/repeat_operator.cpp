@@ -17,6 +17,7 @@
 #include "column/chunk.h"
 #include "exec/exec_node.h"
 #include "runtime/descriptors.h"
+#include "simd/simd.h"
 
 namespace starrocks::pipeline {
 
@@ -40,10 +41,29 @@ bool RepeatOperator::has_output() const {
 }
 
 StatusOr<ChunkPtr> RepeatOperator::pull_chunk(RuntimeState* state) {
-    ChunkPtr curr_chunk = _curr_chunk->clone_empty(_curr_chunk->num_rows());
-    curr_chunk->append_safe(*_curr_chunk, 0, _curr_chunk->num_rows());
+    // The columns are shared by all the repeated chunks instead of copied, only the unneeded columns are replaced by
+    // the const null columns.
+    ChunkPtr curr_chunk = std::make_shared<Chunk>(_curr_chunk->columns(), _curr_chunk->get_slot_id_to_index_map());
     extend_and_update_columns(&curr_chunk);
-    RETURN_IF_ERROR(eval_conjuncts_and_in_filters(_conjunct_ctxs, curr_chunk.get()));
+
+    // The shared columns mustn't be filtered in place, so copy the selected rows if any row is filtered out.
+    FilterPtr filter;
+    RETURN_IF_ERROR(eval_conjuncts_and_in_filters(_conjunct_ctxs, curr_chunk.get(), &filter, false));
+    if (filter != nullptr) {
+        const size_t num_selected = SIMD::count_nonzero(*filter);
+        if (num_selected < curr_chunk->num_rows()) {
+            _selection.clear();
+            _selection.reserve(num_selected);
+            for (uint32_t i = 0; i < filter->size(); ++i) {
+                if ((*filter)[i]) {
+                    _selection.push_back(i);
+                }
+            }
+            ChunkPtr filtered_chunk = curr_chunk->clone_empty(num_selected);
+            filtered_chunk->append_selective(*curr_chunk, _selection.data(), 0, num_selected);
+            curr_chunk = std::move(filtered_chunk);
+        }
+    }
     return curr_chunk;
 }
 
@@ -72,6 +72,8 @@ private:
      */
     // accessing chunk.
     ChunkPtr _curr_chunk;
+    // the rows selected by the conjuncts.
+    std::vector<uint32_t> _selection;
 
     /*
      * _null_slot_ids
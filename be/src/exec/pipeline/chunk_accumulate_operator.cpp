@@ -15,10 +15,20 @@
 #include "exec/pipeline/chunk_accumulate_operator.h"
 
 #include "column/chunk.h"
+#include "common/config.h"
 #include "runtime/runtime_state.h"
 
 namespace starrocks::pipeline {
 
+Status ChunkAccumulateOperator::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(Operator::prepare(state));
+    _acc.set_max_size(state->chunk_size());
+    if (config::pipeline_target_chunk_bytes > 0) {
+        _acc.set_max_bytes(config::pipeline_target_chunk_bytes);
+    }
+    return Status::OK();
+}
+
 Status ChunkAccumulateOperator::push_chunk(RuntimeState* state, const ChunkPtr& chunk) {
     _acc.push(chunk);
     return Status::OK();
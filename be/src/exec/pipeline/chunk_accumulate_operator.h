@@ -31,6 +31,8 @@ public:
 
     ~ChunkAccumulateOperator() override = default;
 
+    Status prepare(RuntimeState* state) override;
+
     Status push_chunk(RuntimeState* state, const ChunkPtr& chunk) override;
     StatusOr<ChunkPtr> pull_chunk(RuntimeState* state) override;
 
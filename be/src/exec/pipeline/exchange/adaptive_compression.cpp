@@ -0,0 +1,92 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "exec/pipeline/exchange/adaptive_compression.h"
+
+#include <algorithm>
+
+#include "common/config.h"
+#include "util/compression/block_compression.h"
+
+namespace starrocks::pipeline {
+
+Status AdaptiveCompression::init(CompressionTypePB type, bool adaptive, QueuePressure queue_pressure) {
+    _adaptive = adaptive;
+    _queue_pressure = std::move(queue_pressure);
+    if (!_adaptive) {
+        _num_levels = 1;
+        _types[0] = type;
+    } else {
+        _num_levels = kMaxLevels;
+        _types[0] = CompressionTypePB::NO_COMPRESSION;
+        _types[1] = CompressionTypePB::LZ4;
+        _types[2] = CompressionTypePB::ZSTD;
+        // start from the configured type, or LZ4 if it's not one of the levels
+        _level = 1;
+        for (int i = 0; i < _num_levels; i++) {
+            if (_types[i] == type) {
+                _level = i;
+            }
+        }
+    }
+    for (int i = 0; i < _num_levels; i++) {
+        RETURN_IF_ERROR(get_block_compression_codec(_types[i], &_codecs[i]));
+    }
+    return Status::OK();
+}
+
+bool AdaptiveCompression::update(size_t uncompressed_bytes, size_t sent_bytes) {
+    if (!_adaptive) {
+        return false;
+    }
+    _uncompressed_bytes += uncompressed_bytes;
+    _sent_bytes += sent_bytes;
+    if (++_chunks < config::exchange_adaptive_compression_interval_chunks) {
+        return false;
+    }
+    int old_level = _level;
+    _evaluate();
+    _chunks = 0;
+    _uncompressed_bytes = 0;
+    _sent_bytes = 0;
+    if (_level == old_level) {
+        return false;
+    }
+    _num_switches++;
+    return true;
+}
+
+void AdaptiveCompression::_evaluate() {
+    if (++_num_evaluations % kRatioExpireEvaluations == 0) {
+        std::fill(std::begin(_ratios), std::end(_ratios), 0);
+    }
+    double ratio = static_cast<double>(_uncompressed_bytes) / std::max<size_t>(_sent_bytes, 1);
+    _ratios[_level] = ratio;
+
+    if (_level > 0 && ratio < config::rpc_compress_ratio_threshold) {
+        _level--;
+        return;
+    }
+    double pressure = _queue_pressure();
+    if (pressure >= kHighPressure) {
+        if (_level + 1 < _num_levels && (_ratios[_level + 1] == 0 || _ratios[_level + 1] >= ratio * kMinRatioGain)) {
+            _level++;
+        }
+    } else if (pressure <= kLowPressure && _level > 0) {
+        _level--;
+    }
+}
+
+} // namespace starrocks::pipeline
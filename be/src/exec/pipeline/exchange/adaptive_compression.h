@@ -0,0 +1,86 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <functional>
+
+#include "common/status.h"
+#include "gen_cpp/types.pb.h"
+
+namespace starrocks {
+class BlockCompressionCodec;
+}
+
+namespace starrocks::pipeline {
+
+// AdaptiveCompression picks the compression type of the chunks sent through one exchange destination.
+//
+// The types are ordered by the compression ratio and the CPU cost: NO_COMPRESSION < LZ4 < ZSTD. They are
+// re-evaluated every `exchange_adaptive_compression_interval_chunks` chunks by the feedback of the last interval:
+// 1. Step down if the data compressed by the current type is not compressible enough, which wastes CPU.
+// 2. Step up if the queue of the destination in SinkBuffer is congested, i.e. the network is the bottleneck,
+//    unless the stronger type is known not to compress better.
+// 3. Step down if the queue is almost empty, i.e. the network is idle, and the CPU is the bottleneck.
+class AdaptiveCompression {
+public:
+    // The queued requests of the destination normalized by `pipeline_sink_buffer_size`.
+    using QueuePressure = std::function<double()>;
+
+    static constexpr double kHighPressure = 0.5;
+    static constexpr double kLowPressure = 0.1;
+    // The stronger type has to compress better by this factor to be chosen again.
+    static constexpr double kMinRatioGain = 1.05;
+    // The remembered compression ratios are forgotten after this number of evaluations, since the data changes.
+    static constexpr int kRatioExpireEvaluations = 16;
+
+    // If |adaptive| is false, |type| is always used.
+    Status init(CompressionTypePB type, bool adaptive, QueuePressure queue_pressure);
+
+    CompressionTypePB type() const { return _types[_level]; }
+    // nullptr if the chunks should not be compressed.
+    const BlockCompressionCodec* codec() const { return _codecs[_level]; }
+
+    // Record one chunk serialized with type(), |sent_bytes| is the size of the data sent, which equals to
+    // |uncompressed_bytes| if it's not compressed.
+    // Return true if the type changed for the next chunks.
+    bool update(size_t uncompressed_bytes, size_t sent_bytes);
+
+    int64_t num_switches() const { return _num_switches; }
+
+private:
+    static constexpr int kMaxLevels = 3;
+
+    void _evaluate();
+
+    bool _adaptive = false;
+    QueuePressure _queue_pressure;
+    int _num_levels = 0;
+    int _level = 0;
+    CompressionTypePB _types[kMaxLevels] = {};
+    const BlockCompressionCodec* _codecs[kMaxLevels] = {};
+    // The compression ratio measured when the type was used last time, 0 means unknown.
+    double _ratios[kMaxLevels] = {};
+
+    // The stats of the current interval.
+    int64_t _chunks = 0;
+    size_t _uncompressed_bytes = 0;
+    size_t _sent_bytes = 0;
+
+    int64_t _num_evaluations = 0;
+    int64_t _num_switches = 0;
+};
+
+} // namespace starrocks::pipeline
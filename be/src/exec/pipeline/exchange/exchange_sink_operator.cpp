@@ -15,9 +15,13 @@
 #include "exec/pipeline/exchange/exchange_sink_operator.h"
 
 #include <arpa/inet.h>
+#include <fmt/format.h>
+#include <malloc.h>
 
+#include <algorithm>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <random>
 #include <utility>
@@ -26,6 +30,7 @@
 #include "exec/pipeline/exchange/shuffler.h"
 #include "exec/pipeline/exchange/sink_buffer.h"
 #include "exprs/expr.h"
+#include "exprs/expr_context.h"
 #include "runtime/data_stream_mgr.h"
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
@@ -35,6 +40,8 @@
 #include "service/brpc.h"
 #include "util/compression/block_compression.h"
 #include "util/compression/compression_utils.h"
+#include "util/defer_op.h"
+#include "util/time.h"
 
 namespace starrocks::pipeline {
 
@@ -88,6 +95,9 @@ public:
     // can run parallel.
     Status close(RuntimeState* state, FragmentContext* fragment_ctx);
 
+    // Send the batched request if its first chunk has been batched for at least |max_latency_ms|.
+    Status send_stale_request(RuntimeState* state, int64_t now_ms, int64_t max_latency_ms);
+
     std::string get_fragment_instance_id_str() {
         UniqueId uid(_fragment_instance_id);
         return uid.to_string();
@@ -102,6 +112,8 @@ public:
 private:
     Status _close_internal(RuntimeState* state, FragmentContext* fragment_ctx);
 
+    Status _send_request(RuntimeState* state, bool eos);
+
     bool _check_use_pass_through();
     void _prepare_pass_through();
 
@@ -119,14 +131,24 @@ private:
 
     bool _is_first_chunk = true;
     doris::PBackendService_Stub* _brpc_stub = nullptr;
+    AdaptiveCompression _compression;
 
     // If pipeline level shuffle is enable, the size of the _chunks
     // equals with dop of dest pipeline
     // If pipeline level shuffle is disable, the size of _chunks
     // always be 1
     std::vector<std::unique_ptr<Chunk>> _chunks;
+    // If true, the rows of all the drivers are batched in _chunks[0], and the driver of every row is
+    // kept in _row_driver_sequences, then the receiver splits the chunk into the drivers.
+    bool _split_by_receiver = false;
+    std::vector<uint16_t> _row_driver_sequences;
     PTransmitChunkParamsPtr _chunk_request;
+    // the serialized data of the chunks of _chunk_request
+    butil::IOBuf _attachment;
+    int64_t _attachment_physical_bytes = 0;
     size_t _current_request_bytes = 0;
+    // The time in ms when the first chunk of _chunk_request was batched, -1 if there is no chunk.
+    int64_t _request_start_ms = -1;
 
     bool _is_inited = false;
     bool _use_pass_through = false;
@@ -176,6 +198,12 @@ Status ExchangeSinkOperator::Channel::init(RuntimeState* state) {
     _brpc_stub = state->exec_env()->brpc_stub_cache()->get_stub(_brpc_dest_addr);
     _prepare_pass_through();
     _ignore_local_data = _enable_exchange_perf && is_local();
+    _split_by_receiver = config::enable_exchange_receiver_side_split && _parent->_is_pipeline_level_shuffle &&
+                         !_parent->_is_channel_bound_driver_sequence && !_use_pass_through && _chunks.size() > 1 &&
+                         _chunks.size() <= std::numeric_limits<uint16_t>::max();
+    RETURN_IF_ERROR(_compression.init(_parent->_compress_type, _parent->_adaptive_compression, [this]() {
+        return _parent->_buffer->queue_pressure(_fragment_instance_id);
+    }));
 
     _is_inited = true;
     return Status::OK();
@@ -183,17 +211,24 @@ Status ExchangeSinkOperator::Channel::init(RuntimeState* state) {
 
 Status ExchangeSinkOperator::Channel::add_rows_selective(Chunk* chunk, int32_t driver_sequence, const uint32_t* indexes,
                                                          uint32_t from, uint32_t size, RuntimeState* state) {
-    if (UNLIKELY(_chunks[driver_sequence] == nullptr)) {
-        _chunks[driver_sequence] = chunk->clone_empty_with_slot(size);
+    const int32_t index = _split_by_receiver ? 0 : driver_sequence;
+    auto& dst = _chunks[index];
+    if (UNLIKELY(dst == nullptr)) {
+        dst = chunk->clone_empty_with_slot(size);
     }
 
-    if (_chunks[driver_sequence]->num_rows() + size > state->chunk_size()) {
-        RETURN_IF_ERROR(send_one_chunk(state, _chunks[driver_sequence].get(), driver_sequence, false));
+    if (dst->num_rows() + size > state->chunk_size() ||
+        (config::pipeline_target_chunk_bytes > 0 && dst->num_rows() > 0 &&
+         dst->bytes_usage() >= config::pipeline_target_chunk_bytes)) {
+        RETURN_IF_ERROR(send_one_chunk(state, dst.get(), index, false));
         // we only clear column data, because we need to reuse column schema
-        _chunks[driver_sequence]->set_num_rows(0);
+        dst->set_num_rows(0);
     }
 
-    _chunks[driver_sequence]->append_selective(*chunk, indexes, from, size);
+    dst->append_selective(*chunk, indexes, from, size);
+    if (_split_by_receiver) {
+        _row_driver_sequences.insert(_row_driver_sequences.end(), size, driver_sequence);
+    }
     return Status::OK();
 }
 
@@ -232,36 +267,64 @@ Status ExchangeSinkOperator::Channel::send_one_chunk(RuntimeState* state, const
             _current_request_bytes += chunk_size;
             COUNTER_UPDATE(_parent->_bytes_pass_through_counter, chunk_size);
         } else {
-            if (_parent->_is_pipeline_level_shuffle) {
+            if (_split_by_receiver) {
+                DCHECK_EQ(chunk->num_rows(), _row_driver_sequences.size());
+                // -1 means the receiver splits the chunk by the driver sequences of the rows
+                _chunk_request->add_driver_sequences(-1);
+                _chunk_request->add_row_driver_sequences(reinterpret_cast<const char*>(_row_driver_sequences.data()),
+                                                         _row_driver_sequences.size() * sizeof(uint16_t));
+                _current_request_bytes += _row_driver_sequences.size() * sizeof(uint16_t);
+                _row_driver_sequences.clear();
+            } else if (_parent->_is_pipeline_level_shuffle) {
                 _chunk_request->add_driver_sequences(driver_sequence);
             }
             auto pchunk = _chunk_request->add_chunks();
-            TRY_CATCH_BAD_ALLOC(RETURN_IF_ERROR(_parent->serialize_chunk(chunk, pchunk, &_is_first_chunk)));
-            _current_request_bytes += pchunk->data().size();
+            TRY_CATCH_BAD_ALLOC(RETURN_IF_ERROR(_parent->serialize_chunk(chunk, pchunk, &_is_first_chunk, 1,
+                                                                         &_compression, &_attachment,
+                                                                         &_attachment_physical_bytes)));
+            _current_request_bytes += pchunk->data_size();
+        }
+        if (_request_start_ms < 0) {
+            _request_start_ms = MonotonicMillis();
         }
     }
 
     // Try to accumulate enough bytes before sending a RPC. When eos is true we should send
     // last packet
     if (_current_request_bytes > config::max_transmit_batched_bytes || eos) {
-        _chunk_request->set_eos(eos);
-        _chunk_request->set_use_pass_through(_use_pass_through);
-        if (auto delta_statistic = state->intermediate_query_statistic()) {
-            delta_statistic->to_pb(_chunk_request->mutable_query_statistics());
-        }
-        butil::IOBuf attachment;
-        int64_t attachment_physical_bytes = _parent->construct_brpc_attachment(_chunk_request, attachment);
-        TransmitChunkInfo info = {this->_fragment_instance_id, _brpc_stub, std::move(_chunk_request), attachment,
-                                  attachment_physical_bytes};
-        RETURN_IF_ERROR(_parent->_buffer->add_request(info));
-        _current_request_bytes = 0;
-        _chunk_request.reset();
+        RETURN_IF_ERROR(_send_request(state, eos));
         *is_real_sent = true;
     }
 
     return Status::OK();
 }
 
+Status ExchangeSinkOperator::Channel::_send_request(RuntimeState* state, bool eos) {
+    _chunk_request->set_eos(eos);
+    _chunk_request->set_use_pass_through(_use_pass_through);
+    if (auto delta_statistic = state->intermediate_query_statistic()) {
+        delta_statistic->to_pb(_chunk_request->mutable_query_statistics());
+    }
+    TransmitChunkInfo info = {this->_fragment_instance_id, _brpc_stub, std::move(_chunk_request), _attachment,
+                              _attachment_physical_bytes};
+    RETURN_IF_ERROR(_parent->_buffer->add_request(info));
+    _current_request_bytes = 0;
+    _chunk_request.reset();
+    _attachment.clear();
+    _attachment_physical_bytes = 0;
+    _request_start_ms = -1;
+    return Status::OK();
+}
+
+Status ExchangeSinkOperator::Channel::send_stale_request(RuntimeState* state, int64_t now_ms,
+                                                         int64_t max_latency_ms) {
+    if (_chunk_request == nullptr || _request_start_ms < 0 || now_ms - _request_start_ms < max_latency_ms) {
+        return Status::OK();
+    }
+    COUNTER_UPDATE(_parent->_latency_flushes_counter, 1);
+    return _send_request(state, false);
+}
+
 Status ExchangeSinkOperator::Channel::send_chunk_request(RuntimeState* state, PTransmitChunkParamsPtr chunk_request,
                                                          const butil::IOBuf& attachment,
                                                          int64_t attachment_physical_bytes) {
@@ -323,7 +386,8 @@ ExchangeSinkOperator::ExchangeSinkOperator(
         const std::vector<TPlanFragmentDestination>& destinations, bool is_pipeline_level_shuffle,
         const int32_t num_shuffles_per_channel, int32_t sender_id, PlanNodeId dest_node_id,
         const std::vector<ExprContext*>& partition_expr_ctxs, bool enable_exchange_pass_through,
-        bool enable_exchange_perf, FragmentContext* const fragment_ctx, const std::vector<int32_t>& output_columns)
+        bool enable_exchange_perf, FragmentContext* const fragment_ctx, const std::vector<int32_t>& output_columns,
+        TSkewShuffleMode::type skew_shuffle_mode, const std::vector<uint32_t>& skew_hash_values)
         : Operator(factory, id, "exchange_sink", plan_node_id, driver_sequence),
           _buffer(buffer),
           _part_type(part_type),
@@ -333,7 +397,9 @@ ExchangeSinkOperator::ExchangeSinkOperator(
           _dest_node_id(dest_node_id),
           _partition_expr_ctxs(partition_expr_ctxs),
           _fragment_ctx(fragment_ctx),
-          _output_columns(output_columns) {
+          _output_columns(output_columns),
+          _skew_shuffle_mode(skew_shuffle_mode),
+          _skew_hash_values(skew_hash_values) {
     std::map<int64_t, int64_t> fragment_id_to_channel_index;
     RuntimeState* state = fragment_ctx->runtime_state();
     PassThroughChunkBuffer* pass_through_chunk_buffer =
@@ -399,7 +465,9 @@ Status ExchangeSinkOperator::prepare(RuntimeState* state) {
         // compress transmitted data.
         _compress_type = CompressionTypePB::LZ4;
     }
-    RETURN_IF_ERROR(get_block_compression_codec(_compress_type, &_compress_codec));
+    _adaptive_compression = config::enable_exchange_adaptive_compression;
+    RETURN_IF_ERROR(_compression.init(_compress_type, _adaptive_compression,
+                                      [this]() { return _buffer->max_queue_pressure(); }));
 
     std::string instances;
     for (const auto& channel : _channels) {
@@ -422,6 +490,20 @@ Status ExchangeSinkOperator::prepare(RuntimeState* state) {
         _unique_metrics->add_info_string("TotalShuffleNum", std::to_string(_num_shuffles));
         _unique_metrics->add_info_string("PipelineLevelShuffle", _is_pipeline_level_shuffle ? "Yes" : "No");
     }
+    if (!_skew_hash_values.empty()) {
+        _unique_metrics->add_info_string("SkewShuffleMode", to_string(_skew_shuffle_mode));
+        _unique_metrics->add_info_string("SkewKeyNum", std::to_string(_skew_hash_values.size()));
+        _skew_rows_counter = ADD_COUNTER(_unique_metrics, "SkewRows", TUnit::UNIT);
+        for (int32_t i = 0; i < _channels.size(); ++i) {
+            if (_channels[i]->is_local()) {
+                _skew_spread_channels.emplace_back(i);
+            }
+        }
+        if (_skew_spread_channels.empty()) {
+            _skew_spread_channels.resize(_channels.size());
+            std::iota(_skew_spread_channels.begin(), _skew_spread_channels.end(), 0);
+        }
+    }
 
     // Randomize the order we open/transmit to channels to avoid thundering herd problems.
     _channel_indices.resize(_channels.size());
@@ -431,9 +513,14 @@ Status ExchangeSinkOperator::prepare(RuntimeState* state) {
 
     _bytes_pass_through_counter = ADD_COUNTER(_unique_metrics, "BytesPassThrough", TUnit::BYTES);
     _uncompressed_bytes_counter = ADD_COUNTER(_unique_metrics, "UncompressedBytes", TUnit::BYTES);
+    _coalesced_chunks_counter = ADD_COUNTER(_unique_metrics, "CoalescedSmallChunks", TUnit::UNIT);
+    _latency_flushes_counter = ADD_COUNTER(_unique_metrics, "MaxLatencyFlushes", TUnit::UNIT);
     _serialize_chunk_timer = ADD_TIMER(_unique_metrics, "SerializeChunkTime");
     _shuffle_hash_timer = ADD_TIMER(_unique_metrics, "ShuffleHashTime");
     _compress_timer = ADD_TIMER(_unique_metrics, "CompressTime");
+    if (_adaptive_compression) {
+        _compression_switches_counter = ADD_COUNTER(_unique_metrics, "CompressionTypeSwitches", TUnit::UNIT);
+    }
 
     for (auto& [_, channel] : _instance_id2channel) {
         RETURN_IF_ERROR(channel->init(state));
@@ -482,70 +569,16 @@ Status ExchangeSinkOperator::push_chunk(RuntimeState* state, const ChunkPtr& chu
         send_chunk = &temp_chunk;
     }
 
-    if (_part_type == TPartitionType::UNPARTITIONED || _num_shuffles == 1) {
-        if (_chunk_request == nullptr) {
-            _chunk_request = std::make_shared<PTransmitChunkParams>();
-        }
-
-        // If we have any channel which can pass through chunks, we use `send_one_chunk`(without serialization)
-        int has_not_pass_through = false;
-        for (auto idx : _channel_indices) {
-            if (_channels[idx]->use_pass_through()) {
-                RETURN_IF_ERROR(_channels[idx]->send_one_chunk(state, send_chunk, DEFAULT_DRIVER_SEQUENCE, false));
-            } else {
-                has_not_pass_through = true;
-            }
-        }
-
-        // And if we find if there are other channels can not pass through, we have to use old way.
-        // Do serialization once, and send serialized data.
-        if (has_not_pass_through) {
-            // We use sender request to avoid serialize chunk many times.
-            // 1. create a new chunk PB to serialize
-            ChunkPB* pchunk = _chunk_request->add_chunks();
-            // 2. serialize input chunk to pchunk
-            TRY_CATCH_BAD_ALLOC(
-                    RETURN_IF_ERROR(serialize_chunk(send_chunk, pchunk, &_is_first_chunk, _channels.size())));
-            _current_request_bytes += pchunk->data().size();
-            // 3. if request bytes exceede the threshold, send current request
-            if (_current_request_bytes > config::max_transmit_batched_bytes) {
-                butil::IOBuf attachment;
-                int64_t attachment_physical_bytes = construct_brpc_attachment(_chunk_request, attachment);
-                for (auto idx : _channel_indices) {
-                    if (!_channels[idx]->use_pass_through()) {
-                        PTransmitChunkParamsPtr copy = std::make_shared<PTransmitChunkParams>(*_chunk_request);
-                        RETURN_IF_ERROR(
-                                _channels[idx]->send_chunk_request(state, copy, attachment, attachment_physical_bytes));
-                    }
-                }
-                _current_request_bytes = 0;
-                _chunk_request.reset();
-            }
-        }
-    } else if (_part_type == TPartitionType::RANDOM) {
-        // Round-robin batches among channels. Wait for the current channel to finish its
-        // rpc before overwriting its batch.
-        // 1. Get request of that channel
-        std::vector<Channel*> local_channels;
-        for (const auto& channel : _channels) {
-            if (channel->is_local()) {
-                local_channels.emplace_back(channel);
-            }
-        }
-
-        if (local_channels.empty()) {
-            local_channels = _channels;
-        }
-
-        auto& channel = local_channels[_curr_random_channel_idx];
-        bool real_sent = false;
-        RETURN_IF_ERROR(channel->send_one_chunk(state, send_chunk, DEFAULT_DRIVER_SEQUENCE, false, &real_sent));
-        if (real_sent) {
-            _curr_random_channel_idx = (_curr_random_channel_idx + 1) % local_channels.size();
+    if (_part_type == TPartitionType::UNPARTITIONED || _num_shuffles == 1 || _part_type == TPartitionType::RANDOM) {
+        if (config::enable_exchange_coalesce_small_chunks) {
+            RETURN_IF_ERROR(_coalesce_small_chunk(state, send_chunk));
+        } else {
+            RETURN_IF_ERROR(_send_unshuffled_chunk(state, send_chunk));
         }
     } else if (_part_type == TPartitionType::HASH_PARTITIONED ||
                _part_type == TPartitionType::BUCKET_SHUFFLE_HASH_PARTITIONED) {
         // hash-partition batch's rows across channels
+        size_t num_buckets = _num_shuffles;
         {
             SCOPED_TIMER(_shuffle_hash_timer);
             for (size_t i = 0; i < _partitions_columns.size(); ++i) {
@@ -569,15 +602,16 @@ Status ExchangeSinkOperator::push_chunk(RuntimeState* state, const ChunkPtr& chu
             }
 
             // Compute row indexes for each channel's each shuffle
-            _channel_row_idx_start_points.assign(_num_shuffles + 1, 0);
             _shuffler->exchange_shuffle(_shuffle_channel_ids, _hash_values, num_rows);
+            num_buckets = _skew_hash_values.empty() ? _num_shuffles : _route_skew_rows(num_rows);
+            _channel_row_idx_start_points.assign(num_buckets + 1, 0);
 
             for (size_t i = 0; i < num_rows; ++i) {
                 _channel_row_idx_start_points[_shuffle_channel_ids[i]]++;
             }
             // NOTE:
             // we make the last item equal with number of rows of this chunk
-            for (int32_t i = 1; i <= _num_shuffles; ++i) {
+            for (int32_t i = 1; i <= num_buckets; ++i) {
                 _channel_row_idx_start_points[i] += _channel_row_idx_start_points[i - 1];
             }
 
@@ -608,24 +642,197 @@ Status ExchangeSinkOperator::push_chunk(RuntimeState* state, const ChunkPtr& chu
                                                                           _row_indexes.data(), from, size, state));
             }
         }
+
+        // The rows of the skewed keys are sent to all the shuffles in BROADCAST mode.
+        if (num_buckets > _num_shuffles) {
+            size_t from = _channel_row_idx_start_points[_num_shuffles];
+            size_t size = _channel_row_idx_start_points[_num_shuffles + 1] - from;
+            for (int32_t channel_id : _channel_indices) {
+                if (size == 0) {
+                    break;
+                }
+                for (int32_t i = 0; i < _num_shuffles_per_channel; ++i) {
+                    int driver_sequence = _driver_sequence_per_shuffle[channel_id * _num_shuffles_per_channel + i];
+                    RETURN_IF_ERROR(_channels[channel_id]->add_rows_selective(send_chunk, driver_sequence,
+                                                                              _row_indexes.data(), from, size, state));
+                }
+            }
+        }
+    }
+    return _send_stale_batches(state);
+}
+
+Status ExchangeSinkOperator::_send_unshuffled_chunk(RuntimeState* state, const Chunk* send_chunk) {
+    if (_part_type == TPartitionType::UNPARTITIONED || _num_shuffles == 1) {
+        if (_chunk_request == nullptr) {
+            _chunk_request = std::make_shared<PTransmitChunkParams>();
+        }
+
+        // If we have any channel which can pass through chunks, we use `send_one_chunk`(without serialization)
+        int has_not_pass_through = false;
+        for (auto idx : _channel_indices) {
+            if (_channels[idx]->use_pass_through()) {
+                RETURN_IF_ERROR(_channels[idx]->send_one_chunk(state, send_chunk, DEFAULT_DRIVER_SEQUENCE, false));
+            } else {
+                has_not_pass_through = true;
+            }
+        }
+
+        // And if we find if there are other channels can not pass through, we have to use old way.
+        // Do serialization once, and send serialized data.
+        if (has_not_pass_through) {
+            // We use sender request to avoid serialize chunk many times.
+            // 1. create a new chunk PB to serialize
+            ChunkPB* pchunk = _chunk_request->add_chunks();
+            // 2. serialize input chunk to pchunk
+            TRY_CATCH_BAD_ALLOC(RETURN_IF_ERROR(serialize_chunk(send_chunk, pchunk, &_is_first_chunk, _channels.size(),
+                                                                &_compression, &_attachment,
+                                                                &_attachment_physical_bytes)));
+            _current_request_bytes += pchunk->data_size();
+            if (_batch_start_ms < 0) {
+                _batch_start_ms = MonotonicMillis();
+            }
+            // 3. if request bytes exceede the threshold, send current request
+            if (_current_request_bytes > config::max_transmit_batched_bytes) {
+                RETURN_IF_ERROR(_send_broadcast_request(state));
+            }
+        }
+    } else if (_part_type == TPartitionType::RANDOM) {
+        // Round-robin batches among channels. Wait for the current channel to finish its
+        // rpc before overwriting its batch.
+        // 1. Get request of that channel
+        std::vector<Channel*> local_channels;
+        for (const auto& channel : _channels) {
+            if (channel->is_local()) {
+                local_channels.emplace_back(channel);
+            }
+        }
+
+        if (local_channels.empty()) {
+            local_channels = _channels;
+        }
+
+        auto& channel = local_channels[_curr_random_channel_idx];
+        bool real_sent = false;
+        RETURN_IF_ERROR(channel->send_one_chunk(state, send_chunk, DEFAULT_DRIVER_SEQUENCE, false, &real_sent));
+        if (real_sent) {
+            _curr_random_channel_idx = (_curr_random_channel_idx + 1) % local_channels.size();
+        }
+    }
+    return Status::OK();
+}
+
+Status ExchangeSinkOperator::_coalesce_small_chunk(RuntimeState* state, const Chunk* chunk) {
+    const size_t num_rows = chunk->num_rows();
+    // The chunks are sent in order, since the merging exchange requires the chunks of a sender to be sorted.
+    if (num_rows * 2 > state->chunk_size()) {
+        RETURN_IF_ERROR(_send_coalesced_chunk(state));
+        return _send_unshuffled_chunk(state, chunk);
+    }
+
+    if (_coalesced_chunk != nullptr && _coalesced_chunk->num_rows() > 0 &&
+        (_coalesced_chunk->num_rows() + num_rows > state->chunk_size() ||
+         (config::pipeline_target_chunk_bytes > 0 &&
+          _coalesced_chunk->bytes_usage() >= config::pipeline_target_chunk_bytes))) {
+        RETURN_IF_ERROR(_send_coalesced_chunk(state));
+    }
+    if (_coalesced_chunk == nullptr) {
+        _coalesced_chunk = chunk->clone_empty_with_slot(state->chunk_size());
+    }
+    _coalesced_chunk->append(*chunk);
+    COUNTER_UPDATE(_coalesced_chunks_counter, 1);
+    if (_batch_start_ms < 0) {
+        _batch_start_ms = MonotonicMillis();
+    }
+    return Status::OK();
+}
+
+Status ExchangeSinkOperator::_send_coalesced_chunk(RuntimeState* state) {
+    if (_coalesced_chunk == nullptr || _coalesced_chunk->num_rows() == 0) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(_send_unshuffled_chunk(state, _coalesced_chunk.get()));
+    // we only clear column data, because we need to reuse column schema
+    _coalesced_chunk->set_num_rows(0);
+    if (_chunk_request == nullptr || _chunk_request->chunks_size() == 0) {
+        _batch_start_ms = -1;
+    }
+    return Status::OK();
+}
+
+Status ExchangeSinkOperator::_send_broadcast_request(RuntimeState* state) {
+    for (auto idx : _channel_indices) {
+        if (!_channels[idx]->use_pass_through()) {
+            PTransmitChunkParamsPtr copy = std::make_shared<PTransmitChunkParams>(*_chunk_request);
+            RETURN_IF_ERROR(_channels[idx]->send_chunk_request(state, copy, _attachment, _attachment_physical_bytes));
+        }
+    }
+    _current_request_bytes = 0;
+    _chunk_request.reset();
+    _attachment.clear();
+    _attachment_physical_bytes = 0;
+    if (_coalesced_chunk == nullptr || _coalesced_chunk->num_rows() == 0) {
+        _batch_start_ms = -1;
+    }
+    return Status::OK();
+}
+
+Status ExchangeSinkOperator::_send_stale_batches(RuntimeState* state) {
+    const int64_t max_latency_ms = config::exchange_max_batch_latency_ms;
+    if (max_latency_ms <= 0) {
+        return Status::OK();
+    }
+    const int64_t now_ms = MonotonicMillis();
+    if (_batch_start_ms >= 0 && now_ms - _batch_start_ms >= max_latency_ms) {
+        COUNTER_UPDATE(_latency_flushes_counter, 1);
+        RETURN_IF_ERROR(_send_coalesced_chunk(state));
+        if (_chunk_request != nullptr && _chunk_request->chunks_size() > 0) {
+            RETURN_IF_ERROR(_send_broadcast_request(state));
+        }
+        _batch_start_ms = -1;
+    }
+    for (auto& [_, channel] : _instance_id2channel) {
+        RETURN_IF_ERROR(channel->send_stale_request(state, now_ms, max_latency_ms));
     }
     return Status::OK();
 }
 
+size_t ExchangeSinkOperator::_route_skew_rows(size_t num_rows) {
+    size_t num_skew_rows = 0;
+    for (size_t i = 0; i < num_rows; ++i) {
+        if (!std::binary_search(_skew_hash_values.begin(), _skew_hash_values.end(), _hash_values[i])) {
+            continue;
+        }
+        // The rows of other keys colliding with the hash value of a skewed key are treated as skewed too,
+        // it's still correct since both sides of the join use the same hash values.
+        num_skew_rows++;
+        if (_skew_shuffle_mode == TSkewShuffleMode::BROADCAST) {
+            _shuffle_channel_ids[i] = _num_shuffles;
+        } else {
+            int32_t channel_id = _skew_spread_channels[_skew_spread_cursor % _skew_spread_channels.size()];
+            int32_t shuffle = (_skew_spread_cursor / _skew_spread_channels.size()) % _num_shuffles_per_channel;
+            _shuffle_channel_ids[i] = channel_id * _num_shuffles_per_channel + shuffle;
+            _skew_spread_cursor++;
+        }
+    }
+    COUNTER_UPDATE(_skew_rows_counter, num_skew_rows);
+    return _skew_shuffle_mode == TSkewShuffleMode::BROADCAST ? _num_shuffles + 1 : _num_shuffles;
+}
+
 Status ExchangeSinkOperator::set_finishing(RuntimeState* state) {
     _is_finished = true;
 
+    Status status = _send_coalesced_chunk(state);
     if (_chunk_request != nullptr) {
-        butil::IOBuf attachment;
-        int64_t attachment_physical_bytes = construct_brpc_attachment(_chunk_request, attachment);
         for (const auto& [_, channel] : _instance_id2channel) {
             PTransmitChunkParamsPtr copy = std::make_shared<PTransmitChunkParams>(*_chunk_request);
-            channel->send_chunk_request(state, copy, attachment, attachment_physical_bytes);
+            channel->send_chunk_request(state, copy, _attachment, _attachment_physical_bytes);
         }
         _current_request_bytes = 0;
         _chunk_request.reset();
+        _attachment.clear();
+        _attachment_physical_bytes = 0;
     }
-    Status status = Status::OK();
     for (auto& [_, channel] : _instance_id2channel) {
         auto tmp_status = channel->close(state, _fragment_ctx);
         if (!tmp_status.ok()) {
@@ -642,94 +849,92 @@ void ExchangeSinkOperator::close(RuntimeState* state) {
     Operator::close(state);
 }
 
-Status ExchangeSinkOperator::serialize_chunk(const Chunk* src, ChunkPB* dst, bool* is_first_chunk, int num_receivers) {
+Status ExchangeSinkOperator::serialize_chunk(const Chunk* src, ChunkPB* dst, bool* is_first_chunk, int num_receivers,
+                                             AdaptiveCompression* compression, butil::IOBuf* attachment,
+                                             int64_t* attachment_physical_bytes) {
     VLOG_ROW << "[ExchangeSinkOperator] serializing " << src->num_rows() << " rows";
+    // The data is allocated by malloc and owned by the attachment, rather than copied from ChunkPB.data.
+    uint8_t* data = nullptr;
+    DeferOp free_data([&data]() { free(data); });
+    auto allocate = [](size_t size) -> StatusOr<uint8_t*> {
+        auto* buff = static_cast<uint8_t*>(malloc(size));
+        if (UNLIKELY(buff == nullptr)) {
+            return Status::MemoryAllocFailed(fmt::format("failed to allocate {} bytes to serialize chunk", size));
+        }
+        return buff;
+    };
+
+    const BlockCompressionCodec* codec = compression->codec();
+    size_t uncompressed_size = 0;
     {
         SCOPED_TIMER(_serialize_chunk_timer);
         // We only serialize chunk meta for first chunk
         if (*is_first_chunk) {
             _encode_context = serde::EncodeContext::get_encode_context_shared_ptr(src->columns().size(), _encode_level);
-            StatusOr<ChunkPB> res = Status::OK();
-            TRY_CATCH_BAD_ALLOC(res = serde::ProtobufChunkSerde::serialize(*src, _encode_context));
-            RETURN_IF_ERROR(res);
-            res->Swap(dst);
+            serde::ProtobufChunkSerde::serialize_meta(*src, dst);
             *is_first_chunk = false;
+        }
+        size_t max_serialized_size = serde::ProtobufChunkSerde::max_serialized_data_size(*src, _encode_context);
+        uint8_t* buff = nullptr;
+        if (codec != nullptr) {
+            // only the compressed data is sent, so serialize into the reused scratch
+            raw::stl_string_resize_uninitialized(&_compression_scratch, max_serialized_size);
+            buff = reinterpret_cast<uint8_t*>(_compression_scratch.data());
         } else {
-            StatusOr<ChunkPB> res = Status::OK();
-            TRY_CATCH_BAD_ALLOC(res = serde::ProtobufChunkSerde::serialize_without_meta(*src, _encode_context));
-            RETURN_IF_ERROR(res);
-            res->Swap(dst);
+            ASSIGN_OR_RETURN(data, allocate(max_serialized_size));
+            buff = data;
         }
+        StatusOr<size_t> res = Status::OK();
+        TRY_CATCH_BAD_ALLOC(res = serde::ProtobufChunkSerde::serialize_data(*src, _encode_context, buff, dst));
+        RETURN_IF_ERROR(res);
+        uncompressed_size = res.value();
     }
     if (_encode_context) {
         _encode_context->set_encode_levels_in_pb(dst);
     }
     DCHECK(dst->has_uncompressed_size());
-    DCHECK_EQ(dst->uncompressed_size(), dst->data().size());
-    const size_t uncompressed_size = dst->uncompressed_size();
-
-    if (_compress_codec != nullptr && _compress_codec->exceed_max_input_size(uncompressed_size)) {
-        return Status::InternalError(strings::Substitute("The input size for compression should be less than $0",
-                                                         _compress_codec->max_input_size()));
-    }
+    DCHECK_EQ(dst->uncompressed_size(), uncompressed_size);
 
+    size_t data_size = uncompressed_size;
     // try compress the ChunkPB data
-    if (_compress_codec != nullptr && uncompressed_size > 0) {
+    if (codec != nullptr) {
+        if (codec->exceed_max_input_size(uncompressed_size)) {
+            return Status::InternalError(strings::Substitute("The input size for compression should be less than $0",
+                                                             codec->max_input_size()));
+        }
         SCOPED_TIMER(_compress_timer);
+        size_t max_compressed_size = codec->max_compressed_len(uncompressed_size);
+        ASSIGN_OR_RETURN(data, allocate(std::max(max_compressed_size, uncompressed_size)));
 
-        if (use_compression_pool(_compress_codec->type())) {
-            Slice compressed_slice;
-            Slice input(dst->data());
-            RETURN_IF_ERROR(_compress_codec->compress(input, &compressed_slice, true, uncompressed_size, nullptr,
-                                                      &_compression_scratch));
-        } else {
-            int max_compressed_size = _compress_codec->max_compressed_len(uncompressed_size);
-
-            if (_compression_scratch.size() < max_compressed_size) {
-                _compression_scratch.resize(max_compressed_size);
-            }
-
-            Slice compressed_slice{_compression_scratch.data(), _compression_scratch.size()};
-
-            Slice input(dst->data());
-            RETURN_IF_ERROR(_compress_codec->compress(input, &compressed_slice));
-            _compression_scratch.resize(compressed_slice.size);
-        }
+        Slice input(_compression_scratch.data(), uncompressed_size);
+        Slice compressed_slice(data, max_compressed_size);
+        RETURN_IF_ERROR(codec->compress(input, &compressed_slice));
 
-        double compress_ratio = (static_cast<double>(uncompressed_size)) / _compression_scratch.size();
+        double compress_ratio = (static_cast<double>(uncompressed_size)) / compressed_slice.size;
         if (LIKELY(compress_ratio > config::rpc_compress_ratio_threshold)) {
-            dst->mutable_data()->swap(reinterpret_cast<std::string&>(_compression_scratch));
-            dst->set_compress_type(_compress_type);
+            dst->set_compress_type(compression->type());
+            data_size = compressed_slice.size;
+        } else {
+            memcpy(data, input.data, uncompressed_size);
         }
 
-        VLOG_ROW << "uncompressed size: " << uncompressed_size << ", compressed size: " << _compression_scratch.size();
+        VLOG_ROW << "uncompressed size: " << uncompressed_size << ", compressed size: " << compressed_slice.size;
+    }
+    // shrink the buffer to the data
+    if (auto* shrunk = static_cast<uint8_t*>(realloc(data, data_size)); shrunk != nullptr) {
+        data = shrunk;
     }
-    size_t chunk_size = dst->data().size();
-    VLOG_ROW << "chunk data size " << chunk_size;
+    *attachment_physical_bytes += malloc_usable_size(data);
+    attachment->append_user_data(data, data_size, free);
+    data = nullptr;
+    dst->set_data_size(data_size);
+    VLOG_ROW << "chunk data size " << data_size;
 
     COUNTER_UPDATE(_uncompressed_bytes_counter, uncompressed_size * num_receivers);
-    return Status::OK();
-}
-
-int64_t ExchangeSinkOperator::construct_brpc_attachment(const PTransmitChunkParamsPtr& chunk_request,
-                                                        butil::IOBuf& attachment) {
-    int64_t attachment_physical_bytes = 0;
-    for (int i = 0; i < chunk_request->chunks().size(); ++i) {
-        auto chunk = chunk_request->mutable_chunks(i);
-        chunk->set_data_size(chunk->data().size());
-
-        int64_t before_bytes = CurrentThread::current().get_consumed_bytes();
-        attachment.append(chunk->data());
-        attachment_physical_bytes += CurrentThread::current().get_consumed_bytes() - before_bytes;
-
-        chunk->clear_data();
-        // If the request is too big, free the memory in order to avoid OOM
-        if (_is_large_chunk(chunk->data_size())) {
-            chunk->mutable_data()->shrink_to_fit();
-        }
+    if (compression->update(uncompressed_size, data_size)) {
+        COUNTER_UPDATE(_compression_switches_counter, 1);
     }
-
-    return attachment_physical_bytes;
+    return Status::OK();
 }
 
 ExchangeSinkOperatorFactory::ExchangeSinkOperatorFactory(
@@ -756,7 +961,7 @@ OperatorPtr ExchangeSinkOperatorFactory::create(int32_t degree_of_parallelism, i
     return std::make_shared<ExchangeSinkOperator>(
             this, _id, _plan_node_id, driver_sequence, _buffer, _part_type, _destinations, _is_pipeline_level_shuffle,
             _num_shuffles_per_channel, _sender_id, _dest_node_id, _partition_expr_ctxs, _enable_exchange_pass_through,
-            _enable_exchange_perf, _fragment_ctx, _output_columns);
+            _enable_exchange_perf, _fragment_ctx, _output_columns, _skew_shuffle_mode, _skew_hash_values);
 }
 
 Status ExchangeSinkOperatorFactory::prepare(RuntimeState* state) {
@@ -767,6 +972,33 @@ Status ExchangeSinkOperatorFactory::prepare(RuntimeState* state) {
         RETURN_IF_ERROR(Expr::prepare(_partition_expr_ctxs, state));
         RETURN_IF_ERROR(Expr::open(_partition_expr_ctxs, state));
     }
+    if (_part_type == TPartitionType::HASH_PARTITIONED && !_skew_values.empty()) {
+        RETURN_IF_ERROR(_prepare_skew_hash_values(state));
+    }
+    return Status::OK();
+}
+
+Status ExchangeSinkOperatorFactory::_prepare_skew_hash_values(RuntimeState* state) {
+    for (const auto& skew_value : _skew_values) {
+        if (skew_value.size() != _partition_expr_ctxs.size()) {
+            return Status::InternalError(fmt::format("skew value has {} columns, but there are {} partition exprs",
+                                                     skew_value.size(), _partition_expr_ctxs.size()));
+        }
+        std::vector<ExprContext*> ctxs;
+        RETURN_IF_ERROR(Expr::create_expr_trees(state->obj_pool(), skew_value, &ctxs, state));
+        RETURN_IF_ERROR(Expr::prepare(ctxs, state));
+        DeferOp close_ctxs([&]() { Expr::close(ctxs, state); });
+        RETURN_IF_ERROR(Expr::open(ctxs, state));
+        // Must be the same as the hash values computed by ExchangeSinkOperator::push_chunk.
+        uint32_t hash_value = HashUtil::FNV_SEED;
+        for (ExprContext* ctx : ctxs) {
+            ASSIGN_OR_RETURN(ColumnPtr column, ctx->evaluate(nullptr));
+            column->fnv_hash(&hash_value, 0, 1);
+        }
+        _skew_hash_values.emplace_back(hash_value);
+    }
+    std::sort(_skew_hash_values.begin(), _skew_hash_values.end());
+    _skew_hash_values.erase(std::unique(_skew_hash_values.begin(), _skew_hash_values.end()), _skew_hash_values.end());
     return Status::OK();
 }
 
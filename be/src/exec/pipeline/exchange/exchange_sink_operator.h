@@ -22,6 +22,7 @@
 #include "common/object_pool.h"
 #include "common/status.h"
 #include "exec/data_sink.h"
+#include "exec/pipeline/exchange/adaptive_compression.h"
 #include "exec/pipeline/exchange/shuffler.h"
 #include "exec/pipeline/exchange/sink_buffer.h"
 #include "exec/pipeline/fragment_context.h"
@@ -51,7 +52,8 @@ public:
                          const int32_t num_shuffles_per_channel, int32_t sender_id, PlanNodeId dest_node_id,
                          const std::vector<ExprContext*>& partition_expr_ctxs, bool enable_exchange_pass_through,
                          bool enable_exchange_perf, FragmentContext* const fragment_ctx,
-                         const std::vector<int32_t>& output_columns);
+                         const std::vector<int32_t>& output_columns, TSkewShuffleMode::type skew_shuffle_mode,
+                         const std::vector<uint32_t>& skew_hash_values);
 
     ~ExchangeSinkOperator() override = default;
 
@@ -77,16 +79,28 @@ public:
 
     // For the first chunk , serialize the chunk data and meta to ChunkPB both.
     // For other chunk, only serialize the chunk data to ChunkPB.
-    Status serialize_chunk(const Chunk* chunk, ChunkPB* dst, bool* is_first_chunk, int num_receivers = 1);
-
-    // Return the physical bytes of attachment.
-    int64_t construct_brpc_attachment(const PTransmitChunkParamsPtr& _chunk_request, butil::IOBuf& attachment);
+    // The data, compressed by |compression| if it pays off, is written to a buffer appended to |attachment|
+    // without copying, and the size of which is set to ChunkPB.data_size. The physical bytes of the buffer
+    // are added to |attachment_physical_bytes|.
+    Status serialize_chunk(const Chunk* chunk, ChunkPB* dst, bool* is_first_chunk, int num_receivers,
+                           AdaptiveCompression* compression, butil::IOBuf* attachment,
+                           int64_t* attachment_physical_bytes);
 
 private:
-    bool _is_large_chunk(size_t sz) const {
-        // ref olap_scan_node.cpp release_large_columns
-        return sz > runtime_state()->chunk_size() * 512;
-    }
+    // Route the rows of the skewed keys computed by the shuffler, return the number of the shuffle buckets.
+    // In BROADCAST mode, the rows of the skewed keys are put in an extra bucket _num_shuffles which is
+    // sent to all the shuffles.
+    size_t _route_skew_rows(size_t num_rows);
+
+    // Send the chunk of the UNPARTITIONED or RANDOM exchange.
+    Status _send_unshuffled_chunk(RuntimeState* state, const Chunk* chunk);
+    // Coalesce the small chunk into _coalesced_chunk, which is sent once it's large enough.
+    Status _coalesce_small_chunk(RuntimeState* state, const Chunk* chunk);
+    Status _send_coalesced_chunk(RuntimeState* state);
+    // Send the broadcast request to all the channels not using pass through.
+    Status _send_broadcast_request(RuntimeState* state);
+    // Send the coalesced chunks and the batched requests waiting for more than exchange_max_batch_latency_ms.
+    Status _send_stale_batches(RuntimeState* state);
 
 private:
     class Channel;
@@ -157,24 +171,36 @@ private:
 
     // Only used when broadcast
     PTransmitChunkParamsPtr _chunk_request;
+    // the serialized data of the chunks of _chunk_request
+    butil::IOBuf _attachment;
+    int64_t _attachment_physical_bytes = 0;
     size_t _current_request_bytes = 0;
 
     bool _is_first_chunk = true;
 
-    // String to write compressed chunk data in serialize().
-    // This is a string so we can swap() with the string in the ChunkPB we're serializing
-    // to (we don't compress directly into the ChunkPB in case the compressed data is
-    // longer than the uncompressed data).
+    // The small chunks of the UNPARTITIONED and RANDOM exchange coalesced to be sent together.
+    ChunkUniquePtr _coalesced_chunk;
+    // The time in ms when the rows of _coalesced_chunk or the chunks of _chunk_request began to be batched,
+    // -1 if nothing is batched.
+    int64_t _batch_start_ms = -1;
+
+    // The uncompressed chunk data written in serialize_chunk() before compressed into the attachment.
     raw::RawString _compression_scratch;
 
+    // The configured compression type, which is changed for every destination if _adaptive_compression is true.
     CompressionTypePB _compress_type = CompressionTypePB::NO_COMPRESSION;
-    const BlockCompressionCodec* _compress_codec = nullptr;
+    bool _adaptive_compression = false;
+    // Only used when broadcast, it's adapted to the most congested destination.
+    AdaptiveCompression _compression;
 
     RuntimeProfile::Counter* _serialize_chunk_timer = nullptr;
     RuntimeProfile::Counter* _shuffle_hash_timer = nullptr;
     RuntimeProfile::Counter* _compress_timer = nullptr;
+    RuntimeProfile::Counter* _compression_switches_counter = nullptr;
     RuntimeProfile::Counter* _bytes_pass_through_counter = nullptr;
     RuntimeProfile::Counter* _uncompressed_bytes_counter = nullptr;
+    RuntimeProfile::Counter* _coalesced_chunks_counter = nullptr;
+    RuntimeProfile::Counter* _latency_flushes_counter = nullptr;
 
     std::atomic<bool> _is_finished = false;
     std::atomic<bool> _is_cancelled = false;
@@ -202,6 +228,16 @@ private:
 
     std::unique_ptr<Shuffler> _shuffler;
 
+    // The rows whose partition hash values are in _skew_hash_values are routed by _skew_shuffle_mode
+    // rather than hash partitioned, see TSkewShuffleMode.
+    const TSkewShuffleMode::type _skew_shuffle_mode;
+    // Sorted, empty if there are no skewed keys.
+    const std::vector<uint32_t>& _skew_hash_values;
+    // The channels to which the rows of the skewed keys are spread in SPREAD mode.
+    std::vector<int32_t> _skew_spread_channels;
+    size_t _skew_spread_cursor = 0;
+    RuntimeProfile::Counter* _skew_rows_counter = nullptr;
+
     std::shared_ptr<serde::EncodeContext> _encode_context = nullptr;
 };
 
@@ -223,7 +259,16 @@ public:
 
     void close(RuntimeState* state) override;
 
+    // Each element of |skew_values| is a skewed key, which consists of one literal per partition expr.
+    void set_skew_shuffle(TSkewShuffleMode::type mode, std::vector<std::vector<TExpr>> skew_values) {
+        _skew_shuffle_mode = mode;
+        _skew_values = std::move(skew_values);
+    }
+
 private:
+    // Compute the partition hash values of _skew_values into _skew_hash_values.
+    Status _prepare_skew_hash_values(RuntimeState* state);
+
     std::shared_ptr<SinkBuffer> _buffer;
     const TPartitionType::type _part_type;
 
@@ -242,6 +287,10 @@ private:
     FragmentContext* const _fragment_ctx;
 
     const std::vector<int32_t> _output_columns;
+
+    TSkewShuffleMode::type _skew_shuffle_mode = TSkewShuffleMode::BROADCAST;
+    std::vector<std::vector<TExpr>> _skew_values;
+    std::vector<uint32_t> _skew_hash_values;
 };
 
 } // namespace pipeline
@@ -24,9 +24,19 @@ namespace starrocks::pipeline {
 Status ExchangeSourceOperator::prepare(RuntimeState* state) {
     SourceOperator::prepare(state);
     _stream_recvr = static_cast<ExchangeSourceOperatorFactory*>(_factory)->create_stream_recvr(state, _unique_metrics);
+    if (config::enable_pipeline_driver_readiness_notification) {
+        _stream_recvr->set_readiness_notifier(_driver_sequence, [this]() { notify_readiness(); });
+    }
     return Status::OK();
 }
 
+void ExchangeSourceOperator::close(RuntimeState* state) {
+    if (_stream_recvr != nullptr) {
+        _stream_recvr->set_readiness_notifier(_driver_sequence, nullptr);
+    }
+    SourceOperator::close(state);
+}
+
 bool ExchangeSourceOperator::has_output() const {
     return _stream_recvr->has_output_for_pipeline(_driver_sequence);
 }
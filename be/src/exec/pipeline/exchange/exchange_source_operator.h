@@ -30,9 +30,12 @@ public:
     ~ExchangeSourceOperator() override = default;
 
     Status prepare(RuntimeState* state) override;
+    void close(RuntimeState* state) override;
 
     bool has_output() const override;
 
+    bool support_readiness_notification() const override { return true; }
+
     bool is_finished() const override;
 
     Status set_finishing(RuntimeState* state) override;
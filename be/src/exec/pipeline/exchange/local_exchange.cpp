@@ -127,8 +127,10 @@ Status PartitionExchanger::accept(const ChunkPtr& chunk, const int32_t sink_driv
 }
 
 Status BroadcastExchanger::accept(const ChunkPtr& chunk, const int32_t sink_driver_sequence) {
-    for (auto* source : _source->get_sources()) {
-        source->add_chunk(chunk);
+    // Every source gets its own chunk sharing the columns, so that they're copied only if modified by a source.
+    const auto& sources = _source->get_sources();
+    for (size_t i = 0; i < sources.size(); i++) {
+        sources[i]->add_chunk(i + 1 == sources.size() ? chunk : chunk->clone_with_shared_columns());
     }
     return Status::OK();
 }
@@ -22,14 +22,17 @@ namespace starrocks::pipeline {
 // Used for PassthroughExchanger.
 // The input chunk is most likely full, so we don't merge it to avoid copying chunk data.
 Status LocalExchangeSourceOperator::add_chunk(ChunkPtr chunk) {
-    std::lock_guard<std::mutex> l(_chunk_lock);
-    if (_is_finished) {
-        return Status::OK();
+    {
+        std::lock_guard<std::mutex> l(_chunk_lock);
+        if (_is_finished) {
+            return Status::OK();
+        }
+        size_t memory_usage = chunk->memory_usage();
+        _memory_manager->update_memory_usage(memory_usage);
+        _local_memory_usage += memory_usage;
+        _full_chunk_queue.emplace(std::move(chunk));
     }
-    size_t memory_usage = chunk->memory_usage();
-    _memory_manager->update_memory_usage(memory_usage);
-    _local_memory_usage += memory_usage;
-    _full_chunk_queue.emplace(std::move(chunk));
+    notify_readiness();
 
     return Status::OK();
 }
@@ -38,14 +41,17 @@ Status LocalExchangeSourceOperator::add_chunk(ChunkPtr chunk) {
 // Only enqueue the partition chunk information here, and merge chunk in pull_chunk().
 Status LocalExchangeSourceOperator::add_chunk(ChunkPtr chunk, std::shared_ptr<std::vector<uint32_t>> indexes,
                                               uint32_t from, uint32_t size, size_t memory_usage) {
-    std::lock_guard<std::mutex> l(_chunk_lock);
-    if (_is_finished) {
-        return Status::OK();
+    {
+        std::lock_guard<std::mutex> l(_chunk_lock);
+        if (_is_finished) {
+            return Status::OK();
+        }
+        _memory_manager->update_memory_usage(memory_usage);
+        _partition_chunk_queue.emplace(std::move(chunk), std::move(indexes), from, size, memory_usage);
+        _partition_rows_num += size;
+        _local_memory_usage += memory_usage;
     }
-    _memory_manager->update_memory_usage(memory_usage);
-    _partition_chunk_queue.emplace(std::move(chunk), std::move(indexes), from, size, memory_usage);
-    _partition_rows_num += size;
-    _local_memory_usage += memory_usage;
+    notify_readiness();
 
     return Status::OK();
 }
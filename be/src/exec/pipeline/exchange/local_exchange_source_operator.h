@@ -61,11 +61,16 @@ public:
 
     Status set_finished(RuntimeState* state) override;
     Status set_finishing(RuntimeState* state) override {
-        std::lock_guard<std::mutex> l(_chunk_lock);
-        _is_finished = true;
+        {
+            std::lock_guard<std::mutex> l(_chunk_lock);
+            _is_finished = true;
+        }
+        notify_readiness();
         return Status::OK();
     }
 
+    bool support_readiness_notification() const override { return true; }
+
     bool is_epoch_finished() const override {
         std::lock_guard<std::mutex> l(_chunk_lock);
         return _is_epoch_finished && _full_chunk_queue.empty() && !_partition_rows_num;
@@ -122,7 +122,8 @@ StatusOr<ChunkPtr> MultiCastLocalExchanger::pull_chunk(RuntimeState* state, int3
     cell->used_count += 1;
 
     _update_progress(cell);
-    return cell->chunk;
+    // the consumers share the columns of the chunk, which are copied only if modified by a consumer
+    return cell->chunk->clone_with_shared_columns();
 }
 
 void MultiCastLocalExchanger::open_source_operator(int32_t mcast_consumer_index) {
@@ -16,6 +16,7 @@
 
 #include <bthread/bthread.h>
 
+#include <algorithm>
 #include <chrono>
 
 #include "fmt/core.h"
@@ -47,6 +48,8 @@ SinkBuffer::SinkBuffer(FragmentContext* fragment_ctx, const std::vector<TPlanFra
             _num_finished_rpcs[instance_id.lo] = 0;
             _num_in_flight_rpcs[instance_id.lo] = 0;
             _network_times[instance_id.lo] = TimeTrace{};
+            _in_flight_bytes[instance_id.lo] = 0;
+            _credits[instance_id.lo] = -1;
             _mutexes[instance_id.lo] = std::make_unique<Mutex>();
 
             PUniqueId finst_id;
@@ -119,6 +122,23 @@ bool SinkBuffer::is_full() const {
     return is_full;
 }
 
+double SinkBuffer::queue_pressure(const TUniqueId& instance_id) const {
+    // std::queue' read is concurrent safe without mutex, as is_full()
+    auto it = _buffers.find(instance_id.lo);
+    if (it == _buffers.end()) {
+        return 0;
+    }
+    return static_cast<double>(it->second.size()) / std::max<int64_t>(config::pipeline_sink_buffer_size, 1);
+}
+
+double SinkBuffer::max_queue_pressure() const {
+    size_t max_size = 0;
+    for (auto& [_, buffer] : _buffers) {
+        max_size = std::max(max_size, buffer.size());
+    }
+    return static_cast<double>(max_size) / std::max<int64_t>(config::pipeline_sink_buffer_size, 1);
+}
+
 void SinkBuffer::set_finishing() {
     _pending_timestamp = MonotonicNanos();
 }
@@ -159,6 +179,10 @@ void SinkBuffer::update_profile(RuntimeProfile* profile) {
     auto* request_sent_counter = ADD_COUNTER(profile, "RequestSent", TUnit::UNIT);
     COUNTER_SET(bytes_sent_counter, _bytes_sent);
     COUNTER_SET(request_sent_counter, _request_sent);
+    if (_credit_blocked_times > 0) {
+        auto* credit_blocked_counter = ADD_COUNTER(profile, "CreditBlockedTimes", TUnit::UNIT);
+        COUNTER_SET(credit_blocked_counter, _credit_blocked_times);
+    }
 
     if (_bytes_enqueued - _bytes_sent > 0) {
         auto* bytes_unsent_counter = ADD_COUNTER(profile, "BytesUnsent", TUnit::BYTES);
@@ -263,6 +287,14 @@ Status SinkBuffer::_try_to_send_rpc(const TUniqueId& instance_id, const std::fun
         }
 
         TransmitChunkInfo& request = buffer.front();
+        if (config::enable_exchange_credit_flow_control && _num_in_flight_rpcs[instance_id.lo] > 0 &&
+            _credits[instance_id.lo] >= 0 &&
+            _in_flight_bytes[instance_id.lo] + static_cast<int64_t>(request.attachment.size()) >
+                    _credits[instance_id.lo]) {
+            // wait for the credits granted by the responses of the in-flight requests
+            _credit_blocked_times++;
+            return Status::OK();
+        }
         bool need_wait = false;
         DeferOp pop_defer([&need_wait, &buffer, mem_tracker = _mem_tracker]() {
             if (need_wait) {
@@ -322,7 +354,8 @@ Status SinkBuffer::_try_to_send_rpc(const TUniqueId& instance_id, const std::fun
         }
 
         auto* closure = new DisposableClosure<PTransmitChunkResult, ClosureContext>(
-                {instance_id, request.params->sequence(), GetCurrentTimeNanos()});
+                {instance_id, request.params->sequence(), GetCurrentTimeNanos(),
+                 static_cast<int64_t>(request.attachment.size())});
         if (_first_send_time == -1) {
             _first_send_time = MonotonicNanos();
         }
@@ -333,6 +366,7 @@ Status SinkBuffer::_try_to_send_rpc(const TUniqueId& instance_id, const std::fun
                 std::lock_guard<Mutex> l(*_mutexes[ctx.instance_id.lo]);
                 ++_num_finished_rpcs[ctx.instance_id.lo];
                 --_num_in_flight_rpcs[ctx.instance_id.lo];
+                _in_flight_bytes[ctx.instance_id.lo] -= ctx.bytes;
             }
             --_total_in_flight_rpc;
             std::string err_msg = fmt::format("transmit chunk rpc failed:{}", print_id(ctx.instance_id));
@@ -345,6 +379,10 @@ Status SinkBuffer::_try_to_send_rpc(const TUniqueId& instance_id, const std::fun
                 std::lock_guard<Mutex> l(*_mutexes[ctx.instance_id.lo]);
                 ++_num_finished_rpcs[ctx.instance_id.lo];
                 --_num_in_flight_rpcs[ctx.instance_id.lo];
+                _in_flight_bytes[ctx.instance_id.lo] -= ctx.bytes;
+                if (result.has_credit_bytes()) {
+                    _credits[ctx.instance_id.lo] = result.credit_bytes();
+                }
             }
             if (!status.ok()) {
                 _is_finishing = true;
@@ -362,6 +400,7 @@ Status SinkBuffer::_try_to_send_rpc(const TUniqueId& instance_id, const std::fun
 
         ++_total_in_flight_rpc;
         ++_num_in_flight_rpcs[instance_id.lo];
+        _in_flight_bytes[instance_id.lo] += request.attachment.size();
 
         // Attachment will be released by process_mem_tracker in closure->Run() in bthread, when receiving the response,
         // so decrease the memory usage of attachment from instance_mem_tracker immediately before sending the request.
@@ -53,6 +53,7 @@ struct ClosureContext {
     TUniqueId instance_id;
     int64_t sequence;
     int64_t send_timestamp;
+    int64_t bytes;
 };
 
 // TimeTrace is introduced to estimate time more accurately.
@@ -85,6 +86,12 @@ public:
     Status add_request(TransmitChunkInfo& request);
     bool is_full() const;
 
+    // The queued requests of the destination normalized by pipeline_sink_buffer_size, it's the feedback of
+    // the congestion of the destination.
+    double queue_pressure(const TUniqueId& instance_id) const;
+    // The max queue_pressure() among all the destinations.
+    double max_queue_pressure() const;
+
     void set_finishing();
     bool is_finished() const;
 
@@ -151,6 +158,11 @@ private:
     phmap::flat_hash_map<int64_t, int32_t> _num_finished_rpcs;
     phmap::flat_hash_map<int64_t, int32_t> _num_in_flight_rpcs;
     phmap::flat_hash_map<int64_t, TimeTrace> _network_times;
+    // Credit-based flow control: the request is sent only if the in-flight bytes of the destination won't exceed
+    // the credits granted by the receiver in the last response, or there is no in-flight request. -1 means the
+    // receiver doesn't grant credits.
+    phmap::flat_hash_map<int64_t, int64_t> _in_flight_bytes;
+    phmap::flat_hash_map<int64_t, int64_t> _credits;
     phmap::flat_hash_map<int64_t, std::unique_ptr<Mutex>> _mutexes;
 
     // True means that SinkBuffer needn't input chunk and send chunk anymore,
@@ -175,6 +187,7 @@ private:
     std::atomic<int64_t> _request_enqueued = 0;
     std::atomic<int64_t> _bytes_sent = 0;
     std::atomic<int64_t> _request_sent = 0;
+    std::atomic<int64_t> _credit_blocked_times = 0;
 
     int64_t _pending_timestamp = -1;
     mutable std::atomic<int64_t> _last_full_timestamp = -1;
@@ -31,6 +31,7 @@
 #include "gen_cpp/PlanNodes_types.h"
 #include "gen_cpp/QueryPlanExtra_types.h"
 #include "gen_cpp/Types_types.h"
+#include "io/io_stats.h"
 #include "runtime/profile_report_worker.h"
 #include "runtime/runtime_filter_worker.h"
 #include "runtime/runtime_state.h"
@@ -64,6 +65,8 @@ public:
     std::shared_ptr<RuntimeState> runtime_state_ptr() { return _runtime_state; }
     void set_runtime_state(std::shared_ptr<RuntimeState>&& runtime_state) { _runtime_state = std::move(runtime_state); }
     ExecNode*& plan() { return _plan; }
+    // The ios of the drivers and the io tasks of this fragment instance.
+    io::IOStats& io_stats() { return _io_stats; }
 
     void move_tplan(TPlan& tplan);
     const TPlan& tplan() const { return _tplan; }
@@ -154,6 +157,9 @@ private:
     // promise used to determine whether fragment finished its execution
     FragmentPromise _finish_promise;
 
+    // Declared before _runtime_state to outlive the io tasks holding the operators.
+    io::IOStats _io_stats;
+
     // never adjust the order of _runtime_state, _plan, _pipelines and _drivers, since
     // _plan depends on _runtime_state and _drivers depends on _runtime_state.
     std::shared_ptr<RuntimeState> _runtime_state = nullptr;
@@ -29,7 +29,9 @@ HashJoinBuildOperator::HashJoinBuildOperator(OperatorFactory* factory, int32_t i
           _distribution_mode(distribution_mode) {}
 
 Status HashJoinBuildOperator::push_chunk(RuntimeState* state, const ChunkPtr& chunk) {
-    return _join_builder->append_chunk_to_ht(state, chunk);
+    RETURN_IF_ERROR(_join_builder->append_chunk_to_ht(state, chunk));
+    set_revocable_mem_bytes(_join_builder->revocable_mem_bytes());
+    return Status::OK();
 }
 
 Status HashJoinBuildOperator::prepare(RuntimeState* state) {
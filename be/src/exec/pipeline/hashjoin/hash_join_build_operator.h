@@ -51,6 +51,14 @@ public:
     Status push_chunk(RuntimeState* state, const ChunkPtr& chunk) override;
     StatusOr<ChunkPtr> pull_chunk(RuntimeState* state) override;
 
+    void mark_need_spill() override {
+        Operator::mark_need_spill();
+        _join_builder->mark_need_spill();
+    }
+
+    // the probe rows of the spilled partitions are spilled too.
+    double spill_cost() const override { return 2.0; }
+
     std::string get_name() const override {
         return strings::Substitute("$0(HashJoiner=$1)", Operator::get_name(), _join_builder.get());
     }
@@ -75,8 +75,7 @@ bool HashJoinProbeOperator::is_ready() const {
 
 Status HashJoinProbeOperator::push_chunk(RuntimeState* state, const ChunkPtr& chunk) {
     RETURN_IF_ERROR(_reference_builder_hash_table_once());
-    _join_prober->push_chunk(state, std::move(const_cast<ChunkPtr&>(chunk)));
-    return Status::OK();
+    return _join_prober->push_chunk(state, std::move(const_cast<ChunkPtr&>(chunk)));
 }
 
 StatusOr<ChunkPtr> HashJoinProbeOperator::pull_chunk(RuntimeState* state) {
@@ -41,6 +41,9 @@ public:
     HashJoinerPtr create_prober(int32_t prober_dop, int32_t prober_driver_seq);
     HashJoinerPtr get_builder(int32_t prober_dop, int32_t prober_driver_seq);
 
+    // Must be called before any HashJoiner is created.
+    void set_spillable(bool spillable) { _param._spillable = spillable; }
+
 private:
     HashJoinerPtr _create_joiner(HashJoinerMap& joiner_map, int32_t driver_sequence);
 
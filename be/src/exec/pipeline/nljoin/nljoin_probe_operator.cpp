@@ -14,9 +14,13 @@
 
 #include "exec/pipeline/nljoin/nljoin_probe_operator.h"
 
+#include <unordered_set>
+
 #include "column/chunk.h"
 #include "column/column_helper.h"
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
+#include "exprs/column_ref.h"
 #include "gen_cpp/PlanNodes_types.h"
 #include "runtime/current_thread.h"
 #include "runtime/descriptors.h"
@@ -25,10 +29,168 @@
 
 namespace starrocks::pipeline {
 
+namespace {
+
+bool is_block_predicate_type(LogicalType type) {
+    switch (type) {
+    case TYPE_TINYINT:
+    case TYPE_SMALLINT:
+    case TYPE_INT:
+    case TYPE_BIGINT:
+    case TYPE_FLOAT:
+    case TYPE_DOUBLE:
+    case TYPE_DATE:
+    case TYPE_DATETIME:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool is_block_predicate_op(TExprOpcode::type op) {
+    switch (op) {
+    case TExprOpcode::EQ:
+    case TExprOpcode::NE:
+    case TExprOpcode::LT:
+    case TExprOpcode::LE:
+    case TExprOpcode::GT:
+    case TExprOpcode::GE:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// `a op b` => `b op' a`
+TExprOpcode::type swap_block_predicate_op(TExprOpcode::type op) {
+    switch (op) {
+    case TExprOpcode::LT:
+        return TExprOpcode::GT;
+    case TExprOpcode::LE:
+        return TExprOpcode::GE;
+    case TExprOpcode::GT:
+        return TExprOpcode::LT;
+    case TExprOpcode::GE:
+        return TExprOpcode::LE;
+    default:
+        return op;
+    }
+}
+
+template <TExprOpcode::type Op, typename T>
+inline bool block_compare(const T& build_value, const T& probe_value) {
+    if constexpr (Op == TExprOpcode::EQ) {
+        return build_value == probe_value;
+    } else if constexpr (Op == TExprOpcode::NE) {
+        return build_value != probe_value;
+    } else if constexpr (Op == TExprOpcode::LT) {
+        return build_value < probe_value;
+    } else if constexpr (Op == TExprOpcode::LE) {
+        return build_value <= probe_value;
+    } else if constexpr (Op == TExprOpcode::GT) {
+        return build_value > probe_value;
+    } else {
+        return build_value >= probe_value;
+    }
+}
+
+// Branch-free loop over the build values, which is vectorized by the compiler
+template <TExprOpcode::type Op, typename T>
+void block_filter(const T* __restrict build_data, T probe_value, size_t num_rows, uint8_t* __restrict filter) {
+    for (size_t i = 0; i < num_rows; i++) {
+        filter[i] &= static_cast<uint8_t>(block_compare<Op>(build_data[i], probe_value));
+    }
+}
+
+template <LogicalType Type>
+struct BlockFilterApplier {
+    using CppType = RunTimeCppType<Type>;
+
+    // Return false if no build row matched
+    bool operator()(const NLJoinBlockPredicate& pred, const Column* probe_column, size_t probe_row,
+                    const Column* build_column, Filter* filter) const {
+        if (probe_column->is_null(probe_row)) {
+            return false;
+        }
+        if (probe_column->is_constant()) {
+            probe_row = 0;
+        }
+        const auto* probe_data = ColumnHelper::get_data_column(ColumnHelper::get_data_column(probe_column));
+        const CppType probe_value = down_cast<const RunTimeColumnType<Type>*>(probe_data)->get_data()[probe_row];
+
+        const size_t num_rows = filter->size();
+        if (build_column->is_constant()) {
+            if (build_column->is_null(0)) {
+                return false;
+            }
+            const auto* build_data = ColumnHelper::get_data_column(ColumnHelper::get_data_column(build_column));
+            const CppType build_value = down_cast<const RunTimeColumnType<Type>*>(build_data)->get_data()[0];
+            uint8_t matched = 1;
+            block_filter_dispatch(pred.op, &build_value, probe_value, 1, &matched);
+            return matched != 0;
+        }
+
+        const auto* build_data = down_cast<const RunTimeColumnType<Type>*>(ColumnHelper::get_data_column(build_column));
+        block_filter_dispatch(pred.op, build_data->get_data().data(), probe_value, num_rows, filter->data());
+        if (build_column->has_null()) {
+            const auto& nulls = down_cast<const NullableColumn*>(build_column)->immutable_null_column_data();
+            uint8_t* f = filter->data();
+            for (size_t i = 0; i < num_rows; i++) {
+                f[i] &= !nulls[i];
+            }
+        }
+        return SIMD::contain_nonzero(*filter);
+    }
+
+    static void block_filter_dispatch(TExprOpcode::type op, const CppType* build_data, CppType probe_value,
+                                      size_t num_rows, uint8_t* filter) {
+        switch (op) {
+        case TExprOpcode::EQ:
+            return block_filter<TExprOpcode::EQ>(build_data, probe_value, num_rows, filter);
+        case TExprOpcode::NE:
+            return block_filter<TExprOpcode::NE>(build_data, probe_value, num_rows, filter);
+        case TExprOpcode::LT:
+            return block_filter<TExprOpcode::LT>(build_data, probe_value, num_rows, filter);
+        case TExprOpcode::LE:
+            return block_filter<TExprOpcode::LE>(build_data, probe_value, num_rows, filter);
+        case TExprOpcode::GT:
+            return block_filter<TExprOpcode::GT>(build_data, probe_value, num_rows, filter);
+        case TExprOpcode::GE:
+            return block_filter<TExprOpcode::GE>(build_data, probe_value, num_rows, filter);
+        default:
+            DCHECK(false) << "unsupported block predicate op: " << op;
+        }
+    }
+};
+
+bool apply_block_predicate(const NLJoinBlockPredicate& pred, const Column* probe_column, size_t probe_row,
+                           const Column* build_column, Filter* filter) {
+    switch (pred.type) {
+#define M(TYPE)      \
+    case TYPE:       \
+        return BlockFilterApplier<TYPE>()(pred, probe_column, probe_row, build_column, filter);
+        M(TYPE_TINYINT)
+        M(TYPE_SMALLINT)
+        M(TYPE_INT)
+        M(TYPE_BIGINT)
+        M(TYPE_FLOAT)
+        M(TYPE_DOUBLE)
+        M(TYPE_DATE)
+        M(TYPE_DATETIME)
+#undef M
+    default:
+        DCHECK(false) << "unsupported block predicate type: " << pred.type;
+        return true;
+    }
+}
+
+} // namespace
+
 NLJoinProbeOperator::NLJoinProbeOperator(OperatorFactory* factory, int32_t id, int32_t plan_node_id,
                                          int32_t driver_sequence, TJoinOp::type join_op,
                                          const std::string& sql_join_conjuncts,
                                          const std::vector<ExprContext*>& join_conjuncts,
+                                         const std::vector<NLJoinBlockPredicate>& block_predicates,
                                          const std::vector<ExprContext*>& conjunct_ctxs,
                                          const std::vector<SlotDescriptor*>& col_types, size_t probe_column_count,
                                          const std::shared_ptr<NLJoinContext>& cross_join_context)
@@ -38,6 +200,7 @@ NLJoinProbeOperator::NLJoinProbeOperator(OperatorFactory* factory, int32_t id, i
           _probe_column_count(probe_column_count),
           _sql_join_conjuncts(sql_join_conjuncts),
           _join_conjuncts(join_conjuncts),
+          _block_predicates(block_predicates),
           _conjunct_ctxs(conjunct_ctxs),
           _cross_join_context(cross_join_context) {}
 
@@ -57,6 +220,10 @@ Status NLJoinProbeOperator::prepare(RuntimeState* state) {
     if (_is_left_join() || _is_left_anti_join()) {
         _permute_left_rows_counter = ADD_COUNTER(_unique_metrics, "PermuteLeftJoinRows", TUnit::UNIT);
     }
+    if (!_block_predicates.empty()) {
+        _unique_metrics->add_info_string("BlockPredicates", std::to_string(_block_predicates.size()));
+        _block_filtered_rows_counter = ADD_COUNTER(_unique_metrics, "BlockFilteredRows", TUnit::UNIT);
+    }
     return Status::OK();
 }
 
@@ -399,10 +566,55 @@ ChunkPtr NLJoinProbeOperator::_permute_chunk(RuntimeState* state) {
     return chunk;
 }
 
+bool NLJoinProbeOperator::_filter_build_rows() {
+    _block_filter.assign(_curr_build_chunk->num_rows(), 1);
+    for (const auto& pred : _block_predicates) {
+        const ColumnPtr& probe_column = _probe_chunk->get_column_by_slot_id(pred.probe_slot);
+        const ColumnPtr& build_column = _curr_build_chunk->get_column_by_slot_id(pred.build_slot);
+        if (!apply_block_predicate(pred, probe_column.get(), _probe_row_current, build_column.get(),
+                                   &_block_filter)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 // Permute one probe row with current build chunk
 void NLJoinProbeOperator::_permute_probe_row(RuntimeState* state, const ChunkPtr& chunk) {
     DCHECK(_curr_build_chunk);
     size_t cur_build_chunk_rows = _curr_build_chunk->num_rows();
+    if (!_block_predicates.empty()) {
+        // Only permute the build rows matching the block predicates
+        _block_selection.clear();
+        if (_filter_build_rows()) {
+            for (uint32_t i = 0; i < cur_build_chunk_rows; i++) {
+                if (_block_filter[i]) {
+                    _block_selection.push_back(i);
+                }
+            }
+        }
+        size_t num_matched = _block_selection.size();
+        COUNTER_UPDATE(_block_filtered_rows_counter, cur_build_chunk_rows - num_matched);
+        if (num_matched < cur_build_chunk_rows) {
+            COUNTER_UPDATE(_permute_rows_counter, num_matched);
+            if (num_matched == 0) {
+                return;
+            }
+            for (size_t i = 0; i < _col_types.size(); i++) {
+                bool is_probe = i < _probe_column_count;
+                SlotDescriptor* slot = _col_types[i];
+                ColumnPtr& dst_col = chunk->get_column_by_slot_id(slot->id());
+                if (is_probe) {
+                    ColumnPtr& src_col = _probe_chunk->get_column_by_slot_id(slot->id());
+                    dst_col->append_value_multiple_times(*src_col, _probe_row_current, num_matched);
+                } else {
+                    ColumnPtr& src_col = _curr_build_chunk->get_column_by_slot_id(slot->id());
+                    dst_col->append_selective(*src_col, _block_selection.data(), 0, num_matched);
+                }
+            }
+            return;
+        }
+    }
     COUNTER_UPDATE(_permute_rows_counter, cur_build_chunk_rows);
     for (size_t i = 0; i < _col_types.size(); i++) {
         bool is_probe = i < _probe_column_count;
@@ -566,8 +778,49 @@ void NLJoinProbeOperatorFactory::_init_row_desc() {
 
 OperatorPtr NLJoinProbeOperatorFactory::create(int32_t degree_of_parallelism, int32_t driver_sequence) {
     return std::make_shared<NLJoinProbeOperator>(this, _id, _plan_node_id, driver_sequence, _join_op,
-                                                 _sql_join_conjuncts, _join_conjuncts, _conjunct_ctxs, _col_types,
-                                                 _probe_column_count, _cross_join_context);
+                                                 _sql_join_conjuncts, _probe_join_conjuncts, _block_predicates,
+                                                 _conjunct_ctxs, _col_types, _probe_column_count, _cross_join_context);
+}
+
+void NLJoinProbeOperatorFactory::_init_block_predicates() {
+    _probe_join_conjuncts = _join_conjuncts;
+    // The outer/semi/anti joins depend on the permuted chunk consisting of all the build rows of a probe row
+    if (!config::enable_nljoin_block_predicate ||
+        (_join_op != TJoinOp::INNER_JOIN && _join_op != TJoinOp::CROSS_JOIN)) {
+        return;
+    }
+    std::unordered_set<SlotId> probe_slots;
+    std::unordered_set<SlotId> build_slots;
+    for (size_t i = 0; i < _col_types.size(); i++) {
+        if (i < _probe_column_count) {
+            probe_slots.insert(_col_types[i]->id());
+        } else {
+            build_slots.insert(_col_types[i]->id());
+        }
+    }
+
+    _probe_join_conjuncts.clear();
+    for (ExprContext* ctx : _join_conjuncts) {
+        Expr* root = ctx->root();
+        if (root->node_type() == TExprNodeType::BINARY_PRED && is_block_predicate_op(root->op()) &&
+            root->get_num_children() == 2 && root->get_child(0)->node_type() == TExprNodeType::SLOT_REF &&
+            root->get_child(1)->node_type() == TExprNodeType::SLOT_REF &&
+            root->get_child(0)->type() == root->get_child(1)->type() &&
+            is_block_predicate_type(root->get_child(0)->type().type)) {
+            SlotId left = down_cast<ColumnRef*>(root->get_child(0))->slot_id();
+            SlotId right = down_cast<ColumnRef*>(root->get_child(1))->slot_id();
+            if (build_slots.count(left) && probe_slots.count(right)) {
+                _block_predicates.push_back({left, right, root->get_child(0)->type().type, root->op()});
+                continue;
+            }
+            if (probe_slots.count(left) && build_slots.count(right)) {
+                _block_predicates.push_back(
+                        {right, left, root->get_child(0)->type().type, swap_block_predicate_op(root->op())});
+                continue;
+            }
+        }
+        _probe_join_conjuncts.push_back(ctx);
+    }
 }
 
 Status NLJoinProbeOperatorFactory::prepare(RuntimeState* state) {
@@ -577,6 +830,7 @@ Status NLJoinProbeOperatorFactory::prepare(RuntimeState* state) {
     _cross_join_context->ref();
 
     _init_row_desc();
+    _init_block_predicates();
     RETURN_IF_ERROR(Expr::prepare(_join_conjuncts, state));
     RETURN_IF_ERROR(Expr::open(_join_conjuncts, state));
     RETURN_IF_ERROR(Expr::prepare(_conjunct_ctxs, state));
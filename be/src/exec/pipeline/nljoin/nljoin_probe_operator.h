@@ -25,6 +25,16 @@
 
 namespace starrocks::pipeline {
 
+// A join conjunct `build_slot op probe_slot` comparing two arithmetic columns of the same type, it's evaluated
+// over one probe row and a build chunk before permuting them, so only the matched build rows are permuted.
+struct NLJoinBlockPredicate {
+    SlotId build_slot;
+    SlotId probe_slot;
+    LogicalType type;
+    // One of EQ/NE/LT/LE/GT/GE
+    TExprOpcode::type op;
+};
+
 // NestLoopJoin
 // Implement the block-wise nestloop algorithm, support inner/outer join
 // The algorithm consists of three steps:
@@ -35,9 +45,10 @@ class NLJoinProbeOperator final : public OperatorWithDependency {
 public:
     NLJoinProbeOperator(OperatorFactory* factory, int32_t id, int32_t plan_node_id, int32_t driver_sequence,
                         TJoinOp::type join_op, const std::string& sql_join_conjuncts,
-                        const std::vector<ExprContext*>& join_conjuncts, const std::vector<ExprContext*>& conjunct_ctxs,
-                        const std::vector<SlotDescriptor*>& col_types, size_t probe_column_count,
-                        const std::shared_ptr<NLJoinContext>& cross_join_context);
+                        const std::vector<ExprContext*>& join_conjuncts,
+                        const std::vector<NLJoinBlockPredicate>& block_predicates,
+                        const std::vector<ExprContext*>& conjunct_ctxs, const std::vector<SlotDescriptor*>& col_types,
+                        size_t probe_column_count, const std::shared_ptr<NLJoinContext>& cross_join_context);
 
     ~NLJoinProbeOperator() override = default;
 
@@ -76,6 +87,9 @@ private:
     void _check_post_probe() const;
     void _init_build_match() const;
     void _permute_probe_row(RuntimeState* state, const ChunkPtr& chunk);
+    // Evaluate the block predicates of current probe row over current build chunk into _block_filter,
+    // return false if no build row matched.
+    bool _filter_build_rows();
     ChunkPtr _permute_chunk(RuntimeState* state);
     Status _permute_right_join(RuntimeState* state);
     void _permute_left_join(RuntimeState* state, const ChunkPtr& chunk, size_t probe_row_index, size_t probe_rows);
@@ -95,6 +109,7 @@ private:
 
     const std::string& _sql_join_conjuncts;
     const std::vector<ExprContext*>& _join_conjuncts;
+    const std::vector<NLJoinBlockPredicate>& _block_predicates;
 
     const std::vector<ExprContext*>& _conjunct_ctxs;
     const std::shared_ptr<NLJoinContext>& _cross_join_context;
@@ -117,10 +132,13 @@ private:
     bool _probe_row_finished = false; // For multi build-chunk, whether this probe row is the last
     size_t _probe_row_start = 0;      // Start index of current chunk
     size_t _probe_row_current = 0;    // End index of current chunk
+    Filter _block_filter;
+    std::vector<uint32_t> _block_selection;
 
     // Counters
     RuntimeProfile::Counter* _permute_rows_counter = nullptr;
     RuntimeProfile::Counter* _permute_left_rows_counter = nullptr;
+    RuntimeProfile::Counter* _block_filtered_rows_counter = nullptr;
 };
 
 class NLJoinProbeOperatorFactory final : public OperatorWithDependencyFactory {
@@ -148,6 +166,8 @@ public:
 
 private:
     void _init_row_desc();
+    // Move the join conjuncts which could be block predicates out of _probe_join_conjuncts.
+    void _init_block_predicates();
 
     const TJoinOp::type _join_op;
     const RowDescriptor& _left_row_desc;
@@ -159,6 +179,9 @@ private:
 
     std::string _sql_join_conjuncts;
     std::vector<ExprContext*> _join_conjuncts;
+    // The join conjuncts evaluated on the permuted chunks, excluding the block predicates.
+    std::vector<ExprContext*> _probe_join_conjuncts;
+    std::vector<NLJoinBlockPredicate> _block_predicates;
     std::vector<ExprContext*> _conjunct_ctxs;
 
     std::shared_ptr<NLJoinContext> _cross_join_context;
@@ -22,6 +22,7 @@
 #include "runtime/exec_env.h"
 #include "runtime/runtime_filter_cache.h"
 #include "runtime/runtime_state.h"
+#include "simd/simd.h"
 #include "util/runtime_profile.h"
 
 namespace starrocks::pipeline {
@@ -155,7 +156,9 @@ Status Operator::eval_conjuncts_and_in_filters(const std::vector<ExprContext*>&
         _conjuncts_input_counter->update(before);
         RETURN_IF_ERROR(
                 starrocks::ExecNode::eval_conjuncts(_cached_conjuncts_and_in_filters, chunk, filter, apply_filter));
-        auto after = chunk->num_rows();
+        // the chunk is not filtered yet if the filter isn't applied
+        auto after = (apply_filter || filter == nullptr || *filter == nullptr) ? chunk->num_rows()
+                                                                               : SIMD::count_nonzero(**filter);
         _conjuncts_output_counter->update(after);
     }
 
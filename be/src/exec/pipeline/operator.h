@@ -113,6 +113,10 @@ public:
     // Push chunk to this operator
     virtual Status push_chunk(RuntimeState* state, const ChunkPtr& chunk) = 0;
 
+    // Whether this operator can be pushed a chunk with a selection, see Chunk::selection(). The selection
+    // of the chunks pushed to the other operators is materialized by the driver.
+    virtual bool support_selection() const { return false; }
+
     // reset_state is used by MultilaneOperator in cache mechanism, because lanes in MultilaneOperator are
     // re-used by tablets, before the lane serves for the current tablet, it must invoke reset_state to re-prepare
     // the operators (such as: Project, ChunkAccumulate, DictDecode, Aggregate) that is decorated by MultilaneOperator
@@ -144,7 +148,7 @@ public:
         return strings::Substitute("$0_$1_$2($3)", _name, _plan_node_id, this, is_finished() ? "X" : "O");
     }
 
-    std::string get_raw_name() const { return _name; }
+    const std::string& get_raw_name() const { return _name; }
 
     const LocalRFWaitingSet& rf_waiting_set() const;
 
@@ -227,6 +231,9 @@ public:
     // the memory that can be freed by the current operator
     size_t revocable_mem_bytes() { return _revocable_mem_bytes; }
     void set_revocable_mem_bytes(size_t bytes) { _revocable_mem_bytes = bytes; }
+    // The relative cost to spill a byte of the revocable memory and to restore it, the operators freeing more bytes
+    // per cost spill first when the query is under memory pressure.
+    virtual double spill_cost() const { return 1.0; }
 
 protected:
     OperatorFactory* _factory;
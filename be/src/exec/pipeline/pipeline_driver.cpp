@@ -14,6 +14,8 @@
 
 #include "exec/pipeline/pipeline_driver.h"
 
+#include <fmt/format.h>
+
 #include <sstream>
 
 #include "column/chunk.h"
@@ -30,6 +32,7 @@
 #include "runtime/runtime_state.h"
 #include "util/debug/query_trace.h"
 #include "util/defer_op.h"
+#include "util/pretty_printer.h"
 
 namespace starrocks::pipeline {
 
@@ -69,6 +72,8 @@ Status PipelineDriver::prepare(RuntimeState* runtime_state) {
 
     _peak_driver_queue_size_counter = _runtime_profile->AddHighWaterMarkCounter(
             "PeakDriverQueueSize", TUnit::UNIT, RuntimeProfile::Counter::create_strategy(TUnit::UNIT));
+    _short_query_lane_schedule_counter =
+            ADD_CHILD_COUNTER(_runtime_profile, "ShortQueryLaneScheduleCount", TUnit::UNIT, "ScheduleCount");
 
     DCHECK(_state == DriverState::NOT_READY);
 
@@ -87,6 +92,11 @@ Status PipelineDriver::prepare(RuntimeState* runtime_state) {
 
     const auto use_cache = _fragment_ctx->enable_cache();
     source_op->add_morsel_queue(_morsel_queue);
+    // Whether the source operator supports readiness notification may change at runtime,
+    // so always set the notifier and let the poller decide.
+    if (config::enable_pipeline_driver_readiness_notification) {
+        source_op->set_readiness_notifier([this]() { notify_source_ready(); });
+    }
     // fill OperatorWithDependency instances into _dependencies from _operators.
     DCHECK(_dependencies.empty());
     _dependencies.reserve(_operators.size());
@@ -196,6 +206,12 @@ void PipelineDriver::update_peak_driver_queue_size_counter(size_t new_value) {
     }
 }
 
+void PipelineDriver::incr_short_query_lane_schedule_count() {
+    if (_short_query_lane_schedule_counter != nullptr) {
+        COUNTER_UPDATE(_short_query_lane_schedule_counter, 1);
+    }
+}
+
 static inline bool is_multilane(pipeline::OperatorPtr& op) {
     if (dynamic_cast<query_cache::MultilaneOperator*>(op.get()) != nullptr) {
         return true;
@@ -212,12 +228,23 @@ StatusOr<DriverState> PipelineDriver::process(RuntimeState* runtime_state, int w
     COUNTER_UPDATE(_schedule_counter, 1);
     SCOPED_TIMER(_active_timer);
     QUERY_TRACE_SCOPED("process", _driver_name);
+    if (_ready_queue_enter_ns > 0) {
+        int64_t ready_queue_wait_ns = MonotonicNanos() - _ready_queue_enter_ns;
+        _ready_queue_enter_ns = 0;
+        _ready_queue_wait_hist.add(ready_queue_wait_ns);
+        if (_workgroup != nullptr) {
+            _workgroup->add_driver_ready_queue_wait_ns(ready_queue_wait_ns);
+        }
+    }
     set_driver_state(DriverState::RUNNING);
     size_t total_chunks_moved = 0;
     size_t total_rows_moved = 0;
     int64_t time_spent = 0;
     Status return_status = Status::OK();
-    DeferOp defer([&]() { _update_statistics(total_chunks_moved, total_rows_moved, time_spent); });
+    DeferOp defer([&]() {
+        _time_slice_hist.add(time_spent);
+        _update_statistics(total_chunks_moved, total_rows_moved, time_spent);
+    });
     while (true) {
         RETURN_IF_LIMIT_EXCEEDED(runtime_state, "Pipeline");
 
@@ -252,17 +279,17 @@ StatusOr<DriverState> PipelineDriver::process(RuntimeState* runtime_state, int w
                 }
 
                 // Run spill stragety
-                // TODO: FIXME
-                // a simple spill stragety
+                // the spillable operators of the query are arbitrated by the query spill manager
                 auto query_mem_tracker = _query_ctx->mem_tracker();
                 if (runtime_state->enable_spill() &&
                     sink_operator()->revocable_mem_bytes() > runtime_state->spill_operator_min_bytes() &&
                     !sink_operator()->need_mark_spill()) {
                     auto spill_manager = _query_ctx->spill_manager();
-                    if (query_mem_tracker->consumption() - spill_manager->pending_spilled_bytes() >
-                        query_mem_tracker->limit() * runtime_state->spill_mem_limit_threshold()) {
-                        spill_manager->update_spilled_bytes(sink_operator()->revocable_mem_bytes());
-                        sink_operator()->mark_need_spill();
+                    int64_t used_bytes = query_mem_tracker->consumption() - spill_manager->pending_spilled_bytes();
+                    auto threshold = static_cast<int64_t>(query_mem_tracker->limit() *
+                                                          runtime_state->spill_mem_limit_threshold());
+                    if (used_bytes > threshold) {
+                        _try_mark_sink_spill(spill_manager, used_bytes - threshold);
                     }
                 }
 
@@ -271,6 +298,7 @@ StatusOr<DriverState> PipelineDriver::process(RuntimeState* runtime_state, int w
                 StatusOr<ChunkPtr> maybe_chunk;
                 {
                     SCOPED_THREAD_LOCAL_OPERATOR_MEM_TRACKER_SETTER(curr_op);
+                    SCOPED_SET_OPERATOR_TRACE_INFO(curr_op);
                     SCOPED_TIMER(curr_op->_pull_timer);
                     QUERY_TRACE_SCOPED(curr_op->get_name(), "pull_chunk");
                     maybe_chunk = curr_op->pull_chunk(runtime_state);
@@ -290,12 +318,16 @@ StatusOr<DriverState> PipelineDriver::process(RuntimeState* runtime_state, int w
                     if (maybe_chunk.value() &&
                         (maybe_chunk.value()->num_rows() > 0 ||
                          (maybe_chunk.value()->owner_info().is_last_chunk() && is_multilane(next_op)))) {
-                        size_t row_num = maybe_chunk.value()->num_rows();
+                        size_t row_num = maybe_chunk.value()->num_selected_rows();
                         total_rows_moved += row_num;
                         {
                             SCOPED_THREAD_LOCAL_OPERATOR_MEM_TRACKER_SETTER(next_op);
+                            SCOPED_SET_OPERATOR_TRACE_INFO(next_op);
                             SCOPED_TIMER(next_op->_push_timer);
                             QUERY_TRACE_SCOPED(next_op->get_name(), "push_chunk");
+                            if (maybe_chunk.value()->has_selection() && !next_op->support_selection()) {
+                                maybe_chunk.value()->materialize_selection();
+                            }
                             return_status = next_op->push_chunk(runtime_state, maybe_chunk.value());
                         }
                         // ignore empty chunk generated by per-tablet computation when query cache enabled
@@ -333,12 +365,16 @@ StatusOr<DriverState> PipelineDriver::process(RuntimeState* runtime_state, int w
             if (time_spent >= YIELD_MAX_TIME_SPENT) {
                 should_yield = true;
                 COUNTER_UPDATE(_yield_by_time_limit_counter, 1);
+                if (_workgroup != nullptr) {
+                    _workgroup->incr_driver_yield_by_time_limit();
+                }
                 break;
             }
             if (_workgroup != nullptr && time_spent >= YIELD_PREEMPT_MAX_TIME_SPENT &&
                 _workgroup->driver_sched_entity()->in_queue()->should_yield(this, time_spent)) {
                 should_yield = true;
                 COUNTER_UPDATE(_yield_by_preempt_counter, 1);
+                _workgroup->incr_driver_yield_by_preempt();
                 break;
             }
         }
@@ -432,11 +468,44 @@ void PipelineDriver::cancel_operators(RuntimeState* runtime_state) {
 }
 
 void PipelineDriver::_close_operators(RuntimeState* runtime_state) {
+    if (_is_spill_candidate) {
+        _is_spill_candidate = false;
+        _query_ctx->spill_manager()->remove_spill_candidate(sink_operator());
+    }
     for (auto& op : _operators) {
         _mark_operator_closed(op, runtime_state);
     }
 }
 
+void PipelineDriver::_try_mark_sink_spill(QuerySpillManager* spill_manager, size_t excess_bytes) {
+    auto* sink = sink_operator();
+    const size_t revocable_bytes = sink->revocable_mem_bytes();
+    const double cost = sink->spill_cost();
+    _is_spill_candidate = true;
+    if (!spill_manager->arbitrate_spill(sink, revocable_bytes, cost, excess_bytes)) {
+        return;
+    }
+    // the revocable bytes are counted by the pending spilled bytes until spilled
+    _is_spill_candidate = false;
+    spill_manager->remove_spill_candidate(sink);
+    spill_manager->update_spilled_bytes(revocable_bytes);
+    sink->mark_need_spill();
+    sink->common_metrics()->add_info_string(
+            "SpillArbitration", fmt::format("revocable: {}, cost: {}, query excess: {}",
+                                            PrettyPrinter::print(revocable_bytes, TUnit::BYTES), cost,
+                                            PrettyPrinter::print(excess_bytes, TUnit::BYTES)));
+}
+
+void PipelineDriver::notify_source_ready() {
+    // If it has been notified since the poller reset the flag last time, the driver cannot be waiting for notification.
+    if (_source_ready_notified.exchange(true)) {
+        return;
+    }
+    if (auto* poller = _blocked_driver_poller.load(); poller != nullptr) {
+        poller->on_source_ready(this);
+    }
+}
+
 void PipelineDriver::finalize(RuntimeState* runtime_state, DriverState state) {
     int64_t time_spent = 0;
     // The driver may be destructed after finalizing, so use a temporal driver to record
@@ -445,6 +514,8 @@ void PipelineDriver::finalize(RuntimeState* runtime_state, DriverState state) {
     copied_driver.set_workgroup(_workgroup);
     copied_driver.set_in_queue(_in_queue);
     copied_driver.set_driver_queue_level(_driver_queue_level);
+    copied_driver.set_in_short_query_lane(_in_short_query_lane);
+    copied_driver.set_driver_queue_shard(driver_queue_shard());
     DeferOp defer([&copied_driver, &time_spent]() {
         if (copied_driver._in_queue != nullptr) {
             copied_driver._update_driver_acct(0, 0, time_spent);
@@ -463,6 +534,12 @@ void PipelineDriver::finalize(RuntimeState* runtime_state, DriverState state) {
     COUNTER_UPDATE(_total_timer, _total_timer_sw->elapsed_time());
     COUNTER_UPDATE(_schedule_timer, _total_timer->value() - _active_timer->value() - _pending_timer->value());
     _update_overhead_timer();
+    if (_ready_queue_wait_hist.total_count() > 0) {
+        _runtime_profile->add_info_string("ReadyQueueWaitHistogram", _ready_queue_wait_hist.to_string());
+    }
+    if (_time_slice_hist.total_count() > 0) {
+        _runtime_profile->add_info_string("TimeSliceHistogram", _time_slice_hist.to_string());
+    }
 
     // Acquire the pointer to avoid be released when removing query
     auto query_trace = _query_ctx->shared_query_trace();
@@ -549,6 +626,7 @@ Status PipelineDriver::_mark_operator_finishing(OperatorPtr& op, RuntimeState* s
                                     print_id(state->fragment_instance_id()), to_readable_string(), op->get_name());
     {
         SCOPED_THREAD_LOCAL_OPERATOR_MEM_TRACKER_SETTER(op);
+        SCOPED_SET_OPERATOR_TRACE_INFO(op);
         SCOPED_TIMER(op->_finishing_timer);
         op_state = OperatorStage::FINISHING;
         QUERY_TRACE_SCOPED(op->get_name(), "set_finishing");
@@ -567,6 +645,7 @@ Status PipelineDriver::_mark_operator_finished(OperatorPtr& op, RuntimeState* st
                                     print_id(state->fragment_instance_id()), to_readable_string(), op->get_name());
     {
         SCOPED_THREAD_LOCAL_OPERATOR_MEM_TRACKER_SETTER(op);
+        SCOPED_SET_OPERATOR_TRACE_INFO(op);
         SCOPED_TIMER(op->_finished_timer);
         op_state = OperatorStage::FINISHED;
         QUERY_TRACE_SCOPED(op->get_name(), "set_finished");
@@ -590,6 +669,7 @@ Status PipelineDriver::_mark_operator_cancelled(OperatorPtr& op, RuntimeState* s
                                     print_id(state->fragment_instance_id()), to_readable_string(), op->get_name());
     {
         SCOPED_THREAD_LOCAL_OPERATOR_MEM_TRACKER_SETTER(op);
+        SCOPED_SET_OPERATOR_TRACE_INFO(op);
         op_state = OperatorStage::CANCELLED;
         return op->set_cancelled(state);
     }
@@ -611,6 +691,7 @@ Status PipelineDriver::_mark_operator_closed(OperatorPtr& op, RuntimeState* stat
                                     print_id(state->fragment_instance_id()), to_readable_string(), op->get_name());
     {
         SCOPED_THREAD_LOCAL_OPERATOR_MEM_TRACKER_SETTER(op);
+        SCOPED_SET_OPERATOR_TRACE_INFO(op);
         SCOPED_TIMER(op->_close_timer);
         op_state = OperatorStage::CLOSED;
         QUERY_TRACE_SCOPED(op->get_name(), "close");
@@ -30,7 +30,9 @@
 #include "exec/pipeline/source_operator.h"
 #include "exec/workgroup/work_group_fwd.h"
 #include "fmt/printf.h"
+#include "util/latency_histogram.h"
 #include "util/phmap/phmap.h"
+#include "util/time.h"
 
 namespace starrocks {
 
@@ -48,6 +50,7 @@ using Drivers = std::vector<DriverPtr>;
 using IterateImmutableDriverFunc = std::function<void(DriverConstRawPtr)>;
 using ImmutableDriverPredicateFunc = std::function<bool(DriverConstRawPtr)>;
 class DriverQueue;
+class PipelineDriverPoller;
 
 enum DriverState : uint32_t {
     NOT_READY = 0,
@@ -392,9 +395,26 @@ public:
     void set_in_queue(DriverQueue* in_queue) { _in_queue = in_queue; }
     size_t get_driver_queue_level() const { return _driver_queue_level; }
     void set_driver_queue_level(size_t driver_queue_level) { _driver_queue_level = driver_queue_level; }
+    // Whether the driver is in the short-query lane of QuerySharedDriverQueue instead of the multi-level queues.
+    bool is_in_short_query_lane() const { return _in_short_query_lane; }
+    void set_in_short_query_lane(bool in_short_query_lane) { _in_short_query_lane = in_short_query_lane; }
+    void incr_short_query_lane_schedule_count();
+
+    // Called by the source operator supporting readiness notification, when it may have output or become finished,
+    // to wake up the driver waiting for this notification in PipelineDriverPoller.
+    void notify_source_ready();
+
+    // The shard of WorkStealingDriverQueue which this driver belongs to, or -1 if it hasn't been assigned.
+    int driver_queue_shard() const { return _driver_queue_shard.load(std::memory_order_acquire); }
+    void set_driver_queue_shard(int shard) { _driver_queue_shard.store(shard, std::memory_order_release); }
 
     inline bool is_in_ready_queue() const { return _in_ready_queue.load(std::memory_order_acquire); }
-    void set_in_ready_queue(bool v) { _in_ready_queue.store(v, std::memory_order_release); }
+    void set_in_ready_queue(bool v) {
+        if (v) {
+            _ready_queue_enter_ns = MonotonicNanos();
+        }
+        _in_ready_queue.store(v, std::memory_order_release);
+    }
 
     inline std::string get_name() const { return strings::Substitute("PipelineDriver (id=$0)", _driver_id); }
 
@@ -432,6 +452,8 @@ protected:
     Status _mark_operator_cancelled(OperatorPtr& op, RuntimeState* runtime_state);
     Status _mark_operator_closed(OperatorPtr& op, RuntimeState* runtime_state);
     void _close_operators(RuntimeState* runtime_state);
+    // Mark the sink operator to spill if it's chosen by the spill arbitration of the query.
+    void _try_mark_sink_spill(QuerySpillManager* spill_manager, size_t excess_bytes);
 
     // Update metrics when the driver yields.
     void _update_driver_acct(size_t total_chunks_moved, size_t total_rows_moved, size_t time_spent);
@@ -472,7 +494,17 @@ protected:
     DriverQueue* _in_queue = nullptr;
     // The index of QuerySharedDriverQueue._queues which this driver belongs to.
     size_t _driver_queue_level = 0;
+    bool _in_short_query_lane = false;
+    // Whether the sink operator is a spill candidate of the query spill manager.
+    bool _is_spill_candidate = false;
+    std::atomic<int> _driver_queue_shard{-1};
+    // The poller which the driver is added to when it is blocked.
+    std::atomic<PipelineDriverPoller*> _blocked_driver_poller{nullptr};
+    // Set by notify_source_ready(), and reset by the poller before checking whether the driver is still blocked.
+    std::atomic<bool> _source_ready_notified{false};
     std::atomic<bool> _in_ready_queue{false};
+    // The time when the driver is put into the ready queue, used to record the ready queue wait latency.
+    int64_t _ready_queue_enter_ns = 0;
 
     // metrics
     RuntimeProfile::Counter* _total_timer = nullptr;
@@ -504,6 +536,11 @@ protected:
     MonotonicStopWatch* _pending_finish_timer_sw = nullptr;
 
     RuntimeProfile::HighWaterMarkCounter* _peak_driver_queue_size_counter = nullptr;
+    RuntimeProfile::Counter* _short_query_lane_schedule_counter = nullptr;
+
+    // Latency distribution of waiting in the ready queue and running on-core per schedule.
+    LatencyHistogram _ready_queue_wait_hist;
+    LatencyHistogram _time_slice_hist;
 };
 
 } // namespace pipeline
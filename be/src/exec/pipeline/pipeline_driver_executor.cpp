@@ -20,7 +20,9 @@
 #include "exec/workgroup/work_group.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/current_thread.h"
+#include "runtime/query_cpu_profiler.h"
 #include "util/debug/query_trace.h"
+#include "util/cpu_info.h"
 #include "util/defer_op.h"
 #include "util/stack_util.h"
 
@@ -29,12 +31,26 @@ namespace starrocks::pipeline {
 GlobalDriverExecutor::GlobalDriverExecutor(const std::string& name, std::unique_ptr<ThreadPool> thread_pool,
                                            bool enable_resource_group)
         : Base(name),
-          _driver_queue(enable_resource_group ? std::unique_ptr<DriverQueue>(std::make_unique<WorkGroupDriverQueue>())
-                                              : std::make_unique<QuerySharedDriverQueue>()),
+          _driver_queue(_create_driver_queue(enable_resource_group)),
           _thread_pool(std::move(thread_pool)),
           _blocked_driver_poller(new PipelineDriverPoller(_driver_queue.get())),
           _exec_state_reporter(new ExecStateReporter()) {}
 
+std::unique_ptr<DriverQueue> GlobalDriverExecutor::_create_driver_queue(bool enable_resource_group) {
+    if (enable_resource_group) {
+        return std::make_unique<WorkGroupDriverQueue>();
+    }
+    if (config::pipeline_driver_queue_enable_work_stealing || config::enable_pipeline_numa_aware_executor) {
+        int64_t num_shards = CpuInfo::num_cores();
+        if (config::pipeline_exec_thread_pool_thread_num > 0) {
+            num_shards = config::pipeline_exec_thread_pool_thread_num;
+        }
+        size_t num_numa_nodes = config::enable_pipeline_numa_aware_executor ? CpuInfo::get_max_num_numa_nodes() : 1;
+        return std::make_unique<WorkStealingDriverQueue>(std::max<int64_t>(1, num_shards), num_numa_nodes);
+    }
+    return std::make_unique<QuerySharedDriverQueue>();
+}
+
 GlobalDriverExecutor::~GlobalDriverExecutor() {
     {
         // unregist hook
@@ -87,6 +103,10 @@ void GlobalDriverExecutor::_finalize_driver(DriverRawPtr driver, RuntimeState* r
 
 void GlobalDriverExecutor::_worker_thread() {
     const int worker_id = _next_id++;
+    if (auto* ws_queue = dynamic_cast<WorkStealingDriverQueue*>(_driver_queue.get());
+        ws_queue != nullptr && config::enable_pipeline_numa_aware_executor && CpuInfo::get_max_num_numa_nodes() > 1) {
+        CpuInfo::bind_current_thread_to_numa_node(ws_queue->numa_node_of_worker(worker_id));
+    }
     while (true) {
         if (_num_threads_setter.should_shrink()) {
             break;
@@ -96,7 +116,7 @@ void GlobalDriverExecutor::_worker_thread() {
         CurrentThread::current().set_fragment_instance_id({});
         CurrentThread::current().set_pipeline_driver_id(0);
 
-        auto maybe_driver = this->_driver_queue->take();
+        auto maybe_driver = this->_driver_queue->take(worker_id);
         if (maybe_driver.status().is_cancelled()) {
             return;
         }
@@ -109,6 +129,7 @@ void GlobalDriverExecutor::_worker_thread() {
         driver->increment_schedule_times();
 
         SCOPED_SET_TRACE_INFO(driver->driver_id(), query_ctx->query_id(), fragment_ctx->fragment_instance_id());
+        SCOPED_IO_STATS(&fragment_ctx->io_stats());
 
         SET_THREAD_LOCAL_QUERY_TRACE_CONTEXT(query_ctx->query_trace(), fragment_ctx->fragment_instance_id(), driver);
 
@@ -232,6 +253,11 @@ void GlobalDriverExecutor::cancel(DriverRawPtr driver) {
 
 void GlobalDriverExecutor::report_exec_state(QueryContext* query_ctx, FragmentContext* fragment_ctx,
                                              const Status& status, bool done) {
+    if (done && query_ctx->is_report_profile()) {
+        QueryCpuProfiler::instance()->attach_to_profile(query_ctx->query_id(), fragment_ctx->fragment_instance_id(),
+                                                        fragment_ctx->runtime_state()->runtime_profile());
+        fragment_ctx->io_stats().to_profile(fragment_ctx->runtime_state()->runtime_profile());
+    }
     _update_profile_by_level(query_ctx, fragment_ctx, done);
     auto params = ExecStateReporter::create_report_exec_status_params(query_ctx, fragment_ctx, status, done);
     auto fe_addr = fragment_ctx->fe_addr();
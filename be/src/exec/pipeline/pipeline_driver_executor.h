@@ -83,6 +83,7 @@ public:
 
 private:
     using Base = FactoryMethod<DriverExecutor, GlobalDriverExecutor>;
+    static std::unique_ptr<DriverQueue> _create_driver_queue(bool enable_resource_group);
     void _worker_thread();
     void _finalize_driver(DriverRawPtr driver, RuntimeState* runtime_state, DriverState state);
     void _update_profile_by_level(QueryContext* query_ctx, FragmentContext* fragment_ctx, bool done);
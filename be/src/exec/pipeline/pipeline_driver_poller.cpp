@@ -15,6 +15,9 @@
 #include "pipeline_driver_poller.h"
 
 #include <chrono>
+
+#include "util/time.h"
+
 namespace starrocks::pipeline {
 
 void PipelineDriverPoller::start() {
@@ -42,7 +45,15 @@ void PipelineDriverPoller::run_internal() {
     DriverList tmp_blocked_drivers;
     int spin_count = 0;
     std::vector<DriverRawPtr> ready_drivers;
+    std::vector<DriverRawPtr> notified_waiting_drivers;
+    int64_t last_recheck_ns = MonotonicNanos();
     while (!_is_shutdown.load(std::memory_order_acquire)) {
+        if (int64_t now = MonotonicNanos();
+            now - last_recheck_ns >= config::pipeline_poller_notified_driver_check_interval_ms * 1'000'000L) {
+            last_recheck_ns = now;
+            _recheck_notified_waiting_drivers();
+        }
+
         {
             std::unique_lock<std::mutex> lock(_global_mutex);
             tmp_blocked_drivers.splice(tmp_blocked_drivers.end(), _blocked_drivers);
@@ -50,6 +61,10 @@ void PipelineDriverPoller::run_internal() {
                 std::cv_status cv_status = std::cv_status::no_timeout;
                 while (!_is_shutdown.load(std::memory_order_acquire) && this->_blocked_drivers.empty()) {
                     cv_status = _cond.wait_for(lock, std::chrono::milliseconds(10));
+                    // The drivers waiting for notification still need to be rechecked periodically.
+                    if (cv_status == std::cv_status::timeout && !_notified_waiting_drivers.empty()) {
+                        break;
+                    }
                 }
                 if (cv_status == std::cv_status::timeout) {
                     continue;
@@ -139,12 +154,31 @@ void PipelineDriverPoller::run_internal() {
                     driver->set_driver_state(DriverState::READY);
                     remove_blocked_driver(_local_blocked_drivers, driver_it);
                     ready_drivers.emplace_back(driver);
+                } else if (_can_wait_for_notification(driver)) {
+                    // Reset the notified flag before checking again, so that the notification coming after
+                    // the check cannot be missed.
+                    driver->_source_ready_notified = false;
+                    if (driver->is_not_blocked()) {
+                        driver->set_driver_state(DriverState::READY);
+                        remove_blocked_driver(_local_blocked_drivers, driver_it);
+                        ready_drivers.emplace_back(driver);
+                    } else if (driver->driver_state() == DriverState::INPUT_EMPTY) {
+                        notified_waiting_drivers.emplace_back(driver);
+                        _local_blocked_drivers.erase(driver_it++);
+                    } else {
+                        ++driver_it;
+                    }
                 } else {
                     ++driver_it;
                 }
             }
         }
 
+        if (!notified_waiting_drivers.empty()) {
+            _wait_for_notification(notified_waiting_drivers);
+            notified_waiting_drivers.clear();
+        }
+
         if (ready_drivers.empty()) {
             spin_count += 1;
         } else {
@@ -169,7 +203,41 @@ void PipelineDriverPoller::run_internal() {
     }
 }
 
+bool PipelineDriverPoller::_can_wait_for_notification(const DriverRawPtr driver) {
+    return driver->driver_state() == DriverState::INPUT_EMPTY &&
+           driver->source_operator()->support_readiness_notification() && !driver->is_query_never_expired();
+}
+
+void PipelineDriverPoller::_wait_for_notification(std::vector<DriverRawPtr>& drivers) {
+    std::unique_lock<std::mutex> lock(_global_mutex);
+    for (auto* driver : drivers) {
+        if (driver->_source_ready_notified) {
+            // The driver has been notified after checking it, so check it again.
+            _blocked_drivers.push_back(driver);
+        } else {
+            _notified_waiting_drivers.emplace(driver);
+        }
+    }
+}
+
+void PipelineDriverPoller::_recheck_notified_waiting_drivers() {
+    std::unique_lock<std::mutex> lock(_global_mutex);
+    for (auto* driver : _notified_waiting_drivers) {
+        _blocked_drivers.push_back(driver);
+    }
+    _notified_waiting_drivers.clear();
+}
+
+void PipelineDriverPoller::on_source_ready(const DriverRawPtr driver) {
+    std::unique_lock<std::mutex> lock(_global_mutex);
+    if (_notified_waiting_drivers.erase(driver) > 0) {
+        _blocked_drivers.push_back(driver);
+        _cond.notify_one();
+    }
+}
+
 void PipelineDriverPoller::add_blocked_driver(const DriverRawPtr driver) {
+    driver->_blocked_driver_poller = this;
     std::unique_lock<std::mutex> lock(_global_mutex);
     _blocked_drivers.push_back(driver);
     driver->_pending_timer_sw->reset();
@@ -225,8 +293,14 @@ void PipelineDriverPoller::remove_blocked_driver(DriverList& local_blocked_drive
 }
 
 void PipelineDriverPoller::iterate_immutable_driver(const IterateImmutableDriverFunc& call) const {
-    std::shared_lock guard(_local_mutex);
-    for (auto* driver : _local_blocked_drivers) {
+    {
+        std::shared_lock guard(_local_mutex);
+        for (auto* driver : _local_blocked_drivers) {
+            call(driver);
+        }
+    }
+    std::lock_guard<std::mutex> lock(_global_mutex);
+    for (auto* driver : _notified_waiting_drivers) {
         call(driver);
     }
 }
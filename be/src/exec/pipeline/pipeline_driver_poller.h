@@ -19,6 +19,7 @@
 #include <list>
 #include <memory>
 #include <mutex>
+#include <unordered_set>
 
 #include "pipeline_driver.h"
 #include "pipeline_driver_queue.h"
@@ -55,16 +56,31 @@ public:
     size_t activate_parked_driver(const ImmutableDriverPredicateFunc& predicate_func);
     size_t calculate_parked_driver(const ImmutableDriverPredicateFunc& predicate_func) const;
 
+    // Called by PipelineDriver::notify_source_ready(), when the source operator of the driver may become ready.
+    // If the driver is waiting for notification, move it back to the blocked drivers to be checked by the poller.
+    void on_source_ready(const DriverRawPtr driver);
+
     // only used for collect metrics
     size_t blocked_driver_queue_len() const {
+        size_t num_notified_waiting_drivers = 0;
+        {
+            std::lock_guard<std::mutex> lock(_global_mutex);
+            num_notified_waiting_drivers = _notified_waiting_drivers.size();
+        }
         std::shared_lock guard(_local_mutex);
-        return _local_blocked_drivers.size();
+        return _local_blocked_drivers.size() + num_notified_waiting_drivers;
     }
 
     void iterate_immutable_driver(const IterateImmutableDriverFunc& call) const;
 
 private:
     void run_internal();
+    // Whether the driver only waits for its source operator, which supports readiness notification.
+    static bool _can_wait_for_notification(const DriverRawPtr driver);
+    // Move the drivers to _notified_waiting_drivers, unless they have been notified.
+    void _wait_for_notification(std::vector<DriverRawPtr>& drivers);
+    // Move all the drivers waiting for notification back to _blocked_drivers.
+    void _recheck_notified_waiting_drivers();
     PipelineDriverPoller(const PipelineDriverPoller&) = delete;
     PipelineDriverPoller& operator=(const PipelineDriverPoller&) = delete;
 
@@ -72,6 +88,8 @@ private:
     mutable std::mutex _global_mutex;
     std::condition_variable _cond;
     DriverList _blocked_drivers;
+    // The drivers waiting for readiness notification of their source operators, which needn't be polled.
+    std::unordered_set<DriverRawPtr> _notified_waiting_drivers;
 
     mutable std::shared_mutex _local_mutex;
     DriverList _local_blocked_drivers;
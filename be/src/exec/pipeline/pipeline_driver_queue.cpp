@@ -17,11 +17,13 @@
 #include "exec/pipeline/source_operator.h"
 #include "exec/workgroup/work_group.h"
 #include "gutil/strings/substitute.h"
+#include "util/hash_util.hpp"
 
 namespace starrocks::pipeline {
 
 /// QuerySharedDriverQueue.
-QuerySharedDriverQueue::QuerySharedDriverQueue() {
+QuerySharedDriverQueue::QuerySharedDriverQueue(bool enable_short_query_lane)
+        : _enable_short_query_lane(enable_short_query_lane) {
     double factor = 1;
     for (int i = QUEUE_SIZE - 1; i >= 0; --i) {
         // initialize factor for every sub queue,
@@ -46,33 +48,31 @@ void QuerySharedDriverQueue::close() {
 
 void QuerySharedDriverQueue::put_back(const DriverRawPtr driver) {
     int level = _compute_driver_level(driver);
-    driver->set_driver_queue_level(level);
-    {
-        std::lock_guard<std::mutex> lock(_global_mutex);
-        _queues[level].put(driver);
-        driver->set_in_ready_queue(true);
-        driver->set_in_queue(this);
-        driver->update_peak_driver_queue_size_counter(_num_drivers);
-        _cv.notify_one();
-        ++_num_drivers;
-    }
+    std::lock_guard<std::mutex> lock(_global_mutex);
+    _put_back_locked(driver, level);
+    _cv.notify_one();
 }
 
 void QuerySharedDriverQueue::put_back(const std::vector<DriverRawPtr>& drivers) {
     std::vector<int> levels(drivers.size());
     for (int i = 0; i < drivers.size(); i++) {
         levels[i] = _compute_driver_level(drivers[i]);
-        drivers[i]->set_driver_queue_level(levels[i]);
     }
     std::lock_guard<std::mutex> lock(_global_mutex);
     for (int i = 0; i < drivers.size(); i++) {
-        _queues[levels[i]].put(drivers[i]);
-        drivers[i]->set_in_ready_queue(true);
-        drivers[i]->set_in_queue(this);
-        drivers[i]->update_peak_driver_queue_size_counter(_num_drivers);
+        _put_back_locked(drivers[i], levels[i]);
         _cv.notify_one();
     }
-    _num_drivers += drivers.size();
+}
+
+void QuerySharedDriverQueue::_put_back_locked(const DriverRawPtr driver, int level) {
+    driver->set_driver_queue_level(level);
+    driver->set_in_short_query_lane(_enable_short_query_lane && _is_short_query(driver));
+    _sub_queue_of(driver).put(driver);
+    driver->set_in_ready_queue(true);
+    driver->set_in_queue(this);
+    driver->update_peak_driver_queue_size_counter(_num_drivers);
+    ++_num_drivers;
 }
 
 void QuerySharedDriverQueue::put_back_from_executor(const DriverRawPtr driver) {
@@ -81,43 +81,53 @@ void QuerySharedDriverQueue::put_back_from_executor(const DriverRawPtr driver) {
 }
 
 StatusOr<DriverRawPtr> QuerySharedDriverQueue::take() {
+    std::unique_lock<std::mutex> lock(_global_mutex);
+    while (true) {
+        if (_is_closed) {
+            return Status::Cancelled("Shutdown");
+        }
+        if (auto* driver_ptr = _take_locked(); driver_ptr != nullptr) {
+            // next pipeline driver to execute.
+            return driver_ptr;
+        }
+        _cv.wait(lock);
+    }
+}
+
+DriverRawPtr QuerySharedDriverQueue::_take_locked() {
+    // The short-query lane takes precedence over the multi-level queues.
+    if (!_short_query_lane.empty()) {
+        if (DriverRawPtr driver_ptr = _short_query_lane.take(); driver_ptr != nullptr) {
+            driver_ptr->set_in_ready_queue(false);
+            driver_ptr->incr_short_query_lane_schedule_count();
+            --_num_drivers;
+            return driver_ptr;
+        }
+    }
+
     // -1 means no candidates; else has candidate.
     int queue_idx = -1;
     double target_accu_time = 0;
-    DriverRawPtr driver_ptr;
 
-    {
-        std::unique_lock<std::mutex> lock(_global_mutex);
-        while (true) {
-            if (_is_closed) {
-                return Status::Cancelled("Shutdown");
-            }
-
-            // Find the queue with the smallest execution time.
-            for (int i = 0; i < QUEUE_SIZE; ++i) {
-                // we just search for queue has element
-                if (!_queues[i].empty()) {
-                    double local_target_time = _queues[i].accu_time_after_divisor();
-                    if (queue_idx < 0 || local_target_time < target_accu_time) {
-                        target_accu_time = local_target_time;
-                        queue_idx = i;
-                    }
-                }
-            }
-
-            if (queue_idx >= 0) {
-                break;
+    // Find the queue with the smallest execution time.
+    for (int i = 0; i < QUEUE_SIZE; ++i) {
+        // we just search for queue has element
+        if (!_queues[i].empty()) {
+            double local_target_time = _queues[i].accu_time_after_divisor();
+            if (queue_idx < 0 || local_target_time < target_accu_time) {
+                target_accu_time = local_target_time;
+                queue_idx = i;
             }
-            _cv.wait(lock);
         }
-        // record queue's index to accumulate time for it.
-        driver_ptr = _queues[queue_idx].take();
-        driver_ptr->set_in_ready_queue(false);
-
-        --_num_drivers;
+    }
+    if (queue_idx < 0) {
+        return nullptr;
     }
 
-    // next pipeline driver to execute.
+    // record queue's index to accumulate time for it.
+    DriverRawPtr driver_ptr = _queues[queue_idx].take();
+    driver_ptr->set_in_ready_queue(false);
+    --_num_drivers;
     return driver_ptr;
 }
 
@@ -129,8 +139,7 @@ void QuerySharedDriverQueue::cancel(DriverRawPtr driver) {
     if (!driver->is_in_ready_queue()) {
         return;
     }
-    int level = driver->get_driver_queue_level();
-    _queues[level].cancel(driver);
+    _sub_queue_of(driver).cancel(driver);
     _cv.notify_one();
 }
 
@@ -143,7 +152,19 @@ size_t QuerySharedDriverQueue::size() const {
 void QuerySharedDriverQueue::update_statistics(const DriverRawPtr driver) {
     std::lock_guard<std::mutex> lock(_global_mutex);
 
-    _queues[driver->get_driver_queue_level()].update_accu_time(driver);
+    _sub_queue_of(driver).update_accu_time(driver);
+}
+
+bool QuerySharedDriverQueue::_is_short_query(const DriverRawPtr driver) const {
+    const auto* query_ctx = driver->query_ctx();
+    return query_ctx != nullptr && query_ctx->cpu_cost() < config::pipeline_short_query_lane_cpu_budget_ns;
+}
+
+SubQuerySharedDriverQueue& QuerySharedDriverQueue::_sub_queue_of(const DriverRawPtr driver) {
+    if (driver->is_in_short_query_lane()) {
+        return _short_query_lane;
+    }
+    return _queues[driver->get_driver_queue_level()];
 }
 
 int QuerySharedDriverQueue::_compute_driver_level(const DriverRawPtr driver) const {
@@ -197,6 +218,175 @@ DriverRawPtr SubQuerySharedDriverQueue::take() {
     return nullptr;
 }
 
+/// WorkStealingDriverQueue.
+WorkStealingDriverQueue::WorkStealingDriverQueue(size_t num_shards, size_t num_numa_nodes)
+        : _num_numa_nodes(std::clamp<size_t>(num_numa_nodes, 1, std::max<size_t>(1, num_shards))) {
+    num_shards = std::max<size_t>(1, num_shards);
+    _shards.reserve(num_shards);
+    for (size_t i = 0; i < num_shards; ++i) {
+        _shards.emplace_back(std::make_unique<QuerySharedDriverQueue>());
+    }
+
+    _steal_orders.resize(num_shards);
+    for (size_t i = 0; i < num_shards; ++i) {
+        auto& steal_order = _steal_orders[i];
+        steal_order.reserve(num_shards - 1);
+        for (size_t j = 1; j < num_shards; ++j) {
+            if (size_t victim = (i + j) % num_shards; victim % _num_numa_nodes == i % _num_numa_nodes) {
+                steal_order.emplace_back(victim);
+            }
+        }
+        for (size_t j = 1; j < num_shards; ++j) {
+            if (size_t victim = (i + j) % num_shards; victim % _num_numa_nodes != i % _num_numa_nodes) {
+                steal_order.emplace_back(victim);
+            }
+        }
+    }
+}
+
+void WorkStealingDriverQueue::close() {
+    _is_closed = true;
+    std::lock_guard<std::mutex> lock(_idle_mutex);
+    _idle_cv.notify_all();
+}
+
+void WorkStealingDriverQueue::put_back(const DriverRawPtr driver) {
+    _put_back_to_shard(driver, _shard_of_driver(driver));
+}
+
+void WorkStealingDriverQueue::put_back(const std::vector<DriverRawPtr>& drivers) {
+    for (auto* driver : drivers) {
+        _put_back_to_shard(driver, _shard_of_driver(driver));
+    }
+}
+
+void WorkStealingDriverQueue::put_back_from_executor(const DriverRawPtr driver) {
+    // The shard of the driver has been set to the shard of the executor thread when taking it.
+    _put_back_to_shard(driver, _shard_of_driver(driver));
+}
+
+StatusOr<DriverRawPtr> WorkStealingDriverQueue::take() {
+    return take(0);
+}
+
+StatusOr<DriverRawPtr> WorkStealingDriverQueue::take(int worker_id) {
+    const int num_shards = _shards.size();
+    const int local_shard_idx = worker_id % num_shards;
+    while (true) {
+        if (_is_closed) {
+            return Status::Cancelled("Shutdown");
+        }
+
+        // Take from the local shard first, and then steal from the others.
+        if (auto* driver = _try_take_from_shard(local_shard_idx, local_shard_idx, false); driver != nullptr) {
+            return driver;
+        }
+        for (int victim_shard_idx : _steal_orders[local_shard_idx]) {
+            if (auto* driver = _try_take_from_shard(victim_shard_idx, local_shard_idx, true); driver != nullptr) {
+                return driver;
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(_idle_mutex);
+        // _num_idle_workers must be increased before checking _num_drivers, and _put_back_to_shard increases
+        // _num_drivers before checking _num_idle_workers, so that a new driver cannot be missed.
+        ++_num_idle_workers;
+        if (_num_drivers.load() == 0 && !_is_closed) {
+            _idle_cv.wait_for(lock, std::chrono::microseconds(IDLE_WAIT_TIMEOUT_US));
+        }
+        --_num_idle_workers;
+    }
+}
+
+void WorkStealingDriverQueue::cancel(DriverRawPtr driver) {
+    if (_is_closed) {
+        return;
+    }
+    // The driver may move to another shard concurrently, so check the shard again under the lock of the shard.
+    while (driver->is_in_ready_queue()) {
+        int shard_idx = driver->driver_queue_shard();
+        if (shard_idx < 0) {
+            return;
+        }
+        auto* shard = _shards[shard_idx].get();
+        std::lock_guard<std::mutex> lock(shard->_global_mutex);
+        if (driver->driver_queue_shard() != shard_idx) {
+            continue;
+        }
+        if (driver->is_in_ready_queue()) {
+            shard->_sub_queue_of(driver).cancel(driver);
+        }
+        return;
+    }
+}
+
+void WorkStealingDriverQueue::update_statistics(const DriverRawPtr driver) {
+    _shards[_shard_of_driver(driver)]->update_statistics(driver);
+}
+
+void WorkStealingDriverQueue::_put_back_to_shard(const DriverRawPtr driver, int shard_idx) {
+    auto* shard = _shards[shard_idx].get();
+    int level = shard->_compute_driver_level(driver);
+    {
+        std::lock_guard<std::mutex> lock(shard->_global_mutex);
+        driver->set_driver_queue_shard(shard_idx);
+        shard->_put_back_locked(driver, level);
+        driver->set_in_queue(this);
+    }
+    ++_num_drivers;
+    _notify_idle_worker();
+}
+
+DriverRawPtr WorkStealingDriverQueue::_try_take_from_shard(int shard_idx, int taker_shard_idx, bool try_lock) {
+    auto* shard = _shards[shard_idx].get();
+    if (shard->_num_drivers == 0) {
+        return nullptr;
+    }
+
+    std::unique_lock<std::mutex> lock(shard->_global_mutex, std::defer_lock);
+    if (try_lock) {
+        if (!lock.try_lock()) {
+            return nullptr;
+        }
+    } else {
+        lock.lock();
+    }
+
+    auto* driver = shard->_take_locked();
+    if (driver != nullptr) {
+        // The driver will be put back to the shard of the executor thread which runs it.
+        driver->set_driver_queue_shard(taker_shard_idx);
+        --_num_drivers;
+    }
+    return driver;
+}
+
+void WorkStealingDriverQueue::_notify_idle_worker() {
+    if (_num_idle_workers.load() > 0) {
+        std::lock_guard<std::mutex> lock(_idle_mutex);
+        _idle_cv.notify_one();
+    }
+}
+
+int WorkStealingDriverQueue::_shard_of_driver(const DriverRawPtr driver) {
+    int shard_idx = driver->driver_queue_shard();
+    if (shard_idx >= 0 && shard_idx < _shards.size()) {
+        return shard_idx;
+    }
+
+    // The driver has never been taken by any executor thread, so dispatch it in round-robin.
+    size_t next_shard = _next_shard.fetch_add(1);
+    if (_num_numa_nodes <= 1 || driver->fragment_ctx() == nullptr) {
+        return next_shard % _shards.size();
+    }
+    // Dispatch the drivers of the same fragment instance to the shards of the same NUMA node,
+    // so that the chunks are produced and consumed in the same node as possible.
+    const auto& instance_id = driver->fragment_ctx()->fragment_instance_id();
+    size_t numa_node = HashUtil::hash(&instance_id, sizeof(instance_id), 0) % _num_numa_nodes;
+    size_t num_shards_of_node = (_shards.size() - numa_node + _num_numa_nodes - 1) / _num_numa_nodes;
+    return numa_node + (next_shard % num_shards_of_node) * _num_numa_nodes;
+}
+
 /// WorkGroupDriverQueue.
 bool WorkGroupDriverQueue::WorkGroupDriverSchedEntityComparator::operator()(
         const WorkGroupDriverSchedEntityPtr& lhs_ptr, const WorkGroupDriverSchedEntityPtr& rhs_ptr) const {
@@ -36,6 +36,9 @@ public:
     virtual void put_back_from_executor(const DriverRawPtr driver) = 0;
 
     virtual StatusOr<DriverRawPtr> take() = 0;
+    // *worker_id* is the id of the executor thread taking the driver,
+    // which can be used by the queue to keep the driver on the same thread.
+    virtual StatusOr<DriverRawPtr> take(int worker_id) { return take(); }
     virtual void cancel(DriverRawPtr driver) = 0;
 
     // Update statistics of the driver's workgroup,
@@ -97,9 +100,13 @@ private:
 
 class QuerySharedDriverQueue : public FactoryMethod<DriverQueue, QuerySharedDriverQueue> {
     friend class FactoryMethod<DriverQueue, QuerySharedDriverQueue>;
+    friend class WorkStealingDriverQueue;
 
 public:
-    QuerySharedDriverQueue();
+    // When *enable_short_query_lane* is true, the drivers of the queries which have used less than
+    // pipeline_short_query_lane_cpu_budget_ns CPU time are put into the short-query lane,
+    // which takes precedence over the multi-level queues.
+    explicit QuerySharedDriverQueue(bool enable_short_query_lane = false);
     ~QuerySharedDriverQueue() override = default;
     void close() override;
     void put_back(const DriverRawPtr driver) override;
@@ -124,6 +131,14 @@ private:
     // When the driver at the i-th level costs _level_time_slices[i],
     // it will move to (i+1)-th level.
     int _compute_driver_level(const DriverRawPtr driver) const;
+    bool _is_short_query(const DriverRawPtr driver) const;
+    // Return the short-query lane or the multi-level queue which the driver is put into.
+    SubQuerySharedDriverQueue& _sub_queue_of(const DriverRawPtr driver);
+
+    /// These methods should be guarded by _global_mutex.
+    void _put_back_locked(const DriverRawPtr driver, int level);
+    // Return nullptr, if there is no ready driver.
+    DriverRawPtr _take_locked();
 
 private:
     // The time slice of the i-th level is (i+1)*LEVEL_TIME_SLICE_BASE ns,
@@ -133,16 +148,84 @@ private:
     const double RATIO_OF_ADJACENT_QUEUE = ratio_of_adjacent_queue();
 
     SubQuerySharedDriverQueue _queues[QUEUE_SIZE];
+    const bool _enable_short_query_lane;
+    SubQuerySharedDriverQueue _short_query_lane;
     // The time slice of the i-th level is (i+1)*LEVEL_TIME_SLICE_BASE ns.
     int64_t _level_time_slices[QUEUE_SIZE];
 
-    size_t _num_drivers = 0;
+    // It is atomic, so that WorkStealingDriverQueue can check whether the queue is empty without lock.
+    std::atomic<size_t> _num_drivers = 0;
 
     mutable std::mutex _global_mutex;
     std::condition_variable _cv;
     bool _is_closed = false;
 };
 
+// WorkStealingDriverQueue splits the ready drivers into one QuerySharedDriverQueue per executor thread,
+// so that executor threads don't contend on a single mutex and condition variable.
+// - Each shard keeps the multi-level feedback semantics of QuerySharedDriverQueue.
+// - A driver put back by the poller or an executor thread goes to the shard of the executor thread which ran it last,
+//   so that its operator state is still in the cache of that core.
+// - An executor thread takes drivers from its own shard first, and steals from the other shards when it is empty.
+// - Idle executor threads are parked on a condition variable, which is only touched when there are idle threads.
+//
+// When *num_numa_nodes* is larger than 1, the i-th shard belongs to the (i%num_numa_nodes)-th NUMA node,
+// and its executor thread is expected to be bound to this node.
+// - The drivers of a fragment instance are dispatched to the shards of the same NUMA node at first.
+// - The executor thread steals drivers from the shards of the same NUMA node, before the remote ones.
+class WorkStealingDriverQueue : public FactoryMethod<DriverQueue, WorkStealingDriverQueue> {
+    friend class FactoryMethod<DriverQueue, WorkStealingDriverQueue>;
+
+public:
+    explicit WorkStealingDriverQueue(size_t num_shards, size_t num_numa_nodes = 1);
+    ~WorkStealingDriverQueue() override = default;
+    void close() override;
+    void put_back(const DriverRawPtr driver) override;
+    void put_back(const std::vector<DriverRawPtr>& drivers) override;
+    void put_back_from_executor(const DriverRawPtr driver) override;
+
+    void update_statistics(const DriverRawPtr driver) override;
+
+    // Return cancelled status, if the queue is closed.
+    StatusOr<DriverRawPtr> take() override;
+    StatusOr<DriverRawPtr> take(int worker_id) override;
+
+    void cancel(DriverRawPtr driver) override;
+
+    size_t size() const override { return _num_drivers.load(); }
+
+    bool should_yield(const DriverRawPtr driver, int64_t unaccounted_runtime_ns) const override { return false; }
+
+    size_t num_shards() const { return _shards.size(); }
+    // The NUMA node which the executor thread with *worker_id* should be bound to.
+    int numa_node_of_worker(int worker_id) const { return (worker_id % _shards.size()) % _num_numa_nodes; }
+
+private:
+    void _put_back_to_shard(const DriverRawPtr driver, int shard_idx);
+    // Return nullptr, if the shard is empty or, when *try_lock* is true, the shard is locked by others.
+    DriverRawPtr _try_take_from_shard(int shard_idx, int taker_shard_idx, bool try_lock);
+    void _notify_idle_worker();
+
+    int _shard_of_driver(const DriverRawPtr driver);
+
+    // Idle executor threads wait at most this time before trying to steal drivers again.
+    static constexpr int64_t IDLE_WAIT_TIMEOUT_US = 10'000;
+
+    std::vector<std::unique_ptr<QuerySharedDriverQueue>> _shards;
+    const size_t _num_numa_nodes;
+    // _steal_orders[i] contains the shards stolen by the i-th shard in order,
+    // where the shards of the same NUMA node come first.
+    std::vector<std::vector<int>> _steal_orders;
+    std::atomic<size_t> _num_drivers = 0;
+    // Used to dispatch drivers, which have never been taken by any executor thread.
+    std::atomic<size_t> _next_shard = 0;
+
+    std::mutex _idle_mutex;
+    std::condition_variable _idle_cv;
+    std::atomic<int> _num_idle_workers = 0;
+    std::atomic<bool> _is_closed = false;
+};
+
 // WorkGroupDriverQueue contains two levels of queues.
 // The first level is the work group queue, and the second level is the driver queue in a work group.
 class WorkGroupDriverQueue : public FactoryMethod<DriverQueue, WorkGroupDriverQueue> {
@@ -14,6 +14,8 @@
 
 #include "exec/pipeline/project_operator.h"
 
+#include <algorithm>
+
 #include "column/chunk.h"
 #include "column/column_helper.h"
 #include "column/nullable_column.h"
@@ -25,6 +27,23 @@ namespace starrocks::pipeline {
 Status ProjectOperator::prepare(RuntimeState* state) {
     _expr_compute_timer = ADD_TIMER(_unique_metrics, "ExprComputeTime");
     _common_sub_expr_compute_timer = ADD_TIMER(_unique_metrics, "CommonSubExprComputeTime");
+
+    std::vector<SlotId> slot_ids;
+    for (auto* ctx : _common_sub_expr_ctxs) {
+        ctx->root()->get_slot_ids(&slot_ids);
+    }
+    for (auto* ctx : _expr_ctxs) {
+        ctx->root()->get_slot_ids(&slot_ids);
+    }
+    std::sort(slot_ids.begin(), slot_ids.end());
+    slot_ids.erase(std::unique(slot_ids.begin(), slot_ids.end()), slot_ids.end());
+    for (auto slot_id : slot_ids) {
+        // the common sub exprs are computed by this operator
+        if (std::find(_common_sub_column_ids.begin(), _common_sub_column_ids.end(), slot_id) ==
+            _common_sub_column_ids.end()) {
+            _input_slot_ids.emplace_back(slot_id);
+        }
+    }
     return Operator::prepare(state);
 }
 
@@ -37,8 +56,18 @@ StatusOr<ChunkPtr> ProjectOperator::pull_chunk(RuntimeState* state) {
     return std::move(_cur_chunk);
 }
 
-Status ProjectOperator::push_chunk(RuntimeState* state, const ChunkPtr& chunk) {
+Status ProjectOperator::push_chunk(RuntimeState* state, const ChunkPtr& input_chunk) {
     TRY_CATCH_ALLOC_SCOPE_START();
+    ChunkPtr chunk = input_chunk;
+    if (chunk->has_selection()) {
+        // if no column is used, e.g. all the exprs are constant, it's still compacted to get the number of rows
+        ChunkPtr compacted = _input_slot_ids.empty() ? nullptr : chunk->materialize_selection(_input_slot_ids);
+        if (compacted == nullptr || compacted->num_columns() == 0) {
+            chunk->materialize_selection();
+        } else {
+            chunk = std::move(compacted);
+        }
+    }
     {
         SCOPED_TIMER(_common_sub_expr_compute_timer);
         for (size_t i = 0; i < _common_sub_column_ids.size(); ++i) {
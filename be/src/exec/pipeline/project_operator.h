@@ -54,9 +54,15 @@ public:
 
     Status push_chunk(RuntimeState* state, const ChunkPtr& chunk) override;
 
+    // Only the columns used by the exprs of a chunk with a selection are compacted.
+    bool support_selection() const override { return true; }
+
     Status reset_state(RuntimeState* state, const std::vector<ChunkPtr>& refill_chunks) override;
 
 private:
+    // The slots of the input chunks used by the exprs.
+    std::vector<SlotId> _input_slot_ids;
+
     const std::vector<int32_t>& _column_ids;
     const std::vector<ExprContext*>& _expr_ctxs;
     const std::vector<bool>& _type_is_nullable;
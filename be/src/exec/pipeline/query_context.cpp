@@ -14,10 +14,13 @@
 
 #include "exec/pipeline/query_context.h"
 
+#include <fmt/format.h>
+
 #include <memory>
 #include <vector>
 
 #include "agent/master_info.h"
+#include "common/config.h"
 #include "exec/pipeline/fragment_context.h"
 #include "exec/pipeline/pipeline_fwd.h"
 #include "exec/spill/query_spill_manager.h"
@@ -28,6 +31,7 @@
 #include "runtime/exec_env.h"
 #include "runtime/query_statistics.h"
 #include "runtime/runtime_filter_cache.h"
+#include "util/defer_op.h"
 #include "util/thread.h"
 
 namespace starrocks::pipeline {
@@ -152,6 +156,22 @@ Status QueryContext::init_query_once(workgroup::WorkGroup* wg) {
     return st;
 }
 
+Status QueryContext::admit_query_once(QueryContextManager* manager, workgroup::WorkGroup* wg) {
+    std::call_once(_admit_query_once, [this, manager, wg]() {
+        auto maybe_token = manager->admit_query(this, wg);
+        if (maybe_token.ok()) {
+            _mem_reservation_token = std::move(maybe_token.value());
+        } else {
+            _admission_status = maybe_token.status();
+        }
+    });
+    return _admission_status;
+}
+
+QueryMemReservationToken::~QueryMemReservationToken() {
+    manager->release_mem_reservation(reserved_bytes);
+}
+
 void QueryContext::set_query_trace(std::shared_ptr<starrocks::debug::QueryTrace> query_trace) {
     std::call_once(_query_trace_init_flag, [this, &query_trace]() { _query_trace = std::move(query_trace); });
 }
@@ -197,6 +217,10 @@ Status QueryContextManager::init() {
     _query_ctx_cnt = std::make_unique<UIntGauge>(MetricUnit::NOUNIT);
     metrics->register_metric(_metric_name, _query_ctx_cnt.get());
     metrics->register_hook(_metric_name, [this]() { _query_ctx_cnt->set_value(this->size()); });
+    _queued_queries_gauge = std::make_unique<IntGauge>(MetricUnit::NOUNIT);
+    metrics->register_metric(_queued_queries_metric_name, _queued_queries_gauge.get());
+    metrics->register_hook(_queued_queries_metric_name,
+                           [this]() { _queued_queries_gauge->set_value(this->num_queued_queries()); });
 
     try {
         _clean_thread = std::make_shared<std::thread>(_clean_func, this);
@@ -243,6 +267,8 @@ QueryContextManager::~QueryContextManager() {
     auto metrics = StarRocksMetrics::instance()->metrics();
     metrics->deregister_hook(_metric_name);
     _query_ctx_cnt.reset();
+    metrics->deregister_hook(_queued_queries_metric_name);
+    _queued_queries_gauge.reset();
 
     if (_clean_thread) {
         this->_stop_clean_func();
@@ -586,4 +612,81 @@ void QueryContextManager::report_fragments(
     }
 }
 
+int64_t QueryContextManager::_estimate_mem_reservation(QueryContext* query_ctx, int64_t query_pool_limit) const {
+    int64_t query_mem_limit = query_ctx->mem_tracker()->limit();
+    if (query_mem_limit <= 0 || query_mem_limit > query_pool_limit) {
+        query_mem_limit = query_pool_limit;
+    }
+    return static_cast<int64_t>(query_mem_limit * config::query_admission_mem_reservation_ratio);
+}
+
+bool QueryContextManager::_can_admit_unlocked(int64_t reserved_bytes, int64_t query_pool_limit) const {
+    // Always admit a query when there is no admitted query, to avoid starving the query larger than the pool.
+    if (_total_mem_reservation == 0) {
+        return true;
+    }
+    int64_t query_pool_consumption = ExecEnv::GetInstance()->query_pool_mem_tracker()->consumption();
+    int64_t mem_demand = std::max<int64_t>(_total_mem_reservation, query_pool_consumption);
+    return mem_demand + reserved_bytes <= query_pool_limit * config::query_admission_query_pool_ratio;
+}
+
+StatusOr<QueryMemReservationTokenPtr> QueryContextManager::admit_query(QueryContext* query_ctx,
+                                                                       workgroup::WorkGroup* wg) {
+    if (!config::enable_query_mem_admission) {
+        return nullptr;
+    }
+    const int64_t query_pool_limit = ExecEnv::GetInstance()->query_pool_mem_tracker()->limit();
+    if (query_pool_limit <= 0) {
+        return nullptr;
+    }
+
+    const int64_t reserved_bytes = _estimate_mem_reservation(query_ctx, query_pool_limit);
+    std::unique_lock lock(_admission_mutex);
+    if (!_can_admit_unlocked(reserved_bytes, query_pool_limit)) {
+        if (_num_queued_queries >= config::query_admission_max_queued_queries) {
+            return Status::TooManyTasks(
+                    fmt::format("Exceed query admission queue length: {}", config::query_admission_max_queued_queries));
+        }
+
+        const int64_t wait_start_ns = MonotonicNanos();
+        _num_queued_queries++;
+        if (wg != nullptr) {
+            wg->incr_num_queued_queries();
+        }
+        DeferOp defer([this, wg, wait_start_ns]() {
+            _num_queued_queries--;
+            if (wg != nullptr) {
+                wg->decr_num_queued_queries(MonotonicNanos() - wait_start_ns);
+            }
+        });
+
+        // The query pool consumption also decreases without notification, so re-check it periodically.
+        static constexpr auto CHECK_INTERVAL = milliseconds(100);
+        const auto deadline = steady_clock::now() + milliseconds(config::query_admission_wait_timeout_ms);
+        while (!_can_admit_unlocked(reserved_bytes, query_pool_limit)) {
+            const auto now = steady_clock::now();
+            if (now >= deadline) {
+                return Status::TooManyTasks(fmt::format(
+                        "Wait for query admission timeout, reserved_bytes={}, total_reserved_bytes={}, "
+                        "query_pool_consumption={}",
+                        reserved_bytes, _total_mem_reservation.load(),
+                        ExecEnv::GetInstance()->query_pool_mem_tracker()->consumption()));
+            }
+            _admission_cv.wait_for(lock, std::min<steady_clock::duration>(CHECK_INTERVAL, deadline - now));
+        }
+    }
+
+    _total_mem_reservation += reserved_bytes;
+    return std::make_unique<QueryMemReservationToken>(this, reserved_bytes);
+}
+
+void QueryContextManager::release_mem_reservation(int64_t reserved_bytes) {
+    {
+        std::lock_guard lock(_admission_mutex);
+        _total_mem_reservation -= reserved_bytes;
+        DCHECK_GE(_total_mem_reservation, 0);
+    }
+    _admission_cv.notify_all();
+}
+
 } // namespace starrocks::pipeline
@@ -16,6 +16,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <mutex>
 #include <unordered_map>
 
@@ -44,6 +45,28 @@ using std::chrono::milliseconds;
 using std::chrono::steady_clock;
 using std::chrono::duration_cast;
 
+class QueryContextManager;
+
+// QueryMemReservationToken holds the memory reserved by the query admission of QueryContextManager,
+// and releases it back when destructed.
+struct QueryMemReservationToken {
+public:
+    QueryMemReservationToken(QueryContextManager* manager, int64_t reserved_bytes)
+            : manager(manager), reserved_bytes(reserved_bytes) {}
+    ~QueryMemReservationToken();
+
+    // Disable copy/move ctor and assignment.
+    QueryMemReservationToken(const QueryMemReservationToken&) = delete;
+    QueryMemReservationToken& operator=(const QueryMemReservationToken&) = delete;
+    QueryMemReservationToken(QueryMemReservationToken&&) = delete;
+    QueryMemReservationToken& operator=(QueryMemReservationToken&&) = delete;
+
+private:
+    QueryContextManager* manager;
+    int64_t reserved_bytes;
+};
+using QueryMemReservationTokenPtr = std::unique_ptr<QueryMemReservationToken>;
+
 // The context for all fragment of one query in one BE
 class QueryContext : public std::enable_shared_from_this<QueryContext> {
 public:
@@ -116,6 +139,9 @@ public:
     std::shared_ptr<MemTracker> mem_tracker() { return _mem_tracker; }
 
     Status init_query_once(workgroup::WorkGroup* wg);
+    // Admit this query by QueryContextManager once, which is shared by all the fragments of this query.
+    // It MUST be invoked after init_mem_tracker.
+    Status admit_query_once(QueryContextManager* manager, workgroup::WorkGroup* wg);
 
     // Some statistic about the query, including cpu, scan_rows, scan_bytes
     int64_t mem_cost_bytes() const { return _mem_tracker->peak_consumption(); }
@@ -203,6 +229,10 @@ private:
     int64_t _scan_limit = 0;
     workgroup::RunningQueryTokenPtr _wg_running_query_token_ptr;
 
+    std::once_flag _admit_query_once;
+    Status _admission_status;
+    QueryMemReservationTokenPtr _mem_reservation_token;
+
     // STREAM MV
     std::shared_ptr<StreamEpochManager> _stream_epoch_manager;
 
@@ -232,7 +262,19 @@ public:
     void collect_query_statistics(const PCollectQueryStatisticsRequest* request,
                                   PCollectQueryStatisticsResult* response);
 
+    // Memory-aware query admission.
+    // Each query reserves its estimated memory before running, and waits in the queue until the reservation fits
+    // into the query pool. The memory demand of the admitted queries is the larger one of their total reservations
+    // and the actual consumption of the query pool, so the runtime growth beyond the estimation is also considered.
+    StatusOr<QueryMemReservationTokenPtr> admit_query(QueryContext* query_ctx, workgroup::WorkGroup* wg);
+    void release_mem_reservation(int64_t reserved_bytes);
+    int64_t num_queued_queries() const { return _num_queued_queries; }
+    int64_t total_mem_reservation() const { return _total_mem_reservation; }
+
 private:
+    int64_t _estimate_mem_reservation(QueryContext* query_ctx, int64_t query_pool_limit) const;
+    bool _can_admit_unlocked(int64_t reserved_bytes, int64_t query_pool_limit) const;
+
     static void _clean_func(QueryContextManager* manager);
     void _clean_query_contexts();
     void _stop_clean_func() { _stop.store(true); }
@@ -252,6 +294,13 @@ private:
 
     inline static const char* _metric_name = "pip_query_ctx_cnt";
     std::unique_ptr<UIntGauge> _query_ctx_cnt;
+
+    std::mutex _admission_mutex;
+    std::condition_variable _admission_cv;
+    std::atomic<int64_t> _total_mem_reservation = 0;
+    std::atomic<int64_t> _num_queued_queries = 0;
+    inline static const char* _queued_queries_metric_name = "pip_query_admission_queued_queries";
+    std::unique_ptr<IntGauge> _queued_queries_gauge;
 };
 
 } // namespace pipeline
@@ -16,6 +16,7 @@
 
 #include "column/chunk.h"
 #include "exprs/expr.h"
+#include "runtime/arrow_result_writer.h"
 #include "runtime/buffer_control_block.h"
 #include "runtime/mysql_result_writer.h"
 #include "runtime/query_statistics.h"
@@ -42,6 +43,9 @@ Status ResultSinkOperator::prepare(RuntimeState* state) {
     case TResultSinkType::VARIABLE:
         _writer = std::make_shared<VariableResultWriter>(_sender.get(), _output_expr_ctxs, _profile.get());
         break;
+    case TResultSinkType::ARROW:
+        _writer = std::make_shared<ArrowResultWriter>(_sender.get(), _output_expr_ctxs, _profile.get());
+        break;
     default:
         return Status::InternalError("Unknown result sink type");
     }
@@ -140,7 +144,10 @@ Status ResultSinkOperator::push_chunk(RuntimeState* state, const ChunkPtr& chunk
 
 Status ResultSinkOperatorFactory::prepare(RuntimeState* state) {
     RETURN_IF_ERROR(OperatorFactory::prepare(state));
-    RETURN_IF_ERROR(state->exec_env()->result_mgr()->create_sender(state->fragment_instance_id(), 1024, &_sender));
+    // Every row of the ARROW sink is a record batch of a chunk.
+    const int buffer_size = _sink_type == TResultSinkType::ARROW ? config::max_memory_sink_batch_count : 1024;
+    RETURN_IF_ERROR(
+            state->exec_env()->result_mgr()->create_sender(state->fragment_instance_id(), buffer_size, &_sender));
 
     RETURN_IF_ERROR(Expr::create_expr_trees(state->obj_pool(), _t_output_expr, &_output_expr_ctxs, state));
 
@@ -322,7 +322,7 @@ public:
             LogicalType build_type = desc->build_expr_type();
             JoinRuntimeFilter* filter = RuntimeFilterHelper::create_runtime_bloom_filter(_pool, build_type);
             if (filter == nullptr) continue;
-            filter->init(row_count);
+            // it's inited after all the build key columns are known.
             filter->set_join_mode(desc->join_mode());
             desc->set_runtime_filter(filter);
         }
@@ -362,6 +362,19 @@ public:
                 desc->set_runtime_filter(nullptr);
                 continue;
             }
+            Columns columns;
+            for (auto& opt_params : _partial_bloom_filter_build_params) {
+                auto& param = opt_params[i].value();
+                if (param.column != nullptr) {
+                    columns.emplace_back(param.column);
+                }
+            }
+            // the partitioned runtime filters are concatenated by hash partitions, so only the runtime filter
+            // which isn't partitioned can be a dense bitset.
+            bool allow_dense_bitset = desc->join_mode() == TRuntimeFilterBuildJoinMode::BORADCAST ||
+                                      !desc->has_remote_targets();
+            RuntimeFilterHelper::init_runtime_bloom_filter(desc->runtime_filter(), desc->build_expr_type(), columns,
+                                                           kHashJoinKeyColumnOffset, row_count, allow_dense_bitset);
             for (auto& opt_params : _partial_bloom_filter_build_params) {
                 auto& opt_param = opt_params[i];
                 DCHECK(opt_param.has_value());
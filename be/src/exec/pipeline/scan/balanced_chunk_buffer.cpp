@@ -14,8 +14,8 @@
 
 #include "exec/pipeline/scan/balanced_chunk_buffer.h"
 
+#include "common/compiler_util.h"
 #include "fmt/format.h"
-#include "util/blocking_queue.hpp"
 
 namespace starrocks::pipeline {
 
@@ -23,12 +23,62 @@ BalancedChunkBuffer::BalancedChunkBuffer(BalanceStrategy strategy, int output_op
         : _output_operators(output_operators), _strategy(strategy), _limiter(std::move(limiter)) {
     DCHECK_GT(output_operators, 0);
     for (int i = 0; i < output_operators; i++) {
-        _sub_buffers.emplace_back(std::make_unique<QueueT>());
+        _sub_buffers.emplace_back(std::make_unique<QueueT>(kRingCapacity));
     }
 }
 
 BalancedChunkBuffer::~BalancedChunkBuffer() = default;
 
+bool BalancedChunkBuffer::QueueT::put(ChunkWithToken&& chunk_with_token) {
+    if (_shutdown.load(std::memory_order_acquire)) {
+        return false;
+    }
+    if (_num_overflow.load(std::memory_order_acquire) == 0 && _ring.try_put(std::move(chunk_with_token))) {
+        // The sub-buffer may be cleared by set_finished() concurrently, so clear it again to release the token.
+        if (UNLIKELY(_shutdown.load(std::memory_order_acquire))) {
+            clear();
+        }
+        return true;
+    }
+
+    std::lock_guard<std::mutex> l(_overflow_mutex);
+    if (_shutdown.load(std::memory_order_acquire)) {
+        return false;
+    }
+    _overflow.emplace_back(std::move(chunk_with_token));
+    _num_overflow.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+bool BalancedChunkBuffer::QueueT::try_get(ChunkWithToken* chunk_with_token) {
+    // The chunks in the ring are always put earlier than the ones in the overflow queue.
+    if (_ring.try_get(chunk_with_token)) {
+        return true;
+    }
+    if (_num_overflow.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> l(_overflow_mutex);
+    if (_overflow.empty()) {
+        return false;
+    }
+    *chunk_with_token = std::move(_overflow.front());
+    _overflow.pop_front();
+    _num_overflow.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+void BalancedChunkBuffer::QueueT::clear() {
+    ChunkWithToken chunk_with_token;
+    while (_ring.try_get(&chunk_with_token)) {
+        chunk_with_token = {nullptr, nullptr};
+    }
+    std::lock_guard<std::mutex> l(_overflow_mutex);
+    _overflow.clear();
+    _num_overflow.store(0, std::memory_order_release);
+}
+
 const BalancedChunkBuffer::SubBuffer& BalancedChunkBuffer::_get_sub_buffer(int index) const {
     DCHECK_LT(index, _output_operators);
     return _sub_buffers[index % _output_operators];
@@ -68,6 +118,7 @@ bool BalancedChunkBuffer::try_get(int buffer_index, ChunkPtr* output_chunk) {
     bool ok = _get_sub_buffer(buffer_index)->try_get(&chunk_with_token);
     if (ok) {
         *output_chunk = std::move(chunk_with_token.first);
+        _limiter->update_consumed_chunks(1);
     }
     return ok;
 }
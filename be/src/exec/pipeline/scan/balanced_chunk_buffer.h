@@ -14,11 +14,14 @@
 
 #pragma once
 
+#include <atomic>
+#include <deque>
+#include <mutex>
 #include <vector>
 
 #include "column/chunk.h"
 #include "exec/pipeline/scan/chunk_buffer_limiter.h"
-#include "util/blocking_queue.hpp"
+#include "util/bounded_mpmc_queue.h"
 
 namespace starrocks::pipeline {
 
@@ -57,9 +60,36 @@ private:
     };
 
     using ChunkWithToken = std::pair<ChunkPtr, ChunkBufferTokenPtr>;
-    using QueueT = UnboundedBlockingQueue<ChunkWithToken>;
+
+    // QueueT hands off chunks from the scan threads to the driver without lock in the common case.
+    // Chunks are put into a bounded lock-free ring, and only into the locked overflow queue when the ring is full.
+    // Once the overflow queue is not empty, the following chunks are also put into it until it is drained,
+    // so that the chunks put by the same chunk source are still got in order.
+    class QueueT {
+    public:
+        explicit QueueT(size_t ring_capacity) : _ring(ring_capacity) {}
+
+        bool put(ChunkWithToken&& chunk_with_token);
+        bool try_get(ChunkWithToken* chunk_with_token);
+        size_t get_size() const { return _ring.size() + _num_overflow.load(std::memory_order_acquire); }
+        bool empty() const { return get_size() == 0; }
+        void shutdown() { _shutdown.store(true, std::memory_order_release); }
+        void clear();
+
+    private:
+        BoundedMPMCQueue<ChunkWithToken> _ring;
+        std::atomic<bool> _shutdown{false};
+
+        std::mutex _overflow_mutex;
+        std::deque<ChunkWithToken> _overflow;
+        std::atomic<size_t> _num_overflow{0};
+    };
     using SubBuffer = std::unique_ptr<QueueT>;
 
+    // The capacity of the lock-free ring of each sub-buffer, the number of buffered chunks is usually
+    // limited by the ChunkBufferLimiter to a much smaller number.
+    static constexpr size_t kRingCapacity = 256;
+
     const SubBuffer& _get_sub_buffer(int index) const;
     SubBuffer& _get_sub_buffer(int index);
 
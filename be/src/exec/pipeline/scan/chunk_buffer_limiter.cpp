@@ -14,7 +14,11 @@
 
 #include "exec/pipeline/scan/chunk_buffer_limiter.h"
 
+#include <cmath>
+
+#include "common/config.h"
 #include "glog/logging.h"
+#include "util/time.h"
 
 namespace starrocks::pipeline {
 
@@ -34,7 +38,55 @@ void DynamicChunkBufferLimiter::update_avg_row_bytes(size_t added_sum_row_bytes,
 
     size_t chunk_mem_usage = avg_row_bytes * max_chunk_rows;
     size_t new_capacity = std::max<size_t>(_mem_limit / chunk_mem_usage, 1);
-    _capacity = std::min(new_capacity, _max_capacity);
+    _mem_capacity = std::min(new_capacity, _max_capacity);
+    _update_capacity();
+}
+
+void DynamicChunkBufferLimiter::update_consumed_chunks(size_t num_chunks) {
+    size_t prev_value = _num_consumed_chunks.fetch_add(num_chunks);
+    if ((prev_value + num_chunks) / CONSUME_SAMPLE_PERIOD == prev_value / CONSUME_SAMPLE_PERIOD) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    int64_t now = MonotonicNanos();
+    size_t consumed_chunks = _num_consumed_chunks.load();
+    if (_last_sample_time_ns > 0 && now > _last_sample_time_ns && consumed_chunks > _last_sample_consumed_chunks) {
+        double rate = static_cast<double>(consumed_chunks - _last_sample_consumed_chunks) /
+                      static_cast<double>(now - _last_sample_time_ns);
+        _consumed_chunks_per_ns =
+                _consumed_chunks_per_ns == 0 ? rate : EWMA_ALPHA * rate + (1 - EWMA_ALPHA) * _consumed_chunks_per_ns;
+    }
+    _last_sample_time_ns = now;
+    _last_sample_consumed_chunks = consumed_chunks;
+    _update_capacity();
+}
+
+void DynamicChunkBufferLimiter::update_io_time(int64_t io_time_ns, size_t num_chunks) {
+    if (io_time_ns <= 0 || num_chunks == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    double io_time_ns_per_chunk = static_cast<double>(io_time_ns) / num_chunks;
+    _io_time_ns_per_chunk = _io_time_ns_per_chunk == 0
+                                    ? io_time_ns_per_chunk
+                                    : EWMA_ALPHA * io_time_ns_per_chunk + (1 - EWMA_ALPHA) * _io_time_ns_per_chunk;
+    _update_capacity();
+}
+
+void DynamicChunkBufferLimiter::_update_capacity() {
+    if (!config::enable_chunk_buffer_feedback_capacity || _consumed_chunks_per_ns == 0 || _io_time_ns_per_chunk == 0) {
+        _capacity = _mem_capacity;
+        return;
+    }
+
+    double feedback_capacity = _consumed_chunks_per_ns * _io_time_ns_per_chunk * FEEDBACK_CAPACITY_HEADROOM;
+    if (feedback_capacity >= static_cast<double>(_mem_capacity)) {
+        _capacity = _mem_capacity;
+    } else {
+        _capacity = std::max<size_t>(static_cast<size_t>(std::ceil(feedback_capacity)), 1);
+    }
 }
 
 ChunkBufferTokenPtr DynamicChunkBufferLimiter::pin(int num_chunks) {
@@ -44,6 +44,10 @@ public:
     // `added_sum_row_bytes` is the bytes of the new reading rows.
     // `added_num_rows` is the number of the new read rows.
     virtual void update_avg_row_bytes(size_t added_sum_row_bytes, size_t added_num_rows, size_t max_chunk_rows) {}
+    // Update the consumption statistics, called after `num_chunks` chunks are got from the buffer by drivers.
+    virtual void update_consumed_chunks(size_t num_chunks) {}
+    // Update the scan io statistics, `io_time_ns` is the time spent by an io task to read `num_chunks` chunks.
+    virtual void update_io_time(int64_t io_time_ns, size_t num_chunks) {}
 
     // Pin a position in the buffer and return a token.
     // When desctructing the token, the position will be unpinned.
@@ -94,6 +98,14 @@ private:
 };
 
 // Use the dynamic chunk memory usage statistics to compute the capacity.
+//
+// The capacity computed by the memory usage is an upper bound. When the consumption rate of drivers and the io time
+// of scan tasks are known, the capacity is further limited to the number of chunks consumed during reading a chunk,
+// like the bandwidth-delay product of the TCP congestion window:
+// - Slow drivers need few buffered chunks, so scans don't over-buffer and waste memory.
+// - Fast drivers need more buffered chunks. When drivers are starved, the consumption rate is the rate of the
+//   running io tasks, so the capacity grows with the number of running io tasks, until it reaches the upper bound.
+// Since each running io task pins a position in the buffer, the capacity also limits the concurrent chunk sources.
 class DynamicChunkBufferLimiter final : public ChunkBufferLimiter {
 public:
     class Token final : public ChunkBufferToken {
@@ -113,6 +125,7 @@ public:
 public:
     DynamicChunkBufferLimiter(size_t max_capacity, size_t default_capacity, int64_t mem_limit, int chunk_size)
             : _capacity(default_capacity),
+              _mem_capacity(default_capacity),
               _max_capacity(max_capacity),
               _default_capacity(default_capacity),
               _mem_limit(mem_limit) {}
@@ -120,6 +133,8 @@ public:
     ~DynamicChunkBufferLimiter() override = default;
 
     void update_avg_row_bytes(size_t added_sum_row_bytes, size_t added_num_rows, size_t max_chunk_rows) override;
+    void update_consumed_chunks(size_t num_chunks) override;
+    void update_io_time(int64_t io_time_ns, size_t num_chunks) override;
 
     ChunkBufferTokenPtr pin(int num_chunks) override;
 
@@ -130,13 +145,32 @@ public:
 
 private:
     void _unpin(int num_chunks);
+    // Compute `_capacity` from `_mem_capacity` and the feedback statistics, must be called with `_mutex` held.
+    void _update_capacity();
 
 private:
+    // Sample the consumption rate every `CONSUME_SAMPLE_PERIOD` consumed chunks.
+    static constexpr size_t CONSUME_SAMPLE_PERIOD = 16;
+    // The weight of the new sample in the moving average of the consumption rate and io time.
+    static constexpr double EWMA_ALPHA = 0.25;
+    // Buffer twice the chunks consumed during reading a chunk, to tolerate the jitter of io time.
+    static constexpr double FEEDBACK_CAPACITY_HEADROOM = 2.0;
+
     std::mutex _mutex;
     size_t _sum_row_bytes = 0;
     size_t _num_rows = 0;
 
+    std::atomic<size_t> _num_consumed_chunks = 0;
+    size_t _last_sample_consumed_chunks = 0;
+    int64_t _last_sample_time_ns = 0;
+    // The moving average of the number of chunks consumed per nanosecond.
+    double _consumed_chunks_per_ns = 0;
+    // The moving average of the io time to read a chunk.
+    double _io_time_ns_per_chunk = 0;
+
     size_t _capacity;
+    // The capacity computed by the chunk memory usage.
+    size_t _mem_capacity;
     const size_t _max_capacity;
     const size_t _default_capacity;
 
@@ -58,6 +58,8 @@ public:
     int64_t get_cpu_time_spent() const { return _cpu_time_spent_ns; }
     int64_t get_scan_rows() const { return _scan_rows_num; }
     int64_t get_scan_bytes() const { return _scan_bytes; }
+    // The IO device which this chunk source reads from, or -1 if it is unknown.
+    virtual int64_t io_device_id() const { return -1; }
 
     RuntimeProfile::Counter* scan_timer() { return _scan_timer; }
     RuntimeProfile::Counter* io_task_wait_timer() { return _io_task_wait_timer; }
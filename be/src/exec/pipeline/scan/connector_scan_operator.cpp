@@ -71,8 +71,26 @@ void ConnectorScanOperator::do_close(RuntimeState* state) {}
 ChunkSourcePtr ConnectorScanOperator::create_chunk_source(MorselPtr morsel, int32_t chunk_source_index) {
     auto* scan_node = down_cast<ConnectorScanNode*>(_scan_node);
     auto* factory = down_cast<ConnectorScanOperatorFactory*>(_factory);
-    return std::make_shared<ConnectorChunkSource>(_driver_sequence, _chunk_source_profiles[chunk_source_index].get(),
-                                                  std::move(morsel), this, scan_node, factory->get_chunk_buffer());
+    auto chunk_source = std::make_shared<ConnectorChunkSource>(
+            _driver_sequence, _chunk_source_profiles[chunk_source_index].get(), std::move(morsel), this, scan_node,
+            factory->get_chunk_buffer());
+    _coalesce_morsels(chunk_source.get());
+    return chunk_source;
+}
+
+void ConnectorScanOperator::_coalesce_morsels(ConnectorChunkSource* chunk_source) {
+    // don't coalesce the morsels if there are not enough of them for all the io tasks.
+    size_t num_io_tasks = std::max<size_t>(1, _dop * _io_tasks_per_scan_operator);
+    size_t max_num = std::min<size_t>(std::max(config::connector_coalesce_scan_ranges_max_num, 1),
+                                      _morsel_queue->num_original_morsels() / num_io_tasks);
+    for (size_t num = 1; num < max_num && chunk_source->can_add_morsel() && !_morsel_queue->empty(); num++) {
+        auto morsel_or = _morsel_queue->try_get();
+        // leave the error to the next pickup of the morsels.
+        if (!morsel_or.ok() || morsel_or.value() == nullptr) {
+            break;
+        }
+        chunk_source->add_morsel(std::move(morsel_or.value()));
+    }
 }
 
 void ConnectorScanOperator::attach_chunk_source(int32_t source_index) {
@@ -177,6 +195,11 @@ ConnectorChunkSource::ConnectorChunkSource(int32_t scan_operator_id, RuntimeProf
     _data_source->update_has_any_predicate();
 }
 
+void ConnectorChunkSource::add_morsel(MorselPtr&& morsel) {
+    auto* scan_morsel = (ScanMorsel*)morsel.get();
+    _data_source->add_scan_range(*scan_morsel->get_scan_range());
+}
+
 ConnectorChunkSource::~ConnectorChunkSource() {
     if (_runtime_state != nullptr) {
         close(_runtime_state);
@@ -27,6 +27,8 @@ class ScanNode;
 
 namespace pipeline {
 
+class ConnectorChunkSource;
+
 class ConnectorScanOperatorFactory : public ScanOperatorFactory {
 public:
     using ActiveInputKey = std::pair<int32_t, int32_t>;
@@ -77,6 +79,10 @@ public:
     ChunkBufferTokenPtr pin_chunk(int num_chunks) override;
     bool is_buffer_full() const override;
     void set_buffer_finished() override;
+
+private:
+    // Let the data source of |chunk_source| read more morsels from the queue after its own one.
+    void _coalesce_morsels(ConnectorChunkSource* chunk_source);
 };
 
 class ConnectorChunkSource : public ChunkSource {
@@ -89,6 +95,10 @@ public:
     Status prepare(RuntimeState* state) override;
     void close(RuntimeState* state) override;
 
+    bool can_add_morsel() const { return _data_source->can_add_scan_range(); }
+    // Read the scan range of |morsel| by the data source after the current ones.
+    void add_morsel(MorselPtr&& morsel);
+
 protected:
     virtual bool _reach_eof() { return _limit != -1 && _rows_read >= _limit; }
     Status _open_data_source(RuntimeState* state);
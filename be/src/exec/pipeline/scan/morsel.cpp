@@ -14,6 +14,8 @@
 
 #include "exec/pipeline/scan/morsel.h"
 
+#include <algorithm>
+
 #include "exec/olap_utils.h"
 #include "storage/chunk_helper.h"
 #include "storage/range.h"
@@ -68,6 +70,29 @@ IndividualMorselQueueFactory::IndividualMorselQueueFactory(std::map<int, MorselQ
     }
 }
 
+void IndividualMorselQueueFactory::enable_morsel_stealing() {
+    std::vector<FixedMorselQueue*> queues;
+    queues.reserve(_queue_per_driver_seq.size());
+    for (const auto& queue : _queue_per_driver_seq) {
+        auto* fixed_queue = dynamic_cast<FixedMorselQueue*>(queue.get());
+        if (fixed_queue == nullptr) {
+            return;
+        }
+        queues.emplace_back(fixed_queue);
+    }
+
+    // Each queue visits the victims starting from its next queue, to spread the thieves among the victims.
+    const size_t num_queues = queues.size();
+    for (size_t i = 0; i < num_queues; ++i) {
+        std::vector<FixedMorselQueue*> victims;
+        victims.reserve(num_queues - 1);
+        for (size_t j = 1; j < num_queues; ++j) {
+            victims.emplace_back(queues[(i + j) % num_queues]);
+        }
+        queues[i]->set_steal_victims(std::move(victims));
+    }
+}
+
 /// MorselQueue.
 std::vector<TInternalScanRange*> _convert_morsels_to_olap_scan_ranges(const Morsels& morsels) {
     std::vector<TInternalScanRange*> scan_ranges;
@@ -92,6 +117,29 @@ StatusOr<MorselPtr> FixedMorselQueue::try_get() {
     if (_unget_morsel != nullptr) {
         return std::move(_unget_morsel);
     }
+    if (!_started.load(std::memory_order_relaxed)) {
+        _started.store(true, std::memory_order_release);
+    }
+
+    if (auto morsel = _pop_morsel(); morsel != nullptr) {
+        return morsel;
+    }
+    for (auto* victim : _steal_victims) {
+        if (auto morsel = victim->_try_steal(); morsel != nullptr) {
+            _num_stolen_morsels++;
+            return morsel;
+        }
+    }
+    return nullptr;
+}
+
+bool FixedMorselQueue::_has_stealable_morsels() const {
+    return std::any_of(_steal_victims.begin(), _steal_victims.end(), [](const auto* victim) {
+        return victim->_started.load(std::memory_order_acquire) && victim->_pop_index < victim->_num_morsels;
+    });
+}
+
+MorselPtr FixedMorselQueue::_pop_morsel() {
     auto idx = _pop_index.load();
     // prevent _num_morsels from superfluous addition
     if (idx >= _num_morsels) {
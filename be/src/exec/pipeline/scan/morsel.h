@@ -193,6 +193,11 @@ public:
     bool is_shared() const override { return false; }
     bool could_local_shuffle() const override { return _could_local_shuffle; }
 
+    // Make each queue steal morsels from the other queues after its own morsels are exhausted.
+    // It only supports the queues which are all FixedMorselQueue, and doesn't keep the tablet locality of drivers,
+    // so it should be used only when could_local_shuffle is true.
+    void enable_morsel_stealing();
+
 private:
     std::vector<MorselQueuePtr> _queue_per_driver_seq;
     const bool _could_local_shuffle;
@@ -236,16 +241,32 @@ public:
 
     size_t num_original_morsels() const override { return _num_morsels; }
     size_t max_degree_of_parallelism() const override { return _num_morsels; }
-    bool empty() const override { return _unget_morsel == nullptr && _pop_index >= _num_morsels; }
+    bool empty() const override {
+        return _unget_morsel == nullptr && _pop_index >= _num_morsels && !_has_stealable_morsels();
+    }
     StatusOr<MorselPtr> try_get() override;
 
     std::string name() const override { return "fixed_morsel_queue"; }
 
+    // Steal morsels from victims in order, after the morsels of this queue are exhausted.
+    void set_steal_victims(std::vector<FixedMorselQueue*> victims) { _steal_victims = std::move(victims); }
+    size_t num_stolen_morsels() const { return _num_stolen_morsels; }
+
 private:
+    MorselPtr _pop_morsel();
+    // Only steal from the queue whose owner has started to get morsels, since the owner prepares the morsels
+    // (e.g. sets the captured rowsets of tablets) before getting them.
+    MorselPtr _try_steal() { return _started.load(std::memory_order_acquire) ? _pop_morsel() : nullptr; }
+    bool _has_stealable_morsels() const;
+
     Morsels _morsels;
     const size_t _num_morsels;
     std::atomic<size_t> _pop_index;
     std::vector<std::vector<RowsetSharedPtr>> _tablet_rowsets;
+
+    std::vector<FixedMorselQueue*> _steal_victims;
+    std::atomic<bool> _started{false};
+    std::atomic<size_t> _num_stolen_morsels{0};
 };
 
 class SplitMorselQueue : public MorselQueue {
@@ -14,8 +14,12 @@
 
 #include "exec/pipeline/scan/olap_chunk_source.h"
 
+#include <algorithm>
+
+#include "common/config.h"
 #include "exec/olap_scan_node.h"
 #include "exec/olap_scan_prepare.h"
+#include "exec/pipeline/fragment_context.h"
 #include "exec/pipeline/scan/olap_scan_context.h"
 #include "exec/pipeline/scan/scan_operator.h"
 #include "exec/workgroup/work_group.h"
@@ -25,6 +29,7 @@
 #include "runtime/exec_env.h"
 #include "storage/chunk_helper.h"
 #include "storage/column_predicate_rewriter.h"
+#include "storage/data_dir.h"
 #include "storage/olap_runtime_range_pruner.hpp"
 #include "storage/predicate_parser.h"
 #include "storage/projection_iterator.h"
@@ -38,7 +43,7 @@ OlapChunkSource::OlapChunkSource(int32_t scan_operator_id, RuntimeProfile* runti
         : ChunkSource(scan_operator_id, runtime_profile, std::move(morsel), scan_ctx->get_chunk_buffer()),
           _scan_node(scan_node),
           _scan_ctx(scan_ctx),
-          _limit(scan_node->limit()),
+          _limit(scan_node->limit() != -1 ? scan_node->limit() : scan_ctx->fused_limit()),
           _scan_range(down_cast<ScanMorsel*>(_morsel.get())->get_olap_scan_range()) {}
 
 OlapChunkSource::~OlapChunkSource() {
@@ -46,6 +51,13 @@ OlapChunkSource::~OlapChunkSource() {
     _predicate_free_pool.clear();
 }
 
+int64_t OlapChunkSource::io_device_id() const {
+    if (_tablet == nullptr || _tablet->data_dir() == nullptr) {
+        return -1;
+    }
+    return _tablet->data_dir()->path_hash();
+}
+
 void OlapChunkSource::close(RuntimeState* state) {
     if (_reader) {
         _update_counter();
@@ -53,6 +65,9 @@ void OlapChunkSource::close(RuntimeState* state) {
     if (_prj_iter) {
         _prj_iter->close();
     }
+    if (_chunk_recycler) {
+        _chunk_recycler->close();
+    }
     if (_reader) {
         _reader.reset();
     }
@@ -93,6 +108,8 @@ void OlapChunkSource::_init_counter(RuntimeState* state) {
     _raw_rows_counter = ADD_COUNTER(_runtime_profile, "RawRowsRead", TUnit::UNIT);
     _read_pages_num_counter = ADD_COUNTER(_runtime_profile, "ReadPagesNum", TUnit::UNIT);
     _cached_pages_num_counter = ADD_COUNTER(_runtime_profile, "CachedPagesNum", TUnit::UNIT);
+    _shared_read_pages_num_counter =
+            ADD_CHILD_COUNTER(_runtime_profile, "SharedReadPagesNum", TUnit::UNIT, "CachedPagesNum");
     _pushdown_predicates_counter =
             ADD_COUNTER_SKIP_MERGE(_runtime_profile, "PushdownPredicates", TUnit::UNIT, TCounterMergeType::SKIP_ALL);
 
@@ -119,6 +136,8 @@ void OlapChunkSource::_init_counter(RuntimeState* state) {
     _block_seek_counter = ADD_CHILD_COUNTER(_runtime_profile, "BlockSeekCount", TUnit::UNIT, "SegmentRead");
     _pred_filter_timer = ADD_CHILD_TIMER(_runtime_profile, "PredFilter", "SegmentRead");
     _pred_filter_counter = ADD_CHILD_COUNTER(_runtime_profile, "PredFilterRows", TUnit::UNIT, "SegmentRead");
+    _pred_filter_skipped_counter =
+            ADD_CHILD_COUNTER(_runtime_profile, "PredFilterSkippedRows", TUnit::UNIT, "SegmentRead");
     _del_vec_filter_counter = ADD_CHILD_COUNTER(_runtime_profile, "DelVecFilterRows", TUnit::UNIT, "SegmentRead");
     _chunk_copy_timer = ADD_CHILD_TIMER(_runtime_profile, "ChunkCopy", "SegmentRead");
     _decompress_timer = ADD_CHILD_TIMER(_runtime_profile, "DecompressT", "SegmentRead");
@@ -145,6 +164,14 @@ void OlapChunkSource::_decide_chunk_size(bool has_predicate) {
         _params.chunk_size = _limit;
     } else {
         _params.chunk_size = _runtime_state->chunk_size();
+        // Size the chunk by the row width observed by the previous chunk sources of this scan.
+        if (const size_t row_bytes = _scan_ctx->observed_row_bytes();
+            config::pipeline_target_chunk_bytes > 0 && row_bytes > 0) {
+            const size_t max_chunk_size = _params.chunk_size;
+            const size_t min_chunk_size = std::min<size_t>(MIN_ADAPTIVE_CHUNK_SIZE, max_chunk_size);
+            _params.chunk_size =
+                    std::clamp<size_t>(config::pipeline_target_chunk_bytes / row_bytes, min_chunk_size, max_chunk_size);
+        }
     }
 }
 
@@ -160,6 +187,12 @@ Status OlapChunkSource::_init_reader_params(const std::vector<std::unique_ptr<Ol
     _params.profile = _runtime_profile;
     _params.runtime_state = _runtime_state;
     _params.use_page_cache = !config::disable_storage_page_cache;
+    _params.use_direct_io = _runtime_state->query_options().__isset.enable_scan_direct_io &&
+                            _runtime_state->query_options().enable_scan_direct_io;
+    if (auto* fragment_ctx = _runtime_state->fragment_ctx();
+        fragment_ctx != nullptr && fragment_ctx->workgroup() != nullptr) {
+        _params.use_direct_io |= fragment_ctx->workgroup()->scan_direct_io();
+    }
     if (thrift_olap_scan_node.__isset.sorted_by_keys_per_tablet) {
         _params.sorted_by_keys_per_tablet = thrift_olap_scan_node.sorted_by_keys_per_tablet;
     }
@@ -168,7 +201,7 @@ Status OlapChunkSource::_init_reader_params(const std::vector<std::unique_ptr<Ol
     _morsel->init_tablet_reader_params(&_params);
     std::vector<PredicatePtr> preds;
     RETURN_IF_ERROR(_scan_ctx->conjuncts_manager().get_column_predicates(parser, &preds));
-    _decide_chunk_size(!preds.empty());
+    _decide_chunk_size(!preds.empty() || !_scan_ctx->fused_conjunct_ctxs().empty());
     for (auto& p : preds) {
         if (parser->can_pushdown(p.get())) {
             _params.predicates.push_back(p.get());
@@ -269,6 +302,7 @@ Status OlapChunkSource::_init_olap_reader(RuntimeState* runtime_state) {
     RETURN_IF_ERROR(_init_unused_output_columns(thrift_olap_scan_node.unused_output_column_name));
     RETURN_IF_ERROR(_init_scanner_columns(scanner_columns));
     RETURN_IF_ERROR(_init_reader_params(_scan_ctx->key_ranges(), scanner_columns, reader_columns));
+    _reader_columns = reader_columns;
     const TabletSchema& tablet_schema = _tablet->tablet_schema();
     starrocks::Schema child_schema = ChunkHelper::convert_schema(tablet_schema, reader_columns);
 
@@ -281,7 +315,8 @@ Status OlapChunkSource::_init_olap_reader(RuntimeState* runtime_state) {
         _prj_iter = new_projection_iterator(output_schema, _reader);
     }
 
-    if (!_scan_ctx->not_push_down_conjuncts().empty() || !_not_push_down_predicates.empty()) {
+    if (!_scan_ctx->not_push_down_conjuncts().empty() || !_not_push_down_predicates.empty() ||
+        !_scan_ctx->fused_conjunct_ctxs().empty()) {
         _expr_filter_timer = ADD_TIMER(_runtime_profile, "ExprFilterTime");
     }
 
@@ -296,7 +331,11 @@ Status OlapChunkSource::_init_olap_reader(RuntimeState* runtime_state) {
 }
 
 Status OlapChunkSource::_read_chunk(RuntimeState* state, ChunkPtr* chunk) {
-    chunk->reset(ChunkHelper::new_chunk_pooled(_prj_iter->output_schema(), _runtime_state->chunk_size(), true));
+    if (_chunk_recycler == nullptr) {
+        _chunk_recycler = std::make_shared<ChunkRecycler>(_prj_iter->output_schema(), _runtime_state->chunk_size(),
+                                                          std::max(config::olap_scan_recycled_chunk_num, 0));
+    }
+    *chunk = _chunk_recycler->new_chunk();
     return _read_chunk_from_storage(_runtime_state, (*chunk).get());
 }
 
@@ -358,6 +397,11 @@ Status OlapChunkSource::_read_chunk_from_storage(RuntimeState* state, Chunk* chu
             RETURN_IF_ERROR(ExecNode::eval_conjuncts(_scan_ctx->not_push_down_conjuncts(), chunk));
             DCHECK_CHUNK(chunk);
         }
+        if (!_scan_ctx->fused_conjunct_ctxs().empty()) {
+            SCOPED_TIMER(_expr_filter_timer);
+            RETURN_IF_ERROR(ExecNode::eval_conjuncts(_scan_ctx->fused_conjunct_ctxs(), chunk));
+            DCHECK_CHUNK(chunk);
+        }
         TRY_CATCH_ALLOC_SCOPE_END()
 
     } while (chunk->num_rows() == 0);
@@ -373,6 +417,9 @@ void OlapChunkSource::_update_realtime_counter(Chunk* chunk) {
     auto& stats = _reader->stats();
     size_t num_rows = chunk->num_rows();
     _num_rows_read += num_rows;
+    if (config::pipeline_target_chunk_bytes > 0 && num_rows > 0) {
+        _scan_ctx->update_observed_row_bytes(chunk->bytes_usage() / num_rows);
+    }
     _scan_rows_num = stats.raw_rows_read;
     _scan_bytes = stats.bytes_read;
     _cpu_time_spent_ns = stats.decompress_ns + stats.vec_cond_ns + stats.del_filter_ns;
@@ -417,6 +464,7 @@ void OlapChunkSource::_update_counter() {
     // When we support metric classification, we can disassemble it again.
     COUNTER_UPDATE(_pred_filter_timer, cond_evaluate_ns);
     COUNTER_UPDATE(_pred_filter_counter, _reader->stats().rows_vec_cond_filtered);
+    COUNTER_UPDATE(_pred_filter_skipped_counter, _reader->stats().rows_zone_map_all_matched);
     COUNTER_UPDATE(_del_vec_filter_counter, _reader->stats().rows_del_vec_filtered);
 
     COUNTER_UPDATE(_seg_zm_filtered_counter, _reader->stats().segment_stats_filtered);
@@ -427,6 +475,7 @@ void OlapChunkSource::_update_counter() {
 
     COUNTER_UPDATE(_read_pages_num_counter, _reader->stats().total_pages_num);
     COUNTER_UPDATE(_cached_pages_num_counter, _reader->stats().cached_pages_num);
+    COUNTER_UPDATE(_shared_read_pages_num_counter, _reader->stats().shared_read_pages_num);
 
     COUNTER_UPDATE(_bi_filtered_counter, _reader->stats().rows_bitmap_index_filtered);
     COUNTER_UPDATE(_bi_filter_timer, _reader->stats().bitmap_index_filter_timer);
@@ -441,6 +490,12 @@ void OlapChunkSource::_update_counter() {
     StarRocksMetrics::instance()->query_scan_bytes.increment(_scan_bytes);
     StarRocksMetrics::instance()->query_scan_rows.increment(_scan_rows_num);
 
+    if (_tablet->data_dir() != nullptr) {
+        // the io latency of the queries adapts the compaction io budget of the disk
+        _tablet->data_dir()->compaction_io_throttle()->add_query_io(
+                _reader->stats().io_ns, _reader->stats().total_pages_num - _reader->stats().cached_pages_num);
+    }
+
     if (_reader->stats().decode_dict_ns > 0) {
         RuntimeProfile::Counter* c = ADD_TIMER(_runtime_profile, "DictDecode");
         COUNTER_UPDATE(c, _reader->stats().decode_dict_ns);
@@ -31,6 +31,7 @@
 
 namespace starrocks {
 
+class ChunkRecycler;
 class SlotDescriptor;
 
 namespace pipeline {
@@ -48,6 +49,12 @@ public:
     Status prepare(RuntimeState* state) override;
     void close(RuntimeState* state) override;
 
+    int64_t io_device_id() const override;
+
+    int64_t tablet_id() const { return _tablet->tablet_id(); }
+    // The ids of the columns read from the storage, which are prefetched for the following morsels.
+    const std::vector<uint32_t>& reader_columns() const { return _reader_columns; }
+
 private:
     Status _read_chunk(RuntimeState* state, ChunkPtr* chunk) override;
 
@@ -67,6 +74,9 @@ private:
     void _decide_chunk_size(bool has_predicate);
 
 private:
+    // The lower bound of the chunk size decided by pipeline_target_chunk_bytes.
+    static constexpr size_t MIN_ADAPTIVE_CHUNK_SIZE = 128;
+
     TabletReaderParams _params{};
     OlapScanNode* _scan_node;
     OlapScanContext* _scan_ctx;
@@ -92,8 +102,11 @@ private:
     std::shared_ptr<TabletReader> _reader;
     // projection iterator, doing the job of choosing |_scanner_columns| from |_reader_columns|.
     std::shared_ptr<ChunkIterator> _prj_iter;
+    // The chunks released by the consumers are reused for the next chunks.
+    std::shared_ptr<ChunkRecycler> _chunk_recycler;
 
     std::unordered_set<uint32_t> _unused_output_column_ids;
+    std::vector<uint32_t> _reader_columns;
 
     // slot descriptors for each one of |output_columns|.
     std::vector<SlotDescriptor*> _query_slots;
@@ -112,6 +125,7 @@ private:
     RuntimeProfile::Counter* _read_uncompressed_counter = nullptr;
     RuntimeProfile::Counter* _raw_rows_counter = nullptr;
     RuntimeProfile::Counter* _pred_filter_counter = nullptr;
+    RuntimeProfile::Counter* _pred_filter_skipped_counter = nullptr;
     RuntimeProfile::Counter* _del_vec_filter_counter = nullptr;
     RuntimeProfile::Counter* _pred_filter_timer = nullptr;
     RuntimeProfile::Counter* _chunk_copy_timer = nullptr;
@@ -130,6 +144,7 @@ private:
     RuntimeProfile::Counter* _block_fetch_timer = nullptr;
     RuntimeProfile::Counter* _read_pages_num_counter = nullptr;
     RuntimeProfile::Counter* _cached_pages_num_counter = nullptr;
+    RuntimeProfile::Counter* _shared_read_pages_num_counter = nullptr;
     RuntimeProfile::Counter* _bi_filtered_counter = nullptr;
     RuntimeProfile::Counter* _bi_filter_timer = nullptr;
     RuntimeProfile::Counter* _pushdown_predicates_counter = nullptr;
@@ -76,6 +76,29 @@ Status OlapScanContext::capture_tablet_rowsets(const std::vector<TInternalScanRa
     return Status::OK();
 }
 
+std::vector<RowsetSharedPtr> OlapScanContext::acquire_rowsets_to_prefetch(int64_t tablet_id, size_t num_tablets) {
+    std::vector<RowsetSharedPtr> rowsets;
+
+    std::lock_guard<std::mutex> l(_prefetch_mutex);
+    _prefetched_tablets.resize(_tablets.size(), false);
+    auto it = std::find_if(_tablets.begin(), _tablets.end(),
+                           [tablet_id](const auto& tablet) { return tablet->tablet_id() == tablet_id; });
+    if (it == _tablets.end()) {
+        return rowsets;
+    }
+    size_t tablet_idx = it - _tablets.begin();
+    _prefetched_tablets[tablet_idx] = true;
+    for (size_t i = tablet_idx + 1; i < _tablets.size() && i <= tablet_idx + num_tablets; i++) {
+        if (_prefetched_tablets[i]) {
+            continue;
+        }
+        _prefetched_tablets[i] = true;
+        rowsets.insert(rowsets.end(), _tablet_rowsets[i].begin(), _tablet_rowsets[i].end());
+    }
+    Rowset::acquire_readers(rowsets);
+    return rowsets;
+}
+
 Status OlapScanContext::parse_conjuncts(RuntimeState* state, const std::vector<ExprContext*>& runtime_in_filters,
                                         RuntimeFilterProbeCollector* runtime_bloom_filters) {
     const TOlapScanNode& thrift_olap_scan_node = _scan_node->thrift_olap_scan_node();
@@ -135,6 +158,7 @@ OlapScanContextPtr OlapScanContextFactory::get_or_create(int32_t driver_sequence
 
     if (_contexts[idx] == nullptr) {
         _contexts[idx] = std::make_shared<OlapScanContext>(_scan_node, _dop, _shared_scan, _chunk_buffer);
+        _contexts[idx]->set_fused_select(_fused_conjunct_ctxs, _fused_limit);
     }
     return _contexts[idx];
 }
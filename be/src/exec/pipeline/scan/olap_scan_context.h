@@ -57,6 +57,20 @@ public:
     OlapScanNode* scan_node() const { return _scan_node; }
     OlapScanConjunctsManager& conjuncts_manager() { return _conjuncts_manager; }
     const std::vector<ExprContext*>& not_push_down_conjuncts() const { return _not_push_down_conjuncts; }
+    // The conjuncts and limit of the parent SelectNode fused into the scan, evaluated by OlapChunkSource.
+    void set_fused_select(const std::vector<ExprContext*>& conjunct_ctxs, int64_t limit) {
+        _fused_conjunct_ctxs = conjunct_ctxs;
+        _fused_limit = limit;
+    }
+    const std::vector<ExprContext*>& fused_conjunct_ctxs() const { return _fused_conjunct_ctxs; }
+    int64_t fused_limit() const { return _fused_limit; }
+
+    // The average bytes per row of the latest chunk read by the chunk sources, used to decide the chunk size
+    // of the following chunk sources by pipeline_target_chunk_bytes.
+    size_t observed_row_bytes() const { return _observed_row_bytes.load(std::memory_order_relaxed); }
+    void update_observed_row_bytes(size_t row_bytes) {
+        _observed_row_bytes.store(row_bytes, std::memory_order_relaxed);
+    }
     const std::vector<std::unique_ptr<OlapScanRange>>& key_ranges() const { return _key_ranges; }
     BalancedChunkBuffer& get_chunk_buffer() { return _chunk_buffer; }
 
@@ -71,6 +85,9 @@ public:
     Status capture_tablet_rowsets(const std::vector<TInternalScanRange*>& olap_scan_ranges);
     const std::vector<TabletSharedPtr>& tablets() const { return _tablets; }
     const std::vector<std::vector<RowsetSharedPtr>>& tablet_rowsets() const { return _tablet_rowsets; };
+    // Return the row sets of at most |num_tablets| tablets following |tablet_id|, which haven't been prefetched yet.
+    // The row sets are acquired by the readers, and the caller must release them after prefetching.
+    std::vector<RowsetSharedPtr> acquire_rowsets_to_prefetch(int64_t tablet_id, size_t num_tablets);
 
 private:
     OlapScanNode* _scan_node;
@@ -79,6 +96,10 @@ private:
     OlapScanConjunctsManager _conjuncts_manager;
     // The conjuncts couldn't push down to storage engine
     std::vector<ExprContext*> _not_push_down_conjuncts;
+    // Owned by OlapScanOperatorFactory.
+    std::vector<ExprContext*> _fused_conjunct_ctxs;
+    int64_t _fused_limit = -1;
+    std::atomic<size_t> _observed_row_bytes = 0;
     std::vector<std::unique_ptr<OlapScanRange>> _key_ranges;
     DictOptimizeParser _dict_optimize_parser;
     ObjectPool _obj_pool;
@@ -100,6 +121,10 @@ private:
     // the row sets into _tablet_rowsets in the preparation phase to avoid the row sets being deleted.
     std::vector<TabletSharedPtr> _tablets;
     std::vector<std::vector<RowsetSharedPtr>> _tablet_rowsets;
+
+    std::mutex _prefetch_mutex;
+    // Whether the segments of each tablet have been prefetched or are being read.
+    std::vector<bool> _prefetched_tablets;
 };
 
 // OlapScanContextFactory creates different contexts for each scan operator, if _shared_scan is false.
@@ -118,6 +143,12 @@ public:
 
     OlapScanContextPtr get_or_create(int32_t driver_sequence);
 
+    // It must be invoked before any context is created.
+    void set_fused_select(const std::vector<ExprContext*>& conjunct_ctxs, int64_t limit) {
+        _fused_conjunct_ctxs = conjunct_ctxs;
+        _fused_limit = limit;
+    }
+
 private:
     OlapScanNode* const _scan_node;
     const int32_t _dop;
@@ -126,6 +157,9 @@ private:
     BalancedChunkBuffer _chunk_buffer; // Shared Chunk buffer for all the scan operators.
 
     std::vector<OlapScanContextPtr> _contexts;
+
+    std::vector<ExprContext*> _fused_conjunct_ctxs;
+    int64_t _fused_limit = -1;
 };
 
 } // namespace pipeline
@@ -15,12 +15,16 @@
 #include "exec/pipeline/scan/olap_scan_operator.h"
 
 #include "column/chunk.h"
+#include "common/config.h"
 #include "exec/olap_scan_node.h"
 #include "exec/pipeline/scan/olap_chunk_source.h"
 #include "exec/pipeline/scan/olap_scan_context.h"
+#include "exprs/expr.h"
 #include "runtime/current_thread.h"
 #include "runtime/exec_env.h"
 #include "runtime/runtime_state.h"
+#include "storage/rowset/rowset.h"
+#include "storage/rowset/segment.h"
 #include "storage/storage_engine.h"
 
 namespace starrocks::pipeline {
@@ -31,16 +35,32 @@ OlapScanOperatorFactory::OlapScanOperatorFactory(int32_t id, ScanNode* scan_node
         : ScanOperatorFactory(id, scan_node), _ctx_factory(std::move(ctx_factory)) {}
 
 Status OlapScanOperatorFactory::do_prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(Expr::prepare(_fused_conjunct_ctxs, state));
+    RETURN_IF_ERROR(Expr::open(_fused_conjunct_ctxs, state));
     return Status::OK();
 }
 
-void OlapScanOperatorFactory::do_close(RuntimeState*) {}
+void OlapScanOperatorFactory::do_close(RuntimeState* state) {
+    Expr::close(_fused_conjunct_ctxs, state);
+}
 
 OperatorPtr OlapScanOperatorFactory::do_create(int32_t dop, int32_t driver_sequence) {
     return std::make_shared<OlapScanOperator>(this, _id, driver_sequence, dop, _scan_node,
                                               _ctx_factory->get_or_create(driver_sequence));
 }
 
+bool OlapScanOperatorFactory::could_fuse_select() const {
+    // The runtime filters are evaluated by ScanOperator after the chunk sources,
+    // so the limit cannot be applied by the chunk sources in this case.
+    return config::enable_pipeline_scan_select_fusion && _scan_node->limit() == -1 && _fused_conjunct_ctxs.empty() &&
+           !has_runtime_filters() && !has_topn_filter();
+}
+
+void OlapScanOperatorFactory::fuse_select(std::vector<ExprContext*> conjunct_ctxs, int64_t limit) {
+    _fused_conjunct_ctxs = std::move(conjunct_ctxs);
+    _ctx_factory->set_fused_select(_fused_conjunct_ctxs, limit);
+}
+
 const std::vector<ExprContext*>& OlapScanOperatorFactory::partition_exprs() const {
     auto* olap_scan_node = down_cast<OlapScanNode*>(_scan_node);
     return olap_scan_node->bucket_exprs();
@@ -89,6 +109,9 @@ bool OlapScanOperator::is_finished() const {
 Status OlapScanOperator::do_prepare(RuntimeState*) {
     bool shared_scan = _ctx->is_shared_scan();
     _unique_metrics->add_info_string("SharedScan", shared_scan ? "True" : "False");
+    if (!_ctx->fused_conjunct_ctxs().empty()) {
+        _unique_metrics->add_info_string("FusedSelect", "True");
+    }
     return Status::OK();
 }
 
@@ -100,6 +123,40 @@ ChunkSourcePtr OlapScanOperator::create_chunk_source(MorselPtr morsel, int32_t c
                                              std::move(morsel), olap_scan_node, _ctx.get());
 }
 
+void OlapScanOperator::prefetch_next_morsels(RuntimeState* state, const ChunkSourcePtr& chunk_source) {
+    if (config::olap_scan_prefetch_tablet_num <= 0) {
+        return;
+    }
+    const auto* olap_chunk_source = down_cast<const OlapChunkSource*>(chunk_source.get());
+    auto rowsets = _ctx->acquire_rowsets_to_prefetch(olap_chunk_source->tablet_id(),
+                                                     config::olap_scan_prefetch_tablet_num);
+    if (rowsets.empty()) {
+        return;
+    }
+
+    // Release the row sets when the task is destroyed, whether it is executed or not.
+    std::shared_ptr<std::vector<RowsetSharedPtr>> prefetch_rowsets(
+            new std::vector<RowsetSharedPtr>(std::move(rowsets)), [](std::vector<RowsetSharedPtr>* rowsets) {
+                Rowset::release_readers(*rowsets);
+                delete rowsets;
+            });
+    auto work_function = [prefetch_rowsets, column_ids = olap_chunk_source->reader_columns()]() {
+        for (const auto& rowset : *prefetch_rowsets) {
+            // Prefetching is best-effort, and the errors will be reported by the scan of the tablet.
+            if (auto st = rowset->load(); !st.ok()) {
+                VLOG(2) << "failed to prefetch rowset " << rowset->rowset_id().to_string() << ": " << st;
+                continue;
+            }
+            for (const auto& segment : rowset->segments()) {
+                if (auto st = segment->prefetch(column_ids); !st.ok()) {
+                    VLOG(2) << "failed to prefetch segment " << segment->file_name() << ": " << st;
+                }
+            }
+        }
+    };
+    submit_prefetch_task(state, std::move(work_function));
+}
+
 void OlapScanOperator::attach_chunk_source(int32_t source_index) {
     _ctx->attach_shared_input(_driver_sequence, source_index);
 }
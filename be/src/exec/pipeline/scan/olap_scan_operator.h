@@ -43,8 +43,15 @@ public:
     TPartitionType::type partition_type() const override { return TPartitionType::BUCKET_SHUFFLE_HASH_PARTITIONED; }
     const std::vector<ExprContext*>& partition_exprs() const override;
 
+    // Whether the conjuncts and limit of the parent SelectNode could be evaluated by the chunk sources directly,
+    // which saves the operator boundaries and stops the scan early when the limit is reached.
+    // MUST be invoked after init_runtime_filter.
+    bool could_fuse_select() const;
+    void fuse_select(std::vector<ExprContext*> conjunct_ctxs, int64_t limit);
+
 private:
     OlapScanContextFactoryPtr _ctx_factory;
+    std::vector<ExprContext*> _fused_conjunct_ctxs;
 };
 
 class OlapScanOperator final : public ScanOperator {
@@ -73,6 +80,7 @@ protected:
     ChunkBufferTokenPtr pin_chunk(int num_chunks) override;
     bool is_buffer_full() const override;
     void set_buffer_finished() override;
+    void prefetch_next_morsels(RuntimeState* state, const ChunkSourcePtr& chunk_source) override;
 
 private:
     OlapScanContextPtr _ctx;
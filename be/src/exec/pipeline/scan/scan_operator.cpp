@@ -18,6 +18,7 @@
 
 #include "column/chunk.h"
 #include "exec/olap_scan_node.h"
+#include "exec/pipeline/fragment_context.h"
 #include "exec/pipeline/limit_operator.h"
 #include "exec/pipeline/pipeline_builder.h"
 #include "exec/pipeline/scan/connector_scan_operator.h"
@@ -99,6 +100,11 @@ void ScanOperator::close(RuntimeState* state) {
     _tablets_counter =
             ADD_COUNTER_SKIP_MERGE(_unique_metrics, "TabletCount", TUnit::UNIT, TCounterMergeType::SKIP_FIRST_MERGE);
     COUNTER_SET(_tablets_counter, static_cast<int64_t>(_source_factory()->num_total_original_morsels()));
+    if (auto* fixed_morsel_queue = dynamic_cast<FixedMorselQueue*>(_morsel_queue);
+        fixed_morsel_queue != nullptr && fixed_morsel_queue->num_stolen_morsels() > 0) {
+        auto* stolen_morsels_counter = ADD_COUNTER(_unique_metrics, "StolenMorselCount", TUnit::UNIT);
+        COUNTER_SET(stolen_morsels_counter, static_cast<int64_t>(fixed_morsel_queue->num_stolen_morsels()));
+    }
 
     _merge_chunk_source_profiles(state);
 
@@ -320,6 +326,8 @@ void ScanOperator::_finish_chunk_source_task(RuntimeState* state, int chunk_sour
             _close_chunk_source_unlocked(state, chunk_source_index);
         }
         _is_io_task_running[chunk_source_index] = false;
+        // The driver blocked by the running io tasks may be waiting for notification.
+        notify_readiness();
     }
 }
 
@@ -344,6 +352,7 @@ Status ScanOperator::_trigger_next_scan(RuntimeState* state, int chunk_source_in
     task.priority = OlapScanNode::compute_priority(_submit_task_counter->value());
     task.task_group = down_cast<const ScanOperatorFactory*>(_factory)->scan_task_group();
     task.peak_scan_task_queue_size_counter = _peak_scan_task_queue_size_counter;
+    task.io_device_id = _chunk_sources[chunk_source_index]->io_device_id();
     const auto io_task_start_nano = MonotonicNanos();
     task.work_function = [wp = _query_ctx, this, state, chunk_source_index, query_trace_ctx, driver_id,
                           io_task_start_nano]() {
@@ -353,6 +362,9 @@ Status ScanOperator::_trigger_next_scan(RuntimeState* state, int chunk_source_in
             SCOPED_SET_TRACE_INFO(driver_id, state->query_id(), state->fragment_instance_id());
             SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(state->instance_mem_tracker());
             SCOPED_THREAD_LOCAL_OPERATOR_MEM_TRACKER_SETTER(this);
+            SCOPED_SET_OPERATOR_TRACE_INFO(this);
+            SCOPED_IO_PURPOSE(io::IOPurpose::SCAN);
+            SCOPED_IO_STATS(&state->fragment_ctx()->io_stats());
 
             auto& chunk_source = _chunk_sources[chunk_source_index];
             [[maybe_unused]] std::string category;
@@ -467,11 +479,34 @@ Status ScanOperator::_pickup_morsel(RuntimeState* state, int chunk_source_index)
         }
         need_detach = false;
         RETURN_IF_ERROR(_trigger_next_scan(state, chunk_source_index));
+        prefetch_next_morsels(state, _chunk_sources[chunk_source_index]);
     }
 
     return Status::OK();
 }
 
+bool ScanOperator::submit_prefetch_task(RuntimeState* state, std::function<void()> work_function) {
+    int32_t driver_id = CurrentThread::current().get_driver_id();
+
+    workgroup::ScanTask task;
+    task.workgroup = _workgroup.get();
+    task.priority = OlapScanNode::compute_priority(_submit_task_counter->value());
+    task.task_group = down_cast<const ScanOperatorFactory*>(_factory)->scan_task_group();
+    task.peak_scan_task_queue_size_counter = _peak_scan_task_queue_size_counter;
+    task.work_function = [wp = _query_ctx, this, state, driver_id, work_function = std::move(work_function)]() {
+        if (auto sp = wp.lock()) {
+            SCOPED_SET_TRACE_INFO(driver_id, state->query_id(), state->fragment_instance_id());
+            SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(state->instance_mem_tracker());
+            SCOPED_THREAD_LOCAL_OPERATOR_MEM_TRACKER_SETTER(this);
+            SCOPED_SET_OPERATOR_TRACE_INFO(this);
+            SCOPED_IO_PURPOSE(io::IOPurpose::SCAN);
+            SCOPED_IO_STATS(&state->fragment_ctx()->io_stats());
+            work_function();
+        }
+    };
+    return _scan_executor->submit(std::move(task));
+}
+
 void ScanOperator::_merge_chunk_source_profiles(RuntimeState* state) {
     auto query_ctx = _query_ctx.lock();
     // _query_ctx uses lazy initialization, maybe it is not initialized
@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "exec/pipeline/source_operator.h"
 #include "exec/query_cache/cache_operator.h"
 #include "exec/query_cache/lane_arbiter.h"
@@ -54,6 +56,13 @@ public:
 
     Status set_finishing(RuntimeState* state) override;
 
+    // Only when the io tasks are saturated, the driver certainly waits for the io tasks of this operator,
+    // which notify the readiness after finished.
+    // Otherwise, it may wait for the chunk buffer or morsels shared with the other scan operators.
+    bool support_readiness_notification() const override {
+        return _num_running_io_tasks >= _io_tasks_per_scan_operator;
+    }
+
     StatusOr<ChunkPtr> pull_chunk(RuntimeState* state) override;
 
     void set_scan_executor(workgroup::ScanExecutor* scan_executor) { _scan_executor = scan_executor; }
@@ -92,6 +101,10 @@ protected:
     virtual ChunkBufferTokenPtr pin_chunk(int num_chunks) = 0;
     virtual bool is_buffer_full() const = 0;
     virtual void set_buffer_finished() = 0;
+    // Invoked after a chunk source of a new morsel is prepared, to warm up the data of the following morsels.
+    virtual void prefetch_next_morsels(RuntimeState* state, const ChunkSourcePtr& chunk_source) {}
+    // Submit a best-effort background io task, which is not accounted as a running io task of this operator.
+    bool submit_prefetch_task(RuntimeState* state, std::function<void()> work_function);
 
     // This method is only invoked when current morsel is reached eof
     // and all cached chunk of this morsel has benn read out
@@ -15,8 +15,10 @@
 #include "exec/pipeline/select_operator.h"
 
 #include "column/chunk.h"
+#include "common/config.h"
 #include "exprs/expr.h"
 #include "runtime/runtime_state.h"
+#include "simd/simd.h"
 
 namespace starrocks::pipeline {
 Status SelectOperator::prepare(RuntimeState* state) {
@@ -40,7 +42,7 @@ StatusOr<ChunkPtr> SelectOperator::pull_chunk(RuntimeState* state) {
      *      merge it into _pre_output_chunk.
      */
     if (!_pre_output_chunk) {
-        auto cur_size = _curr_chunk->num_rows();
+        auto cur_size = _curr_chunk->num_selected_rows();
         if (cur_size >= chunk_size / 2) {
             return std::move(_curr_chunk);
         } else {
@@ -58,12 +60,14 @@ StatusOr<ChunkPtr> SelectOperator::pull_chunk(RuntimeState* state) {
              *  else
              *      merge input chunk into _pre_output_chunk.
              */
-            auto cur_size = _curr_chunk->num_rows();
-            if (cur_size + _pre_output_chunk->num_rows() > chunk_size) {
+            auto cur_size = _curr_chunk->num_selected_rows();
+            if (cur_size + _pre_output_chunk->num_selected_rows() > chunk_size) {
                 auto output_chunk = _pre_output_chunk;
                 _pre_output_chunk = std::move(_curr_chunk);
                 return output_chunk;
             } else {
+                _pre_output_chunk->materialize_selection();
+                _curr_chunk->materialize_selection();
                 Columns& dest_columns = _pre_output_chunk->columns();
                 Columns& src_columns = _curr_chunk->columns();
                 size_t num_rows = cur_size;
@@ -85,11 +89,33 @@ bool SelectOperator::need_input() const {
 }
 
 Status SelectOperator::push_chunk(RuntimeState* state, const ChunkPtr& chunk) {
-    RETURN_IF_ERROR(eval_conjuncts_and_in_filters(_conjunct_ctxs, chunk.get()));
+    if (chunk->num_columns() < kMinColumnsToSelect || config::chunk_selection_min_density > 1) {
+        RETURN_IF_ERROR(eval_conjuncts_and_in_filters(_conjunct_ctxs, chunk.get()));
+    } else {
+        FilterPtr filter;
+        RETURN_IF_ERROR(eval_conjuncts_and_in_filters(_conjunct_ctxs, chunk.get(), &filter, false));
+        if (filter != nullptr) {
+            _filter_or_select(chunk, filter, state->chunk_size());
+        }
+    }
     _curr_chunk = chunk;
     return Status::OK();
 }
 
+void SelectOperator::_filter_or_select(const ChunkPtr& chunk, const FilterPtr& filter, size_t chunk_size) {
+    const size_t num_rows = chunk->num_rows();
+    const size_t num_selected = SIMD::count_nonzero(*filter);
+    if (num_selected == num_rows) {
+        return;
+    }
+    // the small chunks are merged with the others by pull_chunk, which needs them compacted
+    if (num_selected >= chunk_size / 2 && num_selected >= num_rows * config::chunk_selection_min_density) {
+        chunk->set_selection(filter);
+    } else {
+        chunk->filter(*filter);
+    }
+}
+
 Status SelectOperator::reset_state(starrocks::RuntimeState* state, const std::vector<ChunkPtr>& refill_chunks) {
     _curr_chunk.reset();
     _pre_output_chunk.reset();
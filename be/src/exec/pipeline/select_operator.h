@@ -47,6 +47,12 @@ public:
     Status reset_state(starrocks::RuntimeState* state, const std::vector<ChunkPtr>& refill_chunks) override;
 
 private:
+    // The chunks with fewer columns are always compacted, which is cheap.
+    static constexpr size_t kMinColumnsToSelect = 6;
+
+    // Filter |chunk| by |filter|, or mark the remaining rows by a selection to compact them later.
+    static void _filter_or_select(const ChunkPtr& chunk, const FilterPtr& filter, size_t chunk_size);
+
     // _curr_chunk used to receive input chunks, and apply predicate filtering.
     ChunkPtr _curr_chunk = nullptr;
     // _pre_output_chunk used to merge small _curr_chunk until it's big enough, then return as output.
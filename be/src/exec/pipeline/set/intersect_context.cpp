@@ -54,8 +54,8 @@ StatusOr<ChunkPtr> IntersectContext::pull_chunk(RuntimeState* state) {
     size_t num_remained_keys = 0;
     _remained_keys.resize(state->chunk_size());
     while (_next_processed_iter != _hash_set->end() && num_remained_keys < state->chunk_size()) {
-        if (_next_processed_iter->hit_times == _intersect_times) {
-            _remained_keys[num_remained_keys++] = _next_processed_iter->slice;
+        if (_next_processed_iter->flag() == _intersect_times) {
+            _remained_keys[num_remained_keys++] = _next_processed_iter->slice();
         }
         ++_next_processed_iter;
     }
@@ -46,7 +46,7 @@ Status LocalMergeSortSourceOperator::set_finished(RuntimeState* state) {
 
 bool LocalMergeSortSourceOperator::has_output() const {
     return _sort_context->is_partition_sort_finished() && !_sort_context->is_output_finished() &&
-           _sort_context->is_partition_ready();
+           _sort_context->is_partition_ready() && _sort_context->is_output_ready();
 }
 
 bool LocalMergeSortSourceOperator::is_finished() const {
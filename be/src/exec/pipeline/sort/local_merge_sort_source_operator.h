@@ -28,6 +28,8 @@ class SortContext;
  * LocalMergeSortSourceOperator is used to merge multiple sorted datas from partion sort sink operator.
  * It is one instance and Execute in single threaded mode,  
  * It completely depends on SortContext with a heap to Dynamically filter out the smallest or largest data.
+ * The large sorted runs kept in memory are split into slices of disjoint key ranges and merged in parallel by
+ * SortContext, while this operator still outputs them in order.
  */
 class LocalMergeSortSourceOperator final : public SourceOperator {
 public:
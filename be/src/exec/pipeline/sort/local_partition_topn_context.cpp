@@ -18,6 +18,7 @@
 
 #include <utility>
 
+#include "column/column_helper.h"
 #include "exec/chunks_sorter_topn.h"
 
 namespace starrocks::pipeline {
@@ -55,25 +56,56 @@ Status LocalPartitionTopnContext::prepare(RuntimeState* state) {
         _has_nullable_key = _has_nullable_key || _partition_types[i].is_nullable;
     }
 
+    // The kept rows of PartitionTopn are exact after every update, so the offset isn't supported.
+    _use_partition_topn = _offset == 0 && _partition_limit > 0 && _partition_limit <= kMaxPartitionTopnLimit &&
+                          (_topn_type == TTopNType::ROW_NUMBER || _topn_type == TTopNType::RANK);
+    _sort_desc = SortDescs(_is_asc_order, _is_null_first);
+    _chunk_size = state->chunk_size();
+
     _chunks_partitioner = std::make_unique<ChunksPartitioner>(_has_nullable_key, _partition_exprs, _partition_types);
     return _chunks_partitioner->prepare(state);
 }
 
 Status LocalPartitionTopnContext::push_one_chunk_to_partitioner(RuntimeState* state, const ChunkPtr& chunk) {
+    Status update_st;
     auto st = _chunks_partitioner->offer<true>(
             chunk,
             [this, state](size_t partition_idx) {
+                if (_use_partition_topn) {
+                    _partition_topns.emplace_back();
+                    return;
+                }
                 _chunks_sorters.emplace_back(std::make_shared<ChunksSorterTopn>(
                         state, &_sort_exprs, &_is_asc_order, &_is_null_first, _sort_keys, _offset, _partition_limit,
                         _topn_type, ChunksSorterTopn::tunning_buffered_chunks(_partition_limit)));
             },
-            [this, state](size_t partition_idx, const ChunkPtr& chunk) {
-                _chunks_sorters[partition_idx]->update(state, chunk);
+            [this, state, &update_st](size_t partition_idx, const ChunkPtr& chunk) {
+                if (update_st.ok()) {
+                    update_st = _update_partition(state, partition_idx, chunk);
+                }
             });
+    RETURN_IF_ERROR(st);
+    RETURN_IF_ERROR(update_st);
     if (_chunks_partitioner->is_passthrough()) {
-        transfer_all_chunks_from_partitioner_to_sorters(state);
+        RETURN_IF_ERROR(transfer_all_chunks_from_partitioner_to_sorters(state));
+    }
+    return Status::OK();
+}
+
+Status LocalPartitionTopnContext::_update_partition(RuntimeState* state, size_t partition_idx,
+                                                    const ChunkPtr& chunk) {
+    if (!_use_partition_topn) {
+        return _chunks_sorters[partition_idx]->update(state, chunk);
+    }
+    Columns order_by_columns;
+    order_by_columns.reserve(_sort_exprs.size());
+    for (auto* expr_ctx : _sort_exprs) {
+        ASSIGN_OR_RETURN(auto column, expr_ctx->evaluate(chunk.get()));
+        order_by_columns.push_back(ColumnHelper::unpack_and_duplicate_const_column(chunk->num_rows(), column));
     }
-    return st;
+    return _partition_topns[partition_idx].add(state->cancelled_ref(), chunk, std::move(order_by_columns),
+                                               _sort_desc, _partition_limit, _topn_type == TTopNType::RANK,
+                                               &_rejected_rows);
 }
 
 void LocalPartitionTopnContext::sink_complete() {
@@ -85,11 +117,13 @@ Status LocalPartitionTopnContext::transfer_all_chunks_from_partitioner_to_sorter
         return Status::OK();
     }
 
-    RETURN_IF_ERROR(
-            _chunks_partitioner->consume_from_hash_map([this, state](int32_t partition_idx, const ChunkPtr& chunk) {
-                _chunks_sorters[partition_idx]->update(state, chunk);
-                return true;
+    Status update_st;
+    RETURN_IF_ERROR(_chunks_partitioner->consume_from_hash_map(
+            [this, state, &update_st](int32_t partition_idx, const ChunkPtr& chunk) {
+                update_st = _update_partition(state, partition_idx, chunk);
+                return update_st.ok();
             }));
+    RETURN_IF_ERROR(update_st);
 
     for (auto& chunks_sorter : _chunks_sorters) {
         RETURN_IF_ERROR(chunks_sorter->done(state));
@@ -101,9 +135,9 @@ Status LocalPartitionTopnContext::transfer_all_chunks_from_partitioner_to_sorter
 
 bool LocalPartitionTopnContext::has_output() {
     if (_chunks_partitioner->is_passthrough() && _is_transfered) {
-        return _sorter_index < _chunks_sorters.size() || !_chunks_partitioner->is_passthrough_buffer_empty();
+        return _sorter_index < _num_partitions() || !_chunks_partitioner->is_passthrough_buffer_empty();
     }
-    return _is_sink_complete && _sorter_index < _chunks_sorters.size();
+    return _is_sink_complete && _sorter_index < _num_partitions();
 }
 
 bool LocalPartitionTopnContext::is_finished() {
@@ -115,7 +149,12 @@ bool LocalPartitionTopnContext::is_finished() {
 
 StatusOr<ChunkPtr> LocalPartitionTopnContext::pull_one_chunk() {
     ChunkPtr chunk = nullptr;
-    if (_sorter_index < _chunks_sorters.size()) {
+    if (_use_partition_topn) {
+        chunk = pull_one_chunk_from_partition_topns();
+        if (chunk != nullptr) {
+            return chunk;
+        }
+    } else if (_sorter_index < _chunks_sorters.size()) {
         ASSIGN_OR_RETURN(chunk, pull_one_chunk_from_sorters());
         if (chunk != nullptr) {
             return chunk;
@@ -137,6 +176,26 @@ StatusOr<ChunkPtr> LocalPartitionTopnContext::pull_one_chunk_from_sorters() {
     return chunk;
 }
 
+ChunkPtr LocalPartitionTopnContext::pull_one_chunk_from_partition_topns() {
+    ChunkPtr chunk = nullptr;
+    // The kept rows of a partition are few, so gather the rows of the partitions into one chunk.
+    while (_sorter_index < _partition_topns.size() && (chunk == nullptr || chunk->num_rows() < _chunk_size)) {
+        auto& partition_topn = _partition_topns[_sorter_index++];
+        // The kept rows are released once pulled, so the first chunk is owned by the output and can be appended.
+        ChunkPtr partition_chunk = partition_topn.chunk();
+        partition_topn.reset();
+        if (partition_chunk == nullptr) {
+            continue;
+        }
+        if (chunk == nullptr) {
+            chunk = std::move(partition_chunk);
+        } else {
+            chunk->append(*partition_chunk);
+        }
+    }
+    return chunk;
+}
+
 LocalPartitionTopnContextFactory::LocalPartitionTopnContextFactory(
         RuntimeState*, const TTopNType::type topn_type, bool is_merging, const std::vector<ExprContext*>& sort_exprs,
         std::vector<bool> is_asc_order, std::vector<bool> is_null_first, const std::vector<TExpr>& t_partition_exprs,
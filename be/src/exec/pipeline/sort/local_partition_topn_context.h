@@ -18,6 +18,7 @@
 
 #include "exec/chunks_sorter.h"
 #include "exec/partition/chunks_partitioner.h"
+#include "exec/pipeline/sort/partition_topn.h"
 #include "runtime/runtime_state.h"
 
 namespace starrocks {
@@ -42,8 +43,14 @@ using LocalPartitionTopnContextFactoryPtr = std::shared_ptr<LocalPartitionTopnCo
 //                                   │               │
 //                                   │               │
 //                                   └────► topn ────┘
+//
+// If only a few rows are kept for each partition, every partition holds a compact PartitionTopn instead of a
+// ChunksSorterTopn, so a large number of partitions cost little more than the rows kept.
 class LocalPartitionTopnContext {
 public:
+    // The max number of the kept rows of a partition to use PartitionTopn.
+    static constexpr int64_t kMaxPartitionTopnLimit = 1024;
+
     LocalPartitionTopnContext(const std::vector<TExpr>& t_partition_exprs, const std::vector<ExprContext*>& sort_exprs,
                               std::vector<bool> is_asc_order, std::vector<bool> is_null_first, std::string sort_keys,
                               int64_t offset, int64_t partition_limit, const TTopNType::type topn_type);
@@ -68,10 +75,22 @@ public:
     // Pull one chunk from sorters or passthrough_buffer
     StatusOr<ChunkPtr> pull_one_chunk();
 
+    // The number of the rows dropped by comparing with the last kept row of the PartitionTopns
+    size_t rejected_rows() const { return _rejected_rows; }
+
 private:
     // Pull one chunk from one of the sorters
     // The output chunk stream is unordered
     StatusOr<ChunkPtr> pull_one_chunk_from_sorters();
+    // Pull the kept rows of the next partitions, up to chunk_size rows
+    ChunkPtr pull_one_chunk_from_partition_topns();
+
+    // Add the rows of one partition to its sorter or PartitionTopn
+    Status _update_partition(RuntimeState* state, size_t partition_idx, const ChunkPtr& chunk);
+
+    size_t _num_partitions() const {
+        return _use_partition_topn ? _partition_topns.size() : _chunks_sorters.size();
+    }
 
     const std::vector<TExpr>& _t_partition_exprs;
     std::vector<ExprContext*> _partition_exprs;
@@ -94,6 +113,14 @@ private:
     int64_t _partition_limit;
     const TTopNType::type _topn_type;
 
+    // Every partition holds a PartitionTopn instead of a chunks_sorter if it's true
+    bool _use_partition_topn = false;
+    std::vector<PartitionTopn> _partition_topns;
+    SortDescs _sort_desc;
+    int32_t _chunk_size = 0;
+    // The number of the rows dropped by comparing with the last kept row of the partitions
+    size_t _rejected_rows = 0;
+
     int32_t _sorter_index = 0;
 };
 
@@ -39,6 +39,8 @@ Status LocalPartitionTopnSinkOperator::push_chunk(RuntimeState* state, const Chu
 
 Status LocalPartitionTopnSinkOperator::set_finishing(RuntimeState* state) {
     RETURN_IF_ERROR(_partition_topn_ctx->transfer_all_chunks_from_partitioner_to_sorters(state));
+    COUNTER_SET(ADD_COUNTER(_unique_metrics, "RejectedRows", TUnit::UNIT),
+                static_cast<int64_t>(_partition_topn_ctx->rejected_rows()));
     _partition_topn_ctx->sink_complete();
     _is_finished = true;
     return Status::OK();
@@ -0,0 +1,115 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "exec/pipeline/sort/partition_topn.h"
+
+#include <algorithm>
+
+#include "exec/sorting/sort_permute.h"
+
+namespace starrocks::pipeline {
+
+Status PartitionTopn::add(const std::atomic<bool>& cancel, const ChunkPtr& chunk, Columns order_by_columns,
+                          const SortDescs& sort_desc, size_t limit, bool limit_by_rank, size_t* rejected_rows) {
+    const size_t num_rows = chunk->num_rows();
+    if (num_rows == 0) {
+        return Status::OK();
+    }
+    DCHECK_GT(limit, 0);
+    DCHECK_EQ(order_by_columns.size(), sort_desc.num_columns());
+
+    const size_t num_kept_rows = this->num_rows();
+    std::vector<ChunkPtr> chunks;
+    std::vector<Columns> vertical_chunks;
+    Permutation perm;
+    perm.reserve(num_kept_rows + num_rows);
+    if (num_kept_rows > 0) {
+        chunks.push_back(_chunk);
+        vertical_chunks.push_back(_order_by_columns);
+        for (uint32_t i = 0; i < num_kept_rows; i++) {
+            perm.push_back({0, i});
+        }
+    }
+    const auto input_index = static_cast<uint32_t>(chunks.size());
+    chunks.push_back(chunk);
+    vertical_chunks.push_back(order_by_columns);
+
+    if (num_kept_rows >= limit) {
+        // Only the rows before the last kept row, or equal to it for rank, may be kept.
+        std::vector<Datum> last_row;
+        last_row.reserve(_order_by_columns.size());
+        for (const auto& column : _order_by_columns) {
+            last_row.push_back(column->get(num_kept_rows - 1));
+        }
+        CompareVector cmp_vector(num_rows, 0);
+        compare_columns(order_by_columns, cmp_vector, last_row, sort_desc);
+        const int8_t max_cmp = limit_by_rank ? 0 : -1;
+        for (uint32_t i = 0; i < num_rows; i++) {
+            if (cmp_vector[i] <= max_cmp) {
+                perm.push_back({input_index, i});
+            }
+        }
+        *rejected_rows += num_kept_rows + num_rows - perm.size();
+        if (perm.size() == num_kept_rows) {
+            return Status::OK();
+        }
+    } else {
+        for (uint32_t i = 0; i < num_rows; i++) {
+            perm.push_back({input_index, i});
+        }
+    }
+
+    if (!limit_by_rank) {
+        RETURN_IF_ERROR(sort_vertical_chunks(cancel, vertical_chunks, sort_desc, perm, limit));
+    } else {
+        // The rows after the limit-th row aren't in order if sorted with limit, so sort all of them to find the
+        // rows tied with the limit-th row.
+        RETURN_IF_ERROR(sort_vertical_chunks(cancel, vertical_chunks, sort_desc, perm, perm.size()));
+        size_t peer_group_end = limit;
+        for (; peer_group_end < perm.size(); peer_group_end++) {
+            const auto& cur = perm[peer_group_end];
+            const auto& prev = perm[peer_group_end - 1];
+            bool equal = true;
+            for (size_t col = 0; equal && col < order_by_columns.size(); col++) {
+                const auto& prev_column = *vertical_chunks[prev.chunk_index][col];
+                equal = vertical_chunks[cur.chunk_index][col]->compare_at(cur.index_in_chunk, prev.index_in_chunk,
+                                                                          prev_column, 1) == 0;
+            }
+            if (!equal) {
+                break;
+            }
+        }
+        perm.resize(std::min(peer_group_end, perm.size()));
+    }
+
+    ChunkPtr kept_chunk = chunk->clone_empty_with_slot(perm.size());
+    materialize_by_permutation(kept_chunk.get(), chunks, perm);
+    Columns kept_columns;
+    kept_columns.reserve(order_by_columns.size());
+    for (size_t col = 0; col < order_by_columns.size(); col++) {
+        Columns columns;
+        for (const auto& vertical_chunk : vertical_chunks) {
+            columns.push_back(vertical_chunk[col]);
+        }
+        ColumnPtr kept_column = order_by_columns[col]->clone_empty();
+        materialize_column_by_permutation(kept_column.get(), columns, perm);
+        kept_columns.push_back(std::move(kept_column));
+    }
+    _chunk = std::move(kept_chunk);
+    _order_by_columns = std::move(kept_columns);
+    return Status::OK();
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,58 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <atomic>
+
+#include "column/chunk.h"
+#include "column/vectorized_fwd.h"
+#include "common/status.h"
+#include "exec/sorting/sorting.h"
+
+namespace starrocks::pipeline {
+
+// PartitionTopn keeps the top rows of one partition of LocalPartitionTopnContext.
+// It's much lighter than a ChunksSorterTopn, which buffers a few chunks before every partial sort: only the kept rows
+// and their order by columns are held. Once it's full, the coming rows are compared with the last kept row, and the
+// rows behind it are dropped before merged into the kept rows.
+// The sort descs and the limit are shared by all the partitions, so they are passed in rather than held.
+class PartitionTopn {
+public:
+    // Merge the rows of |chunk| into the kept rows, keep at most |limit| rows, or the rows of whose rank is not
+    // larger than |limit| if |limit_by_rank|.
+    // |order_by_columns| are the evaluated order by columns of |chunk|, which mustn't be const columns.
+    // |rejected_rows| is increased by the number of the rows dropped by comparing with the last kept row.
+    Status add(const std::atomic<bool>& cancel, const ChunkPtr& chunk, Columns order_by_columns,
+               const SortDescs& sort_desc, size_t limit, bool limit_by_rank, size_t* rejected_rows);
+
+    // The kept rows in order, nullptr if there is no row.
+    const ChunkPtr& chunk() const { return _chunk; }
+
+    size_t num_rows() const { return _chunk == nullptr ? 0 : _chunk->num_rows(); }
+
+    int64_t mem_usage() const { return _chunk == nullptr ? 0 : _chunk->memory_usage(); }
+
+    void reset() {
+        _chunk.reset();
+        _order_by_columns.clear();
+    }
+
+private:
+    ChunkPtr _chunk;
+    Columns _order_by_columns;
+};
+
+} // namespace starrocks::pipeline
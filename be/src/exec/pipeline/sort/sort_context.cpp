@@ -19,16 +19,35 @@
 #include <utility>
 
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
 #include "exec/sorting/merge.h"
 #include "exec/sorting/sorting.h"
 #include "exprs/runtime_filter_bank.h"
 #include "runtime/chunk_cursor.h"
 #include "runtime/current_thread.h"
 #include "runtime/exec_env.h"
+#include "util/threadpool.h"
 
 namespace starrocks::pipeline {
 
+// The pool merging the slices of the sorted runs, nullptr if it can not be created.
+static ThreadPool* parallel_merge_pool() {
+    static std::unique_ptr<ThreadPool> pool = [] {
+        std::unique_ptr<ThreadPool> p;
+        auto st = ThreadPoolBuilder("sort_merge")
+                          .set_min_threads(0)
+                          .set_max_threads(std::max(1, config::sort_parallel_merge_threads))
+                          .set_idle_timeout(MonoDelta::FromMilliseconds(2000))
+                          .build(&p);
+        LOG_IF(WARNING, !st.ok()) << "Fail to create the sort merge pool, merge the sorted runs serially: " << st;
+        return p;
+    }();
+    return pool.get();
+}
+
 void SortContext::close(RuntimeState* state) {
+    // the merging slices reference the sorters
+    _parallel_merger.reset();
     _chunks_sorter_partitions.clear();
 }
 
@@ -56,7 +75,14 @@ bool SortContext::is_partition_ready() const {
     });
 }
 
+bool SortContext::is_output_ready() {
+    return !_merger_inited || _parallel_merger == nullptr || _parallel_merger->is_data_ready();
+}
+
 void SortContext::cancel() {
+    if (_parallel_merger != nullptr) {
+        _parallel_merger->cancel();
+    }
     for (const auto& sorter : _chunks_sorter_partitions) {
         if (sorter) {
             sorter->cancel();
@@ -67,12 +93,17 @@ void SortContext::cancel() {
 StatusOr<ChunkPtr> SortContext::pull_chunk() {
     _init_merger();
 
-    while (_required_rows > 0 && !_merger.is_eos()) {
+    while (_required_rows > 0 && !_is_merger_eos()) {
         if (_current_chunk.empty()) {
-            auto chunk = _merger.try_get_next();
+            ChunkUniquePtr chunk;
+            if (_parallel_merger != nullptr) {
+                ASSIGN_OR_RETURN(chunk, _parallel_merger->try_get_next());
+            } else {
+                chunk = _merger.try_get_next();
+            }
             // Input cursor maye short circuit
             if (!chunk) {
-                if (_merger.is_eos()) {
+                if (_is_merger_eos()) {
                     _required_rows = 0;
                 }
                 return nullptr;
@@ -114,6 +145,11 @@ Status SortContext::_init_merger() {
         _required_rows = ((_limit < 0) ? _total_rows.load() : std::min<int64_t>(_limit + _offset, _total_rows));
     }
 
+    if (_init_parallel_merger()) {
+        _merger_inited = true;
+        return Status::OK();
+    }
+
     _partial_cursors.reserve(_num_partition_sinkers);
     for (int i = 0; i < _num_partition_sinkers; i++) {
         ChunkProvider provider = [i, this](ChunkUniquePtr* out_chunk, bool* eos) -> bool {
@@ -140,6 +176,48 @@ Status SortContext::_init_merger() {
     return Status::OK();
 }
 
+bool SortContext::_init_parallel_merger() {
+    if (config::sort_parallel_merge_threads <= 0 || config::sort_parallel_merge_min_rows <= 0 ||
+        _total_rows < config::sort_parallel_merge_min_rows || _num_partition_sinkers <= 1) {
+        return false;
+    }
+    // the sort exprs are evaluated by the threads of the pool
+    if (!std::all_of(_sort_exprs.begin(), _sort_exprs.end(),
+                     [](ExprContext* ctx) { return ctx->root()->is_slotref(); })) {
+        return false;
+    }
+    std::vector<const SortedRuns*> inputs;
+    for (const auto& sorter : _chunks_sorter_partitions) {
+        const SortedRuns* runs = sorter->sorted_runs();
+        if (runs == nullptr) {
+            return false;
+        }
+        inputs.push_back(runs);
+    }
+    ThreadPool* pool = parallel_merge_pool();
+    if (pool == nullptr) {
+        return false;
+    }
+
+    auto materializer = [this](size_t input, ChunkUniquePtr chunk) {
+        return _chunks_sorter_partitions[input]->materialize_output(std::move(chunk));
+    };
+    auto merger = std::make_unique<ParallelMerger>(_sort_desc, &_sort_exprs, _state->chunk_size(), materializer);
+    // Split into more slices than the partitions, so that the small slices ahead of the output are merged soon.
+    size_t num_slices = kParallelMergeSlicesPerPartition * _num_partition_sinkers;
+    Status st = merger->init(pool, _state->instance_mem_tracker(), inputs, num_slices, _num_partition_sinkers);
+    if (!st.ok()) {
+        LOG(WARNING) << "Fail to merge the sorted runs in parallel, merge them serially: " << st;
+        return false;
+    }
+    _parallel_merger = std::move(merger);
+    return true;
+}
+
+bool SortContext::_is_merger_eos() {
+    return _parallel_merger != nullptr ? _parallel_merger->is_eos() : _merger.is_eos();
+}
+
 SortContextFactory::SortContextFactory(RuntimeState* state, const TTopNType::type topn_type, bool is_merging,
                                        std::vector<ExprContext*> sort_exprs, const std::vector<bool>& is_asc_order,
                                        const std::vector<bool>& is_null_first,
@@ -26,6 +26,7 @@
 #include "exec/pipeline/context_with_dependency.h"
 #include "exec/pipeline/runtime_filter_types.h"
 #include "exec/sorting/merge.h"
+#include "exec/sorting/parallel_merge.h"
 #include "exec/sorting/sorting.h"
 #include "exprs/runtime_filter_bank.h"
 
@@ -36,6 +37,8 @@ using SortContextPtr = std::shared_ptr<SortContext>;
 
 class SortContext final : public ContextWithDependency {
 public:
+    static constexpr size_t kParallelMergeSlicesPerPartition = 4;
+
     explicit SortContext(RuntimeState* state, const TTopNType::type topn_type, int64_t offset, int64_t limit,
                          const std::vector<ExprContext*>& sort_exprs, const SortDescs& sort_descs,
                          const std::vector<RuntimeFilterBuildDescriptor*>& build_runtime_filters)
@@ -58,6 +61,8 @@ public:
     bool is_partition_sort_finished() const;
     bool is_output_finished() const;
     bool is_partition_ready() const;
+    // Whether the next merged chunk could be pulled.
+    bool is_output_ready();
     void cancel();
 
     StatusOr<ChunkPtr> pull_chunk();
@@ -67,6 +72,9 @@ public:
 
 private:
     Status _init_merger();
+    // Merge the sorted runs of the partitions in parallel if all of them are kept in memory.
+    bool _init_parallel_merger();
+    bool _is_merger_eos();
 
     RuntimeState* _state;
     const TTopNType::type _topn_type;
@@ -82,6 +90,7 @@ private:
     std::vector<std::shared_ptr<ChunksSorter>> _chunks_sorter_partitions; // Partial sorters
     std::vector<std::unique_ptr<SimpleChunkSortCursor>> _partial_cursors;
     MergeCursorsCascade _merger;
+    std::unique_ptr<ParallelMerger> _parallel_merger;
     ChunkSlice _current_chunk;
     int64_t _required_rows = 0;
     bool _merger_inited = false;
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <functional>
 #include <utility>
 
 #include "exec/pipeline/operator.h"
@@ -139,10 +140,24 @@ public:
         return _source_factory()->group_dependent_pipelines();
     }
 
+    // The source operator supporting readiness notification must call notify_readiness(),
+    // whenever has_output() or is_finished() may become true.
+    // Then the driver blocked by this operator needn't be polled by PipelineDriverPoller,
+    // until it is notified.
+    virtual bool support_readiness_notification() const { return false; }
+    // It must be set before the driver is submitted.
+    void set_readiness_notifier(std::function<void()> notifier) { _readiness_notifier = std::move(notifier); }
+    void notify_readiness() const {
+        if (_readiness_notifier) {
+            _readiness_notifier();
+        }
+    }
+
 protected:
     const SourceOperatorFactory* _source_factory() const { return down_cast<const SourceOperatorFactory*>(_factory); }
 
     MorselQueue* _morsel_queue = nullptr;
+    std::function<void()> _readiness_notifier;
 };
 
 } // namespace pipeline
@@ -14,6 +14,8 @@
 
 #include "table_function_operator.h"
 
+#include "column/fixed_length_column.h"
+
 namespace starrocks::pipeline {
 
 void TableFunctionOperator::close(RuntimeState* state) {
@@ -101,73 +103,66 @@ Status TableFunctionOperator::prepare(RuntimeState* state) {
 
 StatusOr<ChunkPtr> TableFunctionOperator::pull_chunk(RuntimeState* state) {
     DCHECK(_input_chunk != nullptr);
-    size_t chunk_size = state->chunk_size();
-    size_t remain_chunk_size = chunk_size;
-    std::vector<ColumnPtr> output_columns;
+    const size_t chunk_size = state->chunk_size();
+    const size_t num_input_rows = _input_chunk->num_rows();
 
     _process_table_function();
 
-    output_columns.reserve(_outer_slots.size());
-    for (int _outer_slot : _outer_slots) {
-        output_columns.emplace_back(_input_chunk->get_column_by_slot_id(_outer_slot)->clone_empty());
-    }
-    for (size_t i = 0; i < _fn_result_slots.size(); ++i) {
-        output_columns.emplace_back(_table_function_result.first[i]->clone_empty());
-    }
-
+    const auto& offsets = down_cast<const UInt32Column*>(_table_function_result.second.get())->get_data();
+    DCHECK_LT(_input_chunk_index, offsets.size());
+    // The results of the consecutive input rows are consecutive, so the results of the output chunk are one range.
     // If _remain_repeat_times > 0, first use the remaining data of the previous chunk to construct this data
-    while (_remain_repeat_times > 0 || _input_chunk_index < _input_chunk->num_rows()) {
-        bool has_remain_repeat_times = _remain_repeat_times > 0;
+    const uint32_t start_offset = _remain_repeat_times > 0 ? offsets[_input_chunk_index + 1] - _remain_repeat_times
+                                                           : offsets[_input_chunk_index];
 
-        if (!has_remain_repeat_times) {
-            DCHECK_LT(_input_chunk_index + 1, _table_function_result.second->size());
-            _remain_repeat_times = _table_function_result.second->get(_input_chunk_index + 1).get_int32() -
-                                   _table_function_result.second->get(_input_chunk_index).get_int32();
-        }
-        size_t repeat_times = std::min(_remain_repeat_times, remain_chunk_size);
-        if (repeat_times == 0) {
-            ++_input_chunk_index;
-            continue;
-        }
-
-        // Build outer data, repeat multiple times
-        for (size_t i = 0; i < _outer_slots.size(); ++i) {
-            ColumnPtr& input_column_ptr = _input_chunk->get_column_by_slot_id(_outer_slots[i]);
-            Datum value = input_column_ptr->get(_input_chunk_index);
-            if (value.is_null()) {
-                DCHECK(output_columns[i]->is_nullable());
-                down_cast<NullableColumn*>(output_columns[i].get())->append_nulls(repeat_times);
-            } else {
-                output_columns[i]->append_value_multiple_times(&value, repeat_times);
-            }
-        }
-        // Build table function result
-        for (size_t i = 0; i < _fn_result_slots.size(); ++i) {
-            uint32_t start_offset;
-            if (has_remain_repeat_times) {
-                start_offset =
-                        _table_function_result.second->get(_input_chunk_index + 1).get_int32() - _remain_repeat_times;
-            } else {
-                start_offset = _table_function_result.second->get(_input_chunk_index).get_int32();
-            }
-            output_columns[_outer_slots.size() + i]->append(*(_table_function_result.first[i]), start_offset,
-                                                            repeat_times);
+    // Collect the input row of every output row, the outer columns are expanded by them at once.
+    _outer_indexes.clear();
+    size_t num_output_rows = 0;
+    while (num_output_rows < chunk_size && _input_chunk_index < num_input_rows) {
+        if (_remain_repeat_times == 0) {
+            _remain_repeat_times = offsets[_input_chunk_index + 1] - offsets[_input_chunk_index];
         }
-
-        remain_chunk_size -= repeat_times;
+        size_t repeat_times = std::min(_remain_repeat_times, chunk_size - num_output_rows);
+        _outer_indexes.insert(_outer_indexes.end(), repeat_times, _input_chunk_index);
+        num_output_rows += repeat_times;
         _remain_repeat_times -= repeat_times;
         if (_remain_repeat_times == 0) {
             ++_input_chunk_index;
         }
+    }
 
-        if (remain_chunk_size == 0) {
-            // Chunk is full
-            break;
+    // Every input row is output once, e.g. all the arrays have one element.
+    bool is_identity = num_output_rows == num_input_rows;
+    for (size_t i = 0; is_identity && i < num_output_rows; ++i) {
+        is_identity = _outer_indexes[i] == i;
+    }
+
+    std::vector<ColumnPtr> output_columns;
+    output_columns.reserve(_outer_slots.size() + _fn_result_slots.size());
+    for (SlotId outer_slot : _outer_slots) {
+        const ColumnPtr& input_column = _input_chunk->get_column_by_slot_id(outer_slot);
+        if (is_identity) {
+            output_columns.emplace_back(input_column);
+            continue;
+        }
+        ColumnPtr output_column = input_column->clone_empty();
+        output_column->append_selective(*input_column, _outer_indexes.data(), 0, num_output_rows);
+        output_columns.emplace_back(std::move(output_column));
+    }
+    for (size_t i = 0; i < _fn_result_slots.size(); ++i) {
+        const ColumnPtr& result_column = _table_function_result.first[i];
+        if (start_offset == 0 && num_output_rows == result_column->size()) {
+            // All the results are output by this chunk, reuse them without copying
+            output_columns.emplace_back(result_column);
+            continue;
         }
+        ColumnPtr output_column = result_column->clone_empty();
+        output_column->append(*result_column, start_offset, num_output_rows);
+        output_columns.emplace_back(std::move(output_column));
     }
 
     // Current input chunk has been processed, clean the state to be ready for next input chunk
-    if (_remain_repeat_times == 0 && _input_chunk_index >= _input_chunk->num_rows()) {
+    if (_remain_repeat_times == 0 && _input_chunk_index >= num_input_rows) {
         _input_chunk = nullptr;
     }
 
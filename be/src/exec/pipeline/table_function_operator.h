@@ -70,6 +70,8 @@ private:
     size_t _remain_repeat_times = 0;
     // table function result
     std::pair<Columns, ColumnPtr> _table_function_result;
+    // The input row of every output row of the chunk being built
+    std::vector<uint32_t> _outer_indexes;
     // table function return result end ?
     bool _table_function_result_eos = false;
     // table function param and return offset
@@ -14,36 +14,256 @@
 
 #include "exec/query_cache/cache_manager.h"
 
+#include <fmt/format.h>
+
+#include "block_cache/block_cache.h"
+#include "common/config.h"
+#include "serde/column_array_serde.h"
+#include "util/compression/block_compression.h"
 #include "util/defer_op.h"
+#include "util/hash_util.hpp"
 namespace starrocks::query_cache {
 
-CacheManager::CacheManager(size_t capacity) : _cache(capacity) {}
-static void delete_cache_entry(const CacheKey& key, void* value) {
-    auto* cache_value = (CacheValue*)value;
-    delete cache_value;
+// The chunks of a cache value are either kept as they are in `value`, or serialized column by column and compressed
+// as a whole in `compressed_data`. The empty chunks of the same layouts as the compressed ones are kept to create the
+// columns to deserialize into, and they carry the owner infos of the chunks.
+struct CacheManager::CacheEntry {
+    CacheManager* mgr;
+    CacheValue value;
+    bool compressed = false;
+    std::vector<ChunkPtr> empty_chunks;
+    size_t uncompressed_size = 0;
+    // empty if the entry is spilled to the block cache.
+    std::string compressed_data;
+    size_t compressed_size = 0;
+    // the key of the compressed data in the block cache once it's spilled.
+    std::string block_cache_key;
+    // false if the entry is replaced or invalidated rather than evicted.
+    std::atomic<bool> spill_on_evict{true};
+
+    CacheEntry(CacheManager* mgr, const CacheValue& value) : mgr(mgr), value(value) {}
+
+    size_t charge() const {
+        if (!compressed) {
+            return const_cast<CacheValue&>(value).size();
+        }
+        size_t size = sizeof(CacheEntry) + compressed_data.size();
+        for (const auto& chunk : empty_chunks) {
+            size += chunk->memory_usage();
+        }
+        return size;
+    }
+};
+
+static const BlockCompressionCodec* cache_codec() {
+    const BlockCompressionCodec* codec = nullptr;
+    CHECK(get_block_compression_codec(CompressionTypePB::LZ4, &codec).ok());
+    return codec;
 }
 
-Status CacheManager::populate(const std::string& key, const CacheValue& value) {
-    auto* cache_value = new CacheValue(value);
-    auto* handle = _cache.insert(key, cache_value, cache_value->size(), &delete_cache_entry, CachePriority::NORMAL);
+static Status compress_entry(CacheValue* value, std::vector<ChunkPtr>* empty_chunks, size_t* uncompressed_size,
+                             std::string* compressed_data) {
+    size_t max_size = 0;
+    for (const auto& chunk : value->result) {
+        if (chunk->has_extra_data()) {
+            return Status::NotSupported("the extra data of the chunk can't be serialized");
+        }
+        for (const auto& column : chunk->columns()) {
+            int64_t size = serde::ColumnArraySerde::max_serialized_size(*column);
+            if (size <= 0) {
+                return Status::NotSupported("the column can't be serialized");
+            }
+            max_size += size;
+        }
+    }
+    std::string buffer;
+    buffer.resize(max_size);
+    auto* buff = reinterpret_cast<uint8_t*>(buffer.data());
+    for (const auto& chunk : value->result) {
+        for (const auto& column : chunk->columns()) {
+            buff = serde::ColumnArraySerde::serialize(*column, buff);
+            if (buff == nullptr) {
+                return Status::InternalError("failed to serialize the column");
+            }
+        }
+        ChunkPtr empty_chunk = chunk->clone_empty(0);
+        empty_chunk->owner_info() = chunk->owner_info();
+        empty_chunks->emplace_back(std::move(empty_chunk));
+    }
+    *uncompressed_size = buff - reinterpret_cast<uint8_t*>(buffer.data());
+
+    const auto* codec = cache_codec();
+    compressed_data->resize(codec->max_compressed_len(*uncompressed_size));
+    Slice output(compressed_data->data(), compressed_data->size());
+    RETURN_IF_ERROR(codec->compress(Slice(buffer.data(), *uncompressed_size), &output));
+    compressed_data->resize(output.size);
+    compressed_data->shrink_to_fit();
+    value->result.clear();
+    return Status::OK();
+}
+
+static StatusOr<CacheResult> decompress_entry(const std::vector<ChunkPtr>& empty_chunks, size_t uncompressed_size,
+                                              const std::string& compressed_data) {
+    std::string buffer;
+    buffer.resize(uncompressed_size);
+    Slice output(buffer.data(), buffer.size());
+    RETURN_IF_ERROR(cache_codec()->decompress(Slice(compressed_data), &output));
+    if (output.size != uncompressed_size) {
+        return Status::Corruption("the size of the decompressed cache entry mismatches");
+    }
+
+    CacheResult result;
+    result.reserve(empty_chunks.size());
+    const auto* buff = reinterpret_cast<const uint8_t*>(buffer.data());
+    for (const auto& empty_chunk : empty_chunks) {
+        ChunkPtr chunk = empty_chunk->clone_empty(0);
+        chunk->owner_info() = empty_chunk->owner_info();
+        for (auto& column : chunk->columns()) {
+            buff = serde::ColumnArraySerde::deserialize(buff, column.get());
+            if (buff == nullptr) {
+                return Status::Corruption("failed to deserialize the cache entry");
+            }
+        }
+        result.emplace_back(std::move(chunk));
+    }
+    return result;
+}
+
+CacheManager::CacheManager(size_t capacity) : _spilled_entries(std::max<size_t>(capacity / 4, 1)), _cache(capacity) {}
+
+CacheManager::~CacheManager() {
+    // don't spill the entries released when the cache is destroyed.
+    _spill_disabled = true;
+}
+
+bool CacheManager::_spill_enabled() const {
+    return config::query_cache_spill_to_block_cache && config::block_cache_enable && !_spill_disabled;
+}
+
+void CacheManager::_delete_entry(const CacheKey& key, void* value) {
+    auto* entry = reinterpret_cast<CacheEntry*>(value);
+    DeferOp defer([entry]() { delete entry; });
+    if (entry->compressed && !entry->compressed_data.empty() && entry->spill_on_evict && entry->mgr != nullptr &&
+        entry->mgr->_spill_enabled()) {
+        entry->mgr->_spill(key.to_string(), entry);
+    }
+}
+
+Status CacheManager::_insert(const std::string& key, CacheEntry* entry) {
+    // the replaced entry is not spilled, and the spilled one is stale.
+    if (auto* old_handle = _cache.lookup(key); old_handle != nullptr) {
+        reinterpret_cast<CacheEntry*>(_cache.value(old_handle))->spill_on_evict = false;
+        _cache.release(old_handle);
+    }
+    _spilled_entries.erase(key);
+    auto* handle = _cache.insert(key, entry, entry->charge(), &_delete_entry, CachePriority::NORMAL);
     DeferOp defer([this, handle]() { _cache.release(handle); });
     return handle != nullptr ? Status::OK() : Status::InternalError("Insert failure");
 }
 
+Status CacheManager::populate(const std::string& key, const CacheValue& value) {
+    auto* entry = new CacheEntry(this, value);
+    if (config::query_cache_compress_entries) {
+        Status st = compress_entry(&entry->value, &entry->empty_chunks, &entry->uncompressed_size,
+                                   &entry->compressed_data);
+        if (st.ok()) {
+            entry->compressed = true;
+            entry->compressed_size = entry->compressed_data.size();
+        } else {
+            // keep the chunks as they are.
+            entry->value = value;
+            entry->empty_chunks.clear();
+        }
+    }
+    return _insert(key, entry);
+}
+
 static const Status CACHE_MISS = Status::NotFound("CacheMiss");
 
 StatusOr<CacheValue> CacheManager::probe(const std::string& key) {
     auto* handle = _cache.lookup(key);
     if (handle == nullptr) {
+        if (_spill_enabled()) {
+            return _probe_spilled(key);
+        }
         return CACHE_MISS;
     }
     DeferOp defer([this, handle]() { _cache.release(handle); });
-    CacheValue cache_value(*reinterpret_cast<CacheValue*>(_cache.value(handle)));
+    const auto* entry = reinterpret_cast<CacheEntry*>(_cache.value(handle));
+    CacheValue cache_value(entry->value);
+    if (entry->compressed) {
+        ASSIGN_OR_RETURN(cache_value.result,
+                         decompress_entry(entry->empty_chunks, entry->uncompressed_size, entry->compressed_data));
+    }
+    return cache_value;
+}
+
+void CacheManager::_spill(const std::string& key, CacheEntry* entry) {
+    auto* meta = new CacheEntry(this, entry->value);
+    meta->compressed = true;
+    meta->empty_chunks = entry->empty_chunks;
+    meta->uncompressed_size = entry->uncompressed_size;
+    meta->compressed_size = entry->compressed_size;
+    meta->block_cache_key = entry->block_cache_key;
+    // the data of an entry probed from the block cache is still there.
+    if (meta->block_cache_key.empty()) {
+        meta->block_cache_key = fmt::format("query_cache_{}_{}", HashUtil::hash64(key.data(), key.size(), 0),
+                                            entry->value.populate_time);
+        Status st = BlockCache::instance()->write_cache_async(meta->block_cache_key, 0, entry->compressed_size,
+                                                              entry->compressed_data.data());
+        if (!st.ok()) {
+            delete meta;
+            return;
+        }
+    }
+    auto* handle = _spilled_entries.insert(key, meta, meta->charge(), &_delete_entry, CachePriority::NORMAL);
+    if (handle != nullptr) {
+        _spilled_entries.release(handle);
+    }
+}
+
+StatusOr<CacheValue> CacheManager::_probe_spilled(const std::string& key) {
+    auto* handle = _spilled_entries.lookup(key);
+    if (handle == nullptr) {
+        return CACHE_MISS;
+    }
+    DeferOp defer([this, handle]() { _spilled_entries.release(handle); });
+    const auto* meta = reinterpret_cast<CacheEntry*>(_spilled_entries.value(handle));
+
+    // the block cache reads the data block by block.
+    std::string data;
+    data.resize(meta->compressed_size);
+    auto* block_cache = BlockCache::instance();
+    const size_t block_size = block_cache->block_size();
+    for (size_t offset = 0; offset < data.size(); offset += block_size) {
+        size_t size = std::min(block_size, data.size() - offset);
+        auto res = block_cache->read_cache(meta->block_cache_key, offset, size, data.data() + offset);
+        if (!res.ok() || res.value() != size) {
+            // evicted from the block cache.
+            _spilled_entries.erase(key);
+            return CACHE_MISS;
+        }
+    }
+    ASSIGN_OR_RETURN(auto result, decompress_entry(meta->empty_chunks, meta->uncompressed_size, data));
+    _spilled_hit_count.fetch_add(1, std::memory_order_relaxed);
+
+    // move it back to the memory.
+    auto* entry = new CacheEntry(this, meta->value);
+    entry->compressed = true;
+    entry->empty_chunks = meta->empty_chunks;
+    entry->uncompressed_size = meta->uncompressed_size;
+    entry->compressed_data = std::move(data);
+    entry->compressed_size = meta->compressed_size;
+    entry->block_cache_key = meta->block_cache_key;
+    CacheValue cache_value(meta->value);
+    cache_value.result = std::move(result);
+    // the value is hit anyway even if it fails to be moved back.
+    (void)_insert(key, entry);
     return cache_value;
 }
 
 size_t CacheManager::memory_usage() {
-    return _cache.get_memory_usage();
+    return _cache.get_memory_usage() + _spilled_entries.get_memory_usage();
 }
 
 size_t CacheManager::capacity() {
@@ -55,14 +275,19 @@ size_t CacheManager::lookup_count() {
 }
 
 size_t CacheManager::hit_count() {
-    return _cache.get_hit_count();
+    return _cache.get_hit_count() + spilled_hit_count();
 }
 
 void CacheManager::invalidate_all() {
     auto old_capacity = _cache.get_capacity();
-    // set capacity of cache to zero, the cache shall prune all cache entries.
+    // set capacity of cache to zero, the cache shall prune all cache entries, and they are not spilled.
+    _spill_disabled = true;
     _cache.set_capacity(0);
     _cache.set_capacity(old_capacity);
+    auto old_spilled_capacity = _spilled_entries.get_capacity();
+    _spilled_entries.set_capacity(0);
+    _spilled_entries.set_capacity(old_spilled_capacity);
+    _spill_disabled = false;
 }
 
 } // namespace starrocks::query_cache
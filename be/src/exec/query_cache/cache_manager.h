@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -36,6 +37,9 @@ struct CacheValue {
     int64_t hit_count{0};
     int64_t populate_time;
     int64_t version;
+    // The number of the rows of the tablet at `version` if it's a duplicate-key tablet without delete predicates,
+    // otherwise -1, it tells whether the data of the tablet changed since `version` after compactions.
+    int64_t tablet_num_rows{-1};
     CacheResult result;
 
     CacheValue(int64_t populate_time, int64_t cache_version, CacheResult&& cache_result)
@@ -60,20 +64,40 @@ struct CacheValue {
     }
 };
 
+// CacheManager keeps the cache values in a LRU cache in memory. The chunks of the values are serialized and
+// compressed if config::query_cache_compress_entries is on, and the compressed values evicted from the memory are
+// written to the block cache if config::query_cache_spill_to_block_cache is on, only their metas are kept in
+// memory, and they are moved back to the memory when they are probed again.
 class CacheManager {
 public:
     explicit CacheManager(size_t capacity);
-    ~CacheManager() = default;
+    ~CacheManager();
     Status populate(const std::string& key, const CacheValue& value);
     StatusOr<CacheValue> probe(const std::string& key);
     size_t memory_usage();
     size_t capacity();
     size_t lookup_count();
     size_t hit_count();
+    // The number of the values probed from the block cache.
+    size_t spilled_hit_count() const { return _spilled_hit_count.load(std::memory_order_relaxed); }
     // vacuum cache by invalidate all cache entries
     void invalidate_all();
 
 private:
+    struct CacheEntry;
+
+    static void _delete_entry(const CacheKey& key, void* value);
+    Status _insert(const std::string& key, CacheEntry* entry);
+    // Write the compressed chunks of the evicted |entry| into the block cache and keep its meta.
+    void _spill(const std::string& key, CacheEntry* entry);
+    StatusOr<CacheValue> _probe_spilled(const std::string& key);
+    bool _spill_enabled() const;
+
+    std::atomic<bool> _spill_disabled{false};
+    std::atomic<size_t> _spilled_hit_count{0};
+    // The metas of the values spilled to the block cache, it's destroyed after _cache, whose evicted entries are
+    // moved into it.
+    ShardedLRUCache _spilled_entries;
     ShardedLRUCache _cache;
 };
 } // namespace starrocks::query_cache
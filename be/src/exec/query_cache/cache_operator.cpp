@@ -242,10 +242,20 @@ void CacheOperator::_handle_stale_cache_value_for_non_pk(int64_t tablet_id, Cach
     auto status = StorageEngine::instance()->tablet_manager()->capture_tablet_and_rowsets(
             tablet_id, cache_value.version + 1, version);
 
-    // Cache MISS if delta versions are not captured, because aggressive cumulative compactions.
+    // Cache MISS if delta versions are not captured, because aggressive cumulative compactions, unless nothing
+    // is changed in delta versions.
     if (!status.ok()) {
-        buffer->state = PLBS_MISS;
-        buffer->cached_version = 0;
+        if (_is_unchanged_after_compaction(tablet_id, cache_value, version)) {
+            buffer->cached_version = cache_value.version;
+            auto chunks = remap_chunks(cache_value.result, _cache_param.reverse_slot_remapping);
+            _update_probe_metrics(tablet_id, chunks);
+            buffer->chunks = std::move(chunks);
+            buffer->state = PLBS_HIT_TOTAL;
+            buffer->chunks.back()->owner_info().set_last_chunk(true);
+        } else {
+            buffer->state = PLBS_MISS;
+            buffer->cached_version = 0;
+        }
         return;
     }
 
@@ -329,6 +339,40 @@ void CacheOperator::_handle_stale_cache_value_for_pk(int64_t tablet_id, starrock
     buffer->chunks.back()->owner_info().set_last_chunk(true);
 }
 
+bool CacheOperator::_is_unchanged_after_compaction(int64_t tablet_id, const CacheValue& cache_value,
+                                                   int64_t version) {
+    // The rows of a duplicate-key tablet are never merged or deleted without delete predicates, so the tablet has
+    // the same rows at both versions iff it has the same number of rows, i.e. all the delta versions are empty.
+    if (cache_value.tablet_num_rows < 0) {
+        return false;
+    }
+    return _tablet_num_rows(tablet_id, version, cache_value.version) == cache_value.tablet_num_rows;
+}
+
+int64_t CacheOperator::_tablet_num_rows(int64_t tablet_id, int64_t version, int64_t base_version) {
+    if (_cache_param.keys_type != TKeysType::DUP_KEYS || StorageEngine::instance() == nullptr) {
+        return -1;
+    }
+    auto status = StorageEngine::instance()->tablet_manager()->capture_tablet_and_rowsets(tablet_id, 0, version);
+    if (!status.ok()) {
+        return -1;
+    }
+    auto& [tablet, rowsets, rowsets_acq_rel] = status.value();
+    if (tablet->has_delete_predicates(Version(0, version))) {
+        return -1;
+    }
+    int64_t num_rows = 0;
+    for (const auto& rs : rowsets) {
+        // only the base compactions apply the delete predicates and remove them, a delete predicate after
+        // |base_version| may have been removed.
+        if (rs->start_version() == 0 && rs->end_version() > base_version) {
+            return -1;
+        }
+        num_rows += rs->num_rows();
+    }
+    return num_rows;
+}
+
 void CacheOperator::_update_probe_metrics(int64_t tablet_id, const std::vector<ChunkPtr>& chunks) {
     auto num_bytes = 0L;
     auto num_rows = 0L;
@@ -415,6 +459,7 @@ void CacheOperator::populate_cache(int64_t tablet_id) {
     int64_t current = GetMonoTimeMicros();
     auto chunks = remap_chunks(buffer->chunks, _cache_param.slot_remapping);
     CacheValue cache_value(current, buffer->required_version, std::move(chunks));
+    cache_value.tablet_num_rows = _tablet_num_rows(tablet_id, buffer->required_version, buffer->required_version);
     // If the cache implementation is global, populate method must be asynchronous and try its best to
     // update the cache.
     _cache_populate_bytes_counter->update(buffer->num_bytes);
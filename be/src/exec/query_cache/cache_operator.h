@@ -73,6 +73,12 @@ private:
                                               int64_t version);
     void _handle_stale_cache_value_for_pk(int64_t tablet_id, CacheValue& cache_value, PerLaneBufferPtr& buffer,
                                           int64_t version);
+    // Whether the cache value is still the total result of the tablet at |version|, when the delta rowsets can't be
+    // captured because they are merged with the older rowsets by compactions.
+    bool _is_unchanged_after_compaction(int64_t tablet_id, const CacheValue& cache_value, int64_t version);
+    // See CacheValue::tablet_num_rows, it's -1 too if the rows of the versions after |base_version| may be
+    // deleted by base compactions.
+    int64_t _tablet_num_rows(int64_t tablet_id, int64_t version, int64_t base_version);
     bool _should_passthrough(size_t num_rows, size_t num_bytes);
     ChunkPtr _pull_chunk_from_per_lane_buffer(PerLaneBufferPtr& buffer);
     CacheManagerRawPtr _cache_mgr;
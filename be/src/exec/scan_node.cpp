@@ -107,8 +107,12 @@ StatusOr<pipeline::MorselQueueFactoryPtr> ScanNode::convert_scan_range_to_morsel
         if (!always_shared_scan() && scan_dop > 1 && dynamic_cast<pipeline::FixedMorselQueue*>(morsel_queue.get()) &&
             morsel_queue->num_original_morsels() <= io_parallelism) {
             auto morsel_queue_map = uniform_distribute_morsels(std::move(morsel_queue), scan_dop);
-            return std::make_unique<pipeline::IndividualMorselQueueFactory>(std::move(morsel_queue_map),
-                                                                            /*could_local_shuffle*/ true);
+            auto morsel_queue_factory = std::make_unique<pipeline::IndividualMorselQueueFactory>(
+                    std::move(morsel_queue_map), /*could_local_shuffle*/ true);
+            if (support_morsel_stealing() && config::enable_pipeline_scan_morsel_stealing) {
+                morsel_queue_factory->enable_morsel_stealing();
+            }
+            return morsel_queue_factory;
         } else {
             return std::make_unique<pipeline::SharedMorselQueueFactory>(std::move(morsel_queue), scan_dop);
         }
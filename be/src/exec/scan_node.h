@@ -116,6 +116,8 @@ public:
 
     virtual int io_tasks_per_scan_operator() const { return _io_tasks_per_scan_operator; }
     virtual bool always_shared_scan() const { return config::scan_node_always_shared_scan; }
+    // Whether the scan operators can steal morsels from each other, when the morsels are not shared by them.
+    virtual bool support_morsel_stealing() const { return false; }
 
     // TODO: support more share_scan strategy
     void enable_shared_scan(bool enable);
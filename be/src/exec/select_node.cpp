@@ -36,6 +36,7 @@
 
 #include "exec/pipeline/limit_operator.h"
 #include "exec/pipeline/pipeline_builder.h"
+#include "exec/pipeline/scan/olap_scan_operator.h"
 #include "exec/pipeline/select_operator.h"
 #include "exprs/expr.h"
 #include "runtime/runtime_state.h"
@@ -108,6 +109,17 @@ pipeline::OpFactories SelectNode::decompose_to_pipeline(pipeline::PipelineBuilde
 
     OpFactories operators = _children[0]->decompose_to_pipeline(context);
 
+    // Fuse the conjuncts and limit into the OlapScan, when the scan operator is the only operator of the pipeline.
+    // LimitOperator is still added, since the limit is applied by each chunk source individually.
+    auto* olap_scan_op = operators.size() == 1 ? dynamic_cast<OlapScanOperatorFactory*>(operators[0].get()) : nullptr;
+    if (olap_scan_op != nullptr && olap_scan_op->could_fuse_select() && runtime_filter_collector().empty()) {
+        olap_scan_op->fuse_select(std::move(_conjunct_ctxs), limit());
+        if (limit() != -1) {
+            operators.emplace_back(std::make_shared<LimitOperatorFactory>(context->next_operator_id(), id(), limit()));
+        }
+        return operators;
+    }
+
     operators.emplace_back(
             std::make_shared<SelectOperatorFactory>(context->next_operator_id(), id(), std::move(_conjunct_ctxs)));
 
@@ -0,0 +1,98 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "column/column_hash.h"
+#include "runtime/mem_pool.h"
+#include "util/memcmp.h"
+#include "util/slice.h"
+
+namespace starrocks {
+
+// The serialized key of the hash sets of INTERSECT and EXCEPT, with a 16-bit flag of the set operation.
+//
+// It takes 16 bytes. A persisted key of at most kInlineSize bytes, e.g. the key of one or two numeric columns,
+// is stored inline, and larger ones are allocated from the memory pool of the set.
+class SerializedSetKey {
+public:
+    static constexpr size_t kInlineSize = 10;
+
+    // Refer to the key of |size| bytes at |data|, which must outlive this key.
+    SerializedSetKey(const uint8_t* data, size_t size) { _refer(data, size); }
+
+    // Persist |key| to be inserted into a set, the large keys are allocated from |pool|.
+    SerializedSetKey(const SerializedSetKey& key, MemPool* pool) {
+        Slice slice = key.slice();
+        if (slice.size <= kInlineSize) {
+            memcpy(_data, slice.data, slice.size);
+            _size = slice.size;
+        } else {
+            uint8_t* pos = pool->allocate(slice.size);
+            memcpy(pos, slice.data, slice.size);
+            _refer(pos, slice.size);
+        }
+    }
+
+    // The slice of an inline key points to the key itself, so it's invalidated once the key is moved,
+    // e.g. by the rehash of the set.
+    Slice slice() const {
+        if (_size & kExternalBit) {
+            const uint8_t* data;
+            memcpy(&data, _data, sizeof(data));
+            return {data, _size & ~kExternalBit};
+        }
+        return {_data, _size};
+    }
+
+    uint16_t flag() const { return _flag; }
+    // The key in a set is const, but its flag can be changed.
+    void set_flag(uint16_t flag) const { _flag = flag; }
+
+private:
+    static constexpr uint32_t kExternalBit = 1U << 31;
+
+    void _refer(const uint8_t* data, size_t size) {
+        memcpy(_data, &data, sizeof(data));
+        _size = size | kExternalBit;
+    }
+
+    // The inline key, or the address of the key.
+    uint8_t _data[kInlineSize];
+    mutable uint16_t _flag = 0;
+    uint32_t _size;
+};
+
+static_assert(sizeof(SerializedSetKey) == 16);
+
+struct SerializedSetKeyEqual {
+    bool operator()(const SerializedSetKey& x, const SerializedSetKey& y) const {
+        Slice a = x.slice();
+        Slice b = y.slice();
+        return memequal(a.data, a.size, b.data, b.size);
+    }
+};
+
+struct SerializedSetKeyHash {
+    static const uint32_t CRC_SEED = 0x811C9DC5;
+    std::size_t operator()(const SerializedSetKey& key) const {
+        Slice slice = key.slice();
+        return crc_hash_64(slice.data, slice.size, CRC_SEED);
+    }
+};
+
+} // namespace starrocks
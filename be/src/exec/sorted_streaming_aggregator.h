@@ -33,6 +33,9 @@ public:
     StatusOr<ChunkPtr> pull_eos_chunk();
 
 private:
+    // The states of a group are allocated and released along with the sorted input.
+    bool _support_columnar_agg_states() const override { return false; }
+
     Status _compute_group_by(size_t chunk_size);
 
     Status _update_states(size_t chunk_size);
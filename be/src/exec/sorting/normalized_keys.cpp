@@ -0,0 +1,187 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/sorting/normalized_keys.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "column/binary_column.h"
+#include "column/column_visitor_adapter.h"
+#include "column/const_column.h"
+#include "column/fixed_length_column_base.h"
+#include "column/json_column.h"
+#include "column/nullable_column.h"
+#include "column/object_column.h"
+#include "exec/sorting/radix_sort.h"
+#include "exec/sorting/sorting.h"
+
+namespace starrocks {
+
+namespace {
+
+// Encode one sort key column into the normalized keys, or compute its width if |keys| is nullptr.
+class KeyColumnEncoder final : public ColumnVisitorAdapter<KeyColumnEncoder> {
+public:
+    KeyColumnEncoder(const SortDesc& sort_desc, size_t string_prefix, uint8_t* keys, size_t key_size, size_t offset,
+                     std::vector<uint8_t>* ambiguous, std::vector<size_t>* ambiguous_ends)
+            : ColumnVisitorAdapter(this),
+              _sort_desc(sort_desc),
+              _string_prefix(string_prefix),
+              _keys(keys),
+              _key_size(key_size),
+              _offset(offset),
+              _ambiguous(ambiguous),
+              _ambiguous_ends(ambiguous_ends) {}
+
+    size_t width() const { return _width; }
+
+    Status do_visit(const NullableColumn& column) {
+        if (_keys != nullptr) {
+            const uint8_t null_flag = _sort_desc.is_null_first() ? 0 : 1;
+            const auto& null_data = column.immutable_null_column_data();
+            for (size_t i = 0; i < null_data.size(); i++) {
+                _keys[i * _key_size + _offset] = null_data[i] ? null_flag : (1 - null_flag);
+            }
+        }
+        KeyColumnEncoder data_encoder(_sort_desc, _string_prefix, _keys, _key_size, _offset + 1, _ambiguous,
+                                      _ambiguous_ends);
+        RETURN_IF_ERROR(column.data_column_ref().accept(&data_encoder));
+        _width = 1 + data_encoder.width();
+
+        if (_keys != nullptr && column.has_null()) {
+            // the nulls are equal whatever their data are
+            const auto& null_data = column.immutable_null_column_data();
+            for (size_t i = 0; i < null_data.size(); i++) {
+                if (null_data[i]) {
+                    memset(_keys + i * _key_size + _offset + 1, 0, data_encoder.width());
+                }
+            }
+        }
+        return Status::OK();
+    }
+
+    template <typename T>
+    Status do_visit(const BinaryColumnBase<T>& column) {
+        _width = _string_prefix + 1;
+        if (_keys == nullptr) {
+            return Status::OK();
+        }
+        const uint8_t mask = _sort_desc.asc_order() ? 0 : 0xFF;
+        for (size_t i = 0; i < column.size(); i++) {
+            Slice value = column.get_slice(i);
+            uint8_t* key = _keys + i * _key_size + _offset;
+            size_t copied = std::min(value.size, _string_prefix);
+            memcpy(key, value.data, copied);
+            memset(key + copied, 0, _string_prefix - copied);
+            key[_string_prefix] = static_cast<uint8_t>(std::min(value.size, _string_prefix + 1));
+            if (value.size > _string_prefix) {
+                (*_ambiguous)[i] = 1;
+                (*_ambiguous_ends)[i] = std::min((*_ambiguous_ends)[i], _offset + _string_prefix + 1);
+            }
+            if (mask != 0) {
+                for (size_t j = 0; j <= _string_prefix; j++) {
+                    key[j] ^= mask;
+                }
+            }
+        }
+        return Status::OK();
+    }
+
+    template <typename T>
+    Status do_visit(const FixedLengthColumnBase<T>& column) {
+        if constexpr (RadixSortKey<T>::supported) {
+            using KeyType = typename RadixSortKey<T>::KeyType;
+            _width = sizeof(KeyType);
+            if (_keys == nullptr) {
+                return Status::OK();
+            }
+            const auto& data = column.get_data();
+            const bool asc = _sort_desc.asc_order();
+            for (size_t i = 0; i < data.size(); i++) {
+                KeyType value = RadixSortKey<T>::to_key(data[i]);
+                if (!asc) {
+                    value = ~value;
+                }
+                uint8_t* key = _keys + i * _key_size + _offset;
+                // big-endian, so that memcmp follows the order of the integers
+                for (size_t j = 0; j < sizeof(KeyType); j++) {
+                    key[j] = static_cast<uint8_t>(value >> ((sizeof(KeyType) - 1 - j) * 8));
+                }
+            }
+            return Status::OK();
+        } else {
+            return Status::NotSupported("the column can't be normalized");
+        }
+    }
+
+    Status do_visit(const ConstColumn& column) { return Status::NotSupported("the column can't be normalized"); }
+    Status do_visit(const ArrayColumn& column) { return Status::NotSupported("the column can't be normalized"); }
+    Status do_visit(const MapColumn& column) { return Status::NotSupported("the column can't be normalized"); }
+    Status do_visit(const StructColumn& column) { return Status::NotSupported("the column can't be normalized"); }
+    Status do_visit(const JsonColumn& column) { return Status::NotSupported("the column can't be normalized"); }
+
+    template <typename T>
+    Status do_visit(const ObjectColumn<T>& column) {
+        return Status::NotSupported("the column can't be normalized");
+    }
+
+private:
+    const SortDesc _sort_desc;
+    const size_t _string_prefix;
+    uint8_t* _keys;
+    const size_t _key_size;
+    const size_t _offset;
+    std::vector<uint8_t>* _ambiguous;
+    std::vector<size_t>* _ambiguous_ends;
+    size_t _width = 0;
+};
+
+} // namespace
+
+Status NormalizedKeys::encode(const Columns& columns, const SortDescs& sort_desc, size_t string_prefix) {
+    DCHECK(!columns.empty());
+    DCHECK_LE(string_prefix, kMaxStringPrefix);
+    const size_t num_rows = columns[0]->size();
+
+    std::vector<size_t> offsets;
+    _key_size = 0;
+    for (size_t i = 0; i < columns.size(); i++) {
+        KeyColumnEncoder encoder(sort_desc.get_column_desc(i), string_prefix, nullptr, 0, 0, nullptr, nullptr);
+        RETURN_IF_ERROR(columns[i]->accept(&encoder));
+        offsets.push_back(_key_size);
+        _key_size += encoder.width();
+    }
+
+    _keys.resize(num_rows * _key_size);
+    _ambiguous.assign(num_rows, 0);
+    // The end of the first clipped string of every row.
+    std::vector<size_t> ambiguous_ends(num_rows, _key_size);
+    for (size_t i = 0; i < columns.size(); i++) {
+        KeyColumnEncoder encoder(sort_desc.get_column_desc(i), string_prefix, _keys.data(), _key_size, offsets[i],
+                                 &_ambiguous, &ambiguous_ends);
+        RETURN_IF_ERROR(columns[i]->accept(&encoder));
+    }
+    // The keys after a clipped string can't order the rows, which are only ordered by the whole string, so clear
+    // them to make the rows of the same clipped string equal.
+    for (size_t i = 0; i < num_rows; i++) {
+        if (ambiguous_ends[i] < _key_size) {
+            memset(_keys.data() + i * _key_size + ambiguous_ends[i], 0, _key_size - ambiguous_ends[i]);
+        }
+    }
+    _has_ambiguous = std::find(_ambiguous.begin(), _ambiguous.end(), 1) != _ambiguous.end();
+    return Status::OK();
+}
+
+} // namespace starrocks
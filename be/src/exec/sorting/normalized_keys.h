@@ -0,0 +1,62 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "common/status.h"
+
+namespace starrocks {
+
+struct SortDescs;
+
+// NormalizedKeys encodes the sort keys of every row into a fixed-length memcmp-able byte string, so that the rows
+// could be sorted by comparing raw bytes instead of column by column.
+//
+// The encoding of a sort key:
+// - A nullable key starts with a flag byte, which orders the nulls before or after the others, and the rest bytes
+//   of a null are zeros.
+// - An integer, decimal, date or datetime is encoded as the big-endian order-preserving unsigned integer.
+// - A string is encoded as its first |string_prefix| bytes padded by zeros, followed by a byte of its length
+//   clipped to |string_prefix| + 1.
+// All the bytes except the null flag are complemented for a descending key.
+//
+// The rows of the equal normalized keys are equal, unless any of their strings is longer than the prefix. Such rows
+// are ambiguous, the bytes after the first clipped string of them are zeros, so the rows sharing the clipped string
+// have equal keys, and must be tie-broken by comparing the columns.
+class NormalizedKeys {
+public:
+    // The max length of the string prefix, so that the clipped length fits into one byte.
+    static constexpr size_t kMaxStringPrefix = 254;
+
+    // Return NotSupported if any of |columns| can't be normalized, e.g. floats or arrays.
+    Status encode(const Columns& columns, const SortDescs& sort_desc, size_t string_prefix);
+
+    size_t num_rows() const { return _ambiguous.size(); }
+    size_t key_size() const { return _key_size; }
+    const uint8_t* key(size_t row) const { return _keys.data() + row * _key_size; }
+    bool is_ambiguous(size_t row) const { return _ambiguous[row]; }
+    bool has_ambiguous() const { return _has_ambiguous; }
+
+private:
+    size_t _key_size = 0;
+    std::vector<uint8_t> _keys;
+    std::vector<uint8_t> _ambiguous;
+    bool _has_ambiguous = false;
+};
+
+} // namespace starrocks
@@ -0,0 +1,302 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/sorting/parallel_merge.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "column/chunk.h"
+#include "runtime/chunk_cursor.h"
+#include "runtime/current_thread.h"
+#include "util/threadpool.h"
+
+namespace starrocks {
+
+namespace {
+
+// The number of the splitter candidates sampled for each slice.
+constexpr size_t kSamplesPerSlice = 32;
+
+// Address the rows of sorted runs by their positions in all the rows.
+class SortedRunsIndex {
+public:
+    explicit SortedRunsIndex(const SortedRuns& runs) : _runs(runs) {
+        _offsets.reserve(runs.num_chunks() + 1);
+        _offsets.push_back(0);
+        for (const auto& run : runs.chunks) {
+            _offsets.push_back(_offsets.back() + run.num_rows());
+        }
+    }
+
+    size_t num_rows() const { return _offsets.back(); }
+
+    // The run of the row at |pos|, and the index of the row in the chunk of the run.
+    std::pair<const SortedRun*, size_t> locate(size_t pos) const {
+        DCHECK_LT(pos, num_rows());
+        size_t i = std::upper_bound(_offsets.begin(), _offsets.end(), pos) - _offsets.begin() - 1;
+        const SortedRun& run = _runs.chunks[i];
+        return {&run, run.start_index() + pos - _offsets[i]};
+    }
+
+    // The number of the rows less than the |row|-th row of |run|.
+    size_t lower_bound(const SortDescs& sort_desc, const SortedRun& run, size_t row) const {
+        size_t first = 0;
+        size_t count = num_rows();
+        while (count > 0) {
+            size_t step = count / 2;
+            auto [mid_run, mid_row] = locate(first + step);
+            if (mid_run->compare_row(sort_desc, run, mid_row, row) < 0) {
+                first += step + 1;
+                count -= step + 1;
+            } else {
+                count = step;
+            }
+        }
+        return first;
+    }
+
+    // Append the rows in the positions [from, to) to |output|.
+    void slice(size_t from, size_t to, SortedRuns* output) const {
+        for (size_t i = 0; i < _runs.num_chunks() && from < to; i++) {
+            size_t begin = std::max(from, _offsets[i]);
+            size_t end = std::min(to, _offsets[i + 1]);
+            if (begin < end) {
+                const SortedRun& run = _runs.chunks[i];
+                output->chunks.emplace_back(run, run.start_index() + begin - _offsets[i],
+                                            run.start_index() + end - _offsets[i]);
+            }
+        }
+    }
+
+private:
+    const SortedRuns& _runs;
+    std::vector<size_t> _offsets;
+};
+
+} // namespace
+
+std::vector<std::vector<SortedRuns>> split_sorted_runs(const SortDescs& sort_desc,
+                                                       const std::vector<const SortedRuns*>& inputs,
+                                                       size_t num_slices) {
+    DCHECK_GT(num_slices, 0);
+    std::vector<SortedRunsIndex> indexes;
+    indexes.reserve(inputs.size());
+    size_t total_rows = 0;
+    for (const auto* input : inputs) {
+        indexes.emplace_back(*input);
+        total_rows += indexes.back().num_rows();
+    }
+
+    // Sample the splitter candidates from every input in proportion to its rows.
+    std::vector<std::pair<const SortedRun*, size_t>> samples;
+    const size_t total_samples = num_slices * kSamplesPerSlice;
+    for (const auto& index : indexes) {
+        size_t num_rows = index.num_rows();
+        if (num_rows == 0) {
+            continue;
+        }
+        size_t num_samples = std::clamp<size_t>(total_samples * num_rows / total_rows, 1, num_rows);
+        for (size_t j = 0; j < num_samples; j++) {
+            samples.emplace_back(index.locate((2 * j + 1) * num_rows / (2 * num_samples)));
+        }
+    }
+    std::sort(samples.begin(), samples.end(), [&](const auto& lhs, const auto& rhs) {
+        return lhs.first->compare_row(sort_desc, *rhs.first, lhs.second, rhs.second) < 0;
+    });
+
+    // bounds[i][k] is the position the k-th slice of the i-th input starts from.
+    std::vector<std::vector<size_t>> bounds(inputs.size());
+    for (size_t i = 0; i < inputs.size(); i++) {
+        bounds[i].push_back(0);
+        for (size_t k = 1; k < num_slices; k++) {
+            if (samples.empty()) {
+                bounds[i].push_back(0);
+                continue;
+            }
+            const auto& [run, row] = samples[k * samples.size() / num_slices];
+            bounds[i].push_back(indexes[i].lower_bound(sort_desc, *run, row));
+        }
+        bounds[i].push_back(indexes[i].num_rows());
+    }
+
+    std::vector<std::vector<SortedRuns>> slices(num_slices, std::vector<SortedRuns>(inputs.size()));
+    for (size_t k = 0; k < num_slices; k++) {
+        for (size_t i = 0; i < inputs.size(); i++) {
+            indexes[i].slice(bounds[i][k], bounds[i][k + 1], &slices[k][i]);
+        }
+    }
+    return slices;
+}
+
+ParallelMerger::ParallelMerger(const SortDescs& sort_desc, const std::vector<ExprContext*>* sort_exprs,
+                               size_t chunk_size, Materializer materializer)
+        : _sort_desc(sort_desc),
+          _sort_exprs(sort_exprs),
+          _chunk_size(chunk_size),
+          _materializer(std::move(materializer)) {}
+
+ParallelMerger::~ParallelMerger() {
+    cancel();
+}
+
+Status ParallelMerger::init(ThreadPool* pool, MemTracker* mem_tracker, const std::vector<const SortedRuns*>& inputs,
+                            size_t num_slices, size_t max_running_slices) {
+    _pool = pool;
+    _mem_tracker = mem_tracker;
+    _max_running_slices = std::max<size_t>(1, max_running_slices);
+    for (auto& inputs_of_slice : split_sorted_runs(_sort_desc, inputs, num_slices)) {
+        auto slice = std::make_unique<Slice>();
+        slice->inputs = std::move(inputs_of_slice);
+        _slices.push_back(std::move(slice));
+    }
+    _submit_slices();
+    return Status::OK();
+}
+
+bool ParallelMerger::is_data_ready() {
+    std::lock_guard<std::mutex> l(_mutex);
+    if (_output_slice >= _slices.size()) {
+        return true;
+    }
+    const auto& slice = _slices[_output_slice];
+    return !slice->chunks.empty() || slice->finished;
+}
+
+bool ParallelMerger::is_eos() {
+    std::lock_guard<std::mutex> l(_mutex);
+    return _output_slice >= _slices.size();
+}
+
+StatusOr<ChunkUniquePtr> ParallelMerger::try_get_next() {
+    ChunkUniquePtr chunk;
+    bool advanced = false;
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        while (_output_slice < _slices.size()) {
+            auto& slice = _slices[_output_slice];
+            if (!slice->chunks.empty()) {
+                chunk = std::move(slice->chunks.front());
+                slice->chunks.pop_front();
+                break;
+            }
+            if (!slice->finished) {
+                break;
+            }
+            RETURN_IF_ERROR(slice->status);
+            // release the inputs of the slice as early as possible
+            slice.reset();
+            _output_slice++;
+            advanced = true;
+        }
+    }
+    if (advanced) {
+        _submit_slices();
+    }
+    return chunk;
+}
+
+void ParallelMerger::cancel() {
+    _cancelled.store(true, std::memory_order_release);
+    std::unique_lock<std::mutex> l(_mutex);
+    _cv.wait(l, [this]() { return _num_running == 0; });
+}
+
+void ParallelMerger::_submit_slices() {
+    while (!_cancelled.load(std::memory_order_acquire)) {
+        Slice* slice = nullptr;
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            if (_next_submitted_slice >= _slices.size() ||
+                _next_submitted_slice >= _output_slice + _max_running_slices) {
+                return;
+            }
+            slice = _slices[_next_submitted_slice++].get();
+            _num_running++;
+        }
+        if (!_pool->submit_func([this, slice]() { _run_slice(slice); }).ok()) {
+            // merge it in the caller thread if the pool refuses it
+            _run_slice(slice);
+        }
+    }
+}
+
+void ParallelMerger::_run_slice(Slice* slice) {
+    Status status;
+    {
+        SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(_mem_tracker);
+        status = _merge_slice(slice);
+    }
+    std::lock_guard<std::mutex> l(_mutex);
+    slice->status = std::move(status);
+    slice->finished = true;
+    _num_running--;
+    _cv.notify_all();
+}
+
+Status ParallelMerger::_merge_slice(Slice* slice) {
+    Status input_status;
+    std::vector<std::unique_ptr<SimpleChunkSortCursor>> cursors;
+    for (size_t i = 0; i < slice->inputs.size(); i++) {
+        if (slice->inputs[i].num_chunks() == 0) {
+            continue;
+        }
+        ChunkProvider provider = [this, slice, i, &input_status](ChunkUniquePtr* out_chunk, bool* eos) -> bool {
+            // data ready
+            if (out_chunk == nullptr || eos == nullptr) {
+                return true;
+            }
+            SortedRuns& runs = slice->inputs[i];
+            if (runs.num_chunks() == 0 || !input_status.ok()) {
+                *eos = true;
+                return false;
+            }
+            SortedRun& run = runs.front();
+            size_t num_rows = std::min(run.num_rows(), _chunk_size);
+            ChunkUniquePtr chunk = SortedRun(run, run.start_index(), run.start_index() + num_rows).clone_slice();
+            run.range.first += num_rows;
+            if (run.empty()) {
+                runs.pop_front();
+            }
+            auto materialized = _materializer(i, std::move(chunk));
+            if (!materialized.ok()) {
+                input_status = materialized.status();
+                *eos = true;
+                return false;
+            }
+            *out_chunk = std::move(materialized.value());
+            return true;
+        };
+        cursors.push_back(std::make_unique<SimpleChunkSortCursor>(std::move(provider), _sort_exprs));
+    }
+    if (cursors.empty()) {
+        return Status::OK();
+    }
+
+    MergeCursorsCascade merger;
+    RETURN_IF_ERROR(merger.init(_sort_desc, std::move(cursors)));
+    while (!merger.is_eos()) {
+        if (_cancelled.load(std::memory_order_acquire)) {
+            return Status::Cancelled("Sort cancelled");
+        }
+        ChunkUniquePtr chunk = merger.try_get_next();
+        if (chunk != nullptr && !chunk->is_empty()) {
+            std::lock_guard<std::mutex> l(_mutex);
+            slice->chunks.push_back(std::move(chunk));
+        }
+    }
+    return input_status;
+}
+
+} // namespace starrocks
@@ -0,0 +1,105 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "common/statusor.h"
+#include "exec/sorting/merge.h"
+#include "exec/sorting/sorting.h"
+
+namespace starrocks {
+
+class ExprContext;
+class MemTracker;
+class ThreadPool;
+
+// Split every input into |num_slices| consecutive slices by the same splitters, so that all the rows of the k-th
+// slices are ordered before the rows of the (k+1)-th slices, and merging the k-th slices of all the inputs produces
+// the k-th contiguous part of the merged output. The result[k][i] is the k-th slice of the i-th input.
+//
+// It's the multi-way version of the merge path partition: instead of co-ranking the exact positions of all the
+// inputs, the splitters are sampled evenly from the inputs, and every input is cut at the lower bound of each
+// splitter by binary search.
+std::vector<std::vector<SortedRuns>> split_sorted_runs(const SortDescs& sort_desc,
+                                                       const std::vector<const SortedRuns*>& inputs,
+                                                       size_t num_slices);
+
+// ParallelMerger merges the sorted runs in memory by slices of disjoint key ranges in parallel, and outputs the
+// merged chunks of the slices in order.
+//
+// The slices are merged on a thread pool, at most |max_running_slices| slices ahead of the output are merged, so the
+// merged chunks buffered are bounded.
+class ParallelMerger {
+public:
+    // Materializes a chunk sliced from the |input|-th sorted runs before it's merged.
+    using Materializer = std::function<StatusOr<ChunkUniquePtr>(size_t input, ChunkUniquePtr chunk)>;
+
+    // |sort_exprs| must be slot refs, they are evaluated by the threads of the pool.
+    ParallelMerger(const SortDescs& sort_desc, const std::vector<ExprContext*>* sort_exprs, size_t chunk_size,
+                   Materializer materializer);
+    ~ParallelMerger();
+
+    Status init(ThreadPool* pool, MemTracker* mem_tracker, const std::vector<const SortedRuns*>& inputs,
+                size_t num_slices, size_t max_running_slices);
+
+    // Whether the next chunk is merged, or all the chunks have been output.
+    bool is_data_ready();
+    bool is_eos();
+    // Return nullptr if the next chunk is not merged yet.
+    StatusOr<ChunkUniquePtr> try_get_next();
+
+    // Stop merging the slices, and wait for the running ones to quit.
+    void cancel();
+
+private:
+    struct Slice {
+        std::vector<SortedRuns> inputs;
+        std::deque<ChunkUniquePtr> chunks;
+        bool finished = false;
+        Status status;
+    };
+
+    void _submit_slices();
+    void _run_slice(Slice* slice);
+    Status _merge_slice(Slice* slice);
+
+    const SortDescs _sort_desc;
+    const std::vector<ExprContext*>* _sort_exprs;
+    const size_t _chunk_size;
+    Materializer _materializer;
+
+    ThreadPool* _pool = nullptr;
+    MemTracker* _mem_tracker = nullptr;
+    size_t _max_running_slices = 1;
+
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::vector<std::unique_ptr<Slice>> _slices;
+    // The slice the chunks are output from.
+    size_t _output_slice = 0;
+    size_t _next_submitted_slice = 0;
+    size_t _num_running = 0;
+    std::atomic<bool> _cancelled{false};
+};
+
+} // namespace starrocks
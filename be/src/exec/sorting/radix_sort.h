@@ -0,0 +1,129 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "types/date_value.h"
+#include "types/timestamp_value.h"
+
+namespace starrocks {
+
+// RadixSortKey maps a value to an unsigned integer of the same order, it's supported by the integers, dates and
+// datetimes, which covers the decimals stored as integers too.
+// Floats are not supported since their comparators don't follow the order of bits for NaN.
+template <class T, class = void>
+struct RadixSortKey {
+    static constexpr bool supported = false;
+};
+
+template <class T>
+struct RadixSortKey<
+        T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool> && (sizeof(T) <= sizeof(uint64_t))>> {
+    static constexpr bool supported = true;
+    using KeyType = std::make_unsigned_t<T>;
+
+    static KeyType to_key(T value) {
+        if constexpr (std::is_signed_v<T>) {
+            // flip the sign bit so that the negative values are less than the positive ones
+            return static_cast<KeyType>(value) ^ (KeyType(1) << (sizeof(T) * 8 - 1));
+        } else {
+            return value;
+        }
+    }
+};
+
+template <>
+struct RadixSortKey<__int128> {
+    static constexpr bool supported = true;
+    using KeyType = unsigned __int128;
+
+    static KeyType to_key(__int128 value) { return static_cast<KeyType>(value) ^ (KeyType(1) << 127); }
+};
+
+template <>
+struct RadixSortKey<DateValue> {
+    static constexpr bool supported = true;
+    using KeyType = uint32_t;
+
+    static KeyType to_key(const DateValue& value) { return RadixSortKey<int32_t>::to_key(value.julian()); }
+};
+
+template <>
+struct RadixSortKey<TimestampValue> {
+    static constexpr bool supported = true;
+    using KeyType = uint64_t;
+
+    static KeyType to_key(const TimestampValue& value) { return RadixSortKey<int64_t>::to_key(value.timestamp()); }
+};
+
+// Sort [begin, end) stably by the LSD radix sort with 8 bits digits, |get_key| returns the unsigned key of an item.
+// The histograms of all the digits are built in one pass, and the digits where all the keys are the same are
+// skipped, e.g. the high bytes of small integers.
+// It costs O(sizeof(key) * n) instead of O(n * log(n)), and beats pdqsort for large n.
+template <class Item, class GetKey>
+void radix_sort(Item* begin, Item* end, GetKey get_key) {
+    using KeyType = decltype(get_key(*begin));
+    static_assert(std::is_unsigned_v<KeyType> || std::is_same_v<KeyType, unsigned __int128>);
+    constexpr size_t kNumDigits = sizeof(KeyType);
+    constexpr size_t kNumBuckets = 256;
+
+    const size_t n = end - begin;
+    if (n <= 1) {
+        return;
+    }
+
+    std::vector<std::array<uint32_t, kNumBuckets>> histograms(kNumDigits);
+    for (auto& histogram : histograms) {
+        histogram.fill(0);
+    }
+    for (Item* iter = begin; iter != end; ++iter) {
+        KeyType key = get_key(*iter);
+        for (size_t d = 0; d < kNumDigits; d++) {
+            histograms[d][static_cast<uint8_t>(key >> (d * 8))]++;
+        }
+    }
+
+    std::vector<Item> buffer(n);
+    Item* src = begin;
+    Item* dst = buffer.data();
+    const KeyType first_key = get_key(*begin);
+    for (size_t d = 0; d < kNumDigits; d++) {
+        auto& histogram = histograms[d];
+        if (histogram[static_cast<uint8_t>(first_key >> (d * 8))] == n) {
+            continue;
+        }
+
+        uint32_t offset = 0;
+        for (auto& count : histogram) {
+            uint32_t next = offset + count;
+            count = offset;
+            offset = next;
+        }
+        for (size_t i = 0; i < n; i++) {
+            dst[histogram[static_cast<uint8_t>(get_key(src[i]) >> (d * 8))]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+    if (src != begin) {
+        std::copy(src, src + n, begin);
+    }
+}
+
+} // namespace starrocks
@@ -26,6 +26,9 @@
 #include "column/json_column.h"
 #include "column/map_column.h"
 #include "column/nullable_column.h"
+#include "column/string_view.h"
+#include "common/config.h"
+#include "exec/sorting/normalized_keys.h"
 #include "exec/sorting/sort_helper.h"
 #include "exec/sorting/sort_permute.h"
 #include "exec/sorting/sorting.h"
@@ -96,12 +99,13 @@ public:
     template <typename T>
     Status do_visit(const BinaryColumnBase<T>& column) {
         DCHECK_GE(column.size(), _permutation.size());
-        using ItemType = InlinePermuteItem<Slice>;
+        // the prefixes of the strings are inlined, most comparisons don't touch the bytes of the column
+        using ItemType = InlinePermuteItem<StringView>;
         auto cmp = [&](const ItemType& lhs, const ItemType& rhs) -> int {
             return lhs.inline_value.compare(rhs.inline_value);
         };
 
-        auto inlined = create_inline_permutation<Slice>(_permutation, column.get_proxy_data());
+        auto inlined = create_inline_permutation<StringView>(_permutation, column.get_proxy_data());
         RETURN_IF_ERROR(
                 sort_and_tie_helper(_cancel, &column, _sort_desc.asc_order(), inlined, _tie, cmp, _range, _build_tie));
         restore_inline_permutation(inlined, _permutation);
@@ -119,6 +123,15 @@ public:
         };
 
         auto inlined = create_inline_permutation<T>(_permutation, column.get_data());
+        if constexpr (RadixSortKey<T>::supported) {
+            const int64_t radix_sort_threshold = config::sort_radix_sort_threshold;
+            if (radix_sort_threshold > 0 && _range.second - _range.first >= radix_sort_threshold) {
+                RETURN_IF_ERROR(sort_and_tie_helper_radix(_cancel, _sort_desc.asc_order(), inlined, _tie, _range,
+                                                          _build_tie, radix_sort_threshold));
+                restore_inline_permutation(inlined, _permutation);
+                return Status::OK();
+            }
+        }
         RETURN_IF_ERROR(
                 sort_and_tie_helper(_cancel, &column, _sort_desc.asc_order(), inlined, _tie, cmp, _range, _build_tie));
         restore_inline_permutation(inlined, _permutation);
@@ -207,7 +220,7 @@ public:
         using ColumnType = BinaryColumnBase<T>;
 
         if (_need_inline_value()) {
-            using ItemType = CompactChunkItem<Slice>;
+            using ItemType = CompactChunkItem<StringView>;
             using Container = typename BinaryColumnBase<T>::BinaryDataProxyContainer;
 
             auto cmp = [&](const ItemType& lhs, const ItemType& rhs) -> int {
@@ -220,7 +233,7 @@ public:
                 containers.push_back(&real->get_proxy_data());
             }
 
-            auto inlined = _create_inlined_permutation<Slice>(containers);
+            auto inlined = _create_inlined_permutation<StringView>(containers);
             RETURN_IF_ERROR(sort_and_tie_helper(_cancel, &column, _sort_desc.asc_order(), inlined, _tie, cmp, _range,
                                                 _build_tie, _limit, &_pruned_limit));
             _restore_inlined_permutation(inlined);
@@ -407,6 +420,45 @@ Status sort_and_tie_column(const std::atomic<bool>& cancel, ColumnPtr& column, c
     return column->accept(&column_sorter);
 }
 
+// Sort the rows by the normalized keys of |columns|, and tie-break the ambiguous rows column by column.
+// Return false if the columns can't be normalized, then |small_perm| is untouched.
+static StatusOr<bool> sort_by_normalized_keys(const std::atomic<bool>& cancel, const Columns& columns,
+                                              const SortDescs& sort_desc, SmallPermutation& small_perm) {
+    size_t string_prefix = std::clamp<int64_t>(config::sort_normalized_key_string_prefix, 0,
+                                               NormalizedKeys::kMaxStringPrefix);
+    NormalizedKeys keys;
+    if (!keys.encode(columns, sort_desc, string_prefix).ok()) {
+        return false;
+    }
+    if (UNLIKELY(cancel.load(std::memory_order_acquire))) {
+        return Status::Cancelled("Sort cancelled");
+    }
+    const size_t key_size = keys.key_size();
+    ::pdqsort(small_perm.begin(), small_perm.end(), [&](SmallPermuteItem lhs, SmallPermuteItem rhs) {
+        return memcmp(keys.key(lhs.index_in_chunk), keys.key(rhs.index_in_chunk), key_size) < 0;
+    });
+    if (!keys.has_ambiguous()) {
+        return true;
+    }
+
+    const size_t num_rows = small_perm.size();
+    Tie tie(num_rows, 0);
+    for (size_t i = 1; i < num_rows; i++) {
+        uint32_t prev = small_perm[i - 1].index_in_chunk;
+        uint32_t cur = small_perm[i].index_in_chunk;
+        tie[i] = (keys.is_ambiguous(prev) || keys.is_ambiguous(cur)) &&
+                 memcmp(keys.key(prev), keys.key(cur), key_size) == 0;
+    }
+    std::pair<int, int> range{0, num_rows};
+    for (int col_index = 0; col_index < columns.size(); col_index++) {
+        ColumnPtr column = columns[col_index];
+        bool build_tie = col_index != columns.size() - 1;
+        RETURN_IF_ERROR(sort_and_tie_column(cancel, column, sort_desc.get_column_desc(col_index), small_perm, tie,
+                                            range, build_tie));
+    }
+    return true;
+}
+
 Status sort_and_tie_columns(const std::atomic<bool>& cancel, const Columns& columns, const SortDescs& sort_desc,
                             Permutation* permutation) {
     if (columns.size() < 1) {
@@ -417,6 +469,14 @@ Status sort_and_tie_columns(const std::atomic<bool>& cancel, const Columns& colu
     std::pair<int, int> range{0, num_rows};
     SmallPermutation small_perm = create_small_permutation(num_rows);
 
+    if (config::enable_sort_normalized_keys && columns.size() > 1) {
+        ASSIGN_OR_RETURN(bool sorted, sort_by_normalized_keys(cancel, columns, sort_desc, small_perm));
+        if (sorted) {
+            restore_small_permutation(small_perm, *permutation);
+            return Status::OK();
+        }
+    }
+
     for (int col_index = 0; col_index < columns.size(); col_index++) {
         ColumnPtr column = columns[col_index];
         bool build_tie = col_index != columns.size() - 1;
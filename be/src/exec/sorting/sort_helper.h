@@ -19,6 +19,7 @@
 #include "column/nullable_column.h"
 #include "column/type_traits.h"
 #include "column/vectorized_fwd.h"
+#include "exec/sorting/radix_sort.h"
 #include "exec/sorting/sort_permute.h"
 #include "exec/sorting/sorting.h"
 #include "types/timestamp_value.h"
@@ -251,6 +252,57 @@ static inline Status sort_and_tie_helper(const std::atomic<bool>& cancel, const
     return Status::OK();
 }
 
+// Like sort_and_tie_helper, but the ranges of at least |radix_sort_threshold| rows are sorted by the LSD radix sort.
+template <class T>
+static inline Status sort_and_tie_helper_radix(const std::atomic<bool>& cancel, bool is_asc_order,
+                                               InlinePermutation<T>& permutation, Tie& tie, std::pair<int, int> range,
+                                               bool build_tie, size_t radix_sort_threshold) {
+    using Traits = RadixSortKey<T>;
+    using ItemType = InlinePermuteItem<T>;
+    auto cmp = [](const ItemType& lhs, const ItemType& rhs) {
+        return SorterComparator<T>::compare(lhs.inline_value, rhs.inline_value);
+    };
+
+    TieIterator iterator(tie, range.first, range.second);
+    while (iterator.next()) {
+        if (UNLIKELY(cancel.load(std::memory_order_acquire))) {
+            return Status::Cancelled("Sort cancelled");
+        }
+        int range_first = iterator.range_first;
+        int range_last = iterator.range_last;
+        if (range_last - range_first <= 1) {
+            continue;
+        }
+
+        auto begin = permutation.begin() + range_first;
+        auto end = permutation.begin() + range_last;
+        if (static_cast<size_t>(range_last - range_first) >= radix_sort_threshold) {
+            ItemType* first = permutation.data() + range_first;
+            ItemType* last = permutation.data() + range_last;
+            if (is_asc_order) {
+                radix_sort(first, last, [](const ItemType& item) { return Traits::to_key(item.inline_value); });
+            } else {
+                radix_sort(first, last, [](const ItemType& item) {
+                    return static_cast<typename Traits::KeyType>(~Traits::to_key(item.inline_value));
+                });
+            }
+        } else if (is_asc_order) {
+            ::pdqsort(begin, end, [&](const ItemType& lhs, const ItemType& rhs) { return cmp(lhs, rhs) < 0; });
+        } else {
+            ::pdqsort(begin, end, [&](const ItemType& lhs, const ItemType& rhs) { return cmp(lhs, rhs) > 0; });
+        }
+
+        if (build_tie) {
+            tie[range_first] = 0;
+            for (int i = range_first + 1; i < range_last; i++) {
+                tie[i] &= cmp(permutation[i - 1], permutation[i]) == 0;
+            }
+        }
+    }
+
+    return Status::OK();
+}
+
 static inline int compare_chunk_row(const SortDescs& desc, const Columns& lhs, const Columns& rhs, size_t lhs_row,
                                     size_t rhs_row) {
     DCHECK_EQ(lhs.size(), rhs.size());
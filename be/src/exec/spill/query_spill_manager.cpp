@@ -14,12 +14,16 @@
 
 #include "exec/spill/query_spill_manager.h"
 
+#include <fmt/format.h>
+
 #include <mutex>
 #include <vector>
 
 #include "common/config.h"
+#include "common/logging.h"
 #include "exec/spill/spiller_path_provider.h"
 #include "gen_cpp/Types_types.h"
+#include "service/backend_options.h"
 #include "storage/options.h"
 
 namespace starrocks {
@@ -46,6 +50,19 @@ Status QuerySpillManager::init(const TUniqueId& uid) {
     }
 
     _uid = uid;
+
+    if (!config::spill_remote_storage_path.empty()) {
+        auto fs = FileSystem::CreateSharedFromString(config::spill_remote_storage_path);
+        if (fs.ok()) {
+            _remote_fs = std::move(fs.value());
+            // the query is spilled by many backends
+            _remote_path = fmt::format("{}/{}_{}/{}", config::spill_remote_storage_path,
+                                       BackendOptions::get_localhost(), config::be_port, print_id(uid));
+        } else {
+            LOG(WARNING) << "spill to local disks only, failed to open the remote spill storage "
+                         << config::spill_remote_storage_path << ": " << fs.status();
+        }
+    }
     return Status::OK();
 }
 
@@ -57,11 +74,39 @@ std::vector<std::string> QuerySpillManager::_spill_paths(const TUniqueId& uid) c
     return res;
 }
 
+bool QuerySpillManager::arbitrate_spill(const void* op, size_t revocable_bytes, double spill_cost,
+                                        size_t excess_bytes) {
+    const double score = revocable_bytes / std::max(spill_cost, 1e-3);
+    std::lock_guard guard(_candidates_mutex);
+    _spill_candidates[op] = {revocable_bytes, score};
+    // the bytes freed by the operators ranked before |op|
+    size_t preceding_bytes = 0;
+    for (const auto& [other, candidate] : _spill_candidates) {
+        if (candidate.score > score || (candidate.score == score && other < op)) {
+            preceding_bytes += candidate.revocable_bytes;
+        }
+    }
+    return preceding_bytes < excess_bytes;
+}
+
+void QuerySpillManager::remove_spill_candidate(const void* op) {
+    std::lock_guard guard(_candidates_mutex);
+    _spill_candidates.erase(op);
+}
+
 SpillPathProviderFactory QuerySpillManager::provider(const std::string& prefix) {
     auto paths = _spill_paths(_uid);
     std::lock_guard guard(_mutex);
     if (auto iter = _spill_provider_factorys.find(prefix); iter == _spill_provider_factorys.end()) {
-        auto path_provider = std::make_shared<LocalPathProvider>(paths, prefix, _fs);
+        std::shared_ptr<SpillerPathProvider> path_provider;
+        auto local_provider = std::make_shared<LocalPathProvider>(paths, prefix, _fs);
+        if (_remote_fs != nullptr) {
+            auto remote_provider = std::make_shared<RemotePathProvider>(_remote_path, prefix, _remote_fs);
+            path_provider = std::make_shared<TieredPathProvider>(std::move(local_provider), std::move(remote_provider),
+                                                                 _local_usage, config::spill_local_max_bytes_per_query);
+        } else {
+            path_provider = std::move(local_provider);
+        }
         auto factory = [provider = std::move(path_provider)]() -> StatusOr<std::shared_ptr<SpillerPathProvider>> {
             return provider;
         };
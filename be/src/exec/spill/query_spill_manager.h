@@ -14,7 +14,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
@@ -37,6 +39,20 @@ public:
 
     size_t pending_spilled_bytes() { return _spilled_bytes; }
     void update_spilled_bytes(size_t spilled_bytes) { _spilled_bytes += spilled_bytes; }
+    // Called when the bytes added by update_spilled_bytes have been spilled and released.
+    void release_spilled_bytes(size_t spilled_bytes) {
+        size_t current = _spilled_bytes.load();
+        while (!_spilled_bytes.compare_exchange_weak(current, current - std::min(current, spilled_bytes))) {
+        }
+    }
+
+    // Arbitrate which spillable operators of the query spill when the query exceeds the spill threshold by
+    // |excess_bytes|. The operators are ranked by the revocable bytes per spill cost, and the top ones spill until
+    // the excess bytes are covered, rather than the first operators noticing the pressure.
+    // Update the revocable bytes of |op| and return whether it should spill now.
+    bool arbitrate_spill(const void* op, size_t revocable_bytes, double spill_cost, size_t excess_bytes);
+    // |op| has nothing to spill any more, e.g. it's marked to spill or finished.
+    void remove_spill_candidate(const void* op);
 
 private:
     static std::vector<std::string> _spill_root_paths;
@@ -45,7 +61,19 @@ private:
     std::vector<std::string> _spill_paths(const TUniqueId& uid) const;
     std::unordered_map<std::string, SpillPathProviderFactory> _spill_provider_factorys;
     std::mutex _mutex;
-    std::atomic_size_t _spilled_bytes;
+
+    struct SpillCandidate {
+        size_t revocable_bytes;
+        double score;
+    };
+    std::unordered_map<const void*, SpillCandidate> _spill_candidates;
+    std::mutex _candidates_mutex;
+    std::atomic_size_t _spilled_bytes = 0;
     FileSystem* _fs = FileSystem::Default();
+    // the bytes of the local spilled files of the query
+    std::shared_ptr<std::atomic_int64_t> _local_usage = std::make_shared<std::atomic_int64_t>(0);
+    // the remote storage that the local spilled files overflow to, nullptr if not configured
+    std::shared_ptr<FileSystem> _remote_fs;
+    std::string _remote_path;
 };
 } // namespace starrocks
\ No newline at end of file
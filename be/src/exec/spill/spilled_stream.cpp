@@ -16,6 +16,7 @@
 
 #include <glog/logging.h>
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <memory>
@@ -24,6 +25,7 @@
 #include <utility>
 
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
 #include "common/status.h"
 #include "exec/sort_exec_exprs.h"
 #include "exec/sorting/sorting.h"
@@ -31,6 +33,7 @@
 #include "exec/spill/spiller.h"
 #include "exec/spill/spiller_path_provider.h"
 #include "fs/fs.h"
+#include "io/io_stats.h"
 #include "runtime/runtime_state.h"
 #include "runtime/sorted_chunks_merger.h"
 #include "util/blocking_queue.hpp"
@@ -40,6 +43,20 @@ struct SpilledStreamConfig {
     static constexpr size_t chunk_buffer_max_size = 2;
 };
 
+// The memory budget of the chunks read ahead, shared by the buffered sorted runs of a partition.
+class SpillReadAheadBudget {
+public:
+    explicit SpillReadAheadBudget(int64_t limit) : _limit(limit) {}
+
+    bool exceeded() const { return _usage.load(std::memory_order_relaxed) >= _limit; }
+    void consume(int64_t bytes) { _usage.fetch_add(bytes, std::memory_order_relaxed); }
+    void release(int64_t bytes) { _usage.fetch_sub(bytes, std::memory_order_relaxed); }
+
+private:
+    const int64_t _limit;
+    std::atomic<int64_t> _usage{0};
+};
+
 // read chunk from spilled files one by one
 // A basic input stream for multiple files
 class SequentialFileStream final : public SpilledInputStream {
@@ -61,6 +78,7 @@ private:
 };
 
 StatusOr<ChunkUniquePtr> SequentialFileStream::read(SpillFormatContext& context) {
+    SCOPED_IO_PURPOSE(io::IOPurpose::SPILL);
     size_t eos_retry_times = 0;
     while (eos_retry_times++ < max_eos_retry_times) {
         if (_readable == nullptr) {
@@ -94,11 +112,20 @@ void SequentialFileStream::close() {
 // we can wrap the inputstream in an buffered input stream and run the read_to_buffer task in another thread pool
 class BufferedSpilledStream final : public SpilledInputStream {
 public:
-    BufferedSpilledStream(int capacity, std::shared_ptr<SpilledInputStream> stream)
-            : _capacity(capacity), _raw_input_stream(std::move(stream)) {}
+    // The buffer holds at least one chunk and at most |capacity| chunks, and stops reading ahead once |budget|
+    // is exceeded if it's not null.
+    BufferedSpilledStream(int capacity, std::shared_ptr<SpilledInputStream> stream,
+                          std::shared_ptr<SpillReadAheadBudget> budget = nullptr)
+            : _capacity(capacity), _raw_input_stream(std::move(stream)), _budget(std::move(budget)) {}
     ~BufferedSpilledStream() override = default;
 
-    bool buffer_fulled() const { return _chunk_buffer.get_size() == _capacity || eof(); }
+    bool buffer_fulled() const {
+        size_t size = _chunk_buffer.get_size();
+        if (size >= static_cast<size_t>(_capacity) || eof()) {
+            return true;
+        }
+        return _budget != nullptr && size > 0 && _budget->exceeded();
+    }
 
     bool buffer_has_data() const { return _chunk_buffer.get_size() > 0 || eof(); }
 
@@ -125,6 +152,7 @@ private:
     int _capacity;
     UnboundedBlockingQueue<ChunkUniquePtr> _chunk_buffer;
     std::shared_ptr<SpilledInputStream> _raw_input_stream;
+    std::shared_ptr<SpillReadAheadBudget> _budget;
     std::atomic_bool _is_running{};
     size_t _read_rows_from_buffer = 0;
 };
@@ -137,6 +165,9 @@ StatusOr<ChunkUniquePtr> BufferedSpilledStream::read_from_buffer() {
     ChunkUniquePtr res;
     CHECK(_chunk_buffer.try_get(&res));
     _read_rows_from_buffer += res->num_rows();
+    if (_budget != nullptr) {
+        _budget->release(res->memory_usage());
+    }
 
     return res;
 }
@@ -155,6 +186,9 @@ Status BufferedSpilledStream::read_to_buffer(SpillFormatContext& context) {
     auto res = _raw_input_stream->read(context);
     if (res.ok()) {
         // put it to chunk buffer
+        if (_budget != nullptr) {
+            _budget->consume(res.value()->memory_usage());
+        }
         _chunk_buffer.put(std::move(res.value()));
         return Status::OK();
     } else if (res.status().is_end_of_file()) {
@@ -193,9 +227,11 @@ SortedFileStream::SortedFileStream(SpilledInputStreamList streams, RuntimeState*
 
 Status SortedFileStream::init(const SortExecExprs* sort_exprs, const SortDescs* descs) {
     std::vector<ChunkProvider> providers;
+    // every run reads ahead on its own, while the memory of the chunks read ahead by all the runs is bounded.
+    auto budget = std::make_shared<SpillReadAheadBudget>(config::spill_restore_prefetch_bytes);
+    int capacity = std::max<int>(SpilledStreamConfig::chunk_buffer_max_size, config::spill_restore_prefetch_chunks);
     for (auto& stream : _streams) {
-        _buffered_streams.emplace_back(
-                std::make_unique<BufferedSpilledStream>(SpilledStreamConfig::chunk_buffer_max_size, stream));
+        _buffered_streams.emplace_back(std::make_unique<BufferedSpilledStream>(capacity, stream, budget));
         auto buffered_stream = _buffered_streams.back();
         auto chunk_provider = [buffered_stream, this](ChunkUniquePtr* out_chunk, bool* eos) {
             if (out_chunk == nullptr || eos == nullptr) {
@@ -265,8 +301,13 @@ Status BufferedSpillReadTask::do_read(SpillFormatContext& context) {
     for (auto& stream : _buffered_stream) {
         if (!stream->buffer_fulled() && !stream->eof()) {
             if (stream->acquire()) {
-                RETURN_IF_ERROR(stream->read_to_buffer(context));
+                // read ahead until the buffer is full, rather than one chunk per task
+                Status st;
+                while (st.ok() && !stream->buffer_fulled()) {
+                    st = stream->read_to_buffer(context);
+                }
                 stream->release();
+                RETURN_IF_ERROR(st);
             } else {
                 // TODO: now we cannot guarantee that the read task trigger is thread-safe,
                 // in the future we can implement it
@@ -304,8 +345,11 @@ StatusOr<InputStreamWithTasks> SpilledFileGroup::as_sorted_stream(std::weak_ptr<
 
     auto stream = std::make_shared<SortedFileStream>(res, state);
     RETURN_IF_ERROR(stream->init(sort_exprs, descs));
-    auto tasks =
-            std::vector<SpillRestoreTaskPtr>{std::make_shared<BufferedSpillReadTask>(factory, stream->raw_streams())};
+    // one read task per run, so the runs are read and deserialized in parallel by the io executor.
+    std::vector<SpillRestoreTaskPtr> tasks;
+    for (auto& raw_stream : stream->raw_streams()) {
+        tasks.emplace_back(std::make_shared<BufferedSpillReadTask>(factory, raw_stream));
+    }
 
     return {{std::move(stream), std::move(tasks)}};
 }
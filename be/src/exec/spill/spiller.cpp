@@ -33,8 +33,13 @@
 #include "exec/spill/spilled_stream.h"
 #include "exec/spill/spiller_path_provider.h"
 #include "gutil/port.h"
+#include "io/io_stats.h"
 #include "runtime/runtime_state.h"
 #include "serde/column_array_serde.h"
+#include "serde/protobuf_serde.h"
+#include "util/compression/block_compression.h"
+#include "util/compression/compression_utils.h"
+#include "util/raw_container.h"
 
 namespace starrocks {
 SpillProcessMetrics::SpillProcessMetrics(RuntimeProfile* profile) {
@@ -110,9 +115,141 @@ Status ColumnSpillFormater::flush(std::unique_ptr<WritableFile>& writable) const
     return Status::OK();
 }
 
+// The columns are serialized with the lightweight integer encoding of ColumnArraySerde, and then the block is
+// compressed as a whole by a BlockCompressionCodec, it's kept uncompressed if the compression doesn't pay off.
+// The layout of a block:
+// | block size (8 bytes) | encode level (4 bytes) | compression type (4 bytes) | uncompressed size (8 bytes) | data |
+class CompressedColumnSpillFormater : public SpillFormater {
+public:
+    // |codec| is nullptr means no compression.
+    CompressedColumnSpillFormater(ChunkBuilder chunk_builder, const BlockCompressionCodec* codec, int encode_level)
+            : _chunk_builder(std::move(chunk_builder)), _codec(codec), _encode_level(encode_level) {}
+    Status spill_as_fmt(SpillFormatContext& context, std::unique_ptr<WritableFile>& writable,
+                        const ChunkPtr& chunk) const noexcept override;
+    StatusOr<ChunkUniquePtr> restore_from_fmt(SpillFormatContext& context,
+                                              std::unique_ptr<RawInputStreamWrapper>& readable) const override;
+    Status flush(std::unique_ptr<WritableFile>& writable) const override;
+
+private:
+    static constexpr size_t kHeaderSize = sizeof(uint64_t) * 2 + sizeof(uint32_t) * 2;
+    // streamvbyte may read up to 16 bytes beyond the encoded integers
+    static constexpr size_t kPaddingSize = serde::EncodeContext::STREAMVBYTE_PADDING_SIZE;
+    // keep the block uncompressed if the compressed one is larger than this ratio of it
+    static constexpr double kMaxCompressRatio = 0.9;
+
+    ChunkBuilder _chunk_builder;
+    const BlockCompressionCodec* _codec;
+    const int _encode_level;
+};
+
+Status CompressedColumnSpillFormater::spill_as_fmt(SpillFormatContext& context,
+                                                   std::unique_ptr<WritableFile>& writable,
+                                                   const ChunkPtr& chunk) const noexcept {
+    size_t max_serialize_sz = 0;
+    for (const auto& column : chunk->columns()) {
+        max_serialize_sz += serde::ColumnArraySerde::max_serialized_size(*column, _encode_level);
+    }
+    raw::stl_string_resize_uninitialized(&context.compress_buffer, max_serialize_sz + kPaddingSize);
+    auto* begin = reinterpret_cast<uint8_t*>(context.compress_buffer.data());
+    uint8_t* buff = begin;
+    for (const auto& column : chunk->columns()) {
+        buff = serde::ColumnArraySerde::serialize(*column, buff, false, _encode_level);
+        if (UNLIKELY(buff == nullptr)) {
+            return Status::InternalError("has unsupported column");
+        }
+    }
+    const size_t serialize_sz = buff - begin;
+
+    CompressionTypePB compression = CompressionTypePB::NO_COMPRESSION;
+    size_t data_sz = serialize_sz;
+    if (_codec != nullptr && !_codec->exceed_max_input_size(serialize_sz)) {
+        size_t max_compressed_sz = _codec->max_compressed_len(serialize_sz);
+        raw::stl_string_resize_uninitialized(&context.io_buffer, kHeaderSize + max_compressed_sz);
+        Slice compressed(context.io_buffer.data() + kHeaderSize, max_compressed_sz);
+        RETURN_IF_ERROR(_codec->compress(Slice(begin, serialize_sz), &compressed));
+        if (compressed.size < serialize_sz * kMaxCompressRatio) {
+            compression = _codec->type();
+            data_sz = compressed.size;
+        }
+    }
+    raw::stl_string_resize_uninitialized(&context.io_buffer, kHeaderSize + data_sz);
+    auto* header = reinterpret_cast<uint8_t*>(context.io_buffer.data());
+    if (compression == CompressionTypePB::NO_COMPRESSION) {
+        memcpy(header + kHeaderSize, begin, serialize_sz);
+    }
+    UNALIGNED_STORE64(header, kHeaderSize + data_sz);
+    UNALIGNED_STORE32(header + 8, _encode_level);
+    UNALIGNED_STORE32(header + 12, compression);
+    UNALIGNED_STORE64(header + 16, serialize_sz);
+
+    RETURN_IF_ERROR(writable->append(context.io_buffer));
+    return Status::OK();
+}
+
+StatusOr<ChunkUniquePtr> CompressedColumnSpillFormater::restore_from_fmt(
+        SpillFormatContext& context, std::unique_ptr<RawInputStreamWrapper>& readable) const {
+    uint64_t block_sz;
+    RETURN_IF_ERROR(readable->read_fully(&block_sz, sizeof(block_sz)));
+    if (UNLIKELY(block_sz < kHeaderSize)) {
+        return Status::Corruption(fmt::format("invalid spilled block size:{}", block_sz));
+    }
+    raw::stl_string_resize_uninitialized(&context.io_buffer, block_sz - sizeof(block_sz) + kPaddingSize);
+    auto* buff = reinterpret_cast<uint8_t*>(context.io_buffer.data());
+    RETURN_IF_ERROR(readable->read_fully(buff, block_sz - sizeof(block_sz)));
+
+    const int encode_level = static_cast<int32_t>(UNALIGNED_LOAD32(buff));
+    const auto compression = static_cast<CompressionTypePB>(UNALIGNED_LOAD32(buff + 4));
+    const uint64_t serialize_sz = UNALIGNED_LOAD64(buff + 8);
+    const uint8_t* read_cursor = buff + kHeaderSize - sizeof(block_sz);
+    if (compression != CompressionTypePB::NO_COMPRESSION) {
+        const BlockCompressionCodec* codec = nullptr;
+        RETURN_IF_ERROR(get_block_compression_codec(compression, &codec));
+        raw::stl_string_resize_uninitialized(&context.compress_buffer, serialize_sz + kPaddingSize);
+        Slice decompressed(context.compress_buffer.data(), serialize_sz);
+        RETURN_IF_ERROR(codec->decompress(Slice(read_cursor, block_sz - kHeaderSize), &decompressed));
+        if (UNLIKELY(decompressed.size != serialize_sz)) {
+            return Status::Corruption(fmt::format("spilled block is decompressed to {} bytes, expected {} bytes",
+                                                  decompressed.size, serialize_sz));
+        }
+        read_cursor = reinterpret_cast<const uint8_t*>(context.compress_buffer.data());
+    }
+
+    auto chunk = _chunk_builder();
+    for (const auto& column : chunk->columns()) {
+        read_cursor = serde::ColumnArraySerde::deserialize(read_cursor, column.get(), false, encode_level);
+        if (UNLIKELY(read_cursor == nullptr)) {
+            return Status::Corruption("failed to deserialize the spilled block");
+        }
+    }
+    return chunk;
+}
+
+Status CompressedColumnSpillFormater::flush(std::unique_ptr<WritableFile>& writable) const {
+    if (!config::experimental_spill_skip_sync) {
+        RETURN_IF_ERROR(writable->flush(WritableFile::FLUSH_ASYNC));
+    }
+    return Status::OK();
+}
+
 StatusOr<std::unique_ptr<SpillFormater>> SpillFormater::create(SpillFormaterType type, ChunkBuilder chunk_builder) {
     if (type == SpillFormaterType::SPILL_BY_COLUMN) {
         return std::make_unique<ColumnSpillFormater>(std::move(chunk_builder));
+    } else if (type == SpillFormaterType::SPILL_BY_COMPRESSED_COLUMN) {
+        CompressionTypePB compression = CompressionTypePB::NO_COMPRESSION;
+        if (config::spill_compression_type != "none") {
+            compression = CompressionUtils::to_compression_pb(config::spill_compression_type);
+            if (compression == CompressionTypePB::UNKNOWN_COMPRESSION) {
+                return Status::InvalidArgument(
+                        fmt::format("unknown spill compression type:{}", config::spill_compression_type));
+            }
+        }
+        const BlockCompressionCodec* codec = nullptr;
+        RETURN_IF_ERROR(get_block_compression_codec(compression, &codec));
+        // ENCODE_INTEGER of serde::EncodeContext, the strings are left to the block compression.
+        // The spilled blocks never leave this BE, so the null flags are always spilled as a bitmap
+        // (ENCODE_NULL_BITMAP).
+        int encode_level = (config::enable_spill_integer_encoding ? 2 : 0) | 16;
+        return std::make_unique<CompressedColumnSpillFormater>(std::move(chunk_builder), codec, encode_level);
     } else {
         return Status::InternalError(fmt::format("unsupported spill type:{}", type));
     }
@@ -162,12 +299,14 @@ Status Spiller::_flush_and_closed(std::unique_ptr<WritableFile>& writable) {
 }
 
 Status Spiller::_run_flush_task(RuntimeState* state, const MemTablePtr& mem_table) {
+    SCOPED_IO_PURPOSE(io::IOPurpose::SPILL);
     RETURN_IF_ERROR(this->_open(state));
     // prepare current file
     ASSIGN_OR_RETURN(auto file, _path_provider->get_file());
     ASSIGN_OR_RETURN(auto writable, file->as<WritableFile>());
     // TODO: reuse io context
     SpillFormatContext spill_ctx;
+    SpillFile* spill_file = file.get();
     {
         std::lock_guard guard(_mutex);
         _file_group->append_file(std::move(file));
@@ -184,6 +323,7 @@ Status Spiller::_run_flush_task(RuntimeState* state, const MemTablePtr& mem_tabl
         }));
         TRACE_SPILL_LOG << "spill flush rows:" << num_rows_flushed << ",spiller:" << this;
     }
+    spill_file->update_written_bytes(writable->size());
     // then release the pending memory
     RETURN_IF_ERROR(_flush_and_closed(writable));
     return Status::OK();
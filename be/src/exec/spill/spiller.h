@@ -34,7 +34,7 @@
 #include "util/runtime_profile.h"
 
 namespace starrocks {
-enum class SpillFormaterType { NONE, SPILL_BY_COLUMN };
+enum class SpillFormaterType { NONE, SPILL_BY_COLUMN, SPILL_BY_COMPRESSED_COLUMN };
 
 using ChunkBuilder = std::function<ChunkUniquePtr()>;
 
@@ -80,6 +80,8 @@ struct SpillProcessMetrics {
 // some context for spiller to reuse data
 struct SpillFormatContext {
     std::string io_buffer;
+    // the serialized columns before compressed or after decompressed
+    std::string compress_buffer;
 };
 
 // spill strategy
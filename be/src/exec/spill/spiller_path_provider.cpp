@@ -18,6 +18,7 @@
 
 #include <memory>
 
+#include "common/config.h"
 #include "common/status.h"
 
 namespace starrocks {
@@ -45,4 +46,58 @@ StatusOr<SpillFilePtr> LocalPathProvider::get_file() {
     return std::make_shared<SpillFile>(std::move(file_path), _fs);
 }
 
+bool LocalPathProvider::next_disk_full() const {
+    const std::string& path = _paths[_next_id.load() % _paths.size()];
+    auto space = _fs->space(path);
+    if (!space.ok() || space->capacity <= 0) {
+        return false;
+    }
+    // the same as the flood stage of the data dirs
+    int64_t used_percent = (space->capacity - space->available) * 100 / space->capacity;
+    return used_percent >= config::storage_flood_stage_usage_percent &&
+           space->available <= config::storage_flood_stage_left_capacity_bytes;
+}
+
+RemotePathProvider::~RemotePathProvider() noexcept {
+    if (_del_path) {
+        // the files left by a failed query are deleted too
+        WARN_IF_ERROR(_fs->delete_dir_recursive(_path), "delete remote spilled path error:");
+    }
+}
+
+Status RemotePathProvider::open(RuntimeState* state) {
+    bool created;
+    RETURN_IF_ERROR(_fs->create_dir_if_missing(_path, &created));
+    return Status::OK();
+}
+
+StatusOr<SpillFilePtr> RemotePathProvider::get_file() {
+    int32_t id = _next_id.fetch_add(1);
+    auto file_path = fmt::format("{}/{}-{}", _path, _prefix, id);
+    return std::make_shared<SpillFile>(std::move(file_path), _fs);
+}
+
+Status TieredPathProvider::open(RuntimeState* state) {
+    // the remote storage is opened when the local disks are exhausted
+    return _local->open(state);
+}
+
+bool TieredPathProvider::_local_exhausted() const {
+    if (_local_quota >= 0 && _local_usage->load() >= _local_quota) {
+        return true;
+    }
+    return _local->next_disk_full();
+}
+
+StatusOr<SpillFilePtr> TieredPathProvider::get_file() {
+    if (!_local_exhausted()) {
+        ASSIGN_OR_RETURN(auto file, _local->get_file());
+        file->set_usage_counter(_local_usage);
+        return file;
+    }
+    std::call_once(_remote_opened, [this]() { _remote_open_status = _remote->open(nullptr); });
+    RETURN_IF_ERROR(_remote_open_status);
+    return _remote->get_file();
+}
+
 } // namespace starrocks
\ No newline at end of file
@@ -16,6 +16,7 @@
 
 #include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -34,20 +35,39 @@ using SpillPaths = std::vector<std::string>;
 class SpillFile {
 public:
     SpillFile(std::string file_path, FileSystem* fs) : _file_path(std::move(file_path)), _fs(fs) {}
+    // the file system is kept alive by the file, e.g. a remote one.
+    SpillFile(std::string file_path, std::shared_ptr<FileSystem> fs)
+            : _file_path(std::move(file_path)), _fs(fs.get()), _shared_fs(std::move(fs)) {}
     ~SpillFile() noexcept {
         if (_del_file) {
             WARN_IF_ERROR(_fs->delete_file(_file_path), "delete spilled file error:");
         }
+        if (_usage != nullptr) {
+            _usage->fetch_sub(_written_bytes);
+        }
     }
     template <class T>
     StatusOr<std::unique_ptr<T>> as();
 
     StatusOr<int64_t> file_size() { return _fs->get_file_size(_file_path); }
+    const std::string& path() const { return _file_path; }
+
+    // The written bytes are counted in |usage| until the file is deleted.
+    void set_usage_counter(std::shared_ptr<std::atomic_int64_t> usage) { _usage = std::move(usage); }
+    void update_written_bytes(int64_t bytes) {
+        if (_usage != nullptr) {
+            _usage->fetch_add(bytes - _written_bytes);
+        }
+        _written_bytes = bytes;
+    }
 
 private:
     const bool _del_file = AUTO_DEL_SPILL_FILE;
     std::string _file_path;
     FileSystem* _fs;
+    std::shared_ptr<FileSystem> _shared_fs;
+    std::shared_ptr<std::atomic_int64_t> _usage;
+    int64_t _written_bytes = 0;
 };
 
 // a wrapper for io::InputStream
@@ -109,6 +129,9 @@ public:
     Status open(RuntimeState* state) override;
     StatusOr<SpillFilePtr> get_file() override;
 
+    // Whether the disk of the next file reaches the flood stage of the storage.
+    bool next_disk_full() const;
+
 private:
     const bool _del_path = AUTO_DEL_SPILL_DIR;
     SpillPaths _paths;
@@ -116,4 +139,48 @@ private:
     FileSystem* _fs;
     std::atomic_int _next_id = 0;
 };
+
+// Spill to a shared file system, e.g. S3 or HDFS. The files are written sequentially, and the file system does
+// the multipart upload.
+class RemotePathProvider : public SpillerPathProvider {
+public:
+    RemotePathProvider(std::string path, std::string prefix, std::shared_ptr<FileSystem> fs)
+            : _path(std::move(path)), _prefix(std::move(prefix)), _fs(std::move(fs)) {}
+    ~RemotePathProvider() noexcept override;
+    Status open(RuntimeState* state) override;
+    StatusOr<SpillFilePtr> get_file() override;
+
+private:
+    const bool _del_path = AUTO_DEL_SPILL_DIR;
+    std::string _path;
+    std::string _prefix;
+    std::shared_ptr<FileSystem> _fs;
+    std::atomic_int _next_id = 0;
+};
+
+// Spill to the local disks, and overflow to the remote storage once the local files of the query exceed
+// |local_quota| bytes or the local disk is nearly full.
+class TieredPathProvider : public SpillerPathProvider {
+public:
+    // |local_usage| is the bytes of the local files of the query, |local_quota| < 0 means no quota.
+    TieredPathProvider(std::shared_ptr<LocalPathProvider> local, std::shared_ptr<RemotePathProvider> remote,
+                       std::shared_ptr<std::atomic_int64_t> local_usage, int64_t local_quota)
+            : _local(std::move(local)),
+              _remote(std::move(remote)),
+              _local_usage(std::move(local_usage)),
+              _local_quota(local_quota) {}
+    ~TieredPathProvider() noexcept override = default;
+    Status open(RuntimeState* state) override;
+    StatusOr<SpillFilePtr> get_file() override;
+
+private:
+    bool _local_exhausted() const;
+
+    std::shared_ptr<LocalPathProvider> _local;
+    std::shared_ptr<RemotePathProvider> _remote;
+    std::shared_ptr<std::atomic_int64_t> _local_usage;
+    const int64_t _local_quota;
+    std::once_flag _remote_opened;
+    Status _remote_open_status;
+};
 } // namespace starrocks
\ No newline at end of file
@@ -38,6 +38,10 @@ public:
 
     size_t get_output_rows() const override;
 
+    const SortedRuns* sorted_runs() const override {
+        return _spiller->spilled() ? nullptr : ChunksSorterFullSort::sorted_runs();
+    }
+
 private:
     void _update_revocable_mem_bytes();
 
@@ -17,8 +17,11 @@
 
 #include "exec/stream/aggregate/agg_group_state.h"
 
+#include "common/config.h"
+#include "exec/pipeline/query_context.h"
 #include "exprs/agg/stream/stream_detail_state.h"
 #include "fmt/format.h"
+#include "util/uid_util.h"
 
 namespace starrocks::stream {
 
@@ -68,10 +71,37 @@ Status AggGroupState::prepare(RuntimeState* state) {
 Status AggGroupState::_prepare_mem_state_tables(RuntimeState* state,
                                                 const std::vector<AggStateData*>& intermediate_agg_states,
                                                 const std::vector<AggStateData*>& detail_agg_states) {
+    return _prepare_state_tables(state, intermediate_agg_states, detail_agg_states,
+                                 [](std::vector<SlotDescriptor*> slots, size_t k_num, const std::string& name) {
+                                     return std::make_unique<MemStateTable>(std::move(slots), k_num);
+                                 });
+}
+
+Status AggGroupState::_prepare_imt_state_tables(RuntimeState* state,
+                                                const std::vector<AggStateData*>& intermediate_agg_states,
+                                                const std::vector<AggStateData*>& detail_agg_states) {
+    // The state tables of a fragment instance are kept under the directory of the mv and the instance.
+    int64_t mv_id = 0;
+    if (state->query_ctx() != nullptr && state->query_ctx()->stream_epoch_manager() != nullptr) {
+        mv_id = state->query_ctx()->stream_epoch_manager()->maintenance_task_info().mv_id;
+    }
+    auto dir = fmt::format("{}/{}/{}/{}", config::stream_state_table_dir, mv_id,
+                           print_id(state->fragment_instance_id()), _output_tuple_desc->id());
+    return _prepare_state_tables(state, intermediate_agg_states, detail_agg_states,
+                                 [&dir](std::vector<SlotDescriptor*> slots, size_t k_num, const std::string& name) {
+                                     return std::make_unique<KVStateTable>(std::move(slots), k_num,
+                                                                           fmt::format("{}/{}", dir, name));
+                                 });
+}
+
+Status AggGroupState::_prepare_state_tables(RuntimeState* state,
+                                            const std::vector<AggStateData*>& intermediate_agg_states,
+                                            const std::vector<AggStateData*>& detail_agg_states,
+                                            const StateTableFactory& factory) {
     auto key_size = _params->grouping_exprs.size();
     // result state table must be made!
     auto output_slots = _output_tuple_desc->slots();
-    _result_state_table = std::make_unique<MemStateTable>(output_slots, key_size);
+    _result_state_table = factory(output_slots, key_size, "result");
 
     // intermediate agg_state is created when intermediate/detail agg states are not empty.
     if (!intermediate_agg_states.empty()) {
@@ -84,7 +114,7 @@ Status AggGroupState::_prepare_mem_state_tables(RuntimeState* state,
             DCHECK_LT(agg_func_id + key_size, _intermediate_tuple_desc->slots().size());
             intermediate_slots.push_back(_intermediate_tuple_desc->slots()[agg_func_id + key_size]);
         }
-        _intermediate_state_table = std::make_unique<MemStateTable>(intermediate_slots, key_size);
+        _intermediate_state_table = factory(intermediate_slots, key_size, "intermediate");
     }
 
     if (!detail_agg_states.empty()) {
@@ -102,19 +132,14 @@ Status AggGroupState::_prepare_mem_state_tables(RuntimeState* state,
             detail_table_slots.push_back(_output_tuple_desc->slots()[key_size + agg_func_idx]);
             detail_table_slots.push_back(_output_tuple_desc->slots()[key_size + count_agg_idx]);
             DCHECK_EQ(detail_table_slots.size(), key_size + 2);
-            auto detail_state_table = std::make_unique<MemStateTable>(detail_table_slots, key_size + 1);
+            auto detail_state_table =
+                    factory(detail_table_slots, key_size + 1, fmt::format("detail_{}", agg_state->agg_func_id()));
             _detail_state_tables.emplace_back(std::move(detail_state_table));
         }
     }
     return Status::OK();
 }
 
-Status AggGroupState::_prepare_imt_state_tables(RuntimeState* state,
-                                                const std::vector<AggStateData*>& intermediate_agg_states,
-                                                const std::vector<AggStateData*>& detail_agg_states) {
-    return Status::InternalError("IMT state table is not supported yet.");
-}
-
 Status AggGroupState::open(RuntimeState* state) {
     // Update result table
     DCHECK(_result_state_table);
@@ -196,7 +221,9 @@ Status AggGroupState::process_chunk(size_t chunk_size, const Columns& group_by_c
             StateTableResult detail_result_chunk;
 
             // Restore retract state from detail table, find the details for the specific group_by_keys and agg_values.
-            RETURN_IF_ERROR(detail_state_table->seek(detail_seek_keys, keys_not_in_map, detail_result_chunk));
+            // The details of all the rows are restored, not only the ones of the new groups, because the values
+            // may be new to the existed groups, while the restored details are skipped.
+            RETURN_IF_ERROR(detail_state_table->seek(detail_seek_keys, detail_result_chunk));
 
             RETURN_IF_ERROR(agg_state->allocate_detail_state(chunk_size, raw_columns[i][0], &detail_result_chunk,
                                                              agg_group_state));
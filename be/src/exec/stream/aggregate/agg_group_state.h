@@ -17,7 +17,10 @@
 
 #pragma once
 
+#include <functional>
+
 #include "exec/stream/aggregate/agg_state_data.h"
+#include "exec/stream/state/kv_state_table.h"
 #include "exec/stream/state/mem_state_table.h"
 
 namespace starrocks::stream {
@@ -54,6 +57,14 @@ public:
     Status reset_epoch(RuntimeState* state);
 
 private:
+    // Create a state table of |slots| whose first |k_num| slots are the primary keys, |name| is unique in the
+    // AggGroupState.
+    using StateTableFactory = std::function<std::unique_ptr<StateTable>(std::vector<SlotDescriptor*> slots,
+                                                                        size_t k_num, const std::string& name)>;
+
+    Status _prepare_state_tables(RuntimeState* state, const std::vector<AggStateData*>& intermediate_agg_states,
+                                 const std::vector<AggStateData*>& detail_agg_states,
+                                 const StateTableFactory& factory);
     Status _prepare_mem_state_tables(RuntimeState* state, const std::vector<AggStateData*>& intermediate_agg_states,
                                      const std::vector<AggStateData*>& detail_agg_states);
     Status _prepare_imt_state_tables(RuntimeState* state, const std::vector<AggStateData*>& intermediate_agg_states,
@@ -17,8 +17,12 @@
 
 #include "exec/stream/aggregate/agg_state_data.h"
 
+#include <algorithm>
+
 #include "exprs/agg/stream/stream_detail_state.h"
 #include "fmt/format.h"
+#include "util/hash_util.hpp"
+#include "util/phmap/phmap.h"
 
 namespace starrocks::stream {
 
@@ -75,22 +79,58 @@ Status AggStateData::process_chunk(size_t chunk_size, const StreamRowOp* ops,
                                    std::vector<std::vector<const Column*>>& raw_columns,
                                    const Buffer<AggDataPtr>& agg_group_state) const {
     auto* columns = (raw_columns[agg_func_id()]).data();
-    for (int i = 0; i < chunk_size; i++) {
-        auto op = ops[i];
-        switch (op) {
-        case StreamRowOp::OP_INSERT:
-        case StreamRowOp::OP_UPDATE_BEFORE:
-            _agg_function->update(_agg_fn_ctx, columns, agg_group_state[i] + _agg_state_offset, i);
-            break;
-        case StreamRowOp::OP_DELETE:
-        case StreamRowOp::OP_UPDATE_AFTER:
-            _agg_function->retract(_agg_fn_ctx, columns, agg_group_state[i] + _agg_state_offset, i);
-            break;
+    // UPDATE_BEFORE is the row before updated, which is retracted.
+    std::vector<uint8_t> update_filter(chunk_size, 1);
+    std::vector<uint8_t> retract_filter(chunk_size, 1);
+    size_t num_retracts = 0;
+    for (size_t i = 0; i < chunk_size; i++) {
+        if (ops[i] == StreamRowOp::OP_DELETE || ops[i] == StreamRowOp::OP_UPDATE_BEFORE) {
+            retract_filter[i] = 0;
+            num_retracts++;
+        } else {
+            update_filter[i] = 0;
         }
     }
+    if (num_retracts > 0 && num_retracts < chunk_size) {
+        _cancel_retract_pairs(chunk_size, columns[0], agg_group_state, &update_filter, &retract_filter);
+    }
+
+    auto* states = const_cast<AggDataPtr*>(agg_group_state.data());
+    if (num_retracts < chunk_size) {
+        _agg_function->update_batch_selectively(_agg_fn_ctx, chunk_size, _agg_state_offset, columns, states,
+                                                update_filter);
+    }
+    if (num_retracts > 0) {
+        _agg_function->retract_batch_selectively(_agg_fn_ctx, chunk_size, _agg_state_offset, columns, states,
+                                                 retract_filter);
+    }
     return Status::OK();
 }
 
+void AggStateData::_cancel_retract_pairs(size_t chunk_size, const Column* column,
+                                         const Buffer<AggDataPtr>& agg_group_state,
+                                         std::vector<uint8_t>* update_filter,
+                                         std::vector<uint8_t>* retract_filter) const {
+    std::vector<uint32_t> hashes(chunk_size, HashUtil::FNV_SEED);
+    column->fnv_hash(hashes.data(), 0, chunk_size);
+    // The rows not cancelled yet of the same group and the same hash of the value.
+    phmap::flat_hash_map<std::pair<AggDataPtr, uint32_t>, std::vector<uint32_t>> pending_rows;
+    for (uint32_t i = 0; i < chunk_size; i++) {
+        bool is_retract = (*retract_filter)[i] == 0;
+        auto& rows = pending_rows[{agg_group_state[i], hashes[i]}];
+        auto iter = std::find_if(rows.begin(), rows.end(), [&](uint32_t j) {
+            return ((*retract_filter)[j] == 0) != is_retract && column->equals(j, *column, i);
+        });
+        if (iter == rows.end()) {
+            rows.emplace_back(i);
+            continue;
+        }
+        (*update_filter)[i] = (*update_filter)[*iter] = 1;
+        (*retract_filter)[i] = (*retract_filter)[*iter] = 1;
+        rows.erase(iter);
+    }
+}
+
 Status AggStateData::output_result(size_t chunk_size, const Columns& group_by_columns,
                                    const Buffer<AggDataPtr>& agg_group_data, const StateTable* detail_state_table,
                                    Column* to) const {
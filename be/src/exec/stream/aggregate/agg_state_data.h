@@ -62,6 +62,9 @@ public:
     Status allocate_detail_state(size_t chunk_size, const Column* raw_column, const StateTableResult* state_result,
                                  const Buffer<AggGroupStatePtr>& agg_group_state) const;
 
+    // Update the states by the rows of the chunk in batch: all the added rows in one batch, then all the
+    // retracted rows in another batch, and the pairs of the added and retracted rows cancelling each other are
+    // skipped.
     Status process_chunk(size_t chunk_size, const StreamRowOp* ops,
                          std::vector<std::vector<const Column*>>& raw_columns,
                          const Buffer<AggDataPtr>& agg_group_state) const;
@@ -93,6 +96,12 @@ public:
     }
 
 protected:
+    // Skip the pairs of the added and retracted rows of the same value in the same group, they don't change the
+    // state, but retracting the result of min/max may restore all the details of the group.
+    // filter[i] = 0 means the row is processed.
+    void _cancel_retract_pairs(size_t chunk_size, const Column* column, const Buffer<AggDataPtr>& agg_group_state,
+                               std::vector<uint8_t>* update_filter, std::vector<uint8_t>* retract_filter) const;
+
     const AggregateFunction* _agg_function;
     FunctionContext* _agg_fn_ctx;
     const AggFunctionTypes& _agg_fn_type;
@@ -51,8 +51,10 @@ Status StreamAggregateOperator::set_epoch_finishing(RuntimeState* state) {
 Status StreamAggregateOperator::set_epoch_finished(RuntimeState* state) {
     // TODO:  async flush state
     // ATTENTION:
-    // 1. reset state to reduce memory usage.
-    // 2. reset state will change `_aggregator->is_ht_eos()`
+    // 1. checkpoint the state tables of the epoch.
+    // 2. reset state to reduce memory usage.
+    // 3. reset state will change `_aggregator->is_ht_eos()`
+    RETURN_IF_ERROR(_aggregator->commit_epoch(state));
     RETURN_IF_ERROR(_aggregator->reset_state(state));
     return Status::OK();
 }
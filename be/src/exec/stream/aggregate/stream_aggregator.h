@@ -81,6 +81,9 @@ public:
     Status reset_epoch(RuntimeState* state);
 
 private:
+    // The agg states are kept by the state tables.
+    bool _support_columnar_agg_states() const override { return false; }
+
     Status _prepare_state_tables(RuntimeState* state);
 
     // Output intermediate(same to OLAP's agg_state) chunks.
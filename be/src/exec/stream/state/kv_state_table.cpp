@@ -0,0 +1,334 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/stream/state/kv_state_table.h"
+
+#include <rocksdb/db.h>
+#include <rocksdb/write_batch.h>
+
+#include "column/const_column.h"
+#include "column/nullable_column.h"
+#include "exec/pipeline/query_context.h"
+#include "fs/fs_util.h"
+#include "storage/rocksdb_status_adapter.h"
+
+namespace starrocks::stream {
+namespace {
+
+// The keys of the rows start with kDataPrefix, so they are not mixed with the meta keys.
+constexpr char kDataPrefix = 'd';
+const std::string kEpochIdKey = "m_epoch_id";
+
+// NOTE: The chunk is output at once.
+class ChunkRowsIterator final : public ChunkIterator {
+public:
+    ChunkRowsIterator(Schema schema, ChunkPtr chunk)
+            : ChunkIterator(std::move(schema), chunk->num_rows()), _chunk(std::move(chunk)) {}
+    void close() override {}
+
+protected:
+    Status do_get_next(Chunk* chunk) override {
+        if (_chunk == nullptr) {
+            return Status::EndOfFile("end of chunk rows iterator");
+        }
+        chunk->append(*_chunk);
+        _chunk.reset();
+        return Status::OK();
+    }
+    Status do_get_next(Chunk* chunk, vector<uint32_t>* rowid) override {
+        return Status::EndOfFile("end of chunk rows iterator");
+    }
+
+private:
+    ChunkPtr _chunk;
+};
+
+Schema make_schema_from_slots(const std::vector<SlotDescriptor*>& slots) {
+    Fields fields;
+    for (auto& slot : slots) {
+        auto field = std::make_shared<Field>(slot->id(), slot->col_name(), slot->type().type, slot->is_nullable());
+        fields.emplace_back(std::move(field));
+    }
+    return Schema(std::move(fields), KeysType::PRIMARY_KEYS, {});
+}
+
+// The same as the format of NullableColumn::serialize if |nullable|, whatever the nullability of |column| is.
+void encode_datum(const Column* column, size_t row, bool nullable, std::string* buf) {
+    if (column->is_constant()) {
+        column = down_cast<const ConstColumn*>(column)->data_column().get();
+        row = 0;
+    }
+    if (column->is_nullable()) {
+        const auto* nullable_column = down_cast<const NullableColumn*>(column);
+        bool is_null = nullable_column->is_null(row);
+        DCHECK(nullable || !is_null);
+        if (nullable) {
+            buf->push_back(static_cast<char>(is_null));
+        }
+        if (is_null) {
+            return;
+        }
+        column = nullable_column->data_column().get();
+    } else if (nullable) {
+        buf->push_back(static_cast<char>(false));
+    }
+    size_t offset = buf->size();
+    buf->resize(offset + column->serialize_size(row));
+    const_cast<Column*>(column)->serialize(row, reinterpret_cast<uint8_t*>(buf->data() + offset));
+}
+
+int64_t current_epoch_id(RuntimeState* state) {
+    if (state->query_ctx() == nullptr || state->query_ctx()->stream_epoch_manager() == nullptr) {
+        return -1;
+    }
+    return state->query_ctx()->stream_epoch_manager()->epoch_info().epoch_id;
+}
+
+} // namespace
+
+KVStateTable::KVStateTable(std::vector<SlotDescriptor*> slots, size_t k_num, std::string path)
+        : _slots(std::move(slots)), _k_num(k_num), _cols_num(_slots.size()), _path(std::move(path)) {
+    _v_schema = make_schema_from_slots(std::vector<SlotDescriptor*>{_slots.begin() + _k_num, _slots.end()});
+}
+
+KVStateTable::~KVStateTable() = default;
+
+Status KVStateTable::prepare(RuntimeState* state) {
+    return Status::OK();
+}
+
+Status KVStateTable::open(RuntimeState* state) {
+    RETURN_IF_ERROR(fs::create_directories(_path));
+    rocksdb::Options options;
+    options.create_if_missing = true;
+    rocksdb::DB* db = nullptr;
+    rocksdb::Status st = rocksdb::DB::Open(options, _path, &db);
+    if (!st.ok()) {
+        LOG(WARNING) << "failed to open the state table, path=" << _path << ", error=" << st.ToString();
+        return to_status(st);
+    }
+    _db.reset(db);
+
+    std::string epoch_id;
+    st = _db->Get(rocksdb::ReadOptions(), kEpochIdKey, &epoch_id);
+    if (st.ok()) {
+        _committed_epoch_id = std::stoll(epoch_id);
+        LOG(INFO) << "recover the state table from the epoch " << _committed_epoch_id << ", path=" << _path;
+    } else if (!st.IsNotFound()) {
+        return to_status(st);
+    }
+    return Status::OK();
+}
+
+void KVStateTable::_encode_key(const Columns& columns, size_t row, std::string* key) const {
+    DCHECK_LE(columns.size(), _k_num);
+    key->push_back(kDataPrefix);
+    for (size_t i = 0; i < columns.size(); i++) {
+        encode_datum(columns[i].get(), row, _slots[i]->is_nullable(), key);
+    }
+}
+
+Status KVStateTable::_decode(const Slice& data, Columns& columns, size_t from, size_t to) {
+    const auto* pos = reinterpret_cast<const uint8_t*>(data.data);
+    const auto* end = pos + data.size;
+    for (size_t i = from; i < to; i++) {
+        pos = columns[i]->deserialize_and_append(pos);
+    }
+    if (pos != end) {
+        return Status::Corruption("the row of the state table is corrupted");
+    }
+    return Status::OK();
+}
+
+Status KVStateTable::seek(const Columns& keys, StateTableResult& values) const {
+    return _seek(keys, nullptr, values);
+}
+
+Status KVStateTable::seek(const Columns& keys, const std::vector<uint8_t>& selection, StateTableResult& values) const {
+    return _seek(keys, &selection, values);
+}
+
+Status KVStateTable::_seek(const Columns& keys, const std::vector<uint8_t>* selection,
+                           StateTableResult& values) const {
+    DCHECK_EQ(keys.size(), _k_num);
+    auto num_rows = keys[0]->size();
+    DCHECK(selection == nullptr || selection->size() == num_rows);
+
+    // Seek the write buffer first, then seek the other keys from RocksDB in one batch.
+    std::vector<std::string> encoded_keys(num_rows);
+    std::vector<const std::string*> row_values(num_rows, nullptr);
+    std::vector<rocksdb::Slice> db_keys;
+    std::vector<size_t> db_rows;
+    for (size_t i = 0; i < num_rows; i++) {
+        if (selection != nullptr && !(*selection)[i]) {
+            continue;
+        }
+        _encode_key(keys, i, &encoded_keys[i]);
+        if (auto iter = _write_buffer.find(encoded_keys[i]); iter != _write_buffer.end()) {
+            if (iter->second.has_value()) {
+                row_values[i] = &iter->second.value();
+            }
+            continue;
+        }
+        db_keys.emplace_back(encoded_keys[i]);
+        db_rows.emplace_back(i);
+    }
+    std::vector<std::string> db_values;
+    if (!db_keys.empty()) {
+        auto statuses = _db->MultiGet(rocksdb::ReadOptions(), db_keys, &db_values);
+        for (size_t j = 0; j < statuses.size(); j++) {
+            if (statuses[j].ok()) {
+                row_values[db_rows[j]] = &db_values[j];
+            } else if (!statuses[j].IsNotFound()) {
+                return to_status(statuses[j]);
+            }
+        }
+    }
+
+    auto& found = values.found;
+    auto& result_chunk = values.result_chunk;
+    found.assign(num_rows, false);
+    result_chunk = ChunkHelper::new_chunk(_v_schema, num_rows);
+    for (size_t i = 0; i < num_rows; i++) {
+        if (row_values[i] != nullptr) {
+            found[i] = true;
+            RETURN_IF_ERROR(_decode(*row_values[i], result_chunk->columns(), 0, result_chunk->num_columns()));
+        }
+    }
+    return Status::OK();
+}
+
+Status KVStateTable::seek(const Columns& keys, const std::vector<std::string>& projection_columns,
+                          StateTableResult& values) const {
+    return Status::NotSupported("Seek with projection columns is not supported yet.");
+}
+
+ChunkIteratorPtrOr KVStateTable::prefix_scan(const Columns& keys, size_t row_idx) const {
+    DCHECK_LE(keys.size(), _k_num);
+    std::string prefix;
+    _encode_key(keys, row_idx, &prefix);
+
+    // output the extra key columns + value columns
+    auto schema = make_schema_from_slots(std::vector<SlotDescriptor*>{_slots.begin() + keys.size(), _slots.end()});
+    ChunkPtr chunk = ChunkHelper::new_chunk(schema, 0);
+    const size_t num_extra_keys = _k_num - keys.size();
+    auto append_row = [&](const Slice& key, const Slice& value) {
+        RETURN_IF_ERROR(_decode(Slice(key.data + prefix.size(), key.size - prefix.size()), chunk->columns(), 0,
+                                num_extra_keys));
+        return _decode(value, chunk->columns(), num_extra_keys, chunk->num_columns());
+    };
+
+    std::unique_ptr<rocksdb::Iterator> iter(_db->NewIterator(rocksdb::ReadOptions()));
+    for (iter->Seek(prefix); iter->Valid() && iter->key().starts_with(prefix); iter->Next()) {
+        // the rows in the write buffer are newer.
+        if (_write_buffer.count(iter->key().ToString()) > 0) {
+            continue;
+        }
+        RETURN_IF_ERROR(append_row(Slice(iter->key().data(), iter->key().size()),
+                                   Slice(iter->value().data(), iter->value().size())));
+    }
+    RETURN_IF_ERROR(to_status(iter->status()));
+    for (auto it = _write_buffer.lower_bound(prefix); it != _write_buffer.end(); ++it) {
+        if (it->first.compare(0, prefix.size(), prefix) != 0) {
+            break;
+        }
+        if (it->second.has_value()) {
+            RETURN_IF_ERROR(append_row(it->first, it->second.value()));
+        }
+    }
+
+    if (chunk->num_rows() == 0) {
+        return Status::EndOfFile("");
+    }
+    return std::make_shared<ChunkRowsIterator>(std::move(schema), std::move(chunk));
+}
+
+ChunkIteratorPtrOr KVStateTable::prefix_scan(const std::vector<std::string>& projection_columns, const Columns& keys,
+                                             size_t row_idx) const {
+    return Status::NotSupported("PrefixScan with projection columns is not supported yet.");
+}
+
+void KVStateTable::_put(std::string&& key, std::optional<std::string>&& value) {
+    auto [iter, inserted] = _write_buffer.try_emplace(std::move(key));
+    if (inserted) {
+        _write_buffer_bytes += iter->first.size();
+    } else if (iter->second.has_value()) {
+        _write_buffer_bytes -= iter->second->size();
+    }
+    if (value.has_value()) {
+        _write_buffer_bytes += value->size();
+    }
+    iter->second = std::move(value);
+}
+
+Status KVStateTable::write(RuntimeState* state, const StreamChunkPtr& chunk) {
+    DCHECK(chunk);
+    auto chunk_size = chunk->num_rows();
+    const StreamRowOp* ops = StreamChunkConverter::has_ops_column(chunk) ? StreamChunkConverter::ops(chunk) : nullptr;
+    const auto& columns = chunk->columns();
+    DCHECK_EQ(columns.size(), _cols_num);
+    Columns key_columns(columns.begin(), columns.begin() + _k_num);
+    for (size_t i = 0; i < chunk_size; i++) {
+        if (ops != nullptr && ops[i] == StreamRowOp::OP_UPDATE_BEFORE) {
+            continue;
+        }
+        std::string key;
+        _encode_key(key_columns, i, &key);
+        if (ops != nullptr && ops[i] == StreamRowOp::OP_DELETE) {
+            _put(std::move(key), std::nullopt);
+            continue;
+        }
+        std::string value;
+        for (size_t j = _k_num; j < _cols_num; j++) {
+            encode_datum(columns[j].get(), i, _slots[j]->is_nullable(), &value);
+        }
+        _put(std::move(key), std::move(value));
+    }
+    return Status::OK();
+}
+
+Status KVStateTable::commit(RuntimeState* state) {
+    int64_t epoch_id = current_epoch_id(state);
+    rocksdb::WriteBatch batch;
+    for (auto& [key, value] : _write_buffer) {
+        if (value.has_value()) {
+            batch.Put(key, value.value());
+        } else {
+            batch.Delete(key);
+        }
+    }
+    if (epoch_id >= 0) {
+        batch.Put(kEpochIdKey, std::to_string(epoch_id));
+    }
+    if (batch.Count() == 0) {
+        return Status::OK();
+    }
+    rocksdb::WriteOptions options;
+    options.sync = true;
+    RETURN_IF_ERROR(to_status(_db->Write(options, &batch)));
+    _write_buffer.clear();
+    _write_buffer_bytes = 0;
+    if (epoch_id >= 0) {
+        _committed_epoch_id = epoch_id;
+    }
+    return Status::OK();
+}
+
+Status KVStateTable::reset_epoch(RuntimeState* state) {
+    _write_buffer.clear();
+    _write_buffer_bytes = 0;
+    return Status::OK();
+}
+
+} // namespace starrocks::stream
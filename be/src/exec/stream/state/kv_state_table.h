@@ -0,0 +1,89 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <optional>
+#include <string>
+
+#include "column/schema.h"
+#include "exec/stream/state/state_table.h"
+#include "runtime/descriptors.h"
+
+namespace rocksdb {
+class DB;
+} // namespace rocksdb
+
+namespace starrocks::stream {
+
+// `KVStateTable` keeps the state in a RocksDB instance on the local disk, so the state is not limited by the memory.
+//
+// The rows are encoded column by column: a nullable column is encoded as a null flag followed by the value, and a
+// value is encoded by `Column::serialize`, so the encoded prefix of the primary keys is the prefix of the encoded
+// primary keys, and a prefix scan is a range scan in RocksDB.
+// The rows written in an epoch are kept in a write buffer, and written into RocksDB atomically along with the epoch
+// id of `StreamEpochManager` when the epoch is committed, so the state table always recovers from the last committed
+// epoch. The keys of a chunk are seeked from the write buffer and RocksDB in one batch.
+class KVStateTable final : public StateTable {
+public:
+    // The columns of the flushed chunks are assigned as: _k_num | _v_num, |path| is the directory of RocksDB.
+    KVStateTable(std::vector<SlotDescriptor*> slots, size_t k_num, std::string path);
+    ~KVStateTable() override;
+
+    Status prepare(RuntimeState* state) override;
+    Status open(RuntimeState* state) override;
+
+    Status seek(const Columns& keys, StateTableResult& values) const override;
+    Status seek(const Columns& keys, const std::vector<uint8_t>& selection, StateTableResult& values) const override;
+
+    Status seek(const Columns& keys, const std::vector<std::string>& projection_columns,
+                StateTableResult& values) const override;
+    ChunkIteratorPtrOr prefix_scan(const Columns& keys, size_t row_idx) const override;
+    ChunkIteratorPtrOr prefix_scan(const std::vector<std::string>& projection_columns, const Columns& keys,
+                                   size_t row_idx) const override;
+
+    Status write(RuntimeState* state, const StreamChunkPtr& chunk) override;
+    // Persist the rows written since the last commit.
+    Status commit(RuntimeState* state) override;
+    // Discard the rows written since the last commit.
+    Status reset_epoch(RuntimeState* state) override;
+
+    // The id of the last committed epoch, -1 if no epoch is committed.
+    int64_t committed_epoch_id() const { return _committed_epoch_id; }
+    size_t write_buffer_bytes() const { return _write_buffer_bytes; }
+
+private:
+    Status _seek(const Columns& keys, const std::vector<uint8_t>* selection, StateTableResult& values) const;
+    // Encode the |row|-th row of |columns| which are the first columns of the primary keys.
+    void _encode_key(const Columns& columns, size_t row, std::string* key) const;
+    // Decode all the bytes of |data| into the columns [from, to) of |columns|.
+    static Status _decode(const Slice& data, Columns& columns, size_t from, size_t to);
+    void _put(std::string&& key, std::optional<std::string>&& value);
+
+    std::vector<SlotDescriptor*> _slots;
+    const size_t _k_num;
+    const size_t _cols_num;
+    const std::string _path;
+    // value's schema
+    Schema _v_schema;
+
+    std::unique_ptr<rocksdb::DB> _db;
+    int64_t _committed_epoch_id = -1;
+    // The rows written since the last commit, the deleted rows are std::nullopt.
+    std::map<std::string, std::optional<std::string>> _write_buffer;
+    size_t _write_buffer_bytes = 0;
+};
+
+} // namespace starrocks::stream
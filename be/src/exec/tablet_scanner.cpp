@@ -23,6 +23,7 @@
 #include "exec/olap_scan_node.h"
 #include "storage/chunk_helper.h"
 #include "storage/column_predicate_rewriter.h"
+#include "storage/data_dir.h"
 #include "storage/predicate_parser.h"
 #include "storage/projection_iterator.h"
 #include "storage/storage_engine.h"
@@ -138,6 +139,8 @@ Status TabletScanner::_init_reader_params(const std::vector<OlapScanRange*>* key
     // to avoid the unnecessary SerDe and improve query performance
     _params.need_agg_finalize = _need_agg_finalize;
     _params.use_page_cache = !config::disable_storage_page_cache;
+    _params.use_direct_io = runtime_state()->query_options().__isset.enable_scan_direct_io &&
+                            runtime_state()->query_options().enable_scan_direct_io;
     // Improve for select * from table limit x, x is small
     if (_parent->_limit != -1 && _parent->_limit < runtime_state()->chunk_size()) {
         _params.chunk_size = _parent->_limit;
@@ -371,6 +374,12 @@ void TabletScanner::update_counter() {
     StarRocksMetrics::instance()->query_scan_bytes.increment(_compressed_bytes_read);
     StarRocksMetrics::instance()->query_scan_rows.increment(_raw_rows_read);
 
+    if (_tablet->data_dir() != nullptr) {
+        // the io latency of the queries adapts the compaction io budget of the disk
+        _tablet->data_dir()->compaction_io_throttle()->add_query_io(
+                _reader->stats().io_ns, _reader->stats().total_pages_num - _reader->stats().cached_pages_num);
+    }
+
     if (_reader->stats().decode_dict_ns > 0) {
         RuntimeProfile::Counter* c = ADD_TIMER(_parent->_scan_profile, "DictDecode");
         COUNTER_UPDATE(c, _reader->stats().decode_dict_ns);
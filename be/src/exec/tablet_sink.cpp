@@ -34,6 +34,7 @@
 
 #include "exec/tablet_sink.h"
 
+#include <algorithm>
 #include <memory>
 #include <numeric>
 #include <sstream>
@@ -151,6 +152,8 @@ Status NodeChannel::init(RuntimeState* state) {
     }
     RETURN_IF_ERROR(get_block_compression_codec(_compress_type, &_compress_codec));
 
+    _max_parallel_request_size =
+            std::clamp<int64_t>(config::tablet_sink_max_in_flight_requests, 1, config::max_load_dop);
     if (state->query_options().__isset.load_dop) {
         _max_parallel_request_size = state->query_options().load_dop;
         if (_max_parallel_request_size > config::max_load_dop || _max_parallel_request_size < 1) {
@@ -388,6 +391,17 @@ Status NodeChannel::_serialize_chunk(const Chunk* src, ChunkPB* dst) {
     return Status::OK();
 }
 
+bool NodeChannel::_is_cur_chunk_full() const {
+    const size_t num_rows = _cur_chunk->num_rows();
+    if (num_rows < _runtime_state->chunk_size()) {
+        return false;
+    }
+    if (config::tablet_sink_batch_bytes <= 0 || num_rows >= config::tablet_sink_max_batch_rows) {
+        return true;
+    }
+    return _cur_chunk->memory_usage() >= config::tablet_sink_batch_bytes;
+}
+
 bool NodeChannel::is_full() {
     if (_request_queue.size() >= _max_request_queue_size || _mem_tracker->limit()) {
         if (!_check_prev_request_done()) {
@@ -423,7 +437,7 @@ Status NodeChannel::add_chunk(Chunk* input, const std::vector<int64_t>& tablet_i
         req->add_tablet_ids(tablet_ids[indexes[from + i]]);
     }
 
-    if (_cur_chunk->num_rows() < _runtime_state->chunk_size()) {
+    if (!_is_cur_chunk_full()) {
         // 2. chunk not full
         if (_request_queue.empty()) {
             return Status::OK();
@@ -473,7 +487,7 @@ Status NodeChannel::add_chunks(Chunk* input, const std::vector<std::vector<int64
         }
     }
 
-    if (_cur_chunk->num_rows() < _runtime_state->chunk_size()) {
+    if (!_is_cur_chunk_full()) {
         // 2. chunk not full
         if (_request_queue.empty()) {
             return Status::OK();
@@ -156,6 +156,8 @@ private:
     Status _wait_all_prev_request();
     Status _wait_one_prev_request();
     bool _check_prev_request_done();
+    // Whether the rows gathered in _cur_chunk are enough to be sent in one request.
+    bool _is_cur_chunk_full() const;
     bool _check_all_prev_request_done();
     Status _serialize_chunk(const Chunk* src, ChunkPB* dst);
     void _open(int64_t index_id, RefCountClosure<PTabletWriterOpenResult>* open_closure,
@@ -14,7 +14,11 @@
 
 #include "exec/workgroup/scan_executor.h"
 
+#include "common/config.h"
 #include "exec/workgroup/scan_task_queue.h"
+#include "gutil/walltime.h"
+#include "runtime/current_thread.h"
+#include "util/defer_op.h"
 
 namespace starrocks::workgroup {
 
@@ -43,6 +47,8 @@ void ScanExecutor::change_num_threads(int32_t num_threads) {
 }
 
 void ScanExecutor::worker_thread() {
+    bool io_bound = false;
+    DeferOp defer([this, &io_bound]() { _update_io_bound(&io_bound, false); });
     while (true) {
         if (_num_threads_setter.should_shrink()) {
             break;
@@ -52,19 +58,82 @@ void ScanExecutor::worker_thread() {
         if (maybe_task.status().is_cancelled()) {
             return;
         }
-        auto& task = maybe_task.value();
+        _update_io_bound(&io_bound, _run_task(maybe_task.value()));
+    }
+}
+
+void ScanExecutor::elastic_worker_thread() {
+    bool io_bound = false;
+    DeferOp defer([this, &io_bound]() {
+        _update_io_bound(&io_bound, false);
+        _num_elastic_threads--;
+    });
+    // Exit once there is no pending task or the blocked threads have been waked up,
+    // so that the elastic threads never take over the cpu from the normal worker threads.
+    while (!_task_queue->empty() && _num_elastic_threads <= _num_io_bound_threads) {
+        auto maybe_task = _task_queue->take();
+        if (maybe_task.status().is_cancelled()) {
+            return;
+        }
+        _update_io_bound(&io_bound, _run_task(maybe_task.value()));
+    }
+}
+
+bool ScanExecutor::_run_task(ScanTask& task) {
+    int64_t time_spent_ns = 0;
+    int64_t cpu_time_spent_us = GetThreadCpuTimeMicros();
+    {
+        SCOPED_RAW_TIMER(&time_spent_ns);
+        // Account the caches filled by the task to its workgroup.
+        int64_t prev_workgroup_id =
+                CurrentThread::current().set_workgroup_id(task.workgroup != nullptr ? task.workgroup->id() : -1);
+        DeferOp op([prev_workgroup_id] { CurrentThread::current().set_workgroup_id(prev_workgroup_id); });
+        task.work_function();
+    }
+    cpu_time_spent_us = GetThreadCpuTimeMicros() - cpu_time_spent_us;
+    _task_queue->update_statistics(task, time_spent_ns);
+
+    int64_t off_cpu_time_ns = time_spent_ns - cpu_time_spent_us * 1000;
+    return off_cpu_time_ns > 0 && off_cpu_time_ns >= time_spent_ns * config::pipeline_scan_io_bound_task_ratio;
+}
+
+void ScanExecutor::_update_io_bound(bool* curr_io_bound, bool new_io_bound) {
+    if (*curr_io_bound == new_io_bound) {
+        return;
+    }
+    *curr_io_bound = new_io_bound;
+    if (new_io_bound) {
+        _num_io_bound_threads++;
+        _try_start_elastic_thread();
+    } else {
+        _num_io_bound_threads--;
+    }
+}
 
-        int64_t time_spent_ns = 0;
-        {
-            SCOPED_RAW_TIMER(&time_spent_ns);
-            task.work_function();
+void ScanExecutor::_try_start_elastic_thread() {
+    if (_max_elastic_threads <= 0 || _task_queue->empty()) {
+        return;
+    }
+    int32_t num_elastic_threads = _num_elastic_threads.load();
+    do {
+        if (num_elastic_threads >= _max_elastic_threads || num_elastic_threads >= _num_io_bound_threads) {
+            return;
         }
-        _task_queue->update_statistics(task, time_spent_ns);
+    } while (!_num_elastic_threads.compare_exchange_weak(num_elastic_threads, num_elastic_threads + 1));
+
+    if (!_thread_pool->submit_func([this]() { this->elastic_worker_thread(); }).ok()) {
+        _num_elastic_threads--;
     }
 }
 
 bool ScanExecutor::submit(ScanTask task) {
-    return _task_queue->try_offer(std::move(task));
+    if (!_task_queue->try_offer(std::move(task))) {
+        return false;
+    }
+    if (_num_io_bound_threads > 0) {
+        _try_start_elastic_thread();
+    }
+    return true;
 }
 
 } // namespace starrocks::workgroup
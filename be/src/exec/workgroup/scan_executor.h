@@ -33,14 +33,29 @@ public:
 
     bool submit(ScanTask task);
 
+    // Allow to start at most max_elastic_threads extra worker threads, when the worker threads are blocked by IO.
+    void set_max_elastic_threads(int32_t max_elastic_threads) { _max_elastic_threads = max_elastic_threads; }
+    int32_t num_elastic_threads() const { return _num_elastic_threads; }
+    int32_t num_io_bound_threads() const { return _num_io_bound_threads; }
+
 private:
     void worker_thread();
+    void elastic_worker_thread();
+    // Run the task and return whether it is IO-bound.
+    bool _run_task(ScanTask& task);
+    void _update_io_bound(bool* curr_io_bound, bool new_io_bound);
+    void _try_start_elastic_thread();
 
     LimitSetter _num_threads_setter;
     std::unique_ptr<ScanTaskQueue> _task_queue;
     // _thread_pool must be placed after _task_queue, because worker threads in _thread_pool use _task_queue.
     std::unique_ptr<ThreadPool> _thread_pool;
     std::atomic<int> _next_id = 0;
+
+    int32_t _max_elastic_threads = 0;
+    // The number of worker threads whose last task was IO-bound.
+    std::atomic<int32_t> _num_io_bound_threads = 0;
+    std::atomic<int32_t> _num_elastic_threads = 0;
 };
 
 } // namespace starrocks::workgroup
@@ -14,9 +14,12 @@
 
 #include "exec/workgroup/scan_task_queue.h"
 
+#include "common/config.h"
+#include "common/logging.h"
 #include "common/status.h"
 #include "exec/workgroup/work_group.h"
 #include "exec/workgroup/work_group_fwd.h"
+#include "util/starrocks_metrics.h"
 
 namespace starrocks::workgroup {
 
@@ -352,6 +355,104 @@ const workgroup::WorkGroupScanSchedEntity* WorkGroupScanTaskQueue::_sched_entity
     }
 }
 
+/// DiskAwareScanTaskQueue.
+DiskAwareScanTaskQueue::~DiskAwareScanTaskQueue() {
+    for (auto& [_, device_queue] : _device_queues) {
+        StarRocksMetrics::instance()->metrics()->deregister_metric(device_queue->queue_depth.get());
+    }
+}
+
+void DiskAwareScanTaskQueue::close() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _is_closed = true;
+    }
+    _queue->close();
+}
+
+bool DiskAwareScanTaskQueue::try_offer(ScanTask task) {
+    if (task.io_device_id < 0) {
+        return _queue->try_offer(std::move(task));
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_is_closed) {
+        return false;
+    }
+
+    auto* device_queue = _get_or_create_device_queue(task.io_device_id);
+    const int64_t max_in_flight_tasks = _max_in_flight_tasks_per_device();
+    if (max_in_flight_tasks > 0 && device_queue->num_in_flight_tasks >= max_in_flight_tasks) {
+        device_queue->pending_tasks.emplace(std::move(task));
+        _num_pending_tasks++;
+    } else {
+        if (!_queue->try_offer(std::move(task))) {
+            return false;
+        }
+        device_queue->num_in_flight_tasks++;
+    }
+    device_queue->queue_depth->set_value(_queue_depth(*device_queue));
+    return true;
+}
+
+void DiskAwareScanTaskQueue::update_statistics(ScanTask& task, int64_t runtime_ns) {
+    _queue->update_statistics(task, runtime_ns);
+    if (task.io_device_id < 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _device_queues.find(task.io_device_id);
+    if (it == _device_queues.end()) {
+        return;
+    }
+    auto& device_queue = it->second;
+    device_queue->num_in_flight_tasks--;
+
+    // Offer the pending tasks of this device to the underlying queue, since a slot of the device is released.
+    // All of them are offered, if the cap is turned off after they are pended.
+    const int64_t max_in_flight_tasks = _max_in_flight_tasks_per_device();
+    // Keep the pending tasks if the underlying queue is almost full, since a rejected task cannot be taken back.
+    while (!_is_closed && !device_queue->pending_tasks.empty() &&
+           (max_in_flight_tasks <= 0 || device_queue->num_in_flight_tasks < max_in_flight_tasks) &&
+           _queue->size() < config::pipeline_scan_thread_pool_queue_size) {
+        bool offered = _queue->try_offer(std::move(device_queue->pending_tasks.front()));
+        LOG_IF(WARNING, !offered) << "DiskAwareScanTaskQueue failed to offer the pending task of device "
+                                  << task.io_device_id;
+        device_queue->pending_tasks.pop();
+        _num_pending_tasks--;
+        if (offered) {
+            device_queue->num_in_flight_tasks++;
+        }
+    }
+    device_queue->queue_depth->set_value(_queue_depth(*device_queue));
+}
+
+int64_t DiskAwareScanTaskQueue::device_queue_depth(int64_t io_device_id) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _device_queues.find(io_device_id);
+    return it == _device_queues.end() ? 0 : _queue_depth(*it->second);
+}
+
+int64_t DiskAwareScanTaskQueue::_max_in_flight_tasks_per_device() {
+    return config::pipeline_scan_max_in_flight_tasks_per_disk;
+}
+
+DiskAwareScanTaskQueue::DeviceQueue* DiskAwareScanTaskQueue::_get_or_create_device_queue(int64_t io_device_id) {
+    auto it = _device_queues.find(io_device_id);
+    if (it != _device_queues.end()) {
+        return it->second.get();
+    }
+
+    auto device_queue = std::make_unique<DeviceQueue>();
+    device_queue->queue_depth = std::make_unique<IntGauge>(MetricUnit::NOUNIT);
+    StarRocksMetrics::instance()->metrics()->register_metric(
+            "pipe_scan_disk_queue_depth",
+            MetricLabels().add("executor", _name).add("path_hash", std::to_string(io_device_id)),
+            device_queue->queue_depth.get());
+    return _device_queues.emplace(io_device_id, std::move(device_queue)).first->second.get();
+}
+
 std::unique_ptr<ScanTaskQueue> create_scan_task_queue() {
     switch (config::pipeline_scan_queue_mode) {
     case 0:
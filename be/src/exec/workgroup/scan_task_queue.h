@@ -19,11 +19,13 @@
 #include <mutex>
 #include <queue>
 #include <set>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "common/statusor.h"
 #include "exec/workgroup/work_group_fwd.h"
 #include "util/blocking_priority_queue.hpp"
+#include "util/metrics.h"
 #include "util/runtime_profile.h"
 
 namespace starrocks::workgroup {
@@ -60,9 +62,11 @@ public:
     int priority = 0;
     std::shared_ptr<ScanTaskGroup> task_group = nullptr;
     RuntimeProfile::HighWaterMarkCounter* peak_scan_task_queue_size_counter = nullptr;
+    // The IO device (e.g. the path hash of DataDir) which this task reads from, or -1 if it is unknown.
+    int64_t io_device_id = -1;
 };
 
-/// There are three types of ScanTaskQueue:
+/// There are three types of ScanTaskQueue, and DiskAwareScanTaskQueue can be used to wrap any of them:
 /// - WorkGroupScanTaskQueue, which is a two-level queue.
 ///   - The first level selects the workgroup with the shortest execution time.
 ///   - The second level selects an appropriate task using either PriorityScanTaskQueue or MultiLevelFeedScanTaskQueue.
@@ -230,6 +234,55 @@ private:
     std::atomic<size_t> _num_tasks = 0;
 };
 
+// DiskAwareScanTaskQueue wraps another queue to cap the number of in-flight tasks of each IO device.
+// - A task of a device is offered to the underlying queue directly, if the device has less than
+//   pipeline_scan_max_in_flight_tasks_per_disk tasks in flight, that is, queued in the underlying queue or running.
+// - Otherwise, the task is pended in the FIFO queue of its device, and it is offered to the underlying queue
+//   when a task of the same device is finished.
+// Therefore, a hot device cannot occupy all the scan threads, and the tasks of the other devices can be executed.
+class DiskAwareScanTaskQueue final : public ScanTaskQueue {
+public:
+    DiskAwareScanTaskQueue(std::string name, std::unique_ptr<ScanTaskQueue> queue)
+            : _name(std::move(name)), _queue(std::move(queue)) {}
+    ~DiskAwareScanTaskQueue() override;
+
+    void close() override;
+
+    StatusOr<ScanTask> take() override { return _queue->take(); }
+    bool try_offer(ScanTask task) override;
+
+    size_t size() const override { return _queue->size() + _num_pending_tasks.load(std::memory_order_acquire); }
+
+    void update_statistics(ScanTask& task, int64_t runtime_ns) override;
+    bool should_yield(const WorkGroup* wg, int64_t unaccounted_runtime_ns) const override {
+        return _queue->should_yield(wg, unaccounted_runtime_ns);
+    }
+
+    // The number of the in-flight and pending tasks of the device.
+    int64_t device_queue_depth(int64_t io_device_id) const;
+
+private:
+    struct DeviceQueue {
+        int64_t num_in_flight_tasks = 0;
+        std::queue<ScanTask> pending_tasks;
+        std::unique_ptr<IntGauge> queue_depth;
+    };
+
+    static int64_t _max_in_flight_tasks_per_device();
+    DeviceQueue* _get_or_create_device_queue(int64_t io_device_id);
+    static int64_t _queue_depth(const DeviceQueue& device_queue) {
+        return device_queue.num_in_flight_tasks + device_queue.pending_tasks.size();
+    }
+
+    const std::string _name;
+    std::unique_ptr<ScanTaskQueue> _queue;
+
+    mutable std::mutex _mutex;
+    bool _is_closed = false;
+    std::unordered_map<int64_t, std::unique_ptr<DeviceQueue>> _device_queues;
+    std::atomic<size_t> _num_pending_tasks = 0;
+};
+
 std::unique_ptr<ScanTaskQueue> create_scan_task_queue();
 
 } // namespace starrocks::workgroup
@@ -20,6 +20,7 @@
 #include "exec/workgroup/work_group_fwd.h"
 #include "glog/logging.h"
 #include "runtime/exec_env.h"
+#include "storage/page_cache.h"
 #include "util/cpu_info.h"
 #include "util/metrics.h"
 #include "util/starrocks_metrics.h"
@@ -110,6 +111,18 @@ WorkGroup::WorkGroup(const TWorkGroup& twg)
     if (twg.__isset.big_query_cpu_second_limit) {
         _big_query_cpu_nanos_limit = twg.big_query_cpu_second_limit * NANOS_PER_SEC;
     }
+
+    if (twg.__isset.page_cache_reserved_ratio) {
+        _page_cache_reserved_ratio = twg.page_cache_reserved_ratio;
+    }
+
+    if (twg.__isset.page_cache_limit_ratio) {
+        _page_cache_limit_ratio = twg.page_cache_limit_ratio;
+    }
+
+    if (twg.__isset.scan_direct_io) {
+        _scan_direct_io = twg.scan_direct_io;
+    }
 }
 
 TWorkGroup WorkGroup::to_thrift() const {
@@ -134,6 +147,9 @@ TWorkGroup WorkGroup::to_thrift_verbose() const {
     twg.__set_big_query_mem_limit(_big_query_mem_limit);
     twg.__set_big_query_scan_rows_limit(_big_query_scan_rows_limit);
     twg.__set_big_query_cpu_second_limit(big_query_cpu_second_limit());
+    twg.__set_page_cache_reserved_ratio(_page_cache_reserved_ratio);
+    twg.__set_page_cache_limit_ratio(_page_cache_limit_ratio);
+    twg.__set_scan_direct_io(_scan_direct_io);
     return twg;
 }
 
@@ -143,7 +159,8 @@ void WorkGroup::init() {
                                   : ExecEnv::GetInstance()->query_pool_mem_tracker()->limit() * _memory_limit;
     _mem_tracker = std::make_shared<starrocks::MemTracker>(_memory_limit_bytes, _name,
                                                            ExecEnv::GetInstance()->query_pool_mem_tracker());
-    _driver_sched_entity.set_queue(std::make_unique<pipeline::QuerySharedDriverQueue>());
+    _driver_sched_entity.set_queue(
+            std::make_unique<pipeline::QuerySharedDriverQueue>(config::enable_pipeline_wg_short_query_lane));
     _scan_sched_entity.set_queue(workgroup::create_scan_task_queue());
     _connector_scan_sched_entity.set_queue(workgroup::create_scan_task_queue());
 }
@@ -219,6 +236,10 @@ void WorkGroup::copy_metrics(const WorkGroup& rhs) {
     _num_total_queries = rhs.num_total_queries();
     _concurrency_overflow_count = rhs.concurrency_overflow_count();
     _bigquery_count = rhs.bigquery_count();
+    _acc_queue_wait_ns = rhs.acc_queue_wait_ns();
+    _driver_ready_queue_wait_hist.merge(rhs.driver_ready_queue_wait_hist());
+    _num_driver_yield_by_time_limit = rhs.num_driver_yield_by_time_limit();
+    _num_driver_yield_by_preempt = rhs.num_driver_yield_by_preempt();
 }
 
 /// WorkGroupManager.
@@ -307,6 +328,54 @@ void WorkGroupManager::add_metrics_unlocked(const WorkGroupPtr& wg, UniqueLockTy
                 "resource_group_bigquery_count", MetricLabels().add("name", wg->name()),
                 resource_group_bigquery_count.get());
 
+        // queued queries of query admission
+        auto resource_group_queued_queries = std::make_unique<IntGauge>(MetricUnit::NOUNIT);
+        bool queued_registered = StarRocksMetrics::instance()->metrics()->register_metric(
+                "resource_group_queued_queries", MetricLabels().add("name", wg->name()),
+                resource_group_queued_queries.get());
+
+        // accumulated wait time of query admission
+        auto resource_group_queue_wait_ns = std::make_unique<IntGauge>(MetricUnit::NANOSECONDS);
+        bool queue_wait_registered = StarRocksMetrics::instance()->metrics()->register_metric(
+                "resource_group_queue_wait_ns", MetricLabels().add("name", wg->name()),
+                resource_group_queue_wait_ns.get());
+
+        // histogram of the time drivers wait in the ready queue, one gauge per bucket
+        std::vector<std::unique_ptr<IntGauge>> resource_group_driver_ready_queue_wait;
+        bool ready_queue_wait_registered = false;
+        for (size_t i = 0; i < LatencyHistogram::NUM_BUCKETS; ++i) {
+            auto& bucket_gauge = resource_group_driver_ready_queue_wait.emplace_back(
+                    std::make_unique<IntGauge>(MetricUnit::NOUNIT));
+            ready_queue_wait_registered |= StarRocksMetrics::instance()->metrics()->register_metric(
+                    "resource_group_driver_ready_queue_wait_bucket",
+                    MetricLabels().add("name", wg->name()).add("le", LatencyHistogram::bucket_name(i)),
+                    bucket_gauge.get());
+        }
+
+        // yield causes of drivers
+        auto resource_group_driver_yield_by_time_limit = std::make_unique<IntGauge>(MetricUnit::NOUNIT);
+        bool yield_by_time_limit_registered = StarRocksMetrics::instance()->metrics()->register_metric(
+                "resource_group_driver_yield_by_time_limit", MetricLabels().add("name", wg->name()),
+                resource_group_driver_yield_by_time_limit.get());
+        auto resource_group_driver_yield_by_preempt = std::make_unique<IntGauge>(MetricUnit::NOUNIT);
+        bool yield_by_preempt_registered = StarRocksMetrics::instance()->metrics()->register_metric(
+                "resource_group_driver_yield_by_preempt", MetricLabels().add("name", wg->name()),
+                resource_group_driver_yield_by_preempt.get());
+
+        // page cache usage and hit of the pages read by the workgroup
+        auto resource_group_page_cache_usage_bytes = std::make_unique<IntGauge>(MetricUnit::BYTES);
+        bool page_cache_usage_registered = StarRocksMetrics::instance()->metrics()->register_metric(
+                "resource_group_page_cache_usage_bytes", MetricLabels().add("name", wg->name()),
+                resource_group_page_cache_usage_bytes.get());
+        auto resource_group_page_cache_lookup_count = std::make_unique<IntGauge>(MetricUnit::OPERATIONS);
+        bool page_cache_lookup_registered = StarRocksMetrics::instance()->metrics()->register_metric(
+                "resource_group_page_cache_lookup_count", MetricLabels().add("name", wg->name()),
+                resource_group_page_cache_lookup_count.get());
+        auto resource_group_page_cache_hit_count = std::make_unique<IntGauge>(MetricUnit::OPERATIONS);
+        bool page_cache_hit_registered = StarRocksMetrics::instance()->metrics()->register_metric(
+                "resource_group_page_cache_hit_count", MetricLabels().add("name", wg->name()),
+                resource_group_page_cache_hit_count.get());
+
         unique_lock.lock();
         if (cpu_limit_registered) _wg_cpu_limit_metrics.emplace(wg->name(), std::move(resource_group_cpu_limit_ratio));
         if (cpu_ratio_registered) _wg_cpu_metrics.emplace(wg->name(), std::move(resource_group_cpu_use_ratio));
@@ -320,6 +389,20 @@ void WorkGroupManager::add_metrics_unlocked(const WorkGroupPtr& wg, UniqueLockTy
         if (concurrency_registered)
             _wg_concurrency_overflow_count.emplace(wg->name(), std::move(resource_group_concurrency_overflow));
         if (bigquery_registered) _wg_bigquery_count.emplace(wg->name(), std::move(resource_group_bigquery_count));
+        if (queued_registered) _wg_queued_queries.emplace(wg->name(), std::move(resource_group_queued_queries));
+        if (queue_wait_registered) _wg_queue_wait_ns.emplace(wg->name(), std::move(resource_group_queue_wait_ns));
+        if (ready_queue_wait_registered)
+            _wg_driver_ready_queue_wait.emplace(wg->name(), std::move(resource_group_driver_ready_queue_wait));
+        if (yield_by_time_limit_registered)
+            _wg_driver_yield_by_time_limit.emplace(wg->name(), std::move(resource_group_driver_yield_by_time_limit));
+        if (yield_by_preempt_registered)
+            _wg_driver_yield_by_preempt.emplace(wg->name(), std::move(resource_group_driver_yield_by_preempt));
+        if (page_cache_usage_registered)
+            _wg_page_cache_usage_bytes.emplace(wg->name(), std::move(resource_group_page_cache_usage_bytes));
+        if (page_cache_lookup_registered)
+            _wg_page_cache_lookup_count.emplace(wg->name(), std::move(resource_group_page_cache_lookup_count));
+        if (page_cache_hit_registered)
+            _wg_page_cache_hit_count.emplace(wg->name(), std::move(resource_group_page_cache_hit_count));
     }
     _wg_metrics[wg->name()] = wg->unique_id();
 }
@@ -374,6 +457,22 @@ void WorkGroupManager::update_metrics_unlocked() {
             _wg_total_queries[name]->set_value(wg->num_total_queries());
             _wg_concurrency_overflow_count[name]->set_value(wg->concurrency_overflow_count());
             _wg_bigquery_count[name]->set_value(wg->bigquery_count());
+            _wg_queued_queries[name]->set_value(wg->num_queued_queries());
+            _wg_queue_wait_ns[name]->set_value(wg->acc_queue_wait_ns());
+            const auto& ready_queue_wait_hist = wg->driver_ready_queue_wait_hist();
+            auto& ready_queue_wait_gauges = _wg_driver_ready_queue_wait[name];
+            for (size_t i = 0; i < ready_queue_wait_gauges.size(); ++i) {
+                ready_queue_wait_gauges[i]->set_value(ready_queue_wait_hist.count(i));
+            }
+            _wg_driver_yield_by_time_limit[name]->set_value(wg->num_driver_yield_by_time_limit());
+            _wg_driver_yield_by_preempt[name]->set_value(wg->num_driver_yield_by_preempt());
+            auto* page_cache = StoragePageCache::instance();
+            if (page_cache != nullptr) {
+                auto page_cache_stats = page_cache->get_workgroup_stats(wg->id());
+                _wg_page_cache_usage_bytes[name]->set_value(page_cache_stats.usage);
+                _wg_page_cache_lookup_count[name]->set_value(page_cache_stats.lookup_count);
+                _wg_page_cache_hit_count[name]->set_value(page_cache_stats.hit_count);
+            }
         } else {
             VLOG(2) << "workgroup update_metrics " << name << ", workgroup not exists so cleanup metrics";
 
@@ -387,6 +486,16 @@ void WorkGroupManager::update_metrics_unlocked() {
             _wg_total_queries[name]->set_value(0);
             _wg_concurrency_overflow_count[name]->set_value(0);
             _wg_bigquery_count[name]->set_value(0);
+            _wg_queued_queries[name]->set_value(0);
+            _wg_queue_wait_ns[name]->set_value(0);
+            for (auto& bucket_gauge : _wg_driver_ready_queue_wait[name]) {
+                bucket_gauge->set_value(0);
+            }
+            _wg_driver_yield_by_time_limit[name]->set_value(0);
+            _wg_driver_yield_by_preempt[name]->set_value(0);
+            _wg_page_cache_usage_bytes[name]->set_value(0);
+            _wg_page_cache_lookup_count[name]->set_value(0);
+            _wg_page_cache_hit_count[name]->set_value(0);
         }
     }
 }
@@ -470,6 +579,10 @@ void WorkGroupManager::create_workgroup_unlocked(const WorkGroupPtr& wg, UniqueL
     // install new version
     _workgroup_versions[wg->id()] = wg->version();
 
+    if (auto* page_cache = StoragePageCache::instance(); page_cache != nullptr) {
+        page_cache->set_workgroup_quota(wg->id(), wg->page_cache_reserved_ratio(), wg->page_cache_limit_ratio());
+    }
+
     // Update metrics
     add_metrics_unlocked(wg, unique_lock);
 }
@@ -501,6 +614,9 @@ void WorkGroupManager::delete_workgroup_unlocked(const WorkGroupPtr& wg) {
         _workgroup_expired_versions.push_back(unique_id);
         LOG(INFO) << "workgroup expired version: " << wg->name() << "(" << wg->id() << "," << curr_version << ")";
     }
+    if (auto* page_cache = StoragePageCache::instance(); page_cache != nullptr) {
+        page_cache->set_workgroup_quota(id, 0, 0);
+    }
     LOG(INFO) << "delete workgroup " << wg->name();
 }
 
@@ -25,6 +25,7 @@
 #include "runtime/mem_tracker.h"
 #include "storage/olap_define.h"
 #include "util/blocking_queue.hpp"
+#include "util/latency_histogram.h"
 #include "util/metrics.h"
 #include "util/priority_thread_pool.hpp"
 #include "util/starrocks_metrics.h"
@@ -186,6 +187,21 @@ public:
     int64_t num_total_queries() const { return _num_total_queries; }
     int64_t concurrency_overflow_count() const { return _concurrency_overflow_count; }
     int64_t bigquery_count() const { return _bigquery_count; }
+    void incr_num_queued_queries() { _num_queued_queries++; }
+    void decr_num_queued_queries(int64_t wait_ns) {
+        _num_queued_queries--;
+        _acc_queue_wait_ns += wait_ns;
+    }
+    int64_t num_queued_queries() const { return _num_queued_queries; }
+    int64_t acc_queue_wait_ns() const { return _acc_queue_wait_ns; }
+
+    // The time drivers of this workgroup wait in the ready queue before being scheduled.
+    void add_driver_ready_queue_wait_ns(int64_t wait_ns) { _driver_ready_queue_wait_hist.add(wait_ns); }
+    const LatencyHistogram& driver_ready_queue_wait_hist() const { return _driver_ready_queue_wait_hist; }
+    void incr_driver_yield_by_time_limit() { _num_driver_yield_by_time_limit++; }
+    void incr_driver_yield_by_preempt() { _num_driver_yield_by_preempt++; }
+    int64_t num_driver_yield_by_time_limit() const { return _num_driver_yield_by_time_limit; }
+    int64_t num_driver_yield_by_preempt() const { return _num_driver_yield_by_preempt; }
 
     int64_t big_query_mem_limit() const { return _big_query_mem_limit; }
     bool use_big_query_mem_limit() const {
@@ -194,6 +210,13 @@ public:
     int64_t big_query_cpu_second_limit() const { return _big_query_cpu_nanos_limit / NANOS_PER_SEC; }
     int64_t big_query_scan_rows_limit() const { return _big_query_scan_rows_limit; }
 
+    // The ratios of the page cache capacity reserved for and limited to this workgroup, 0 means no quota.
+    double page_cache_reserved_ratio() const { return _page_cache_reserved_ratio; }
+    double page_cache_limit_ratio() const { return _page_cache_limit_ratio; }
+
+    // Whether the scans of this workgroup read the segment data with O_DIRECT.
+    bool scan_direct_io() const { return _scan_direct_io; }
+
     static constexpr int64 DEFAULT_WG_ID = 0;
     static constexpr int64 DEFAULT_VERSION = 0;
 
@@ -214,6 +237,9 @@ private:
     int64_t _big_query_mem_limit = 0;
     int64_t _big_query_scan_rows_limit = 0;
     int64_t _big_query_cpu_nanos_limit = 0;
+    double _page_cache_reserved_ratio = 0;
+    double _page_cache_limit_ratio = 0;
+    bool _scan_direct_io = false;
 
     std::shared_ptr<starrocks::MemTracker> _mem_tracker = nullptr;
 
@@ -232,6 +258,11 @@ private:
     std::atomic<int64_t> _num_total_queries = 0;
     std::atomic<int64_t> _concurrency_overflow_count = 0;
     std::atomic<int64_t> _bigquery_count = 0;
+    std::atomic<int64_t> _num_queued_queries = 0;
+    std::atomic<int64_t> _acc_queue_wait_ns = 0;
+    LatencyHistogram _driver_ready_queue_wait_hist;
+    std::atomic<int64_t> _num_driver_yield_by_time_limit = 0;
+    std::atomic<int64_t> _num_driver_yield_by_preempt = 0;
 };
 
 // WorkGroupManager is a singleton used to manage WorkGroup instances in BE, it has an io queue and a cpu queues for
@@ -294,6 +325,14 @@ private:
     std::unordered_map<std::string, std::unique_ptr<starrocks::IntGauge>> _wg_total_queries;
     std::unordered_map<std::string, std::unique_ptr<starrocks::IntGauge>> _wg_concurrency_overflow_count;
     std::unordered_map<std::string, std::unique_ptr<starrocks::IntGauge>> _wg_bigquery_count;
+    std::unordered_map<std::string, std::unique_ptr<starrocks::IntGauge>> _wg_queued_queries;
+    std::unordered_map<std::string, std::unique_ptr<starrocks::IntGauge>> _wg_queue_wait_ns;
+    std::unordered_map<std::string, std::vector<std::unique_ptr<starrocks::IntGauge>>> _wg_driver_ready_queue_wait;
+    std::unordered_map<std::string, std::unique_ptr<starrocks::IntGauge>> _wg_driver_yield_by_time_limit;
+    std::unordered_map<std::string, std::unique_ptr<starrocks::IntGauge>> _wg_driver_yield_by_preempt;
+    std::unordered_map<std::string, std::unique_ptr<starrocks::IntGauge>> _wg_page_cache_usage_bytes;
+    std::unordered_map<std::string, std::unique_ptr<starrocks::IntGauge>> _wg_page_cache_lookup_count;
+    std::unordered_map<std::string, std::unique_ptr<starrocks::IntGauge>> _wg_page_cache_hit_count;
 };
 
 class DefaultWorkGroupInitialization {
@@ -217,6 +217,17 @@ public:
         throw std::runtime_error("retract function in aggregate is not supported for now.");
     }
 
+    // The batch api of `retract`, filter[i] = 0, will be retracted.
+    virtual void retract_batch_selectively(FunctionContext* ctx, size_t chunk_size, size_t state_offset,
+                                           const Column** columns, AggDataPtr* states,
+                                           const std::vector<uint8_t>& filter) const {
+        for (size_t i = 0; i < chunk_size; i++) {
+            if (filter[i] == 0) {
+                retract(ctx, columns, states[i] + state_offset, i);
+            }
+        }
+    }
+
     // NOTE: Below Methods for agg functions of Detail_Result/Detail_Intermediate kind,
     // other kinds no need to implement.
 
@@ -352,6 +363,16 @@ public:
         }
     }
 
+    void retract_batch_selectively(FunctionContext* ctx, size_t chunk_size, size_t state_offset,
+                                   const Column** columns, AggDataPtr* states,
+                                   const std::vector<uint8_t>& filter) const override {
+        for (size_t i = 0; i < chunk_size; i++) {
+            if (filter[i] == 0) {
+                static_cast<const Derived*>(this)->retract(ctx, columns, states[i] + state_offset, i);
+            }
+        }
+    }
+
     void merge_batch(FunctionContext* ctx, size_t chunk_size, size_t state_offset, const Column* column,
                      AggDataPtr* states) const override {
         for (size_t i = 0; i < chunk_size; ++i) {
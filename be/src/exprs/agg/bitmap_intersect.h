@@ -52,6 +52,16 @@ public:
         }
     }
 
+    void update_batch_single_state(FunctionContext* ctx, size_t chunk_size, const Column** columns,
+                                   AggDataPtr __restrict state) const override {
+        _fast_intersect(columns[0], 0, chunk_size, state);
+    }
+
+    void merge_batch_single_state(FunctionContext* ctx, AggDataPtr __restrict state, const Column* column, size_t start,
+                                  size_t size) const override {
+        _fast_intersect(column, start, size, state);
+    }
+
     void serialize_to_column(FunctionContext* ctx, ConstAggDataPtr __restrict state, Column* to) const override {
         auto* col = down_cast<BitmapColumn*>(to);
         auto& bitmap = const_cast<BitmapValue&>(this->data(state).bitmap);
@@ -70,6 +80,30 @@ public:
     }
 
     std::string get_name() const override { return "bitmap_intersect"; }
+
+private:
+    void _fast_intersect(const Column* column, size_t start, size_t size, AggDataPtr __restrict state) const {
+        if (size == 0) {
+            return;
+        }
+        const auto* col = down_cast<const BitmapColumn*>(column);
+        std::vector<const BitmapValue*> values;
+        values.reserve(size);
+        for (size_t i = 0; i < size; ++i) {
+            values.emplace_back(col->get_object(start + i));
+        }
+        auto& packed = this->data(state);
+        if (!packed.initial) {
+            // start from the smallest one, so the intersection never grows beyond it
+            auto smallest = std::min_element(values.begin(), values.end(), [](const auto* lhs, const auto* rhs) {
+                return lhs->cardinality() < rhs->cardinality();
+            });
+            packed.bitmap |= **smallest;
+            packed.initial = true;
+            values.erase(smallest);
+        }
+        packed.bitmap.fast_intersect(values);
+    }
 };
 
 } // namespace starrocks
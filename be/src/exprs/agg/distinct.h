@@ -17,8 +17,10 @@
 #include <algorithm>
 #include <cstring>
 #include <limits>
+#include <memory>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include "column/array_column.h"
 #include "column/binary_column.h"
@@ -34,6 +36,7 @@
 #include "gutil/casts.h"
 #include "runtime/mem_pool.h"
 #include "thrift/protocol/TJSONProtocol.h"
+#include "types/bitmap_value_detail.h"
 #include "util/phmap/phmap_dump.h"
 #include "util/slice.h"
 
@@ -271,6 +274,137 @@ struct DistinctAggregateStateV2<LT, SumLT, FixedLengthLTGuard<LT>> {
 template <LogicalType LT, LogicalType SumLT>
 struct DistinctAggregateStateV2<LT, SumLT, StringLTGuard<LT>> : public DistinctAggregateState<LT, SumLT> {};
 
+// The exact distinct state of the integers, which keeps a few distinct values in a sorted array, and the others in
+// a roaring bitmap, which is much smaller than a hash set for a lot of groups or a large cardinality.
+// It's serialized in the same format as DistinctAggregateStateV2, so the two states are exchangeable.
+template <LogicalType LT, LogicalType SumLT>
+struct BitmapDistinctAggregateState {
+    using T = RunTimeCppType<LT>;
+    using SumType = RunTimeCppType<SumLT>;
+    // The values of the bitmap, so the negative values are kept in the high bits.
+    using BitmapValueType = std::conditional_t<sizeof(T) <= sizeof(uint32_t), uint32_t, uint64_t>;
+    static constexpr size_t kMaxSortedValues = 64;
+    // The approximate memory usage of a value in the array containers of the bitmap.
+    static constexpr size_t kBitmapValueBytes = sizeof(uint16_t);
+
+    size_t update(T key) {
+        if (bitmap == nullptr) {
+            auto iter = std::lower_bound(values.begin(), values.end(), key);
+            if (iter != values.end() && *iter == key) {
+                return 0;
+            }
+            if (values.size() < kMaxSortedValues) {
+                values.insert(iter, key);
+                return sizeof(T);
+            }
+            _convert_to_bitmap();
+        }
+        BitmapValueType value = to_bitmap_value(key);
+        if (bitmap->contains(value)) {
+            return 0;
+        }
+        bitmap->add(value);
+        return kBitmapValueBytes;
+    }
+
+    size_t update_batch(const T* keys, size_t num_keys) {
+        size_t mem_usage = 0;
+        size_t i = 0;
+        for (; i < num_keys && bitmap == nullptr; i++) {
+            mem_usage += update(keys[i]);
+        }
+        if (i == num_keys) {
+            return mem_usage;
+        }
+        std::vector<BitmapValueType> bitmap_values(num_keys - i);
+        for (size_t j = 0; j < bitmap_values.size(); j++) {
+            bitmap_values[j] = to_bitmap_value(keys[i + j]);
+        }
+        uint64_t old_cardinality = bitmap->cardinality();
+        bitmap->addMany(bitmap_values.size(), bitmap_values.data());
+        return mem_usage + (bitmap->cardinality() - old_cardinality) * kBitmapValueBytes;
+    }
+
+    int64_t disctint_count() const { return bitmap == nullptr ? values.size() : bitmap->cardinality(); }
+
+    size_t serialize_size() const {
+        size_t size = disctint_count() * sizeof(T) + sizeof(size_t);
+        size = std::max(size, MIN_SIZE_OF_HASH_SET_SERIALIZED_DATA);
+        return size;
+    }
+
+    void serialize(uint8_t* dst) const {
+        size_t size = disctint_count();
+        memcpy(dst, &size, sizeof(size));
+        dst += sizeof(size);
+        for_each([&](T key) {
+            memcpy(dst, &key, sizeof(T));
+            dst += sizeof(T);
+        });
+    }
+
+    size_t deserialize_and_merge(const uint8_t* src, size_t len) {
+        size_t size = 0;
+        memcpy(&size, src, sizeof(size));
+        src += sizeof(size);
+        std::vector<T> keys(size);
+        memcpy(keys.data(), src, size * sizeof(T));
+        if (bitmap == nullptr && values.size() + size > kMaxSortedValues) {
+            _convert_to_bitmap();
+        }
+        return update_batch(keys.data(), keys.size());
+    }
+
+    SumType sum_distinct() const {
+        SumType sum{};
+        for_each([&](T key) { sum += key; });
+        return sum;
+    }
+
+    template <typename Func>
+    void for_each(Func&& func) const {
+        if (bitmap == nullptr) {
+            for (T key : values) {
+                func(key);
+            }
+            return;
+        }
+        std::vector<uint64_t> bitmap_values(bitmap->cardinality());
+        bitmap->toUint64Array(bitmap_values.data());
+        for (uint64_t value : bitmap_values) {
+            func(static_cast<T>(static_cast<BitmapValueType>(value)));
+        }
+    }
+
+    static BitmapValueType to_bitmap_value(T key) {
+        return static_cast<BitmapValueType>(static_cast<std::make_unsigned_t<T>>(key));
+    }
+
+    void _convert_to_bitmap() {
+        DCHECK(bitmap == nullptr);
+        bitmap = std::make_unique<detail::Roaring64Map>();
+        for (T key : values) {
+            bitmap->add(to_bitmap_value(key));
+        }
+        std::vector<T>().swap(values);
+    }
+
+    // The sorted distinct values before converted to the bitmap.
+    std::vector<T> values;
+    std::unique_ptr<detail::Roaring64Map> bitmap;
+};
+
+template <typename State>
+inline constexpr bool is_bitmap_distinct_state = false;
+template <LogicalType LT, LogicalType SumLT>
+inline constexpr bool is_bitmap_distinct_state<BitmapDistinctAggregateState<LT, SumLT>> = true;
+
+// The state of multi_distinct_count2 and multi_distinct_sum2, the integers except largeint are kept by the bitmap.
+template <LogicalType LT, LogicalType SumLT, typename = guard::Guard>
+using AdaptiveDistinctAggregateState =
+        std::conditional_t<lt_is_integer<LT> && !lt_is_largeint<LT>, BitmapDistinctAggregateState<LT, SumLT>,
+                           DistinctAggregateStateV2<LT, SumLT>>;
+
 // Dear god this template class as template parameter kills me!
 template <LogicalType LT, LogicalType SumLT,
           template <LogicalType X, LogicalType Y, typename = guard::Guard> class TDistinctAggState,
@@ -300,6 +434,10 @@ public:
         const ColumnType* column = down_cast<const ColumnType*>(columns[0]);
         size_t mem_usage = 0;
         auto& agg_state = this->data(state);
+        if constexpr (is_bitmap_distinct_state<TDistinctAggState<LT, SumLT>>) {
+            ctx->add_mem_usage(agg_state.update_batch(column->get_data().data(), chunk_size));
+            return;
+        }
 
         struct CacheEntry {
             size_t hash_value;
@@ -329,6 +467,15 @@ public:
                       AggDataPtr* states) const override {
         const ColumnType* column = down_cast<const ColumnType*>(columns[0]);
         size_t mem_usage = 0;
+        if constexpr (is_bitmap_distinct_state<TDistinctAggState<LT, SumLT>>) {
+            // There is no hash to prefetch.
+            const auto& container_data = column->get_data();
+            for (size_t i = 0; i < chunk_size; ++i) {
+                mem_usage += this->data(states[i] + state_offset).update(container_data[i]);
+            }
+            ctx->add_mem_usage(mem_usage);
+            return;
+        }
 
         // We find that agg_states are scatterd in `states`, we can collect them together with hash value,
         // so there will be good cache locality. We can also collect column data into this `CacheEntry` to
@@ -456,7 +603,7 @@ class DistinctAggregateFunction
 
 template <LogicalType LT, AggDistinctType DistinctType, typename T = RunTimeCppType<LT>>
 class DistinctAggregateFunctionV2
-        : public TDistinctAggregateFunction<LT, SumResultLT<LT>, DistinctAggregateStateV2, DistinctType, T> {};
+        : public TDistinctAggregateFunction<LT, SumResultLT<LT>, AdaptiveDistinctAggregateState, DistinctType, T> {};
 
 template <LogicalType LT, AggDistinctType DistinctType, typename T = RunTimeCppType<LT>>
 class DecimalDistinctAggregateFunction
@@ -41,6 +41,7 @@
 #include "exprs/agg/nullable_aggregate.h"
 #include "exprs/agg/percentile_approx.h"
 #include "exprs/agg/percentile_cont.h"
+#include "exprs/agg/percentile_ddsketch.h"
 #include "exprs/agg/percentile_union.h"
 #include "exprs/agg/retention.h"
 #include "exprs/agg/stream/retract_maxmin.h"
@@ -163,6 +164,9 @@ public:
     template <LogicalType LT>
     static AggregateFunctionPtr MakePercentileContAggregateFunction();
 
+    template <DDSketchAggType AggType>
+    static AggregateFunctionPtr MakeDDSketchAggregateFunction();
+
     // Windows functions:
     static AggregateFunctionPtr MakeDenseRankWindowFunction();
 
@@ -187,6 +191,11 @@ public:
         return std::make_shared<LeadLagWindowFunction<LT, ignoreNulls, isLag>>();
     }
 
+    template <LogicalType LT, bool IsMax>
+    static AggregateFunctionPtr MakeMaxMinSlidingWindowFunction() {
+        return std::make_shared<MaxMinSlidingWindowFunction<LT, IsMax>>();
+    }
+
     template <LogicalType LT>
     static AggregateFunctionPtr MakeHistogramAggregationFunction() {
         return std::make_shared<HistogramAggregationFunction<LT>>();
@@ -323,6 +332,11 @@ AggregateFunctionPtr AggregateFactory::MakePercentileContAggregateFunction() {
     return std::make_shared<PercentileContAggregateFunction<LT>>();
 }
 
+template <DDSketchAggType AggType>
+AggregateFunctionPtr AggregateFactory::MakeDDSketchAggregateFunction() {
+    return std::make_shared<DDSketchAggregateFunction<AggType>>();
+}
+
 // Stream MV Retractable Aggregate Functions
 template <LogicalType LT>
 auto AggregateFactory::MakeRetractMinAggregateFunction() {
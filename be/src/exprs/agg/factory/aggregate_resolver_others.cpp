@@ -17,6 +17,7 @@
 #include "exprs/agg/factory/aggregate_resolver.hpp"
 #include "exprs/agg/group_concat.h"
 #include "exprs/agg/percentile_cont.h"
+#include "exprs/agg/percentile_ddsketch.h"
 #include "types/logical_type.h"
 #include "util/percentile_value.h"
 
@@ -37,6 +38,14 @@ void AggregateFuncResolver::register_others() {
     add_aggregate_mapping_variadic<TYPE_DATE, TYPE_DATE, PercentileContState<TYPE_DATE>>(
             "percentile_cont", false, AggregateFactory::MakePercentileContAggregateFunction<TYPE_DATE>());
 
+    add_aggregate_mapping_variadic<TYPE_DOUBLE, TYPE_DOUBLE, DDSketchState>(
+            "percentile_ddsketch", false,
+            AggregateFactory::MakeDDSketchAggregateFunction<DDSketchAggType::PERCENTILE>());
+    add_aggregate_mapping<TYPE_DOUBLE, TYPE_VARBINARY, DDSketchState>(
+            "ddsketch_state", false, AggregateFactory::MakeDDSketchAggregateFunction<DDSketchAggType::STATE>());
+    add_aggregate_mapping<TYPE_VARBINARY, TYPE_VARBINARY, DDSketchState>(
+            "ddsketch_union", false, AggregateFactory::MakeDDSketchAggregateFunction<DDSketchAggType::UNION>());
+
     add_aggregate_mapping_variadic<TYPE_CHAR, TYPE_VARCHAR, GroupConcatAggregateState>(
             "group_concat", false, AggregateFactory::MakeGroupConcatAggregateFunction<TYPE_CHAR>());
     add_aggregate_mapping_variadic<TYPE_VARCHAR, TYPE_VARCHAR, GroupConcatAggregateState>(
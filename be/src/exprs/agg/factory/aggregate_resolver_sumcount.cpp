@@ -55,7 +55,7 @@ struct DistinctDispatcher {
     void operator()(AggregateFuncResolver* resolver) {
         if constexpr (lt_is_aggregate<lt> || lt_is_string<lt>) {
             using DistinctState = DistinctAggregateState<lt, SumResultLT<lt>>;
-            using DistinctState2 = DistinctAggregateStateV2<lt, SumResultLT<lt>>;
+            using DistinctState2 = AdaptiveDistinctAggregateState<lt, SumResultLT<lt>>;
             resolver->add_aggregate_mapping<lt, TYPE_BIGINT, DistinctState>(
                     "multi_distinct_count", false, AggregateFactory::MakeCountDistinctAggregateFunction<lt>());
             resolver->add_aggregate_mapping<lt, TYPE_BIGINT, DistinctState2>(
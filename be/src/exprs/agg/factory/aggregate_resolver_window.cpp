@@ -46,6 +46,13 @@ struct WindowDispatcher {
             resolver->add_aggregate_mapping_notnull<lt, lt>(
                     "lag_in", true, AggregateFactory::MakeLeadLagWindowFunction<lt, true, true>());
         }
+        if constexpr (lt_is_aggregate<lt> && !lt_is_float<lt>) {
+            // max/min over the sliding rows frames, see Analytor::_support_removable_cumulatively.
+            resolver->add_aggregate_mapping<lt, lt, MaxMinSlidingState<lt>>(
+                    "max_sliding", true, AggregateFactory::MakeMaxMinSlidingWindowFunction<lt, true>());
+            resolver->add_aggregate_mapping<lt, lt, MaxMinSlidingState<lt>>(
+                    "min_sliding", true, AggregateFactory::MakeMaxMinSlidingWindowFunction<lt, false>());
+        }
     }
 };
 
@@ -41,48 +41,22 @@ public:
 
     void update(FunctionContext* ctx, const Column** columns, AggDataPtr __restrict state,
                 size_t row_num) const override {
-        uint64_t value = 0;
         const ColumnType* column = down_cast<const ColumnType*>(columns[0]);
-
-        if constexpr (lt_is_string<LT>) {
-            Slice s = column->get_slice(row_num);
-            value = HashUtil::murmur_hash64A(s.data, s.size, HashUtil::MURMUR_SEED);
-        } else {
-            const auto& v = column->get_data();
-            value = HashUtil::murmur_hash64A(&v[row_num], sizeof(v[row_num]), HashUtil::MURMUR_SEED);
-        }
-
+        uint64_t value = hash_value(column, row_num);
         if (value != 0) {
             this->data(state).update(value);
         }
     }
 
+    void update_batch_single_state(FunctionContext* ctx, size_t chunk_size, const Column** columns,
+                                   AggDataPtr __restrict state) const override {
+        update_range(down_cast<const ColumnType*>(columns[0]), 0, chunk_size, state);
+    }
+
     void update_batch_single_state_with_frame(FunctionContext* ctx, AggDataPtr __restrict state, const Column** columns,
                                               int64_t peer_group_start, int64_t peer_group_end, int64_t frame_start,
                                               int64_t frame_end) const override {
-        const ColumnType* column = down_cast<const ColumnType*>(columns[0]);
-
-        if constexpr (lt_is_string<LT>) {
-            uint64_t value = 0;
-            for (size_t i = frame_start; i < frame_end; ++i) {
-                Slice s = column->get_slice(i);
-                value = HashUtil::murmur_hash64A(s.data, s.size, HashUtil::MURMUR_SEED);
-
-                if (value != 0) {
-                    this->data(state).update(value);
-                }
-            }
-        } else {
-            uint64_t value = 0;
-            const auto& v = column->get_data();
-            for (size_t i = frame_start; i < frame_end; ++i) {
-                value = HashUtil::murmur_hash64A(&v[i], sizeof(v[i]), HashUtil::MURMUR_SEED);
-
-                if (value != 0) {
-                    this->data(state).update(value);
-                }
-            }
-        }
+        update_range(down_cast<const ColumnType*>(columns[0]), frame_start, frame_end, state);
     }
 
     void merge(FunctionContext* ctx, const Column* column, AggDataPtr __restrict state, size_t row_num) const override {
@@ -171,6 +145,30 @@ public:
             return "ndv";
         }
     }
+
+private:
+    static uint64_t hash_value(const ColumnType* column, size_t row_num) {
+        if constexpr (lt_is_string<LT>) {
+            Slice s = column->get_slice(row_num);
+            return HashUtil::murmur_hash64A(s.data, s.size, HashUtil::MURMUR_SEED);
+        } else {
+            const auto& v = column->get_data();
+            return HashUtil::murmur_hash64A(&v[row_num], sizeof(v[row_num]), HashUtil::MURMUR_SEED);
+        }
+    }
+
+    // Hash the rows [from, to) in a batch, then update the registers in a batch.
+    void update_range(const ColumnType* column, size_t from, size_t to, AggDataPtr __restrict state) const {
+        static constexpr size_t kBatchSize = 1024;
+        uint64_t hash_values[kBatchSize];
+        for (size_t start = from; start < to; start += kBatchSize) {
+            size_t size = std::min(kBatchSize, to - start);
+            for (size_t i = 0; i < size; i++) {
+                hash_values[i] = hash_value(column, start + i);
+            }
+            this->data(state).update_batch(hash_values, size);
+        }
+    }
 };
 
 } // namespace starrocks
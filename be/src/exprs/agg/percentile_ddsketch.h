@@ -0,0 +1,158 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstring>
+
+#include "column/binary_column.h"
+#include "column/const_column.h"
+#include "column/fixed_length_column.h"
+#include "column/vectorized_fwd.h"
+#include "exprs/agg/aggregate.h"
+#include "gutil/casts.h"
+#include "util/ddsketch.h"
+
+namespace starrocks {
+
+struct DDSketchState {
+    DDSketch sketch;
+    double quantile = -1.0;
+};
+
+enum class DDSketchAggType {
+    // percentile_ddsketch(DOUBLE value, DOUBLE quantile) -> DOUBLE
+    PERCENTILE,
+    // ddsketch_state(DOUBLE value) -> VARBINARY, the serialized sketch of the values.
+    STATE,
+    // ddsketch_union(VARBINARY sketch) -> VARBINARY, the serialized sketch merged from the sketches.
+    UNION
+};
+
+// The quantile aggregate functions based on DDSketch. The serialized sketches of ddsketch_state and ddsketch_union
+// could be kept in tables, merged by ddsketch_union and estimated by ddsketch_quantile later.
+//
+// The intermediate result is the serialized sketch, following the quantile for percentile_ddsketch.
+template <DDSketchAggType AggType>
+class DDSketchAggregateFunction final
+        : public AggregateFunctionBatchHelper<DDSketchState, DDSketchAggregateFunction<AggType>> {
+public:
+    static constexpr bool kSketchInput = AggType == DDSketchAggType::UNION;
+    static constexpr bool kWithQuantile = AggType == DDSketchAggType::PERCENTILE;
+
+    void update(FunctionContext* ctx, const Column** columns, AggDataPtr __restrict state,
+                size_t row_num) const override {
+        if constexpr (kSketchInput) {
+            merge_sketch(down_cast<const BinaryColumn*>(columns[0])->get_slice(row_num), state);
+        } else {
+            this->data(state).sketch.add(down_cast<const DoubleColumn*>(columns[0])->get_data()[row_num]);
+            update_quantile(columns, state);
+        }
+    }
+
+    void update_batch_single_state(FunctionContext* ctx, size_t chunk_size, const Column** columns,
+                                   AggDataPtr __restrict state) const override {
+        if constexpr (kSketchInput) {
+            const auto* column = down_cast<const BinaryColumn*>(columns[0]);
+            for (size_t i = 0; i < chunk_size; i++) {
+                merge_sketch(column->get_slice(i), state);
+            }
+        } else if (chunk_size > 0) {
+            this->data(state).sketch.add_batch(down_cast<const DoubleColumn*>(columns[0])->get_data().data(),
+                                               chunk_size);
+            update_quantile(columns, state);
+        }
+    }
+
+    void merge(FunctionContext* ctx, const Column* column, AggDataPtr __restrict state, size_t row_num) const override {
+        Slice slice = down_cast<const BinaryColumn*>(column)->get_slice(row_num);
+        if constexpr (kWithQuantile) {
+            DCHECK_GE(slice.size, sizeof(double));
+            memcpy(&this->data(state).quantile, slice.data, sizeof(double));
+            slice.remove_prefix(sizeof(double));
+        }
+        merge_sketch(slice, state);
+    }
+
+    void serialize_to_column(FunctionContext* ctx, ConstAggDataPtr __restrict state, Column* to) const override {
+        serialize_state(this->data(state).sketch, this->data(state).quantile, down_cast<BinaryColumn*>(to));
+    }
+
+    void convert_to_serialize_format(FunctionContext* ctx, const Columns& src, size_t chunk_size,
+                                     ColumnPtr* dst) const override {
+        if constexpr (kSketchInput) {
+            *dst = src[0];
+        } else {
+            const auto& values = down_cast<const DoubleColumn*>(src[0].get())->get_data();
+            double quantile = kWithQuantile ? src[1]->get(0).get_double() : -1.0;
+            auto* column = down_cast<BinaryColumn*>(dst->get());
+            for (size_t i = 0; i < chunk_size; i++) {
+                DDSketch sketch;
+                sketch.add(values[i]);
+                serialize_state(sketch, quantile, column);
+            }
+        }
+    }
+
+    void finalize_to_column(FunctionContext* ctx, ConstAggDataPtr __restrict state, Column* to) const override {
+        if constexpr (kWithQuantile) {
+            down_cast<DoubleColumn*>(to)->append(this->data(state).sketch.quantile(this->data(state).quantile));
+        } else {
+            serialize_state(this->data(state).sketch, -1.0, down_cast<BinaryColumn*>(to));
+        }
+    }
+
+    std::string get_name() const override {
+        switch (AggType) {
+        case DDSketchAggType::PERCENTILE:
+            return "percentile_ddsketch";
+        case DDSketchAggType::STATE:
+            return "ddsketch_state";
+        default:
+            return "ddsketch_union";
+        }
+    }
+
+private:
+    void update_quantile(const Column** columns, AggDataPtr __restrict state) const {
+        if constexpr (kWithQuantile) {
+            DCHECK(columns[1]->is_constant());
+            this->data(state).quantile = columns[1]->get(0).get_double();
+        }
+    }
+
+    void merge_sketch(const Slice& slice, AggDataPtr __restrict state) const {
+        DDSketch sketch;
+        if (!sketch.deserialize(slice)) {
+            // the sketches from the tables may be written by anything, just ignore the invalid ones.
+            DCHECK(kSketchInput) << "invalid intermediate ddsketch";
+            return;
+        }
+        this->data(state).sketch.merge(sketch);
+    }
+
+    static void serialize_state(const DDSketch& sketch, double quantile, BinaryColumn* column) {
+        Bytes& bytes = column->get_bytes();
+        size_t old_size = bytes.size();
+        size_t quantile_size = kWithQuantile ? sizeof(double) : 0;
+        bytes.resize(old_size + quantile_size + sketch.serialize_size());
+        if constexpr (kWithQuantile) {
+            memcpy(bytes.data() + old_size, &quantile, sizeof(double));
+        }
+        sketch.serialize(bytes.data() + old_size + quantile_size);
+        column->get_offset().emplace_back(bytes.size());
+    }
+};
+
+} // namespace starrocks
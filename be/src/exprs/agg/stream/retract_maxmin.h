@@ -202,8 +202,10 @@ public:
         T value = get_row_value(columns[0], row_num);
         this->data(state).update_rows(value, -1);
 
-        // reset state to restore from detail
-        if (!this->data(state).is_sync() && OP::is_sync(this->data(state), value)) {
+        // reset state to restore from detail, unless other rows of the result value remain: the detail state
+        // is a multiset of the values, so the result is not changed.
+        if (!this->data(state).is_sync() && OP::is_sync(this->data(state), value) &&
+            this->data(state).count(value) <= 0) {
             this->data(state).set_is_sync(true);
             this->data(state).reset_result();
         }
@@ -71,6 +71,13 @@ public:
         return _detail_state.find(value) != _detail_state.end();
     }
 
+    // The number of the rows of the value, the value's detail must have been restored.
+    int64_t count(const CppType& v) {
+        auto value = _convert_to_key_type(v);
+        auto iter = _detail_state.find(value);
+        return iter != _detail_state.end() ? iter->second : 0;
+    }
+
     const StateHashMap& detail_state() const { return _detail_state; }
     const bool is_sync() const { return _is_sync; }
     void set_is_sync(bool sync) { this->_is_sync = sync; }
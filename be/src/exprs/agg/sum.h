@@ -42,6 +42,24 @@ struct SumAggregateState {
     T sum{};
 };
 
+// Add up |data| to |init| with 4 independent int128 accumulators, so the carries of the int128 additions don't form
+// a single dependency chain. It wraps around on overflow the same as adding them one by one.
+template <typename T>
+inline int128_t sum_to_int128(int128_t init, const T* data, size_t size) {
+    uint128_t sums[4] = {static_cast<uint128_t>(init), 0, 0, 0};
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        sums[0] += static_cast<uint128_t>(static_cast<int128_t>(data[i]));
+        sums[1] += static_cast<uint128_t>(static_cast<int128_t>(data[i + 1]));
+        sums[2] += static_cast<uint128_t>(static_cast<int128_t>(data[i + 2]));
+        sums[3] += static_cast<uint128_t>(static_cast<int128_t>(data[i + 3]));
+    }
+    for (; i < size; ++i) {
+        sums[0] += static_cast<uint128_t>(static_cast<int128_t>(data[i]));
+    }
+    return static_cast<int128_t>(sums[0] + sums[1] + sums[2] + sums[3]);
+}
+
 template <LogicalType LT, typename T = RunTimeCppType<LT>, LogicalType ResultLT = SumResultLT<LT>,
           typename ResultType = RunTimeCppType<ResultLT>>
 class SumAggregateFunction final
@@ -75,8 +93,12 @@ public:
                                    AggDataPtr __restrict state) const override {
         const auto* column = down_cast<const InputColumnType*>(columns[0]);
         const auto* data = column->get_data().data();
-        for (size_t i = 0; i < chunk_size; ++i) {
-            this->data(state).sum += data[i];
+        if constexpr (std::is_same_v<ResultType, int128_t>) {
+            this->data(state).sum = sum_to_int128(this->data(state).sum, data, chunk_size);
+        } else {
+            for (size_t i = 0; i < chunk_size; ++i) {
+                this->data(state).sum += data[i];
+            }
         }
     }
 
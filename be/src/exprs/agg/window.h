@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #pragma once
+#include <deque>
+
 #include "column/column_helper.h"
 #include "exprs/agg/aggregate.h"
 #include "exprs/agg/aggregate_traits.h"
@@ -540,4 +542,86 @@ class LeadLagWindowFunction final : public ValueWindowFunction<LT, LeadLagState<
     std::string get_name() const override { return "lead-lag"; }
 };
 
+template <LogicalType LT>
+struct MaxMinSlidingState {
+    using T = AggDataValueType<LT>;
+    // The values of the frame which may still be the result of the current or a later frame, in the order of rows.
+    std::deque<T> values;
+};
+
+// MAX/MIN over the sliding frames like "rows between m preceding and n following".
+//
+// The values of the frame are kept in a monotonic queue: a value is dropped once a later value of the frame is
+// greater (less for MIN) than it, since it can't be the result of any later frame. So the front of the queue is
+// the result of the frame, and adding or removing a row costs amortized O(1) instead of evaluating the whole frame
+// for every row.
+// Equal values are all kept, so a removed row is at the front of the queue iff the front value equals to it.
+// Float types are not supported since NaN doesn't equal to itself.
+template <LogicalType LT, bool IsMax>
+class MaxMinSlidingWindowFunction final : public WindowFunction<MaxMinSlidingState<LT>> {
+public:
+    using InputColumnType = RunTimeColumnType<LT>;
+    using T = AggDataValueType<LT>;
+
+    void reset(FunctionContext* ctx, const Columns& args, AggDataPtr __restrict state) const override {
+        this->data(state).values.clear();
+    }
+
+    void update_batch_single_state_with_frame(FunctionContext* ctx, AggDataPtr __restrict state, const Column** columns,
+                                              int64_t peer_group_start, int64_t peer_group_end, int64_t frame_start,
+                                              int64_t frame_end) const override {
+        const auto& data = down_cast<const InputColumnType*>(columns[0])->get_data();
+        for (int64_t i = frame_start; i < frame_end; ++i) {
+            _push(this->data(state), data[i]);
+        }
+    }
+
+    void update_state_removable_cumulatively(FunctionContext* ctx, AggDataPtr __restrict state, const Column** columns,
+                                             int64_t current_row_position, int64_t partition_start,
+                                             int64_t partition_end, int64_t rows_start_offset, int64_t rows_end_offset,
+                                             bool ignore_subtraction, bool ignore_addition) const override {
+        const auto& data = down_cast<const InputColumnType*>(columns[0])->get_data();
+        auto& values = this->data(state).values;
+        const int64_t previous_frame_first_position = current_row_position - 1 + rows_start_offset;
+        const int64_t current_frame_last_position = current_row_position + rows_end_offset;
+        if (!ignore_subtraction && previous_frame_first_position >= partition_start &&
+            previous_frame_first_position < partition_end && !values.empty() &&
+            values.front() == data[previous_frame_first_position]) {
+            values.pop_front();
+        }
+        if (!ignore_addition && current_frame_last_position >= partition_start &&
+            current_frame_last_position < partition_end) {
+            _push(this->data(state), data[current_frame_last_position]);
+        }
+    }
+
+    void get_values(FunctionContext* ctx, ConstAggDataPtr __restrict state, Column* dst, size_t start,
+                    size_t end) const override {
+        DCHECK_GT(end, start);
+        const auto& values = this->data(state).values;
+        T value = values.empty() ? T{} : values.front();
+        auto* column = down_cast<InputColumnType*>(dst);
+        for (size_t i = start; i < end; ++i) {
+            AggDataTypeTraits<LT>::assign_value(column, i, value);
+        }
+    }
+
+    std::string get_name() const override { return IsMax ? "max_sliding" : "min_sliding"; }
+
+private:
+    static void _push(MaxMinSlidingState<LT>& state, const T& value) {
+        auto& values = state.values;
+        if constexpr (IsMax) {
+            while (!values.empty() && values.back() < value) {
+                values.pop_back();
+            }
+        } else {
+            while (!values.empty() && value < values.back()) {
+                values.pop_back();
+            }
+        }
+        values.push_back(value);
+    }
+};
+
 } // namespace starrocks
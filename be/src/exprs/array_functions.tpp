@@ -21,6 +21,7 @@
 #include "exprs/arithmetic_operation.h"
 #include "exprs/function_context.h"
 #include "exprs/function_helper.h"
+#include "simd/simd.h"
 #include "types/logical_type.h"
 #include "util/orlp/pdqsort.h"
 #include "util/phmap/phmap.h"
@@ -914,7 +915,7 @@ private:
         return dest_column;
     }
 
-    static void _filter_array_items(const ArrayColumn* src_column, const ColumnPtr raw_filter, ArrayColumn* dest_column,
+    static void _filter_array_items(ArrayColumn* src_column, const ColumnPtr raw_filter, ArrayColumn* dest_column,
                                     NullColumn* dest_null_map) {
         ArrayColumn* filter;
         NullColumn* filter_null_map = nullptr;
@@ -927,6 +928,9 @@ private:
         } else {
             filter = down_cast<ArrayColumn*>(raw_filter.get());
         }
+        if (_filter_aligned_array_items(src_column, filter, filter_null_map, dest_column, dest_null_map)) {
+            return;
+        }
         std::vector<uint32_t> indexes;
         // only keep the elements whose filter is not null and not 0.
         for (size_t i = 0; i < src_column->size(); ++i) {
@@ -954,6 +958,64 @@ private:
         }
         dest_column->elements_column()->append_selective(src_column->elements(), indexes);
     }
+
+    // array_filter(x -> ..., arr) is array_filter(arr, array_map(x -> ..., arr)), so the filter arrays mostly have
+    // the same offsets as the source arrays, then the selection of the elements is computed on the boolean elements
+    // directly, and the source elements are shared if all of them are selected.
+    // Return false if the filter arrays are not aligned with the source arrays.
+    static bool _filter_aligned_array_items(ArrayColumn* src_column, const ArrayColumn* filter,
+                                            const NullColumn* filter_null_map, ArrayColumn* dest_column,
+                                            const NullColumn* dest_null_map) {
+        const auto& offsets = src_column->offsets().get_data();
+        if (&src_column->offsets() != &filter->offsets() && offsets != filter->offsets().get_data()) {
+            return false;
+        }
+        const auto* bools = dynamic_cast<const BooleanColumn*>(ColumnHelper::get_data_column(&filter->elements()));
+        size_t num_elements = offsets.back();
+        if (bools == nullptr || src_column->elements().size() != num_elements ||
+            filter->elements().size() != num_elements) {
+            return false;
+        }
+
+        Filter selection(num_elements);
+        const auto& values = bools->get_data();
+        if (filter->elements().is_nullable()) {
+            const auto& nulls = down_cast<const NullableColumn&>(filter->elements()).immutable_null_column_data();
+            for (size_t i = 0; i < num_elements; ++i) {
+                selection[i] = (values[i] != 0) & !nulls[i];
+            }
+        } else {
+            for (size_t i = 0; i < num_elements; ++i) {
+                selection[i] = values[i] != 0;
+            }
+        }
+
+        auto& dest_offsets = dest_column->offsets_column()->get_data();
+        dest_offsets.reserve(dest_offsets.size() + src_column->size());
+        for (size_t i = 0; i < src_column->size(); ++i) {
+            // the null arrays and the arrays of null filters are empty
+            if ((dest_null_map != nullptr && dest_null_map->get_data()[i]) ||
+                (filter_null_map != nullptr && filter_null_map->get_data()[i])) {
+                memset(selection.data() + offsets[i], 0, offsets[i + 1] - offsets[i]);
+            }
+            dest_offsets.emplace_back(dest_offsets.back() +
+                                      SIMD::count_nonzero(selection.data() + offsets[i], offsets[i + 1] - offsets[i]));
+        }
+
+        if (dest_offsets.back() == num_elements) {
+            dest_column->elements_column() = src_column->elements_column();
+        } else {
+            std::vector<uint32_t> indexes;
+            indexes.reserve(dest_offsets.back());
+            for (uint32_t i = 0; i < num_elements; ++i) {
+                if (selection[i]) {
+                    indexes.emplace_back(i);
+                }
+            }
+            dest_column->elements_column()->append_selective(src_column->elements(), indexes);
+        }
+        return true;
+    }
 };
 
 // array_sortby(array, key_array) the key_array should not change the null property of array, if key_array is null,
@@ -34,10 +34,16 @@ ArrayMapExpr::ArrayMapExpr(const TExprNode& node) : Expr(node, false) {}
 
 ArrayMapExpr::ArrayMapExpr(TypeDescriptor type) : Expr(std::move(type), false) {}
 
+// The same array_map may be evaluated several times on a chunk, e.g. array_filter(x -> .., array_map(..)) is
+// array_filter(array_map(..), array_map(x -> .., array_map(..))), so reuse the result of the same array_map.
+StatusOr<ColumnPtr> ArrayMapExpr::evaluate_checked(ExprContext* context, Chunk* chunk) {
+    return evaluate_or_reuse(chunk, [&]() { return _evaluate(context, chunk); });
+}
+
 // The input array column maybe nullable, so first remove the wrap of nullable property.
 // The result of lambda expressions do not change the offsets of the current array and the null map.
 // NOTE the return column must be of the return type.
-StatusOr<ColumnPtr> ArrayMapExpr::evaluate_checked(ExprContext* context, Chunk* chunk) {
+StatusOr<ColumnPtr> ArrayMapExpr::_evaluate(ExprContext* context, Chunk* chunk) {
     // keep ColumnPtr refs
     std::vector<ColumnPtr> inputs;
     std::vector<ColumnPtr> input_elements;
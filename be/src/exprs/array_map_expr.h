@@ -37,5 +37,8 @@ public:
     Expr* clone(ObjectPool* pool) const override { return pool->add(new ArrayMapExpr(*this)); }
 
     StatusOr<ColumnPtr> evaluate_checked(ExprContext* context, Chunk* ptr) override;
+
+private:
+    StatusOr<ColumnPtr> _evaluate(ExprContext* context, Chunk* chunk);
 };
 } // namespace starrocks
@@ -15,6 +15,7 @@
 #include "exprs/case_expr.h"
 
 #include <cstdint>
+#include <limits>
 
 #include "column/chunk.h"
 #include "column/column_builder.h"
@@ -23,6 +24,7 @@
 #include "column/type_traits.h"
 #include "column/vectorized_fwd.h"
 #include "common/object_pool.h"
+#include "exprs/selective_evaluator.h"
 #include "gutil/casts.h"
 #include "simd/mulselector.h"
 #include "types/logical_type_infra.h"
@@ -97,16 +99,9 @@ private:
     //   If `CASE` equals `WHEN`, return `THEN`
     //   If `CASE` can't match ANY `WHEN`, return NULL
     StatusOr<ColumnPtr> evaluate_case(ExprContext* context, Chunk* chunk) {
-        ColumnPtr else_column = nullptr;
-        if (!_has_else_expr) {
-            else_column = ColumnHelper::create_const_null_column(chunk != nullptr ? chunk->num_rows() : 1);
-        } else {
-            ASSIGN_OR_RETURN(else_column, _children[_children.size() - 1]->evaluate_checked(context, chunk));
-        }
-
         ASSIGN_OR_RETURN(ColumnPtr case_column, _children[0]->evaluate_checked(context, chunk));
         if (ColumnHelper::count_nulls(case_column) == case_column->size()) {
-            return else_column->clone();
+            return evaluate_else(context, chunk);
         }
 
         int loop_end = _children.size() - 1;
@@ -114,15 +109,12 @@ private:
         Columns when_columns;
         when_columns.reserve(loop_end);
 
-        Columns then_columns;
-        then_columns.reserve(loop_end);
+        std::vector<Expr*> branch_exprs;
+        branch_exprs.reserve(loop_end);
 
         std::vector<ColumnViewer<WhenType>> when_viewers;
         when_viewers.reserve(loop_end);
 
-        std::vector<ColumnViewer<ResultType>> then_viewers;
-        then_viewers.reserve(loop_end);
-
         for (int i = 1; i < loop_end; i += 2) {
             ASSIGN_OR_RETURN(ColumnPtr when_column, _children[i]->evaluate_checked(context, chunk));
 
@@ -131,23 +123,40 @@ private:
                 continue;
             }
 
-            ASSIGN_OR_RETURN(ColumnPtr then_column, _children[i + 1]->evaluate_checked(context, chunk));
-
             when_viewers.emplace_back(when_column);
-            then_viewers.emplace_back(then_column);
-
             when_columns.emplace_back(when_column);
-            then_columns.emplace_back(then_column);
+            branch_exprs.emplace_back(_children[i + 1]);
         }
 
         if (when_viewers.empty()) {
-            return else_column->clone();
+            return evaluate_else(context, chunk);
         }
-        when_columns.emplace_back(case_column);
-        then_columns.emplace_back(else_column);
+        branch_exprs.emplace_back(_has_else_expr ? _children.back() : nullptr);
 
         ColumnViewer<WhenType> case_viewer(case_column);
-        then_viewers.emplace_back(else_column);
+        Branches branches;
+        RETURN_IF_ERROR(evaluate_branches(context, chunk, branch_exprs, &branches, [&](Buffer<uint16_t>* branch) {
+            branch->assign(case_column->size(), when_viewers.size());
+            for (int i = when_viewers.size() - 1; i >= 0; --i) {
+                const auto& when_viewer = when_viewers[i];
+                for (size_t row = 0; row < branch->size(); ++row) {
+                    bool matched = !case_viewer.is_null(row) && !when_viewer.is_null(row) &&
+                                   when_viewer.value(row) == case_viewer.value(row);
+                    (*branch)[row] = matched ? i : (*branch)[row];
+                }
+            }
+        }));
+        if (branches.any_selected) {
+            return merge_selected(branches);
+        }
+        when_columns.emplace_back(case_column);
+        Columns& then_columns = branches.columns;
+
+        std::vector<ColumnViewer<ResultType>> then_viewers;
+        then_viewers.reserve(then_columns.size());
+        for (const ColumnPtr& column : then_columns) {
+            then_viewers.emplace_back(column);
+        }
 
         size_t size = when_columns[0]->size();
         ColumnBuilder<ResultType> builder(size, this->type().precision, this->type().scale);
@@ -208,27 +217,17 @@ private:
     //  If all `WHEN` is null/false, return NULL
     //  If `WHEN` is not null and true, return `THEN`
     StatusOr<ColumnPtr> evaluate_no_case(ExprContext* context, Chunk* chunk) {
-        ColumnPtr else_column = nullptr;
-        if (!_has_else_expr) {
-            else_column = ColumnHelper::create_const_null_column(chunk != nullptr ? chunk->num_rows() : 1);
-        } else {
-            ASSIGN_OR_RETURN(else_column, _children[_children.size() - 1]->evaluate_checked(context, chunk));
-        }
-
         int loop_end = _children.size() - 1;
 
         Columns when_columns;
         when_columns.reserve(loop_end);
 
-        Columns then_columns;
-        then_columns.reserve(loop_end);
+        std::vector<Expr*> branch_exprs;
+        branch_exprs.reserve(loop_end);
 
         std::vector<ColumnViewer<TYPE_BOOLEAN>> when_viewers;
         when_viewers.reserve(loop_end);
 
-        std::vector<ColumnViewer<ResultType>> then_viewers;
-        then_viewers.reserve(loop_end);
-
         for (int i = 0; i < loop_end; i += 2) {
             ASSIGN_OR_RETURN(ColumnPtr when_column, _children[i]->evaluate_checked(context, chunk));
 
@@ -239,25 +238,43 @@ private:
                 continue;
             }
 
-            ASSIGN_OR_RETURN(ColumnPtr then_column, _children[i + 1]->evaluate_checked(context, chunk));
-
             // direct return if first when is all true
             if (when_viewers.empty() && trues_count == when_column->size()) {
+                ASSIGN_OR_RETURN(ColumnPtr then_column, _children[i + 1]->evaluate_checked(context, chunk));
                 return then_column->clone();
             }
 
             when_columns.emplace_back(when_column);
-            then_columns.emplace_back(then_column);
-
+            branch_exprs.emplace_back(_children[i + 1]);
             when_viewers.emplace_back(when_column);
-            then_viewers.emplace_back(then_column);
         }
 
         if (when_viewers.empty()) {
-            return else_column->clone();
+            return evaluate_else(context, chunk);
+        }
+        branch_exprs.emplace_back(_has_else_expr ? _children.back() : nullptr);
+
+        Branches branches;
+        RETURN_IF_ERROR(evaluate_branches(context, chunk, branch_exprs, &branches, [&](Buffer<uint16_t>* branch) {
+            branch->assign(when_columns[0]->size(), when_viewers.size());
+            for (int i = when_viewers.size() - 1; i >= 0; --i) {
+                const auto& when_viewer = when_viewers[i];
+                for (size_t row = 0; row < branch->size(); ++row) {
+                    bool matched = !when_viewer.is_null(row) && when_viewer.value(row);
+                    (*branch)[row] = matched ? i : (*branch)[row];
+                }
+            }
+        }));
+        if (branches.any_selected) {
+            return merge_selected(branches);
+        }
+        Columns& then_columns = branches.columns;
+
+        std::vector<ColumnViewer<ResultType>> then_viewers;
+        then_viewers.reserve(then_columns.size());
+        for (const ColumnPtr& column : then_columns) {
+            then_viewers.emplace_back(column);
         }
-        then_columns.emplace_back(else_column);
-        then_viewers.emplace_back(else_column);
 
         size_t size = when_columns[0]->size();
         ColumnBuilder<ResultType> builder(size, this->type().precision, this->type().scale);
@@ -354,7 +371,93 @@ private:
         return builder.build(ColumnHelper::is_all_const(when_columns) && ColumnHelper::is_all_const(then_columns));
     }
 
-private:
+    StatusOr<ColumnPtr> evaluate_else(ExprContext* context, Chunk* chunk) {
+        if (!_has_else_expr) {
+            return ColumnHelper::create_const_null_column(chunk != nullptr ? chunk->num_rows() : 1);
+        }
+        ASSIGN_OR_RETURN(ColumnPtr else_column, _children.back()->evaluate_checked(context, chunk));
+        return else_column->clone();
+    }
+
+    // The results of the THENs and the ELSE.
+    struct Branches {
+        Columns columns;
+        // The branch of each row, the index of |columns|, only computed if any branch is selective.
+        Buffer<uint16_t> branch;
+        // Whether columns[i] is evaluated on the rows of the branch i only.
+        std::vector<uint8_t> selected;
+        bool any_selected = false;
+    };
+
+    // Evaluate |exprs|, the THENs followed by the ELSE, which is nullptr if there is no ELSE.
+    // The selective exprs are evaluated only on the rows of their branch if there are few of them, and
+    // |compute_branch| is called to compute the branch of every row in that case.
+    template <typename ComputeBranch>
+    Status evaluate_branches(ExprContext* context, Chunk* chunk, const std::vector<Expr*>& exprs, Branches* branches,
+                             ComputeBranch&& compute_branch) {
+        DCHECK_LE(exprs.size(), std::numeric_limits<uint16_t>::max());
+        std::vector<uint8_t> selective(exprs.size(), 0);
+        bool any_selective = false;
+        for (size_t i = 0; i < exprs.size(); ++i) {
+            selective[i] = exprs[i] != nullptr && SelectiveEvaluator::is_selective(exprs[i], chunk);
+            any_selective |= selective[i];
+        }
+        std::vector<std::vector<uint32_t>> branch_rows;
+        if (any_selective) {
+            compute_branch(&branches->branch);
+            branch_rows.resize(exprs.size());
+            for (uint32_t row = 0; row < branches->branch.size(); ++row) {
+                branch_rows[branches->branch[row]].emplace_back(row);
+            }
+        }
+
+        branches->columns.reserve(exprs.size());
+        branches->selected.assign(exprs.size(), 0);
+        for (size_t i = 0; i < exprs.size(); ++i) {
+            ColumnPtr column;
+            if (exprs[i] == nullptr) {
+                column = ColumnHelper::create_const_null_column(chunk != nullptr ? chunk->num_rows() : 1);
+            } else if (selective[i] && SelectiveEvaluator::is_few_selected(branch_rows[i].size(), chunk)) {
+                if (branch_rows[i].empty()) {
+                    // None of the rows is of this branch, so the column is never accessed.
+                    column = ColumnHelper::create_const_null_column(1);
+                } else {
+                    ASSIGN_OR_RETURN(column, SelectiveEvaluator::evaluate(context, exprs[i], chunk, branch_rows[i]));
+                }
+                branches->selected[i] = 1;
+                branches->any_selected = true;
+            } else {
+                ASSIGN_OR_RETURN(column, exprs[i]->evaluate_checked(context, chunk));
+            }
+            branches->columns.emplace_back(std::move(column));
+        }
+        return Status::OK();
+    }
+
+    // Scatter the results of the branches to the rows of them.
+    ColumnPtr merge_selected(const Branches& branches) {
+        std::vector<ColumnViewer<ResultType>> viewers;
+        viewers.reserve(branches.columns.size());
+        for (const ColumnPtr& column : branches.columns) {
+            viewers.emplace_back(column);
+        }
+        // The next row of the selectively evaluated branches.
+        std::vector<uint32_t> positions(branches.columns.size(), 0);
+
+        size_t size = branches.branch.size();
+        ColumnBuilder<ResultType> builder(size, this->type().precision, this->type().scale);
+        for (size_t row = 0; row < size; ++row) {
+            uint16_t i = branches.branch[row];
+            size_t index = branches.selected[i] ? positions[i]++ : row;
+            if (viewers[i].is_null(index)) {
+                builder.append_null();
+            } else {
+                builder.append(viewers[i].value(index));
+            }
+        }
+        return builder.build(false);
+    }
+
     const bool _has_case_expr;
     const bool _has_else_expr;
 };
@@ -40,6 +40,7 @@
 #include "types/hll.h"
 #include "types/logical_type.h"
 #include "util/date_func.h"
+#include "util/fixed_layout_parser.h"
 #include "util/json.h"
 #include "util/mysql_global.h"
 #include "velocypack/Iterator.h"
@@ -435,6 +436,17 @@ DEFINE_UNARY_FN_WITH_IMPL(TimestampToNumber, value) {
     return value.to_timestamp_literal();
 }
 
+// Parse the regular integers by FixedLayoutParser, and the others by StringParser.
+template <typename T>
+static inline T parse_int_from_string(const Slice& slice, StringParser::ParseResult* result) {
+    T value;
+    if (FixedLayoutParser::parse_int(slice.data, slice.size, &value)) {
+        *result = StringParser::PARSE_SUCCESS;
+        return value;
+    }
+    return StringParser::string_to_int<T>(slice.data, slice.size, result);
+}
+
 template <LogicalType FromType, LogicalType ToType, bool AllowThrowException>
 ColumnPtr cast_int_from_string_fn(ColumnPtr& column) {
     StringParser::ParseResult result;
@@ -445,7 +457,7 @@ ColumnPtr cast_int_from_string_fn(ColumnPtr& column) {
     if (column->is_constant()) {
         auto* input = ColumnHelper::get_binary_column(column.get());
         auto slice = input->get_slice(0);
-        auto r = StringParser::string_to_int<RunTimeCppType<ToType>>(slice.data, slice.size, &result);
+        auto r = parse_int_from_string<RunTimeCppType<ToType>>(slice, &result);
         if (result != StringParser::PARSE_SUCCESS) {
             if constexpr (AllowThrowException) {
                 THROW_RUNTIME_ERROR_WITH_TYPES_AND_VALUE(FromType, ToType, slice.to_string());
@@ -465,7 +477,7 @@ ColumnPtr cast_int_from_string_fn(ColumnPtr& column) {
         for (int i = 0; i < sz; ++i) {
             if (!null_data[i]) {
                 auto slice = data_column->get_slice(i);
-                res_data[i] = StringParser::string_to_int<RunTimeCppType<ToType>>(slice.data, slice.size, &result);
+                res_data[i] = parse_int_from_string<RunTimeCppType<ToType>>(slice, &result);
                 if constexpr (AllowThrowException) {
                     if (result != StringParser::PARSE_SUCCESS) {
                         THROW_RUNTIME_ERROR_WITH_TYPES_AND_VALUE(FromType, ToType, slice.to_string());
@@ -483,7 +495,7 @@ ColumnPtr cast_int_from_string_fn(ColumnPtr& column) {
         bool has_null = false;
         for (int i = 0; i < sz; ++i) {
             auto slice = data_column->get_slice(i);
-            res_data[i] = StringParser::string_to_int<RunTimeCppType<ToType>>(slice.data, slice.size, &result);
+            res_data[i] = parse_int_from_string<RunTimeCppType<ToType>>(slice, &result);
             null_data[i] = (result != StringParser::PARSE_SUCCESS);
             if constexpr (AllowThrowException) {
                 if (result != StringParser::PARSE_SUCCESS) {
@@ -1065,6 +1077,10 @@ class VectorizedCastExpr final : public Expr {
 public:
     DEFINE_CAST_CONSTRUCT(VectorizedCastExpr);
     StatusOr<ColumnPtr> evaluate_checked(ExprContext* context, Chunk* ptr) override {
+        return evaluate_or_reuse(ptr, [&]() { return _evaluate(context, ptr); });
+    }
+
+    StatusOr<ColumnPtr> _evaluate(ExprContext* context, Chunk* ptr) {
         ASSIGN_OR_RETURN(ColumnPtr column, _children[0]->evaluate_checked(context, ptr));
         if (ColumnHelper::count_nulls(column) == column->size() && column->size() != 0) {
             return ColumnHelper::create_const_null_column(column->size());
@@ -1255,6 +1271,10 @@ class VectorizedCastToStringExpr final : public Expr {
 public:
     DEFINE_CAST_CONSTRUCT(VectorizedCastToStringExpr);
     StatusOr<ColumnPtr> evaluate_checked(ExprContext* context, Chunk* ptr) override {
+        return evaluate_or_reuse(ptr, [&]() { return _evaluate(context, ptr); });
+    }
+
+    StatusOr<ColumnPtr> _evaluate(ExprContext* context, Chunk* ptr) {
         ASSIGN_OR_RETURN(ColumnPtr column, _children[0]->evaluate_checked(context, ptr));
         if (ColumnHelper::count_nulls(column) == column->size() && column->size() != 0) {
             return ColumnHelper::create_const_null_column(column->size());
@@ -14,8 +14,14 @@
 
 #include "exprs/compound_predicate.h"
 
+#include <unordered_map>
+
+#include "column/column_helper.h"
+#include "common/config.h"
 #include "common/object_pool.h"
 #include "exprs/binary_function.h"
+#include "exprs/column_ref.h"
+#include "exprs/multi_pattern_matcher.h"
 #include "exprs/predicate.h"
 #include "exprs/unary_function.h"
 
@@ -74,8 +80,31 @@ DEFINE_BINARY_FUNCTION_WITH_IMPL(OrImpl, l_value, r_value) {
 
 class VectorizedOrCompoundPredicate final : public Predicate {
 public:
-    DEFINE_COMPOUND_CONSTRUCT(VectorizedOrCompoundPredicate);
+    VectorizedOrCompoundPredicate(const TExprNode& node) : Predicate(node) {}
+    ~VectorizedOrCompoundPredicate() override = default;
+
+    Expr* clone(ObjectPool* pool) const override {
+        auto* expr = pool->add(new VectorizedOrCompoundPredicate(*this));
+        // the pattern leaves point to the children of this tree, they are collected again when the clone is opened
+        expr->_pattern_matcher.reset();
+        expr->_pattern_value_expr = nullptr;
+        expr->_other_leaves.clear();
+        return expr;
+    }
+
+    Status open(RuntimeState* state, ExprContext* context, FunctionContext::FunctionStateScope scope) override {
+        RETURN_IF_ERROR(Expr::open(state, context, scope));
+        if (scope == FunctionContext::FRAGMENT_LOCAL && config::multi_pattern_match_min_patterns > 0) {
+            RETURN_IF_ERROR(_prepare_pattern_matcher(context));
+        }
+        return Status::OK();
+    }
+
     StatusOr<ColumnPtr> evaluate_checked(ExprContext* context, Chunk* ptr) override {
+        if (_pattern_matcher != nullptr) {
+            return _evaluate_with_pattern_matcher(context, ptr);
+        }
+
         ASSIGN_OR_RETURN(auto l, _children[0]->evaluate_checked(context, ptr));
 
         int l_trues = ColumnHelper::count_true_with_notnull(l);
@@ -88,6 +117,120 @@ public:
 
         return VectorizedLogicPredicateBinaryFunction<OrNullImpl, OrImpl>::template evaluate<TYPE_BOOLEAN>(l, r);
     }
+
+private:
+    // The fids of the builtin functions LIKE and REGEXP.
+    static constexpr int64_t kLikeFid = 60010;
+    static constexpr int64_t kRegexpFid = 60020;
+
+    // Collect the operands of the nested ORs into |leaves|, and the nested ORs into |ors|.
+    void _collect_leaves(std::vector<Expr*>* leaves, std::vector<VectorizedOrCompoundPredicate*>* ors) {
+        for (auto* child : _children) {
+            if (auto* child_or = dynamic_cast<VectorizedOrCompoundPredicate*>(child); child_or != nullptr) {
+                ors->emplace_back(child_or);
+                child_or->_collect_leaves(leaves, ors);
+            } else {
+                leaves->emplace_back(child);
+            }
+        }
+    }
+
+    // Whether |expr| is `col LIKE 'pattern'` or `col REGEXP 'pattern'`.
+    static bool _is_pattern_match(const Expr* expr) {
+        return expr->node_type() == TExprNodeType::FUNCTION_CALL &&
+               (expr->fn().fid == kLikeFid || expr->fn().fid == kRegexpFid) && expr->get_num_children() == 2 &&
+               expr->get_child(0)->is_slotref() && expr->get_child(1)->is_constant();
+    }
+
+    // Match the LIKE/REGEXP leaves on the same column together by a MultiPatternMatcher, if there are enough.
+    Status _prepare_pattern_matcher(ExprContext* context) {
+        std::vector<Expr*> leaves;
+        std::vector<VectorizedOrCompoundPredicate*> ors;
+        _collect_leaves(&leaves, &ors);
+
+        // the LIKE/REGEXP leaves of every column
+        std::unordered_map<SlotId, std::vector<size_t>> slot_leaves;
+        std::vector<std::string> patterns(leaves.size());
+        SlotId best_slot = -1;
+        for (size_t i = 0; i < leaves.size(); i++) {
+            if (!_is_pattern_match(leaves[i])) {
+                continue;
+            }
+            ASSIGN_OR_RETURN(auto pattern_column, leaves[i]->get_child(1)->evaluate_const(context));
+            if (pattern_column == nullptr || pattern_column->only_null()) {
+                continue;
+            }
+            patterns[i] = ColumnHelper::get_const_value<TYPE_VARCHAR>(pattern_column).to_string();
+            auto slot_id = down_cast<ColumnRef*>(leaves[i]->get_child(0))->slot_id();
+            auto& indexes = slot_leaves[slot_id];
+            indexes.emplace_back(i);
+            if (best_slot < 0 || indexes.size() > slot_leaves[best_slot].size()) {
+                best_slot = slot_id;
+            }
+        }
+        if (best_slot < 0) {
+            return Status::OK();
+        }
+        const auto& indexes = slot_leaves[best_slot];
+        if (indexes.size() < static_cast<size_t>(config::multi_pattern_match_min_patterns)) {
+            return Status::OK();
+        }
+
+        std::vector<std::string> like_patterns;
+        std::vector<std::string> regex_patterns;
+        for (auto i : indexes) {
+            if (leaves[i]->fn().fid == kLikeFid) {
+                like_patterns.emplace_back(std::move(patterns[i]));
+            } else {
+                regex_patterns.emplace_back(std::move(patterns[i]));
+            }
+        }
+        auto matcher = MultiPatternMatcher::create(like_patterns, regex_patterns);
+        if (!matcher.ok()) {
+            // some patterns are not supported by hyperscan, evaluate them one by one
+            VLOG(2) << "Fail to match the OR'ed patterns together: " << matcher.status();
+            return Status::OK();
+        }
+
+        _pattern_matcher = std::move(matcher).value();
+        _pattern_value_expr = leaves[indexes[0]]->get_child(0);
+        std::vector<bool> matched(leaves.size(), false);
+        for (auto i : indexes) {
+            matched[i] = true;
+        }
+        _other_leaves.clear();
+        for (size_t i = 0; i < leaves.size(); i++) {
+            if (!matched[i]) {
+                _other_leaves.emplace_back(leaves[i]);
+            }
+        }
+        // the nested ORs are evaluated by this one
+        for (auto* child_or : ors) {
+            child_or->_pattern_matcher.reset();
+        }
+        return Status::OK();
+    }
+
+    StatusOr<ColumnPtr> _evaluate_with_pattern_matcher(ExprContext* context, Chunk* ptr) {
+        ASSIGN_OR_RETURN(auto value, _pattern_value_expr->evaluate_checked(context, ptr));
+        ASSIGN_OR_RETURN(auto result, _pattern_matcher->match(value));
+        for (auto* leaf : _other_leaves) {
+            // all true and not null
+            if (ColumnHelper::count_true_with_notnull(result) == result->size()) {
+                break;
+            }
+            ASSIGN_OR_RETURN(auto r, leaf->evaluate_checked(context, ptr));
+            result = VectorizedLogicPredicateBinaryFunction<OrNullImpl, OrImpl>::template evaluate<TYPE_BOOLEAN>(
+                    result, r);
+        }
+        return result;
+    }
+
+    // Set if the LIKE/REGEXP leaves on the same column are matched together.
+    std::shared_ptr<MultiPatternMatcher> _pattern_matcher;
+    Expr* _pattern_value_expr = nullptr;
+    // The other leaves of the nested ORs, OR'ed with the result of _pattern_matcher one by one.
+    std::vector<Expr*> _other_leaves;
 };
 
 DEFINE_UNARY_FN_WITH_IMPL(CompoundPredNot, l) {
@@ -23,6 +23,7 @@
 #include "column/type_traits.h"
 #include "column/vectorized_fwd.h"
 #include "common/object_pool.h"
+#include "exprs/selective_evaluator.h"
 #include "gutil/casts.h"
 #include "runtime/types.h"
 #include "simd/selector.h"
@@ -168,6 +169,12 @@ public:
         ASSIGN_OR_RETURN(auto bhs, _children[0]->evaluate_checked(context, ptr));
         int true_count = ColumnHelper::count_true_with_notnull(bhs);
 
+        int false_count = bhs->size() - true_count;
+        if (true_count > 0 && false_count > 0 &&
+            (_few_selected(_children[1], ptr, true_count) || _few_selected(_children[2], ptr, false_count))) {
+            return _evaluate_selective(context, ptr, bhs);
+        }
+
         ASSIGN_OR_RETURN(auto lhs, _children[1]->evaluate_checked(context, ptr));
         if (true_count == bhs->size()) {
             return lhs->clone();
@@ -222,6 +229,50 @@ public:
     }
 
 private:
+    static bool _few_selected(Expr* expr, const Chunk* chunk, size_t num_selected) {
+        return SelectiveEvaluator::is_selective(expr, chunk) &&
+               SelectiveEvaluator::is_few_selected(num_selected, chunk);
+    }
+
+    // Evaluate the expensive branch only on the rows of it, rather than on all the rows and then select.
+    StatusOr<ColumnPtr> _evaluate_selective(ExprContext* context, Chunk* chunk, const ColumnPtr& bhs) {
+        size_t num_rows = bhs->size();
+        ColumnViewer<TYPE_BOOLEAN> bhs_viewer(bhs);
+        // The rows of the THEN and the ELSE.
+        std::vector<uint32_t> branch_rows[2];
+        Filter is_else(num_rows);
+        for (uint32_t row = 0; row < num_rows; ++row) {
+            is_else[row] = bhs_viewer.is_null(row) || !bhs_viewer.value(row);
+            branch_rows[is_else[row]].emplace_back(row);
+        }
+
+        ColumnPtr branches[2];
+        bool selected[2];
+        for (int i = 0; i < 2; ++i) {
+            Expr* expr = _children[i + 1];
+            selected[i] = _few_selected(expr, chunk, branch_rows[i].size());
+            if (selected[i]) {
+                ASSIGN_OR_RETURN(branches[i], SelectiveEvaluator::evaluate(context, expr, chunk, branch_rows[i]));
+            } else {
+                ASSIGN_OR_RETURN(branches[i], expr->evaluate_checked(context, chunk));
+            }
+        }
+
+        ColumnViewer<Type> viewers[2] = {ColumnViewer<Type>(branches[0]), ColumnViewer<Type>(branches[1])};
+        size_t positions[2] = {0, 0};
+        ColumnBuilder<Type> builder(num_rows, this->type().precision, this->type().scale);
+        for (size_t row = 0; row < num_rows; ++row) {
+            int i = is_else[row];
+            size_t index = selected[i] ? positions[i]++ : row;
+            if (viewers[i].is_null(index)) {
+                builder.append_null();
+            } else {
+                builder.append(viewers[i].value(index));
+            }
+        }
+        return builder.build(false);
+    }
+
     ColumnPtr get_null_column(int num_rows, ColumnPtr& input_col) {
         if (input_col->only_null()) {
             auto res = UInt8Column::create(num_rows);
@@ -17,6 +17,7 @@
 #include "column/column_builder.h"
 #include "exprs/arithmetic_operation.h"
 #include "exprs/binary_function.h"
+#include "simd/simd.h"
 #include "types/logical_type.h"
 
 namespace starrocks {
@@ -89,15 +90,34 @@ struct DecimalBinaryFunction {
                                                                          scale_factor);
             }
             if constexpr (check_overflow) {
-                if (overflow) {
-                    *has_null = true;
-                    nulls[i] = DATUM_NULL;
-                }
+                nulls[i] = overflow;
             }
         }
+        if constexpr (check_overflow) {
+            // detect the overflow of the whole batch at once, so the loop is free of branches
+            *has_null = SIMD::count_nonzero(nulls, num_rows) > 0;
+        }
         return false;
     }
 
+    // Add/sub the decimal128 operands of the same scale. The overflow of every row is computed from the sign bits,
+    // instead of the inline asm of add_overflow/sub_overflow which can't be optimized across rows.
+    template <bool lhs_is_const, bool rhs_is_const, bool is_add>
+    static inline void int128_add_sub(size_t num_rows, const int128_t* lhs_data, const int128_t* rhs_data,
+                                      int128_t* result_data, NullColumn::ValueType* nulls, bool* has_null) {
+        for (size_t i = 0; i < num_rows; ++i) {
+            auto l = static_cast<uint128_t>(lhs_data[lhs_is_const ? 0 : i]);
+            auto r = static_cast<uint128_t>(rhs_data[rhs_is_const ? 0 : i]);
+            uint128_t res = is_add ? l + r : l - r;
+            // add overflows if both operands have the same sign which differs from the result's,
+            // sub overflows if the operands have different signs and the result's sign differs from lhs's.
+            uint128_t sign = is_add ? (l ^ res) & (r ^ res) : (l ^ r) & (l ^ res);
+            result_data[i] = static_cast<int128_t>(res);
+            nulls[i] = static_cast<uint8_t>(sign >> 127);
+        }
+        *has_null = SIMD::count_nonzero(nulls, num_rows) > 0;
+    }
+
     template <bool lhs_is_const, bool rhs_is_const, LogicalType LhsType, LogicalType RhsType, LogicalType ResultType>
     static inline ColumnPtr evaluate(const ColumnPtr& lhs, const ColumnPtr& rhs) {
         using ResultCppType = RunTimeCppType<ResultType>;
@@ -132,8 +152,14 @@ struct DecimalBinaryFunction {
             // add/sub operation
             if (adjust_scale == 0) {
                 // S(lhs)==S(rhs) no need to adjust
-                all_null = adjust_evaluate<lhs_is_const, rhs_is_const, false, BinaryOperator>(
-                        num_rows, lhs_data, rhs_data, result_data, nulls, &has_null, adjust_scale);
+                if constexpr (check_overflow && (is_add_op<Op> || is_sub_op<Op>) && lt_is_decimal128<LhsType> &&
+                              lt_is_decimal128<RhsType> && lt_is_decimal128<ResultType>) {
+                    int128_add_sub<lhs_is_const, rhs_is_const, is_add_op<Op>>(num_rows, lhs_data, rhs_data,
+                                                                               result_data, nulls, &has_null);
+                } else {
+                    all_null = adjust_evaluate<lhs_is_const, rhs_is_const, false, BinaryOperator>(
+                            num_rows, lhs_data, rhs_data, result_data, nulls, &has_null, adjust_scale);
+                }
             } else if (lhs_scale < rhs_scale) {
                 // S(lhs) < S(rhs), scale lhs up by S(rhs)-S(lhs)
                 all_null = adjust_evaluate<lhs_is_const, rhs_is_const, true, BinaryOperator>(
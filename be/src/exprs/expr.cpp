@@ -40,7 +40,9 @@
 #include <utility>
 #include <vector>
 
+#include "column/chunk.h"
 #include "column/fixed_length_column.h"
+#include "common/config.h"
 #include "common/object_pool.h"
 #include "common/status.h"
 #include "exprs/arithmetic_expr.h"
@@ -56,6 +58,7 @@
 #include "exprs/condition_expr.h"
 #include "exprs/dictmapping_expr.h"
 #include "exprs/function_call_expr.h"
+#include "exprs/fused_arithmetic_expr.h"
 #include "exprs/in_predicate.h"
 #include "exprs/info_func.h"
 #include "exprs/is_null_predicate.h"
@@ -70,6 +73,7 @@
 #include "gutil/strings/substitute.h"
 #include "runtime/runtime_state.h"
 #include "types/logical_type.h"
+#include "util/hash_util.hpp"
 
 #pragma clang diagnostic push
 #pragma ide diagnostic ignored "EndlessLoop"
@@ -86,7 +90,9 @@ Expr::Expr(const Expr& expr)
           _type(expr._type),
           _output_scale(expr._output_scale),
           _fn(expr._fn),
-          _fn_context_index(expr._fn_context_index) {}
+          _fn_context_index(expr._fn_context_index),
+          _fingerprint(expr._fingerprint),
+          _reuse_result(expr._reuse_result) {}
 
 Expr::Expr(TypeDescriptor type) : Expr(std::move(type), false) {}
 
@@ -226,9 +232,10 @@ Status Expr::create_tree_from_thrift(ObjectPool* pool, const std::vector<TExprNo
                                     "node_idx:$0, nodes size:$1.",
                                     *node_idx, nodes.size()));
     }
-    int num_children = nodes[*node_idx].num_children;
+    const TExprNode& node = nodes[*node_idx];
+    int num_children = node.num_children;
     Expr* expr = nullptr;
-    RETURN_IF_ERROR(create_vectorized_expr(pool, nodes[*node_idx], &expr, state));
+    RETURN_IF_ERROR(create_vectorized_expr(pool, node, &expr, state));
     DCHECK(expr != nullptr);
     if (parent != nullptr) {
         parent->add_child(expr);
@@ -245,6 +252,9 @@ Status Expr::create_tree_from_thrift(ObjectPool* pool, const std::vector<TExprNo
                                         *node_idx, nodes.size()));
         }
     }
+    if (config::enable_expr_result_reuse) {
+        _compute_fingerprint(node, expr, state);
+    }
     if (parent == nullptr) {
         DCHECK(root_expr != nullptr);
         DCHECK(ctx != nullptr);
@@ -252,6 +262,9 @@ Status Expr::create_tree_from_thrift(ObjectPool* pool, const std::vector<TExprNo
             return Status::InternalError(
                     "Failed to reconstruct expression tree from thrift. Invalid input root_expr or ctx");
         } else {
+            if (config::enable_fused_arithmetic_expr) {
+                expr = FusedArithmeticExpr::rewrite(pool, expr);
+            }
             *root_expr = expr;
             *ctx = pool->add(new ExprContext(expr));
         }
@@ -259,6 +272,45 @@ Status Expr::create_tree_from_thrift(ObjectPool* pool, const std::vector<TExprNo
     return Status::OK();
 }
 
+void Expr::_compute_fingerprint(const TExprNode& node, Expr* expr, RuntimeState* state) {
+    // The node itself, excluding its children.
+    const std::string desc = apache::thrift::ThriftDebugString(node);
+    uint64_t fingerprint = HashUtil::hash64(desc.data(), desc.size(), 0);
+    for (const Expr* child : expr->_children) {
+        if (child->_fingerprint == 0) {
+            return;
+        }
+        fingerprint = HashUtil::hash64(&child->_fingerprint, sizeof(child->_fingerprint), fingerprint);
+    }
+    expr->_fingerprint = fingerprint == 0 ? 1 : fingerprint;
+
+    // Only the results of function calls and casts are worth reusing.
+    switch (node.node_type) {
+    case TExprNodeType::FUNCTION_CALL:
+    case TExprNodeType::COMPUTE_FUNCTION_CALL:
+    case TExprNodeType::CAST_EXPR:
+        if (state != nullptr && node.num_children > 0) {
+            state->add_expr_fingerprint(expr->_fingerprint);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+const ColumnPtr* Expr::_find_reusable_result(Chunk* chunk) const {
+    if (!_reuse_result || chunk == nullptr) {
+        return nullptr;
+    }
+    return chunk->get_expr_result(_fingerprint);
+}
+
+void Expr::_save_reusable_result(Chunk* chunk, const ColumnPtr& result) const {
+    if (_reuse_result && chunk != nullptr) {
+        chunk->set_expr_result(_fingerprint, result);
+    }
+}
+
 Status Expr::create_vectorized_expr(starrocks::ObjectPool* pool, const starrocks::TExprNode& texpr_node,
                                     starrocks::Expr** expr, RuntimeState* state) {
     switch (texpr_node.node_type) {
@@ -393,6 +445,7 @@ Status Expr::create_vectorized_expr(starrocks::ObjectPool* pool, const starrocks
     case TExprNodeType::LITERAL_PRED:
     case TExprNodeType::TUPLE_IS_NULL_PRED:
     case TExprNodeType::RUNTIME_FILTER_MIN_MAX_EXPR:
+    case TExprNodeType::FUSED_EXPR:
         break;
     }
     if (*expr == nullptr) {
@@ -437,6 +490,7 @@ Status Expr::prepare(RuntimeState* state, ExprContext* context) {
     for (auto& i : _children) {
         RETURN_IF_ERROR(i->prepare(state, context));
     }
+    _reuse_result = _fingerprint != 0 && state != nullptr && state->num_exprs_of_fingerprint(_fingerprint) > 1;
     return Status::OK();
 }
 
@@ -92,6 +92,7 @@ public:
     int output_scale() const { return _output_scale; }
 
     void add_child(Expr* expr) { _children.push_back(expr); }
+    void set_child(int i, Expr* expr) { _children[i] = expr; }
 
     // only the expr after clone can call this function
     // clear children
@@ -113,6 +114,10 @@ public:
     bool is_nullable() const { return _is_nullable; }
 
     bool is_monotonic() const { return _is_monotonic; }
+
+    // The fingerprint of the tree rooted at this expr, the exprs of the same fingerprint always compute the same
+    // results on the same chunk. It's 0 if unknown.
+    uint64_t fingerprint() const { return _fingerprint; }
     bool is_cast_expr() const { return _node_type == TExprNodeType::CAST_EXPR; }
 
     // In most time, this field is passed from FE
@@ -285,6 +290,23 @@ protected:
     std::once_flag _constant_column_evaluate_once{};
     StatusOr<ColumnPtr> _constant_column = Status::OK();
 
+    // The fingerprint of the exprs worth computing once per chunk, and whether to reuse the result of the exprs of
+    // the same fingerprint evaluated on the same chunk, which is set in prepare if more than one expr of the
+    // fragment has the same fingerprint.
+    uint64_t _fingerprint = 0;
+    bool _reuse_result = false;
+
+    // Evaluate by |evaluate|, or reuse the result of the expr of the same fingerprint evaluated on |chunk|.
+    template <typename Evaluate>
+    StatusOr<ColumnPtr> evaluate_or_reuse(Chunk* chunk, Evaluate&& evaluate) {
+        if (const ColumnPtr* result = _find_reusable_result(chunk); result != nullptr) {
+            return *result;
+        }
+        ASSIGN_OR_RETURN(ColumnPtr result, evaluate());
+        _save_reusable_result(chunk, result);
+        return result;
+    }
+
     /// Simple debug string that provides no expr subclass-specific information
     std::string debug_string(const std::string& expr_name) const {
         std::stringstream out;
@@ -296,6 +318,12 @@ private:
     // Create a new vectorized expr
     static Status create_vectorized_expr(ObjectPool* pool, const TExprNode& texpr_node, Expr** expr,
                                          RuntimeState* state);
+
+    // Compute the fingerprint of |expr| created from |node|, after its children are created.
+    static void _compute_fingerprint(const TExprNode& node, Expr* expr, RuntimeState* state);
+
+    const ColumnPtr* _find_reusable_result(Chunk* chunk) const;
+    void _save_reusable_result(Chunk* chunk, const ColumnPtr& result) const;
 };
 
 } // namespace starrocks
@@ -62,6 +62,9 @@ Status VectorizedFunctionCallExpr::prepare(starrocks::RuntimeState* state, starr
     _is_returning_random_value = _fn.fid == 10300 /* rand */ || _fn.fid == 10301 /* random */ ||
                                  _fn.fid == 10302 /* rand */ || _fn.fid == 10303 /* random */ ||
                                  _fn.fid == 100015 /* uuid */ || _fn.fid == 100016 /* uniq_id */;
+    if (_is_returning_random_value) {
+        _reuse_result = false;
+    }
 
     return Status::OK();
 }
@@ -127,6 +130,10 @@ bool VectorizedFunctionCallExpr::is_constant() const {
 }
 
 StatusOr<ColumnPtr> VectorizedFunctionCallExpr::evaluate_checked(starrocks::ExprContext* context, Chunk* ptr) {
+    return evaluate_or_reuse(ptr, [&]() { return _evaluate(context, ptr); });
+}
+
+StatusOr<ColumnPtr> VectorizedFunctionCallExpr::_evaluate(ExprContext* context, Chunk* ptr) {
     FunctionContext* fn_ctx = context->fn_context(_fn_context_index);
 
     Columns args;
@@ -40,6 +40,8 @@ protected:
     StatusOr<ColumnPtr> evaluate_checked(ExprContext* context, Chunk* ptr) override;
 
 private:
+    StatusOr<ColumnPtr> _evaluate(ExprContext* context, Chunk* ptr);
+
     const FunctionDescriptor* _fn_desc;
 
     bool _is_returning_random_value = false;
@@ -0,0 +1,368 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "exprs/fused_arithmetic_expr.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+
+#include "column/column_helper.h"
+#include "column/nullable_column.h"
+#include "column/type_traits.h"
+#include "exprs/arithmetic_operation.h"
+#include "types/logical_type.h"
+
+namespace starrocks {
+
+namespace {
+
+using Instruction = FusedArithmeticExpr::Instruction;
+
+// The values and nulls of a register in the current block, |nulls| is nullptr if none of them is null.
+struct Register {
+    const uint8_t* data = nullptr;
+    const uint8_t* nulls = nullptr;
+
+    // The whole column of a non-constant leaf, which is sliced block by block.
+    const uint8_t* column_data = nullptr;
+    const uint8_t* column_nulls = nullptr;
+    size_t value_size = 0;
+    bool is_leaf = false;
+    bool is_constant = false;
+
+    // The buffers written by the instruction of this register.
+    uint8_t* data_buffer = nullptr;
+    uint8_t* nulls_buffer = nullptr;
+};
+
+bool is_fusable_type(LogicalType type) {
+    switch (type) {
+    case TYPE_TINYINT:
+    case TYPE_SMALLINT:
+    case TYPE_INT:
+    case TYPE_BIGINT:
+    case TYPE_LARGEINT:
+    case TYPE_FLOAT:
+    case TYPE_DOUBLE:
+        return true;
+    default:
+        return false;
+    }
+}
+
+template <LogicalType LT, typename Op>
+void apply_arithmetic(const RunTimeCppType<LT>* lhs, const RunTimeCppType<LT>* rhs, RunTimeCppType<LT>* dst,
+                      size_t n) {
+    using T = RunTimeCppType<LT>;
+    for (size_t i = 0; i < n; i++) {
+        dst[i] = ArithmeticBinaryOperator<Op, LT>::template apply<T, T, T>(lhs[i], rhs[i]);
+    }
+}
+
+template <typename Cmp, typename T>
+void apply_compare(const T* lhs, const T* rhs, uint8_t* dst, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        dst[i] = Cmp()(lhs[i], rhs[i]);
+    }
+}
+
+// Return the nulls of a binary instruction, or nullptr if none of them is null.
+const uint8_t* merge_nulls(const uint8_t* lhs, const uint8_t* rhs, uint8_t* dst, size_t n) {
+    if (lhs != nullptr && rhs != nullptr) {
+        for (size_t i = 0; i < n; i++) {
+            dst[i] = lhs[i] | rhs[i];
+        }
+        return dst;
+    } else if (lhs != nullptr || rhs != nullptr) {
+        memcpy(dst, lhs != nullptr ? lhs : rhs, n);
+        return dst;
+    }
+    return nullptr;
+}
+
+template <LogicalType LT>
+void run_instruction(const Instruction& ins, Register* registers, size_t n) {
+    using T = RunTimeCppType<LT>;
+    const Register& lhs = registers[ins.lhs];
+    const Register& rhs = registers[ins.rhs];
+    Register& dst = registers[ins.dst];
+    const auto* l = reinterpret_cast<const T*>(lhs.data);
+    const auto* r = reinterpret_cast<const T*>(rhs.data);
+    auto* out = reinterpret_cast<T*>(dst.data_buffer);
+
+    dst.data = dst.data_buffer;
+    dst.nulls = merge_nulls(lhs.nulls, rhs.nulls, dst.nulls_buffer, n);
+    switch (ins.op) {
+    case TExprOpcode::ADD:
+        apply_arithmetic<LT, AddOp>(l, r, out, n);
+        break;
+    case TExprOpcode::SUBTRACT:
+        apply_arithmetic<LT, SubOp>(l, r, out, n);
+        break;
+    case TExprOpcode::MULTIPLY:
+        apply_arithmetic<LT, MulOp>(l, r, out, n);
+        break;
+    case TExprOpcode::DIVIDE:
+        if constexpr (std::is_floating_point_v<T>) {
+            apply_arithmetic<LT, DivOp>(l, r, out, n);
+            // dividing by zero results in NULL, the same as ArithmeticRightZeroCheck.
+            uint8_t* nulls = dst.nulls_buffer;
+            if (dst.nulls == nullptr) {
+                memset(nulls, 0, n);
+            }
+            for (size_t i = 0; i < n; i++) {
+                nulls[i] |= r[i] == T(0);
+            }
+            dst.nulls = nulls;
+        } else {
+            DCHECK(false) << "unsupported integer division";
+        }
+        break;
+    case TExprOpcode::EQ:
+        apply_compare<std::equal_to<T>>(l, r, dst.data_buffer, n);
+        break;
+    case TExprOpcode::NE:
+        apply_compare<std::not_equal_to<T>>(l, r, dst.data_buffer, n);
+        break;
+    case TExprOpcode::LT:
+        apply_compare<std::less<T>>(l, r, dst.data_buffer, n);
+        break;
+    case TExprOpcode::LE:
+        apply_compare<std::less_equal<T>>(l, r, dst.data_buffer, n);
+        break;
+    case TExprOpcode::GT:
+        apply_compare<std::greater<T>>(l, r, dst.data_buffer, n);
+        break;
+    case TExprOpcode::GE:
+        apply_compare<std::greater_equal<T>>(l, r, dst.data_buffer, n);
+        break;
+    default:
+        DCHECK(false) << "unsupported opcode: " << ins.op;
+    }
+}
+
+void run_instruction(const Instruction& ins, Register* registers, size_t n) {
+    switch (ins.type) {
+    case TYPE_TINYINT:
+        return run_instruction<TYPE_TINYINT>(ins, registers, n);
+    case TYPE_SMALLINT:
+        return run_instruction<TYPE_SMALLINT>(ins, registers, n);
+    case TYPE_INT:
+        return run_instruction<TYPE_INT>(ins, registers, n);
+    case TYPE_BIGINT:
+        return run_instruction<TYPE_BIGINT>(ins, registers, n);
+    case TYPE_LARGEINT:
+        return run_instruction<TYPE_LARGEINT>(ins, registers, n);
+    case TYPE_FLOAT:
+        return run_instruction<TYPE_FLOAT>(ins, registers, n);
+    case TYPE_DOUBLE:
+        return run_instruction<TYPE_DOUBLE>(ins, registers, n);
+    default:
+        DCHECK(false) << "unsupported type: " << ins.type;
+    }
+}
+
+} // namespace
+
+bool FusedArithmeticExpr::_is_fusable(const Expr* expr) {
+    if (expr->get_num_children() != 2) {
+        return false;
+    }
+    const LogicalType type = expr->get_child(0)->type().type;
+    if (type != expr->get_child(1)->type().type || !is_fusable_type(type)) {
+        return false;
+    }
+    if (expr->node_type() == TExprNodeType::ARITHMETIC_EXPR) {
+        if (expr->type().type != type) {
+            return false;
+        }
+        switch (expr->op()) {
+        case TExprOpcode::ADD:
+        case TExprOpcode::SUBTRACT:
+        case TExprOpcode::MULTIPLY:
+            return true;
+        case TExprOpcode::DIVIDE:
+            return type == TYPE_FLOAT || type == TYPE_DOUBLE;
+        default:
+            return false;
+        }
+    } else if (expr->node_type() == TExprNodeType::BINARY_PRED) {
+        if (expr->type().type != TYPE_BOOLEAN) {
+            return false;
+        }
+        switch (expr->op()) {
+        case TExprOpcode::EQ:
+        case TExprOpcode::NE:
+        case TExprOpcode::LT:
+        case TExprOpcode::LE:
+        case TExprOpcode::GT:
+        case TExprOpcode::GE:
+            return true;
+        default:
+            return false;
+        }
+    }
+    return false;
+}
+
+size_t FusedArithmeticExpr::_count_fusable(const Expr* expr) {
+    if (!_is_fusable(expr)) {
+        return 0;
+    }
+    return 1 + _count_fusable(expr->get_child(0)) + _count_fusable(expr->get_child(1));
+}
+
+Expr* FusedArithmeticExpr::rewrite(ObjectPool* pool, Expr* root) {
+    // A single node gains nothing from fusion.
+    if (_count_fusable(root) < 2) {
+        for (int i = 0; i < root->get_num_children(); i++) {
+            root->set_child(i, rewrite(pool, root->get_child(i)));
+        }
+        return root;
+    }
+    // The leaves of the fused tree may contain fusable subtrees too.
+    std::function<void(Expr*)> rewrite_leaves = [&](Expr* expr) {
+        for (int i = 0; i < expr->get_num_children(); i++) {
+            Expr* child = expr->get_child(i);
+            if (_is_fusable(child)) {
+                rewrite_leaves(child);
+            } else {
+                expr->set_child(i, rewrite(pool, child));
+            }
+        }
+    };
+    rewrite_leaves(root);
+    return pool->add(new FusedArithmeticExpr(root));
+}
+
+FusedArithmeticExpr::FusedArithmeticExpr(Expr* root) : Expr(*root) {
+    _node_type = TExprNodeType::FUSED_EXPR;
+    _opcode = TExprOpcode::INVALID_OPCODE;
+    add_child(root);
+}
+
+Status FusedArithmeticExpr::prepare(RuntimeState* state, ExprContext* context) {
+    RETURN_IF_ERROR(Expr::prepare(state, context));
+    if (_program.empty()) {
+        _compile(_children[0]);
+        DCHECK(!_program.empty());
+    }
+    return Status::OK();
+}
+
+int FusedArithmeticExpr::_compile(Expr* expr) {
+    if (!_is_fusable(expr)) {
+        const int reg = _num_registers++;
+        _leaves.emplace_back(expr);
+        _leaf_registers.emplace_back(reg);
+        return reg;
+    }
+    const int lhs = _compile(expr->get_child(0));
+    const int rhs = _compile(expr->get_child(1));
+    const int dst = _num_registers++;
+    _program.push_back({expr->op(), expr->get_child(0)->type().type, lhs, rhs, dst});
+    return dst;
+}
+
+StatusOr<ColumnPtr> FusedArithmeticExpr::evaluate_checked(ExprContext* context, Chunk* chunk) {
+    DCHECK(!_program.empty());
+    Columns leaf_columns(_leaves.size());
+    size_t num_rows = 0;
+    bool all_constant = true;
+    for (size_t i = 0; i < _leaves.size(); i++) {
+        ASSIGN_OR_RETURN(leaf_columns[i], _leaves[i]->evaluate_checked(context, chunk));
+        if (!leaf_columns[i]->is_constant()) {
+            all_constant = false;
+            num_rows = leaf_columns[i]->size();
+        }
+    }
+    if (all_constant) {
+        return _children[0]->evaluate_checked(context, chunk);
+    }
+
+    // Every register has a block of values and nulls in the scratch buffer, the root writes the result directly.
+    static constexpr size_t kMaxValueSize = sizeof(__int128);
+    std::vector<uint8_t> scratch(_num_registers * kBlockSize * (kMaxValueSize + 1));
+    std::vector<Register> registers(_num_registers);
+    for (size_t i = 0; i < _num_registers; i++) {
+        registers[i].data_buffer = scratch.data() + i * kBlockSize * kMaxValueSize;
+        registers[i].nulls_buffer = scratch.data() + _num_registers * kBlockSize * kMaxValueSize + i * kBlockSize;
+    }
+    for (size_t i = 0; i < _leaves.size(); i++) {
+        const Column* column = leaf_columns[i].get();
+        Register& reg = registers[_leaf_registers[i]];
+        reg.is_leaf = true;
+        reg.value_size = get_size_of_fixed_length_type(_leaves[i]->type().type);
+        DCHECK_LE(reg.value_size, kMaxValueSize);
+        if (column->is_constant()) {
+            // Broadcast the constant into a block of values.
+            reg.is_constant = true;
+            reg.data = reg.data_buffer;
+            if (column->only_null()) {
+                memset(reg.nulls_buffer, 1, kBlockSize);
+                reg.nulls = reg.nulls_buffer;
+            } else {
+                const uint8_t* value = column->raw_data();
+                for (size_t j = 0; j < kBlockSize; j++) {
+                    memcpy(reg.data_buffer + j * reg.value_size, value, reg.value_size);
+                }
+            }
+        } else if (column->is_nullable()) {
+            const auto* nullable_column = down_cast<const NullableColumn*>(column);
+            reg.column_data = nullable_column->raw_data();
+            reg.column_nulls = nullable_column->has_null() ? nullable_column->null_column()->raw_data() : nullptr;
+        } else {
+            reg.column_data = column->raw_data();
+        }
+    }
+
+    const int root = _program.back().dst;
+    ColumnPtr data_column = ColumnHelper::create_column(_type, false);
+    data_column->resize(num_rows);
+    auto null_column = NullColumn::create(num_rows, 0);
+    const size_t result_size = get_size_of_fixed_length_type(_type.type);
+    bool has_null = false;
+    for (size_t from = 0; from < num_rows; from += kBlockSize) {
+        const size_t n = std::min(kBlockSize, num_rows - from);
+        for (auto& reg : registers) {
+            if (reg.is_leaf && !reg.is_constant) {
+                reg.data = reg.column_data + from * reg.value_size;
+                reg.nulls = reg.column_nulls != nullptr ? reg.column_nulls + from : nullptr;
+            }
+        }
+        registers[root].data_buffer = data_column->mutable_raw_data() + from * result_size;
+        registers[root].nulls_buffer = null_column->get_data().data() + from;
+        for (const auto& ins : _program) {
+            run_instruction(ins, registers.data(), n);
+        }
+        has_null |= registers[root].nulls != nullptr;
+    }
+    if (has_null) {
+        // The nulls of the blocks without any null are left zero.
+        return NullableColumn::create(std::move(data_column), std::move(null_column));
+    }
+    return data_column;
+}
+
+std::string FusedArithmeticExpr::debug_string() const {
+    return Expr::debug_string(fmt::format("FusedArithmeticExpr instructions={} leaves={}", _program.size(),
+                                          _leaves.size()));
+}
+
+} // namespace starrocks
@@ -0,0 +1,81 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <vector>
+
+#include "exprs/expr.h"
+
+namespace starrocks {
+
+// FusedArithmeticExpr evaluates a tree of arithmetic exprs (+, -, *, / of DOUBLE and FLOAT) and comparisons over
+// the same fixed-width numeric types in one pass, instead of materializing a whole column for every node.
+//
+// The tree is compiled into a flat program of vectorized instructions, which runs over a block of rows at a time,
+// so the intermediate results stay in small cache-resident buffers, and only the leaves of the tree (slots,
+// literals and any other exprs) are evaluated as columns. The results are the same as evaluating the tree node by
+// node, including the null handling.
+//
+// The original tree is kept as the only child, so it's prepared, opened and closed as usual, and used if all the
+// leaves are constant.
+class FusedArithmeticExpr final : public Expr {
+public:
+    // Try to replace the fusable subtrees of |root| with FusedArithmeticExpr, return the new root.
+    static Expr* rewrite(ObjectPool* pool, Expr* root);
+
+    explicit FusedArithmeticExpr(Expr* root);
+    // The program is compiled again by prepare, for the children are copied after the expr itself.
+    FusedArithmeticExpr(const FusedArithmeticExpr& other) : Expr(other) {}
+    ~FusedArithmeticExpr() override = default;
+
+    Expr* clone(ObjectPool* pool) const override { return pool->add(new FusedArithmeticExpr(*this)); }
+
+    Status prepare(RuntimeState* state, ExprContext* context) override;
+
+    StatusOr<ColumnPtr> evaluate_checked(ExprContext* context, Chunk* chunk) override;
+
+    std::string debug_string() const override;
+
+    // The number of rows evaluated by each run of the program.
+    static constexpr size_t kBlockSize = 256;
+
+    // The instruction computing register |dst| from registers |lhs| and |rhs|, of operands of |type|.
+    struct Instruction {
+        TExprOpcode::type op;
+        LogicalType type;
+        int lhs;
+        int rhs;
+        int dst;
+    };
+
+private:
+    // Whether |expr| itself can be computed by an instruction.
+    static bool _is_fusable(const Expr* expr);
+    // The number of the fusable nodes of the subtree rooted at |expr|, stopped at the non-fusable ones.
+    static size_t _count_fusable(const Expr* expr);
+
+    // Compile the subtree of |expr|, return the register of its result.
+    int _compile(Expr* expr);
+
+    // The result of the last instruction is the result of the tree.
+    std::vector<Instruction> _program;
+    // The exprs evaluated as columns, the result of _leaves[i] is in register _leaf_registers[i].
+    std::vector<Expr*> _leaves;
+    std::vector<int> _leaf_registers;
+    size_t _num_registers = 0;
+};
+
+} // namespace starrocks
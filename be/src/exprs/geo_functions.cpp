@@ -307,8 +307,13 @@ struct StContainsState {
     }
     bool is_null{false};
     GeoShape* shapes[2];
+    // Built for a constant polygon or circle of the first argument
+    std::unique_ptr<GeoContainsIndex> index;
 };
 
+// The max number of the cells of the covering of a constant shape.
+static constexpr int kContainsIndexMaxCells = 64;
+
 Status GeoFunctions::st_contains_close(FunctionContext* ctx, FunctionContext::FunctionStateScope scope) {
     if (scope == FunctionContext::FRAGMENT_LOCAL) {
         auto* contains_ctx = reinterpret_cast<StContainsState*>(ctx->get_function_state(scope));
@@ -342,6 +347,9 @@ Status GeoFunctions::st_contains_prepare(FunctionContext* ctx, FunctionContext::
             }
         }
     }
+    if (!contains_ctx->is_null && contains_ctx->shapes[0] != nullptr && contains_ctx->shapes[1] == nullptr) {
+        contains_ctx->index = GeoContainsIndex::create(contains_ctx->shapes[0], kContainsIndexMaxCells);
+    }
 
     ctx->set_function_state(scope, contains_ctx);
     return Status::OK();
@@ -385,7 +393,12 @@ StatusOr<ColumnPtr> GeoFunctions::st_contains(FunctionContext* context, const Co
         }
 
         if (i == 2) {
-            result.append(shapes[0]->contains(shapes[1]));
+            if (state != nullptr && state->index != nullptr && shapes[1]->type() == GEO_SHAPE_POINT) {
+                // Most of the points are decided by their cell ids without the exact test
+                result.append(state->index->contains(*(const GeoPoint*)shapes[1]));
+            } else {
+                result.append(shapes[0]->contains(shapes[1]));
+            }
         }
     }
 
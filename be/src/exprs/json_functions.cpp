@@ -22,10 +22,12 @@
 #include "column/column_builder.h"
 #include "column/column_helper.h"
 #include "column/column_viewer.h"
+#include "common/config.h"
 #include "common/status.h"
 #include "exprs/function_context.h"
 #include "exprs/jsonpath.h"
 #include "glog/logging.h"
+#include "gutil/casts.h"
 #include "gutil/strings/escaping.h"
 #include "gutil/strings/substitute.h"
 #include "util/json.h"
@@ -222,7 +224,33 @@ JsonFunctionType JsonTypeTraits<TYPE_INT>::JsonType = JSON_FUN_INT;
 JsonFunctionType JsonTypeTraits<TYPE_DOUBLE>::JsonType = JSON_FUN_DOUBLE;
 JsonFunctionType JsonTypeTraits<TYPE_VARCHAR>::JsonType = JSON_FUN_STRING;
 
+// The prepared constant path of get_json_int/double/string, if it can be extracted on demand: it only selects
+// fields and single array elements, since the wildcard and slice selectors build new arrays, and a "$" in the
+// middle of the path goes back to the root.
+static JsonPath* get_prepared_ondemand_path(FunctionContext* context) {
+    if (!config::enable_json_ondemand_extract) {
+        return nullptr;
+    }
+    auto* path = reinterpret_cast<JsonPath*>(context->get_function_state(FunctionContext::FRAGMENT_LOCAL));
+    if (path == nullptr) {
+        return nullptr;
+    }
+    for (size_t i = 1; i < path->paths.size(); i++) {
+        const auto& piece = path->paths[i];
+        if (piece.key == "$" && i != 1) {
+            return nullptr;
+        }
+        if (piece.array_selector->type != NONE && piece.array_selector->type != SINGLE) {
+            return nullptr;
+        }
+    }
+    return path;
+}
+
 StatusOr<ColumnPtr> JsonFunctions::get_json_int(FunctionContext* context, const Columns& columns) {
+    if (auto* path = get_prepared_ondemand_path(context); path != nullptr) {
+        return _get_json_ondemand<TYPE_INT>(columns, *path);
+    }
     ASSIGN_OR_RETURN(auto jsons, _string_json(context, columns));
     const auto& paths = columns[1];
 
@@ -231,6 +259,9 @@ StatusOr<ColumnPtr> JsonFunctions::get_json_int(FunctionContext* context, const
 }
 
 StatusOr<ColumnPtr> JsonFunctions::get_json_double(FunctionContext* context, const Columns& columns) {
+    if (auto* path = get_prepared_ondemand_path(context); path != nullptr) {
+        return _get_json_ondemand<TYPE_DOUBLE>(columns, *path);
+    }
     ASSIGN_OR_RETURN(auto jsons, _string_json(context, columns));
     const auto& paths = columns[1];
 
@@ -239,6 +270,9 @@ StatusOr<ColumnPtr> JsonFunctions::get_json_double(FunctionContext* context, con
 }
 
 StatusOr<ColumnPtr> JsonFunctions::get_json_string(FunctionContext* context, const Columns& columns) {
+    if (auto* path = get_prepared_ondemand_path(context); path != nullptr) {
+        return _get_json_ondemand<TYPE_VARCHAR>(columns, *path);
+    }
     ASSIGN_OR_RETURN(auto jsons, _string_json(context, columns));
     const auto& paths = columns[1];
 
@@ -363,38 +397,39 @@ StatusOr<ColumnPtr> JsonFunctions::_string_json(FunctionContext* context, const
     return result.build(ColumnHelper::is_all_const(columns));
 }
 
+// Convert the json to an unescaped string with the first/last quote trimmed, return false if it fails.
+static bool json_to_unescaped_string(const JsonValue& json, std::string* str) {
+    auto json_str = json.to_string();
+    if (!json_str.ok()) {
+        return false;
+    }
+    *str = std::move(json_str.value());
+
+    // Since the string extract from json may be escaped, unescaping is needed.
+    // The src and dest of strings::CUnescape could be the same.
+    if (!strings::CUnescape(StringPiece{*str}, str, nullptr)) {
+        return false;
+    }
+
+    if (str->length() < 2) {
+        return true;
+    }
+
+    // Try to trim the first/last quote.
+    if ((*str)[0] == '"') *str = str->substr(1, str->size() - 1);
+    if ((*str)[str->size() - 1] == '"') *str = str->substr(0, str->size() - 1);
+    return true;
+}
+
 StatusOr<ColumnPtr> JsonFunctions::_json_string_unescaped(FunctionContext* context, const Columns& columns) {
     ColumnViewer<TYPE_JSON> viewer(columns[0]);
     ColumnBuilder<TYPE_VARCHAR> result(columns[0]->size());
 
+    std::string str;
     for (int row = 0; row < columns[0]->size(); row++) {
-        if (viewer.is_null(row)) {
+        if (viewer.is_null(row) || !json_to_unescaped_string(*viewer.value(row), &str)) {
             result.append_null();
         } else {
-            JsonValue* json = viewer.value(row);
-            auto json_str = json->to_string();
-            if (!json_str.ok()) {
-                result.append_null();
-                continue;
-            }
-            auto str = json_str.value();
-
-            // Since the string extract from json may be escaped, unescaping is needed.
-            // The src and dest of strings::CUnescape could be the same.
-            if (!strings::CUnescape(StringPiece{str}, &str, nullptr)) {
-                result.append_null();
-                continue;
-            }
-
-            if (str.length() < 2) {
-                result.append(str);
-                continue;
-            }
-
-            // Try to trim the first/last quote.
-            if (str[0] == '"') str = str.substr(1, str.size() - 1);
-            if (str[str.size() - 1] == '"') str = str.substr(0, str.size() - 1);
-
             result.append(str);
         }
     }
@@ -513,6 +548,178 @@ StatusOr<ColumnPtr> JsonFunctions::_json_query_impl(FunctionContext* context, co
     return result.build(ColumnHelper::is_all_const(columns));
 }
 
+// Walk the json document along |path| like JsonPathPiece::extract, only the fields on the path are parsed.
+// NO_SUCH_FIELD is returned if the path does not exist.
+static simdjson::error_code walk_ondemand(simdjson::ondemand::document& doc, const JsonPath& path,
+                                          simdjson::ondemand::value* value) {
+    simdjson::ondemand::value current;
+    auto err = doc.get_value().get(current);
+    for (size_t i = 1; !err && i < path.paths.size(); i++) {
+        const auto& piece = path.paths[i];
+        simdjson::ondemand::json_type type;
+        if (!piece.key.empty() && piece.key != "$") {
+            if ((err = current.type().get(type)) || type != simdjson::ondemand::json_type::object) {
+                return err ? err : simdjson::NO_SUCH_FIELD;
+            }
+            err = current.find_field_unordered(piece.key).get(current);
+        }
+        if (!err && piece.array_selector->type == SINGLE) {
+            if ((err = current.type().get(type)) || type != simdjson::ondemand::json_type::array) {
+                return err ? err : simdjson::NO_SUCH_FIELD;
+            }
+            simdjson::ondemand::array array;
+            int index = down_cast<ArraySelectorSingle*>(piece.array_selector.get())->index;
+            if (!(err = current.get_array().get(array))) {
+                err = array.at(index).get(current);
+            }
+        }
+    }
+    if (err == simdjson::INDEX_OUT_OF_BOUNDS) {
+        return simdjson::NO_SUCH_FIELD;
+    }
+    std::swap(*value, current);
+    return err;
+}
+
+// Append the extracted value the same as the JsonValue converted by _json_int/_json_double/_json_string_unescaped,
+// return false if the value should be converted through JsonValue.
+template <LogicalType ResultType>
+static bool append_ondemand_value(simdjson::ondemand::value& value, ColumnBuilder<ResultType>* result) {
+    simdjson::ondemand::json_type type;
+    if (value.type().get(type)) {
+        return false;
+    }
+    if constexpr (ResultType == TYPE_VARCHAR) {
+        std::string_view str;
+        if (type != simdjson::ondemand::json_type::string || value.get_string().get(str)) {
+            return false;
+        }
+        // The string is escaped again by JsonValue::to_string and then unescaped, which keeps the string only if
+        // there is no quote, backslash or control character in it.
+        for (char c : str) {
+            if (c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20) {
+                return false;
+            }
+        }
+        result->append(Slice(str.data(), str.size()));
+        return true;
+    } else {
+        if (type != simdjson::ondemand::json_type::number) {
+            // Only the numbers can be converted to INT/DOUBLE.
+            result->append_null();
+            return true;
+        }
+        simdjson::ondemand::number number;
+        if (value.get_number().get(number)) {
+            return false;
+        }
+        switch (number.get_number_type()) {
+        case simdjson::ondemand::number_type::signed_integer:
+            result->append(number.get_int64());
+            return true;
+        case simdjson::ondemand::number_type::floating_point_number: {
+            double d = number.get_double();
+            if constexpr (ResultType == TYPE_INT) {
+                // Leave the out of range values to vpack.
+                constexpr double kInt64Bound = static_cast<double>(1ULL << 63);
+                if (!(d >= -kInt64Bound && d < kInt64Bound)) {
+                    return false;
+                }
+                result->append(static_cast<int64_t>(d));
+            } else {
+                result->append(d);
+            }
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+}
+
+// Parse the json string as a whole and extract the path from it like get_json_int/double/string on JsonValue.
+template <LogicalType ResultType>
+static void append_parsed_value(const Slice& raw, const JsonPath& path, vpack::Builder* builder,
+                                ColumnBuilder<ResultType>* result) {
+    JsonValue json;
+    if (!JsonValue::parse(raw, &json).ok()) {
+        result->append_null();
+        return;
+    }
+    builder->clear();
+    vpack::Slice slice = JsonPath::extract(&json, path, builder);
+    if (slice.isNone()) {
+        result->append_null();
+        return;
+    }
+    JsonValue value(slice);
+    if constexpr (ResultType == TYPE_VARCHAR) {
+        std::string str;
+        if (json_to_unescaped_string(value, &str)) {
+            result->append(str);
+        } else {
+            result->append_null();
+        }
+    } else {
+        auto number = [&]() {
+            if constexpr (ResultType == TYPE_INT) {
+                return value.get_int();
+            } else {
+                return value.get_double();
+            }
+        }();
+        if (number.ok()) {
+            result->append(number.value());
+        } else {
+            result->append_null();
+        }
+    }
+}
+
+template <LogicalType ResultType>
+StatusOr<ColumnPtr> JsonFunctions::_get_json_ondemand(const Columns& columns, const JsonPath& path) {
+    auto num_rows = columns[0]->size();
+    ColumnViewer<TYPE_VARCHAR> json_viewer(columns[0]);
+    ColumnViewer<TYPE_VARCHAR> path_viewer(columns[1]);
+    ColumnBuilder<ResultType> result(num_rows);
+
+    simdjson::ondemand::parser parser;
+    // simdjson requires SIMDJSON_PADDING readable bytes after the json string.
+    std::string padded;
+    vpack::Builder builder;
+    for (int row = 0; row < num_rows; ++row) {
+        if (json_viewer.is_null(row) || path_viewer.is_null(row)) {
+            result.append_null();
+            continue;
+        }
+        Slice raw = json_viewer.value(row);
+        // Only the objects and arrays are walked on demand, the other strings are parsed as scalar json values.
+        size_t start = 0;
+        while (start < raw.size && (raw.data[start] == ' ' || raw.data[start] == '\t' || raw.data[start] == '\n' ||
+                                    raw.data[start] == '\r')) {
+            start++;
+        }
+        if (raw.size <= kJSONLengthLimit && start < raw.size && (raw.data[start] == '{' || raw.data[start] == '[')) {
+            padded.assign(raw.data, raw.size);
+            padded.resize(raw.size + simdjson::SIMDJSON_PADDING, '\0');
+            simdjson::ondemand::document doc;
+            simdjson::ondemand::value value;
+            if (!parser.iterate(padded.data(), raw.size, padded.size()).get(doc)) {
+                auto err = walk_ondemand(doc, path, &value);
+                if (err == simdjson::NO_SUCH_FIELD) {
+                    result.append_null();
+                    continue;
+                }
+                if (!err && append_ondemand_value<ResultType>(value, &result)) {
+                    continue;
+                }
+            }
+        }
+        append_parsed_value<ResultType>(raw, path, &builder, &result);
+    }
+    return result.build(ColumnHelper::is_all_const(columns));
+}
+
 StatusOr<ColumnPtr> JsonFunctions::json_exists(FunctionContext* context, const Columns& columns) {
     auto num_rows = columns[0]->size();
     auto json_viewer = ColumnViewer<TYPE_JSON>(columns[0]);
@@ -224,6 +224,16 @@ private:
     template <LogicalType ResultType>
     static StatusOr<ColumnPtr> _json_query_impl(FunctionContext* context, const Columns& columns);
 
+    /**
+     * Extract the prepared |path| from the json strings of get_json_int/double/string, the strings are walked by
+     * simdjson on-demand parser, so the fields not on the path are skipped without being parsed or converted to
+     * JsonValue. The rows which cannot be extracted on demand are parsed as a whole.
+     * @param: [json_string, json_path]
+     * @paramType: [BinaryColumn, BinaryColumn]
+     */
+    template <LogicalType ResultType>
+    static StatusOr<ColumnPtr> _get_json_ondemand(const Columns& columns, const JsonPath& path);
+
     /**
      * Parse string column as json column
      * @param: 
@@ -540,10 +540,15 @@ StatusOr<ColumnPtr> LikePredicate::regex_match_partial(FunctionContext* context,
 
 template <bool fullMatch>
 std::string LikePredicate::convert_like_pattern(FunctionContext* context, const Slice& pattern) {
+    auto state = reinterpret_cast<LikePredicateState*>(context->get_function_state(FunctionContext::THREAD_LOCAL));
+    return convert_like_pattern<fullMatch>(state->escape_char, pattern);
+}
+
+template <bool fullMatch>
+std::string LikePredicate::convert_like_pattern(char escape_char, const Slice& pattern) {
     std::string re_pattern;
     re_pattern.clear();
 
-    auto state = reinterpret_cast<LikePredicateState*>(context->get_function_state(FunctionContext::THREAD_LOCAL));
     bool is_escaped = false;
 
     if constexpr (fullMatch) {
@@ -556,7 +561,7 @@ std::string LikePredicate::convert_like_pattern(FunctionContext* context, const
         } else if (!is_escaped && pattern.data[i] == '_') {
             re_pattern.append(".");
             // check for escape char before checking for regex special chars, they might overlap
-        } else if (!is_escaped && pattern.data[i] == state->escape_char) {
+        } else if (!is_escaped && pattern.data[i] == escape_char) {
             is_escaped = true;
         } else if (pattern.data[i] == '.' || pattern.data[i] == '[' || pattern.data[i] == ']' ||
                    pattern.data[i] == '{' || pattern.data[i] == '}' || pattern.data[i] == '(' ||
@@ -581,6 +586,9 @@ std::string LikePredicate::convert_like_pattern(FunctionContext* context, const
     return re_pattern;
 }
 
+template std::string LikePredicate::convert_like_pattern<true>(char escape_char, const Slice& pattern);
+template std::string LikePredicate::convert_like_pattern<false>(char escape_char, const Slice& pattern);
+
 void LikePredicate::remove_escape_character(std::string* search_string) {
     std::string tmp_search_string;
     tmp_search_string.swap(*search_string);
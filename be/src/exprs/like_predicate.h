@@ -58,6 +58,11 @@ public:
      */
     DEFINE_VECTORIZED_FN(regex);
 
+    /// Convert a LIKE pattern (with embedded % and _) escaped by |escape_char| into the corresponding
+    /// regular expression pattern.
+    template <bool fullMatch>
+    static std::string convert_like_pattern(char escape_char, const Slice& pattern);
+
 private:
     /**
      * use for:
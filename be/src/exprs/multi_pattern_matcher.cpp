@@ -0,0 +1,107 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "exprs/multi_pattern_matcher.h"
+
+#include <fmt/format.h>
+
+#include "column/column_builder.h"
+#include "column/column_viewer.h"
+#include "exprs/like_predicate.h"
+
+namespace starrocks {
+
+MultiPatternMatcher::~MultiPatternMatcher() {
+    if (_scratch != nullptr) {
+        hs_free_scratch(_scratch);
+    }
+    if (_database != nullptr) {
+        hs_free_database(_database);
+    }
+}
+
+StatusOr<std::unique_ptr<MultiPatternMatcher>> MultiPatternMatcher::create(
+        const std::vector<std::string>& like_patterns, const std::vector<std::string>& regex_patterns) {
+    std::vector<std::string> expressions;
+    expressions.reserve(like_patterns.size() + regex_patterns.size());
+    for (const auto& pattern : like_patterns) {
+        // `\z` instead of `$`, which also matches before a trailing newline.
+        expressions.emplace_back("^" + LikePredicate::convert_like_pattern<false>('\\', Slice(pattern)) + "\\z");
+    }
+    for (const auto& pattern : regex_patterns) {
+        expressions.emplace_back(pattern);
+    }
+
+    std::vector<const char*> c_expressions;
+    std::vector<unsigned int> flags;
+    std::vector<unsigned int> ids;
+    for (size_t i = 0; i < expressions.size(); i++) {
+        c_expressions.emplace_back(expressions[i].c_str());
+        flags.emplace_back(HS_FLAG_ALLOWEMPTY | HS_FLAG_DOTALL | HS_FLAG_UTF8 | HS_FLAG_SINGLEMATCH);
+        ids.emplace_back(i);
+    }
+
+    std::unique_ptr<MultiPatternMatcher> matcher(new MultiPatternMatcher());
+    hs_compile_error_t* compile_err = nullptr;
+    if (hs_compile_multi(c_expressions.data(), flags.data(), ids.data(), c_expressions.size(), HS_MODE_BLOCK,
+                         nullptr, &matcher->_database, &compile_err) != HS_SUCCESS) {
+        auto error = fmt::format("Invalid hyperscan expression: {}, {}",
+                                 compile_err->expression >= 0 ? expressions[compile_err->expression] : "",
+                                 compile_err->message);
+        hs_free_compile_error(compile_err);
+        return Status::InvalidArgument(error);
+    }
+    if (hs_alloc_scratch(matcher->_database, &matcher->_scratch) != HS_SUCCESS) {
+        return Status::InternalError("Unable to allocate hyperscan scratch space");
+    }
+    return matcher;
+}
+
+StatusOr<ColumnPtr> MultiPatternMatcher::match(const ColumnPtr& column) const {
+    hs_scratch_t* scratch = nullptr;
+    if (hs_clone_scratch(_scratch, &scratch) != HS_SUCCESS) {
+        return Status::InternalError("Unable to clone hyperscan scratch space");
+    }
+
+    // Use a non-null pointer for the empty values to avoid crash in hs_scan.
+    static const char kEmptyValue = 'A';
+    ColumnViewer<TYPE_VARCHAR> viewer(column);
+    const size_t num_rows = viewer.size();
+    ColumnBuilder<TYPE_BOOLEAN> builder(num_rows);
+    for (size_t row = 0; row < num_rows; ++row) {
+        if (viewer.is_null(row)) {
+            builder.append_null();
+            continue;
+        }
+        bool matched = false;
+        auto value = viewer.value(row);
+        // stop scanning once any of the patterns matches
+        [[maybe_unused]] auto status = hs_scan(
+                _database, value.size > 0 ? value.data : &kEmptyValue, value.size, 0, scratch,
+                [](unsigned int id, unsigned long long from, unsigned long long to, unsigned int flags,
+                   void* ctx) -> int {
+                    *((bool*)ctx) = true;
+                    return 1;
+                },
+                &matched);
+        DCHECK(status == HS_SUCCESS || status == HS_SCAN_TERMINATED) << " status: " << status;
+        builder.append(matched);
+    }
+
+    hs_free_scratch(scratch);
+    return builder.build(column->is_constant());
+}
+
+} // namespace starrocks
@@ -0,0 +1,52 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <hs/hs.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "common/statusor.h"
+
+namespace starrocks {
+
+// MultiPatternMatcher matches a string column against several LIKE and REGEXP patterns in one pass, by compiling
+// all of them into one Hyperscan database. A row is matched if it matches any of the patterns.
+class MultiPatternMatcher {
+public:
+    ~MultiPatternMatcher();
+
+    // |like_patterns| are the patterns of LIKE, escaped by '\', and |regex_patterns| are the patterns of REGEXP.
+    // Return error if Hyperscan can't compile them.
+    static StatusOr<std::unique_ptr<MultiPatternMatcher>> create(const std::vector<std::string>& like_patterns,
+                                                                 const std::vector<std::string>& regex_patterns);
+
+    // Return a BOOLEAN column telling whether every row of |column| matches any of the patterns,
+    // the NULL values are still NULL.
+    StatusOr<ColumnPtr> match(const ColumnPtr& column) const;
+
+private:
+    MultiPatternMatcher() = default;
+
+    hs_database_t* _database = nullptr;
+    // The prototype of the scratch spaces, one per concurrent caller of match() is cloned from it.
+    hs_scratch_t* _scratch = nullptr;
+};
+
+} // namespace starrocks
@@ -18,6 +18,7 @@
 #include "column/column_helper.h"
 #include "column/column_viewer.h"
 #include "gutil/strings/substitute.h"
+#include "util/ddsketch.h"
 #include "util/percentile_value.h"
 #include "util/string_parser.hpp"
 
@@ -64,4 +65,21 @@ StatusOr<ColumnPtr> PercentileFunctions::percentile_approx_raw(FunctionContext*
     return builder.build(columns[0]->is_constant());
 }
 
+StatusOr<ColumnPtr> PercentileFunctions::ddsketch_quantile(FunctionContext* context, const Columns& columns) {
+    ColumnViewer<TYPE_VARBINARY> viewer1(columns[0]);
+    ColumnViewer<TYPE_DOUBLE> viewer2(columns[1]);
+    size_t size = columns[0]->size();
+    ColumnBuilder<TYPE_DOUBLE> builder(size);
+    for (int row = 0; row < size; ++row) {
+        DDSketch sketch;
+        if (viewer1.is_null(row) || viewer2.is_null(row) || !sketch.deserialize(viewer1.value(row)) ||
+            sketch.empty()) {
+            builder.append_null();
+        } else {
+            builder.append(sketch.quantile(viewer2.value(row)));
+        }
+    }
+    return builder.build(ColumnHelper::is_all_const(columns));
+}
+
 } // namespace starrocks
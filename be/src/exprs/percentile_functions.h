@@ -40,5 +40,13 @@ public:
      * @return TYPE_DOUBLE
      */
     DEFINE_VECTORIZED_FN(percentile_approx_raw);
+
+    /**
+     * Estimate the quantile by the sketch serialized by ddsketch_state or ddsketch_union.
+     * @param:
+     * @paramType columns: [TYPE_VARBINARY, TYPE_DOUBLE]
+     * @return TYPE_DOUBLE
+     */
+    DEFINE_VECTORIZED_FN(ddsketch_quantile);
 };
 } // namespace starrocks
@@ -14,6 +14,9 @@
 
 #include "exprs/runtime_filter.h"
 
+#include <algorithm>
+
+#include "common/config.h"
 #include "util/compression/stream_compression.h"
 namespace starrocks {
 
@@ -22,6 +25,7 @@ void SimdBlockFilter::init(size_t nums) {
     int log_heap_space = std::ceil(std::log2(nums));
     _log_num_buckets = std::max(1, log_heap_space - LOG_BUCKET_BYTE_SIZE);
     _directory_mask = (1ull << std::min(63, _log_num_buckets)) - 1;
+    _mask_shift = _log_num_buckets;
     const size_t alloc_size = get_alloc_size();
     const int malloc_failed = posix_memalign(reinterpret_cast<void**>(&_directory), 64, alloc_size);
     if (malloc_failed) throw ::std::bad_alloc();
@@ -31,35 +35,111 @@ void SimdBlockFilter::init(size_t nums) {
 SimdBlockFilter::SimdBlockFilter(SimdBlockFilter&& bf) noexcept {
     _log_num_buckets = bf._log_num_buckets;
     _directory_mask = bf._directory_mask;
+    _mask_shift = bf._mask_shift;
     _directory = bf._directory;
     bf._directory = nullptr;
 }
 
 size_t SimdBlockFilter::max_serialized_size() const {
     const size_t alloc_size = get_alloc_size();
-    return sizeof(_log_num_buckets) + sizeof(_directory_mask) + // data size + max data size
+    return sizeof(_log_num_buckets) + sizeof(_directory_mask) + sizeof(_mask_shift) + sizeof(uint8_t) +
+           // data size + max data size
            sizeof(int32_t) + alloc_size;
 }
 
+int SimdBlockFilter::_fold_times() const {
+    const double max_fill_ratio = config::runtime_filter_fold_max_fill_ratio;
+    if (max_fill_ratio <= 0) {
+        return 0;
+    }
+    int times = 0;
+    Bucket bucket;
+    // small filters are not worth folding.
+    while (times < MAX_FOLD_TIMES && _log_num_buckets - times - 1 + LOG_BUCKET_BYTE_SIZE >= LOG_MIN_FOLDED_BYTES) {
+        const size_t num_buckets = 1ull << (_log_num_buckets - times - 1);
+        const size_t max_bits = max_fill_ratio * num_buckets * sizeof(Bucket) * 8;
+        size_t num_bits = 0;
+        for (size_t i = 0; i < num_buckets && num_bits <= max_bits; i++) {
+            _fold_bucket(times + 1, i, &bucket);
+            for (int j = 0; j < BITS_SET_PER_BLOCK; j++) {
+                num_bits += __builtin_popcount(bucket[j]);
+            }
+        }
+        if (num_bits > max_bits) {
+            break;
+        }
+        times++;
+    }
+    return times;
+}
+
+void SimdBlockFilter::_fold_bucket(int fold_times, size_t idx, Bucket* bucket) const {
+    const size_t num_buckets = 1ull << (_log_num_buckets - fold_times);
+    memcpy(*bucket, _directory[idx], sizeof(Bucket));
+    for (size_t k = idx + num_buckets; k <= _directory_mask; k += num_buckets) {
+        for (int j = 0; j < BITS_SET_PER_BLOCK; j++) {
+            (*bucket)[j] |= _directory[k][j];
+        }
+    }
+}
+
 size_t SimdBlockFilter::serialize(uint8_t* data) const {
+    const int fold_times = _fold_times();
+    const int log_num_buckets = _log_num_buckets - fold_times;
+    const uint32_t directory_mask = (1ull << std::min(63, log_num_buckets)) - 1;
+    const size_t num_buckets = 1ull << log_num_buckets;
+
+    size_t num_non_empty_buckets = 0;
+    Bucket bucket;
+    for (size_t i = 0; i < num_buckets; i++) {
+        _fold_bucket(fold_times, i, &bucket);
+        num_non_empty_buckets += !std::all_of(bucket, bucket + BITS_SET_PER_BLOCK, [](uint32_t v) { return v == 0; });
+    }
+    const size_t bitmap_size = (num_buckets + 7) / 8;
+    const size_t sparse_size = bitmap_size + num_non_empty_buckets * sizeof(Bucket);
+    const uint8_t encoding = sparse_size < num_buckets * sizeof(Bucket) ? SPARSE_ENCODING : RAW_ENCODING;
+
     size_t offset = 0;
 #define SIMD_BF_COPY_FIELD(field)                 \
     memcpy(data + offset, &field, sizeof(field)); \
     offset += sizeof(field);
-    SIMD_BF_COPY_FIELD(_log_num_buckets);
-    SIMD_BF_COPY_FIELD(_directory_mask);
+    SIMD_BF_COPY_FIELD(log_num_buckets);
+    SIMD_BF_COPY_FIELD(directory_mask);
+    SIMD_BF_COPY_FIELD(_mask_shift);
+    SIMD_BF_COPY_FIELD(encoding);
 
-    const size_t alloc_size = get_alloc_size();
-    int32_t data_size = alloc_size;
+    int32_t data_size = encoding == SPARSE_ENCODING ? sparse_size : num_buckets * sizeof(Bucket);
     SIMD_BF_COPY_FIELD(data_size);
-    memcpy(data + offset, _directory, data_size);
-    offset += data_size;
-    return offset;
 #undef SIMD_BF_COPY_FIELD
+
+    if (encoding == RAW_ENCODING && fold_times == 0) {
+        memcpy(data + offset, _directory, data_size);
+        return offset + data_size;
+    }
+    uint8_t* bitmap = data + offset;
+    uint8_t* buckets = data + offset;
+    if (encoding == SPARSE_ENCODING) {
+        memset(bitmap, 0, bitmap_size);
+        buckets += bitmap_size;
+    }
+    for (size_t i = 0; i < num_buckets; i++) {
+        _fold_bucket(fold_times, i, &bucket);
+        if (encoding == SPARSE_ENCODING) {
+            if (std::all_of(bucket, bucket + BITS_SET_PER_BLOCK, [](uint32_t v) { return v == 0; })) {
+                continue;
+            }
+            bitmap[i / 8] |= 1 << (i % 8);
+        }
+        memcpy(buckets, bucket, sizeof(Bucket));
+        buckets += sizeof(Bucket);
+    }
+    DCHECK_EQ(buckets - (data + offset), data_size);
+    return offset + data_size;
 }
 
 size_t SimdBlockFilter::deserialize(const uint8_t* data) {
     size_t offset = 0;
+    uint8_t encoding = RAW_ENCODING;
     int32_t data_size = 0;
 
 #define SIMD_BF_COPY_FIELD(field)                 \
@@ -67,19 +147,37 @@ size_t SimdBlockFilter::deserialize(const uint8_t* data) {
     offset += sizeof(field);
     SIMD_BF_COPY_FIELD(_log_num_buckets);
     SIMD_BF_COPY_FIELD(_directory_mask);
+    SIMD_BF_COPY_FIELD(_mask_shift);
+    SIMD_BF_COPY_FIELD(encoding);
     SIMD_BF_COPY_FIELD(data_size);
 #undef SIMD_BF_COPY_FIELD
     const size_t alloc_size = get_alloc_size();
-    DCHECK(data_size == alloc_size);
     const int malloc_failed = posix_memalign(reinterpret_cast<void**>(&(_directory)), 64, alloc_size);
     if (malloc_failed) throw ::std::bad_alloc();
-    memcpy(_directory, data + offset, data_size);
+    if (encoding == RAW_ENCODING) {
+        DCHECK(data_size == alloc_size);
+        memcpy(_directory, data + offset, data_size);
+    } else {
+        DCHECK_EQ(encoding, SPARSE_ENCODING);
+        memset(_directory, 0, alloc_size);
+        const size_t num_buckets = 1ull << _log_num_buckets;
+        const uint8_t* bitmap = data + offset;
+        const uint8_t* buckets = bitmap + (num_buckets + 7) / 8;
+        for (size_t i = 0; i < num_buckets; i++) {
+            if (bitmap[i / 8] & (1 << (i % 8))) {
+                memcpy(_directory[i], buckets, sizeof(Bucket));
+                buckets += sizeof(Bucket);
+            }
+        }
+        DCHECK_EQ(buckets - (data + offset), data_size);
+    }
     offset += data_size;
     return offset;
 }
 
 void SimdBlockFilter::merge(const SimdBlockFilter& bf) {
     DCHECK(_log_num_buckets == bf._log_num_buckets);
+    DCHECK(_mask_shift == bf._mask_shift);
     for (int i = 0; i < (1 << _log_num_buckets); i++) {
 #ifdef __AVX2__
         auto* const dst = reinterpret_cast<__m256i*>(_directory[i]);
@@ -114,7 +212,7 @@ void SimdBlockFilter::make_mask(uint32_t key, uint32_t* masks) const {
 bool SimdBlockFilter::check_equal(const SimdBlockFilter& bf) const {
     const size_t alloc_size = get_alloc_size();
     return _log_num_buckets == bf._log_num_buckets && _directory_mask == bf._directory_mask &&
-           memcmp(_directory, bf._directory, alloc_size) == 0;
+           _mask_shift == bf._mask_shift && memcmp(_directory, bf._directory, alloc_size) == 0;
 }
 
 size_t JoinRuntimeFilter::max_serialized_size() const {
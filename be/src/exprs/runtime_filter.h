@@ -46,12 +46,12 @@ public:
     void insert_hash(const uint64_t hash) noexcept {
         const uint32_t bucket_idx = hash & _directory_mask;
 #ifdef __AVX2__
-        const __m256i mask = make_mask(hash >> _log_num_buckets);
+        const __m256i mask = make_mask(hash >> _mask_shift);
         __m256i* const bucket = &reinterpret_cast<__m256i*>(_directory)[bucket_idx];
         _mm256_store_si256(bucket, _mm256_or_si256(*bucket, mask));
 #else
         uint32_t masks[BITS_SET_PER_BLOCK];
-        make_mask(hash >> _log_num_buckets, masks);
+        make_mask(hash >> _mask_shift, masks);
         for (int i = 0; i < BITS_SET_PER_BLOCK; ++i) {
             _directory[bucket_idx][i] |= masks[i];
         }
@@ -61,7 +61,7 @@ public:
     bool test_hash(const uint64_t hash) const noexcept {
         const uint32_t bucket_idx = hash & _directory_mask;
 #ifdef __AVX2__
-        const __m256i mask = make_mask(hash >> _log_num_buckets);
+        const __m256i mask = make_mask(hash >> _mask_shift);
         const __m256i bucket = reinterpret_cast<__m256i*>(_directory)[bucket_idx];
         // We should return true if 'bucket' has a one wherever 'mask' does. _mm256_testc_si256
         // takes the negation of its first argument and ands that with its second argument. In
@@ -70,7 +70,7 @@ public:
         return _mm256_testc_si256(bucket, mask);
 #else
         uint32_t masks[BITS_SET_PER_BLOCK];
-        make_mask(hash >> _log_num_buckets, masks);
+        make_mask(hash >> _mask_shift, masks);
         for (int i = 0; i < BITS_SET_PER_BLOCK; ++i) {
             if ((_directory[bucket_idx][i] & masks[i]) == 0) {
                 return false;
@@ -81,6 +81,7 @@ public:
     }
 
     size_t max_serialized_size() const;
+    // The filter is folded and encoded sparsely if possible, see _fold_times.
     size_t serialize(uint8_t* data) const;
     size_t deserialize(const uint8_t* data);
     void merge(const SimdBlockFilter& bf);
@@ -114,11 +115,29 @@ private:
 
     size_t get_alloc_size() const { return 1ull << (_log_num_buckets + LOG_BUCKET_BYTE_SIZE); }
 
+    // Folding the filter in half ORs the upper half of the buckets into the lower half, the bits of all the
+    // inserted hash values are kept since the bucket index is the low bits of the hash value and the mask shift
+    // is unchanged. Return how many times the filter can be folded for serialization, as long as the ratio of
+    // the set bits doesn't exceed config::runtime_filter_fold_max_fill_ratio.
+    static constexpr int MAX_FOLD_TIMES = 4;
+    static constexpr int LOG_MIN_FOLDED_BYTES = 16;
+    int _fold_times() const;
+    // OR the buckets folded into the |idx|-th bucket of the filter folded |fold_times| times.
+    void _fold_bucket(int fold_times, size_t idx, Bucket* bucket) const;
+
+    // The encodings of the serialized buckets, the sparse one only has a bitmap of the non-empty buckets
+    // followed by them.
+    static constexpr uint8_t RAW_ENCODING = 0;
+    static constexpr uint8_t SPARSE_ENCODING = 1;
+
     // Common:
     // log_num_buckets_ is the log (base 2) of the number of buckets in the directory:
     int _log_num_buckets;
     // directory_mask_ is (1 << log_num_buckets_) - 1
     uint32_t _directory_mask;
+    // The hash value is shifted right by it before making the mask of a bucket, it's the log_num_buckets_
+    // before the filter is folded.
+    int _mask_shift;
     Bucket* _directory = nullptr;
 };
 
@@ -223,7 +242,14 @@ public:
 
     virtual void concat(JoinRuntimeFilter* rf) {
         _has_null |= rf->_has_null;
-        _hash_partition_bf.emplace_back(std::move(rf->_bf));
+        if (rf->_num_hash_partitions == 0) {
+            _hash_partition_bf.emplace_back(std::move(rf->_bf));
+        } else {
+            // rf is concatenated from the partitioned runtime filters by an intermediate merge node.
+            for (auto& bf : rf->_hash_partition_bf) {
+                _hash_partition_bf.emplace_back(std::move(bf));
+            }
+        }
         _num_hash_partitions = _hash_partition_bf.size();
         _join_mode = rf->_join_mode;
         _size += rf->_size;
@@ -308,6 +334,38 @@ public:
         _bf.init(_size);
     }
 
+    // The integer values of a dense range are tested exactly by a bitset over the range instead of the bloom filter.
+    static constexpr bool support_dense_bitset =
+            std::is_integral_v<CppType> && sizeof(CppType) <= sizeof(int64_t) && !std::is_same_v<CppType, bool>;
+
+    // Init the filter as a bitset over [min, max] rather than a bloom filter, if the bitset is not larger than
+    // the bloom filter for |hash_table_size| rows, return false and do nothing otherwise.
+    // All the values inserted later must be within [min, max].
+    bool init_dense_bitset(size_t hash_table_size, CppType min, CppType max) {
+        if constexpr (support_dense_bitset) {
+            if (min > max) {
+                return false;
+            }
+            const uint64_t num_bits = _dense_offset(max, min) + 1;
+            // the bloom filter allocates about one byte per row.
+            const uint64_t max_bits = std::max<uint64_t>(hash_table_size, 64) * 8;
+            if (num_bits == 0 || num_bits > max_bits) {
+                return false;
+            }
+            _size = hash_table_size;
+            // the bloom filter is never used, but keeps serialization working.
+            _bf.init(1);
+            _dense_base = min;
+            _dense_num_bits = num_bits;
+            _dense_bitset.assign((num_bits + 7) / 8, 0);
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    bool is_dense_bitset() const { return _dense_num_bits > 0; }
+
     size_t compute_hash(CppType value) const {
         if constexpr (IsSlice<CppType>) {
             return SliceHash()(value);
@@ -322,6 +380,16 @@ public:
             return;
         }
 
+        if constexpr (support_dense_bitset) {
+            if (is_dense_bitset()) {
+                const uint64_t offset = _dense_offset(*value, _dense_base);
+                DCHECK_LT(offset, _dense_num_bits);
+                _dense_bitset[offset / 8] |= 1 << (offset % 8);
+                _min = std::min(*value, _min);
+                _max = std::max(*value, _max);
+                return;
+            }
+        }
         size_t hash = compute_hash(*value);
         _bf.insert_hash(hash);
 
@@ -347,8 +415,18 @@ public:
     // this->min = std::min(other->min, this->min)
     // this->max = std::max(other->max, this->max)
     void merge(const JoinRuntimeFilter* rf) override {
-        JoinRuntimeFilter::merge(rf);
-        _merge_min_max(down_cast<const RuntimeBloomFilter*>(rf));
+        auto* other = down_cast<const RuntimeBloomFilter*>(rf);
+        DCHECK_EQ(is_dense_bitset(), other->is_dense_bitset());
+        if (is_dense_bitset()) {
+            DCHECK_EQ(_dense_num_bits, other->_dense_num_bits);
+            _has_null |= rf->has_null();
+            for (size_t i = 0; i < _dense_bitset.size(); i++) {
+                _dense_bitset[i] |= other->_dense_bitset[i];
+            }
+        } else {
+            JoinRuntimeFilter::merge(rf);
+        }
+        _merge_min_max(other);
     }
 
     // this->min = std::max(other->min, this->min)
@@ -361,6 +439,8 @@ public:
     }
 
     void concat(JoinRuntimeFilter* rf) override {
+        // the dense bitset is only built for the runtime filter which isn't partitioned.
+        DCHECK(!down_cast<const RuntimeBloomFilter*>(rf)->is_dense_bitset());
         JoinRuntimeFilter::concat(rf);
         _merge_min_max(down_cast<const RuntimeBloomFilter*>(rf));
     }
@@ -369,6 +449,9 @@ public:
         LogicalType ltype = Type;
         std::stringstream ss;
         ss << "RuntimeBF(type = " << ltype << ", bfsize = " << _size << ", has_null = " << _has_null;
+        if (is_dense_bitset()) {
+            ss << ", dense_bits = " << _dense_num_bits;
+        }
         if constexpr (std::is_integral_v<CppType> || std::is_floating_point_v<CppType>) {
             if constexpr (!std::is_same_v<CppType, __int128>) {
                 ss << ", _min = " << _min << ", _max = " << _max;
@@ -396,6 +479,11 @@ public:
             size += sizeof(_min.size) + _min.size;
             size += sizeof(_max.size) + _max.size;
         }
+        // _dense_num_bits.
+        size += sizeof(_dense_num_bits);
+        if (is_dense_bitset()) {
+            size += sizeof(_dense_base) + _dense_bitset.size();
+        }
 
         return size;
     }
@@ -430,6 +518,17 @@ public:
                 offset += _max.size;
             }
         }
+
+        memcpy(data + offset, &_dense_num_bits, sizeof(_dense_num_bits));
+        offset += sizeof(_dense_num_bits);
+        if constexpr (support_dense_bitset) {
+            if (is_dense_bitset()) {
+                memcpy(data + offset, &_dense_base, sizeof(_dense_base));
+                offset += sizeof(_dense_base);
+                memcpy(data + offset, _dense_bitset.data(), _dense_bitset.size());
+                offset += _dense_bitset.size();
+            }
+        }
         return offset;
     }
 
@@ -474,6 +573,18 @@ public:
             }
         }
 
+        memcpy(&_dense_num_bits, data + offset, sizeof(_dense_num_bits));
+        offset += sizeof(_dense_num_bits);
+        if constexpr (support_dense_bitset) {
+            if (is_dense_bitset()) {
+                memcpy(&_dense_base, data + offset, sizeof(_dense_base));
+                offset += sizeof(_dense_base);
+                _dense_bitset.resize((_dense_num_bits + 7) / 8);
+                memcpy(_dense_bitset.data(), data + offset, _dense_bitset.size());
+                offset += _dense_bitset.size();
+            }
+        }
+
         return offset;
     }
 
@@ -487,6 +598,12 @@ public:
             bool eq = (_min == rf._min) && (_max == rf._max);
             if (!eq) return false;
         }
+        if (_dense_num_bits != rf._dense_num_bits) return false;
+        if constexpr (support_dense_bitset) {
+            if (is_dense_bitset()) {
+                return _dense_base == rf._dense_base && _dense_bitset == rf._dense_bitset;
+            }
+        }
         return true;
     }
 
@@ -663,10 +780,26 @@ private:
     }
 
     bool _test_data(CppType value) const {
+        if constexpr (support_dense_bitset) {
+            if (is_dense_bitset()) {
+                const uint64_t offset = _dense_offset(value, _dense_base);
+                return offset < _dense_num_bits && (_dense_bitset[offset / 8] >> (offset % 8) & 1);
+            }
+        }
         size_t hash = compute_hash(value);
         return _bf.test_hash(hash);
     }
 
+    // The offset of |value| to |base| in the dense bitset, it's out of the bitset if |value| < |base|.
+    static uint64_t _dense_offset(CppType value, CppType base) {
+        if constexpr (support_dense_bitset) {
+            return static_cast<uint64_t>(static_cast<int64_t>(value)) -
+                   static_cast<uint64_t>(static_cast<int64_t>(base));
+        } else {
+            return 0;
+        }
+    }
+
     bool _test_data_with_hash(CppType value, const uint32_t shuffle_hash) const {
         static constexpr uint32_t BUCKET_ABSENT = 2147483647;
         if (shuffle_hash == BUCKET_ABSENT) {
@@ -753,6 +886,10 @@ private:
     bool _has_min_max = true;
     bool _left_close_interval = true;
     bool _right_close_interval = true;
+    // The exact bitset over [_dense_base, _dense_base + _dense_num_bits), see init_dense_bitset.
+    CppType _dense_base{};
+    uint64_t _dense_num_bits = 0;
+    std::vector<uint8_t> _dense_bitset;
 };
 
 } // namespace starrocks
@@ -17,6 +17,7 @@
 #include <thread>
 
 #include "column/column.h"
+#include "common/config.h"
 #include "exec/pipeline/runtime_filter_types.h"
 #include "exprs/in_const_predicate.hpp"
 #include "exprs/literal.h"
@@ -34,7 +35,9 @@ namespace starrocks {
 
 // 0x1. initial global runtime filter impl
 // 0x2. change simd-block-filter hash function.
-static const uint8_t RF_VERSION = 0x2;
+// 0x3. fold and sparse encode simd-block-filter.
+// 0x4. dense bitset of runtime bloom filter.
+static const uint8_t RF_VERSION = 0x4;
 
 struct FilterBuilder {
     template <LogicalType ltype>
@@ -98,6 +101,46 @@ JoinRuntimeFilter* RuntimeFilterHelper::create_runtime_bloom_filter(ObjectPool*
     return filter;
 }
 
+struct DenseBitsetIniter {
+    template <LogicalType ltype>
+    bool operator()(JoinRuntimeFilter* expr, const Columns& columns, size_t column_offset, size_t row_count) {
+        auto* filter = down_cast<RuntimeBloomFilter<ltype>*>(expr);
+        if constexpr (RuntimeBloomFilter<ltype>::support_dense_bitset) {
+            using ColumnType = RunTimeColumnType<ltype>;
+            using CppType = RunTimeCppType<ltype>;
+            CppType min_value = RunTimeTypeLimits<ltype>::max_value();
+            CppType max_value = RunTimeTypeLimits<ltype>::min_value();
+            for (const auto& column : columns) {
+                const auto& data = ColumnHelper::as_raw_column<ColumnType>(ColumnHelper::get_data_column(column.get()))
+                                           ->get_data();
+                const uint8_t* nulls = nullptr;
+                if (column->is_nullable() && column->has_null()) {
+                    nulls = down_cast<const NullableColumn*>(column.get())->immutable_null_column_data().data();
+                }
+                for (size_t j = column_offset; j < data.size(); j++) {
+                    if (nulls == nullptr || !nulls[j]) {
+                        min_value = std::min(min_value, data[j]);
+                        max_value = std::max(max_value, data[j]);
+                    }
+                }
+            }
+            return filter->init_dense_bitset(row_count, min_value, max_value);
+        } else {
+            return false;
+        }
+    }
+};
+
+void RuntimeFilterHelper::init_runtime_bloom_filter(JoinRuntimeFilter* filter, LogicalType type,
+                                                    const Columns& columns, size_t column_offset, size_t row_count,
+                                                    bool allow_dense_bitset) {
+    if (allow_dense_bitset && config::enable_runtime_filter_dense_bitset &&
+        type_dispatch_filter(type, false, DenseBitsetIniter(), filter, columns, column_offset, row_count)) {
+        return;
+    }
+    filter->init(row_count);
+}
+
 struct FilterIniter {
     template <LogicalType ltype>
     auto operator()(const ColumnPtr& column, size_t column_offset, JoinRuntimeFilter* expr, bool eq_null) {
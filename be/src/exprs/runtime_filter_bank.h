@@ -53,6 +53,10 @@ public:
 
     // ====================================
     static JoinRuntimeFilter* create_runtime_bloom_filter(ObjectPool* pool, LogicalType type);
+    // Init |filter| for |row_count| rows. It becomes an exact bitset over [min, max] instead of a bloom filter if
+    // |allow_dense_bitset| and the non-null values of |columns| from |column_offset| are integers of a dense range.
+    static void init_runtime_bloom_filter(JoinRuntimeFilter* filter, LogicalType type, const Columns& columns,
+                                          size_t column_offset, size_t row_count, bool allow_dense_bitset);
     static Status fill_runtime_bloom_filter(const ColumnPtr& column, LogicalType type, JoinRuntimeFilter* filter,
                                             size_t column_offset, bool eq_null);
 
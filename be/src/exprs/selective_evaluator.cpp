@@ -0,0 +1,82 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "exprs/selective_evaluator.h"
+
+#include "column/chunk.h"
+#include "common/config.h"
+#include "exprs/expr.h"
+
+namespace starrocks {
+
+bool SelectiveEvaluator::_calls_function(const Expr* expr) {
+    switch (expr->node_type()) {
+    case TExprNodeType::FUNCTION_CALL:
+    case TExprNodeType::COMPUTE_FUNCTION_CALL:
+    case TExprNodeType::CASE_EXPR:
+    case TExprNodeType::LAMBDA_FUNCTION_EXPR:
+        return true;
+    default:
+        break;
+    }
+    for (const Expr* child : expr->children()) {
+        if (_calls_function(child)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SelectiveEvaluator::is_selective(const Expr* expr, const Chunk* chunk) {
+    if (!config::enable_selective_branch_evaluation || chunk == nullptr || chunk->num_rows() == 0 ||
+        expr->is_constant() || !_calls_function(expr)) {
+        return false;
+    }
+    std::vector<SlotId> slot_ids;
+    expr->get_slot_ids(&slot_ids);
+    if (slot_ids.empty()) {
+        return false;
+    }
+    for (SlotId id : slot_ids) {
+        if (!chunk->is_slot_exist(id)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SelectiveEvaluator::is_few_selected(size_t num_selected, const Chunk* chunk) {
+    return num_selected < kMaxSelectedRatio * static_cast<double>(chunk->num_rows());
+}
+
+StatusOr<ColumnPtr> SelectiveEvaluator::evaluate(ExprContext* context, Expr* expr, Chunk* chunk,
+                                                 const std::vector<uint32_t>& rows) {
+    std::vector<SlotId> slot_ids;
+    expr->get_slot_ids(&slot_ids);
+    Chunk selected;
+    for (SlotId id : slot_ids) {
+        if (selected.is_slot_exist(id)) {
+            continue;
+        }
+        const ColumnPtr& column = chunk->get_column_by_slot_id(id);
+        ColumnPtr selected_column = column->clone_empty();
+        selected_column->append_selective(*column, rows.data(), 0, rows.size());
+        selected.append_column(std::move(selected_column), id);
+    }
+    DCHECK_EQ(rows.size(), selected.num_rows());
+    return expr->evaluate_checked(context, &selected);
+}
+
+} // namespace starrocks
@@ -0,0 +1,55 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "common/statusor.h"
+
+namespace starrocks {
+
+class Expr;
+class ExprContext;
+
+// SelectiveEvaluator evaluates the branches of the conditional exprs, e.g. the THEN of CASE WHEN and IF, only on
+// the rows selected by their conditions instead of the whole chunk.
+//
+// Only the columns of the slots referenced by the branch are copied for the selected rows, so it's used for the
+// branches calling functions, which are much more expensive than the copying. The cheap branches, e.g. literals,
+// slots and arithmetic of them, are still evaluated on the whole chunk and merged by SIMD selectors.
+class SelectiveEvaluator {
+public:
+    // At most this ratio of the rows are selected to evaluate a branch on the selected rows.
+    static constexpr double kMaxSelectedRatio = 0.5;
+
+    // Whether |expr| is expensive enough to be evaluated on the selected rows of |chunk|, and all the slots it
+    // references are in |chunk|.
+    static bool is_selective(const Expr* expr, const Chunk* chunk);
+
+    // Whether |num_selected| rows of |chunk| are few enough to be evaluated selectively.
+    static bool is_few_selected(size_t num_selected, const Chunk* chunk);
+
+    // Evaluate |expr| on the |rows| of |chunk|, the i-th row of the result is the result of the row rows[i].
+    static StatusOr<ColumnPtr> evaluate(ExprContext* context, Expr* expr, Chunk* chunk,
+                                        const std::vector<uint32_t>& rows);
+
+private:
+    static bool _calls_function(const Expr* expr);
+};
+
+} // namespace starrocks
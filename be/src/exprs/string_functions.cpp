@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <memory>
 #include <stdexcept>
+#include <unordered_map>
 
 #include "column/binary_column.h"
 #include "column/column_builder.h"
@@ -2263,39 +2264,58 @@ static inline ColumnPtr concat_not_const(Columns const& columns) {
         return concat_not_const_small(list, num_rows, dst_bytes_max_size, is_const);
     }
 
+    // The upper bound is too large to be allocated up front, so compute the exact size of every result first,
+    // then copy the strings into the bytes of the exact size, rather than growing the bytes repeatedly.
     NullableBinaryColumnBuilder builder;
-    builder.resize(num_rows, std::min(dst_bytes_max_size, CONCAT_SMALL_OPTIMIZE_THRESHOLD));
+    auto& dst_nulls = builder.get_null_data();
+    auto& dst_offsets = builder.data_column()->get_offset();
+    auto& dst_bytes = builder.data_column()->get_bytes();
+    dst_nulls.resize(num_rows);
+    raw::make_room(&dst_offsets, num_rows + 1);
+    dst_offsets[0] = 0;
+
+    // first pass: compute offsets and nulls
+    size_t dst_off = 0;
+    bool has_null = false;
     for (int i = 0; i < num_rows; i++) {
         bool is_null = false;
+        size_t dst_slice_len = 0;
         for (auto& view : list) {
             if (view.is_null(i)) {
                 is_null = true;
-                builder.set_null(i);
+                break;
+            }
+            dst_slice_len += view.value(i).size;
+            if (UNLIKELY(dst_slice_len > OLAP_STRING_MAX_LENGTH)) {
+                // return NULL for an oversize result
+                is_null = true;
                 break;
             }
         }
         if (is_null) {
+            has_null = true;
+            dst_nulls[i] = 1;
+        } else {
+            dst_off += dst_slice_len;
+        }
+        dst_offsets[i + 1] = dst_off;
+    }
+
+    // second pass: copy the strings
+    dst_bytes.resize(dst_off);
+    auto* dst_begin = (uint8_t*)dst_bytes.data();
+    for (int i = 0; i < num_rows; i++) {
+        if (dst_nulls[i]) {
             continue;
         }
-        size_t dst_slice_len = 0;
-        bool oversize = false;
+        auto* dst = dst_begin + dst_offsets[i];
         for (auto& view : list) {
             auto v = view.value(i);
-            if (UNLIKELY(dst_slice_len + v.size > OLAP_STRING_MAX_LENGTH)) {
-                oversize = true;
-                break;
-            }
-            builder.append_partial((uint8_t*)v.data, (uint8_t*)v.data + v.size);
-            dst_slice_len += v.size;
-        }
-
-        if (UNLIKELY(oversize)) {
-            builder.rewind(dst_slice_len);
-            builder.set_null(i);
-        } else {
-            builder.append_complete(i);
+            strings::memcpy_inlined(dst, v.data, v.size);
+            dst += v.size;
         }
     }
+    builder.set_has_null(has_null);
     return builder.build(is_const);
 }
 /**
@@ -2519,11 +2539,21 @@ struct StringFunctionsState {
                                                     phmap::EqualTo<int32_t>, phmap::Allocator<int32_t>,
                                                     NUM_LOCK_SHARD_LOG, std::mutex>;
 
+    using RegexCache = std::unordered_map<std::string, std::unique_ptr<re2::RE2>>;
+    using DriverRegexCacheMap =
+            phmap::parallel_flat_hash_map<int32_t, std::unique_ptr<RegexCache>, phmap::Hash<int32_t>,
+                                          phmap::EqualTo<int32_t>, phmap::Allocator<int32_t>, NUM_LOCK_SHARD_LOG,
+                                          std::mutex>;
+    // The cached regexes of the non-constant patterns are dropped once there are more than this many of them.
+    static constexpr size_t kMaxCachedRegexes = 256;
+
     std::string pattern;
     std::unique_ptr<re2::RE2> regex;
     std::unique_ptr<re2::RE2::Options> options;
     bool const_pattern{false};
     DriverMap driver_regex_map; // regex for each pipeline_driver, to make it driver-local
+    // the compiled non-constant patterns of each pipeline driver
+    DriverRegexCacheMap driver_regex_cache_map;
 
     bool use_hyperscan = false;
     int size_of_pattern = -1;
@@ -2558,6 +2588,32 @@ struct StringFunctionsState {
         return res;
     }
 
+    // Return the regex of the non-constant |ptn|, which may be invalid. It's compiled once per pipeline driver,
+    // or once per |local_cache| if it's not called by a pipeline driver.
+    re2::RE2* get_or_compile_regex(const std::string& ptn, RegexCache* local_cache) {
+        RegexCache* cache = local_cache;
+        int32_t driver_id = CurrentThread::current().get_driver_id();
+        if (driver_id != 0) {
+            driver_regex_cache_map.lazy_emplace_l(
+                    driver_id, [&](auto& value) { cache = value.get(); },
+                    [&](auto build) {
+                        auto driver_cache = std::make_unique<RegexCache>();
+                        cache = driver_cache.get();
+                        build(driver_id, std::move(driver_cache));
+                    });
+        }
+        if (auto iter = cache->find(ptn); iter != cache->end()) {
+            return iter->second.get();
+        }
+        if (cache->size() >= kMaxCachedRegexes) {
+            cache->clear();
+        }
+        auto compiled = std::make_unique<re2::RE2>(ptn, *options);
+        auto* res = compiled.get();
+        cache->emplace(ptn, std::move(compiled));
+        return res;
+    }
+
     ~StringFunctionsState() {
         if (scratch != nullptr) {
             hs_free_scratch(scratch);
@@ -2679,13 +2735,14 @@ Status StringFunctions::regexp_close(FunctionContext* context, FunctionContext::
     return Status::OK();
 }
 
-static ColumnPtr regexp_extract_general(FunctionContext* context, re2::RE2::Options* options, const Columns& columns) {
+static ColumnPtr regexp_extract_general(FunctionContext* context, StringFunctionsState* state, const Columns& columns) {
     auto content_viewer = ColumnViewer<TYPE_VARCHAR>(columns[0]);
     auto ptn_viewer = ColumnViewer<TYPE_VARCHAR>(columns[1]);
     auto field_viewer = ColumnViewer<TYPE_BIGINT>(columns[2]);
 
     auto size = columns[0]->size();
     ColumnBuilder<TYPE_VARCHAR> result(size);
+    StringFunctionsState::RegexCache local_cache;
     for (int row = 0; row < size; ++row) {
         if (content_viewer.is_null(row) || ptn_viewer.is_null(row) || field_viewer.is_null(row)) {
             result.append_null();
@@ -2699,14 +2756,14 @@ static ColumnPtr regexp_extract_general(FunctionContext* context, re2::RE2::Opti
         }
 
         std::string ptn_value = ptn_viewer.value(row).to_string();
-        re2::RE2 local_re(ptn_value, *options);
-        if (!local_re.ok()) {
+        re2::RE2* local_re = state->get_or_compile_regex(ptn_value, &local_cache);
+        if (!local_re->ok()) {
             context->set_error(strings::Substitute("Invalid regex: $0", ptn_value).c_str());
             result.append_null();
             continue;
         }
 
-        int max_matches = 1 + local_re.NumberOfCapturingGroups();
+        int max_matches = 1 + local_re->NumberOfCapturingGroups();
         if (field_value >= max_matches) {
             result.append(Slice("", 0));
             continue;
@@ -2715,7 +2772,7 @@ static ColumnPtr regexp_extract_general(FunctionContext* context, re2::RE2::Opti
         auto str_value = content_viewer.value(row);
         re2::StringPiece str_sp(str_value.get_data(), str_value.get_size());
         std::vector<re2::StringPiece> matches(max_matches);
-        bool success = local_re.Match(str_sp, 0, str_value.get_size(), re2::RE2::UNANCHORED, &matches[0], max_matches);
+        bool success = local_re->Match(str_sp, 0, str_value.get_size(), re2::RE2::UNANCHORED, &matches[0], max_matches);
         if (!success) {
             result.append(Slice("", 0));
             continue;
@@ -2776,17 +2833,17 @@ StatusOr<ColumnPtr> StringFunctions::regexp_extract(FunctionContext* context, co
         return regexp_extract_const(const_re, columns);
     }
 
-    re2::RE2::Options* options = state->options.get();
-    return regexp_extract_general(context, options, columns);
+    return regexp_extract_general(context, state, columns);
 }
 
-static ColumnPtr regexp_replace_general(FunctionContext* context, re2::RE2::Options* options, const Columns& columns) {
+static ColumnPtr regexp_replace_general(FunctionContext* context, StringFunctionsState* state, const Columns& columns) {
     auto str_viewer = ColumnViewer<TYPE_VARCHAR>(columns[0]);
     auto ptn_viewer = ColumnViewer<TYPE_VARCHAR>(columns[1]);
     auto rpl_viewer = ColumnViewer<TYPE_VARCHAR>(columns[2]);
 
     auto size = columns[0]->size();
     ColumnBuilder<TYPE_VARCHAR> result(size);
+    StringFunctionsState::RegexCache local_cache;
     for (int row = 0; row < size; ++row) {
         if (str_viewer.is_null(row) || ptn_viewer.is_null(row) || rpl_viewer.is_null(row)) {
             result.append_null();
@@ -2794,8 +2851,8 @@ static ColumnPtr regexp_replace_general(FunctionContext* context, re2::RE2::Opti
         }
 
         std::string ptn_value = ptn_viewer.value(row).to_string();
-        re2::RE2 local_re(ptn_value, *options);
-        if (!local_re.ok()) {
+        re2::RE2* local_re = state->get_or_compile_regex(ptn_value, &local_cache);
+        if (!local_re->ok()) {
             context->set_error(strings::Substitute("Invalid regex: $0", ptn_value).c_str());
             result.append_null();
             continue;
@@ -2805,7 +2862,7 @@ static ColumnPtr regexp_replace_general(FunctionContext* context, re2::RE2::Opti
         re2::StringPiece rpl_str = re2::StringPiece(rpl_value.get_data(), rpl_value.get_size());
         auto str_value = str_viewer.value(row);
         std::string result_str(str_value.get_data(), str_value.get_size());
-        re2::RE2::GlobalReplace(&result_str, local_re, rpl_str);
+        re2::RE2::GlobalReplace(&result_str, *local_re, rpl_str);
         result.append(Slice(result_str.data(), result_str.size()));
     }
 
@@ -2916,8 +2973,7 @@ StatusOr<ColumnPtr> StringFunctions::regexp_replace(FunctionContext* context, co
         }
     }
 
-    re2::RE2::Options* options = state->options.get();
-    return regexp_replace_general(context, options, columns);
+    return regexp_replace_general(context, state, columns);
 }
 
 struct ReplaceState {
@@ -3013,6 +3069,11 @@ StatusOr<ColumnPtr> StringFunctions::replace(FunctionContext* context, const Col
     const auto rpl_viewer = ColumnViewer<TYPE_VARCHAR>(columns[2]);
 
     ColumnBuilder<TYPE_VARCHAR> result(num_rows);
+    // The result is no larger than the source if the replacement is not longer than the pattern, otherwise the
+    // source size is still a good estimation.
+    auto* src = down_cast<BinaryColumn*>(ColumnHelper::get_data_column(arg0.get()));
+    result.data_column()->reserve(num_rows, src->get_bytes().size());
+    std::string str;
     for (int row = 0; row < num_rows; ++row) {
         if (str_viewer.is_null(row) || (!state->const_pattern && ptn_viewer.is_null(row)) ||
             (!state->const_repl && rpl_viewer.is_null(row))) {
@@ -3026,7 +3087,8 @@ StatusOr<ColumnPtr> StringFunctions::replace(FunctionContext* context, const Col
             continue;
         }
 
-        std::string str = str_slice.to_string();
+        // reuse the buffer of the previous row
+        str.assign(str_slice.data, str_slice.size);
         replace_all(str, state->const_pattern ? state->pattern : ptn_viewer.value(row).to_string(),
                     state->const_repl ? state->repl : rpl_viewer.value(row).to_string());
         result.append(Slice(str.data(), str.size()));
@@ -20,6 +20,7 @@
 #include "column/nullable_column.h"
 #include "column/struct_column.h"
 #include "common/object_pool.h"
+#include "gutil/casts.h"
 
 namespace starrocks {
 
@@ -88,6 +89,8 @@ public:
 
     Expr* clone(ObjectPool* pool) const override { return pool->add(new SubfieldExpr(*this)); }
 
+    const std::vector<std::string>& used_subfield_names() const { return _used_subfield_names; }
+
 private:
     std::vector<std::string> _used_subfield_names;
 };
@@ -98,4 +101,9 @@ Expr* SubfieldExprFactory::from_thrift(const TExprNode& node) {
     return new SubfieldExpr(node);
 }
 
+const std::vector<std::string>& SubfieldExprFactory::used_subfield_names(const Expr* expr) {
+    DCHECK_EQ(TExprNodeType::SUBFIELD_EXPR, expr->node_type());
+    return down_cast<const SubfieldExpr*>(expr)->used_subfield_names();
+}
+
 } // namespace starrocks
\ No newline at end of file
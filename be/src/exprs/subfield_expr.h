@@ -21,6 +21,9 @@ namespace starrocks {
 class SubfieldExprFactory {
 public:
     static Expr* from_thrift(const TExprNode& node);
+
+    // The path of the subfield accessed by |expr|, which must be created by `from_thrift`.
+    static const std::vector<std::string>& used_subfield_names(const Expr* expr);
 };
 
 } // namespace starrocks
\ No newline at end of file
@@ -37,38 +37,12 @@ public:
         Column* arg0 = state->get_columns()[0].get();
         auto* col_array = down_cast<ArrayColumn*>(ColumnHelper::get_data_column(arg0));
         Columns result;
-        if (arg0->has_null()) {
-            auto* nullable_array_column = down_cast<NullableColumn*>(arg0);
-
-            auto offset_column = col_array->offsets_column();
-            ColumnPtr compacted_offset_column = offset_column->clone_empty();
-            compacted_offset_column->append_datum(Datum(0));
-
-            ColumnPtr compacted_array_elements = col_array->elements_column()->clone_empty();
-            int compact_offset = 0;
-
-            for (int row_idx = 0; row_idx < nullable_array_column->size(); ++row_idx) {
-                if (nullable_array_column->is_null(row_idx)) {
-                    compact_offset +=
-                            offset_column->get(row_idx + 1).get_int32() - offset_column->get(row_idx).get_int32();
-                    int32 offset = offset_column->get(row_idx + 1).get_int32();
-                    compacted_offset_column->append_datum(offset - compact_offset);
-                } else {
-                    int32 offset = offset_column->get(row_idx + 1).get_int32();
-                    compacted_offset_column->append_datum(offset - compact_offset);
-
-                    compacted_array_elements->append(
-                            *(col_array->elements_column()), offset_column->get(row_idx).get_int32(),
-                            offset_column->get(row_idx + 1).get_int32() - offset_column->get(row_idx).get_int32());
-                }
-            }
-
-            result.emplace_back(compacted_array_elements);
-            return std::make_pair(result, compacted_offset_column);
-        } else {
-            result.emplace_back(col_array->elements_column());
-            return std::make_pair(result, col_array->offsets_column());
+        if (arg0->has_null() && _null_rows_have_elements(down_cast<NullableColumn*>(arg0), col_array)) {
+            return _compact_null_rows(down_cast<NullableColumn*>(arg0), col_array);
         }
+        // The elements and the offsets are returned as is, no element is copied.
+        result.emplace_back(col_array->elements_column());
+        return std::make_pair(result, col_array->offsets_column());
     }
 
     class UnnestState : public TableFunctionState {
@@ -91,6 +65,53 @@ public:
         delete state;
         return Status::OK();
     }
+
+private:
+    // The null arrays are usually empty, then they are expanded to no row without compacting the elements.
+    static bool _null_rows_have_elements(const NullableColumn* nullable_array_column, const ArrayColumn* col_array) {
+        const auto& nulls = nullable_array_column->immutable_null_column_data();
+        const auto& offsets = col_array->offsets().get_data();
+        for (size_t row_idx = 0; row_idx < nulls.size(); ++row_idx) {
+            if (nulls[row_idx] && offsets[row_idx + 1] != offsets[row_idx]) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Remove the elements of the null arrays, the elements of the consecutive non-null arrays are copied at once.
+    static std::pair<Columns, ColumnPtr> _compact_null_rows(const NullableColumn* nullable_array_column,
+                                                            ArrayColumn* col_array) {
+        const auto& nulls = nullable_array_column->immutable_null_column_data();
+        const auto& offsets = col_array->offsets().get_data();
+        const ColumnPtr& elements = col_array->elements_column();
+
+        auto compacted_offset_column = UInt32Column::create();
+        auto& compacted_offsets = compacted_offset_column->get_data();
+        compacted_offsets.resize(nulls.size() + 1);
+        compacted_offsets[0] = 0;
+        ColumnPtr compacted_array_elements = elements->clone_empty();
+
+        uint32_t range_begin = 0;
+        uint32_t range_end = 0;
+        for (size_t row_idx = 0; row_idx < nulls.size(); ++row_idx) {
+            uint32_t length = nulls[row_idx] ? 0 : offsets[row_idx + 1] - offsets[row_idx];
+            compacted_offsets[row_idx + 1] = compacted_offsets[row_idx] + length;
+            if (length == 0) {
+                continue;
+            }
+            if (offsets[row_idx] != range_end) {
+                compacted_array_elements->append(*elements, range_begin, range_end - range_begin);
+                range_begin = offsets[row_idx];
+            }
+            range_end = offsets[row_idx + 1];
+        }
+        compacted_array_elements->append(*elements, range_begin, range_end - range_begin);
+
+        Columns result;
+        result.emplace_back(std::move(compacted_array_elements));
+        return std::make_pair(std::move(result), std::move(compacted_offset_column));
+    }
 };
 
 } // namespace starrocks
@@ -14,6 +14,8 @@
 
 #include "exprs/time_functions.h"
 
+#include <algorithm>
+#include <limits>
 #include <string_view>
 
 #include "column/column_helper.h"
@@ -147,6 +149,8 @@ Status TimeFunctions::convert_tz_prepare(FunctionContext* context, FunctionConte
         return Status::OK();
     }
 
+    ctc->from_transitions = std::make_unique<TimezoneTransitions>(ctc->from_tz);
+    ctc->to_transitions = std::make_unique<TimezoneTransitions>(ctc->to_tz);
     ctc->is_valid = true;
     return Status::OK();
 }
@@ -218,17 +222,54 @@ StatusOr<ColumnPtr> TimeFunctions::convert_tz_general(FunctionContext* context,
 }
 
 StatusOr<ColumnPtr> TimeFunctions::convert_tz_const(FunctionContext* context, const Columns& columns,
-                                                    const cctz::time_zone& from, const cctz::time_zone& to) {
+                                                    const cctz::time_zone& from, const cctz::time_zone& to,
+                                                    const TimezoneTransitions& from_transitions,
+                                                    const TimezoneTransitions& to_transitions) {
     auto time_viewer = ColumnViewer<TYPE_DATETIME>(columns[0]);
 
     auto size = columns[0]->size();
+    // the civil seconds of the rows in the from time zone
+    std::vector<int64_t> seconds(size);
+    int64_t min_seconds = std::numeric_limits<int64_t>::max();
+    int64_t max_seconds = std::numeric_limits<int64_t>::min();
+    for (int row = 0; row < size; ++row) {
+        seconds[row] = time_viewer.value(row).to_unix_second();
+        if (!time_viewer.is_null(row)) {
+            min_seconds = std::min(min_seconds, seconds[row]);
+            max_seconds = std::max(max_seconds, seconds[row]);
+        }
+    }
+
     ColumnBuilder<TYPE_DATETIME> result(size);
+    // fast path: no transition of both time zones in the range, so all the rows are shifted by the same offset
+    int64_t from_offset = from_transitions.local_offset(min_seconds);
+    if (min_seconds <= max_seconds && TimezoneTransitions::contains(min_seconds - from_offset) &&
+        TimezoneTransitions::contains(max_seconds - from_offset) &&
+        from_transitions.same_local_offset(min_seconds, max_seconds) &&
+        to_transitions.same_utc_offset(min_seconds - from_offset, max_seconds - from_offset)) {
+        int64_t offset = to_transitions.utc_offset(min_seconds - from_offset) - from_offset;
+        TimestampValue ts;
+        for (int row = 0; row < size; ++row) {
+            ts.from_unix_second(seconds[row] + offset);
+            result.append(ts, time_viewer.is_null(row));
+        }
+        return result.build(ColumnHelper::is_all_const(columns));
+    }
+
     for (int row = 0; row < size; ++row) {
         if (time_viewer.is_null(row)) {
             result.append_null();
             continue;
         }
 
+        int64_t utc = from_transitions.to_utc(seconds[row]);
+        if (TimezoneTransitions::contains(seconds[row]) && TimezoneTransitions::contains(utc)) {
+            TimestampValue ts;
+            ts.from_unix_second(utc + to_transitions.utc_offset(utc));
+            result.append(ts);
+            continue;
+        }
+
         auto datetime_value = time_viewer.value(row);
 
         int year, month, day, hour, minute, second, usec;
@@ -267,7 +308,8 @@ StatusOr<ColumnPtr> TimeFunctions::convert_tz(FunctionContext* context, const Co
         return ColumnHelper::create_const_null_column(columns[0]->size());
     }
 
-    return convert_tz_const(context, columns, ctc->from_tz, ctc->to_tz);
+    return convert_tz_const(context, columns, ctc->from_tz, ctc->to_tz, *ctc->from_transitions,
+                            *ctc->to_transitions);
 }
 
 StatusOr<ColumnPtr> TimeFunctions::utc_timestamp(FunctionContext* context, const Columns& columns) {
@@ -962,6 +1004,7 @@ StatusOr<ColumnPtr> TimeFunctions::to_unix_from_datetime(FunctionContext* contex
     DCHECK_EQ(columns.size(), 1);
 
     auto date_viewer = ColumnViewer<TYPE_DATETIME>(columns[0]);
+    const auto& transitions = context->state()->timezone_transitions();
 
     auto size = columns[0]->size();
     ColumnBuilder<TYPE_INT> result(size);
@@ -973,11 +1016,18 @@ StatusOr<ColumnPtr> TimeFunctions::to_unix_from_datetime(FunctionContext* contex
 
         auto date = date_viewer.value(row);
 
+        int64_t timestamp = transitions.to_utc(date.to_unix_second());
+        if (TimezoneTransitions::contains(date.to_unix_second()) && TimezoneTransitions::contains(timestamp)) {
+            timestamp = timestamp < 0 ? 0 : timestamp;
+            timestamp = timestamp > INT_MAX ? 0 : timestamp;
+            result.append(timestamp);
+            continue;
+        }
+
         int year, month, day, hour, minute, second, usec;
         date.to_timestamp(&year, &month, &day, &hour, &minute, &second, &usec);
         DateTimeValue tv(TIME_DATETIME, year, month, day, hour, minute, second, usec);
 
-        int64_t timestamp;
         if (!tv.unix_timestamp(&timestamp, context->state()->timezone_obj())) {
             result.append_null();
         } else {
@@ -1084,6 +1134,8 @@ StatusOr<ColumnPtr> TimeFunctions::from_unix_to_datetime(FunctionContext* contex
     RETURN_IF_COLUMNS_ONLY_NULL(columns);
 
     ColumnViewer<TYPE_INT> data_column(columns[0]);
+    // the unix seconds in [0, INT_MAX] are all precomputed
+    const auto& transitions = context->state()->timezone_transitions();
 
     auto size = columns[0]->size();
     ColumnBuilder<TYPE_VARCHAR> result(size);
@@ -1099,14 +1151,11 @@ StatusOr<ColumnPtr> TimeFunctions::from_unix_to_datetime(FunctionContext* contex
             continue;
         }
 
-        DateTimeValue dtv;
-        if (!dtv.from_unixtime(date, context->state()->timezone_obj())) {
-            result.append_null();
-            continue;
-        }
+        TimestampValue ts;
+        ts.from_unix_second(date + transitions.utc_offset(date));
         char buf[64];
-        dtv.to_string(buf);
-        result.append(Slice(buf));
+        int len = ts.to_string(buf, sizeof(buf));
+        result.append(Slice(buf, len));
     }
 
     return result.build(ColumnHelper::is_all_const(columns));
@@ -20,6 +20,7 @@
 #include "exprs/function_context.h"
 #include "exprs/function_helper.h"
 #include "util/timezone_hsscan.h"
+#include "util/timezone_transitions.h"
 
 namespace starrocks {
 
@@ -613,7 +614,9 @@ private:
     static StatusOr<ColumnPtr> convert_tz_general(FunctionContext* context, const Columns& columns);
 
     static StatusOr<ColumnPtr> convert_tz_const(FunctionContext* context, const Columns& columns,
-                                                const cctz::time_zone& from, const cctz::time_zone& to);
+                                                const cctz::time_zone& from, const cctz::time_zone& to,
+                                                const TimezoneTransitions& from_transitions,
+                                                const TimezoneTransitions& to_transitions);
 
 public:
     static TimestampValue start_of_time_slice;
@@ -646,6 +649,8 @@ private:
         bool is_valid = false;
         cctz::time_zone from_tz;
         cctz::time_zone to_tz;
+        std::unique_ptr<TimezoneTransitions> from_transitions;
+        std::unique_ptr<TimezoneTransitions> to_transitions;
     };
 
     struct FormatCtx {
@@ -111,6 +111,7 @@ char* CSVReader::escapeDataPtr() {
 Status CSVReader::buffInit() {
 #ifndef CSVBENCHMARK
     _buff.compact();
+    _invalidate_index();
     if (_buff.free_space() > 0) {
         return _fill_buffer();
     }
@@ -535,6 +536,7 @@ Status CSVReader::next_record(Record* record) {
     while ((d = _buff.find(_parse_options.row_delimiter, pos)) == nullptr) {
         pos = _buff.available();
         _buff.compact();
+        _invalidate_index();
         if (_buff.free_space() == 0) {
             RETURN_IF_ERROR(_expand_buffer());
         }
@@ -549,6 +551,65 @@ Status CSVReader::next_record(Record* record) {
     return Status::OK();
 }
 
+Status CSVReader::next_record(Record* record, Fields* fields) {
+    if (_limit > 0 && _parsed_bytes > _limit) {
+        return Status::EndOfFile("Reached limit");
+    }
+    const size_t num_fields = fields->size();
+    size_t window = kIndexWindowSize;
+    while (true) {
+        const char* base = _buff.base_ptr();
+        const size_t start = _buff.position_offset();
+        // Skip the structurals consumed by the other ways of reading.
+        while (_next_structural < _structurals.size() && _structurals[_next_structural].offset < start) {
+            _next_structural++;
+        }
+        size_t field_start = start;
+        for (size_t i = _next_structural; i < _structurals.size(); i++) {
+            const CSVStructural& s = _structurals[i];
+            _append_field(base + field_start, s.offset - field_start, fields);
+            if (s.row_delimiter) {
+                *record = Record(base + start, s.offset - start);
+                _next_structural = i + 1;
+                _buff.skip(s.offset - start + _row_delimiter_length);
+                _parsed_bytes += s.offset - start + _row_delimiter_length;
+                return Status::OK();
+            }
+            field_start = s.offset + _column_delimiter_length;
+        }
+        fields->resize(num_fields);
+
+        // No complete record in the indexed bytes, read more if all the bytes have been indexed,
+        // otherwise index more bytes.
+        if (_buff.limit_offset() == _indexed_limit) {
+            _buff.compact();
+            _invalidate_index();
+            if (_buff.free_space() == 0) {
+                RETURN_IF_ERROR(_expand_buffer());
+            }
+            RETURN_IF_ERROR(_fill_buffer());
+        }
+        _index_buffer(std::min(_buff.limit_offset(), _buff.position_offset() + window));
+        window *= 2;
+    }
+}
+
+void CSVReader::_index_buffer(size_t to) {
+    _structurals.clear();
+    _next_structural = 0;
+    _indexer.index(_buff.base_ptr(), _buff.position_offset(), to, &_structurals);
+    _indexed_limit = to;
+}
+
+inline void CSVReader::_append_field(const char* data, size_t size, Fields* fields) const {
+    if (_parse_options.trim_space && size > 0) {
+        std::pair<const char*, size_t> newPos = trim(data, size);
+        fields->emplace_back(newPos.first, newPos.second);
+    } else {
+        fields->emplace_back(data, size);
+    }
+}
+
 Status CSVReader::_expand_buffer() {
     if (UNLIKELY(_storage.size() >= kMaxBufferSize)) {
         return Status::InternalError("CSV line length exceed limit " + std::to_string(kMaxBufferSize));
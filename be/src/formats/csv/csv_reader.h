@@ -14,10 +14,12 @@
 
 #pragma once
 
+#include <limits>
 #include <queue>
 #include <unordered_set>
 
 #include "formats/csv/converter.h"
+#include "formats/csv/csv_structural_index.h"
 
 namespace starrocks {
 class CSVBuffer {
@@ -160,6 +162,8 @@ class CSVReader {
     constexpr static size_t kMinBufferSize = 128 * 1024L;
     constexpr static size_t kMaxBufferSize = 512 * 1024L;
 #endif
+    // The bytes indexed at a time, to bound the memory of the structural index.
+    constexpr static size_t kIndexWindowSize = 256 * 1024L;
 
 public:
     using Record = Slice;
@@ -167,7 +171,10 @@ public:
     using Fields = std::vector<Field>;
 
     CSVReader(const CSVParseOptions& parse_options, const size_t bufferSize = kMinBufferSize)
-            : _parse_options(parse_options), _storage(bufferSize), _buff(_storage.data(), _storage.size()) {
+            : _parse_options(parse_options),
+              _storage(bufferSize),
+              _buff(_storage.data(), _storage.size()),
+              _indexer(parse_options.row_delimiter, parse_options.column_delimiter) {
         _row_delimiter_length = parse_options.row_delimiter.size();
         _column_delimiter_length = parse_options.column_delimiter.size();
     }
@@ -178,6 +185,11 @@ public:
 
     Status next_record(CSVRow& row);
 
+    // Same as next_record(Record*) followed by split_record, but the fields are located by the structural index
+    // of the whole buffer, instead of searching the delimiters record by record.
+    // |fields| are appended, and valid until the next call.
+    Status next_record(Record* record, Fields* fields);
+
     Status more_rows();
 
     void set_limit(size_t limit) { _limit = limit; }
@@ -215,6 +227,22 @@ private:
     Status _expand_buffer();
     Status _expand_buffer_loosely();
 
+    // Index the bytes between the current position and |to|.
+    void _index_buffer(size_t to);
+    // Must be called once the buffer is compacted.
+    void _invalidate_index() {
+        _structurals.clear();
+        _next_structural = 0;
+        _indexed_limit = std::numeric_limits<size_t>::max();
+    }
+    void _append_field(const char* data, size_t size, Fields* fields) const;
+
+    CSVStructuralIndexer _indexer;
+    std::vector<CSVStructural> _structurals;
+    size_t _next_structural = 0;
+    // The end offset of the indexed bytes.
+    size_t _indexed_limit = std::numeric_limits<size_t>::max();
+
     size_t _parsed_bytes = 0;
     size_t _limit = 0;
 };
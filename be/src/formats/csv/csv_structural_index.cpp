@@ -0,0 +1,147 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "formats/csv/csv_structural_index.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#ifdef __AVX2__
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "common/logging.h"
+
+namespace starrocks {
+
+static constexpr size_t kBlockSize = 64;
+
+// The bitmask of the bytes equal to |c| in the 64 bytes starting at |p|.
+static inline uint64_t equal_mask(const char* p, char c) {
+#ifdef __AVX2__
+    const __m256i v = _mm256_set1_epi8(c);
+    auto lo = static_cast<uint32_t>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)), v)));
+    auto hi = static_cast<uint32_t>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32)), v)));
+    return static_cast<uint64_t>(lo) | (static_cast<uint64_t>(hi) << 32);
+#elif defined(__SSE2__)
+    const __m128i v = _mm_set1_epi8(c);
+    uint64_t mask = 0;
+    for (int i = 0; i < 4; i++) {
+        auto m = static_cast<uint16_t>(
+                _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i * 16)), v)));
+        mask |= static_cast<uint64_t>(m) << (i * 16);
+    }
+    return mask;
+#else
+    uint64_t mask = 0;
+    for (size_t i = 0; i < kBlockSize; i++) {
+        mask |= static_cast<uint64_t>(p[i] == c) << i;
+    }
+    return mask;
+#endif
+}
+
+// Bit i of the result is the xor of the bits [0, i] of |x|.
+static inline uint64_t prefix_xor(uint64_t x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+CSVStructuralIndexer::CSVStructuralIndexer(std::string row_delimiter, std::string column_delimiter, char enclose)
+        : _row_delimiter(std::move(row_delimiter)), _column_delimiter(std::move(column_delimiter)), _enclose(enclose) {
+    DCHECK(!_row_delimiter.empty());
+    DCHECK(!_column_delimiter.empty());
+}
+
+inline bool CSVStructuralIndexer::_match(const char* data, size_t pos, size_t to, const std::string& delimiter) const {
+    return pos + delimiter.size() <= to && memcmp(data + pos, delimiter.data(), delimiter.size()) == 0;
+}
+
+bool CSVStructuralIndexer::_cross_row_delimiter(const char* data, size_t pos, size_t next_row, size_t to) const {
+    for (size_t p = std::max(pos + 1, next_row); p < pos + _column_delimiter.size(); p++) {
+        if (_match(data, p, to, _row_delimiter)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void CSVStructuralIndexer::index(const char* data, size_t from, size_t to,
+                                 std::vector<CSVStructural>* structurals) const {
+    const char row_first = _row_delimiter[0];
+    const char column_first = _column_delimiter[0];
+    const bool single_char = _row_delimiter.size() == 1 && _column_delimiter.size() == 1;
+    // All ones if the previous block ends inside the enclose characters.
+    uint64_t prev_in_enclose = 0;
+    // The row delimiters and column delimiters are matched separately and must not overlap the previous ones.
+    size_t next_row = from;
+    size_t next_column = from;
+    char tail[kBlockSize];
+
+    for (size_t block = from; block < to; block += kBlockSize) {
+        const char* p = data + block;
+        const size_t n = std::min(kBlockSize, to - block);
+        uint64_t valid = ~0ULL;
+        if (n < kBlockSize) {
+            memset(tail, 0, kBlockSize);
+            memcpy(tail, p, n);
+            p = tail;
+            valid = (1ULL << n) - 1;
+        }
+
+        // Pass 1: classify the bytes into bitmasks.
+        uint64_t row_mask = equal_mask(p, row_first) & valid;
+        uint64_t column_mask = row_first == column_first ? row_mask : equal_mask(p, column_first) & valid;
+        if (_enclose != 0) {
+            uint64_t in_enclose = prefix_xor(equal_mask(p, _enclose) & valid) ^ prev_in_enclose;
+            prev_in_enclose = static_cast<uint64_t>(static_cast<int64_t>(in_enclose) >> 63);
+            row_mask &= ~in_enclose;
+            column_mask &= ~in_enclose;
+        }
+
+        // Pass 2: extract the delimiters from the bitmasks.
+        if (single_char) {
+            for (uint64_t candidates = row_mask | column_mask; candidates != 0; candidates &= candidates - 1) {
+                const size_t offset = block + __builtin_ctzll(candidates);
+                structurals->push_back({offset, (row_mask >> (offset - block) & 1) != 0});
+            }
+            continue;
+        }
+        for (uint64_t candidates = row_mask | column_mask; candidates != 0; candidates &= candidates - 1) {
+            const size_t bit = __builtin_ctzll(candidates);
+            const size_t offset = block + bit;
+            if ((row_mask >> bit & 1) && offset >= next_row && _match(data, offset, to, _row_delimiter)) {
+                structurals->push_back({offset, true});
+                next_row = next_column = offset + _row_delimiter.size();
+                continue;
+            }
+            if ((column_mask >> bit & 1) && offset >= next_column && _match(data, offset, to, _column_delimiter) &&
+                !_cross_row_delimiter(data, offset, next_row, to)) {
+                structurals->push_back({offset, false});
+                next_column = offset + _column_delimiter.size();
+            }
+        }
+    }
+}
+
+} // namespace starrocks
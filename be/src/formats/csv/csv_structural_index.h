@@ -0,0 +1,57 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace starrocks {
+
+// The position of a column delimiter or a row delimiter in the csv data.
+struct CSVStructural {
+    size_t offset;
+    bool row_delimiter;
+};
+
+// CSVStructuralIndexer locates all the column delimiters and row delimiters of a buffer at once.
+//
+// It works in two passes like simdcsv. The first pass compares 64 bytes at a time with the first characters of the
+// delimiters by SIMD, producing the bitmasks of the candidate positions, and the candidates between a pair of the
+// enclose characters are masked out by the prefix xor of the enclose bitmask. The second pass walks the bits of the
+// candidates, verifies the remaining characters of the multi-char delimiters and emits the structurals in order.
+//
+// The delimiters are matched the same as CSVReader::next_record(Record*) followed by CSVReader::split_record: the
+// row delimiters are matched first, and a column delimiter never crosses a row delimiter.
+class CSVStructuralIndexer {
+public:
+    // The delimiters must not be empty, the enclose character is ignored if it's 0.
+    CSVStructuralIndexer(std::string row_delimiter, std::string column_delimiter, char enclose = 0);
+
+    // Append the structurals of data[from, to) to |structurals|, where |from| must be the start of a record.
+    // The offsets of the structurals are relative to |data|, and the delimiters crossing |to| are not emitted.
+    void index(const char* data, size_t from, size_t to, std::vector<CSVStructural>* structurals) const;
+
+private:
+    bool _match(const char* data, size_t pos, size_t to, const std::string& delimiter) const;
+    // Whether a row delimiter not before |next_row| starts in (pos, pos + column delimiter length).
+    bool _cross_row_delimiter(const char* data, size_t pos, size_t next_row, size_t to) const;
+
+    const std::string _row_delimiter;
+    const std::string _column_delimiter;
+    const char _enclose;
+};
+
+} // namespace starrocks
@@ -16,6 +16,7 @@
 
 #include "column/fixed_length_column.h"
 #include "common/logging.h"
+#include "util/fixed_layout_parser.h"
 #include "util/string_parser.hpp"
 
 namespace starrocks::csv {
@@ -39,6 +40,11 @@ Status NumericConverter<T>::write_quoted_string(OutputStream* os, const Column&
 
 template <typename T>
 bool NumericConverter<T>::read_string(Column* column, Slice s, const Options& options) const {
+    DataType value;
+    if (FixedLayoutParser::parse_int(s.data, s.size, &value)) {
+        down_cast<FixedLengthColumn<DataType>*>(column)->append(value);
+        return true;
+    }
     StringParser::ParseResult r;
     auto v = StringParser::string_to_int<DataType>(s.data, s.size, &r);
     if (r == StringParser::PARSE_SUCCESS) {
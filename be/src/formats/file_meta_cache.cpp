@@ -0,0 +1,107 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "formats/file_meta_cache.h"
+
+#include <algorithm>
+
+#include "common/config.h"
+#include "formats/parquet/metadata.h"
+
+namespace starrocks {
+
+FileMetaCache* FileMetaCache::instance() {
+    static FileMetaCache s_cache(std::max<int64_t>(config::file_meta_cache_capacity, 0));
+    s_cache.set_capacity(std::max<int64_t>(config::file_meta_cache_capacity, 0));
+    return &s_cache;
+}
+
+FileMetaCache::FileMetaCache(size_t capacity) : _capacity(capacity), _cache(new_lru_cache(capacity)) {}
+
+FileMetaCache::~FileMetaCache() = default;
+
+std::string FileMetaCache::cache_key(const std::string& path, int64_t file_size, int64_t modification_time) {
+    std::string key(path);
+    key.append(reinterpret_cast<const char*>(&file_size), sizeof(file_size));
+    key.append(reinterpret_cast<const char*>(&modification_time), sizeof(modification_time));
+    return key;
+}
+
+void FileMetaCache::set_capacity(size_t capacity) {
+    if (_capacity.exchange(capacity, std::memory_order_relaxed) != capacity) {
+        _cache->set_capacity(capacity);
+    }
+}
+
+void FileMetaCache::_insert(const std::string& key, CacheValue* value, size_t charge) {
+    if (!enabled()) {
+        delete value;
+        return;
+    }
+    Cache::Handle* handle = _cache->insert(CacheKey(key), value, charge, cache_value_deleter);
+    if (handle == nullptr) {
+        delete value;
+    } else {
+        _cache->release(handle);
+    }
+}
+
+template <typename T>
+T FileMetaCache::_lookup(const std::string& key) {
+    if (!enabled()) {
+        return nullptr;
+    }
+    Cache::Handle* handle = _cache->lookup(CacheKey(key));
+    if (handle == nullptr) {
+        return nullptr;
+    }
+    const auto* value = static_cast<CacheValue*>(_cache->value(handle));
+    T result = std::holds_alternative<T>(*value) ? std::get<T>(*value) : nullptr;
+    _cache->release(handle);
+    return result;
+}
+
+static std::string parquet_meta_key(const std::string& key, bool case_sensitive) {
+    return key + (case_sensitive ? "/parquet/case_sensitive" : "/parquet");
+}
+
+FileMetaCache::ParquetMetaPtr FileMetaCache::lookup_parquet_meta(const std::string& key, bool case_sensitive) {
+    return _lookup<ParquetMetaPtr>(parquet_meta_key(key, case_sensitive));
+}
+
+void FileMetaCache::insert_parquet_meta(const std::string& key, bool case_sensitive, ParquetMetaPtr meta,
+                                        size_t charge) {
+    _insert(parquet_meta_key(key, case_sensitive), new CacheValue(std::move(meta)), charge);
+}
+
+FileMetaCache::OrcTailPtr FileMetaCache::lookup_orc_tail(const std::string& key) {
+    return _lookup<OrcTailPtr>(key + "/orc");
+}
+
+void FileMetaCache::insert_orc_tail(const std::string& key, std::string tail) {
+    size_t charge = tail.size();
+    _insert(key + "/orc", new CacheValue(std::make_shared<const std::string>(std::move(tail))), charge);
+}
+
+FileMetaCache::PositionDeletesPtr FileMetaCache::lookup_position_deletes(const std::string& key) {
+    return _lookup<PositionDeletesPtr>(key + "/position_deletes");
+}
+
+void FileMetaCache::insert_position_deletes(const std::string& key, PositionDeletesPtr deletes) {
+    size_t charge = deletes->getSizeInBytes();
+    _insert(key + "/position_deletes", new CacheValue(std::move(deletes)), charge);
+}
+
+} // namespace starrocks
@@ -0,0 +1,87 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <roaring/roaring.hh>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <variant>
+
+#include "util/lru_cache.h"
+
+namespace starrocks {
+
+namespace parquet {
+class FileMetaData;
+} // namespace parquet
+
+// FileMetaCache caches the parsed footers of the parquet files and the serialized tails of the orc files, so that
+// the scan ranges and the queries reading the same files don't read and parse the footers again and again.
+// It caches the deleted positions of the iceberg data files too, which are parsed from the position delete files.
+//
+// The entries are keyed by the path, the size and the modification time of the files, a rewritten file has a
+// different key, and its stale entry is evicted by LRU at last. The cache is disabled if the capacity is 0.
+class FileMetaCache {
+public:
+    using ParquetMetaPtr = std::shared_ptr<parquet::FileMetaData>;
+    using OrcTailPtr = std::shared_ptr<const std::string>;
+    using PositionDeletesPtr = std::shared_ptr<const Roaring>;
+
+    // The global instance, whose capacity follows config::file_meta_cache_capacity.
+    static FileMetaCache* instance();
+
+    explicit FileMetaCache(size_t capacity);
+    ~FileMetaCache();
+
+    // The key identifying the meta of a file, |modification_time| is 0 if the file is never rewritten.
+    static std::string cache_key(const std::string& path, int64_t file_size, int64_t modification_time);
+
+    bool enabled() const { return _capacity.load(std::memory_order_relaxed) > 0; }
+
+    void set_capacity(size_t capacity);
+
+    // The schema of the parsed footer depends on |case_sensitive|.
+    ParquetMetaPtr lookup_parquet_meta(const std::string& key, bool case_sensitive);
+    // |charge| is the estimated memory of |meta|.
+    void insert_parquet_meta(const std::string& key, bool case_sensitive, ParquetMetaPtr meta, size_t charge);
+
+    OrcTailPtr lookup_orc_tail(const std::string& key);
+    void insert_orc_tail(const std::string& key, std::string tail);
+
+    // |key| identifies a data file and all the delete files applied to it.
+    PositionDeletesPtr lookup_position_deletes(const std::string& key);
+    void insert_position_deletes(const std::string& key, PositionDeletesPtr deletes);
+
+    size_t memory_usage() const { return _cache->get_memory_usage(); }
+    size_t lookup_count() const { return _cache->get_lookup_count(); }
+    size_t hit_count() const { return _cache->get_hit_count(); }
+
+private:
+    using CacheValue = std::variant<ParquetMetaPtr, OrcTailPtr, PositionDeletesPtr>;
+
+    static void cache_value_deleter(const CacheKey& /*key*/, void* value) { delete static_cast<CacheValue*>(value); }
+
+    void _insert(const std::string& key, CacheValue* value, size_t charge);
+    template <typename T>
+    T _lookup(const std::string& key);
+
+    std::atomic<size_t> _capacity;
+    std::unique_ptr<Cache> _cache;
+};
+
+} // namespace starrocks
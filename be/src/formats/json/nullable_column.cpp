@@ -378,6 +378,53 @@ Status add_adaptive_nullable_column(Column* column, const TypeDescriptor& type_d
     }
 }
 
+template <Status (*AddValue)(Column*, const TypeDescriptor&, const std::string&, simdjson::ondemand::value*)>
+static Status add_adaptive_nullable_value(Column* column, const TypeDescriptor& type_desc, const std::string& name,
+                                          simdjson::ondemand::value* value, bool invalid_as_null) {
+    try {
+        if (value->is_null()) {
+            column->append_nulls(1);
+            return Status::OK();
+        }
+
+        auto st = AddValue(column, type_desc, name, value);
+        if (!st.ok() && invalid_as_null) {
+            column->append_nulls(1);
+            return Status::OK();
+        }
+        return st;
+
+    } catch (simdjson::simdjson_error& e) {
+        auto err_msg = strings::Substitute("Failed to parse value, column=$0, error=$1", name,
+                                           simdjson::error_message(e.error()));
+        return Status::DataQualityError(err_msg);
+    }
+}
+
+JsonValueAppender get_adaptive_nullable_column_appender(const TypeDescriptor& type_desc) {
+    // Keep in accord with add_adpative_nullable_column.
+    switch (type_desc.type) {
+    case TYPE_BIGINT:
+        return add_adaptive_nullable_value<add_adaptive_nullable_numeric_column<int64_t>>;
+    case TYPE_INT:
+        return add_adaptive_nullable_value<add_adaptive_nullable_numeric_column<int32_t>>;
+    case TYPE_SMALLINT:
+        return add_adaptive_nullable_value<add_adaptive_nullable_numeric_column<int16_t>>;
+    case TYPE_TINYINT:
+        return add_adaptive_nullable_value<add_adaptive_nullable_numeric_column<int8_t>>;
+    case TYPE_DOUBLE:
+        return add_adaptive_nullable_value<add_adaptive_nullable_numeric_column<double>>;
+    case TYPE_FLOAT:
+        return add_adaptive_nullable_value<add_adaptive_nullable_numeric_column<float>>;
+    case TYPE_JSON:
+        return add_adaptive_nullable_value<add_adpative_nullable_native_json_column>;
+    case TYPE_ARRAY:
+        return add_adaptive_nullable_column;
+    default:
+        return add_adaptive_nullable_value<add_adpative_nullable_binary_column>;
+    }
+}
+
 Status add_nullable_column(Column* column, const TypeDescriptor& type_desc, const std::string& name,
                            simdjson::ondemand::value* value, bool invalid_as_null) {
     try {
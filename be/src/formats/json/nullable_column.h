@@ -31,6 +31,13 @@ Status add_nullable_column(Column* column, const TypeDescriptor& type_desc, cons
 Status add_adaptive_nullable_column(Column* column, const TypeDescriptor& type_desc, const std::string& name,
                                     simdjson::ondemand::value* value, bool invalid_as_null);
 
+// JsonValueAppender appends a json value to an adaptive nullable column of a specific type, the same as
+// add_adaptive_nullable_column, but the type is dispatched only once by get_adaptive_nullable_column_appender.
+using JsonValueAppender = Status (*)(Column* column, const TypeDescriptor& type_desc, const std::string& name,
+                                     simdjson::ondemand::value* value, bool invalid_as_null);
+
+JsonValueAppender get_adaptive_nullable_column_appender(const TypeDescriptor& type_desc);
+
 Status add_adaptive_nullable_column_by_json_object(Column* column, const TypeDescriptor& type_desc,
                                                    const std::string& name, simdjson::ondemand::object* value,
                                                    bool invalid_as_null);
@@ -1138,16 +1138,23 @@ Status OrcChunkReader::set_conjuncts_and_runtime_filters(const std::vector<Expr*
     return Status::OK();
 }
 
-ColumnPtr OrcChunkReader::get_row_delete_filter(const std::set<int64_t>& deleted_pos) {
-    int64_t start_pos = _row_reader->getRowNumber();
+ColumnPtr OrcChunkReader::get_row_delete_filter(const Roaring* deleted_pos) {
     auto num_rows = _batch->numElements;
     ColumnPtr filter_column = BooleanColumn::create(num_rows, 1);
+    if (deleted_pos == nullptr || deleted_pos->isEmpty()) {
+        return filter_column;
+    }
+    const uint64_t start_pos = _row_reader->getRowNumber();
+    const uint64_t end_pos = start_pos + num_rows;
+    if (start_pos > deleted_pos->maximum()) {
+        return filter_column;
+    }
     auto& filter = static_cast<BooleanColumn*>(filter_column.get())->get_data();
-    auto iter = deleted_pos.lower_bound(start_pos);
-    auto end = deleted_pos.upper_bound(start_pos + num_rows);
-    for (; iter != end; iter++) {
-        const int64_t file_pos = *iter - start_pos;
-        filter[file_pos] = 0;
+    // the number of the deleted positions before |start_pos|
+    uint64_t rank = start_pos == 0 ? 0 : deleted_pos->rank(static_cast<uint32_t>(start_pos - 1));
+    uint32_t pos = 0;
+    while (deleted_pos->select(static_cast<uint32_t>(rank++), &pos) && pos < end_pos) {
+        filter[pos - start_pos] = 0;
     }
 
     return filter_column;
@@ -16,6 +16,7 @@
 
 #include <boost/algorithm/string.hpp>
 #include <orc/OrcFile.hh>
+#include <roaring/roaring.hh>
 
 #include "column/column_helper.h"
 #include "column/vectorized_fwd.h"
@@ -71,6 +72,8 @@ public:
     ChunkPtr cast_chunk(ChunkPtr* chunk) { return cast_chunk_checked(chunk).value(); }
     // call them before calling init.
     void set_read_chunk_size(uint64_t v) { _read_chunk_size = v; }
+    // Only read the stripes starting in [offset, offset + length), must be called before init.
+    void set_read_range(uint64_t offset, uint64_t length) { _row_reader_options.range(offset, length); }
     void set_row_reader_filter(std::shared_ptr<orc::RowReaderFilter> filter);
     Status set_conjuncts(const std::vector<Expr*>& conjuncts);
     Status set_conjuncts_and_runtime_filters(const std::vector<Expr*>& conjuncts,
@@ -134,7 +137,8 @@ public:
     Status lazy_seek_to(uint64_t rowInStripe);
     void lazy_filter_on_cvb(Filter* filter);
     StatusOr<ChunkPtr> get_lazy_chunk();
-    ColumnPtr get_row_delete_filter(const std::set<int64_t>& deleted_pos);
+    // |deleted_pos| may be nullptr if no row is deleted.
+    ColumnPtr get_row_delete_filter(const Roaring* deleted_pos);
 
 private:
     ChunkPtr _create_chunk(const std::vector<SlotDescriptor*>& slots, const std::vector<int>* indices);
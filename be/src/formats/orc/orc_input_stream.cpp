@@ -43,8 +43,10 @@ namespace starrocks {
 
 ORCHdfsFileStream::ORCHdfsFileStream(RandomAccessFile* file, uint64_t length)
         : _file(file), _length(length), _cache_buffer(0), _cache_offset(0), _buffer_stream(_file) {
-    SharedBufferedInputStream::CoalesceOptions options = {.max_dist_size = config::io_coalesce_read_max_distance_size,
-                                                          .max_buffer_size = config::io_coalesce_read_max_buffer_size};
+    SharedBufferedInputStream::CoalesceOptions options = {
+            .max_dist_size = config::io_coalesce_read_max_distance_size,
+            .max_buffer_size = config::io_coalesce_read_max_buffer_size,
+            .max_prefetch_size = config::io_coalesce_read_max_prefetch_size};
     _buffer_stream.set_coalesce_options(options);
 }
 
@@ -0,0 +1,62 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "formats/parquet/bloom_filter.h"
+
+#include "gutil/strings/substitute.h"
+#include "util/xxh3.h"
+
+namespace starrocks::parquet {
+
+static constexpr uint32_t SALT[8] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                                     0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+Status SplitBlockBloomFilter::init(uint32_t num_bytes) {
+    if (num_bytes == 0 || num_bytes % kBytesPerBlock != 0 || num_bytes > kMaxBytes) {
+        return Status::Corruption(strings::Substitute("Invalid size of parquet bloom filter: $0", num_bytes));
+    }
+    _bitset.assign(num_bytes / sizeof(uint32_t), 0);
+    return Status::OK();
+}
+
+uint32_t SplitBlockBloomFilter::_block_index(uint64_t hash) const {
+    const uint64_t num_blocks = _bitset.size() / kWordsPerBlock;
+    return static_cast<uint32_t>(((hash >> 32) * num_blocks) >> 32);
+}
+
+void SplitBlockBloomFilter::insert_hash(uint64_t hash) {
+    uint32_t* block = _bitset.data() + _block_index(hash) * kWordsPerBlock;
+    const auto key = static_cast<uint32_t>(hash);
+    for (int i = 0; i < kWordsPerBlock; i++) {
+        block[i] |= 1U << ((key * SALT[i]) >> 27);
+    }
+}
+
+bool SplitBlockBloomFilter::test_hash(uint64_t hash) const {
+    const uint32_t* block = _bitset.data() + _block_index(hash) * kWordsPerBlock;
+    const auto key = static_cast<uint32_t>(hash);
+    for (int i = 0; i < kWordsPerBlock; i++) {
+        if ((block[i] & (1U << ((key * SALT[i]) >> 27))) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64_t SplitBlockBloomFilter::hash(const void* data, size_t size) {
+    return XXH64(data, size, 0);
+}
+
+} // namespace starrocks::parquet
@@ -0,0 +1,58 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common/status.h"
+
+namespace starrocks::parquet {
+
+// The split block bloom filter of parquet, see BloomFilter.md of parquet-format.
+//
+// The bitset is divided into blocks of 256 bits, a value is hashed by xxHash64 with seed 0, the most significant
+// 32 bits of the hash select the block, and the least significant 32 bits set one bit in each of the 8 words of
+// the block.
+class SplitBlockBloomFilter {
+public:
+    static constexpr uint32_t kBytesPerBlock = 32;
+    // The writers of parquet limit the bitset to 128MB.
+    static constexpr uint32_t kMaxBytes = 128 * 1024 * 1024;
+
+    // Create an empty bitset of |num_bytes|, which must be a multiple of kBytesPerBlock.
+    Status init(uint32_t num_bytes);
+
+    // The bitset, which can be filled by the one read from the file.
+    uint8_t* data() { return reinterpret_cast<uint8_t*>(_bitset.data()); }
+    size_t size() const { return _bitset.size() * sizeof(uint32_t); }
+
+    void insert_hash(uint64_t hash);
+    bool test_hash(uint64_t hash) const;
+
+    // Hash the plain encoding of a value, i.e. the little endian bytes of the numbers or the bytes of the
+    // byte arrays without the length.
+    static uint64_t hash(const void* data, size_t size);
+
+private:
+    static constexpr int kWordsPerBlock = 8;
+
+    uint32_t _block_index(uint64_t hash) const;
+
+    std::vector<uint32_t> _bitset;
+};
+
+} // namespace starrocks::parquet
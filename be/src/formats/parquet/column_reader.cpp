@@ -107,7 +107,14 @@ public:
         _reader->get_levels(def_levels, rep_levels, num_levels);
     }
 
-    Status get_dict_values(Column* column) override { return _reader->get_dict_values(column); }
+    Status get_dict_values(Column* column) override {
+        if (!converter->need_convert) {
+            return _reader->get_dict_values(column);
+        }
+        auto src_column = converter->create_src_column();
+        RETURN_IF_ERROR(_reader->get_dict_values(src_column.get()));
+        return converter->convert(src_column, column);
+    }
 
     Status get_dict_values(const std::vector<int32_t>& dict_codes, Column* column) override {
         return _reader->get_dict_values(dict_codes, column);
@@ -67,6 +67,8 @@ public:
 
     virtual void set_need_parse_levels(bool need_parse_levels) = 0;
 
+    // Append all the values of the dictionary to |column| of the column type, |column| must be nullable if a
+    // conversion from the parquet type is needed.
     virtual Status get_dict_values(Column* column) { return Status::NotSupported("get_dict_values is not supported"); }
 
     virtual Status get_dict_values(const std::vector<int32_t>& dict_codes, Column* column) {
@@ -14,13 +14,17 @@
 
 #include "formats/parquet/file_reader.h"
 
+#include <algorithm>
+
 #include "column/column_helper.h"
 #include "column/vectorized_fwd.h"
 #include "exec/exec_node.h"
 #include "exec/hdfs_scanner.h"
 #include "exprs/expr.h"
+#include "exprs/column_ref.h"
 #include "exprs/expr_context.h"
 #include "exprs/runtime_filter_bank.h"
+#include "formats/file_meta_cache.h"
 #include "formats/parquet/encoding_plain.h"
 #include "formats/parquet/metadata.h"
 #include "fs/fs.h"
@@ -66,6 +70,15 @@ Status FileReader::init(HdfsScannerContext* ctx) {
 }
 
 Status FileReader::_parse_footer() {
+    const std::string& cache_key = _scanner_ctx->file_meta_cache_key;
+    if (!cache_key.empty()) {
+        _file_metadata = FileMetaCache::instance()->lookup_parquet_meta(cache_key, _scanner_ctx->case_sensitive);
+        if (_file_metadata != nullptr) {
+            _scanner_ctx->stats->footer_cache_hit++;
+            return Status::OK();
+        }
+    }
+
     // try with buffer on stack
     uint8_t local_buf[FOOTER_BUFFER_SIZE];
     uint8_t* footer_buf = local_buf;
@@ -111,6 +124,12 @@ Status FileReader::_parse_footer() {
                                            &t_metadata));
     _file_metadata.reset(new FileMetaData());
     RETURN_IF_ERROR(_file_metadata->init(t_metadata, _scanner_ctx->case_sensitive));
+    if (!cache_key.empty()) {
+        // the parsed footer takes several times the memory of the serialized one, both the thrift objects
+        // and the schema are copied.
+        FileMetaCache::instance()->insert_parquet_meta(cache_key, _scanner_ctx->case_sensitive, _file_metadata,
+                                                       FOOTER_MEMORY_FACTOR * footer_size);
+    }
 
     return Status::OK();
 }
@@ -140,23 +159,31 @@ StatusOr<bool> FileReader::_filter_group(const tparquet::RowGroup& row_group) {
 
         bool exist = false;
         RETURN_IF_ERROR(_read_min_max_chunk(row_group, tuple_desc.slots(), &min_chunk, &max_chunk, &exist));
-        if (!exist) {
-            return false;
+        // the other filters can still be used without the statistics
+        if (exist) {
+            for (auto& min_max_conjunct_ctx : _scanner_ctx->min_max_conjunct_ctxs) {
+                ASSIGN_OR_RETURN(auto min_column, min_max_conjunct_ctx->evaluate(min_chunk.get()));
+                ASSIGN_OR_RETURN(auto max_column, min_max_conjunct_ctx->evaluate(max_chunk.get()));
+                auto f = [&](Column* c) {
+                    // is_null(0) only when something unexpected happens
+                    if (c->is_null(0)) return (int8_t)0;
+                    return c->get(0).get_int8();
+                };
+                auto min = f(min_column.get());
+                auto max = f(max_column.get());
+                if (min == 0 && max == 0) {
+                    return true;
+                }
+            }
         }
+    }
 
-        for (auto& min_max_conjunct_ctx : _scanner_ctx->min_max_conjunct_ctxs) {
-            ASSIGN_OR_RETURN(auto min_column, min_max_conjunct_ctx->evaluate(min_chunk.get()));
-            ASSIGN_OR_RETURN(auto max_column, min_max_conjunct_ctx->evaluate(max_chunk.get()));
-            auto f = [&](Column* c) {
-                // is_null(0) only when something unexpected happens
-                if (c->is_null(0)) return (int8_t)0;
-                return c->get(0).get_int8();
-            };
-            auto min = f(min_column.get());
-            auto max = f(max_column.get());
-            if (min == 0 && max == 0) {
-                return true;
-            }
+    // filter by bloom filter.
+    if (config::parquet_bloom_filter_enable) {
+        ASSIGN_OR_RETURN(bool filtered, _filter_group_by_bloom_filter(row_group));
+        if (filtered) {
+            _scanner_ctx->stats->bloom_filter_groups++;
+            return true;
         }
     }
 
@@ -198,6 +225,218 @@ StatusOr<bool> FileReader::_filter_group(const tparquet::RowGroup& row_group) {
     return false;
 }
 
+StatusOr<bool> FileReader::_filter_group_by_bloom_filter(const tparquet::RowGroup& row_group) {
+    const HdfsScannerContext& ctx = *_scanner_ctx;
+    if (ctx.conjunct_ctxs_by_slot.empty()) {
+        return false;
+    }
+    SCOPED_RAW_TIMER(&ctx.stats->bloom_filter_ns);
+    const auto& slots = ctx.tuple_desc->slots();
+    std::unordered_map<std::string, size_t> column_name_2_pos_in_meta{};
+    _meta_helper->build_column_name_2_pos_in_meta(column_name_2_pos_in_meta, row_group, slots);
+
+    std::vector<uint64_t> hashes;
+    for (const auto& entry : ctx.conjunct_ctxs_by_slot) {
+        const SlotId slot_id = entry.first;
+        const std::vector<ExprContext*>& conjunct_ctxs = entry.second;
+        auto it = std::find_if(slots.begin(), slots.end(), [&](auto* s) { return s->id() == slot_id; });
+        if (it == slots.end()) {
+            continue;
+        }
+        const SlotDescriptor* slot = *it;
+        const tparquet::ColumnMetaData* column_meta =
+                _meta_helper->get_column_meta(column_name_2_pos_in_meta, row_group, slot->col_name());
+        if (column_meta == nullptr || !column_meta->__isset.bloom_filter_offset ||
+            !_can_use_bloom_filter(slot->type(), column_meta->type)) {
+            continue;
+        }
+
+        SplitBlockBloomFilter bloom_filter;
+        bool bloom_filter_loaded = false;
+        for (ExprContext* conjunct_ctx : conjunct_ctxs) {
+            hashes.clear();
+            if (!_get_bloom_filter_hashes(conjunct_ctx, slot_id, column_meta->type, &hashes)) {
+                continue;
+            }
+            // the bloom filter is only read if there is any equal or in conjunct
+            if (!bloom_filter_loaded) {
+                bool exist = false;
+                RETURN_IF_ERROR(_read_bloom_filter(*column_meta, &bloom_filter, &exist));
+                if (!exist) {
+                    break;
+                }
+                bloom_filter_loaded = true;
+            }
+            if (std::none_of(hashes.begin(), hashes.end(), [&](uint64_t h) { return bloom_filter.test_hash(h); })) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+Status FileReader::_read_bloom_filter(const tparquet::ColumnMetaData& column_meta,
+                                      SplitBlockBloomFilter* bloom_filter, bool* exist) {
+    *exist = false;
+    const int64_t offset = column_meta.bloom_filter_offset;
+    if (offset < 0 || static_cast<uint64_t>(offset) >= _file_size) {
+        return Status::Corruption(strings::Substitute("Invalid bloom filter of parquet file: name=$0, offset=$1",
+                                                      _file->filename(), offset));
+    }
+    // the size of the header is unknown, read a buffer large enough for it, which also covers the bitset
+    // following the header if the bitset is small.
+    uint8_t header_buf[BLOOM_FILTER_HEADER_BUFFER_SIZE];
+    const auto to_read = static_cast<uint32_t>(std::min<uint64_t>(_file_size - offset, sizeof(header_buf)));
+    RETURN_IF_ERROR(_file->read_at_fully(offset, header_buf, to_read));
+    _scanner_ctx->stats->request_bytes_read += to_read;
+    _scanner_ctx->stats->request_bytes_read_uncompressed += to_read;
+
+    tparquet::BloomFilterHeader header;
+    uint32_t header_size = to_read;
+    RETURN_IF_ERROR(deserialize_thrift_msg(header_buf, &header_size, TProtocolType::COMPACT, &header));
+    if (!header.algorithm.__isset.BLOCK || !header.hash.__isset.XXHASH || !header.compression.__isset.UNCOMPRESSED) {
+        return Status::OK();
+    }
+    if (header.numBytes <= 0 || static_cast<uint64_t>(offset) + header_size + header.numBytes > _file_size) {
+        return Status::Corruption(
+                strings::Substitute("Invalid bloom filter of parquet file: name=$0, offset=$1, len=$2",
+                                    _file->filename(), offset, header.numBytes));
+    }
+    RETURN_IF_ERROR(bloom_filter->init(header.numBytes));
+    if (header_size + header.numBytes <= to_read) {
+        memcpy(bloom_filter->data(), header_buf + header_size, header.numBytes);
+    } else {
+        RETURN_IF_ERROR(_file->read_at_fully(offset + header_size, bloom_filter->data(), header.numBytes));
+        _scanner_ctx->stats->request_bytes_read += header.numBytes;
+        _scanner_ctx->stats->request_bytes_read_uncompressed += header.numBytes;
+    }
+    *exist = true;
+    return Status::OK();
+}
+
+Status FileReader::_filter_pages(const tparquet::RowGroup& row_group, SparseRange* ranges, bool* filtered) {
+    *filtered = false;
+    if (!config::parquet_page_index_enable || _scanner_ctx->min_max_conjunct_ctxs.empty()) {
+        return Status::OK();
+    }
+    SCOPED_RAW_TIMER(&_scanner_ctx->stats->page_index_ns);
+    const HdfsScannerContext& ctx = *_scanner_ctx;
+    const auto& slots = ctx.min_max_tuple_desc->slots();
+    std::unordered_map<std::string, size_t> column_name_2_pos_in_meta{};
+    _meta_helper->build_column_name_2_pos_in_meta(column_name_2_pos_in_meta, row_group, slots);
+
+    const auto num_rows = static_cast<rowid_t>(row_group.num_rows);
+    SparseRange selected(0, num_rows);
+    std::vector<SlotDescriptor*> min_max_slots(1);
+    std::vector<SlotId> slot_ids;
+    for (auto& min_max_conjunct_ctx : ctx.min_max_conjunct_ctxs) {
+        slot_ids.clear();
+        min_max_conjunct_ctx->root()->get_slot_ids(&slot_ids);
+        if (slot_ids.size() != 1) {
+            continue;
+        }
+        auto it = std::find_if(slots.begin(), slots.end(), [&](auto* s) { return s->id() == slot_ids[0]; });
+        if (it == slots.end()) {
+            continue;
+        }
+        SlotDescriptor* slot = *it;
+        // the columns not in the file and the partition columns are filtered by row group
+        auto pos = column_name_2_pos_in_meta.find(slot->col_name());
+        if (pos == column_name_2_pos_in_meta.end() || pos->second >= row_group.columns.size()) {
+            continue;
+        }
+        const tparquet::ColumnChunk& column_chunk = row_group.columns[pos->second];
+        if (!column_chunk.__isset.column_index_offset || !column_chunk.__isset.offset_index_offset) {
+            continue;
+        }
+        const ParquetField* field = _meta_helper->get_parquet_field(column_name_2_pos_in_meta, slot->col_name());
+        if (field == nullptr || field->type.is_complex_type()) {
+            continue;
+        }
+        const tparquet::ColumnOrder* column_order = nullptr;
+        if (_file_metadata->t_metadata().__isset.column_orders) {
+            const auto& column_orders = _file_metadata->t_metadata().column_orders;
+            int column_idx = field->physical_column_index;
+            column_order = column_idx < column_orders.size() ? &column_orders[column_idx] : nullptr;
+        }
+        if (!_can_use_stats(column_chunk.meta_data.type, column_order)) {
+            continue;
+        }
+
+        tparquet::ColumnIndex column_index;
+        tparquet::OffsetIndex offset_index;
+        RETURN_IF_ERROR(_read_thrift_msg(column_chunk.column_index_offset, column_chunk.column_index_length,
+                                         &column_index));
+        RETURN_IF_ERROR(_read_thrift_msg(column_chunk.offset_index_offset, column_chunk.offset_index_length,
+                                         &offset_index));
+        const size_t num_pages = offset_index.page_locations.size();
+        if (num_pages == 0 || column_index.null_pages.size() != num_pages ||
+            column_index.min_values.size() != num_pages || column_index.max_values.size() != num_pages) {
+            continue;
+        }
+
+        min_max_slots[0] = slot;
+        ChunkPtr min_chunk = ChunkHelper::new_chunk(min_max_slots, num_pages);
+        ChunkPtr max_chunk = ChunkHelper::new_chunk(min_max_slots, num_pages);
+        bool decode_ok = true;
+        for (size_t i = 0; i < num_pages && decode_ok; i++) {
+            if (column_index.null_pages[i]) {
+                min_chunk->columns()[0]->append_nulls(1);
+                max_chunk->columns()[0]->append_nulls(1);
+                continue;
+            }
+            RETURN_IF_ERROR(_decode_min_max_value(*field, ctx.timezone, slot->type(), column_chunk.meta_data.type,
+                                                  column_index.min_values[i], column_index.max_values[i],
+                                                  &min_chunk->columns()[0], &max_chunk->columns()[0], &decode_ok));
+        }
+        if (!decode_ok) {
+            continue;
+        }
+
+        ASSIGN_OR_RETURN(auto min_column, min_max_conjunct_ctx->evaluate(min_chunk.get()));
+        ASSIGN_OR_RETURN(auto max_column, min_max_conjunct_ctx->evaluate(max_chunk.get()));
+        auto f = [&](Column* c, size_t i) {
+            if (c->is_null(i)) return (int8_t)0;
+            return c->get(i).get_int8();
+        };
+        SparseRange page_ranges;
+        for (size_t i = 0; i < num_pages; i++) {
+            if (f(min_column.get(), i) == 0 && f(max_column.get(), i) == 0) {
+                continue;
+            }
+            auto begin = static_cast<rowid_t>(offset_index.page_locations[i].first_row_index);
+            auto end = i + 1 < num_pages ? static_cast<rowid_t>(offset_index.page_locations[i + 1].first_row_index)
+                                         : num_rows;
+            page_ranges.add(Range(begin, end));
+        }
+        selected &= page_ranges;
+        if (selected.empty()) {
+            break;
+        }
+    }
+
+    if (selected.span_size() < num_rows) {
+        ctx.stats->page_index_filter_rows += num_rows - selected.span_size();
+        *ranges = std::move(selected);
+        *filtered = true;
+    }
+    return Status::OK();
+}
+
+template <typename T>
+Status FileReader::_read_thrift_msg(int64_t offset, int32_t length, T* msg) {
+    if (offset < 0 || length <= 0 || offset + length > _file_size) {
+        return Status::Corruption(strings::Substitute("Invalid page index of parquet file: name=$0, offset=$1, len=$2",
+                                                      _file->filename(), offset, length));
+    }
+    std::vector<uint8_t> buf(length);
+    RETURN_IF_ERROR(_file->read_at_fully(offset, buf.data(), length));
+    _scanner_ctx->stats->request_bytes_read += length;
+    _scanner_ctx->stats->request_bytes_read_uncompressed += length;
+    auto len = static_cast<uint32_t>(length);
+    return deserialize_thrift_msg(buf.data(), &len, TProtocolType::COMPACT, msg);
+}
+
 Status FileReader::_read_min_max_chunk(const tparquet::RowGroup& row_group, const std::vector<SlotDescriptor*>& slots,
                                        ChunkPtr* min_chunk, ChunkPtr* max_chunk, bool* exist) const {
     const HdfsScannerContext& ctx = *_scanner_ctx;
@@ -275,17 +514,24 @@ Status FileReader::_decode_min_max_column(const ParquetField& field, const std::
         return Status::OK();
     }
 
-    switch (column_meta.type) {
+    const auto& statistics = column_meta.statistics;
+    const std::string& min_value = statistics.__isset.min_value ? statistics.min_value : statistics.min;
+    const std::string& max_value = statistics.__isset.min_value ? statistics.max_value : statistics.max;
+    return _decode_min_max_value(field, timezone, type, column_meta.type, min_value, max_value, min_column,
+                                 max_column, decode_ok);
+}
+
+Status FileReader::_decode_min_max_value(const ParquetField& field, const std::string& timezone,
+                                         const TypeDescriptor& type, tparquet::Type::type physical_type,
+                                         const std::string& encoded_min, const std::string& encoded_max,
+                                         ColumnPtr* min_column, ColumnPtr* max_column, bool* decode_ok) {
+    *decode_ok = true;
+    switch (physical_type) {
     case tparquet::Type::type::INT32: {
         int32_t min_value = 0;
         int32_t max_value = 0;
-        if (column_meta.statistics.__isset.min_value) {
-            RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(column_meta.statistics.min_value, &min_value));
-            RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(column_meta.statistics.max_value, &max_value));
-        } else {
-            RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(column_meta.statistics.min, &min_value));
-            RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(column_meta.statistics.max, &max_value));
-        }
+        RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(encoded_min, &min_value));
+        RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(encoded_max, &max_value));
         std::unique_ptr<ColumnConverter> converter;
         RETURN_IF_ERROR(ColumnConverterFactory::create_converter(field, type, timezone, &converter));
 
@@ -307,13 +553,8 @@ Status FileReader::_decode_min_max_column(const ParquetField& field, const std::
     case tparquet::Type::type::INT64: {
         int64_t min_value = 0;
         int64_t max_value = 0;
-        if (column_meta.statistics.__isset.min_value) {
-            RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(column_meta.statistics.min_value, &min_value));
-            RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(column_meta.statistics.max_value, &max_value));
-        } else {
-            RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(column_meta.statistics.max, &max_value));
-            RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(column_meta.statistics.min, &min_value));
-        }
+        RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(encoded_min, &min_value));
+        RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(encoded_max, &max_value));
         std::unique_ptr<ColumnConverter> converter;
         RETURN_IF_ERROR(ColumnConverterFactory::create_converter(field, type, timezone, &converter));
 
@@ -335,14 +576,8 @@ Status FileReader::_decode_min_max_column(const ParquetField& field, const std::
     case tparquet::Type::type::BYTE_ARRAY: {
         Slice min_slice;
         Slice max_slice;
-
-        if (column_meta.statistics.__isset.min_value) {
-            RETURN_IF_ERROR(PlainDecoder<Slice>::decode(column_meta.statistics.min_value, &min_slice));
-            RETURN_IF_ERROR(PlainDecoder<Slice>::decode(column_meta.statistics.max_value, &max_slice));
-        } else {
-            RETURN_IF_ERROR(PlainDecoder<Slice>::decode(column_meta.statistics.min, &min_slice));
-            RETURN_IF_ERROR(PlainDecoder<Slice>::decode(column_meta.statistics.max, &max_slice));
-        }
+        RETURN_IF_ERROR(PlainDecoder<Slice>::decode(encoded_min, &min_slice));
+        RETURN_IF_ERROR(PlainDecoder<Slice>::decode(encoded_max, &max_slice));
         std::unique_ptr<ColumnConverter> converter;
         RETURN_IF_ERROR(ColumnConverterFactory::create_converter(field, type, timezone, &converter));
 
@@ -403,6 +638,83 @@ bool FileReader::_is_integer_type(const tparquet::Type::type& type) {
            type == tparquet::Type::type::INT96;
 }
 
+bool FileReader::_can_use_bloom_filter(const TypeDescriptor& type, tparquet::Type::type physical_type) {
+    switch (physical_type) {
+    case tparquet::Type::type::INT32:
+        return type.type == TYPE_INT;
+    case tparquet::Type::type::INT64:
+        return type.type == TYPE_BIGINT;
+    case tparquet::Type::type::BYTE_ARRAY:
+        return type.type == TYPE_VARCHAR;
+    default:
+        return false;
+    }
+}
+
+bool FileReader::_get_bloom_filter_hashes(ExprContext* ctx, SlotId slot_id, tparquet::Type::type physical_type,
+                                          std::vector<uint64_t>* hashes) {
+    Expr* root = ctx->root();
+    std::vector<Expr*> value_exprs;
+    if (root->node_type() == TExprNodeType::BINARY_PRED && root->op() == TExprOpcode::EQ) {
+        // `slot = value` or `value = slot`
+        int slot_child = root->get_child(0)->is_slotref() ? 0 : 1;
+        value_exprs.emplace_back(root->get_child(1 - slot_child));
+        if (!root->get_child(slot_child)->is_slotref()) {
+            return false;
+        }
+    } else if (root->node_type() == TExprNodeType::IN_PRED && root->op() == TExprOpcode::FILTER_IN &&
+               root->get_child(0)->is_slotref()) {
+        // the in predicates built by the runtime filter have no value children
+        if (root->get_num_children() < 2) {
+            return false;
+        }
+        for (int i = 1; i < root->get_num_children(); i++) {
+            value_exprs.emplace_back(root->get_child(i));
+        }
+    } else {
+        return false;
+    }
+
+    auto* slot_ref = down_cast<ColumnRef*>(root->get_child(0)->is_slotref() ? root->get_child(0) : root->get_child(1));
+    if (slot_ref->slot_id() != slot_id) {
+        return false;
+    }
+    for (Expr* value_expr : value_exprs) {
+        // the values must be of the same type with the slot, so that they are hashed as the values in the file
+        if (!value_expr->is_constant() || value_expr->type().type != slot_ref->type().type) {
+            return false;
+        }
+        auto value_or = ctx->evaluate(value_expr, nullptr);
+        if (!value_or.ok() || value_or.value()->size() != 1) {
+            return false;
+        }
+        Datum value = value_or.value()->get(0);
+        if (value.is_null()) {
+            continue;
+        }
+        switch (physical_type) {
+        case tparquet::Type::type::INT32: {
+            int32_t v = value.get_int32();
+            hashes->emplace_back(SplitBlockBloomFilter::hash(&v, sizeof(v)));
+            break;
+        }
+        case tparquet::Type::type::INT64: {
+            int64_t v = value.get_int64();
+            hashes->emplace_back(SplitBlockBloomFilter::hash(&v, sizeof(v)));
+            break;
+        }
+        case tparquet::Type::type::BYTE_ARRAY: {
+            const Slice& v = value.get_slice();
+            hashes->emplace_back(SplitBlockBloomFilter::hash(v.data, v.size));
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
 void FileReader::_prepare_read_columns() {
     _meta_helper->prepare_read_columns(_scanner_ctx->materialized_columns, _group_reader_param.read_cols,
                                        _is_only_partition_scan);
@@ -449,7 +761,18 @@ Status FileReader::_init_group_readers() {
                 continue;
             }
 
+            SparseRange page_ranges;
+            bool page_filtered = false;
+            RETURN_IF_ERROR(_filter_pages(_file_metadata->t_metadata().row_groups[i], &page_ranges, &page_filtered));
+            if (page_filtered && page_ranges.empty()) {
+                LOG(INFO) << "row group " << i << " of file has been filtered by page index";
+                continue;
+            }
+
             auto row_group_reader = std::make_shared<GroupReader>(_group_reader_param, i);
+            if (page_filtered) {
+                row_group_reader->set_page_index_ranges(std::move(page_ranges));
+            }
             _row_group_readers.emplace_back(row_group_reader);
             _total_row_count += _file_metadata->t_metadata().row_groups[i].num_rows;
         } else {
@@ -466,7 +789,8 @@ Status FileReader::_init_group_readers() {
         _sb_stream = std::make_shared<SharedBufferedInputStream>(_file);
         SharedBufferedInputStream::CoalesceOptions options = {
                 .max_dist_size = config::io_coalesce_read_max_distance_size,
-                .max_buffer_size = config::io_coalesce_read_max_buffer_size};
+                .max_buffer_size = config::io_coalesce_read_max_buffer_size,
+                .max_prefetch_size = config::io_coalesce_read_max_prefetch_size};
         _sb_stream->set_coalesce_options(options);
 
         std::vector<SharedBufferedInputStream::IORange> ranges;
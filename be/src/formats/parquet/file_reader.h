@@ -19,10 +19,12 @@
 
 #include "column/chunk.h"
 #include "common/status.h"
+#include "formats/parquet/bloom_filter.h"
 #include "formats/parquet/group_reader.h"
 #include "formats/parquet/meta_helper.h"
 #include "gen_cpp/parquet_types.h"
 #include "runtime/runtime_state.h"
+#include "storage/range.h"
 #include "util/buffered_stream.h"
 #include "util/runtime_profile.h"
 
@@ -36,6 +38,9 @@ struct HdfsScannerContext;
 namespace starrocks::parquet {
 
 constexpr static const uint64_t FOOTER_BUFFER_SIZE = 16 * 1024;
+constexpr static const uint64_t BLOOM_FILTER_HEADER_BUFFER_SIZE = 1024;
+// the estimated memory of the parsed footer relative to its size in the file
+constexpr static const uint64_t FOOTER_MEMORY_FACTOR = 3;
 constexpr static const char* PARQUET_MAGIC_NUMBER = "PAR1";
 
 class FileMetaData;
@@ -63,6 +68,21 @@ private:
     // filter row group by min/max conjuncts
     StatusOr<bool> _filter_group(const tparquet::RowGroup& row_group);
 
+    // filter row group by the bloom filters of the columns with equal or in conjuncts
+    StatusOr<bool> _filter_group_by_bloom_filter(const tparquet::RowGroup& row_group);
+
+    // read the bloom filter of the column chunk, exist=false if it's not usable
+    Status _read_bloom_filter(const tparquet::ColumnMetaData& column_meta, SplitBlockBloomFilter* bloom_filter,
+                              bool* exist);
+
+    // filter the pages of row group by min/max conjuncts with the page index (ColumnIndex/OffsetIndex),
+    // |ranges| are the rows in the row group which may match, only set if some rows are filtered.
+    Status _filter_pages(const tparquet::RowGroup& row_group, SparseRange* ranges, bool* filtered);
+
+    // read and deserialize the thrift message at [offset, offset + length) of the file
+    template <typename T>
+    Status _read_thrift_msg(int64_t offset, int32_t length, T* msg);
+
     // get row group to read
     // if scan range conatain the first byte in the row group, will be read
     // TODO: later modify the larger block should be read
@@ -90,6 +110,11 @@ private:
                                          const TypeDescriptor& type, const tparquet::ColumnMetaData& column_meta,
                                          const tparquet::ColumnOrder* column_order, ColumnPtr* min_column,
                                          ColumnPtr* max_column, bool* decode_ok);
+    // decode the plain encoded min/max value of the statistics or page index
+    static Status _decode_min_max_value(const ParquetField& field, const std::string& timezone,
+                                        const TypeDescriptor& type, tparquet::Type::type physical_type,
+                                        const std::string& encoded_min, const std::string& encoded_max,
+                                        ColumnPtr* min_column, ColumnPtr* max_column, bool* decode_ok);
     static bool _can_use_min_max_stats(const tparquet::ColumnMetaData& column_meta,
                                        const tparquet::ColumnOrder* column_order);
     // statistics.min_value max_value
@@ -98,6 +123,13 @@ private:
     static bool _can_use_deprecated_stats(const tparquet::Type::type& type, const tparquet::ColumnOrder* column_order);
     static bool _is_integer_type(const tparquet::Type::type& type);
 
+    // the values of |type| are hashed by the bloom filter of |physical_type| as they are
+    static bool _can_use_bloom_filter(const TypeDescriptor& type, tparquet::Type::type physical_type);
+    // get the hashes of the values for the bloom filter if |ctx| is `slot = value` or `slot in (values)`,
+    // the null values are ignored as they never match.
+    static bool _get_bloom_filter_hashes(ExprContext* ctx, SlotId slot_id, tparquet::Type::type physical_type,
+                                         std::vector<uint64_t>* hashes);
+
     // get the data page start offset in parquet file
     static int64_t _get_row_group_start_offset(const tparquet::RowGroup& row_group);
 
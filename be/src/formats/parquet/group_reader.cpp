@@ -42,6 +42,12 @@ Status GroupReader::init() {
     _process_columns_and_conjunct_ctxs();
     RETURN_IF_ERROR(_dict_filter_ctx.rewrite_conjunct_ctxs_to_predicates(_param, _column_readers, &_obj_pool,
                                                                          &_is_group_filtered));
+    if (!_is_group_filtered) {
+        RETURN_IF_ERROR(_filter_group_by_dict_values());
+    }
+    if (_is_group_filtered) {
+        _param.stats->group_dict_filter_groups++;
+    }
     _init_read_chunk();
     return Status::OK();
 }
@@ -57,16 +63,20 @@ Status GroupReader::get_next(ChunkPtr* chunk, size_t* row_count) {
     bool has_more_filter = !_left_conjunct_ctxs.empty();
     Status status;
 
+    const bool use_page_index_filter = _build_page_index_filter(count);
     ChunkPtr active_chunk = _create_read_chunk(_active_column_indices);
     {
         size_t rows_to_skip = _column_reader_opts.context->rows_to_skip;
         _column_reader_opts.context->rows_to_skip = 0;
 
         SCOPED_RAW_TIMER(&_param.stats->group_chunk_read_ns);
-        // read data into active_chunk
-        _column_reader_opts.context->filter = nullptr;
+        // read data into active_chunk, the rows not selected by the page index are filled with default values,
+        // and they are filtered out below.
+        _column_reader_opts.context->filter =
+                use_page_index_filter && _skip_active_pages ? &_page_index_filter : nullptr;
         status = _read(_active_column_indices, &count, &active_chunk);
         _param.stats->raw_rows_read += count;
+        _next_row += count;
         if (!status.ok() && !status.is_end_of_file()) {
             return status;
         }
@@ -94,6 +104,19 @@ Status GroupReader::get_next(ChunkPtr* chunk, size_t* row_count) {
         has_filter = true;
     }
 
+    if (use_page_index_filter) {
+        size_t n = std::min(count, _page_index_filter.size());
+        if (has_filter) {
+            for (size_t i = 0; i < n; i++) {
+                chunk_filter[i] &= _page_index_filter[i];
+            }
+        } else {
+            memcpy(chunk_filter.data(), _page_index_filter.data(), n);
+        }
+        has_filter = true;
+        chunk_size = -1;
+    }
+
     if (has_filter) {
         size_t hit_count = chunk_size >= 0 ? chunk_size : SIMD::count_nonzero(chunk_filter.data(), count);
         if (hit_count == 0) {
@@ -168,6 +191,34 @@ Status GroupReader::_init_column_readers() {
     return Status::OK();
 }
 
+bool GroupReader::_build_page_index_filter(size_t count) {
+    if (!_has_page_index_ranges) {
+        return false;
+    }
+    const size_t begin = _next_row;
+    const size_t end = std::min<size_t>(begin + count, _row_group_metadata->num_rows);
+    if (begin >= end) {
+        return false;
+    }
+    _page_index_filter.assign(end - begin, 0);
+    while (_page_index_range_idx < _page_index_ranges.size() &&
+           _page_index_ranges[_page_index_range_idx].end() <= begin) {
+        _page_index_range_idx++;
+    }
+    size_t selected = 0;
+    for (size_t i = _page_index_range_idx; i < _page_index_ranges.size(); i++) {
+        const Range& r = _page_index_ranges[i];
+        if (r.begin() >= end) {
+            break;
+        }
+        size_t b = std::max<size_t>(begin, r.begin());
+        size_t e = std::min<size_t>(end, r.end());
+        memset(_page_index_filter.data() + (b - begin), 1, e - b);
+        selected += e - b;
+    }
+    return selected < end - begin;
+}
+
 Status GroupReader::_create_column_reader(const GroupReaderParam::Column& column) {
     std::unique_ptr<ColumnReader> column_reader = nullptr;
     const auto* schema_node = _param.file_metadata->schema().get_stored_column_by_idx(column.col_idx_in_parquet);
@@ -213,6 +264,10 @@ void GroupReader::_process_columns_and_conjunct_ctxs() {
                 }
                 has_conjunct = true;
             }
+            if (has_conjunct && !slots[chunk_index]->type().is_complex_type() &&
+                _can_filter_by_dict_values(slots[chunk_index], conjunct_ctxs_by_slot, column_metadata)) {
+                _dict_values_filter_column_indices.emplace_back(read_col_idx);
+            }
             if (config::parquet_late_materialization_enable && !has_conjunct) {
                 _lazy_column_indices.emplace_back(read_col_idx);
             } else {
@@ -224,6 +279,13 @@ void GroupReader::_process_columns_and_conjunct_ctxs() {
     if (_active_column_indices.empty()) {
         _active_column_indices.swap(_lazy_column_indices);
     }
+    // the complex columns are assembled from the levels of their children, which are not filled for the skipped
+    // pages, so the pages are only skipped by the lazy columns.
+    for (int col_idx : _active_column_indices) {
+        if (_param.read_cols[col_idx].col_type_in_chunk.is_complex_type()) {
+            _skip_active_pages = false;
+        }
+    }
 }
 
 ChunkPtr GroupReader::_create_read_chunk(const std::vector<int>& column_indices) {
@@ -287,7 +349,12 @@ bool GroupReader::_can_use_as_dict_filter_column(const SlotDescriptor* slot,
     if (!slot->type().is_string_type()) {
         return false;
     }
+    return _can_filter_by_dict_values(slot, conjunct_ctxs_by_slot, column_metadata);
+}
 
+bool GroupReader::_can_filter_by_dict_values(const SlotDescriptor* slot,
+                                             const SlotIdExprContextsMap& conjunct_ctxs_by_slot,
+                                             const tparquet::ColumnMetaData& column_metadata) {
     // check slot has conjuncts
     SlotId slot_id = slot->id();
     if (conjunct_ctxs_by_slot.find(slot_id) == conjunct_ctxs_by_slot.end()) {
@@ -314,6 +381,31 @@ bool GroupReader::_can_use_as_dict_filter_column(const SlotDescriptor* slot,
     return true;
 }
 
+Status GroupReader::_filter_group_by_dict_values() {
+    const auto& slots = _param.tuple_desc->slots();
+    for (int col_idx : _dict_values_filter_column_indices) {
+        const auto& column = _param.read_cols[col_idx];
+        const tparquet::ColumnMetaData& column_metadata =
+                _row_group_metadata->columns[column.col_idx_in_parquet].meta_data;
+
+        ColumnPtr dict_value_column = ColumnHelper::create_column(slots[column.col_idx_in_chunk]->type(), true);
+        RETURN_IF_ERROR(_column_readers[column.slot_id]->get_dict_values(dict_value_column.get()));
+        // the nulls are not in the dict, and some conjuncts are true for null, e.g. `ifnull(c, 0) = 0`
+        if (!column_metadata.statistics.__isset.null_count || column_metadata.statistics.null_count > 0) {
+            dict_value_column->append_nulls(1);
+        }
+        ChunkPtr dict_value_chunk = std::make_shared<Chunk>();
+        dict_value_chunk->append_column(dict_value_column, column.slot_id);
+        RETURN_IF_ERROR(ExecNode::eval_conjuncts(_param.conjunct_ctxs_by_slot.at(column.slot_id),
+                                                 dict_value_chunk.get()));
+        if (dict_value_chunk->num_rows() == 0) {
+            _is_group_filtered = true;
+            return Status::OK();
+        }
+    }
+    return Status::OK();
+}
+
 bool GroupReader::_column_all_pages_dict_encoded(const tparquet::ColumnMetaData& column_metadata) {
     // The Parquet spec allows for column chunks to have mixed encodings
     // where some data pages are dictionary-encoded and others are plain
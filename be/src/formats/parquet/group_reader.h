@@ -22,6 +22,7 @@
 #include "runtime/descriptors.h"
 #include "runtime/runtime_state.h"
 #include "storage/column_predicate.h"
+#include "storage/range.h"
 #include "util/buffered_stream.h"
 #include "util/runtime_profile.h"
 namespace starrocks {
@@ -83,6 +84,11 @@ public:
     void close();
     void collect_io_ranges(std::vector<SharedBufferedInputStream::IORange>* ranges, int64_t* end_offset);
     void set_end_offset(int64_t value) { _end_offset = value; }
+    // Only the rows in |ranges| may match the conjuncts, the pages without any of them are not decoded.
+    void set_page_index_ranges(SparseRange ranges) {
+        _page_index_ranges = std::move(ranges);
+        _has_page_index_ranges = true;
+    }
 
 private:
     struct DictFilterContext {
@@ -126,9 +132,18 @@ private:
     void _process_columns_and_conjunct_ctxs();
     bool _can_use_as_dict_filter_column(const SlotDescriptor* slot, const SlotIdExprContextsMap& slot_conjunct_ctxs,
                                         const tparquet::ColumnMetaData& column_metadata);
+    // Whether the row group can be filtered by evaluating the conjuncts of |slot| on the dict values
+    bool _can_filter_by_dict_values(const SlotDescriptor* slot, const SlotIdExprContextsMap& slot_conjunct_ctxs,
+                                    const tparquet::ColumnMetaData& column_metadata);
+    // Filter the row group if no dict value of any column in |_dict_values_filter_column_indices| matches its
+    // conjuncts, these conjuncts are still evaluated on the values after read.
+    Status _filter_group_by_dict_values();
     // Returns true if all of the data pages in the column chunk are dict encoded
     static bool _column_all_pages_dict_encoded(const tparquet::ColumnMetaData& column_metadata);
     void _init_read_chunk();
+    // Build |_page_index_filter| of the next |count| rows by the page index ranges,
+    // return false if all of them are selected.
+    bool _build_page_index_filter(size_t count);
 
     Status _read(const std::vector<int>& read_columns, size_t* row_count, ChunkPtr* chunk);
     Status _lazy_skip_rows(const std::vector<int>& read_columns, const ChunkPtr& chunk, size_t chunk_size);
@@ -150,6 +165,8 @@ private:
     std::vector<int> _active_column_indices;
     // lazy conlumns that hold read_col index
     std::vector<int> _lazy_column_indices;
+    // the dict encoded columns which are not dict filter columns but can filter the row group by the dict values
+    std::vector<int> _dict_values_filter_column_indices;
 
     // dict value is empty after conjunct eval, file group can be skipped
     bool _is_group_filtered = false;
@@ -166,6 +183,16 @@ private:
     int64_t _end_offset = 0;
 
     DictFilterContext _dict_filter_ctx;
+
+    // the rows selected by the page index
+    SparseRange _page_index_ranges;
+    bool _has_page_index_ranges = false;
+    size_t _page_index_range_idx = 0;
+    Filter _page_index_filter;
+    // whether the active columns can skip the pages by |_page_index_filter|
+    bool _skip_active_pages = true;
+    // the rows read from the row group
+    size_t _next_row = 0;
 };
 
 } // namespace starrocks::parquet
@@ -16,48 +16,273 @@
 
 #include <unistd.h>
 
-#include "util/lru_cache.h"
+#include <list>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "common/logging.h"
 
 namespace starrocks {
 
-static void fd_deleter(const CacheKey& key, void* value) {
-    int fd = static_cast<int>(reinterpret_cast<uintptr_t>(value));
-    ::close(fd);
+static constexpr size_t kNumShards = 32;
+
+struct FdCache::Handle {
+    Handle(std::string_view path, int fd) : path(path), fd(fd) {}
+
+    ~Handle() { ::close(fd); }
+
+    const std::string path;
+    const int fd;
+    // One reference is held by the cache as long as the entry is cached.
+    std::atomic<int32_t> refs{1};
+    // Set on every access, and cleared when the clock hand passes the entry.
+    std::atomic<bool> referenced{true};
+    std::list<Handle*>::iterator pos;
+};
+
+static void unref(FdCache::Handle* h);
+
+class FdCache::Shard {
+public:
+    void set_capacity(size_t capacity) { _capacity = std::max<size_t>(1, capacity); }
+
+    Handle* lookup(std::string_view path) {
+        std::shared_lock lock(_mutex);
+        auto iter = _map.find(path);
+        if (iter == _map.end()) {
+            return nullptr;
+        }
+        Handle* h = iter->second;
+        h->refs.fetch_add(1, std::memory_order_relaxed);
+        // Avoid dirtying the cache line when the bit is already set.
+        if (!h->referenced.load(std::memory_order_relaxed)) {
+            h->referenced.store(true, std::memory_order_relaxed);
+        }
+        return h;
+    }
+
+    Handle* insert(std::string_view path, int fd) {
+        std::vector<Handle*> evicted;
+        Handle* h = nullptr;
+        {
+            std::unique_lock lock(_mutex);
+            auto iter = _map.find(path);
+            if (iter != _map.end()) {
+                // Another thread has inserted the same file.
+                h = iter->second;
+                h->refs.fetch_add(1, std::memory_order_relaxed);
+                h->referenced.store(true, std::memory_order_relaxed);
+            } else {
+                while (_map.size() >= _capacity) {
+                    Handle* victim = _evict_one();
+                    if (victim == nullptr) {
+                        // All the entries are pinned, exceed the capacity rather than closing them.
+                        break;
+                    }
+                    evicted.push_back(victim);
+                }
+                h = new Handle(path, fd);
+                h->refs.store(2, std::memory_order_relaxed);
+                h->pos = _clock.insert(_hand, h);
+                _map.emplace(h->path, h);
+                fd = -1;
+            }
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        for (Handle* victim : evicted) {
+            unref(victim);
+        }
+        return h;
+    }
+
+    void erase(std::string_view path) {
+        Handle* h = nullptr;
+        {
+            std::unique_lock lock(_mutex);
+            auto iter = _map.find(path);
+            if (iter == _map.end()) {
+                return;
+            }
+            h = iter->second;
+            _remove(h);
+        }
+        unref(h);
+    }
+
+    void prune() {
+        std::vector<Handle*> removed;
+        {
+            std::unique_lock lock(_mutex);
+            for (auto iter = _clock.begin(); iter != _clock.end();) {
+                Handle* h = *iter++;
+                if (h->refs.load(std::memory_order_acquire) == 1) {
+                    _remove(h);
+                    removed.push_back(h);
+                }
+            }
+        }
+        for (Handle* h : removed) {
+            unref(h);
+        }
+    }
+
+    size_t size() const {
+        std::shared_lock lock(_mutex);
+        return _map.size();
+    }
+
+    ~Shard() {
+        for (Handle* h : _clock) {
+            unref(h);
+        }
+    }
+
+private:
+    // Remove |h| from the shard, the reference of the cache is left to the caller.
+    void _remove(Handle* h) {
+        if (_hand == h->pos) {
+            _hand = _clock.erase(h->pos);
+        } else {
+            _clock.erase(h->pos);
+        }
+        _map.erase(h->path);
+    }
+
+    // Pick an entry which is neither pinned nor recently used, and remove it from the shard.
+    Handle* _evict_one() {
+        // Two rounds are enough to clear the referenced bits of all the entries.
+        for (size_t steps = 2 * _clock.size(); steps > 0; steps--) {
+            if (_hand == _clock.end()) {
+                _hand = _clock.begin();
+            }
+            Handle* h = *_hand;
+            // The lookups are excluded by the lock, so the count of a unpinned entry can't grow here.
+            if (h->refs.load(std::memory_order_acquire) > 1 ||
+                h->referenced.exchange(false, std::memory_order_relaxed)) {
+                ++_hand;
+                continue;
+            }
+            _remove(h);
+            return h;
+        }
+        return nullptr;
+    }
+
+    mutable std::shared_mutex _mutex;
+    size_t _capacity{1};
+    // The keys point to the paths of the handles.
+    std::unordered_map<std::string_view, Handle*> _map;
+    std::list<Handle*> _clock;
+    std::list<Handle*>::iterator _hand{_clock.end()};
+};
+
+class FdCache::Partition {
+public:
+    Partition(std::string_view root, size_t capacity) : _root(root) {
+        for (auto& shard : _shards) {
+            shard.set_capacity(capacity / kNumShards);
+        }
+    }
+
+    const std::string& root() const { return _root; }
+
+    Shard* shard_of(std::string_view path) { return &_shards[std::hash<std::string_view>()(path) % kNumShards]; }
+
+    Shard* shards() { return _shards; }
+
+private:
+    const std::string _root;
+    Shard _shards[kNumShards];
+};
+
+static void unref(FdCache::Handle* h) {
+    if (h->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete h;
+    }
 }
 
-FdCache::FdCache(size_t capacity) : _cache(new_lru_cache(capacity)) {}
+FdCache::FdCache(size_t capacity) : _default_partition(std::make_unique<Partition>("", capacity)) {}
+
+FdCache::~FdCache() = default;
+
+void FdCache::add_partition(std::string_view root, size_t capacity) {
+    while (root.size() > 1 && root.back() == '/') {
+        root.remove_suffix(1);
+    }
+    std::lock_guard l(_partitions_mutex);
+    size_t n = _num_partitions.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < n; i++) {
+        if (_partitions[i]->root() == root) {
+            return;
+        }
+    }
+    if (n >= kMaxPartitions) {
+        LOG(WARNING) << "Too many partitions of the fd cache, the files under " << root
+                     << " share the default capacity";
+        return;
+    }
+    _partitions[n] = std::make_unique<Partition>(root, capacity);
+    _num_partitions.store(n + 1, std::memory_order_release);
+}
 
-FdCache::~FdCache() {
-    delete _cache;
+FdCache::Partition* FdCache::_partition_of(std::string_view path) const {
+    Partition* result = _default_partition.get();
+    size_t matched = 0;
+    size_t n = _num_partitions.load(std::memory_order_acquire);
+    for (size_t i = 0; i < n; i++) {
+        const std::string& root = _partitions[i]->root();
+        if (root.size() > matched && path.size() > root.size() && path.compare(0, root.size(), root) == 0 &&
+            (path[root.size()] == '/' || root.back() == '/')) {
+            result = _partitions[i].get();
+            matched = root.size();
+        }
+    }
+    return result;
 }
 
 FdCache::Handle* FdCache::insert(std::string_view path, int fd) {
-    void* value = reinterpret_cast<void*>(static_cast<uintptr_t>(fd));
-    Cache::Handle* h = _cache->insert(CacheKey(path.data(), path.size()), value, 1, fd_deleter);
-    return reinterpret_cast<FdCache::Handle*>(h);
+    return _partition_of(path)->shard_of(path)->insert(path, fd);
 }
 
 FdCache::Handle* FdCache::lookup(std::string_view path) {
-    Cache::Handle* h = _cache->lookup(CacheKey(path.data(), path.size()));
-    return reinterpret_cast<FdCache::Handle*>(h);
+    return _partition_of(path)->shard_of(path)->lookup(path);
 }
 
 void FdCache::erase(std::string_view path) {
-    _cache->erase(CacheKey(path.data(), path.size()));
+    _partition_of(path)->shard_of(path)->erase(path);
 }
 
 void FdCache::release(Handle* handle) {
-    _cache->release(reinterpret_cast<Cache::Handle*>(handle));
+    unref(handle);
 }
 
 void FdCache::prune() {
-    _cache->prune();
+    size_t n = _num_partitions.load(std::memory_order_acquire);
+    for (size_t i = 0; i <= n; i++) {
+        Partition* partition = i < n ? _partitions[i].get() : _default_partition.get();
+        for (size_t s = 0; s < kNumShards; s++) {
+            partition->shards()[s].prune();
+        }
+    }
+}
+
+size_t FdCache::size() const {
+    size_t total = 0;
+    size_t n = _num_partitions.load(std::memory_order_acquire);
+    for (size_t i = 0; i <= n; i++) {
+        Partition* partition = i < n ? _partitions[i].get() : _default_partition.get();
+        for (size_t s = 0; s < kNumShards; s++) {
+            total += partition->shards()[s].size();
+        }
+    }
+    return total;
 }
 
 int FdCache::fd(Handle* handle) {
-    void* value = FdCache::Instance()->_cache->value(reinterpret_cast<Cache::Handle*>(handle));
-    int fd = static_cast<int>(reinterpret_cast<uintptr_t>(value));
-    return fd;
+    return handle->fd;
 }
 
 } // namespace starrocks
@@ -15,6 +15,10 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <string_view>
 
 #include "common/config.h"
@@ -22,27 +26,45 @@
 
 namespace starrocks {
 
-class Cache;
-
+// A cache of the file descriptors of the segment files.
+//
+// The entries are spread over a fixed number of shards by the hash of the path. A lookup only
+// takes the shared lock of its shard and bumps the reference count of the entry, so concurrent
+// readers of the same files never block each other. Entries are evicted by the CLOCK algorithm
+// when a shard is full, an entry with outstanding handles is pinned and never evicted, so the
+// file of a segment being read is never closed and reopened while its iterators are alive.
+//
+// The capacity can be split by data directory through `add_partition`, the files under a
+// partition only compete with the other files of the same directory for the descriptors.
 class FdCache {
 public:
-    struct Handle {};
+    struct Handle;
 
     static FdCache* Instance() {
         static FdCache cache(std::max<size_t>(4096, config::file_descriptor_cache_capacity));
         return &cache;
     }
 
+    explicit FdCache(size_t capacity);
+
     ~FdCache();
 
     DISALLOW_COPY(FdCache);
 
+    // Give the files under directory |root| their own capacity of |capacity| descriptors.
+    // The files not under any partition share the capacity passed to the constructor.
+    // Partitions can't be removed, adding a partition of the same root again is a no-op.
+    void add_partition(std::string_view root, size_t capacity);
+
     // Insert a mapping from path->fd into the cache.
     //
     // Returns a handle that corresponds to the mapping.  The caller
     // must call this->release(handle) when the returned mapping is no
     // longer needed.
     //
+    // If there is already a mapping for |path|, |fd| is closed and the
+    // existing mapping is returned.
+    //
     // When the inserted entry is no longer needed, the file descriptor
     // will be `close`d.
     Handle* insert(std::string_view path, int fd);
@@ -66,15 +88,27 @@ public:
     // Remove all cache entries that are not actively in use.
     void prune();
 
+    // Return the number of the cached descriptors.
+    size_t size() const;
+
     // Return the file descriptor encapsulated in a handle returned by a
     // successful lookup().
     // REQUIRES: handle must not have been released yet.
     static int fd(Handle* handle);
 
 private:
-    explicit FdCache(size_t capacity);
+    class Shard;
+    class Partition;
+
+    static constexpr size_t kMaxPartitions = 64;
+
+    Partition* _partition_of(std::string_view path) const;
 
-    Cache* _cache;
+    std::unique_ptr<Partition> _default_partition;
+    // Append-only, the first |_num_partitions| slots are valid.
+    std::unique_ptr<Partition> _partitions[kMaxPartitions];
+    std::atomic<size_t> _num_partitions{0};
+    std::mutex _partitions_mutex;
 };
 
 } // namespace starrocks
@@ -101,6 +101,10 @@ struct RandomAccessFileOptions {
     // Don't cache remote file locally on read requests.
     // This options can be ignored if the underlying filesystem does not support local cache.
     bool skip_fill_local_cache = false;
+
+    // Read with O_DIRECT, bypassing the OS page cache. The small reads are still buffered.
+    // This options can be ignored if the underlying filesystem does not support direct io.
+    bool direct_io = false;
 };
 
 class FileSystem {
@@ -18,9 +18,12 @@
 #include <hdfs/hdfs.h>
 
 #include <atomic>
+#include <memory>
 #include <utility>
 
+#include "fs/io_stats_file.h"
 #include "gutil/strings/substitute.h"
+#include "io/hedged_read.h"
 #include "runtime/file_result_writer.h"
 #include "runtime/hdfs/hdfs_fs_cache.h"
 #include "udf/java/utils.h"
@@ -37,10 +40,9 @@ namespace starrocks {
 // Now this is not thread-safe.
 class HdfsInputStream : public io::SeekableInputStream {
 public:
-    HdfsInputStream(hdfsFS fs, hdfsFile file, std::string file_name)
-            : _fs(fs), _file(file), _file_name(std::move(file_name)) {}
+    HdfsInputStream(hdfsFS fs, hdfsFile file, std::string file_name);
 
-    ~HdfsInputStream() override;
+    ~HdfsInputStream() override = default;
 
     StatusOr<int64_t> read(void* data, int64_t size) override;
     StatusOr<int64_t> get_size() override;
@@ -52,34 +54,49 @@ public:
 private:
     bool _is_jfs_file() const;
 
+    // Close the file when the last reference is released.
+    static void close_file(hdfsFS fs, hdfsFile file, const std::string& file_name);
+
     hdfsFS _fs;
-    hdfsFile _file;
+    // Shared with the reads in flight, a read losing a hedged read may finish after the stream is destroyed.
+    std::shared_ptr<hdfsFile_internal> _file;
     std::string _file_name;
     int64_t _offset{0};
     int64_t _file_size{0};
 };
 
-HdfsInputStream::~HdfsInputStream() {
-    auto ret = call_hdfs_scan_function_in_pthread([this]() {
-        int r = hdfsCloseFile(this->_fs, this->_file);
+HdfsInputStream::HdfsInputStream(hdfsFS fs, hdfsFile file, std::string file_name)
+        : _fs(fs),
+          _file(file, [fs, file_name](hdfsFile f) { close_file(fs, f, file_name); }),
+          _file_name(std::move(file_name)) {}
+
+void HdfsInputStream::close_file(hdfsFS fs, hdfsFile file, const std::string& file_name) {
+    auto ret = call_hdfs_scan_function_in_pthread([&]() {
+        int r = hdfsCloseFile(fs, file);
         if (r == 0) {
             return Status::OK();
         } else {
-            return Status::IOError("close error, file: {}"_format(_file_name));
+            return Status::IOError("close error, file: {}"_format(file_name));
         }
     });
     Status st = ret->get_future().get();
-    PLOG_IF(ERROR, !st.ok()) << "close " << _file_name << " failed";
+    PLOG_IF(ERROR, !st.ok()) << "close " << file_name << " failed";
 }
 
 StatusOr<int64_t> HdfsInputStream::read(void* data, int64_t size) {
     if (UNLIKELY(size > std::numeric_limits<tSize>::max())) {
         size = std::numeric_limits<tSize>::max();
     }
-    tSize r = hdfsPread(_fs, _file, _offset, data, static_cast<tSize>(size));
-    if (r == -1) {
-        return Status::IOError(fmt::format("fail to hdfsPread {}: {}", _file_name, get_hdfs_err_msg()));
-    }
+    auto read = [fs = _fs, file = _file, file_name = _file_name, offset = _offset,
+                 size = static_cast<tSize>(size)](void* buf) -> StatusOr<int64_t> {
+        tSize r = hdfsPread(fs, file.get(), offset, buf, size);
+        if (r == -1) {
+            return Status::IOError(fmt::format("fail to hdfsPread {}: {}", file_name, get_hdfs_err_msg()));
+        }
+        return r;
+    };
+    static io::HedgedReadPolicy s_hedged_read_policy("hdfs");
+    ASSIGN_OR_RETURN(auto r, io::hedged_read(&s_hedged_read_policy, data, size, std::move(read)));
     _offset += r;
     return r;
 }
@@ -126,7 +143,7 @@ StatusOr<std::unique_ptr<io::NumericStatistics>> HdfsInputStream::get_numeric_st
     io::NumericStatistics* stats = statistics.get();
     auto ret = call_hdfs_scan_function_in_pthread([this, stats] {
         struct hdfsReadStatistics* hdfs_statistics = nullptr;
-        auto r = hdfsFileGetReadStatistics(_file, &hdfs_statistics);
+        auto r = hdfsFileGetReadStatistics(_file.get(), &hdfs_statistics);
         if (r != 0) return Status::InternalError(fmt::format("hdfsFileGetReadStatistics failed: {}", r));
         stats->reserve(4);
         stats->append("TotalBytesRead", hdfs_statistics->totalBytesRead);
@@ -406,7 +423,8 @@ StatusOr<std::unique_ptr<WritableFile>> HdfsFileSystem::new_writable_file(const
     if (file == nullptr) {
         return Status::InternalError(fmt::format("hdfsOpenFile failed, file={}", path));
     }
-    return std::make_unique<HDFSWritableFile>(handle.hdfs_fs, file, path, 0);
+    return with_io_stats(std::make_unique<HDFSWritableFile>(handle.hdfs_fs, file, path, 0),
+                         io::IOTargetRegistry::instance()->remote_target(path));
 }
 
 StatusOr<std::unique_ptr<SequentialFile>> HdfsFileSystem::new_sequential_file(const SequentialFileOptions& opts,
@@ -429,7 +447,8 @@ StatusOr<std::unique_ptr<SequentialFile>> HdfsFileSystem::new_sequential_file(co
         return Status::InternalError("hdfsOpenFile failed, path={}"_format(path));
     }
     auto stream = std::make_shared<HdfsInputStream>(handle.hdfs_fs, file, path);
-    return std::make_unique<SequentialFile>(std::move(stream), path);
+    return std::make_unique<SequentialFile>(
+            with_sequential_io_stats(std::move(stream), io::IOTargetRegistry::instance()->remote_target(path)), path);
 }
 
 StatusOr<std::unique_ptr<RandomAccessFile>> HdfsFileSystem::new_random_access_file(const RandomAccessFileOptions& opts,
@@ -451,7 +470,8 @@ StatusOr<std::unique_ptr<RandomAccessFile>> HdfsFileSystem::new_random_access_fi
         return Status::InternalError("hdfsOpenFile failed, path={}"_format(path));
     }
     auto stream = std::make_shared<HdfsInputStream>(handle.hdfs_fs, file, path);
-    return std::make_unique<RandomAccessFile>(std::move(stream), path);
+    return std::make_unique<RandomAccessFile>(
+            with_io_stats(std::move(stream), io::IOTargetRegistry::instance()->remote_target(path)), path);
 }
 
 Status HdfsFileSystem::rename_file(const std::string& src, const std::string& target) {
@@ -23,12 +23,16 @@
 #include "common/logging.h"
 #include "fs/fd_cache.h"
 #include "fs/fs.h"
+#include "fs/io_stats_file.h"
 #include "gutil/gscoped_ptr.h"
 #include "gutil/macros.h"
 #include "gutil/port.h"
 #include "gutil/strings/substitute.h"
 #include "gutil/strings/util.h"
+#include "io/aligned_buffer_pool.h"
+#include "io/direct_io_input_stream.h"
 #include "io/fd_input_stream.h"
+#include "io/io_uring.h"
 #include "util/errno.h"
 #include "util/slice.h"
 
@@ -86,6 +90,10 @@ inline bool enable_fd_cache(std::string_view path) {
     return HasSuffixString(path, ".dat");
 }
 
+inline bool use_io_uring() {
+    return config::enable_io_uring_read && io::IoUring::is_supported();
+}
+
 static Status io_error(const std::string& context, int err_number) {
     switch (err_number) {
     case 0:
@@ -99,6 +107,34 @@ static Status io_error(const std::string& context, int err_number) {
     }
 }
 
+static StatusOr<std::shared_ptr<io::FdInputStream>> new_fd_input_stream(const std::string& fname) {
+    if (config::file_descriptor_cache_capacity > 0 && enable_fd_cache(fname)) {
+        FdCache::Handle* h = FdCache::Instance()->lookup(fname);
+        if (h == nullptr) {
+            int fd;
+            RETRY_ON_EINTR(fd, ::open(fname.c_str(), O_RDONLY));
+            if (fd < 0) {
+                return io_error(fname, errno);
+            }
+            h = FdCache::Instance()->insert(fname, fd);
+        }
+        auto stream = std::make_shared<CachedFdInputStream>(h);
+        stream->set_close_on_delete(false);
+        stream->set_use_io_uring(use_io_uring());
+        return stream;
+    } else {
+        int fd;
+        RETRY_ON_EINTR(fd, ::open(fname.c_str(), O_RDONLY));
+        if (fd < 0) {
+            return io_error(fname, errno);
+        }
+        auto stream = std::make_shared<io::FdInputStream>(fd);
+        stream->set_close_on_delete(true);
+        stream->set_use_io_uring(use_io_uring());
+        return stream;
+    }
+}
+
 static Status do_sync(int fd, const string& filename) {
     if (fdatasync(fd) < 0) {
         return io_error(filename, errno);
@@ -324,34 +360,29 @@ public:
         }
         auto stream = std::make_shared<io::FdInputStream>(fd);
         stream->set_close_on_delete(true);
-        return std::make_unique<SequentialFile>(std::move(stream), fname);
+        return std::make_unique<SequentialFile>(
+                with_sequential_io_stats(std::move(stream), io::IOTargetRegistry::instance()->local_target(fname)),
+                fname);
     }
 
     StatusOr<std::unique_ptr<RandomAccessFile>> new_random_access_file(const RandomAccessFileOptions& opts,
                                                                        const std::string& fname) override {
-        if (config::file_descriptor_cache_capacity > 0 && enable_fd_cache(fname)) {
-            FdCache::Handle* h = FdCache::Instance()->lookup(fname);
-            if (h == nullptr) {
-                int fd;
-                RETRY_ON_EINTR(fd, ::open(fname.c_str(), O_RDONLY));
-                if (fd < 0) {
-                    return io_error(fname, errno);
-                }
-                h = FdCache::Instance()->insert(fname, fd);
-            }
-            auto stream = std::make_shared<CachedFdInputStream>(h);
-            stream->set_close_on_delete(false);
-            return std::make_unique<RandomAccessFile>(std::move(stream), fname);
-        } else {
+        ASSIGN_OR_RETURN(auto stream, new_fd_input_stream(fname));
+        if (opts.direct_io) {
             int fd;
-            RETRY_ON_EINTR(fd, ::open(fname.c_str(), O_RDONLY));
-            if (fd < 0) {
-                return io_error(fname, errno);
+            RETRY_ON_EINTR(fd, ::open(fname.c_str(), O_RDONLY | O_DIRECT));
+            if (fd >= 0) {
+                auto direct_stream = std::make_shared<io::DirectIoInputStream>(std::move(stream), fd,
+                                                                               io::AlignedBufferPool::instance());
+                return std::make_unique<RandomAccessFile>(
+                        with_io_stats(std::move(direct_stream), io::IOTargetRegistry::instance()->local_target(fname)),
+                        fname);
             }
-            auto stream = std::make_shared<io::FdInputStream>(fd);
-            stream->set_close_on_delete(true);
-            return std::make_unique<RandomAccessFile>(std::move(stream), fname);
+            // The file system may not support O_DIRECT, e.g, tmpfs, read it with the buffered io.
+            VLOG(2) << "Fail to open " << fname << " with O_DIRECT: " << std::strerror(errno);
         }
+        return std::make_unique<RandomAccessFile>(
+                with_io_stats(std::move(stream), io::IOTargetRegistry::instance()->local_target(fname)), fname);
     }
 
     StatusOr<std::unique_ptr<WritableFile>> new_writable_file(const string& fname) override {
@@ -367,7 +398,8 @@ public:
         if (opts.mode == MUST_EXIST) {
             ASSIGN_OR_RETURN(file_size, get_file_size(fname));
         }
-        return std::make_unique<PosixWritableFile>(fname, fd, file_size, opts.sync_on_close);
+        return with_io_stats(std::make_unique<PosixWritableFile>(fname, fd, file_size, opts.sync_on_close),
+                             io::IOTargetRegistry::instance()->local_target(fname));
     }
 
     Status path_exists(const std::string& fname) override {
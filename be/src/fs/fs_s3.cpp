@@ -38,6 +38,7 @@
 
 #include "common/config.h"
 #include "common/s3_uri.h"
+#include "fs/io_stats_file.h"
 #include "fs/output_stream_adapter.h"
 #include "gutil/casts.h"
 #include "gutil/strings/util.h"
@@ -390,7 +391,8 @@ StatusOr<std::unique_ptr<RandomAccessFile>> S3FileSystem::new_random_access_file
     }
     auto client = new_s3client(uri, _options);
     auto input_stream = std::make_shared<io::S3InputStream>(std::move(client), uri.bucket(), uri.key());
-    return std::make_unique<RandomAccessFile>(std::move(input_stream), path);
+    return std::make_unique<RandomAccessFile>(
+            with_io_stats(std::move(input_stream), io::IOTargetRegistry::instance()->remote_target(path)), path);
 }
 
 StatusOr<std::unique_ptr<SequentialFile>> S3FileSystem::new_sequential_file(const SequentialFileOptions& opts,
@@ -402,7 +404,9 @@ StatusOr<std::unique_ptr<SequentialFile>> S3FileSystem::new_sequential_file(cons
     }
     auto client = new_s3client(uri, _options);
     auto input_stream = std::make_shared<io::S3InputStream>(std::move(client), uri.bucket(), uri.key());
-    return std::make_unique<SequentialFile>(std::move(input_stream), path);
+    return std::make_unique<SequentialFile>(
+            with_sequential_io_stats(std::move(input_stream), io::IOTargetRegistry::instance()->remote_target(path)),
+            path);
 }
 
 StatusOr<std::unique_ptr<WritableFile>> S3FileSystem::new_writable_file(const std::string& fname) {
@@ -429,7 +433,8 @@ StatusOr<std::unique_ptr<WritableFile>> S3FileSystem::new_writable_file(const Wr
     auto ostream = std::make_unique<io::S3OutputStream>(std::move(client), uri.bucket(), uri.key(),
                                                         config::experimental_s3_max_single_part_size,
                                                         config::experimental_s3_min_upload_part_size);
-    return std::make_unique<OutputStreamAdapter>(std::move(ostream), fname);
+    return with_io_stats(std::make_unique<OutputStreamAdapter>(std::move(ostream), fname),
+                         io::IOTargetRegistry::instance()->remote_target(fname));
 }
 
 Status S3FileSystem::rename_file(const std::string& src, const std::string& target) {
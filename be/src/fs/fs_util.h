@@ -19,6 +19,8 @@
 #include <vector>
 
 #include "fs/fs.h"
+#include "util/bandwidth_throttle.h"
+#include "util/md5.h"
 
 namespace starrocks::fs {
 
@@ -111,8 +113,10 @@ inline bool path_exist(const std::string& path) {
     return (*fs)->path_exists(path).ok();
 }
 
-// Return the number of bytes copied on success.
-inline StatusOr<int64_t> copy(SequentialFile* src, WritableFile* dest, size_t buff_size = 8192) {
+// Return the number of bytes copied on success, the bytes read are throttled by |throttle| if it's not nullptr,
+// and digested by |md5| if it's not nullptr.
+inline StatusOr<int64_t> copy(SequentialFile* src, WritableFile* dest, size_t buff_size = 8192,
+                              BandwidthThrottle* throttle = nullptr, Md5Digest* md5 = nullptr) {
     char* buf = new char[buff_size];
     std::unique_ptr<char[]> guard(buf);
     int64_t ncopy = 0;
@@ -122,6 +126,12 @@ inline StatusOr<int64_t> copy(SequentialFile* src, WritableFile* dest, size_t bu
             break;
         }
         ncopy += nread;
+        if (throttle != nullptr) {
+            throttle->throttle(nread);
+        }
+        if (md5 != nullptr) {
+            md5->update(buf, nread);
+        }
         RETURN_IF_ERROR(dest->append(Slice(buf, nread)));
     }
     return ncopy;
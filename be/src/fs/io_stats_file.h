@@ -0,0 +1,173 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <memory>
+
+#include "common/config.h"
+#include "fs/fs.h"
+#include "fs/writable_file_wrapper.h"
+#include "io/io_stats.h"
+#include "io/seekable_input_stream.h"
+#include "util/time.h"
+
+namespace starrocks {
+
+// IOStatsInputStream records the latency and the bytes of every read of |stream| into |target|.
+class IOStatsInputStream final : public io::SeekableInputStreamWrapper {
+public:
+    IOStatsInputStream(std::shared_ptr<io::SeekableInputStream> stream, io::IOTarget* target)
+            : io::SeekableInputStreamWrapper(stream.get(), kDontTakeOwnership),
+              _stream(std::move(stream)),
+              _target(target) {}
+
+    StatusOr<int64_t> read(void* data, int64_t count) override {
+        const int64_t start_ns = MonotonicNanos();
+        auto res = io::SeekableInputStreamWrapper::read(data, count);
+        if (res.ok()) {
+            _target->record(io::IOOp::READ, res.value(), MonotonicNanos() - start_ns);
+        }
+        return res;
+    }
+
+    Status read_fully(void* data, int64_t count) override {
+        const int64_t start_ns = MonotonicNanos();
+        RETURN_IF_ERROR(io::SeekableInputStreamWrapper::read_fully(data, count));
+        _target->record(io::IOOp::READ, count, MonotonicNanos() - start_ns);
+        return Status::OK();
+    }
+
+    StatusOr<int64_t> read_at(int64_t offset, void* data, int64_t count) override {
+        const int64_t start_ns = MonotonicNanos();
+        auto res = io::SeekableInputStreamWrapper::read_at(offset, data, count);
+        if (res.ok()) {
+            _target->record(io::IOOp::READ, res.value(), MonotonicNanos() - start_ns);
+        }
+        return res;
+    }
+
+    Status read_at_fully(int64_t offset, void* data, int64_t count) override {
+        const int64_t start_ns = MonotonicNanos();
+        RETURN_IF_ERROR(io::SeekableInputStreamWrapper::read_at_fully(offset, data, count));
+        _target->record(io::IOOp::READ, count, MonotonicNanos() - start_ns);
+        return Status::OK();
+    }
+
+    // The batched ranges are recorded as one read.
+    Status read_ranges_fully(const std::vector<io::ReadRange>& ranges) override {
+        const int64_t start_ns = MonotonicNanos();
+        RETURN_IF_ERROR(io::SeekableInputStreamWrapper::read_ranges_fully(ranges));
+        int64_t bytes = 0;
+        for (const auto& range : ranges) {
+            bytes += range.count;
+        }
+        _target->record(io::IOOp::READ, bytes, MonotonicNanos() - start_ns);
+        return Status::OK();
+    }
+
+private:
+    std::shared_ptr<io::SeekableInputStream> _stream;
+    io::IOTarget* _target;
+};
+
+// IOStatsSequentialInputStream records the latency and the bytes of every read of the sequential |stream| into
+// |target|.
+class IOStatsSequentialInputStream final : public io::InputStreamWrapper {
+public:
+    IOStatsSequentialInputStream(std::shared_ptr<io::InputStream> stream, io::IOTarget* target)
+            : io::InputStreamWrapper(stream.get(), kDontTakeOwnership), _stream(std::move(stream)), _target(target) {}
+
+    StatusOr<int64_t> read(void* data, int64_t count) override {
+        const int64_t start_ns = MonotonicNanos();
+        auto res = io::InputStreamWrapper::read(data, count);
+        if (res.ok()) {
+            _target->record(io::IOOp::READ, res.value(), MonotonicNanos() - start_ns);
+        }
+        return res;
+    }
+
+    Status read_fully(void* data, int64_t count) override {
+        const int64_t start_ns = MonotonicNanos();
+        RETURN_IF_ERROR(io::InputStreamWrapper::read_fully(data, count));
+        _target->record(io::IOOp::READ, count, MonotonicNanos() - start_ns);
+        return Status::OK();
+    }
+
+private:
+    std::shared_ptr<io::InputStream> _stream;
+    io::IOTarget* _target;
+};
+
+// IOStatsWritableFile records the latency and the bytes of every write of |file| into |target|. The syncs and the
+// closes, which wait for the devices or upload the remaining data, are recorded as the writes of 0 byte.
+class IOStatsWritableFile final : public WritableFileWrapper {
+public:
+    IOStatsWritableFile(std::unique_ptr<WritableFile> file, io::IOTarget* target)
+            : WritableFileWrapper(file.release(), kTakesOwnership), _target(target) {}
+
+    Status append(const Slice& data) override { return _record(data.size, [&]() { return _file->append(data); }); }
+
+    Status appendv(const Slice* data, size_t cnt) override {
+        int64_t bytes = 0;
+        for (size_t i = 0; i < cnt; i++) {
+            bytes += data[i].size;
+        }
+        return _record(bytes, [&]() { return _file->appendv(data, cnt); });
+    }
+
+    Status sync() override { return _record(0, [&]() { return _file->sync(); }); }
+
+    Status close() override { return _record(0, [&]() { return _file->close(); }); }
+
+private:
+    template <typename Write>
+    Status _record(int64_t bytes, const Write& write) {
+        const int64_t start_ns = MonotonicNanos();
+        RETURN_IF_ERROR(write());
+        _target->record(io::IOOp::WRITE, bytes, MonotonicNanos() - start_ns);
+        return Status::OK();
+    }
+
+    io::IOTarget* _target;
+};
+
+// Wrap |stream| to record its reads into |target| if config::enable_io_stats.
+inline std::shared_ptr<io::SeekableInputStream> with_io_stats(std::shared_ptr<io::SeekableInputStream> stream,
+                                                             io::IOTarget* target) {
+    if (!config::enable_io_stats) {
+        return stream;
+    }
+    return std::make_shared<IOStatsInputStream>(std::move(stream), target);
+}
+
+// Wrap the sequential |stream| to record its reads into |target| if config::enable_io_stats.
+inline std::shared_ptr<io::InputStream> with_sequential_io_stats(std::shared_ptr<io::InputStream> stream,
+                                                                 io::IOTarget* target) {
+    if (!config::enable_io_stats) {
+        return stream;
+    }
+    return std::make_shared<IOStatsSequentialInputStream>(std::move(stream), target);
+}
+
+// Wrap |file| to record its writes into |target| if config::enable_io_stats.
+inline std::unique_ptr<WritableFile> with_io_stats(std::unique_ptr<WritableFile> file, io::IOTarget* target) {
+    if (!config::enable_io_stats) {
+        return file;
+    }
+    return std::make_unique<IOStatsWritableFile>(std::move(file), target);
+}
+
+} // namespace starrocks
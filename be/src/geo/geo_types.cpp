@@ -36,10 +36,13 @@
 
 #include <s2/s2cap.h>
 #include <s2/s2cell.h>
+#include <s2/s2cell_id.h>
+#include <s2/s2cell_union.h>
 #include <s2/s2earth.h>
 #include <s2/s2latlng.h>
 #include <s2/s2polygon.h>
 #include <s2/s2polyline.h>
+#include <s2/s2region_coverer.h>
 #include <s2/util/coding/coder.h>
 #include <s2/util/units/length-units.h>
 
@@ -504,6 +507,40 @@ std::string GeoCircle::as_wkt() const {
     return ss.str();
 }
 
+std::unique_ptr<GeoContainsIndex> GeoContainsIndex::create(const GeoShape* shape, int max_cells) {
+    switch (shape->type()) {
+    case GEO_SHAPE_POLYGON:
+        return std::unique_ptr<GeoContainsIndex>(
+                new GeoContainsIndex(shape, *((const GeoPolygon*)shape)->polygon(), max_cells));
+    case GEO_SHAPE_CIRCLE:
+        return std::unique_ptr<GeoContainsIndex>(
+                new GeoContainsIndex(shape, *((const GeoCircle*)shape)->cap(), max_cells));
+    default:
+        return nullptr;
+    }
+}
+
+GeoContainsIndex::GeoContainsIndex(const GeoShape* shape, const S2Region& region, int max_cells) : _shape(shape) {
+    S2RegionCoverer::Options options;
+    options.set_max_cells(max_cells);
+    S2RegionCoverer coverer(options);
+    _covering = std::make_unique<S2CellUnion>(coverer.GetCovering(region));
+    _interior_covering = std::make_unique<S2CellUnion>(coverer.GetInteriorCovering(region));
+}
+
+GeoContainsIndex::~GeoContainsIndex() = default;
+
+bool GeoContainsIndex::contains(const GeoPoint& point) const {
+    S2CellId cell_id(*point.point());
+    if (!_covering->Contains(cell_id)) {
+        return false;
+    }
+    if (_interior_covering->Contains(cell_id)) {
+        return true;
+    }
+    return _shape->contains(&point);
+}
+
 #if 0
 
 template<typename T>
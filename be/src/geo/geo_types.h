@@ -44,6 +44,8 @@
 class S2Polyline;
 class S2Polygon;
 class S2Cap;
+class S2CellUnion;
+class S2Region;
 
 template <typename T>
 class Vector3;
@@ -156,6 +158,8 @@ public:
 
     GeoShapeType type() const override { return GEO_SHAPE_CIRCLE; }
 
+    const S2Cap* cap() const { return _cap.get(); }
+
     bool contains(const GeoShape* rhs) const override;
     std::string as_wkt() const override;
 
@@ -167,6 +171,26 @@ private:
     std::unique_ptr<S2Cap> _cap;
 };
 
+// GeoContainsIndex decides whether a polygon or a circle contains the points by the S2 cell coverings of the shape.
+// A point out of the covering is not contained, and a point in the interior covering is contained, only the points
+// near the boundary need the exact test. It's built once for a constant shape, and used for all the rows.
+class GeoContainsIndex {
+public:
+    // Return nullptr if |shape| isn't a polygon or a circle, |shape| must outlive the index.
+    static std::unique_ptr<GeoContainsIndex> create(const GeoShape* shape, int max_cells);
+
+    ~GeoContainsIndex();
+
+    bool contains(const GeoPoint& point) const;
+
+private:
+    GeoContainsIndex(const GeoShape* shape, const S2Region& region, int max_cells);
+
+    const GeoShape* _shape;
+    std::unique_ptr<S2CellUnion> _covering;
+    std::unique_ptr<S2CellUnion> _interior_covering;
+};
+
 #if 0
 class GeoMultiPoint : public GeoShape {
 public:
@@ -0,0 +1,150 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "http/action/lake_cache_warmup_action.h"
+
+#include <rapidjson/document.h>
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+
+#include <string>
+#include <vector>
+
+#include "common/logging.h"
+#include "gutil/strings/numbers.h"
+#include "gutil/strings/substitute.h"
+#include "http/http_channel.h"
+#include "http/http_headers.h"
+#include "http/http_request.h"
+#include "http/http_status.h"
+#include "storage/lake/cache_warmer.h"
+#include "storage/lake/tablet.h"
+
+namespace starrocks {
+
+const static std::string HEADER_JSON = "application/json";
+
+void LakeCacheWarmupAction::handle(HttpRequest* req) {
+    VLOG_ROW << req->debug_string();
+    if (_exec_env->lake_cache_warmer() == nullptr) {
+        _handle_error(req, "Lake cache warmer is nullptr");
+    } else if (req->method() == HttpMethod::GET && !req->param("tablet_id").empty()) {
+        _handle_residency(req);
+    } else if (req->method() == HttpMethod::GET) {
+        _handle_progress(req);
+    } else if (req->method() == HttpMethod::POST) {
+        _handle_submit(req);
+    } else {
+        _handle_error(req,
+                      strings::Substitute("Not support $0 method: '$1'", to_method_desc(req->method()), req->uri()));
+    }
+}
+
+void LakeCacheWarmupAction::_handle(HttpRequest* req, const std::function<void(rapidjson::Document&)>& func) {
+    rapidjson::Document root;
+    root.SetObject();
+    func(root);
+    rapidjson::StringBuffer strbuf;
+    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(strbuf);
+    root.Accept(writer);
+    req->add_output_header(HttpHeaders::CONTENT_TYPE, HEADER_JSON.c_str());
+    HttpChannel::send_reply(req, HttpStatus::OK, strbuf.GetString());
+}
+
+void LakeCacheWarmupAction::_handle_progress(HttpRequest* req) {
+    auto progress = _exec_env->lake_cache_warmer()->progress();
+    _handle(req, [&](rapidjson::Document& root) {
+        auto& allocator = root.GetAllocator();
+        root.AddMember("total_tablets", rapidjson::Value(progress.total_tablets), allocator);
+        root.AddMember("finished_tablets", rapidjson::Value(progress.finished_tablets), allocator);
+        root.AddMember("failed_tablets", rapidjson::Value(progress.failed_tablets), allocator);
+        root.AddMember("pending_tablets", rapidjson::Value(progress.pending_tablets), allocator);
+        root.AddMember("loaded_bytes", rapidjson::Value(progress.loaded_bytes), allocator);
+    });
+}
+
+void LakeCacheWarmupAction::_handle_residency(HttpRequest* req) {
+    int64_t tablet_id = 0;
+    int64_t version = 0;
+    if (!safe_strto64(req->param("tablet_id"), &tablet_id) || !safe_strto64(req->param("version"), &version)) {
+        _handle_error(req, "Invalid parameters, expect integer \"tablet_id\" and \"version\"");
+        return;
+    }
+    auto residency = [&]() -> StatusOr<lake::TabletCacheResidency> {
+        ASSIGN_OR_RETURN(auto tablet, _exec_env->lake_tablet_manager()->get_tablet(tablet_id));
+        return tablet.get_cache_residency(version);
+    }();
+    if (!residency.ok()) {
+        _handle_error(req, residency.status().to_string());
+        return;
+    }
+    _handle(req, [&](rapidjson::Document& root) {
+        auto& allocator = root.GetAllocator();
+        root.AddMember("tablet_id", rapidjson::Value(tablet_id), allocator);
+        root.AddMember("version", rapidjson::Value(version), allocator);
+        root.AddMember("num_segments", rapidjson::Value(residency->num_segments), allocator);
+        root.AddMember("num_cached_segments", rapidjson::Value(residency->num_cached_segments), allocator);
+        root.AddMember("data_size", rapidjson::Value(residency->data_size), allocator);
+        root.AddMember("cached_data_size", rapidjson::Value(residency->cached_data_size), allocator);
+    });
+}
+
+void LakeCacheWarmupAction::_handle_submit(HttpRequest* req) {
+    rapidjson::Document body;
+    std::string request = req->get_request_body();
+    body.Parse(request.c_str(), request.size());
+    if (body.HasParseError() || !body.IsObject() || !body.HasMember("tablets") || !body["tablets"].IsArray()) {
+        _handle_error(req, "Invalid request body, expect {\"tablets\": [{\"id\": ..., \"version\": ...}]}");
+        return;
+    }
+    std::vector<lake::CacheWarmupTask> tasks;
+    for (const auto& tablet : body["tablets"].GetArray()) {
+        if (!tablet.IsObject() || !tablet.HasMember("id") || !tablet["id"].IsInt64() || !tablet.HasMember("version") ||
+            !tablet["version"].IsInt64()) {
+            _handle_error(req, "Invalid tablet in request body, expect integer \"id\" and \"version\"");
+            return;
+        }
+        lake::CacheWarmupTask task;
+        task.tablet_id = tablet["id"].GetInt64();
+        task.version = tablet["version"].GetInt64();
+        if (tablet.HasMember("columns") && tablet["columns"].IsArray()) {
+            for (const auto& column : tablet["columns"].GetArray()) {
+                if (column.IsString()) {
+                    task.columns.emplace_back(column.GetString(), column.GetStringLength());
+                }
+            }
+        }
+        tasks.emplace_back(std::move(task));
+    }
+    size_t num_tasks = tasks.size();
+    auto st = _exec_env->lake_cache_warmer()->submit(std::move(tasks));
+    if (!st.ok()) {
+        _handle_error(req, st.to_string());
+        return;
+    }
+    _handle(req, [&](rapidjson::Document& root) {
+        auto& allocator = root.GetAllocator();
+        root.AddMember("status", rapidjson::StringRef("OK"), allocator);
+        root.AddMember("submitted_tablets", rapidjson::Value(static_cast<int64_t>(num_tasks)), allocator);
+    });
+}
+
+void LakeCacheWarmupAction::_handle_error(HttpRequest* req, const std::string& err_msg) {
+    _handle(req, [err_msg](rapidjson::Document& root) {
+        auto& allocator = root.GetAllocator();
+        root.AddMember("error", rapidjson::Value(err_msg.c_str(), err_msg.size()), allocator);
+    });
+}
+
+} // namespace starrocks
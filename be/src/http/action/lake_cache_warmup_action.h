@@ -0,0 +1,51 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <rapidjson/document.h>
+
+#include <functional>
+#include <string>
+
+#include "http/http_handler.h"
+#include "runtime/exec_env.h"
+
+namespace starrocks {
+
+// Warm up the cache of lake tablets in background.
+//   POST /api/lake/cache_warmup
+//     {"tablets": [{"id": 10001, "version": 5, "columns": ["c1", "c2"]}, ...]}
+//     "columns" is optional, all data of the tablet is loaded if absent.
+//   GET /api/lake/cache_warmup
+//     return the progress of the warmup.
+//   GET /api/lake/cache_warmup?tablet_id=10001&version=5
+//     return the number and data size of the segments of the tablet in the local cache.
+class LakeCacheWarmupAction : public HttpHandler {
+public:
+    explicit LakeCacheWarmupAction(ExecEnv* exec_env) : _exec_env(exec_env) {}
+    ~LakeCacheWarmupAction() override = default;
+
+    void handle(HttpRequest* req) override;
+
+private:
+    void _handle(HttpRequest* req, const std::function<void(rapidjson::Document& root)>& func);
+    void _handle_progress(HttpRequest* req);
+    void _handle_residency(HttpRequest* req);
+    void _handle_submit(HttpRequest* req);
+    void _handle_error(HttpRequest* req, const std::string& error_msg);
+    ExecEnv* _exec_env;
+};
+
+} // namespace starrocks
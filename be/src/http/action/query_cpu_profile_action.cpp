@@ -0,0 +1,119 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "http/action/query_cpu_profile_action.h"
+
+#include <rapidjson/document.h>
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+
+#include "common/logging.h"
+#include "gutil/strings/substitute.h"
+#include "http/http_channel.h"
+#include "http/http_headers.h"
+#include "http/http_request.h"
+#include "http/http_status.h"
+#include "runtime/query_cpu_profiler.h"
+
+namespace starrocks {
+
+const static std::string HEADER_JSON = "application/json";
+const static std::string ACTION_KEY = "action";
+const static std::string ACTION_LIST = "list";
+const static std::string ACTION_STACKS = "stacks";
+const static std::string QUERY_ID_KEY = "query_id";
+const static std::string FRAGMENT_INSTANCE_ID_KEY = "fragment_instance_id";
+
+// Parse the id printed as "<hi>-<lo>" in hex.
+static bool parse_unique_id(const std::string& str, UniqueId* id) {
+    const size_t pos = str.find('-');
+    if (pos == std::string::npos || pos == 0 || pos > 16 || str.size() - pos - 1 == 0 || str.size() - pos - 1 > 16) {
+        return false;
+    }
+    for (size_t i = 0; i < str.size(); i++) {
+        if (i != pos && !isxdigit(str[i])) {
+            return false;
+        }
+    }
+    std::string lower = str;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    *id = UniqueId(std::string_view(lower).substr(0, pos), std::string_view(lower).substr(pos + 1));
+    return true;
+}
+
+void QueryCpuProfileAction::handle(HttpRequest* req) {
+    VLOG_ROW << req->debug_string();
+    const auto& action = req->param(ACTION_KEY);
+    if (req->method() != HttpMethod::GET) {
+        _handle_error(req,
+                      strings::Substitute("Not support $0 method: '$1'", to_method_desc(req->method()), req->uri()));
+    } else if (action == ACTION_LIST) {
+        _handle_list(req);
+    } else if (action == ACTION_STACKS) {
+        _handle_stacks(req);
+    } else {
+        _handle_error(req, strings::Substitute("Not support GET method: '$0'", req->uri()));
+    }
+}
+
+void QueryCpuProfileAction::_handle_list(HttpRequest* req) {
+    auto* profiler = QueryCpuProfiler::instance();
+    rapidjson::Document root;
+    root.SetObject();
+    auto& allocator = root.GetAllocator();
+    rapidjson::Value queries(rapidjson::kArrayType);
+    for (const auto& query : profiler->list_queries()) {
+        rapidjson::Value query_obj(rapidjson::kObjectType);
+        query_obj.AddMember("query_id", rapidjson::Value(query.query_id.to_string().c_str(), allocator), allocator);
+        query_obj.AddMember("samples", query.num_samples, allocator);
+        query_obj.AddMember("stacks", query.num_stacks, allocator);
+        query_obj.AddMember("last_sample_time_ms", query.last_sample_time_ms, allocator);
+        queries.PushBack(query_obj, allocator);
+    }
+    root.AddMember("queries", queries, allocator);
+    root.AddMember("dropped_samples", profiler->num_dropped_samples(), allocator);
+
+    rapidjson::StringBuffer strbuf;
+    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(strbuf);
+    root.Accept(writer);
+    req->add_output_header(HttpHeaders::CONTENT_TYPE, HEADER_JSON.c_str());
+    HttpChannel::send_reply(req, HttpStatus::OK, strbuf.GetString());
+}
+
+void QueryCpuProfileAction::_handle_stacks(HttpRequest* req) {
+    UniqueId query_id;
+    if (!parse_unique_id(req->param(QUERY_ID_KEY), &query_id)) {
+        _handle_error(req, strings::Substitute("Invalid query_id: '$0'", req->param(QUERY_ID_KEY)));
+        return;
+    }
+    UniqueId fragment_instance_id;
+    const auto& fragment_instance_id_str = req->param(FRAGMENT_INSTANCE_ID_KEY);
+    if (!fragment_instance_id_str.empty() && !parse_unique_id(fragment_instance_id_str, &fragment_instance_id)) {
+        _handle_error(req, strings::Substitute("Invalid fragment_instance_id: '$0'", fragment_instance_id_str));
+        return;
+    }
+    HttpChannel::send_reply(req, HttpStatus::OK,
+                            QueryCpuProfiler::instance()->folded_stacks(query_id, fragment_instance_id));
+}
+
+void QueryCpuProfileAction::_handle_error(HttpRequest* req, const std::string& err_msg) {
+    HttpChannel::send_reply(req, HttpStatus::BAD_REQUEST, err_msg);
+}
+
+} // namespace starrocks
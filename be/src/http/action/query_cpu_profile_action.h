@@ -0,0 +1,41 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include "http/http_handler.h"
+
+namespace starrocks {
+
+// Get the cpu samples of the recent queries taken by QueryCpuProfiler.
+//
+// GET /api/query_cpu_profile/list
+//      the sampled queries in JSON, the latest sampled first.
+// GET /api/query_cpu_profile/stacks?query_id=<id>[&fragment_instance_id=<id>]
+//      the sampled stacks of a query in the folded format, which flamegraph.pl and speedscope accept.
+class QueryCpuProfileAction : public HttpHandler {
+public:
+    QueryCpuProfileAction() = default;
+    ~QueryCpuProfileAction() override = default;
+
+    void handle(HttpRequest* req) override;
+
+private:
+    void _handle_list(HttpRequest* req);
+    void _handle_stacks(HttpRequest* req);
+    void _handle_error(HttpRequest* req, const std::string& error_msg);
+};
+
+} // namespace starrocks
@@ -63,6 +63,7 @@
 #include "runtime/fragment_mgr.h"
 #include "runtime/load_path_mgr.h"
 #include "runtime/plan_fragment_executor.h"
+#include "runtime/stream_load/group_commit_manager.h"
 #include "runtime/stream_load/load_stream_mgr.h"
 #include "runtime/stream_load/stream_load_context.h"
 #include "runtime/stream_load/stream_load_executor.h"
@@ -124,7 +125,41 @@ static bool is_format_support_streaming(TFileFormatType::type format) {
     }
 }
 
-StreamLoadAction::StreamLoadAction(ExecEnv* exec_env) : _exec_env(exec_env) {
+// The loads of the same group key are merged into one group commit load, so they must be bound for the same table
+// with the same user and load properties.
+static std::string group_commit_key(HttpRequest* http_req, const StreamLoadContext* ctx) {
+    static const std::string* const kHeaders[] = {&HTTP_COLUMNS,
+                                                  &HTTP_WHERE,
+                                                  &HTTP_COLUMN_SEPARATOR,
+                                                  &HTTP_TRIM_SPACE,
+                                                  &HTTP_ENCLOSE,
+                                                  &HTTP_ESCAPE,
+                                                  &HTTP_MAX_FILTER_RATIO,
+                                                  &HTTP_TIMEOUT,
+                                                  &HTTP_PARTITIONS,
+                                                  &HTTP_TEMP_PARTITIONS,
+                                                  &HTTP_NEGATIVE,
+                                                  &HTTP_STRICT_MODE,
+                                                  &HTTP_TIMEZONE,
+                                                  &HTTP_LOAD_MEM_LIMIT,
+                                                  &HTTP_EXEC_MEM_LIMIT,
+                                                  &HTTP_PARTIAL_UPDATE,
+                                                  &HTTP_MERGE_CONDITION,
+                                                  &HTTP_TRANSMISSION_COMPRESSION_TYPE,
+                                                  &HTTP_LOAD_DOP,
+                                                  &HTTP_PARSE_DOP,
+                                                  &HTTP_ENABLE_REPLICATED_STORAGE};
+    std::string key;
+    key.append(ctx->db).append(1, '\n').append(ctx->table).append(1, '\n');
+    key.append(ctx->auth.user).append(1, '\n').append(ctx->auth.passwd);
+    for (const auto* header : kHeaders) {
+        key.append(1, '\n').append(http_req->header(*header));
+    }
+    return key;
+}
+
+StreamLoadAction::StreamLoadAction(ExecEnv* exec_env)
+        : _exec_env(exec_env), _group_commit_mgr(std::make_unique<GroupCommitManager>(exec_env)) {
     StarRocksMetrics::instance()->metrics()->register_metric("streaming_load_requests_total",
                                                              &streaming_load_requests_total);
     StarRocksMetrics::instance()->metrics()->register_metric("streaming_load_bytes", &streaming_load_bytes);
@@ -143,7 +178,7 @@ void StreamLoadAction::handle(HttpRequest* req) {
 
     // status already set to fail
     if (ctx->status.ok()) {
-        ctx->status = _handle(ctx);
+        ctx->status = ctx->group_commit ? _handle_group_commit(req, ctx) : _handle(ctx);
         if (!ctx->status.ok() && ctx->status.code() != TStatusCode::PUBLISH_TIMEOUT) {
             LOG(WARNING) << "Fail to handle streaming load, id=" << ctx->id
                          << " errmsg=" << ctx->status.get_error_msg();
@@ -203,6 +238,22 @@ Status StreamLoadAction::_handle(StreamLoadContext* ctx) {
     return Status::OK();
 }
 
+Status StreamLoadAction::_handle_group_commit(HttpRequest* http_req, StreamLoadContext* ctx) {
+    if (ctx->receive_bytes != ctx->body_bytes) {
+        LOG(WARNING) << "receive body don't equal with body bytes, body_bytes=" << ctx->body_bytes
+                     << ", receive_bytes=" << ctx->receive_bytes << ", id=" << ctx->id;
+        return Status::InternalError("receive body don't equal with body bytes");
+    }
+    ctx->buffer->flip();
+    // The leader of the group begins the group load with its own http request, which is alive until the group
+    // is committed.
+    return _group_commit_mgr->append_and_wait(
+            group_commit_key(http_req, ctx), ctx, [this, http_req](StreamLoadContext* group_ctx) {
+                RETURN_IF_ERROR(_exec_env->stream_load_executor()->begin_txn(group_ctx));
+                return _process_put(http_req, group_ctx);
+            });
+}
+
 int StreamLoadAction::on_header(HttpRequest* req) {
     streaming_load_current_processing.increment(1);
 
@@ -307,6 +358,16 @@ Status StreamLoadAction::_on_header(HttpRequest* http_req, StreamLoadContext* ct
         ctx->timeout_second = timeout_second;
     }
 
+    // Small csv loads are merged into a group commit load, their transactions are begun by the group.
+    if (boost::iequals(http_req->header(HTTP_GROUP_COMMIT), "true") &&
+        ctx->format == TFileFormatType::FORMAT_CSV_PLAIN && ctx->body_bytes > 0 &&
+        ctx->body_bytes <= config::group_commit_max_body_bytes && http_req->header(HTTP_ROW_DELIMITER).empty() &&
+        http_req->header(HTTP_SKIP_HEADER).empty()) {
+        ctx->group_commit = true;
+        ctx->buffer = ByteBuffer::allocate(ctx->body_bytes);
+        return Status::OK();
+    }
+
     // begin transaction
     int64_t begin_txn_start_time = MonotonicNanos();
     RETURN_IF_ERROR(_exec_env->stream_load_executor()->begin_txn(ctx));
@@ -337,6 +398,11 @@ void StreamLoadAction::on_chunk_data(HttpRequest* req) {
                     ctx->format == TFileFormatType::FORMAT_JSON ? std::max(len, ctx->kDefaultBufferSize) : len);
 
         } else if (ctx->buffer->remaining() < len) {
+            if (ctx->group_commit) {
+                // the whole body of a group commit load is buffered
+                ctx->status = Status::InternalError("receive body exceeds the body bytes");
+                return;
+            }
             if (ctx->format == TFileFormatType::FORMAT_JSON) {
                 // For json format, we need build a complete json before we push the buffer to the pipe.
                 // buffer capacity is not enough, so we try to expand the buffer.
@@ -402,6 +468,19 @@ Status StreamLoadAction::_process_put(HttpRequest* http_req, StreamLoadContext*
     if (ctx->use_streaming) {
         auto pipe =
                 std::make_shared<StreamLoadPipe>(1024 * 1024 /* max_buffered_bytes */, 64 * 1024 /* min_chunk_size */);
+        if (!http_req->header(HTTP_PARSE_DOP).empty()) {
+            // The rows are loaded out of order if the csv is parsed in parallel.
+            try {
+                auto parse_dop = std::stoll(http_req->header(HTTP_PARSE_DOP));
+                if (parse_dop > config::max_load_dop || parse_dop < 1) {
+                    return Status::InvalidArgument("parse_dop should between [1-" +
+                                                   std::to_string(config::max_load_dop) + "]");
+                }
+                pipe->set_num_parsers(parse_dop);
+            } catch (const std::invalid_argument& e) {
+                return Status::InvalidArgument("Invalid parse_dop format");
+            }
+        }
         RETURN_IF_ERROR(_exec_env->load_stream_mgr()->put(ctx->id, pipe));
         request.fileType = TFileType::FILE_STREAM;
         ctx->body_sink = pipe;
@@ -35,6 +35,7 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 
 #include "gen_cpp/PlanNodes_types.h"
 #include "http/http_handler.h"
@@ -45,6 +46,7 @@
 namespace starrocks {
 
 class ExecEnv;
+class GroupCommitManager;
 class Status;
 class StreamLoadContext;
 
@@ -65,12 +67,14 @@ public:
 private:
     Status _on_header(HttpRequest* http_req, StreamLoadContext* ctx);
     Status _handle(StreamLoadContext* ctx);
+    Status _handle_group_commit(HttpRequest* http_req, StreamLoadContext* ctx);
     Status _data_saved_path(HttpRequest* req, std::string* file_path);
     Status _execute_plan_fragment(StreamLoadContext* ctx);
     Status _process_put(HttpRequest* http_req, StreamLoadContext* ctx);
 
 private:
     ExecEnv* _exec_env;
+    std::unique_ptr<GroupCommitManager> _group_commit_mgr;
 };
 
 } // namespace starrocks
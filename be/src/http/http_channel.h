@@ -44,7 +44,7 @@ public:
 
     static void send_reply(HttpRequest* request, HttpStatus status, const std::string& content);
 
-    static void send_file(HttpRequest* request, int fd, size_t off, size_t size);
+    static void send_file(HttpRequest* request, int fd, size_t off, size_t size, HttpStatus status = HttpStatus::OK);
 };
 
 } // namespace starrocks
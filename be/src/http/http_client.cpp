@@ -17,7 +17,10 @@
 
 #include "http/http_client.h"
 
+#include <unistd.h>
+
 #include "common/config.h"
+#include "util/bandwidth_throttle.h"
 
 namespace starrocks {
 
@@ -168,7 +171,7 @@ Status HttpClient::execute(const std::function<bool(const void* data, size_t len
     return Status::OK();
 }
 
-Status HttpClient::download(const std::string& local_path) {
+Status HttpClient::download(const std::string& local_path, int64_t offset, BandwidthThrottle* throttle) {
     // set method to GET
     set_method(GET);
 
@@ -179,13 +182,24 @@ Status HttpClient::download(const std::string& local_path) {
     curl_easy_setopt(_curl, CURLOPT_MAX_RECV_SPEED_LARGE, config::max_download_speed_kbps * 1024);
 
     auto fp_closer = [](FILE* fp) { fclose(fp); };
-    std::unique_ptr<FILE, decltype(fp_closer)> fp(fopen(local_path.c_str(), "w"), fp_closer);
+    std::unique_ptr<FILE, decltype(fp_closer)> fp(fopen(local_path.c_str(), offset > 0 ? "r+" : "w"), fp_closer);
     if (fp == nullptr) {
         LOG(WARNING) << "open file failed, file=" << local_path;
         return Status::InternalError("open file failed");
     }
+    if (offset > 0) {
+        // drop the bytes after |offset| possibly written by the interrupted download
+        if (ftruncate(fileno(fp.get()), offset) != 0 || fseeko(fp.get(), offset, SEEK_SET) != 0) {
+            LOG(WARNING) << "fail to seek file to resume download, file=" << local_path << ", offset=" << offset;
+            return Status::InternalError("fail to seek file to resume download");
+        }
+    }
+    curl_easy_setopt(_curl, CURLOPT_RESUME_FROM_LARGE, static_cast<curl_off_t>(offset));
     Status status;
-    auto callback = [&status, &fp, &local_path](const void* data, size_t length) {
+    auto callback = [&status, &fp, &local_path, throttle](const void* data, size_t length) {
+        if (throttle != nullptr) {
+            throttle->throttle(length);
+        }
         auto res = fwrite(data, length, 1, fp.get());
         if (res != 1) {
             LOG(WARNING) << "fail to write data to file, file=" << local_path << ", error=" << ferror(fp.get());
@@ -29,6 +29,8 @@
 #include "http/utils.h"
 namespace starrocks {
 
+class BandwidthThrottle;
+
 // Helper class to access HTTP resource
 class HttpClient {
 public:
@@ -110,7 +112,12 @@ public:
 
     // helper function to download a file, you can call this function to downlaod
     // a file to local_path
-    Status download(const std::string& local_path);
+    Status download(const std::string& local_path) { return download(local_path, 0, nullptr); }
+
+    // Download the remote file from |offset| into local_path, which keeps its first |offset| bytes to resume an
+    // interrupted download, it fails if the server does not support the ranges. The received bytes are throttled
+    // by |throttle| if it's not nullptr.
+    Status download(const std::string& local_path, int64_t offset, BandwidthThrottle* throttle);
 
     Status execute_post_request(const std::string& payload, std::string* response);
 
@@ -35,8 +35,11 @@
 #include "http/utils.h"
 
 #include <fcntl.h>
+#include <fmt/format.h>
 #include <sys/stat.h>
 
+#include <algorithm>
+
 #include "common/logging.h"
 #include "common/status.h"
 #include "common/utils.h"
@@ -45,6 +48,7 @@
 #include "http/http_headers.h"
 #include "http/http_request.h"
 #include "util/path_util.h"
+#include "util/string_parser.hpp"
 #include "util/url_coding.h"
 
 namespace starrocks {
@@ -122,6 +126,57 @@ std::string get_content_type(const std::string& file_name) {
     return "";
 }
 
+bool parse_byte_range(const std::string& range, int64_t file_size, int64_t* start, int64_t* end) {
+    *start = 0;
+    *end = file_size;
+    static const std::string kUnit = "bytes=";
+    if (range.compare(0, kUnit.size(), kUnit) != 0 || range.find(',') != std::string::npos) {
+        return true;
+    }
+    const std::string spec = range.substr(kUnit.size());
+    const size_t dash = spec.find('-');
+    if (dash == std::string::npos) {
+        return true;
+    }
+    auto parse = [](const std::string& s, int64_t* value) {
+        if (s.empty() || s.find_first_not_of("0123456789") != std::string::npos) {
+            return false;
+        }
+        StringParser::ParseResult result;
+        *value = StringParser::string_to_int<int64_t>(s.data(), s.size(), &result);
+        return result == StringParser::PARSE_SUCCESS;
+    };
+    const std::string first = spec.substr(0, dash);
+    const std::string last = spec.substr(dash + 1);
+    int64_t first_value = 0;
+    int64_t last_value = 0;
+    if (first.empty()) {
+        // the last |last_value| bytes
+        if (!parse(last, &last_value)) {
+            return true;
+        }
+        if (last_value == 0) {
+            return false;
+        }
+        *start = std::max<int64_t>(0, file_size - last_value);
+        return true;
+    }
+    if (!parse(first, &first_value) || (!last.empty() && !parse(last, &last_value))) {
+        return true;
+    }
+    if (!last.empty() && last_value < first_value) {
+        return true;
+    }
+    if (first_value >= file_size) {
+        return false;
+    }
+    *start = first_value;
+    if (!last.empty()) {
+        *end = std::min(file_size, last_value + 1);
+    }
+    return true;
+}
+
 void do_file_response(const std::string& file_path, HttpRequest* req) {
     if (file_path.find("..") != std::string::npos) {
         LOG(WARNING) << "Not allowed to read relative path: " << file_path;
@@ -148,22 +203,32 @@ void do_file_response(const std::string& file_path, HttpRequest* req) {
     int64_t file_size = st.st_size;
 
     // TODO(lingbin): process "IF_MODIFIED_SINCE" header
-    // TODO(lingbin): process "RANGE" header
+    int64_t start = 0;
+    int64_t end = file_size;
     const std::string& range_header = req->header(HttpHeaders::RANGE);
-    if (!range_header.empty()) {
-        // analyse range header
+    if (!range_header.empty() && !parse_byte_range(range_header, file_size, &start, &end)) {
+        close(fd);
+        req->add_output_header(HttpHeaders::CONTENT_RANGE, fmt::format("bytes */{}", file_size).c_str());
+        HttpChannel::send_error(req, HttpStatus::REQUESTED_RANGE_NOT_SATISFIED);
+        return;
     }
+    const bool partial = start > 0 || end < file_size;
 
     req->add_output_header(HttpHeaders::CONTENT_TYPE, get_content_type(file_path).c_str());
+    req->add_output_header(HttpHeaders::ACCEPT_RANGES, "bytes");
+    if (partial) {
+        req->add_output_header(HttpHeaders::CONTENT_RANGE,
+                               fmt::format("bytes {}-{}/{}", start, end - 1, file_size).c_str());
+    }
 
     if (req->method() == HttpMethod::HEAD) {
         close(fd);
-        req->add_output_header(HttpHeaders::CONTENT_LENGTH, std::to_string(file_size).c_str());
+        req->add_output_header(HttpHeaders::CONTENT_LENGTH, std::to_string(end - start).c_str());
         HttpChannel::send_reply(req);
         return;
     }
 
-    HttpChannel::send_file(req, fd, 0, file_size);
+    HttpChannel::send_file(req, fd, start, end - start, partial ? HttpStatus::PARTIAL_CONTENT : HttpStatus::OK);
 }
 
 void do_dir_response(const std::string& dir_path, HttpRequest* req) {
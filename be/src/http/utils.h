@@ -35,6 +35,12 @@ bool parse_basic_auth(const HttpRequest& req, std::string* user, std::string* pa
 
 bool parse_basic_auth(const HttpRequest& req, AuthInfo* auth);
 
+// Parse the value of a Range header of a file of |file_size| bytes into the bytes [*start, *end).
+// The single range of "bytes=<first>-[<last>]" or "bytes=-<suffix length>" is supported, and the others,
+// e.g. multiple ranges, are regarded as the whole file. Return false if the range is not satisfiable.
+bool parse_byte_range(const std::string& range, int64_t file_size, int64_t* start, int64_t* end);
+
+// Send the file, or the part of it requested by the Range header.
 void do_file_response(const std::string& dir_path, HttpRequest* req);
 
 void do_dir_response(const std::string& dir_path, HttpRequest* req);
@@ -0,0 +1,84 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "io/aligned_buffer_pool.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+#include "common/config.h"
+#include "common/logging.h"
+
+namespace starrocks::io {
+
+void AlignedBufferPool::Buffer::reset() {
+    if (_data != nullptr) {
+        _pool->_release(_data);
+        _data = nullptr;
+    }
+}
+
+AlignedBufferPool::AlignedBufferPool(size_t buffer_size, size_t capacity)
+        : _buffer_size((std::max<size_t>(buffer_size, 1) + kAlignment - 1) / kAlignment * kAlignment),
+          _max_buffers(std::max<size_t>(capacity / _buffer_size, 1)) {}
+
+AlignedBufferPool::~AlignedBufferPool() {
+    DCHECK_EQ(_free_buffers.size(), _num_allocated) << "buffers in use when the pool is destroyed";
+    for (uint8_t* data : _free_buffers) {
+        std::free(data);
+    }
+}
+
+AlignedBufferPool* AlignedBufferPool::instance() {
+    // Never destroyed, the buffers may be still in use by the scan threads at exit.
+    static auto* pool = new AlignedBufferPool(config::direct_io_buffer_size, config::direct_io_buffer_pool_capacity);
+    return pool;
+}
+
+AlignedBufferPool::Buffer AlignedBufferPool::acquire() {
+    std::unique_lock l(_mutex);
+    _cv.wait(l, [this] { return !_free_buffers.empty() || _num_allocated < _max_buffers; });
+    if (!_free_buffers.empty()) {
+        uint8_t* data = _free_buffers.back();
+        _free_buffers.pop_back();
+        return {this, data};
+    }
+    auto* data = static_cast<uint8_t*>(std::aligned_alloc(kAlignment, _buffer_size));
+    if (data == nullptr) {
+        throw std::bad_alloc();
+    }
+    _num_allocated++;
+    return {this, data};
+}
+
+void AlignedBufferPool::_release(uint8_t* data) {
+    {
+        std::lock_guard l(_mutex);
+        _free_buffers.push_back(data);
+    }
+    _cv.notify_one();
+}
+
+size_t AlignedBufferPool::num_allocated() const {
+    std::lock_guard l(_mutex);
+    return _num_allocated;
+}
+
+size_t AlignedBufferPool::num_free() const {
+    std::lock_guard l(_mutex);
+    return _free_buffers.size();
+}
+
+} // namespace starrocks::io
@@ -0,0 +1,94 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "gutil/macros.h"
+
+namespace starrocks::io {
+
+// A pool of the aligned buffers of the same size used by the direct io reads. The buffers are allocated on
+// demand and kept for reuse, at most |capacity| bytes of buffers are allocated, `acquire()` waits for a buffer
+// released when all are in use, so the memory used by direct io is bounded.
+class AlignedBufferPool {
+public:
+    static constexpr size_t kAlignment = 4096;
+
+    class Buffer {
+    public:
+        Buffer() = default;
+        Buffer(AlignedBufferPool* pool, uint8_t* data) : _pool(pool), _data(data) {}
+        ~Buffer() { reset(); }
+
+        Buffer(Buffer&& other) noexcept : _pool(other._pool), _data(other._data) { other._data = nullptr; }
+        Buffer& operator=(Buffer&& other) noexcept {
+            if (this != &other) {
+                reset();
+                _pool = other._pool;
+                _data = other._data;
+                other._data = nullptr;
+            }
+            return *this;
+        }
+        Buffer(const Buffer&) = delete;
+        Buffer& operator=(const Buffer&) = delete;
+
+        uint8_t* data() const { return _data; }
+        size_t size() const { return _pool->buffer_size(); }
+
+        // Return the buffer to the pool.
+        void reset();
+
+    private:
+        AlignedBufferPool* _pool = nullptr;
+        uint8_t* _data = nullptr;
+    };
+
+    // |buffer_size| is rounded up to the multiple of kAlignment.
+    AlignedBufferPool(size_t buffer_size, size_t capacity);
+
+    ~AlignedBufferPool();
+
+    DISALLOW_COPY_AND_MOVE(AlignedBufferPool);
+
+    // The pool created with `direct_io_buffer_size` and `direct_io_buffer_pool_capacity`.
+    static AlignedBufferPool* instance();
+
+    Buffer acquire();
+
+    size_t buffer_size() const { return _buffer_size; }
+
+    size_t num_allocated() const;
+
+    size_t num_free() const;
+
+private:
+    void _release(uint8_t* data);
+
+    const size_t _buffer_size;
+    const size_t _max_buffers;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _cv;
+    std::vector<uint8_t*> _free_buffers;
+    size_t _num_allocated = 0;
+};
+
+} // namespace starrocks::io
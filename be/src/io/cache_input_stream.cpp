@@ -87,7 +87,7 @@ StatusOr<int64_t> CacheInputStream::read(void* out, int64_t count) {
 
         if (_enable_populate_cache) {
             SCOPED_RAW_TIMER(&_stats.write_cache_ns);
-            Status r = cache->write_cache(_cache_key, block_offset, load_size, src);
+            Status r = cache->write_cache_async(_cache_key, block_offset, load_size, src);
             if (r.ok()) {
                 _stats.write_cache_count += 1;
                 _stats.write_cache_bytes += load_size;
@@ -123,6 +123,33 @@ StatusOr<int64_t> CacheInputStream::read(void* out, int64_t count) {
     DCHECK(p == pe);
     return count;
 }
+
+bool CacheInputStream::allows_peek() const {
+    return true;
+}
+
+StatusOr<std::string_view> CacheInputStream::peek(int64_t count) {
+    // Only the bytes in a cached block can be returned without copy.
+    BlockCache* cache = BlockCache::instance();
+    const int64_t BLOCK_SIZE = cache->block_size();
+    count = std::min(_size - _offset, count);
+    int64_t block_offset = _offset / BLOCK_SIZE * BLOCK_SIZE;
+    int64_t shift = _offset - block_offset;
+    if (shift + count > BLOCK_SIZE) {
+        return Status::NotSupported("CacheInputStream::peek across blocks");
+    }
+    _peek_handle.reset();
+    {
+        SCOPED_RAW_TIMER(&_stats.read_cache_ns);
+        ASSIGN_OR_RETURN(_peek_handle, cache->read_block_handle(_cache_key, block_offset));
+    }
+    if (shift + count > static_cast<int64_t>(_peek_handle->size())) {
+        return Status::NotSupported("CacheInputStream::peek beyond cached block");
+    }
+    _stats.read_cache_count += 1;
+    _stats.read_cache_bytes += count;
+    return std::string_view(_peek_handle->data() + shift, count);
+}
 #else
 StatusOr<int64_t> CacheInputStream::read(void* out, int64_t count) {
     int64_t load_size = std::min(count, _size - _offset);
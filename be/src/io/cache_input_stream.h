@@ -17,6 +17,7 @@
 #include <memory>
 #include <string>
 
+#include "block_cache/kv_cache.h"
 #include "io/seekable_input_stream.h"
 
 namespace starrocks::io {
@@ -47,6 +48,15 @@ public:
 
     StatusOr<int64_t> get_size() override;
 
+#ifdef WITH_BLOCK_CACHE
+    bool allows_peek() const override;
+
+    // Return the upcoming bytes in the cached block without copy, the block is pinned in cache until the next
+    // peek or the stream is destroyed. NotFound if the block is not cached, and NotSupported if the bytes
+    // span multiple blocks.
+    StatusOr<std::string_view> peek(int64_t count) override;
+#endif
+
     const Stats& stats() { return _stats; }
 
     void set_enable_populate_cache(bool v) { _enable_populate_cache = v; }
@@ -60,6 +70,7 @@ private:
     Stats _stats;
     int64_t _size;
     bool _enable_populate_cache = false;
+    KvCacheHandlePtr _peek_handle;
 };
 
 } // namespace starrocks::io
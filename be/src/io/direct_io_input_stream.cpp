@@ -0,0 +1,133 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "io/direct_io_input_stream.h"
+
+#include <fmt/format.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "gutil/macros.h"
+#include "io/io_error.h"
+
+namespace starrocks::io {
+
+static constexpr int64_t kAlignment = AlignedBufferPool::kAlignment;
+
+static inline bool is_aligned(int64_t value) {
+    return (value & (kAlignment - 1)) == 0;
+}
+
+DirectIoInputStream::DirectIoInputStream(std::shared_ptr<SeekableInputStream> buffered, int direct_fd,
+                                         AlignedBufferPool* pool)
+        : _buffered(std::move(buffered)), _direct_fd(direct_fd), _pool(pool) {}
+
+DirectIoInputStream::~DirectIoInputStream() {
+    int res;
+    RETRY_ON_EINTR(res, ::close(_direct_fd));
+    PLOG_IF(ERROR, res != 0) << "close() failed";
+}
+
+bool DirectIoInputStream::_use_direct_io(int64_t count) {
+    return count >= config::direct_io_min_read_size;
+}
+
+StatusOr<int64_t> DirectIoInputStream::read(void* data, int64_t count) {
+    ASSIGN_OR_RETURN(auto nread, read_at(_offset, data, count));
+    _offset += nread;
+    return nread;
+}
+
+StatusOr<int64_t> DirectIoInputStream::read_at(int64_t offset, void* data, int64_t count) {
+    if (!_use_direct_io(count)) {
+        return _buffered->read_at(offset, data, count);
+    }
+    return _direct_read_at(offset, data, count);
+}
+
+Status DirectIoInputStream::read_at_fully(int64_t offset, void* data, int64_t count) {
+    if (!_use_direct_io(count)) {
+        return _buffered->read_at_fully(offset, data, count);
+    }
+    ASSIGN_OR_RETURN(auto nread, _direct_read_at(offset, data, count));
+    if (nread < count) {
+        return Status::IOError("cannot read fully");
+    }
+    return Status::OK();
+}
+
+Status DirectIoInputStream::read_ranges_fully(const std::vector<ReadRange>& ranges) {
+    std::vector<ReadRange> small_ranges;
+    for (const auto& r : ranges) {
+        if (_use_direct_io(r.count)) {
+            RETURN_IF_ERROR(read_at_fully(r.offset, r.data, r.count));
+        } else {
+            small_ranges.push_back(r);
+        }
+    }
+    return small_ranges.empty() ? Status::OK() : _buffered->read_ranges_fully(small_ranges);
+}
+
+Status DirectIoInputStream::seek(int64_t offset) {
+    if (offset < 0) return Status::InvalidArgument(fmt::format("Invalid offset {}", offset));
+    _offset = offset;
+    return Status::OK();
+}
+
+StatusOr<int64_t> DirectIoInputStream::_direct_read_at(int64_t offset, void* data, int64_t count) {
+    int64_t total = 0;
+    while (total < count) {
+        int64_t pos = offset + total;
+        int64_t remain = count - total;
+        auto* dst = static_cast<uint8_t*>(data) + total;
+        ssize_t res;
+        if (is_aligned(pos) && is_aligned(reinterpret_cast<uintptr_t>(dst)) && remain >= kAlignment) {
+            // Read into the destination directly.
+            RETRY_ON_EINTR(res, ::pread(_direct_fd, dst, remain & ~(kAlignment - 1), pos));
+            if (UNLIKELY(res < 0)) {
+                return io_error("pread", errno);
+            }
+            if (res == 0) {
+                break;
+            }
+            total += res;
+            continue;
+        }
+        // Read the aligned range covering [pos, pos + remain) into the buffer, at most a buffer a time.
+        auto buffer = _pool->acquire();
+        int64_t aligned_pos = pos & ~(kAlignment - 1);
+        int64_t skip = pos - aligned_pos;
+        auto to_read = std::min<int64_t>(buffer.size(), (skip + remain + kAlignment - 1) & ~(kAlignment - 1));
+        RETRY_ON_EINTR(res, ::pread(_direct_fd, buffer.data(), to_read, aligned_pos));
+        if (UNLIKELY(res < 0)) {
+            return io_error("pread", errno);
+        }
+        if (res <= skip) {
+            break;
+        }
+        int64_t copied = std::min<int64_t>(res - skip, remain);
+        memcpy(dst, buffer.data() + skip, copied);
+        total += copied;
+        if (res < to_read) {
+            // Reached the end of file.
+            break;
+        }
+    }
+    return total;
+}
+
+} // namespace starrocks::io
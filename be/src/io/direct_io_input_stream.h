@@ -0,0 +1,67 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+
+#include "io/aligned_buffer_pool.h"
+#include "io/seekable_input_stream.h"
+
+namespace starrocks::io {
+
+// An input stream reads the large ranges of a file with O_DIRECT, which bypasses the OS page cache, and the
+// small ones, smaller than `direct_io_min_read_size`, from |buffered|, so the small metadata and index reads
+// still benefit from the OS page cache.
+//
+// The direct reads of the unaligned ranges go through the aligned buffers of |pool|.
+class DirectIoInputStream final : public SeekableInputStream {
+public:
+    // |direct_fd| is opened with O_DIRECT, and closed when the stream is destroyed.
+    DirectIoInputStream(std::shared_ptr<SeekableInputStream> buffered, int direct_fd, AlignedBufferPool* pool);
+
+    ~DirectIoInputStream() override;
+
+    DirectIoInputStream(const DirectIoInputStream&) = delete;
+    DirectIoInputStream(DirectIoInputStream&&) = delete;
+    void operator=(const DirectIoInputStream&) = delete;
+    void operator=(DirectIoInputStream&&) = delete;
+
+    StatusOr<int64_t> read(void* data, int64_t count) override;
+
+    StatusOr<int64_t> read_at(int64_t offset, void* data, int64_t count) override;
+
+    Status read_at_fully(int64_t offset, void* data, int64_t count) override;
+
+    // The small ranges are read by |buffered| together, the others are read one by one with O_DIRECT.
+    Status read_ranges_fully(const std::vector<ReadRange>& ranges) override;
+
+    StatusOr<int64_t> get_size() override { return _buffered->get_size(); }
+
+    StatusOr<int64_t> position() override { return _offset; }
+
+    Status seek(int64_t offset) override;
+
+private:
+    static bool _use_direct_io(int64_t count);
+
+    StatusOr<int64_t> _direct_read_at(int64_t offset, void* data, int64_t count);
+
+    std::shared_ptr<SeekableInputStream> _buffered;
+    int _direct_fd;
+    AlignedBufferPool* _pool;
+    int64_t _offset = 0;
+};
+
+} // namespace starrocks::io
@@ -21,6 +21,7 @@
 #include "common/logging.h"
 #include "gutil/macros.h"
 #include "io/io_error.h"
+#include "io/io_uring.h"
 
 #ifdef USE_STAROS
 #include "fslib/metric_key.h"
@@ -101,5 +102,32 @@ Status FdInputStream::seek(int64_t offset) {
     return Status::OK();
 }
 
+Status FdInputStream::read_ranges_fully(const std::vector<ReadRange>& ranges) {
+    CHECK_IS_CLOSED(_is_closed);
+    IoUring* ring = _use_io_uring ? IoUring::thread_local_instance() : nullptr;
+    if (ring == nullptr) {
+        return SeekableInputStream::read_ranges_fully(ranges);
+    }
+#ifdef USE_STAROS
+    staros::starlet::metrics::TimeObserver<prometheus::Histogram> observer(s_posixread_iolatency);
+#endif
+    std::vector<IoUring::ReadRequest> requests;
+    requests.reserve(ranges.size());
+    for (const auto& r : ranges) {
+        requests.push_back({_fd, r.offset, r.data, r.count});
+    }
+    auto st = ring->read_fully(requests);
+    if (st.is_end_of_file()) {
+        return Status::IOError("cannot read fully");
+    }
+    RETURN_IF_ERROR(st);
+#ifdef USE_STAROS
+    for (const auto& r : ranges) {
+        s_posixread_iosize.Observe(r.count);
+    }
+#endif
+    return Status::OK();
+}
+
 #undef CHECK_IS_CLOSED
 } // namespace starrocks::io
@@ -38,6 +38,12 @@ public:
 
     Status seek(int64_t offset) override;
 
+    // Read the ranges with one io_uring submission if io_uring is enabled, or one pread for each.
+    Status read_ranges_fully(const std::vector<ReadRange>& ranges) override;
+
+    // Use io_uring of the current thread for `read_ranges_fully()`, fallback to pread if it's not available.
+    void set_use_io_uring(bool value) { _use_io_uring = value; }
+
     // closes the underlying file.
     //
     // Returns error if an error occurs during the process;
@@ -63,6 +69,7 @@ private:
     int64_t _offset;
     bool _close_on_delete;
     bool _is_closed;
+    bool _use_io_uring{false};
 };
 
 } // namespace starrocks::io
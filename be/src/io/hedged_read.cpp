@@ -0,0 +1,169 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "io/hedged_read.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "util/monotime.h"
+#include "util/threadpool.h"
+#include "util/time.h"
+
+namespace starrocks::io {
+
+void HedgedReadPolicy::record(int64_t latency_us) {
+    int bucket = 0;
+    while (bucket + 1 < kNumBuckets && (int64_t(1) << (bucket + 1)) <= latency_us) {
+        bucket++;
+    }
+    std::lock_guard l(_mutex);
+    _buckets[bucket]++;
+    if (++_num_reads >= kDecayWindow * 2) {
+        for (auto& b : _buckets) {
+            b /= 2;
+        }
+        _num_reads /= 2;
+        _num_hedged /= 2;
+    }
+}
+
+int64_t HedgedReadPolicy::threshold_us() const {
+    const int64_t min_threshold_us = config::hedged_read_min_threshold_ms * 1000;
+    std::lock_guard l(_mutex);
+    int64_t total = 0;
+    for (auto b : _buckets) {
+        total += b;
+    }
+    if (total < kMinSamples) {
+        return -1;
+    }
+    const double percentile = std::clamp(config::hedged_read_percentile, 0.0, 100.0);
+    auto target = static_cast<int64_t>(total * percentile / 100);
+    int64_t count = 0;
+    for (int i = 0; i < kNumBuckets; i++) {
+        if (_buckets[i] > 0 && count + _buckets[i] >= target) {
+            // Interpolate in the bucket [2^i, 2^(i+1)).
+            int64_t lower = int64_t(1) << i;
+            int64_t threshold = lower + lower * (target - count) / _buckets[i];
+            return std::max(threshold, min_threshold_us);
+        }
+        count += _buckets[i];
+    }
+    return std::max(int64_t(1) << kNumBuckets, min_threshold_us);
+}
+
+bool HedgedReadPolicy::try_acquire_hedge() {
+    std::lock_guard l(_mutex);
+    if ((_num_hedged + 1) * 100 > config::hedged_read_budget_percent * _num_reads) {
+        return false;
+    }
+    _num_hedged++;
+    return true;
+}
+
+static ThreadPool* hedged_read_pool() {
+    static std::unique_ptr<ThreadPool> pool = [] {
+        std::unique_ptr<ThreadPool> p;
+        auto st = ThreadPoolBuilder("hedged_read")
+                          .set_min_threads(0)
+                          .set_max_threads(std::max(1, config::hedged_read_threads))
+                          .set_idle_timeout(MonoDelta::FromMilliseconds(2000))
+                          .build(&p);
+        LOG_IF(WARNING, !st.ok()) << "Fail to create the hedged read pool, hedged read is disabled: " << st;
+        return p;
+    }();
+    return pool.get();
+}
+
+namespace {
+// Shared by the call and the reads, the reads may outlive the call.
+struct HedgedReadState {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<uint8_t> buffers[2];
+    std::optional<StatusOr<int64_t>> results[2];
+    int num_sent = 0;
+    int num_finished = 0;
+    // The attempt to return, the first successful one, or the last one if all failed.
+    int winner = -1;
+};
+} // namespace
+
+static Status send_read(ThreadPool* pool, HedgedReadPolicy* policy, const std::shared_ptr<HedgedReadState>& state,
+                        int attempt, const std::function<StatusOr<int64_t>(void* buf)>& read) {
+    return pool->submit_func([=]() {
+        int64_t start = MonotonicMicros();
+        auto res = read(state->buffers[attempt].data());
+        if (attempt == 0) {
+            policy->record(MonotonicMicros() - start);
+        }
+        {
+            std::lock_guard l(state->mutex);
+            state->results[attempt] = std::move(res);
+            state->num_finished++;
+            if (state->winner < 0 && (state->results[attempt]->ok() || state->num_finished == state->num_sent)) {
+                state->winner = attempt;
+            }
+        }
+        state->cv.notify_all();
+    });
+}
+
+StatusOr<int64_t> hedged_read(HedgedReadPolicy* policy, void* out, int64_t count,
+                              std::function<StatusOr<int64_t>(void* buf)> read) {
+    ThreadPool* pool = nullptr;
+    if (config::enable_hedged_read && count <= config::hedged_read_max_size) {
+        pool = hedged_read_pool();
+    }
+    if (pool == nullptr) {
+        return read(out);
+    }
+
+    auto state = std::make_shared<HedgedReadState>();
+    state->buffers[0].resize(count);
+    state->num_sent = 1;
+    if (!send_read(pool, policy, state, 0, read).ok()) {
+        return read(out);
+    }
+
+    std::unique_lock l(state->mutex);
+    int64_t threshold_us = policy->threshold_us();
+    if (threshold_us >= 0 &&
+        !state->cv.wait_for(l, std::chrono::microseconds(threshold_us), [&] { return state->winner >= 0; }) &&
+        policy->try_acquire_hedge()) {
+        state->buffers[1].resize(count);
+        state->num_sent = 2;
+        if (!send_read(pool, policy, state, 1, read).ok()) {
+            state->num_sent = 1;
+        } else {
+            VLOG(2) << "Send hedged read of " << policy->name() << " after " << threshold_us << "us";
+        }
+    }
+    state->cv.wait(l, [&] { return state->winner >= 0; });
+    auto& res = *state->results[state->winner];
+    if (!res.ok()) {
+        return res.status();
+    }
+    memcpy(out, state->buffers[state->winner].data(), *res);
+    return *res;
+}
+
+} // namespace starrocks::io
@@ -0,0 +1,73 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+
+#include "common/statusor.h"
+#include "gutil/macros.h"
+
+namespace starrocks::io {
+
+// HedgedReadPolicy tracks the latencies of the reads of a remote file system, to decide when a read is slow
+// enough to send a duplicate, and limits the duplicates to a percentage of the reads.
+//
+// The latencies are kept in log2 buckets of microseconds, and decayed by half every kDecayWindow reads,
+// so the threshold follows the recent latencies.
+class HedgedReadPolicy {
+public:
+    explicit HedgedReadPolicy(std::string name) : _name(std::move(name)) {}
+
+    DISALLOW_COPY_AND_MOVE(HedgedReadPolicy);
+
+    void record(int64_t latency_us);
+
+    // The `hedged_read_percentile` of the recent latencies, at least `hedged_read_min_threshold_ms`.
+    // Return -1 if there are not enough reads to estimate the threshold yet.
+    int64_t threshold_us() const;
+
+    // Return true if the duplicates sent are still within `hedged_read_budget_percent` of the reads,
+    // and count the duplicate.
+    bool try_acquire_hedge();
+
+    const std::string& name() const { return _name; }
+
+private:
+    static constexpr int kNumBuckets = 40;
+    static constexpr int64_t kMinSamples = 100;
+    static constexpr int64_t kDecayWindow = 10000;
+
+    const std::string _name;
+    mutable std::mutex _mutex;
+    int64_t _buckets[kNumBuckets]{};
+    int64_t _num_reads = 0;
+    int64_t _num_hedged = 0;
+};
+
+// Read with |read| into a buffer of |count| bytes, and copy the result to |out|. If the read does not finish
+// within the threshold of |policy|, a duplicate of |read| is sent, and the first successful one wins.
+//
+// The reads run in a background pool and may outlive this call, so |read| must own everything it uses,
+// e.g, hold the shared pointer of the client instead of the pointer of the stream.
+// |policy| must outlive the reads, usually it is a static one per file system.
+//
+// Without `enable_hedged_read`, |read| is called with |out| directly in the current thread.
+StatusOr<int64_t> hedged_read(HedgedReadPolicy* policy, void* out, int64_t count,
+                              std::function<StatusOr<int64_t>(void* buf)> read);
+
+} // namespace starrocks::io
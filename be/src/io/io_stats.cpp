@@ -0,0 +1,184 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "io/io_stats.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+
+#include "util/pretty_printer.h"
+#include "util/runtime_profile.h"
+#include "util/starrocks_metrics.h"
+
+namespace starrocks::io {
+
+const char* io_purpose_name(IOPurpose purpose) {
+    switch (purpose) {
+    case IOPurpose::OTHER:
+        return "other";
+    case IOPurpose::SCAN:
+        return "scan";
+    case IOPurpose::COMPACTION:
+        return "compaction";
+    case IOPurpose::LOAD:
+        return "load";
+    case IOPurpose::SPILL:
+        return "spill";
+    case IOPurpose::CACHE_FILL:
+        return "cache_fill";
+    }
+    return "unknown";
+}
+
+static const char* io_op_name(IOOp op) {
+    return op == IOOp::READ ? "read" : "write";
+}
+
+void IOStats::add(IOPurpose purpose, IOOp op, int64_t bytes, int64_t latency_ns) {
+    auto& counters = _counters[static_cast<size_t>(purpose) * kNumIOOps + static_cast<size_t>(op)];
+    counters.bytes.fetch_add(bytes, std::memory_order_relaxed);
+    counters.ops.fetch_add(1, std::memory_order_relaxed);
+    counters.time_ns.fetch_add(latency_ns, std::memory_order_relaxed);
+    _latencies[static_cast<size_t>(op)].add(latency_ns);
+}
+
+void IOStats::to_profile(RuntimeProfile* profile) const {
+    std::string purposes_desc;
+    for (size_t op_index = 0; op_index < kNumIOOps; op_index++) {
+        const auto op = static_cast<IOOp>(op_index);
+        int64_t total_bytes = 0;
+        int64_t total_ops = 0;
+        int64_t total_time_ns = 0;
+        for (size_t purpose_index = 0; purpose_index < kNumIOPurposes; purpose_index++) {
+            const auto purpose = static_cast<IOPurpose>(purpose_index);
+            if (ops(purpose, op) == 0) {
+                continue;
+            }
+            total_bytes += bytes(purpose, op);
+            total_ops += ops(purpose, op);
+            total_time_ns += time_ns(purpose, op);
+            if (!purposes_desc.empty()) {
+                purposes_desc.append(", ");
+            }
+            purposes_desc.append(fmt::format("{} {}: {}/{} ops/{}", io_purpose_name(purpose), io_op_name(op),
+                                             PrettyPrinter::print(bytes(purpose, op), TUnit::BYTES),
+                                             ops(purpose, op),
+                                             PrettyPrinter::print(time_ns(purpose, op), TUnit::TIME_NS)));
+        }
+        if (total_ops == 0) {
+            continue;
+        }
+        const std::string prefix = op == IOOp::READ ? "IORead" : "IOWrite";
+        COUNTER_SET(ADD_COUNTER(profile, prefix + "Bytes", TUnit::BYTES), total_bytes);
+        COUNTER_SET(ADD_COUNTER(profile, prefix + "Count", TUnit::UNIT), total_ops);
+        COUNTER_SET(ADD_COUNTER(profile, prefix + "Time", TUnit::TIME_NS), total_time_ns);
+        profile->add_info_string(prefix + "Latency", latency(op).to_string());
+    }
+    if (!purposes_desc.empty()) {
+        profile->add_info_string("IOByPurpose", purposes_desc);
+    }
+}
+
+IOTarget::IOTarget(std::string name) : _name(std::move(name)) {
+    auto* metrics = StarRocksMetrics::instance()->metrics();
+    for (size_t op_index = 0; op_index < kNumIOOps; op_index++) {
+        const char* op_name = io_op_name(static_cast<IOOp>(op_index));
+        for (size_t purpose_index = 0; purpose_index < kNumIOPurposes; purpose_index++) {
+            auto& counters = _counters[purpose_index * kNumIOOps + op_index];
+            const auto labels = MetricLabels()
+                                        .add("target", _name)
+                                        .add("purpose", io_purpose_name(static_cast<IOPurpose>(purpose_index)))
+                                        .add("op", op_name);
+            metrics->register_metric("io_bytes_total", labels, &counters.bytes);
+            metrics->register_metric("io_ops_total", labels, &counters.ops);
+            metrics->register_metric("io_time_ns_total", labels, &counters.time_ns);
+        }
+        for (size_t i = 0; i < LatencyHistogram::NUM_BUCKETS; i++) {
+            metrics->register_metric(
+                    "io_latency_bucket",
+                    MetricLabels().add("target", _name).add("op", op_name).add("le", LatencyHistogram::bucket_name(i)),
+                    &_latency_buckets[op_index][i].count);
+        }
+    }
+}
+
+void IOTarget::record(IOOp op, int64_t bytes, int64_t latency_ns) {
+    const IOPurpose purpose = tls_io_purpose;
+    auto& counters = _counters[static_cast<size_t>(purpose) * kNumIOOps + static_cast<size_t>(op)];
+    counters.bytes.increment(bytes);
+    counters.ops.increment(1);
+    counters.time_ns.increment(latency_ns);
+    _latency_buckets[static_cast<size_t>(op)][LatencyHistogram::bucket_of(latency_ns)].count.increment(1);
+    if (tls_io_stats != nullptr) {
+        tls_io_stats->add(purpose, op, bytes, latency_ns);
+    }
+}
+
+IOTargetRegistry* IOTargetRegistry::instance() {
+    // never destroyed, the files may be closed after the static objects are destroyed
+    static auto* registry = new IOTargetRegistry();
+    return registry;
+}
+
+IOTarget* IOTargetRegistry::get(const std::string& name) {
+    std::lock_guard l(_mutex);
+    auto& target = _targets[name];
+    if (target == nullptr) {
+        target = std::make_unique<IOTarget>(name);
+    }
+    return target.get();
+}
+
+void IOTargetRegistry::register_local_path(const std::string& path) {
+    std::string normalized = path;
+    while (normalized.size() > 1 && normalized.back() == '/') {
+        normalized.pop_back();
+    }
+    IOTarget* target = get(normalized);
+    std::lock_guard l(_mutex);
+    for (const auto& [local_path, _] : _local_paths) {
+        if (local_path == normalized) {
+            return;
+        }
+    }
+    _local_paths.emplace_back(std::move(normalized), target);
+    std::stable_sort(_local_paths.begin(), _local_paths.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.first.size() > rhs.first.size(); });
+}
+
+IOTarget* IOTargetRegistry::local_target(std::string_view path) {
+    {
+        std::lock_guard l(_mutex);
+        for (const auto& [local_path, target] : _local_paths) {
+            if (path.size() >= local_path.size() && path.compare(0, local_path.size(), local_path) == 0 &&
+                (path.size() == local_path.size() || path[local_path.size()] == '/' || local_path == "/")) {
+                return target;
+            }
+        }
+    }
+    return get("local");
+}
+
+IOTarget* IOTargetRegistry::remote_target(std::string_view uri) {
+    const size_t scheme_end = uri.find("://");
+    if (scheme_end == std::string_view::npos) {
+        return local_target(uri);
+    }
+    const size_t authority_end = uri.find('/', scheme_end + 3);
+    return get(std::string(uri.substr(0, authority_end)));
+}
+
+} // namespace starrocks::io
@@ -0,0 +1,162 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "gutil/macros.h"
+#include "util/latency_histogram.h"
+#include "util/metrics.h"
+
+namespace starrocks {
+class RuntimeProfile;
+} // namespace starrocks
+
+namespace starrocks::io {
+
+// Why an io is issued, taken from the thread issuing it.
+enum class IOPurpose : uint8_t { OTHER = 0, SCAN, COMPACTION, LOAD, SPILL, CACHE_FILL };
+static constexpr size_t kNumIOPurposes = 6;
+
+const char* io_purpose_name(IOPurpose purpose);
+
+enum class IOOp : uint8_t { READ = 0, WRITE };
+static constexpr size_t kNumIOOps = 2;
+
+// The io purpose and the IOStats of the fragment instance on the current thread.
+inline thread_local IOPurpose tls_io_purpose = IOPurpose::OTHER;
+class IOStats;
+inline thread_local IOStats* tls_io_stats = nullptr;
+
+// IOStats counts the ios of a fragment instance by the purposes, it's lock-free.
+class IOStats {
+public:
+    IOStats() = default;
+    DISALLOW_COPY_AND_MOVE(IOStats);
+
+    void add(IOPurpose purpose, IOOp op, int64_t bytes, int64_t latency_ns);
+
+    int64_t bytes(IOPurpose purpose, IOOp op) const { return _get(purpose, op).bytes.load(std::memory_order_relaxed); }
+    int64_t ops(IOPurpose purpose, IOOp op) const { return _get(purpose, op).ops.load(std::memory_order_relaxed); }
+    int64_t time_ns(IOPurpose purpose, IOOp op) const {
+        return _get(purpose, op).time_ns.load(std::memory_order_relaxed);
+    }
+    const LatencyHistogram& latency(IOOp op) const { return _latencies[static_cast<size_t>(op)]; }
+
+    // Add the counters of the ios and the summaries by the purposes to |profile|, nothing if there is no io.
+    void to_profile(RuntimeProfile* profile) const;
+
+private:
+    struct Counters {
+        std::atomic<int64_t> bytes{0};
+        std::atomic<int64_t> ops{0};
+        std::atomic<int64_t> time_ns{0};
+    };
+
+    const Counters& _get(IOPurpose purpose, IOOp op) const {
+        return _counters[static_cast<size_t>(purpose) * kNumIOOps + static_cast<size_t>(op)];
+    }
+
+    std::array<Counters, kNumIOPurposes * kNumIOOps> _counters;
+    std::array<LatencyHistogram, kNumIOOps> _latencies;
+};
+
+// IOTarget is a device or a remote endpoint, e.g. a storage root path, an S3 bucket or an HDFS namenode. Its ios
+// are exported as the metrics labelled by the target:
+//   io_bytes_total{target, purpose, op}, io_ops_total{target, purpose, op}, io_time_ns_total{target, purpose, op}
+//   and io_latency_bucket{target, op, le}
+class IOTarget {
+public:
+    explicit IOTarget(std::string name);
+    DISALLOW_COPY_AND_MOVE(IOTarget);
+
+    const std::string& name() const { return _name; }
+
+    // Record an io of the purpose of the current thread, also into the IOStats of the current thread if any.
+    void record(IOOp op, int64_t bytes, int64_t latency_ns);
+
+private:
+    struct Counters {
+        IntCounter bytes{MetricUnit::BYTES};
+        IntCounter ops{MetricUnit::OPERATIONS};
+        IntCounter time_ns{MetricUnit::NANOSECONDS};
+    };
+    struct LatencyBucket {
+        IntCounter count{MetricUnit::OPERATIONS};
+    };
+
+    const std::string _name;
+    std::array<Counters, kNumIOPurposes * kNumIOOps> _counters;
+    std::array<std::array<LatencyBucket, LatencyHistogram::NUM_BUCKETS>, kNumIOOps> _latency_buckets;
+};
+
+// The IOTargets are never removed, so the files can keep the pointers of their targets.
+class IOTargetRegistry {
+public:
+    static IOTargetRegistry* instance();
+
+    IOTarget* get(const std::string& name);
+
+    // The local files under |path| are of the target |path|, e.g. a storage root path.
+    void register_local_path(const std::string& path);
+
+    // The target of a local file, the longest registered path containing it, or "local".
+    IOTarget* local_target(std::string_view path);
+
+    // The target of a remote file, "<scheme>://<authority>" of |uri|, e.g. the bucket of an S3 object.
+    IOTarget* remote_target(std::string_view uri);
+
+private:
+    IOTargetRegistry() = default;
+
+    std::mutex _mutex;
+    std::unordered_map<std::string, std::unique_ptr<IOTarget>> _targets;
+    // the registered local paths, longest first
+    std::vector<std::pair<std::string, IOTarget*>> _local_paths;
+};
+
+class ScopedIOPurpose {
+public:
+    explicit ScopedIOPurpose(IOPurpose purpose) : _prev(tls_io_purpose) { tls_io_purpose = purpose; }
+    ~ScopedIOPurpose() { tls_io_purpose = _prev; }
+    DISALLOW_COPY_AND_MOVE(ScopedIOPurpose);
+
+private:
+    IOPurpose _prev;
+};
+
+class ScopedIOStats {
+public:
+    explicit ScopedIOStats(IOStats* stats) : _prev(tls_io_stats) { tls_io_stats = stats; }
+    ~ScopedIOStats() { tls_io_stats = _prev; }
+    DISALLOW_COPY_AND_MOVE(ScopedIOStats);
+
+private:
+    IOStats* _prev;
+};
+
+} // namespace starrocks::io
+
+#define SCOPED_IO_PURPOSE(purpose) auto VARNAME_LINENUM(io_purpose) = starrocks::io::ScopedIOPurpose(purpose)
+#define SCOPED_IO_STATS(stats) auto VARNAME_LINENUM(io_stats) = starrocks::io::ScopedIOStats(stats)
@@ -0,0 +1,302 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "io/io_uring.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "io/io_error.h"
+
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define STARROCKS_HAVE_IO_URING 1
+#endif
+
+namespace starrocks::io {
+
+#ifdef STARROCKS_HAVE_IO_URING
+
+template <typename T>
+static inline T load_acquire(const T* p) {
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+template <typename T>
+static inline void store_release(T* p, T v) {
+    __atomic_store_n(p, v, __ATOMIC_RELEASE);
+}
+
+bool IoUring::is_supported() {
+    static const bool supported = IoUring::create(4).ok();
+    return supported;
+}
+
+StatusOr<std::unique_ptr<IoUring>> IoUring::create(uint32_t entries) {
+    std::unique_ptr<IoUring> ring(new IoUring());
+    RETURN_IF_ERROR(ring->_init(entries));
+    return ring;
+}
+
+IoUring* IoUring::thread_local_instance() {
+    thread_local std::unique_ptr<IoUring> ring;
+    thread_local bool initialized = false;
+    if (!initialized) {
+        initialized = true;
+        auto res = create(std::max(1, config::io_uring_queue_depth));
+        if (res.ok()) {
+            ring = std::move(res).value();
+        } else {
+            LOG(WARNING) << "Fail to create io_uring, fallback to pread: " << res.status();
+        }
+    }
+    return ring.get();
+}
+
+Status IoUring::_init(uint32_t entries) {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    int fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    if (fd < 0) {
+        return io_error("io_uring_setup", errno);
+    }
+    _ring_fd = fd;
+    _sq_entries = params.sq_entries;
+
+    _sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    _cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        _sq_ring_size = _cq_ring_size = std::max(_sq_ring_size, _cq_ring_size);
+    }
+    _sq_ring = mmap(nullptr, _sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (_sq_ring == MAP_FAILED) {
+        _sq_ring = nullptr;
+        return io_error("mmap io_uring sq", errno);
+    }
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        _cq_ring = _sq_ring;
+    } else {
+        _cq_ring =
+                mmap(nullptr, _cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (_cq_ring == MAP_FAILED) {
+            _cq_ring = nullptr;
+            return io_error("mmap io_uring cq", errno);
+        }
+    }
+    _sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    _sqes = mmap(nullptr, _sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (_sqes == MAP_FAILED) {
+        _sqes = nullptr;
+        return io_error("mmap io_uring sqes", errno);
+    }
+
+    auto* sq = static_cast<uint8_t*>(_sq_ring);
+    _sq_head = reinterpret_cast<uint32_t*>(sq + params.sq_off.head);
+    _sq_tail = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+    _sq_mask = *reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+    _sq_array = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+    auto* cq = static_cast<uint8_t*>(_cq_ring);
+    _cq_head = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+    _cq_tail = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+    _cq_mask = *reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+    _cqes = cq + params.cq_off.cqes;
+    return Status::OK();
+}
+
+IoUring::~IoUring() {
+    if (_sqes != nullptr) {
+        munmap(_sqes, _sqes_size);
+    }
+    if (_cq_ring != nullptr && _cq_ring != _sq_ring) {
+        munmap(_cq_ring, _cq_ring_size);
+    }
+    if (_sq_ring != nullptr) {
+        munmap(_sq_ring, _sq_ring_size);
+    }
+    if (_ring_fd >= 0) {
+        ::close(_ring_fd);
+    }
+}
+
+Status IoUring::register_buffers(const std::vector<iovec>& buffers) {
+    RETURN_IF_ERROR(unregister_buffers());
+    if (buffers.empty()) {
+        return Status::OK();
+    }
+    if (syscall(__NR_io_uring_register, _ring_fd, IORING_REGISTER_BUFFERS, buffers.data(), buffers.size()) < 0) {
+        return io_error("io_uring_register", errno);
+    }
+    _registered_buffers = buffers;
+    return Status::OK();
+}
+
+Status IoUring::unregister_buffers() {
+    if (_registered_buffers.empty()) {
+        return Status::OK();
+    }
+    if (syscall(__NR_io_uring_register, _ring_fd, IORING_UNREGISTER_BUFFERS, nullptr, 0) < 0) {
+        return io_error("io_uring_register", errno);
+    }
+    _registered_buffers.clear();
+    return Status::OK();
+}
+
+void IoUring::_prep_read(const iovec& iov, int fd, int64_t offset, uint64_t user_data) {
+    uint32_t tail = *_sq_tail;
+    uint32_t index = tail & _sq_mask;
+    auto* sqe = static_cast<io_uring_sqe*>(_sqes) + index;
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->fd = fd;
+    sqe->off = offset;
+    sqe->user_data = user_data;
+    auto begin = reinterpret_cast<uintptr_t>(iov.iov_base);
+    auto it = std::find_if(_registered_buffers.begin(), _registered_buffers.end(), [&](const iovec& buf) {
+        auto buf_begin = reinterpret_cast<uintptr_t>(buf.iov_base);
+        return begin >= buf_begin && begin + iov.iov_len <= buf_begin + buf.iov_len;
+    });
+    if (it != _registered_buffers.end()) {
+        sqe->opcode = IORING_OP_READ_FIXED;
+        sqe->addr = begin;
+        sqe->len = iov.iov_len;
+        sqe->buf_index = it - _registered_buffers.begin();
+    } else {
+        // IORING_OP_READV is supported by all the kernels with io_uring, the iovec must be alive until completed.
+        sqe->opcode = IORING_OP_READV;
+        sqe->addr = reinterpret_cast<uintptr_t>(&iov);
+        sqe->len = 1;
+    }
+    _sq_array[index] = index;
+    store_release(_sq_tail, tail + 1);
+}
+
+Status IoUring::_submit_and_wait(uint32_t min_complete) {
+    while (true) {
+        // The kernel may consume only part of the queue, submit the rest in the next call.
+        uint32_t to_submit = *_sq_tail - load_acquire(_sq_head);
+        long ret = syscall(__NR_io_uring_enter, _ring_fd, to_submit, min_complete, IORING_ENTER_GETEVENTS, nullptr, 0);
+        if (ret >= 0) {
+            return Status::OK();
+        }
+        if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+            return io_error("io_uring_enter", errno);
+        }
+    }
+}
+
+Status IoUring::read_fully(const std::vector<ReadRequest>& requests) {
+    // The remaining range of each request, which is also the iovec submitted for it.
+    std::vector<iovec> iovs(requests.size());
+    std::vector<int64_t> offsets(requests.size());
+    for (size_t i = 0; i < requests.size(); i++) {
+        iovs[i].iov_base = requests[i].data;
+        iovs[i].iov_len = requests[i].count;
+        offsets[i] = requests[i].offset;
+    }
+    std::vector<size_t> resubmit;
+    size_t next = 0;
+    uint32_t inflight = 0;
+    Status status;
+    while (inflight > 0 || (status.ok() && (next < requests.size() || !resubmit.empty()))) {
+        // Stop submitting after an error, but wait for the reads in flight, which still write to the buffers.
+        while (status.ok() && inflight < _sq_entries && (next < requests.size() || !resubmit.empty())) {
+            size_t i;
+            if (!resubmit.empty()) {
+                i = resubmit.back();
+                resubmit.pop_back();
+            } else {
+                i = next++;
+            }
+            if (iovs[i].iov_len == 0) {
+                continue;
+            }
+            _prep_read(iovs[i], requests[i].fd, offsets[i], i);
+            inflight++;
+        }
+        if (inflight == 0) {
+            break;
+        }
+        auto st = _submit_and_wait(1);
+        if (!st.ok()) {
+            // The reads can not be waited, crash rather than let the kernel write to the freed buffers.
+            LOG(FATAL) << "Fail to wait for io_uring completions: " << st;
+        }
+        uint32_t head = *_cq_head;
+        uint32_t tail = load_acquire(_cq_tail);
+        for (; head != tail; head++) {
+            const auto* cqe = static_cast<const io_uring_cqe*>(_cqes) + (head & _cq_mask);
+            size_t i = cqe->user_data;
+            int res = cqe->res;
+            inflight--;
+            if (res == -EINTR || res == -EAGAIN) {
+                resubmit.push_back(i);
+            } else if (res < 0) {
+                if (status.ok()) {
+                    status = io_error("io_uring read", -res);
+                }
+            } else if (res == 0) {
+                if (status.ok()) {
+                    status = Status::EndOfFile("Reached the end of file");
+                }
+            } else {
+                iovs[i].iov_base = static_cast<uint8_t*>(iovs[i].iov_base) + res;
+                iovs[i].iov_len -= res;
+                offsets[i] += res;
+                if (iovs[i].iov_len > 0) {
+                    resubmit.push_back(i);
+                }
+            }
+        }
+        store_release(_cq_head, head);
+    }
+    return status;
+}
+
+#else
+
+bool IoUring::is_supported() {
+    return false;
+}
+
+StatusOr<std::unique_ptr<IoUring>> IoUring::create(uint32_t entries) {
+    return Status::NotSupported("io_uring is not supported");
+}
+
+IoUring* IoUring::thread_local_instance() {
+    return nullptr;
+}
+
+IoUring::~IoUring() = default;
+
+Status IoUring::register_buffers(const std::vector<iovec>& buffers) {
+    return Status::NotSupported("io_uring is not supported");
+}
+
+Status IoUring::unregister_buffers() {
+    return Status::OK();
+}
+
+Status IoUring::read_fully(const std::vector<ReadRequest>& requests) {
+    return Status::NotSupported("io_uring is not supported");
+}
+
+#endif
+
+} // namespace starrocks::io
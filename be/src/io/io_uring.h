@@ -0,0 +1,96 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <sys/uio.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common/statusor.h"
+#include "gutil/macros.h"
+
+namespace starrocks::io {
+
+// A minimal io_uring ring used to read files in batches, many reads are submitted and completed with
+// one system call instead of one pread for each. It is built on the raw system calls, liburing is not needed.
+//
+// A ring is not thread safe, use `thread_local_instance()` to get the ring of the current thread.
+class IoUring {
+public:
+    struct ReadRequest {
+        int fd;
+        int64_t offset;
+        void* data;
+        int64_t count;
+    };
+
+    // Return true if io_uring is available in the running kernel.
+    static bool is_supported();
+
+    // Create a ring of at most |entries| reads in flight.
+    static StatusOr<std::unique_ptr<IoUring>> create(uint32_t entries);
+
+    // The ring of the current thread, created on first use with `io_uring_queue_depth` entries.
+    // Return nullptr if the ring can not be created.
+    static IoUring* thread_local_instance();
+
+    ~IoUring();
+
+    DISALLOW_COPY_AND_MOVE(IoUring);
+
+    // Register |buffers| to the ring, the reads into them are issued as fixed buffer reads, which saves
+    // mapping the pages of the buffer for each read. The buffers must be alive until unregistered.
+    Status register_buffers(const std::vector<iovec>& buffers);
+
+    Status unregister_buffers();
+
+    // Read all the |requests| fully, a short read is continued until the whole range is read.
+    // Return EndOfFile if the end of file is reached before any range is read fully.
+    Status read_fully(const std::vector<ReadRequest>& requests);
+
+    uint32_t entries() const { return _sq_entries; }
+
+private:
+    IoUring() = default;
+
+    Status _init(uint32_t entries);
+    void _prep_read(const iovec& iov, int fd, int64_t offset, uint64_t user_data);
+    Status _submit_and_wait(uint32_t min_complete);
+
+    int _ring_fd = -1;
+    uint32_t _sq_entries = 0;
+
+    void* _sq_ring = nullptr;
+    size_t _sq_ring_size = 0;
+    void* _cq_ring = nullptr;
+    size_t _cq_ring_size = 0;
+    void* _sqes = nullptr;
+    size_t _sqes_size = 0;
+
+    uint32_t* _sq_head = nullptr;
+    uint32_t* _sq_tail = nullptr;
+    uint32_t _sq_mask = 0;
+    uint32_t* _sq_array = nullptr;
+    uint32_t* _cq_head = nullptr;
+    uint32_t* _cq_tail = nullptr;
+    uint32_t _cq_mask = 0;
+    void* _cqes = nullptr;
+
+    std::vector<iovec> _registered_buffers;
+};
+
+} // namespace starrocks::io
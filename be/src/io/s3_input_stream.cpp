@@ -20,6 +20,12 @@
 #include <aws/s3/model/HeadObjectRequest.h>
 #include <fmt/format.h>
 
+#include "common/config.h"
+#include "common/logging.h"
+#include "io/hedged_read.h"
+#include "util/countdown_latch.h"
+#include "util/threadpool.h"
+
 #ifdef USE_STAROS
 #include "fslib/metric_key.h"
 #include "metrics/metrics.h"
@@ -32,29 +38,107 @@ inline Status make_error_status(const Aws::S3::S3Error& error) {
                                        error.GetErrorType(), error.GetMessage()));
 }
 
+// The pool fetching the parts of the large reads, nullptr if it can not be created.
+static ThreadPool* parallel_read_pool() {
+    static std::unique_ptr<ThreadPool> pool = [] {
+        std::unique_ptr<ThreadPool> p;
+        auto st = ThreadPoolBuilder("s3_read")
+                          .set_min_threads(0)
+                          .set_max_threads(std::max(1, config::s3_read_parallel_threads))
+                          .set_idle_timeout(MonoDelta::FromMilliseconds(2000))
+                          .build(&p);
+        LOG_IF(WARNING, !st.ok()) << "Fail to create the s3 read pool, fetch the parts serially: " << st;
+        return p;
+    }();
+    return pool.get();
+}
+
 StatusOr<int64_t> S3InputStream::read(void* out, int64_t count) {
     if (UNLIKELY(_size == -1)) {
         ASSIGN_OR_RETURN(_size, S3InputStream::get_size());
     }
-    if (_offset >= _size) {
+    ASSIGN_OR_RETURN(auto nread, _read_at(_offset, out, count));
+    _offset += nread;
+    return nread;
+}
+
+StatusOr<int64_t> S3InputStream::_read_at(int64_t offset, void* out, int64_t count) {
+    if (offset >= _size) {
         return 0;
     }
 
-    auto range = fmt::format("bytes={}-{}", _offset, std::min<int64_t>(_offset + count, _size));
-    Aws::S3::Model::GetObjectRequest request;
-    request.SetBucket(_bucket);
-    request.SetKey(_object);
-    request.SetRange(std::move(range));
-
-    Aws::S3::Model::GetObjectOutcome outcome = _s3client->GetObject(request);
-    if (outcome.IsSuccess()) {
-        Aws::IOStream& body = outcome.GetResult().GetBody();
-        body.read(static_cast<char*>(out), count);
-        _offset += body.gcount();
-        return body.gcount();
-    } else {
-        return make_error_status(outcome.GetError());
+    auto range = fmt::format("bytes={}-{}", offset, std::min<int64_t>(offset + count, _size));
+    // Capture by value, the read may outlive the stream when it loses a hedged read.
+    auto read = [client = _s3client, bucket = _bucket, object = _object, range = std::move(range),
+                 count](void* buf) -> StatusOr<int64_t> {
+        Aws::S3::Model::GetObjectRequest request;
+        request.SetBucket(bucket);
+        request.SetKey(object);
+        request.SetRange(range);
+
+        Aws::S3::Model::GetObjectOutcome outcome = client->GetObject(request);
+        if (outcome.IsSuccess()) {
+            Aws::IOStream& body = outcome.GetResult().GetBody();
+            body.read(static_cast<char*>(buf), count);
+            return body.gcount();
+        } else {
+            return make_error_status(outcome.GetError());
+        }
+    };
+    static HedgedReadPolicy s_hedged_read_policy("s3");
+    return hedged_read(&s_hedged_read_policy, out, count, std::move(read));
+}
+
+Status S3InputStream::_read_range_fully(const ReadRange& range) {
+    int64_t nread = 0;
+    while (nread < range.count) {
+        ASSIGN_OR_RETURN(auto n, _read_at(range.offset + nread, static_cast<char*>(range.data) + nread,
+                                          range.count - nread));
+        if (n == 0) {
+            return Status::IOError("cannot read fully");
+        }
+        nread += n;
+    }
+    return Status::OK();
+}
+
+Status S3InputStream::read_at_fully(int64_t offset, void* out, int64_t count) {
+    const int64_t part_size = config::s3_read_part_size;
+    if (part_size <= 0 || count < 2 * part_size) {
+        return SeekableInputStream::read_at_fully(offset, out, count);
+    }
+    std::vector<ReadRange> parts;
+    for (int64_t pos = 0; pos < count; pos += part_size) {
+        parts.push_back({offset + pos, static_cast<char*>(out) + pos, std::min(part_size, count - pos)});
+    }
+    return read_ranges_fully(parts);
+}
+
+Status S3InputStream::read_ranges_fully(const std::vector<ReadRange>& ranges) {
+    ThreadPool* pool = ranges.size() > 1 ? parallel_read_pool() : nullptr;
+    if (pool == nullptr) {
+        return SeekableInputStream::read_ranges_fully(ranges);
     }
+    if (UNLIKELY(_size == -1)) {
+        ASSIGN_OR_RETURN(_size, S3InputStream::get_size());
+    }
+    std::vector<Status> results(ranges.size());
+    CountDownLatch latch(ranges.size());
+    for (size_t i = 0; i < ranges.size(); i++) {
+        auto task = [&, i]() {
+            results[i] = _read_range_fully(ranges[i]);
+            latch.count_down();
+        };
+        if (!pool->submit_func(task).ok()) {
+            task();
+        }
+    }
+    latch.wait();
+    for (const auto& st : results) {
+        RETURN_IF_ERROR(st);
+    }
+    _offset = ranges.back().offset + ranges.back().count;
+    return Status::OK();
 }
 
 Status S3InputStream::seek(int64_t offset) {
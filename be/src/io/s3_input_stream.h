@@ -42,6 +42,12 @@ public:
 
     StatusOr<int64_t> read(void* data, int64_t count) override;
 
+    // The large read is split into the parts of `s3_read_part_size`, which are fetched in parallel.
+    Status read_at_fully(int64_t offset, void* data, int64_t count) override;
+
+    // The ranges are fetched in parallel.
+    Status read_ranges_fully(const std::vector<ReadRange>& ranges) override;
+
     Status seek(int64_t offset) override;
 
     StatusOr<int64_t> position() override;
@@ -51,6 +57,11 @@ public:
     void set_size(int64_t size) override;
 
 private:
+    // Read [offset, offset + count) without changing the position, which is safe to be called concurrently
+    // once the size is known.
+    StatusOr<int64_t> _read_at(int64_t offset, void* data, int64_t count);
+    Status _read_range_fully(const ReadRange& range);
+
     std::shared_ptr<Aws::S3::S3Client> _s3client;
     std::string _bucket;
     std::string _object;
@@ -21,7 +21,11 @@
 #include <aws/s3/model/UploadPartRequest.h>
 #include <fmt/format.h>
 
+#include <algorithm>
+
+#include "common/config.h"
 #include "common/logging.h"
+#include "util/threadpool.h"
 
 namespace starrocks::io {
 
@@ -38,6 +42,26 @@ S3OutputStream::S3OutputStream(std::shared_ptr<Aws::S3::S3Client> client, std::s
     CHECK(_client != nullptr);
 }
 
+S3OutputStream::~S3OutputStream() {
+    // The parts uploading in background reference this stream.
+    (void)wait_uploading_parts();
+}
+
+// The pool uploading the parts, nullptr if it can not be created.
+static ThreadPool* upload_pool() {
+    static std::unique_ptr<ThreadPool> pool = [] {
+        std::unique_ptr<ThreadPool> p;
+        auto st = ThreadPoolBuilder("s3_upload")
+                          .set_min_threads(0)
+                          .set_max_threads(std::max(1, config::s3_upload_parallel_threads))
+                          .set_idle_timeout(MonoDelta::FromMilliseconds(2000))
+                          .build(&p);
+        LOG_IF(WARNING, !st.ok()) << "Fail to create the s3 upload pool, upload the parts serially: " << st;
+        return p;
+    }();
+    return pool.get();
+}
+
 Status S3OutputStream::write(const void* data, int64_t size) {
     _buffer.append(static_cast<const char*>(data), size);
     if (_upload_id.empty() && _buffer.size() > _max_single_part_size) {
@@ -80,6 +104,7 @@ Status S3OutputStream::close() {
         RETURN_IF_ERROR(singlepart_upload());
     } else {
         RETURN_IF_ERROR(multipart_upload());
+        RETURN_IF_ERROR(wait_uploading_parts());
         RETURN_IF_ERROR(complete_multipart_upload());
     }
     _client = nullptr;
@@ -122,22 +147,79 @@ Status S3OutputStream::multipart_upload() {
     if (_buffer.empty()) {
         return Status::OK();
     }
-    Aws::S3::Model::UploadPartRequest req;
-    req.SetBucket(_bucket);
-    req.SetKey(_object);
-    req.SetPartNumber(static_cast<int>(_etags.size() + 1));
-    req.SetUploadId(_upload_id);
-    req.SetContentLength(static_cast<int64_t>(_buffer.size()));
-    req.SetBody(std::make_shared<Aws::StringStream>(_buffer));
-    auto outcome = _client->UploadPart(req);
-    if (outcome.IsSuccess()) {
-        _etags.push_back(outcome.GetResult().GetETag());
-        return Status::OK();
+    int part_number;
+    {
+        std::lock_guard l(_mutex);
+        _etags.emplace_back();
+        part_number = static_cast<int>(_etags.size());
+    }
+    const int64_t max_inflight_bytes = config::s3_upload_max_inflight_bytes;
+    ThreadPool* pool = max_inflight_bytes > 0 ? upload_pool() : nullptr;
+    if (pool == nullptr) {
+        return upload_part(part_number, _buffer);
+    }
+
+    auto data = std::make_shared<Aws::String>(std::move(_buffer));
+    _buffer.clear();
+    const auto size = static_cast<int64_t>(data->size());
+    {
+        std::unique_lock l(_mutex);
+        _cv.wait(l, [&] { return _inflight_parts == 0 || _inflight_bytes + size <= max_inflight_bytes; });
+        RETURN_IF_ERROR(_upload_status);
+        _inflight_bytes += size;
+        _inflight_parts++;
+    }
+    auto st = pool->submit_func([this, part_number, data, size]() {
+        auto st = upload_part(part_number, *data);
+        std::lock_guard l(_mutex);
+        if (!st.ok() && _upload_status.ok()) {
+            _upload_status = st;
+        }
+        _inflight_bytes -= size;
+        _inflight_parts--;
+        // Notify with the lock held, the stream may be destroyed once the lock is released.
+        _cv.notify_all();
+    });
+    if (!st.ok()) {
+        {
+            std::lock_guard l(_mutex);
+            _inflight_bytes -= size;
+            _inflight_parts--;
+        }
+        return upload_part(part_number, *data);
+    }
+    return Status::OK();
+}
+
+Status S3OutputStream::upload_part(int part_number, const Aws::String& data) {
+    Aws::S3::Model::UploadPartOutcome outcome;
+    for (int attempt = 0; attempt <= std::max(0, config::s3_upload_part_max_retries); attempt++) {
+        Aws::S3::Model::UploadPartRequest req;
+        req.SetBucket(_bucket);
+        req.SetKey(_object);
+        req.SetPartNumber(part_number);
+        req.SetUploadId(_upload_id);
+        req.SetContentLength(static_cast<int64_t>(data.size()));
+        req.SetBody(std::make_shared<Aws::StringStream>(data));
+        outcome = _client->UploadPart(req);
+        if (outcome.IsSuccess()) {
+            std::lock_guard l(_mutex);
+            _etags[part_number - 1] = outcome.GetResult().GetETag();
+            return Status::OK();
+        }
+        LOG(WARNING) << "S3: Fail to upload part " << part_number << " of " << _bucket << "/" << _object
+                     << ", attempt " << attempt << ": " << outcome.GetError().GetMessage();
     }
     return Status::IOError(
             fmt::format("S3: Fail to upload part of {}/{}: {}", _bucket, _object, outcome.GetError().GetMessage()));
 }
 
+Status S3OutputStream::wait_uploading_parts() {
+    std::unique_lock l(_mutex);
+    _cv.wait(l, [this] { return _inflight_parts == 0; });
+    return _upload_status;
+}
+
 Status S3OutputStream::complete_multipart_upload() {
     VLOG(12) << "Completing multipart upload s3://" << _bucket << "/" << _object;
     DCHECK(!_upload_id.empty());
@@ -16,16 +16,21 @@
 
 #include <aws/s3/S3Client.h>
 
+#include <condition_variable>
+#include <mutex>
+
 #include "io/output_stream.h"
 
 namespace starrocks::io {
 
+// The parts of a multipart upload are uploaded in background, at most `s3_upload_max_inflight_bytes` of them
+// at the same time, and `close()` waits for the last parts before completing the upload.
 class S3OutputStream : public OutputStream {
 public:
     explicit S3OutputStream(std::shared_ptr<Aws::S3::S3Client> client, std::string bucket, std::string object,
                             int64_t max_single_part_size, int64_t min_upload_part_size);
 
-    ~S3OutputStream() override = default;
+    ~S3OutputStream() override;
 
     // Disallow copy and assignment
     S3OutputStream(const S3OutputStream&) = delete;
@@ -54,6 +59,10 @@ private:
     Status multipart_upload();
     Status singlepart_upload();
     Status complete_multipart_upload();
+    // Upload a part with retries, and record its etag.
+    Status upload_part(int part_number, const Aws::String& data);
+    // Wait for the parts uploading in background, and return the first failure of them.
+    Status wait_uploading_parts();
 
     std::shared_ptr<Aws::S3::S3Client> _client;
     const Aws::String _bucket;
@@ -62,7 +71,14 @@ private:
     const int64_t _min_upload_part_size;
     Aws::String _buffer;
     Aws::String _upload_id;
+
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    // The etags of the parts, indexed by part number - 1.
     std::vector<Aws::String> _etags;
+    int64_t _inflight_bytes = 0;
+    int _inflight_parts = 0;
+    Status _upload_status;
 };
 
 } // namespace starrocks::io
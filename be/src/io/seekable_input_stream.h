@@ -14,10 +14,18 @@
 
 #pragma once
 
+#include <vector>
+
 #include "io/input_stream.h"
 
 namespace starrocks::io {
 
+struct ReadRange {
+    int64_t offset;
+    void* data;
+    int64_t count;
+};
+
 class SeekableInputStream : public InputStream {
 public:
     ~SeekableInputStream() override = default;
@@ -57,6 +65,15 @@ public:
     // ```
     virtual Status read_at_fully(int64_t offset, void* out, int64_t count);
 
+    // Read each of |ranges| fully, as `read_at_fully()` does. The implementation may issue the reads
+    // together, e.g, with one system call.
+    //
+    // Default implementation:
+    // ```
+    //    for (auto& r : ranges) RETURN_IF_ERROR(read_at_fully(r.offset, r.data, r.count));
+    // ```
+    virtual Status read_ranges_fully(const std::vector<ReadRange>& ranges);
+
     // Return the total file size in bytes, or error.
     virtual StatusOr<int64_t> get_size() = 0;
 
@@ -112,6 +129,8 @@ public:
         return _impl->read_at_fully(offset, out, count);
     }
 
+    Status read_ranges_fully(const std::vector<ReadRange>& ranges) override { return _impl->read_ranges_fully(ranges); }
+
     StatusOr<int64_t> get_size() override { return _impl->get_size(); }
 
     Status seek(int64_t offset) override { return _impl->seek(offset); }
@@ -0,0 +1,106 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "runtime/arrow_result_writer.h"
+
+#include <arrow/memory_pool.h>
+#include <arrow/record_batch.h>
+
+#include "column/chunk.h"
+#include "runtime/buffer_control_block.h"
+#include "util/arrow/row_batch.h"
+#include "util/arrow/starrocks_column_to_arrow.h"
+
+namespace starrocks {
+
+ArrowResultWriter::ArrowResultWriter(BufferControlBlock* sinker, const std::vector<ExprContext*>& output_expr_ctxs,
+                                     RuntimeProfile* parent_profile)
+        : _sinker(sinker), _output_expr_ctxs(output_expr_ctxs), _parent_profile(parent_profile) {}
+
+ArrowResultWriter::~ArrowResultWriter() = default;
+
+Status ArrowResultWriter::init(RuntimeState* state) {
+    _init_profile();
+    if (nullptr == _sinker) {
+        return Status::InternalError("sinker is nullptr.");
+    }
+    return convert_to_arrow_schema(_output_expr_ctxs, &_arrow_schema);
+}
+
+void ArrowResultWriter::_init_profile() {
+    _total_timer = ADD_TIMER(_parent_profile, "TotalSendTime");
+    _convert_timer = ADD_CHILD_TIMER(_parent_profile, "ConvertToArrowTime", "TotalSendTime");
+    _serialize_timer = ADD_CHILD_TIMER(_parent_profile, "SerializeTime", "TotalSendTime");
+    _sent_rows_counter = ADD_COUNTER(_parent_profile, "NumSentRows", TUnit::UNIT);
+    _sent_bytes_counter = ADD_COUNTER(_parent_profile, "SerializedBytes", TUnit::BYTES);
+}
+
+Status ArrowResultWriter::append_chunk(Chunk* chunk) {
+    ASSIGN_OR_RETURN(auto results, process_chunk(chunk));
+    SCOPED_TIMER(_total_timer);
+    for (auto& result : results) {
+        RETURN_IF_ERROR(_sinker->add_batch(result));
+    }
+    _written_rows += _pending_rows;
+    _pending_rows = 0;
+    return Status::OK();
+}
+
+StatusOr<TFetchDataResultPtrs> ArrowResultWriter::process_chunk(Chunk* chunk) {
+    SCOPED_TIMER(_total_timer);
+    TFetchDataResultPtrs results;
+    if (nullptr == chunk || 0 == chunk->num_rows()) {
+        return results;
+    }
+
+    std::shared_ptr<arrow::RecordBatch> batch;
+    {
+        SCOPED_TIMER(_convert_timer);
+        RETURN_IF_ERROR(convert_chunk_to_arrow_batch(chunk, _output_expr_ctxs, _arrow_schema,
+                                                     arrow::default_memory_pool(), &batch));
+    }
+
+    auto result = std::make_unique<TFetchDataResult>();
+    result->result_batch.rows.resize(1);
+    {
+        SCOPED_TIMER(_serialize_timer);
+        RETURN_IF_ERROR(serialize_record_batch(*batch, &result->result_batch.rows[0]));
+    }
+    COUNTER_UPDATE(_sent_bytes_counter, result->result_batch.rows[0].size());
+    _pending_rows += chunk->num_rows();
+    results.emplace_back(std::move(result));
+    return results;
+}
+
+StatusOr<bool> ArrowResultWriter::try_add_batch(TFetchDataResultPtrs& results) {
+    auto status = _sinker->try_add_batch(results);
+    if (status.ok()) {
+        if (status.value()) {
+            _written_rows += _pending_rows;
+            _pending_rows = 0;
+            results.clear();
+        }
+    } else {
+        results.clear();
+        LOG(WARNING) << "Append arrow result to sink failed";
+    }
+    return status;
+}
+
+Status ArrowResultWriter::close() {
+    COUNTER_SET(_sent_rows_counter, _written_rows);
+    return Status::OK();
+}
+
+} // namespace starrocks
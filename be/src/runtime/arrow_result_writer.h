@@ -0,0 +1,71 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <arrow/type_fwd.h>
+
+#include "runtime/result_writer.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks {
+
+class ExprContext;
+class BufferControlBlock;
+class RuntimeProfile;
+
+// ArrowResultWriter converts the result chunks to Arrow record batches, every one of which is serialized as
+// an Arrow IPC stream into one row of TFetchDataResult. Rather than proxied by FE and converted to text rows,
+// the results are fetched from the BE by the fetch_arrow_data RPC, whose response attachment is the sequence
+// of the IPC streams.
+class ArrowResultWriter final : public ResultWriter {
+public:
+    ArrowResultWriter(BufferControlBlock* sinker, const std::vector<ExprContext*>& output_expr_ctxs,
+                      RuntimeProfile* parent_profile);
+
+    ~ArrowResultWriter() override;
+
+    Status init(RuntimeState* state) override;
+
+    Status append_chunk(Chunk* chunk) override;
+
+    StatusOr<TFetchDataResultPtrs> process_chunk(Chunk* chunk) override;
+
+    StatusOr<bool> try_add_batch(TFetchDataResultPtrs& results) override;
+
+    Status close() override;
+
+private:
+    void _init_profile();
+
+    BufferControlBlock* _sinker;
+    const std::vector<ExprContext*>& _output_expr_ctxs;
+    std::shared_ptr<arrow::Schema> _arrow_schema;
+    // The rows of the results processed but not added to the sinker yet.
+    int64_t _pending_rows = 0;
+
+    // parent profile from result sink. not owned
+    RuntimeProfile* _parent_profile;
+    // total time
+    RuntimeProfile::Counter* _total_timer = nullptr;
+    // the time to convert the chunks to record batches
+    RuntimeProfile::Counter* _convert_timer = nullptr;
+    // the time to serialize the record batches
+    RuntimeProfile::Counter* _serialize_timer = nullptr;
+    // number of sent rows
+    RuntimeProfile::Counter* _sent_rows_counter = nullptr;
+    RuntimeProfile::Counter* _sent_bytes_counter = nullptr;
+};
+
+} // namespace starrocks
@@ -63,6 +63,17 @@ void GetResultBatchCtx::on_close(int64_t packet_seq, QueryStatistics* statistics
 }
 
 void GetResultBatchCtx::on_data(TFetchDataResult* t_result, int64_t packet_seq, bool eos) {
+    if (raw_rows) {
+        for (const auto& row : t_result->result_batch.rows) {
+            cntl->response_attachment().append(row);
+        }
+        result->set_packet_seq(packet_seq);
+        result->set_eos(eos);
+        Status::OK().to_protobuf(result->mutable_status());
+        done->Run();
+        delete this;
+        return;
+    }
     uint8_t* buf = nullptr;
     uint32_t len = 0;
     ThriftSerializer ser(false, 4096);
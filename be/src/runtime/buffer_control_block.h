@@ -62,6 +62,9 @@ struct GetResultBatchCtx {
     brpc::Controller* cntl = nullptr;
     PFetchDataResult* result = nullptr;
     google::protobuf::Closure* done = nullptr;
+    // If true, the rows are appended to the response attachment as they are rather than serialized as
+    // TResultBatch, e.g. the Arrow IPC streams of ArrowResultWriter.
+    bool raw_rows = false;
 
     GetResultBatchCtx(brpc::Controller* cntl_, PFetchDataResult* result_, google::protobuf::Closure* done_)
             : cntl(cntl_), result(result_), done(done_) {}
@@ -20,6 +20,7 @@
 #include "gen_cpp/Types_types.h"
 #include "gutil/macros.h"
 #include "runtime/mem_tracker.h"
+#include "runtime/query_cpu_profiler.h"
 #include "util/defer_op.h"
 #include "util/uid_util.h"
 
@@ -33,12 +34,18 @@
 #define SCOPED_THREAD_LOCAL_OPERATOR_MEM_TRACKER_SETTER(operator) \
     auto VARNAME_LINENUM(tracker_setter) = CurrentThreadOperatorMemTrackerSetter(operator->mem_tracker())
 
+// Tag the cpu samples of the thread by the operator.
+#define SCOPED_SET_OPERATOR_TRACE_INFO(operator) \
+    auto VARNAME_LINENUM(operator_setter) =      \
+            CurrentThreadOperatorSetter(operator->get_plan_node_id(), &operator->get_raw_name())
+
 #define SCOPED_THREAD_LOCAL_CHECK_MEM_LIMIT_SETTER(check) \
     auto VARNAME_LINENUM(check_setter) = CurrentThreadCheckMemLimitSetter(check)
 
 #define CHECK_MEM_LIMIT(err_msg)                                                              \
     do {                                                                                      \
         if (tls_thread_status.check_mem_limit() && CurrentThread::mem_tracker() != nullptr) { \
+            tls_thread_status.commit_mem_consumption();                                       \
             RETURN_IF_ERROR(CurrentThread::mem_tracker()->check_mem_limit(err_msg));          \
         }                                                                                     \
     } while (0)
@@ -64,7 +71,7 @@ private:
             _cache_size += size;
             _allocated_cache_size += size;
             _total_consumed_bytes += size;
-            if (_cache_size >= BATCH_SIZE) {
+            if (_cache_size >= _batch_size) {
                 commit(false);
             }
         }
@@ -74,10 +81,11 @@ private:
             _cache_size += size;
             _allocated_cache_size += size;
             _total_consumed_bytes += size;
-            if (cur_tracker != nullptr && _cache_size >= BATCH_SIZE) {
+            if (cur_tracker != nullptr && _cache_size >= _batch_size) {
                 MemTracker* limit_tracker = cur_tracker->try_consume(_cache_size);
                 if (LIKELY(limit_tracker == nullptr)) {
                     _cache_size = 0;
+                    _update_batch_size(cur_tracker);
                     return true;
                 } else {
                     _cache_size -= size;
@@ -93,7 +101,7 @@ private:
         void release(int64_t size) {
             _cache_size -= size;
             _deallocated_cache_size += size;
-            if (_cache_size <= -BATCH_SIZE) {
+            if (_cache_size <= -_batch_size) {
                 commit(false);
             }
         }
@@ -102,6 +110,7 @@ private:
             MemTracker* cur_tracker = _loader();
             if (cur_tracker != nullptr) {
                 cur_tracker->consume(_cache_size);
+                _update_batch_size(cur_tracker);
             }
             _cache_size = 0;
             if (is_ctx_shift) {
@@ -123,11 +132,27 @@ private:
 
         int64_t get_consumed_bytes() const { return _total_consumed_bytes; }
 
+        // Commit the cached bytes if any, the allocation and deallocation stats are still cached.
+        void commit_consumption() {
+            if (_cache_size != 0) {
+                commit(false);
+            }
+        }
+
     private:
+        // Cache less bytes when the tracker or any of its ancestors is close to its limit, so that the error of
+        // the limit checks, which is at most the batch size per thread, is small near the limit.
+        void _update_batch_size(MemTracker* tracker) {
+            _batch_size = tracker->spare_capacity() < PRECISE_SPARE_CAPACITY ? PRECISE_BATCH_SIZE : BATCH_SIZE;
+        }
+
         const static int64_t BATCH_SIZE = 2 * 1024 * 1024;
+        const static int64_t PRECISE_BATCH_SIZE = 64 * 1024;
+        const static int64_t PRECISE_SPARE_CAPACITY = 256 * 1024 * 1024;
 
         std::function<MemTracker*()> _loader;
 
+        int64_t _batch_size = BATCH_SIZE;
         // Allocated or delocated but not committed memory bytes, can be negative
         int64_t _cache_size = 0;
         // Allocated but not committed memory bytes, always positive
@@ -145,6 +170,8 @@ public:
     ~CurrentThread();
 
     void mem_tracker_ctx_shift() { _mem_cache_manager.commit(true); }
+    // Commit the cached consumption to the mem tracker, so that its limit can be checked precisely.
+    void commit_mem_consumption() { _mem_cache_manager.commit_consumption(); }
     void operator_mem_tracker_ctx_shift() { _operator_mem_cache_manager.commit(true); }
 
     void set_query_id(const starrocks::TUniqueId& query_id) { _query_id = query_id; }
@@ -156,6 +183,21 @@ public:
     const starrocks::TUniqueId& fragment_instance_id() { return _fragment_instance_id; }
     void set_pipeline_driver_id(int32_t driver_id) { _driver_id = driver_id; }
     int32_t get_driver_id() const { return _driver_id; }
+    // The operator running on this thread, only to tag the cpu samples by QueryCpuProfiler.
+    void set_operator(int32_t plan_node_id, const std::string* operator_name) {
+        _operator_plan_node_id = plan_node_id;
+        _operator_name = operator_name;
+    }
+    int32_t operator_plan_node_id() const { return _operator_plan_node_id; }
+    const std::string* operator_name() const { return _operator_name; }
+    // The workgroup whose scan task is running on this thread, -1 if none.
+    // Return prev workgroup id.
+    int64_t set_workgroup_id(int64_t workgroup_id) {
+        int64_t prev = _workgroup_id;
+        _workgroup_id = workgroup_id;
+        return prev;
+    }
+    int64_t workgroup_id() const { return _workgroup_id; }
 
     // Return prev memory tracker.
     starrocks::MemTracker* set_mem_tracker(starrocks::MemTracker* mem_tracker) {
@@ -258,6 +300,9 @@ private:
     TUniqueId _query_id;
     TUniqueId _fragment_instance_id;
     int32_t _driver_id = 0;
+    int32_t _operator_plan_node_id = -1;
+    const std::string* _operator_name = nullptr;
+    int64_t _workgroup_id = -1;
     bool _is_catched = false;
     bool _check = true;
 };
@@ -318,6 +363,27 @@ private:
     bool _is_same;
 };
 
+class CurrentThreadOperatorSetter {
+public:
+    CurrentThreadOperatorSetter(int32_t plan_node_id, const std::string* operator_name) {
+        auto& thread = tls_thread_status;
+        _prev_plan_node_id = thread.operator_plan_node_id();
+        _prev_operator_name = thread.operator_name();
+        thread.set_operator(plan_node_id, operator_name);
+    }
+
+    ~CurrentThreadOperatorSetter() { tls_thread_status.set_operator(_prev_plan_node_id, _prev_operator_name); }
+
+    CurrentThreadOperatorSetter(const CurrentThreadOperatorSetter&) = delete;
+    void operator=(const CurrentThreadOperatorSetter&) = delete;
+    CurrentThreadOperatorSetter(CurrentThreadOperatorSetter&&) = delete;
+    void operator=(CurrentThreadOperatorSetter&&) = delete;
+
+private:
+    int32_t _prev_plan_node_id;
+    const std::string* _prev_operator_name;
+};
+
 class CurrentThreadCheckMemLimitSetter {
 public:
     explicit CurrentThreadCheckMemLimitSetter(bool check) {
@@ -353,6 +419,7 @@ private:
 #define SCOPED_SET_CATCHED(catched) auto VARNAME_LINENUM(catched_setter) = CurrentThreadCatchSetter(catched)
 
 #define SCOPED_SET_TRACE_INFO(driver_id, query_id, fragment_instance_id)     \
+    QueryCpuProfiler::register_current_thread();                             \
     CurrentThread::current().set_pipeline_driver_id(driver_id);              \
     CurrentThread::current().set_query_id(query_id);                         \
     CurrentThread::current().set_fragment_instance_id(fragment_instance_id); \
@@ -134,7 +134,8 @@ Status DataStreamMgr::transmit_data(const PTransmitDataParams* request, ::google
     return Status::OK();
 }
 
-Status DataStreamMgr::transmit_chunk(const PTransmitChunkParams& request, ::google::protobuf::Closure** done) {
+Status DataStreamMgr::transmit_chunk(const PTransmitChunkParams& request, ::google::protobuf::Closure** done,
+                                     PTransmitChunkResult* response) {
     const PUniqueId& finst_id = request.finst_id();
     // TODO(zc): Use PUniqueId directly
     // We can use PUniqueId directly, because old version StarRocks has already use
@@ -162,6 +163,15 @@ Status DataStreamMgr::transmit_chunk(const PTransmitChunkParams& request, ::goog
         recvr->add_sub_plan_statistics(request.query_statistics(), request.sender_id());
     }
 
+    // The response must be set before add_chunks, after which done may be run by the consumer at any time.
+    if (response != nullptr && !request.eos()) {
+        int64_t incoming_bytes = 0;
+        for (const auto& chunk : request.chunks()) {
+            incoming_bytes += chunk.data().size();
+        }
+        response->set_credit_bytes(recvr->credit_bytes(incoming_bytes));
+    }
+
     bool eos = request.eos();
     DeferOp op([&eos, &recvr, &request]() {
         if (eos) {
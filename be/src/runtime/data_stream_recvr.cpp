@@ -45,6 +45,7 @@
 #include <utility>
 
 #include "column/chunk.h"
+#include "common/config.h"
 #include "exec/sort_exec_exprs.h"
 #include "gen_cpp/data.pb.h"
 #include "runtime/chunk_cursor.h"
@@ -103,7 +104,6 @@ Status DataStreamRecvr::create_merger_for_pipeline(RuntimeState* state, const So
                                                    const std::vector<bool>* is_null_first) {
     DCHECK(_is_merging);
     _chunks_merger = nullptr;
-    _cascade_merger = std::make_unique<CascadeChunkMerger>(state);
 
     std::vector<ChunkProvider> providers;
     for (SenderQueue* q : _sender_queues) {
@@ -125,6 +125,12 @@ Status DataStreamRecvr::create_merger_for_pipeline(RuntimeState* state, const So
         };
         providers.push_back(std::move(provider));
     }
+    if (config::exchange_merge_loser_tree_min_senders > 0 &&
+        providers.size() >= static_cast<size_t>(config::exchange_merge_loser_tree_min_senders)) {
+        _loser_tree_merger = std::make_unique<LoserTreeChunkMerger>(state);
+        return _loser_tree_merger->init(providers, &(exprs->lhs_ordering_expr_ctxs()), is_asc, is_null_first);
+    }
+    _cascade_merger = std::make_unique<CascadeChunkMerger>(state);
     RETURN_IF_ERROR(_cascade_merger->init(providers, &(exprs->lhs_ordering_expr_ctxs()), is_asc, is_null_first));
     return Status::OK();
 }
@@ -142,6 +148,7 @@ DataStreamRecvr::DataStreamRecvr(DataStreamMgr* stream_mgr, RuntimeState* runtim
           _row_desc(row_desc),
           _is_merging(is_merging),
           _num_buffered_bytes(0),
+          _num_senders(num_senders),
           _profile(std::move(profile)),
           _instance_profile(runtime_state->runtime_profile_ptr()),
           _query_mem_tracker(runtime_state->query_mem_tracker_ptr()),
@@ -193,9 +200,13 @@ Status DataStreamRecvr::get_next(ChunkPtr* chunk, bool* eos) {
 }
 
 Status DataStreamRecvr::get_next_for_pipeline(ChunkPtr* chunk, std::atomic<bool>* eos, bool* should_exit) {
-    DCHECK(_cascade_merger);
     ChunkUniquePtr chunk_ptr;
-    RETURN_IF_ERROR(_cascade_merger->get_next(&chunk_ptr, eos, should_exit));
+    if (_loser_tree_merger) {
+        RETURN_IF_ERROR(_loser_tree_merger->get_next(&chunk_ptr, eos, should_exit));
+    } else {
+        DCHECK(_cascade_merger);
+        RETURN_IF_ERROR(_cascade_merger->get_next(&chunk_ptr, eos, should_exit));
+    }
     *chunk = std::move(chunk_ptr);
     return Status::OK();
 }
@@ -203,11 +214,19 @@ Status DataStreamRecvr::get_next_for_pipeline(ChunkPtr* chunk, std::atomic<bool>
 bool DataStreamRecvr::is_data_ready() {
     if (_chunks_merger) {
         return _chunks_merger->is_data_ready();
+    } else if (_loser_tree_merger) {
+        return _loser_tree_merger->is_data_ready();
     } else {
         return _cascade_merger->is_data_ready();
     }
 }
 
+int64_t DataStreamRecvr::credit_bytes(int64_t incoming_bytes) const {
+    int64_t free_bytes = static_cast<int64_t>(_total_buffer_limit) - static_cast<int64_t>(_num_buffered_bytes) -
+                         incoming_bytes;
+    return std::max<int64_t>(free_bytes, 0) / std::max(_num_senders, 1);
+}
+
 Status DataStreamRecvr::add_chunks(const PTransmitChunkParams& request, ::google::protobuf::Closure** done) {
     MemTracker* prev_tracker = tls_thread_status.set_mem_tracker(_instance_mem_tracker.get());
     DeferOp op([&] { tls_thread_status.set_mem_tracker(prev_tracker); });
@@ -218,23 +237,50 @@ Status DataStreamRecvr::add_chunks(const PTransmitChunkParams& request, ::google
     int use_sender_id = _is_merging ? request.sender_id() : 0;
     // Add all batches to the same queue if _is_merging is false.
 
+    Status status;
     if (_keep_order) {
         DCHECK(_is_pipeline);
-        return _sender_queues[use_sender_id]->add_chunks_and_keep_order(request, done);
+        status = _sender_queues[use_sender_id]->add_chunks_and_keep_order(request, done);
     } else {
-        return _sender_queues[use_sender_id]->add_chunks(request, done);
+        status = _sender_queues[use_sender_id]->add_chunks(request, done);
     }
+    _notify_readiness();
+    return status;
 }
 
 void DataStreamRecvr::remove_sender(int sender_id, int be_number) {
     int use_sender_id = _is_merging ? sender_id : 0;
     _sender_queues[use_sender_id]->decrement_senders(be_number);
+    _notify_readiness();
 }
 
 void DataStreamRecvr::cancel_stream() {
     for (auto& _sender_queue : _sender_queues) {
         _sender_queue->cancel();
     }
+    _notify_readiness();
+}
+
+void DataStreamRecvr::set_readiness_notifier(int32_t driver_sequence, std::function<void()> notifier) {
+    std::unique_lock lock(_readiness_notifiers_lock);
+    if (notifier == nullptr) {
+        _readiness_notifiers.erase(driver_sequence);
+    } else {
+        _readiness_notifiers[driver_sequence] = std::move(notifier);
+    }
+    _has_readiness_notifiers = !_readiness_notifiers.empty();
+}
+
+void DataStreamRecvr::_notify_readiness() {
+    if (!_has_readiness_notifiers) {
+        return;
+    }
+    // The new chunks may make the other drivers ready as well, e.g. when the buffer becomes full,
+    // so notify all the drivers.
+    std::shared_lock lock(_readiness_notifiers_lock);
+    for (auto& [_, notifier] : _readiness_notifiers) {
+        notifier();
+    }
 }
 
 void DataStreamRecvr::close() {
@@ -247,6 +293,7 @@ void DataStreamRecvr::close() {
     _mgr = nullptr;
     _chunks_merger.reset();
     _cascade_merger.reset();
+    _loser_tree_merger.reset();
 
     _closure_block_timer->update(_closure_block_timer->value() / std::max(1, _degree_of_parallelism));
 }
@@ -34,6 +34,10 @@
 
 #pragma once
 
+#include <functional>
+#include <shared_mutex>
+#include <unordered_map>
+
 #include "column/vectorized_fwd.h"
 #include "common/object_pool.h"
 #include "common/status.h"
@@ -51,6 +55,7 @@ namespace starrocks {
 
 class SortedChunksMerger;
 class CascadeChunkMerger;
+class LoserTreeChunkMerger;
 
 class DataStreamMgr;
 class MemTracker;
@@ -128,6 +133,14 @@ public:
 
     bool get_encode_level() const { return _encode_level; }
 
+    // The bytes a sender can send in addition to its in-flight requests, which is its share of the free buffer
+    // after |incoming_bytes| are buffered. The credits are replenished as fast as the buffer is consumed.
+    int64_t credit_bytes(int64_t incoming_bytes) const;
+
+    // Set the callback of the pipeline driver with *driver_sequence*, which is invoked when new chunks come
+    // or the senders finish. It must be reset by nullptr before the driver is destructed.
+    void set_readiness_notifier(int32_t driver_sequence, std::function<void()> notifier);
+
 private:
     friend class DataStreamMgr;
     class SenderQueue;
@@ -150,6 +163,8 @@ private:
     // Empties the sender queues and notifies all waiting consumers of cancellation.
     void cancel_stream();
 
+    void _notify_readiness();
+
     // Return true if the addition of a new batch of size 'chunk_size' would exceed the
     // total buffer limit.
     bool exceeds_limit(int chunk_size) { return _num_buffered_bytes + chunk_size > _total_buffer_limit; }
@@ -176,6 +191,8 @@ private:
     // total number of bytes held across all sender queues.
     std::atomic<size_t> _num_buffered_bytes{0};
 
+    const int _num_senders;
+
     // One or more queues of row batches received from senders. If _is_merging is true,
     // there is one SenderQueue for each sender. Otherwise, row batches from all senders
     // are placed in the same SenderQueue. The SenderQueue instances are owned by the
@@ -185,6 +202,7 @@ private:
     // SortedChunksMerger merges chunks from different senders.
     std::unique_ptr<SortedChunksMerger> _chunks_merger;
     std::unique_ptr<CascadeChunkMerger> _cascade_merger;
+    std::unique_ptr<LoserTreeChunkMerger> _loser_tree_merger;
 
     // Pool of sender queues.
     ObjectPool _sender_queue_pool;
@@ -234,6 +252,10 @@ private:
     PassThroughContext _pass_through_context;
 
     int _encode_level;
+
+    std::shared_mutex _readiness_notifiers_lock;
+    std::unordered_map<int32_t, std::function<void()>> _readiness_notifiers;
+    std::atomic<bool> _has_readiness_notifiers{false};
 };
 
 } // end namespace starrocks
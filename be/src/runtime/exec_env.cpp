@@ -43,6 +43,7 @@
 #include "common/config.h"
 #include "common/configbase.h"
 #include "common/logging.h"
+#include "exec/join_hash_table_cache.h"
 #include "exec/pipeline/driver_limiter.h"
 #include "exec/pipeline/pipeline_driver_executor.h"
 #include "exec/pipeline/query_context.h"
@@ -64,6 +65,7 @@
 #include "runtime/mem_tracker.h"
 #include "runtime/memory/mem_chunk_allocator.h"
 #include "runtime/profile_report_worker.h"
+#include "runtime/query_cpu_profiler.h"
 #include "runtime/result_buffer_mgr.h"
 #include "runtime/result_queue_mgr.h"
 #include "runtime/routine_load/routine_load_task_executor.h"
@@ -73,6 +75,7 @@
 #include "runtime/stream_load/load_stream_mgr.h"
 #include "runtime/stream_load/stream_load_executor.h"
 #include "runtime/stream_load/transaction_mgr.h"
+#include "storage/lake/cache_warmer.h"
 #include "storage/lake/fixed_location_provider.h"
 #include "storage/lake/starlet_location_provider.h"
 #include "storage/lake/tablet_manager.h"
@@ -177,6 +180,56 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
                             .set_idle_timeout(MonoDelta::FromMilliseconds(2000))
                             .build(&_automatic_partition_pool));
 
+    int num_column_encode_threads = config::segment_column_encode_thread_num;
+    if (num_column_encode_threads <= 0) {
+        num_column_encode_threads = CpuInfo::num_cores();
+    }
+    RETURN_IF_ERROR(ThreadPoolBuilder("seg_col_encode") // parallel column encoding of segment writers
+                            .set_min_threads(0)
+                            .set_max_threads(num_column_encode_threads)
+                            .set_idle_timeout(MonoDelta::FromMilliseconds(2000))
+                            .build(&_segment_column_encode_pool));
+
+    int num_compaction_range_threads = config::lake_compaction_sub_range_thread_num;
+    if (num_compaction_range_threads <= 0) {
+        num_compaction_range_threads = CpuInfo::num_cores();
+    }
+    RETURN_IF_ERROR(ThreadPoolBuilder("lake_compact_range") // sub-range compaction of lake tablets
+                            .set_min_threads(0)
+                            .set_max_threads(num_compaction_range_threads)
+                            .set_idle_timeout(MonoDelta::FromMilliseconds(2000))
+                            .build(&_lake_compaction_range_pool));
+
+    int num_parquet_encode_threads = config::parquet_column_encode_thread_num;
+    if (num_parquet_encode_threads <= 0) {
+        num_parquet_encode_threads = CpuInfo::num_cores();
+    }
+    RETURN_IF_ERROR(ThreadPoolBuilder("parquet_col_encode") // parallel column encoding of parquet builders
+                            .set_min_threads(0)
+                            .set_max_threads(num_parquet_encode_threads)
+                            .set_idle_timeout(MonoDelta::FromMilliseconds(2000))
+                            .build(&_parquet_column_encode_pool));
+
+    int num_jni_prefetch_threads = config::jni_scanner_prefetch_thread_num;
+    if (num_jni_prefetch_threads <= 0) {
+        num_jni_prefetch_threads = CpuInfo::num_cores();
+    }
+    RETURN_IF_ERROR(ThreadPoolBuilder("jni_prefetch") // chunk prefetching of jni scanners
+                            .set_min_threads(0)
+                            .set_max_threads(num_jni_prefetch_threads)
+                            .set_idle_timeout(MonoDelta::FromMilliseconds(2000))
+                            .build(&_jni_scanner_prefetch_pool));
+
+    int num_small_file_prefetch_threads = config::connector_small_file_prefetch_thread_num;
+    if (num_small_file_prefetch_threads <= 0) {
+        num_small_file_prefetch_threads = CpuInfo::num_cores();
+    }
+    RETURN_IF_ERROR(ThreadPoolBuilder("file_prefetch") // prefetching of the small coalesced files
+                            .set_min_threads(0)
+                            .set_max_threads(num_small_file_prefetch_threads)
+                            .set_idle_timeout(MonoDelta::FromMilliseconds(2000))
+                            .build(&_small_file_prefetch_pool));
+
     int num_prepare_threads = config::pipeline_prepare_thread_pool_thread_num;
     if (num_prepare_threads <= 0) {
         num_prepare_threads = CpuInfo::num_cores();
@@ -233,22 +286,24 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
     int connector_num_io_threads =
             config::pipeline_connector_scan_thread_num_per_cpu * std::thread::hardware_concurrency();
     CHECK_GT(connector_num_io_threads, 0) << "pipeline_connector_scan_thread_num_per_cpu should greater than 0";
+    int num_io_elastic_threads = std::max<int>(0, config::pipeline_scan_thread_pool_max_io_elastic_threads);
 
     std::unique_ptr<ThreadPool> connector_scan_worker_thread_pool_without_workgroup;
     RETURN_IF_ERROR(ThreadPoolBuilder("con_scan_io")
                             .set_min_threads(0)
-                            .set_max_threads(connector_num_io_threads)
+                            .set_max_threads(connector_num_io_threads + num_io_elastic_threads)
                             .set_max_queue_size(1000)
                             .set_idle_timeout(MonoDelta::FromMilliseconds(2000))
                             .build(&connector_scan_worker_thread_pool_without_workgroup));
     _connector_scan_executor_without_workgroup = new workgroup::ScanExecutor(
             std::move(connector_scan_worker_thread_pool_without_workgroup), workgroup::create_scan_task_queue());
+    _connector_scan_executor_without_workgroup->set_max_elastic_threads(num_io_elastic_threads);
     _connector_scan_executor_without_workgroup->initialize(connector_num_io_threads);
 
     std::unique_ptr<ThreadPool> connector_scan_worker_thread_pool_with_workgroup;
     RETURN_IF_ERROR(ThreadPoolBuilder("con_wg_scan_io")
                             .set_min_threads(0)
-                            .set_max_threads(connector_num_io_threads)
+                            .set_max_threads(connector_num_io_threads + num_io_elastic_threads)
                             .set_max_queue_size(1000)
                             .set_idle_timeout(MonoDelta::FromMilliseconds(2000))
                             .build(&connector_scan_worker_thread_pool_with_workgroup));
@@ -256,6 +311,7 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
             new workgroup::ScanExecutor(std::move(connector_scan_worker_thread_pool_with_workgroup),
                                         std::make_unique<workgroup::WorkGroupScanTaskQueue>(
                                                 workgroup::WorkGroupScanTaskQueue::SchedEntityType::CONNECTOR));
+    _connector_scan_executor_with_workgroup->set_max_elastic_threads(num_io_elastic_threads);
     _connector_scan_executor_with_workgroup->initialize(connector_num_io_threads);
 
     starrocks::workgroup::DefaultWorkGroupInitialization default_workgroup_init;
@@ -263,6 +319,7 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
     _load_path_mgr = new LoadPathMgr(this);
     _broker_mgr = new BrokerMgr(this);
     _bfd_parser = BfdParser::create();
+    RETURN_IF_ERROR(QueryCpuProfiler::instance()->start());
     _load_channel_mgr = new LoadChannelMgr();
     _load_stream_mgr = new LoadStreamMgr();
     _brpc_stub_cache = new BrpcStubCache();
@@ -288,25 +345,30 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
     std::unique_ptr<ThreadPool> scan_worker_thread_pool_without_workgroup;
     RETURN_IF_ERROR(ThreadPoolBuilder("pip_scan_io")
                             .set_min_threads(0)
-                            .set_max_threads(num_io_threads)
+                            .set_max_threads(num_io_threads + num_io_elastic_threads)
                             .set_max_queue_size(1000)
                             .set_idle_timeout(MonoDelta::FromMilliseconds(2000))
                             .build(&scan_worker_thread_pool_without_workgroup));
-    _scan_executor_without_workgroup = new workgroup::ScanExecutor(std::move(scan_worker_thread_pool_without_workgroup),
-                                                                   workgroup::create_scan_task_queue());
+    _scan_executor_without_workgroup = new workgroup::ScanExecutor(
+            std::move(scan_worker_thread_pool_without_workgroup),
+            std::make_unique<workgroup::DiskAwareScanTaskQueue>("pip_scan_io", workgroup::create_scan_task_queue()));
+    _scan_executor_without_workgroup->set_max_elastic_threads(num_io_elastic_threads);
     _scan_executor_without_workgroup->initialize(num_io_threads);
 
     std::unique_ptr<ThreadPool> scan_worker_thread_pool_with_workgroup;
     RETURN_IF_ERROR(ThreadPoolBuilder("pip_wg_scan_io")
                             .set_min_threads(0)
-                            .set_max_threads(num_io_threads)
+                            .set_max_threads(num_io_threads + num_io_elastic_threads)
                             .set_max_queue_size(1000)
                             .set_idle_timeout(MonoDelta::FromMilliseconds(2000))
                             .build(&scan_worker_thread_pool_with_workgroup));
     _scan_executor_with_workgroup =
             new workgroup::ScanExecutor(std::move(scan_worker_thread_pool_with_workgroup),
-                                        std::make_unique<workgroup::WorkGroupScanTaskQueue>(
-                                                workgroup::WorkGroupScanTaskQueue::SchedEntityType::OLAP));
+                                        std::make_unique<workgroup::DiskAwareScanTaskQueue>(
+                                                "pip_wg_scan_io",
+                                                std::make_unique<workgroup::WorkGroupScanTaskQueue>(
+                                                        workgroup::WorkGroupScanTaskQueue::SchedEntityType::OLAP)));
+    _scan_executor_with_workgroup->set_max_elastic_threads(num_io_elastic_threads);
     _scan_executor_with_workgroup->initialize(num_io_threads);
 
     // it means acting as compute node while store_path is empty. some threads are not needed for that case.
@@ -331,6 +393,10 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
 
 #if defined(USE_STAROS) && !defined(BE_TEST)
         _lake_tablet_manager->start_gc();
+        _lake_cache_warmer = new lake::CacheWarmer(_lake_tablet_manager);
+        if (auto st = _lake_cache_warmer->start(); !st.ok()) {
+            LOG(WARNING) << "Fail to start the lake cache warmer: " << st;
+        }
 #endif
     }
 
@@ -347,6 +413,9 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
     _heartbeat_flags = new HeartbeatFlags();
     auto capacity = std::max<size_t>(config::query_cache_capacity, 4L * 1024 * 1024);
     _cache_mgr = new query_cache::CacheManager(capacity);
+    if (config::join_hash_table_cache_capacity > 0) {
+        _join_hash_table_cache = new JoinHashTableCache(config::join_hash_table_cache_capacity);
+    }
     return Status::OK();
 }
 
@@ -422,7 +491,8 @@ Status ExecEnv::init_mem_tracker() {
 
     int64_t compaction_mem_limit = calc_max_compaction_memory(_process_mem_tracker->limit());
     _compaction_mem_tracker = regist_tracker(compaction_mem_limit, "compaction", process_mem_tracker());
-    _schema_change_mem_tracker = regist_tracker(-1, "schema_change", process_mem_tracker());
+    _schema_change_mem_tracker = regist_tracker(
+            -1, "schema_change", config::schema_change_share_load_memory ? load_mem_tracker() : process_mem_tracker());
     _column_pool_mem_tracker = regist_tracker(-1, "column_pool", process_mem_tracker());
     _page_cache_mem_tracker = regist_tracker(-1, "page_cache", process_mem_tracker());
     int32_t update_mem_percent = std::max(std::min(100, config::update_memory_limit_percent), 0);
@@ -478,6 +548,21 @@ void ExecEnv::_destroy() {
     if (_automatic_partition_pool) {
         _automatic_partition_pool->shutdown();
     }
+    if (_segment_column_encode_pool) {
+        _segment_column_encode_pool->shutdown();
+    }
+    if (_lake_compaction_range_pool) {
+        _lake_compaction_range_pool->shutdown();
+    }
+    if (_parquet_column_encode_pool) {
+        _parquet_column_encode_pool->shutdown();
+    }
+    if (_jni_scanner_prefetch_pool) {
+        _jni_scanner_prefetch_pool->shutdown();
+    }
+    if (_small_file_prefetch_pool) {
+        _small_file_prefetch_pool->shutdown();
+    }
 
     SAFE_DELETE(_agent_server);
     SAFE_DELETE(_runtime_filter_worker);
@@ -492,6 +577,7 @@ void ExecEnv::_destroy() {
     SAFE_DELETE(_load_stream_mgr);
     SAFE_DELETE(_load_channel_mgr);
     SAFE_DELETE(_broker_mgr);
+    QueryCpuProfiler::instance()->stop();
     SAFE_DELETE(_bfd_parser);
     SAFE_DELETE(_load_path_mgr);
     SAFE_DELETE(_driver_executor);
@@ -507,6 +593,7 @@ void ExecEnv::_destroy() {
     SAFE_DELETE(_connector_scan_executor_with_workgroup);
     SAFE_DELETE(_thread_pool);
 
+    SAFE_DELETE(_lake_cache_warmer);
     if (_lake_tablet_manager != nullptr) {
         _lake_tablet_manager->prune_metacache();
     }
@@ -527,6 +614,7 @@ void ExecEnv::_destroy() {
     SAFE_DELETE(_lake_location_provider);
     SAFE_DELETE(_lake_update_manager);
     SAFE_DELETE(_cache_mgr);
+    SAFE_DELETE(_join_hash_table_cache);
     _metrics = nullptr;
 
     _reset_tracker();
@@ -76,6 +76,7 @@ class SmallFileMgr;
 class PluginMgr;
 class RuntimeFilterWorker;
 class RuntimeFilterCache;
+class JoinHashTableCache;
 class ProfileReportWorker;
 struct RfTracePoint;
 
@@ -93,6 +94,7 @@ class DriverLimiter;
 } // namespace pipeline
 
 namespace lake {
+class CacheWarmer;
 class LocationProvider;
 class TabletManager;
 class UpdateManager;
@@ -200,6 +202,11 @@ public:
     HeartbeatFlags* heartbeat_flags() { return _heartbeat_flags; }
 
     ThreadPool* automatic_partition_pool() { return _automatic_partition_pool.get(); }
+    ThreadPool* segment_column_encode_pool() { return _segment_column_encode_pool.get(); }
+    ThreadPool* lake_compaction_range_pool() { return _lake_compaction_range_pool.get(); }
+    ThreadPool* parquet_column_encode_pool() { return _parquet_column_encode_pool.get(); }
+    ThreadPool* jni_scanner_prefetch_pool() { return _jni_scanner_prefetch_pool.get(); }
+    ThreadPool* small_file_prefetch_pool() { return _small_file_prefetch_pool.get(); }
 
     RuntimeFilterWorker* runtime_filter_worker() { return _runtime_filter_worker; }
     Status init_mem_tracker();
@@ -224,6 +231,8 @@ public:
 
     lake::UpdateManager* lake_update_manager() const { return _lake_update_manager; }
 
+    lake::CacheWarmer* lake_cache_warmer() const { return _lake_cache_warmer; }
+
     AgentServer* agent_server() const { return _agent_server; }
 
     int64_t get_storage_page_cache_size();
@@ -231,6 +240,8 @@ public:
 
     query_cache::CacheManagerRawPtr cache_mgr() const { return _cache_mgr; }
 
+    JoinHashTableCache* join_hash_table_cache() const { return _join_hash_table_cache; }
+
 private:
     Status _init(const std::vector<StorePath>& store_paths);
     void _destroy();
@@ -338,6 +349,11 @@ private:
     HeartbeatFlags* _heartbeat_flags = nullptr;
 
     std::unique_ptr<ThreadPool> _automatic_partition_pool;
+    std::unique_ptr<ThreadPool> _segment_column_encode_pool;
+    std::unique_ptr<ThreadPool> _lake_compaction_range_pool;
+    std::unique_ptr<ThreadPool> _parquet_column_encode_pool;
+    std::unique_ptr<ThreadPool> _jni_scanner_prefetch_pool;
+    std::unique_ptr<ThreadPool> _small_file_prefetch_pool;
 
     RuntimeFilterWorker* _runtime_filter_worker = nullptr;
     RuntimeFilterCache* _runtime_filter_cache = nullptr;
@@ -347,9 +363,11 @@ private:
     lake::TabletManager* _lake_tablet_manager = nullptr;
     lake::LocationProvider* _lake_location_provider = nullptr;
     lake::UpdateManager* _lake_update_manager = nullptr;
+    lake::CacheWarmer* _lake_cache_warmer = nullptr;
 
     AgentServer* _agent_server = nullptr;
     query_cache::CacheManagerRawPtr _cache_mgr;
+    JoinHashTableCache* _join_hash_table_cache = nullptr;
 };
 
 template <>
@@ -117,7 +117,7 @@ bool MemPool::find_chunk(size_t min_size, bool check_limits) {
 
     // Didn't find a big enough free chunk - need to allocate new chunk.
     size_t chunk_size;
-    DCHECK_LE(next_chunk_size_, MAX_CHUNK_SIZE);
+    DCHECK_LE(next_chunk_size_, max_chunk_size_);
 
     if (config::disable_mem_pools) {
         // Disable pooling by sizing the chunk to fit only this allocation.
@@ -150,7 +150,7 @@ bool MemPool::find_chunk(size_t min_size, bool check_limits) {
     total_reserved_bytes_ += chunk_size;
     // Don't increment the chunk size until the allocation succeeds: if an attempted
     // large allocation fails we don't want to increase the chunk size further.
-    next_chunk_size_ = static_cast<int>(std::min<int64_t>(chunk_size * 2, MAX_CHUNK_SIZE));
+    next_chunk_size_ = static_cast<int>(std::min<int64_t>(chunk_size * 2, max_chunk_size_));
 
     DCHECK(check_integrity(true));
     return true;
@@ -208,6 +208,7 @@ void MemPool::acquire_data(MemPool* src, bool keep_current) {
 void MemPool::exchange_data(MemPool* other) {
     std::swap(current_chunk_idx_, other->current_chunk_idx_);
     std::swap(next_chunk_size_, other->next_chunk_size_);
+    std::swap(max_chunk_size_, other->max_chunk_size_);
     std::swap(total_allocated_bytes_, other->total_allocated_bytes_);
     std::swap(total_reserved_bytes_, other->total_reserved_bytes_);
     std::swap(peak_allocated_bytes_, other->peak_allocated_bytes_);
@@ -106,7 +106,10 @@ class MemTracker;
 ///    delete p;
 class MemPool {
 public:
-    MemPool() : next_chunk_size_(INITIAL_CHUNK_SIZE) {}
+    MemPool() : MemPool(MAX_CHUNK_SIZE) {}
+
+    /// The chunks grow up to max_chunk_size bytes, which must be a power of two.
+    explicit MemPool(int max_chunk_size) : next_chunk_size_(INITIAL_CHUNK_SIZE), max_chunk_size_(max_chunk_size) {}
 
     /// Frees all chunks of memory and subtracts the total allocated bytes
     /// from the registered limits.
@@ -242,6 +245,9 @@ private:
     /// The size of the next chunk to allocate.
     int next_chunk_size_;
 
+    /// The maximum size of the chunks, except the ones of the larger allocations.
+    int max_chunk_size_;
+
     /// sum of allocated_bytes_
     int64_t total_allocated_bytes_{0};
 
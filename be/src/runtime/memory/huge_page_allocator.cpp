@@ -0,0 +1,46 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "runtime/memory/huge_page_allocator.h"
+
+#include <sys/mman.h>
+
+#include <cstdlib>
+
+#include "common/config.h"
+#include "util/bit_util.h"
+
+namespace starrocks {
+
+void* huge_page_allocate(size_t size) {
+    if (size < kHugePageSize || !config::enable_hash_table_huge_pages) {
+        return malloc(size);
+    }
+    size_t length = BitUtil::round_up(size, kHugePageSize);
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, kHugePageSize, length) != 0) {
+        return nullptr;
+    }
+#ifdef MADV_HUGEPAGE
+    // It's only an advice, the small pages still work if the transparent huge pages are disabled.
+    (void)madvise(ptr, length, MADV_HUGEPAGE);
+#endif
+    return ptr;
+}
+
+void huge_page_free(void* ptr) {
+    free(ptr);
+}
+
+} // namespace starrocks
@@ -0,0 +1,67 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace starrocks {
+
+static constexpr size_t kHugePageSize = 2UL << 20;
+
+// Allocate |size| bytes, the allocations of at least kHugePageSize bytes are aligned to and rounded up to the huge
+// pages, and advised to be backed by the transparent huge pages if enable_hash_table_huge_pages is true, which
+// avoids most of the TLB misses of randomly accessing them. The memory is allocated from the global allocator, so
+// it's accounted by the mem tracker of the current thread as usual.
+// Return nullptr if it fails.
+void* huge_page_allocate(size_t size);
+void huge_page_free(void* ptr);
+
+// The STL allocator of the large hash tables, e.g. the buckets of the agg hash maps and the join hash tables.
+template <typename T>
+class HugePageAllocator {
+public:
+    using value_type = T;
+
+    HugePageAllocator() = default;
+    template <typename U>
+    HugePageAllocator(const HugePageAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        void* ptr = huge_page_allocate(n * sizeof(T));
+        if (ptr == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* ptr, size_t n) { huge_page_free(ptr); }
+
+    template <typename U>
+    bool operator==(const HugePageAllocator<U>&) const {
+        return true;
+    }
+    template <typename U>
+    bool operator!=(const HugePageAllocator<U>&) const {
+        return false;
+    }
+};
+
+template <typename T>
+using HugePageBuffer = std::vector<T, HugePageAllocator<T>>;
+
+} // namespace starrocks
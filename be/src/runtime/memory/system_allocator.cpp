@@ -41,6 +41,7 @@
 #include "common/config.h"
 #include "common/logging.h"
 #include "runtime/mem_tracker.h"
+#include "runtime/memory/huge_page_allocator.h"
 
 namespace starrocks {
 
@@ -69,6 +70,14 @@ void SystemAllocator::free(MemTracker* mem_tracker, uint8_t* ptr, size_t length)
 }
 
 uint8_t* SystemAllocator::allocate_via_malloc(size_t length) {
+    if (length >= kHugePageSize) {
+        // the large chunks, e.g. the ones of the agg state pools, are backed by the huge pages
+        auto* ptr = (uint8_t*)huge_page_allocate(length);
+        if (ptr == nullptr) {
+            PLOG(ERROR) << "fail to allocate mem via huge_page_allocate, length=" << length;
+        }
+        return ptr;
+    }
     void* ptr = nullptr;
     // try to use a whole page instead of parts of one page
     int res = posix_memalign(&ptr, PAGE_SIZE, length);
@@ -38,34 +38,29 @@
 
 #include "column/chunk.h"
 #include "column/const_column.h"
+#include "column/nullable_column.h"
+#include "column/type_traits.h"
 #include "exprs/expr.h"
+#include "gutil/strings/fastmem.h"
 #include "runtime/buffer_control_block.h"
 #include "runtime/current_thread.h"
 #include "types/logical_type.h"
-#include "util/mysql_row_buffer.h"
+#include "util/raw_container.h"
 
 namespace starrocks {
 
 MysqlResultWriter::MysqlResultWriter(BufferControlBlock* sinker, const std::vector<ExprContext*>& output_expr_ctxs,
                                      RuntimeProfile* parent_profile)
-        : _sinker(sinker), _output_expr_ctxs(output_expr_ctxs), _row_buffer(nullptr), _parent_profile(parent_profile) {}
+        : _sinker(sinker), _output_expr_ctxs(output_expr_ctxs), _parent_profile(parent_profile) {}
 
-MysqlResultWriter::~MysqlResultWriter() {
-    delete _row_buffer;
-}
+MysqlResultWriter::~MysqlResultWriter() = default;
 
 Status MysqlResultWriter::init(RuntimeState* state) {
     _init_profile();
     if (nullptr == _sinker) {
         return Status::InternalError("sinker is NULL pointer.");
     }
-
-    _row_buffer = new (std::nothrow) MysqlRowBuffer();
-
-    if (nullptr == _row_buffer) {
-        return Status::InternalError("no memory to alloc.");
-    }
-
+    _column_cells.resize(_output_expr_ctxs.size());
     return Status::OK();
 }
 
@@ -108,98 +103,145 @@ Status MysqlResultWriter::close() {
     return Status::OK();
 }
 
-StatusOr<TFetchDataResultPtr> MysqlResultWriter::_process_chunk(Chunk* chunk) {
-    SCOPED_TIMER(_append_chunk_timer);
-    int num_rows = chunk->num_rows();
-    auto result = std::make_unique<TFetchDataResult>();
-    auto& result_rows = result->result_batch.rows;
-    result_rows.resize(num_rows);
-
-    Columns result_columns;
+Status MysqlResultWriter::_serialize_chunk(Chunk* chunk) {
+    const size_t num_rows = chunk->num_rows();
     // Step 1: compute expr
-    int num_columns = _output_expr_ctxs.size();
-    result_columns.reserve(num_columns);
-
-    for (int i = 0; i < num_columns; ++i) {
+    for (size_t i = 0; i < _output_expr_ctxs.size(); ++i) {
         ASSIGN_OR_RETURN(ColumnPtr column, _output_expr_ctxs[i]->evaluate(chunk));
-        column = _output_expr_ctxs[i]->root()->type().type == TYPE_TIME
-                         ? ColumnHelper::convert_time_column_from_double_to_str(column)
-                         : column;
-        result_columns.emplace_back(std::move(column));
+        const LogicalType type = _output_expr_ctxs[i]->root()->type().type;
+        column = type == TYPE_TIME ? ColumnHelper::convert_time_column_from_double_to_str(column) : column;
+        // Step 2: convert the column to mysql cells
+        SCOPED_TIMER(_convert_tuple_timer);
+        _serialize_column(column.get(), type, num_rows, &_column_cells[i]);
     }
+    return Status::OK();
+}
 
-    // Step 2: convert chunk to mysql row format row by row
-    {
-        _row_buffer->reserve(128);
-        SCOPED_TIMER(_convert_tuple_timer);
-        for (int i = 0; i < num_rows; ++i) {
-            DCHECK_EQ(0, _row_buffer->length());
-            for (auto& result_column : result_columns) {
-                result_column->put_mysql_row_buffer(_row_buffer, i);
-            }
-            size_t len = _row_buffer->length();
-            _row_buffer->move_content(&result_rows[i]);
-            _row_buffer->reserve(len * 1.1);
+void MysqlResultWriter::_serialize_column(const Column* column, LogicalType type, size_t num_rows,
+                                          ColumnCells* cells) {
+    cells->buffer.reset();
+    cells->offsets.clear();
+    cells->offsets.reserve(num_rows + 1);
+    cells->offsets.push_back(0);
+
+    const Column* data_column = column;
+    const uint8_t* nulls = nullptr;
+    if (column->is_nullable()) {
+        const auto* nullable_column = down_cast<const NullableColumn*>(column);
+        data_column = nullable_column->data_column().get();
+        nulls = nullable_column->has_null() ? nullable_column->null_column()->get_data().data() : nullptr;
+    }
+
+#define PUSH_NUMBER_COLUMN(LT)                                                                              \
+    case LT: {                                                                                              \
+        const auto* data = down_cast<const RunTimeColumnType<LT>*>(data_column)->get_data().data();         \
+        cells->buffer.push_number_column(data, nulls, num_rows, &cells->offsets);                           \
+        return;                                                                                             \
+    }
+
+    // The cells of the common types are serialized in a tight loop, others fall back to put_mysql_row_buffer.
+    if (data_column->is_binary()) {
+        const auto* binary_column = down_cast<const BinaryColumn*>(data_column);
+        cells->buffer.push_string_column(binary_column->get_bytes().data(), binary_column->get_offset().data(), nulls,
+                                         num_rows, &cells->offsets);
+        return;
+    } else if (data_column->is_large_binary()) {
+        const auto* binary_column = down_cast<const LargeBinaryColumn*>(data_column);
+        cells->buffer.push_string_column(binary_column->get_bytes().data(), binary_column->get_offset().data(), nulls,
+                                         num_rows, &cells->offsets);
+        return;
+    } else if (data_column->is_numeric()) {
+        switch (type) {
+            PUSH_NUMBER_COLUMN(TYPE_BOOLEAN)
+            PUSH_NUMBER_COLUMN(TYPE_TINYINT)
+            PUSH_NUMBER_COLUMN(TYPE_SMALLINT)
+            PUSH_NUMBER_COLUMN(TYPE_INT)
+            PUSH_NUMBER_COLUMN(TYPE_BIGINT)
+            PUSH_NUMBER_COLUMN(TYPE_LARGEINT)
+            PUSH_NUMBER_COLUMN(TYPE_FLOAT)
+            PUSH_NUMBER_COLUMN(TYPE_DOUBLE)
+        default:
+            break;
         }
     }
-    return result;
+#undef PUSH_NUMBER_COLUMN
+
+    for (size_t i = 0; i < num_rows; ++i) {
+        column->put_mysql_row_buffer(&cells->buffer, i);
+        cells->offsets.push_back(cells->buffer.length());
+    }
 }
 
-StatusOr<TFetchDataResultPtrs> MysqlResultWriter::process_chunk(Chunk* chunk) {
-    SCOPED_TIMER(_append_chunk_timer);
-    int num_rows = chunk->num_rows();
-    std::vector<TFetchDataResultPtr> results;
+size_t MysqlResultWriter::_row_length(size_t row) const {
+    size_t length = 0;
+    for (const auto& cells : _column_cells) {
+        length += cells.offsets[row + 1] - cells.offsets[row];
+    }
+    return length;
+}
 
-    Columns result_columns;
-    // Step 1: compute expr
-    int num_columns = _output_expr_ctxs.size();
-    result_columns.reserve(num_columns);
+void MysqlResultWriter::_copy_row(size_t row, size_t length, std::string* dst) const {
+    raw::stl_string_resize_uninitialized(dst, length);
+    char* pos = dst->data();
+    for (const auto& cells : _column_cells) {
+        const size_t size = cells.offsets[row + 1] - cells.offsets[row];
+        strings::memcpy_inlined(pos, cells.buffer.data().data() + cells.offsets[row], size);
+        pos += size;
+    }
+}
 
-    for (int i = 0; i < num_columns; ++i) {
-        ASSIGN_OR_RETURN(ColumnPtr column, _output_expr_ctxs[i]->evaluate(chunk));
-        column = _output_expr_ctxs[i]->root()->type().type == TYPE_TIME
-                         ? ColumnHelper::convert_time_column_from_double_to_str(column)
-                         : column;
-        result_columns.emplace_back(std::move(column));
+StatusOr<TFetchDataResultPtr> MysqlResultWriter::_process_chunk(Chunk* chunk) {
+    SCOPED_TIMER(_append_chunk_timer);
+    const size_t num_rows = chunk->num_rows();
+    RETURN_IF_ERROR(_serialize_chunk(chunk));
+
+    // Step 3: concatenate the cells into rows, every row is allocated exactly once
+    SCOPED_TIMER(_convert_tuple_timer);
+    auto result = std::make_unique<TFetchDataResult>();
+    auto& result_rows = result->result_batch.rows;
+    result_rows.resize(num_rows);
+    for (size_t i = 0; i < num_rows; ++i) {
+        _copy_row(i, _row_length(i), &result_rows[i]);
     }
+    return result;
+}
 
-    // Step 2: convert chunk to mysql row format row by row
+StatusOr<TFetchDataResultPtrs> MysqlResultWriter::process_chunk(Chunk* chunk) {
+    SCOPED_TIMER(_append_chunk_timer);
+    const size_t num_rows = chunk->num_rows();
+    std::vector<TFetchDataResultPtr> results;
     {
         TRY_CATCH_ALLOC_SCOPE_START()
-        _row_buffer->reserve(128);
-        size_t current_bytes = 0;
-        int current_rows = 0;
+        RETURN_IF_ERROR(_serialize_chunk(chunk));
+
+        // Step 3: concatenate the cells into rows, every row is allocated exactly once
         SCOPED_TIMER(_convert_tuple_timer);
+        size_t current_bytes = 0;
+        size_t current_rows = 0;
         auto result = std::make_unique<TFetchDataResult>();
-        auto& result_rows = result->result_batch.rows;
-        result_rows.resize(num_rows);
-
-        for (int i = 0; i < num_rows; ++i) {
-            DCHECK_EQ(0, _row_buffer->length());
-            for (auto& result_column : result_columns) {
-                result_column->put_mysql_row_buffer(_row_buffer, i);
-            }
-            size_t len = _row_buffer->length();
+        auto* result_rows = &result->result_batch.rows;
+        result_rows->resize(num_rows);
 
-            if (UNLIKELY(current_bytes + len >= _max_row_buffer_size)) {
-                result_rows.resize(current_rows);
+        for (size_t i = 0; i < num_rows; ++i) {
+            const size_t len = _row_length(i);
+            if (UNLIKELY(current_bytes + len >= _max_row_buffer_size && current_rows > 0)) {
+                result_rows->resize(current_rows);
                 results.emplace_back(std::move(result));
 
                 result = std::make_unique<TFetchDataResult>();
-                result_rows = result->result_batch.rows;
-                result_rows.resize(num_rows - i);
+                result_rows = &result->result_batch.rows;
+                result_rows->resize(num_rows - i);
 
                 current_bytes = 0;
                 current_rows = 0;
             }
-            _row_buffer->move_content(&result_rows[current_rows]);
-            _row_buffer->reserve(len * 1.1);
+            _copy_row(i, len, &(*result_rows)[current_rows]);
 
             current_bytes += len;
             current_rows += 1;
         }
         if (current_rows > 0) {
-            result_rows.resize(current_rows);
+            result_rows->resize(current_rows);
             results.emplace_back(std::move(result));
         }
         TRY_CATCH_ALLOC_SCOPE_END()
@@ -37,11 +37,11 @@
 #include "common/statusor.h"
 #include "runtime/result_writer.h"
 #include "runtime/runtime_state.h"
+#include "util/mysql_row_buffer.h"
 
 namespace starrocks {
 
 class ExprContext;
-class MysqlRowBuffer;
 class BufferControlBlock;
 class RuntimeProfile;
 using TFetchDataResultPtr = std::unique_ptr<TFetchDataResult>;
@@ -69,9 +69,22 @@ private:
     // this function is only used in non-pipeline engine
     StatusOr<TFetchDataResultPtr> _process_chunk(Chunk* chunk);
 
+    // The serialized cells of an output column, the cell of row i is buffer.data()[offsets[i], offsets[i + 1]).
+    struct ColumnCells {
+        MysqlRowBuffer buffer;
+        std::vector<size_t> offsets;
+    };
+
+    // Evaluate the output exprs of |chunk| and serialize them column by column into _column_cells.
+    Status _serialize_chunk(Chunk* chunk);
+    void _serialize_column(const Column* column, LogicalType type, size_t num_rows, ColumnCells* cells);
+    size_t _row_length(size_t row) const;
+    // Concatenate the cells of |row| into |dst|, |length| is the _row_length of it.
+    void _copy_row(size_t row, size_t length, std::string* dst) const;
+
     BufferControlBlock* _sinker;
     const std::vector<ExprContext*>& _output_expr_ctxs;
-    MysqlRowBuffer* _row_buffer;
+    std::vector<ColumnCells> _column_cells;
 
     RuntimeProfile* _parent_profile; // parent profile from result sink. not owned
     // total time cost on append chunk operation
@@ -0,0 +1,418 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "runtime/query_cpu_profiler.h"
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <fmt/format.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "runtime/current_thread.h"
+#include "runtime/exec_env.h"
+#include "util/bfd_parser.h"
+#include "util/hash_util.hpp"
+#include "util/runtime_profile.h"
+#include "util/thread.h"
+#include "util/time.h"
+
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+namespace google {
+int GetStackTrace(void** result, int max_depth, int skip_count);
+} // namespace google
+
+namespace starrocks {
+
+namespace {
+
+// The timer of the cpu time of a thread, deleted when the thread exits.
+struct ThreadCpuTimer {
+    timer_t timer_id;
+    bool created = false;
+    int64_t interval_ns = 0;
+
+    ~ThreadCpuTimer() {
+        if (created) {
+            timer_delete(timer_id);
+        }
+    }
+};
+
+thread_local ThreadCpuTimer tls_cpu_timer;
+
+// The sampling interval of the cpu time of the threads, 0 if the sampling is disabled.
+std::atomic<int64_t> s_sample_interval_ns{0};
+
+// SIGPROF is used by the pprof actions.
+int sample_signal() {
+    return SIGRTMIN + 5;
+}
+
+} // namespace
+
+QueryCpuProfiler* QueryCpuProfiler::instance() {
+    static QueryCpuProfiler profiler;
+    return &profiler;
+}
+
+Status QueryCpuProfiler::start() {
+    if (!_stopped.load()) {
+        return Status::OK();
+    }
+    if (_slots == nullptr) {
+        _slots = std::make_unique<Slot[]>(kRingBufferSize);
+        struct sigaction action;
+        memset(&action, 0, sizeof(action));
+        action.sa_sigaction = &QueryCpuProfiler::_signal_handler;
+        action.sa_flags = SA_SIGINFO | SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        if (sigaction(sample_signal(), &action, nullptr) != 0) {
+            return Status::InternalError(
+                    fmt::format("failed to install the cpu sampling handler: {}", std::strerror(errno)));
+        }
+    }
+    _stopped.store(false);
+    _thread = std::thread([this]() { _run(); });
+    Thread::set_thread_name(_thread, "query_cpu_prof");
+    return Status::OK();
+}
+
+void QueryCpuProfiler::stop() {
+    if (_stopped.exchange(true)) {
+        return;
+    }
+    s_sample_interval_ns.store(0);
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+void QueryCpuProfiler::register_current_thread() {
+    const int64_t interval_ns = s_sample_interval_ns.load(std::memory_order_relaxed);
+    ThreadCpuTimer& timer = tls_cpu_timer;
+    if (LIKELY(timer.interval_ns == interval_ns)) {
+        return;
+    }
+    // don't retry if failed to create the timer until the interval is changed
+    timer.interval_ns = interval_ns;
+    if (!timer.created) {
+        struct sigevent event;
+        memset(&event, 0, sizeof(event));
+        event.sigev_notify = SIGEV_THREAD_ID;
+        event.sigev_signo = sample_signal();
+        event.sigev_notify_thread_id = static_cast<pid_t>(syscall(SYS_gettid));
+        if (timer_create(CLOCK_THREAD_CPUTIME_ID, &event, &timer.timer_id) != 0) {
+            LOG_EVERY_N(WARNING, 1000) << "failed to create the cpu timer of the thread: " << std::strerror(errno);
+            return;
+        }
+        timer.created = true;
+    }
+    struct itimerspec spec;
+    spec.it_interval.tv_sec = interval_ns / 1000000000L;
+    spec.it_interval.tv_nsec = interval_ns % 1000000000L;
+    spec.it_value = spec.it_interval;
+    if (timer_settime(timer.timer_id, 0, &spec, nullptr) != 0) {
+        LOG_EVERY_N(WARNING, 1000) << "failed to arm the cpu timer of the thread: " << std::strerror(errno);
+    }
+}
+
+void QueryCpuProfiler::_signal_handler(int signo, siginfo_t* info, void* context) {
+    const int saved_errno = errno;
+    instance()->_capture();
+    errno = saved_errno;
+}
+
+void QueryCpuProfiler::_capture() {
+    if (_stopped.load(std::memory_order_relaxed) || !tls_is_thread_status_init) {
+        return;
+    }
+    CurrentThread& thread = tls_thread_status;
+    const TUniqueId& query_id = thread.query_id();
+    if (query_id.hi == 0 && query_id.lo == 0) {
+        return;
+    }
+
+    uint64_t pos = _write_pos.load(std::memory_order_relaxed);
+    do {
+        // the slot is still to be drained
+        if (pos - _read_pos.load(std::memory_order_acquire) >= kRingBufferSize) {
+            _num_dropped_samples.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    } while (!_write_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed));
+
+    Slot& slot = _slots[pos % kRingBufferSize];
+    Sample& sample = slot.sample;
+    sample.query_id_hi = query_id.hi;
+    sample.query_id_lo = query_id.lo;
+    const TUniqueId& fragment_instance_id = thread.fragment_instance_id();
+    sample.fragment_instance_id_hi = fragment_instance_id.hi;
+    sample.fragment_instance_id_lo = fragment_instance_id.lo;
+    sample.driver_id = thread.get_driver_id();
+    sample.plan_node_id = thread.operator_plan_node_id();
+    const std::string* operator_name = thread.operator_name();
+    size_t name_size = 0;
+    if (operator_name != nullptr) {
+        name_size = std::min<size_t>(operator_name->size(), kMaxOperatorNameSize - 1);
+        memcpy(sample.operator_name, operator_name->data(), name_size);
+    }
+    sample.operator_name[name_size] = '\0';
+    // skip the frames of _capture and the signal handler
+    sample.depth = google::GetStackTrace(sample.frames, kMaxDepth, 2);
+    slot.seq.store(pos + 1, std::memory_order_release);
+}
+
+void QueryCpuProfiler::_run() {
+    while (!_stopped.load()) {
+        const int32_t frequency = config::query_cpu_profiler_frequency;
+        s_sample_interval_ns.store(frequency > 0 ? 1000000000L / frequency : 0, std::memory_order_relaxed);
+        flush();
+        std::this_thread::sleep_for(std::chrono::milliseconds(kFlushIntervalMs));
+    }
+}
+
+void QueryCpuProfiler::flush() {
+    std::lock_guard l(_mutex);
+    _drain();
+    _evict_queries();
+}
+
+void QueryCpuProfiler::_drain() {
+    if (_slots == nullptr) {
+        return;
+    }
+    uint64_t read_pos = _read_pos.load(std::memory_order_relaxed);
+    const uint64_t write_pos = _write_pos.load(std::memory_order_acquire);
+    while (read_pos < write_pos) {
+        Slot& slot = _slots[read_pos % kRingBufferSize];
+        // the signal handler is still filling the slot
+        if (slot.seq.load(std::memory_order_acquire) != read_pos + 1) {
+            break;
+        }
+        _add_sample(slot.sample);
+        _read_pos.store(++read_pos, std::memory_order_release);
+    }
+}
+
+void QueryCpuProfiler::add_sample(const Sample& sample) {
+    std::lock_guard l(_mutex);
+    _add_sample(sample);
+    _evict_queries();
+}
+
+void QueryCpuProfiler::_add_sample(const Sample& sample) {
+    auto& query = _queries[UniqueId(sample.query_id_hi, sample.query_id_lo)];
+    query.num_samples++;
+    query.last_sample_time_ms = UnixMillis();
+    const UniqueId fragment_instance_id(sample.fragment_instance_id_hi, sample.fragment_instance_id_lo);
+    query.driver_samples[fragment_instance_id][sample.driver_id]++;
+
+    StackKey key{fragment_instance_id, sample.plan_node_id, std::string(sample.operator_name),
+                 std::vector<void*>(sample.frames, sample.frames + std::clamp(sample.depth, 0, kMaxDepth))};
+    auto iter = query.stacks.find(key);
+    if (iter != query.stacks.end()) {
+        iter->second++;
+        return;
+    }
+    if (query.stacks.size() >= std::max(config::query_cpu_profiler_max_stacks_per_query, 1)) {
+        // only counted for the operator
+        key.frames.clear();
+    }
+    query.stacks[std::move(key)]++;
+}
+
+void QueryCpuProfiler::_evict_queries() {
+    const size_t max_queries = std::max(config::query_cpu_profiler_max_queries, 1);
+    while (_queries.size() > max_queries) {
+        auto oldest = std::min_element(_queries.begin(), _queries.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.second.last_sample_time_ms < rhs.second.last_sample_time_ms;
+        });
+        _queries.erase(oldest);
+    }
+}
+
+size_t QueryCpuProfiler::StackKeyHash::operator()(const StackKey& key) const {
+    size_t seed = key.fragment_instance_id.hash();
+    HashUtil::hash_combine(seed, key.plan_node_id);
+    HashUtil::hash_combine(seed, key.operator_name);
+    for (void* frame : key.frames) {
+        HashUtil::hash_combine(seed, reinterpret_cast<uintptr_t>(frame));
+    }
+    return seed;
+}
+
+std::string QueryCpuProfiler::_operator_desc(const StackKey& key) {
+    if (key.plan_node_id < 0) {
+        return "[driver]";
+    }
+    return fmt::format("{}(plan_node_id={})", key.operator_name, key.plan_node_id);
+}
+
+std::string QueryCpuProfiler::_symbolize(void* frame) {
+    static constexpr size_t kMaxSymbols = 1 << 16;
+    auto iter = _symbols.find(frame);
+    if (iter != _symbols.end()) {
+        return iter->second;
+    }
+    if (_symbols.size() >= kMaxSymbols) {
+        _symbols.clear();
+    }
+    // the frames are the return addresses except the innermost one, look up the call instructions
+    auto* address = reinterpret_cast<char*>(frame) - 1;
+    std::string symbol;
+    BfdParser* parser = ExecEnv::GetInstance()->bfd_parser();
+    if (parser != nullptr) {
+        const std::string str = fmt::format("{}", static_cast<void*>(address));
+        const char* end = nullptr;
+        std::string file_name;
+        unsigned int lineno = 0;
+        if (parser->decode_address(str.c_str(), &end, &file_name, &symbol, &lineno) != 0) {
+            symbol.clear();
+        }
+    }
+    Dl_info info;
+    if (symbol.empty() && dladdr(address, &info) != 0 && info.dli_sname != nullptr) {
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        symbol = demangled != nullptr ? demangled : info.dli_sname;
+        free(demangled);
+    }
+    if (symbol.empty()) {
+        symbol = fmt::format("{}", frame);
+    }
+    // ';' separates the frames of the folded stacks
+    std::replace(symbol.begin(), symbol.end(), ';', ':');
+    return _symbols.emplace(frame, std::move(symbol)).first->second;
+}
+
+std::string QueryCpuProfiler::folded_stacks(const UniqueId& query_id, const UniqueId& fragment_instance_id) {
+    std::lock_guard l(_mutex);
+    _drain();
+    auto query_iter = _queries.find(query_id);
+    if (query_iter == _queries.end()) {
+        return "";
+    }
+    std::vector<std::pair<const StackKey*, int64_t>> stacks;
+    for (const auto& [key, num_samples] : query_iter->second.stacks) {
+        if (fragment_instance_id == UniqueId() || key.fragment_instance_id == fragment_instance_id) {
+            stacks.emplace_back(&key, num_samples);
+        }
+    }
+    std::sort(stacks.begin(), stacks.end(), [](const auto& lhs, const auto& rhs) { return lhs.second > rhs.second; });
+
+    std::string result;
+    for (const auto& [key, num_samples] : stacks) {
+        result.append(key->fragment_instance_id.to_string());
+        result.push_back(';');
+        result.append(_operator_desc(*key));
+        if (key->frames.empty()) {
+            result.append(";[too many stacks]");
+        }
+        for (auto iter = key->frames.rbegin(); iter != key->frames.rend(); ++iter) {
+            result.push_back(';');
+            result.append(_symbolize(*iter));
+        }
+        result.push_back(' ');
+        result.append(std::to_string(num_samples));
+        result.push_back('\n');
+    }
+    return result;
+}
+
+std::vector<QueryCpuProfiler::QuerySummary> QueryCpuProfiler::list_queries() {
+    std::lock_guard l(_mutex);
+    _drain();
+    std::vector<QuerySummary> summaries;
+    summaries.reserve(_queries.size());
+    for (const auto& [query_id, query] : _queries) {
+        summaries.push_back({query_id, query.num_samples, static_cast<int64_t>(query.stacks.size()),
+                             query.last_sample_time_ms});
+    }
+    std::sort(summaries.begin(), summaries.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.last_sample_time_ms > rhs.last_sample_time_ms;
+    });
+    return summaries;
+}
+
+void QueryCpuProfiler::attach_to_profile(const UniqueId& query_id, const UniqueId& fragment_instance_id,
+                                         RuntimeProfile* profile) {
+    static constexpr size_t kMaxOperators = 10;
+    std::vector<std::pair<std::string, int64_t>> operators;
+    int64_t num_samples = 0;
+    int32_t max_driver_id = 0;
+    int64_t max_driver_samples = 0;
+    size_t num_drivers = 0;
+    {
+        std::lock_guard l(_mutex);
+        _drain();
+        auto query_iter = _queries.find(query_id);
+        if (query_iter == _queries.end()) {
+            return;
+        }
+        const auto& query = query_iter->second;
+        std::map<std::string, int64_t> operator_samples;
+        for (const auto& [key, samples] : query.stacks) {
+            if (key.fragment_instance_id == fragment_instance_id) {
+                operator_samples[_operator_desc(key)] += samples;
+                num_samples += samples;
+            }
+        }
+        operators.assign(operator_samples.begin(), operator_samples.end());
+        if (auto iter = query.driver_samples.find(fragment_instance_id); iter != query.driver_samples.end()) {
+            num_drivers = iter->second.size();
+            for (const auto& [driver_id, samples] : iter->second) {
+                if (samples > max_driver_samples) {
+                    max_driver_id = driver_id;
+                    max_driver_samples = samples;
+                }
+            }
+        }
+    }
+    if (num_samples == 0) {
+        return;
+    }
+
+    std::sort(operators.begin(), operators.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs.second > rhs.second; });
+    operators.resize(std::min(operators.size(), kMaxOperators));
+    std::string operators_desc;
+    for (const auto& [desc, samples] : operators) {
+        if (!operators_desc.empty()) {
+            operators_desc.append(", ");
+        }
+        operators_desc.append(fmt::format("{}: {:.1f}%", desc, 100.0 * samples / num_samples));
+    }
+    auto* samples_counter = ADD_COUNTER(profile, "CpuSamples", TUnit::UNIT);
+    COUNTER_SET(samples_counter, num_samples);
+    profile->add_info_string("CpuSampledOperators", operators_desc);
+    profile->add_info_string("CpuSampledDrivers",
+                             fmt::format("drivers={}, avg={:.1f}, max={}(driver_id={})", num_drivers,
+                                         static_cast<double>(num_samples) / num_drivers, max_driver_samples,
+                                         max_driver_id));
+}
+
+} // namespace starrocks
@@ -0,0 +1,154 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <atomic>
+#include <csignal>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "common/status.h"
+#include "util/uid_util.h"
+
+namespace starrocks {
+
+class RuntimeProfile;
+
+// QueryCpuProfiler samples the stacks of the threads running queries, and aggregates the samples by the queries,
+// the fragment instances, the drivers and the operators running on the sampled threads, taken from CurrentThread.
+//
+// A thread registers itself when it's set to run a query, by arming a timer of its own cpu time, so only the
+// threads consuming cpu are interrupted. The signal handler captures the stack into a lock-free ring buffer, and a
+// background thread drains the ring buffer into the profiles of the latest config::query_cpu_profiler_max_queries
+// queries every kFlushIntervalMs.
+class QueryCpuProfiler {
+public:
+    static constexpr int kMaxDepth = 32;
+    static constexpr int kMaxOperatorNameSize = 32;
+    static constexpr size_t kRingBufferSize = 8192;
+    static constexpr int64_t kFlushIntervalMs = 100;
+
+    struct Sample {
+        int64_t query_id_hi = 0;
+        int64_t query_id_lo = 0;
+        int64_t fragment_instance_id_hi = 0;
+        int64_t fragment_instance_id_lo = 0;
+        int32_t driver_id = 0;
+        // -1 if the thread isn't running an operator, e.g. the driver is scheduled
+        int32_t plan_node_id = -1;
+        char operator_name[kMaxOperatorNameSize] = {};
+        int32_t depth = 0;
+        // the innermost frame first
+        void* frames[kMaxDepth];
+    };
+
+    static QueryCpuProfiler* instance();
+
+    // Install the signal handler and start the background thread.
+    Status start();
+    void stop();
+
+    // Arm the cpu timer of the current thread by config::query_cpu_profiler_frequency, it's cheap if it's armed.
+    static void register_current_thread();
+
+    // Drain the ring buffer into the profiles of the queries.
+    void flush();
+
+    // Aggregate a sample into the profile of its query, visible for test.
+    void add_sample(const Sample& sample);
+
+    // The sampled stacks of the query in the folded format of flame graphs, one stack per line from the outermost
+    // frame: "<fragment instance>;<operator>;<frame>;...;<frame> <samples>", of the fragment instance if
+    // |fragment_instance_id| isn't empty. Return an empty string if the query isn't sampled.
+    std::string folded_stacks(const UniqueId& query_id, const UniqueId& fragment_instance_id = {});
+
+    struct QuerySummary {
+        UniqueId query_id;
+        int64_t num_samples = 0;
+        int64_t num_stacks = 0;
+        int64_t last_sample_time_ms = 0;
+    };
+    std::vector<QuerySummary> list_queries();
+
+    // Add the samples of the fragment instance by the operators and drivers to |profile|.
+    void attach_to_profile(const UniqueId& query_id, const UniqueId& fragment_instance_id, RuntimeProfile* profile);
+
+    int64_t num_dropped_samples() const { return _num_dropped_samples.load(std::memory_order_relaxed); }
+
+private:
+    struct StackKey {
+        UniqueId fragment_instance_id;
+        int32_t plan_node_id;
+        std::string operator_name;
+        // empty if the query has too many stacks
+        std::vector<void*> frames;
+
+        bool operator==(const StackKey& rhs) const {
+            return fragment_instance_id == rhs.fragment_instance_id && plan_node_id == rhs.plan_node_id &&
+                   operator_name == rhs.operator_name && frames == rhs.frames;
+        }
+    };
+    struct StackKeyHash {
+        size_t operator()(const StackKey& key) const;
+    };
+    struct QueryProfile {
+        int64_t num_samples = 0;
+        int64_t last_sample_time_ms = 0;
+        std::unordered_map<StackKey, int64_t, StackKeyHash> stacks;
+        // the samples of every driver of every fragment instance
+        std::map<UniqueId, std::map<int32_t, int64_t>> driver_samples;
+    };
+    struct Slot {
+        // the position + 1 of the sample it holds once filled
+        std::atomic<uint64_t> seq{0};
+        Sample sample;
+    };
+
+    QueryCpuProfiler() = default;
+    ~QueryCpuProfiler() = default;
+
+    static void _signal_handler(int signo, siginfo_t* info, void* context);
+    // Capture the sample of the current thread into the ring buffer, it's async-signal-safe.
+    void _capture();
+    void _run();
+    // Drain the ring buffer with _mutex held.
+    void _drain();
+    void _add_sample(const Sample& sample);
+    void _evict_queries();
+    std::string _symbolize(void* frame);
+    static std::string _operator_desc(const StackKey& key);
+
+    std::thread _thread;
+    std::atomic<bool> _stopped{true};
+
+    // the ring buffer written by the signal handlers and read by flush
+    std::unique_ptr<Slot[]> _slots;
+    std::atomic<uint64_t> _write_pos{0};
+    std::atomic<uint64_t> _read_pos{0};
+    std::atomic<int64_t> _num_dropped_samples{0};
+
+    std::mutex _mutex;
+    std::unordered_map<UniqueId, QueryProfile> _queries;
+    // the symbols of the frames, cleared once too large
+    std::unordered_map<void*, std::string> _symbols;
+};
+
+} // namespace starrocks
@@ -38,6 +38,7 @@
 
 #include "common/config.h"
 #include "exprs/expr.h"
+#include "runtime/arrow_result_writer.h"
 #include "runtime/buffer_control_block.h"
 #include "runtime/current_thread.h"
 #include "runtime/exec_env.h"
@@ -106,6 +107,9 @@ Status ResultSink::prepare(RuntimeState* state) {
     case TResultSinkType::VARIABLE:
         _writer.reset(new (std::nothrow) VariableResultWriter(_sender.get(), _output_expr_ctxs, _profile));
         break;
+    case TResultSinkType::ARROW:
+        _writer.reset(new (std::nothrow) ArrowResultWriter(_sender.get(), _output_expr_ctxs, _profile));
+        break;
     default:
         return Status::InternalError("Unknown result sink type");
     }
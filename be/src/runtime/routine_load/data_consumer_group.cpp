@@ -33,6 +33,7 @@
 // under the License.
 #include "runtime/routine_load/data_consumer_group.h"
 
+#include "common/config.h"
 #include "librdkafka/rdkafka.h"
 #include "librdkafka/rdkafkacpp.h"
 #include "runtime/routine_load/data_consumer.h"
@@ -237,6 +238,10 @@ Status KafkaDataConsumerGroup::start_all(StreamLoadContext* ctx) {
                     cmt_offset[msg->partition()] = msg->offset() - 1;
                 }
             } else {
+                // the message may be released by the pipe once appended
+                const int32_t partition = msg->partition();
+                const int64_t offset = msg->offset();
+                const size_t len = msg->len();
                 Status st = Status::OK();
                 if (ctx->format == TFileFormatType::FORMAT_AVRO) {
                     avro_value_t avro;
@@ -255,15 +260,20 @@ Status KafkaDataConsumerGroup::start_all(StreamLoadContext* ctx) {
                     }
                     st = (kafka_pipe.get()->*append_data)(as_json, strlen(as_json), row_delimiter);
                     free(as_json);
+                } else if (append_data == &KafkaConsumerPipe::append_with_row_delimiter &&
+                           len >= config::routine_load_kafka_zero_copy_min_bytes) {
+                    st = kafka_pipe->append_message_with_row_delimiter(std::unique_ptr<RdKafka::Message>(msg),
+                                                                       row_delimiter);
+                    msg = nullptr;
                 } else {
                     st = (kafka_pipe.get()->*append_data)(static_cast<const char*>(msg->payload()),
                                                           static_cast<size_t>(msg->len()), row_delimiter);
                 }
                 if (st.ok()) {
                     received_rows++;
-                    left_bytes -= msg->len();
-                    cmt_offset[msg->partition()] = msg->offset();
-                    VLOG(3) << "consume partition[" << msg->partition() << " - " << msg->offset() << "]";
+                    left_bytes -= len;
+                    cmt_offset[partition] = offset;
+                    VLOG(3) << "consume partition[" << partition << " - " << offset << "]";
                 } else {
                     // failed to append this msg, we must stop
                     LOG(WARNING) << "failed to append msg to pipe. grp: " << _grp_id
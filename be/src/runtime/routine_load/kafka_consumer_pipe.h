@@ -40,6 +40,7 @@
 #include <vector>
 
 #include "librdkafka/rdkafka.h"
+#include "librdkafka/rdkafkacpp.h"
 #include "pulsar/Client.h"
 #include "runtime/message_body_sink.h"
 #include "runtime/stream_load/stream_load_pipe.h"
@@ -65,6 +66,17 @@ public:
         return st;
     }
 
+    // Append the payload of |msg| followed by the row delimiter, the payload is referenced without copying and |msg|
+    // is released once the payload is read. It's only worth it for large messages, the small ones are cheaper to be
+    // copied into the chunks.
+    Status append_message_with_row_delimiter(std::unique_ptr<RdKafka::Message> msg, char row_delimiter) {
+        RETURN_IF_ERROR(_flush_write_buf());
+        auto* data = static_cast<char*>(msg->payload());
+        size_t size = msg->len();
+        RETURN_IF_ERROR(append(ByteBuffer::wrap(data, size, [msg = msg.release()]() { delete msg; })));
+        return append(&row_delimiter, 1);
+    }
+
     Status append_json(const char* data, size_t size, char row_delimiter) {
         // For efficiency reasons, simdjson requires a string with a few bytes (simdjson::SIMDJSON_PADDING) at the end.
         auto buf = ByteBuffer::allocate(size + simdjson::SIMDJSON_PADDING);
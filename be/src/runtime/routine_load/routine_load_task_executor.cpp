@@ -34,6 +34,7 @@
 
 #include "runtime/routine_load/routine_load_task_executor.h"
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <thread>
@@ -328,6 +329,11 @@ void RoutineLoadTaskExecutor::exec_task(StreamLoadContext* ctx, DataConsumerPool
     switch (ctx->load_src_type) {
     case TLoadSourceType::KAFKA: {
         pipe = std::make_shared<KafkaConsumerPipe>();
+        if (ctx->format == TFileFormatType::FORMAT_CSV_PLAIN) {
+            // the messages of different partitions are parsed by several scanners in parallel
+            int num_partitions = static_cast<int>(ctx->kafka_info->begin_offset.size());
+            pipe->set_num_parsers(std::max(1, std::min(config::routine_load_kafka_parse_dop, num_partitions)));
+        }
         Status st = std::static_pointer_cast<KafkaDataConsumerGroup>(consumer_grp)->assign_topic_partitions(ctx);
         if (!st.ok()) {
             err_handler(ctx, st, st.get_error_msg());
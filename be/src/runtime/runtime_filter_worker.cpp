@@ -200,6 +200,9 @@ RuntimeFilterMerger::RuntimeFilterMerger(ExecEnv* env, const UniqueId& query_id,
 
 Status RuntimeFilterMerger::init(const TRuntimeFilterParams& params) {
     _targets = params.id_to_prober_params;
+    if (params.__isset.id_to_upstream_merge_nodes) {
+        _upstream_merge_nodes = params.id_to_upstream_merge_nodes;
+    }
     for (const auto& it : params.runtime_filter_builder_number) {
         int32_t filter_id = it.first;
         RuntimeFilterMergerStatus status;
@@ -220,14 +223,19 @@ void RuntimeFilterMerger::merge_runtime_filter(PTransmitRuntimeFilterParams& par
     DCHECK(params.is_partial());
     int32_t filter_id = params.filter_id();
     int32_t be_number = params.build_be_number();
+    std::vector<int32_t> be_numbers(params.build_be_numbers().begin(), params.build_be_numbers().end());
+    if (be_numbers.empty()) {
+        be_numbers.emplace_back(be_number);
+    }
+    DCHECK_EQ(be_number, be_numbers[0]);
 
-    std::vector<TRuntimeFilterProberParams>* target_nodes = nullptr;
+    // the intermediate merger sends the merged rf to the upstream merge nodes rather than the consumers.
+    bool is_intermediate = _upstream_merge_nodes.count(filter_id) > 0;
     // check if there is no consumer.
-    {
+    if (!is_intermediate) {
         auto it = _targets.find(filter_id);
         if (it == _targets.end()) return;
-        target_nodes = &(it->second);
-        if (target_nodes->size() == 0) return;
+        if (it->second.size() == 0) return;
     }
 
     RuntimeFilterMergerStatus* status = nullptr;
@@ -235,11 +243,13 @@ void RuntimeFilterMerger::merge_runtime_filter(PTransmitRuntimeFilterParams& par
         auto it = _statuses.find(filter_id);
         if (it == _statuses.end()) return;
         status = &(it->second);
-        if (status->arrives.find(be_number) != status->arrives.end()) {
-            // duplicated one, just skip it.
-            VLOG_FILE << "RuntimeFilterMerger::merge_runtime_filter. duplicated filter_id = " << filter_id
-                      << ", be_number = " << be_number;
-            return;
+        for (int32_t num : be_numbers) {
+            if (status->arrives.find(num) != status->arrives.end()) {
+                // duplicated one, just skip it.
+                VLOG_FILE << "RuntimeFilterMerger::merge_runtime_filter. duplicated filter_id = " << filter_id
+                          << ", be_number = " << num;
+                return;
+            }
         }
         if (status->stop) {
             return;
@@ -275,12 +285,86 @@ void RuntimeFilterMerger::merge_runtime_filter(PTransmitRuntimeFilterParams& par
 
     VLOG_FILE << "RuntimeFilterMerger::merge_runtime_filter. assembled filter_id = " << filter_id
               << ", be_number = " << be_number;
-    status->arrives.insert(be_number);
+    status->arrives.insert(be_numbers.begin(), be_numbers.end());
     status->filters.insert(std::make_pair(be_number, rf));
+    status->merged_be_numbers.insert(std::make_pair(be_number, std::move(be_numbers)));
 
     // not ready. still have to wait more filters.
-    if (status->filters.size() < status->expect_number) return;
-    _send_total_runtime_filter(filter_id, rpc_closure);
+    if (status->arrives.size() < status->expect_number) return;
+    if (is_intermediate) {
+        _send_upstream_runtime_filter(filter_id, rpc_closure);
+    } else {
+        _send_total_runtime_filter(filter_id, rpc_closure);
+    }
+}
+
+JoinRuntimeFilter* RuntimeFilterMerger::_concat_runtime_filters(int32_t filter_id, RuntimeFilterMergerStatus* status,
+                                                                std::vector<int32_t>* be_numbers) {
+    // the partitions of the concatenated rf must be in the order of be numbers, so the ranges of be numbers
+    // merged by the intermediate merge nodes can't interleave.
+    for (const auto& [_, nums] : status->merged_be_numbers) {
+        if (!be_numbers->empty() && be_numbers->back() >= nums.front()) {
+            LOG(WARNING) << "RuntimeFilterMerger: be numbers of the partitioned runtime filters interleave, "
+                         << "query_id = " << _query_id << ", filter_id = " << filter_id;
+            return nullptr;
+        }
+        be_numbers->insert(be_numbers->end(), nums.begin(), nums.end());
+    }
+
+    JoinRuntimeFilter* first = status->filters.begin()->second;
+    JoinRuntimeFilter* out = first->create_empty(&(status->pool));
+    for (auto it : status->filters) {
+        out->concat(it.second);
+    }
+    return out;
+}
+
+void RuntimeFilterMerger::_send_upstream_runtime_filter(int32_t filter_id, RuntimeFilterRpcClosure* rpc_closure) {
+    auto status_it = _statuses.find(filter_id);
+    DCHECK(status_it != _statuses.end());
+    RuntimeFilterMergerStatus* status = &(status_it->second);
+    ObjectPool* pool = &(status->pool);
+    DeferOp clear_pool([&]() { pool->clear(); });
+
+    std::vector<int32_t> be_numbers;
+    JoinRuntimeFilter* out = _concat_runtime_filters(filter_id, status, &be_numbers);
+    if (out == nullptr) {
+        status->stop = true;
+        return;
+    }
+
+    PTransmitRuntimeFilterParams request;
+    if (_is_pipeline) {
+        request.set_is_pipeline(true);
+    }
+    request.set_filter_id(filter_id);
+    request.set_is_partial(true);
+    PUniqueId* query_id = request.mutable_query_id();
+    query_id->set_hi(_query_id.hi);
+    query_id->set_lo(_query_id.lo);
+    request.set_build_be_number(be_numbers[0]);
+    for (int32_t num : be_numbers) {
+        request.add_build_be_numbers(num);
+    }
+
+    std::string* send_data = request.mutable_data();
+    send_data->resize(RuntimeFilterHelper::max_runtime_filter_serialized_size(out));
+    size_t actual_size =
+            RuntimeFilterHelper::serialize_runtime_filter(out, reinterpret_cast<uint8_t*>(send_data->data()));
+    send_data->resize(actual_size);
+    int timeout_ms = config::send_rpc_runtime_filter_timeout_ms;
+    if (_query_options.__isset.runtime_filter_send_timeout_ms) {
+        timeout_ms = _query_options.runtime_filter_send_timeout_ms;
+    }
+
+    VLOG_FILE << "RuntimeFilterMerger::merge_runtime_filter. send merged partitioned rf to upstream, filter_id = "
+              << filter_id << ", be_numbers = " << be_numbers.size()
+              << ", latency(last-first = " << status->recv_last_filter_ts - status->recv_first_filter_ts << ")";
+    for (const auto& addr : _upstream_merge_nodes[filter_id]) {
+        doris::PBackendService_Stub* stub = _exec_env->brpc_stub_cache()->get_stub(addr);
+        _exec_env->add_rf_event({request.query_id(), request.filter_id(), addr.hostname, "SEND_MERGED_PART_RF_RPC"});
+        send_rpc_runtime_filter(stub, rpc_closure, timeout_ms, request);
+    }
 }
 
 void RuntimeFilterMerger::_send_total_runtime_filter(int32_t filter_id, RuntimeFilterRpcClosure* rpc_closure) {
@@ -291,12 +375,13 @@ void RuntimeFilterMerger::_send_total_runtime_filter(int32_t filter_id, RuntimeF
     DCHECK(target_it != _targets.end());
     std::vector<TRuntimeFilterProberParams>* target_nodes = &(target_it->second);
 
-    JoinRuntimeFilter* out = nullptr;
-    JoinRuntimeFilter* first = status->filters.begin()->second;
     ObjectPool* pool = &(status->pool);
-    out = first->create_empty(pool);
-    for (auto it : status->filters) {
-        out->concat(it.second);
+    std::vector<int32_t> be_numbers;
+    JoinRuntimeFilter* out = _concat_runtime_filters(filter_id, status, &be_numbers);
+    if (out == nullptr) {
+        status->stop = true;
+        pool->clear();
+        return;
     }
     // if well enough, then we send it out.
 
@@ -63,6 +63,7 @@ public:
               expect_number(other.expect_number),
               pool(std::move(other.pool)),
               filters(std::move(other.filters)),
+              merged_be_numbers(std::move(other.merged_be_numbers)),
               current_size(other.current_size),
               max_size(other.max_size),
               stop(other.stop),
@@ -74,8 +75,10 @@ public:
     // how many partitioned rf we expect
     int32_t expect_number;
     ObjectPool pool;
-    // each partitioned rf.
+    // each partitioned rf, keyed by the first be number of it.
     std::map<int32_t, JoinRuntimeFilter*> filters;
+    // the be numbers of each partitioned rf, more than one if it's merged by an intermediate merge node.
+    std::map<int32_t, std::vector<int32_t>> merged_be_numbers;
     size_t current_size = 0;
     size_t max_size = 0;
     bool stop = false;
@@ -90,6 +93,9 @@ public:
 
 // RuntimeFilterMerger is to merge partitioned RF
 // and sent merged RF to consumer nodes.
+//
+// With the tree-based merging, an intermediate merger merges the partitioned RFs of a range of builders, and
+// sends the merged one to the upstream merge nodes as a partitioned RF, so the root merger receives far fewer RFs.
 class RuntimeFilterMerger {
 public:
     RuntimeFilterMerger(ExecEnv* env, const UniqueId& query_id, const TQueryOptions& query_options, bool is_pipeline);
@@ -97,9 +103,16 @@ public:
     void merge_runtime_filter(PTransmitRuntimeFilterParams& params, RuntimeFilterRpcClosure* rpc_closure);
 
 private:
+    // Concatenate the received partitioned RFs in the order of be numbers into a RF allocated in status->pool,
+    // and fill the be numbers of it into |be_numbers|, return nullptr if the be numbers of the RFs interleave.
+    JoinRuntimeFilter* _concat_runtime_filters(int32_t filter_id, RuntimeFilterMergerStatus* status,
+                                               std::vector<int32_t>* be_numbers);
     void _send_total_runtime_filter(int32_t filter_id, RuntimeFilterRpcClosure* rpc_closure);
+    void _send_upstream_runtime_filter(int32_t filter_id, RuntimeFilterRpcClosure* rpc_closure);
     // filter_id -> where this filter should send to
     std::map<int32_t, std::vector<TRuntimeFilterProberParams>> _targets;
+    // filter_id -> where the merged partitioned RF should send to, only for the intermediate merger.
+    std::map<int32_t, std::vector<TNetworkAddress>> _upstream_merge_nodes;
     std::map<int32_t, RuntimeFilterMergerStatus> _statuses;
     ExecEnv* _exec_env;
     UniqueId _query_id;
@@ -361,6 +361,12 @@ int64_t RuntimeState::get_load_mem_limit() const {
     return 0;
 }
 
+const TimezoneTransitions& RuntimeState::timezone_transitions() {
+    std::call_once(_timezone_transitions_once,
+                   [this]() { _timezone_transitions = std::make_unique<TimezoneTransitions>(_timezone_obj); });
+    return *_timezone_transitions;
+}
+
 const GlobalDictMaps& RuntimeState::get_query_global_dict_map() const {
     return _query_global_dicts;
 }
@@ -37,6 +37,7 @@
 #include <atomic>
 #include <fstream>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <unordered_map>
@@ -55,6 +56,7 @@
 #include "runtime/mem_tracker.h"
 #include "util/logging.h"
 #include "util/runtime_profile.h"
+#include "util/timezone_transitions.h"
 
 namespace starrocks {
 
@@ -123,6 +125,8 @@ public:
     int64_t timestamp_ms() const { return _timestamp_ms; }
     const std::string& timezone() const { return _timezone; }
     const cctz::time_zone& timezone_obj() const { return _timezone_obj; }
+    // The UTC offsets of the session time zone, precomputed on the first call.
+    const TimezoneTransitions& timezone_transitions();
     const std::string& user() const { return _user; }
     const std::vector<std::string>& error_log() const { return _error_log; }
     const std::string& last_query_id() const { return _last_query_id; }
@@ -343,6 +347,14 @@ public:
 
     Status reset_epoch();
 
+    // Count the exprs of the same fingerprint in this fragment instance, to find the results worth reusing.
+    // Only called when the exprs are created, before they're prepared.
+    void add_expr_fingerprint(uint64_t fingerprint) { _expr_fingerprints[fingerprint]++; }
+    size_t num_exprs_of_fingerprint(uint64_t fingerprint) const {
+        auto iter = _expr_fingerprints.find(fingerprint);
+        return iter == _expr_fingerprints.end() ? 0 : iter->second;
+    }
+
 private:
     // Set per-query state.
     void _init(const TUniqueId& fragment_instance_id, const TQueryOptions& query_options,
@@ -377,6 +389,8 @@ private:
     int64_t _timestamp_ms = 0;
     std::string _timezone;
     cctz::time_zone _timezone_obj;
+    std::once_flag _timezone_transitions_once;
+    std::unique_ptr<TimezoneTransitions> _timezone_transitions;
 
     std::string _last_query_id;
     TUniqueId _query_id;
@@ -384,6 +398,8 @@ private:
     TQueryOptions _query_options;
     ExecEnv* _exec_env = nullptr;
 
+    std::unordered_map<uint64_t, size_t> _expr_fingerprints;
+
     // MemTracker that is shared by all fragment instances running on this host.
     // The query mem tracker must be released after the _instance_mem_tracker.
     std::shared_ptr<MemTracker> _query_mem_tracker;
@@ -14,6 +14,8 @@
 
 #include "runtime/sender_queue.h"
 
+#include <fmt/format.h>
+
 #include "column/chunk.h"
 #include "gen_cpp/data.pb.h"
 #include "gen_cpp/internal_service.pb.h"
@@ -536,23 +538,27 @@ void DataStreamRecvr::PipelineSenderQueue::close() {
     cancel();
 }
 
+void DataStreamRecvr::PipelineSenderQueue::drain_chunk_queue(size_t index) {
+    auto& chunk_queue = _chunk_queues[index];
+    auto& chunk_queue_state = _chunk_queue_states[index];
+    ChunkItem item;
+    while (chunk_queue.size_approx() > 0) {
+        if (chunk_queue.try_dequeue(item)) {
+            if (item.closure != nullptr) {
+                _recvr->_closure_block_timer->update(MonotonicNanos() - item.queue_enter_time);
+                item.closure->Run();
+                chunk_queue_state.blocked_closure_num--;
+            }
+            --_total_chunks;
+            _recvr->_num_buffered_bytes -= item.chunk_bytes;
+        }
+    }
+}
+
 void DataStreamRecvr::PipelineSenderQueue::clean_buffer_queues() {
     std::lock_guard<Mutex> l(_lock);
     for (size_t i = 0; i < _chunk_queues.size(); i++) {
-        auto& chunk_queue = _chunk_queues[i];
-        auto& chunk_queue_state = _chunk_queue_states[i];
-        ChunkItem item;
-        while (chunk_queue.size_approx() > 0) {
-            if (chunk_queue.try_dequeue(item)) {
-                if (item.closure != nullptr) {
-                    _recvr->_closure_block_timer->update(MonotonicNanos() - item.queue_enter_time);
-                    item.closure->Run();
-                    chunk_queue_state.blocked_closure_num--;
-                }
-                --_total_chunks;
-                _recvr->_num_buffered_bytes -= item.chunk_bytes;
-            }
-        }
+        drain_chunk_queue(i);
     }
 
     for (auto& [_, chunk_queues] : _buffered_chunk_queues) {
@@ -568,6 +574,9 @@ void DataStreamRecvr::PipelineSenderQueue::clean_buffer_queues() {
 }
 
 Status DataStreamRecvr::PipelineSenderQueue::try_to_build_chunk_meta(const PTransmitChunkParams& request) {
+    if (_chunk_meta_built.load(std::memory_order_acquire) || request.use_pass_through()) {
+        return Status::OK();
+    }
     ScopedTimer<MonotonicStopWatch> wait_timer(_recvr->_sender_wait_lock_timer);
     std::lock_guard<Mutex> l(_lock);
     wait_timer.stop();
@@ -577,8 +586,9 @@ Status DataStreamRecvr::PipelineSenderQueue::try_to_build_chunk_meta(const PTran
     if (_chunk_meta.types.empty() && !request.use_pass_through()) {
         SCOPED_TIMER(_recvr->_deserialize_chunk_timer);
         auto& pchunk = request.chunks(0);
-        return _build_chunk_meta(pchunk);
+        RETURN_IF_ERROR(_build_chunk_meta(pchunk));
     }
+    _chunk_meta_built.store(true, std::memory_order_release);
     return Status::OK();
 }
 
@@ -613,7 +623,16 @@ StatusOr<DataStreamRecvr::PipelineSenderQueue::ChunkList> DataStreamRecvr::Pipel
         auto& pchunk = request.chunks().Get(i);
         int32_t driver_sequence = _is_pipeline_level_shuffle ? request.driver_sequences(i) : -1;
         int64_t chunk_bytes = pchunk.data().size();
-        if constexpr (need_deserialization) {
+        if (_is_pipeline_level_shuffle && driver_sequence < 0) {
+            // the rows of the chunk belong to different drivers, the chunk has to be deserialized to be split
+            ChunkUniquePtr chunk = std::make_unique<Chunk>();
+            RETURN_IF_ERROR(_deserialize_chunk(pchunk, chunk.get(), &uncompressed_buffer));
+            if (UNLIKELY(i >= request.row_driver_sequences_size())) {
+                return Status::InternalError("missing the row driver sequences of the chunk");
+            }
+            RETURN_IF_ERROR(split_chunk_by_drivers(std::move(chunk), chunk_bytes, request.row_driver_sequences(i),
+                                                   &chunks));
+        } else if constexpr (need_deserialization) {
             ChunkUniquePtr chunk = std::make_unique<Chunk>();
             RETURN_IF_ERROR(_deserialize_chunk(pchunk, chunk.get(), &uncompressed_buffer));
             chunks.emplace_back(chunk_bytes, driver_sequence, nullptr, std::move(chunk));
@@ -625,6 +644,46 @@ StatusOr<DataStreamRecvr::PipelineSenderQueue::ChunkList> DataStreamRecvr::Pipel
     return chunks;
 }
 
+Status DataStreamRecvr::PipelineSenderQueue::split_chunk_by_drivers(ChunkUniquePtr chunk, int64_t chunk_bytes,
+                                                                   const std::string& row_driver_sequences,
+                                                                   ChunkList* chunks) {
+    const size_t num_rows = chunk->num_rows();
+    if (row_driver_sequences.size() != num_rows * sizeof(uint16_t)) {
+        return Status::InternalError(fmt::format("mismatched row driver sequences, rows={} bytes={}", num_rows,
+                                                 row_driver_sequences.size()));
+    }
+    const auto* sequences = reinterpret_cast<const uint16_t*>(row_driver_sequences.data());
+    std::vector<std::vector<uint32_t>> driver_rows(_chunk_queues.size());
+    for (uint32_t i = 0; i < num_rows; i++) {
+        if (UNLIKELY(sequences[i] >= driver_rows.size())) {
+            return Status::InternalError(fmt::format("invalid driver sequence {}, dop={}", sequences[i],
+                                                     driver_rows.size()));
+        }
+        driver_rows[sequences[i]].emplace_back(i);
+    }
+
+    // the bytes of the parts are estimated by their rows, and they sum up to chunk_bytes
+    int64_t remaining_bytes = chunk_bytes;
+    size_t remaining_rows = num_rows;
+    for (int32_t driver_sequence = 0; driver_sequence < driver_rows.size(); driver_sequence++) {
+        const auto& rows = driver_rows[driver_sequence];
+        if (rows.empty()) {
+            continue;
+        }
+        int64_t part_bytes = remaining_bytes * rows.size() / remaining_rows;
+        remaining_bytes -= part_bytes;
+        remaining_rows -= rows.size();
+        if (rows.size() == num_rows) {
+            chunks->emplace_back(part_bytes, driver_sequence, nullptr, std::move(chunk));
+            break;
+        }
+        ChunkUniquePtr part = chunk->clone_empty_with_slot(rows.size());
+        part->append_selective(*chunk, rows.data(), 0, rows.size());
+        chunks->emplace_back(part_bytes, driver_sequence, nullptr, std::move(part));
+    }
+    return Status::OK();
+}
+
 template <bool keep_order>
 Status DataStreamRecvr::PipelineSenderQueue::add_chunks(const PTransmitChunkParams& request,
                                                         ::google::protobuf::Closure** done) {
@@ -711,16 +770,15 @@ Status DataStreamRecvr::PipelineSenderQueue::add_chunks(const PTransmitChunkPara
             ++max_processed_sequence;
         }
     } else {
-        // remove the short-circuited chunks
-        ScopedTimer<MonotonicStopWatch> wait_timer(_recvr->_sender_wait_lock_timer);
-        std::lock_guard<Mutex> l(_lock);
-        wait_timer.stop();
-
+        // The chunks are enqueued without lock to avoid the contention among the brpc threads. short_circuit() and
+        // cancel() drain the queues after setting their flags, and the flags are checked again after enqueueing,
+        // so no chunk, especially the one holding the closure, is left in a short-circuited or cancelled queue.
         if (_is_cancelled) {
             LOG(ERROR) << "Cancelled receiver cannot add_chunk!";
             return Status::OK();
         }
 
+        // remove the short-circuited chunks
         for (auto iter = chunks.begin(); iter != chunks.end();) {
             if (_is_pipeline_level_shuffle && _chunk_queue_states[iter->driver_sequence].is_short_circuited) {
                 total_chunk_bytes -= iter->chunk_bytes;
@@ -737,12 +795,15 @@ Status DataStreamRecvr::PipelineSenderQueue::add_chunks(const PTransmitChunkPara
         }
         for (auto& chunk : chunks) {
             int index = _is_pipeline_level_shuffle ? chunk.driver_sequence : 0;
-            size_t chunk_bytes = chunk.chunk_bytes;
-            auto* closure = chunk.closure;
-            _chunk_queues[index].enqueue(std::move(chunk));
-            _chunk_queue_states[index].blocked_closure_num += closure != nullptr;
+            auto& chunk_queue_state = _chunk_queue_states[index];
+            // count the chunk before it's visible to the consumers, which decrease the counters
+            chunk_queue_state.blocked_closure_num += chunk.closure != nullptr;
             _total_chunks++;
-            _recvr->_num_buffered_bytes += chunk_bytes;
+            _recvr->_num_buffered_bytes += chunk.chunk_bytes;
+            _chunk_queues[index].enqueue(std::move(chunk));
+            if (UNLIKELY(_is_cancelled || (_is_pipeline_level_shuffle && chunk_queue_state.is_short_circuited))) {
+                drain_chunk_queue(index);
+            }
         }
     }
 
@@ -754,19 +815,7 @@ void DataStreamRecvr::PipelineSenderQueue::short_circuit(const int32_t driver_se
     auto& chunk_queue_state = _chunk_queue_states[driver_sequence];
     chunk_queue_state.is_short_circuited = true;
     if (_is_pipeline_level_shuffle) {
-        auto& chunk_queue = _chunk_queues[driver_sequence];
-        ChunkItem item;
-        while (chunk_queue.size_approx() > 0) {
-            if (chunk_queue.try_dequeue(item)) {
-                if (item.closure != nullptr) {
-                    _recvr->_closure_block_timer->update(MonotonicNanos() - item.queue_enter_time);
-                    item.closure->Run();
-                    chunk_queue_state.blocked_closure_num--;
-                }
-                --_total_chunks;
-                _recvr->_num_buffered_bytes -= item.chunk_bytes;
-            }
-        }
+        drain_chunk_queue(driver_sequence);
     }
 }
 
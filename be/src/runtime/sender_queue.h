@@ -205,11 +205,18 @@ private:
 
     void clean_buffer_queues();
 
+    // Run the closures of the chunks in the queue of |index| and drop the chunks.
+    void drain_chunk_queue(size_t index);
+
     StatusOr<ChunkList> get_chunks_from_pass_through(const int32_t sender_id, size_t& total_chunk_bytes);
 
     template <bool need_deserialization>
     StatusOr<ChunkList> get_chunks_from_request(const PTransmitChunkParams& request, size_t& total_chunk_bytes);
 
+    // Split the chunk whose rows belong to different drivers by |row_driver_sequences| into |chunks|.
+    Status split_chunk_by_drivers(ChunkUniquePtr chunk, int64_t chunk_bytes, const std::string& row_driver_sequences,
+                                  ChunkList* chunks);
+
     Status try_to_build_chunk_meta(const PTransmitChunkParams& request);
 
     template <bool keep_order>
@@ -237,12 +244,14 @@ private:
         // In the unplug state, has_output will return true directly if there is a chunk in the queue.
         // Otherwise, it will try to batch enough chunks to reduce the scheduling overhead.
         bool unpluging = false;
-        bool is_short_circuited = false;
+        std::atomic_bool is_short_circuited = false;
     };
     std::vector<ChunkQueueState> _chunk_queue_states;
 
     std::atomic<size_t> _total_chunks{0};
     bool _is_pipeline_level_shuffle = false;
+    // The chunk meta is built by the first request, then the requests needn't lock to check it.
+    std::atomic<bool> _chunk_meta_built{false};
 
     std::unordered_set<int> _sender_eos_set;
 
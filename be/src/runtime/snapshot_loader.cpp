@@ -34,9 +34,12 @@
 
 #include "runtime/snapshot_loader.h"
 
+#include <condition_variable>
 #include <cstdint>
 #include <filesystem>
+#include <mutex>
 #include <set>
+#include <unordered_map>
 
 #include "agent/master_info.h"
 #include "common/logging.h"
@@ -55,6 +58,9 @@
 #include "storage/tablet.h"
 #include "storage/tablet_manager.h"
 #include "storage/tablet_updates.h"
+#include "util/bandwidth_throttle.h"
+#include "util/md5.h"
+#include "util/threadpool.h"
 #include "util/thrift_rpc_helper.h"
 
 namespace starrocks {
@@ -79,6 +85,22 @@ inline const std::string& client_id(ExecEnv* env, const TNetworkAddress& addr) {
 }
 #endif
 
+// The pool transferring the files of all the uploads and downloads.
+static ThreadPool* snapshot_transfer_pool() {
+    static std::unique_ptr<ThreadPool> pool = [] {
+        std::unique_ptr<ThreadPool> p;
+        auto st = ThreadPoolBuilder("snapshot_transfer")
+                          .set_min_threads(0)
+                          .set_max_threads(std::max(1, config::upload_worker_count + config::download_worker_count) *
+                                           std::max(1, config::snapshot_loader_transfer_parallelism))
+                          .set_idle_timeout(MonoDelta::FromMilliseconds(2000))
+                          .build(&p);
+        LOG_IF(WARNING, !st.ok()) << "Fail to create the snapshot transfer pool, transfer the files serially: " << st;
+        return p;
+    }();
+    return pool.get();
+}
+
 SnapshotLoader::SnapshotLoader(ExecEnv* env, int64_t job_id, int64_t task_id)
         : _env(env), _job_id(job_id), _task_id(task_id) {}
 
@@ -122,21 +144,26 @@ Status SnapshotLoader::upload(const std::map<std::string, std::string>& src_to_d
         fs = std::move(maybe_fs.value());
     }
 
-    // 3. for each src path, upload it to remote storage
-    // we report to frontend for every 10 files, and we will cancel the job if
+    // 3. for each src path, find the files to upload to remote storage, then upload all of them concurrently.
+    // we report to frontend for every 10 tablets or files, and we will cancel the job if
     // the job has already been cancelled in frontend.
     int report_counter = 0;
     int total_num = src_to_dest_path.size();
     int finished_num = 0;
+    // the files of every tablet with their checksums, the checksums of the uploaded files are filled by the transfers
+    std::vector<std::pair<int64_t, std::vector<std::string>>> files_with_checksum;
+    files_with_checksum.reserve(total_num);
+    std::vector<FileTransfer> transfers;
     for (const auto& iter : src_to_dest_path) {
         const std::string& src_path = iter.first;
         const std::string& dest_path = iter.second;
+        RETURN_IF_ERROR(_report_every(10, &report_counter, finished_num, total_num, TTaskType::type::UPLOAD));
 
         int64_t tablet_id = 0;
         int32_t schema_hash = 0;
         RETURN_IF_ERROR(_get_tablet_id_and_schema_hash_from_file_path(src_path, &tablet_id, &schema_hash));
 
-        // 2.1 get existing files from remote path
+        // 3.1 get existing files from remote path
         std::map<std::string, FileStat> remote_files;
         if (!upload.__isset.use_broker || upload.use_broker) {
             RETURN_IF_ERROR(_get_existing_files_from_remote(*client, dest_path, upload.broker_prop, &remote_files));
@@ -147,75 +174,54 @@ Status SnapshotLoader::upload(const std::map<std::string, std::string>& src_to_d
             VLOG(2) << "get remote file: " << tmp.first << ", checksum: " << tmp.second.md5;
         }
 
-        // 2.2 list local files
+        // 3.2 list local files
         std::vector<std::string> local_files;
-        std::vector<std::string> local_files_with_checksum;
         RETURN_IF_ERROR(_get_existing_files_from_local(src_path, &local_files));
+        auto& local_files_with_checksum =
+                files_with_checksum.emplace_back(tablet_id, std::vector<std::string>(local_files.size())).second;
 
-        // 2.3 iterate local files
-        for (auto& local_file : local_files) {
-            RETURN_IF_ERROR(_report_every(10, &report_counter, finished_num, total_num, TTaskType::type::UPLOAD));
-
-            // calc md5sum of localfile
-            ASSIGN_OR_RETURN(auto md5sum, fs::md5sum(src_path + "/" + local_file));
-            VLOG(2) << "get file checksum: " << local_file << ": " << md5sum;
-            local_files_with_checksum.push_back(local_file + "." + md5sum);
+        // 3.3 iterate local files
+        for (size_t i = 0; i < local_files.size(); i++) {
+            const std::string& local_file = local_files[i];
+            auto local_file_path = src_path + "/" + local_file;
 
             // check if this local file need upload
-            bool need_upload = false;
             auto find = remote_files.find(local_file);
             if (find != remote_files.end()) {
-                if (md5sum != find->second.md5) {
-                    // remote storage file exist, but with different checksum
-                    LOG(WARNING) << "remote file checksum is invalid. remote: " << find->first << ", local: " << md5sum;
-                    // TODO(cmy): save these files and delete them later
-                    need_upload = true;
+                // calc md5sum of localfile
+                ASSIGN_OR_RETURN(auto md5sum, fs::md5sum(local_file_path));
+                VLOG(2) << "get file checksum: " << local_file << ": " << md5sum;
+                if (md5sum == find->second.md5) {
+                    VLOG(2) << "file exist in remote path, no need to upload: " << local_file;
+                    local_files_with_checksum[i] = local_file + "." + md5sum;
+                    continue;
                 }
-            } else {
-                need_upload = true;
+                // remote storage file exist, but with different checksum
+                LOG(WARNING) << "remote file checksum is invalid. remote: " << find->first << ", local: " << md5sum;
+                // TODO(cmy): save these files and delete them later
             }
 
-            if (!need_upload) {
-                VLOG(2) << "file exist in remote path, no need to upload: " << local_file;
-                continue;
-            }
-
-            // upload
-            // open broker writer. file name end with ".part"
-            // it will be renamed to ".md5sum" after upload finished
+            ASSIGN_OR_RETURN(auto file_size, FileSystem::Default()->get_file_size(local_file_path));
             auto full_remote_file = dest_path + "/" + local_file;
-            auto tmp_broker_file_name = full_remote_file + ".part";
-            auto local_file_path = src_path + "/" + local_file;
-            std::unique_ptr<WritableFile> remote_writable_file;
-            WritableFileOptions opts{.sync_on_close = false, .mode = FileSystem::CREATE_OR_OPEN_WITH_TRUNCATE};
-            if (!upload.__isset.use_broker || upload.use_broker) {
-                BrokerFileSystem fs_broker(upload.broker_addr, upload.broker_prop);
-                ASSIGN_OR_RETURN(remote_writable_file, fs_broker.new_writable_file(opts, tmp_broker_file_name));
-            } else {
-                ASSIGN_OR_RETURN(remote_writable_file, fs->new_writable_file(opts, tmp_broker_file_name));
-            }
-            ASSIGN_OR_RETURN(auto input_file, FileSystem::Default()->new_sequential_file(local_file_path));
-            auto res = fs::copy(input_file.get(), remote_writable_file.get(), 1024 * 1024);
-            if (!res.ok()) {
-                return res.status();
-            }
-            LOG(INFO) << "finished to write file via broker. file: " << local_file_path << ", length: " << *res;
-            RETURN_IF_ERROR(remote_writable_file->close());
-            // rename file to end with ".md5sum"
-            if (!upload.__isset.use_broker || upload.use_broker) {
-                RETURN_IF_ERROR(_rename_remote_file(*client, full_remote_file + ".part",
-                                                    full_remote_file + "." + md5sum, upload.broker_prop));
-            } else {
-                RETURN_IF_ERROR(_rename_remote_file_without_broker(fs, full_remote_file + ".part",
-                                                                   full_remote_file + "." + md5sum));
-            }
+            auto* file_with_checksum = &local_files_with_checksum[i];
+            transfers.push_back({static_cast<int64_t>(file_size), [&, local_file, local_file_path, full_remote_file,
+                                                                   file_with_checksum]() -> Status {
+                                     std::string md5sum;
+                                     RETURN_IF_ERROR(
+                                             _upload_file(upload, fs, local_file_path, full_remote_file, &md5sum));
+                                     *file_with_checksum = local_file + "." + md5sum;
+                                     return Status::OK();
+                                 }});
         } // end for each tablet's local files
-
-        tablet_files->emplace(tablet_id, local_files_with_checksum);
         finished_num++;
-        LOG(INFO) << "finished to write tablet to remote. local path: " << src_path << ", remote path: " << dest_path;
     } // end for each tablet path
 
+    // 4. upload the files of all the tablets
+    RETURN_IF_ERROR(_run_transfers(&transfers, TTaskType::type::UPLOAD));
+    for (auto& [tablet_id, files] : files_with_checksum) {
+        tablet_files->emplace(tablet_id, std::move(files));
+    }
+
     LOG(INFO) << "finished to upload snapshots. job: " << _job_id << ", task id: " << _task_id;
     return status;
 }
@@ -267,13 +273,25 @@ Status SnapshotLoader::download(const std::map<std::string, std::string>& src_to
         fs = std::move(maybe_fs.value());
     }
 
-    // 3. for each src path, download it to local storage
+    // 3. for each src path, find the files to download to local storage, then download all of them concurrently.
     int report_counter = 0;
     int total_num = src_to_dest_path.size();
     int finished_num = 0;
+    // the local files of the tablets are compared with their remote files after downloading
+    struct TabletFiles {
+        std::string local_path;
+        int64_t remote_tablet_id = 0;
+        std::vector<std::string> local_files;
+        std::map<std::string, FileStat> remote_files;
+    };
+    std::vector<TabletFiles> tablets;
+    tablets.reserve(total_num);
+    std::unordered_map<DataDir*, int64_t> data_dir_download_bytes;
+    std::vector<FileTransfer> transfers;
     for (const auto& iter : src_to_dest_path) {
         const std::string& remote_path = iter.first;
         const std::string& local_path = iter.second;
+        RETURN_IF_ERROR(_report_every(10, &report_counter, finished_num, total_num, TTaskType::type::DOWNLOAD));
 
         int64_t local_tablet_id = 0;
         int32_t schema_hash = 0;
@@ -285,12 +303,15 @@ Status SnapshotLoader::download(const std::map<std::string, std::string>& src_to
         VLOG(2) << "get local tablet id: " << local_tablet_id << ", schema hash: " << schema_hash
                 << ", remote tablet id: " << remote_tablet_id;
 
+        auto& tablet_files = tablets.emplace_back();
+        tablet_files.local_path = local_path;
+        tablet_files.remote_tablet_id = remote_tablet_id;
         // 1. get local files
-        std::vector<std::string> local_files;
+        std::vector<std::string>& local_files = tablet_files.local_files;
         RETURN_IF_ERROR(_get_existing_files_from_local(local_path, &local_files));
 
         // 2. get remote files
-        std::map<std::string, FileStat> remote_files;
+        std::map<std::string, FileStat>& remote_files = tablet_files.remote_files;
         if (!download.__isset.use_broker || download.use_broker) {
             RETURN_IF_ERROR(_get_existing_files_from_remote(*client, remote_path, download.broker_prop, &remote_files));
         } else {
@@ -313,8 +334,6 @@ Status SnapshotLoader::download(const std::map<std::string, std::string>& src_to
         DataDir* data_dir = tablet->data_dir();
 
         for (auto& iter : remote_files) {
-            RETURN_IF_ERROR(_report_every(10, &report_counter, finished_num, total_num, TTaskType::type::DOWNLOAD));
-
             bool need_download = false;
             const std::string& remote_file = iter.first;
             const FileStat& file_stat = iter.second;
@@ -349,93 +368,200 @@ Status SnapshotLoader::download(const std::map<std::string, std::string>& src_to
                 continue;
             }
 
-            // begin to download
             std::string full_remote_file = remote_path + "/" + remote_file + "." + file_stat.md5;
             std::string local_file_name;
             // we need to replace the tablet_id in remote file name with local tablet id
             RETURN_IF_ERROR(_replace_tablet_id(remote_file, local_tablet_id, &local_file_name));
             std::string full_local_file = local_path + "/" + local_file_name;
-            LOG(INFO) << "begin to download from " << full_remote_file << " to " << full_local_file;
-            size_t file_len = file_stat.size;
 
-            // check disk capacity
-            if (data_dir->capacity_limit_reached(file_len)) {
+            // check disk capacity for all the files to download to the disk
+            int64_t& download_bytes = data_dir_download_bytes[data_dir];
+            download_bytes += file_stat.size;
+            if (data_dir->capacity_limit_reached(download_bytes)) {
                 return Status::InternalError("capacity limit reached");
             }
 
-            std::unique_ptr<SequentialFile> remote_sequential_file;
-            if (!download.__isset.use_broker || download.use_broker) {
-                BrokerFileSystem fs_broker(download.broker_addr, download.broker_prop);
-                ASSIGN_OR_RETURN(remote_sequential_file, fs_broker.new_sequential_file(full_remote_file));
-            } else {
-                ASSIGN_OR_RETURN(remote_sequential_file, fs->new_sequential_file(full_remote_file));
-            }
-            // remove file which will be downloaded now.
-            // this file will be added to local_files if it be downloaded successfully.
+            // local_files always keep the updated local files, all the files must be downloaded successfully
+            // before the useless local files are deleted.
             // The Restore process of Primary key tablet may get a empty local_files at the begining.
             // Because we just generate the download path but not any other file.
-            if (!local_files.empty()) {
+            if (find != local_files.end()) {
                 local_files.erase(find);
             }
-
-            // 3. open local file for write
-            WritableFileOptions opts{.sync_on_close = false, .mode = FileSystem::CREATE_OR_OPEN_WITH_TRUNCATE};
-            ASSIGN_OR_RETURN(auto local_file, FileSystem::Default()->new_writable_file(opts, full_local_file));
-
-            auto res = fs::copy(remote_sequential_file.get(), local_file.get(), 1024 * 1024);
-            if (!res.ok()) {
-                return res.status();
-            }
-            RETURN_IF_ERROR(local_file->close());
-
-            // 5. check md5 of the downloaded file
-            ASSIGN_OR_RETURN(auto downloaded_md5sum, fs::md5sum(full_local_file));
-            VLOG(2) << "get downloaded file checksum: " << full_local_file << ": " << downloaded_md5sum;
-            if (downloaded_md5sum != file_stat.md5) {
-                std::stringstream ss;
-                ss << "invalid md5 of downloaded file: " << full_local_file << ", expected: " << file_stat.md5
-                   << ", get: " << downloaded_md5sum;
-                LOG(WARNING) << ss.str();
-                return Status::InternalError(ss.str());
-            }
-
-            // local_files always keep the updated local files
             local_files.push_back(local_file_name);
-            LOG(INFO) << "finished to download file via broker. file: " << full_local_file << ", length: " << file_len;
+
+            transfers.push_back({file_stat.size, [&, full_remote_file, full_local_file, file_stat]() {
+                                     return _download_file(download, fs, full_remote_file, full_local_file, file_stat);
+                                 }});
         } // end for all remote files
+        finished_num++;
+    } // end for src_to_dest_path
 
-        // finally, delete local files which are not in remote
-        for (const auto& local_file : local_files) {
+    // 4. download the files of all the tablets
+    RETURN_IF_ERROR(_run_transfers(&transfers, TTaskType::type::DOWNLOAD));
+
+    // finally, delete local files which are not in remote
+    for (const auto& tablet_files : tablets) {
+        for (const auto& local_file : tablet_files.local_files) {
             // replace the tablet id in local file name with the remote tablet id,
             // in order to compare the file name.
             std::string new_name;
-            Status st = _replace_tablet_id(local_file, remote_tablet_id, &new_name);
+            Status st = _replace_tablet_id(local_file, tablet_files.remote_tablet_id, &new_name);
             if (!st.ok()) {
                 LOG(WARNING) << "failed to replace tablet id. unknown local file: " << st.get_error_msg()
                              << ". ignore it";
                 continue;
             }
             VLOG(2) << "new file name after replace tablet id: " << new_name;
-            const auto& find = remote_files.find(new_name);
-            if (find != remote_files.end()) {
+            const auto& find = tablet_files.remote_files.find(new_name);
+            if (find != tablet_files.remote_files.end()) {
                 continue;
             }
 
             // delete
-            std::string full_local_file = local_path + "/" + local_file;
+            std::string full_local_file = tablet_files.local_path + "/" + local_file;
             VLOG(2) << "begin to delete local snapshot file: " << full_local_file << ", it does not exist in remote";
             if (remove(full_local_file.c_str()) != 0) {
                 LOG(WARNING) << "failed to delete unknown local file: " << full_local_file << ", ignore it";
             }
         }
-
-        finished_num++;
-    } // end for src_to_dest_path
+    }
 
     LOG(INFO) << "finished to download snapshots. job: " << _job_id << ", task id: " << _task_id;
     return status;
 }
 
+Status SnapshotLoader::_run_transfers(std::vector<FileTransfer>* transfers, TTaskType::type type) {
+    const int parallelism = std::max(1, config::snapshot_loader_transfer_parallelism);
+    const int64_t max_inflight_bytes = config::snapshot_loader_max_inflight_bytes;
+    ThreadPool* pool = parallelism > 1 ? snapshot_transfer_pool() : nullptr;
+    const int total_num = transfers->size();
+    int report_counter = 0;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    int inflight_num = 0;
+    int64_t inflight_bytes = 0;
+    int finished_num = 0;
+    Status status;
+    auto finish = [&](int64_t size, const Status& st) {
+        std::lock_guard l(mutex);
+        --inflight_num;
+        inflight_bytes -= size;
+        ++finished_num;
+        if (status.ok() && !st.ok()) {
+            status = st;
+        }
+        cv.notify_all();
+    };
+
+    for (auto& transfer : *transfers) {
+        int current_finished_num = 0;
+        {
+            std::unique_lock l(mutex);
+            // a transfer larger than max_inflight_bytes runs alone
+            cv.wait(l, [&] {
+                return !status.ok() || inflight_num == 0 ||
+                       (inflight_num < parallelism && inflight_bytes + transfer.size <= max_inflight_bytes);
+            });
+            if (!status.ok()) {
+                break;
+            }
+            ++inflight_num;
+            inflight_bytes += transfer.size;
+            current_finished_num = finished_num;
+        }
+        auto st = _report_every(10, &report_counter, current_finished_num, total_num, type);
+        if (!st.ok()) {
+            finish(transfer.size, st);
+            break;
+        }
+        auto task = [&transfer, &finish] { finish(transfer.size, transfer.run()); };
+        if (pool == nullptr || !pool->submit_func(task).ok()) {
+            task();
+        }
+    }
+
+    std::unique_lock l(mutex);
+    cv.wait(l, [&] { return inflight_num == 0; });
+    return status;
+}
+
+Status SnapshotLoader::_upload_file(const TUploadReq& upload, const std::unique_ptr<FileSystem>& fs,
+                                    const std::string& local_file_path, const std::string& full_remote_file,
+                                    std::string* md5sum) {
+    // open broker writer. file name end with ".part"
+    // it will be renamed to ".md5sum" after upload finished
+    const bool use_broker = !upload.__isset.use_broker || upload.use_broker;
+    auto tmp_broker_file_name = full_remote_file + ".part";
+    std::unique_ptr<WritableFile> remote_writable_file;
+    WritableFileOptions opts{.sync_on_close = false, .mode = FileSystem::CREATE_OR_OPEN_WITH_TRUNCATE};
+    if (use_broker) {
+        BrokerFileSystem fs_broker(upload.broker_addr, upload.broker_prop);
+        ASSIGN_OR_RETURN(remote_writable_file, fs_broker.new_writable_file(opts, tmp_broker_file_name));
+    } else {
+        ASSIGN_OR_RETURN(remote_writable_file, fs->new_writable_file(opts, tmp_broker_file_name));
+    }
+    ASSIGN_OR_RETURN(auto input_file, FileSystem::Default()->new_sequential_file(local_file_path));
+    // the checksum is computed while the file is uploaded, and the large files written to the object storages
+    // are uploaded by the parallel multipart uploads of their writable files.
+    Md5Digest md5;
+    ASSIGN_OR_RETURN(auto length, fs::copy(input_file.get(), remote_writable_file.get(), 1024 * 1024, nullptr, &md5));
+    LOG(INFO) << "finished to write file via broker. file: " << local_file_path << ", length: " << length;
+    RETURN_IF_ERROR(remote_writable_file->close());
+    md5.digest();
+    *md5sum = md5.hex();
+    VLOG(2) << "get file checksum: " << local_file_path << ": " << *md5sum;
+
+    // rename file to end with ".md5sum"
+    if (use_broker) {
+        // the broker connections can't be shared by the concurrent transfers
+        Status status;
+        BrokerServiceConnection client(client_cache(_env), upload.broker_addr,
+                                       config::broker_write_timeout_seconds * 1000, &status);
+        RETURN_IF_ERROR(status);
+        return _rename_remote_file(client, tmp_broker_file_name, full_remote_file + "." + *md5sum,
+                                   upload.broker_prop);
+    }
+    return _rename_remote_file_without_broker(fs, tmp_broker_file_name, full_remote_file + "." + *md5sum);
+}
+
+Status SnapshotLoader::_download_file(const TDownloadReq& download, const std::unique_ptr<FileSystem>& fs,
+                                      const std::string& full_remote_file, const std::string& full_local_file,
+                                      const FileStat& file_stat) {
+    LOG(INFO) << "begin to download from " << full_remote_file << " to " << full_local_file;
+    std::unique_ptr<SequentialFile> remote_sequential_file;
+    if (!download.__isset.use_broker || download.use_broker) {
+        BrokerFileSystem fs_broker(download.broker_addr, download.broker_prop);
+        ASSIGN_OR_RETURN(remote_sequential_file, fs_broker.new_sequential_file(full_remote_file));
+    } else {
+        ASSIGN_OR_RETURN(remote_sequential_file, fs->new_sequential_file(full_remote_file));
+    }
+
+    // open local file for write
+    WritableFileOptions opts{.sync_on_close = false, .mode = FileSystem::CREATE_OR_OPEN_WITH_TRUNCATE};
+    ASSIGN_OR_RETURN(auto local_file, FileSystem::Default()->new_writable_file(opts, full_local_file));
+
+    // the downloads share the bandwidth with the clones, and the checksum is computed while the file is downloaded
+    Md5Digest md5;
+    ASSIGN_OR_RETURN(auto length, fs::copy(remote_sequential_file.get(), local_file.get(), 1024 * 1024,
+                                           BandwidthThrottle::replication_download(), &md5));
+    RETURN_IF_ERROR(local_file->close());
+
+    // check md5 of the downloaded file
+    md5.digest();
+    VLOG(2) << "get downloaded file checksum: " << full_local_file << ": " << md5.hex();
+    if (md5.hex() != file_stat.md5) {
+        std::stringstream ss;
+        ss << "invalid md5 of downloaded file: " << full_local_file << ", expected: " << file_stat.md5
+           << ", get: " << md5.hex();
+        LOG(WARNING) << ss.str();
+        return Status::InternalError(ss.str());
+    }
+    LOG(INFO) << "finished to download file via broker. file: " << full_local_file << ", length: " << length;
+    return Status::OK();
+}
+
 Status SnapshotLoader::primary_key_move(const std::string& snapshot_path, const TabletSharedPtr& tablet,
                                         bool overwrite) {
     CHECK(tablet->updates() != nullptr);
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <map>
 #include <string>
 #include <vector>
@@ -51,6 +52,9 @@ struct FileStat {
  * to local snapshot dir via broker.
  * It will also only download files which does not exist in local dir.
  *
+ * The files of all the tablets of an upload or download are transferred concurrently,
+ * see _run_transfers(), and their checksums are computed while they are transferred.
+ *
  * Move:
  * move() is the final step of restore process. it will replace the 
  * old tablet data dir with the newly downloaded snapshot dir.
@@ -74,6 +78,26 @@ public:
     Status primary_key_move(const std::string& snapshot_path, const TabletSharedPtr& tablet, bool overwrite);
 
 private:
+    // The transfer of a file of |size| bytes.
+    struct FileTransfer {
+        int64_t size = 0;
+        std::function<Status()> run;
+    };
+
+    // Run |transfers| by at most config::snapshot_loader_transfer_parallelism threads, with at most
+    // config::snapshot_loader_max_inflight_bytes bytes in flight. No more transfer is started once any of them
+    // fails or the job is cancelled, and the first failure is returned after the running ones finish.
+    Status _run_transfers(std::vector<FileTransfer>* transfers, TTaskType::type type);
+
+    // Upload the local file to |full_remote_file|.|md5sum|, |md5sum| is computed while uploading.
+    Status _upload_file(const TUploadReq& upload, const std::unique_ptr<FileSystem>& fs,
+                        const std::string& local_file_path, const std::string& full_remote_file, std::string* md5sum);
+
+    // Download the remote file and check its checksum while downloading.
+    Status _download_file(const TDownloadReq& download, const std::unique_ptr<FileSystem>& fs,
+                          const std::string& full_remote_file, const std::string& full_local_file,
+                          const FileStat& file_stat);
+
     Status _get_tablet_id_and_schema_hash_from_file_path(const std::string& src_path, int64_t* tablet_id,
                                                          int32_t* schema_hash);
 
@@ -14,9 +14,14 @@
 
 #include "runtime/sorted_chunks_merger.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "column/chunk.h"
+#include "common/config.h"
 #include "exec/sort_exec_exprs.h"
 #include "exec/sorting/sorting.h"
+#include "exprs/expr_context.h"
 #include "runtime/chunk_cursor.h"
 #include "runtime/runtime_state.h"
 
@@ -347,4 +352,211 @@ Status CascadeChunkMerger::get_next(ChunkUniquePtr* output, std::atomic<bool>* e
     return Status::OK();
 }
 
+LoserTreeChunkMerger::LoserTreeChunkMerger(RuntimeState* state) : _state(state) {}
+
+Status LoserTreeChunkMerger::init(const std::vector<ChunkProvider>& providers,
+                                  const std::vector<ExprContext*>* sort_exprs, const std::vector<bool>* sort_orders,
+                                  const std::vector<bool>* null_firsts) {
+    DCHECK(!providers.empty());
+    _sort_exprs = sort_exprs;
+    _sort_desc = SortDescs(*sort_orders, *null_firsts);
+    _string_prefix = std::clamp<int64_t>(config::sort_normalized_key_string_prefix, 0,
+                                         NormalizedKeys::kMaxStringPrefix);
+    _inputs.resize(providers.size());
+    for (size_t i = 0; i < providers.size(); i++) {
+        _inputs[i].provider = providers[i];
+    }
+    return Status::OK();
+}
+
+bool LoserTreeChunkMerger::is_data_ready() {
+    if (!_tree_built) {
+        return std::all_of(_inputs.begin(), _inputs.end(), [](Input& input) { return input.is_data_ready(); });
+    }
+    return _waiting_input < 0 || _inputs[_waiting_input].is_data_ready();
+}
+
+Status LoserTreeChunkMerger::get_next(ChunkUniquePtr* output, std::atomic<bool>* eos, bool* should_exit) {
+    if (!_tree_built) {
+        for (auto& input : _inputs) {
+            RETURN_IF_ERROR(_pull(&input, kLookaheadChunks + 1));
+            if (input.chunks.empty() && !input.eos) {
+                *should_exit = true;
+                return Status::OK();
+            }
+        }
+        _build_tree();
+    } else if (_waiting_input >= 0) {
+        Input& input = _inputs[_waiting_input];
+        RETURN_IF_ERROR(_pull(&input, kLookaheadChunks + 1));
+        if (input.chunks.empty() && !input.eos) {
+            *should_exit = true;
+            return Status::OK();
+        }
+        _replay(_waiting_input);
+        _waiting_input = -1;
+    }
+    for (auto& input : _inputs) {
+        if (!input.eos && input.chunks.size() <= kLookaheadChunks) {
+            RETURN_IF_ERROR(_pull(&input, kLookaheadChunks + 1));
+        }
+    }
+
+    const size_t chunk_size = _state->chunk_size();
+    ChunkUniquePtr result;
+    ChunkPtr current_chunk;
+    std::vector<uint32_t> selective_values;
+    selective_values.reserve(chunk_size);
+    size_t num_rows = 0;
+    while (num_rows < chunk_size) {
+        const size_t winner = _tree[0];
+        Input& input = _inputs[winner];
+        if (input.exhausted()) {
+            break;
+        }
+        const ChunkPtr& chunk = input.chunks.front().chunk;
+        if (result == nullptr) {
+            result = chunk->clone_empty(chunk_size);
+        }
+        // copy the successive rows of the same chunk together
+        if (chunk != current_chunk) {
+            if (!selective_values.empty()) {
+                result->append_selective(*current_chunk, selective_values.data(), 0, selective_values.size());
+                selective_values.clear();
+            }
+            current_chunk = chunk;
+        }
+        selective_values.push_back(input.pos);
+        num_rows++;
+
+        if (++input.pos == current_chunk->num_rows()) {
+            input.chunks.pop_front();
+            input.pos = 0;
+            if (input.chunks.empty()) {
+                RETURN_IF_ERROR(_pull(&input, kLookaheadChunks + 1));
+                if (input.chunks.empty() && !input.eos) {
+                    _waiting_input = winner;
+                    break;
+                }
+            }
+        }
+        _replay(winner);
+    }
+    if (!selective_values.empty()) {
+        result->append_selective(*current_chunk, selective_values.data(), 0, selective_values.size());
+    }
+
+    if (num_rows > 0) {
+        *output = std::move(result);
+    } else if (_waiting_input >= 0) {
+        *should_exit = true;
+    } else {
+        *eos = true;
+        *should_exit = true;
+    }
+    return Status::OK();
+}
+
+Status LoserTreeChunkMerger::_pull(Input* input, size_t max_chunks) {
+    while (!input->eos && input->chunks.size() < max_chunks) {
+        ChunkUniquePtr chunk;
+        bool eos = false;
+        if (!input->provider(&chunk, &eos)) {
+            input->eos = eos;
+            break;
+        }
+        if (chunk == nullptr || chunk->is_empty()) {
+            continue;
+        }
+        InputChunk& input_chunk = input->chunks.emplace_back();
+        for (ExprContext* expr : *_sort_exprs) {
+            ASSIGN_OR_RETURN(auto column, expr->evaluate(chunk.get()));
+            input_chunk.orderby.push_back(std::move(column));
+        }
+        if (input_chunk.keys.encode(input_chunk.orderby, _sort_desc, _string_prefix).ok()) {
+            input_chunk.layout = _layout_of(input_chunk.orderby);
+        }
+        input_chunk.chunk = std::move(chunk);
+    }
+    return Status::OK();
+}
+
+int LoserTreeChunkMerger::_layout_of(const Columns& orderby) {
+    // the keys of the same types are of the same layout, unless some are nullable and the others are not
+    std::vector<bool> nullables;
+    nullables.reserve(orderby.size());
+    for (const auto& column : orderby) {
+        nullables.push_back(column->is_nullable());
+    }
+    auto it = std::find(_layouts.begin(), _layouts.end(), nullables);
+    if (it != _layouts.end()) {
+        return it - _layouts.begin();
+    }
+    _layouts.push_back(std::move(nullables));
+    return _layouts.size() - 1;
+}
+
+bool LoserTreeChunkMerger::_is_before(size_t lhs, size_t rhs) const {
+    const Input& lhs_input = _inputs[lhs];
+    const Input& rhs_input = _inputs[rhs];
+    if (lhs_input.exhausted() || rhs_input.exhausted()) {
+        return !lhs_input.exhausted() || (rhs_input.exhausted() && lhs < rhs);
+    }
+    int x = _compare(lhs_input, rhs_input);
+    // keep the order of the inputs for the equal rows
+    return x < 0 || (x == 0 && lhs < rhs);
+}
+
+int LoserTreeChunkMerger::_compare(const Input& lhs, const Input& rhs) const {
+    const InputChunk& lhs_chunk = lhs.chunks.front();
+    const InputChunk& rhs_chunk = rhs.chunks.front();
+    if (lhs_chunk.layout >= 0 && lhs_chunk.layout == rhs_chunk.layout) {
+        int x = memcmp(lhs_chunk.keys.key(lhs.pos), rhs_chunk.keys.key(rhs.pos), lhs_chunk.keys.key_size());
+        if (x != 0 || (!lhs_chunk.keys.is_ambiguous(lhs.pos) && !rhs_chunk.keys.is_ambiguous(rhs.pos))) {
+            return x;
+        }
+    }
+    for (size_t i = 0; i < _sort_desc.num_columns(); i++) {
+        const SortDesc& desc = _sort_desc.descs[i];
+        int x = lhs_chunk.orderby[i]->compare_at(lhs.pos, rhs.pos, *rhs_chunk.orderby[i], desc.null_first);
+        if (x != 0) {
+            return x * desc.sort_order;
+        }
+    }
+    return 0;
+}
+
+void LoserTreeChunkMerger::_build_tree() {
+    // The leaf of the i-th input is the (k + i)-th node, and the parent of the j-th node is the (j / 2)-th node.
+    const size_t k = _inputs.size();
+    std::vector<size_t> winners(2 * k);
+    for (size_t i = 0; i < k; i++) {
+        winners[k + i] = i;
+    }
+    _tree.assign(k, 0);
+    for (size_t j = k - 1; j >= 1; j--) {
+        size_t lhs = winners[2 * j];
+        size_t rhs = winners[2 * j + 1];
+        if (_is_before(lhs, rhs)) {
+            winners[j] = lhs;
+            _tree[j] = rhs;
+        } else {
+            winners[j] = rhs;
+            _tree[j] = lhs;
+        }
+    }
+    _tree[0] = winners[1];
+    _tree_built = true;
+}
+
+void LoserTreeChunkMerger::_replay(size_t winner) {
+    const size_t k = _inputs.size();
+    for (size_t node = (k + winner) / 2; node >= 1; node /= 2) {
+        if (_is_before(_tree[node], winner)) {
+            std::swap(_tree[node], winner);
+        }
+    }
+    _tree[0] = winner;
+}
+
 } // namespace starrocks
@@ -14,10 +14,12 @@
 
 #pragma once
 
+#include <deque>
 #include <queue>
 
 #include "column/column_helper.h"
 #include "exec/sorting/merge.h"
+#include "exec/sorting/normalized_keys.h"
 #include "exec/sorting/sorting.h"
 #include "runtime/chunk_cursor.h"
 #include "util/runtime_profile.h"
@@ -118,4 +120,67 @@ private:
     ChunkSlice _current_chunk;
 };
 
+// Merge the sorted chunks of many inputs by a loser tree, which takes log2(k) comparisons for each output row,
+// instead of passing each row through the k - 1 two-way mergers of CascadeChunkMerger.
+//
+// The sort keys of every input chunk are encoded into normalized keys if possible, so most of the comparisons are
+// a memcmp. Every input pulls up to kLookaheadChunks chunks ahead of the merging one whenever they have arrived, so
+// a slow sender stalls the merge only if all its lookahead chunks are consumed.
+class LoserTreeChunkMerger {
+public:
+    static constexpr size_t kLookaheadChunks = 2;
+
+    explicit LoserTreeChunkMerger(RuntimeState* state);
+    ~LoserTreeChunkMerger() = default;
+
+    Status init(const std::vector<ChunkProvider>& providers, const std::vector<ExprContext*>* sort_exprs,
+                const std::vector<bool>* sort_orders, const std::vector<bool>* null_firsts);
+
+    bool is_data_ready();
+    Status get_next(ChunkUniquePtr* chunk, std::atomic<bool>* eos, bool* should_exit);
+
+private:
+    struct InputChunk {
+        ChunkPtr chunk;
+        Columns orderby;
+        NormalizedKeys keys;
+        // The normalized keys of the chunks of the same layout are comparable, -1 if they can't be normalized.
+        int layout = -1;
+    };
+
+    struct Input {
+        ChunkProvider provider;
+        // The front chunk is being merged, and it's never empty.
+        std::deque<InputChunk> chunks;
+        size_t pos = 0;
+        bool eos = false;
+
+        bool exhausted() const { return eos && chunks.empty(); }
+        bool is_data_ready() { return !chunks.empty() || eos || provider(nullptr, nullptr); }
+    };
+
+    // Pull the arrived chunks of |input| until it has |max_chunks| chunks.
+    Status _pull(Input* input, size_t max_chunks);
+    int _layout_of(const Columns& orderby);
+    // Return true if the current row of the |lhs|-th input should be output before the |rhs|-th one.
+    bool _is_before(size_t lhs, size_t rhs) const;
+    int _compare(const Input& lhs, const Input& rhs) const;
+    void _build_tree();
+    // Replay the matches from the leaf of the |winner|-th input to the root after its current row changed.
+    void _replay(size_t winner);
+
+    RuntimeState* _state;
+    const std::vector<ExprContext*>* _sort_exprs = nullptr;
+    SortDescs _sort_desc;
+    size_t _string_prefix = 0;
+    std::vector<Input> _inputs;
+    std::vector<std::vector<bool>> _layouts;
+
+    // _tree[0] is the winner, and _tree[i] for i > 0 is the loser of the i-th match.
+    std::vector<size_t> _tree;
+    bool _tree_built = false;
+    // The input whose chunks are used up before its sender finished, -1 if none.
+    int _waiting_input = -1;
+};
+
 } // namespace starrocks
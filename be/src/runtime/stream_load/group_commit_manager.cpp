@@ -0,0 +1,183 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "runtime/stream_load/group_commit_manager.h"
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "runtime/exec_env.h"
+#include "runtime/message_body_sink.h"
+#include "runtime/stream_load/stream_load_context.h"
+#include "runtime/stream_load/stream_load_executor.h"
+#include "util/byte_buffer.h"
+#include "util/time.h"
+#include "util/uid_util.h"
+
+namespace starrocks {
+
+GroupCommitManager::Group::Group(StreamLoadContext* ctx_) : ctx(ctx_), create_time(std::chrono::steady_clock::now()) {
+    ctx->ref();
+}
+
+GroupCommitManager::Group::~Group() {
+    // the transaction is rolled back by the context if it's not committed
+    if (ctx->unref()) {
+        delete ctx;
+    }
+}
+
+Status GroupCommitManager::append_and_wait(const std::string& key, StreamLoadContext* ctx,
+                                           const BeginGroupLoad& begin) {
+    while (true) {
+        bool leader = false;
+        auto group = _join(key, ctx, &leader);
+        if (leader) {
+            int64_t begin_start_time = MonotonicNanos();
+            auto st = begin(group->ctx);
+            ctx->begin_txn_cost_nanos = MonotonicNanos() - begin_start_time;
+            if (!st.ok()) {
+                _seal(key, group.get());
+                _finish(group.get(), st);
+                return st;
+            }
+            std::lock_guard l(group->mutex);
+            group->ready = true;
+            group->cv.notify_all();
+        }
+
+        Status st;
+        if (!_append(group.get(), ctx, &st)) {
+            // the group is sealed before the body is appended, try the next group
+            DCHECK(!leader);
+            continue;
+        }
+        if (leader) {
+            if (st.ok()) {
+                std::unique_lock l(group->mutex);
+                auto deadline = group->create_time + std::chrono::milliseconds(config::group_commit_interval_ms);
+                group->cv.wait_until(l, deadline, [&] {
+                    return group->done || group->buffered_bytes >= config::group_commit_max_bytes;
+                });
+            }
+            _seal(key, group.get());
+            int64_t commit_start_time = MonotonicNanos();
+            _finish(group.get(), st.ok() ? _commit(group.get()) : st);
+            ctx->commit_and_publish_txn_cost_nanos = MonotonicNanos() - commit_start_time;
+        } else if (st.ok()) {
+            std::unique_lock l(group->mutex);
+            group->cv.wait(l, [&] { return group->done; });
+        }
+
+        std::lock_guard l(group->mutex);
+        ctx->txn_id = group->ctx->txn_id;
+        return st.ok() ? group->status : st;
+    }
+}
+
+GroupCommitManager::GroupPtr GroupCommitManager::_join(const std::string& key, StreamLoadContext* ctx, bool* leader) {
+    std::lock_guard l(_lock);
+    auto iter = _groups.find(key);
+    if (iter != _groups.end()) {
+        *leader = false;
+        return iter->second;
+    }
+    auto* group_ctx = new StreamLoadContext(_exec_env);
+    group_ctx->load_type = ctx->load_type;
+    group_ctx->load_src_type = ctx->load_src_type;
+    group_ctx->db = ctx->db;
+    group_ctx->table = ctx->table;
+    group_ctx->label = "group_commit_" + generate_uuid_string();
+    group_ctx->timeout_second = ctx->timeout_second;
+    group_ctx->auth = ctx->auth;
+    group_ctx->format = ctx->format;
+    auto group = std::make_shared<Group>(group_ctx);
+    _groups.emplace(key, group);
+    *leader = true;
+    VLOG(1) << "new group commit load " << group_ctx->brief() << ", db=" << ctx->db << ", tbl=" << ctx->table;
+    return group;
+}
+
+bool GroupCommitManager::_append(Group* group, StreamLoadContext* ctx, Status* st) {
+    std::unique_lock l(group->mutex);
+    group->cv.wait(l, [&] { return group->ready || group->done; });
+    if (group->done) {
+        *st = group->status;
+        return true;
+    }
+    if (group->sealed) {
+        return false;
+    }
+    auto& buffer = ctx->buffer;
+    const size_t size = buffer->remaining();
+    const bool need_delimiter = size > 0 && buffer->ptr[buffer->limit - 1] != '\n';
+    *st = group->ctx->body_sink->append(std::move(buffer));
+    if (st->ok() && need_delimiter) {
+        // the last row of the body must be terminated before the rows of the next body
+        *st = group->ctx->body_sink->append("\n", 1);
+    }
+    if (!st->ok()) {
+        LOG(WARNING) << "append body to group commit load failed. errmsg=" << *st << " group=" << group->ctx->brief()
+                     << " context=" << ctx->brief();
+        return true;
+    }
+    group->buffered_bytes += size;
+    group->num_loads++;
+    if (group->buffered_bytes >= config::group_commit_max_bytes) {
+        group->cv.notify_all();
+    }
+    return true;
+}
+
+void GroupCommitManager::_seal(const std::string& key, Group* group) {
+    {
+        std::lock_guard l(_lock);
+        auto iter = _groups.find(key);
+        if (iter != _groups.end() && iter->second.get() == group) {
+            _groups.erase(iter);
+        }
+    }
+    std::lock_guard l(group->mutex);
+    group->sealed = true;
+}
+
+Status GroupCommitManager::_commit(Group* group) {
+    auto* ctx = group->ctx;
+    RETURN_IF_ERROR(ctx->body_sink->finish());
+    RETURN_IF_ERROR(ctx->future.get());
+    return _exec_env->stream_load_executor()->commit_txn(ctx);
+}
+
+void GroupCommitManager::_finish(Group* group, const Status& st) {
+    auto* ctx = group->ctx;
+    if (!st.ok()) {
+        LOG(WARNING) << "group commit load failed. errmsg=" << st << " group=" << ctx->brief();
+        if (ctx->need_rollback) {
+            _exec_env->stream_load_executor()->rollback_txn(ctx);
+            ctx->need_rollback = false;
+        }
+        if (ctx->body_sink != nullptr) {
+            ctx->body_sink->cancel(st);
+        }
+    } else {
+        VLOG(1) << "group commit load committed " << ctx->brief() << ", txn_id=" << ctx->txn_id
+                << ", loads=" << group->num_loads << ", bytes=" << group->buffered_bytes;
+    }
+    std::lock_guard l(group->mutex);
+    group->status = st;
+    group->done = true;
+    group->cv.notify_all();
+}
+
+} // namespace starrocks
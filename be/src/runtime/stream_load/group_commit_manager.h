@@ -0,0 +1,87 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "common/status.h"
+
+namespace starrocks {
+
+class ExecEnv;
+class StreamLoadContext;
+
+// GroupCommitManager merges the small csv stream loads of the same table and the same load properties into one
+// load, so that they are committed by one transaction and published as one version.
+//
+// The first load of a group is the leader, it begins the transaction and the plan fragment of the group load,
+// and the bodies of the following loads are appended to the pipe of the group load. The group is sealed when
+// group_commit_interval_ms passed or group_commit_max_bytes are buffered, then the leader commits the group load,
+// and every load of the group is replied with the result of the commit.
+class GroupCommitManager {
+public:
+    // Begin the transaction and the plan fragment of the group load |group_ctx|.
+    using BeginGroupLoad = std::function<Status(StreamLoadContext* group_ctx)>;
+
+    explicit GroupCommitManager(ExecEnv* exec_env) : _exec_env(exec_env) {}
+    ~GroupCommitManager() = default;
+
+    // Append the body in |ctx->buffer| to the group of |key|, and wait until the group is committed.
+    // |begin| is called if |ctx| starts a new group.
+    Status append_and_wait(const std::string& key, StreamLoadContext* ctx, const BeginGroupLoad& begin);
+
+private:
+    struct Group {
+        explicit Group(StreamLoadContext* ctx);
+        ~Group();
+
+        StreamLoadContext* const ctx;
+        const std::chrono::steady_clock::time_point create_time;
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        // The group load is begun and the bodies can be appended.
+        bool ready = false;
+        // No more bodies can be appended.
+        bool sealed = false;
+        // The group load is committed or failed with |status|.
+        bool done = false;
+        Status status;
+        size_t buffered_bytes = 0;
+        int64_t num_loads = 0;
+    };
+    using GroupPtr = std::shared_ptr<Group>;
+
+    // Return the open group of |key|, a new one is created if there's none, and |leader| is set to true.
+    GroupPtr _join(const std::string& key, StreamLoadContext* ctx, bool* leader);
+    // Return false if the group has been sealed.
+    bool _append(Group* group, StreamLoadContext* ctx, Status* st);
+    void _seal(const std::string& key, Group* group);
+    Status _commit(Group* group);
+    void _finish(Group* group, const Status& st);
+
+    ExecEnv* _exec_env;
+    std::mutex _lock;
+    std::unordered_map<std::string, GroupPtr> _groups;
+};
+
+} // namespace starrocks
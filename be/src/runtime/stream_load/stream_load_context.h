@@ -213,6 +213,8 @@ public:
     // when use_streaming is true, we use stream_pipe to send source data,
     // otherwise we save source data to file first, then process it.
     bool use_streaming = false;
+    // the body is appended to a group commit load instead of being loaded by its own transaction
+    bool group_commit = false;
     TFileFormatType::type format = TFileFormatType::FORMAT_CSV_PLAIN;
 
     TStreamLoadPutResult put_result;
@@ -34,6 +34,8 @@
 
 #include "runtime/stream_load/stream_load_pipe.h"
 
+#include <string_view>
+
 namespace starrocks {
 
 Status StreamLoadPipe::append(ByteBufferPtr&& buf) {
@@ -220,12 +222,65 @@ Status StreamLoadPipe::no_block_read(uint8_t* data, size_t* data_size, bool* eof
     return Status::OK();
 }
 
-Status StreamLoadPipe::finish() {
-    if (_write_buf != nullptr) {
-        _write_buf->flip();
-        _append(_write_buf);
-        _write_buf.reset();
+// Returns a new buffer of the remaining bytes of |prefix| followed by data[0, size).
+static ByteBufferPtr concat_bytes(const ByteBufferPtr& prefix, const char* data, size_t size) {
+    size_t prefix_size = prefix != nullptr ? prefix->remaining() : 0;
+    auto buf = ByteBuffer::allocate(prefix_size + size);
+    if (prefix_size > 0) {
+        buf->put_bytes(prefix->ptr + prefix->pos, prefix_size);
+    }
+    buf->put_bytes(data, size);
+    buf->flip();
+    return buf;
+}
+
+StatusOr<ByteBufferPtr> StreamLoadPipe::read_records(const std::string& record_delimiter) {
+    DCHECK(!record_delimiter.empty());
+    std::lock_guard<std::mutex> l(_records_lock);
+    if (_pending_records != nullptr) {
+        return std::move(_pending_records);
+    }
+    while (true) {
+        auto res = read();
+        if (res.status().is_end_of_file() && _partial_record != nullptr) {
+            return std::move(_partial_record);
+        }
+        if (!res.ok()) {
+            return res.status();
+        }
+        ByteBufferPtr buf = std::move(res).value();
+        std::string_view bytes(buf->ptr + buf->pos, buf->remaining());
+        size_t first = bytes.find(record_delimiter);
+        if (first == std::string_view::npos) {
+            _partial_record = concat_bytes(_partial_record, bytes.data(), bytes.size());
+            continue;
+        }
+        size_t first_end = first + record_delimiter.size();
+        size_t last_end = bytes.rfind(record_delimiter) + record_delimiter.size();
+
+        ByteBufferPtr head;
+        if (_partial_record != nullptr) {
+            // The record across the previous buffer and this one.
+            head = concat_bytes(_partial_record, bytes.data(), first_end);
+            _partial_record.reset();
+        }
+        if (last_end < bytes.size()) {
+            _partial_record = concat_bytes(nullptr, bytes.data() + last_end, bytes.size() - last_end);
+        }
+        buf->limit = buf->pos + last_end;
+        if (head == nullptr) {
+            return buf;
+        }
+        buf->pos += first_end;
+        if (buf->has_remaining()) {
+            _pending_records = std::move(buf);
+        }
+        return head;
     }
+}
+
+Status StreamLoadPipe::finish() {
+    (void)_flush_write_buf();
     {
         std::lock_guard<std::mutex> l(_lock);
         _finished = true;
@@ -246,6 +301,16 @@ void StreamLoadPipe::cancel(const Status& status) {
     _put_cond.notify_all();
 }
 
+Status StreamLoadPipe::_flush_write_buf() {
+    if (_write_buf == nullptr) {
+        return Status::OK();
+    }
+    _write_buf->flip();
+    auto st = _append(_write_buf);
+    _write_buf.reset();
+    return st;
+}
+
 Status StreamLoadPipe::_append(const ByteBufferPtr& buf) {
     if (buf != nullptr && buf->has_remaining()) {
         std::unique_lock<std::mutex> l(_lock);
@@ -280,6 +345,7 @@ StreamLoadPipeInputStream::StreamLoadPipeInputStream(std::shared_ptr<StreamLoadP
     if (non_blocking_read) {
         _pipe->set_non_blocking_read();
     }
+    _pipe->add_reader();
 }
 
 StreamLoadPipeInputStream::~StreamLoadPipeInputStream() {
@@ -287,6 +353,19 @@ StreamLoadPipeInputStream::~StreamLoadPipeInputStream() {
 }
 
 StatusOr<int64_t> StreamLoadPipeInputStream::read(void* data, int64_t size) {
+    if (!_record_delimiter.empty()) {
+        while (_records == nullptr || !_records->has_remaining()) {
+            auto res = _pipe->read_records(_record_delimiter);
+            if (res.status().is_end_of_file()) {
+                return 0;
+            }
+            RETURN_IF_ERROR(res.status());
+            _records = std::move(res).value();
+        }
+        size_t nread = std::min<size_t>(size, _records->remaining());
+        _records->get_bytes(static_cast<char*>(data), nread);
+        return nread;
+    }
     bool eof = false;
     size_t nread = size;
     RETURN_IF_ERROR(_pipe->read(static_cast<uint8_t*>(data), &nread, &eof));
@@ -34,9 +34,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <deque>
 #include <mutex>
+#include <string>
 
 #include "io/input_stream.h"
 #include "runtime/message_body_sink.h"
@@ -70,8 +72,25 @@ public:
 
     Status no_block_read(uint8_t* data, size_t* data_size, bool* eof);
 
-    // called when consumer finished
-    void close() { cancel(Status::OK()); }
+    // Read a buffer consisting of complete records ending with |record_delimiter|, except that the last record of
+    // the pipe may have no delimiter. So that several readers can parse the records of the pipe in parallel.
+    // Every buffer read is searched for the first and the last delimiters, the records across two buffers are
+    // copied into a new buffer, while the others are returned without copying.
+    StatusOr<ByteBufferPtr> read_records(const std::string& record_delimiter);
+
+    // The number of the parsers reading this pipe in parallel by read_records.
+    void set_num_parsers(int num_parsers) { _num_parsers = num_parsers; }
+    int num_parsers() const { return _num_parsers; }
+
+    // called when a consumer is created, see close().
+    void add_reader() { _num_readers++; }
+
+    // called when consumer finished, the pipe is closed once all the consumers are finished.
+    void close() {
+        if (_num_readers.fetch_sub(1) <= 1) {
+            cancel(Status::OK());
+        }
+    }
 
     // called when producer finished
     Status finish() override;
@@ -81,6 +100,11 @@ public:
 
     void set_non_blocking_read() { _non_blocking_read = true; }
 
+protected:
+    // Append the data written by append(const char*, size_t) but not appended yet, so that a buffer appended by
+    // append(ByteBufferPtr&&) later is read after them.
+    Status _flush_write_buf();
+
 private:
     Status _append(const ByteBufferPtr& buf);
 
@@ -106,6 +130,15 @@ private:
     ByteBufferPtr _write_buf;
     ByteBufferPtr _read_buf;
     Status _err_st = Status::OK();
+
+    int _num_parsers = 1;
+    std::atomic<int> _num_readers{0};
+    // Serializes read_records.
+    std::mutex _records_lock;
+    // The records of the last buffer read, after the record across it and the previous one.
+    ByteBufferPtr _pending_records;
+    // The last incomplete record read.
+    ByteBufferPtr _partial_record;
 };
 
 // TODO: Make `StreamLoadPipe` as a derived class of `io::InputStream`.
@@ -120,8 +153,14 @@ public:
 
     std::shared_ptr<StreamLoadPipe> pipe() { return _pipe; }
 
+    // Read the complete records ending with |record_delimiter| only, see StreamLoadPipe::read_records.
+    // Must be set before reading.
+    void set_record_delimiter(std::string record_delimiter) { _record_delimiter = std::move(record_delimiter); }
+
 private:
     std::shared_ptr<StreamLoadPipe> _pipe;
+    std::string _record_delimiter;
+    ByteBufferPtr _records;
 };
 
 } // namespace starrocks
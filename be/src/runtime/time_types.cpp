@@ -17,6 +17,7 @@
 #include <string>
 
 #include "gutil/strings/substitute.h"
+#include "util/fixed_layout_parser.h"
 #include "util/raw_container.h"
 
 namespace starrocks {
@@ -301,25 +302,9 @@ bool date::from_string(const char* date_str, size_t len, int* year, int* month,
 // Get date base on format "%Y-%m-%d", '-' means any char.
 // compare every char.
 bool date::from_string_to_date_internal(const char* ptr, int* year, int* month, int* day) {
-    uint8_t year1;
-    uint8_t year2;
-    uint8_t year3;
-    uint8_t year4;
-    uint8_t month1;
-    uint8_t month2;
-    uint8_t day1;
-    uint8_t day2;
-    if (char_to_digit(ptr, 0, &year1) || char_to_digit(ptr, 1, &year2) || char_to_digit(ptr, 2, &year3) ||
-        char_to_digit(ptr, 3, &year4) || isdigit(ptr[4]) || char_to_digit(ptr, 5, &month1) ||
-        char_to_digit(ptr, 6, &month2) || isdigit(ptr[7]) || char_to_digit(ptr, 8, &day1) ||
-        char_to_digit(ptr, 9, &day2)) {
+    if (!FixedLayoutParser::parse_date(ptr, year, month, day)) {
         return false;
     }
-
-    *year = year1 * 1000 + year2 * 100 + year3 * 10 + year4;
-    *month = month1 * 10 + month2;
-    *day = day1 * 10 + day2;
-
     if (*month > 12 || (*day > DAYS_IN_MONTH[is_leap(*year)][*month])) {
         return false;
     }
@@ -386,37 +371,10 @@ bool date::is_standard_datetime_format(const char* ptr, int length, const char**
 // else return false;
 bool date::from_string_to_datetime_internal(const char* ptr_date, const char* ptr_time, int* year, int* month, int* day,
                                             int* hour, int* minute, int* second, int* microsecond) {
-    uint8_t year1;
-    uint8_t year2;
-    uint8_t year3;
-    uint8_t year4;
-    uint8_t month1;
-    uint8_t month2;
-    uint8_t day1;
-    uint8_t day2;
-
-    uint8_t hour1;
-    uint8_t hour2;
-    uint8_t minute1;
-    uint8_t minute2;
-    uint8_t second1;
-    uint8_t second2;
-    if (char_to_digit(ptr_date, 0, &year1) || char_to_digit(ptr_date, 1, &year2) ||
-        char_to_digit(ptr_date, 2, &year3) || char_to_digit(ptr_date, 3, &year4) || isdigit(ptr_date[4]) ||
-        char_to_digit(ptr_date, 5, &month1) || char_to_digit(ptr_date, 6, &month2) || isdigit(ptr_date[7]) ||
-        char_to_digit(ptr_date, 8, &day1) || char_to_digit(ptr_date, 9, &day2) || char_to_digit(ptr_time, 0, &hour1) ||
-        char_to_digit(ptr_time, 1, &hour2) || isdigit(ptr_time[2]) || char_to_digit(ptr_time, 3, &minute1) ||
-        char_to_digit(ptr_time, 4, &minute2) || isdigit(ptr_time[5]) || char_to_digit(ptr_time, 6, &second1) ||
-        char_to_digit(ptr_time, 7, &second2)) {
+    if (!FixedLayoutParser::parse_date(ptr_date, year, month, day) ||
+        !FixedLayoutParser::parse_time(ptr_time, hour, minute, second)) {
         return false;
     }
-
-    *year = year1 * 1000 + year2 * 100 + year3 * 10 + year4;
-    *month = month1 * 10 + month2;
-    *day = day1 * 10 + day2;
-    *hour = hour1 * 10 + hour2;
-    *minute = minute1 * 10 + minute2;
-    *second = second1 * 10 + second2;
     *microsecond = 0;
     if (*month > 12 || (*day > DAYS_IN_MONTH[is_leap(*year)][*month]) || *hour > 23 || *minute > 59 || *second > 59) {
         return false;
@@ -463,9 +421,17 @@ bool date::from_string_to_datetime(const char* date_str, size_t len, int* year,
             return from_string(date_str, len, year, month, day, hour, minute, second, microsecond);
         }
         return result;
-    } else {
-        return from_string(date_str, len, year, month, day, hour, minute, second, microsecond);
     }
+
+    // maybe It like "%Y-%m-%d %H:%i:%s.%f" with at most 6 digits of fraction, the values are the same as parsed by
+    // the uncommon approach.
+    if (length > 20 && length <= 26 && ptr[4] == '-' && ptr[7] == '-' && (ptr[10] == ' ' || ptr[10] == 'T') &&
+        ptr[13] == ':' && ptr[16] == ':' && ptr[19] == '.' && FixedLayoutParser::parse_date(ptr, year, month, day) &&
+        FixedLayoutParser::parse_time(ptr + 11, hour, minute, second) &&
+        FixedLayoutParser::parse_microsecond(ptr + 20, length - 20, microsecond)) {
+        return true;
+    }
+    return from_string(date_str, len, year, month, day, hour, minute, second, microsecond);
 }
 
 JulianDate date::from_date(int year, int month, int day) {
@@ -26,6 +26,7 @@
 #include "column/const_column.h"
 #include "column/decimalv3_column.h"
 #include "column/fixed_length_column.h"
+#include "column/hash_set.h"
 #include "column/json_column.h"
 #include "column/map_column.h"
 #include "column/nullable_column.h"
@@ -34,6 +35,7 @@
 #include "gutil/strings/substitute.h"
 #include "runtime/descriptors.h"
 #include "serde/protobuf_serde.h"
+#include "simd/null_bitmap.h"
 #include "types/hll.h"
 #include "util/coding.h"
 #include "util/json.h"
@@ -193,13 +195,29 @@ public:
     }
 };
 
+// If dictionary encoding is enabled, a binary column starts with the number of the dictionary words, 0 means the
+// column is not dictionary encoded and the plain layout follows. Otherwise, the code width and the number of rows
+// follow, and then the dictionary in the plain layout, and the 1 or 2 bytes code of every row.
 class BinaryColumnSerde {
 public:
+    // The codes are at most 2 bytes.
+    static constexpr size_t kMaxDictWords = 1 << 16;
+    // The columns of fewer rows are not worth dictionary encoding.
+    static constexpr size_t kDictMinRows = 64;
+    // Give up dictionary encoding if the first kDictProbeRows rows are already of more than half distinct
+    // values, to avoid hashing the whole high cardinality column.
+    static constexpr size_t kDictProbeRows = 1024;
+
     template <typename T>
     static int64_t max_serialized_size(const BinaryColumnBase<T>& column, const int encode_level) {
         const auto& bytes = column.get_bytes();
         const auto& offsets = column.get_offset();
         int64_t res = sizeof(T) * 2;
+        if (EncodeContext::enable_encode_dict(encode_level)) {
+            // A column is dictionary encoded only if there are at most half as many words as rows, so the
+            // dictionary plus the codes are no larger than the offsets, except the header.
+            res += sizeof(uint32_t) * 3;
+        }
         int64_t offsets_size = offsets.size() * sizeof(typename BinaryColumnBase<T>::Offset);
         if (EncodeContext::enable_encode_integer(encode_level) && offsets_size >= ENCODE_SIZE_LIMIT) {
             res += sizeof(uint64_t) +
@@ -217,6 +235,13 @@ public:
 
     template <typename T>
     static uint8_t* serialize(const BinaryColumnBase<T>& column, uint8_t* buff, const int encode_level) {
+        if (EncodeContext::enable_encode_dict(encode_level)) {
+            uint8_t* end = _serialize_dict(column, buff, encode_level);
+            if (end != nullptr) {
+                return end;
+            }
+            buff = write_little_endian_32(0, buff);
+        }
         const auto& bytes = column.get_bytes();
         const auto& offsets = column.get_offset();
 
@@ -253,6 +278,13 @@ public:
 
     template <typename T>
     static const uint8_t* deserialize(const uint8_t* buff, BinaryColumnBase<T>* column, const int encode_level) {
+        if (EncodeContext::enable_encode_dict(encode_level)) {
+            uint32_t num_words = 0;
+            buff = read_little_endian_32(buff, &num_words);
+            if (num_words > 0) {
+                return _deserialize_dict(buff, num_words, column, encode_level);
+            }
+        }
         T bytes_size = 0;
         if constexpr (std::is_same_v<T, uint32_t>) {
             buff = read_little_endian_32(buff, &bytes_size);
@@ -284,6 +316,90 @@ public:
         }
         return buff;
     }
+
+private:
+    // Return nullptr if the column is not worth dictionary encoding.
+    template <typename T>
+    static uint8_t* _serialize_dict(const BinaryColumnBase<T>& column, uint8_t* buff, const int encode_level) {
+        const size_t num_rows = column.size();
+        if (num_rows < kDictMinRows) {
+            return nullptr;
+        }
+        const size_t max_words = std::min(num_rows / 2, kMaxDictWords);
+        const size_t probe_rows = std::min(num_rows, kDictProbeRows);
+
+        phmap::flat_hash_map<Slice, uint16_t, SliceHash, SliceNormalEqual> word_codes;
+        BinaryColumnBase<T> words;
+        std::vector<uint16_t> codes(num_rows);
+        for (size_t i = 0; i < num_rows; i++) {
+            Slice value = column.get_slice(i);
+            auto [iter, inserted] = word_codes.try_emplace(value, static_cast<uint16_t>(words.size()));
+            if (inserted) {
+                if (words.size() == max_words) {
+                    return nullptr;
+                }
+                words.append(value);
+            }
+            codes[i] = iter->second;
+            if (i + 1 == probe_rows && words.size() * 2 > probe_rows) {
+                return nullptr;
+            }
+        }
+
+        const uint32_t code_width = words.size() <= (1 << 8) ? 1 : 2;
+        buff = write_little_endian_32(words.size(), buff);
+        buff = write_little_endian_32(code_width, buff);
+        buff = write_little_endian_32(num_rows, buff);
+        buff = serialize(words, buff, EncodeContext::disable_encode_dict(encode_level));
+        if (code_width == 1) {
+            for (size_t i = 0; i < num_rows; i++) {
+                buff[i] = static_cast<uint8_t>(codes[i]);
+            }
+            buff += num_rows;
+        } else {
+            for (size_t i = 0; i < num_rows; i++) {
+                encode_fixed16_le(buff + i * 2, codes[i]);
+            }
+            buff += num_rows * 2;
+        }
+        return buff;
+    }
+
+    template <typename T>
+    static const uint8_t* _deserialize_dict(const uint8_t* buff, uint32_t num_words, BinaryColumnBase<T>* column,
+                                            const int encode_level) {
+        uint32_t code_width = 0;
+        uint32_t num_rows = 0;
+        buff = read_little_endian_32(buff, &code_width);
+        buff = read_little_endian_32(buff, &num_rows);
+        BinaryColumnBase<T> words;
+        buff = deserialize(buff, &words, EncodeContext::disable_encode_dict(encode_level));
+        if (words.size() != num_words || (code_width != 1 && code_width != 2)) {
+            throw std::runtime_error(fmt::format("invalid dictionary, words = {}, expected words = {}, code width = {}",
+                                                 words.size(), num_words, code_width));
+        }
+
+        auto code_at = [&](size_t i) -> uint32_t {
+            return code_width == 1 ? buff[i] : decode_fixed16_le(buff + i * 2);
+        };
+        auto& offsets = column->get_offset();
+        raw::make_room(&offsets, num_rows + 1);
+        offsets[0] = 0;
+        for (size_t i = 0; i < num_rows; i++) {
+            uint32_t code = code_at(i);
+            if (UNLIKELY(code >= num_words)) {
+                throw std::runtime_error(fmt::format("invalid dictionary code {}, words = {}", code, num_words));
+            }
+            offsets[i + 1] = offsets[i] + words.get_slice(code).size;
+        }
+        auto& bytes = column->get_bytes();
+        raw::make_room(&bytes, offsets[num_rows]);
+        for (size_t i = 0; i < num_rows; i++) {
+            Slice word = words.get_slice(code_at(i));
+            strings::memcpy_inlined(bytes.data() + offsets[i], word.data, word.size);
+        }
+        return buff + static_cast<size_t>(num_rows) * code_width;
+    }
 };
 
 template <typename T>
@@ -378,21 +494,53 @@ public:
     }
 };
 
+// If the null bitmap encoding is enabled, a nullable column starts with the number of rows and whether it has
+// null, and the null bitmap follows only if it has null.
 class NullableColumnSerde {
 public:
     static int64_t max_serialized_size(const NullableColumn& column, const int encode_level) {
-        return serde::ColumnArraySerde::max_serialized_size(*column.null_column(), encode_level) +
-               serde::ColumnArraySerde::max_serialized_size(*column.data_column(), encode_level);
+        int64_t null_size = 0;
+        if (EncodeContext::enable_encode_null_bitmap(encode_level)) {
+            null_size = sizeof(uint32_t) * 2 + SIMD::null_bitmap_size(column.size());
+        } else {
+            null_size = serde::ColumnArraySerde::max_serialized_size(*column.null_column(), encode_level);
+        }
+        return null_size + serde::ColumnArraySerde::max_serialized_size(*column.data_column(), encode_level);
     }
 
     static uint8_t* serialize(const NullableColumn& column, uint8_t* buff, const int encode_level) {
-        buff = serde::ColumnArraySerde::serialize(*column.null_column(), buff, false, encode_level);
+        if (EncodeContext::enable_encode_null_bitmap(encode_level)) {
+            const auto& nulls = column.immutable_null_column_data();
+            buff = write_little_endian_32(nulls.size(), buff);
+            buff = write_little_endian_32(column.has_null(), buff);
+            if (column.has_null()) {
+                SIMD::pack_null_bitmap(nulls.data(), nulls.size(), buff);
+                buff += SIMD::null_bitmap_size(nulls.size());
+            }
+        } else {
+            buff = serde::ColumnArraySerde::serialize(*column.null_column(), buff, false, encode_level);
+        }
         buff = serde::ColumnArraySerde::serialize(*column.data_column(), buff, false, encode_level);
         return buff;
     }
 
     static const uint8_t* deserialize(const uint8_t* buff, NullableColumn* column, const int encode_level) {
-        buff = serde::ColumnArraySerde::deserialize(buff, column->null_column().get(), false, encode_level);
+        if (EncodeContext::enable_encode_null_bitmap(encode_level)) {
+            uint32_t num_rows = 0;
+            uint32_t has_null = 0;
+            buff = read_little_endian_32(buff, &num_rows);
+            buff = read_little_endian_32(buff, &has_null);
+            auto& nulls = column->null_column_data();
+            raw::make_room(&nulls, num_rows);
+            if (has_null) {
+                SIMD::unpack_null_bitmap(buff, num_rows, nulls.data());
+                buff += SIMD::null_bitmap_size(num_rows);
+            } else {
+                memset(nulls.data(), 0, num_rows);
+            }
+        } else {
+            buff = serde::ColumnArraySerde::deserialize(buff, column->null_column().get(), false, encode_level);
+        }
         buff = serde::ColumnArraySerde::deserialize(buff, column->data_column().get(), false, encode_level);
         column->update_has_null();
         return buff;
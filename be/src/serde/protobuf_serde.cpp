@@ -104,31 +104,35 @@ int64_t ProtobufChunkSerde::max_serialized_size(const Chunk& chunk, const std::s
 StatusOr<ChunkPB> ProtobufChunkSerde::serialize(const Chunk& chunk, const std::shared_ptr<EncodeContext>& context) {
     StatusOr<ChunkPB> res = serialize_without_meta(chunk, std::move(context));
     if (!res.ok()) return res.status();
+    serialize_meta(chunk, &res.value());
+    return res;
+}
 
+void ProtobufChunkSerde::serialize_meta(const Chunk& chunk, ChunkPB* chunk_pb) {
     const auto& slot_id_to_index = chunk.get_slot_id_to_index_map();
     const auto& tuple_id_to_index = chunk.get_tuple_id_to_index_map();
     const auto& columns = chunk.columns();
 
-    res->mutable_slot_id_map()->Reserve(static_cast<int>(slot_id_to_index.size()) * 2);
+    chunk_pb->mutable_slot_id_map()->Reserve(static_cast<int>(slot_id_to_index.size()) * 2);
     for (const auto& kv : slot_id_to_index) {
-        res->mutable_slot_id_map()->Add(kv.first);
-        res->mutable_slot_id_map()->Add(static_cast<int>(kv.second));
+        chunk_pb->mutable_slot_id_map()->Add(kv.first);
+        chunk_pb->mutable_slot_id_map()->Add(static_cast<int>(kv.second));
     }
 
-    res->mutable_tuple_id_map()->Reserve(static_cast<int>(tuple_id_to_index.size()) * 2);
+    chunk_pb->mutable_tuple_id_map()->Reserve(static_cast<int>(tuple_id_to_index.size()) * 2);
     for (const auto& kv : tuple_id_to_index) {
-        res->mutable_tuple_id_map()->Add(kv.first);
-        res->mutable_tuple_id_map()->Add(static_cast<int>(kv.second));
+        chunk_pb->mutable_tuple_id_map()->Add(kv.first);
+        chunk_pb->mutable_tuple_id_map()->Add(static_cast<int>(kv.second));
     }
 
-    res->mutable_is_nulls()->Reserve(static_cast<int>(columns.size()));
+    chunk_pb->mutable_is_nulls()->Reserve(static_cast<int>(columns.size()));
     for (const auto& column : columns) {
-        res->mutable_is_nulls()->Add(column->is_nullable());
+        chunk_pb->mutable_is_nulls()->Add(column->is_nullable());
     }
 
-    res->mutable_is_consts()->Reserve(static_cast<int>(columns.size()));
+    chunk_pb->mutable_is_consts()->Reserve(static_cast<int>(columns.size()));
     for (const auto& column : columns) {
-        res->mutable_is_consts()->Add(column->is_constant());
+        chunk_pb->mutable_is_consts()->Add(column->is_constant());
     }
 
     DCHECK_EQ(columns.size(), tuple_id_to_index.size() + slot_id_to_index.size());
@@ -138,31 +142,31 @@ StatusOr<ChunkPB> ProtobufChunkSerde::serialize(const Chunk& chunk, const std::s
             chunk.get_extra_data() ? dynamic_cast<ChunkExtraColumnsData*>(chunk.get_extra_data().get()) : nullptr;
     if (chunk_extra_data) {
         auto extra_data_metas = chunk_extra_data->chunk_data_metas();
-        res->mutable_extra_data_metas()->Reserve(extra_data_metas.size());
+        chunk_pb->mutable_extra_data_metas()->Reserve(extra_data_metas.size());
         for (auto& data_meta : extra_data_metas) {
-            auto* extra_data_meta_pb = res->add_extra_data_metas();
+            auto* extra_data_meta_pb = chunk_pb->add_extra_data_metas();
             *(extra_data_meta_pb->mutable_type_desc()) = data_meta.type.to_protobuf();
             extra_data_meta_pb->set_is_const(data_meta.is_const);
             extra_data_meta_pb->set_is_null(data_meta.is_null);
         }
     }
-    return res;
 }
 
-StatusOr<ChunkPB> ProtobufChunkSerde::serialize_without_meta(const Chunk& chunk,
-                                                             const std::shared_ptr<EncodeContext>& context) {
-    ChunkPB chunk_pb;
-    chunk_pb.set_compress_type(CompressionTypePB::NO_COMPRESSION);
-
-    std::string* serialized_data = chunk_pb.mutable_data();
+int64_t ProtobufChunkSerde::max_serialized_data_size(const Chunk& chunk,
+                                                     const std::shared_ptr<EncodeContext>& context) {
     auto max_serialized_size = ProtobufChunkSerde::max_serialized_size(chunk, context);
     auto* chunk_extra_data =
             chunk.get_extra_data() ? dynamic_cast<ChunkExtraColumnsData*>(chunk.get_extra_data().get()) : nullptr;
     if (chunk_extra_data) {
         max_serialized_size += chunk_extra_data->max_serialized_size(0);
     }
-    raw::stl_string_resize_uninitialized(serialized_data, max_serialized_size);
-    auto* buff = reinterpret_cast<uint8_t*>(serialized_data->data());
+    return max_serialized_size + EncodeContext::STREAMVBYTE_PADDING_SIZE;
+}
+
+StatusOr<size_t> ProtobufChunkSerde::serialize_data(const Chunk& chunk, const std::shared_ptr<EncodeContext>& context,
+                                                    uint8_t* data, ChunkPB* chunk_pb) {
+    chunk_pb->set_compress_type(CompressionTypePB::NO_COMPRESSION);
+    auto* buff = data;
     encode_fixed32_le(buff + 0, 1);
     encode_fixed32_le(buff + 4, chunk.num_rows());
     buff = buff + 8;
@@ -186,18 +190,31 @@ StatusOr<ChunkPB> ProtobufChunkSerde::serialize_without_meta(const Chunk& chunk,
     }
 
     // do serialize extra data
+    auto* chunk_extra_data =
+            chunk.get_extra_data() ? dynamic_cast<ChunkExtraColumnsData*>(chunk.get_extra_data().get()) : nullptr;
     if (chunk_extra_data) {
         buff = chunk_extra_data->serialize(buff);
     }
-    chunk_pb.set_serialized_size(buff - reinterpret_cast<const uint8_t*>(serialized_data->data()));
-    serialized_data->resize(chunk_pb.serialized_size() + padding_size);
-    chunk_pb.set_uncompressed_size(serialized_data->size());
+    chunk_pb->set_serialized_size(buff - data);
+    memset(buff, 0, padding_size);
+    chunk_pb->set_uncompressed_size(chunk_pb->serialized_size() + padding_size);
     if (context) {
         VLOG_ROW << "pb serialize data, memory bytes = " << chunk.bytes_usage()
-                 << " serialized size = " << chunk_pb.serialized_size()
-                 << " uncompressed size = " << chunk_pb.uncompressed_size()
-                 << " serialize ratio = " << chunk_pb.serialized_size() * 1.0 / chunk.bytes_usage();
+                 << " serialized size = " << chunk_pb->serialized_size()
+                 << " uncompressed size = " << chunk_pb->uncompressed_size()
+                 << " serialize ratio = " << chunk_pb->serialized_size() * 1.0 / chunk.bytes_usage();
     }
+    return chunk_pb->uncompressed_size();
+}
+
+StatusOr<ChunkPB> ProtobufChunkSerde::serialize_without_meta(const Chunk& chunk,
+                                                             const std::shared_ptr<EncodeContext>& context) {
+    ChunkPB chunk_pb;
+    std::string* serialized_data = chunk_pb.mutable_data();
+    raw::stl_string_resize_uninitialized(serialized_data, max_serialized_data_size(chunk, context));
+    auto* buff = reinterpret_cast<uint8_t*>(serialized_data->data());
+    ASSIGN_OR_RETURN(auto size, serialize_data(chunk, context, buff, &chunk_pb));
+    serialized_data->resize(size);
     return std::move(chunk_pb);
 }
 
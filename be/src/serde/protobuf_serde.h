@@ -63,9 +63,19 @@ public:
 
     static bool enable_encode_string(const int encode_level) { return encode_level & ENCODE_STRING; }
 
+    // Low cardinality binary columns are sent as a dictionary plus the codes of the rows.
+    static bool enable_encode_dict(const int encode_level) { return encode_level & ENCODE_DICT; }
+
+    static int disable_encode_dict(const int encode_level) { return encode_level & ~ENCODE_DICT; }
+
+    // The null flags of nullable columns are sent as a bitmap, and omitted if the column has no null.
+    static bool enable_encode_null_bitmap(const int encode_level) { return encode_level & ENCODE_NULL_BITMAP; }
+
 private:
     static constexpr int ENCODE_INTEGER = 2;
     static constexpr int ENCODE_STRING = 4;
+    static constexpr int ENCODE_DICT = 8;
+    static constexpr int ENCODE_NULL_BITMAP = 16;
 
     // if encode ratio < EncodeRatioLimit, encode it, otherwise not.
     void _adjust(const int col_id);
@@ -94,6 +104,18 @@ public:
     static StatusOr<ChunkPB> serialize_without_meta(const Chunk& chunk,
                                                     const std::shared_ptr<EncodeContext>& context = nullptr);
 
+    // Fill the meta fields of |chunk_pb| left by `serialize_without_meta()`.
+    static void serialize_meta(const Chunk& chunk, ChunkPB* chunk_pb);
+
+    // The max bytes written by `serialize_data()`, including the padding.
+    static int64_t max_serialized_data_size(const Chunk& chunk,
+                                            const std::shared_ptr<EncodeContext>& context = nullptr);
+
+    // Like `serialize_without_meta()` but write the data into |data| rather than ChunkPB.data, so the caller can
+    // own the buffer, e.g. a brpc attachment. Return the bytes written, which equals to uncompressed_size.
+    static StatusOr<size_t> serialize_data(const Chunk& chunk, const std::shared_ptr<EncodeContext>& context,
+                                           uint8_t* data, ChunkPB* chunk_pb);
+
     // REQUIRE: the following fields of |chunk_pb| must be non-empty:
     //  - slot_id_map()
     //  - tuple_id_map()
@@ -155,7 +155,7 @@ void PInternalServiceImplBase<T>::_transmit_chunk(google::protobuf::RpcControlle
     }
     Status st;
     st.to_protobuf(response->mutable_status());
-    TRY_CATCH_ALL(st, _exec_env->stream_mgr()->transmit_chunk(*request, &done));
+    TRY_CATCH_ALL(st, _exec_env->stream_mgr()->transmit_chunk(*request, &done, response));
     if (!st.ok()) {
         LOG(WARNING) << "transmit_data failed, message=" << st.get_error_msg()
                      << ", fragment_instance_id=" << print_id(request->finst_id()) << ", node=" << request->node_id();
@@ -442,19 +442,31 @@ template <typename T>
 void PInternalServiceImplBase<T>::fetch_data(google::protobuf::RpcController* cntl_base,
                                              const PFetchDataRequest* request, PFetchDataResult* result,
                                              google::protobuf::Closure* done) {
-    auto task = [=]() { this->_fetch_data(cntl_base, request, result, done); };
+    auto task = [=]() { this->_fetch_data(cntl_base, request, result, done, false); };
     if (!_exec_env->query_rpc_pool()->try_offer(std::move(task))) {
         ClosureGuard closure_guard(done);
         Status::ServiceUnavailable("submit fetch_data task failed").to_protobuf(result->mutable_status());
     }
 }
 
+template <typename T>
+void PInternalServiceImplBase<T>::fetch_arrow_data(google::protobuf::RpcController* cntl_base,
+                                                   const PFetchDataRequest* request, PFetchDataResult* result,
+                                                   google::protobuf::Closure* done) {
+    auto task = [=]() { this->_fetch_data(cntl_base, request, result, done, true); };
+    if (!_exec_env->query_rpc_pool()->try_offer(std::move(task))) {
+        ClosureGuard closure_guard(done);
+        Status::ServiceUnavailable("submit fetch_arrow_data task failed").to_protobuf(result->mutable_status());
+    }
+}
+
 template <typename T>
 void PInternalServiceImplBase<T>::_fetch_data(google::protobuf::RpcController* cntl_base,
                                               const PFetchDataRequest* request, PFetchDataResult* result,
-                                              google::protobuf::Closure* done) {
+                                              google::protobuf::Closure* done, bool raw_rows) {
     auto* cntl = static_cast<brpc::Controller*>(cntl_base);
     auto* ctx = new GetResultBatchCtx(cntl, result, done);
+    ctx->raw_rows = raw_rows;
     _exec_env->result_mgr()->fetch_data(request->finst_id(), ctx);
 }
 
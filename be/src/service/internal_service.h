@@ -86,6 +86,9 @@ public:
     void fetch_data(google::protobuf::RpcController* controller, const PFetchDataRequest* request,
                     PFetchDataResult* result, google::protobuf::Closure* done) override;
 
+    void fetch_arrow_data(google::protobuf::RpcController* controller, const PFetchDataRequest* request,
+                          PFetchDataResult* result, google::protobuf::Closure* done) override;
+
     void tablet_writer_open(google::protobuf::RpcController* controller, const PTabletWriterOpenRequest* request,
                             PTabletWriterOpenResult* response, google::protobuf::Closure* done) override;
 
@@ -170,7 +173,7 @@ private:
                                PCancelPlanFragmentResult* result, google::protobuf::Closure* done);
 
     void _fetch_data(google::protobuf::RpcController* controller, const PFetchDataRequest* request,
-                     PFetchDataResult* result, google::protobuf::Closure* done);
+                     PFetchDataResult* result, google::protobuf::Closure* done, bool raw_rows);
 
     void _get_info_impl(const PProxyRequest* request, PProxyResult* response,
                         GenericCountDownLatch<bthread::Mutex, bthread::ConditionVariable>* latch, int timeout_ms);
@@ -40,11 +40,13 @@
 #include "http/action/compact_rocksdb_meta_action.h"
 #include "http/action/compaction_action.h"
 #include "http/action/health_action.h"
+#include "http/action/lake_cache_warmup_action.h"
 #include "http/action/meta_action.h"
 #include "http/action/metrics_action.h"
 #include "http/action/pipeline_blocking_drivers_action.h"
 #include "http/action/pprof_actions.h"
 #include "http/action/query_cache_action.h"
+#include "http/action/query_cpu_profile_action.h"
 #include "http/action/reload_tablet_action.h"
 #include "http/action/restore_tablet_action.h"
 #include "http/action/runtime_filter_cache_action.h"
@@ -232,11 +234,20 @@ Status HttpServiceBE::start() {
     _ev_http_server->register_handler(HttpMethod::PUT, "/api/query_cache/{action}", query_cache_action);
     _http_handlers.emplace_back(query_cache_action);
 
+    auto* lake_cache_warmup_action = new LakeCacheWarmupAction(_env);
+    _ev_http_server->register_handler(HttpMethod::GET, "/api/lake/cache_warmup", lake_cache_warmup_action);
+    _ev_http_server->register_handler(HttpMethod::POST, "/api/lake/cache_warmup", lake_cache_warmup_action);
+    _http_handlers.emplace_back(lake_cache_warmup_action);
+
     auto* pipeline_driver_poller_action = new PipelineBlockingDriversAction(_env);
     _ev_http_server->register_handler(HttpMethod::GET, "/api/pipeline_blocking_drivers/{action}",
                                       pipeline_driver_poller_action);
     _http_handlers.emplace_back(pipeline_driver_poller_action);
 
+    auto* query_cpu_profile_action = new QueryCpuProfileAction();
+    _ev_http_server->register_handler(HttpMethod::GET, "/api/query_cpu_profile/{action}", query_cpu_profile_action);
+    _http_handlers.emplace_back(query_cpu_profile_action);
+
     RETURN_IF_ERROR(_ev_http_server->start());
     return Status::OK();
 }
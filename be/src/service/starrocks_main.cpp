@@ -231,6 +231,8 @@ int main(int argc, char** argv) {
         cache_options.checksum = starrocks::config::block_cache_checksum_enable;
         cache_options.max_parcel_memory_mb = starrocks::config::block_cache_max_parcel_memory_mb;
         cache_options.max_concurrent_inserts = starrocks::config::block_cache_max_concurrent_inserts;
+        cache_options.async_write_threads = starrocks::config::block_cache_async_write_threads;
+        cache_options.async_write_buffer_size = starrocks::config::block_cache_async_write_buffer_size;
         cache->init(cache_options);
     }
 #endif
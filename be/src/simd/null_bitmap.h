@@ -0,0 +1,149 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__) || defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+// A null bitmap packs the null flags of the rows into one bit per row, the row i is the bit (i % 8) of the
+// byte (i / 8), and the bits beyond the rows of the last byte are always zero. It takes 1/8 of the memory of
+// a byte map like NullColumn, so it's used where the null flags are moved around in bulk, e.g. serialization.
+namespace SIMD {
+
+inline size_t null_bitmap_size(size_t num_rows) {
+    return (num_rows + 7) / 8;
+}
+
+namespace detail {
+
+// Pack at most 8 flags into the bits of a byte.
+inline uint8_t pack_byte(const uint8_t* data, size_t size) {
+    uint8_t bits = 0;
+    for (size_t i = 0; i < size; i++) {
+        bits |= static_cast<uint8_t>(data[i] != 0) << i;
+    }
+    return bits;
+}
+
+} // namespace detail
+
+// Pack the flags |data| of |size| rows into |bitmap|, a row is set if its flag is nonzero.
+inline void pack_null_bitmap(const uint8_t* data, size_t size, uint8_t* bitmap) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i zero32 = _mm256_setzero_si256();
+    for (; i + 32 <= size; i += 32) {
+        auto zeros = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), zero32);
+        uint32_t bits = ~static_cast<uint32_t>(_mm256_movemask_epi8(zeros));
+        memcpy(bitmap + i / 8, &bits, sizeof(bits));
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i zero16 = _mm_setzero_si128();
+    for (; i + 16 <= size; i += 16) {
+        auto zeros = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), zero16);
+        uint16_t bits = ~static_cast<uint16_t>(_mm_movemask_epi8(zeros));
+        memcpy(bitmap + i / 8, &bits, sizeof(bits));
+    }
+#endif
+    for (; i < size; i += 8) {
+        bitmap[i / 8] = detail::pack_byte(data + i, std::min<size_t>(8, size - i));
+    }
+}
+
+// Unpack |bitmap| of |size| rows into the 0/1 flags |data|.
+inline void unpack_null_bitmap(const uint8_t* bitmap, size_t size, uint8_t* data) {
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        // spread the bit j to the highest bit of the byte j, then shift it to the lowest bit
+        uint64_t spread = (bitmap[i / 8] * 0x0101010101010101ULL) & 0x8040201008040201ULL;
+        uint64_t flags = ((spread + 0x7F7F7F7F7F7F7F7FULL) & 0x8080808080808080ULL) >> 7;
+        memcpy(data + i, &flags, sizeof(flags));
+    }
+    for (; i < size; i++) {
+        data[i] = (bitmap[i / 8] >> (i % 8)) & 1;
+    }
+}
+
+// Count the set rows of |bitmap| of |size| rows.
+inline size_t count_null_bitmap(const uint8_t* bitmap, size_t size) {
+    const size_t num_bytes = null_bitmap_size(size);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 8 <= num_bytes; i += 8) {
+        uint64_t word;
+        memcpy(&word, bitmap + i, sizeof(word));
+        count += __builtin_popcountll(word);
+    }
+    for (; i < num_bytes; i++) {
+        count += __builtin_popcount(bitmap[i]);
+    }
+    return count;
+}
+
+// Merge the nulls of |src| into |dst|, both of |size| rows, a row is null if it's null in either of them.
+inline void merge_null_bitmap(uint8_t* dst, const uint8_t* src, size_t size) {
+    const size_t num_bytes = null_bitmap_size(size);
+    size_t i = 0;
+    for (; i + 8 <= num_bytes; i += 8) {
+        uint64_t lhs;
+        uint64_t rhs;
+        memcpy(&lhs, dst + i, sizeof(lhs));
+        memcpy(&rhs, src + i, sizeof(rhs));
+        lhs |= rhs;
+        memcpy(dst + i, &lhs, sizeof(lhs));
+    }
+    for (; i < num_bytes; i++) {
+        dst[i] |= src[i];
+    }
+}
+
+// Keep the rows of |bitmap| of |size| rows whose |filter| are nonzero and write them to |dst| compactly,
+// |dst| must hold null_bitmap_size(size) bytes. Return the number of the kept rows.
+inline size_t filter_null_bitmap(const uint8_t* bitmap, size_t size, const uint8_t* filter, uint8_t* dst) {
+    memset(dst, 0, null_bitmap_size(size));
+    size_t kept = 0;
+    for (size_t i = 0; i < size; i += 8) {
+        const size_t n = std::min<size_t>(8, size - i);
+        const uint32_t selected = detail::pack_byte(filter + i, n);
+#if defined(__BMI2__)
+        const uint32_t bits = _pext_u32(bitmap[i / 8], selected);
+#else
+        uint32_t bits = 0;
+        for (uint32_t mask = selected, j = 0; mask != 0; mask &= mask - 1, j++) {
+            bits |= ((bitmap[i / 8] >> __builtin_ctz(mask)) & 1) << j;
+        }
+#endif
+        // the kept bits span at most two bytes of |dst|
+        const size_t shift = kept % 8;
+        dst[kept / 8] |= static_cast<uint8_t>(bits << shift);
+        const size_t num_selected = __builtin_popcount(selected);
+        if (shift + num_selected > 8) {
+            dst[kept / 8 + 1] |= static_cast<uint8_t>(bits >> (8 - shift));
+        }
+        kept += num_selected;
+    }
+    return kept;
+}
+
+} // namespace SIMD
@@ -14,6 +14,7 @@
 
 #include "storage/binlog_reader.h"
 
+#include <limits>
 #include <utility>
 
 #include "column/datum.h"
@@ -85,6 +86,32 @@ Status BinlogReader::seek(int64_t version, int64_t seq_id) {
 }
 
 Status BinlogReader::get_next(ChunkPtr* chunk, int64_t max_version_exclusive) {
+    if (!_deferred_status.ok()) {
+        Status status = std::move(_deferred_status);
+        _deferred_status = Status::OK();
+        return status;
+    }
+    bool read = false;
+    RETURN_IF_ERROR(_read_log_entry(chunk->get(), max_version_exclusive, std::numeric_limits<int64_t>::max(), &read));
+    DCHECK(read);
+    // Coalesce the following log entries fitting in the chunk, e.g. the log entries of the small loads,
+    // the error when reading them is returned by the next call.
+    while ((*chunk)->num_rows() < _reader_params.chunk_size) {
+        int64_t max_rows = _reader_params.chunk_size - (*chunk)->num_rows();
+        Status status = _read_log_entry(chunk->get(), max_version_exclusive, max_rows, &read);
+        if (status.is_end_of_file() || (status.ok() && !read)) {
+            break;
+        }
+        if (!status.ok()) {
+            _deferred_status = std::move(status);
+            break;
+        }
+    }
+    return Status::OK();
+}
+
+Status BinlogReader::_read_log_entry(Chunk* chunk, int64_t max_version_exclusive, int64_t max_rows, bool* read) {
+    *read = false;
     // Invariant: if _log_entry_info is not nullptr, change event with
     // <_next_version, _next_seq_id> must be in this log entry, otherwise
     // need to find the log entry first
@@ -141,10 +168,25 @@ Status BinlogReader::get_next(ChunkPtr* chunk, int64_t max_version_exclusive) {
     }
 
     LogEntryInfo* log_entry_info = _log_entry_info;
-    _swap_output_and_data_chunk(chunk->get());
-    status = _segment_iterator->get_next(_data_chunk.get());
-    int32_t num_rows = _data_chunk->num_rows();
-    _swap_output_and_data_chunk(chunk->get());
+    if (log_entry_info->end_seq_id - _next_seq_id + 1 > max_rows) {
+        return Status::OK();
+    }
+    *read = true;
+    int32_t num_rows = 0;
+    if (chunk->num_rows() == 0) {
+        _swap_output_and_data_chunk(chunk);
+        status = _segment_iterator->get_next(_data_chunk.get());
+        num_rows = _data_chunk->num_rows();
+        _swap_output_and_data_chunk(chunk);
+    } else {
+        status = _segment_iterator->get_next(_data_chunk.get());
+        num_rows = _data_chunk->num_rows();
+        if (status.ok()) {
+            _append_data_chunk(chunk);
+        } else {
+            _data_chunk->reset();
+        }
+    }
     // sanity check: should not meet the end of file
     if (status.is_end_of_file()) {
         std::string err_msg = fmt::format(
@@ -158,7 +200,7 @@ Status BinlogReader::get_next(ChunkPtr* chunk, int64_t max_version_exclusive) {
     if (!status.ok()) {
         return status;
     }
-    _append_meta_column(chunk->get(), num_rows, log_entry_info->version, log_entry_info->timestamp_in_us, _next_seq_id);
+    _append_meta_column(chunk, num_rows, log_entry_info->version, log_entry_info->timestamp_in_us, _next_seq_id);
     _next_seq_id += num_rows;
     // read all change events in this log entry
     if (_next_seq_id > log_entry_info->end_seq_id) {
@@ -209,6 +251,14 @@ void BinlogReader::_append_meta_column(Chunk* output_chunk, int32_t num_rows, in
     }
 }
 
+void BinlogReader::_append_data_chunk(Chunk* output_chunk) {
+    Columns& output_columns = output_chunk->columns();
+    for (size_t i = 0; i < _data_column_index.size(); i++) {
+        output_columns[_data_column_index[i]]->append(*_data_chunk->get_column_by_index(i));
+    }
+    _data_chunk->reset();
+}
+
 void BinlogReader::_swap_output_and_data_chunk(Chunk* output_chunk) {
     Columns& output_columns = output_chunk->columns();
     for (size_t i = 0; i < _data_column_index.size(); i++) {
@@ -300,6 +350,7 @@ void BinlogReader::_reset() {
     }
 
     _log_entry_info = nullptr;
+    _deferred_status = Status::OK();
 }
 
 void BinlogReader::close() {
@@ -87,6 +87,8 @@ public:
 
     // Get a chunk of change events less than the *max_version_exclusive*.
     // The schema of chunk should be the same with BinlogReaderParams#schema.
+    // The change events of several log entries are returned in one chunk if they
+    // fit in BinlogReaderParams#chunk_size.
     // Return Status::OK() if there is at least one change event in the chunk
     // Return Status::EndOfFile() if there is no more change events, or the
     // version of left change events are no less than *max_version_exclusive*.
@@ -107,11 +109,15 @@ public:
     int64_t reader_id() { return _reader_id; }
 
 private:
+    // Read the change events of the next log entry into |chunk| if they are at most |max_rows|,
+    // |read| tells whether they are read.
+    Status _read_log_entry(Chunk* chunk, int64_t max_version_exclusive, int64_t max_rows, bool* read);
     Status _seek_binlog_file_reader(int64_t version, int64_t seq_id);
     Status _init_segment_iterator();
     void _release_segment_iterator(bool release_rowset);
     void _reset();
     void _swap_output_and_data_chunk(Chunk* output_chunk);
+    void _append_data_chunk(Chunk* output_chunk);
     void _append_meta_column(Chunk* output_chunk, int32_t num_rows, int64_t version, int64_t timestamp,
                              int64_t start_seq_id);
 
@@ -143,6 +149,8 @@ private:
     ChunkIteratorPtr _segment_iterator;
     // the chunk delivered to the segment iterator for get_next()
     ChunkPtr _data_chunk;
+    // the error met when coalescing the log entries, returned by the next get_next()
+    Status _deferred_status;
 
     bool _initialized = false;
     bool _closed = false;
@@ -196,7 +196,7 @@ inline std::shared_ptr<T> get_column_ptr(size_t chunk_size) {
     if constexpr (std::negation_v<HasColumnPool<T>>) {
         return std::make_shared<T>();
     } else {
-        T* ptr = get_column<T, force>();
+        T* ptr = get_column<T, force>(chunk_size);
         if (LIKELY(ptr != nullptr)) {
             return std::shared_ptr<T>(ptr, ColumnDeleter<T>(chunk_size));
         } else {
@@ -500,27 +500,52 @@ void ChunkAccumulator::finalize() {
 void ChunkPipelineAccumulator::push(const ChunkPtr& chunk) {
     chunk->check_or_die();
     DCHECK(_out_chunk == nullptr);
-    if (_in_chunk == nullptr) {
-        _in_chunk = chunk;
-    } else if (_in_chunk->num_rows() + chunk->num_rows() > _max_size) {
-        _out_chunk = std::move(_in_chunk);
-        _in_chunk = chunk;
-    } else {
-        _in_chunk->append(*chunk);
+    const size_t num_rows = chunk->num_rows();
+    const size_t bytes = _max_bytes > 0 ? chunk->bytes_usage() : 0;
+    if (!_segments.empty() &&
+        (_segment_rows + num_rows > _max_size || (_max_bytes > 0 && _segment_bytes + bytes > _max_bytes))) {
+        _out_chunk = _flatten();
+    }
+    _segments.emplace_back(chunk);
+    _segment_rows += num_rows;
+    _segment_bytes += bytes;
+    _segment_memory += chunk->memory_usage();
+
+    if (_out_chunk == nullptr) {
+        bool reach_max_bytes = _max_bytes > 0 && _segment_bytes >= _max_bytes * LOW_WATERMARK_ROWS_RATE;
+        if (_segment_rows >= _max_size * LOW_WATERMARK_ROWS_RATE || _segment_memory >= LOW_WATERMARK_BYTES ||
+            reach_max_bytes) {
+            _out_chunk = _flatten();
+        }
     }
+}
 
-    if (_out_chunk == nullptr && (_in_chunk->num_rows() >= _max_size * LOW_WATERMARK_ROWS_RATE ||
-                                  _in_chunk->memory_usage() >= LOW_WATERMARK_BYTES)) {
-        _out_chunk = std::move(_in_chunk);
+ChunkPtr ChunkPipelineAccumulator::_flatten() {
+    DCHECK(!_segments.empty());
+    ChunkPtr chunk = std::move(_segments[0]);
+    if (_segments.size() > 1) {
+        chunk->append(std::vector<ChunkPtr>(_segments.begin() + 1, _segments.end()));
     }
+    _segments.clear();
+    _segment_rows = 0;
+    _segment_bytes = 0;
+    _segment_memory = 0;
+    return chunk;
 }
 
 void ChunkPipelineAccumulator::reset() {
+    _segments.clear();
+    _segment_rows = 0;
+    _segment_bytes = 0;
+    _segment_memory = 0;
     _in_chunk.reset();
     _out_chunk.reset();
 }
 
 void ChunkPipelineAccumulator::finalize() {
+    if (!_segments.empty()) {
+        _in_chunk = _flatten();
+    }
     _finalized = true;
 }
 
@@ -531,13 +556,17 @@ void ChunkPipelineAccumulator::reset_state() {
 
 ChunkPtr& ChunkPipelineAccumulator::pull() {
     if (_finalized && _out_chunk == nullptr) {
+        // the chunks pushed after finalized
+        if (_in_chunk == nullptr && !_segments.empty()) {
+            _in_chunk = _flatten();
+        }
         return _in_chunk;
     }
     return _out_chunk;
 }
 
 bool ChunkPipelineAccumulator::has_output() const {
-    return _out_chunk != nullptr || (_finalized && _in_chunk != nullptr);
+    return _out_chunk != nullptr || (_finalized && (_in_chunk != nullptr || !_segments.empty()));
 }
 
 bool ChunkPipelineAccumulator::need_input() const {
@@ -545,7 +574,81 @@ bool ChunkPipelineAccumulator::need_input() const {
 }
 
 bool ChunkPipelineAccumulator::is_finished() const {
-    return _finalized && _out_chunk == nullptr && _in_chunk == nullptr;
+    return _finalized && _out_chunk == nullptr && _in_chunk == nullptr && _segments.empty();
+}
+
+ChunkRecycler::ChunkRecycler(const Schema& schema, size_t chunk_size, size_t capacity)
+        : _schema(std::make_shared<Schema>(schema)),
+          _chunk_size(chunk_size),
+          _capacity(capacity),
+          _template(ChunkHelper::new_chunk(*_schema, 0)) {
+    _chunks.reserve(capacity);
+}
+
+ChunkPtr ChunkRecycler::new_chunk() {
+    ChunkUniquePtr chunk;
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        if (!_chunks.empty()) {
+            chunk = std::move(_chunks.back());
+            _chunks.pop_back();
+        }
+    }
+    if (chunk == nullptr) {
+        chunk.reset(ChunkHelper::new_chunk_pooled(*_schema, _chunk_size, true));
+    }
+    if (_capacity == 0) {
+        return chunk;
+    }
+    return {chunk.release(), [recycler = shared_from_this()](Chunk* c) { recycler->_recycle(c); }};
+}
+
+void ChunkRecycler::close() {
+    std::vector<ChunkUniquePtr> chunks;
+    std::lock_guard<std::mutex> l(_lock);
+    _closed = true;
+    // release the chunks after unlocked
+    chunks.swap(_chunks);
+}
+
+size_t ChunkRecycler::num_recycled_chunks() const {
+    std::lock_guard<std::mutex> l(_lock);
+    return _chunks.size();
+}
+
+void ChunkRecycler::_recycle(Chunk* chunk) {
+    ChunkUniquePtr holder(chunk);
+    if (!_reusable(*chunk)) {
+        return;
+    }
+    chunk->reset();
+    std::lock_guard<std::mutex> l(_lock);
+    if (!_closed && _chunks.size() < _capacity) {
+        _chunks.emplace_back(std::move(holder));
+    }
+}
+
+bool ChunkRecycler::_reusable(const Chunk& chunk) const {
+    // The consumers may append, remove or replace the columns of the chunk, or keep the columns shared with the
+    // other chunks, then the chunk can't be reused, and a chunk grown much larger should not be kept.
+    if (chunk.num_columns() != _template->num_columns() || chunk.num_rows() > _chunk_size) {
+        return false;
+    }
+    for (size_t i = 0; i < chunk.num_columns(); i++) {
+        const auto& column = chunk.get_column_by_index(i);
+        const auto& expected = _template->get_column_by_index(i);
+        if (column == nullptr || column.use_count() != 1 || typeid(*column) != typeid(*expected)) {
+            return false;
+        }
+        if (column->is_nullable()) {
+            const auto& data = down_cast<const NullableColumn*>(column.get())->data_column();
+            const auto& expected_data = down_cast<const NullableColumn*>(expected.get())->data_column();
+            if (data.use_count() != 1 || typeid(*data) != typeid(*expected_data)) {
+                return false;
+            }
+        }
+    }
+    return true;
 }
 
 } // namespace starrocks
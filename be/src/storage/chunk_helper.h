@@ -15,6 +15,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <queue>
 
 #include "column/vectorized_fwd.h"
@@ -110,6 +111,9 @@ class ChunkPipelineAccumulator {
 public:
     ChunkPipelineAccumulator() = default;
     void set_max_size(size_t max_size) { _max_size = max_size; }
+    // The output chunk is also limited by *max_bytes*, if it is positive,
+    // so that the chunks of wide rows can be kept in cache.
+    void set_max_bytes(size_t max_bytes) { _max_bytes = max_bytes; }
     void push(const ChunkPtr& chunk);
     ChunkPtr& pull();
     void finalize();
@@ -123,10 +127,55 @@ public:
 private:
     static constexpr double LOW_WATERMARK_ROWS_RATE = 0.75;          // 0.75 * chunk_size
     static constexpr size_t LOW_WATERMARK_BYTES = 256 * 1024 * 1024; // 256MB.
+
+    // Concatenate the pending chunks into one.
+    ChunkPtr _flatten();
+
+    // The input chunks are kept as they are until the output chunk is made of them, so every column is
+    // allocated and copied once rather than growing with every input chunk, and a single chunk is passed
+    // through without copying.
+    std::vector<ChunkPtr> _segments;
+    size_t _segment_rows = 0;
+    size_t _segment_bytes = 0;
+    size_t _segment_memory = 0;
     ChunkPtr _in_chunk = nullptr;
     ChunkPtr _out_chunk = nullptr;
     size_t _max_size = 4096;
+    size_t _max_bytes = 0;
     bool _finalized = false;
 };
 
+// ChunkRecycler keeps the chunks released by the consumers, so that the producer reuses their columns with the
+// capacity retained for the next chunks, rather than allocating new columns for every chunk.
+// A chunk is only recycled if it still consists of the columns of the schema and no one else references them,
+// it's thread-safe since the chunks are usually released by the other threads.
+class ChunkRecycler : public std::enable_shared_from_this<ChunkRecycler> {
+public:
+    // At most |capacity| released chunks are kept.
+    ChunkRecycler(const Schema& schema, size_t chunk_size, size_t capacity);
+    ~ChunkRecycler() = default;
+
+    // Returns an empty chunk of the schema, which is given back to the recycler when it's released.
+    ChunkPtr new_chunk();
+
+    // Release the kept chunks, and the chunks released later are not recycled.
+    void close();
+
+    size_t num_recycled_chunks() const;
+
+private:
+    void _recycle(Chunk* chunk);
+    bool _reusable(const Chunk& chunk) const;
+
+    const std::shared_ptr<Schema> _schema;
+    const size_t _chunk_size;
+    const size_t _capacity;
+    // The columns of the chunks of the schema, only the types of them are checked by _reusable.
+    ChunkUniquePtr _template;
+
+    mutable std::mutex _lock;
+    std::vector<ChunkUniquePtr> _chunks;
+    bool _closed = false;
+};
+
 } // namespace starrocks
@@ -3,6 +3,7 @@
 #include <utility>
 
 #include "column/column_helper.h"
+#include "column/datum_convert.h"
 #include "common/status.h"
 #include "common/statusor.h"
 #include "exprs/binary_predicate.h"
@@ -10,10 +11,15 @@
 #include "exprs/column_ref.h"
 #include "exprs/expr.h"
 #include "exprs/expr_context.h"
+#include "exprs/subfield_expr.h"
 #include "runtime/current_thread.h"
 #include "runtime/descriptors.h"
 #include "runtime/runtime_state.h"
 #include "storage/column_predicate.h"
+#include "storage/rowset/bloom_filter.h"
+#include "storage/rowset/inverted_index_tokenizer.h"
+#include "storage/tablet_schema.h"
+#include "storage/types.h"
 #include "types/logical_type.h"
 
 namespace starrocks {
@@ -32,6 +38,9 @@ StatusOr<ColumnExprPredicate*> ColumnExprPredicate::make_column_expr_predicate(T
     // note: conjuncts would be shared by multiple scanners
     // so here we have to clone one to keep thread safe.
     RETURN_IF_ERROR(expr_predicate->_add_expr_ctx(expr_ctx));
+    if (expr_ctx != nullptr) {
+        RETURN_IF_ERROR(expr_predicate->_extract_like_literals());
+    }
     return expr_predicate;
 }
 
@@ -70,6 +79,81 @@ Status ColumnExprPredicate::_add_expr_ctx(ExprContext* expr_ctx) {
     return Status::OK();
 }
 
+Status ColumnExprPredicate::_extract_like_literals() {
+    LogicalType type = _type_info->type();
+    RETURN_IF(type != TYPE_CHAR && type != TYPE_VARCHAR, Status::OK());
+    RETURN_IF(_expr_ctxs.size() != 1, Status::OK());
+    Expr* root = _expr_ctxs[0]->root();
+    if (root->node_type() != TExprNodeType::FUNCTION_CALL || root->fn().name.function_name != "like" ||
+        root->get_num_children() != 2 || !root->get_child(0)->is_slotref() || !root->get_child(1)->is_constant()) {
+        return Status::OK();
+    }
+    ASSIGN_OR_RETURN(ColumnPtr column, _expr_ctxs[0]->evaluate(root->get_child(1), nullptr));
+    if (column->only_null() || column->is_null(0)) {
+        return Status::OK();
+    }
+    Slice pattern = ColumnHelper::get_const_value<TYPE_VARCHAR>(column);
+    RETURN_IF(pattern.size == 0, Status::OK());
+    _like_literal_at_begin = pattern.data[0] != '%' && pattern.data[0] != '_';
+    _like_literal_at_end = pattern.data[pattern.size - 1] != '%' && pattern.data[pattern.size - 1] != '_';
+    // '%' and '_' are the wildcards, and '\' escapes the next character.
+    std::string literal;
+    for (size_t i = 0; i < pattern.size; i++) {
+        char c = pattern.data[i];
+        if (c == '\\' && i + 1 < pattern.size) {
+            literal.push_back(pattern.data[++i]);
+        } else if (c == '%' || c == '_') {
+            if (!literal.empty()) {
+                _like_literals.emplace_back(std::move(literal));
+                literal.clear();
+            }
+        } else {
+            literal.push_back(c);
+        }
+    }
+    if (!literal.empty()) {
+        _like_literals.emplace_back(std::move(literal));
+    }
+    return Status::OK();
+}
+
+bool ColumnExprPredicate::ngram_bloom_filter(const BloomFilter* bf, size_t gram_size) const {
+    // All the n-grams of the literals must be present in the page which contains a matched value.
+    for (const auto& literal : _like_literals) {
+        for (size_t pos = 0; pos + gram_size <= literal.size(); pos++) {
+            if (!bf->test_bytes(literal.data() + pos, gram_size)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool ColumnExprPredicate::inverted_index_terms(const InvertedIndexTokenizer& tokenizer,
+                                               std::vector<std::string>* terms) const {
+    // The terms of a literal are also the terms of the matched value, except that the first one may be a
+    // part of a longer term in the value unless it's at the beginning of the pattern or preceded by a
+    // non-term character, and the same for the last one. The index is lowercased, so the terms are a
+    // superset of the matched rows of the case-sensitive LIKE, which is still evaluated later.
+    size_t old_size = terms->size();
+    for (size_t i = 0; i < _like_literals.size(); i++) {
+        const std::string& literal = _like_literals[i];
+        std::vector<std::string> literal_terms = tokenizer.tokenize(literal);
+        size_t begin = 0;
+        size_t end = literal_terms.size();
+        bool at_begin = i == 0 && _like_literal_at_begin;
+        bool at_end = i + 1 == _like_literals.size() && _like_literal_at_end;
+        if (end > begin && !at_begin && InvertedIndexTokenizer::is_term_char(literal.front())) {
+            begin++;
+        }
+        if (end > begin && !at_end && InvertedIndexTokenizer::is_term_char(literal.back())) {
+            end--;
+        }
+        terms->insert(terms->end(), literal_terms.begin() + begin, literal_terms.begin() + end);
+    }
+    return terms->size() > old_size;
+}
+
 Status ColumnExprPredicate::evaluate(const Column* column, uint8_t* selection, uint16_t from, uint16_t to) const {
     // Does not support range evaluatation.
     DCHECK(from == 0);
@@ -214,6 +298,8 @@ Status ColumnExprPredicate::try_to_rewrite_for_zone_map_filter(starrocks::Object
                                                                std::vector<const ColumnExprPredicate*>* output) const {
     DCHECK(pool != nullptr);
     DCHECK(output != nullptr);
+    // the rewritten predicates would lose the subfield predicate
+    RETURN_IF(_subfield_predicate != nullptr, Status::OK());
     ExprContext* pred_from_planner = _expr_ctxs[0];
     Expr* root = pred_from_planner->root();
 
@@ -295,4 +381,84 @@ std::string ColumnTruePredicate::debug_string() const {
     return "(ColumnTruePredicate)";
 }
 
+Status ColumnExprPredicate::try_to_rewrite_for_subfield(const TabletColumn& struct_column) {
+    RETURN_IF(struct_column.type() != TYPE_STRUCT || _expr_ctxs.size() != 1, Status::OK());
+    Expr* root = _expr_ctxs[0]->root();
+    if (root->node_type() != TExprNodeType::BINARY_PRED || root->get_num_children() != 2) {
+        return Status::OK();
+    }
+    PredicateType type;
+    switch (root->op()) {
+    case TExprOpcode::EQ:
+        type = PredicateType::kEQ;
+        break;
+    case TExprOpcode::NE:
+        type = PredicateType::kNE;
+        break;
+    case TExprOpcode::LT:
+        type = PredicateType::kLT;
+        break;
+    case TExprOpcode::LE:
+        type = PredicateType::kLE;
+        break;
+    case TExprOpcode::GT:
+        type = PredicateType::kGT;
+        break;
+    case TExprOpcode::GE:
+        type = PredicateType::kGE;
+        break;
+    default:
+        return Status::OK();
+    }
+    Expr* subfield = root->get_child(0);
+    Expr* value = root->get_child(1);
+    if (subfield->node_type() != TExprNodeType::SUBFIELD_EXPR || subfield->get_num_children() != 1 ||
+        !subfield->get_child(0)->is_slotref() || !value->is_constant()) {
+        return Status::OK();
+    }
+    // only the fields of the top level struct have their own column readers
+    const auto& names = SubfieldExprFactory::used_subfield_names(subfield);
+    RETURN_IF(names.size() != 1, Status::OK());
+    int index = -1;
+    for (uint32_t i = 0; i < struct_column.subcolumn_count(); i++) {
+        if (struct_column.subcolumn(i).name() == names[0]) {
+            index = i;
+            break;
+        }
+    }
+    RETURN_IF(index < 0, Status::OK());
+    const TabletColumn& field = struct_column.subcolumn(index);
+    LogicalType field_type = field.type();
+    // disable on float/double type because min/max value may lose precision
+    if (!is_scalar_field_type(delegate_type(field_type)) ||
+        (!is_zone_map_key_type(field_type) && !is_string_type(field_type)) || field_type == TYPE_FLOAT ||
+        field_type == TYPE_DOUBLE) {
+        return Status::OK();
+    }
+    const TypeDescriptor& value_type = value->type();
+    if (subfield->type().type != field_type || value_type.type != field_type) {
+        return Status::OK();
+    }
+    if (is_decimalv3_field_type(field_type) &&
+        (value_type.precision != field.precision() || value_type.scale != field.scale())) {
+        return Status::OK();
+    }
+
+    ASSIGN_OR_RETURN(ColumnPtr column, _expr_ctxs[0]->evaluate(value, nullptr));
+    if (column->only_null() || column->is_null(0)) {
+        return Status::OK();
+    }
+    TypeInfoPtr field_type_info = get_type_info(field);
+    std::string operand = datum_to_string(field_type_info.get(), column->get(0));
+    ColumnPredicate* pred = new_column_cmp_predicate(type, field_type_info, index, operand);
+    RETURN_IF(pred == nullptr, Status::OK());
+    _pool.add(pred);
+    if (field_type == TYPE_CHAR) {
+        pred->padding_zeros(field.length());
+    }
+    _subfield_index = index;
+    _subfield_predicate = pred;
+    return Status::OK();
+}
+
 } // namespace starrocks
@@ -12,6 +12,7 @@ class SparseRange;
 class ExprContext;
 class BitmapIndexIterator;
 class ObjectPool;
+class TabletColumn;
 } // namespace starrocks
 
 namespace starrocks {
@@ -43,6 +44,9 @@ public:
 
     bool zone_map_filter(const ZoneMapDetail& detail) const override;
     bool support_bloom_filter() const override { return false; }
+    bool support_ngram_bloom_filter() const override { return !_like_literals.empty(); }
+    bool ngram_bloom_filter(const BloomFilter* bf, size_t gram_size) const override;
+    bool inverted_index_terms(const InvertedIndexTokenizer& tokenizer, std::vector<std::string>* terms) const override;
     PredicateType type() const override { return PredicateType::kExpr; }
     bool can_vectorized() const override { return true; }
 
@@ -59,6 +63,13 @@ public:
     Status try_to_rewrite_for_zone_map_filter(starrocks::ObjectPool* pool,
                                               std::vector<const ColumnExprPredicate*>* output) const;
 
+    // If the predicate is `struct_column.field <op> constant`, build the equivalent predicate on the
+    // field, so that the zone map and bloom filter of the field can be used to skip the pages.
+    Status try_to_rewrite_for_subfield(const TabletColumn& struct_column);
+    // The index of the field in the struct column, only valid if `subfield_predicate` is not nullptr.
+    int subfield_index() const { return _subfield_index; }
+    const ColumnPredicate* subfield_predicate() const { return _subfield_predicate; }
+
 private:
     ColumnExprPredicate(TypeInfoPtr type_info, ColumnId column_id, RuntimeState* state,
                         const SlotDescriptor* slot_desc);
@@ -71,12 +82,22 @@ private:
     // Share the ownership, is necessary to clone it
     Status _add_expr_ctx(ExprContext* expr_ctx);
 
+    // If the predicate is `column LIKE 'constant pattern'`, extract the literal parts of the pattern
+    // separated by the wildcards into `_like_literals`, which are used by the n-gram bloom filter.
+    Status _extract_like_literals();
+
     ObjectPool _pool;
     RuntimeState* _state;
     std::vector<ExprContext*> _expr_ctxs;
     const SlotDescriptor* _slot_desc;
     bool _monotonic;
     mutable std::vector<uint8_t> _tmp_select;
+    std::vector<std::string> _like_literals;
+    // whether the first literal is at the beginning of the pattern, and the last one is at the end
+    bool _like_literal_at_begin = false;
+    bool _like_literal_at_end = false;
+    int _subfield_index = -1;
+    const ColumnPredicate* _subfield_predicate = nullptr;
 };
 
 class ColumnTruePredicate : public ColumnPredicate {
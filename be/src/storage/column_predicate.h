@@ -45,6 +45,7 @@ class ExprContext;
 class RuntimeState;
 class SlotDescriptor;
 class BitmapIndexIterator;
+class InvertedIndexTokenizer;
 class BloomFilter;
 } // namespace starrocks
 
@@ -150,11 +151,27 @@ public:
     // Return false to filter out a data page.
     virtual bool zone_map_filter(const ZoneMapDetail& detail) const { return true; }
 
+    // Return true if all the rows of a data page satisfy this predicate, so that the predicate
+    // needn't be evaluated on the rows of this page.
+    virtual bool zone_map_all_match(const ZoneMapDetail& detail) const { return false; }
+
     virtual bool support_bloom_filter() const { return false; }
 
     // Return false to filter out a data page.
     virtual bool bloom_filter(const BloomFilter* bf) const { return true; }
 
+    virtual bool support_ngram_bloom_filter() const { return false; }
+
+    // Return false to filter out a data page by its n-gram bloom filter, in which
+    // the n-grams of size |gram_size| are added.
+    virtual bool ngram_bloom_filter(const BloomFilter* bf, size_t gram_size) const { return true; }
+
+    // Append the terms of full-text inverted index which are contained by every value satisfying
+    // this predicate to |terms|. Return false if there is no such term.
+    virtual bool inverted_index_terms(const InvertedIndexTokenizer& tokenizer, std::vector<std::string>* terms) const {
+        return false;
+    }
+
     virtual Status seek_bitmap_dictionary(BitmapIndexIterator* iter, SparseRange* range) const {
         return Status::Cancelled("not implemented");
     }
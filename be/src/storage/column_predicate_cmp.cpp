@@ -263,6 +263,11 @@ public:
         return this->type_info()->cmp(Datum(this->_value), max) <= 0;
     }
 
+    bool zone_map_all_match(const ZoneMapDetail& detail) const override {
+        const auto& min = detail.min_or_null_value();
+        return !min.is_null() && this->type_info()->cmp(Datum(this->_value), min) <= 0;
+    }
+
     Status seek_bitmap_dictionary(BitmapIndexIterator* iter, SparseRange* range) const override {
         range->clear();
         bool exact_match;
@@ -298,6 +303,11 @@ public:
         return this->type_info()->cmp(Datum(this->_value), max) < 0;
     }
 
+    bool zone_map_all_match(const ZoneMapDetail& detail) const override {
+        const auto& min = detail.min_or_null_value();
+        return !min.is_null() && this->type_info()->cmp(Datum(this->_value), min) < 0;
+    }
+
     Status seek_bitmap_dictionary(BitmapIndexIterator* iter, SparseRange* range) const override {
         range->clear();
         bool exact_match = false;
@@ -334,6 +344,12 @@ public:
         return (this->type_info()->cmp(Datum(this->_value), min) >= 0) & !max.is_null();
     }
 
+    bool zone_map_all_match(const ZoneMapDetail& detail) const override {
+        const auto& min = detail.min_or_null_value();
+        const auto& max = detail.max_value();
+        return !min.is_null() && this->type_info()->cmp(Datum(this->_value), max) >= 0;
+    }
+
     Status seek_bitmap_dictionary(BitmapIndexIterator* iter, SparseRange* range) const override {
         range->clear();
         bool exact_match = false;
@@ -370,6 +386,12 @@ public:
         return (this->type_info()->cmp(Datum(this->_value), min) > 0) & !max.is_null();
     }
 
+    bool zone_map_all_match(const ZoneMapDetail& detail) const override {
+        const auto& min = detail.min_or_null_value();
+        const auto& max = detail.max_value();
+        return !min.is_null() && this->type_info()->cmp(Datum(this->_value), max) > 0;
+    }
+
     Status seek_bitmap_dictionary(BitmapIndexIterator* iter, SparseRange* range) const override {
         range->clear();
         bool exact_match = false;
@@ -407,6 +429,14 @@ public:
         return type_info->cmp(Datum(this->_value), min) >= 0 && type_info->cmp(Datum(this->_value), max) <= 0;
     }
 
+    bool zone_map_all_match(const ZoneMapDetail& detail) const override {
+        const auto& min = detail.min_or_null_value();
+        const auto& max = detail.max_value();
+        const auto type_info = this->type_info();
+        return !min.is_null() && type_info->cmp(Datum(this->_value), min) == 0 &&
+               type_info->cmp(Datum(this->_value), max) == 0;
+    }
+
     Status seek_bitmap_dictionary(BitmapIndexIterator* iter, SparseRange* range) const override {
         range->clear();
         bool exact_match = false;
@@ -596,6 +626,18 @@ public:
         return type_info->cmp(Datum(this->_value), min) >= 0 && type_info->cmp(Datum(this->_value), max) <= 0;
     }
 
+    bool zone_map_all_match(const ZoneMapDetail& detail) const override {
+        // The values of CHAR column are padded with zeros in storage.
+        if constexpr (field_type == TYPE_CHAR) {
+            return false;
+        }
+        const auto& min = detail.min_or_null_value();
+        const auto& max = detail.max_value();
+        const auto type_info = this->type_info();
+        return !min.is_null() && type_info->cmp(Datum(this->_value), min) == 0 &&
+               type_info->cmp(Datum(this->_value), max) == 0;
+    }
+
     bool support_bloom_filter() const override { return true; }
 
     bool bloom_filter(const BloomFilter* bf) const override {
@@ -635,6 +677,15 @@ public:
         return this->type_info()->cmp(Datum(this->_value), max) <= 0;
     }
 
+    bool zone_map_all_match(const ZoneMapDetail& detail) const override {
+        // The values of CHAR column are padded with zeros in storage.
+        if constexpr (field_type == TYPE_CHAR) {
+            return false;
+        }
+        const auto& min = detail.min_or_null_value();
+        return !min.is_null() && this->type_info()->cmp(Datum(this->_value), min) <= 0;
+    }
+
     Status seek_bitmap_dictionary(BitmapIndexIterator* iter, SparseRange* range) const override {
         // Can NOT use `_value` here, see the comment in `predicate_parser.cpp`.
         Slice padded_value(Base::_zero_padded_str);
@@ -667,6 +718,15 @@ public:
         return this->type_info()->cmp(Datum(this->_value), max) < 0;
     }
 
+    bool zone_map_all_match(const ZoneMapDetail& detail) const override {
+        // The values of CHAR column are padded with zeros in storage.
+        if constexpr (field_type == TYPE_CHAR) {
+            return false;
+        }
+        const auto& min = detail.min_or_null_value();
+        return !min.is_null() && this->type_info()->cmp(Datum(this->_value), min) < 0;
+    }
+
     Status seek_bitmap_dictionary(BitmapIndexIterator* iter, SparseRange* range) const override {
         // Can NOT use `_value` here, see comment in predicate_parser.cpp.
         Slice padded_value(Base::_zero_padded_str);
@@ -700,6 +760,16 @@ public:
         return (type_info->cmp(Datum(this->_value), min) > 0) & !max.is_null();
     }
 
+    bool zone_map_all_match(const ZoneMapDetail& detail) const override {
+        // The values of CHAR column are padded with zeros in storage.
+        if constexpr (field_type == TYPE_CHAR) {
+            return false;
+        }
+        const auto& min = detail.min_or_null_value();
+        const auto& max = detail.max_value();
+        return !min.is_null() && this->type_info()->cmp(Datum(this->_value), max) > 0;
+    }
+
     Status seek_bitmap_dictionary(BitmapIndexIterator* iter, SparseRange* range) const override {
         Slice padded_value(Base::_zero_padded_str);
         range->clear();
@@ -731,6 +801,16 @@ public:
         return (this->type_info()->cmp(Datum(this->_value), min) >= 0) & !max.is_null();
     }
 
+    bool zone_map_all_match(const ZoneMapDetail& detail) const override {
+        // The values of CHAR column are padded with zeros in storage.
+        if constexpr (field_type == TYPE_CHAR) {
+            return false;
+        }
+        const auto& min = detail.min_or_null_value();
+        const auto& max = detail.max_value();
+        return !min.is_null() && this->type_info()->cmp(Datum(this->_value), max) >= 0;
+    }
+
     Status seek_bitmap_dictionary(BitmapIndexIterator* iter, SparseRange* range) const override {
         Slice padded_value(Base::_zero_padded_str);
         range->clear();
@@ -0,0 +1,95 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "storage/compaction_io_throttle.h"
+
+#include <algorithm>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "util/time.h"
+
+namespace starrocks {
+
+// The average latency is computed only if there are enough ios during the interval.
+static constexpr int64_t kMinQueryIOCount = 16;
+
+// Advance |paid_ns| by the time to pay |cost| at |rate| per second, return the time to wait until it's paid off.
+static int64_t reserve(int64_t* paid_ns, int64_t now_ns, int64_t cost, double rate) {
+    if (rate <= 0 || cost <= 0) {
+        return 0;
+    }
+    *paid_ns = std::max(*paid_ns, now_ns - CompactionIOThrottle::kBurstNs) + static_cast<int64_t>(cost * 1e9 / rate);
+    return std::max<int64_t>(0, *paid_ns - now_ns);
+}
+
+int64_t CompactionIOThrottle::acquire(int64_t bytes, int64_t io_count) {
+    const int64_t max_bytes = config::compaction_io_bytes_per_second_per_disk;
+    const int64_t max_ios = config::compaction_io_count_per_second_per_disk;
+    if (max_bytes <= 0 && max_ios <= 0) {
+        return 0;
+    }
+    const int64_t now_ns = MonotonicNanos();
+    std::lock_guard l(_mutex);
+    _adjust_budget(now_ns);
+    int64_t bytes_wait_ns = reserve(&_bytes_paid_ns, now_ns, bytes, max_bytes * _budget_ratio);
+    int64_t ios_wait_ns = reserve(&_ios_paid_ns, now_ns, io_count, max_ios * _budget_ratio);
+    return std::max(bytes_wait_ns, ios_wait_ns);
+}
+
+bool CompactionIOThrottle::is_query_peak() {
+    std::lock_guard l(_mutex);
+    _adjust_budget(MonotonicNanos());
+    return _query_peak;
+}
+
+double CompactionIOThrottle::budget_ratio() {
+    std::lock_guard l(_mutex);
+    _adjust_budget(MonotonicNanos());
+    return _budget_ratio;
+}
+
+void CompactionIOThrottle::_adjust_budget(int64_t now_ns) {
+    const int64_t threshold_us = config::compaction_query_io_latency_threshold_us;
+    if (threshold_us <= 0) {
+        _budget_ratio = 1.0;
+        _query_peak = false;
+        return;
+    }
+    if (_last_adjust_ns > 0 && now_ns - _last_adjust_ns < kAdjustIntervalNs) {
+        return;
+    }
+    _last_adjust_ns = now_ns;
+    const int64_t query_io_ns = _query_io_ns.load(std::memory_order_relaxed);
+    const int64_t query_io_count = _query_io_count.load(std::memory_order_relaxed);
+    const int64_t io_ns = query_io_ns - _last_query_io_ns;
+    const int64_t io_count = query_io_count - _last_query_io_count;
+    _last_query_io_ns = query_io_ns;
+    _last_query_io_count = query_io_count;
+
+    const bool query_peak = io_count >= kMinQueryIOCount && io_ns / io_count > threshold_us * 1000;
+    if (query_peak) {
+        _budget_ratio = std::max(kMinBudgetRatio, _budget_ratio / 2);
+    } else {
+        _budget_ratio = std::min(1.0, _budget_ratio * 1.25);
+    }
+    if (query_peak != _query_peak) {
+        LOG(INFO) << (query_peak ? "enter" : "leave") << " query peak of compaction io throttle, query io latency: "
+                  << (io_count > 0 ? io_ns / io_count / 1000 : 0) << "us, budget ratio: " << _budget_ratio;
+    }
+    _query_peak = query_peak;
+}
+
+} // namespace starrocks
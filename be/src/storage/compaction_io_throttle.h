@@ -0,0 +1,73 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+namespace starrocks {
+
+// CompactionIOThrottle limits the io of the compactions on one disk.
+//
+// The compactions are limited to compaction_io_bytes_per_second_per_disk bytes and
+// compaction_io_count_per_second_per_disk ios per second, with a burst of one second. And the budget adapts to
+// the io latency of the queries reading the disk: when the average latency exceeds
+// compaction_query_io_latency_threshold_us, the budget is halved every second down to 1/16 of the configured
+// one, and the disk is regarded as in a query peak, during which the low priority compactions are not scheduled.
+// Otherwise the budget is restored gradually.
+class CompactionIOThrottle {
+public:
+    static constexpr int64_t kBurstNs = 1000000000L;
+    static constexpr int64_t kAdjustIntervalNs = 1000000000L;
+    static constexpr double kMinBudgetRatio = 1.0 / 16;
+
+    CompactionIOThrottle() = default;
+
+    // Record the io of the queries reading the disk, |io_ns| is the time spent by |io_count| ios.
+    void add_query_io(int64_t io_ns, int64_t io_count) {
+        _query_io_ns.fetch_add(io_ns, std::memory_order_relaxed);
+        _query_io_count.fetch_add(io_count, std::memory_order_relaxed);
+    }
+
+    // Account |bytes| in |io_count| ios done by a compaction, return the nanoseconds the compaction should
+    // sleep to stay within the budget.
+    int64_t acquire(int64_t bytes, int64_t io_count);
+
+    // Whether the queries reading the disk suffer from high io latency.
+    bool is_query_peak();
+
+    // The ratio of the configured budget available for the compactions.
+    double budget_ratio();
+
+private:
+    void _adjust_budget(int64_t now_ns);
+
+    std::atomic<int64_t> _query_io_ns{0};
+    std::atomic<int64_t> _query_io_count{0};
+
+    std::mutex _mutex;
+    double _budget_ratio = 1.0;
+    bool _query_peak = false;
+    int64_t _last_adjust_ns = 0;
+    int64_t _last_query_io_ns = 0;
+    int64_t _last_query_io_count = 0;
+    // The time when the bytes and ios acquired so far are paid off.
+    int64_t _bytes_paid_ns = 0;
+    int64_t _ios_paid_ns = 0;
+};
+
+} // namespace starrocks
@@ -221,6 +221,12 @@ bool CompactionManager::_check_precondition(const CompactionCandidate& candidate
             VLOG(2) << "skip tablet:" << tablet->tablet_id() << " for base lock";
             return false;
         }
+        if (data_dir->compaction_io_throttle()->is_query_peak()) {
+            // base compactions are of low priority, pause them until the query io latency drops
+            VLOG(2) << "skip tablet:" << tablet->tablet_id()
+                    << " for query peak of the disk. disk path:" << data_dir->path();
+            return false;
+        }
         uint16_t num = running_base_tasks_num_for_dir(data_dir);
         if (config::base_compaction_num_threads_per_disk > 0 &&
             num >= config::base_compaction_num_threads_per_disk * 2) {
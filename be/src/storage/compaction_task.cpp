@@ -14,11 +14,21 @@
 
 #include "storage/compaction_task.h"
 
+#include <algorithm>
+#include <chrono>
 #include <sstream>
+#include <thread>
 
+#include "io/io_stats.h"
 #include "runtime/current_thread.h"
 #include "runtime/mem_tracker.h"
 #include "storage/compaction_manager.h"
+#include "storage/data_dir.h"
+#include "storage/rowset/column_reader.h"
+#include "storage/rowset/rowset_writer.h"
+#include "storage/rowset/segment.h"
+#include "storage/types.h"
+#include "storage/zone_map_detail.h"
 #include "storage/storage_engine.h"
 #include "util/scoped_cleanup.h"
 #include "util/starrocks_metrics.h"
@@ -34,6 +44,7 @@ CompactionTask::~CompactionTask() {
 }
 
 void CompactionTask::run() {
+    SCOPED_IO_PURPOSE(io::IOPurpose::COMPACTION);
     LOG(INFO) << "start compaction. task_id:" << _task_info.task_id << ", tablet:" << _task_info.tablet_id
               << ", algorithm:" << CompactionUtils::compaction_algorithm_to_string(_task_info.algorithm)
               << ", compaction_type:" << starrocks::to_string(_task_info.compaction_type)
@@ -119,7 +130,13 @@ void CompactionTask::run() {
     }
     TRACE("[Compaction] got compaction lock");
 
-    Status status = run_impl();
+    Status status;
+    auto moved = _try_trivial_move();
+    if (!moved.ok()) {
+        status = moved.status();
+    } else if (!moved.value()) {
+        status = run_impl();
+    }
     if (status.ok()) {
         _success_callback();
     } else {
@@ -137,6 +154,119 @@ bool CompactionTask::should_stop() const {
     return StorageEngine::instance()->bg_worker_stopped() || BackgroundTask::should_stop();
 }
 
+StatusOr<bool> CompactionTask::_try_trivial_move() {
+    if (!config::enable_compaction_trivial_move || _tablet->keys_type() != DUP_KEYS) {
+        return false;
+    }
+    const auto& tablet_schema = _tablet->tablet_schema();
+    const ColumnId sort_key = tablet_schema.sort_key_idxes().empty() ? 0 : tablet_schema.sort_key_idxes()[0];
+    auto type_info = get_type_info(delegate_type(tablet_schema.column(sort_key).type()));
+
+    struct InputSegment {
+        RowsetSharedPtr rowset;
+        uint32_t segment_id;
+        ZoneMapDetail zone_map;
+    };
+    std::vector<InputSegment> segments;
+    for (const auto& rowset : _input_rowsets) {
+        if (rowset->num_segments() == 0) {
+            continue;
+        }
+        if (rowset->rowset_meta()->has_delete_predicate() || rowset->rowset_meta()->is_segments_overlapping() ||
+            rowset->data_disk_size() / rowset->num_segments() < config::compaction_trivial_move_min_segment_bytes) {
+            return false;
+        }
+        RETURN_IF_ERROR(rowset->load());
+        for (uint32_t i = 0; i < rowset->segments().size(); i++) {
+            const auto& segment = rowset->segments()[i];
+            if (segment->num_rows() == 0) {
+                continue;
+            }
+            if (sort_key >= segment->num_columns() || segment->column(sort_key) == nullptr) {
+                return false;
+            }
+            InputSegment input{rowset, i, {}};
+            if (!segment->column(sort_key)->segment_zone_map_detail(&input.zone_map).ok()) {
+                return false;
+            }
+            segments.emplace_back(std::move(input));
+        }
+    }
+    if (segments.size() < 2) {
+        // nothing to gain, the rowsets may need to be merged with the delete predicates in the next compaction
+        return false;
+    }
+
+    // the null is smaller than any other value
+    std::sort(segments.begin(), segments.end(), [&](const InputSegment& a, const InputSegment& b) {
+        if (a.zone_map.has_null() || b.zone_map.has_null()) {
+            return a.zone_map.has_null() && !b.zone_map.has_null();
+        }
+        return type_info->cmp(a.zone_map.min_value(), b.zone_map.min_value()) < 0;
+    });
+    for (size_t i = 1; i < segments.size(); i++) {
+        const auto& prev = segments[i - 1].zone_map;
+        const auto& cur = segments[i].zone_map;
+        if (cur.has_null() || !cur.has_not_null()) {
+            return false;
+        }
+        if (prev.has_not_null() && type_info->cmp(prev.max_value(), cur.min_value()) >= 0) {
+            return false;
+        }
+    }
+
+    int64_t max_rows_per_segment = CompactionUtils::get_segment_max_rows(
+            config::max_segment_file_size, _task_info.input_rows_num, _task_info.input_rowsets_size);
+    std::unique_ptr<RowsetWriter> output_rs_writer;
+    RETURN_IF_ERROR(CompactionUtils::construct_output_rowset_writer(_tablet.get(), max_rows_per_segment,
+                                                                    HORIZONTAL_COMPACTION, _task_info.output_version,
+                                                                    &output_rs_writer));
+    for (const auto& input : segments) {
+        RETURN_IF_ERROR(output_rs_writer->link_segment(input.rowset, input.segment_id));
+    }
+    ASSIGN_OR_RETURN(_output_rowset, output_rs_writer->build());
+    if (_output_rowset->num_rows() != _task_info.input_rows_num) {
+        LOG(WARNING) << "row_num does not match between trivial move input and output! input_row_num="
+                     << _task_info.input_rows_num << ", output_row_num=" << _output_rowset->num_rows();
+        return Status::InternalError("compaction check lines error.");
+    }
+    _task_info.output_num_rows = _output_rowset->num_rows();
+    _task_info.output_segments_num = _output_rowset->num_segments();
+    _task_info.output_rowset_size = _output_rowset->data_disk_size();
+    TRACE("[Compaction] $0 segments are trivially moved", segments.size());
+
+    _commit_compaction();
+    TRACE("[Compaction] trivial move committed");
+    return true;
+}
+
+void CompactionTask::_throttle_io(const OlapReaderStatistics& stats, RowsetWriter* writer, IOCounter* last) {
+    DataDir* data_dir = _tablet->data_dir();
+    if (data_dir == nullptr) {
+        return;
+    }
+    IOCounter current;
+    current.read_bytes = stats.compressed_bytes_read;
+    current.read_ios = stats.total_pages_num - stats.cached_pages_num;
+    current.write_bytes = writer->total_data_size();
+    int64_t bytes = current.read_bytes - last->read_bytes + current.write_bytes - last->write_bytes;
+    int64_t ios = current.read_ios - last->read_ios;
+    *last = current;
+
+    int64_t wait_ns = data_dir->compaction_io_throttle()->acquire(bytes, ios);
+    if (wait_ns <= 0) {
+        return;
+    }
+    int64_t start_ns = MonotonicNanos();
+    // sleep in small slices to stop in time
+    const int64_t slice_ns = 100 * 1000 * 1000;
+    while (wait_ns > 0 && !should_stop()) {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(std::min(wait_ns, slice_ns)));
+        wait_ns -= slice_ns;
+    }
+    _task_info.io_throttled_ms += (MonotonicNanos() - start_ns) / 1000000;
+}
+
 void CompactionTask::_success_callback() {
     set_compaction_task_state(COMPACTION_SUCCESS);
     // for compatible, update compaction time
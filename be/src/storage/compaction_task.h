@@ -28,6 +28,8 @@
 
 namespace starrocks {
 
+class RowsetWriter;
+
 enum CompactionTaskState { COMPACTION_INIT, COMPACTION_RUNNING, COMPACTION_FAILED, COMPACTION_SUCCESS };
 
 static const char* compaction_state_to_string(CompactionTaskState state) {
@@ -66,6 +68,8 @@ struct CompactionTaskInfo {
     size_t merged_rows{0};
     size_t filtered_rows{0};
     size_t output_num_rows{0};
+    // the time slept for the io throttle of the disk
+    uint64_t io_throttled_ms{0};
     CompactionType compaction_type{CompactionType::INVALID_COMPACTION};
 
     // for vertical compaction
@@ -116,6 +120,7 @@ struct CompactionTaskInfo {
         ss << ", total_output_num_rows:" << total_output_num_rows;
         ss << ", total_merged_rows:" << total_merged_rows;
         ss << ", total_del_filtered_rows:" << total_del_filtered_rows;
+        ss << ", io_throttled_ms:" << io_throttled_ms;
         ss << ", progress:" << get_progress();
         return ss.str();
     }
@@ -259,6 +264,21 @@ protected:
 
     void _failure_callback(const Status& st);
 
+    // The io done by the compaction which has been accounted by the io throttle of the disk.
+    struct IOCounter {
+        int64_t read_bytes = 0;
+        int64_t read_ios = 0;
+        int64_t write_bytes = 0;
+    };
+
+    // Link the input segments into the output rowset if they are sorted by the first sort key without overlapping,
+    // and there's no delete predicate to apply. Return false if the input rowsets must be merged.
+    StatusOr<bool> _try_trivial_move();
+
+    // Account the io of |stats| and |writer| since |last|, and sleep if the io exceeds the compaction io budget
+    // of the disk.
+    void _throttle_io(const OlapReaderStatistics& stats, RowsetWriter* writer, IOCounter* last);
+
 protected:
     CompactionTaskInfo _task_info;
     RuntimeProfile _runtime_profile;
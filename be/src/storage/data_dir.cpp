@@ -40,15 +40,18 @@
 #include <utility>
 
 #include "common/config.h"
+#include "fs/fd_cache.h"
 #include "fs/fs.h"
 #include "fs/fs_util.h"
 #include "gutil/strings/substitute.h"
+#include "io/io_stats.h"
 #include "runtime/exec_env.h"
 #include "service/backend_options.h"
 #include "storage/olap_define.h"
 #include "storage/rowset/rowset_factory.h"
 #include "storage/rowset/rowset_meta.h"
 #include "storage/rowset/rowset_meta_manager.h"
+#include "storage/rowset/segment_meta_cache.h"
 #include "storage/storage_engine.h"
 #include "storage/tablet_manager.h"
 #include "storage/tablet_meta_manager.h"
@@ -78,6 +81,10 @@ DataDir::DataDir(const std::string& path, TStorageMedium::type storage_medium, T
           _current_shard(0) {}
 
 DataDir::~DataDir() {
+    if (_segment_meta_cache != nullptr) {
+        SegmentMetaCache::unregister_cache(_segment_meta_cache.get());
+        flush_segment_meta_cache();
+    }
     delete _id_generator;
     delete _kv_store;
 }
@@ -85,6 +92,8 @@ DataDir::~DataDir() {
 Status DataDir::init(bool read_only) {
     ASSIGN_OR_RETURN(_fs, FileSystem::CreateSharedFromString(_path));
     RETURN_IF_ERROR(_fs->path_exists(_path));
+    // the io stats of the files under the root path are labelled by it
+    io::IOTargetRegistry::instance()->register_local_path(_path);
     std::string align_tag_path = _path + ALIGN_TAG_PREFIX;
     if (access(align_tag_path.c_str(), F_OK) == 0) {
         RETURN_IF_ERROR_WITH_WARN(Status::NotFound(Substitute("align tag $0 was found", align_tag_path)),
@@ -96,11 +105,29 @@ Status DataDir::init(bool read_only) {
     RETURN_IF_ERROR_WITH_WARN(_init_data_dir(), "_init_data_dir failed");
     RETURN_IF_ERROR_WITH_WARN(_init_tmp_dir(), "_init_tmp_dir failed");
     RETURN_IF_ERROR_WITH_WARN(_init_meta(read_only), "_init_meta failed");
+    if (config::file_descriptor_cache_capacity_per_disk > 0) {
+        FdCache::Instance()->add_partition(_path, config::file_descriptor_cache_capacity_per_disk);
+    }
+    if (!read_only) {
+        _segment_meta_cache = std::make_unique<SegmentMetaCache>(_path);
+        // The cache is only an optimization, the segment footers will be read from the files if failed.
+        auto st = _segment_meta_cache->open();
+        LOG_IF(WARNING, !st.ok()) << "Fail to open segment meta cache of " << _path << ": " << st;
+        SegmentMetaCache::register_cache(_segment_meta_cache.get());
+    }
 
     _is_used = true;
     return Status::OK();
 }
 
+void DataDir::flush_segment_meta_cache() {
+    if (_segment_meta_cache == nullptr) {
+        return;
+    }
+    auto st = _segment_meta_cache->flush();
+    LOG_IF(WARNING, !st.ok()) << "Fail to flush segment meta cache " << _segment_meta_cache->file_path() << ": " << st;
+}
+
 void DataDir::stop_bg_worker() {
     _stop_bg_worker = true;
     _cv.notify_one();
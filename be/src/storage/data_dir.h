@@ -36,6 +36,7 @@
 
 #include <condition_variable>
 #include <cstdint>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <shared_mutex>
@@ -46,12 +47,14 @@
 #include "gen_cpp/Types_types.h"
 #include "gen_cpp/olap_file.pb.h"
 #include "storage/cluster_id_mgr.h"
+#include "storage/compaction_io_throttle.h"
 #include "storage/kv_store.h"
 #include "storage/olap_common.h"
 #include "storage/rowset/rowset_id_generator.h"
 
 namespace starrocks {
 
+class SegmentMetaCache;
 class Tablet;
 class TabletManager;
 class TxnManager;
@@ -133,6 +136,11 @@ public:
 
     Status update_capacity();
 
+    // Persist the new segment footers in the segment meta cache, see `SegmentMetaCache`.
+    void flush_segment_meta_cache();
+
+    CompactionIOThrottle* compaction_io_throttle() { return &_compaction_io_throttle; }
+
 private:
     Status _init_data_dir();
     Status _init_tmp_dir();
@@ -167,6 +175,8 @@ private:
 
     KVStore* _kv_store = nullptr;
     RowsetIdGenerator* _id_generator = nullptr;
+    std::unique_ptr<SegmentMetaCache> _segment_meta_cache;
+    CompactionIOThrottle _compaction_io_throttle;
 
     std::mutex _check_path_mutex;
     std::condition_variable _cv;
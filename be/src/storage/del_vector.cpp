@@ -39,6 +39,7 @@ void DelVector::_add_dels(const std::vector<uint32_t>& dels) {
     } else {
         _roaring->addMany(dels.size(), dels.data());
     }
+    _optimize();
     _update_stats();
 }
 
@@ -69,6 +70,7 @@ Status DelVector::load(int64_t version, const char* data, size_t length) {
     if (length > 0) {
         _roaring = std::make_unique<Roaring>(Roaring::readSafe(data, length));
     }
+    _optimize();
     _update_stats();
     return Status::OK();
 }
@@ -79,6 +81,7 @@ void DelVector::init(int64_t version, const uint32_t* data, size_t length) {
     if (length > 0) {
         _roaring = std::make_unique<Roaring>(length, data);
     }
+    _optimize();
     _update_stats();
 }
 
@@ -106,6 +109,14 @@ string DelVector::to_string() const {
     return strings::Substitute("version:$0 $1", _version, _roaring ? _roaring->toString() : string("null"));
 }
 
+void DelVector::_optimize() {
+    // deleted rows are usually clustered, run containers take much less memory for them
+    if (_roaring) {
+        _roaring->runOptimize();
+        _roaring->shrinkToFit();
+    }
+}
+
 void DelVector::_update_stats() {
     // TODO(cbl): optimization
     if (_roaring) {
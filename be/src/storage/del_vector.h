@@ -64,6 +64,8 @@ public:
 private:
     void _add_dels(const std::vector<uint32_t>& dels);
 
+    void _optimize();
+
     void _update_stats();
 
     bool _loaded = false;
@@ -20,6 +20,7 @@
 #include "runtime/descriptors.h"
 #include "storage/compaction_manager.h"
 #include "storage/memtable.h"
+#include "storage/memtable_flush_arbiter.h"
 #include "storage/memtable_flush_executor.h"
 #include "storage/memtable_rowset_writer_sink.h"
 #include "storage/primary_key_encoder.h"
@@ -54,9 +55,12 @@ DeltaWriter::DeltaWriter(DeltaWriterOptions opt, MemTracker* mem_tracker, Storag
           _tablet_schema(nullptr),
           _flush_token(nullptr),
           _replicate_token(nullptr),
-          _with_rollback_log(true) {}
+          _with_rollback_log(true) {
+    MemTableFlushArbiter::instance()->add(this);
+}
 
 DeltaWriter::~DeltaWriter() {
+    MemTableFlushArbiter::instance()->remove(this);
     SCOPED_THREAD_LOCAL_MEM_SETTER(_mem_tracker, false);
     if (_flush_token != nullptr) {
         _flush_token->shutdown();
@@ -255,6 +259,16 @@ Status DeltaWriter::_init() {
     writer_context.global_dicts = _opt.global_dicts;
     writer_context.miss_auto_increment_column = _opt.miss_auto_increment_column;
     writer_context.abort_delete = _opt.abort_delete;
+    if (_replica_state == Primary && _opt.replicas.size() > 1) {
+        // stream the segments to the secondary replicas while they are written, _replicate_token is created below
+        writer_context.segment_piece_callback = [this](int64_t segment_id, int64_t offset, butil::IOBuf* piece) {
+            auto st = _replicate_token->submit_piece(segment_id, offset, piece);
+            if (!st.ok()) {
+                LOG(WARNING) << "Failed to submit sync segment piece err=" << st;
+                _replicate_token->set_status(st);
+            }
+        };
+    }
     Status st = RowsetFactory::create_rowset_writer(writer_context, &_rowset_writer);
     if (!st.ok()) {
         auto msg = strings::Substitute("Fail to create rowset writer. tablet_id: $0, error: $1", _opt.tablet_id,
@@ -320,15 +334,22 @@ Status DeltaWriter::write(const Chunk& chunk, const uint32_t* indexes, uint32_t
 
     Status st;
     bool full = _mem_table->insert(chunk, indexes, from, size);
+    _memtable_memory_usage.store(_mem_table->memory_usage(), std::memory_order_relaxed);
+    MemTracker* exceeded_tracker = nullptr;
     if (_mem_tracker->limit_exceeded()) {
-        VLOG(2) << "Flushing memory table due to memory limit exceeded";
-        st = _flush_memtable();
-        _reset_mem_table();
+        exceeded_tracker = _mem_tracker;
     } else if (_mem_tracker->parent() && _mem_tracker->parent()->limit_exceeded()) {
-        VLOG(2) << "Flushing memory table due to parent memory limit exceeded";
+        exceeded_tracker = _mem_tracker->parent();
+    }
+    // Unless this memtable is one of the largest ones, flush the largest ones instead of it.
+    if (exceeded_tracker != nullptr &&
+        (!config::enable_memtable_flush_largest_first ||
+         MemTableFlushArbiter::instance()->flush_largest(
+                 this, exceeded_tracker->consumption() - exceeded_tracker->limit()))) {
+        VLOG(2) << "Flushing memory table due to memory limit exceeded of " << exceeded_tracker->label();
         st = _flush_memtable();
         _reset_mem_table();
-    } else if (full) {
+    } else if (full || flush_requested()) {
         st = _flush_memtable_async();
         _reset_mem_table();
     }
@@ -439,6 +460,8 @@ void DeltaWriter::_reset_mem_table() {
     }
     _mem_table->set_write_buffer_row(_memtable_buffer_row);
     _mem_table->set_abort_delete(_opt.abort_delete);
+    _memtable_memory_usage.store(0, std::memory_order_relaxed);
+    _flush_requested.store(false, std::memory_order_relaxed);
 }
 
 Status DeltaWriter::commit() {
@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "column/chunk.h"
 #include "column/vectorized_fwd.h"
 #include "common/tracer.h"
@@ -145,6 +147,15 @@ public:
 
     Status get_err_status() const;
 
+    // The memory usage of the current memtable, updated on every write.
+    // [thread-safe]
+    int64_t memtable_memory_usage() const { return _memtable_memory_usage.load(std::memory_order_relaxed); }
+
+    // Flush the current memtable on the next write, see MemTableFlushArbiter.
+    // [thread-safe]
+    void request_flush() { _flush_requested.store(true, std::memory_order_relaxed); }
+    bool flush_requested() const { return _flush_requested.load(std::memory_order_relaxed); }
+
 private:
     DeltaWriter(DeltaWriterOptions opt, MemTracker* parent, StorageEngine* storage_engine);
 
@@ -184,6 +195,9 @@ private:
     bool _with_rollback_log;
     // initial value is max value
     size_t _memtable_buffer_row = -1;
+
+    std::atomic<int64_t> _memtable_memory_usage{0};
+    std::atomic<bool> _flush_requested{false};
 };
 
 } // namespace starrocks
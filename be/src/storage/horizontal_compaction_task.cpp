@@ -121,6 +121,7 @@ StatusOr<size_t> HorizontalCompactionTask::_compact_data(int32_t chunk_size, Tab
     size_t output_rows = 0;
     auto char_field_indexes = ChunkHelper::get_char_field_indexes(schema);
     auto chunk = ChunkHelper::new_chunk(schema, chunk_size);
+    IOCounter throttled_io;
     while (LIKELY(!should_stop())) {
 #ifndef BE_TEST
         status = tls_thread_status.mem_tracker()->check_mem_limit("Compaction");
@@ -149,6 +150,8 @@ StatusOr<size_t> HorizontalCompactionTask::_compact_data(int32_t chunk_size, Tab
         _task_info.output_num_rows = output_rows;
         _task_info.filtered_rows = reader.stats().rows_del_filtered;
         _task_info.merged_rows = reader.merged_rows();
+
+        _throttle_io(reader.stats(), output_rs_writer, &throttled_io);
     }
     TRACE("[Compaction] data compacted");
 
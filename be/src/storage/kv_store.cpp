@@ -34,7 +34,10 @@
 
 #include "storage/kv_store.h"
 
+#include <chrono>
+#include <condition_variable>
 #include <sstream>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -45,6 +48,7 @@
 #include "rocksdb/options.h"
 #include "rocksdb/slice.h"
 #include "rocksdb/slice_transform.h"
+#include "rocksdb/write_batch.h"
 #include "storage/olap_define.h"
 #include "storage/rocksdb_status_adapter.h"
 #include "util/runtime_profile.h"
@@ -160,6 +164,11 @@ Status KVStore::get(ColumnFamilyIndex column_family_index, const std::string& ke
 }
 
 Status KVStore::put(ColumnFamilyIndex column_family_index, const std::string& key, const std::string& value) {
+    if (_group_commit_enabled()) {
+        WriteBatch batch;
+        RETURN_IF_ERROR(to_status(batch.Put(_handles[column_family_index], key, value)));
+        return write_batch(&batch);
+    }
     StarRocksMetrics::instance()->meta_write_request_total.increment(1);
     rocksdb::ColumnFamilyHandle* handle = _handles[column_family_index];
     int64_t duration_ns = 0;
@@ -178,19 +187,159 @@ Status KVStore::put(ColumnFamilyIndex column_family_index, const std::string& ke
 Status KVStore::write_batch(rocksdb::WriteBatch* batch) {
     StarRocksMetrics::instance()->meta_write_request_total.increment(1);
     int64_t duration_ns = 0;
-    rocksdb::Status s;
+    Status st;
     {
         SCOPED_RAW_TIMER(&duration_ns);
-        WriteOptions write_options;
-        write_options.sync = config::sync_tablet_meta;
-        s = _db->Write(write_options, batch);
+        st = _group_commit_enabled() ? _group_commit(batch) : _write(batch);
     }
     StarRocksMetrics::instance()->meta_write_request_duration_us.increment(duration_ns / 1000);
+    return st;
+}
+
+Status KVStore::_write(WriteBatch* batch) {
+    WriteOptions write_options;
+    write_options.sync = config::sync_tablet_meta;
+    rocksdb::Status s = _db->Write(write_options, batch);
     LOG_IF(WARNING, !s.ok()) << s.ToString();
     return to_status(s);
 }
 
+bool KVStore::_group_commit_enabled() {
+    // Without syncing, a write is cheap, and the concurrent writes are grouped by rocksdb itself.
+    return config::sync_tablet_meta && config::tablet_meta_group_commit_window_us > 0;
+}
+
+struct KVStore::Writer {
+    explicit Writer(WriteBatch* batch) : batch(batch) {}
+
+    WriteBatch* batch;
+    bool done = false;
+    Status status;
+    std::condition_variable cv;
+};
+
+Status KVStore::_group_commit(WriteBatch* batch) {
+    Writer w(batch);
+    std::unique_lock l(_writers_mutex);
+    _writers.push_back(&w);
+    while (!w.done && &w != _writers.front()) {
+        w.cv.wait(l);
+    }
+    if (w.done) {
+        return w.status;
+    }
+
+    // This writer is the leader of the next group, wait a moment for the others to join.
+    l.unlock();
+    std::this_thread::sleep_for(std::chrono::microseconds(config::tablet_meta_group_commit_window_us));
+    l.lock();
+    std::vector<Writer*> group;
+    size_t group_bytes = 0;
+    for (Writer* writer : _writers) {
+        size_t bytes = writer->batch->GetDataSize();
+        if (!group.empty() &&
+            static_cast<int64_t>(group_bytes + bytes) > config::tablet_meta_group_commit_max_bytes) {
+            break;
+        }
+        group.push_back(writer);
+        group_bytes += bytes;
+    }
+    l.unlock();
+
+    // The batches of a group are committed or failed together.
+    Status st;
+    if (group.size() == 1) {
+        st = _write(batch);
+    } else {
+        WriteBatch merged;
+        for (Writer* writer : group) {
+            st = _append(&merged, writer->batch);
+            if (!st.ok()) {
+                break;
+            }
+        }
+        if (st.ok()) {
+            st = _write(&merged);
+        }
+    }
+
+    l.lock();
+    for (Writer* writer : group) {
+        DCHECK_EQ(writer, _writers.front());
+        _writers.pop_front();
+        writer->status = st;
+        writer->done = true;
+        if (writer != &w) {
+            writer->cv.notify_one();
+        }
+    }
+    if (!_writers.empty()) {
+        _writers.front()->cv.notify_one();
+    }
+    return st;
+}
+
+// Replay the records of a batch into another one.
+class BatchAppender : public rocksdb::WriteBatch::Handler {
+public:
+    BatchAppender(WriteBatch* dst, const std::vector<ColumnFamilyHandle*>& handles) : _dst(dst), _handles(handles) {}
+
+    rocksdb::Status PutCF(uint32_t column_family_id, const rocksdb::Slice& key, const rocksdb::Slice& value) override {
+        ColumnFamilyHandle* handle = _handle(column_family_id);
+        return handle == nullptr ? _unknown(column_family_id) : _dst->Put(handle, key, value);
+    }
+
+    rocksdb::Status DeleteCF(uint32_t column_family_id, const rocksdb::Slice& key) override {
+        ColumnFamilyHandle* handle = _handle(column_family_id);
+        return handle == nullptr ? _unknown(column_family_id) : _dst->Delete(handle, key);
+    }
+
+    rocksdb::Status SingleDeleteCF(uint32_t column_family_id, const rocksdb::Slice& key) override {
+        ColumnFamilyHandle* handle = _handle(column_family_id);
+        return handle == nullptr ? _unknown(column_family_id) : _dst->SingleDelete(handle, key);
+    }
+
+    rocksdb::Status DeleteRangeCF(uint32_t column_family_id, const rocksdb::Slice& begin_key,
+                                  const rocksdb::Slice& end_key) override {
+        ColumnFamilyHandle* handle = _handle(column_family_id);
+        return handle == nullptr ? _unknown(column_family_id) : _dst->DeleteRange(handle, begin_key, end_key);
+    }
+
+    rocksdb::Status MergeCF(uint32_t column_family_id, const rocksdb::Slice& key,
+                            const rocksdb::Slice& value) override {
+        ColumnFamilyHandle* handle = _handle(column_family_id);
+        return handle == nullptr ? _unknown(column_family_id) : _dst->Merge(handle, key, value);
+    }
+
+private:
+    ColumnFamilyHandle* _handle(uint32_t column_family_id) const {
+        for (auto* handle : _handles) {
+            if (handle->GetID() == column_family_id) {
+                return handle;
+            }
+        }
+        return nullptr;
+    }
+
+    static rocksdb::Status _unknown(uint32_t column_family_id) {
+        return rocksdb::Status::InvalidArgument("unknown column family " + std::to_string(column_family_id));
+    }
+
+    WriteBatch* _dst;
+    const std::vector<ColumnFamilyHandle*>& _handles;
+};
+
+Status KVStore::_append(WriteBatch* dst, WriteBatch* src) {
+    BatchAppender appender(dst, _handles);
+    return to_status(src->Iterate(&appender));
+}
+
 Status KVStore::remove(ColumnFamilyIndex column_family_index, const std::string& key) {
+    if (_group_commit_enabled()) {
+        WriteBatch batch;
+        RETURN_IF_ERROR(to_status(batch.Delete(_handles[column_family_index], key)));
+        return write_batch(&batch);
+    }
     StarRocksMetrics::instance()->meta_write_request_total.increment(1);
     rocksdb::ColumnFamilyHandle* handle = _handles[column_family_index];
     rocksdb::Status s;
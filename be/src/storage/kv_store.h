@@ -36,8 +36,10 @@
 
 #include <rocksdb/write_batch.h>
 
+#include <deque>
 #include <functional>
 #include <map>
+#include <mutex>
 #include <string>
 #include <string_view>
 
@@ -66,6 +68,8 @@ public:
 
     Status put(ColumnFamilyIndex column_family_index, const std::string& key, const std::string& value);
 
+    // The concurrent batches may be group committed, see config::tablet_meta_group_commit_window_us, and this
+    // returns after the batch is committed.
     Status write_batch(WriteBatch* batch);
 
     Status remove(ColumnFamilyIndex column_family_index, const std::string& key);
@@ -90,9 +94,22 @@ public:
     ColumnFamilyHandle* handle(ColumnFamilyIndex column_family_index) { return _handles[column_family_index]; }
 
 private:
+    struct Writer;
+
+    static bool _group_commit_enabled();
+    Status _write(WriteBatch* batch);
+    // Wait for |batch| to be committed by the leader of its group, or commit the group as the leader.
+    Status _group_commit(WriteBatch* batch);
+    // Append the records of |src| to |dst|.
+    Status _append(WriteBatch* dst, WriteBatch* src);
+
     std::string _root_path;
     rocksdb::DB* _db;
     std::vector<rocksdb::ColumnFamilyHandle*> _handles;
+
+    std::mutex _writers_mutex;
+    // The writers waiting for the group commit, the first one is the leader of the next group.
+    std::deque<Writer*> _writers;
 };
 
 } // namespace starrocks
@@ -0,0 +1,282 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/lake/cache_warmer.h"
+
+#include <fstream>
+#include <sstream>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "fs/fs.h"
+#include "gutil/strings/join.h"
+#include "gutil/strings/numbers.h"
+#include "gutil/strings/split.h"
+#include "io/io_stats.h"
+#include "storage/chunk_helper.h"
+#include "storage/lake/rowset.h"
+#include "storage/lake/tablet.h"
+#include "storage/lake/tablet_manager.h"
+#include "storage/olap_common.h"
+#include "storage/rowset/segment.h"
+#include "storage/rowset/segment_options.h"
+#include "storage/tablet_schema.h"
+#include "util/monotime.h"
+#include "util/thread.h"
+#include "util/time.h"
+
+namespace starrocks::lake {
+
+static constexpr int64_t kWarmupReadSize = 1024 * 1024;
+
+CacheWarmer::CacheWarmer(TabletManager* tablet_mgr) : _tablet_mgr(tablet_mgr) {}
+
+CacheWarmer::~CacheWarmer() {
+    stop();
+}
+
+Status CacheWarmer::start() {
+    std::vector<CacheWarmupTask> tasks;
+    auto st = _load_recorded_tasks(&tasks);
+    LOG_IF(WARNING, !st.ok()) << "Fail to load the recorded cache warmup tablets: " << st;
+    _thread = std::thread([this] { _run(); });
+    Thread::set_thread_name(_thread, "lake_cache_warm");
+    if (!tasks.empty()) {
+        LOG(INFO) << "Warm up the cache of " << tasks.size() << " tablets recorded before restart";
+        RETURN_IF_ERROR(submit(std::move(tasks)));
+    }
+    return Status::OK();
+}
+
+void CacheWarmer::stop() {
+    {
+        std::lock_guard l(_mutex);
+        _stopped = true;
+    }
+    _cv.notify_all();
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+Status CacheWarmer::submit(std::vector<CacheWarmupTask> tasks) {
+    {
+        std::lock_guard l(_mutex);
+        if (_stopped) {
+            return Status::ServiceUnavailable("cache warmer is stopped");
+        }
+        for (auto& task : tasks) {
+            if (!_pending_keys.emplace(task.tablet_id, task.version).second) {
+                continue;
+            }
+            _pending.emplace_back(std::move(task));
+            _total_tablets++;
+        }
+    }
+    _cv.notify_one();
+    return Status::OK();
+}
+
+CacheWarmer::Progress CacheWarmer::progress() const {
+    Progress progress;
+    progress.total_tablets = _total_tablets;
+    progress.finished_tablets = _finished_tablets;
+    progress.failed_tablets = _failed_tablets;
+    progress.loaded_bytes = _loaded_bytes;
+    std::lock_guard l(_mutex);
+    progress.pending_tablets = _pending.size();
+    return progress;
+}
+
+void CacheWarmer::_run() {
+    while (true) {
+        CacheWarmupTask task;
+        {
+            std::unique_lock l(_mutex);
+            _cv.wait(l, [this] { return _stopped || !_pending.empty(); });
+            if (_stopped) {
+                return;
+            }
+            task = std::move(_pending.front());
+            _pending.pop_front();
+            _pending_keys.erase({task.tablet_id, task.version});
+        }
+        auto st = _warmup(task);
+        if (st.ok()) {
+            _finished_tablets++;
+            if (task.record) {
+                _record(task);
+            }
+        } else {
+            _failed_tablets++;
+            LOG(WARNING) << "Fail to warm up the cache of tablet " << task.tablet_id << " version " << task.version
+                         << ": " << st;
+        }
+    }
+}
+
+Status CacheWarmer::_warmup(const CacheWarmupTask& task) {
+    SCOPED_IO_PURPOSE(io::IOPurpose::CACHE_FILL);
+    ASSIGN_OR_RETURN(auto tablet, _tablet_mgr->get_tablet(task.tablet_id));
+    ASSIGN_OR_RETURN(auto rowsets, tablet.get_rowsets(task.version));
+    for (const auto& rowset : rowsets) {
+        // Load the footers and indexes into the metadata cache.
+        std::vector<SegmentPtr> segments;
+        RETURN_IF_ERROR(rowset->load_segments(&segments, true));
+        if (task.columns.empty()) {
+            for (const auto& segment_name : rowset->metadata().segments()) {
+                RETURN_IF_ERROR(_warmup_file(tablet.segment_location(segment_name)));
+            }
+        }
+    }
+    if (!task.columns.empty()) {
+        RETURN_IF_ERROR(_warmup_columns(&tablet, task));
+    }
+    return Status::OK();
+}
+
+Status CacheWarmer::_warmup_file(const std::string& location) {
+    ASSIGN_OR_RETURN(auto fs, FileSystem::CreateSharedFromString(location));
+    RandomAccessFileOptions opts{.skip_fill_local_cache = false};
+    ASSIGN_OR_RETURN(auto file, fs->new_random_access_file(opts, location));
+    ASSIGN_OR_RETURN(auto file_size, file->get_size());
+    std::string buffer;
+    buffer.resize(std::min(kWarmupReadSize, file_size));
+    for (int64_t offset = 0; offset < file_size; offset += kWarmupReadSize) {
+        int64_t count = std::min(kWarmupReadSize, file_size - offset);
+        RETURN_IF_ERROR(file->read_at_fully(offset, buffer.data(), count));
+        _loaded_bytes += count;
+        _throttle(count);
+    }
+    return Status::OK();
+}
+
+Status CacheWarmer::_warmup_columns(Tablet* tablet, const CacheWarmupTask& task) {
+    ASSIGN_OR_RETURN(auto tablet_schema, tablet->get_schema());
+    std::vector<ColumnId> column_ids;
+    for (const auto& name : task.columns) {
+        auto idx = tablet_schema->field_index(name);
+        if (idx == static_cast<size_t>(-1)) {
+            return Status::InvalidArgument("unknown column " + name);
+        }
+        column_ids.push_back(idx);
+    }
+    auto schema = ChunkHelper::convert_schema(*tablet_schema, column_ids);
+    ASSIGN_OR_RETURN(auto rowsets, tablet->get_rowsets(task.version));
+    OlapReaderStatistics stats;
+    for (const auto& rowset : rowsets) {
+        std::vector<SegmentPtr> segments;
+        RETURN_IF_ERROR(rowset->load_segments(&segments, true));
+        for (const auto& segment : segments) {
+            SegmentReadOptions seg_options;
+            ASSIGN_OR_RETURN(seg_options.fs, FileSystem::CreateSharedFromString(tablet->root_location()));
+            seg_options.stats = &stats;
+            seg_options.use_page_cache = true;
+            auto res = segment->new_iterator(schema, seg_options);
+            if (res.status().is_end_of_file()) {
+                continue;
+            }
+            RETURN_IF_ERROR(res);
+            auto iter = std::move(res).value();
+            auto chunk = ChunkHelper::new_chunk(schema, config::vector_chunk_size);
+            while (true) {
+                chunk->reset();
+                int64_t prev_bytes = stats.compressed_bytes_read;
+                auto st = iter->get_next(chunk.get());
+                int64_t bytes = stats.compressed_bytes_read - prev_bytes;
+                _loaded_bytes += bytes;
+                _throttle(bytes);
+                if (st.is_end_of_file()) {
+                    break;
+                }
+                RETURN_IF_ERROR(st);
+            }
+            iter->close();
+        }
+    }
+    return Status::OK();
+}
+
+void CacheWarmer::_throttle(int64_t bytes) {
+    const int64_t limit = config::lake_cache_warmup_max_bytes_per_second;
+    if (limit <= 0) {
+        return;
+    }
+    int64_t now = MonotonicNanos();
+    // Restart the window every second, so the idle time is not accumulated as the credit.
+    if (now - _throttle_start_ns > NANOS_PER_SEC) {
+        _throttle_start_ns = now;
+        _throttle_bytes = 0;
+    }
+    _throttle_bytes += bytes;
+    int64_t expected_ns = _throttle_bytes * NANOS_PER_SEC / limit;
+    int64_t elapsed_ns = now - _throttle_start_ns;
+    if (expected_ns > elapsed_ns) {
+        SleepFor(MonoDelta::FromNanoseconds(expected_ns - elapsed_ns));
+    }
+}
+
+void CacheWarmer::_record(const CacheWarmupTask& task) {
+    const std::string& path = config::lake_cache_warmup_meta_file;
+    if (path.empty()) {
+        return;
+    }
+    // Each line is "<tablet_id> <version> [<column>,...]"
+    std::stringstream ss;
+    {
+        std::lock_guard l(_mutex);
+        _warmed_tablets[task.tablet_id] = task;
+        for (const auto& [tablet_id, t] : _warmed_tablets) {
+            ss << tablet_id << " " << t.version << " " << JoinStrings(t.columns, ",") << "\n";
+        }
+    }
+    std::string tmp_path = path + ".tmp";
+    std::ofstream of(tmp_path, std::ios::out | std::ios::trunc);
+    of << ss.str();
+    of.close();
+    if (!of || std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        LOG(WARNING) << "Fail to record the cache warmup tablets to " << path;
+    }
+}
+
+Status CacheWarmer::_load_recorded_tasks(std::vector<CacheWarmupTask>* tasks) {
+    const std::string& path = config::lake_cache_warmup_meta_file;
+    if (path.empty()) {
+        return Status::OK();
+    }
+    std::ifstream in(path);
+    if (!in) {
+        return Status::OK();
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+        std::vector<std::string> fields = strings::Split(line, " ", strings::SkipEmpty());
+        if (fields.size() < 2) {
+            continue;
+        }
+        CacheWarmupTask task;
+        if (!safe_strto64(fields[0], &task.tablet_id) || !safe_strto64(fields[1], &task.version)) {
+            return Status::Corruption("invalid line in " + path + ": " + line);
+        }
+        if (fields.size() > 2) {
+            task.columns = strings::Split(fields[2], ",", strings::SkipEmpty());
+        }
+        std::lock_guard l(_mutex);
+        _warmed_tablets[task.tablet_id] = task;
+        tasks->emplace_back(std::move(task));
+    }
+    return Status::OK();
+}
+
+} // namespace starrocks::lake
@@ -0,0 +1,107 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/status.h"
+#include "gutil/macros.h"
+
+namespace starrocks::lake {
+
+class Tablet;
+class TabletManager;
+
+struct CacheWarmupTask {
+    int64_t tablet_id = 0;
+    int64_t version = 0;
+    // The columns to load, all data of the segments are loaded if empty.
+    std::vector<std::string> columns;
+    // Whether to record the tablet in `lake_cache_warmup_meta_file`, false for the prefetches of queries.
+    bool record = true;
+};
+
+// CacheWarmer loads the segments of the chosen tablets into the local caches in background, ahead of the
+// queries, so a compute node just started does not read every segment from the object storage:
+// - the footers and indexes of the segments are loaded into the metadata cache of TabletManager.
+// - the segment files, or the pages of the chosen columns, are read through the file system to fill its local
+//   cache, and the page cache for the chosen columns.
+// The loading is limited by `lake_cache_warmup_max_bytes_per_second`. The tablets warmed up are recorded in
+// `lake_cache_warmup_meta_file` if set, and warmed up again after restart.
+class CacheWarmer {
+public:
+    struct Progress {
+        int64_t total_tablets = 0;
+        int64_t finished_tablets = 0;
+        int64_t failed_tablets = 0;
+        int64_t pending_tablets = 0;
+        int64_t loaded_bytes = 0;
+    };
+
+    explicit CacheWarmer(TabletManager* tablet_mgr);
+
+    ~CacheWarmer();
+
+    DISALLOW_COPY_AND_MOVE(CacheWarmer);
+
+    // Start the background thread, and submit the tablets recorded before restart.
+    Status start();
+
+    void stop();
+
+    // The tasks of the same tablet and version as a pending one are ignored.
+    Status submit(std::vector<CacheWarmupTask> tasks);
+
+    Progress progress() const;
+
+private:
+    void _run();
+    Status _warmup(const CacheWarmupTask& task);
+    Status _warmup_file(const std::string& location);
+    Status _warmup_columns(Tablet* tablet, const CacheWarmupTask& task);
+    // Sleep to keep the loading not faster than the limit after |bytes| loaded.
+    void _throttle(int64_t bytes);
+    void _record(const CacheWarmupTask& task);
+    Status _load_recorded_tasks(std::vector<CacheWarmupTask>* tasks);
+
+    TabletManager* _tablet_mgr;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _cv;
+    std::deque<CacheWarmupTask> _pending;
+    // The tablet ids and versions of the pending tasks.
+    std::set<std::pair<int64_t, int64_t>> _pending_keys;
+    // The latest version of the tablets warmed up.
+    std::map<int64_t, CacheWarmupTask> _warmed_tablets;
+    bool _stopped = false;
+    std::thread _thread;
+
+    std::atomic<int64_t> _total_tablets{0};
+    std::atomic<int64_t> _finished_tablets{0};
+    std::atomic<int64_t> _failed_tablets{0};
+    std::atomic<int64_t> _loaded_bytes{0};
+    int64_t _throttle_start_ns = 0;
+    int64_t _throttle_bytes = 0;
+};
+
+} // namespace starrocks::lake
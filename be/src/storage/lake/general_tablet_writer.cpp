@@ -22,6 +22,7 @@
 #include "serde/column_array_serde.h"
 #include "storage/lake/filenames.h"
 #include "storage/rowset/segment_writer.h"
+#include "storage/rowset/shared_dictionary.h"
 
 namespace starrocks::lake {
 
@@ -78,6 +79,12 @@ Status GeneralTabletWriter::reset_segment_writer() {
     auto name = random_segment_filename();
     ASSIGN_OR_RETURN(auto of, fs::new_writable_file(_tablet.segment_location(name)));
     SegmentWriterOptions opts;
+    if (config::enable_shared_segment_dictionary) {
+        if (_shared_dicts == nullptr) {
+            _shared_dicts = std::make_shared<SharedDictionaries>();
+        }
+        opts.shared_dicts = _shared_dicts;
+    }
     auto w = std::make_unique<SegmentWriter>(std::move(of), _seg_id++, _schema.get(), opts);
     RETURN_IF_ERROR(w->init());
     _seg_writer = std::move(w);
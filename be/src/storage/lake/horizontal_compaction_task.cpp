@@ -14,6 +14,12 @@
 
 #include "storage/lake/horizontal_compaction_task.h"
 
+#include <algorithm>
+
+#include "column/datum_convert.h"
+#include "io/io_stats.h"
+#include "runtime/current_thread.h"
+#include "runtime/exec_env.h"
 #include "runtime/runtime_state.h"
 #include "storage/chunk_helper.h"
 #include "storage/compaction_utils.h"
@@ -22,15 +28,22 @@
 #include "storage/lake/tablet_reader.h"
 #include "storage/lake/tablet_writer.h"
 #include "storage/lake/txn_log.h"
+#include "storage/rowset/column_reader.h"
+#include "storage/rowset/segment.h"
 #include "storage/storage_engine.h"
 #include "storage/tablet_reader_params.h"
+#include "storage/types.h"
+#include "storage/zone_map_detail.h"
+#include "util/countdown_latch.h"
 #include "util/defer_op.h"
+#include "util/threadpool.h"
 
 namespace starrocks::lake {
 
 HorizontalCompactionTask::~HorizontalCompactionTask() = default;
 
 Status HorizontalCompactionTask::execute(Stats* stats) {
+    SCOPED_IO_PURPOSE(io::IOPurpose::COMPACTION);
     ASSIGN_OR_RETURN(auto tablet_schema, _tablet->get_schema());
     const KeysType keys_type = tablet_schema->keys_type();
     int64_t num_rows = 0;
@@ -47,10 +60,186 @@ Status HorizontalCompactionTask::execute(Stats* stats) {
             max_input_segs += rowset->is_overlapped() ? rowset->num_segments() : 1;
         }
     }
-    const int32_t chunk_size = CompactionUtils::get_read_chunk_size(
-            config::compaction_memory_limit_per_worker, config::vector_chunk_size, num_rows, num_size, max_input_segs);
+
+    std::vector<std::string> boundaries;
+    RETURN_IF_ERROR(_pick_range_boundaries(*tablet_schema, num_size, &boundaries));
+    const size_t num_ranges = boundaries.size() + 1;
+    // Every range has its own reader and writer, so share the memory among them.
+    const int32_t chunk_size =
+            CompactionUtils::get_read_chunk_size(config::compaction_memory_limit_per_worker / num_ranges,
+                                                 config::vector_chunk_size, num_rows, num_size, max_input_segs);
 
     Schema schema = ChunkHelper::convert_schema(*tablet_schema);
+    std::vector<std::unique_ptr<TabletWriter>> writers(num_ranges);
+    DeferOp defer([&]() {
+        for (auto& writer : writers) {
+            if (writer != nullptr) {
+                writer->close();
+            }
+        }
+    });
+    for (auto& writer : writers) {
+        ASSIGN_OR_RETURN(writer, _tablet->new_writer());
+        RETURN_IF_ERROR(writer->open());
+    }
+
+    auto compact_range = [&](size_t i) -> Status {
+        OlapTuple start_key;
+        OlapTuple end_key;
+        if (i > 0) {
+            start_key.add_value(boundaries[i - 1]);
+        }
+        if (i + 1 < num_ranges) {
+            end_key.add_value(boundaries[i]);
+        }
+        return _compact_range(schema, *tablet_schema, chunk_size, start_key, end_key, writers[i].get());
+    };
+    std::vector<Status> results(num_ranges);
+    ThreadPool* pool = num_ranges > 1 ? ExecEnv::GetInstance()->lake_compaction_range_pool() : nullptr;
+    if (pool == nullptr) {
+        for (size_t i = 0; i < num_ranges; i++) {
+            results[i] = compact_range(i);
+        }
+    } else {
+        CountDownLatch latch(num_ranges - 1);
+        MemTracker* mem_tracker = CurrentThread::mem_tracker();
+        for (size_t i = 1; i < num_ranges; i++) {
+            auto st = pool->submit_func([&, i]() {
+                SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(mem_tracker);
+                results[i] = compact_range(i);
+                latch.count_down();
+            });
+            if (!st.ok()) {
+                // The pool is full or shutting down, compact the range in the current thread.
+                results[i] = compact_range(i);
+                latch.count_down();
+            }
+        }
+        results[0] = compact_range(0);
+        latch.wait();
+    }
+    for (const auto& st : results) {
+        RETURN_IF_ERROR(st);
+    }
+
+    auto txn_log = std::make_shared<TxnLog>();
+    auto op_compaction = txn_log->mutable_op_compaction();
+    txn_log->set_tablet_id(_tablet->id());
+    txn_log->set_txn_id(_txn_id);
+    for (auto& rowset : _input_rowsets) {
+        op_compaction->add_input_rowsets(rowset->id());
+    }
+    // The ranges are in key order, so are the segments of the output rowset.
+    int64_t output_rows = 0;
+    int64_t output_size = 0;
+    for (auto& writer : writers) {
+        for (auto& file : writer->files()) {
+            op_compaction->mutable_output_rowset()->add_segments(file);
+        }
+        output_rows += writer->num_rows();
+        output_size += writer->data_size();
+    }
+    op_compaction->mutable_output_rowset()->set_num_rows(output_rows);
+    op_compaction->mutable_output_rowset()->set_data_size(output_size);
+    op_compaction->mutable_output_rowset()->set_overlapped(false);
+    Status st = _tablet->put_txn_log(std::move(txn_log));
+    if (st.ok() && stats != nullptr) {
+        stats->input_bytes.fetch_add(num_size, std::memory_order_relaxed);
+        stats->input_rows.fetch_add(num_rows, std::memory_order_relaxed);
+        stats->output_bytes.fetch_add(output_size, std::memory_order_relaxed);
+        stats->output_rows.fetch_add(output_rows, std::memory_order_relaxed);
+    }
+    return st;
+}
+
+Status HorizontalCompactionTask::_pick_range_boundaries(const TabletSchema& tablet_schema, int64_t input_bytes,
+                                                        std::vector<std::string>* boundaries) {
+    const int64_t min_range_bytes = std::max<int64_t>(1, config::lake_compaction_min_sub_range_bytes);
+    const int64_t max_ranges = std::min<int64_t>(config::lake_compaction_max_sub_ranges, input_bytes / min_range_bytes);
+    if (max_ranges <= 1 || tablet_schema.keys_type() == PRIMARY_KEYS || tablet_schema.num_key_columns() == 0) {
+        return Status::OK();
+    }
+    // The ranges are seeked by the first key column, so it must be the first sort key too.
+    if (!tablet_schema.sort_key_idxes().empty() && tablet_schema.sort_key_idxes()[0] != 0) {
+        return Status::OK();
+    }
+    const LogicalType key_type = tablet_schema.column(0).type();
+    switch (key_type) {
+    case TYPE_TINYINT:
+    case TYPE_SMALLINT:
+    case TYPE_INT:
+    case TYPE_BIGINT:
+    case TYPE_LARGEINT:
+    case TYPE_DATE:
+    case TYPE_DATETIME:
+    case TYPE_VARCHAR:
+        break;
+    default:
+        return Status::OK();
+    }
+    auto type_info = get_type_info(delegate_type(key_type));
+
+    struct SegmentMin {
+        // the values of the zone map refer to the memory of the segment
+        SegmentPtr segment;
+        ZoneMapDetail zone_map;
+    };
+    std::vector<SegmentMin> mins;
+    int64_t total_rows = 0;
+    int64_t null_rows = 0;
+    for (auto& rowset : _input_rowsets) {
+        ASSIGN_OR_RETURN(auto segments, rowset->segments(false));
+        for (auto& segment : segments) {
+            if (segment->num_rows() == 0) {
+                continue;
+            }
+            if (segment->num_columns() == 0 || segment->column(0) == nullptr) {
+                return Status::OK();
+            }
+            SegmentMin min{segment, {}};
+            if (!segment->column(0)->segment_zone_map_detail(&min.zone_map).ok()) {
+                return Status::OK();
+            }
+            total_rows += segment->num_rows();
+            if (min.zone_map.has_not_null()) {
+                mins.emplace_back(std::move(min));
+            } else {
+                null_rows += segment->num_rows();
+            }
+        }
+    }
+    if (mins.size() < 2) {
+        return Status::OK();
+    }
+    std::sort(mins.begin(), mins.end(), [&](const SegmentMin& a, const SegmentMin& b) {
+        return type_info->cmp(a.zone_map.min_value(), b.zone_map.min_value()) < 0;
+    });
+
+    // The rows of the segments with smaller minimums approximate the rows smaller than a minimum, so cut the
+    // ranges at the minimums closest to the quantiles of the rows. The same minimums are cut only once.
+    const Datum* last = &mins[0].zone_map.min_value();
+    int64_t rows_before = null_rows;
+    int64_t next_range = 1;
+    for (const auto& min : mins) {
+        if (next_range >= max_ranges) {
+            break;
+        }
+        if (rows_before * max_ranges >= total_rows * next_range &&
+            type_info->cmp(min.zone_map.min_value(), *last) > 0) {
+            boundaries->emplace_back(datum_to_string(type_info.get(), min.zone_map.min_value()));
+            last = &min.zone_map.min_value();
+            while (next_range < max_ranges && rows_before * max_ranges >= total_rows * next_range) {
+                next_range++;
+            }
+        }
+        rows_before += min.segment->num_rows();
+    }
+    return Status::OK();
+}
+
+Status HorizontalCompactionTask::_compact_range(const Schema& schema, const TabletSchema& tablet_schema,
+                                                int32_t chunk_size, const OlapTuple& start_key,
+                                                const OlapTuple& end_key, TabletWriter* writer) {
     TabletReader reader(*_tablet, _version, schema, _input_rowsets);
     RETURN_IF_ERROR(reader.prepare());
     TabletReaderParams reader_params;
@@ -58,12 +247,14 @@ Status HorizontalCompactionTask::execute(Stats* stats) {
     reader_params.chunk_size = chunk_size;
     reader_params.profile = nullptr;
     reader_params.use_page_cache = false;
+    if (start_key.size() > 0 || end_key.size() > 0) {
+        reader_params.range = TabletReaderParams::RangeStartOperation::GE;
+        reader_params.end_range = TabletReaderParams::RangeEndOperation::LT;
+        reader_params.start_key.emplace_back(start_key);
+        reader_params.end_key.emplace_back(end_key);
+    }
     RETURN_IF_ERROR(reader.open(reader_params));
 
-    ASSIGN_OR_RETURN(auto writer, _tablet->new_writer());
-    RETURN_IF_ERROR(writer->open());
-    DeferOp defer([&]() { writer->close(); });
-
     auto chunk = ChunkHelper::new_chunk(schema, chunk_size);
     auto char_field_indexes = ChunkHelper::get_char_field_indexes(schema);
 
@@ -79,33 +270,11 @@ Status HorizontalCompactionTask::execute(Stats* stats) {
         } else if (!st.ok()) {
             return st;
         }
-        ChunkHelper::padding_char_columns(char_field_indexes, schema, *tablet_schema, chunk.get());
+        ChunkHelper::padding_char_columns(char_field_indexes, schema, tablet_schema, chunk.get());
         RETURN_IF_ERROR(writer->write(*chunk));
         chunk->reset();
     }
-    RETURN_IF_ERROR(writer->finish());
-
-    auto txn_log = std::make_shared<TxnLog>();
-    auto op_compaction = txn_log->mutable_op_compaction();
-    txn_log->set_tablet_id(_tablet->id());
-    txn_log->set_txn_id(_txn_id);
-    for (auto& rowset : _input_rowsets) {
-        op_compaction->add_input_rowsets(rowset->id());
-    }
-    for (auto& file : writer->files()) {
-        op_compaction->mutable_output_rowset()->add_segments(file);
-    }
-    op_compaction->mutable_output_rowset()->set_num_rows(writer->num_rows());
-    op_compaction->mutable_output_rowset()->set_data_size(writer->data_size());
-    op_compaction->mutable_output_rowset()->set_overlapped(false);
-    Status st = _tablet->put_txn_log(std::move(txn_log));
-    if (st.ok() && stats != nullptr) {
-        stats->input_bytes.fetch_add(num_size, std::memory_order_relaxed);
-        stats->input_rows.fetch_add(num_rows, std::memory_order_relaxed);
-        stats->output_bytes.fetch_add(writer->data_size(), std::memory_order_relaxed);
-        stats->output_rows.fetch_add(writer->num_rows(), std::memory_order_relaxed);
-    }
-    return st;
+    return writer->finish();
 }
 
 } // namespace starrocks::lake
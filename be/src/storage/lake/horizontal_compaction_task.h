@@ -15,6 +15,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "storage/lake/compaction_task.h"
@@ -22,6 +23,9 @@
 namespace starrocks {
 class Chunk;
 class ChunkIterator;
+class OlapTuple;
+class Schema;
+class TabletSchema;
 } // namespace starrocks
 
 namespace starrocks::lake {
@@ -44,6 +48,15 @@ public:
     Status execute(Stats* stats) override;
 
 private:
+    // Pick the boundaries of the key ranges which are compacted concurrently from the segment zone maps of the
+    // first key column, return no boundary if the input is not worth splitting.
+    Status _pick_range_boundaries(const TabletSchema& tablet_schema, int64_t input_bytes,
+                                  std::vector<std::string>* boundaries);
+
+    // Merge the input rows in [|start_key|, |end_key|) into |writer|, an empty key means unbounded.
+    Status _compact_range(const Schema& schema, const TabletSchema& tablet_schema, int32_t chunk_size,
+                          const OlapTuple& start_key, const OlapTuple& end_key, TabletWriter* writer);
+
     int64_t _txn_id;
     int64_t _version;
     std::shared_ptr<Tablet> _tablet;
@@ -14,13 +14,41 @@
 
 #include "storage/lake/lake_primary_index.h"
 
+#include "common/config.h"
+#include "fmt/format.h"
+#include "fs/fs_util.h"
 #include "storage/chunk_helper.h"
+#include "storage/data_dir.h"
 #include "storage/lake/tablet.h"
 #include "storage/primary_key_encoder.h"
+#include "storage/protobuf_file.h"
+#include "storage/storage_engine.h"
 
 namespace starrocks {
 namespace lake {
 
+static const char* const kIndexMetaFileName = "index.meta";
+
+std::string LakePrimaryIndex::local_index_path(int64_t tablet_id) {
+    if (StorageEngine::instance() == nullptr) {
+        return "";
+    }
+    auto stores = StorageEngine::instance()->get_stores();
+    if (stores.empty()) {
+        return "";
+    }
+    return fmt::format("{}/lake_persistent_index/{}", stores[tablet_id % stores.size()]->path(), tablet_id);
+}
+
+Status LakePrimaryIndex::remove_local_index(int64_t tablet_id) {
+    auto path = local_index_path(tablet_id);
+    if (path.empty()) {
+        return Status::OK();
+    }
+    auto st = fs::remove_all(path);
+    return st.is_not_found() ? Status::OK() : st;
+}
+
 Status LakePrimaryIndex::lake_load(Tablet* tablet, const TabletMetadata& metadata, int64_t base_version,
                                    const MetaFileBuilder* builder) {
     std::lock_guard<std::mutex> lg(_lock);
@@ -48,6 +76,21 @@ Status LakePrimaryIndex::_do_lake_load(Tablet* tablet, const TabletMetadata& met
     auto pkey_schema = ChunkHelper::convert_schema(*tablet_schema, pk_columns);
     _set_schema(pkey_schema);
 
+    size_t fix_size = PrimaryKeyEncoder::get_encoded_fixed_size(pkey_schema);
+    if (config::enable_lake_persistent_index && fix_size <= 128) {
+        _index_path = local_index_path(tablet->id());
+    }
+    if (!_index_path.empty()) {
+        ASSIGN_OR_RETURN(bool loaded, _load_persistent_index(_index_path, fix_size, base_version));
+        if (loaded) {
+            _tablet_id = tablet->id();
+            _data_version = base_version;
+            LOG(INFO) << "LakePrimaryIndex load from local index, tablet:" << tablet->id()
+                      << " version:" << base_version << " cost(ms): " << watch.elapsed_time() / 1000000;
+            return Status::OK();
+        }
+    }
+
     OlapReaderStatistics stats;
     std::unique_ptr<Column> pk_column;
     if (pk_columns.size() > 1) {
@@ -105,6 +148,12 @@ Status LakePrimaryIndex::_do_lake_load(Tablet* tablet, const TabletMetadata& met
             itr->close();
         }
     }
+    if (_persistent_index != nullptr) {
+        // persist the index built from the segments, as the snapshot of base_version
+        RETURN_IF_ERROR(_persistent_index->commit(&_index_meta));
+        RETURN_IF_ERROR(ProtobufFile(_index_path + "/" + kIndexMetaFileName).save(_index_meta, true));
+        RETURN_IF_ERROR(_persistent_index->on_commited());
+    }
     _tablet_id = tablet->id();
     _data_version = base_version;
     if (watch.elapsed_time() > /*10ms=*/10 * 1000 * 1000) {
@@ -113,6 +162,55 @@ Status LakePrimaryIndex::_do_lake_load(Tablet* tablet, const TabletMetadata& met
     return Status::OK();
 }
 
+StatusOr<bool> LakePrimaryIndex::_load_persistent_index(const std::string& path, size_t key_size,
+                                                        int64_t base_version) {
+    _persistent_index = std::make_unique<PersistentIndex>(path);
+    const std::string meta_path = path + "/" + kIndexMetaFileName;
+    if (fs::path_exist(meta_path)) {
+        auto st = ProtobufFile(meta_path).load(&_index_meta);
+        if (st.ok() && _index_meta.format_version() == PERSISTENT_INDEX_VERSION_2 &&
+            _index_meta.key_size() == key_size && _index_meta.version().major() == base_version) {
+            st = _persistent_index->load(_index_meta);
+            if (st.ok()) {
+                return true;
+            }
+        }
+        // The txn logs of the versions in between were deleted after publish, so an index of the
+        // other versions can't catch up, rebuild it from the segments.
+        LOG(INFO) << "rebuild local primary index " << path << ", version:" << base_version
+                  << " local version:" << _index_meta.version().major() << " status:" << st;
+        _persistent_index = std::make_unique<PersistentIndex>(path);
+    }
+    _index_meta.Clear();
+    auto st = fs::remove_all(path);
+    if (!st.ok() && !st.is_not_found()) {
+        return st;
+    }
+    RETURN_IF_ERROR(fs::create_directories(path));
+    RETURN_IF_ERROR(_persistent_index->reset(key_size, EditVersion(base_version, 0), &_index_meta));
+    return false;
+}
+
+Status LakePrimaryIndex::prepare_publish(int64_t version) {
+    std::lock_guard<std::mutex> lg(_lock);
+    if (_persistent_index == nullptr || _prepared_version == version) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(prepare(EditVersion(version, 0)));
+    _prepared_version = version;
+    return Status::OK();
+}
+
+Status LakePrimaryIndex::commit_publish(int64_t version) {
+    std::lock_guard<std::mutex> lg(_lock);
+    if (_persistent_index == nullptr || _prepared_version != version) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(commit(&_index_meta));
+    RETURN_IF_ERROR(ProtobufFile(_index_path + "/" + kIndexMetaFileName).save(_index_meta, true));
+    return on_commited();
+}
+
 } // namespace lake
 
 } // namespace starrocks
\ No newline at end of file
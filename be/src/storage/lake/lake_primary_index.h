@@ -44,13 +44,34 @@ public:
     int64_t data_version() const { return _data_version; }
     void update_data_version(int64_t version) { _data_version = version; }
 
+    // Prepare the persistent index for the changes of |version|, it's a no-op if the index is in memory
+    // or has been prepared for |version| already.
+    Status prepare_publish(int64_t version);
+
+    // Persist the changes of |version| into the local index files, it's a no-op if the index is in memory
+    // or not prepared for |version|.
+    Status commit_publish(int64_t version);
+
+    // The local directory of the persistent index of |tablet_id|, empty if there is no local store.
+    static std::string local_index_path(int64_t tablet_id);
+
+    static Status remove_local_index(int64_t tablet_id);
+
 private:
     Status _do_lake_load(Tablet* tablet, const TabletMetadata& metadata, int64_t base_version,
                          const MetaFileBuilder* builder);
 
+    // Load the persistent index from the local files if they are at |base_version|, otherwise
+    // return false and the caller should build the index from the segments.
+    StatusOr<bool> _load_persistent_index(const std::string& path, size_t key_size, int64_t base_version);
+
 private:
     // We don't support multi version in PrimaryIndex yet, but we will record latest data version for some checking
     int64_t _data_version = 0;
+    // The meta of the persistent index, only used when the index is persistent.
+    PersistentIndexMetaPB _index_meta;
+    std::string _index_path;
+    int64_t _prepared_version = 0;
 };
 
 } // namespace lake
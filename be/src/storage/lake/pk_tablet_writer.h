@@ -24,6 +24,7 @@
 
 namespace starrocks {
 class SegmentWriter;
+class SharedDictionaries;
 }
 
 namespace starrocks::lake {
@@ -64,6 +65,8 @@ private:
 
     Tablet _tablet;
     std::unique_ptr<SegmentWriter> _seg_writer;
+    // the dictionaries shared by the segments written by this writer.
+    std::shared_ptr<SharedDictionaries> _shared_dicts;
     std::vector<std::string> _files;
     int64_t _num_rows = 0;
     int64_t _data_size = 0;
@@ -25,6 +25,7 @@
 #include "storage/rowset/rowset_options.h"
 #include "storage/rowset/segment.h"
 #include "storage/rowset/segment_options.h"
+#include "storage/rowset/shared_dictionary.h"
 #include "storage/union_iterator.h"
 
 namespace starrocks::lake {
@@ -52,7 +53,11 @@ StatusOr<ChunkIteratorPtr> Rowset::read(const Schema& schema, const RowsetReadOp
     seg_options.reader_type = options.reader_type;
     seg_options.chunk_size = options.chunk_size;
     seg_options.global_dictmaps = options.global_dictmaps;
+    if (!options.global_dictmaps->empty()) {
+        seg_options.shared_dict_code_maps = std::make_shared<SharedDictCodeConvertMaps>();
+    }
     seg_options.unused_output_column_ids = options.unused_output_column_ids;
+    seg_options.lengths_only_column_ids = options.lengths_only_column_ids;
     if (options.is_primary_keys) {
         seg_options.is_primary_keys = true;
         seg_options.delvec_loader = std::make_shared<LakeDelvecLoader>(_tablet->update_mgr(), nullptr);
@@ -175,6 +180,12 @@ StatusOr<std::vector<ChunkIteratorPtr>> Rowset::get_each_segment_iterator_with_d
     return seg_iterators;
 }
 
+StatusOr<std::vector<SegmentPtr>> Rowset::segments(bool fill_cache) {
+    std::vector<SegmentPtr> segments;
+    RETURN_IF_ERROR(load_segments(&segments, fill_cache));
+    return segments;
+}
+
 Status Rowset::load_segments(std::vector<SegmentPtr>* segments, bool fill_cache) {
     size_t footer_size_hint = 16 * 1024;
     uint32_t seg_id = 0;
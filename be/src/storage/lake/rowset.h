@@ -67,6 +67,9 @@ public:
 
     [[nodiscard]] const RowsetMetadata& metadata() const { return *_rowset_metadata; }
 
+    // Load the segments of this rowset, the empty segments are included.
+    [[nodiscard]] StatusOr<std::vector<SegmentPtr>> segments(bool fill_cache);
+
 private:
     [[nodiscard]] Status load_segments(std::vector<SegmentPtr>* segments, bool fill_cache);
 
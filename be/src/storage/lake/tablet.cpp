@@ -186,4 +186,28 @@ StatusOr<bool> Tablet::has_delete_predicates(int64_t version) {
     return false;
 }
 
+StatusOr<TabletCacheResidency> Tablet::get_cache_residency(int64_t version) {
+    ASSIGN_OR_RETURN(auto metadata, get_metadata(version));
+    TabletCacheResidency residency;
+    RandomAccessFileOptions opts{.skip_fill_local_cache = true};
+    for (const auto& rowset : metadata->rowsets()) {
+        if (rowset.segments_size() == 0) {
+            continue;
+        }
+        int64_t segment_size = rowset.data_size() / rowset.segments_size();
+        for (const auto& segment : rowset.segments()) {
+            auto location = segment_location(segment);
+            ASSIGN_OR_RETURN(auto fs, FileSystem::CreateSharedFromString(location));
+            ASSIGN_OR_RETURN(auto rfile, fs->new_random_access_file(opts, location));
+            residency.num_segments++;
+            residency.data_size += segment_size;
+            if (rfile->is_cache_hit()) {
+                residency.num_cached_segments++;
+                residency.cached_data_size += segment_size;
+            }
+        }
+    }
+    return residency;
+}
+
 } // namespace starrocks::lake
@@ -45,6 +45,17 @@ class MetadataIterator;
 using TabletMetadataIter = MetadataIterator<TabletMetadataPtr>;
 class UpdateManager;
 
+// The segments of a tablet version in the local cache of the file system.
+struct TabletCacheResidency {
+    int64_t num_segments = 0;
+    int64_t num_cached_segments = 0;
+    // Estimated from the data size of the rowsets, assuming the segments of a rowset are of the same size.
+    int64_t data_size = 0;
+    int64_t cached_data_size = 0;
+
+    double cached_ratio() const { return num_segments == 0 ? 1.0 : double(num_cached_segments) / num_segments; }
+};
+
 class Tablet {
 public:
     explicit Tablet(TabletManager* mgr, int64_t id) : _mgr(mgr), _id(id) {}
@@ -118,6 +129,9 @@ public:
 
     StatusOr<bool> has_delete_predicates(int64_t version);
 
+    // Check which segments of |version| are in the local cache, without filling the cache.
+    StatusOr<TabletCacheResidency> get_cache_residency(int64_t version);
+
     UpdateManager* update_mgr() { return _mgr->update_mgr(); }
 
     TabletManager* tablet_mgr() { return _mgr; }
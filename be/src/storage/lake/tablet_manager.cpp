@@ -32,6 +32,7 @@
 #include "storage/lake/gc.h"
 #include "storage/lake/horizontal_compaction_task.h"
 #include "storage/lake/join_path.h"
+#include "storage/lake/lake_primary_index.h"
 #include "storage/lake/location_provider.h"
 #include "storage/lake/meta_file.h"
 #include "storage/lake/tablet.h"
@@ -278,6 +279,8 @@ Status TabletManager::delete_tablet(int64_t tablet_id) {
     }
     //drop tablet schema from metacache;
     erase_metacache(tablet_schema_cache_key(tablet_id));
+    // It's ok to ignore the error here, the local index is rebuilt if it's stale.
+    (void)LakePrimaryIndex::remove_local_index(tablet_id);
     return Status::OK();
 }
 
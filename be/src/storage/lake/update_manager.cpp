@@ -82,6 +82,7 @@ Status UpdateManager::publish_primary_key_tablet(const TxnLogPB_OpWrite& op_writ
     }
     // release index entry but keep it in cache
     DeferOp release_index_entry([&] { _index_cache.release(index_entry); });
+    RETURN_IF_ERROR(index.prepare_publish(metadata.version()));
     PrimaryIndex::DeletesMap new_deletes;
     for (uint32_t i = 0; i < op_write.rowset().segments_size(); i++) {
         new_deletes[rowset_id + i] = {};
@@ -413,6 +414,7 @@ Status UpdateManager::publish_primary_compaction(const TxnLogPB_OpCompaction& op
     watch.reset();
     // release index entry but keep it in cache
     DeferOp release_index_entry([&] { _index_cache.release(index_entry); });
+    RETURN_IF_ERROR(index.prepare_publish(metadata.version()));
     // 2. iterate output rowset, update primary index and generate delvec
     std::unique_ptr<TabletSchema> tablet_schema = std::make_unique<TabletSchema>(metadata.schema());
     RowsetPtr output_rowset =
@@ -512,6 +514,14 @@ void UpdateManager::update_primary_index_data_version(const Tablet& tablet, int6
     if (index_entry != nullptr) {
         auto& index = index_entry->value();
         index.update_data_version(version);
+        auto st = index.commit_publish(version);
+        if (!st.ok()) {
+            // the local index files are rebuilt when it's loaded next time
+            LOG(WARNING) << "commit local primary index failed, tablet:" << tablet.id() << " version:" << version
+                         << " status:" << st;
+            _index_cache.remove(index_entry);
+            return;
+        }
         _index_cache.release(index_entry);
     }
 }
@@ -18,8 +18,10 @@
 
 #include "column/json_column.h"
 #include "common/logging.h"
+#include "exec/sorting/merge.h"
 #include "exec/sorting/sorting.h"
 #include "gutil/strings/substitute.h"
+#include "io/io_stats.h"
 #include "runtime/current_thread.h"
 #include "runtime/descriptors.h"
 #include "storage/chunk_helper.h"
@@ -119,16 +121,16 @@ size_t MemTable::memory_usage() const {
     }
 
     // _aggregator_memory_usage is 0 if keys type is DUP_KEYS
-    return size + _chunk_memory_usage + _aggregator_memory_usage;
+    return size + _chunk_memory_usage + _aggregator_memory_usage + _sorted_runs_memory_usage;
 }
 
 size_t MemTable::write_buffer_size() const {
-    if (_chunk == nullptr) {
+    if (_chunk == nullptr && _sorted_runs.empty()) {
         return 0;
     }
 
-    // _aggregator_bytes_usage is 0 if keys type is DUP_KEYS
-    return _chunk_bytes_usage + _aggregator_bytes_usage;
+    // _aggregator_bytes_usage is 0 if keys type is DUP_KEYS, _sorted_runs_bytes_usage is 0 otherwise
+    return _chunk_bytes_usage + _aggregator_bytes_usage + _sorted_runs_bytes_usage;
 }
 
 size_t MemTable::write_buffer_rows() const {
@@ -168,6 +170,10 @@ bool MemTable::insert(const Chunk& chunk, const uint32_t* indexes, uint32_t from
         _chunk_bytes_usage += _chunk->bytes_usage(cur_row_count, size);
         _total_rows += chunk.num_rows();
     }
+    if (_keys_type == KeysType::DUP_KEYS && config::memtable_sorted_run_rows > 0 &&
+        _chunk->num_rows() >= config::memtable_sorted_run_rows) {
+        _sort_into_run();
+    }
 
     // if memtable is full, push it to the flush executor,
     // and create a new memtable for incoming data
@@ -192,7 +198,7 @@ bool MemTable::insert(const Chunk& chunk, const uint32_t* indexes, uint32_t from
 }
 
 Status MemTable::finalize() {
-    if (_chunk == nullptr) {
+    if (_chunk == nullptr && _sorted_runs.empty()) {
         return Status::OK();
     }
 
@@ -258,8 +264,11 @@ Status MemTable::finalize() {
             _aggregator.reset();
             _aggregator_memory_usage = 0;
             _aggregator_bytes_usage = 0;
-        } else {
+        } else if (_sorted_runs.empty()) {
             _sort(true);
+        } else {
+            _sort_into_run();
+            RETURN_IF_ERROR(_merge_sorted_runs());
         }
     }
 
@@ -268,6 +277,7 @@ Status MemTable::finalize() {
 }
 
 Status MemTable::flush(SegmentPB* seg_info) {
+    SCOPED_IO_PURPOSE(io::IOPurpose::LOAD);
     if (UNLIKELY(_result_chunk == nullptr)) {
         return Status::OK();
     }
@@ -362,6 +372,61 @@ void MemTable::_append_to_sorted_chunk(Chunk* src, Chunk* dest, bool is_final) {
     }
 }
 
+void MemTable::_sort_into_run() {
+    if (_chunk == nullptr || _chunk->num_rows() == 0) {
+        _chunk.reset();
+        _chunk_memory_usage = 0;
+        _chunk_bytes_usage = 0;
+        return;
+    }
+    _sort(true);
+    _sorted_runs_memory_usage += _result_chunk->memory_usage();
+    _sorted_runs_bytes_usage += _result_chunk->bytes_usage();
+    _sorted_runs.emplace_back(std::move(_result_chunk));
+}
+
+Status MemTable::_merge_sorted_runs() {
+    int64_t t1 = MonotonicMicros();
+    const size_t num_runs = _sorted_runs.size();
+    const size_t num_keys = _vectorized_schema->num_key_fields();
+    const auto sort_descs = SortDescs::asc_null_first(num_keys);
+    auto key_columns = [num_keys](const ChunkPtr& chunk) {
+        Columns columns;
+        for (size_t i = 0; i < num_keys; i++) {
+            columns.push_back(chunk->get_column_by_index(i));
+        }
+        return columns;
+    };
+    // Merge the runs pairwise level by level, so that every row is copied log(k) times for k runs.
+    Permutation perm;
+    while (_sorted_runs.size() > 1) {
+        std::vector<ChunkPtr> merged;
+        merged.reserve((_sorted_runs.size() + 1) / 2);
+        for (size_t i = 0; i + 1 < _sorted_runs.size(); i += 2) {
+            ChunkPtr& left = _sorted_runs[i];
+            ChunkPtr& right = _sorted_runs[i + 1];
+            perm.clear();
+            RETURN_IF_ERROR(merge_sorted_chunks_two_way(sort_descs, SortedRun(left, key_columns(left)),
+                                                        SortedRun(right, key_columns(right)), &perm));
+            ChunkPtr chunk = left->clone_empty_with_schema(perm.size());
+            materialize_by_permutation(chunk.get(), {left, right}, perm);
+            left.reset();
+            right.reset();
+            merged.emplace_back(std::move(chunk));
+        }
+        if (_sorted_runs.size() % 2 == 1) {
+            merged.emplace_back(std::move(_sorted_runs.back()));
+        }
+        _sorted_runs.swap(merged);
+    }
+    _result_chunk = std::move(_sorted_runs[0]);
+    _sorted_runs.clear();
+    _sorted_runs_memory_usage = 0;
+    _sorted_runs_bytes_usage = 0;
+    VLOG(1) << strings::Substitute("memtable merge $0 sorted runs:$1", num_runs, MonotonicMicros() - t1);
+    return Status::OK();
+}
+
 Status MemTable::_split_upserts_deletes(ChunkPtr& src, ChunkPtr* upserts, std::unique_ptr<Column>* deletes) {
     size_t op_column_id = src->num_columns() - 1;
     auto op_column = src->get_column_by_index(op_column_id);
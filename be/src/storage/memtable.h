@@ -76,6 +76,10 @@ private:
     void _sort(bool is_final, bool by_sort_key = false);
     void _sort_column_inc(bool by_sort_key = false);
     void _append_to_sorted_chunk(Chunk* src, Chunk* dest, bool is_final);
+    // Sort the pending rows of a duplicate key table into a sorted run.
+    void _sort_into_run();
+    // Merge the sorted runs into _result_chunk.
+    Status _merge_sorted_runs();
 
     void _init_aggregator_if_needed();
     void _aggregate(bool is_final);
@@ -89,6 +93,11 @@ private:
     SmallPermutation _permutations;
     std::vector<uint32_t> _selective_values;
 
+    // The sorted runs of a duplicate key table, each of them is sorted by the keys.
+    std::vector<ChunkPtr> _sorted_runs;
+    size_t _sorted_runs_memory_usage = 0;
+    size_t _sorted_runs_bytes_usage = 0;
+
     int64_t _tablet_id;
 
     const Schema* _vectorized_schema;
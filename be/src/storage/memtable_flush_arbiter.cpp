@@ -0,0 +1,71 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "storage/memtable_flush_arbiter.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "storage/delta_writer.h"
+
+namespace starrocks {
+
+MemTableFlushArbiter* MemTableFlushArbiter::instance() {
+    static MemTableFlushArbiter arbiter;
+    return &arbiter;
+}
+
+void MemTableFlushArbiter::add(DeltaWriter* writer) {
+    std::lock_guard<std::mutex> l(_lock);
+    _writers.insert(writer);
+}
+
+void MemTableFlushArbiter::remove(DeltaWriter* writer) {
+    std::lock_guard<std::mutex> l(_lock);
+    _writers.erase(writer);
+}
+
+bool MemTableFlushArbiter::flush_largest(DeltaWriter* current, int64_t bytes) {
+    std::lock_guard<std::mutex> l(_lock);
+    std::vector<std::pair<int64_t, DeltaWriter*>> candidates;
+    candidates.reserve(_writers.size());
+    for (DeltaWriter* writer : _writers) {
+        // The writers requested before are not counted, they may be idle and not flush soon.
+        if (writer == current || !writer->flush_requested()) {
+            int64_t usage = writer->memtable_memory_usage();
+            if (usage > 0) {
+                candidates.emplace_back(usage, writer);
+            }
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    bool flush_current = false;
+    int64_t selected = 0;
+    for (const auto& [usage, writer] : candidates) {
+        if (selected >= bytes) {
+            break;
+        }
+        selected += usage;
+        if (writer == current) {
+            flush_current = true;
+        } else {
+            writer->request_flush();
+        }
+    }
+    return flush_current;
+}
+
+} // namespace starrocks
@@ -0,0 +1,46 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_set>
+
+namespace starrocks {
+
+class DeltaWriter;
+
+// MemTableFlushArbiter tracks the memtables of all the delta writers. When the load memory exceeds the limit,
+// the largest memtables are flushed first, rather than the memtable of the writer which happens to write, so
+// the hot tablets are not flushed too late while the other tablets produce tiny segments.
+class MemTableFlushArbiter {
+public:
+    static MemTableFlushArbiter* instance();
+
+    void add(DeltaWriter* writer);
+    void remove(DeltaWriter* writer);
+
+    // Select the largest memtables until their total memory usage reaches |bytes|, the selected writers other
+    // than |current| are requested to flush on their next write.
+    // Returns true if the memtable of |current| is selected, then it should be flushed by the caller.
+    bool flush_largest(DeltaWriter* current, int64_t bytes);
+
+private:
+    std::mutex _lock;
+    std::unordered_set<DeltaWriter*> _writers;
+};
+
+} // namespace starrocks
@@ -231,6 +231,8 @@ struct OlapReaderStatistics {
     int64_t raw_rows_read = 0;
 
     int64_t rows_vec_cond_filtered = 0;
+    // The rows skipping predicate evaluation, because the zone maps show that all of them satisfy the predicates.
+    int64_t rows_zone_map_all_matched = 0;
     int64_t vec_cond_ns = 0;
     int64_t vec_cond_evaluate_ns = 0;
     int64_t vec_cond_chunk_copy_ns = 0;
@@ -250,6 +252,8 @@ struct OlapReaderStatistics {
 
     int64_t total_pages_num = 0;
     int64_t cached_pages_num = 0;
+    // The pages read into the page cache by a concurrent reader, which is waited by this reader.
+    int64_t shared_read_pages_num = 0;
 
     int64_t rows_bitmap_index_filtered = 0;
     int64_t bitmap_index_filter_timer = 0;
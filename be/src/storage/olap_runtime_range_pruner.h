@@ -20,10 +20,12 @@
 
 #include "common/status.h"
 #include "runtime/global_dict/types_fwd_decl.h"
+#include "types/logical_type.h"
 
 namespace starrocks {
 class SlotDescriptor;
 
+class JoinRuntimeFilter;
 class RuntimeFilterProbeDescriptor;
 class PredicateParser;
 class ColumnPredicate;
@@ -42,7 +44,10 @@ class OlapRuntimeScanRangePruner {
 public:
     using PredicatesPtrs = std::vector<std::unique_ptr<ColumnPredicate>>;
     using PredicatesRawPtrs = std::vector<const ColumnPredicate*>;
-    using RuntimeFilterArrivedCallBack = std::function<Status(int, const PredicatesRawPtrs&)>;
+    // The arrived runtime filter and its logical type are also passed, so that the callback could evaluate
+    // the runtime filter on the index of the column directly.
+    using RuntimeFilterArrivedCallBack =
+            std::function<Status(int, const PredicatesRawPtrs&, const JoinRuntimeFilter*, LogicalType)>;
     static constexpr auto rf_update_threhold = 4096 * 10;
 
     OlapRuntimeScanRangePruner() = default;
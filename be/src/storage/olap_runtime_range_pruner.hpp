@@ -183,7 +183,8 @@ inline Status OlapRuntimeScanRangePruner::_update(const ColumnIdToGlobalDictMap*
                 ASSIGN_OR_RETURN(auto predicates, _get_predicates(global_dictmaps, i));
                 auto raw_predicates = _as_raw_predicates(predicates);
                 if (!raw_predicates.empty()) {
-                    RETURN_IF_ERROR(updater(raw_predicates.front()->column_id(), raw_predicates));
+                    RETURN_IF_ERROR(updater(raw_predicates.front()->column_id(), raw_predicates, rf,
+                                            _slot_descs[i]->type().type));
                 }
                 _arrived_runtime_filters_masks[i] = true;
                 _rf_versions[i] = rf_version;
@@ -52,7 +52,10 @@
 #include "storage/tablet_manager.h"
 #include "storage/update_manager.h"
 #include "util/gc_helper.h"
+#include "util/starrocks_metrics.h"
+#include "util/stopwatch.hpp"
 #include "util/thread.h"
+#include "util/threadpool.h"
 #include "util/time.h"
 
 using std::string;
@@ -219,6 +222,11 @@ Status StorageEngine::start_bg_threads() {
         Thread::set_thread_name(_adjust_cache_thread, "adjust_cache");
     }
 
+    if (config::primary_index_preload_tablet_num > 0) {
+        _primary_index_preload_thread = std::thread([this] { _primary_index_preload_callback(nullptr); });
+        Thread::set_thread_name(_primary_index_preload_thread, "pk_index_preload");
+    }
+
     LOG(INFO) << "All backgroud threads of storage engine have started.";
     return Status::OK();
 }
@@ -330,6 +338,51 @@ void* StorageEngine::_fd_cache_clean_callback(void* arg) {
     return nullptr;
 }
 
+void* StorageEngine::_primary_index_preload_callback(void* arg) {
+#ifdef GOOGLE_PROFILER
+    ProfilerRegisterThread();
+#endif
+    MonotonicStopWatch watch;
+    watch.start();
+    auto tablets = _tablet_manager->pick_tablets_to_preload_primary_index(
+            config::primary_index_preload_tablet_num, UnixSeconds() - config::primary_index_preload_recent_write_sec);
+    if (tablets.empty()) {
+        return nullptr;
+    }
+    std::unique_ptr<ThreadPool> pool;
+    auto st = ThreadPoolBuilder("pk_index_preload")
+                      .set_min_threads(0)
+                      .set_max_threads(std::max(1, config::primary_index_preload_threads))
+                      .set_idle_timeout(MonoDelta::FromMilliseconds(2000))
+                      .build(&pool);
+    if (!st.ok()) {
+        LOG(WARNING) << "init primary index preload thread pool failed: " << st;
+        return nullptr;
+    }
+    auto metrics = StarRocksMetrics::instance();
+    metrics->update_primary_index_preload_total.increment(tablets.size());
+    for (auto& tablet : tablets) {
+        auto task = [this, tablet, metrics]() {
+            if (_bg_worker_stopped.load(std::memory_order_consume)) {
+                return;
+            }
+            auto st = _update_manager->preload_primary_index(tablet.get());
+            if (!st.ok()) {
+                LOG(WARNING) << "preload primary index failed, tablet:" << tablet->tablet_id() << " " << st;
+                metrics->update_primary_index_preload_failed.increment(1);
+            }
+            metrics->update_primary_index_preload_finished.increment(1);
+        };
+        if (!pool->submit_func(task).ok()) {
+            task();
+        }
+    }
+    pool->wait();
+    LOG(INFO) << "preload primary index of " << tablets.size() << " tablets, failed "
+              << metrics->update_primary_index_preload_failed.value() << ", cost(ms): " << watch.elapsed_time() / 1000000;
+    return nullptr;
+}
+
 void* StorageEngine::_base_compaction_thread_callback(void* arg, DataDir* data_dir,
                                                       std::pair<int32_t, int32_t> tablet_shards) {
 #ifdef GOOGLE_PROFILER
@@ -718,6 +771,7 @@ void* StorageEngine::_tablet_checkpoint_callback(void* arg) {
         LOG(INFO) << "begin to do tablet meta checkpoint:" << ((DataDir*)arg)->path();
         int64_t start_time = UnixMillis();
         _tablet_manager->do_tablet_meta_checkpoint((DataDir*)arg);
+        ((DataDir*)arg)->flush_segment_meta_cache();
         int64_t used_time = (UnixMillis() - start_time) / 1000;
         if (used_time < config::tablet_meta_checkpoint_min_interval_secs) {
             int64_t interval = config::tablet_meta_checkpoint_min_interval_secs - used_time;
@@ -36,6 +36,7 @@
 
 #include <malloc.h>
 
+#include "common/config.h"
 #include "runtime/current_thread.h"
 #include "runtime/mem_tracker.h"
 #include "util/defer_op.h"
@@ -81,7 +82,7 @@ static void init_metrics() {
 }
 
 StoragePageCache::StoragePageCache(MemTracker* mem_tracker, size_t capacity)
-        : _mem_tracker(mem_tracker), _cache(new_lru_cache(capacity)) {
+        : _mem_tracker(mem_tracker), _cache(new_lru_cache(capacity, config::storage_page_cache_protected_ratio)) {
     init_metrics();
 }
 
@@ -113,8 +114,16 @@ bool StoragePageCache::adjust_capacity(int64_t delta, size_t min_capacity) {
     return _cache->adjust_capacity(delta, min_capacity);
 }
 
+void StoragePageCache::set_workgroup_quota(int64_t workgroup_id, double reserved_ratio, double limit_ratio) {
+    _cache->set_owner_quota(workgroup_id, reserved_ratio, limit_ratio);
+}
+
+CacheOwnerStats StoragePageCache::get_workgroup_stats(int64_t workgroup_id) {
+    return _cache->get_owner_stats(workgroup_id);
+}
+
 bool StoragePageCache::lookup(const CacheKey& key, PageCacheHandle* handle) {
-    auto* lru_handle = _cache->lookup(key.encode());
+    auto* lru_handle = _cache->lookup(key.encode(), tls_thread_status.workgroup_id());
     if (lru_handle == nullptr) {
         return false;
     }
@@ -137,7 +146,8 @@ void StoragePageCache::insert(const CacheKey& key, const Slice& data, PageCacheH
         priority = CachePriority::DURABLE;
     }
 
-    auto* lru_handle = _cache->insert(key.encode(), data.data, data.size, deleter, priority);
+    auto* lru_handle =
+            _cache->insert(key.encode(), data.data, data.size, deleter, priority, tls_thread_status.workgroup_id());
     *handle = PageCacheHandle(_cache.get(), lru_handle);
 }
 
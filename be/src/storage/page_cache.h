@@ -116,6 +116,12 @@ public:
 
     bool adjust_capacity(int64_t delta, size_t min_capacity = 0);
 
+    // The pages are owned by the workgroup of the scan task reading them, see `Cache::set_owner_quota`
+    // for the meaning of the ratios.
+    void set_workgroup_quota(int64_t workgroup_id, double reserved_ratio, double limit_ratio);
+
+    CacheOwnerStats get_workgroup_stats(int64_t workgroup_id);
+
 private:
     static StoragePageCache* _s_instance;
 
@@ -15,6 +15,7 @@
 #include "storage/persistent_index.h"
 
 #include <cstring>
+#include <functional>
 #include <numeric>
 #include <utility>
 
@@ -23,18 +24,21 @@
 #include "storage/chunk_helper.h"
 #include "storage/chunk_iterator.h"
 #include "storage/primary_key_encoder.h"
+#include "storage/rowset/bloom_filter.h"
 #include "storage/rowset/rowset.h"
 #include "storage/tablet.h"
 #include "storage/tablet_meta_manager.h"
 #include "storage/tablet_updates.h"
 #include "util/bit_util.h"
 #include "util/coding.h"
+#include "util/countdown_latch.h"
 #include "util/crc32c.h"
 #include "util/debug_util.h"
 #include "util/defer_op.h"
 #include "util/faststring.h"
 #include "util/filesystem_util.h"
 #include "util/raw_container.h"
+#include "util/threadpool.h"
 #include "util/xxh3.h"
 
 namespace starrocks {
@@ -512,6 +516,15 @@ Status ImmutableIndexWriter::write_shard(size_t key_size, size_t npage_hint, siz
         _total_kv_size += shard_kv_size;
     }
     shard_meta->set_data_size(shard_kv_size);
+    if (config::enable_pindex_bloom_filter && !kvs.empty()) {
+        std::unique_ptr<BloomFilter> bf;
+        RETURN_IF_ERROR(BloomFilter::create(BLOCK_BLOOM_FILTER, &bf));
+        RETURN_IF_ERROR(bf->init(kvs.size(), config::pindex_bloom_filter_fpp, HASH_MURMUR3_X64_64));
+        for (const auto& kv : kvs) {
+            bf->add_hash(kv.hash);
+        }
+        shard_meta->set_bloom_filter(bf->data(), bf->size());
+    }
     _total_bytes += pos_after - pos_before;
     auto iter = _shard_info_by_length.find(_cur_key_size);
     if (iter == _shard_info_by_length.end()) {
@@ -552,6 +565,9 @@ Status ImmutableIndexWriter::write_shard_as_rawbuff(const ImmutableIndex::ShardI
     shard_info->set_value_size(old_shard_info.value_size);
     shard_info->set_nbucket(old_shard_info.nbucket);
     shard_info->set_data_size(old_shard_info.data_size);
+    if (old_shard_info.bloom_filter != nullptr) {
+        shard_info->set_bloom_filter(old_shard_info.bloom_filter->data(), old_shard_info.bloom_filter->size());
+    }
     auto page_pointer = shard_info->mutable_data();
     page_pointer->set_offset(pos_before);
     page_pointer->set_size(pos_after - pos_before);
@@ -1929,6 +1945,29 @@ size_t get_matched_tag_idxes(const uint8_t* tags, size_t ntag, uint8_t tag, uint
     return nmatched;
 }
 
+#elif defined(__ARM_NEON__) || defined(__aarch64__)
+
+#include <arm_neon.h>
+
+size_t get_matched_tag_idxes(const uint8_t* tags, size_t ntag, uint8_t tag, uint8_t* matched_idxes) {
+    size_t nmatched = 0;
+    auto tests = vdupq_n_u8(tag);
+    for (size_t i = 0; i < ntag; i += 16) {
+        auto eqs = vceqq_u8(vld1q_u8(tags + i), tests);
+        // Narrow the 16 byte masks to 4 bits each, as there is no movemask in NEON.
+        uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eqs), 4)), 0);
+        mask &= 0x8888888888888888ULL;
+        while (mask != 0) {
+            uint32_t match_pos = __builtin_ctzll(mask) >> 2;
+            if (i + match_pos < ntag) {
+                matched_idxes[nmatched++] = i + match_pos;
+            }
+            mask &= (mask - 1);
+        }
+    }
+    return nmatched;
+}
+
 #else
 
 size_t get_matched_tag_idxes(const uint8_t* tags, size_t ntag, uint8_t tag, uint8_t* matched_idxes) {
@@ -1943,6 +1982,25 @@ size_t get_matched_tag_idxes(const uint8_t* tags, size_t ntag, uint8_t tag, uint
 
 #endif
 
+// The batched probing of a shard looks ahead this number of keys. The bucket info in the page
+// header of a key is prefetched kProbePrefetchDistance keys ahead, and the tags and keys of its
+// bucket are prefetched at half of the distance, by which time the bucket info is in the cache.
+static constexpr size_t kProbePrefetchDistance = 16;
+
+static inline void prefetch_probe_buckets(ImmutableIndexShard* shard, uint32_t npage, uint32_t nbucket,
+                                          const KeysInfo& keys_info, size_t i) {
+    if (i + kProbePrefetchDistance < keys_info.size()) {
+        IndexHash h(keys_info.key_infos[i + kProbePrefetchDistance].second);
+        __builtin_prefetch(&shard->bucket(h.page() % npage, h.bucket() % nbucket));
+    }
+    if (i + kProbePrefetchDistance / 2 < keys_info.size()) {
+        IndexHash h(keys_info.key_infos[i + kProbePrefetchDistance / 2].second);
+        const uint8_t* bucket_pos = shard->pack(h.page() % npage, h.bucket() % nbucket);
+        __builtin_prefetch(bucket_pos);
+        __builtin_prefetch(bucket_pos + CACHELINE_SIZE);
+    }
+}
+
 Status ImmutableIndex::_get_fixlen_kvs_for_shard(std::vector<std::vector<KVRef>>& kvs_by_shard, size_t shard_idx,
                                                  uint32_t shard_bits,
                                                  std::unique_ptr<ImmutableIndexShard>* shard) const {
@@ -2010,6 +2068,7 @@ Status ImmutableIndex::_get_in_fixlen_shard(size_t shard_idx, size_t n, const Sl
     uint8_t candidate_idxes[kBucketSizeMax];
     for (size_t i = 0; i < keys_info.size(); i++) {
         IndexHash h(keys_info.key_infos[i].second);
+        prefetch_probe_buckets(shard->get(), shard_info.npage, shard_info.nbucket, keys_info, i);
         auto pageid = h.page() % shard_info.npage;
         auto bucketid = h.bucket() % shard_info.nbucket;
         auto& bucket_info = (*shard)->bucket(pageid, bucketid);
@@ -2040,6 +2099,7 @@ Status ImmutableIndex::_get_in_varlen_shard(size_t shard_idx, size_t n, const Sl
     uint8_t candidate_idxes[kBucketSizeMax];
     for (size_t i = 0; i < keys_info.size(); i++) {
         IndexHash h(keys_info.key_infos[i].second);
+        prefetch_probe_buckets(shard->get(), shard_info.npage, shard_info.nbucket, keys_info, i);
         auto pageid = h.page() % shard_info.npage;
         auto bucketid = h.bucket() % shard_info.nbucket;
         auto& bucket_info = (*shard)->bucket(pageid, bucketid);
@@ -2066,12 +2126,37 @@ Status ImmutableIndex::_get_in_varlen_shard(size_t shard_idx, size_t n, const Sl
     return Status::OK();
 }
 
-Status ImmutableIndex::_get_in_shard(size_t shard_idx, size_t n, const Slice* keys, const KeysInfo& keys_info,
+const KeysInfo& ImmutableIndex::_filter_by_bloom_filter(size_t shard_idx, const KeysInfo& keys_info,
+                                                        KeysInfo* filtered) const {
+    const auto& bf = _shards[shard_idx].bloom_filter;
+    if (bf == nullptr) {
+        return keys_info;
+    }
+    for (const auto& key_info : keys_info.key_infos) {
+        if (bf->test_hash(key_info.second)) {
+            filtered->key_infos.emplace_back(key_info);
+        }
+    }
+    return *filtered;
+}
+
+Status ImmutableIndex::_get_in_shard(size_t shard_idx, size_t n, const Slice* keys, const KeysInfo& all_keys_info,
                                      IndexValue* values, KeysInfo* found_keys_info) const {
     const auto& shard_info = _shards[shard_idx];
-    if (shard_info.size == 0 || shard_info.npage == 0 || keys_info.size() == 0) {
+    if (shard_info.size == 0 || shard_info.npage == 0 || all_keys_info.size() == 0) {
         return Status::OK();
     }
+    KeysInfo filtered;
+    const auto& keys_info = _filter_by_bloom_filter(shard_idx, all_keys_info, &filtered);
+    if (keys_info.size() < all_keys_info.size()) {
+        // The keys skipped by the bloom filter are not in this shard.
+        for (const auto& key_info : all_keys_info.key_infos) {
+            values[key_info.first] = NullIndexValue;
+        }
+        if (keys_info.size() == 0) {
+            return Status::OK();
+        }
+    }
     std::unique_ptr<ImmutableIndexShard> shard = std::make_unique<ImmutableIndexShard>(shard_info.npage);
     CHECK(shard->pages.size() * kPageSize == shard_info.bytes) << "illegal shard size";
     RETURN_IF_ERROR(_file->read_at_fully(shard_info.offset, shard->pages.data(), shard_info.bytes));
@@ -2089,6 +2174,7 @@ Status ImmutableIndex::_check_not_exist_in_fixlen_shard(size_t shard_idx, size_t
     uint8_t candidate_idxes[kBucketSizeMax];
     for (size_t i = 0; i < keys_info.size(); i++) {
         IndexHash h(keys_info.key_infos[i].second);
+        prefetch_probe_buckets(shard->get(), shard_info.npage, shard_info.nbucket, keys_info, i);
         auto pageid = h.page() % shard_info.npage;
         auto bucketid = h.bucket() % shard_info.nbucket;
         auto& bucket_info = (*shard)->bucket(pageid, bucketid);
@@ -2117,6 +2203,7 @@ Status ImmutableIndex::_check_not_exist_in_varlen_shard(size_t shard_idx, size_t
     uint8_t candidate_idxes[kBucketSizeMax];
     for (size_t i = 0; i < keys_info.size(); i++) {
         IndexHash h(keys_info.key_infos[i].second);
+        prefetch_probe_buckets(shard->get(), shard_info.npage, shard_info.nbucket, keys_info, i);
         auto pageid = h.page() % shard_info.npage;
         auto bucketid = h.bucket() % shard_info.nbucket;
         auto& bucket_info = (*shard)->bucket(pageid, bucketid);
@@ -2141,9 +2228,14 @@ Status ImmutableIndex::_check_not_exist_in_varlen_shard(size_t shard_idx, size_t
 }
 
 Status ImmutableIndex::_check_not_exist_in_shard(size_t shard_idx, size_t n, const Slice* keys,
-                                                 const KeysInfo& keys_info) const {
+                                                 const KeysInfo& all_keys_info) const {
     const auto& shard_info = _shards[shard_idx];
-    if (shard_info.size == 0 || keys_info.size() == 0) {
+    if (shard_info.size == 0 || all_keys_info.size() == 0) {
+        return Status::OK();
+    }
+    KeysInfo filtered;
+    const auto& keys_info = _filter_by_bloom_filter(shard_idx, all_keys_info, &filtered);
+    if (keys_info.size() == 0) {
         return Status::OK();
     }
     std::unique_ptr<ImmutableIndexShard> shard = std::make_unique<ImmutableIndexShard>(shard_info.npage);
@@ -2166,6 +2258,51 @@ static void split_keys_info_by_shard(const KeysInfo& keys_info, std::vector<Keys
     }
 }
 
+// The pool probing the shards of the large batches concurrently, nullptr if it can not be created.
+static ThreadPool* parallel_probe_pool() {
+    static std::unique_ptr<ThreadPool> pool = [] {
+        std::unique_ptr<ThreadPool> p;
+        auto st = ThreadPoolBuilder("pindex_probe")
+                          .set_min_threads(0)
+                          .set_max_threads(std::max(1, config::pindex_parallel_probe_threads))
+                          .set_idle_timeout(MonoDelta::FromMilliseconds(2000))
+                          .build(&p);
+        LOG_IF(WARNING, !st.ok()) << "Fail to create the persistent index probe pool, probe the shards serially: "
+                                  << st;
+        return p;
+    }();
+    return pool.get();
+}
+
+// Return the pool to probe the shards of a batch of |nkeys| keys, or nullptr to probe them serially.
+static ThreadPool* probe_pool_for(size_t nshard, size_t nkeys) {
+    if (nshard <= 1 || config::pindex_parallel_probe_threads <= 0 ||
+        nkeys < config::pindex_parallel_probe_min_keys) {
+        return nullptr;
+    }
+    return parallel_probe_pool();
+}
+
+// Call |probe| for each of the |nshard| shards on |pool| and wait for all of them, return the first error.
+static Status probe_shards_in_parallel(ThreadPool* pool, size_t nshard, const std::function<Status(size_t)>& probe) {
+    std::vector<Status> results(nshard);
+    CountDownLatch latch(nshard);
+    for (size_t i = 0; i < nshard; i++) {
+        auto task = [&, i]() {
+            results[i] = probe(i);
+            latch.count_down();
+        };
+        if (!pool->submit_func(task).ok()) {
+            task();
+        }
+    }
+    latch.wait();
+    for (const auto& st : results) {
+        RETURN_IF_ERROR(st);
+    }
+    return Status::OK();
+}
+
 Status ImmutableIndex::get(size_t n, const Slice* keys, const KeysInfo& keys_info, IndexValue* values,
                            KeysInfo* found_keys_info, size_t key_size) const {
     auto iter = _shard_info_by_length.find(key_size);
@@ -2176,6 +2313,19 @@ Status ImmutableIndex::get(size_t n, const Slice* keys, const KeysInfo& keys_inf
     if (nshard > 1) {
         std::vector<KeysInfo> keys_info_by_shard(nshard);
         split_keys_info_by_shard(keys_info, keys_info_by_shard);
+        if (ThreadPool* pool = probe_pool_for(nshard, keys_info.size()); pool != nullptr) {
+            // The shards write the values of different keys, only the found keys need to be merged.
+            std::vector<KeysInfo> found_keys_info_by_shard(nshard);
+            RETURN_IF_ERROR(probe_shards_in_parallel(pool, nshard, [&](size_t i) {
+                return _get_in_shard(shard_off + i, n, keys, keys_info_by_shard[i], values,
+                                     &found_keys_info_by_shard[i]);
+            }));
+            for (const auto& found : found_keys_info_by_shard) {
+                found_keys_info->key_infos.insert(found_keys_info->key_infos.end(), found.key_infos.begin(),
+                                                  found.key_infos.end());
+            }
+            return Status::OK();
+        }
         for (size_t i = 0; i < nshard; i++) {
             RETURN_IF_ERROR(_get_in_shard(shard_off + i, n, keys, keys_info_by_shard[i], values, found_keys_info));
         }
@@ -2198,12 +2348,27 @@ Status ImmutableIndex::check_not_exist(size_t n, const Slice* keys, size_t key_s
         auto shard = h.shard(shard_bits);
         keys_info_by_shard[shard].key_infos.emplace_back(i, h.hash);
     }
+    if (ThreadPool* pool = probe_pool_for(nshard, n); pool != nullptr) {
+        return probe_shards_in_parallel(pool, nshard, [&](size_t i) {
+            return _check_not_exist_in_shard(shard_off + i, n, keys, keys_info_by_shard[i]);
+        });
+    }
     for (size_t i = 0; i < nshard; i++) {
         RETURN_IF_ERROR(_check_not_exist_in_shard(shard_off + i, n, keys, keys_info_by_shard[i]));
     }
     return Status::OK();
 }
 
+size_t ImmutableIndex::memory_usage() const {
+    size_t usage = 0;
+    for (const auto& shard : _shards) {
+        if (shard.bloom_filter != nullptr) {
+            usage += shard.bloom_filter->size();
+        }
+    }
+    return usage;
+}
+
 StatusOr<std::unique_ptr<ImmutableIndex>> ImmutableIndex::load(std::unique_ptr<RandomAccessFile>&& file) {
     ASSIGN_OR_RETURN(auto file_size, file->get_size());
     if (file_size < 12) {
@@ -2265,6 +2430,12 @@ StatusOr<std::unique_ptr<ImmutableIndex>> ImmutableIndex::load(std::unique_ptr<R
         } else {
             dest.data_size = src.data_size();
         }
+        if (!src.bloom_filter().empty()) {
+            std::unique_ptr<BloomFilter> bf;
+            RETURN_IF_ERROR(BloomFilter::create(BLOCK_BLOOM_FILTER, &bf));
+            RETURN_IF_ERROR(bf->init(src.bloom_filter().data(), src.bloom_filter().size(), HASH_MURMUR3_X64_64));
+            dest.bloom_filter = std::move(bf);
+        }
     }
     size_t nlength = meta.shard_info_size();
     for (size_t i = 0; i < nlength; i++) {
@@ -2482,6 +2653,40 @@ Status PersistentIndex::_insert_rowsets(Tablet* tablet, std::vector<RowsetShared
     return Status::OK();
 }
 
+Status PersistentIndex::reset(size_t key_size, const EditVersion& version, PersistentIndexMetaPB* index_meta) {
+    _key_size = key_size;
+    _size = 0;
+    _usage = 0;
+    _version = version;
+    _l1_vec.clear();
+    _l1_merged_num.clear();
+    _has_l1 = false;
+    ASSIGN_OR_RETURN(_l0, ShardByLengthMutableIndex::create(_key_size, _path));
+    ASSIGN_OR_RETURN(_fs, FileSystem::CreateSharedFromString(_path));
+    // set _dump_snapshot to true
+    // In this case, only do flush or dump snapshot, set _dump_snapshot to avoid append wal
+    _dump_snapshot = true;
+
+    // Init PersistentIndexMetaPB
+    //   1. reset |version| |key_size|
+    //   2. delete WALs because maybe PersistentIndexMetaPB has expired wals
+    //   3. reset SnapshotMeta
+    //   4. write all data into new tmp _l0 index file (tmp file will be delete in _build_commit())
+    index_meta->clear_l0_meta();
+    index_meta->clear_l1_version();
+    index_meta->set_key_size(_key_size);
+    index_meta->set_format_version(PERSISTENT_INDEX_VERSION_2);
+    version.to_pb(index_meta->mutable_version());
+    MutableIndexMetaPB* l0_meta = index_meta->mutable_l0_meta();
+    l0_meta->clear_wals();
+    IndexSnapshotMetaPB* snapshot = l0_meta->mutable_snapshot();
+    version.to_pb(snapshot->mutable_version());
+    PagePointerPB* data = snapshot->mutable_data();
+    data->set_offset(0);
+    data->set_size(0);
+    return Status::OK();
+}
+
 Status PersistentIndex::load_from_tablet(Tablet* tablet) {
     MonotonicStopWatch timer;
     timer.start();
@@ -2560,38 +2765,12 @@ Status PersistentIndex::load_from_tablet(Tablet* tablet) {
     auto pkey_schema = ChunkHelper::convert_schema(tablet_schema, pk_columns);
     size_t fix_size = PrimaryKeyEncoder::get_encoded_fixed_size(pkey_schema);
 
-    // Init PersistentIndex
-    _key_size = fix_size;
-    _size = 0;
-    _version = lastest_applied_version;
-    auto st = ShardByLengthMutableIndex::create(_key_size, _path);
+    // Init PersistentIndex and PersistentIndexMetaPB
+    auto st = reset(fix_size, lastest_applied_version, &index_meta);
     if (!st.ok()) {
-        LOG(WARNING) << "Build persistent index failed because initialization failed: " << st.status().to_string();
-        return st.status();
+        LOG(WARNING) << "Build persistent index failed because initialization failed: " << st.to_string();
+        return st;
     }
-    _l0 = std::move(st).value();
-    ASSIGN_OR_RETURN(_fs, FileSystem::CreateSharedFromString(_path));
-    // set _dump_snapshot to true
-    // In this case, only do flush or dump snapshot, set _dump_snapshot to avoid append wal
-    _dump_snapshot = true;
-
-    // Init PersistentIndexMetaPB
-    //   1. reset |version| |key_size|
-    //   2. delete WALs because maybe PersistentIndexMetaPB has expired wals
-    //   3. reset SnapshotMeta
-    //   4. write all data into new tmp _l0 index file (tmp file will be delete in _build_commit())
-    index_meta.clear_l0_meta();
-    index_meta.clear_l1_version();
-    index_meta.set_key_size(_key_size);
-    index_meta.set_format_version(PERSISTENT_INDEX_VERSION_2);
-    lastest_applied_version.to_pb(index_meta.mutable_version());
-    MutableIndexMetaPB* l0_meta = index_meta.mutable_l0_meta();
-    l0_meta->clear_wals();
-    IndexSnapshotMetaPB* snapshot = l0_meta->mutable_snapshot();
-    lastest_applied_version.to_pb(snapshot->mutable_version());
-    PagePointerPB* data = snapshot->mutable_data();
-    data->set_offset(0);
-    data->set_size(0);
 
     int64_t apply_version = 0;
     std::vector<RowsetSharedPtr> rowsets;
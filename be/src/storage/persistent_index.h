@@ -30,6 +30,7 @@ namespace starrocks {
 class Tablet;
 class Schema;
 class Column;
+class BloomFilter;
 
 // Add version for persistent index file to support future upgrade compatibility
 // There is only one version for now
@@ -377,6 +378,9 @@ public:
         return size;
     }
 
+    // the memory used by the bloom filters of the shards
+    size_t memory_usage() const;
+
     static StatusOr<std::unique_ptr<ImmutableIndex>> load(std::unique_ptr<RandomAccessFile>&& rb);
 
 private:
@@ -414,6 +418,10 @@ private:
 
     Status _check_not_exist_in_shard(size_t shard_idx, size_t n, const Slice* keys, const KeysInfo& keys_info) const;
 
+    // Return the keys of |keys_info| which may be in the shard by its bloom filter, |filtered| is used as the
+    // storage, or |keys_info| itself if the shard has no bloom filter.
+    const KeysInfo& _filter_by_bloom_filter(size_t shard_idx, const KeysInfo& keys_info, KeysInfo* filtered) const;
+
     std::unique_ptr<RandomAccessFile> _file;
     EditVersion _version;
     size_t _size = 0;
@@ -427,6 +435,8 @@ private:
         uint32_t value_size;
         uint32_t nbucket;
         uint64_t data_size;
+        // null if the shard is written without a bloom filter
+        std::shared_ptr<BloomFilter> bloom_filter;
     };
 
     std::vector<ShardInfo> _shards;
@@ -492,7 +502,13 @@ public:
 
     size_t size() const { return _size; }
     size_t capacity() const { return _l0 ? _l0->capacity() : 0; }
-    size_t memory_usage() const { return _l0 ? _l0->memory_usage() : 0; }
+    size_t memory_usage() const {
+        size_t usage = _l0 ? _l0->memory_usage() : 0;
+        for (const auto& l1 : _l1_vec) {
+            usage += l1->memory_usage();
+        }
+        return usage;
+    }
 
     EditVersion version() const { return _version; }
 
@@ -505,6 +521,10 @@ public:
     // build PersistentIndex from pre-existing tablet data
     Status load_from_tablet(Tablet* tablet);
 
+    // reset to an empty index of |key_size| at |version| and init |index_meta| for it, the keys inserted
+    // afterwards are written as a snapshot by the next commit, used to build the index from existing data
+    Status reset(size_t key_size, const EditVersion& version, PersistentIndexMetaPB* index_meta);
+
     // start modification with intended version
     Status prepare(const EditVersion& version);
 
@@ -92,6 +92,13 @@ StatusOr<ColumnPredicate*> PredicateParser::parse_expr_ctx(const SlotDescriptor&
     auto precision = col.precision();
     auto scale = col.scale();
     auto type = col.type();
+    if (type == TYPE_STRUCT) {
+        ASSIGN_OR_RETURN(auto* expr_pred, ColumnExprPredicate::make_column_expr_predicate(
+                                                  get_type_info(col), column_id, state, expr_ctx, &slot_desc));
+        std::unique_ptr<ColumnExprPredicate> pred(expr_pred);
+        RETURN_IF_ERROR(pred->try_to_rewrite_for_subfield(col));
+        return pred.release();
+    }
     auto&& type_info = get_type_info(type, precision, scale);
     return ColumnExprPredicate::make_column_expr_predicate(type_info, column_id, state, expr_ctx, &slot_desc);
 }
@@ -17,6 +17,7 @@
 #include <memory>
 #include <mutex>
 
+#include "common/config.h"
 #include "common/tracer.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/large_int_value.h"
@@ -27,6 +28,7 @@
 #include "storage/tablet.h"
 #include "storage/tablet_reader.h"
 #include "storage/tablet_updates.h"
+#include "util/coding.h"
 #include "util/stack_util.h"
 #include "util/starrocks_metrics.h"
 
@@ -669,6 +671,216 @@ public:
     }
 };
 
+// Like SliceHashIndex, but the keys are copied into an arena instead of one std::string per key,
+// which saves the std::string object and the malloc overhead of each key. The map only keeps a
+// pointer to the key, which is prefixed by its length in varint32. The space of the erased keys
+// is reclaimed by copying the alive keys into a new arena when it's more than the alive ones.
+class CompactSliceHashIndex : public HashIndex {
+private:
+    constexpr static size_t kArenaBlockSize = 256 * 1024;
+    constexpr static size_t kMaxVarint32Length = 5;
+
+    static Slice decode_key(const uint8_t* p) {
+        uint32_t len = 0;
+        const uint8_t* data = decode_varint32_ptr(p, p + kMaxVarint32Length, &len);
+        return {data, len};
+    }
+
+    struct KeyHash {
+        using is_transparent = void;
+        size_t operator()(const Slice& v) const { return crc_hash_64(v.data, v.size, 0x811C9DC5); }
+        size_t operator()(const uint8_t* p) const { return (*this)(decode_key(p)); }
+    };
+
+    struct KeyEq {
+        using is_transparent = void;
+        static Slice to_slice(const Slice& v) { return v; }
+        static Slice to_slice(const uint8_t* p) { return decode_key(p); }
+        template <class A, class B>
+        bool operator()(const A& a, const B& b) const {
+            return to_slice(a) == to_slice(b);
+        }
+    };
+
+    using KeyMap = phmap::parallel_flat_hash_map<const uint8_t*, tablet_rowid_t, KeyHash, KeyEq,
+                                                 TraceAlloc<phmap::priv::Pair<const uint8_t* const, tablet_rowid_t>>,
+                                                 4, phmap::NullMutex, false>;
+    KeyMap _map;
+    std::vector<std::unique_ptr<uint8_t[]>> _blocks;
+    uint8_t* _block_pos = nullptr;
+    size_t _block_remain = 0;
+    // bytes of all blocks
+    size_t _arena_bytes = 0;
+    // bytes of the keys copied into the arena, including the erased ones
+    size_t _key_bytes = 0;
+    size_t _erased_key_bytes = 0;
+
+    const uint8_t* _copy_key(const Slice& key) {
+        size_t need = kMaxVarint32Length + key.size;
+        if (_block_remain < need) {
+            size_t block_size = std::max(kArenaBlockSize, need);
+            _blocks.emplace_back(new uint8_t[block_size]);
+            _block_pos = _blocks.back().get();
+            _block_remain = block_size;
+            _arena_bytes += block_size;
+        }
+        uint8_t* start = _block_pos;
+        uint8_t* p = encode_varint32(start, key.size);
+        memcpy(p, key.data, key.size);
+        size_t used = p + key.size - start;
+        _block_pos += used;
+        _block_remain -= used;
+        _key_bytes += used;
+        return start;
+    }
+
+    static size_t encoded_size(const Slice& key) {
+        uint8_t buf[kMaxVarint32Length];
+        return encode_varint32(buf, key.size) - buf + key.size;
+    }
+
+    void _maybe_compact() {
+        if (_erased_key_bytes < kArenaBlockSize * 4 || _erased_key_bytes * 2 < _key_bytes) {
+            return;
+        }
+        auto old_blocks = std::move(_blocks);
+        _blocks.clear();
+        _block_pos = nullptr;
+        _block_remain = 0;
+        _arena_bytes = 0;
+        _key_bytes = 0;
+        _erased_key_bytes = 0;
+        KeyMap new_map;
+        new_map.reserve(_map.size());
+        for (const auto& [key, value] : _map) {
+            new_map.emplace(_copy_key(decode_key(key)), value);
+        }
+        _map.swap(new_map);
+    }
+
+public:
+    CompactSliceHashIndex() = default;
+    ~CompactSliceHashIndex() override = default;
+
+    size_t size() const override { return _map.size(); }
+
+    size_t capacity() const override { return _map.capacity(); }
+
+    void reserve(size_t size) override { _map.reserve(size); }
+
+    Status insert(uint32_t rssid, const vector<uint32_t>& rowids, const Column& pks, uint32_t idx_begin,
+                  uint32_t idx_end) override {
+        auto* keys = reinterpret_cast<const Slice*>(pks.raw_data());
+        DCHECK(idx_end <= rowids.size());
+        uint64_t base = (((uint64_t)rssid) << 32);
+        for (uint32_t i = idx_begin; i < idx_end; i++) {
+            uint64_t v = base + rowids[i];
+            bool inserted = false;
+            auto p = _map.lazy_emplace(keys[i], [&](const auto& ctor) {
+                ctor(_copy_key(keys[i]), v);
+                inserted = true;
+            });
+            if (!inserted) {
+                uint64_t old = p->second;
+                std::string msg = strings::Substitute(
+                        "insert found duplicate key new(rssid=$0 rowid=$1) old(rssid=$2 rowid=$3) "
+                        "key=$4 [$5]",
+                        rssid, rowids[i], (uint32_t)(old >> 32), (uint32_t)(old & ROWID_MASK), keys[i].to_string(),
+                        hexdump(keys[i].data, keys[i].size));
+                LOG(ERROR) << msg;
+                return Status::InternalError(msg);
+            }
+        }
+        return Status::OK();
+    }
+
+    void upsert(uint32_t rssid, uint32_t rowid_start, const Column& pks, uint32_t idx_begin, uint32_t idx_end,
+                DeletesMap* deletes) override {
+        auto* keys = reinterpret_cast<const Slice*>(pks.raw_data());
+        uint64_t base = (((uint64_t)rssid) << 32) + rowid_start;
+        for (uint32_t i = idx_begin; i < idx_end; i++) {
+            uint64_t v = base + i;
+            bool inserted = false;
+            auto p = _map.lazy_emplace(keys[i], [&](const auto& ctor) {
+                ctor(_copy_key(keys[i]), v);
+                inserted = true;
+            });
+            if (!inserted) {
+                uint64_t old = p->second;
+                if ((old >> 32) == rssid) {
+                    LOG(ERROR) << "found duplicate in upsert data rssid:" << rssid << " key=" << keys[i].to_string()
+                               << " [" << hexdump(keys[i].data, keys[i].size) << "]";
+                }
+                (*deletes)[(uint32_t)(old >> 32)].push_back((uint32_t)(old & ROWID_MASK));
+                p->second = v;
+            }
+        }
+    }
+
+    [[maybe_unused]] void try_replace(uint32_t rssid, uint32_t rowid_start, const Column& pks,
+                                      const vector<uint32_t>& src_rssid, uint32_t idx_begin, uint32_t idx_end,
+                                      vector<uint32_t>* failed) override {
+        auto* keys = reinterpret_cast<const Slice*>(pks.raw_data());
+        uint64_t base = (((uint64_t)rssid) << 32) + rowid_start;
+        for (uint32_t i = idx_begin; i < idx_end; i++) {
+            auto p = _map.find(keys[i]);
+            if (p != _map.end() && (uint32_t)(p->second >> 32) == src_rssid[i]) {
+                // matched, can replace
+                p->second = base + i;
+            } else {
+                // not match, mark failed
+                failed->push_back(rowid_start + i);
+            }
+        }
+    }
+
+    void try_replace(uint32_t rssid, uint32_t rowid_start, const Column& pks, const uint32_t max_src_rssid,
+                     uint32_t idx_begin, uint32_t idx_end, vector<uint32_t>* failed) override {
+        auto* keys = reinterpret_cast<const Slice*>(pks.raw_data());
+        uint64_t base = (((uint64_t)rssid) << 32) + rowid_start;
+        for (uint32_t i = idx_begin; i < idx_end; i++) {
+            auto p = _map.find(keys[i]);
+            if (p != _map.end() && (uint32_t)(p->second >> 32) <= max_src_rssid) {
+                // matched, can replace
+                p->second = base + i;
+            } else {
+                // not match, mark failed
+                failed->push_back(rowid_start + i);
+            }
+        }
+    }
+
+    void erase(const Column& pks, uint32_t idx_begin, uint32_t idx_end, DeletesMap* deletes) override {
+        auto* keys = reinterpret_cast<const Slice*>(pks.raw_data());
+        for (uint32_t i = idx_begin; i < idx_end; i++) {
+            auto p = _map.find(keys[i]);
+            if (p != _map.end()) {
+                uint64_t old = p->second;
+                (*deletes)[(uint32_t)(old >> 32)].push_back((uint32_t)(old & ROWID_MASK));
+                _map.erase(p);
+                _erased_key_bytes += encoded_size(keys[i]);
+            }
+        }
+        _maybe_compact();
+    }
+
+    void get(const Column& pks, uint32_t idx_begin, uint32_t idx_end, std::vector<uint64_t>* rowids) override {
+        auto* keys = reinterpret_cast<const Slice*>(pks.raw_data());
+        for (uint32_t i = idx_begin; i < idx_end; i++) {
+            auto p = _map.find(keys[i]);
+            if (p != _map.end()) {
+                (*rowids)[i] = p->second;
+            } else {
+                (*rowids)[i] = -1;
+            }
+        }
+    }
+
+    std::size_t memory_usage() const final {
+        return _map.capacity() * (1 + sizeof(const uint8_t*) + sizeof(tablet_rowid_t)) + _arena_bytes;
+    }
+};
+
 class ShardByLengthSliceHashIndex : public HashIndex {
 private:
     constexpr static size_t max_fix_length = 40;
@@ -725,7 +937,13 @@ private:
             CASE_LEN(39)
         default: {
             auto& p = _maps[0];
-            if (!p) p = std::make_unique<SliceHashIndex>();
+            if (!p) {
+                if (config::enable_primary_index_compact_key) {
+                    p = std::make_unique<CompactSliceHashIndex>();
+                } else {
+                    p = std::make_unique<SliceHashIndex>();
+                }
+            }
             return p.get();
         }
         }
@@ -0,0 +1,360 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "column/column.h"
+#include "gutil/strings/substitute.h"
+#include "storage/range.h"
+#include "storage/rowset/options.h"
+#include "storage/rowset/page_builder.h"
+#include "storage/rowset/page_decoder.h"
+#include "storage/type_traits.h"
+#include "util/coding.h"
+#include "util/faststring.h"
+#include "util/frame_of_reference_coding.h"
+#include "util/unaligned_access.h"
+
+namespace starrocks {
+
+// ALP (Adaptive Lossless floating-Point) page for FLOAT and DOUBLE.
+//
+// Most floating point columns are decimals in disguise, e.g. prices or measurements with a
+// fixed number of fractional digits. For such a value v there is an exponent e that makes
+// d = round(v * 10^e) an integer and d / 10^e gives back exactly the same bits of v. The integers
+// of a page are stored with frame-of-reference coding, and the values that can not round-trip
+// (NaN, inf, -0.0 or "real" floating numbers) are stored as exceptions with their positions.
+// If the encoded page is not smaller than the plain values, the values are stored as is.
+//
+// Page layout:
+//   num_values: uint32
+//   mode: uint8, ALP_PAGE_MODE_ALP or ALP_PAGE_MODE_RAW
+//   raw mode: values
+//   alp mode: exponent: uint8, num_exceptions: uint32, for_size: uint32, for_data,
+//             exception positions: uint32 * num_exceptions, exception values: CppType * num_exceptions
+static const size_t ALP_PAGE_HEADER_SIZE = sizeof(uint32_t) + sizeof(uint8_t);
+static const size_t ALP_PAGE_ALP_HEADER_SIZE = sizeof(uint8_t) + sizeof(uint32_t) * 2;
+static const uint8_t ALP_PAGE_MODE_ALP = 0;
+static const uint8_t ALP_PAGE_MODE_RAW = 1;
+
+template <typename CppType>
+struct AlpTraits {};
+
+template <>
+struct AlpTraits<double> {
+    static constexpr int MAX_EXPONENT = 18;
+    static constexpr double POW10[MAX_EXPONENT + 1] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8, 1e9,
+                                                       1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18};
+};
+
+template <>
+struct AlpTraits<float> {
+    static constexpr int MAX_EXPONENT = 10;
+    static constexpr float POW10[MAX_EXPONENT + 1] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f,
+                                                      1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+};
+
+template <typename CppType>
+class AlpCodec {
+public:
+    // The digits larger than this can not be represented exactly by a double.
+    static constexpr double MAX_DIGIT = static_cast<double>(1LL << 53);
+
+    // Both the encoder and the decoder use this formula, so a value that round-trips
+    // in the encoder is decoded to the same bits.
+    static CppType decode(int64_t digit, int exponent) {
+        return static_cast<CppType>(digit) / AlpTraits<CppType>::POW10[exponent];
+    }
+
+    // Return true if |value| can be restored from |*digit| with |exponent|.
+    static bool encode(CppType value, int exponent, int64_t* digit) {
+        double scaled = std::nearbyint(static_cast<double>(value) * AlpTraits<double>::POW10[exponent]);
+        // Also rejects NaN.
+        if (!(std::abs(scaled) < MAX_DIGIT)) {
+            return false;
+        }
+        *digit = static_cast<int64_t>(scaled);
+        CppType decoded = decode(*digit, exponent);
+        return memcmp(&decoded, &value, sizeof(CppType)) == 0;
+    }
+
+    // Choose the exponent that produces the fewest exceptions on a sample of |values|.
+    static int choose_exponent(const CppType* values, size_t count) {
+        static constexpr size_t SAMPLE_SIZE = 256;
+        size_t step = std::max<size_t>(1, count / SAMPLE_SIZE);
+        int best_exponent = 0;
+        size_t best_exceptions = std::numeric_limits<size_t>::max();
+        for (int e = 0; e <= AlpTraits<CppType>::MAX_EXPONENT && best_exceptions > 0; e++) {
+            size_t exceptions = 0;
+            int64_t digit;
+            for (size_t i = 0; i < count; i += step) {
+                exceptions += !encode(values[i], e, &digit);
+            }
+            if (exceptions < best_exceptions) {
+                best_exceptions = exceptions;
+                best_exponent = e;
+            }
+        }
+        return best_exponent;
+    }
+};
+
+template <LogicalType Type>
+class AlpPageBuilder final : public PageBuilder {
+public:
+    explicit AlpPageBuilder(const PageBuilderOptions& options) : _options(options) {
+        _max_count = std::max<uint32_t>(1, _options.data_page_size / SIZE_OF_TYPE);
+        reset();
+    }
+
+    ~AlpPageBuilder() override = default;
+
+    bool is_page_full() override { return _values.size() >= _max_count; }
+
+    uint32_t add(const uint8_t* vals, uint32_t count) override {
+        DCHECK(!_finished);
+        uint32_t to_add = std::min<uint32_t>(_max_count - _values.size(), count);
+        auto new_vals = reinterpret_cast<const CppType*>(vals);
+        _values.insert(_values.end(), new_vals, new_vals + to_add);
+        return to_add;
+    }
+
+    faststring* finish() override {
+        DCHECK(!_finished);
+        _finished = true;
+        uint32_t count = _values.size();
+        _buf.clear();
+        _buf.resize(ALP_PAGE_HEADER_SIZE);
+        encode_fixed32_le(&_buf[0], count);
+        if (count == 0 || !_encode_alp()) {
+            _buf.resize(ALP_PAGE_HEADER_SIZE);
+            _buf[sizeof(uint32_t)] = ALP_PAGE_MODE_RAW;
+            _buf.append(_values.data(), count * SIZE_OF_TYPE);
+        }
+        return &_buf;
+    }
+
+    void reset() override {
+        _values.clear();
+        _values.reserve(_max_count);
+        _buf.clear();
+        _finished = false;
+    }
+
+    uint32_t count() const override { return _values.size(); }
+
+    uint64_t size() const override { return _finished ? _buf.size() : _values.size() * SIZE_OF_TYPE; }
+
+    Status get_first_value(void* value) const override {
+        if (_values.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_values.front(), SIZE_OF_TYPE);
+        return Status::OK();
+    }
+
+    Status get_last_value(void* value) const override {
+        if (_values.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_values.back(), SIZE_OF_TYPE);
+        return Status::OK();
+    }
+
+private:
+    typedef typename TypeTraits<Type>::CppType CppType;
+    enum { SIZE_OF_TYPE = TypeTraits<Type>::size };
+
+    // Append the alp encoded values to |_buf|, return false if it is not smaller than the raw values.
+    bool _encode_alp() {
+        size_t count = _values.size();
+        int exponent = AlpCodec<CppType>::choose_exponent(_values.data(), count);
+
+        std::vector<int64_t> digits(count);
+        std::vector<uint32_t> exception_positions;
+        std::vector<CppType> exception_values;
+        int64_t last_digit = 0;
+        for (size_t i = 0; i < count; i++) {
+            int64_t digit;
+            if (AlpCodec<CppType>::encode(_values[i], exponent, &digit)) {
+                last_digit = digit;
+            } else {
+                // Fill the hole with the previous digit to keep the frame narrow.
+                digit = last_digit;
+                exception_positions.push_back(i);
+                exception_values.push_back(_values[i]);
+            }
+            digits[i] = digit;
+        }
+        size_t raw_size = ALP_PAGE_HEADER_SIZE + count * SIZE_OF_TYPE;
+        size_t exceptions_size = exception_positions.size() * (sizeof(uint32_t) + SIZE_OF_TYPE);
+        if (ALP_PAGE_HEADER_SIZE + ALP_PAGE_ALP_HEADER_SIZE + exceptions_size >= raw_size) {
+            return false;
+        }
+
+        faststring for_buf;
+        ForEncoder<int64_t> encoder(&for_buf);
+        encoder.put_batch(digits.data(), count);
+        encoder.flush();
+        if (ALP_PAGE_HEADER_SIZE + ALP_PAGE_ALP_HEADER_SIZE + for_buf.size() + exceptions_size >= raw_size) {
+            return false;
+        }
+
+        _buf[sizeof(uint32_t)] = ALP_PAGE_MODE_ALP;
+        _buf.push_back(static_cast<uint8_t>(exponent));
+        put_fixed32_le(&_buf, exception_positions.size());
+        put_fixed32_le(&_buf, for_buf.size());
+        _buf.append(for_buf.data(), for_buf.size());
+        _buf.append(exception_positions.data(), exception_positions.size() * sizeof(uint32_t));
+        _buf.append(exception_values.data(), exception_values.size() * SIZE_OF_TYPE);
+        return true;
+    }
+
+    PageBuilderOptions _options;
+    uint32_t _max_count;
+    bool _finished{false};
+    std::vector<CppType> _values;
+    faststring _buf;
+};
+
+template <LogicalType Type>
+class AlpPageDecoder final : public PageDecoder {
+public:
+    AlpPageDecoder(Slice data, const PageDecoderOptions& options) : _data(data) {}
+
+    ~AlpPageDecoder() override = default;
+
+    Status init() override {
+        CHECK(!_parsed);
+        if (_data.size < ALP_PAGE_HEADER_SIZE) {
+            return Status::Corruption("not enough bytes for header in AlpPageDecoder");
+        }
+        const auto* data = reinterpret_cast<const uint8_t*>(_data.data);
+        _num_elements = decode_fixed32_le(data);
+        uint8_t mode = data[sizeof(uint32_t)];
+        if (mode == ALP_PAGE_MODE_RAW) {
+            if (_data.size != ALP_PAGE_HEADER_SIZE + _num_elements * SIZE_OF_TYPE) {
+                return Status::Corruption("unexpected data size of raw alp page");
+            }
+            _values = data + ALP_PAGE_HEADER_SIZE;
+        } else if (mode == ALP_PAGE_MODE_ALP) {
+            RETURN_IF_ERROR(_decode_alp(data));
+            _values = reinterpret_cast<const uint8_t*>(_decoded.data());
+        } else {
+            return Status::Corruption(strings::Substitute("unknown alp page mode $0", mode));
+        }
+        _parsed = true;
+        return Status::OK();
+    }
+
+    Status seek_to_position_in_page(uint32_t pos) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        DCHECK_LE(pos, _num_elements);
+        _cur_index = pos;
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* count, Column* dst) override {
+        SparseRange read_range;
+        uint32_t begin = current_index();
+        read_range.add(Range(begin, begin + *count));
+        RETURN_IF_ERROR(next_batch(read_range, dst));
+        *count = current_index() - begin;
+        return Status::OK();
+    }
+
+    Status next_batch(const SparseRange& range, Column* dst) override {
+        DCHECK(_parsed);
+        size_t to_read = range.span_size();
+        if (PREDICT_FALSE(to_read == 0 || _cur_index >= _num_elements)) {
+            return Status::OK();
+        }
+        SparseRangeIterator iter = range.new_iterator();
+        while (iter.has_more() && _cur_index < _num_elements) {
+            _cur_index = iter.begin();
+            Range r = iter.next(to_read);
+            uint32_t max_fetch = std::min(r.span_size(), _num_elements - _cur_index);
+            int n = dst->append_numbers(_values + _cur_index * SIZE_OF_TYPE, max_fetch * SIZE_OF_TYPE);
+            DCHECK_EQ(max_fetch, n);
+            _cur_index += max_fetch;
+        }
+        return Status::OK();
+    }
+
+    uint32_t count() const override { return _num_elements; }
+
+    uint32_t current_index() const override { return _cur_index; }
+
+    EncodingTypePB encoding_type() const override { return ALP_ENCODING; }
+
+private:
+    typedef typename TypeTraits<Type>::CppType CppType;
+    enum { SIZE_OF_TYPE = TypeTraits<Type>::size };
+
+    Status _decode_alp(const uint8_t* data) {
+        if (_data.size < ALP_PAGE_HEADER_SIZE + ALP_PAGE_ALP_HEADER_SIZE) {
+            return Status::Corruption("not enough bytes for alp header in AlpPageDecoder");
+        }
+        const uint8_t* p = data + ALP_PAGE_HEADER_SIZE;
+        int exponent = *p;
+        uint32_t num_exceptions = decode_fixed32_le(p + 1);
+        uint32_t for_size = decode_fixed32_le(p + 1 + sizeof(uint32_t));
+        p += ALP_PAGE_ALP_HEADER_SIZE;
+        if (exponent > AlpTraits<CppType>::MAX_EXPONENT || num_exceptions > _num_elements ||
+            _data.size != ALP_PAGE_HEADER_SIZE + ALP_PAGE_ALP_HEADER_SIZE + for_size +
+                                  static_cast<size_t>(num_exceptions) * (sizeof(uint32_t) + SIZE_OF_TYPE)) {
+            return Status::Corruption("unexpected data size of alp page");
+        }
+
+        ForDecoder<int64_t> decoder(p, for_size);
+        std::vector<int64_t> digits(_num_elements);
+        if (!decoder.init() || decoder.count() != _num_elements || !decoder.get_batch(digits.data(), _num_elements)) {
+            return Status::Corruption("The frame of reference data of alp page maybe broken");
+        }
+        p += for_size;
+
+        _decoded.resize(_num_elements);
+        // No branch in this loop so it can be vectorized.
+        const CppType pow10 = AlpTraits<CppType>::POW10[exponent];
+        for (uint32_t i = 0; i < _num_elements; i++) {
+            _decoded[i] = static_cast<CppType>(digits[i]) / pow10;
+        }
+
+        const uint8_t* exception_values = p + num_exceptions * sizeof(uint32_t);
+        for (uint32_t i = 0; i < num_exceptions; i++) {
+            uint32_t pos = unaligned_load<uint32_t>(p + i * sizeof(uint32_t));
+            if (PREDICT_FALSE(pos >= _num_elements)) {
+                return Status::Corruption("invalid exception position of alp page");
+            }
+            _decoded[pos] = unaligned_load<CppType>(exception_values + i * SIZE_OF_TYPE);
+        }
+        return Status::OK();
+    }
+
+    Slice _data;
+    bool _parsed{false};
+    uint32_t _num_elements{0};
+    uint32_t _cur_index{0};
+    // Point to the raw values in |_data| or the values in |_decoded|.
+    const uint8_t* _values{nullptr};
+    std::vector<CppType> _decoded;
+};
+
+} // namespace starrocks
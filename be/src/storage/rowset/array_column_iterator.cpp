@@ -39,7 +39,12 @@ Status ArrayColumnIterator::init(const ColumnIteratorOptions& opts) {
         RETURN_IF_ERROR(_null_iterator->init(opts));
     }
     RETURN_IF_ERROR(_array_size_iterator->init(opts));
-    RETURN_IF_ERROR(_element_iterator->init(opts));
+    _lengths_only = opts.lengths_only;
+    if (!_lengths_only) {
+        ColumnIteratorOptions element_opts = opts;
+        element_opts.lengths_only = false;
+        RETURN_IF_ERROR(_element_iterator->init(element_opts));
+    }
     return Status::OK();
 }
 
@@ -81,6 +86,10 @@ Status ArrayColumnIterator::next_batch(size_t* n, Column* dst) {
     num_to_read = end_offset - num_to_read;
 
     // 3. Read elements
+    if (_lengths_only) {
+        array_column->elements_column()->append_default(num_to_read);
+        return Status::OK();
+    }
     RETURN_IF_ERROR(_element_iterator->next_batch(&num_to_read, array_column->elements_column().get()));
 
     return Status::OK();
@@ -120,7 +129,7 @@ Status ArrayColumnIterator::next_batch(const SparseRange& range, Column* dst) {
         size_t element_ordinal = _array_size_iterator->element_ordinal();
         // if array column in nullable or element of array is empty, element_read_range may be empty.
         // so we should reseek the element_ordinal
-        if (element_read_range.span_size() == 0) {
+        if (element_read_range.span_size() == 0 && !_lengths_only) {
             _element_iterator->seek_to_ordinal(element_ordinal);
         }
         // 2. Read offset column
@@ -146,6 +155,10 @@ Status ArrayColumnIterator::next_batch(const SparseRange& range, Column* dst) {
         element_read_range.add(Range(element_ordinal, element_ordinal + num_to_read));
     }
 
+    if (_lengths_only) {
+        array_column->elements_column()->append_default(element_read_range.span_size());
+        return Status::OK();
+    }
     // if array column is nullable, element_read_range may be empty
     DCHECK(element_read_range.empty() || (element_read_range.begin() == _element_iterator->get_current_ordinal()));
     RETURN_IF_ERROR(_element_iterator->next_batch(element_read_range, array_column->elements_column().get()));
@@ -184,6 +197,10 @@ Status ArrayColumnIterator::fetch_values_by_rowid(const rowid_t* rowids, size_t
     }
 
     // 3. Read elements
+    if (_lengths_only) {
+        array_column->elements_column()->append_default(offset - array_column->elements_column()->size());
+        return Status::OK();
+    }
     for (size_t i = 0; i < size; ++i) {
         RETURN_IF_ERROR(_array_size_iterator->seek_to_ordinal_and_calc_element_ordinal(rowids[i]));
         size_t element_ordinal = _array_size_iterator->element_ordinal();
@@ -199,7 +216,9 @@ Status ArrayColumnIterator::seek_to_first() {
         RETURN_IF_ERROR(_null_iterator->seek_to_first());
     }
     RETURN_IF_ERROR(_array_size_iterator->seek_to_first());
-    RETURN_IF_ERROR(_element_iterator->seek_to_first());
+    if (!_lengths_only) {
+        RETURN_IF_ERROR(_element_iterator->seek_to_first());
+    }
     return Status::OK();
 }
 
@@ -208,8 +227,10 @@ Status ArrayColumnIterator::seek_to_ordinal(ordinal_t ord) {
         RETURN_IF_ERROR(_null_iterator->seek_to_ordinal(ord));
     }
     RETURN_IF_ERROR(_array_size_iterator->seek_to_ordinal_and_calc_element_ordinal(ord));
-    size_t element_ordinal = _array_size_iterator->element_ordinal();
-    RETURN_IF_ERROR(_element_iterator->seek_to_ordinal(element_ordinal));
+    if (!_lengths_only) {
+        size_t element_ordinal = _array_size_iterator->element_ordinal();
+        RETURN_IF_ERROR(_element_iterator->seek_to_ordinal(element_ordinal));
+    }
     return Status::OK();
 }
 
@@ -56,6 +56,8 @@ private:
     std::unique_ptr<ColumnIterator> _null_iterator;
     std::unique_ptr<ColumnIterator> _array_size_iterator;
     std::unique_ptr<ColumnIterator> _element_iterator;
+    // The elements are not decoded, see ColumnIteratorOptions::lengths_only.
+    bool _lengths_only = false;
 };
 
 } // namespace starrocks
@@ -17,6 +17,7 @@
 #include "common/status.h"
 #include "gutil/casts.h"
 #include "storage/rowset/column_writer.h"
+#include "types/logical_type.h"
 
 namespace starrocks {
 
@@ -40,11 +41,11 @@ public:
 
     Status finish_current_page() override;
 
-    Status write_zone_map() override { return Status::OK(); }
+    Status write_zone_map() override { return _element_writer->write_zone_map(); }
 
     Status write_bitmap_index() override { return Status::OK(); }
 
-    Status write_bloom_filter_index() override { return Status::OK(); }
+    Status write_bloom_filter_index() override { return _element_writer->write_bloom_filter_index(); }
 
     ordinal_t get_next_rowid() const override { return _array_size_writer->get_next_rowid(); }
 
@@ -65,7 +66,8 @@ StatusOr<std::unique_ptr<ColumnWriter>> create_array_column_writer(const ColumnW
     const TabletColumn& element_column = column->subcolumn(0);
     ColumnWriterOptions element_options;
     element_options.meta = opts.meta->mutable_children_columns(0);
-    element_options.need_zone_map = false;
+    element_options.need_zone_map = opts.need_subfield_zone_map && is_zone_map_key_type(element_column.type());
+    element_options.need_subfield_zone_map = opts.need_subfield_zone_map;
     element_options.need_bloom_filter = element_column.is_bf_column();
     element_options.need_bitmap_index = element_column.has_bitmap_index();
     if (element_column.type() == LogicalType::TYPE_ARRAY) {
@@ -175,6 +175,34 @@ bool BinaryDictPageBuilder::is_valid_global_dict(const GlobalDictMap* global_dic
     return true;
 }
 
+bool BinaryDictPageBuilder::seed_dictionary(const std::vector<std::string>& words) {
+    DCHECK(_dictionary.empty());
+    DCHECK_EQ(_encoding_type, DICT_ENCODING);
+    bool fit = true;
+    for (const auto& word : words) {
+        if (_dictionary.count(Slice(word)) > 0 || !_dict_builder->add_slice(Slice(word))) {
+            fit = false;
+            break;
+        }
+        _dictionary.emplace(word, _dictionary.size());
+    }
+    // A full dictionary page would switch the data pages to plain encoding immediately.
+    if (!fit || _dict_builder->is_page_full()) {
+        _dictionary.clear();
+        _dict_builder->reset();
+        return false;
+    }
+    return true;
+}
+
+std::vector<std::string> BinaryDictPageBuilder::dictionary_words() const {
+    std::vector<std::string> words(_dictionary.size());
+    for (const auto& [word, code] : _dictionary) {
+        words[code] = word;
+    }
+    return words;
+}
+
 template <LogicalType Type>
 BinaryDictPageDecoder<Type>::BinaryDictPageDecoder(Slice data, const PageDecoderOptions& options)
         : _data(data),
@@ -85,6 +85,10 @@ public:
 
     bool is_valid_global_dict(const GlobalDictMap* global_dict) const override;
 
+    bool seed_dictionary(const std::vector<std::string>& words) override;
+
+    std::vector<std::string> dictionary_words() const override;
+
     // Return true iff all pages so far are encoded by dictionary encoding.
     // this method normally should be called after all data pages finish
     // write, i.e, after `finish` has been called.
@@ -0,0 +1,205 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/rowset/binary_fsst_page.h"
+
+#include <cstring>
+
+#include "column/binary_column.h"
+#include "column/column_helper.h"
+#include "column/nullable_column.h"
+#include "gutil/casts.h"
+#include "types/logical_type.h"
+
+namespace starrocks {
+
+uint32_t BinaryFsstPageBuilder::add(const uint8_t* vals, uint32_t count) {
+    DCHECK(!_finished);
+    const auto* slices = reinterpret_cast<const Slice*>(vals);
+    for (uint32_t i = 0; i < count; i++) {
+        if (is_page_full()) {
+            return i;
+        }
+        _raw_offsets.push_back(_raw_values.size());
+        _raw_values.append(slices[i].data, slices[i].size);
+        _raw_size += slices[i].size + sizeof(uint32_t);
+    }
+    return count;
+}
+
+faststring* BinaryFsstPageBuilder::finish() {
+    DCHECK(!_finished);
+    _finished = true;
+    size_t num_elems = _raw_offsets.size();
+    std::vector<Slice> values;
+    values.reserve(num_elems);
+    for (size_t i = 0; i < num_elems; i++) {
+        values.emplace_back(_get_value(i));
+    }
+    FsstSymbolTable table = FsstSymbolTable::build(values);
+
+    _buffer.clear();
+    _buffer.reserve(BINARY_FSST_PAGE_HEADER_SIZE + _raw_size);
+    put_fixed32_le(&_buffer, num_elems);
+    put_fixed32_le(&_buffer, 0);
+    table.serialize(&_buffer);
+    encode_fixed32_le(&_buffer[sizeof(uint32_t)], _buffer.size() - BINARY_FSST_PAGE_HEADER_SIZE);
+
+    size_t codes_begin = _buffer.size();
+    std::vector<uint32_t> offsets;
+    offsets.reserve(num_elems + 1);
+    for (const auto& value : values) {
+        offsets.push_back(_buffer.size() - codes_begin);
+        table.compress(value, &_buffer);
+    }
+    offsets.push_back(_buffer.size() - codes_begin);
+    for (uint32_t offset : offsets) {
+        put_fixed32_le(&_buffer, offset);
+    }
+    return &_buffer;
+}
+
+template <LogicalType Type>
+Status BinaryFsstPageDecoder<Type>::init() {
+    RETURN_IF(_parsed, Status::OK());
+    if (_data.size < BINARY_FSST_PAGE_HEADER_SIZE) {
+        return Status::Corruption("not enough bytes for header in BinaryFsstPageDecoder");
+    }
+    const auto* data = reinterpret_cast<const uint8_t*>(_data.data);
+    _num_elems = decode_fixed32_le(data);
+    uint32_t table_size = decode_fixed32_le(data + sizeof(uint32_t));
+    size_t offsets_size = (static_cast<size_t>(_num_elems) + 1) * sizeof(uint32_t);
+    if (_data.size < BINARY_FSST_PAGE_HEADER_SIZE + table_size + offsets_size) {
+        return Status::Corruption("unexpected data size of fsst page");
+    }
+    size_t consumed = 0;
+    RETURN_IF_ERROR(_table.deserialize(data + BINARY_FSST_PAGE_HEADER_SIZE, table_size, &consumed));
+    _codes = data + BINARY_FSST_PAGE_HEADER_SIZE + table_size;
+    _offsets = data + _data.size - offsets_size;
+    if (_codes + _offset(_num_elems) != _offsets) {
+        return Status::Corruption("unexpected codes size of fsst page");
+    }
+    _parsed = true;
+    return Status::OK();
+}
+
+template <LogicalType Type>
+Status BinaryFsstPageDecoder<Type>::next_batch(size_t* count, Column* dst) {
+    SparseRange read_range;
+    uint32_t begin = current_index();
+    read_range.add(Range(begin, begin + *count));
+    RETURN_IF_ERROR(next_batch(read_range, dst));
+    *count = current_index() - begin;
+    return Status::OK();
+}
+
+template <LogicalType Type>
+Status BinaryFsstPageDecoder<Type>::next_batch(const SparseRange& range, Column* dst) {
+    DCHECK(_parsed);
+    if (PREDICT_FALSE(_cur_idx >= _num_elems)) {
+        return Status::OK();
+    }
+
+    size_t to_read = std::min(range.span_size(), _num_elems - _cur_idx);
+    SparseRangeIterator iter = range.new_iterator();
+    if constexpr (Type == TYPE_VARCHAR) {
+        // Decompress into the bytes of the column directly.
+        auto* binary = down_cast<BinaryColumn*>(ColumnHelper::get_data_column(dst));
+        auto& bytes = binary->get_bytes();
+        auto& offsets = binary->get_offset();
+        size_t num_read = 0;
+        while (to_read > 0) {
+            _cur_idx = iter.begin();
+            Range r = iter.next(to_read);
+            uint32_t end = _cur_idx + r.span_size();
+            size_t pos = bytes.size();
+            bytes.resize(pos + FsstSymbolTable::decompress_bound(_offset(end) - _offset(_cur_idx)));
+            for (; _cur_idx < end; _cur_idx++) {
+                pos += _table.decompress(_codes_at(_cur_idx), _codes_len(_cur_idx), bytes.data() + pos);
+                offsets.push_back(pos);
+            }
+            bytes.resize(pos);
+            num_read += r.span_size();
+            to_read -= r.span_size();
+        }
+        if (dst->is_nullable()) {
+            auto& null_data = down_cast<NullableColumn*>(dst)->null_column_data();
+            null_data.resize(null_data.size() + num_read, 0);
+        }
+#ifndef NDEBUG
+        dst->check_or_die();
+#endif
+        return Status::OK();
+    } else {
+        std::vector<std::pair<uint32_t, uint32_t>> positions;
+        positions.reserve(to_read);
+        _decompressed.clear();
+        while (to_read > 0) {
+            _cur_idx = iter.begin();
+            Range r = iter.next(to_read);
+            uint32_t end = _cur_idx + r.span_size();
+            size_t pos = _decompressed.size();
+            _decompressed.resize(pos + FsstSymbolTable::decompress_bound(_offset(end) - _offset(_cur_idx)));
+            for (; _cur_idx < end; _cur_idx++) {
+                size_t len = _table.decompress(_codes_at(_cur_idx), _codes_len(_cur_idx), _decompressed.data() + pos);
+                positions.emplace_back(pos, len);
+                pos += len;
+            }
+            _decompressed.resize(pos);
+            to_read -= r.span_size();
+        }
+        std::vector<Slice> strs;
+        strs.reserve(positions.size());
+        for (const auto& [pos, len] : positions) {
+            Slice s(_decompressed.data() + pos, len);
+            if constexpr (Type == TYPE_CHAR) {
+                s.size = strnlen(s.data, s.size);
+            }
+            strs.emplace_back(s);
+        }
+        if (dst->append_strings(strs)) {
+            return Status::OK();
+        }
+    }
+    return Status::InvalidArgument("Column::append_strings() not supported");
+}
+
+template <LogicalType Type>
+void BinaryFsstPageDecoder<Type>::match_equal(const Slice& value, uint32_t from, uint32_t to,
+                                              uint8_t* selection) const {
+    DCHECK(_parsed);
+    DCHECK_LE(to, _num_elems);
+    // The compression is deterministic, so compare the codes instead of the strings.
+    faststring codes;
+    _table.compress(value, &codes);
+    for (uint32_t i = from; i < to; i++) {
+        selection[i - from] =
+                _codes_len(i) == codes.size() && memcmp(_codes_at(i), codes.data(), codes.size()) == 0;
+    }
+}
+
+template <LogicalType Type>
+void BinaryFsstPageDecoder<Type>::match_prefix(const Slice& prefix, uint32_t from, uint32_t to,
+                                               uint8_t* selection) const {
+    DCHECK(_parsed);
+    DCHECK_LE(to, _num_elems);
+    for (uint32_t i = from; i < to; i++) {
+        selection[i - from] = _table.starts_with(_codes_at(i), _codes_len(i), prefix);
+    }
+}
+
+template class BinaryFsstPageDecoder<TYPE_CHAR>;
+template class BinaryFsstPageDecoder<TYPE_VARCHAR>;
+
+} // namespace starrocks
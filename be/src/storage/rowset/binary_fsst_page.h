@@ -0,0 +1,158 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// FSST compressed page encoding for strings.
+//
+// A symbol table is built from the values of each page, and every value is compressed on its own,
+// so a single value can be decoded without touching the others, and equality or prefix predicates
+// can be evaluated on the compressed codes.
+//
+// The page consists of:
+//   num_elems (32-bit fixed)
+//   symbol table size (32-bit fixed)
+//   symbol table
+//   compressed strings
+//   offsets (32-bit fixed) * (num_elems + 1), pointing to the beginning of each compressed string
+//     relative to the first compressed string, the last one is the end of compressed strings
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common/logging.h"
+#include "storage/range.h"
+#include "storage/rowset/options.h"
+#include "storage/rowset/page_builder.h"
+#include "storage/rowset/page_decoder.h"
+#include "storage/types.h"
+#include "util/coding.h"
+#include "util/faststring.h"
+#include "util/fsst.h"
+
+namespace starrocks {
+class Column;
+}
+
+namespace starrocks {
+
+static const size_t BINARY_FSST_PAGE_HEADER_SIZE = sizeof(uint32_t) * 2;
+
+class BinaryFsstPageBuilder final : public PageBuilder {
+public:
+    explicit BinaryFsstPageBuilder(const PageBuilderOptions& options) : _options(options) { reset(); }
+
+    // The page size is limited by the size of the uncompressed values.
+    bool is_page_full() override {
+        // data_page_size is 0, do not limit the page size
+        return (_options.data_page_size != 0) & (_raw_size > _options.data_page_size);
+    }
+
+    uint32_t add(const uint8_t* vals, uint32_t count) override;
+
+    faststring* finish() override;
+
+    void reset() override {
+        _raw_values.clear();
+        _raw_offsets.clear();
+        _raw_size = 0;
+        _buffer.clear();
+        _finished = false;
+    }
+
+    uint32_t count() const override { return _raw_offsets.size(); }
+
+    uint64_t size() const override { return _finished ? _buffer.size() : _raw_size; }
+
+    Status get_first_value(void* value) const override {
+        DCHECK(_finished);
+        if (_raw_offsets.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        *reinterpret_cast<Slice*>(value) = _get_value(0);
+        return Status::OK();
+    }
+
+    Status get_last_value(void* value) const override {
+        DCHECK(_finished);
+        if (_raw_offsets.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        *reinterpret_cast<Slice*>(value) = _get_value(_raw_offsets.size() - 1);
+        return Status::OK();
+    }
+
+private:
+    Slice _get_value(size_t idx) const {
+        size_t end = (idx + 1) < _raw_offsets.size() ? _raw_offsets[idx + 1] : _raw_values.size();
+        return {_raw_values.data() + _raw_offsets[idx], end - _raw_offsets[idx]};
+    }
+
+    PageBuilderOptions _options;
+    // The uncompressed values, the symbol table is built from them when the page is finished.
+    faststring _raw_values;
+    std::vector<uint32_t> _raw_offsets;
+    size_t _raw_size{0};
+    faststring _buffer;
+    bool _finished{false};
+};
+
+template <LogicalType Type>
+class BinaryFsstPageDecoder final : public PageDecoder {
+public:
+    BinaryFsstPageDecoder(Slice data, const PageDecoderOptions& options) : _data(data) {}
+
+    Status init() override;
+
+    Status seek_to_position_in_page(uint32_t pos) override {
+        DCHECK_LE(pos, _num_elems);
+        _cur_idx = pos;
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* count, Column* dst) override;
+
+    Status next_batch(const SparseRange& range, Column* dst) override;
+
+    uint32_t count() const override { return _num_elems; }
+
+    uint32_t current_index() const override { return _cur_idx; }
+
+    EncodingTypePB encoding_type() const override { return FSST_ENCODING; }
+
+    // Evaluate `value == |value|` for the rows in [from, to) on the compressed codes.
+    // selection[i - from] is set to 1 if the row i matches, and 0 otherwise.
+    void match_equal(const Slice& value, uint32_t from, uint32_t to, uint8_t* selection) const;
+
+    // Evaluate `value LIKE '|prefix|%'` for the rows in [from, to), only the codes needed to
+    // cover the prefix are decompressed.
+    void match_prefix(const Slice& prefix, uint32_t from, uint32_t to, uint8_t* selection) const;
+
+private:
+    const uint8_t* _codes_at(uint32_t idx) const { return _codes + _offset(idx); }
+    uint32_t _codes_len(uint32_t idx) const { return _offset(idx + 1) - _offset(idx); }
+    uint32_t _offset(uint32_t idx) const { return decode_fixed32_le(_offsets + idx * sizeof(uint32_t)); }
+
+    Slice _data;
+    bool _parsed{false};
+    uint32_t _num_elems{0};
+    uint32_t _cur_idx{0};
+    FsstSymbolTable _table;
+    const uint8_t* _codes{nullptr};
+    const uint8_t* _offsets{nullptr};
+    // Buffer of the decompressed values for the non-varchar types.
+    std::vector<uint8_t> _decompressed;
+};
+
+} // namespace starrocks
@@ -120,6 +120,16 @@ Status BitmapIndexIterator::read_bitmap(rowid_t ordinal, Roaring* result) {
     return Status::OK();
 }
 
+Status BitmapIndexIterator::read_dictionary(Column* dst) {
+    size_t num_to_read = _num_bitmap - _has_null;
+    size_t num_read = num_to_read;
+    RETURN_IF_ERROR(_dict_column_iter->seek_to_first());
+    RETURN_IF_ERROR(_dict_column_iter->next_batch(&num_read, dst));
+    DCHECK_EQ(num_to_read, num_read);
+    _current_rowid = _dict_column_iter->get_current_ordinal();
+    return Status::OK();
+}
+
 Status BitmapIndexIterator::read_union_bitmap(rowid_t from, rowid_t to, Roaring* result) {
     DCHECK(0 <= from && from <= to && to <= _reader->bitmap_nums());
 
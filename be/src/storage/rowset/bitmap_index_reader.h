@@ -45,6 +45,7 @@
 
 namespace starrocks {
 
+class Column;
 class FileSystem;
 class TypeInfo;
 class SparseRange;
@@ -149,6 +150,10 @@ public:
     // }
     Status read_union_bitmap(const SparseRange& range, Roaring* result);
 
+    // Read all the values of the dictionary into `dst` in ascending order, the i-th value corresponds to
+    // the bitmap at ordinal i. Null is not stored in the dictionary.
+    Status read_dictionary(Column* dst);
+
     rowid_t bitmap_nums() const { return _num_bitmap; }
 
     rowid_t current_ordinal() const { return _current_rowid; }
@@ -47,6 +47,7 @@
 #include "storage/olap_common.h"
 #include "storage/rowset/bitshuffle_wrapper.h"
 #include "storage/rowset/common.h"
+#include "storage/rowset/encoded_predicate.h"
 #include "storage/rowset/options.h"
 #include "storage/rowset/page_builder.h"
 #include "storage/rowset/page_decoder.h"
@@ -348,6 +349,20 @@ public:
 
     Status next_batch(const SparseRange& range, Column* dst) override;
 
+    Status evaluate(const ColumnPredicate& pred, uint32_t from, uint32_t to, uint8_t* selection) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        DCHECK_LE(to, _num_elements);
+        if constexpr (is_encoded_predicate_type<Type>) {
+            EncodedValueRange<CppType> range;
+            if (to_encoded_value_range<Type>(pred, &range)) {
+                // The values are unshuffled when the page is loaded, compare them in place.
+                range.evaluate(reinterpret_cast<const CppType*>(get_data(from * SIZE_OF_TYPE)), to - from, selection);
+                return Status::OK();
+            }
+        }
+        return Status::NotSupported("evaluate() not supported");
+    }
+
     uint32_t count() const override { return _num_elements; }
 
     uint32_t current_index() const override { return _cur_index; }
@@ -50,6 +50,9 @@ struct BloomFilterOptions {
     // false positive probablity
     double fpp = 0.05;
     HashStrategyPB strategy = HASH_MURMUR3_X64_64;
+    // If greater than 0, the n-grams of this size are added to the bloom filter instead of
+    // the values, which is used to filter the pages by `LIKE '%pattern%'`.
+    uint32_t gram_size = 0;
 };
 
 // Base class for bloom filter
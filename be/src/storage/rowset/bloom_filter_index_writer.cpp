@@ -34,6 +34,7 @@
 
 #include "storage/rowset/bloom_filter_index_writer.h"
 
+#include <cstring>
 #include <map>
 #include <memory>
 #include <utility>
@@ -47,6 +48,7 @@
 #include "storage/rowset/indexed_column_writer.h"
 #include "storage/type_traits.h"
 #include "storage/types.h"
+#include "util/phmap/phmap.h"
 #include "util/slice.h"
 
 namespace starrocks {
@@ -98,6 +100,23 @@ inline void update_bf(BloomFilter* bf, const typename CppTypeTraits<type>::CppTy
     }
 }
 
+// write the bloom filter of each page into an IndexedColumn with ordinal index
+Status write_bloom_filters(WritableFile* wfile, const std::vector<std::unique_ptr<BloomFilter>>& bfs,
+                           IndexedColumnMetaPB* meta) {
+    TypeInfoPtr bf_typeinfo = get_type_info(TYPE_VARCHAR);
+    IndexedColumnWriterOptions options;
+    options.write_ordinal_index = true;
+    options.write_value_index = false;
+    options.encoding = PLAIN_ENCODING;
+    IndexedColumnWriter bf_writer(options, bf_typeinfo, wfile);
+    RETURN_IF_ERROR(bf_writer.init());
+    for (auto& bf : bfs) {
+        Slice data(bf->data(), bf->size());
+        RETURN_IF_ERROR(bf_writer.add(&data));
+    }
+    return bf_writer.finish(meta);
+}
+
 // Builder for bloom filter. In starrocks, bloom filter index is used in
 // high cardinality key columns and none-agg value columns for high selectivity and storage
 // efficiency.
@@ -149,21 +168,7 @@ public:
         BloomFilterIndexPB* meta = index_meta->mutable_bloom_filter_index();
         meta->set_hash_strategy(_bf_options.strategy);
         meta->set_algorithm(BLOCK_BLOOM_FILTER);
-
-        // write bloom filters
-        TypeInfoPtr bf_typeinfo = get_type_info(TYPE_VARCHAR);
-        IndexedColumnWriterOptions options;
-        options.write_ordinal_index = true;
-        options.write_value_index = false;
-        options.encoding = PLAIN_ENCODING;
-        IndexedColumnWriter bf_writer(options, bf_typeinfo, wfile);
-        RETURN_IF_ERROR(bf_writer.init());
-        for (auto& bf : _bfs) {
-            Slice data(bf->data(), bf->size());
-            bf_writer.add(&data);
-        }
-        RETURN_IF_ERROR(bf_writer.finish(meta->mutable_bloom_filter()));
-        return Status::OK();
+        return write_bloom_filters(wfile, _bfs, meta->mutable_bloom_filter());
     }
 
     uint64_t size() override {
@@ -183,6 +188,74 @@ private:
     std::vector<std::unique_ptr<BloomFilter>> _bfs;
 };
 
+// Builder for n-gram bloom filter of char/varchar columns. All the n-grams of the values
+// in a data page are added to the bloom filter of the page, the page can be skipped by
+// `LIKE '%pattern%'` if any n-gram of the pattern is absent from the bloom filter.
+template <LogicalType field_type>
+class NGramBloomFilterIndexWriter : public BloomFilterIndexWriter {
+public:
+    explicit NGramBloomFilterIndexWriter(const BloomFilterOptions& bf_options) : _bf_options(bf_options) {
+        DCHECK_GT(_bf_options.gram_size, 0);
+    }
+
+    ~NGramBloomFilterIndexWriter() override = default;
+
+    void add_values(const void* values, size_t count) override {
+        const auto* v = (const Slice*)values;
+        const size_t n = _bf_options.gram_size;
+        for (size_t i = 0; i < count; ++i) {
+            Slice s = unaligned_load<Slice>(v + i);
+            if constexpr (field_type == TYPE_CHAR) {
+                // CHAR values are padded with zeros
+                s.size = strnlen(s.data, s.size);
+            }
+            for (size_t pos = 0; pos + n <= s.size; ++pos) {
+                uint64_t hash_code;
+                murmur_hash3_x64_64(s.data + pos, n, BloomFilter::DEFAULT_SEED, &hash_code);
+                _hashes.insert(hash_code);
+            }
+        }
+    }
+
+    void add_nulls(uint32_t count) override { _has_null |= (count > 0); }
+
+    Status flush() override {
+        std::unique_ptr<BloomFilter> bf;
+        RETURN_IF_ERROR(BloomFilter::create(BLOCK_BLOOM_FILTER, &bf));
+        RETURN_IF_ERROR(bf->init(_hashes.size(), _bf_options.fpp, _bf_options.strategy));
+        bf->set_has_null(_has_null);
+        for (uint64_t hash_code : _hashes) {
+            bf->add_hash(hash_code);
+        }
+        _bf_buffer_size += bf->size();
+        _bfs.push_back(std::move(bf));
+        _hashes.clear();
+        return Status::OK();
+    }
+
+    Status finish(WritableFile* wfile, ColumnIndexMetaPB* index_meta) override {
+        if (!_hashes.empty()) {
+            RETURN_IF_ERROR(flush());
+        }
+        index_meta->set_type(NGRAM_BLOOM_FILTER_INDEX);
+        BloomFilterIndexPB* meta = index_meta->mutable_ngram_bloom_filter_index();
+        meta->set_hash_strategy(_bf_options.strategy);
+        meta->set_algorithm(BLOCK_BLOOM_FILTER);
+        meta->set_gram_size(_bf_options.gram_size);
+        return write_bloom_filters(wfile, _bfs, meta->mutable_bloom_filter());
+    }
+
+    uint64_t size() override { return _bf_buffer_size + _hashes.size() * sizeof(uint64_t); }
+
+private:
+    BloomFilterOptions _bf_options;
+    bool _has_null{false};
+    uint64_t _bf_buffer_size{0};
+    // distinct hash codes of the n-grams in current page
+    phmap::flat_hash_set<uint64_t> _hashes;
+    std::vector<std::unique_ptr<BloomFilter>> _bfs;
+};
+
 } // namespace
 
 struct BloomFilterBuilderFunctor {
@@ -200,4 +273,21 @@ Status BloomFilterIndexWriter::create(const BloomFilterOptions& bf_options, cons
     return field_type_dispatch_bloomfilter(typeinfo->type(), BloomFilterBuilderFunctor(), res, bf_options, typeinfo);
 }
 
+Status BloomFilterIndexWriter::create_ngram(const BloomFilterOptions& bf_options, const TypeInfoPtr& typeinfo,
+                                            std::unique_ptr<BloomFilterIndexWriter>* res) {
+    if (bf_options.gram_size == 0) {
+        return Status::InvalidArgument("gram size of n-gram bloom filter must be positive");
+    }
+    switch (typeinfo->type()) {
+    case TYPE_CHAR:
+        *res = std::make_unique<NGramBloomFilterIndexWriter<TYPE_CHAR>>(bf_options);
+        return Status::OK();
+    case TYPE_VARCHAR:
+        *res = std::make_unique<NGramBloomFilterIndexWriter<TYPE_VARCHAR>>(bf_options);
+        return Status::OK();
+    default:
+        return Status::NotSupported("n-gram bloom filter index only supports char/varchar");
+    }
+}
+
 } // namespace starrocks
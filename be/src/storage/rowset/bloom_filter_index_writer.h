@@ -54,6 +54,10 @@ public:
     static Status create(const BloomFilterOptions& bf_options, const TypeInfoPtr& typeinfo,
                          std::unique_ptr<BloomFilterIndexWriter>* res);
 
+    // Create the writer of the n-gram bloom filter index, only char/varchar is supported.
+    static Status create_ngram(const BloomFilterOptions& bf_options, const TypeInfoPtr& typeinfo,
+                               std::unique_ptr<BloomFilterIndexWriter>* res);
+
     BloomFilterIndexWriter() = default;
     virtual ~BloomFilterIndexWriter() = default;
 
@@ -20,6 +20,7 @@
 #include "fmt/core.h"
 #include "gutil/casts.h"
 #include "storage/rowset/dictcode_column_iterator.h"
+#include "storage/rowset/shared_dictionary.h"
 
 namespace starrocks {
 Status ColumnDecoder::encode_to_global_id(Column* datas, Column* codes) {
@@ -70,8 +71,18 @@ void ColumnDecoder::check_global_dict() {
     if (_global_dict && _all_page_dict_encoded) {
         std::vector<int16_t> code_convert_map;
         auto* scalar_iter = down_cast<ScalarColumnIterator*>(_iter);
-        Status st = GlobalDictCodeColumnIterator::build_code_convert_map(scalar_iter, _global_dict, &code_convert_map);
+        uint64_t shared_dict_id = _shared_dict_code_maps != nullptr ? scalar_iter->shared_dict_id() : 0;
+        size_t num_known_codes = 0;
+        if (shared_dict_id != 0) {
+            num_known_codes =
+                    _shared_dict_code_maps->get(_cid, shared_dict_id, scalar_iter->dict_size(), &code_convert_map);
+        }
+        Status st = GlobalDictCodeColumnIterator::build_code_convert_map(scalar_iter, _global_dict, &code_convert_map,
+                                                                         num_known_codes);
         if (st.ok()) {
+            if (shared_dict_id != 0) {
+                _shared_dict_code_maps->put(_cid, shared_dict_id, code_convert_map);
+            }
             _code_convert_map = std::move(code_convert_map);
         } else {
             LOG(INFO) << st.to_string() << " will force the use of the global dictionary encoding";
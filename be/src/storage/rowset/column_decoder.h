@@ -23,6 +23,8 @@
 
 namespace starrocks {
 
+class SharedDictCodeConvertMaps;
+
 // To handle DictDecode
 class ColumnDecoder {
 public:
@@ -42,6 +44,11 @@ public:
 
     void set_all_page_dict_encoded(bool all_page_dict_encoded) { _all_page_dict_encoded = all_page_dict_encoded; }
     void set_global_dict(GlobalDictMap* global_dict) { _global_dict = global_dict; }
+    // reuse the code convert maps built by the other segments sharing the dictionary
+    void set_shared_dict_code_maps(SharedDictCodeConvertMaps* maps, ColumnId cid) {
+        _shared_dict_code_maps = maps;
+        _cid = cid;
+    }
     // check global dict is superset of local dict
     void check_global_dict();
 
@@ -58,6 +65,8 @@ private:
     std::optional<std::vector<int16_t>> _code_convert_map;
     ColumnIterator* _iter = nullptr;
     GlobalDictMap* _global_dict = nullptr;
+    SharedDictCodeConvertMaps* _shared_dict_code_maps = nullptr;
+    ColumnId _cid = 0;
     bool _all_page_dict_encoded = false;
 };
 
@@ -69,6 +69,10 @@ struct ColumnIteratorOptions {
 
     ReaderType reader_type = READER_QUERY;
     int chunk_size = DEFAULT_CHUNK_SIZE;
+
+    // For ARRAY and MAP columns, only the null flags and the lengths are read, the elements are filled with
+    // default values without being decoded. Used when only the lengths are needed, e.g. array_length(c).
+    bool lengths_only = false;
 };
 
 // Base iterator to read one column data
@@ -99,6 +103,15 @@ public:
 
     virtual ordinal_t get_current_ordinal() const = 0;
 
+    // Evaluate |pred| on the encoded pages of the rows in |range| without reading them into a column,
+    // selection[i] is set to 1 if the i-th row of |range| is not null and matches |pred|, and 0 otherwise.
+    // The iterator must be seeked before the next read after this call.
+    // Return NotSupported if any page in |range| can't evaluate |pred| on its encoded data.
+    virtual Status evaluate_on_encoded_pages(const ColumnPredicate& pred, const SparseRange& range,
+                                             uint8_t* selection) {
+        return Status::NotSupported("evaluate_on_encoded_pages() not supported");
+    }
+
     /// for vectorized engine
     virtual Status get_row_ranges_by_zone_map(const std::vector<const ColumnPredicate*>& predicates,
                                               const ColumnPredicate* del_predicate, SparseRange* row_ranges) = 0;
@@ -108,6 +121,13 @@ public:
         return Status::OK();
     }
 
+    // Get the row ranges in which all the rows satisfy |predicates| according to the zone map,
+    // |row_ranges| is left empty if it's unknown.
+    virtual Status get_all_match_row_ranges_by_zone_map(const std::vector<const ColumnPredicate*>& predicates,
+                                                        SparseRange* row_ranges) {
+        return Status::OK();
+    }
+
     // return true iff all data pages of this column are encoded as dictionary encoding.
     // NOTE: the ColumnIterator must have been initialized with `check_dict_encoding`,
     // otherwise this method will always return false.
@@ -50,6 +50,7 @@
 #include "storage/rowset/bloom_filter.h"
 #include "storage/rowset/bloom_filter_index_reader.h"
 #include "storage/rowset/encoding_info.h"
+#include "storage/rowset/json_column_iterator.h"
 #include "storage/rowset/map_column_iterator.h"
 #include "storage/rowset/page_handle.h"
 #include "storage/rowset/page_io.h"
@@ -94,11 +95,21 @@ ColumnReader::~ColumnReader() {
                                  _bitmap_index_meta->SpaceUsedLong());
         _bitmap_index_meta.reset(nullptr);
     }
+    if (_inverted_index_meta != nullptr) {
+        MEM_TRACKER_SAFE_RELEASE(ExecEnv::GetInstance()->bitmap_index_mem_tracker(),
+                                 _inverted_index_meta->SpaceUsedLong());
+        _inverted_index_meta.reset(nullptr);
+    }
     if (_bloom_filter_index_meta != nullptr) {
         MEM_TRACKER_SAFE_RELEASE(ExecEnv::GetInstance()->bloom_filter_index_mem_tracker(),
                                  _bloom_filter_index_meta->SpaceUsedLong());
         _bloom_filter_index_meta.reset(nullptr);
     }
+    if (_ngram_bloom_filter_index_meta != nullptr) {
+        MEM_TRACKER_SAFE_RELEASE(ExecEnv::GetInstance()->bloom_filter_index_mem_tracker(),
+                                 _ngram_bloom_filter_index_meta->SpaceUsedLong());
+        _ngram_bloom_filter_index_meta.reset(nullptr);
+    }
     MEM_TRACKER_SAFE_RELEASE(ExecEnv::GetInstance()->column_metadata_mem_tracker(), sizeof(ColumnReader));
 }
 
@@ -106,6 +117,7 @@ Status ColumnReader::_init(ColumnMetaPB* meta) {
     _column_type = static_cast<LogicalType>(meta->type());
     _dict_page_pointer = PagePointer(meta->dict_page());
     _total_mem_footprint = meta->total_mem_footprint();
+    _shared_dict_id = meta->shared_dict_id();
 
     if (meta->is_nullable()) _flags |= kIsNullableMask;
     if (meta->has_all_dict_encoded()) _flags |= kHasAllDictEncodedMask;
@@ -114,11 +126,30 @@ Status ColumnReader::_init(ColumnMetaPB* meta) {
     if (_column_type == TYPE_JSON && meta->has_json_meta()) {
         // TODO(mofei) store format_version in ColumnReader
         const JsonMetaPB& json_meta = meta->json_meta();
-        CHECK_EQ(kJsonMetaDefaultFormatVersion, json_meta.format_version()) << "Only format_version=1 is supported";
+        if (json_meta.format_version() == kJsonMetaFlatFormatVersion) {
+            if (json_meta.flat_paths_size() != meta->children_columns_size()) {
+                return Status::Corruption(
+                        fmt::format("Bad file {}: mismatched flat json fields of column {}", file_name(),
+                                    meta->column_id()));
+            }
+            _sub_readers = std::make_unique<SubReaderList>();
+            for (int i = 0; i < meta->children_columns_size(); ++i) {
+                ASSIGN_OR_RETURN(auto reader, ColumnReader::create(meta->mutable_children_columns(i), _segment));
+                _sub_readers->emplace_back(std::move(reader));
+            }
+            _json_meta = std::make_unique<JsonMetaPB>(json_meta);
+        } else {
+            CHECK_EQ(kJsonMetaDefaultFormatVersion, json_meta.format_version())
+                    << "Only format_version=1 and 2 are supported";
+        }
     }
     if (is_scalar_field_type(delegate_type(_column_type))) {
         RETURN_IF_ERROR(EncodingInfo::get(delegate_type(_column_type), meta->encoding(), &_encoding_info));
         RETURN_IF_ERROR(get_block_compression_codec(meta->compression(), &_compress_codec));
+        if (meta->has_compression_dict()) {
+            ASSIGN_OR_RETURN(_dict_compress_codec, new_zstd_dict_codec(meta->compression_dict()));
+            _compress_codec = _dict_compress_codec.get();
+        }
 
         for (int i = 0; i < meta->indexes_size(); i++) {
             auto* index_meta = meta->mutable_indexes(i);
@@ -146,12 +177,29 @@ Status ColumnReader::_init(ColumnMetaPB* meta) {
                                          _bitmap_index_meta->SpaceUsedLong());
                 _bitmap_index = std::make_unique<BitmapIndexReader>();
                 break;
+            case INVERTED_INDEX:
+                _inverted_index_meta.reset(index_meta->release_inverted_index());
+                MEM_TRACKER_SAFE_CONSUME(ExecEnv::GetInstance()->bitmap_index_mem_tracker(),
+                                         _inverted_index_meta->SpaceUsedLong());
+                _inverted_index = std::make_unique<InvertedIndexReader>(_inverted_index_meta->parser());
+                break;
             case BLOOM_FILTER_INDEX:
                 _bloom_filter_index_meta.reset(index_meta->release_bloom_filter_index());
                 MEM_TRACKER_SAFE_CONSUME(ExecEnv::GetInstance()->bloom_filter_index_mem_tracker(),
                                          _bloom_filter_index_meta->SpaceUsedLong());
                 _bloom_filter_index = std::make_unique<BloomFilterIndexReader>();
                 break;
+            case NGRAM_BLOOM_FILTER_INDEX:
+                _ngram_bloom_filter_index_meta.reset(index_meta->release_ngram_bloom_filter_index());
+                _ngram_gram_size = _ngram_bloom_filter_index_meta->gram_size();
+                if (_ngram_gram_size == 0) {
+                    return Status::Corruption(
+                            fmt::format("Bad file {}: invalid gram size of n-gram bloom filter", file_name()));
+                }
+                MEM_TRACKER_SAFE_CONSUME(ExecEnv::GetInstance()->bloom_filter_index_mem_tracker(),
+                                         _ngram_bloom_filter_index_meta->SpaceUsedLong());
+                _ngram_bloom_filter_index = std::make_unique<BloomFilterIndexReader>();
+                break;
             case UNKNOWN_INDEX_TYPE:
                 return Status::Corruption(fmt::format("Bad file {}: unknown index type", file_name()));
             }
@@ -268,6 +316,11 @@ Status ColumnReader::new_bitmap_index_iterator(BitmapIndexIterator** iterator) {
     return Status::OK();
 }
 
+Status ColumnReader::new_inverted_index_iterator(std::unique_ptr<InvertedIndexIterator>* iterator) {
+    RETURN_IF_ERROR(_load_inverted_index());
+    return _inverted_index->new_iterator(iterator);
+}
+
 Status ColumnReader::read_page(const ColumnIteratorOptions& iter_opts, const PagePointer& pp, PageHandle* handle,
                                Slice* page_body, PageFooterPB* footer) {
     iter_opts.sanity_check();
@@ -310,9 +363,42 @@ Status ColumnReader::_parse_zone_map(const ZoneMapPB& zm, ZoneMapDetail* detail)
 // prerequisite: at least one predicate in |predicates| support bloom filter.
 Status ColumnReader::bloom_filter(const std::vector<const ColumnPredicate*>& predicates, SparseRange* row_ranges) {
     RETURN_IF_ERROR(_load_bloom_filter_index());
+    return _bloom_filter_pages(
+            _bloom_filter_index.get(),
+            [&](const BloomFilter* bf) {
+                for (const auto* pred : predicates) {
+                    if (pred->support_bloom_filter() && pred->bloom_filter(bf)) {
+                        return true;
+                    }
+                }
+                return false;
+            },
+            row_ranges);
+}
+
+// prerequisite: at least one predicate in |predicates| support n-gram bloom filter.
+Status ColumnReader::ngram_bloom_filter(const std::vector<const ColumnPredicate*>& predicates,
+                                        SparseRange* row_ranges) {
+    RETURN_IF_ERROR(_load_ngram_bloom_filter_index());
+    return _bloom_filter_pages(
+            _ngram_bloom_filter_index.get(),
+            [&](const BloomFilter* bf) {
+                for (const auto* pred : predicates) {
+                    if (pred->support_ngram_bloom_filter() && !pred->ngram_bloom_filter(bf, _ngram_gram_size)) {
+                        return false;
+                    }
+                }
+                return true;
+            },
+            row_ranges);
+}
+
+Status ColumnReader::_bloom_filter_pages(BloomFilterIndexReader* bf_index,
+                                         const std::function<bool(const BloomFilter*)>& page_filter,
+                                         SparseRange* row_ranges) {
     SparseRange bf_row_ranges;
     std::unique_ptr<BloomFilterIndexIterator> bf_iter;
-    RETURN_IF_ERROR(_bloom_filter_index->new_iterator(&bf_iter));
+    RETURN_IF_ERROR(bf_index->new_iterator(&bf_iter));
     size_t range_size = row_ranges->size();
     // get covered page ids
     std::set<int32_t> page_ids;
@@ -329,11 +415,8 @@ Status ColumnReader::bloom_filter(const std::vector<const ColumnPredicate*>& pre
     for (const auto& pid : page_ids) {
         std::unique_ptr<BloomFilter> bf;
         RETURN_IF_ERROR(bf_iter->read_bloom_filter(pid, &bf));
-        for (const auto* pred : predicates) {
-            if (pred->support_bloom_filter() && pred->bloom_filter(bf.get())) {
-                bf_row_ranges.add(
-                        Range(_ordinal_index->get_first_ordinal(pid), _ordinal_index->get_last_ordinal(pid) + 1));
-            }
+        if (page_filter(bf.get())) {
+            bf_row_ranges.add(Range(_ordinal_index->get_first_ordinal(pid), _ordinal_index->get_last_ordinal(pid) + 1));
         }
     }
     *row_ranges = row_ranges->intersection(bf_row_ranges);
@@ -393,6 +476,22 @@ Status ColumnReader::_load_bitmap_index() {
     return Status::OK();
 }
 
+Status ColumnReader::_load_inverted_index() {
+    if (_inverted_index == nullptr || _inverted_index->loaded()) return Status::OK();
+    SCOPED_THREAD_LOCAL_CHECK_MEM_LIMIT_SETTER(false);
+    auto fs = file_system();
+    auto meta = _inverted_index_meta.get();
+    auto use_page_cache = !config::disable_storage_page_cache;
+    auto kept_in_memory = keep_in_memory();
+    ASSIGN_OR_RETURN(auto first_load, _inverted_index->load(fs, file_name(), *meta, use_page_cache, kept_in_memory));
+    if (UNLIKELY(first_load)) {
+        MEM_TRACKER_SAFE_RELEASE(ExecEnv::GetInstance()->bitmap_index_mem_tracker(),
+                                 _inverted_index_meta->SpaceUsedLong());
+        _inverted_index_meta.reset();
+    }
+    return Status::OK();
+}
+
 Status ColumnReader::_load_bloom_filter_index() {
     if (_bloom_filter_index == nullptr || _bloom_filter_index->loaded()) return Status::OK();
     SCOPED_THREAD_LOCAL_CHECK_MEM_LIMIT_SETTER(false);
@@ -410,6 +509,23 @@ Status ColumnReader::_load_bloom_filter_index() {
     return Status::OK();
 }
 
+Status ColumnReader::_load_ngram_bloom_filter_index() {
+    if (_ngram_bloom_filter_index == nullptr || _ngram_bloom_filter_index->loaded()) return Status::OK();
+    SCOPED_THREAD_LOCAL_CHECK_MEM_LIMIT_SETTER(false);
+    auto fs = file_system();
+    auto meta = _ngram_bloom_filter_index_meta.get();
+    auto use_page_cache = !config::disable_storage_page_cache;
+    auto kept_in_memory = keep_in_memory();
+    ASSIGN_OR_RETURN(auto first_load,
+                     _ngram_bloom_filter_index->load(fs, file_name(), *meta, use_page_cache, kept_in_memory));
+    if (UNLIKELY(first_load)) {
+        MEM_TRACKER_SAFE_RELEASE(ExecEnv::GetInstance()->bloom_filter_index_mem_tracker(),
+                                 _ngram_bloom_filter_index_meta->SpaceUsedLong());
+        _ngram_bloom_filter_index_meta.reset();
+    }
+    return Status::OK();
+}
+
 Status ColumnReader::seek_to_first(OrdinalPageIndexIterator* iter) {
     *iter = _ordinal_index->begin();
     if (!iter->valid()) {
@@ -466,6 +582,23 @@ Status ColumnReader::_zone_map_filter(const std::vector<const ColumnPredicate*>&
     return Status::OK();
 }
 
+Status ColumnReader::zone_map_all_match(const std::vector<const ColumnPredicate*>& predicates,
+                                        SparseRange* row_ranges) {
+    RETURN_IF_ERROR(_load_zonemap_index());
+    const std::vector<ZoneMapPB>& zone_maps = _zonemap_index->page_zone_maps();
+    int32_t page_size = _zonemap_index->num_pages();
+    std::vector<uint32_t> page_indexes;
+    for (int32_t i = 0; i < page_size; ++i) {
+        ZoneMapDetail detail;
+        _parse_zone_map(zone_maps[i], &detail);
+        auto all_match = [&](const ColumnPredicate* pred) { return pred->zone_map_all_match(detail); };
+        if (std::all_of(predicates.begin(), predicates.end(), all_match)) {
+            page_indexes.emplace_back(i);
+        }
+    }
+    return _calculate_row_ranges(page_indexes, row_ranges);
+}
+
 bool ColumnReader::segment_zone_map_filter(const std::vector<const ColumnPredicate*>& predicates) const {
     if (_segment_zone_map == nullptr) {
         return true;
@@ -476,8 +609,41 @@ bool ColumnReader::segment_zone_map_filter(const std::vector<const ColumnPredica
     return std::all_of(predicates.begin(), predicates.end(), filter);
 }
 
+Status ColumnReader::segment_zone_map_detail(ZoneMapDetail* detail) const {
+    if (_segment_zone_map == nullptr) {
+        return Status::NotFound("no segment zone map");
+    }
+    return _parse_zone_map(*_segment_zone_map, detail);
+}
+
+StatusOr<std::unique_ptr<ColumnIterator>> ColumnReader::new_flat_json_field_iterator(const std::string& path) {
+    if (_json_meta == nullptr) {
+        return Status::NotFound("not a flat json column");
+    }
+    for (int i = 0; i < _json_meta->flat_paths_size(); ++i) {
+        if (_json_meta->flat_paths(i) == path) {
+            if (i >= _json_meta->flat_path_complete_size() || !_json_meta->flat_path_complete(i)) {
+                break;
+            }
+            return (*_sub_readers)[i]->new_iterator();
+        }
+    }
+    return Status::NotFound(fmt::format("json field {} is not extracted", path));
+}
+
 StatusOr<std::unique_ptr<ColumnIterator>> ColumnReader::new_iterator() {
-    if (is_scalar_field_type(delegate_type(_column_type))) {
+    if (_column_type == TYPE_JSON && _json_meta != nullptr) {
+        std::vector<std::unique_ptr<ColumnIterator>> flat_iters;
+        std::vector<LogicalType> flat_types;
+        for (auto& reader : *_sub_readers) {
+            ASSIGN_OR_RETURN(auto iter, reader->new_iterator());
+            flat_iters.emplace_back(std::move(iter));
+            flat_types.emplace_back(reader->column_type());
+        }
+        std::vector<std::string> flat_paths(_json_meta->flat_paths().begin(), _json_meta->flat_paths().end());
+        return create_flat_json_iter(std::make_unique<ScalarColumnIterator>(this), std::move(flat_iters),
+                                     std::move(flat_paths), std::move(flat_types));
+    } else if (is_scalar_field_type(delegate_type(_column_type))) {
         return std::make_unique<ScalarColumnIterator>(this);
     } else if (_column_type == LogicalType::TYPE_ARRAY) {
         size_t col = 0;
@@ -515,7 +681,7 @@ StatusOr<std::unique_ptr<ColumnIterator>> ColumnReader::new_iterator() {
             ASSIGN_OR_RETURN(auto iter, (*_sub_readers)[i]->new_iterator());
             field_iters.emplace_back(std::move(iter));
         }
-        return create_struct_iter(std::move(null_iter), std::move(field_iters));
+        return create_struct_iter(std::move(null_iter), std::move(field_iters), num_rows());
     } else {
         return Status::NotSupported("unsupported type to create iterator: " + std::to_string(_column_type));
     }
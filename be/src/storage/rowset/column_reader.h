@@ -38,6 +38,7 @@
 #include <bitset>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <utility>
 
@@ -51,6 +52,7 @@
 #include "storage/rowset/bitmap_index_reader.h"
 #include "storage/rowset/bloom_filter_index_reader.h"
 #include "storage/rowset/common.h"
+#include "storage/rowset/inverted_index_reader.h"
 #include "storage/rowset/ordinal_page_index.h"
 #include "storage/rowset/page_handle.h"
 #include "storage/rowset/segment.h"
@@ -74,6 +76,7 @@ class EncodingInfo;
 class PageDecoder;
 class PagePointer;
 class ParsedPage;
+class JsonMetaPB;
 class ZoneMapIndexPB;
 class ZoneMapPB;
 class Segment;
@@ -104,10 +107,22 @@ public:
     // create a new column iterator. Caller should free the returned iterator after unused.
     StatusOr<std::unique_ptr<ColumnIterator>> new_iterator();
 
+    // Create the iterator of the children column in which all the values of the top-level field |path|
+    // of this flat JSON column are stored, in the type of the children column. The rows that do not have
+    // the field are null. Return NotFound if the field is not extracted, or some of its values are kept
+    // in the remainder, in which case the caller should read the whole JSON column instead.
+    StatusOr<std::unique_ptr<ColumnIterator>> new_flat_json_field_iterator(const std::string& path);
+
+    // Whether the frequent top-level fields of the JSON column are stored in typed children columns,
+    // see `JsonMetaPB`.
+    bool is_flat_json() const { return _json_meta != nullptr; }
+
     // Caller should free returned iterator after unused.
     // TODO: StatusOr<std::unique_ptr<ColumnIterator>> new_bitmap_index_iterator()
     Status new_bitmap_index_iterator(BitmapIndexIterator** iterator);
 
+    Status new_inverted_index_iterator(std::unique_ptr<InvertedIndexIterator>* iterator);
+
     // Seek to the first entry in the column.
     Status seek_to_first(OrdinalPageIndexIterator* iter);
     Status seek_at_or_before(ordinal_t ordinal, OrdinalPageIndexIterator* iter);
@@ -122,7 +137,9 @@ public:
 
     bool has_zone_map() const { return _zonemap_index != nullptr; }
     bool has_bitmap_index() const { return _bitmap_index != nullptr; }
+    bool has_inverted_index() const { return _inverted_index != nullptr; }
     bool has_bloom_filter_index() const { return _bloom_filter_index != nullptr; }
+    bool has_ngram_bloom_filter_index() const { return _ngram_bloom_filter_index != nullptr; }
 
     ZoneMapPB* segment_zone_map() const { return _segment_zone_map.get(); }
 
@@ -130,6 +147,8 @@ public:
     LogicalType column_type() const { return _column_type; }
     bool has_all_dict_encoded() const { return _flags & kHasAllDictEncodedMask; }
     bool all_dict_encoded() const { return _flags & kAllDictEncodedMask; }
+    // 0 if the dictionary is not shared with the other segments.
+    uint64_t shared_dict_id() const { return _shared_dict_id; }
 
     uint64_t total_mem_footprint() const { return _total_mem_footprint; }
 
@@ -140,14 +159,23 @@ public:
                            const ::starrocks::ColumnPredicate* del_predicate,
                            std::unordered_set<uint32_t>* del_partial_filtered_pages, SparseRange* row_ranges);
 
+    // page-level zone map filter, return the row ranges of the pages in which all the rows satisfy |p|.
+    Status zone_map_all_match(const std::vector<const ::starrocks::ColumnPredicate*>& p, SparseRange* row_ranges);
+
     // segment-level zone map filter.
     // Return false to filter out this segment.
     // same as `match_condition`, used by vector engine.
     bool segment_zone_map_filter(const std::vector<const ::starrocks::ColumnPredicate*>& predicates) const;
 
+    // Parse the segment-level zone map into |detail|, return NotFound if there's no zone map.
+    Status segment_zone_map_detail(ZoneMapDetail* detail) const;
+
     // prerequisite: at least one predicate in |predicates| support bloom filter.
     Status bloom_filter(const std::vector<const ::starrocks::ColumnPredicate*>& p, SparseRange* ranges);
 
+    // prerequisite: at least one predicate in |predicates| support n-gram bloom filter.
+    Status ngram_bloom_filter(const std::vector<const ::starrocks::ColumnPredicate*>& p, SparseRange* ranges);
+
     Status load_ordinal_index();
 
     uint32_t num_rows() const { return _segment->num_rows(); }
@@ -172,10 +200,16 @@ private:
     Status _load_zonemap_index();
     Status _load_ordinal_index();
     Status _load_bitmap_index();
+    Status _load_inverted_index();
     Status _load_bloom_filter_index();
+    Status _load_ngram_bloom_filter_index();
 
     Status _parse_zone_map(const ZoneMapPB& zm, ZoneMapDetail* detail) const;
 
+    // Narrow |row_ranges| to the pages whose bloom filter in |bf_index| passes |page_filter|.
+    Status _bloom_filter_pages(BloomFilterIndexReader* bf_index,
+                               const std::function<bool(const BloomFilter*)>& page_filter, SparseRange* row_ranges);
+
     Status _calculate_row_ranges(const std::vector<uint32_t>& page_indexes, SparseRange* row_ranges);
 
     Status _zone_map_filter(const std::vector<const ColumnPredicate*>& predicates, const ColumnPredicate* del_predicate,
@@ -187,25 +221,35 @@ private:
     LogicalType _column_type = TYPE_UNKNOWN;
     PagePointer _dict_page_pointer;
     uint64_t _total_mem_footprint = 0;
+    uint64_t _shared_dict_id = 0;
 
     // initialized in init(), used for create PageDecoder
     const EncodingInfo* _encoding_info = nullptr;
     const BlockCompressionCodec* _compress_codec = nullptr; // initialized in init()
+    // The codec with the compression dictionary of the column, if any.
+    std::unique_ptr<BlockCompressionCodec> _dict_compress_codec;
 
     std::unique_ptr<ZoneMapIndexPB> _zonemap_index_meta;
     std::unique_ptr<OrdinalIndexPB> _ordinal_index_meta;
     std::unique_ptr<BitmapIndexPB> _bitmap_index_meta;
+    std::unique_ptr<InvertedIndexPB> _inverted_index_meta;
     std::unique_ptr<BloomFilterIndexPB> _bloom_filter_index_meta;
+    std::unique_ptr<BloomFilterIndexPB> _ngram_bloom_filter_index_meta;
+    uint32_t _ngram_gram_size = 0;
 
     std::unique_ptr<ZoneMapIndexReader> _zonemap_index;
     std::unique_ptr<OrdinalIndexReader> _ordinal_index;
     std::unique_ptr<BitmapIndexReader> _bitmap_index;
+    std::unique_ptr<InvertedIndexReader> _inverted_index;
     std::unique_ptr<BloomFilterIndexReader> _bloom_filter_index;
+    std::unique_ptr<BloomFilterIndexReader> _ngram_bloom_filter_index;
 
     std::unique_ptr<ZoneMapPB> _segment_zone_map;
 
     using SubReaderList = std::vector<std::unique_ptr<ColumnReader>>;
     std::unique_ptr<SubReaderList> _sub_readers;
+    // only set for the flat JSON column, the flat fields are read by |_sub_readers|.
+    std::unique_ptr<JsonMetaPB> _json_meta;
 
     // Pointer to its father segment, as the column reader
     // is never released before the end of the parent's life cycle,
@@ -44,6 +44,7 @@
 #include "common/logging.h"
 #include "fs/fs.h"
 #include "gutil/strings/substitute.h"
+#include "runtime/global_dict/config.h"
 #include "simd/simd.h"
 #include "storage/rowset/array_column_writer.h"
 #include "storage/rowset/bitmap_index_writer.h"
@@ -51,11 +52,15 @@
 #include "storage/rowset/bloom_filter.h"
 #include "storage/rowset/bloom_filter_index_writer.h"
 #include "storage/rowset/encoding_info.h"
+#include "storage/rowset/int_dict_page.h"
+#include "storage/rowset/inverted_index_writer.h"
+#include "storage/rowset/json_column_writer.h"
 #include "storage/rowset/map_column_writer.h"
 #include "storage/rowset/options.h"
 #include "storage/rowset/ordinal_page_index.h"
 #include "storage/rowset/page_builder.h"
 #include "storage/rowset/page_io.h"
+#include "storage/rowset/shared_dictionary.h"
 #include "storage/rowset/struct_column_writer.h"
 #include "storage/rowset/zone_map_index.h"
 #include "util/compression/block_compression.h"
@@ -254,6 +259,39 @@ private:
     ColumnPtr _buf_column = nullptr;
 };
 
+static bool is_int_dict_encoding_type(LogicalType type) {
+    switch (type) {
+    case TYPE_TINYINT:
+    case TYPE_SMALLINT:
+    case TYPE_INT:
+    case TYPE_BIGINT:
+    case TYPE_DATE:
+    case TYPE_DATETIME:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Use INT_DICT_ENCODING if the first |INT_DICT_SPECULATE_ROWS| rows has few distinct values.
+template <LogicalType Type>
+static EncodingTypePB speculate_int_encoding(const Column& column) {
+    static constexpr size_t INT_DICT_SPECULATE_ROWS = 65536;
+    using CppType = typename CppTypeTraits<Type>::CppType;
+    const Column* data_column =
+            column.is_nullable() ? down_cast<const NullableColumn&>(column).data_column().get() : &column;
+    const auto* values = reinterpret_cast<const CppType*>(data_column->raw_data());
+    size_t num_rows = std::min(data_column->size(), INT_DICT_SPECULATE_ROWS);
+    phmap::flat_hash_set<CppType, StdHash<CppType>> distinct_values;
+    for (size_t i = 0; i < num_rows; i++) {
+        distinct_values.insert(values[i]);
+        if (distinct_values.size() > INT_DICT_PAGE_MAX_DICT_SIZE) {
+            return DEFAULT_ENCODING;
+        }
+    }
+    return INT_DICT_ENCODING;
+}
+
 StatusOr<std::unique_ptr<ColumnWriter>> ColumnWriter::create(const ColumnWriterOptions& opts,
                                                              const TabletColumn* column, WritableFile* wfile) {
     TypeInfoPtr type_info = get_type_info(*column);
@@ -263,7 +301,16 @@ StatusOr<std::unique_ptr<ColumnWriter>> ColumnWriter::create(const ColumnWriterO
         str_opts.need_speculate_encoding = true;
         auto column_writer = std::make_unique<ScalarColumnWriter>(str_opts, type_info, wfile);
         return std::make_unique<StringColumnWriter>(str_opts, std::move(type_info), std::move(column_writer));
+    } else if (column->type() == TYPE_JSON) {
+        return create_json_column_writer(opts, std::move(type_info), wfile);
     } else if (is_scalar_field_type(delegate_type(column->type()))) {
+        if (config::enable_int_dict_encoding && opts.meta->encoding() == DEFAULT_ENCODING &&
+            is_int_dict_encoding_type(delegate_type(column->type()))) {
+            // The encoding is speculated from the first appended column.
+            ColumnWriterOptions int_opts = opts;
+            int_opts.need_speculate_encoding = true;
+            return std::make_unique<ScalarColumnWriter>(int_opts, std::move(type_info), wfile);
+        }
         return std::make_unique<ScalarColumnWriter>(opts, std::move(type_info), wfile);
     } else {
         switch (column->type()) {
@@ -310,6 +357,7 @@ ScalarColumnWriter::~ScalarColumnWriter() {
 
 Status ScalarColumnWriter::init() {
     RETURN_IF_ERROR(get_block_compression_codec(_opts.meta->compression(), &_compress_codec));
+    _collecting_dict_samples = config::enable_zstd_dict_compression && _opts.meta->compression() == ZSTD;
 
     if (!_opts.need_speculate_encoding) {
         set_encoding(_opts.meta->encoding());
@@ -333,10 +381,21 @@ Status ScalarColumnWriter::init() {
         _has_index_builder = true;
         RETURN_IF_ERROR(BitmapIndexWriter::create(_type_info, &_bitmap_index_builder));
     }
+    if (_opts.need_inverted_index && config::enable_inverted_index) {
+        _has_index_builder = true;
+        RETURN_IF_ERROR(InvertedIndexWriter::create(_type_info, SIMPLE_PARSER, &_inverted_index_builder));
+    }
     if (_opts.need_bloom_filter) {
         _has_index_builder = true;
         RETURN_IF_ERROR(BloomFilterIndexWriter::create(BloomFilterOptions(), _type_info, &_bloom_filter_index_builder));
     }
+    if (_opts.need_ngram_bloom_filter && config::ngram_bloom_filter_index_gram_size > 0) {
+        _has_index_builder = true;
+        BloomFilterOptions bf_options;
+        bf_options.gram_size = config::ngram_bloom_filter_index_gram_size;
+        RETURN_IF_ERROR(
+                BloomFilterIndexWriter::create_ngram(bf_options, _type_info, &_ngram_bloom_filter_index_builder));
+    }
     return Status::OK();
 }
 
@@ -357,13 +416,23 @@ uint64_t ScalarColumnWriter::estimate_buffer_size() {
     if (_bitmap_index_builder != nullptr) {
         size += _bitmap_index_builder->size();
     }
+    if (_inverted_index_builder != nullptr) {
+        size += _inverted_index_builder->size();
+    }
     if (_bloom_filter_index_builder != nullptr) {
         size += _bloom_filter_index_builder->size();
     }
+    if (_ngram_bloom_filter_index_builder != nullptr) {
+        size += _ngram_bloom_filter_index_builder->size();
+    }
     return size;
 }
 
 Status ScalarColumnWriter::finish() {
+    if (_page_builder == nullptr) {
+        // The encoding is not speculated since no row is appended.
+        RETURN_IF_ERROR(set_encoding(_opts.meta->encoding()));
+    }
     if (_encoding_info->encoding() == DICT_ENCODING && _opts.global_dict != nullptr) {
         _is_global_dict_valid = _page_builder->is_valid_global_dict(_opts.global_dict);
     } else {
@@ -376,6 +445,9 @@ Status ScalarColumnWriter::finish() {
 }
 
 Status ScalarColumnWriter::write_data() {
+    if (_collecting_dict_samples) {
+        RETURN_IF_ERROR(_compress_pending_pages());
+    }
     // dict will be load before data,
     // so write column dict first
     if (_encoding_info->encoding() == DICT_ENCODING) {
@@ -394,6 +466,9 @@ Status ScalarColumnWriter::write_data() {
         RETURN_IF_ERROR(PageIO::compress_and_write_page(_compress_codec, _opts.compression_min_space_saving, _wfile,
                                                         body, footer, &dict_pp));
         dict_pp.to_proto(_opts.meta->mutable_dict_page());
+        if (_opts.shared_dict != nullptr) {
+            _update_shared_dictionary();
+        }
     }
     _opts.meta->set_all_dict_encoded(_page_builder->all_dict_encoded());
 
@@ -429,10 +504,49 @@ inline Status ScalarColumnWriter::set_encoding(const EncodingTypePB& encoding) {
     // should store more concrete encoding type instead of DEFAULT_ENCODING
     // because the default encoding of a data type can be changed in the future
     DCHECK_NE(_opts.meta->encoding(), DEFAULT_ENCODING);
+    if (_encoding_info->encoding() == DICT_ENCODING && _opts.shared_dict != nullptr) {
+        _seed_shared_dictionary(page_builder);
+    }
     _page_builder.reset(page_builder);
     return Status::OK();
 }
 
+void ScalarColumnWriter::_seed_shared_dictionary(PageBuilder* page_builder) {
+    std::vector<std::string> words;
+    _shared_dict_id = _opts.shared_dict->snapshot(&words);
+    if (!page_builder->seed_dictionary(words)) {
+        // Start over with a new dictionary, this segment will be the first one sharing it.
+        _opts.shared_dict->reset();
+        _shared_dict_id = _opts.shared_dict->snapshot(&words);
+        if (!words.empty()) {
+            // The new dictionary has been extended by another segment meanwhile.
+            _shared_dict_id = 0;
+            words.clear();
+        }
+    }
+    _shared_dict_seeded_size = words.size();
+}
+
+void ScalarColumnWriter::_update_shared_dictionary() {
+    if (_shared_dict_id == 0) {
+        return;
+    }
+    if (!_page_builder->all_dict_encoded()) {
+        // The dictionary is full, do not let the next segment start with it.
+        _opts.shared_dict->reset();
+        return;
+    }
+    std::vector<std::string> words = _page_builder->dictionary_words();
+    if (words.size() > DICT_DECODE_MAX_SIZE) {
+        // Too many words for the low cardinality optimization, sharing the dictionary does not help.
+        _opts.shared_dict->reset();
+        return;
+    }
+    if (_opts.shared_dict->update(_shared_dict_id, _shared_dict_seeded_size, words)) {
+        _opts.meta->set_shared_dict_id(_shared_dict_id);
+    }
+}
+
 Status ScalarColumnWriter::write_ordinal_index() {
     return _ordinal_index_builder->finish(_wfile, _opts.meta->add_indexes());
 }
@@ -446,14 +560,20 @@ Status ScalarColumnWriter::write_zone_map() {
 
 Status ScalarColumnWriter::write_bitmap_index() {
     if (_bitmap_index_builder != nullptr) {
-        return _bitmap_index_builder->finish(_wfile, _opts.meta->add_indexes());
+        RETURN_IF_ERROR(_bitmap_index_builder->finish(_wfile, _opts.meta->add_indexes()));
+    }
+    if (_inverted_index_builder != nullptr) {
+        RETURN_IF_ERROR(_inverted_index_builder->finish(_wfile, _opts.meta->add_indexes()));
     }
     return Status::OK();
 }
 
 Status ScalarColumnWriter::write_bloom_filter_index() {
     if (_bloom_filter_index_builder != nullptr) {
-        return _bloom_filter_index_builder->finish(_wfile, _opts.meta->add_indexes());
+        RETURN_IF_ERROR(_bloom_filter_index_builder->finish(_wfile, _opts.meta->add_indexes()));
+    }
+    if (_ngram_bloom_filter_index_builder != nullptr) {
+        RETURN_IF_ERROR(_ngram_bloom_filter_index_builder->finish(_wfile, _opts.meta->add_indexes()));
     }
     return Status::OK();
 }
@@ -479,6 +599,10 @@ Status ScalarColumnWriter::finish_current_page() {
         RETURN_IF_ERROR(_bloom_filter_index_builder->flush());
     }
 
+    if (_ngram_bloom_filter_index_builder != nullptr) {
+        RETURN_IF_ERROR(_ngram_bloom_filter_index_builder->flush());
+    }
+
     // build data page body : encoded values + [nullmap]
     std::vector<Slice> body;
     faststring* encoded_values = _page_builder->finish();
@@ -518,8 +642,15 @@ Status ScalarColumnWriter::finish_current_page() {
     }
     // trying to compress page body
     faststring compressed_body;
-    RETURN_IF_ERROR(
-            PageIO::compress_page_body(_compress_codec, _opts.compression_min_space_saving, body, &compressed_body));
+    if (_collecting_dict_samples) {
+        // Kept uncompressed as a sample of the dictionary, and compressed after the dictionary is trained.
+        page->pending_compression = true;
+        _num_pending_pages++;
+        _pending_pages_size += page->footer.uncompressed_size();
+    } else {
+        RETURN_IF_ERROR(PageIO::compress_page_body(_compress_codec, _opts.compression_min_space_saving, body,
+                                                   &compressed_body));
+    }
     if (compressed_body.size() == 0) {
         // page body is uncompressed
         double space_saving =
@@ -560,10 +691,87 @@ Status ScalarColumnWriter::finish_current_page() {
     _page_builder->reset();
     _first_rowid = _next_rowid;
 
+    if (_collecting_dict_samples && _pending_pages_size >= config::zstd_dict_sample_size) {
+        RETURN_IF_ERROR(_compress_pending_pages());
+    }
+    return Status::OK();
+}
+
+Status ScalarColumnWriter::_compress_pending_pages() {
+    // ZDICT needs a few samples to train a useful dictionary.
+    static constexpr size_t kMinSamplePages = 8;
+    _collecting_dict_samples = false;
+    if (_num_pending_pages >= kMinSamplePages &&
+        _pending_pages_size <= _num_pending_pages * config::zstd_dict_max_page_size) {
+        std::vector<Slice> samples;
+        samples.reserve(_num_pending_pages);
+        for (Page* page = _pages.head; page != nullptr; page = page->next) {
+            if (page->pending_compression) {
+                samples.emplace_back(page->data[0].slice());
+            }
+        }
+        auto dict = train_zstd_dictionary(samples, config::zstd_dict_max_size);
+        if (dict.ok()) {
+            ASSIGN_OR_RETURN(_dict_compress_codec, new_zstd_dict_codec(*dict));
+            _compress_codec = _dict_compress_codec.get();
+            _opts.meta->set_compression_dict(std::move(*dict));
+        } else {
+            VLOG(2) << "Fail to train the compression dictionary of column " << _opts.meta->column_id() << ": "
+                    << dict.status();
+        }
+    }
+
+    for (Page* page = _pages.head; page != nullptr; page = page->next) {
+        if (!page->pending_compression) {
+            continue;
+        }
+        page->pending_compression = false;
+        std::vector<Slice> body;
+        size_t body_size = 0;
+        for (auto& data : page->data) {
+            body.emplace_back(data.slice());
+            body_size += data.slice().size;
+        }
+        faststring compressed_body;
+        RETURN_IF_ERROR(PageIO::compress_page_body(_compress_codec, _opts.compression_min_space_saving, body,
+                                                   &compressed_body));
+        if (compressed_body.size() > 0) {
+            _data_size = _data_size - body_size + compressed_body.size();
+            page->data.clear();
+            page->data.emplace_back(compressed_body.build());
+        }
+    }
+    _num_pending_pages = 0;
+    _pending_pages_size = 0;
     return Status::OK();
 }
 
+Status ScalarColumnWriter::_speculate_and_set_encoding(const Column& column) {
+    EncodingTypePB encoding = DEFAULT_ENCODING;
+    switch (type_info()->type()) {
+#define CASE_SPECULATE_INT_ENCODING(TYPE)                 \
+    case TYPE:                                            \
+        encoding = speculate_int_encoding<TYPE>(column); \
+        break;
+        CASE_SPECULATE_INT_ENCODING(TYPE_TINYINT)
+        CASE_SPECULATE_INT_ENCODING(TYPE_SMALLINT)
+        CASE_SPECULATE_INT_ENCODING(TYPE_INT)
+        CASE_SPECULATE_INT_ENCODING(TYPE_BIGINT)
+        CASE_SPECULATE_INT_ENCODING(TYPE_DATE)
+        CASE_SPECULATE_INT_ENCODING(TYPE_DATETIME)
+#undef CASE_SPECULATE_INT_ENCODING
+    default:
+        break;
+    }
+    return set_encoding(encoding);
+}
+
 Status ScalarColumnWriter::append(const Column& column) {
+    if (PREDICT_FALSE(_page_builder == nullptr)) {
+        // Only the integer columns reach here without encoding, the string columns
+        // are speculated by StringColumnWriter.
+        RETURN_IF_ERROR(_speculate_and_set_encoding(column));
+    }
     _total_mem_footprint += column.byte_size();
 
     const uint8_t* ptr = column.raw_data();
@@ -663,18 +871,24 @@ Status ScalarColumnWriter::append(const uint8_t* data, const uint8_t* null_flags
                 if (is_null) {
                     INDEX_ADD_NULLS(_zone_map_index_builder, run);
                     INDEX_ADD_NULLS(_bitmap_index_builder, run);
+                    INDEX_ADD_NULLS(_inverted_index_builder, run);
                     INDEX_ADD_NULLS(_bloom_filter_index_builder, run);
+                    INDEX_ADD_NULLS(_ngram_bloom_filter_index_builder, run);
                 } else {
                     INDEX_ADD_VALUES(_zone_map_index_builder, pdata, run);
                     INDEX_ADD_VALUES(_bitmap_index_builder, pdata, run);
+                    INDEX_ADD_VALUES(_inverted_index_builder, pdata, run);
                     INDEX_ADD_VALUES(_bloom_filter_index_builder, pdata, run);
+                    INDEX_ADD_VALUES(_ngram_bloom_filter_index_builder, pdata, run);
                 }
                 pdata += type_info()->size() * run;
             }
         } else {
             INDEX_ADD_VALUES(_zone_map_index_builder, data, num_written);
             INDEX_ADD_VALUES(_bitmap_index_builder, data, num_written);
+            INDEX_ADD_VALUES(_inverted_index_builder, data, num_written);
             INDEX_ADD_VALUES(_bloom_filter_index_builder, data, num_written);
+            INDEX_ADD_VALUES(_ngram_bloom_filter_index_builder, data, num_written);
         }
 
         _next_rowid += num_written;
@@ -753,7 +967,7 @@ inline EncodingTypePB StringColumnWriter::speculate_string_encoding(const Binary
             size_t hash = SliceHash()(bin_col.get_slice(i));
             hash_set.insert(hash);
             if (hash_set.size() > max_card) {
-                return PLAIN_ENCODING;
+                return config::enable_fsst_string_encoding ? FSST_ENCODING : PLAIN_ENCODING;
             }
         }
     }
@@ -52,6 +52,7 @@ namespace starrocks {
 
 class TypeInfo;
 class BlockCompressionCodec;
+class SharedDictionary;
 class WritableFile;
 
 class Column;
@@ -67,8 +68,14 @@ struct ColumnWriterOptions {
     // space saving = 1 - compressed_size / uncompressed_size
     double compression_min_space_saving = 0.1;
     bool need_zone_map = false;
+    // build zone maps for the scalar subfields of the nested columns, see `enable_nested_column_zone_map`.
+    bool need_subfield_zone_map = false;
     bool need_bitmap_index = false;
     bool need_bloom_filter = false;
+    // n-gram bloom filter index for char/varchar columns, see `ngram_bloom_filter_index_gram_size`.
+    bool need_ngram_bloom_filter = false;
+    // full-text inverted index for char/varchar columns, see `enable_inverted_index`.
+    bool need_inverted_index = false;
     // for char/varchar will speculate encoding in append
     // for others will decide encoding in init method
     bool need_speculate_encoding = false;
@@ -76,9 +83,14 @@ struct ColumnWriterOptions {
     // when column data is encoding by dict
     // if global_dict is not nullptr, will checkout whether global_dict can cover all data
     GlobalDictMap* global_dict = nullptr;
+
+    // if not nullptr, the dictionary of char/varchar column is shared with the other segments
+    // of the rowset, see `enable_shared_segment_dictionary`.
+    SharedDictionary* shared_dict = nullptr;
 };
 
 class BitmapIndexWriter;
+class InvertedIndexWriter;
 class EncodingInfo;
 class NullMapRLEBuilder;
 class NullFlagsBuilder;
@@ -188,6 +200,8 @@ private:
         std::vector<OwnedSlice> data;
         PageFooterPB footer;
         Page* next = nullptr;
+        // The page is kept uncompressed as a sample until the compression dictionary is trained.
+        bool pending_compression = false;
     };
 
     struct PageHead {
@@ -213,8 +227,21 @@ private:
 
     Status append(const uint8_t* data, const uint8_t* null_flags, size_t count, bool has_null);
 
+    // Choose the encoding of the integer column by the first appended column.
+    Status _speculate_and_set_encoding(const Column& column);
+
     Status _write_data_page(Page* page);
 
+    // Train the ZSTD dictionary from the pending pages if they are small enough, and compress them.
+    Status _compress_pending_pages();
+
+    // Seed the dictionary of |page_builder| with the shared dictionary.
+    void _seed_shared_dictionary(PageBuilder* page_builder);
+
+    // Extend the shared dictionary with the dictionary of this segment, and tag the column
+    // with the shared dictionary id if succeeded.
+    void _update_shared_dictionary();
+
     ColumnWriterOptions _opts;
     WritableFile* _wfile;
     uint32_t _curr_page_format;
@@ -227,6 +254,11 @@ private:
     ordinal_t _next_rowid = 0;
 
     const BlockCompressionCodec* _compress_codec = nullptr;
+    // Collecting the pages to train the ZSTD dictionary of this column.
+    bool _collecting_dict_samples = false;
+    size_t _num_pending_pages = 0;
+    size_t _pending_pages_size = 0;
+    std::unique_ptr<BlockCompressionCodec> _dict_compress_codec;
     const EncodingInfo* _encoding_info = nullptr;
 
     std::unique_ptr<PageBuilder> _page_builder;
@@ -241,7 +273,9 @@ private:
     std::unique_ptr<OrdinalIndexWriter> _ordinal_index_builder;
     std::unique_ptr<ZoneMapIndexWriter> _zone_map_index_builder;
     std::unique_ptr<BitmapIndexWriter> _bitmap_index_builder;
+    std::unique_ptr<InvertedIndexWriter> _inverted_index_builder;
     std::unique_ptr<BloomFilterIndexWriter> _bloom_filter_index_builder;
+    std::unique_ptr<BloomFilterIndexWriter> _ngram_bloom_filter_index_builder;
     // _zone_map_index_builder != NULL || _bitmap_index_builder != NULL || _bloom_filter_index_builder != NULL
     bool _has_index_builder = false;
     int64_t _element_ordinal = 0;
@@ -249,6 +283,10 @@ private:
 
     bool _is_global_dict_valid = true;
 
+    // The id and the size of the shared dictionary the dictionary is seeded with.
+    uint64_t _shared_dict_id = 0;
+    size_t _shared_dict_seeded_size = 0;
+
     uint64_t _total_mem_footprint = 0;
 };
 
@@ -62,25 +62,29 @@ Status GlobalDictCodeColumnIterator::decode_dict_codes(const Column& codes, Colu
 
 Status GlobalDictCodeColumnIterator::build_code_convert_map(ScalarColumnIterator* file_column_iter,
                                                             GlobalDictMap* global_dict,
-                                                            std::vector<int16_t>* code_convert_map) {
+                                                            std::vector<int16_t>* code_convert_map,
+                                                            int num_known_codes) {
     DCHECK(file_column_iter->all_page_dict_encoded());
 
     int dict_size = file_column_iter->dict_size();
+    DCHECK_LE(num_known_codes, dict_size);
+    // only decode the codes not known yet
+    int num_codes = dict_size - num_known_codes;
 
     auto column = BinaryColumn::create();
 
-    int dict_codes[dict_size];
-    for (int i = 0; i < dict_size; ++i) {
-        dict_codes[i] = i;
+    int dict_codes[num_codes];
+    for (int i = 0; i < num_codes; ++i) {
+        dict_codes[i] = num_known_codes + i;
     }
 
-    RETURN_IF_ERROR(file_column_iter->decode_dict_codes(dict_codes, dict_size, column.get()));
+    RETURN_IF_ERROR(file_column_iter->decode_dict_codes(dict_codes, num_codes, column.get()));
 
     code_convert_map->resize(dict_size + 2);
-    std::fill(code_convert_map->begin(), code_convert_map->end(), 0);
+    std::fill(code_convert_map->begin() + num_known_codes + 1, code_convert_map->end(), 0);
     auto* local_to_global = code_convert_map->data() + 1;
 
-    for (int i = 0; i < dict_size; ++i) {
+    for (int i = 0; i < num_codes; ++i) {
         auto slice = column->get_slice(i);
         auto res = global_dict->find(slice);
         if (res == global_dict->end()) {
@@ -139,8 +139,11 @@ public:
         return _col_iter->get_row_ranges_by_zone_map(predicates, del_predicate, row_ranges);
     }
 
+    // Build the map from the local dict codes to the global dict codes.
+    // The first |num_known_codes| codes of |code_convert_map| are already built and kept as they are,
+    // which happens when the dictionary is shared with another segment.
     static Status build_code_convert_map(ScalarColumnIterator* file_column_iter, GlobalDictMap* global_dict,
-                                         std::vector<int16_t>* code_convert_map);
+                                         std::vector<int16_t>* code_convert_map, int num_known_codes = 0);
 
 private:
     // create a new empty local dict column
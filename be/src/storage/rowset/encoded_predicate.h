@@ -0,0 +1,93 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Helpers to evaluate the comparison predicates on the values of encoded pages, without decoding
+// them into a column.
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "storage/column_predicate.h"
+#include "storage/type_traits.h"
+#include "types/logical_type.h"
+
+namespace starrocks {
+
+// Whether the predicates on the |Type| column can be evaluated on the encoded integers.
+template <LogicalType Type>
+inline constexpr bool is_encoded_predicate_type =
+        Type == TYPE_TINYINT || Type == TYPE_SMALLINT || Type == TYPE_INT || Type == TYPE_BIGINT ||
+        Type == TYPE_DATE || Type == TYPE_DATETIME || Type == TYPE_DECIMAL32 || Type == TYPE_DECIMAL64;
+
+// A comparison predicate in the form of a closed value range: a value matches if it is in
+// [lower, upper], or not in it if |negate| is true. The range is empty if lower > upper.
+template <typename T>
+struct EncodedValueRange {
+    static_assert(std::is_integral_v<T>);
+
+    T lower = std::numeric_limits<T>::min();
+    T upper = std::numeric_limits<T>::max();
+    bool negate = false;
+
+    uint8_t match(T v) const { return ((v >= lower) & (v <= upper)) ^ negate; }
+
+    // selection[i] = match(values[i]) for i in [0, n).
+    void evaluate(const T* values, size_t n, uint8_t* selection) const {
+        for (size_t i = 0; i < n; i++) {
+            selection[i] = match(values[i]);
+        }
+    }
+};
+
+// Convert |pred| into |*range|, return false if |pred| isn't a comparison on a |Type| column.
+template <LogicalType Type>
+bool to_encoded_value_range(const ColumnPredicate& pred, EncodedValueRange<typename TypeTraits<Type>::CppType>* range) {
+    using CppType = typename TypeTraits<Type>::CppType;
+    if (pred.is_expr_predicate() || pred.type_info()->type() != Type) {
+        return false;
+    }
+    constexpr CppType kMin = std::numeric_limits<CppType>::min();
+    constexpr CppType kMax = std::numeric_limits<CppType>::max();
+    const CppType value = pred.value().get<CppType>();
+    switch (pred.type()) {
+    case PredicateType::kEQ:
+        *range = {value, value, false};
+        return true;
+    case PredicateType::kNE:
+        *range = {value, value, true};
+        return true;
+    case PredicateType::kLT:
+        *range = value == kMin ? EncodedValueRange<CppType>{kMax, kMin, false}
+                               : EncodedValueRange<CppType>{kMin, static_cast<CppType>(value - 1), false};
+        return true;
+    case PredicateType::kLE:
+        *range = {kMin, value, false};
+        return true;
+    case PredicateType::kGT:
+        *range = value == kMax ? EncodedValueRange<CppType>{kMax, kMin, false}
+                               : EncodedValueRange<CppType>{static_cast<CppType>(value + 1), kMax, false};
+        return true;
+    case PredicateType::kGE:
+        *range = {value, kMax, false};
+        return true;
+    default:
+        return false;
+    }
+}
+
+} // namespace starrocks
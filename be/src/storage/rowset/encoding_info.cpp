@@ -36,13 +36,17 @@
 
 #include <type_traits>
 
+#include "common/config.h"
 #include "gutil/strings/substitute.h"
 #include "storage/olap_common.h"
+#include "storage/rowset/alp_page.h"
 #include "storage/rowset/binary_dict_page.h"
+#include "storage/rowset/binary_fsst_page.h"
 #include "storage/rowset/binary_plain_page.h"
 #include "storage/rowset/binary_prefix_page.h"
 #include "storage/rowset/bitshuffle_page.h"
 #include "storage/rowset/frame_of_reference_page.h"
+#include "storage/rowset/int_dict_page.h"
 #include "storage/rowset/plain_page.h"
 #include "storage/rowset/rle_page.h"
 
@@ -143,6 +147,44 @@ struct TypeEncodingTraits<type, FOR_ENCODING, CppType,
     }
 };
 
+template <LogicalType type, typename CppType>
+struct TypeEncodingTraits<type, ALP_ENCODING, CppType,
+                          typename std::enable_if<std::is_floating_point<CppType>::value>::type> {
+    static Status create_page_builder(const PageBuilderOptions& opts, PageBuilder** builder) {
+        *builder = new AlpPageBuilder<type>(opts);
+        return Status::OK();
+    }
+    static Status create_page_decoder(const Slice& data, const PageDecoderOptions& opts, PageDecoder** decoder) {
+        *decoder = new AlpPageDecoder<type>(data, opts);
+        return Status::OK();
+    }
+};
+
+template <LogicalType type, typename CppType>
+struct TypeEncodingTraits<type, INT_DICT_ENCODING, CppType,
+                          typename std::enable_if<std::is_integral<CppType>::value>::type> {
+    static Status create_page_builder(const PageBuilderOptions& opts, PageBuilder** builder) {
+        *builder = new IntDictPageBuilder<type>(opts);
+        return Status::OK();
+    }
+    static Status create_page_decoder(const Slice& data, const PageDecoderOptions& opts, PageDecoder** decoder) {
+        *decoder = new IntDictPageDecoder<type>(data, opts);
+        return Status::OK();
+    }
+};
+
+template <LogicalType type>
+struct TypeEncodingTraits<type, FSST_ENCODING, Slice> {
+    static Status create_page_builder(const PageBuilderOptions& opts, PageBuilder** builder) {
+        *builder = new BinaryFsstPageBuilder(opts);
+        return Status::OK();
+    }
+    static Status create_page_decoder(const Slice& data, const PageDecoderOptions& opts, PageDecoder** decoder) {
+        *decoder = new BinaryFsstPageDecoder<type>(data, opts);
+        return Status::OK();
+    }
+};
+
 template <LogicalType type>
 struct TypeEncodingTraits<type, PREFIX_ENCODING, Slice> {
     static Status create_page_builder(const PageBuilderOptions& opts, PageBuilder** builder) {
@@ -204,18 +246,22 @@ private:
 EncodingInfoResolver::EncodingInfoResolver() {
     _add_map<TYPE_TINYINT, BIT_SHUFFLE>();
     _add_map<TYPE_TINYINT, FOR_ENCODING, true>();
+    _add_map<TYPE_TINYINT, INT_DICT_ENCODING>();
     _add_map<TYPE_TINYINT, PLAIN_ENCODING>();
 
     _add_map<TYPE_SMALLINT, BIT_SHUFFLE>();
     _add_map<TYPE_SMALLINT, FOR_ENCODING, true>();
+    _add_map<TYPE_SMALLINT, INT_DICT_ENCODING>();
     _add_map<TYPE_SMALLINT, PLAIN_ENCODING>();
 
     _add_map<TYPE_INT, BIT_SHUFFLE>();
     _add_map<TYPE_INT, FOR_ENCODING, true>();
+    _add_map<TYPE_INT, INT_DICT_ENCODING>();
     _add_map<TYPE_INT, PLAIN_ENCODING>();
 
     _add_map<TYPE_BIGINT, BIT_SHUFFLE>();
     _add_map<TYPE_BIGINT, FOR_ENCODING, true>();
+    _add_map<TYPE_BIGINT, INT_DICT_ENCODING>();
     _add_map<TYPE_BIGINT, PLAIN_ENCODING>();
 
     _add_map<TYPE_LARGEINT, BIT_SHUFFLE>();
@@ -224,17 +270,21 @@ EncodingInfoResolver::EncodingInfoResolver() {
 
     _add_map<TYPE_FLOAT, BIT_SHUFFLE>();
     _add_map<TYPE_FLOAT, PLAIN_ENCODING>();
+    _add_map<TYPE_FLOAT, ALP_ENCODING>();
 
     _add_map<TYPE_DOUBLE, BIT_SHUFFLE>();
     _add_map<TYPE_DOUBLE, PLAIN_ENCODING>();
+    _add_map<TYPE_DOUBLE, ALP_ENCODING>();
 
     _add_map<TYPE_CHAR, DICT_ENCODING>();
     _add_map<TYPE_CHAR, PLAIN_ENCODING>();
     _add_map<TYPE_CHAR, PREFIX_ENCODING, true>();
+    _add_map<TYPE_CHAR, FSST_ENCODING>();
 
     _add_map<TYPE_VARCHAR, DICT_ENCODING>();
     _add_map<TYPE_VARCHAR, PLAIN_ENCODING>();
     _add_map<TYPE_VARCHAR, PREFIX_ENCODING, true>();
+    _add_map<TYPE_VARCHAR, FSST_ENCODING>();
 
     _add_map<TYPE_BOOLEAN, RLE>();
     _add_map<TYPE_BOOLEAN, BIT_SHUFFLE>();
@@ -247,6 +297,7 @@ EncodingInfoResolver::EncodingInfoResolver() {
     _add_map<TYPE_DATE, BIT_SHUFFLE>();
     _add_map<TYPE_DATE, PLAIN_ENCODING>();
     _add_map<TYPE_DATE, FOR_ENCODING, true>();
+    _add_map<TYPE_DATE, INT_DICT_ENCODING>();
 
     _add_map<TYPE_DATETIME_V1, BIT_SHUFFLE>();
     _add_map<TYPE_DATETIME_V1, PLAIN_ENCODING>();
@@ -255,6 +306,7 @@ EncodingInfoResolver::EncodingInfoResolver() {
     _add_map<TYPE_DATETIME, BIT_SHUFFLE>();
     _add_map<TYPE_DATETIME, PLAIN_ENCODING>();
     _add_map<TYPE_DATETIME, FOR_ENCODING, true>();
+    _add_map<TYPE_DATETIME, INT_DICT_ENCODING>();
 
     _add_map<TYPE_DECIMAL, BIT_SHUFFLE, true>();
     _add_map<TYPE_DECIMAL, PLAIN_ENCODING>();
@@ -281,7 +333,11 @@ EncodingInfoResolver::~EncodingInfoResolver() {
 
 Status EncodingInfoResolver::get(LogicalType data_type, EncodingTypePB encoding_type, const EncodingInfo** out) {
     if (encoding_type == DEFAULT_ENCODING) {
-        encoding_type = get_default_encoding(data_type, false);
+        if ((data_type == TYPE_FLOAT || data_type == TYPE_DOUBLE) && config::enable_alp_float_encoding) {
+            encoding_type = ALP_ENCODING;
+        } else {
+            encoding_type = get_default_encoding(data_type, false);
+        }
     }
     auto key = std::make_pair(delegate_type(data_type), encoding_type);
     auto it = _encoding_map.find(key);
@@ -35,6 +35,7 @@
 #pragma once
 
 #include "column/column.h"
+#include "storage/rowset/encoded_predicate.h"
 #include "storage/rowset/options.h"      // for PageBuilderOptions/PageDecoderOptions
 #include "storage/rowset/page_builder.h" // for PageBuilder
 #include "storage/rowset/page_decoder.h" // for PageDecoder
@@ -207,6 +208,19 @@ public:
         return Status::OK();
     }
 
+    Status evaluate(const ColumnPredicate& pred, uint32_t from, uint32_t to, uint8_t* selection) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        DCHECK_LE(to, _num_elements);
+        if constexpr (is_encoded_predicate_type<Type>) {
+            EncodedValueRange<CppType> range;
+            if (to_encoded_value_range<Type>(pred, &range)) {
+                _decoder.evaluate_range(from, to, range.lower, range.upper, range.negate, selection);
+                return Status::OK();
+            }
+        }
+        return Status::NotSupported("evaluate() not supported");
+    }
+
     uint32_t count() const override { return _num_elements; }
 
     uint32_t current_index() const override { return _cur_index; }
@@ -150,6 +150,9 @@ public:
     // All the key in page is unique
     Status seek_at_or_after(const Slice& search_key);
 
+    // Move to the first index entry.
+    void seek_to_first() { _pos = 0; }
+
     // Move to the next index entry.
     // Return true on success, false when no more entries can be read.
     bool move_next() {
@@ -164,6 +164,33 @@ Status IndexedColumnIterator::seek_to_ordinal(ordinal_t idx) {
     return Status::OK();
 }
 
+Status IndexedColumnIterator::seek_to_first() {
+    if (_reader->support_ordinal_seek()) {
+        return seek_to_ordinal(0);
+    }
+    if (!_reader->support_value_seek()) {
+        return Status::NotSupported("no ordinal index and value index");
+    }
+
+    if (_reader->num_values() > 0) {
+        PagePointer data_page_pp;
+        if (_reader->_has_index_page) {
+            _value_iter.seek_to_first();
+            data_page_pp = _value_iter.current_page_pointer();
+            _current_iter = &_value_iter;
+        } else {
+            data_page_pp = PagePointer(_reader->_sole_data_page);
+        }
+        if (_data_page == nullptr || _data_page->page_pointer() != data_page_pp) {
+            RETURN_IF_ERROR(_read_data_page(data_page_pp));
+        }
+        RETURN_IF_ERROR(_data_page->seek(0));
+    }
+    _current_ordinal = 0;
+    _seeked = true;
+    return Status::OK();
+}
+
 Status IndexedColumnIterator::seek_at_or_after(const void* key, bool* exact_match) {
     if (!_reader->support_value_seek()) {
         return Status::NotSupported("no value index");
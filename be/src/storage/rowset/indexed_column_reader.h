@@ -65,6 +65,9 @@ public:
     // Return NotSupported for column without ordinal index.
     Status seek_to_ordinal(ordinal_t idx);
 
+    // Seek to the first entry, works for column with either ordinal index or value index.
+    Status seek_to_first();
+
     // Seek the index to the given key, or to the index entry immediately
     // before it. Then seek the data block to the value matching value or to
     // the value immediately after it.
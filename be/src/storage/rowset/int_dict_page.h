@@ -0,0 +1,338 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstring>
+#include <vector>
+
+#include "column/column.h"
+#include "column/column_hash.h"
+#include "column/fixed_length_column.h"
+#include "gutil/casts.h"
+#include "gutil/strings/substitute.h"
+#include "storage/chunk_helper.h"
+#include "storage/column_predicate.h"
+#include "storage/range.h"
+#include "storage/rowset/options.h"
+#include "storage/rowset/page_builder.h"
+#include "storage/rowset/page_decoder.h"
+#include "storage/type_traits.h"
+#include "util/coding.h"
+#include "util/faststring.h"
+#include "util/phmap/phmap.h"
+
+namespace starrocks {
+
+// Dictionary page for the low-cardinality integer and date columns.
+//
+// Each page has its own dictionary of at most INT_DICT_PAGE_MAX_DICT_SIZE distinct values and stores
+// a one-byte code for every value. A predicate is evaluated once for each dictionary entry and then
+// applied to the codes. If a page has more distinct values, it is stored as plain values.
+//
+// Page layout:
+//   num_values: uint32
+//   mode: uint8, INT_DICT_PAGE_MODE_DICT or INT_DICT_PAGE_MODE_PLAIN
+//   plain mode: values
+//   dict mode: dict_size: uint32, dict values: CppType * dict_size, codes: uint8 * num_values
+static const size_t INT_DICT_PAGE_HEADER_SIZE = sizeof(uint32_t) + sizeof(uint8_t);
+static const size_t INT_DICT_PAGE_MAX_DICT_SIZE = 256;
+static const uint8_t INT_DICT_PAGE_MODE_DICT = 0;
+static const uint8_t INT_DICT_PAGE_MODE_PLAIN = 1;
+
+template <LogicalType Type>
+class IntDictPageBuilder final : public PageBuilder {
+public:
+    explicit IntDictPageBuilder(const PageBuilderOptions& options) : _options(options) {
+        _max_count = std::max<uint32_t>(1, _options.data_page_size / SIZE_OF_TYPE);
+        reset();
+    }
+
+    ~IntDictPageBuilder() override = default;
+
+    bool is_page_full() override { return _values.size() >= _max_count; }
+
+    uint32_t add(const uint8_t* vals, uint32_t count) override {
+        DCHECK(!_finished);
+        uint32_t to_add = std::min<uint32_t>(_max_count - _values.size(), count);
+        const auto* new_vals = reinterpret_cast<const CppType*>(vals);
+        _values.insert(_values.end(), new_vals, new_vals + to_add);
+        for (uint32_t i = 0; i < to_add && _dict_encodable; i++) {
+            auto [iter, inserted] = _dict.try_emplace(new_vals[i], _dict_values.size());
+            if (inserted) {
+                if (_dict_values.size() == INT_DICT_PAGE_MAX_DICT_SIZE) {
+                    _dict_encodable = false;
+                    break;
+                }
+                _dict_values.push_back(new_vals[i]);
+            }
+            _codes.push_back(iter->second);
+        }
+        return to_add;
+    }
+
+    faststring* finish() override {
+        DCHECK(!_finished);
+        _finished = true;
+        uint32_t count = _values.size();
+        _buf.clear();
+        put_fixed32_le(&_buf, count);
+        if (_dict_encodable) {
+            DCHECK_EQ(count, _codes.size());
+            _buf.push_back(INT_DICT_PAGE_MODE_DICT);
+            put_fixed32_le(&_buf, _dict_values.size());
+            _buf.append(_dict_values.data(), _dict_values.size() * SIZE_OF_TYPE);
+            _buf.append(_codes.data(), _codes.size());
+        } else {
+            _buf.push_back(INT_DICT_PAGE_MODE_PLAIN);
+            _buf.append(_values.data(), count * SIZE_OF_TYPE);
+        }
+        return &_buf;
+    }
+
+    void reset() override {
+        _values.clear();
+        _values.reserve(_max_count);
+        _dict.clear();
+        _dict_values.clear();
+        _codes.clear();
+        _dict_encodable = true;
+        _buf.clear();
+        _finished = false;
+    }
+
+    uint32_t count() const override { return _values.size(); }
+
+    uint64_t size() const override {
+        if (_finished) {
+            return _buf.size();
+        }
+        return _dict_encodable ? _dict_values.size() * SIZE_OF_TYPE + _codes.size() : _values.size() * SIZE_OF_TYPE;
+    }
+
+    Status get_first_value(void* value) const override {
+        if (_values.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_values.front(), SIZE_OF_TYPE);
+        return Status::OK();
+    }
+
+    Status get_last_value(void* value) const override {
+        if (_values.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_values.back(), SIZE_OF_TYPE);
+        return Status::OK();
+    }
+
+private:
+    typedef typename TypeTraits<Type>::CppType CppType;
+    enum { SIZE_OF_TYPE = TypeTraits<Type>::size };
+
+    PageBuilderOptions _options;
+    uint32_t _max_count;
+    bool _finished{false};
+    std::vector<CppType> _values;
+    // Whether the values added so far has no more than INT_DICT_PAGE_MAX_DICT_SIZE distinct values.
+    bool _dict_encodable{true};
+    phmap::flat_hash_map<CppType, uint8_t, StdHash<CppType>> _dict;
+    std::vector<CppType> _dict_values;
+    std::vector<uint8_t> _codes;
+    faststring _buf;
+};
+
+template <LogicalType Type>
+class IntDictPageDecoder final : public PageDecoder {
+public:
+    IntDictPageDecoder(Slice data, const PageDecoderOptions& options) : _data(data) {}
+
+    ~IntDictPageDecoder() override = default;
+
+    Status init() override {
+        CHECK(!_parsed);
+        if (_data.size < INT_DICT_PAGE_HEADER_SIZE) {
+            return Status::Corruption("not enough bytes for header in IntDictPageDecoder");
+        }
+        const auto* data = reinterpret_cast<const uint8_t*>(_data.data);
+        _num_elements = decode_fixed32_le(data);
+        _mode = data[sizeof(uint32_t)];
+        if (_mode == INT_DICT_PAGE_MODE_PLAIN) {
+            if (_data.size != INT_DICT_PAGE_HEADER_SIZE + static_cast<size_t>(_num_elements) * SIZE_OF_TYPE) {
+                return Status::Corruption("unexpected data size of plain int dict page");
+            }
+            _values = data + INT_DICT_PAGE_HEADER_SIZE;
+        } else if (_mode == INT_DICT_PAGE_MODE_DICT) {
+            if (_data.size < INT_DICT_PAGE_HEADER_SIZE + sizeof(uint32_t)) {
+                return Status::Corruption("not enough bytes for dict header in IntDictPageDecoder");
+            }
+            uint32_t dict_size = decode_fixed32_le(data + INT_DICT_PAGE_HEADER_SIZE);
+            const uint8_t* dict = data + INT_DICT_PAGE_HEADER_SIZE + sizeof(uint32_t);
+            if (dict_size > INT_DICT_PAGE_MAX_DICT_SIZE ||
+                _data.size != INT_DICT_PAGE_HEADER_SIZE + sizeof(uint32_t) + dict_size * SIZE_OF_TYPE + _num_elements) {
+                return Status::Corruption("unexpected data size of int dict page");
+            }
+            // Copy the dictionary out so the values are aligned, and pad it to 256 entries
+            // so an invalid code can not read out of bound.
+            _dict.resize(INT_DICT_PAGE_MAX_DICT_SIZE);
+            memcpy(_dict.data(), dict, dict_size * SIZE_OF_TYPE);
+            _dict_size = dict_size;
+            _codes = dict + dict_size * SIZE_OF_TYPE;
+        } else {
+            return Status::Corruption(strings::Substitute("unknown int dict page mode $0", _mode));
+        }
+        _parsed = true;
+        return Status::OK();
+    }
+
+    Status seek_to_position_in_page(uint32_t pos) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        DCHECK_LE(pos, _num_elements);
+        _cur_index = pos;
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* count, Column* dst) override {
+        SparseRange read_range;
+        uint32_t begin = current_index();
+        read_range.add(Range(begin, begin + *count));
+        RETURN_IF_ERROR(next_batch(read_range, dst));
+        *count = current_index() - begin;
+        return Status::OK();
+    }
+
+    Status next_batch(const SparseRange& range, Column* dst) override {
+        DCHECK(_parsed);
+        size_t to_read = range.span_size();
+        if (PREDICT_FALSE(to_read == 0 || _cur_index >= _num_elements)) {
+            return Status::OK();
+        }
+        SparseRangeIterator iter = range.new_iterator();
+        while (iter.has_more() && _cur_index < _num_elements) {
+            _cur_index = iter.begin();
+            Range r = iter.next(to_read);
+            uint32_t max_fetch = std::min(r.span_size(), _num_elements - _cur_index);
+            int n;
+            if (_mode == INT_DICT_PAGE_MODE_DICT) {
+                _buf.resize(max_fetch);
+                _decode_codes(_cur_index, max_fetch, _buf.data());
+                n = dst->append_numbers(_buf.data(), max_fetch * SIZE_OF_TYPE);
+            } else {
+                n = dst->append_numbers(_values + _cur_index * SIZE_OF_TYPE, max_fetch * SIZE_OF_TYPE);
+            }
+            DCHECK_EQ(max_fetch, n);
+            _cur_index += max_fetch;
+        }
+        return Status::OK();
+    }
+
+    // Evaluate |predicate| on the rows in [from, to), the result is saved into selection[0, to - from).
+    // For a dictionary page, the predicate is evaluated on the dictionary only.
+    Status evaluate(const ColumnPredicate* predicate, uint32_t from, uint32_t to, uint8_t* selection) const {
+        DCHECK(_parsed);
+        DCHECK_LE(to, _num_elements);
+        if (_mode == INT_DICT_PAGE_MODE_DICT) {
+            auto dict_column = ChunkHelper::column_from_field_type(Type, false);
+            [[maybe_unused]] auto n = dict_column->append_numbers(_dict.data(), _dict_size * SIZE_OF_TYPE);
+            uint8_t code_selection[INT_DICT_PAGE_MAX_DICT_SIZE] = {0};
+            RETURN_IF_ERROR(predicate->evaluate(dict_column.get(), code_selection, 0, _dict_size));
+            for (uint32_t i = from; i < to; i++) {
+                selection[i - from] = code_selection[_codes[i]];
+            }
+            return Status::OK();
+        }
+        // ColumnPredicate evaluates at most UINT16_MAX rows at a time.
+        static constexpr uint32_t BATCH_SIZE = 4096;
+        auto column = ChunkHelper::column_from_field_type(Type, false);
+        for (uint32_t begin = from; begin < to; begin += BATCH_SIZE) {
+            uint32_t size = std::min(BATCH_SIZE, to - begin);
+            column->reset_column();
+            [[maybe_unused]] auto n = column->append_numbers(_values + begin * SIZE_OF_TYPE, size * SIZE_OF_TYPE);
+            RETURN_IF_ERROR(predicate->evaluate(column.get(), selection + (begin - from), 0, size));
+        }
+        return Status::OK();
+    }
+
+    uint32_t count() const override { return _num_elements; }
+
+    uint32_t current_index() const override { return _cur_index; }
+
+    EncodingTypePB encoding_type() const override { return INT_DICT_ENCODING; }
+
+    // Whether the page is stored as dictionary and codes, the codes are only valid in this page.
+    bool is_dict_encoded() const { return _mode == INT_DICT_PAGE_MODE_DICT; }
+
+    uint32_t dict_size() const { return _dict_size; }
+
+    const CppType* dict_values() const { return _dict.data(); }
+
+    // Append the codes of the next |n| rows to |dst|, which must be an Int32Column.
+    // prerequisite: is_dict_encoded() is true.
+    Status next_dict_codes(size_t* n, Column* dst) override {
+        SparseRange read_range;
+        uint32_t begin = current_index();
+        read_range.add(Range(begin, begin + *n));
+        RETURN_IF_ERROR(next_dict_codes(read_range, dst));
+        *n = current_index() - begin;
+        return Status::OK();
+    }
+
+    Status next_dict_codes(const SparseRange& range, Column* dst) override {
+        DCHECK(_parsed);
+        if (_mode != INT_DICT_PAGE_MODE_DICT) {
+            return Status::NotSupported("next_dict_codes() on the plain int dict page");
+        }
+        auto& codes = down_cast<Int32Column*>(dst)->get_data();
+        size_t to_read = range.span_size();
+        SparseRangeIterator iter = range.new_iterator();
+        while (iter.has_more() && _cur_index < _num_elements) {
+            _cur_index = iter.begin();
+            Range r = iter.next(to_read);
+            uint32_t max_fetch = std::min(r.span_size(), _num_elements - _cur_index);
+            size_t old_size = codes.size();
+            codes.resize(old_size + max_fetch);
+            for (uint32_t i = 0; i < max_fetch; i++) {
+                codes[old_size + i] = _codes[_cur_index + i];
+            }
+            _cur_index += max_fetch;
+        }
+        return Status::OK();
+    }
+
+private:
+    typedef typename TypeTraits<Type>::CppType CppType;
+    enum { SIZE_OF_TYPE = TypeTraits<Type>::size };
+
+    void _decode_codes(uint32_t begin, uint32_t size, CppType* output) const {
+        const uint8_t* codes = _codes + begin;
+        const CppType* dict = _dict.data();
+        for (uint32_t i = 0; i < size; i++) {
+            output[i] = dict[codes[i]];
+        }
+    }
+
+    Slice _data;
+    bool _parsed{false};
+    uint8_t _mode{INT_DICT_PAGE_MODE_PLAIN};
+    uint32_t _num_elements{0};
+    uint32_t _cur_index{0};
+    // The values of the plain page.
+    const uint8_t* _values{nullptr};
+    std::vector<CppType> _dict;
+    uint32_t _dict_size{0};
+    const uint8_t* _codes{nullptr};
+    std::vector<CppType> _buf;
+};
+
+} // namespace starrocks
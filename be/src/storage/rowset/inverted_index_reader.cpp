@@ -0,0 +1,59 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "storage/rowset/inverted_index_reader.h"
+
+#include "util/slice.h"
+
+namespace starrocks {
+
+StatusOr<bool> InvertedIndexReader::load(FileSystem* fs, const std::string& filename, const InvertedIndexPB& meta,
+                                         bool use_page_cache, bool kept_in_memory) {
+    return _posting_lists.load(fs, filename, meta.posting_lists(), use_page_cache, kept_in_memory);
+}
+
+Status InvertedIndexReader::new_iterator(std::unique_ptr<InvertedIndexIterator>* iterator) {
+    BitmapIndexIterator* iter = nullptr;
+    RETURN_IF_ERROR(_posting_lists.new_iterator(&iter));
+    *iterator = std::make_unique<InvertedIndexIterator>(_parser, std::unique_ptr<BitmapIndexIterator>(iter));
+    return Status::OK();
+}
+
+Status InvertedIndexIterator::match_all(const std::vector<std::string>& terms, Roaring* result) {
+    DCHECK(!terms.empty());
+    for (size_t i = 0; i < terms.size(); i++) {
+        Slice term(terms[i]);
+        bool exact_match = false;
+        Status st = _posting_lists->seek_dictionary(&term, &exact_match);
+        if (st.is_not_found() || (st.ok() && !exact_match)) {
+            *result = Roaring();
+            return Status::OK();
+        }
+        RETURN_IF_ERROR(st);
+        Roaring bitmap;
+        RETURN_IF_ERROR(_posting_lists->read_bitmap(_posting_lists->current_ordinal(), &bitmap));
+        if (i == 0) {
+            *result = std::move(bitmap);
+        } else {
+            *result &= bitmap;
+        }
+        if (result->isEmpty()) {
+            break;
+        }
+    }
+    return Status::OK();
+}
+
+} // namespace starrocks
@@ -0,0 +1,69 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <memory>
+#include <roaring/roaring.hh>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "common/statusor.h"
+#include "gen_cpp/segment.pb.h"
+#include "storage/rowset/bitmap_index_reader.h"
+#include "storage/rowset/inverted_index_tokenizer.h"
+
+namespace starrocks {
+
+class FileSystem;
+class InvertedIndexIterator;
+
+// Reader of the full-text inverted index written by InvertedIndexWriter.
+class InvertedIndexReader {
+public:
+    explicit InvertedIndexReader(InvertedIndexParserPB parser) : _parser(parser) {}
+
+    // Load index data into memory, see BitmapIndexReader::load.
+    StatusOr<bool> load(FileSystem* fs, const std::string& filename, const InvertedIndexPB& meta, bool use_page_cache,
+                        bool kept_in_memory);
+
+    // REQUIRES: the index data has been successfully `load()`ed into memory.
+    Status new_iterator(std::unique_ptr<InvertedIndexIterator>* iterator);
+
+    bool loaded() const { return _posting_lists.loaded(); }
+
+private:
+    const InvertedIndexParserPB _parser;
+    BitmapIndexReader _posting_lists;
+};
+
+class InvertedIndexIterator {
+public:
+    InvertedIndexIterator(InvertedIndexParserPB parser, std::unique_ptr<BitmapIndexIterator> iter)
+            : _tokenizer(parser), _posting_lists(std::move(iter)) {}
+
+    const InvertedIndexTokenizer& tokenizer() const { return _tokenizer; }
+
+    // Set |result| to the row ordinals whose value contains all the |terms|. |terms| must be
+    // produced by `tokenizer()` and must not be empty.
+    Status match_all(const std::vector<std::string>& terms, Roaring* result);
+
+private:
+    InvertedIndexTokenizer _tokenizer;
+    std::unique_ptr<BitmapIndexIterator> _posting_lists;
+};
+
+} // namespace starrocks
@@ -0,0 +1,69 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "gen_cpp/segment.pb.h"
+#include "util/slice.h"
+
+namespace starrocks {
+
+// Split the text into the terms of full-text inverted index.
+//
+// SIMPLE_PARSER: the terms are the maximal runs of ASCII letters, ASCII digits and non-ASCII bytes,
+// and the ASCII letters are lowercased, so the multi-byte UTF-8 characters are kept in the terms.
+class InvertedIndexTokenizer {
+public:
+    explicit InvertedIndexTokenizer(InvertedIndexParserPB parser) : _parser(parser) {}
+
+    InvertedIndexParserPB parser() const { return _parser; }
+
+    static bool is_term_char(char c) {
+        auto u = static_cast<unsigned char>(c);
+        return u >= 0x80 || (u >= '0' && u <= '9') || (u >= 'a' && u <= 'z') || (u >= 'A' && u <= 'Z');
+    }
+
+    // Call |fn| with each term of |text| in order, the same term may appear more than once.
+    template <typename Fn>
+    void for_each_term(const Slice& text, Fn&& fn) const {
+        std::string term;
+        for (size_t i = 0; i < text.size; i++) {
+            char c = text.data[i];
+            if (is_term_char(c)) {
+                term.push_back((c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c);
+            } else if (!term.empty()) {
+                fn(term);
+                term.clear();
+            }
+        }
+        if (!term.empty()) {
+            fn(term);
+        }
+    }
+
+    std::vector<std::string> tokenize(const Slice& text) const {
+        std::vector<std::string> terms;
+        for_each_term(text, [&](const std::string& term) { terms.emplace_back(term); });
+        return terms;
+    }
+
+private:
+    InvertedIndexParserPB _parser;
+};
+
+} // namespace starrocks
@@ -0,0 +1,117 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "storage/rowset/inverted_index_writer.h"
+
+#include <vector>
+
+#include "fs/fs.h"
+#include "storage/rowset/encoding_info.h"
+#include "storage/rowset/indexed_column_writer.h"
+#include "storage/types.h"
+#include "util/faststring.h"
+#include "util/slice.h"
+
+namespace starrocks {
+
+Status InvertedIndexWriter::create(const TypeInfoPtr& type_info, InvertedIndexParserPB parser,
+                                   std::unique_ptr<InvertedIndexWriter>* res) {
+    if (type_info->type() != TYPE_CHAR && type_info->type() != TYPE_VARCHAR) {
+        return Status::NotSupported("inverted index only supports char/varchar");
+    }
+    *res = std::make_unique<InvertedIndexWriter>(parser);
+    return Status::OK();
+}
+
+void InvertedIndexWriter::add_values(const void* values, size_t count) {
+    const auto* p = reinterpret_cast<const Slice*>(values);
+    for (size_t i = 0; i < count; ++i) {
+        // The zeros padded to CHAR values are not term characters, so they are skipped by the tokenizer.
+        _tokenizer.for_each_term(unaligned_load<Slice>(p + i), [&](const std::string& term) {
+            auto [it, inserted] = _postings.try_emplace(term);
+            if (inserted) {
+                _size += term.size() + sizeof(Roaring);
+            }
+            if (it->second.addChecked(_rid)) {
+                _size += sizeof(rowid_t);
+            }
+        });
+        _rid++;
+    }
+}
+
+void InvertedIndexWriter::add_nulls(uint32_t count) {
+    _null_bitmap.addRange(_rid, _rid + count);
+    _rid += count;
+}
+
+Status InvertedIndexWriter::finish(WritableFile* wfile, ColumnIndexMetaPB* index_meta) {
+    index_meta->set_type(INVERTED_INDEX);
+    InvertedIndexPB* inverted_index = index_meta->mutable_inverted_index();
+    inverted_index->set_parser(_tokenizer.parser());
+    BitmapIndexPB* meta = inverted_index->mutable_posting_lists();
+    meta->set_bitmap_type(BitmapIndexPB::ROARING_BITMAP);
+    meta->set_has_null(!_null_bitmap.isEmpty());
+
+    { // write term dictionary
+        TypeInfoPtr dict_typeinfo = get_type_info(TYPE_VARCHAR);
+        IndexedColumnWriterOptions options;
+        options.write_ordinal_index = false;
+        options.write_value_index = true;
+        options.encoding = EncodingInfo::get_default_encoding(TYPE_VARCHAR, true);
+        options.compression = CompressionTypePB::LZ4;
+
+        IndexedColumnWriter dict_column_writer(options, dict_typeinfo, wfile);
+        RETURN_IF_ERROR(dict_column_writer.init());
+        for (const auto& [term, bitmap] : _postings) {
+            Slice value(term);
+            RETURN_IF_ERROR(dict_column_writer.add(&value));
+        }
+        RETURN_IF_ERROR(dict_column_writer.finish(meta->mutable_dict_column()));
+    }
+    { // write posting lists, the null bitmap is always the last one
+        std::vector<Roaring*> bitmaps;
+        bitmaps.reserve(_postings.size() + 1);
+        for (auto& [term, bitmap] : _postings) {
+            bitmaps.push_back(&bitmap);
+        }
+        if (!_null_bitmap.isEmpty()) {
+            bitmaps.push_back(&_null_bitmap);
+        }
+
+        TypeInfoPtr bitmap_typeinfo = get_type_info(TYPE_OBJECT);
+        IndexedColumnWriterOptions options;
+        options.write_ordinal_index = true;
+        options.write_value_index = false;
+        options.encoding = EncodingInfo::get_default_encoding(bitmap_typeinfo->type(), false);
+        // we already store compressed bitmap, use NO_COMPRESSION to save some cpu
+        options.compression = NO_COMPRESSION;
+
+        IndexedColumnWriter bitmap_column_writer(options, bitmap_typeinfo, wfile);
+        RETURN_IF_ERROR(bitmap_column_writer.init());
+        faststring buf;
+        for (Roaring* bitmap : bitmaps) {
+            bitmap->runOptimize();
+            buf.resize(bitmap->getSizeInBytes(false));
+            bitmap->write(reinterpret_cast<char*>(buf.data()), false);
+            Slice buf_slice(buf);
+            RETURN_IF_ERROR(bitmap_column_writer.add(&buf_slice));
+        }
+        RETURN_IF_ERROR(bitmap_column_writer.finish(meta->mutable_bitmap_column()));
+    }
+    return Status::OK();
+}
+
+} // namespace starrocks
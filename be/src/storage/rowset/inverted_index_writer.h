@@ -0,0 +1,68 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <roaring/roaring.hh>
+#include <string>
+
+#include "common/status.h"
+#include "gen_cpp/segment.pb.h"
+#include "storage/rowset/common.h"
+#include "storage/rowset/inverted_index_tokenizer.h"
+
+namespace starrocks {
+
+class TypeInfo;
+using TypeInfoPtr = std::shared_ptr<TypeInfo>;
+
+class WritableFile;
+
+// Builder for the full-text inverted index of char/varchar columns. Every value is split into terms by
+// InvertedIndexTokenizer, and the index maps each distinct term to the bitmap of the row ordinals whose
+// value contains the term. The term dictionary and the bitmaps are written in the same format as bitmap
+// index, so they are read by BitmapIndexReader.
+class InvertedIndexWriter {
+public:
+    static Status create(const TypeInfoPtr& type_info, InvertedIndexParserPB parser,
+                         std::unique_ptr<InvertedIndexWriter>* res);
+
+    explicit InvertedIndexWriter(InvertedIndexParserPB parser) : _tokenizer(parser) {}
+
+    void add_values(const void* values, size_t count);
+
+    void add_nulls(uint32_t count);
+
+    Status finish(WritableFile* wfile, ColumnIndexMetaPB* index_meta);
+
+    uint64_t size() const { return _size + _null_bitmap.getSizeInBytes(false); }
+
+private:
+    InvertedIndexWriter(const InvertedIndexWriter&) = delete;
+    const InvertedIndexWriter& operator=(const InvertedIndexWriter&) = delete;
+
+    InvertedIndexTokenizer _tokenizer;
+    rowid_t _rid = 0;
+    Roaring _null_bitmap;
+    // term to its row id list, sorted by term
+    std::map<std::string, Roaring> _postings;
+    // estimated memory usage of |_postings|
+    uint64_t _size = 0;
+};
+
+} // namespace starrocks
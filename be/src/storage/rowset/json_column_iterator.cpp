@@ -0,0 +1,231 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "storage/rowset/json_column_iterator.h"
+
+#include <fmt/format.h>
+
+#include "column/column_helper.h"
+#include "column/json_column.h"
+#include "column/nullable_column.h"
+#include "gutil/casts.h"
+#include "runtime/types.h"
+#include "util/json.h"
+#include "velocypack/Builder.h"
+#include "velocypack/Iterator.h"
+
+namespace starrocks {
+
+class FlatJsonColumnIterator final : public ColumnIterator {
+public:
+    FlatJsonColumnIterator(std::unique_ptr<ColumnIterator> json_iter,
+                           std::vector<std::unique_ptr<ColumnIterator>> flat_iters, std::vector<std::string> flat_paths,
+                           std::vector<LogicalType> flat_types);
+
+    ~FlatJsonColumnIterator() override = default;
+
+    Status init(const ColumnIteratorOptions& opts) override;
+
+    Status next_batch(size_t* n, Column* dst) override;
+
+    Status next_batch(const SparseRange& range, Column* dst) override;
+
+    Status seek_to_first() override;
+
+    Status seek_to_ordinal(ordinal_t ord) override;
+
+    ordinal_t get_current_ordinal() const override { return _json_iter->get_current_ordinal(); }
+
+    Status get_row_ranges_by_zone_map(const std::vector<const ColumnPredicate*>& predicates,
+                                      const ColumnPredicate* del_predicate, SparseRange* row_ranges) override {
+        return _json_iter->get_row_ranges_by_zone_map(predicates, del_predicate, row_ranges);
+    }
+
+    Status get_row_ranges_by_bloom_filter(const std::vector<const ColumnPredicate*>& predicates,
+                                          SparseRange* row_ranges) override {
+        return _json_iter->get_row_ranges_by_bloom_filter(predicates, row_ranges);
+    }
+
+    Status fetch_values_by_rowid(const rowid_t* rowids, size_t size, Column* values) override;
+
+private:
+    void _reset_flat_columns();
+
+    // Add the fields in |_flat_columns| to the remainders of |dst| starting from the row |from|.
+    Status _merge(Column* dst, size_t from);
+
+    std::unique_ptr<ColumnIterator> _json_iter;
+    std::vector<std::unique_ptr<ColumnIterator>> _flat_iters;
+    std::vector<std::string> _flat_paths;
+    std::vector<LogicalType> _flat_types;
+    // the values of the fields of the current batch
+    Columns _flat_columns;
+};
+
+StatusOr<std::unique_ptr<ColumnIterator>> create_flat_json_iter(std::unique_ptr<ColumnIterator> json_iter,
+                                                                std::vector<std::unique_ptr<ColumnIterator>> flat_iters,
+                                                                std::vector<std::string> flat_paths,
+                                                                std::vector<LogicalType> flat_types) {
+    DCHECK_EQ(flat_iters.size(), flat_paths.size());
+    DCHECK_EQ(flat_iters.size(), flat_types.size());
+    return std::make_unique<FlatJsonColumnIterator>(std::move(json_iter), std::move(flat_iters), std::move(flat_paths),
+                                                    std::move(flat_types));
+}
+
+FlatJsonColumnIterator::FlatJsonColumnIterator(std::unique_ptr<ColumnIterator> json_iter,
+                                               std::vector<std::unique_ptr<ColumnIterator>> flat_iters,
+                                               std::vector<std::string> flat_paths,
+                                               std::vector<LogicalType> flat_types)
+        : _json_iter(std::move(json_iter)),
+          _flat_iters(std::move(flat_iters)),
+          _flat_paths(std::move(flat_paths)),
+          _flat_types(std::move(flat_types)) {
+    for (LogicalType type : _flat_types) {
+        _flat_columns.emplace_back(ColumnHelper::create_column(TypeDescriptor(type), true));
+    }
+}
+
+Status FlatJsonColumnIterator::init(const ColumnIteratorOptions& opts) {
+    RETURN_IF_ERROR(ColumnIterator::init(opts));
+    RETURN_IF_ERROR(_json_iter->init(opts));
+    for (auto& iter : _flat_iters) {
+        RETURN_IF_ERROR(iter->init(opts));
+    }
+    return Status::OK();
+}
+
+void FlatJsonColumnIterator::_reset_flat_columns() {
+    for (auto& column : _flat_columns) {
+        column->reset_column();
+    }
+}
+
+Status FlatJsonColumnIterator::next_batch(size_t* n, Column* dst) {
+    size_t from = dst->size();
+    RETURN_IF_ERROR(_json_iter->next_batch(n, dst));
+    _reset_flat_columns();
+    for (size_t i = 0; i < _flat_iters.size(); i++) {
+        size_t num_to_read = *n;
+        RETURN_IF_ERROR(_flat_iters[i]->next_batch(&num_to_read, _flat_columns[i].get()));
+    }
+    return _merge(dst, from);
+}
+
+Status FlatJsonColumnIterator::next_batch(const SparseRange& range, Column* dst) {
+    size_t from = dst->size();
+    RETURN_IF_ERROR(_json_iter->next_batch(range, dst));
+    _reset_flat_columns();
+    for (size_t i = 0; i < _flat_iters.size(); i++) {
+        RETURN_IF_ERROR(_flat_iters[i]->next_batch(range, _flat_columns[i].get()));
+    }
+    return _merge(dst, from);
+}
+
+Status FlatJsonColumnIterator::fetch_values_by_rowid(const rowid_t* rowids, size_t size, Column* values) {
+    size_t from = values->size();
+    RETURN_IF_ERROR(_json_iter->fetch_values_by_rowid(rowids, size, values));
+    _reset_flat_columns();
+    for (size_t i = 0; i < _flat_iters.size(); i++) {
+        RETURN_IF_ERROR(_flat_iters[i]->fetch_values_by_rowid(rowids, size, _flat_columns[i].get()));
+    }
+    return _merge(values, from);
+}
+
+Status FlatJsonColumnIterator::_merge(Column* dst, size_t from) {
+    auto* json_column = down_cast<JsonColumn*>(ColumnHelper::get_data_column(dst));
+    const uint8_t* nulls = nullptr;
+    if (dst->is_nullable()) {
+        nulls = down_cast<NullableColumn*>(dst)->immutable_null_column_data().data();
+    }
+    auto& pool = json_column->get_pool();
+    const size_t num_rows = json_column->size() - from;
+    for (auto& column : _flat_columns) {
+        if (column->size() != num_rows) {
+            return Status::Corruption(fmt::format("flat json field has {} rows, but the json column has {} rows",
+                                                  column->size(), num_rows));
+        }
+    }
+    try {
+        for (size_t i = 0; i < num_rows; i++) {
+            if (nulls != nullptr && nulls[from + i]) {
+                continue;
+            }
+            bool has_field = false;
+            for (auto& column : _flat_columns) {
+                if (!column->is_null(i)) {
+                    has_field = true;
+                    break;
+                }
+            }
+            if (!has_field) {
+                continue;
+            }
+            vpack::Slice remainder = pool[from + i].to_vslice();
+            if (!remainder.isObject()) {
+                return Status::Corruption("the remainder of flat json is not an object");
+            }
+            vpack::Builder builder;
+            {
+                vpack::ObjectBuilder ob(&builder);
+                for (size_t j = 0; j < _flat_columns.size(); j++) {
+                    if (_flat_columns[j]->is_null(i)) {
+                        continue;
+                    }
+                    Datum datum = _flat_columns[j]->get(i);
+                    switch (_flat_types[j]) {
+                    case TYPE_BIGINT:
+                        builder.add(_flat_paths[j], vpack::Value(datum.get_int64()));
+                        break;
+                    case TYPE_DOUBLE:
+                        builder.add(_flat_paths[j], vpack::Value(datum.get_double()));
+                        break;
+                    case TYPE_BOOLEAN:
+                        builder.add(_flat_paths[j], vpack::Value(datum.get_uint8() != 0));
+                        break;
+                    default:
+                        builder.add(_flat_paths[j], vpack::Value(datum.get_slice().to_string()));
+                        break;
+                    }
+                }
+                for (const auto& it : vpack::ObjectIterator(remainder)) {
+                    builder.add(it.key.stringRef(), it.value);
+                }
+            }
+            pool[from + i] = JsonValue(builder.slice());
+        }
+    } catch (const vpack::Exception& e) {
+        return fromVPackException(e);
+    }
+    json_column->reset_cache();
+    return Status::OK();
+}
+
+Status FlatJsonColumnIterator::seek_to_first() {
+    RETURN_IF_ERROR(_json_iter->seek_to_first());
+    for (auto& iter : _flat_iters) {
+        RETURN_IF_ERROR(iter->seek_to_first());
+    }
+    return Status::OK();
+}
+
+Status FlatJsonColumnIterator::seek_to_ordinal(ordinal_t ord) {
+    RETURN_IF_ERROR(_json_iter->seek_to_ordinal(ord));
+    for (auto& iter : _flat_iters) {
+        RETURN_IF_ERROR(iter->seek_to_ordinal(ord));
+    }
+    return Status::OK();
+}
+
+} // namespace starrocks
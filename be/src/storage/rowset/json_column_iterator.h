@@ -0,0 +1,29 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include "storage/rowset/column_reader.h"
+
+namespace starrocks {
+
+// Create the iterator of a flat JSON column, which reads the remainders with |json_iter| and restores
+// the documents by adding the top-level fields |flat_paths| read with |flat_iters|.
+StatusOr<std::unique_ptr<ColumnIterator>> create_flat_json_iter(std::unique_ptr<ColumnIterator> json_iter,
+                                                                std::vector<std::unique_ptr<ColumnIterator>> flat_iters,
+                                                                std::vector<std::string> flat_paths,
+                                                                std::vector<LogicalType> flat_types);
+
+} // namespace starrocks
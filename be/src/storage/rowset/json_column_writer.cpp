@@ -0,0 +1,397 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "storage/rowset/json_column_writer.h"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <string_view>
+#include <unordered_map>
+
+#include "column/column_helper.h"
+#include "column/json_column.h"
+#include "column/nullable_column.h"
+#include "common/config.h"
+#include "gutil/casts.h"
+#include "runtime/types.h"
+#include "storage/tablet_schema.h"
+#include "storage/types.h"
+#include "types/constexpr.h"
+#include "types/logical_type.h"
+#include "util/json.h"
+#include "velocypack/Builder.h"
+#include "velocypack/Iterator.h"
+
+namespace starrocks {
+
+// At most this number of rows of the first appended column are used to choose the fields to extract.
+static constexpr size_t kMaxSampleRows = 4096;
+
+// The type of the children column which can store |value|, TYPE_UNKNOWN if there is none,
+// e.g. the JSON null, arrays and objects are always kept in the remainder.
+static LogicalType flat_type_of(const vpack::Slice& value) {
+    switch (value.type()) {
+    case vpack::ValueType::SmallInt:
+    case vpack::ValueType::Int:
+        return TYPE_BIGINT;
+    case vpack::ValueType::UInt:
+        return value.getUInt() <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) ? TYPE_BIGINT
+                                                                                               : TYPE_UNKNOWN;
+    case vpack::ValueType::Double:
+        return TYPE_DOUBLE;
+    case vpack::ValueType::Bool:
+        return TYPE_BOOLEAN;
+    case vpack::ValueType::String:
+        return TYPE_VARCHAR;
+    default:
+        return TYPE_UNKNOWN;
+    }
+}
+
+// Write the JSON column in flat format: the frequent top-level fields of the JSON objects are
+// stored in the typed children columns, and the JSON column itself stores the remainder of each
+// document, i.e. the document without the extracted fields.
+//
+// A field is extracted from a row only if its value has the type of the children column, so a row
+// can always be restored by adding the non-null values of the children columns to its remainder.
+class FlatJsonColumnWriter final : public ColumnWriter {
+public:
+    FlatJsonColumnWriter(const ColumnWriterOptions& opts, TypeInfoPtr type_info, WritableFile* wfile,
+                         std::unique_ptr<ScalarColumnWriter> json_writer);
+
+    ~FlatJsonColumnWriter() override = default;
+
+    Status init() override { return _json_writer->init(); }
+
+    Status append(const Column& column) override;
+
+    uint64_t estimate_buffer_size() override;
+
+    Status finish() override;
+    Status write_data() override;
+    Status write_ordinal_index() override;
+
+    Status finish_current_page() override;
+
+    Status write_zone_map() override;
+
+    Status write_bitmap_index() override { return _json_writer->write_bitmap_index(); }
+
+    Status write_bloom_filter_index() override { return _json_writer->write_bloom_filter_index(); }
+
+    ordinal_t get_next_rowid() const override { return _json_writer->get_next_rowid(); }
+
+    uint64_t total_mem_footprint() const override;
+
+private:
+    // Choose the fields to extract from the first appended column, and create their writers.
+    Status _init_flat_writers(const JsonColumn& json_column, const uint8_t* nulls);
+
+    // Append the extracted fields of |json| to |flat_columns| and the remainder to |remainder|.
+    void _flatten(const JsonValue& json, JsonColumn* remainder, const Columns& flat_columns);
+
+    ColumnWriterOptions _opts;
+    WritableFile* _wfile;
+
+    std::unique_ptr<ScalarColumnWriter> _json_writer;
+    bool _flat_inited = false;
+    std::vector<std::string> _flat_paths;
+    std::vector<LogicalType> _flat_types;
+    // see `JsonMetaPB.flat_path_complete`
+    std::vector<bool> _flat_complete;
+    // field name => index in |_flat_paths|, the keys point to the strings in |_flat_paths|.
+    std::unordered_map<std::string_view, size_t> _flat_index;
+    std::vector<std::unique_ptr<ColumnWriter>> _flat_writers;
+    // whether the field has been extracted from the current row
+    std::vector<uint8_t> _extracted;
+};
+
+StatusOr<std::unique_ptr<ColumnWriter>> create_json_column_writer(const ColumnWriterOptions& opts,
+                                                                  TypeInfoPtr type_info, WritableFile* wfile) {
+    auto json_writer = std::make_unique<ScalarColumnWriter>(opts, type_info, wfile);
+    if (!config::enable_json_flat_storage) {
+        return std::unique_ptr<ColumnWriter>(std::move(json_writer));
+    }
+    return std::make_unique<FlatJsonColumnWriter>(opts, std::move(type_info), wfile, std::move(json_writer));
+}
+
+FlatJsonColumnWriter::FlatJsonColumnWriter(const ColumnWriterOptions& opts, TypeInfoPtr type_info,
+                                           WritableFile* wfile, std::unique_ptr<ScalarColumnWriter> json_writer)
+        : ColumnWriter(std::move(type_info), opts.meta->length(), opts.meta->is_nullable()),
+          _opts(opts),
+          _wfile(wfile),
+          _json_writer(std::move(json_writer)) {}
+
+Status FlatJsonColumnWriter::_init_flat_writers(const JsonColumn& json_column, const uint8_t* nulls) {
+    const int32_t max_subcolumns = config::json_flat_max_subcolumns;
+    RETURN_IF(max_subcolumns <= 0, Status::OK());
+
+    // (field name, type) => the number of rows having the field of the type
+    std::map<std::pair<std::string, LogicalType>, size_t> counts;
+    const size_t num_rows = std::min(json_column.size(), kMaxSampleRows);
+    size_t num_sampled = 0;
+    try {
+        for (size_t i = 0; i < num_rows; i++) {
+            if (nulls != nullptr && nulls[i]) {
+                continue;
+            }
+            num_sampled++;
+            vpack::Slice vslice = json_column.get_object(i)->to_vslice();
+            if (!vslice.isObject()) {
+                continue;
+            }
+            for (const auto& it : vpack::ObjectIterator(vslice)) {
+                LogicalType type = flat_type_of(it.value);
+                if (type != TYPE_UNKNOWN) {
+                    counts[{it.key.copyString(), type}]++;
+                }
+            }
+        }
+    } catch (const vpack::Exception& e) {
+        return fromVPackException(e);
+    }
+    RETURN_IF(num_sampled == 0, Status::OK());
+
+    const double min_rows = std::max(config::json_flat_min_frequency * num_sampled, 1.0);
+    std::vector<std::pair<const std::pair<std::string, LogicalType>*, size_t>> candidates;
+    for (const auto& [field, count] : counts) {
+        if (count >= min_rows) {
+            candidates.emplace_back(&field, count);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
+        return a.second != b.second ? a.second > b.second : *a.first < *b.first;
+    });
+    for (const auto& [field, count] : candidates) {
+        if (_flat_paths.size() >= static_cast<size_t>(max_subcolumns)) {
+            break;
+        }
+        // a field may be frequent with more than one type if the frequency is not above 0.5
+        if (std::find(_flat_paths.begin(), _flat_paths.end(), field->first) != _flat_paths.end()) {
+            continue;
+        }
+        _flat_paths.emplace_back(field->first);
+        _flat_types.emplace_back(field->second);
+    }
+    RETURN_IF(_flat_paths.empty(), Status::OK());
+
+    JsonMetaPB* json_meta = _opts.meta->mutable_json_meta();
+    json_meta->set_format_version(kJsonMetaFlatFormatVersion);
+    for (size_t i = 0; i < _flat_paths.size(); i++) {
+        LogicalType type = _flat_types[i];
+        json_meta->add_flat_paths(_flat_paths[i]);
+        _flat_index.emplace(_flat_paths[i], i);
+
+        TabletColumn flat_column(STORAGE_AGGREGATE_NONE, type, true);
+        flat_column.set_length(type == TYPE_VARCHAR ? TypeDescriptor::MAX_VARCHAR_LENGTH
+                                                    : get_type_info(type)->size());
+
+        ColumnWriterOptions flat_opts;
+        flat_opts.meta = _opts.meta->add_children_columns();
+        flat_opts.meta->set_column_id(_opts.meta->column_id());
+        flat_opts.meta->set_unique_id(_opts.meta->unique_id());
+        flat_opts.meta->set_type(type);
+        flat_opts.meta->set_length(flat_column.length());
+        flat_opts.meta->set_encoding(DEFAULT_ENCODING);
+        flat_opts.meta->set_compression(_opts.meta->compression());
+        flat_opts.meta->set_is_nullable(true);
+        flat_opts.data_page_size = _opts.data_page_size;
+        flat_opts.compression_min_space_saving = _opts.compression_min_space_saving;
+        flat_opts.need_zone_map = is_zone_map_key_type(type);
+        ASSIGN_OR_RETURN(auto writer, ColumnWriter::create(flat_opts, &flat_column, _wfile));
+        RETURN_IF_ERROR(writer->init());
+        _flat_writers.emplace_back(std::move(writer));
+    }
+    _flat_complete.assign(_flat_paths.size(), true);
+    _extracted.resize(_flat_paths.size());
+    return Status::OK();
+}
+
+void FlatJsonColumnWriter::_flatten(const JsonValue& json, JsonColumn* remainder, const Columns& flat_columns) {
+    std::fill(_extracted.begin(), _extracted.end(), 0);
+    vpack::Slice vslice = json.to_vslice();
+    if (!vslice.isObject()) {
+        remainder->append(&json);
+    } else {
+        vpack::Builder builder;
+        bool any_extracted = false;
+        {
+            vpack::ObjectBuilder ob(&builder);
+            for (const auto& it : vpack::ObjectIterator(vslice)) {
+                auto key = it.key.stringRef();
+                auto iter = _flat_index.find(std::string_view(key.data(), key.size()));
+                if (iter != _flat_index.end()) {
+                    size_t idx = iter->second;
+                    if (!_extracted[idx] && flat_type_of(it.value) == _flat_types[idx]) {
+                        Column* dst = flat_columns[idx].get();
+                        switch (_flat_types[idx]) {
+                        case TYPE_BIGINT:
+                            dst->append_datum(Datum(it.value.getNumber<int64_t>()));
+                            break;
+                        case TYPE_DOUBLE:
+                            dst->append_datum(Datum(it.value.getDouble()));
+                            break;
+                        case TYPE_BOOLEAN:
+                            dst->append_datum(Datum(static_cast<uint8_t>(it.value.getBool())));
+                            break;
+                        default: {
+                            auto str = it.value.stringRef();
+                            dst->append_datum(Datum(Slice(str.data(), str.size())));
+                            break;
+                        }
+                        }
+                        _extracted[idx] = 1;
+                        any_extracted = true;
+                        continue;
+                    }
+                    // the value of another type or a duplicated field is kept in the remainder
+                    _flat_complete[idx] = false;
+                }
+                builder.add(key, it.value);
+            }
+        }
+        if (any_extracted) {
+            remainder->append(JsonValue(builder.slice()));
+        } else {
+            remainder->append(&json);
+        }
+    }
+    for (size_t i = 0; i < _extracted.size(); i++) {
+        if (!_extracted[i]) {
+            flat_columns[i]->append_nulls(1);
+        }
+    }
+}
+
+Status FlatJsonColumnWriter::append(const Column& column) {
+    const JsonColumn* json_column = nullptr;
+    const uint8_t* nulls = nullptr;
+    if (column.is_nullable()) {
+        const auto& nullable_column = down_cast<const NullableColumn&>(column);
+        json_column = down_cast<const JsonColumn*>(nullable_column.data_column().get());
+        nulls = nullable_column.has_null() ? nullable_column.immutable_null_column_data().data() : nullptr;
+    } else {
+        json_column = down_cast<const JsonColumn*>(&column);
+    }
+    if (!_flat_inited) {
+        _flat_inited = true;
+        RETURN_IF_ERROR(_init_flat_writers(*json_column, nulls));
+    }
+    if (_flat_writers.empty()) {
+        return _json_writer->append(column);
+    }
+
+    const size_t num_rows = json_column->size();
+    auto remainder = JsonColumn::create();
+    remainder->reserve(num_rows);
+    Columns flat_columns;
+    for (LogicalType type : _flat_types) {
+        auto flat_column = ColumnHelper::create_column(TypeDescriptor(type), true);
+        flat_column->reserve(num_rows);
+        flat_columns.emplace_back(std::move(flat_column));
+    }
+    try {
+        for (size_t i = 0; i < num_rows; i++) {
+            if (nulls != nullptr && nulls[i]) {
+                remainder->append_default();
+                for (auto& flat_column : flat_columns) {
+                    flat_column->append_nulls(1);
+                }
+                continue;
+            }
+            _flatten(*json_column->get_object(i), remainder.get(), flat_columns);
+        }
+    } catch (const vpack::Exception& e) {
+        return fromVPackException(e);
+    }
+
+    if (column.is_nullable()) {
+        NullableColumn remainder_column(remainder, down_cast<const NullableColumn&>(column).null_column());
+        RETURN_IF_ERROR(_json_writer->append(remainder_column));
+    } else {
+        RETURN_IF_ERROR(_json_writer->append(*remainder));
+    }
+    for (size_t i = 0; i < _flat_writers.size(); i++) {
+        RETURN_IF_ERROR(_flat_writers[i]->append(*flat_columns[i]));
+    }
+    return Status::OK();
+}
+
+uint64_t FlatJsonColumnWriter::estimate_buffer_size() {
+    uint64_t size = _json_writer->estimate_buffer_size();
+    for (auto& writer : _flat_writers) {
+        size += writer->estimate_buffer_size();
+    }
+    return size;
+}
+
+Status FlatJsonColumnWriter::finish() {
+    RETURN_IF_ERROR(_json_writer->finish());
+    for (auto& writer : _flat_writers) {
+        RETURN_IF_ERROR(writer->finish());
+    }
+    if (!_flat_writers.empty()) {
+        JsonMetaPB* json_meta = _opts.meta->mutable_json_meta();
+        json_meta->clear_flat_path_complete();
+        for (bool complete : _flat_complete) {
+            json_meta->add_flat_path_complete(complete);
+        }
+        _opts.meta->set_total_mem_footprint(total_mem_footprint());
+    }
+    return Status::OK();
+}
+
+uint64_t FlatJsonColumnWriter::total_mem_footprint() const {
+    uint64_t total_mem_footprint = _json_writer->total_mem_footprint();
+    for (auto& writer : _flat_writers) {
+        total_mem_footprint += writer->total_mem_footprint();
+    }
+    return total_mem_footprint;
+}
+
+Status FlatJsonColumnWriter::write_data() {
+    RETURN_IF_ERROR(_json_writer->write_data());
+    for (auto& writer : _flat_writers) {
+        RETURN_IF_ERROR(writer->write_data());
+    }
+    return Status::OK();
+}
+
+Status FlatJsonColumnWriter::write_ordinal_index() {
+    RETURN_IF_ERROR(_json_writer->write_ordinal_index());
+    for (auto& writer : _flat_writers) {
+        RETURN_IF_ERROR(writer->write_ordinal_index());
+    }
+    return Status::OK();
+}
+
+Status FlatJsonColumnWriter::write_zone_map() {
+    RETURN_IF_ERROR(_json_writer->write_zone_map());
+    for (auto& writer : _flat_writers) {
+        RETURN_IF_ERROR(writer->write_zone_map());
+    }
+    return Status::OK();
+}
+
+Status FlatJsonColumnWriter::finish_current_page() {
+    RETURN_IF_ERROR(_json_writer->finish_current_page());
+    for (auto& writer : _flat_writers) {
+        RETURN_IF_ERROR(writer->finish_current_page());
+    }
+    return Status::OK();
+}
+
+} // namespace starrocks
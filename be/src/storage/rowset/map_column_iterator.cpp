@@ -37,8 +37,13 @@ Status MapColumnIterator::init(const ColumnIteratorOptions& opts) {
         RETURN_IF_ERROR(_nulls->init(opts));
     }
     RETURN_IF_ERROR(_offsets->init(opts));
-    RETURN_IF_ERROR(_keys->init(opts));
-    RETURN_IF_ERROR(_values->init(opts));
+    _lengths_only = opts.lengths_only;
+    if (!_lengths_only) {
+        ColumnIteratorOptions element_opts = opts;
+        element_opts.lengths_only = false;
+        RETURN_IF_ERROR(_keys->init(element_opts));
+        RETURN_IF_ERROR(_values->init(element_opts));
+    }
     return Status::OK();
 }
 
@@ -80,6 +85,11 @@ Status MapColumnIterator::next_batch(size_t* n, Column* dst) {
     num_to_read = end_offset - num_to_read;
 
     // 3. Read elements
+    if (_lengths_only) {
+        map_column->keys_column()->append_default(num_to_read);
+        map_column->values_column()->append_default(num_to_read);
+        return Status::OK();
+    }
     RETURN_IF_ERROR(_keys->next_batch(&num_to_read, map_column->keys_column().get()));
     RETURN_IF_ERROR(_values->next_batch(&num_to_read, map_column->values_column().get()));
 
@@ -119,7 +129,7 @@ Status MapColumnIterator::next_batch(const SparseRange& range, Column* dst) {
         size_t element_ordinal = _offsets->element_ordinal();
         // if array column in nullable or element of array is empty, element_read_range may be empty.
         // so we should reseek the element_ordinal
-        if (element_read_range.span_size() == 0) {
+        if (element_read_range.span_size() == 0 && !_lengths_only) {
             _keys->seek_to_ordinal(element_ordinal);
             _values->seek_to_ordinal(element_ordinal);
         }
@@ -146,6 +156,11 @@ Status MapColumnIterator::next_batch(const SparseRange& range, Column* dst) {
         element_read_range.add(Range(element_ordinal, element_ordinal + num_to_read));
     }
 
+    if (_lengths_only) {
+        map_column->keys_column()->append_default(element_read_range.span_size());
+        map_column->values_column()->append_default(element_read_range.span_size());
+        return Status::OK();
+    }
     // if array column is nullable, element_read_range may be empty
     DCHECK(element_read_range.empty() || (element_read_range.begin() == _keys->get_current_ordinal()));
     RETURN_IF_ERROR(_keys->next_batch(element_read_range, map_column->keys_column().get()));
@@ -185,6 +200,12 @@ Status MapColumnIterator::fetch_values_by_rowid(const rowid_t* rowids, size_t si
     }
 
     // 3. Read elements
+    if (_lengths_only) {
+        const size_t num_elements = offset - map_column->keys_column()->size();
+        map_column->keys_column()->append_default(num_elements);
+        map_column->values_column()->append_default(num_elements);
+        return Status::OK();
+    }
     for (size_t i = 0; i < size; ++i) {
         RETURN_IF_ERROR(_offsets->seek_to_ordinal_and_calc_element_ordinal(rowids[i]));
         size_t element_ordinal = _offsets->element_ordinal();
@@ -204,8 +225,10 @@ Status MapColumnIterator::seek_to_first() {
         RETURN_IF_ERROR(_nulls->seek_to_first());
     }
     RETURN_IF_ERROR(_offsets->seek_to_first());
-    RETURN_IF_ERROR(_keys->seek_to_first());
-    RETURN_IF_ERROR(_values->seek_to_first());
+    if (!_lengths_only) {
+        RETURN_IF_ERROR(_keys->seek_to_first());
+        RETURN_IF_ERROR(_values->seek_to_first());
+    }
     return Status::OK();
 }
 
@@ -214,9 +237,11 @@ Status MapColumnIterator::seek_to_ordinal(ordinal_t ord) {
         RETURN_IF_ERROR(_nulls->seek_to_ordinal(ord));
     }
     RETURN_IF_ERROR(_offsets->seek_to_ordinal_and_calc_element_ordinal(ord));
-    size_t element_ordinal = _offsets->element_ordinal();
-    RETURN_IF_ERROR(_keys->seek_to_ordinal(element_ordinal));
-    RETURN_IF_ERROR(_values->seek_to_ordinal(element_ordinal));
+    if (!_lengths_only) {
+        size_t element_ordinal = _offsets->element_ordinal();
+        RETURN_IF_ERROR(_keys->seek_to_ordinal(element_ordinal));
+        RETURN_IF_ERROR(_values->seek_to_ordinal(element_ordinal));
+    }
     return Status::OK();
 }
 
@@ -53,6 +53,8 @@ private:
     std::unique_ptr<ColumnIterator> _offsets;
     std::unique_ptr<ColumnIterator> _keys;
     std::unique_ptr<ColumnIterator> _values;
+    // The keys and values are not decoded, see ColumnIteratorOptions::lengths_only.
+    bool _lengths_only = false;
 };
 
 } // namespace starrocks
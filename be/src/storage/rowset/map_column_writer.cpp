@@ -17,6 +17,7 @@
 #include "common/status.h"
 #include "gutil/casts.h"
 #include "storage/rowset/column_writer.h"
+#include "types/logical_type.h"
 
 namespace starrocks {
 
@@ -41,11 +42,11 @@ public:
 
     Status finish_current_page() override;
 
-    Status write_zone_map() override { return Status::OK(); }
+    Status write_zone_map() override;
 
     Status write_bitmap_index() override { return Status::OK(); }
 
-    Status write_bloom_filter_index() override { return Status::OK(); }
+    Status write_bloom_filter_index() override;
 
     ordinal_t get_next_rowid() const override { return _offsets_writer->get_next_rowid(); }
 
@@ -70,7 +71,8 @@ StatusOr<std::unique_ptr<ColumnWriter>> create_map_column_writer(const ColumnWri
         const TabletColumn& key_column = column->subcolumn(0);
         ColumnWriterOptions key_options;
         key_options.meta = opts.meta->mutable_children_columns(0);
-        key_options.need_zone_map = false;
+        key_options.need_zone_map = opts.need_subfield_zone_map && is_zone_map_key_type(key_column.type());
+        key_options.need_subfield_zone_map = opts.need_subfield_zone_map;
         key_options.need_bloom_filter = key_column.is_bf_column();
         key_options.need_bitmap_index = key_column.has_bitmap_index();
         if (key_column.type() == LogicalType::TYPE_ARRAY) {
@@ -90,7 +92,8 @@ StatusOr<std::unique_ptr<ColumnWriter>> create_map_column_writer(const ColumnWri
         const TabletColumn& value_column = column->subcolumn(1);
         ColumnWriterOptions value_options;
         value_options.meta = opts.meta->mutable_children_columns(1);
-        value_options.need_zone_map = false;
+        value_options.need_zone_map = opts.need_subfield_zone_map && is_zone_map_key_type(value_column.type());
+        value_options.need_subfield_zone_map = opts.need_subfield_zone_map;
         value_options.need_bloom_filter = value_column.is_bf_column();
         value_options.need_bitmap_index = value_column.has_bitmap_index();
         if (value_column.type() == LogicalType::TYPE_ARRAY) {
@@ -242,6 +245,16 @@ Status MapColumnWriter::write_ordinal_index() {
     return Status::OK();
 }
 
+Status MapColumnWriter::write_zone_map() {
+    RETURN_IF_ERROR(_keys_writer->write_zone_map());
+    return _values_writer->write_zone_map();
+}
+
+Status MapColumnWriter::write_bloom_filter_index() {
+    RETURN_IF_ERROR(_keys_writer->write_bloom_filter_index());
+    return _values_writer->write_bloom_filter_index();
+}
+
 Status MapColumnWriter::finish_current_page() {
     if (is_nullable()) {
         RETURN_IF_ERROR(_nulls_writer->finish_current_page());
@@ -35,6 +35,7 @@
 #pragma once
 
 #include <cstdint>
+#include <string>
 #include <vector>
 
 #include "common/status.h"
@@ -86,6 +87,15 @@ public:
     // check global dict valid for dictionary encoding mode column.
     virtual bool is_valid_global_dict(const GlobalDictMap* global_dict) const { return true; }
 
+    // Add |words| to the dictionary of a dictionary encoding mode column, so they get the codes
+    // [0, words.size()) whether they appear in the data or not.
+    // This method can only be called on an *empty* page builder. Return false and leave the
+    // dictionary empty if the words do not fit in the dictionary page.
+    virtual bool seed_dictionary(const std::vector<std::string>& words) { return false; }
+
+    // Return the words of the dictionary ordered by their codes, for dictionary encoding mode column.
+    virtual std::vector<std::string> dictionary_words() const { return {}; }
+
     // Reset the internal state of the page builder.
     //
     // Any data previously returned by finish may be invalidated by this call.
@@ -42,6 +42,7 @@
 
 namespace starrocks {
 class Column;
+class ColumnPredicate;
 }
 
 namespace starrocks {
@@ -102,6 +103,14 @@ public:
         return Status::NotSupported("PageDecoder Not Support");
     }
 
+    // Evaluate |pred| on the encoded values of [from, to) in this page, without decoding them.
+    // selection[i - from] is set to 1 if the value i matches, and 0 otherwise.
+    // The position of the decoder is not changed.
+    // Return NotSupported if the encoding or the predicate is not supported.
+    virtual Status evaluate(const ColumnPredicate& pred, uint32_t from, uint32_t to, uint8_t* selection) {
+        return Status::NotSupported("evaluate() not supported");
+    }
+
     // Return the number of elements in this page.
     virtual uint32_t count() const = 0;
 
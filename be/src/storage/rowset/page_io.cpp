@@ -34,10 +34,15 @@
 
 #include "storage/rowset/page_io.h"
 
+#include <array>
+#include <condition_variable>
 #include <cstring>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include "column/column.h"
+#include "common/config.h"
 #include "common/logging.h"
 #include "fs/fs.h"
 #include "gutil/strings/substitute.h"
@@ -46,6 +51,7 @@
 #include "util/coding.h"
 #include "util/compression/block_compression.h"
 #include "util/crc32c.h"
+#include "util/defer_op.h"
 #include "util/faststring.h"
 #include "util/runtime_profile.h"
 #include "util/scoped_cleanup.h"
@@ -128,6 +134,83 @@ Status PageIO::write_page(WritableFile* wfile, const std::vector<Slice>& body, c
     return Status::OK();
 }
 
+namespace {
+
+// SharedPageReads makes the concurrent readers of the same page missing in the page cache cooperate.
+// The first reader becomes the leader to read the page from file and insert it into the page cache,
+// and the other readers wait for the leader and then look up the page cache again.
+class SharedPageReads {
+public:
+    struct Flight {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool done = false;
+    };
+    using FlightPtr = std::shared_ptr<Flight>;
+
+    static SharedPageReads* instance() {
+        static SharedPageReads instance;
+        return &instance;
+    }
+
+    // Return the in-flight read of the page, and whether the caller is the leader to read it.
+    std::pair<FlightPtr, bool> join(const std::string& key) {
+        auto& shard = _shard(key);
+        std::lock_guard<std::mutex> l(shard.mutex);
+        auto [it, inserted] = shard.flights.try_emplace(key, nullptr);
+        if (inserted) {
+            it->second = std::make_shared<Flight>();
+        }
+        return {it->second, inserted};
+    }
+
+    // Called by the leader after reading the page, whether it succeeds or not.
+    void finish(const std::string& key, const FlightPtr& flight) {
+        {
+            auto& shard = _shard(key);
+            std::lock_guard<std::mutex> l(shard.mutex);
+            shard.flights.erase(key);
+        }
+        {
+            std::lock_guard<std::mutex> l(flight->mutex);
+            flight->done = true;
+        }
+        flight->cv.notify_all();
+    }
+
+    static void wait(const FlightPtr& flight) {
+        std::unique_lock<std::mutex> l(flight->mutex);
+        flight->cv.wait(l, [&flight] { return flight->done; });
+    }
+
+private:
+    static constexpr size_t NUM_SHARDS = 64;
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<std::string, FlightPtr> flights;
+    };
+
+    Shard& _shard(const std::string& key) { return _shards[std::hash<std::string>()(key) % NUM_SHARDS]; }
+
+    std::array<Shard, NUM_SHARDS> _shards;
+};
+
+Status parse_cached_page(PageHandle* handle, Slice* body, PageFooterPB* footer) {
+    Slice page_slice = handle->data();
+    uint32_t footer_size = decode_fixed32_le((uint8_t*)page_slice.data + page_slice.size - 4);
+    std::string footer_buf(page_slice.data + page_slice.size - 4 - footer_size, footer_size);
+    if (!footer->ParseFromString(footer_buf)) {
+        return Status::Corruption("Bad page: invalid footer");
+    }
+    *body = Slice(page_slice.data, page_slice.size - 4 - footer_size);
+    return Status::OK();
+}
+
+Status read_and_decompress_page_from_file(const PageReadOptions& opts, const StoragePageCache::CacheKey& cache_key,
+                                          PageHandle* handle, Slice* body, PageFooterPB* footer);
+
+} // namespace
+
 Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle* handle, Slice* body,
                                         PageFooterPB* footer) {
     // the function will be used by query or load, current load is not allowed to fail when memory reach the limit,
@@ -144,17 +227,43 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
         // we find page in cache, use it
         *handle = PageHandle(std::move(cache_handle));
         opts.stats->cached_pages_num++;
-        // parse body and footer
-        Slice page_slice = handle->data();
-        uint32_t footer_size = decode_fixed32_le((uint8_t*)page_slice.data + page_slice.size - 4);
-        std::string footer_buf(page_slice.data + page_slice.size - 4 - footer_size, footer_size);
-        if (!footer->ParseFromString(footer_buf)) {
-            return Status::Corruption("Bad page: invalid footer");
+        return parse_cached_page(handle, body, footer);
+    }
+
+    if (opts.use_page_cache && config::enable_storage_page_cache_shared_read) {
+        auto* shared_reads = SharedPageReads::instance();
+        const std::string encoded_key = cache_key.encode();
+        auto [flight, is_leader] = shared_reads->join(encoded_key);
+        if (is_leader) {
+            DeferOp finish_flight([shared_reads, &encoded_key, flight = flight] {
+                shared_reads->finish(encoded_key, flight);
+            });
+            return read_and_decompress_page_from_file(opts, cache_key, handle, body, footer);
+        }
+
+        {
+            SCOPED_RAW_TIMER(&opts.stats->io_ns);
+            SharedPageReads::wait(flight);
+        }
+        // The leader may fail to read the page, or the page has been evicted, so read it by self in this case.
+        if (cache->lookup(cache_key, &cache_handle)) {
+            *handle = PageHandle(std::move(cache_handle));
+            opts.stats->cached_pages_num++;
+            opts.stats->shared_read_pages_num++;
+            return parse_cached_page(handle, body, footer);
         }
-        *body = Slice(page_slice.data, page_slice.size - 4 - footer_size);
-        return Status::OK();
     }
 
+    return read_and_decompress_page_from_file(opts, cache_key, handle, body, footer);
+}
+
+namespace {
+
+Status read_and_decompress_page_from_file(const PageReadOptions& opts, const StoragePageCache::CacheKey& cache_key,
+                                          PageHandle* handle, Slice* body, PageFooterPB* footer) {
+    auto cache = StoragePageCache::instance();
+    PageCacheHandle cache_handle;
+
     // every page contains 4 bytes footer length and 4 bytes checksum
     const uint32_t page_size = opts.page_pointer.size;
     if (page_size < 8) {
@@ -237,4 +346,6 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
     return Status::OK();
 }
 
+} // namespace
+
 } // namespace starrocks
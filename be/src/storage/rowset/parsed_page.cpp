@@ -298,6 +298,17 @@ public:
         return Status::OK();
     }
 
+    Status evaluate(const ColumnPredicate& pred, ordinal_t from, ordinal_t to, uint8_t* selection) override {
+        RETURN_IF_ERROR(_data_decoder->evaluate(pred, from, to, selection));
+        if (_null_flags.size() > 0) {
+            const uint8_t* null_flags = _null_flags.data() + from;
+            for (size_t i = 0; i < to - from; i++) {
+                selection[i] &= !null_flags[i];
+            }
+        }
+        return Status::OK();
+    }
+
 private:
     friend Status parse_page_v2(std::unique_ptr<ParsedPage>* result, PageHandle handle, const Slice& body,
                                 const DataPageFooterPB& footer, const EncodingInfo* encoding,
@@ -45,6 +45,7 @@ namespace starrocks {
 class Slice;
 class Status;
 class Column;
+class ColumnPredicate;
 class DataPageFooterPB;
 class EncodingInfo;
 class PageHandle;
@@ -112,6 +113,14 @@ public:
 
     virtual Status read_dict_codes(Column* column, const SparseRange& range) = 0;
 
+    // Evaluate |pred| on the encoded records of [from, to) in this page without reading them into a column,
+    // |from| and |to| are relative to first_ordinal(). selection[i - from] is set to 1 if the record i is not
+    // null and matches |pred|, and 0 otherwise. The page offset is not changed.
+    // Return NotSupported if the page can't evaluate |pred| on its encoded records.
+    virtual Status evaluate(const ColumnPredicate& pred, ordinal_t from, ordinal_t to, uint8_t* selection) {
+        return Status::NotSupported("evaluate() not supported");
+    }
+
 protected:
     uint32_t _page_index{0};
     uint64_t _num_rows{0};
@@ -53,6 +53,8 @@
 #include "storage/merge_iterator.h"
 #include "storage/projection_iterator.h"
 #include "storage/rowset/rowid_range_option.h"
+#include "storage/rowset/segment_meta_cache.h"
+#include "storage/rowset/shared_dictionary.h"
 #include "storage/storage_engine.h"
 #include "storage/union_iterator.h"
 #include "storage/update_manager.h"
@@ -249,6 +251,9 @@ Status Rowset::remove() {
         auto st = fs->delete_file(path);
         LOG_IF(WARNING, !st.ok()) << "Fail to delete " << path << ": " << st;
         merge_status(st);
+        if (auto* meta_cache = SegmentMetaCache::of(path); meta_cache != nullptr) {
+            meta_cache->erase(path);
+        }
     }
     for (int i = 0, sz = num_delete_files(); i < sz; ++i) {
         std::string path = segment_del_file_path(_rowset_path, rowset_id(), i);
@@ -363,6 +368,9 @@ Status Rowset::get_segment_iterators(const Schema& schema, const RowsetReadOptio
     RowsetReleaseGuard guard(shared_from_this());
 
     RETURN_IF_ERROR(load());
+    if (options.reader_type == READER_QUERY) {
+        _num_query_scans.fetch_add(1, std::memory_order_relaxed);
+    }
 
     SegmentReadOptions seg_options;
     ASSIGN_OR_RETURN(seg_options.fs, FileSystem::CreateSharedFromString(_rowset_path));
@@ -371,11 +379,16 @@ Status Rowset::get_segment_iterators(const Schema& schema, const RowsetReadOptio
     seg_options.predicates = options.predicates;
     seg_options.predicates_for_zone_map = options.predicates_for_zone_map;
     seg_options.use_page_cache = options.use_page_cache;
+    seg_options.use_direct_io = options.use_direct_io;
     seg_options.profile = options.profile;
     seg_options.reader_type = options.reader_type;
     seg_options.chunk_size = options.chunk_size;
     seg_options.global_dictmaps = options.global_dictmaps;
+    if (!options.global_dictmaps->empty()) {
+        seg_options.shared_dict_code_maps = std::make_shared<SharedDictCodeConvertMaps>();
+    }
     seg_options.unused_output_column_ids = options.unused_output_column_ids;
+    seg_options.lengths_only_column_ids = options.lengths_only_column_ids;
     seg_options.runtime_range_pruner = options.runtime_range_pruner;
     if (options.delete_predicates != nullptr) {
         seg_options.delete_predicates = options.delete_predicates->get_predicates(end_version());
@@ -207,6 +207,9 @@ public:
     uint32_t num_delete_files() const { return rowset_meta()->get_num_delete_files(); }
     bool has_data_files() const { return num_segments() > 0 || num_delete_files() > 0; }
 
+    // The number of the times this rowset is scanned by the queries since it's loaded.
+    int64_t num_query_scans() const { return _num_query_scans.load(std::memory_order_relaxed); }
+
     // remove all files in this rowset
     // TODO should we rename the method to remove_files() to be more specific?
     Status remove();
@@ -346,6 +349,7 @@ private:
     int64_t _mem_usage() const { return sizeof(Rowset) + _rowset_path.length(); }
 
     std::vector<SegmentSharedPtr> _segments;
+    std::atomic<int64_t> _num_query_scans{0};
 };
 
 class RowsetReleaseGuard {
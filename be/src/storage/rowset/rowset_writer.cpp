@@ -37,6 +37,7 @@
 #include <butil/iobuf.h>
 #include <butil/reader_writer.h>
 #include <fmt/format.h>
+#include <unistd.h>
 
 #include <ctime>
 #include <memory>
@@ -58,9 +59,12 @@
 #include "storage/row_source_mask.h"
 #include "storage/rowset/rowset.h"
 #include "storage/rowset/rowset_factory.h"
+#include "storage/rowset/segment_piece_writable_file.h"
+#include "storage/rowset/shared_dictionary.h"
 #include "storage/storage_engine.h"
 #include "storage/tablet_manager.h"
 #include "storage/type_utils.h"
+#include "util/crc32c.h"
 #include "util/pretty_printer.h"
 
 namespace starrocks {
@@ -89,9 +93,29 @@ ssize_t SegmentFileWriter::WriteV(const iovec* iov, int iovcnt) {
     }
 }
 
+static uint32_t crc32c_extend(uint32_t crc, const butil::IOBuf& buf) {
+    for (size_t i = 0; i < buf.backing_block_num(); i++) {
+        auto block = buf.backing_block(i);
+        crc = crc32c::Extend(crc, block.data(), block.size());
+    }
+    return crc;
+}
+
 RowsetWriter::RowsetWriter(const RowsetWriterContext& context)
         : _context(context), _num_rows_written(0), _total_row_size(0), _total_data_size(0), _total_index_size(0) {}
 
+RowsetWriter::~RowsetWriter() {
+    // the segments whose last piece has not been received
+    for (auto& [segment_id, segment] : _streaming_segments) {
+        if (segment.file != nullptr) {
+            auto path = segment.file->filename();
+            (void)segment.file->close();
+            segment.file.reset();
+            (void)_fs->delete_file(path);
+        }
+    }
+}
+
 Status RowsetWriter::init() {
     _rowset_meta_pb = std::make_unique<RowsetMetaPB>();
     _rowset_meta_pb->set_deprecated_rowset_id(0);
@@ -117,6 +141,9 @@ Status RowsetWriter::init() {
 
     _writer_options.global_dicts = _context.global_dicts != nullptr ? _context.global_dicts : nullptr;
     _writer_options.referenced_column_ids = _context.referenced_column_ids;
+    if (config::enable_shared_segment_dictionary) {
+        _writer_options.shared_dicts = std::make_shared<SharedDictionaries>();
+    }
 
     if (_context.tablet_schema->keys_type() == KeysType::PRIMARY_KEYS &&
         (_context.partial_update_tablet_schema || !_context.merge_condition.empty() ||
@@ -210,26 +237,55 @@ StatusOr<RowsetSharedPtr> RowsetWriter::build() {
 }
 
 Status RowsetWriter::flush_segment(const SegmentPB& segment_pb, butil::IOBuf& data) {
-    if (data.size() != segment_pb.data_size() + segment_pb.delete_data_size()) {
-        return Status::InternalError(fmt::format("segment size {} + delete file size {} not equal attachment size {}",
-                                                 segment_pb.data_size(), segment_pb.delete_data_size(), data.size()));
+    if (segment_pb.has_piece_offset()) {
+        return _flush_segment_piece(segment_pb, data);
+    }
+    // the bytes streamed by pieces are not attached
+    const int64_t attached_data_size = segment_pb.data_size() - segment_pb.streamed_size();
+    if (data.size() != attached_data_size + segment_pb.delete_data_size()) {
+        return Status::InternalError(fmt::format(
+                "segment size {} - streamed size {} + delete file size {} not equal attachment size {}",
+                segment_pb.data_size(), segment_pb.streamed_size(), segment_pb.delete_data_size(), data.size()));
     }
 
     if (segment_pb.has_path()) {
-        // 1. create segment file
-        auto path = Rowset::segment_file_path(_context.rowset_path_prefix, _context.rowset_id, segment_pb.segment_id());
-        // use MUST_CREATE make sure atomic
-        ASSIGN_OR_RETURN(auto wfile, _fs->new_writable_file(path));
+        // 1. create segment file, or continue the one streamed by pieces
+        std::unique_ptr<WritableFile> wfile;
+        uint32_t checksum = 0;
+        if (segment_pb.streamed_size() > 0) {
+            auto iter = _streaming_segments.find(segment_pb.segment_id());
+            int64_t received_size = iter != _streaming_segments.end() ? iter->second.size : 0;
+            if (received_size != segment_pb.streamed_size() || iter->second.file == nullptr) {
+                return Status::InternalError(fmt::format("segment {} streamed size {} not equal received size {}",
+                                                         segment_pb.segment_id(), segment_pb.streamed_size(),
+                                                         received_size));
+            }
+            wfile = std::move(iter->second.file);
+            checksum = iter->second.checksum;
+            _streaming_segments.erase(iter);
+        } else {
+            auto path =
+                    Rowset::segment_file_path(_context.rowset_path_prefix, _context.rowset_id, segment_pb.segment_id());
+            // use MUST_CREATE make sure atomic
+            ASSIGN_OR_RETURN(wfile, _fs->new_writable_file(path));
+        }
+        const auto& path = wfile->filename();
 
         // 2. flush segment file
         auto writer = std::make_unique<SegmentFileWriter>(wfile.get());
 
         butil::IOBuf segment_data;
-        int64_t remaining_bytes = data.cutn(&segment_data, segment_pb.data_size());
-        if (remaining_bytes != segment_pb.data_size()) {
+        int64_t remaining_bytes = data.cutn(&segment_data, attached_data_size);
+        if (remaining_bytes != attached_data_size) {
             return Status::InternalError(fmt::format("segment {} file size {} not equal attachment size {}",
-                                                     segment_pb.DebugString(), remaining_bytes,
-                                                     segment_pb.data_size()));
+                                                     segment_pb.DebugString(), remaining_bytes, attached_data_size));
+        }
+        if (segment_pb.has_checksum()) {
+            checksum = crc32c_extend(checksum, segment_data);
+            if (checksum != segment_pb.checksum()) {
+                return Status::Corruption(fmt::format("segment {} checksum {} not equal expected checksum {}", path,
+                                                      checksum, segment_pb.checksum()));
+            }
         }
         while (remaining_bytes > 0) {
             auto written_bytes = segment_data.cut_into_writer(writer.get(), remaining_bytes);
@@ -240,8 +296,8 @@ Status RowsetWriter::flush_segment(const SegmentPB& segment_pb, butil::IOBuf& da
         }
         if (remaining_bytes != 0) {
             return Status::InternalError(fmt::format("segment {} write size {} not equal expected size {}",
-                                                     wfile->filename(), segment_pb.data_size() - remaining_bytes,
-                                                     segment_pb.data_size()));
+                                                     wfile->filename(), attached_data_size - remaining_bytes,
+                                                     attached_data_size));
         }
         if (config::sync_tablet_meta) {
             RETURN_IF_ERROR(wfile->sync());
@@ -312,6 +368,33 @@ Status RowsetWriter::flush_segment(const SegmentPB& segment_pb, butil::IOBuf& da
     return Status::OK();
 }
 
+Status RowsetWriter::_flush_segment_piece(const SegmentPB& segment_pb, butil::IOBuf& data) {
+    auto& segment = _streaming_segments[segment_pb.segment_id()];
+    if (segment.file == nullptr) {
+        if (segment_pb.piece_offset() != 0) {
+            return Status::InternalError(fmt::format("segment {} piece offset {} without the previous pieces",
+                                                     segment_pb.segment_id(), segment_pb.piece_offset()));
+        }
+        auto path = Rowset::segment_file_path(_context.rowset_path_prefix, _context.rowset_id, segment_pb.segment_id());
+        // use MUST_CREATE make sure atomic
+        ASSIGN_OR_RETURN(segment.file, _fs->new_writable_file(path));
+    }
+    if (segment_pb.piece_offset() != segment.size) {
+        return Status::InternalError(fmt::format("segment {} piece offset {} not equal received size {}",
+                                                 segment.file->filename(), segment_pb.piece_offset(), segment.size));
+    }
+    segment.checksum = crc32c_extend(segment.checksum, data);
+    segment.size += static_cast<int64_t>(data.size());
+
+    SegmentFileWriter writer(segment.file.get());
+    while (!data.empty()) {
+        if (data.cut_into_writer(&writer, data.size()) < 0) {
+            return io::io_error(segment.file->filename(), errno);
+        }
+    }
+    return Status::OK();
+}
+
 HorizontalRowsetWriter::HorizontalRowsetWriter(const RowsetWriterContext& context)
         : RowsetWriter(context), _segment_writer(nullptr) {}
 
@@ -388,6 +471,14 @@ StatusOr<std::unique_ptr<SegmentWriter>> HorizontalRowsetWriter::_create_segment
         path = Rowset::segment_file_path(_context.rowset_path_prefix, _context.rowset_id, _num_segment);
     }
     ASSIGN_OR_RETURN(auto wfile, _fs->new_writable_file(path));
+    if (_context.segment_piece_callback != nullptr && !_context.schema_change_sorting &&
+        config::segment_replicate_piece_bytes > 0) {
+        wfile = std::make_unique<SegmentPieceWritableFile>(
+                std::move(wfile), config::segment_replicate_piece_bytes,
+                [cb = _context.segment_piece_callback, segment_id = _num_segment](int64_t offset, butil::IOBuf* piece) {
+                    cb(segment_id, offset, piece);
+                });
+    }
     const auto* schema = _context.tablet_schema;
     auto segment_writer = std::make_unique<SegmentWriter>(std::move(wfile), _num_segment, schema, _writer_options);
     RETURN_IF_ERROR(segment_writer->init());
@@ -559,6 +650,22 @@ Status HorizontalRowsetWriter::add_rowset_for_linked_schema_change(RowsetSharedP
     return add_rowset(rowset);
 }
 
+Status HorizontalRowsetWriter::link_segment(const RowsetSharedPtr& rowset, uint32_t segment_id) {
+    DCHECK(_segment_writer == nullptr);
+    std::string src_path = Rowset::segment_file_path(rowset->rowset_path(), rowset->rowset_id(), segment_id);
+    std::string dst_path = Rowset::segment_file_path(_context.rowset_path_prefix, _context.rowset_id, _num_segment);
+    if (link(src_path.c_str(), dst_path.c_str()) != 0) {
+        PLOG(WARNING) << "Fail to link " << src_path << " to " << dst_path;
+        return Status::RuntimeError("Fail to link segment data file");
+    }
+    ASSIGN_OR_RETURN(auto file_size, _fs->get_file_size(dst_path));
+    const auto& segment = rowset->segments()[segment_id];
+    _num_rows_written += segment->num_rows();
+    _total_data_size += static_cast<int64_t>(file_size);
+    _num_segment++;
+    return Status::OK();
+}
+
 Status HorizontalRowsetWriter::flush() {
     if (_segment_writer != nullptr) {
         return _flush_segment_writer(&_segment_writer);
@@ -34,6 +34,7 @@
 
 #pragma once
 
+#include <map>
 #include <mutex>
 #include <vector>
 
@@ -100,7 +101,7 @@ class RowsetWriter {
 public:
     RowsetWriter() = default;
     explicit RowsetWriter(const RowsetWriterContext& context);
-    virtual ~RowsetWriter() = default;
+    virtual ~RowsetWriter();
 
     RowsetWriter(const RowsetWriter&) = delete;
     const RowsetWriter& operator=(const RowsetWriter&) = delete;
@@ -132,6 +133,11 @@ public:
         return Status::NotSupported("RowsetWriter::add_rowset_for_linked_schema_change");
     }
 
+    // Link the |segment_id|-th segment of |rowset| as the next segment of this rowset.
+    virtual Status link_segment(const RowsetSharedPtr& rowset, uint32_t segment_id) {
+        return Status::NotSupported("RowsetWriter::link_segment");
+    }
+
     // explicit flush all buffered rows into segment file.
     virtual Status flush() { return Status::NotSupported("RowsetWriter::flush"); }
 
@@ -146,6 +152,7 @@ public:
     // return nullptr when failed
     virtual StatusOr<RowsetSharedPtr> build();
 
+    // Write the segment replicated by the primary replica, or a piece of it streamed while it's written.
     Status flush_segment(const SegmentPB& segment_pb, butil::IOBuf& data);
 
     virtual Version version() { return _context.version; }
@@ -161,6 +168,8 @@ public:
     }
 
 protected:
+    Status _flush_segment_piece(const SegmentPB& segment_pb, butil::IOBuf& data);
+
     RowsetWriterContext _context;
     std::shared_ptr<FileSystem> _fs;
     std::unique_ptr<RowsetMetaPB> _rowset_meta_pb;
@@ -189,6 +198,14 @@ protected:
     FlushChunkState _flush_chunk_state = FlushChunkState::UNKNOWN;
 
     DictColumnsValidMap _global_dict_columns_valid_info;
+
+    // The segments being streamed by pieces from the primary replica, the pieces are received in order.
+    struct StreamingSegment {
+        std::unique_ptr<WritableFile> file;
+        int64_t size = 0;
+        uint32_t checksum = 0;
+    };
+    std::map<int64_t, StreamingSegment> _streaming_segments;
 };
 
 class VerticalRowsetWriter;
@@ -208,6 +225,8 @@ public:
     Status add_rowset(RowsetSharedPtr rowset) override;
     Status add_rowset_for_linked_schema_change(RowsetSharedPtr rowset, const SchemaMapping& schema_mapping) override;
 
+    Status link_segment(const RowsetSharedPtr& rowset, uint32_t segment_id) override;
+
     Status flush() override;
 
     StatusOr<RowsetSharedPtr> build() override;
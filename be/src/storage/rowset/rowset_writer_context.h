@@ -34,15 +34,24 @@
 
 #pragma once
 
+#include <functional>
+
 #include "fs/fs.h"
 #include "gen_cpp/olap_file.pb.h"
 #include "runtime/global_dict/types_fwd_decl.h"
 #include "storage/type_utils.h"
 
+namespace butil {
+class IOBuf;
+}
+
 namespace starrocks {
 
 class TabletSchema;
 
+// Called with a piece of the segment file |segment_id| at |offset| while the segment is written.
+using SegmentPieceCallback = std::function<void(int64_t segment_id, int64_t offset, butil::IOBuf* piece)>;
+
 enum RowsetWriterType { kHorizontal = 0, kVertical = 1 };
 
 class RowsetWriterContext {
@@ -88,6 +97,9 @@ public:
     bool miss_auto_increment_column = false;
 
     bool abort_delete = false;
+
+    // If set, the segment files are passed to it piece by piece while they are written.
+    SegmentPieceCallback segment_piece_callback;
 };
 
 } // namespace starrocks
@@ -235,6 +235,22 @@ Status ScalarColumnIterator::next_batch(const SparseRange& range, Column* dst) {
     return Status::OK();
 }
 
+Status ScalarColumnIterator::evaluate_on_encoded_pages(const ColumnPredicate& pred, const SparseRange& range,
+                                                       uint8_t* selection) {
+    SparseRangeIterator iter = range.new_iterator();
+    while (iter.has_more()) {
+        if (_page == nullptr || !_page->contains(iter.begin())) {
+            _opts.stats->block_seek_num += 1;
+            RETURN_IF_ERROR(seek_to_ordinal(iter.begin()));
+        }
+        ordinal_t first_ordinal = _page->first_ordinal();
+        Range r = iter.next(first_ordinal + _page->num_rows() - iter.begin());
+        RETURN_IF_ERROR(_page->evaluate(pred, r.begin() - first_ordinal, r.end() - first_ordinal, selection));
+        selection += r.span_size();
+    }
+    return Status::OK();
+}
+
 Status ScalarColumnIterator::_load_next_page(bool* eos) {
     _page_iter.next();
     if (!_page_iter.valid()) {
@@ -309,15 +325,29 @@ Status ScalarColumnIterator::get_row_ranges_by_zone_map(const std::vector<const
     return Status::OK();
 }
 
+Status ScalarColumnIterator::get_all_match_row_ranges_by_zone_map(const std::vector<const ColumnPredicate*>& predicates,
+                                                                  SparseRange* row_ranges) {
+    DCHECK(row_ranges->empty());
+    if (_reader->has_zone_map()) {
+        RETURN_IF_ERROR(_reader->zone_map_all_match(predicates, row_ranges));
+    }
+    return Status::OK();
+}
+
 Status ScalarColumnIterator::get_row_ranges_by_bloom_filter(const std::vector<const ColumnPredicate*>& predicates,
                                                             SparseRange* row_ranges) {
-    RETURN_IF(!_reader->has_bloom_filter_index(), Status::OK());
     bool support = false;
+    bool support_ngram = false;
     for (const auto* pred : predicates) {
         support = support | pred->support_bloom_filter();
+        support_ngram = support_ngram | pred->support_ngram_bloom_filter();
+    }
+    if (support && _reader->has_bloom_filter_index()) {
+        RETURN_IF_ERROR(_reader->bloom_filter(predicates, row_ranges));
+    }
+    if (support_ngram && _reader->has_ngram_bloom_filter_index()) {
+        RETURN_IF_ERROR(_reader->ngram_bloom_filter(predicates, row_ranges));
     }
-    RETURN_IF(!support, Status::OK());
-    RETURN_IF_ERROR(_reader->bloom_filter(predicates, row_ranges));
     return Status::OK();
 }
 
@@ -525,6 +555,10 @@ int ScalarColumnIterator::dict_size() {
     return 0;
 }
 
+uint64_t ScalarColumnIterator::shared_dict_id() const {
+    return _reader->shared_dict_id();
+}
+
 bool ScalarColumnIterator::_contains_deleted_row(uint32_t page_index) const {
     if (_reader->has_zone_map()) {
         return _delete_partial_satisfied_pages.count(page_index) > 0;
@@ -63,12 +63,18 @@ public:
 
     ordinal_t get_current_ordinal() const override { return _current_ordinal; }
 
+    Status evaluate_on_encoded_pages(const ColumnPredicate& pred, const SparseRange& range,
+                                     uint8_t* selection) override;
+
     Status get_row_ranges_by_zone_map(const std::vector<const ColumnPredicate*>& predicate,
                                       const ColumnPredicate* del_predicate, SparseRange* range) override;
 
     Status get_row_ranges_by_bloom_filter(const std::vector<const ColumnPredicate*>& predicates,
                                           SparseRange* range) override;
 
+    Status get_all_match_row_ranges_by_zone_map(const std::vector<const ColumnPredicate*>& predicates,
+                                                SparseRange* range) override;
+
     bool all_page_dict_encoded() const override { return _all_dict_encoded; }
 
     Status fetch_all_dict_words(std::vector<Slice>* words) const override;
@@ -95,6 +101,9 @@ public:
     // used to acquire load local dict
     int dict_size();
 
+    // the id of the dictionary shared with the other segments, 0 if not shared.
+    uint64_t shared_dict_id() const;
+
 private:
     static void _seek_to_pos_in_page(ParsedPage* page, ordinal_t offset_in_page);
     Status _load_next_page(bool* eos);
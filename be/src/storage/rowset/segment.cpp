@@ -49,6 +49,7 @@
 #include "storage/rowset/column_reader.h"
 #include "storage/rowset/default_value_column_iterator.h"
 #include "storage/rowset/page_io.h"
+#include "storage/rowset/segment_meta_cache.h"
 #include "storage/rowset/segment_writer.h" // k_segment_magic_length
 #include "storage/tablet_schema.h"
 #include "storage/type_utils.h"
@@ -203,7 +204,7 @@ Segment::~Segment() {
 Status Segment::_open(size_t* footer_length_hint, const FooterPointerPB* partial_rowset_footer) {
     SegmentFooterPB footer;
     ASSIGN_OR_RETURN(auto read_file, _fs->new_random_access_file(_fname));
-    RETURN_IF_ERROR(Segment::parse_segment_footer(read_file.get(), &footer, footer_length_hint, partial_rowset_footer));
+    RETURN_IF_ERROR(_read_footer(read_file.get(), &footer, footer_length_hint, partial_rowset_footer));
 
     RETURN_IF_ERROR(_create_column_readers(&footer));
     _num_rows = footer.num_rows();
@@ -212,6 +213,27 @@ Status Segment::_open(size_t* footer_length_hint, const FooterPointerPB* partial
     return Status::OK();
 }
 
+Status Segment::_read_footer(RandomAccessFile* read_file, SegmentFooterPB* footer, size_t* footer_length_hint,
+                             const FooterPointerPB* partial_rowset_footer) {
+    // The footer of a partial rowset segment is not at the end of the file, and will be rewritten later.
+    SegmentMetaCache* meta_cache = nullptr;
+    if (config::enable_segment_meta_cache && partial_rowset_footer == nullptr) {
+        meta_cache = SegmentMetaCache::of(_fname);
+    }
+    if (meta_cache == nullptr) {
+        return Segment::parse_segment_footer(read_file, footer, footer_length_hint, partial_rowset_footer);
+    }
+    ASSIGN_OR_RETURN(auto file_size, read_file->get_size());
+    ASSIGN_OR_RETURN(auto mtime, _fs->get_file_modified_time(_fname));
+    if (meta_cache->lookup(_fname, file_size, mtime, footer)) {
+        g_open_segments << 1;
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(Segment::parse_segment_footer(read_file, footer, footer_length_hint, partial_rowset_footer));
+    meta_cache->insert(_fname, file_size, mtime, *footer);
+    return Status::OK();
+}
+
 StatusOr<ChunkIteratorPtr> Segment::_new_iterator(const Schema& schema, const SegmentReadOptions& read_options) {
     DCHECK(read_options.stats != nullptr);
     // trying to prune the current segment by segment-level zone map
@@ -289,6 +311,30 @@ Status Segment::_load_index() {
     return _sk_index_decoder->parse(body, footer.short_key_page_footer());
 }
 
+Status Segment::prefetch(const std::vector<uint32_t>& column_ids) {
+    RETURN_IF_ERROR(load_index());
+    if (_num_rows == 0) {
+        return Status::OK();
+    }
+
+    ASSIGN_OR_RETURN(auto read_file, _fs->new_random_access_file(_fname));
+    OlapReaderStatistics tmp_stats;
+    for (uint32_t cid : column_ids) {
+        if (cid >= _column_readers.size() || _column_readers[cid] == nullptr) {
+            continue;
+        }
+        ASSIGN_OR_RETURN(auto iter, new_column_iterator(cid));
+        ColumnIteratorOptions iter_opts;
+        iter_opts.stats = &tmp_stats;
+        iter_opts.use_page_cache = !config::disable_storage_page_cache;
+        iter_opts.read_file = read_file.get();
+        RETURN_IF_ERROR(iter->init(iter_opts));
+        // Seeking loads the ordinal index and reads the first data page.
+        RETURN_IF_ERROR(iter->seek_to_first());
+    }
+    return Status::OK();
+}
+
 void Segment::_reset() {
     _sk_index_handle.reset();
     _sk_index_decoder.reset();
@@ -370,4 +416,11 @@ Status Segment::new_bitmap_index_iterator(uint32_t cid, BitmapIndexIterator** it
     return Status::OK();
 }
 
+Status Segment::new_inverted_index_iterator(uint32_t cid, std::unique_ptr<InvertedIndexIterator>* iter) {
+    if (_column_readers[cid] != nullptr && _column_readers[cid]->has_inverted_index()) {
+        return _column_readers[cid]->new_inverted_index_iterator(iter);
+    }
+    return Status::OK();
+}
+
 } // namespace starrocks
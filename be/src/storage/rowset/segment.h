@@ -62,6 +62,7 @@ class SegmentIterator;
 class SegmentReadOptions;
 
 class BitmapIndexIterator;
+class InvertedIndexIterator;
 class ColumnReader;
 class ColumnIterator;
 class Segment;
@@ -116,6 +117,9 @@ public:
 
     Status new_bitmap_index_iterator(uint32_t cid, BitmapIndexIterator** iter);
 
+    // |*iter| is left nullptr if column |cid| has no inverted index.
+    Status new_inverted_index_iterator(uint32_t cid, std::unique_ptr<InvertedIndexIterator>* iter);
+
     size_t num_short_keys() const { return _tablet_schema->num_short_key_columns(); }
 
     uint32_t num_rows_per_block() const {
@@ -159,6 +163,10 @@ public:
     Status load_index();
     bool has_loaded_index() const;
 
+    // Load the short key index and read the first pages of the columns |column_ids| in advance, to warm up
+    // the page cache of the local storage or the block cache of the remote storage before scanning this segment.
+    Status prefetch(const std::vector<uint32_t>& column_ids);
+
     const ShortKeyIndexDecoder* decoder() const { return _sk_index_decoder.get(); }
 
     int64_t mem_usage() { return _basic_info_mem_usage() + _short_key_index_mem_usage(); }
@@ -205,6 +213,10 @@ private:
 
     // open segment file and read the minimum amount of necessary information (footer)
     Status _open(size_t* footer_length_hint, const FooterPointerPB* partial_rowset_footer);
+
+    // read the footer from the segment meta cache of the data dir if possible, see `SegmentMetaCache`.
+    Status _read_footer(RandomAccessFile* read_file, SegmentFooterPB* footer, size_t* footer_length_hint,
+                        const FooterPointerPB* partial_rowset_footer);
     Status _create_column_readers(SegmentFooterPB* footer);
 
     StatusOr<ChunkIteratorPtr> _new_iterator(const Schema& schema, const SegmentReadOptions& read_options);
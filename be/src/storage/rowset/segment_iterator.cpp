@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <optional>
 #include <stack>
 #include <unordered_map>
 
@@ -48,6 +49,7 @@
 #include "storage/rowset/common.h"
 #include "storage/rowset/default_value_column_iterator.h"
 #include "storage/rowset/dictcode_column_iterator.h"
+#include "storage/rowset/inverted_index_reader.h"
 #include "storage/rowset/rowid_column_iterator.h"
 #include "storage/rowset/rowid_range_option.h"
 #include "storage/rowset/segment.h"
@@ -189,7 +191,10 @@ private:
     Status _get_row_ranges_by_short_key_ranges();
     Status _get_row_ranges_by_zone_map();
     Status _get_row_ranges_by_bloom_filter();
+    Status _get_row_ranges_by_runtime_filter_bitmap(ColumnId cid, const JoinRuntimeFilter* rf, LogicalType rf_type,
+                                                    SparseRange* row_ranges);
     Status _get_row_ranges_by_rowid_range();
+    Status _get_all_match_row_ranges_by_zone_map();
 
     uint32_t segment_id() const { return _segment->id(); }
     uint32_t num_rows() const { return _segment->num_rows(); }
@@ -237,10 +242,14 @@ private:
 
     Status _apply_bitmap_index();
 
+    Status _apply_inverted_index();
+
     Status _apply_del_vector();
 
     Status _read(Chunk* chunk, vector<rowid_t>* rowid, size_t n);
 
+    Status _evaluate_on_encoded_pages(SparseRange* range);
+
 private:
     using RawColumnIterators = std::vector<std::unique_ptr<ColumnIterator>>;
     using ColumnDecoders = std::vector<ColumnDecoder>;
@@ -260,6 +269,11 @@ private:
 
     SparseRange _scan_range;
     SparseRangeIterator _range_iter;
+    // The rows in which all the predicates are satisfied according to the page zone maps,
+    // the predicates needn't be evaluated on them.
+    SparseRange _all_match_range;
+    // Whether all the rows read by the last `_read` are in |_all_match_range|.
+    bool _read_all_match = false;
 
     std::vector<const ColumnPredicate*> _vectorized_preds;
     std::vector<const ColumnPredicate*> _branchless_preds;
@@ -270,6 +284,16 @@ private:
     // _selected_idx is used to store selected index when evaluating branchless predicate
     Buffer<uint16_t> _selected_idx;
 
+    // The vectorized predicates to evaluate on the encoded pages, a predicate is moved to |_unevaluated_preds|
+    // once its pages don't support it.
+    std::vector<const ColumnPredicate*> _encoded_preds;
+    std::vector<const ColumnPredicate*> _unevaluated_preds;
+    // Whether |_encoded_preds| have been evaluated on the encoded pages by the last `_read`, if true, only
+    // the rows satisfying them are read, and |_unevaluated_preds| are left to `_filter`.
+    bool _read_encoded_evaluated = false;
+    Buffer<uint8_t> _encoded_selection;
+    Buffer<uint8_t> _encoded_selection_tmp;
+
     ScanContext _context_list[2];
     // points to |_context_list[0]| or |_context_list[1]| after `_init_context`.
     ScanContext* _context = nullptr;
@@ -349,7 +373,9 @@ Status SegmentIterator::_init() {
 
     StarRocksMetrics::instance()->segment_read_total.increment(1);
     // get file handle from file descriptor of segment
-    ASSIGN_OR_RETURN(_rfile, _opts.fs->new_random_access_file(_segment->file_name()));
+    RandomAccessFileOptions rfile_opts;
+    rfile_opts.direct_io = _opts.use_direct_io;
+    ASSIGN_OR_RETURN(_rfile, _opts.fs->new_random_access_file(rfile_opts, _segment->file_name()));
 
     // check cache hit for lake tablet
     if (_rfile->is_cache_hit()) {
@@ -370,8 +396,10 @@ Status SegmentIterator::_init() {
     RETURN_IF_ERROR(_get_row_ranges_by_rowid_range());
     RETURN_IF_ERROR(_apply_del_vector());
     RETURN_IF_ERROR(_apply_bitmap_index());
+    RETURN_IF_ERROR(_apply_inverted_index());
     RETURN_IF_ERROR(_get_row_ranges_by_zone_map());
     RETURN_IF_ERROR(_get_row_ranges_by_bloom_filter());
+    RETURN_IF_ERROR(_get_all_match_row_ranges_by_zone_map());
     // rewrite stage
     // Rewriting predicates using segment dictionary codes
     RETURN_IF_ERROR(_rewrite_predicates());
@@ -385,12 +413,13 @@ Status SegmentIterator::_init() {
 Status SegmentIterator::_try_to_update_ranges_by_runtime_filter() {
     return _opts.runtime_range_pruner.update_range_if_arrived(
             _opts.global_dictmaps,
-            [this](auto cid, const PredicateList& predicates) {
+            [this](auto cid, const PredicateList& predicates, const JoinRuntimeFilter* rf, LogicalType rf_type) {
                 const ColumnPredicate* del_pred;
                 auto iter = _del_predicates.find(cid);
                 del_pred = iter != _del_predicates.end() ? &(iter->second) : nullptr;
                 SparseRange r;
                 RETURN_IF_ERROR(_column_iterators[cid]->get_row_ranges_by_zone_map(predicates, del_pred, &r));
+                RETURN_IF_ERROR(_get_row_ranges_by_runtime_filter_bitmap(cid, rf, rf_type, &r));
                 size_t prev_size = _scan_range.span_size();
                 SparseRange res;
                 _range_iter = _range_iter.intersection(r, &res);
@@ -439,6 +468,8 @@ Status SegmentIterator::_init_column_iterators(const Schema& schema) {
             iter_opts.read_file = _rfile.get();
             iter_opts.check_dict_encoding = check_dict_enc;
             iter_opts.reader_type = _opts.reader_type;
+            iter_opts.lengths_only =
+                    _opts.lengths_only_column_ids != nullptr && _opts.lengths_only_column_ids->count(cid) > 0;
             RETURN_IF_ERROR(_column_iterators[cid]->init(iter_opts));
 
             if constexpr (check_global_dict) {
@@ -446,6 +477,7 @@ Status SegmentIterator::_init_column_iterators(const Schema& schema) {
                 _column_decoders[cid].set_all_page_dict_encoded(_column_iterators[cid]->all_page_dict_encoded());
                 if (_opts.global_dictmaps->count(cid)) {
                     _column_decoders[cid].set_global_dict(_opts.global_dictmaps->find(cid)->second);
+                    _column_decoders[cid].set_shared_dict_code_maps(_opts.shared_dict_code_maps.get(), cid);
                     _column_decoders[cid].check_global_dict();
                 }
             }
@@ -478,6 +510,7 @@ void SegmentIterator::_init_column_predicates() {
     if (_vectorized_preds.empty() && _branchless_preds.empty()) {
         _opts.predicates.clear();
     }
+    _encoded_preds = _vectorized_preds;
 }
 
 Status SegmentIterator::_get_row_ranges_by_keys() {
@@ -775,6 +808,22 @@ inline Status SegmentIterator::_read(Chunk* chunk, vector<rowid_t>* rowids, size
 
     _range_iter.next_range(n, &range);
     read_num += range.span_size();
+    _read_all_match = !_all_match_range.empty() && _all_match_range.intersection(range).span_size() == read_num;
+
+    _read_encoded_evaluated = false;
+    if (config::enable_encoded_page_predicate_evaluation && !_read_all_match && !_encoded_preds.empty()) {
+        RETURN_IF_ERROR(_evaluate_on_encoded_pages(&range));
+        // The column iterators may have been moved by the evaluation.
+        if (range.empty()) {
+            // No row is selected, make the next `_read` seek the columns.
+            _cur_rowid = 0;
+            _opts.stats->raw_rows_read += read_num;
+            return Status::OK();
+        }
+        _opts.stats->block_seek_num += 1;
+        SCOPED_RAW_TIMER(&_opts.stats->block_seek_ns);
+        RETURN_IF_ERROR(_context->seek_columns(range.begin()));
+    }
 
     {
         _opts.stats->blocks_load += 1;
@@ -799,6 +848,60 @@ inline Status SegmentIterator::_read(Chunk* chunk, vector<rowid_t>* rowids, size
     return Status::OK();
 }
 
+// Evaluate |_encoded_preds| on the encoded pages of the rows in |*range|, and narrow |*range| to the rows
+// satisfying them.
+Status SegmentIterator::_evaluate_on_encoded_pages(SparseRange* range) {
+    SCOPED_RAW_TIMER(&_opts.stats->vec_cond_evaluate_ns);
+    const size_t num_rows = range->span_size();
+    _encoded_selection.resize(num_rows);
+    _encoded_selection_tmp.resize(num_rows);
+    for (size_t i = 0; i < _encoded_preds.size();) {
+        const ColumnPredicate* pred = _encoded_preds[i];
+        uint8_t* selection = _read_encoded_evaluated ? _encoded_selection_tmp.data() : _encoded_selection.data();
+        Status st = _column_iterators[pred->column_id()]->evaluate_on_encoded_pages(*pred, *range, selection);
+        if (st.is_not_supported()) {
+            _unevaluated_preds.emplace_back(pred);
+            _encoded_preds.erase(_encoded_preds.begin() + i);
+            continue;
+        }
+        RETURN_IF_ERROR(st);
+        if (_read_encoded_evaluated) {
+            for (size_t k = 0; k < num_rows; k++) {
+                _encoded_selection[k] &= _encoded_selection_tmp[k];
+            }
+        }
+        _read_encoded_evaluated = true;
+        i++;
+    }
+    if (!_read_encoded_evaluated) {
+        return Status::OK();
+    }
+
+    SparseRange selected;
+    const uint8_t* selection = _encoded_selection.data();
+    SparseRangeIterator iter = range->new_iterator();
+    while (iter.has_more()) {
+        Range r = iter.next(num_rows);
+        for (rowid_t begin = r.begin(); begin < r.end();) {
+            while (begin < r.end() && !selection[begin - r.begin()]) {
+                begin++;
+            }
+            rowid_t end = begin;
+            while (end < r.end() && selection[end - r.begin()]) {
+                end++;
+            }
+            if (begin < end) {
+                selected.add(Range(begin, end));
+            }
+            begin = end;
+        }
+        selection += r.span_size();
+    }
+    _opts.stats->rows_vec_cond_filtered += num_rows - selected.span_size();
+    *range = std::move(selected);
+    return Status::OK();
+}
+
 Status SegmentIterator::do_get_next(Chunk* chunk) {
     if (!_inited) {
         RETURN_IF_ERROR(_init());
@@ -855,9 +958,11 @@ Status SegmentIterator::_do_get_next(Chunk* result, vector<rowid_t>* rowid) {
         chunk->check_or_die();
         size_t next_start = chunk->num_rows();
 
-        if (has_predicate) {
+        if (has_predicate && !_read_all_match) {
             ASSIGN_OR_RETURN(next_start, _filter(chunk, rowid, chunk_start, next_start));
             chunk->check_or_die();
+        } else if (has_predicate) {
+            _opts.stats->rows_zone_map_all_matched += next_start - chunk_start;
         }
         chunk_start = next_start;
         DCHECK_EQ(chunk_start, chunk->num_rows());
@@ -992,14 +1097,20 @@ StatusOr<uint16_t> SegmentIterator::_filter(Chunk* chunk, vector<rowid_t>* rowid
 
     SCOPED_RAW_TIMER(&_opts.stats->vec_cond_ns);
 
+    const auto& vectorized_preds = _read_encoded_evaluated ? _unevaluated_preds : _vectorized_preds;
+    if (_read_encoded_evaluated && vectorized_preds.empty() && _branchless_preds.empty()) {
+        // All the rows read satisfy the predicates evaluated on the encoded pages.
+        return to;
+    }
+
     // first evaluate
-    if (!_vectorized_preds.empty()) {
+    if (!vectorized_preds.empty()) {
         SCOPED_RAW_TIMER(&_opts.stats->vec_cond_evaluate_ns);
-        const ColumnPredicate* pred = _vectorized_preds[0];
+        const ColumnPredicate* pred = vectorized_preds[0];
         Column* c = chunk->get_column_by_id(pred->column_id()).get();
         pred->evaluate(c, _selection.data(), from, to);
-        for (int i = 1; i < _vectorized_preds.size(); ++i) {
-            pred = _vectorized_preds[i];
+        for (int i = 1; i < vectorized_preds.size(); ++i) {
+            pred = vectorized_preds[i];
             c = chunk->get_column_by_id(pred->column_id()).get();
             pred->evaluate_and(c, _selection.data(), from, to);
         }
@@ -1010,7 +1121,7 @@ StatusOr<uint16_t> SegmentIterator::_filter(Chunk* chunk, vector<rowid_t>* rowid
         SCOPED_RAW_TIMER(&_opts.stats->branchless_cond_evaluate_ns);
 
         uint16_t selected_size = 0;
-        if (!_vectorized_preds.empty()) {
+        if (!vectorized_preds.empty()) {
             for (uint16_t i = from; i < to; ++i) {
                 _selected_idx[selected_size] = i;
                 selected_size += _selection[i];
@@ -1521,6 +1632,40 @@ Status SegmentIterator::_apply_bitmap_index() {
     return Status::OK();
 }
 
+// filter rows by the terms of column predicates using full-text inverted indexes.
+// unlike bitmap index, the inverted index only narrows the candidate rows, so the predicates are kept.
+Status SegmentIterator::_apply_inverted_index() {
+    RETURN_IF(_opts.predicates.empty() || _scan_range.empty(), Status::OK());
+    SCOPED_RAW_TIMER(&_opts.stats->bitmap_index_filter_timer);
+    std::optional<Roaring> row_bitmap;
+    size_t input_rows = _scan_range.span_size();
+    for (const auto& [cid, pred_list] : _opts.predicates) {
+        std::unique_ptr<InvertedIndexIterator> iter;
+        RETURN_IF_ERROR(_segment->new_inverted_index_iterator(cid, &iter));
+        if (iter == nullptr) {
+            continue;
+        }
+        std::vector<std::string> terms;
+        for (const ColumnPredicate* pred : pred_list) {
+            pred->inverted_index_terms(iter->tokenizer(), &terms);
+        }
+        if (terms.empty()) {
+            continue;
+        }
+        Roaring matched;
+        RETURN_IF_ERROR(iter->match_all(terms, &matched));
+        if (!row_bitmap.has_value()) {
+            row_bitmap = range2roaring(_scan_range);
+        }
+        *row_bitmap &= matched;
+    }
+    if (row_bitmap.has_value() && row_bitmap->cardinality() < input_rows) {
+        _scan_range = roaring2range(*row_bitmap);
+        _opts.stats->rows_bitmap_index_filtered += input_rows - _scan_range.span_size();
+    }
+    return Status::OK();
+}
+
 Status SegmentIterator::_apply_del_vector() {
     if (_opts.is_primary_keys && _opts.version > 0 && _del_vec && !_del_vec->empty()) {
         Roaring row_bitmap = range2roaring(_scan_range);
@@ -1544,6 +1689,87 @@ Status SegmentIterator::_get_row_ranges_by_bloom_filter() {
     return Status::OK();
 }
 
+// Evaluate the arrived join runtime filter on the bitmap index dictionary of column |cid|, and narrow
+// |row_ranges| to the rows whose values pass the runtime filter.
+Status SegmentIterator::_get_row_ranges_by_runtime_filter_bitmap(ColumnId cid, const JoinRuntimeFilter* rf,
+                                                                 LogicalType rf_type, SparseRange* row_ranges) {
+    RETURN_IF(!config::enable_runtime_filter_bitmap_index, Status::OK());
+    // The partitioned runtime filter needs the hash partition of each row, and the runtime filter without
+    // bloom filter (e.g. top-n runtime filter) has already been applied by zone map.
+    RETURN_IF(rf->num_hash_partitions() > 0 || rf->size() == 0 || rf->always_true(), Status::OK());
+    // The runtime filter of the low-cardinality column is built on the global dict codes, and the values of
+    // CHAR column in the dictionary are padded with zeros.
+    RETURN_IF(_opts.global_dictmaps->count(cid) > 0 || rf_type == TYPE_CHAR, Status::OK());
+    RETURN_IF(cid >= _bitmap_index_iterators.size() || row_ranges->empty(), Status::OK());
+    const ColumnReader* column_reader = _segment->column(cid);
+    RETURN_IF(column_reader == nullptr || !column_reader->has_bitmap_index(), Status::OK());
+    RETURN_IF(column_reader->column_type() != rf_type, Status::OK());
+
+    SCOPED_RAW_TIMER(&_opts.stats->bitmap_index_filter_timer);
+    if (_bitmap_index_iterators[cid] == nullptr) {
+        RETURN_IF_ERROR(_segment->new_bitmap_index_iterator(cid, &_bitmap_index_iterators[cid]));
+    }
+    BitmapIndexIterator* bitmap_iter = _bitmap_index_iterators[cid];
+
+    auto dict_column = ChunkHelper::column_from_field_type(rf_type, false);
+    RETURN_IF_ERROR(bitmap_iter->read_dictionary(dict_column.get()));
+    const size_t cardinality = dict_column->size();
+
+    JoinRuntimeFilter::RunningContext ctx;
+    ctx.use_merged_selection = false;
+    rf->evaluate(dict_column.get(), &ctx);
+
+    SparseRange selected;
+    for (size_t i = 0; i < cardinality; i++) {
+        if (ctx.selection[i]) {
+            selected.add(Range(i, i + 1));
+        }
+    }
+    // Reading bitmaps is not cheap, only use the bitmap index when it's selective enough, the same as
+    // |_apply_bitmap_index|.
+    if (selected.span_size() * 1000 > cardinality * config::bitmap_max_filter_ratio) {
+        return Status::OK();
+    }
+
+    // null never passes the runtime filter here, because runtime filter with null is not pushed down to storage.
+    Roaring roaring;
+    RETURN_IF_ERROR(bitmap_iter->read_union_bitmap(selected, &roaring));
+    *row_ranges = row_ranges->intersection(roaring2range(roaring));
+    return Status::OK();
+}
+
+// The vectorized and branchless predicates needn't be evaluated on the pages whose zone maps show
+// that all the rows satisfy these predicates, e.g. the pages fully inside the range of `dt BETWEEN x AND y`.
+Status SegmentIterator::_get_all_match_row_ranges_by_zone_map() {
+    RETURN_IF(!config::enable_zone_map_skip_all_match_predicates || _opts.predicates.empty(), Status::OK());
+    SparseRange all_match(0, num_rows());
+    std::vector<const ColumnPredicate*> preds;
+    for (const auto& [cid, pred_list] : _opts.predicates) {
+        preds.clear();
+        for (const ColumnPredicate* pred : pred_list) {
+            if (!pred->is_index_filter_only() && !pred->is_expr_predicate()) {
+                preds.emplace_back(pred);
+            }
+        }
+        if (preds.empty()) {
+            continue;
+        }
+        // The zone map is built on the stored values, which may be of different type from the predicates
+        // after schema change.
+        const ColumnReader* column_reader = _segment->column(cid);
+        RETURN_IF(column_reader == nullptr, Status::OK());
+        for (const ColumnPredicate* pred : preds) {
+            RETURN_IF(pred->type_info()->type() != column_reader->column_type(), Status::OK());
+        }
+        SparseRange r;
+        RETURN_IF_ERROR(_column_iterators[cid]->get_all_match_row_ranges_by_zone_map(preds, &r));
+        all_match = all_match.intersection(r);
+        RETURN_IF(all_match.empty(), Status::OK());
+    }
+    _all_match_range = _scan_range.intersection(all_match);
+    return Status::OK();
+}
+
 Status SegmentIterator::_get_row_ranges_by_rowid_range() {
     if (_opts.rowid_range_option == nullptr) {
         return Status::OK();
@@ -0,0 +1,261 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "storage/rowset/segment_meta_cache.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "fs/fs.h"
+#include "gen_cpp/segment.pb.h"
+#include "gutil/strings/substitute.h"
+#include "util/coding.h"
+#include "util/crc32c.h"
+#include "util/defer_op.h"
+#include "util/errno.h"
+#include "util/faststring.h"
+
+namespace starrocks {
+
+static const char* const k_segment_meta_cache_file = "/segment_meta_cache";
+static const char k_segment_meta_cache_magic[] = "SRSMC001";
+static constexpr size_t k_magic_size = sizeof(k_segment_meta_cache_magic) - 1;
+// size and checksum of a record
+static constexpr size_t k_record_header_size = sizeof(uint32_t) * 2;
+// file size, modified time and path size
+static constexpr size_t k_record_fixed_body_size = sizeof(uint64_t) * 2 + sizeof(uint32_t);
+// write the cache file in batches of this size
+static constexpr size_t k_write_batch_size = 1024 * 1024;
+
+static std::mutex s_caches_mutex;
+static std::vector<SegmentMetaCache*> s_caches;
+
+SegmentMetaCache::SegmentMetaCache(std::string dir)
+        : _dir(std::move(dir)), _file_path(_dir + k_segment_meta_cache_file) {}
+
+SegmentMetaCache::~SegmentMetaCache() {
+    _entries.clear();
+    _unmap_file();
+}
+
+Status SegmentMetaCache::open() {
+    std::unique_lock l(_mutex);
+    return _map_file();
+}
+
+Status SegmentMetaCache::_map_file() {
+    DCHECK(_mapped == nullptr);
+    DCHECK(_entries.empty());
+    int fd = ::open(_file_path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        if (errno == ENOENT) {
+            return Status::OK();
+        }
+        return Status::IOError(strings::Substitute("Fail to open $0: $1", _file_path, errno_to_string(errno)));
+    }
+    DeferOp close_fd([&] { ::close(fd); });
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        return Status::IOError(strings::Substitute("Fail to stat $0: $1", _file_path, errno_to_string(errno)));
+    }
+    auto size = static_cast<size_t>(st.st_size);
+    if (size < k_magic_size) {
+        return Status::Corruption(strings::Substitute("Bad segment meta cache $0: file size $1", _file_path, size));
+    }
+    void* addr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        return Status::IOError(strings::Substitute("Fail to mmap $0: $1", _file_path, errno_to_string(errno)));
+    }
+    _mapped = addr;
+    _mapped_size = size;
+
+    const auto* data = static_cast<const uint8_t*>(_mapped);
+    if (memcmp(data, k_segment_meta_cache_magic, k_magic_size) != 0) {
+        return Status::Corruption(strings::Substitute("Bad segment meta cache $0: magic number not match", _file_path));
+    }
+    const uint8_t* p = data + k_magic_size;
+    const uint8_t* end = data + size;
+    while (static_cast<size_t>(end - p) >= k_record_header_size) {
+        uint32_t body_size = decode_fixed32_le(p);
+        uint32_t checksum = decode_fixed32_le(p + sizeof(uint32_t));
+        const uint8_t* body = p + k_record_header_size;
+        if (static_cast<size_t>(end - body) < body_size || body_size < k_record_fixed_body_size ||
+            crc32c::Value(reinterpret_cast<const char*>(body), body_size) != checksum) {
+            break;
+        }
+        uint32_t path_size = decode_fixed32_le(body + sizeof(uint64_t) * 2);
+        if (k_record_fixed_body_size + path_size > body_size) {
+            break;
+        }
+        Entry entry;
+        entry.file_size = decode_fixed64_le(body);
+        entry.mtime = decode_fixed64_le(body + sizeof(uint64_t));
+        const uint8_t* path = body + k_record_fixed_body_size;
+        entry.footer = Slice(path + path_size, body_size - k_record_fixed_body_size - path_size);
+        _footer_bytes += entry.footer.size;
+        _entries.insert_or_assign(std::string(reinterpret_cast<const char*>(path), path_size), std::move(entry));
+        p = body + body_size;
+    }
+    LOG_IF(WARNING, p != end) << "Ignored the corrupted tail of segment meta cache " << _file_path << " at "
+                              << (p - data);
+    LOG(INFO) << "Loaded " << _entries.size() << " segment footers from " << _file_path;
+    return Status::OK();
+}
+
+void SegmentMetaCache::_unmap_file() {
+    if (_mapped != nullptr) {
+        ::munmap(_mapped, _mapped_size);
+        _mapped = nullptr;
+        _mapped_size = 0;
+    }
+}
+
+bool SegmentMetaCache::lookup(const std::string& path, uint64_t file_size, uint64_t mtime,
+                              SegmentFooterPB* footer) const {
+    std::shared_lock l(_mutex);
+    auto iter = _entries.find(path);
+    if (iter == _entries.end() || iter->second.file_size != file_size || iter->second.mtime != mtime) {
+        return false;
+    }
+    const Slice& data = iter->second.footer;
+    return footer->ParseFromArray(data.data, static_cast<int>(data.size));
+}
+
+void SegmentMetaCache::insert(const std::string& path, uint64_t file_size, uint64_t mtime,
+                              const SegmentFooterPB& footer) {
+    std::string data;
+    if (!footer.SerializeToString(&data)) {
+        return;
+    }
+    std::unique_lock l(_mutex);
+    auto iter = _entries.find(path);
+    size_t old_size = iter != _entries.end() ? iter->second.footer.size : 0;
+    if (_footer_bytes - old_size + data.size() > config::segment_meta_cache_capacity) {
+        return;
+    }
+    _footer_bytes = _footer_bytes - old_size + data.size();
+    auto& entry = _entries[path];
+    entry.file_size = file_size;
+    entry.mtime = mtime;
+    entry.owned_footer = std::move(data);
+    entry.footer = Slice(entry.owned_footer);
+    _version++;
+}
+
+void SegmentMetaCache::erase(const std::string& path) {
+    std::unique_lock l(_mutex);
+    auto iter = _entries.find(path);
+    if (iter == _entries.end()) {
+        return;
+    }
+    _footer_bytes -= iter->second.footer.size;
+    _entries.erase(iter);
+    _version++;
+}
+
+size_t SegmentMetaCache::size() const {
+    std::shared_lock l(_mutex);
+    return _entries.size();
+}
+
+Status SegmentMetaCache::_write_file(const std::string& path) const {
+    ASSIGN_OR_RETURN(auto fs, FileSystem::CreateSharedFromString(path));
+    WritableFileOptions opts{.sync_on_close = true, .mode = FileSystem::CREATE_OR_OPEN_WITH_TRUNCATE};
+    ASSIGN_OR_RETURN(auto wfile, fs->new_writable_file(opts, path));
+    faststring buffer;
+    buffer.append(k_segment_meta_cache_magic, k_magic_size);
+    for (const auto& [seg_path, entry] : _entries) {
+        size_t record_pos = buffer.size();
+        put_fixed32_le(&buffer, 0);
+        put_fixed32_le(&buffer, 0);
+        size_t body_pos = buffer.size();
+        put_fixed64_le(&buffer, entry.file_size);
+        put_fixed64_le(&buffer, entry.mtime);
+        put_fixed32_le(&buffer, seg_path.size());
+        buffer.append(seg_path.data(), seg_path.size());
+        buffer.append(entry.footer.data, entry.footer.size);
+        size_t body_size = buffer.size() - body_pos;
+        encode_fixed32_le(buffer.data() + record_pos, body_size);
+        encode_fixed32_le(buffer.data() + record_pos + sizeof(uint32_t),
+                          crc32c::Value(reinterpret_cast<const char*>(buffer.data() + body_pos), body_size));
+        if (buffer.size() >= k_write_batch_size) {
+            RETURN_IF_ERROR(wfile->append(Slice(buffer)));
+            buffer.clear();
+        }
+    }
+    RETURN_IF_ERROR(wfile->append(Slice(buffer)));
+    return wfile->close();
+}
+
+Status SegmentMetaCache::flush() {
+    const std::string tmp_path = _file_path + ".tmp";
+    uint64_t version = 0;
+    {
+        // The footers are not changed while writing, but can still be looked up.
+        std::shared_lock l(_mutex);
+        if (_version == _flushed_version) {
+            return Status::OK();
+        }
+        version = _version;
+        RETURN_IF_ERROR(_write_file(tmp_path));
+    }
+    ASSIGN_OR_RETURN(auto fs, FileSystem::CreateSharedFromString(_file_path));
+    RETURN_IF_ERROR(fs->rename_file(tmp_path, _file_path));
+
+    std::unique_lock l(_mutex);
+    if (_version != version) {
+        // Changed after writing, the footers in memory will be written again by the next flush.
+        return Status::OK();
+    }
+    // Drop the footers in memory and use the mapped ones instead.
+    _entries.clear();
+    _footer_bytes = 0;
+    _unmap_file();
+    Status st = _map_file();
+    _flushed_version = _version;
+    return st;
+}
+
+void SegmentMetaCache::register_cache(SegmentMetaCache* cache) {
+    std::lock_guard l(s_caches_mutex);
+    s_caches.push_back(cache);
+}
+
+void SegmentMetaCache::unregister_cache(SegmentMetaCache* cache) {
+    std::lock_guard l(s_caches_mutex);
+    s_caches.erase(std::remove(s_caches.begin(), s_caches.end(), cache), s_caches.end());
+}
+
+SegmentMetaCache* SegmentMetaCache::of(const std::string& path) {
+    std::lock_guard l(s_caches_mutex);
+    for (auto* cache : s_caches) {
+        const std::string& dir = cache->_dir;
+        if (path.size() > dir.size() && path.compare(0, dir.size(), dir) == 0 && path[dir.size()] == '/') {
+            return cache;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace starrocks
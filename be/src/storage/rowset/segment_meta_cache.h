@@ -0,0 +1,114 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+#include "common/status.h"
+#include "util/slice.h"
+
+namespace starrocks {
+
+class SegmentFooterPB;
+
+// A persistent cache of the segment footers of a data dir.
+//
+// After a restart, opening a segment would read its footer from the end of the segment file, which
+// makes the first queries on every tablet wait for a random read per segment. The cache keeps the
+// footers of the segments in one flat file under the data dir, which is mapped into memory when the
+// data dir is loaded and read without any I/O, the footers are only parsed when the segments are opened.
+//
+// File layout:
+//   magic (8 bytes)
+//   records, each one is:
+//     record size (32-bit fixed), the size of the record body
+//     checksum (32-bit fixed), crc32c of the record body
+//     record body:
+//       segment file size (64-bit fixed)
+//       segment file modified time (64-bit fixed)
+//       path size (32-bit fixed)
+//       path
+//       serialized SegmentFooterPB
+//
+// A cached footer is only used if the size and the modified time of the segment file are unchanged.
+// The new footers are kept in memory and written with `flush`, which rewrites the whole file.
+class SegmentMetaCache {
+public:
+    explicit SegmentMetaCache(std::string dir);
+
+    ~SegmentMetaCache();
+
+    SegmentMetaCache(const SegmentMetaCache&) = delete;
+    void operator=(const SegmentMetaCache&) = delete;
+
+    // Map the cache file of the data dir, the records after the first corrupted one are ignored.
+    Status open();
+
+    // Parse the cached footer of the segment file |path| into |footer|.
+    // Return false if there is no valid footer for the file of |file_size| and |mtime|.
+    bool lookup(const std::string& path, uint64_t file_size, uint64_t mtime, SegmentFooterPB* footer) const;
+
+    void insert(const std::string& path, uint64_t file_size, uint64_t mtime, const SegmentFooterPB& footer);
+
+    void erase(const std::string& path);
+
+    // Write all the footers into the cache file if there are changes since the last flush.
+    Status flush();
+
+    size_t size() const;
+
+    const std::string& file_path() const { return _file_path; }
+
+    // Register the cache of a data dir, so the segments under the data dir can find it with `of`.
+    static void register_cache(SegmentMetaCache* cache);
+    static void unregister_cache(SegmentMetaCache* cache);
+
+    // Return the cache of the data dir containing the segment file |path|, nullptr if there is none.
+    static SegmentMetaCache* of(const std::string& path);
+
+private:
+    struct Entry {
+        uint64_t file_size = 0;
+        uint64_t mtime = 0;
+        // points to the mapped file, or to |owned_footer| for the footers inserted after the last flush
+        Slice footer;
+        std::string owned_footer;
+    };
+
+    Status _map_file();
+    void _unmap_file();
+    Status _write_file(const std::string& path) const;
+
+    const std::string _dir;
+    const std::string _file_path;
+
+    mutable std::shared_mutex _mutex;
+    // node based, so the footers owned by the entries are not moved
+    std::unordered_map<std::string, Entry> _entries;
+    // the total size of the cached footers
+    size_t _footer_bytes = 0;
+    // increased on each change of the entries
+    uint64_t _version = 0;
+    uint64_t _flushed_version = 0;
+
+    void* _mapped = nullptr;
+    size_t _mapped_size = 0;
+};
+
+} // namespace starrocks
@@ -42,8 +42,10 @@ Status SegmentReadOptions::convert_to(SegmentReadOptions* dst, const std::vector
     dst->fs = fs;
     dst->stats = stats;
     dst->use_page_cache = use_page_cache;
+    dst->use_direct_io = use_direct_io;
     dst->profile = profile;
     dst->global_dictmaps = global_dictmaps;
+    dst->shared_dict_code_maps = shared_dict_code_maps;
     dst->rowid_range_option = rowid_range_option;
     dst->short_key_ranges = short_key_ranges;
 
@@ -77,6 +79,7 @@ std::string SegmentReadOptions::debug_string() const {
     ss << "],delete_predicates={";
     ss << "},tablet_schema={";
     ss << "},use_page_cache=" << use_page_cache;
+    ss << ",use_direct_io=" << use_direct_io;
     return ss.str();
 }
 
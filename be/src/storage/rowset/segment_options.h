@@ -35,6 +35,7 @@ class TabletSchema;
 namespace starrocks {
 
 class ColumnPredicate;
+class SharedDictCodeConvertMaps;
 struct RowidRangeOption;
 using RowidRangeOptionPtr = std::shared_ptr<RowidRangeOption>;
 struct ShortKeyRangeOption;
@@ -66,12 +67,18 @@ public:
     RuntimeProfile* profile = nullptr;
 
     bool use_page_cache = false;
+    // Read the column data pages with O_DIRECT, the index and metadata reads are still buffered.
+    bool use_direct_io = false;
 
     ReaderType reader_type = READER_QUERY;
     int chunk_size = DEFAULT_CHUNK_SIZE;
 
     const ColumnIdToGlobalDictMap* global_dictmaps = &EMPTY_GLOBAL_DICTMAPS;
+    // shared by the segments of a rowset, to reuse the code convert maps of the shared dictionaries.
+    std::shared_ptr<SharedDictCodeConvertMaps> shared_dict_code_maps;
     const std::unordered_set<uint32_t>* unused_output_column_ids = nullptr;
+    // The ARRAY and MAP columns of which only the lengths are read, see ColumnIteratorOptions::lengths_only.
+    const std::unordered_set<uint32_t>* lengths_only_column_ids = nullptr;
 
     bool has_delete_pred = false;
 
@@ -0,0 +1,74 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <butil/iobuf.h>
+
+#include <functional>
+#include <memory>
+
+#include "fs/fs.h"
+#include "fs/writable_file_wrapper.h"
+
+namespace starrocks {
+
+// SegmentPieceWritableFile passes the bytes appended to a segment file to a callback piece by piece, so that the
+// segment can be replicated while it's written. The bytes appended after the last full piece are not passed, the
+// caller sends them with the segment meta once the segment is finished.
+class SegmentPieceWritableFile final : public WritableFileWrapper {
+public:
+    // Called with the piece at |offset| of the file, the callback can take the bytes of |piece| away by swapping.
+    using PieceCallback = std::function<void(int64_t offset, butil::IOBuf* piece)>;
+
+    SegmentPieceWritableFile(std::unique_ptr<WritableFile> file, size_t piece_size, PieceCallback callback)
+            : WritableFileWrapper(file.release(), kTakesOwnership),
+              _piece_size(piece_size),
+              _callback(std::move(callback)) {}
+
+    Status append(const Slice& data) override {
+        RETURN_IF_ERROR(_file->append(data));
+        _add(data);
+        return Status::OK();
+    }
+
+    Status appendv(const Slice* data, size_t cnt) override {
+        RETURN_IF_ERROR(_file->appendv(data, cnt));
+        for (size_t i = 0; i < cnt; i++) {
+            _add(data[i]);
+        }
+        return Status::OK();
+    }
+
+private:
+    void _add(const Slice& data) {
+        _piece.append(data.data, data.size);
+        if (_piece.size() >= _piece_size) {
+            butil::IOBuf piece;
+            piece.swap(_piece);
+            int64_t offset = _offset;
+            _offset += static_cast<int64_t>(piece.size());
+            _callback(offset, &piece);
+        }
+    }
+
+    const size_t _piece_size;
+    PieceCallback _callback;
+    // The offset of _piece in the file.
+    int64_t _offset = 0;
+    butil::IOBuf _piece;
+};
+
+} // namespace starrocks
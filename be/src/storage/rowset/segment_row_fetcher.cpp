@@ -0,0 +1,84 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/rowset/segment_row_fetcher.h"
+
+#include <algorithm>
+#include <functional>
+
+#include "column/chunk.h"
+#include "fs/fs.h"
+#include "storage/rowset/column_iterator.h"
+#include "storage/rowset/segment.h"
+
+namespace starrocks {
+
+SegmentRowFetcher::SegmentRowFetcher(std::shared_ptr<Segment> segment, Schema schema)
+        : _segment(std::move(segment)), _schema(std::move(schema)) {}
+
+SegmentRowFetcher::~SegmentRowFetcher() = default;
+
+Status SegmentRowFetcher::init(OlapReaderStatistics* stats, bool use_page_cache) {
+    ASSIGN_OR_RETURN(_read_file, _segment->file_system()->new_random_access_file(_segment->file_name()));
+
+    _column_iterators.clear();
+    _column_iterators.reserve(_schema.num_fields());
+    for (const auto& field : _schema.fields()) {
+        ASSIGN_OR_RETURN(auto iter, _segment->new_column_iterator(field->id()));
+        ColumnIteratorOptions iter_opts;
+        iter_opts.stats = stats;
+        iter_opts.use_page_cache = use_page_cache;
+        iter_opts.read_file = _read_file.get();
+        RETURN_IF_ERROR(iter->init(iter_opts));
+        _column_iterators.emplace_back(std::move(iter));
+    }
+    return Status::OK();
+}
+
+Status SegmentRowFetcher::fetch(const rowid_t* rowids, size_t size, Chunk* chunk) {
+    DCHECK_EQ(_column_iterators.size(), chunk->num_columns());
+    if (size == 0) {
+        return Status::OK();
+    }
+
+    // ColumnIterator::fetch_values_by_rowid requires the ascending row ids, which is the common case
+    // when the rows come from a scan directly.
+    if (std::is_sorted(rowids, rowids + size, std::less_equal<rowid_t>())) {
+        for (size_t i = 0; i < _column_iterators.size(); i++) {
+            RETURN_IF_ERROR(_column_iterators[i]->fetch_values_by_rowid(rowids, size,
+                                                                        chunk->get_column_by_index(i).get()));
+        }
+        return Status::OK();
+    }
+
+    _sorted_rowids.assign(rowids, rowids + size);
+    std::sort(_sorted_rowids.begin(), _sorted_rowids.end());
+    _sorted_rowids.erase(std::unique(_sorted_rowids.begin(), _sorted_rowids.end()), _sorted_rowids.end());
+    _positions.resize(size);
+    for (size_t i = 0; i < size; i++) {
+        _positions[i] = std::lower_bound(_sorted_rowids.begin(), _sorted_rowids.end(), rowids[i]) -
+                        _sorted_rowids.begin();
+    }
+
+    for (size_t i = 0; i < _column_iterators.size(); i++) {
+        auto& dst = chunk->get_column_by_index(i);
+        auto sorted_values = dst->clone_empty();
+        RETURN_IF_ERROR(_column_iterators[i]->fetch_values_by_rowid(_sorted_rowids.data(), _sorted_rowids.size(),
+                                                                    sorted_values.get()));
+        dst->append_selective(*sorted_values, _positions.data(), 0, size);
+    }
+    return Status::OK();
+}
+
+} // namespace starrocks
@@ -0,0 +1,61 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "column/schema.h"
+#include "common/status.h"
+#include "storage/rowset/common.h"
+
+namespace starrocks {
+
+class Chunk;
+class ColumnIterator;
+class OlapReaderStatistics;
+class RandomAccessFile;
+class Segment;
+
+// SegmentRowFetcher fetches the columns of the rows identified by their ordinals in a segment.
+// It is the random access counterpart of SegmentIterator, used to materialize the columns which are not read
+// by the scan, after most rows are filtered out by the following operators, e.g. a selective hash join.
+class SegmentRowFetcher {
+public:
+    // The ids of the fields of |schema| are the column ids of the tablet schema.
+    SegmentRowFetcher(std::shared_ptr<Segment> segment, Schema schema);
+    ~SegmentRowFetcher();
+
+    Status init(OlapReaderStatistics* stats, bool use_page_cache);
+
+    // Append the rows |rowids| of the segment to the columns of |chunk|, which match the fields of the schema.
+    // |rowids| may be in any order and contain duplicates, and the rows are appended in the same order.
+    Status fetch(const rowid_t* rowids, size_t size, Chunk* chunk);
+
+    const Schema& schema() const { return _schema; }
+
+private:
+    std::shared_ptr<Segment> _segment;
+    Schema _schema;
+
+    std::unique_ptr<RandomAccessFile> _read_file;
+    std::vector<std::unique_ptr<ColumnIterator>> _column_iterators;
+
+    // The sorted unique row ids and the position of each input row id in them, reused between fetches.
+    std::vector<rowid_t> _sorted_rowids;
+    std::vector<uint32_t> _positions;
+};
+
+} // namespace starrocks
@@ -34,22 +34,29 @@
 
 #include "storage/rowset/segment_writer.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
 #include "column/chunk.h"
 #include "column/datum_tuple.h"
 #include "column/nullable_column.h"
+#include "common/config.h"
 #include "common/logging.h" // LOG
 #include "fs/fs.h"          // FileSystem
 #include "gen_cpp/segment.pb.h"
+#include "runtime/current_thread.h"
+#include "runtime/exec_env.h"
 #include "storage/rowset/column_writer.h" // ColumnWriter
 #include "storage/rowset/page_io.h"
+#include "storage/rowset/shared_dictionary.h"
 #include "storage/seek_tuple.h"
 #include "storage/short_key_index.h"
+#include "util/countdown_latch.h"
 #include "util/crc32c.h"
 #include "util/faststring.h"
 #include "util/json.h"
+#include "util/threadpool.h"
 
 namespace starrocks {
 
@@ -140,6 +147,9 @@ Status SegmentWriter::init(const std::vector<uint32_t>& column_indexes, bool has
         } else {
             _init_column_meta(opts.meta, column_index, column);
         }
+        if (auto iter = _opts.column_encodings.find(column.unique_id()); iter != _opts.column_encodings.end()) {
+            opts.meta->set_encoding(iter->second);
+        }
 
         // now we create zone map for key columns
         // and not support zone map for array type.
@@ -149,7 +159,18 @@ Status SegmentWriter::init(const std::vector<uint32_t>& column_indexes, bool has
         if (column.type() == LogicalType::TYPE_ARRAY) {
             opts.need_zone_map = false;
         }
+        // the scalar subfields of the nested columns have their own zone maps.
+        bool is_nested_column = column.type() == LogicalType::TYPE_ARRAY || column.type() == LogicalType::TYPE_MAP ||
+                                column.type() == LogicalType::TYPE_STRUCT;
+        opts.need_subfield_zone_map = config::enable_nested_column_zone_map && is_nested_column &&
+                                      _tablet_schema->keys_type() == KeysType::DUP_KEYS;
         opts.need_bloom_filter = column.is_bf_column();
+        // n-gram bloom filter and inverted index are built for the char/varchar bloom filter columns,
+        // if enabled by the config.
+        bool is_string_bf_column = opts.need_bloom_filter && (column.type() == LogicalType::TYPE_CHAR ||
+                                                              column.type() == LogicalType::TYPE_VARCHAR);
+        opts.need_ngram_bloom_filter = is_string_bf_column;
+        opts.need_inverted_index = is_string_bf_column;
         opts.need_bitmap_index = column.has_bitmap_index();
         if (column.type() == LogicalType::TYPE_ARRAY) {
             if (opts.need_bloom_filter) {
@@ -167,6 +188,10 @@ Status SegmentWriter::init(const std::vector<uint32_t>& column_indexes, bool has
                 _global_dict_columns_valid_info[iter->first] = true;
             }
         }
+        if ((column.type() == LogicalType::TYPE_CHAR || column.type() == LogicalType::TYPE_VARCHAR) &&
+            _opts.shared_dicts != nullptr) {
+            opts.shared_dict = _opts.shared_dicts->get(column.unique_id());
+        }
 
         ASSIGN_OR_RETURN(auto writer, ColumnWriter::create(opts, &column, _wfile.get()));
         RETURN_IF_ERROR(writer->init());
@@ -300,12 +325,57 @@ Status SegmentWriter::_write_raw_data(const std::vector<Slice>& slices) {
     return Status::OK();
 }
 
+Status SegmentWriter::_append_columns(const Chunk& chunk) {
+    const size_t num_columns = _column_writers.size();
+    auto append_range = [&](size_t begin, size_t end) -> Status {
+        for (size_t i = begin; i < end; ++i) {
+            const Column* col = chunk.get_column_by_index(i).get();
+            RETURN_IF_ERROR(_column_writers[i]->append(*col));
+        }
+        return Status::OK();
+    };
+
+    const size_t columns_per_task = std::max<int32_t>(1, config::segment_parallel_encode_columns_per_task);
+    ThreadPool* pool = nullptr;
+    if (config::enable_segment_parallel_column_encode && num_columns >= 2 * columns_per_task) {
+        pool = ExecEnv::GetInstance()->segment_column_encode_pool();
+    }
+    if (pool == nullptr) {
+        return append_range(0, num_columns);
+    }
+
+    // The pages are only encoded into the buffers of each column writer here, and they are written
+    // into the segment file in column order by `finalize_columns`, so the column writers do not share
+    // any state and can be appended concurrently.
+    const size_t num_tasks = (num_columns + columns_per_task - 1) / columns_per_task;
+    std::vector<Status> results(num_tasks);
+    CountDownLatch latch(num_tasks - 1);
+    MemTracker* mem_tracker = CurrentThread::mem_tracker();
+    for (size_t t = 1; t < num_tasks; ++t) {
+        size_t begin = t * columns_per_task;
+        size_t end = std::min(num_columns, begin + columns_per_task);
+        auto st = pool->submit_func([&, t, begin, end]() {
+            SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(mem_tracker);
+            results[t] = append_range(begin, end);
+            latch.count_down();
+        });
+        if (!st.ok()) {
+            // The pool is full or shutting down, encode the columns in the current thread.
+            results[t] = append_range(begin, end);
+            latch.count_down();
+        }
+    }
+    results[0] = append_range(0, columns_per_task);
+    latch.wait();
+    for (const auto& st : results) {
+        RETURN_IF_ERROR(st);
+    }
+    return Status::OK();
+}
+
 Status SegmentWriter::append_chunk(const Chunk& chunk) {
     DCHECK_EQ(_column_writers.size(), chunk.num_columns());
-    for (size_t i = 0; i < _column_writers.size(); ++i) {
-        const Column* col = chunk.get_column_by_index(i).get();
-        RETURN_IF_ERROR(_column_writers[i]->append(*col));
-    }
+    RETURN_IF_ERROR(_append_columns(chunk));
 
     size_t chunk_num_rows = chunk.num_rows();
     if (_has_key) {
@@ -37,6 +37,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "common/status.h"
@@ -54,6 +55,7 @@ class MemTracker;
 class WritableFile;
 class Chunk;
 class ColumnWriter;
+class SharedDictionaries;
 
 extern const char* const k_segment_magic;
 extern const uint32_t k_segment_magic_length;
@@ -62,6 +64,10 @@ struct SegmentWriterOptions {
     uint32_t num_rows_per_block = 1024;
     GlobalDictByNameMaps* global_dicts = nullptr;
     std::vector<int32_t> referenced_column_ids;
+    // the dictionaries shared by the segments of a rowset, see `enable_shared_segment_dictionary`.
+    std::shared_ptr<SharedDictionaries> shared_dicts;
+    // the encodings of the columns by their unique ids, the other columns use DEFAULT_ENCODING.
+    std::unordered_map<int32_t, EncodingTypePB> column_encodings;
 };
 
 // SegmentWriter is responsible for writing data into single segment by all or partital columns.
@@ -126,6 +132,9 @@ public:
     std::string segment_path() const;
 
 private:
+    // Append the columns of |chunk| to the column writers, the columns of the wide tables are
+    // encoded in parallel if `enable_segment_parallel_column_encode` is true.
+    Status _append_columns(const Chunk& chunk);
     Status _write_short_key_index();
     Status _write_footer();
     Status _write_raw_data(const std::vector<Slice>& slices);
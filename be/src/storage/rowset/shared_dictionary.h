@@ -0,0 +1,139 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Dictionaries of the char/varchar columns shared by the segments of one rowset.
+//
+// Every segment still has its own dictionary page, but the dictionary page of a later segment
+// starts with the words of the earlier ones, in the same order. So a word has the same code in
+// all the segments sharing a dictionary, and the readers only need to translate the codes
+// appended by each segment instead of the whole dictionary.
+//
+// The shared dictionary is append-only. A segment is tagged with the id of the shared dictionary
+// (`ColumnMetaPB.shared_dict_id`) only if its dictionary is an extension of the shared dictionary
+// when it's finished, so the dictionaries of the segments with the same id are prefixes of each other.
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "storage/olap_common.h"
+#include "util/uid_util.h"
+
+namespace starrocks {
+
+class SharedDictionary {
+public:
+    SharedDictionary() { reset(); }
+
+    // Return the id and the words of the current dictionary.
+    uint64_t snapshot(std::vector<std::string>* words) const {
+        std::lock_guard l(_mutex);
+        *words = _words;
+        return _id;
+    }
+
+    // Replace the words with |words| if the dictionary is still the one of |id| and has
+    // |seeded_size| words, i.e. |words| is an extension of the current dictionary.
+    // Return false if the dictionary has been changed by others.
+    bool update(uint64_t id, size_t seeded_size, const std::vector<std::string>& words) {
+        std::lock_guard l(_mutex);
+        if (_id != id || _words.size() != seeded_size || words.size() < seeded_size) {
+            return false;
+        }
+        _words = words;
+        return true;
+    }
+
+    // Start a new empty dictionary, the segments written later will not share codes
+    // with the earlier ones.
+    void reset() {
+        std::lock_guard l(_mutex);
+        _words.clear();
+        do {
+            UniqueId uid = UniqueId::gen_uid();
+            _id = static_cast<uint64_t>(uid.hi) ^ static_cast<uint64_t>(uid.lo);
+        } while (_id == 0);
+    }
+
+private:
+    mutable std::mutex _mutex;
+    // 0 is reserved for the segments not sharing dictionary.
+    uint64_t _id = 0;
+    std::vector<std::string> _words;
+};
+
+// The shared dictionaries of a rowset writer, keyed by the column unique id.
+class SharedDictionaries {
+public:
+    SharedDictionary* get(uint32_t unique_id) {
+        std::lock_guard l(_mutex);
+        auto& dict = _dicts[unique_id];
+        if (dict == nullptr) {
+            dict = std::make_unique<SharedDictionary>();
+        }
+        return dict.get();
+    }
+
+private:
+    std::mutex _mutex;
+    std::unordered_map<uint32_t, std::unique_ptr<SharedDictionary>> _dicts;
+};
+
+// The code convert maps (local code -> global dict code) built by the scan of a rowset, keyed by
+// the column id. The map of a segment sharing dictionary with an earlier segment of the same rowset
+// starts with the map of the earlier one, so only the codes appended by the segment need to be looked up.
+class SharedDictCodeConvertMaps {
+public:
+    // Copy the known part of the convert map of |dict_id| into |code_convert_map|, at most
+    // |dict_size| codes. Return the number of codes copied.
+    size_t get(ColumnId cid, uint64_t dict_id, size_t dict_size, std::vector<int16_t>* code_convert_map) const {
+        std::lock_guard l(_mutex);
+        auto iter = _maps.find(cid);
+        if (iter == _maps.end() || iter->second.dict_id != dict_id) {
+            return 0;
+        }
+        const auto& map = iter->second.code_convert_map;
+        // The map has a slot before and after the codes.
+        size_t num_codes = std::min(map.size() - 2, dict_size);
+        code_convert_map->assign(map.begin(), map.begin() + num_codes + 1);
+        return num_codes;
+    }
+
+    // Keep the longest convert map of each column.
+    void put(ColumnId cid, uint64_t dict_id, const std::vector<int16_t>& code_convert_map) {
+        std::lock_guard l(_mutex);
+        auto& entry = _maps[cid];
+        if (entry.dict_id != dict_id || entry.code_convert_map.size() < code_convert_map.size()) {
+            entry.dict_id = dict_id;
+            entry.code_convert_map = code_convert_map;
+        }
+    }
+
+private:
+    struct Entry {
+        uint64_t dict_id = 0;
+        std::vector<int16_t> code_convert_map;
+    };
+
+    mutable std::mutex _mutex;
+    std::unordered_map<ColumnId, Entry> _maps;
+};
+
+} // namespace starrocks
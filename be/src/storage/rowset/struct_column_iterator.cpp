@@ -16,6 +16,7 @@
 
 #include "column/nullable_column.h"
 #include "column/struct_column.h"
+#include "storage/column_expr_predicate.h"
 #include "storage/rowset/scalar_column_iterator.h"
 
 namespace starrocks {
@@ -23,7 +24,7 @@ namespace starrocks {
 class StructColumnIterator final : public ColumnIterator {
 public:
     StructColumnIterator(std::unique_ptr<ColumnIterator> null_iter,
-                         std::vector<std::unique_ptr<ColumnIterator>> field_iters);
+                         std::vector<std::unique_ptr<ColumnIterator>> field_iters, ordinal_t num_rows);
 
     ~StructColumnIterator() override = default;
 
@@ -40,27 +41,36 @@ public:
     ordinal_t get_current_ordinal() const override { return _field_iters[0]->get_current_ordinal(); }
 
     /// for vectorized engine
+    // The struct column has no zone map itself, the predicates on its fields, e.g. `s.a = 1`, are
+    // evaluated on the zone maps of the fields.
     Status get_row_ranges_by_zone_map(const std::vector<const ColumnPredicate*>& predicates,
-                                      const ColumnPredicate* del_predicate, SparseRange* row_ranges) override {
-        CHECK(false) << "array column does not has zone map index";
-        return Status::OK();
-    }
+                                      const ColumnPredicate* del_predicate, SparseRange* row_ranges) override;
+
+    Status get_row_ranges_by_bloom_filter(const std::vector<const ColumnPredicate*>& predicates,
+                                          SparseRange* row_ranges) override;
 
     Status fetch_values_by_rowid(const rowid_t* rowids, size_t size, Column* values) override;
 
 private:
+    // Group the predicates on the fields by the field index.
+    std::vector<std::vector<const ColumnPredicate*>> _subfield_predicates(
+            const std::vector<const ColumnPredicate*>& predicates) const;
+
     std::unique_ptr<ColumnIterator> _null_iter;
     std::vector<std::unique_ptr<ColumnIterator>> _field_iters;
+    ordinal_t _num_rows;
 };
 
 StatusOr<std::unique_ptr<ColumnIterator>> create_struct_iter(std::unique_ptr<ColumnIterator> null_iter,
-                                                             std::vector<std::unique_ptr<ColumnIterator>> field_iters) {
-    return std::make_unique<StructColumnIterator>(std::move(null_iter), std::move(field_iters));
+                                                             std::vector<std::unique_ptr<ColumnIterator>> field_iters,
+                                                             ordinal_t num_rows) {
+    return std::make_unique<StructColumnIterator>(std::move(null_iter), std::move(field_iters), num_rows);
 }
 
 StructColumnIterator::StructColumnIterator(std::unique_ptr<ColumnIterator> null_iter,
-                                           std::vector<std::unique_ptr<ColumnIterator>> field_iters)
-        : _null_iter(std::move(null_iter)), _field_iters(std::move(field_iters)) {}
+                                           std::vector<std::unique_ptr<ColumnIterator>> field_iters,
+                                           ordinal_t num_rows)
+        : _null_iter(std::move(null_iter)), _field_iters(std::move(field_iters)), _num_rows(num_rows) {}
 
 Status StructColumnIterator::init(const ColumnIteratorOptions& opts) {
     if (_null_iter != nullptr) {
@@ -149,6 +159,50 @@ Status StructColumnIterator::fetch_values_by_rowid(const rowid_t* rowids, size_t
     return Status::OK();
 }
 
+std::vector<std::vector<const ColumnPredicate*>> StructColumnIterator::_subfield_predicates(
+        const std::vector<const ColumnPredicate*>& predicates) const {
+    std::vector<std::vector<const ColumnPredicate*>> subfield_preds(_field_iters.size());
+    for (const auto* pred : predicates) {
+        if (!pred->is_expr_predicate()) {
+            continue;
+        }
+        const auto* expr_pred = static_cast<const ColumnExprPredicate*>(pred);
+        if (expr_pred->subfield_predicate() != nullptr &&
+            static_cast<size_t>(expr_pred->subfield_index()) < _field_iters.size()) {
+            subfield_preds[expr_pred->subfield_index()].emplace_back(expr_pred->subfield_predicate());
+        }
+    }
+    return subfield_preds;
+}
+
+Status StructColumnIterator::get_row_ranges_by_zone_map(const std::vector<const ColumnPredicate*>& predicates,
+                                                        const ColumnPredicate* del_predicate, SparseRange* row_ranges) {
+    DCHECK(row_ranges->empty());
+    // the delete predicates are not supported on the struct column.
+    row_ranges->add({0, static_cast<rowid_t>(_num_rows)});
+    auto subfield_preds = _subfield_predicates(predicates);
+    for (size_t i = 0; i < _field_iters.size(); i++) {
+        if (subfield_preds[i].empty()) {
+            continue;
+        }
+        SparseRange r;
+        RETURN_IF_ERROR(_field_iters[i]->get_row_ranges_by_zone_map(subfield_preds[i], nullptr, &r));
+        *row_ranges = row_ranges->intersection(r);
+    }
+    return Status::OK();
+}
+
+Status StructColumnIterator::get_row_ranges_by_bloom_filter(const std::vector<const ColumnPredicate*>& predicates,
+                                                            SparseRange* row_ranges) {
+    auto subfield_preds = _subfield_predicates(predicates);
+    for (size_t i = 0; i < _field_iters.size(); i++) {
+        if (!subfield_preds[i].empty()) {
+            RETURN_IF_ERROR(_field_iters[i]->get_row_ranges_by_bloom_filter(subfield_preds[i], row_ranges));
+        }
+    }
+    return Status::OK();
+}
+
 Status StructColumnIterator::seek_to_first() {
     if (_null_iter != nullptr) {
         RETURN_IF_ERROR(_null_iter->seek_to_first());
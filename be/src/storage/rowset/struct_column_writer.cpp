@@ -18,6 +18,7 @@
 #include "column/struct_column.h"
 #include "common/status.h"
 #include "gutil/casts.h"
+#include "types/logical_type.h"
 
 namespace starrocks {
 
@@ -41,11 +42,11 @@ public:
 
     Status finish_current_page() override;
 
-    Status write_zone_map() override { return Status::OK(); }
+    Status write_zone_map() override;
 
     Status write_bitmap_index() override { return Status::OK(); }
 
-    Status write_bloom_filter_index() override { return Status::OK(); }
+    Status write_bloom_filter_index() override;
 
     ordinal_t get_next_rowid() const override { return _field_writers[0]->get_next_rowid(); }
 
@@ -68,7 +69,8 @@ StatusOr<std::unique_ptr<ColumnWriter>> create_struct_column_writer(const Column
         const TabletColumn& field_column = column->subcolumn(i);
         ColumnWriterOptions value_options;
         value_options.meta = opts.meta->mutable_children_columns(i);
-        value_options.need_zone_map = false;
+        value_options.need_zone_map = opts.need_subfield_zone_map && is_zone_map_key_type(field_column.type());
+        value_options.need_subfield_zone_map = opts.need_subfield_zone_map;
         value_options.need_bloom_filter = field_column.is_bf_column();
         value_options.need_bitmap_index = field_column.has_bitmap_index();
         ASSIGN_OR_RETURN(auto field_writer, ColumnWriter::create(value_options, &field_column, wfile));
@@ -189,6 +191,20 @@ Status StructColumnWriter::write_ordinal_index() {
     return Status::OK();
 }
 
+Status StructColumnWriter::write_zone_map() {
+    for (auto& writer : _field_writers) {
+        RETURN_IF_ERROR(writer->write_zone_map());
+    }
+    return Status::OK();
+}
+
+Status StructColumnWriter::write_bloom_filter_index() {
+    for (auto& writer : _field_writers) {
+        RETURN_IF_ERROR(writer->write_bloom_filter_index());
+    }
+    return Status::OK();
+}
+
 Status StructColumnWriter::finish_current_page() {
     if (is_nullable()) {
         RETURN_IF_ERROR(_null_writer->finish_current_page());
@@ -54,7 +54,9 @@
 #include "storage/tablet.h"
 #include "storage/tablet_manager.h"
 #include "storage/tablet_updates.h"
+#include "util/countdown_latch.h"
 #include "util/defer_op.h"
+#include "util/threadpool.h"
 #include "util/unaligned_access.h"
 
 namespace starrocks {
@@ -575,6 +577,11 @@ bool SchemaChangeWithSorting::process(TabletReader* reader, RowsetWriter* new_ro
 Status SchemaChangeWithSorting::process_v2(TabletReader* reader, RowsetWriter* new_rowset_writer,
                                            TabletSharedPtr new_tablet, TabletSharedPtr base_tablet,
                                            RowsetSharedPtr rowset) {
+    if (is_sorted_by_new_keys(new_tablet, base_tablet, rowset)) {
+        VLOG(1) << "the rows of rowset " << rowset->rowset_id() << " are sorted by the new sort keys of tablet "
+                << new_tablet->tablet_id() << ", write them without sorting";
+        return _process_sorted_input(reader, new_rowset_writer, new_tablet, base_tablet);
+    }
     MemTableRowsetWriterSink mem_table_sink(new_rowset_writer);
     Schema base_schema =
             ChunkHelper::convert_schema(base_tablet->tablet_schema(), _chunk_changer->get_selected_column_indexes());
@@ -602,8 +609,9 @@ Status SchemaChangeWithSorting::process_v2(TabletReader* reader, RowsetWriter* n
 #ifndef BE_TEST
         auto cur_usage = CurrentThread::mem_tracker()->consumption();
         // we check memory usage exceeds 90% since tablet reader use some memory
-        // it will return fail if memory is exhausted
-        if (cur_usage > CurrentThread::mem_tracker()->limit() * 0.9) {
+        // it will return fail if memory is exhausted, also flush if the memory limit shared with the loads is exceeded
+        if (cur_usage > CurrentThread::mem_tracker()->limit() * 0.9 ||
+            CurrentThread::mem_tracker()->any_limit_exceeded()) {
             RETURN_IF_ERROR_WITH_WARN(mem_table->finalize(), "failed to finalize mem table");
             RETURN_IF_ERROR_WITH_WARN(mem_table->flush(), "failed to flush mem table");
             mem_table = std::make_unique<MemTable>(new_tablet->tablet_id(), &new_schema, &mem_table_sink,
@@ -661,6 +669,129 @@ Status SchemaChangeWithSorting::process_v2(TabletReader* reader, RowsetWriter* n
     return Status::OK();
 }
 
+bool SchemaChangeWithSorting::is_sorted_by_new_keys(const TabletSharedPtr& new_tablet,
+                                                    const TabletSharedPtr& base_tablet,
+                                                    const RowsetSharedPtr& rowset) const {
+    const TabletSchema& base_schema = base_tablet->tablet_schema();
+    const TabletSchema& new_schema = new_tablet->tablet_schema();
+    // The reader merges the segments of the other keys types by the keys, but only unions the segments of the
+    // duplicate keys, which are sorted as a whole only if they are not overlapping.
+    if (base_schema.keys_type() == KeysType::DUP_KEYS && rowset->num_segments() > 1 &&
+        rowset->rowset_meta()->segments_overlap() != NONOVERLAPPING) {
+        return false;
+    }
+    auto sort_keys_of = [](const TabletSchema& schema) {
+        std::vector<ColumnId> sort_key_idxes = schema.sort_key_idxes();
+        if (sort_key_idxes.empty()) {
+            for (ColumnId i = 0; i < schema.num_key_columns(); i++) {
+                sort_key_idxes.push_back(i);
+            }
+        }
+        return sort_key_idxes;
+    };
+    const auto base_sort_keys = sort_keys_of(base_schema);
+    const auto new_sort_keys = sort_keys_of(new_schema);
+    if (new_sort_keys.empty() || new_sort_keys.size() > base_sort_keys.size()) {
+        return false;
+    }
+    // The new sort keys must be a prefix of the base ones, copied without any conversion changing the order.
+    for (size_t i = 0; i < new_sort_keys.size(); i++) {
+        const ColumnMapping* column_mapping = _chunk_changer->get_mutable_column_mapping(new_sort_keys[i]);
+        if (column_mapping->ref_column < 0 || column_mapping->ref_column != base_sort_keys[i] ||
+            !column_mapping->materialized_function.empty()) {
+            return false;
+        }
+        const TabletColumn& new_column = new_schema.column(new_sort_keys[i]);
+        const TabletColumn& base_column = base_schema.column(column_mapping->ref_column);
+        if (new_column.type() != base_column.type()) {
+            return false;
+        }
+        if (is_decimalv3_field_type(new_column.type()) &&
+            (new_column.precision() != base_column.precision() || new_column.scale() != base_column.scale())) {
+            return false;
+        }
+        // the char columns are padded to their lengths
+        if (new_column.type() == TYPE_CHAR && new_column.length() != base_column.length()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Status SchemaChangeWithSorting::_process_sorted_input(TabletReader* reader, RowsetWriter* new_rowset_writer,
+                                                      const TabletSharedPtr& new_tablet,
+                                                      const TabletSharedPtr& base_tablet) {
+    Schema base_schema =
+            ChunkHelper::convert_schema(base_tablet->tablet_schema(), _chunk_changer->get_selected_column_indexes());
+    Schema new_schema = ChunkHelper::convert_schema(new_tablet->tablet_schema());
+    auto char_field_indexes = ChunkHelper::get_char_field_indexes(new_schema);
+
+    std::unique_ptr<ChunkAggregator> aggregator;
+    if (new_tablet->keys_type() != KeysType::DUP_KEYS) {
+        aggregator = std::make_unique<ChunkAggregator>(&new_schema, config::vector_chunk_size, 0);
+    }
+    DeferOp close_aggregator([&] {
+        if (aggregator != nullptr) {
+            aggregator->close();
+        }
+    });
+
+    auto write_chunk = [&](ChunkPtr& chunk) -> Status {
+        if (aggregator == nullptr) {
+            return new_rowset_writer->add_chunk(*chunk);
+        }
+        aggregator->update_source(chunk);
+        aggregator->aggregate();
+        while (aggregator->is_finish()) {
+            RETURN_IF_ERROR(new_rowset_writer->add_chunk(*aggregator->aggregate_result()));
+            aggregator->aggregate_reset();
+            aggregator->aggregate();
+        }
+        return Status::OK();
+    };
+
+    std::unique_ptr<MemPool> mem_pool(new MemPool());
+    StorageEngine* storage_engine = StorageEngine::instance();
+    while (true) {
+        if (storage_engine->bg_worker_stopped()) {
+            return Status::InternalError("bg_worker_stopped");
+        }
+#ifndef BE_TEST
+        RETURN_IF_ERROR_WITH_WARN(CurrentThread::mem_tracker()->check_mem_limit("SortedSchemaChange"),
+                                  "fail to execute schema change");
+#endif
+        ChunkPtr base_chunk = ChunkHelper::new_chunk(base_schema, config::vector_chunk_size);
+        Status status = reader->do_get_next(base_chunk.get());
+        if (!status.ok()) {
+            if (!status.is_end_of_file()) {
+                LOG(WARNING) << "failed to get next chunk, status is:" << status.to_string();
+                return status;
+            } else if (base_chunk->num_rows() <= 0) {
+                break;
+            }
+        }
+        // the aggregator may refer to the source chunk until it's exhausted, so allocate a new one every time
+        ChunkPtr new_chunk = ChunkHelper::new_chunk(new_schema, base_chunk->num_rows());
+        if (!_chunk_changer->change_chunk_v2(base_chunk, new_chunk, base_schema, new_schema, mem_pool.get())) {
+            std::string err_msg = strings::Substitute("failed to convert chunk data. base tablet:$0, new tablet:$1",
+                                                      base_tablet->tablet_id(), new_tablet->tablet_id());
+            LOG(WARNING) << err_msg;
+            return Status::InternalError(err_msg);
+        }
+        ChunkHelper::padding_char_columns(char_field_indexes, new_schema, new_tablet->tablet_schema(), new_chunk.get());
+        RETURN_IF_ERROR_WITH_WARN(write_chunk(new_chunk), "rowset writer add chunk failed");
+        mem_pool->clear();
+    }
+
+    if (aggregator != nullptr && aggregator->has_aggregate_data()) {
+        aggregator->aggregate();
+        RETURN_IF_ERROR_WITH_WARN(new_rowset_writer->add_chunk(*aggregator->aggregate_result()),
+                                  "rowset writer add chunk failed");
+    }
+    RETURN_IF_ERROR_WITH_WARN(new_rowset_writer->flush(), "failed to flush rowset writer");
+    return Status::OK();
+}
+
 bool SchemaChangeWithSorting::_internal_sorting(std::vector<ChunkPtr>& chunk_arr, RowsetWriter* new_rowset_writer,
                                                 TabletSharedPtr tablet) {
     if (chunk_arr.size() == 1) {
@@ -954,6 +1085,21 @@ Status SchemaChangeHandler::_get_versions_to_be_changed(const TabletSharedPtr& b
     return Status::OK();
 }
 
+// The pool converting the rowsets of the schema changes in parallel, nullptr if it can not be created.
+static ThreadPool* schema_change_pool() {
+    static std::unique_ptr<ThreadPool> pool = [] {
+        std::unique_ptr<ThreadPool> p;
+        auto st = ThreadPoolBuilder("schema_change")
+                          .set_min_threads(0)
+                          .set_max_threads(std::max(1, config::schema_change_parallel_rowset_threads))
+                          .set_idle_timeout(MonoDelta::FromMilliseconds(2000))
+                          .build(&p);
+        LOG_IF(WARNING, !st.ok()) << "Fail to create the schema change pool, convert the rowsets serially: " << st;
+        return p;
+    }();
+    return pool.get();
+}
+
 Status SchemaChangeHandler::_convert_historical_rowsets(SchemaChangeParams& sc_params) {
     LOG(INFO) << "begin to convert historical rowsets for new_tablet from base_tablet."
               << " base_tablet=" << sc_params.base_tablet->full_name()
@@ -963,13 +1109,26 @@ Status SchemaChangeHandler::_convert_historical_rowsets(SchemaChangeParams& sc_p
         sc_params.new_tablet->save_meta();
     });
 
+    // The rowsets are converted by different readers and writers, so they can be converted in parallel, except by
+    // the schema change v1, whose procedures keep the states of the rowset being converted.
+    const size_t num_rowsets = sc_params.rowset_readers.size();
+    ThreadPool* pool = nullptr;
+    size_t parallelism = 1;
+    if (config::enable_schema_change_v2 && config::schema_change_parallel_rowset_threads > 1 && num_rowsets > 1) {
+        pool = schema_change_pool();
+        if (pool != nullptr) {
+            parallelism = std::min<size_t>(num_rowsets, config::schema_change_parallel_rowset_threads);
+        }
+    }
+
     std::unique_ptr<SchemaChange> sc_procedure;
     auto chunk_changer = sc_params.chunk_changer.get();
     if (sc_params.sc_sorting) {
         LOG(INFO) << "doing schema change with sorting for base_tablet " << sc_params.base_tablet->full_name();
+        // the parallel rowsets share the memory limitation of the task
         size_t memory_limitation =
                 static_cast<size_t>(config::memory_limitation_per_thread_for_schema_change) * 1024 * 1024 * 1024;
-        sc_procedure = std::make_unique<SchemaChangeWithSorting>(chunk_changer, memory_limitation);
+        sc_procedure = std::make_unique<SchemaChangeWithSorting>(chunk_changer, memory_limitation / parallelism);
     } else if (sc_params.sc_directly) {
         LOG(INFO) << "doing directly schema change for base_tablet " << sc_params.base_tablet->full_name();
         sc_procedure = std::make_unique<SchemaChangeDirectly>(chunk_changer);
@@ -984,73 +1143,58 @@ Status SchemaChangeHandler::_convert_historical_rowsets(SchemaChangeParams& sc_p
         return Status::InternalError("failed to malloc SchemaChange");
     }
 
-    Status status;
-
-    for (int i = 0; i < sc_params.rowset_readers.size(); ++i) {
-        VLOG(3) << "begin to convert a history rowset. version=" << sc_params.rowsets_to_change[i]->version();
-
-        TabletSharedPtr new_tablet = sc_params.new_tablet;
-        TabletSharedPtr base_tablet = sc_params.base_tablet;
-        RowsetWriterContext writer_context;
-        writer_context.rowset_id = StorageEngine::instance()->next_rowset_id();
-        writer_context.tablet_uid = new_tablet->tablet_uid();
-        writer_context.tablet_id = new_tablet->tablet_id();
-        writer_context.partition_id = new_tablet->partition_id();
-        writer_context.tablet_schema_hash = new_tablet->schema_hash();
-        writer_context.rowset_path_prefix = new_tablet->schema_hash_path();
-        writer_context.tablet_schema = &new_tablet->tablet_schema();
-        writer_context.rowset_state = VISIBLE;
-        writer_context.version = sc_params.rowsets_to_change[i]->version();
-        writer_context.segments_overlap = sc_params.rowsets_to_change[i]->rowset_meta()->segments_overlap();
-
-        if (sc_params.sc_sorting) {
-            writer_context.schema_change_sorting = true;
-        }
-
-        std::unique_ptr<RowsetWriter> rowset_writer;
-        status = RowsetFactory::create_rowset_writer(writer_context, &rowset_writer);
-        if (!status.ok()) {
-            return Status::InternalError("build rowset writer failed");
+    std::vector<StatusOr<RowsetSharedPtr>> new_rowsets(num_rowsets, Status::InternalError("rowset not converted"));
+    if (parallelism > 1) {
+        VLOG(1) << "convert " << num_rowsets << " rowsets of tablet " << sc_params.new_tablet->tablet_id()
+                << " with parallelism " << parallelism;
+        MemTracker* mem_tracker = CurrentThread::mem_tracker();
+        CountDownLatch latch(num_rowsets);
+        for (size_t i = 0; i < num_rowsets; i++) {
+            auto task = [&, i]() {
+                SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(mem_tracker);
+                new_rowsets[i] = _convert_rowset(sc_params, sc_procedure.get(), i);
+                latch.count_down();
+            };
+            if (!pool->submit_func(task).ok()) {
+                task();
+            }
         }
+        latch.wait();
+    } else {
+        for (size_t i = 0; i < num_rowsets; i++) {
+            new_rowsets[i] = _convert_rowset(sc_params, sc_procedure.get(), i);
+            if (!new_rowsets[i].ok()) {
+                break;
+            }
+        }
+    }
 
-        if (config::enable_schema_change_v2) {
-            auto st = sc_procedure->process_v2(sc_params.rowset_readers[i].get(), rowset_writer.get(), new_tablet,
-                                               base_tablet, sc_params.rowsets_to_change[i]);
-            if (!st.ok()) {
-                LOG(WARNING) << "failed to process the schema change. from tablet "
-                             << base_tablet->get_tablet_info().to_string() << " to tablet "
-                             << new_tablet->get_tablet_info().to_string() << " version=" << sc_params.version.first
-                             << "-" << sc_params.version.second << " error " << st;
-                return st;
+    Status status;
+    for (size_t i = 0; i < num_rowsets; i++) {
+        if (!status.ok() || !new_rowsets[i].ok()) {
+            if (status.ok()) {
+                status = new_rowsets[i].status();
             }
-        } else {
-            if (!sc_procedure->process(sc_params.rowset_readers[i].get(), rowset_writer.get(), new_tablet, base_tablet,
-                                       sc_params.rowsets_to_change[i])) {
-                LOG(WARNING) << "failed to process the version."
-                             << " version=" << sc_params.version.first << "-" << sc_params.version.second;
-                return Status::InternalError("process failed");
+            // the rowsets converted after a failure are not added
+            if (new_rowsets[i].ok()) {
+                StorageEngine::instance()->add_unused_rowset(*new_rowsets[i]);
             }
+            continue;
         }
-        sc_params.rowset_readers[i]->close();
-        auto new_rowset = rowset_writer->build();
-        if (!new_rowset.ok()) {
-            LOG(WARNING) << "failed to build rowset: " << new_rowset.status() << ". exit alter process";
-            break;
-        }
-        LOG(INFO) << "new rowset has " << (*new_rowset)->num_segments() << " segments";
-        status = sc_params.new_tablet->add_rowset(*new_rowset, false);
+        const auto& new_rowset = new_rowsets[i].value();
+        LOG(INFO) << "new rowset has " << new_rowset->num_segments() << " segments";
+        status = sc_params.new_tablet->add_rowset(new_rowset, false);
         if (status.is_already_exist()) {
             LOG(WARNING) << "version already exist, version revert occurred. "
                          << "tablet=" << sc_params.new_tablet->full_name() << ", version='" << sc_params.version.first
                          << "-" << sc_params.version.second;
-            StorageEngine::instance()->add_unused_rowset(*new_rowset);
+            StorageEngine::instance()->add_unused_rowset(new_rowset);
             status = Status::OK();
         } else if (!status.ok()) {
             LOG(WARNING) << "failed to register new version. "
                          << " tablet=" << sc_params.new_tablet->full_name() << ", version=" << sc_params.version.first
                          << "-" << sc_params.version.second;
-            StorageEngine::instance()->add_unused_rowset(*new_rowset);
-            break;
+            StorageEngine::instance()->add_unused_rowset(new_rowset);
         } else {
             VLOG(3) << "register new version. tablet=" << sc_params.new_tablet->full_name()
                     << ", version=" << sc_params.version.first << "-" << sc_params.version.second;
@@ -1071,6 +1215,60 @@ Status SchemaChangeHandler::_convert_historical_rowsets(SchemaChangeParams& sc_p
     return status;
 }
 
+StatusOr<RowsetSharedPtr> SchemaChangeHandler::_convert_rowset(SchemaChangeParams& sc_params,
+                                                               SchemaChange* sc_procedure, size_t i) {
+    VLOG(3) << "begin to convert a history rowset. version=" << sc_params.rowsets_to_change[i]->version();
+
+    TabletSharedPtr new_tablet = sc_params.new_tablet;
+    TabletSharedPtr base_tablet = sc_params.base_tablet;
+    RowsetWriterContext writer_context;
+    writer_context.rowset_id = StorageEngine::instance()->next_rowset_id();
+    writer_context.tablet_uid = new_tablet->tablet_uid();
+    writer_context.tablet_id = new_tablet->tablet_id();
+    writer_context.partition_id = new_tablet->partition_id();
+    writer_context.tablet_schema_hash = new_tablet->schema_hash();
+    writer_context.rowset_path_prefix = new_tablet->schema_hash_path();
+    writer_context.tablet_schema = &new_tablet->tablet_schema();
+    writer_context.rowset_state = VISIBLE;
+    writer_context.version = sc_params.rowsets_to_change[i]->version();
+    writer_context.segments_overlap = sc_params.rowsets_to_change[i]->rowset_meta()->segments_overlap();
+
+    if (sc_params.sc_sorting) {
+        writer_context.schema_change_sorting = true;
+    }
+
+    std::unique_ptr<RowsetWriter> rowset_writer;
+    Status status = RowsetFactory::create_rowset_writer(writer_context, &rowset_writer);
+    if (!status.ok()) {
+        return Status::InternalError("build rowset writer failed");
+    }
+
+    if (config::enable_schema_change_v2) {
+        auto st = sc_procedure->process_v2(sc_params.rowset_readers[i].get(), rowset_writer.get(), new_tablet,
+                                           base_tablet, sc_params.rowsets_to_change[i]);
+        if (!st.ok()) {
+            LOG(WARNING) << "failed to process the schema change. from tablet "
+                         << base_tablet->get_tablet_info().to_string() << " to tablet "
+                         << new_tablet->get_tablet_info().to_string() << " version=" << writer_context.version.first
+                         << "-" << writer_context.version.second << " error " << st;
+            return st;
+        }
+    } else {
+        if (!sc_procedure->process(sc_params.rowset_readers[i].get(), rowset_writer.get(), new_tablet, base_tablet,
+                                   sc_params.rowsets_to_change[i])) {
+            LOG(WARNING) << "failed to process the version."
+                         << " version=" << writer_context.version.first << "-" << writer_context.version.second;
+            return Status::InternalError("process failed");
+        }
+    }
+    sc_params.rowset_readers[i]->close();
+    auto new_rowset = rowset_writer->build();
+    if (!new_rowset.ok()) {
+        LOG(WARNING) << "failed to build rowset: " << new_rowset.status() << ". exit alter process";
+    }
+    return new_rowset;
+}
+
 Status SchemaChangeHandler::_validate_alter_result(const TabletSharedPtr& new_tablet,
                                                    const TAlterTabletReqV2& request) {
     int64_t max_continuous_version = new_tablet->max_continuous_version();
@@ -128,6 +128,8 @@ private:
 };
 
 // @breif schema change with sorting
+// If the rows read from a rowset are already sorted by the new sort keys, e.g. the new sort keys are a prefix of
+// the base ones, they are written directly, and aggregated if needed, instead of being sorted again.
 class SchemaChangeWithSorting : public SchemaChange {
 public:
     explicit SchemaChangeWithSorting(ChunkChanger* chunk_changer, size_t memory_limitation);
@@ -142,7 +144,16 @@ public:
     static bool _internal_sorting(std::vector<ChunkPtr>& chunk_arr, RowsetWriter* new_rowset_writer,
                                   TabletSharedPtr tablet);
 
+    // Whether the rows of |rowset| read by the base reader are sorted by the sort keys of |new_tablet| after changed.
+    bool is_sorted_by_new_keys(const TabletSharedPtr& new_tablet, const TabletSharedPtr& base_tablet,
+                               const RowsetSharedPtr& rowset) const;
+
 private:
+    // Change the sorted rows read by |reader| and write them in order, aggregate the rows of the same keys
+    // if the new tablet is not of duplicate keys.
+    Status _process_sorted_input(TabletReader* reader, RowsetWriter* new_rowset_writer,
+                                 const TabletSharedPtr& new_tablet, const TabletSharedPtr& base_tablet);
+
     ChunkChanger* _chunk_changer = nullptr;
     size_t _memory_limitation;
     ChunkAllocator* _chunk_allocator = nullptr;
@@ -183,6 +194,10 @@ private:
 
     static Status _convert_historical_rowsets(SchemaChangeParams& sc_params);
 
+    // Convert the |i|-th rowset of |sc_params| by |sc_procedure| into a new rowset.
+    static StatusOr<RowsetSharedPtr> _convert_rowset(SchemaChangeParams& sc_params, SchemaChange* sc_procedure,
+                                                     size_t i);
+
     DISALLOW_COPY(SchemaChangeHandler);
 };
 
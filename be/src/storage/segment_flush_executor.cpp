@@ -40,7 +40,9 @@ Status SegmentFlushToken::submit(brpc::Controller* cntl, const PTabletWriterAddS
     auto submit_st = _flush_token->submit_func([this, cntl, request, response, done] {
         auto& writer = this->_writer;
         auto st = Status::OK();
-        if (request->has_segment() && cntl->request_attachment().size() > 0) {
+        // all the data of a segment streamed by pieces may have been sent before
+        if (request->has_segment() &&
+            (cntl->request_attachment().size() > 0 || request->segment().streamed_size() > 0)) {
             auto& segment_pb = request->segment();
             st = writer->write_segment(segment_pb, cntl->request_attachment());
         } else if (!request->eos()) {
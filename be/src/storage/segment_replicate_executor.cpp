@@ -14,6 +14,7 @@
 
 #include "storage/segment_replicate_executor.h"
 
+#include <butil/iobuf.h>
 #include <fmt/format.h>
 
 #include <memory>
@@ -25,6 +26,7 @@
 #include "runtime/exec_env.h"
 #include "storage/delta_writer.h"
 #include "util/brpc_stub_cache.h"
+#include "util/crc32c.h"
 #include "util/raw_container.h"
 
 namespace starrocks {
@@ -44,6 +46,23 @@ private:
     bool _eos;
 };
 
+class SegmentPieceReplicateTask final : public Runnable {
+public:
+    SegmentPieceReplicateTask(ReplicateToken* replicate_token, std::unique_ptr<SegmentPB> segment, butil::IOBuf* piece)
+            : _replicate_token(replicate_token), _segment(std::move(segment)) {
+        _piece.swap(*piece);
+    }
+
+    ~SegmentPieceReplicateTask() override = default;
+
+    void run() override { _replicate_token->_sync_segment_piece(std::move(_segment), &_piece); }
+
+private:
+    ReplicateToken* _replicate_token;
+    std::unique_ptr<SegmentPB> _segment;
+    butil::IOBuf _piece;
+};
+
 ReplicateChannel::ReplicateChannel(const DeltaWriterOptions* opt, std::string host, int32_t port, int64_t node_id)
         : _opt(opt), _host(std::move(host)), _port(port), _node_id(node_id) {
     _closure = new ReusableClosure<PTabletWriterAddSegmentResult>();
@@ -219,6 +238,15 @@ Status ReplicateToken::submit(std::unique_ptr<SegmentPB> segment, bool eos) {
     return _replicate_token->submit(std::move(task));
 }
 
+Status ReplicateToken::submit_piece(int64_t segment_id, int64_t offset, butil::IOBuf* piece) {
+    RETURN_IF_ERROR(status());
+    auto segment = std::make_unique<SegmentPB>();
+    segment->set_segment_id(segment_id);
+    segment->set_piece_offset(offset);
+    auto task = std::make_shared<SegmentPieceReplicateTask>(this, std::move(segment), piece);
+    return _replicate_token->submit(std::move(task));
+}
+
 void ReplicateToken::cancel(const Status& st) {
     for (auto& channel : _replicate_channels) {
         channel->cancel();
@@ -249,6 +277,14 @@ void ReplicateToken::_sync_segment(std::unique_ptr<SegmentPB> segment, bool eos)
     if (segment) {
         // 1.1 read segment file
         if (segment->has_path()) {
+            // only the rest of a segment streamed by pieces is sent
+            int64_t streamed_size = 0;
+            uint32_t checksum = 0;
+            if (auto iter = _streamed_segments.find(segment->segment_id()); iter != _streamed_segments.end()) {
+                streamed_size = iter->second.size;
+                checksum = iter->second.checksum;
+                _streamed_segments.erase(iter);
+            }
             auto res = _fs->new_random_access_file(segment->path());
             if (!res.ok()) {
                 LOG(WARNING) << "Failed to open segment file " << segment->DebugString() << " by " << debug_string()
@@ -256,13 +292,21 @@ void ReplicateToken::_sync_segment(std::unique_ptr<SegmentPB> segment, bool eos)
                 return set_status(res.status());
             }
             auto rfile = std::move(res.value());
-            auto buf = new uint8[segment->data_size()];
-            data.append_user_data(buf, segment->data_size(), [](void* buf) { delete[](uint8*) buf; });
-            auto st = rfile->read_fully(buf, segment->data_size());
-            if (!st.ok()) {
-                LOG(WARNING) << "Failed to read segment " << segment->DebugString() << " by " << debug_string()
-                             << " err " << st;
-                return set_status(st);
+            const int64_t size = segment->data_size() - streamed_size;
+            if (size > 0) {
+                auto buf = new uint8[size];
+                data.append_user_data(buf, size, [](void* buf) { delete[](uint8*) buf; });
+                auto st = rfile->read_at_fully(streamed_size, buf, size);
+                if (!st.ok()) {
+                    LOG(WARNING) << "Failed to read segment " << segment->DebugString() << " by " << debug_string()
+                                 << " err " << st;
+                    return set_status(st);
+                }
+                checksum = crc32c::Extend(checksum, reinterpret_cast<const char*>(buf), size);
+            }
+            if (streamed_size > 0) {
+                segment->set_streamed_size(streamed_size);
+                segment->set_checksum(checksum);
             }
         }
         if (segment->has_delete_path()) {
@@ -285,10 +329,28 @@ void ReplicateToken::_sync_segment(std::unique_ptr<SegmentPB> segment, bool eos)
     }
 
     // 2. send segment to secondary replica
+    _send_to_replicas(segment.get(), data, eos);
+}
+
+void ReplicateToken::_sync_segment_piece(std::unique_ptr<SegmentPB> segment, butil::IOBuf* piece) {
+    // If previous sync has failed, return directly
+    if (!status().ok()) return;
+
+    auto& streamed = _streamed_segments[segment->segment_id()];
+    for (size_t i = 0; i < piece->backing_block_num(); i++) {
+        auto block = piece->backing_block(i);
+        streamed.checksum = crc32c::Extend(streamed.checksum, block.data(), block.size());
+    }
+    streamed.size += static_cast<int64_t>(piece->size());
+
+    _send_to_replicas(segment.get(), *piece, false);
+}
+
+void ReplicateToken::_send_to_replicas(SegmentPB* segment, butil::IOBuf& data, bool eos) {
     for (auto& channel : _replicate_channels) {
         auto st = Status::OK();
         if (_failed_node_id.count(channel->node_id()) == 0) {
-            st = channel->async_segment(segment.get(), data, eos, &_replicated_tablet_infos, &_failed_tablet_infos);
+            st = channel->async_segment(segment, data, eos, &_replicated_tablet_infos, &_failed_tablet_infos);
             if (!st.ok()) {
                 LOG(WARNING) << "Failed to sync segment " << channel->debug_string() << " err " << st;
                 channel->cancel();
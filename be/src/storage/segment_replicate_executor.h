@@ -15,6 +15,7 @@
 #pragma once
 
 #include <atomic>
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -81,6 +82,10 @@ public:
 
     Status submit(std::unique_ptr<SegmentPB> segment, bool eos);
 
+    // Submit the piece of the segment |segment_id| at |offset| streamed while the segment is written, the bytes
+    // of |piece| are taken away. The pieces of a segment must be submitted in order before the segment.
+    Status submit_piece(int64_t segment_id, int64_t offset, butil::IOBuf* piece);
+
     // when error has happpens, so we cancel this token
     // and remove all tasks in the queue.
     void cancel(const Status& st);
@@ -111,8 +116,11 @@ public:
 
 private:
     friend class SegmentReplicateTask;
+    friend class SegmentPieceReplicateTask;
 
     void _sync_segment(std::unique_ptr<SegmentPB> segment, bool eos);
+    void _sync_segment_piece(std::unique_ptr<SegmentPB> segment, butil::IOBuf* piece);
+    void _send_to_replicas(SegmentPB* segment, butil::IOBuf& data, bool eos);
 
     std::unique_ptr<ThreadPoolToken> _replicate_token;
 
@@ -132,6 +140,13 @@ private:
     std::set<int64_t> _failed_node_id;
 
     int64_t _max_fail_replica_num;
+
+    // The size and crc32c of the pieces sent of the segments being streamed.
+    struct StreamedSegment {
+        int64_t size = 0;
+        uint32_t checksum = 0;
+    };
+    std::map<int64_t, StreamedSegment> _streamed_segments;
 };
 
 class SegmentReplicateExecutor {
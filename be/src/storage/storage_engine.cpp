@@ -552,6 +552,9 @@ void StorageEngine::stop() {
     if (_adjust_cache_thread.joinable()) {
         _adjust_cache_thread.join();
     }
+    if (_primary_index_preload_thread.joinable()) {
+        _primary_index_preload_thread.join();
+    }
     if (config::path_gc_check) {
         for (auto& thread : _path_scan_threads) {
             if (thread.joinable()) {
@@ -291,6 +291,9 @@ private:
 
     void* _adjust_pagecache_callback(void* arg);
 
+    // load the primary indexes of the recently written tablets after BE starts
+    void* _primary_index_preload_callback(void* arg);
+
     void _start_clean_fd_cache();
     Status _perform_cumulative_compaction(DataDir* data_dir, std::pair<int32_t, int32_t> tablet_shards_range);
     Status _perform_base_compaction(DataDir* data_dir, std::pair<int32_t, int32_t> tablet_shards_range);
@@ -357,6 +360,7 @@ private:
     // threads to clean all file descriptor not actively in use
     std::thread _fd_cache_clean_thread;
     std::thread _adjust_cache_thread;
+    std::thread _primary_index_preload_thread;
     std::vector<std::thread> _path_gc_threads;
     // threads to scan disk paths
     std::vector<std::thread> _path_scan_threads;
@@ -38,6 +38,7 @@
 #include <fmt/format.h>
 #include <re2/re2.h>
 
+#include <algorithm>
 #include <ctime>
 #include <memory>
 
@@ -626,6 +627,36 @@ TabletSharedPtr TabletManager::find_best_tablet_to_compaction(CompactionType com
     return best_tablet;
 }
 
+std::vector<TabletSharedPtr> TabletManager::pick_tablets_to_preload_primary_index(size_t max_num,
+                                                                                  int64_t since_time) {
+    std::vector<std::pair<int64_t, TabletSharedPtr>> candidates;
+    for (const auto& tablets_shard : _tablets_shards) {
+        std::shared_lock rlock(tablets_shard.lock);
+        for (const auto& [tablet_id, tablet_ptr] : tablets_shard.tablet_map) {
+            if (tablet_ptr->keys_type() != PRIMARY_KEYS || tablet_ptr->updates() == nullptr) {
+                continue;
+            }
+            if (tablet_ptr->tablet_state() != TABLET_RUNNING || !tablet_ptr->is_used() ||
+                !tablet_ptr->init_succeeded()) {
+                continue;
+            }
+            int64_t write_time = tablet_ptr->updates()->max_version_creation_time();
+            if (write_time >= since_time) {
+                candidates.emplace_back(write_time, tablet_ptr);
+            }
+        }
+    }
+    size_t num = std::min(max_num, candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + num, candidates.end(),
+                      [](const auto& a, const auto& b) { return a.first > b.first; });
+    std::vector<TabletSharedPtr> tablets;
+    tablets.reserve(num);
+    for (size_t i = 0; i < num; i++) {
+        tablets.emplace_back(std::move(candidates[i].second));
+    }
+    return tablets;
+}
+
 TabletSharedPtr TabletManager::find_best_tablet_to_do_update_compaction(DataDir* data_dir) {
     int64_t highest_score = 0;
     TabletSharedPtr best_tablet;
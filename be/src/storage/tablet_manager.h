@@ -112,6 +112,10 @@ public:
 
     TabletSharedPtr find_best_tablet_to_do_update_compaction(DataDir* data_dir);
 
+    // Pick at most |max_num| primary key tablets written after |since_time|(in seconds),
+    // the most recently written first.
+    std::vector<TabletSharedPtr> pick_tablets_to_preload_primary_index(size_t max_num, int64_t since_time);
+
     // TODO: pass |include_deleted| as an enum instead of boolean to avoid unexpected implicit cast.
     TabletSharedPtr get_tablet(TTabletId tablet_id, bool include_deleted = false, std::string* err = nullptr);
 
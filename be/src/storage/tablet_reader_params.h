@@ -55,6 +55,8 @@ struct TabletReaderParams {
     // 2. when read column index page
     //     if config::disable_storage_page_cache is false, we use page cache
     bool use_page_cache = false;
+    // Read the column data pages with O_DIRECT, bypassing the OS page cache.
+    bool use_direct_io = false;
 
     RangeStartOperation range = RangeStartOperation::GT;
     RangeEndOperation end_range = RangeEndOperation::LT;
@@ -70,6 +72,8 @@ struct TabletReaderParams {
 
     ColumnIdToGlobalDictMap* global_dictmaps = &EMPTY_GLOBAL_DICTMAPS;
     const std::unordered_set<uint32_t>* unused_output_column_ids = &EMPTY_FILTERED_COLUMN_IDS;
+    // The ARRAY and MAP columns of which only the lengths are read, see ColumnIteratorOptions::lengths_only.
+    const std::unordered_set<uint32_t>* lengths_only_column_ids = &EMPTY_FILTERED_COLUMN_IDS;
 
     RowidRangeOptionPtr rowid_range_option = nullptr;
     std::vector<ShortKeyRangeOptionPtr> short_key_ranges;
@@ -376,6 +376,11 @@ int64_t TabletUpdates::max_version() const {
     return _edit_version_infos.empty() ? 0 : _edit_version_infos.back()->version.major();
 }
 
+int64_t TabletUpdates::max_version_creation_time() const {
+    std::lock_guard rl(_lock);
+    return _edit_version_infos.empty() ? 0 : _edit_version_infos.back()->creation_time;
+}
+
 Status TabletUpdates::get_rowsets_total_stats(const std::vector<uint32_t>& rowsets, size_t* total_rows,
                                               size_t* total_dels) {
     string err_rowsets;
@@ -724,6 +729,7 @@ void TabletUpdates::do_apply() {
     bool first = true;
     while (!_apply_stopped) {
         const EditVersionInfo* version_info_apply = nullptr;
+        const EditVersionInfo* version_info_next = nullptr;
         {
             std::lock_guard rl(_lock);
             if (_edit_version_infos.empty()) {
@@ -740,6 +746,18 @@ void TabletUpdates::do_apply() {
             }
             // we make sure version_info_apply will never be deleted before apply finished
             version_info_apply = _edit_version_infos[_apply_version_idx + 1].get();
+            if (_apply_version_idx + 2 < _edit_version_infos.size()) {
+                version_info_next = _edit_version_infos[_apply_version_idx + 2].get();
+            }
+        }
+        if (version_info_next != nullptr && version_info_next->deltas.size() > 0) {
+            // load the next version while applying this one
+            auto next_rowset = _get_rowset(version_info_next->deltas[0]);
+            if (next_rowset != nullptr) {
+                StorageEngine::instance()->update_manager()->prefetch_rowset_update_state(
+                        std::static_pointer_cast<Tablet>(_tablet.shared_from_this()), next_rowset,
+                        version_info_next->version.major());
+            }
         }
         if (version_info_apply->deltas.size() > 0) {
             int64_t duration_ns = 0;
@@ -1779,21 +1797,22 @@ int64_t TabletUpdates::get_compaction_score() {
         }
         rowsets = _edit_version_infos[_apply_version_idx]->rowsets;
     }
+    const auto num_scans = _get_rowsets_num_scans(rowsets);
     int64_t total_score = -_compaction_cost_seek;
     bool has_error = false;
     {
         std::lock_guard lg(_rowset_stats_lock);
-        for (auto rowsetid : rowsets) {
-            auto itr = _rowset_stats.find(rowsetid);
+        for (size_t i = 0; i < rowsets.size(); i++) {
+            auto itr = _rowset_stats.find(rowsets[i]);
             if (itr == _rowset_stats.end()) {
                 // should not happen
                 string msg = strings::Substitute("rowset not found in rowset stats tablet=$0 rowset=$1",
-                                                 _tablet.tablet_id(), rowsetid);
+                                                 _tablet.tablet_id(), rowsets[i]);
                 DCHECK(false) << msg;
                 LOG(WARNING) << msg;
                 has_error = true;
-            } else if (itr->second->compaction_score > 0) {
-                total_score += itr->second->compaction_score;
+            } else if (auto score = _compaction_score_with_scans(*itr->second, num_scans[i]); score > 0) {
+                total_score += score;
             }
         }
     }
@@ -1859,23 +1878,24 @@ Status TabletUpdates::compaction(MemTracker* mem_tracker) {
     size_t total_bytes_after_compaction = 0;
     int64_t total_score = -_compaction_cost_seek;
     vector<CompactionEntry> candidates;
+    const auto num_scans = _get_rowsets_num_scans(rowsets);
     {
         std::lock_guard lg(_rowset_stats_lock);
-        for (auto rowsetid : rowsets) {
-            auto itr = _rowset_stats.find(rowsetid);
+        for (size_t i = 0; i < rowsets.size(); i++) {
+            auto itr = _rowset_stats.find(rowsets[i]);
             if (itr == _rowset_stats.end()) {
                 // should not happen
                 string msg = strings::Substitute("rowset not found in rowset stats tablet=$0 rowset=$1",
-                                                 _tablet.tablet_id(), rowsetid);
+                                                 _tablet.tablet_id(), rowsets[i]);
                 DCHECK(false) << msg;
                 LOG(WARNING) << msg;
-            } else if (itr->second->compaction_score > 0) {
+            } else if (auto score = _compaction_score_with_scans(*itr->second, num_scans[i]); score > 0) {
                 auto& stat = *itr->second;
                 total_valid_rowsets++;
                 if (stat.num_rows == stat.num_dels) {
                     // add to compaction directly
                     info->inputs.push_back(itr->first);
-                    total_score += stat.compaction_score;
+                    total_score += score;
                     total_rows += stat.num_rows;
                     total_bytes += stat.byte_size;
                     continue;
@@ -1883,7 +1903,7 @@ Status TabletUpdates::compaction(MemTracker* mem_tracker) {
                 candidates.emplace_back();
                 auto& e = candidates.back();
                 e.rowsetid = itr->first;
-                e.score_per_row = (float)((double)stat.compaction_score / (stat.num_rows - stat.num_dels));
+                e.score_per_row = (float)((double)score / (stat.num_rows - stat.num_dels));
                 e.num_rows = stat.num_rows;
                 e.num_dels = stat.num_dels;
                 e.bytes = stat.byte_size;
@@ -2137,6 +2157,29 @@ void TabletUpdates::_calc_compaction_score(RowsetStats* stats) {
                               cost_record_write * stats->byte_size;
 }
 
+int64_t TabletUpdates::_compaction_score_with_scans(const RowsetStats& stats, int64_t num_scans) {
+    const double cost_per_scan = config::update_compaction_read_cost_per_scan;
+    if (cost_per_scan <= 0 || num_scans <= 0 || stats.num_dels == 0 || stats.num_rows < 10) {
+        return stats.compaction_score;
+    }
+    num_scans = std::min(num_scans, config::update_compaction_max_counted_scans);
+    // use double to prevent overflow
+    auto delete_bytes = stats.byte_size * (double)stats.num_dels / stats.num_rows;
+    return stats.compaction_score + (int64_t)(cost_per_scan * (double)num_scans * delete_bytes);
+}
+
+std::vector<int64_t> TabletUpdates::_get_rowsets_num_scans(const std::vector<uint32_t>& rowset_ids) {
+    std::vector<int64_t> num_scans(rowset_ids.size(), 0);
+    std::lock_guard<std::mutex> lg(_rowsets_lock);
+    for (size_t i = 0; i < rowset_ids.size(); i++) {
+        auto itr = _rowsets.find(rowset_ids[i]);
+        if (itr != _rowsets.end()) {
+            num_scans[i] = itr->second->num_query_scans();
+        }
+    }
+    return num_scans;
+}
+
 size_t TabletUpdates::_get_rowset_num_deletes(uint32_t rowsetid) {
     auto rowset = _get_rowset(rowsetid);
     return (rowset == nullptr) ? 0 : _get_rowset_num_deletes(*rowset);
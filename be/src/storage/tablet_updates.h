@@ -89,6 +89,9 @@ public:
     // get latest version's version
     int64_t max_version() const;
 
+    // get the creation time(in seconds) of latest version, which is the time of the last write or compaction
+    int64_t max_version_creation_time() const;
+
     // get total number of committed and pending rowsets
     size_t version_count() const;
 
@@ -329,6 +332,12 @@ private:
 
     void _calc_compaction_score(RowsetStats* stats);
 
+    // The compaction score of a rowset including the cost of reading its deleted rows in |num_scans| scans.
+    static int64_t _compaction_score_with_scans(const RowsetStats& stats, int64_t num_scans);
+
+    // This method will acquire |_rowsets_lock|.
+    std::vector<int64_t> _get_rowsets_num_scans(const std::vector<uint32_t>& rowset_ids);
+
     Status _do_update(std::uint32_t rowset_id, std::int32_t upsert_idx, std::int32_t condition_column,
                       const std::vector<ColumnUniquePtr>& upserts, PrimaryIndex& index, std::int64_t tablet_id,
                       DeletesMap* new_deletes);
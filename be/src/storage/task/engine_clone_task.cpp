@@ -37,6 +37,7 @@
 #include <fmt/format.h>
 #include <sys/stat.h>
 
+#include <atomic>
 #include <filesystem>
 #include <set>
 
@@ -61,9 +62,12 @@
 #include "storage/rowset/rowset_factory.h"
 #include "storage/snapshot_manager.h"
 #include "storage/tablet_updates.h"
+#include "util/bandwidth_throttle.h"
+#include "util/countdown_latch.h"
 #include "util/defer_op.h"
 #include "util/string_parser.hpp"
 #include "util/thrift_rpc_helper.h"
+#include "util/threadpool.h"
 
 using std::set;
 using std::stringstream;
@@ -80,6 +84,22 @@ const uint32_t DOWNLOAD_FILE_MAX_RETRY = 3;
 const uint32_t LIST_REMOTE_FILE_TIMEOUT = 15;
 const uint32_t GET_LENGTH_TIMEOUT = 10;
 
+// The pool downloading the files of the clones in parallel, nullptr if it can not be created.
+static ThreadPool* clone_download_pool() {
+    static std::unique_ptr<ThreadPool> pool = [] {
+        std::unique_ptr<ThreadPool> p;
+        auto st = ThreadPoolBuilder("clone_download")
+                          .set_min_threads(0)
+                          .set_max_threads(std::max(1, config::clone_worker_count) *
+                                           std::max(1, config::clone_download_parallelism))
+                          .set_idle_timeout(MonoDelta::FromMilliseconds(2000))
+                          .build(&p);
+        LOG_IF(WARNING, !st.ok()) << "Fail to create the clone download pool, download the files serially: " << st;
+        return p;
+    }();
+    return pool.get();
+}
+
 EngineCloneTask::EngineCloneTask(MemTracker* mem_tracker, const TCloneReq& clone_req, int64_t signature,
                                  std::vector<string>* error_msgs, std::vector<TTabletInfo>* tablet_infos,
                                  AgentStatus* res_status)
@@ -534,18 +554,13 @@ Status EngineCloneTask::_download_files(DataDir* data_dir, const std::string& re
         }
     }
 
-    // Get copy from remote
+    // Get the sizes of the files to check the disk capacity and the downloaded files
     uint64_t total_file_size = 0;
-    MonotonicStopWatch watch;
-    watch.start();
-    for (int i = 0; i < file_name_list.size(); ++i) {
-        std::string& file_name = file_name_list[i];
-        auto remote_file_url = remote_url_prefix + file_name;
-
-        uint64_t file_size = 0;
-        if (use_file_name_and_size_format) {
-            file_size = file_size_list[i];
-        } else {
+    if (!use_file_name_and_size_format) {
+        file_size_list.resize(file_name_list.size());
+        for (int i = 0; i < file_name_list.size(); ++i) {
+            auto remote_file_url = remote_url_prefix + file_name_list[i];
+            int64_t& file_size = file_size_list[i];
             auto get_file_size_cb = [&remote_file_url, &file_size](HttpClient* client) {
                 RETURN_IF_ERROR(client->init(remote_file_url));
                 client->set_timeout_ms(GET_LENGTH_TIMEOUT * 1000);
@@ -555,39 +570,61 @@ Status EngineCloneTask::_download_files(DataDir* data_dir, const std::string& re
             };
             RETURN_IF_ERROR(HttpClient::execute_with_retry(DOWNLOAD_FILE_MAX_RETRY, 1, get_file_size_cb));
         }
+    }
+    for (auto file_size : file_size_list) {
+        total_file_size += file_size;
+    }
+    // check disk capacity
+    if (data_dir->capacity_limit_reached(total_file_size)) {
+        return Status::InternalError("Disk reach capacity limit");
+    }
 
-        // check disk capacity
-        if (data_dir->capacity_limit_reached(file_size)) {
-            return Status::InternalError("Disk reach capacity limit");
+    // Get copy from remote, the files except the header are downloaded in parallel
+    MonotonicStopWatch watch;
+    watch.start();
+    auto download = [&](size_t i) {
+        if (StorageEngine::instance()->bg_worker_stopped()) {
+            return Status::InternalError("Process is going to quit. The download will stop.");
         }
-
-        total_file_size += file_size;
-        uint64_t estimate_timeout = file_size / config::download_low_speed_limit_kbps / 1024;
-        if (estimate_timeout < config::download_low_speed_time) {
-            estimate_timeout = config::download_low_speed_time;
+        return _download_file(remote_url_prefix + file_name_list[i], local_path + file_name_list[i],
+                              file_size_list[i]);
+    };
+    const size_t num_data_files = file_name_list.empty() ? 0 : file_name_list.size() - 1;
+    const size_t parallelism = std::min<size_t>(num_data_files, std::max(1, config::clone_download_parallelism));
+    ThreadPool* pool = parallelism > 1 ? clone_download_pool() : nullptr;
+    if (pool == nullptr) {
+        for (size_t i = 0; i < num_data_files; ++i) {
+            RETURN_IF_ERROR(download(i));
         }
-
-        std::string local_file_path = local_path + file_name;
-
-        VLOG(1) << "Downloading " << remote_file_url << " to " << local_path << ". bytes=" << file_size
-                << " timeout=" << estimate_timeout;
-
-        auto download_cb = [&remote_file_url, estimate_timeout, &local_file_path, file_size](HttpClient* client) {
-            RETURN_IF_ERROR(client->init(remote_file_url));
-            client->set_timeout_ms(estimate_timeout * 1000);
-            RETURN_IF_ERROR(client->download(local_file_path));
-
-            // Check file length
-            uint64_t local_file_size = std::filesystem::file_size(local_file_path);
-            if (local_file_size != file_size) {
-                LOG(WARNING) << "Fail to download " << remote_file_url << ". file_size=" << local_file_size << "/"
-                             << file_size;
-                return Status::InternalError("mismatched file size");
+    } else {
+        // every worker downloads the next file not downloaded yet until any download fails
+        std::atomic<size_t> next_file{0};
+        std::vector<Status> results(parallelism);
+        CountDownLatch latch(parallelism);
+        MemTracker* mem_tracker = CurrentThread::mem_tracker();
+        for (size_t w = 0; w < parallelism; ++w) {
+            auto worker = [&, w]() {
+                SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(mem_tracker);
+                for (size_t i = next_file++; i < num_data_files; i = next_file++) {
+                    results[w] = download(i);
+                    if (!results[w].ok()) {
+                        next_file = num_data_files;
+                        break;
+                    }
+                }
+                latch.count_down();
+            };
+            if (!pool->submit_func(worker).ok()) {
+                worker();
             }
-            chmod(local_file_path.c_str(), S_IRUSR | S_IWUSR);
-            return Status::OK();
-        };
-        RETURN_IF_ERROR(HttpClient::execute_with_retry(DOWNLOAD_FILE_MAX_RETRY, 1, download_cb));
+        }
+        latch.wait();
+        for (const auto& st : results) {
+            RETURN_IF_ERROR(st);
+        }
+    }
+    if (!file_name_list.empty()) {
+        RETURN_IF_ERROR(download(file_name_list.size() - 1));
     } // Clone files from remote backend
 
     uint64_t total_time_ms = watch.elapsed_time() / 1000 / 1000;
@@ -602,6 +639,53 @@ Status EngineCloneTask::_download_files(DataDir* data_dir, const std::string& re
     return Status::OK();
 }
 
+Status EngineCloneTask::_download_file(const std::string& remote_file_url, const std::string& local_file_path,
+                                       uint64_t file_size) {
+    uint64_t estimate_timeout = file_size / config::download_low_speed_limit_kbps / 1024;
+    if (estimate_timeout < config::download_low_speed_time) {
+        estimate_timeout = config::download_low_speed_time;
+    }
+
+    VLOG(1) << "Downloading " << remote_file_url << " to " << local_file_path << ". bytes=" << file_size
+            << " timeout=" << estimate_timeout;
+
+    auto download_cb = [&remote_file_url, estimate_timeout, &local_file_path, file_size](HttpClient* client) {
+        RETURN_IF_ERROR(client->init(remote_file_url));
+        client->set_timeout_ms(estimate_timeout * 1000);
+
+        // Resume from the bytes downloaded by the interrupted download if any.
+        std::error_code ec;
+        uint64_t offset = std::filesystem::file_size(local_file_path, ec);
+        if (ec || offset >= file_size) {
+            offset = 0;
+        }
+        if (offset > 0) {
+            VLOG(1) << "Resume downloading " << remote_file_url << " from offset " << offset;
+        }
+        auto st = client->download(local_file_path, offset, BandwidthThrottle::replication_download());
+        if (!st.ok()) {
+            // Nothing is downloaded if the remote backend does not support the ranges, download the whole file
+            // in the next retry.
+            uint64_t downloaded = std::filesystem::file_size(local_file_path, ec);
+            if (offset > 0 && !ec && downloaded <= offset) {
+                std::filesystem::remove(local_file_path, ec);
+            }
+            return st;
+        }
+
+        // Check file length
+        uint64_t local_file_size = std::filesystem::file_size(local_file_path);
+        if (local_file_size != file_size) {
+            LOG(WARNING) << "Fail to download " << remote_file_url << ". file_size=" << local_file_size << "/"
+                         << file_size;
+            return Status::InternalError("mismatched file size");
+        }
+        chmod(local_file_path.c_str(), S_IRUSR | S_IWUSR);
+        return Status::OK();
+    };
+    return HttpClient::execute_with_retry(DOWNLOAD_FILE_MAX_RETRY, 1, download_cb);
+}
+
 Status EngineCloneTask::_finish_clone(Tablet* tablet, const string& clone_dir, int64_t committed_version,
                                       bool incremental_clone) {
     bool bg_worker_stopped = StorageEngine::instance()->bg_worker_stopped();
@@ -78,6 +78,10 @@ private:
     // Download tablet files from
     Status _download_files(DataDir* data_dir, const std::string& remote_url_prefix, const std::string& local_path);
 
+    // Download a file of |file_size| bytes, the retries resume from the bytes downloaded by the failed tries.
+    static Status _download_file(const std::string& remote_file_url, const std::string& local_file_path,
+                                 uint64_t file_size);
+
     Status _make_snapshot(const std::string& ip, int port, TTableId tablet_id, TSchemaHash schema_hash, int timeout_s,
                           const std::vector<Version>* missed_versions,
                           const std::vector<int64_t>* missing_version_ranges, std::string* snapshot_path,
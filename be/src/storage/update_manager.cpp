@@ -18,6 +18,7 @@
 #include <memory>
 #include <numeric>
 
+#include "common/config.h"
 #include "gutil/endian.h"
 #include "storage/chunk_helper.h"
 #include "storage/del_vector.h"
@@ -25,6 +26,7 @@
 #include "storage/storage_engine.h"
 #include "storage/tablet.h"
 #include "storage/tablet_meta_manager.h"
+#include "storage/tablet_updates.h"
 #include "util/pretty_printer.h"
 #include "util/starrocks_metrics.h"
 #include "util/time.h"
@@ -54,6 +56,9 @@ UpdateManager::~UpdateManager() {
         // should be shutdown.
         _apply_thread_pool->shutdown();
     }
+    if (_apply_prefetch_thread_pool != nullptr) {
+        _apply_prefetch_thread_pool->shutdown();
+    }
     clear_cache();
     if (_compaction_state_mem_tracker) {
         _compaction_state_mem_tracker.reset();
@@ -70,8 +75,15 @@ UpdateManager::~UpdateManager() {
 }
 
 Status UpdateManager::init() {
-    auto st = ThreadPoolBuilder("update_apply").build(&_apply_thread_pool);
-    return st;
+    RETURN_IF_ERROR(ThreadPoolBuilder("update_apply").build(&_apply_thread_pool));
+    if (config::update_apply_prefetch_threads > 0) {
+        RETURN_IF_ERROR(ThreadPoolBuilder("update_prefetch")
+                                .set_min_threads(0)
+                                .set_max_threads(config::update_apply_prefetch_threads)
+                                .set_idle_timeout(MonoDelta::FromMilliseconds(2000))
+                                .build(&_apply_prefetch_thread_pool));
+    }
+    return Status::OK();
 }
 
 Status UpdateManager::get_del_vec_in_meta(KVStore* meta, const TabletSegmentId& tsid, int64_t version,
@@ -98,11 +110,17 @@ Status UpdateManager::get_del_vec(KVStore* meta, const TabletSegmentId& tsid, in
                 return Status::OK();
             }
         }
+        if (_get_versioned_del_vec(tsid, version, pdelvec)) {
+            return Status::OK();
+        }
     }
     (*pdelvec).reset(new DelVector());
     int64_t latest_version = 0;
     RETURN_IF_ERROR(get_del_vec_in_meta(meta, tsid, version, pdelvec->get(), &latest_version));
-    if ((*pdelvec)->version() == latest_version) {
+    if ((*pdelvec)->version() != latest_version) {
+        std::lock_guard<std::mutex> lg(_del_vec_cache_lock);
+        _put_versioned_del_vec(tsid, version, *pdelvec);
+    } else {
         std::lock_guard<std::mutex> lg(_del_vec_cache_lock);
         auto itr = _del_vec_cache.find(tsid);
         if (itr == _del_vec_cache.end()) {
@@ -118,6 +136,60 @@ Status UpdateManager::get_del_vec(KVStore* meta, const TabletSegmentId& tsid, in
     return Status::OK();
 }
 
+bool UpdateManager::_get_versioned_del_vec(const TabletSegmentId& tsid, int64_t version, DelVectorPtr* pdelvec) {
+    auto itr = _versioned_del_vec_index.find(tsid);
+    if (itr == _versioned_del_vec_index.end()) {
+        return false;
+    }
+    auto version_itr = itr->second.find(version);
+    if (version_itr == itr->second.end()) {
+        return false;
+    }
+    // move to the front as the most recently used one
+    _versioned_del_vec_lru.splice(_versioned_del_vec_lru.begin(), _versioned_del_vec_lru, version_itr->second);
+    *pdelvec = version_itr->second->delvec;
+    return true;
+}
+
+void UpdateManager::_put_versioned_del_vec(const TabletSegmentId& tsid, int64_t version, const DelVectorPtr& delvec) {
+    const size_t capacity = std::max<int64_t>(0, config::versioned_del_vec_cache_capacity);
+    if (delvec->memory_usage() > capacity) {
+        return;
+    }
+    auto& versions = _versioned_del_vec_index[tsid];
+    if (versions.count(version) > 0) {
+        return;
+    }
+    _versioned_del_vec_lru.push_front(VersionedDelVec{tsid, version, delvec});
+    versions.emplace(version, _versioned_del_vec_lru.begin());
+    _versioned_del_vec_bytes += delvec->memory_usage();
+    _del_vec_cache_mem_tracker->consume(delvec->memory_usage());
+    while (_versioned_del_vec_bytes > capacity) {
+        auto& victim = _versioned_del_vec_lru.back();
+        auto index_itr = _versioned_del_vec_index.find(victim.tsid);
+        index_itr->second.erase(victim.version);
+        if (index_itr->second.empty()) {
+            _versioned_del_vec_index.erase(index_itr);
+        }
+        _versioned_del_vec_bytes -= victim.delvec->memory_usage();
+        _del_vec_cache_mem_tracker->release(victim.delvec->memory_usage());
+        _versioned_del_vec_lru.pop_back();
+    }
+}
+
+void UpdateManager::_erase_versioned_del_vec(const TabletSegmentId& tsid) {
+    auto itr = _versioned_del_vec_index.find(tsid);
+    if (itr == _versioned_del_vec_index.end()) {
+        return;
+    }
+    for (auto& [version, lru_itr] : itr->second) {
+        _versioned_del_vec_bytes -= lru_itr->delvec->memory_usage();
+        _del_vec_cache_mem_tracker->release(lru_itr->delvec->memory_usage());
+        _versioned_del_vec_lru.erase(lru_itr);
+    }
+    _versioned_del_vec_index.erase(itr);
+}
+
 void UpdateManager::clear_cache() {
     _update_state_cache.clear();
     if (_update_state_mem_tracker) {
@@ -132,6 +204,9 @@ void UpdateManager::clear_cache() {
     {
         std::lock_guard<std::mutex> lg(_del_vec_cache_lock);
         _del_vec_cache.clear();
+        _versioned_del_vec_lru.clear();
+        _versioned_del_vec_index.clear();
+        _versioned_del_vec_bytes = 0;
         if (_del_vec_cache_mem_tracker) {
             _del_vec_cache_mem_tracker->release(_del_vec_cache_mem_tracker->consumption());
         }
@@ -148,6 +223,7 @@ void UpdateManager::clear_cached_del_vec(const std::vector<TabletSegmentId>& tsi
             _del_vec_cache_mem_tracker->release(itr->second->memory_usage());
             _del_vec_cache.erase(itr);
         }
+        _erase_versioned_del_vec(tsid);
     }
 }
 
@@ -313,4 +389,49 @@ void UpdateManager::on_rowset_cancel(Tablet* tablet, Rowset* rowset) {
     }
 }
 
+void UpdateManager::prefetch_rowset_update_state(const std::shared_ptr<Tablet>& tablet,
+                                                 const std::shared_ptr<Rowset>& rowset, int64_t version) {
+    if (_apply_prefetch_thread_pool == nullptr || !rowset->has_data_files()) {
+        return;
+    }
+    auto st = _apply_prefetch_thread_pool->submit_func([this, tablet, rowset, version]() {
+        EditVersion applied_version;
+        if (!tablet->updates()->get_latest_applied_version(&applied_version).ok() ||
+            applied_version.major() >= version) {
+            // the tablet is dropped or the version has been applied
+            return;
+        }
+        auto state_entry = _update_state_cache.get_or_create(
+                strings::Substitute("$0_$1", tablet->tablet_id(), rowset->rowset_id().to_string()));
+        state_entry->update_expire_time(MonotonicMillis() + _cache_expire_ms);
+        auto st = state_entry->value().load(tablet.get(), rowset.get());
+        _update_state_cache.update_object_size(state_entry, state_entry->value().memory_usage());
+        if (st.ok()) {
+            _update_state_cache.release(state_entry);
+        } else {
+            // it will be loaded again in apply
+            LOG(WARNING) << "prefetch RowsetUpdateState error: " << st << " tablet: " << tablet->tablet_id();
+            _update_state_cache.remove(state_entry);
+        }
+    });
+    if (!st.ok()) {
+        VLOG(1) << "submit prefetch RowsetUpdateState task failed: " << st << " tablet: " << tablet->tablet_id();
+    }
+}
+
+Status UpdateManager::preload_primary_index(Tablet* tablet) {
+    auto index_entry = _index_cache.get_or_create(tablet->tablet_id());
+    index_entry->update_expire_time(MonotonicMillis() + get_cache_expire_ms());
+    auto& index = index_entry->value();
+    auto st = index.load(tablet);
+    _index_cache.update_object_size(index_entry, index.memory_usage());
+    if (!st.ok()) {
+        _index_cache.remove(index_entry);
+        return st;
+    }
+    // release index entry but keep it in cache
+    _index_cache.release(index_entry);
+    return Status::OK();
+}
+
 } // namespace starrocks
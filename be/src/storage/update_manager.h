@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <list>
+#include <map>
 #include <string>
 #include <unordered_map>
 
@@ -31,6 +33,7 @@ class DelVector;
 using DelVectorPtr = std::shared_ptr<DelVector>;
 class MemTracker;
 class KVStore;
+class Rowset;
 class RowsetUpdateState;
 class Tablet;
 
@@ -72,8 +75,16 @@ public:
 
     void on_rowset_cancel(Tablet* tablet, Rowset* rowset);
 
+    // Load the primary index of |tablet| into the index cache if it's not loaded yet.
+    Status preload_primary_index(Tablet* tablet);
+
     ThreadPool* apply_thread_pool() { return _apply_thread_pool.get(); }
 
+    // Load the RowsetUpdateState of |rowset| in background, which will be applied as |version| of |tablet|.
+    // It's skipped if |version| has been applied when the task runs.
+    void prefetch_rowset_update_state(const std::shared_ptr<Tablet>& tablet, const std::shared_ptr<Rowset>& rowset,
+                                      int64_t version);
+
     DynamicCache<uint64_t, PrimaryIndex>& index_cache() { return _index_cache; }
 
     DynamicCache<string, RowsetUpdateState>& update_state_cache() { return _update_state_cache; }
@@ -113,9 +124,25 @@ private:
     // DelVector related states
     std::mutex _del_vec_cache_lock;
     std::unordered_map<TabletSegmentId, DelVectorPtr> _del_vec_cache;
+    // The delvecs read by the versions before the latest one, keyed by (tablet, segment, read version)
+    // and evicted in LRU order, guarded by _del_vec_cache_lock too.
+    struct VersionedDelVec {
+        TabletSegmentId tsid;
+        int64_t version;
+        DelVectorPtr delvec;
+    };
+    using VersionedDelVecList = std::list<VersionedDelVec>;
+    VersionedDelVecList _versioned_del_vec_lru;
+    std::unordered_map<TabletSegmentId, std::map<int64_t, VersionedDelVecList::iterator>> _versioned_del_vec_index;
+    size_t _versioned_del_vec_bytes = 0;
     std::unique_ptr<MemTracker> _del_vec_cache_mem_tracker;
 
     std::unique_ptr<ThreadPool> _apply_thread_pool;
+    std::unique_ptr<ThreadPool> _apply_prefetch_thread_pool;
+
+    bool _get_versioned_del_vec(const TabletSegmentId& tsid, int64_t version, DelVectorPtr* pdelvec);
+    void _put_versioned_del_vec(const TabletSegmentId& tsid, int64_t version, const DelVectorPtr& delvec);
+    void _erase_versioned_del_vec(const TabletSegmentId& tsid);
 
     UpdateManager(const UpdateManager&) = delete;
     const UpdateManager& operator=(const UpdateManager&) = delete;
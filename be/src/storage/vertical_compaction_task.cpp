@@ -188,6 +188,9 @@ StatusOr<size_t> VerticalCompactionTask::_compact_data(bool is_key, int32_t chun
     Status status = Status::OK();
     size_t column_group_del_filtered_rows = 0;
     size_t column_group_merged_rows = 0;
+    // the reader is created for every column group, while the writer is shared by all of them
+    IOCounter throttled_io;
+    throttled_io.write_bytes = output_rs_writer->total_data_size();
     while (LIKELY(!should_stop())) {
 #ifndef BE_TEST
         status = tls_thread_status.mem_tracker()->check_mem_limit("Compaction");
@@ -228,6 +231,8 @@ StatusOr<size_t> VerticalCompactionTask::_compact_data(bool is_key, int32_t chun
         if (!source_masks->empty()) {
             source_masks->clear();
         }
+
+        _throttle_io(reader->stats(), output_rs_writer, &throttled_io);
     }
     if (should_stop()) {
         LOG(INFO) << "vertical compaction task_id:" << _task_info.task_id << ", tablet:" << _task_info.tablet_id
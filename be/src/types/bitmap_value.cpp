@@ -232,6 +232,63 @@ BitmapValue& BitmapValue::operator|=(const BitmapValue& rhs) {
     return *this;
 }
 
+void BitmapValue::fast_union(const std::vector<const BitmapValue*>& values) {
+    std::vector<const detail::Roaring64Map*> bitmaps;
+    for (const auto* value : values) {
+        if (value->_type == BITMAP) {
+            bitmaps.emplace_back(value->_bitmap.get());
+        }
+    }
+    if (bitmaps.size() < 2) {
+        for (const auto* value : values) {
+            *this |= *value;
+        }
+        return;
+    }
+
+    if (_type == BITMAP) {
+        bitmaps.emplace_back(_bitmap.get());
+    }
+    auto bitmap = std::make_shared<detail::Roaring64Map>(
+            detail::Roaring64Map::fastunion(bitmaps.size(), bitmaps.data()));
+    if (_type == SINGLE) {
+        bitmap->add(_sv);
+    } else if (_type == SET) {
+        for (auto x : *_set) {
+            bitmap->add(x);
+        }
+    }
+    for (const auto* value : values) {
+        if (value->_type == SINGLE) {
+            bitmap->add(value->_sv);
+        } else if (value->_type == SET) {
+            for (auto x : *value->_set) {
+                bitmap->add(x);
+            }
+        }
+    }
+    _bitmap = std::move(bitmap);
+    _set.reset();
+    _type = BITMAP;
+}
+
+void BitmapValue::fast_intersect(const std::vector<const BitmapValue*>& values) {
+    // the cardinality is computed from the headers of the containers, which is much cheaper than the intersection
+    std::vector<std::pair<int64_t, const BitmapValue*>> sorted;
+    sorted.reserve(values.size());
+    for (const auto* value : values) {
+        sorted.emplace_back(value->cardinality(), value);
+    }
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    for (const auto& [_, value] : sorted) {
+        if (cardinality() == 0) {
+            return;
+        }
+        *this &= *value;
+    }
+}
+
 // Note: rhs BitmapValue is only readable after this method
 // Compute the intersection between the current bitmap and the provided bitmap.
 // Possible type transitions are:
@@ -102,6 +102,14 @@ public:
     // BITMAP -> SINGLE
     BitmapValue& operator&=(const BitmapValue& rhs);
 
+    // Compute the union between the current bitmap and all the |values| at once, the same as `|=` them one by one.
+    // The roaring bitmaps among them are united by the multi-way union, which avoids the intermediate results.
+    void fast_union(const std::vector<const BitmapValue*>& values);
+
+    // Compute the intersection between the current bitmap and all the |values|, the same as `&=` them one by one.
+    // The smaller ones are intersected first, and it stops as soon as the result is empty.
+    void fast_intersect(const std::vector<const BitmapValue*>& values);
+
     void remove(uint64_t rhs);
 
     BitmapValue& operator-=(const BitmapValue& rhs);
@@ -39,6 +39,7 @@
 // So other files should not include this file except bitmap_value.cpp.
 #include <cstdint>
 #include <optional>
+#include <vector>
 
 #include "roaring/array_util.h"
 #include "roaring/bitset_util.h"
@@ -871,12 +872,23 @@ public:
     /**
      * computes the logical or (union) between "n" bitmaps (referenced by a
      * pointer).
+     * The 32-bit bitmaps of the same high 32 bits are united by the multi-way
+     * union of Roaring, instead of being united one by one.
      */
     static Roaring64Map fastunion(size_t n, const Roaring64Map** inputs) {
-        Roaring64Map ans;
-        // not particularly fast
+        std::map<uint32_t, std::vector<const Roaring*>> groups;
         for (size_t lcv = 0; lcv < n; ++lcv) {
-            ans |= *(inputs[lcv]);
+            for (const auto& map_entry : inputs[lcv]->roarings) {
+                groups[map_entry.first].emplace_back(&map_entry.second);
+            }
+        }
+        Roaring64Map ans;
+        for (auto& [key, group] : groups) {
+            if (group.size() == 1) {
+                ans.emplace(key, *group[0]);
+            } else {
+                ans.emplace(key, Roaring::fastunion(group.size(), group.data()));
+            }
         }
         return ans;
     }
@@ -38,6 +38,7 @@
 #include <immintrin.h>
 #endif
 
+#include <algorithm>
 #include <cmath>
 #include <map>
 
@@ -172,6 +173,42 @@ void HyperLogLog::update(uint64_t hash_value) {
     }
 }
 
+void HyperLogLog::update_batch(const uint64_t* hash_values, size_t num_values) {
+    size_t i = 0;
+    // the explicit values are inserted one by one until they are converted to the registers.
+    for (; i < num_values && _type != HLL_DATA_SPARSE && _type != HLL_DATA_FULL; i++) {
+        if (hash_values[i] != 0) {
+            update(hash_values[i]);
+        }
+    }
+    if (i < num_values) {
+        _update_registers_batch(hash_values + i, num_values - i);
+    }
+}
+
+void HyperLogLog::_update_registers_batch(const uint64_t* hash_values, size_t num_values) {
+    static constexpr size_t kBatchSize = 256;
+    uint16_t indexes[kBatchSize];
+    uint8_t first_one_bits[kBatchSize];
+    for (size_t start = 0; start < num_values; start += kBatchSize) {
+        size_t size = std::min(kBatchSize, num_values - start);
+        const uint64_t* values = hash_values + start;
+        // Same as _update_registers, but branch free so that it could be vectorized, and the first one bit of
+        // a zero value is 0, which doesn't change the register.
+        for (size_t j = 0; j < size; j++) {
+            uint64_t value = values[j];
+            indexes[j] = value % HLL_REGISTERS_COUNT;
+            uint64_t bits = (value >> HLL_COLUMN_PRECISION) | ((uint64_t)1 << HLL_ZERO_COUNT_BITS);
+            auto first_one_bit = (uint8_t)(__builtin_ctzl(bits) + 1);
+            first_one_bits[j] = value != 0 ? first_one_bit : 0;
+        }
+        uint8_t* registers = _registers.data;
+        for (size_t j = 0; j < size; j++) {
+            registers[indexes[j]] = std::max(registers[indexes[j]], first_one_bits[j]);
+        }
+    }
+}
+
 void HyperLogLog::merge(const HyperLogLog& other) {
     // fast path
     if (other._type == HLL_DATA_EMPTY) {
@@ -113,6 +113,9 @@ public:
     // NOTE: input must be a hash_value
     void update(uint64_t hash_value);
 
+    // Add |num_values| hash values to this HLL value, the zero values are ignored.
+    void update_batch(const uint64_t* hash_values, size_t num_values);
+
     void merge(const HyperLogLog& other);
 
     // Return max size of serialized binary
@@ -175,6 +178,9 @@ private:
         auto first_one_bit = (uint8_t)(__builtin_ctzl(hash_value) + 1);
         _registers.data[idx] = std::max((uint8_t)_registers.data[idx], first_one_bit);
     }
+
+    // update the hash values into this registers, the zero values are ignored.
+    void _update_registers_batch(const uint64_t* hash_values, size_t num_values);
 };
 
 } // namespace starrocks
@@ -297,10 +297,11 @@ private:
     std::shared_ptr<arrow::Array>& _array;
 };
 
-Status convert_chunk_to_arrow_batch(Chunk* chunk, std::vector<ExprContext*>& _output_expr_ctxs,
+Status convert_chunk_to_arrow_batch(Chunk* chunk, const std::vector<ExprContext*>& _output_expr_ctxs,
                                     const std::shared_ptr<arrow::Schema>& schema, arrow::MemoryPool* pool,
                                     std::shared_ptr<arrow::RecordBatch>* result) {
-    if (chunk->num_columns() != schema->num_fields()) {
+    // the columns are evaluated by the output exprs, which may refer to the same column of the chunk
+    if (static_cast<int>(_output_expr_ctxs.size()) != schema->num_fields()) {
         return Status::InvalidArgument("number fields not match");
     }
 
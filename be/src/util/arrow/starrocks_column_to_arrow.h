@@ -35,7 +35,7 @@
 
 namespace starrocks {
 
-Status convert_chunk_to_arrow_batch(Chunk* chunk, std::vector<ExprContext*>& _output_expr_ctxs,
+Status convert_chunk_to_arrow_batch(Chunk* chunk, const std::vector<ExprContext*>& _output_expr_ctxs,
                                     const std::shared_ptr<arrow::Schema>& schema, arrow::MemoryPool* pool,
                                     std::shared_ptr<arrow::RecordBatch>* result);
 
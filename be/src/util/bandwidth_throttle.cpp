@@ -0,0 +1,49 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "util/bandwidth_throttle.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include "common/config.h"
+#include "util/time.h"
+
+namespace starrocks {
+
+BandwidthThrottle* BandwidthThrottle::replication_download() {
+    static BandwidthThrottle throttle([] { return config::replication_download_bytes_per_second; });
+    return &throttle;
+}
+
+int64_t BandwidthThrottle::acquire(int64_t bytes) {
+    const int64_t rate = _bytes_per_second();
+    if (rate <= 0 || bytes <= 0) {
+        return 0;
+    }
+    const int64_t now_ns = MonotonicNanos();
+    std::lock_guard l(_mutex);
+    _paid_ns = std::max(_paid_ns, now_ns - kBurstNs) + static_cast<int64_t>(bytes * 1e9 / rate);
+    return std::max<int64_t>(0, _paid_ns - now_ns);
+}
+
+void BandwidthThrottle::throttle(int64_t bytes) {
+    const int64_t wait_ns = acquire(bytes);
+    if (wait_ns > 0) {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(wait_ns));
+    }
+}
+
+} // namespace starrocks
@@ -0,0 +1,51 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <utility>
+
+namespace starrocks {
+
+// BandwidthThrottle limits the bytes per second of the transfers sharing it, with a burst of one second.
+class BandwidthThrottle {
+public:
+    static constexpr int64_t kBurstNs = 1000000000L;
+
+    // |bytes_per_second| returns the current limit, which is unlimited if it's 0 or less.
+    explicit BandwidthThrottle(std::function<int64_t()> bytes_per_second)
+            : _bytes_per_second(std::move(bytes_per_second)) {}
+
+    // The throttle shared by the downloads of the clones and the restores, limited by
+    // config::replication_download_bytes_per_second.
+    static BandwidthThrottle* replication_download();
+
+    // Account |bytes| transferred, return the nanoseconds the transfer should sleep to stay within the limit.
+    int64_t acquire(int64_t bytes);
+
+    // Account |bytes| transferred and sleep to stay within the limit.
+    void throttle(int64_t bytes);
+
+private:
+    const std::function<int64_t()> _bytes_per_second;
+
+    std::mutex _mutex;
+    // The time when the bytes acquired so far are paid off.
+    int64_t _paid_ns = 0;
+};
+
+} // namespace starrocks
@@ -0,0 +1,125 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "gutil/port.h"
+#include "util/bit_util.h"
+
+namespace starrocks {
+
+// A bounded multi-producer multi-consumer lock-free queue, based on the ring buffer of Dmitry Vyukov
+// (https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue).
+//
+// Each cell has a sequence number, which tells whether the cell is ready for the producer of the position
+// (sequence == pos) or the consumer of the position (sequence == pos + 1). Producers and consumers only
+// compete on the CAS of the enqueue position and the dequeue position respectively.
+//
+// The elements put by one thread are got in the same order.
+template <typename T>
+class BoundedMPMCQueue {
+public:
+    // |capacity| is rounded up to the power of 2.
+    explicit BoundedMPMCQueue(size_t capacity)
+            : _capacity(BitUtil::RoundUpToPowerOfTwo(std::max<size_t>(capacity, 2))),
+              _mask(_capacity - 1),
+              _cells(new Cell[_capacity]) {
+        for (size_t i = 0; i < _capacity; i++) {
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedMPMCQueue(const BoundedMPMCQueue&) = delete;
+    BoundedMPMCQueue& operator=(const BoundedMPMCQueue&) = delete;
+
+    // Return false if the queue is full, and |value| is not moved in this case.
+    bool try_put(T&& value) {
+        Cell* cell;
+        size_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &_cells[pos & _mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = _enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        cell->data = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Return false if the queue is empty.
+    bool try_get(T* value) {
+        Cell* cell;
+        size_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &_cells[pos & _mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = _dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        *value = std::move(cell->data);
+        // Release the resources held by the element as soon as possible.
+        cell->data = T();
+        cell->sequence.store(pos + _mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    // The number of elements, which is exact only if there is no concurrent put or get.
+    size_t size() const {
+        size_t dequeue_pos = _dequeue_pos.load(std::memory_order_acquire);
+        size_t enqueue_pos = _enqueue_pos.load(std::memory_order_acquire);
+        return enqueue_pos > dequeue_pos ? enqueue_pos - dequeue_pos : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    size_t capacity() const { return _capacity; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    const size_t _capacity;
+    const size_t _mask;
+    std::unique_ptr<Cell[]> _cells;
+
+    alignas(CACHELINE_SIZE) std::atomic<size_t> _enqueue_pos{0};
+    alignas(CACHELINE_SIZE) std::atomic<size_t> _dequeue_pos{0};
+};
+
+} // namespace starrocks
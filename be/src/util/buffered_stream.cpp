@@ -161,14 +161,40 @@ Status SharedBufferedInputStream::get_bytes(const uint8_t** buffer, size_t offse
     }
 
     if (sb.buffer.capacity() == 0) {
-        sb.buffer.reserve(sb.size);
-        RETURN_IF_ERROR(_file->read_at_fully(sb.offset, sb.buffer.data(), sb.size));
+        RETURN_IF_ERROR(_load_buffers(iter));
     }
 
     *buffer = sb.buffer.data() + offset - sb.offset;
     return Status::OK();
 }
 
+Status SharedBufferedInputStream::_load_buffers(BufferMap::iterator iter) {
+    std::vector<SharedBuffer*> buffers;
+    std::vector<io::ReadRange> ranges;
+    int64_t prefetch_size = 0;
+    for (auto it = iter; it != _map.end(); ++it) {
+        SharedBuffer& sb = it->second;
+        if (it != iter) {
+            if (sb.buffer.capacity() != 0 || prefetch_size + sb.size > _options.max_prefetch_size) {
+                break;
+            }
+            prefetch_size += sb.size;
+        }
+        sb.buffer.reserve(sb.size);
+        buffers.push_back(&sb);
+        ranges.push_back({sb.offset, sb.buffer.data(), sb.size});
+    }
+    auto st = ranges.size() == 1 ? _file->read_at_fully(ranges[0].offset, ranges[0].data, ranges[0].count)
+                                 : _file->read_ranges_fully(ranges);
+    if (!st.ok()) {
+        // Drop the buffers, so they are read again next time.
+        for (SharedBuffer* sb : buffers) {
+            std::vector<uint8_t>().swap(sb->buffer);
+        }
+    }
+    return st;
+}
+
 void SharedBufferedInputStream::release() {
     _map.clear();
 }
@@ -16,7 +16,9 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <map>
 #include <memory>
+#include <vector>
 
 #include "common/status.h"
 
@@ -96,6 +98,8 @@ public:
         static constexpr int64_t MB = 1024 * 1024;
         int64_t max_dist_size = 1 * MB;
         int64_t max_buffer_size = 8 * MB;
+        // The max bytes of the next buffers read together with the buffer being read.
+        int64_t max_prefetch_size = 0;
     };
 
     SharedBufferedInputStream(RandomAccessFile* file);
@@ -119,8 +123,13 @@ private:
         int64_t ref_count;
         std::vector<uint8_t> buffer;
     };
+    using BufferMap = std::map<int64_t, SharedBuffer>;
+
+    // Read the buffer of |iter| and the buffers after it within `max_prefetch_size`.
+    Status _load_buffers(BufferMap::iterator iter);
+
     RandomAccessFile* _file;
-    std::map<int64_t, SharedBuffer> _map;
+    BufferMap _map;
     CoalesceOptions _options;
 };
 
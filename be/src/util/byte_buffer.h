@@ -36,6 +36,7 @@
 
 #include <cstddef>
 #include <cstring>
+#include <functional>
 #include <memory>
 
 #include "common/logging.h"
@@ -52,7 +53,19 @@ struct ByteBuffer {
         return ptr;
     }
 
-    ~ByteBuffer() { delete[] ptr; }
+    // Reference the |size| bytes of |data| without copying, |release| is called when the buffer is destroyed.
+    static ByteBufferPtr wrap(char* data, size_t size, std::function<void()> release) {
+        ByteBufferPtr ptr(new ByteBuffer(data, size, std::move(release)));
+        return ptr;
+    }
+
+    ~ByteBuffer() {
+        if (_release) {
+            _release();
+        } else {
+            delete[] ptr;
+        }
+    }
 
     void put_bytes(const char* data, size_t size) {
         strings::memcpy_inlined(ptr + pos, data, size);
@@ -80,6 +93,10 @@ struct ByteBuffer {
 
 private:
     ByteBuffer(size_t capacity_) : ptr(new char[capacity_]), limit(capacity_), capacity(capacity_) {}
+    ByteBuffer(char* data, size_t size, std::function<void()> release)
+            : ptr(data), limit(size), capacity(size), _release(std::move(release)) {}
+
+    std::function<void()> _release;
 };
 
 } // namespace starrocks
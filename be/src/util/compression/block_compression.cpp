@@ -39,6 +39,7 @@
 #include <snappy/snappy-sinksource.h>
 #include <snappy/snappy.h>
 #include <zlib.h>
+#include <zstd/zdict.h>
 #include <zstd/zstd.h>
 #include <zstd/zstd_errors.h>
 
@@ -713,12 +714,20 @@ class ZstdBlockCompression final : public BlockCompressionCodec {
 public:
     ZstdBlockCompression() : BlockCompressionCodec(CompressionTypePB::ZSTD) {}
 
+    // Compress with the digested dictionaries, which are owned by this codec. The pooled contexts only
+    // reference them during a call, and drop them when returned to the pool.
+    ZstdBlockCompression(ZSTD_CDict* cdict, ZSTD_DDict* ddict)
+            : BlockCompressionCodec(CompressionTypePB::ZSTD), _cdict(cdict), _ddict(ddict) {}
+
     static const ZstdBlockCompression* instance() {
         static ZstdBlockCompression s_instance;
         return &s_instance;
     }
 
-    ~ZstdBlockCompression() override = default;
+    ~ZstdBlockCompression() override {
+        ZSTD_freeCDict(_cdict);
+        ZSTD_freeDDict(_ddict);
+    }
 
     Status compress(const Slice& input, Slice* output, bool use_compression_buffer, size_t uncompressed_size,
                     faststring* compressed_body1, raw::RawString* compressed_body2) const override {
@@ -746,6 +755,14 @@ private:
         }
         compression::ZSTDCompressionContext* context = ref.value().get();
         ZSTD_CCtx* ctx = context->ctx;
+        if (_cdict != nullptr) {
+            size_t ret = ZSTD_CCtx_refCDict(ctx, _cdict);
+            if (ZSTD_isError(ret)) {
+                context->compression_fail = true;
+                return Status::InvalidArgument(strings::Substitute("ZSTD load dictionary failed: $0",
+                                                                   ZSTD_getErrorString(ZSTD_getErrorCode(ret))));
+            }
+        }
 
         [[maybe_unused]] faststring* compression_buffer = nullptr;
         [[maybe_unused]] size_t max_len = 0;
@@ -849,7 +866,9 @@ private:
             output->size = 0;
         }
 
-        size_t ret = ZSTD_decompressDCtx(ctx, output->data, output->size, input.data, input.size);
+        size_t ret = _ddict != nullptr ? ZSTD_decompress_usingDDict(ctx, output->data, output->size, input.data,
+                                                                    input.size, _ddict)
+                                       : ZSTD_decompressDCtx(ctx, output->data, output->size, input.data, input.size);
         if (ZSTD_isError(ret)) {
             context->decompression_fail = true;
             return Status::InvalidArgument(
@@ -858,8 +877,40 @@ private:
         output->size = ret;
         return Status::OK();
     }
+
+    ZSTD_CDict* _cdict = nullptr;
+    ZSTD_DDict* _ddict = nullptr;
 };
 
+StatusOr<std::string> train_zstd_dictionary(const std::vector<Slice>& samples, size_t max_dict_size) {
+    std::string samples_buffer;
+    std::vector<size_t> sample_sizes;
+    sample_sizes.reserve(samples.size());
+    for (const auto& sample : samples) {
+        samples_buffer.append(sample.data, sample.size);
+        sample_sizes.push_back(sample.size);
+    }
+    std::string dict(max_dict_size, '\0');
+    size_t ret = ZDICT_trainFromBuffer(dict.data(), dict.size(), samples_buffer.data(), sample_sizes.data(),
+                                       static_cast<unsigned>(sample_sizes.size()));
+    if (ZDICT_isError(ret)) {
+        return Status::InvalidArgument(Substitute("ZSTD train dictionary failed: $0", ZDICT_getErrorName(ret)));
+    }
+    dict.resize(ret);
+    return dict;
+}
+
+StatusOr<std::unique_ptr<BlockCompressionCodec>> new_zstd_dict_codec(const Slice& dict) {
+    ZSTD_CDict* cdict = ZSTD_createCDict(dict.data, dict.size, ZSTD_CLEVEL_DEFAULT);
+    ZSTD_DDict* ddict = ZSTD_createDDict(dict.data, dict.size);
+    if (cdict == nullptr || ddict == nullptr) {
+        ZSTD_freeCDict(cdict);
+        ZSTD_freeDDict(ddict);
+        return Status::InvalidArgument("ZSTD load dictionary failed");
+    }
+    return std::make_unique<ZstdBlockCompression>(cdict, ddict);
+}
+
 class GzipBlockCompression final : public ZlibBlockCompression {
 public:
     GzipBlockCompression() : ZlibBlockCompression(CompressionTypePB::GZIP) {}
@@ -35,9 +35,12 @@
 #pragma once
 
 #include <cstddef>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "common/status.h"
+#include "common/statusor.h"
 #include "gen_cpp/segment.pb.h"
 #include "util/raw_container.h"
 #include "util/slice.h"
@@ -110,4 +113,11 @@ Status get_block_compression_codec(CompressionTypePB type, const BlockCompressio
 
 bool use_compression_pool(CompressionTypePB type);
 
+// Train a ZSTD dictionary of at most |max_dict_size| bytes from |samples|.
+StatusOr<std::string> train_zstd_dictionary(const std::vector<Slice>& samples, size_t max_dict_size);
+
+// Create a ZSTD codec with the dictionary |dict|. The data compressed by it can only be
+// decompressed by a codec of the same dictionary.
+StatusOr<std::unique_ptr<BlockCompressionCodec>> new_zstd_dict_codec(const Slice& dict);
+
 } // namespace starrocks
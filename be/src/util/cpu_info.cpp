@@ -44,6 +44,7 @@
 #endif
 
 #include <linux/magic.h>
+#include <pthread.h>
 #include <sched.h>
 #include <sys/sysinfo.h>
 #include <sys/vfs.h>
@@ -423,6 +424,29 @@ int CpuInfo::get_current_core() {
 #endif
 }
 
+bool CpuInfo::bind_current_thread_to_numa_node(int node) {
+    DCHECK_LE(0, node);
+    DCHECK_LT(node, max_num_numa_nodes_);
+#ifdef __linux__
+    const auto& cores = get_cores_of_numa_node(node);
+    if (cores.empty()) {
+        return false;
+    }
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (int core : cores) {
+        CPU_SET(core, &cpu_set);
+    }
+    if (int res = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set); res != 0) {
+        LOG_FIRST_N(WARNING, 5) << "Failed to bind thread to NUMA node " << node << ": " << errno_to_string(res);
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
 void CpuInfo::_get_cache_info(long cache_sizes[NUM_CACHE_LEVELS], long cache_line_sizes[NUM_CACHE_LEVELS]) {
 #ifdef __APPLE__
     // On Mac OS X use sysctl() to get the cache sizes
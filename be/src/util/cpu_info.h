@@ -137,6 +137,11 @@ public:
         return numa_node_core_idx_[core];
     }
 
+    /// Binds the current thread to the cores of the NUMA node. 'node' must be in the range
+    /// [0, GetMaxNumNumaNodes()). Returns false if the thread cannot be bound, e.g. when
+    /// the cores of the node are not allowed by cgroup.
+    static bool bind_current_thread_to_numa_node(int node);
+
     /// Returns the model name of the cpu (e.g. Intel i7-2600)
     static std::string model_name() {
         DCHECK(initialized_);
@@ -0,0 +1,279 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "util/ddsketch.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "common/logging.h"
+#include "util/coding.h"
+
+namespace starrocks {
+
+static constexpr uint8_t kDDSketchVersion = 1;
+static constexpr double kGamma = (1 + DDSketch::kRelativeAccuracy) / (1 - DDSketch::kRelativeAccuracy);
+static const double kLogGamma = std::log(kGamma);
+static const double kMultiplier = 1 / kLogGamma;
+// The lowest positive normal value, whose index is about -35000.
+static constexpr double kMinIndexableValue = std::numeric_limits<double>::min();
+
+void DDSketch::Store::add_batch(const int32_t* indexes, size_t num_indexes) {
+    if (num_indexes == 0) {
+        return;
+    }
+    int32_t min_index = indexes[0];
+    int32_t max_index = indexes[0];
+    for (size_t i = 1; i < num_indexes; i++) {
+        min_index = std::min(min_index, indexes[i]);
+        max_index = std::max(max_index, indexes[i]);
+    }
+    if (empty() || min_index < _offset || max_index > this->max_index()) {
+        _extend(min_index, max_index);
+    }
+    for (size_t i = 0; i < num_indexes; i++) {
+        _bucket(indexes[i])++;
+    }
+    _total += num_indexes;
+}
+
+void DDSketch::Store::merge(const Store& other) {
+    if (other.empty()) {
+        return;
+    }
+    _extend(other.min_index(), other.max_index());
+    for (size_t i = 0; i < other._counts.size(); i++) {
+        _bucket(other._offset + static_cast<int32_t>(i)) += other._counts[i];
+    }
+    _total += other._total;
+}
+
+void DDSketch::Store::_extend(int32_t min_index, int32_t max_index) {
+    if (!empty()) {
+        min_index = std::min(min_index, _offset);
+        max_index = std::max(max_index, this->max_index());
+    }
+    // The highest index never decreases, so neither does the lowest collapsed one, and the buckets only depend on
+    // the added indexes.
+    min_index = static_cast<int32_t>(std::max<int64_t>(min_index, int64_t(max_index) - kMaxNumBuckets + 1));
+    if (!empty() && min_index == _offset && max_index == this->max_index()) {
+        return;
+    }
+    std::vector<uint64_t> counts(max_index - min_index + 1, 0);
+    for (size_t i = 0; i < _counts.size(); i++) {
+        int32_t index = std::max(_offset + static_cast<int32_t>(i), min_index);
+        counts[index - min_index] += _counts[i];
+    }
+    _counts.swap(counts);
+    _offset = min_index;
+}
+
+size_t DDSketch::Store::serialize_size() const {
+    size_t size = varint_length(_counts.size());
+    if (!empty()) {
+        size += sizeof(_offset);
+        for (uint64_t count : _counts) {
+            size += varint_length(count);
+        }
+    }
+    return size;
+}
+
+uint8_t* DDSketch::Store::serialize(uint8_t* dst) const {
+    dst = encode_varint32(dst, static_cast<uint32_t>(_counts.size()));
+    if (!empty()) {
+        memcpy(dst, &_offset, sizeof(_offset));
+        dst += sizeof(_offset);
+        for (uint64_t count : _counts) {
+            dst = encode_varint64(dst, count);
+        }
+    }
+    return dst;
+}
+
+bool DDSketch::Store::deserialize(Slice* src) {
+    uint32_t num_buckets = 0;
+    if (!get_varint32(src, &num_buckets) || num_buckets > kMaxNumBuckets) {
+        return false;
+    }
+    if (num_buckets == 0) {
+        return true;
+    }
+    if (src->size < sizeof(_offset)) {
+        return false;
+    }
+    memcpy(&_offset, src->data, sizeof(_offset));
+    src->remove_prefix(sizeof(_offset));
+    if (int64_t(_offset) + num_buckets - 1 > std::numeric_limits<int32_t>::max()) {
+        return false;
+    }
+    _counts.resize(num_buckets);
+    for (uint64_t& count : _counts) {
+        if (!get_varint64(src, &count)) {
+            return false;
+        }
+        _total += count;
+    }
+    return true;
+}
+
+int32_t DDSketch::_index(double value) {
+    return static_cast<int32_t>(std::ceil(std::log(value) * kMultiplier));
+}
+
+double DDSketch::_value(int32_t index) {
+    // The middle of the bucket (gamma^(index-1), gamma^index] in terms of the relative error.
+    return std::exp(index * kLogGamma) * 2 / (1 + kGamma);
+}
+
+void DDSketch::add(double value) {
+    add_batch(&value, 1);
+}
+
+void DDSketch::add_batch(const double* values, size_t num_values) {
+    static constexpr size_t kBatchSize = 256;
+    int32_t positive_indexes[kBatchSize];
+    int32_t negative_indexes[kBatchSize];
+    for (size_t start = 0; start < num_values; start += kBatchSize) {
+        size_t size = std::min(kBatchSize, num_values - start);
+        size_t num_positives = 0;
+        size_t num_negatives = 0;
+        uint64_t num_zeros = 0;
+        double min = std::numeric_limits<double>::infinity();
+        double max = -std::numeric_limits<double>::infinity();
+        for (size_t i = 0; i < size; i++) {
+            double value = values[start + i];
+            if (!std::isfinite(value)) {
+                continue;
+            }
+            min = std::min(min, value);
+            max = std::max(max, value);
+            if (value > kMinIndexableValue) {
+                positive_indexes[num_positives++] = _index(value);
+            } else if (value < -kMinIndexableValue) {
+                negative_indexes[num_negatives++] = _index(-value);
+            } else {
+                num_zeros++;
+            }
+        }
+        if (min > max) {
+            continue;
+        }
+        if (empty()) {
+            _min = min;
+            _max = max;
+        } else {
+            _min = std::min(_min, min);
+            _max = std::max(_max, max);
+        }
+        _positive.add_batch(positive_indexes, num_positives);
+        _negative.add_batch(negative_indexes, num_negatives);
+        _zero_count += num_zeros;
+    }
+}
+
+void DDSketch::merge(const DDSketch& other) {
+    if (other.empty()) {
+        return;
+    }
+    if (empty()) {
+        _min = other._min;
+        _max = other._max;
+    } else {
+        _min = std::min(_min, other._min);
+        _max = std::max(_max, other._max);
+    }
+    _positive.merge(other._positive);
+    _negative.merge(other._negative);
+    _zero_count += other._zero_count;
+}
+
+double DDSketch::quantile(double q) const {
+    uint64_t total = count();
+    if (total == 0 || std::isnan(q)) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    q = std::clamp(q, 0.0, 1.0);
+    double rank = q * (total - 1);
+    double result = 0;
+    if (rank < _negative.count()) {
+        // The negative values from the lowest, i.e. from the highest index of the absolute values.
+        uint64_t n = 0;
+        for (int32_t index = _negative.max_index();; index--) {
+            n += _negative.bucket_count(index);
+            if (n > rank) {
+                result = -_value(index);
+                break;
+            }
+        }
+    } else if (rank >= _negative.count() + _zero_count) {
+        uint64_t n = _negative.count() + _zero_count;
+        for (int32_t index = _positive.min_index();; index++) {
+            n += _positive.bucket_count(index);
+            if (n > rank) {
+                result = _value(index);
+                break;
+            }
+        }
+    }
+    return std::clamp(result, _min, _max);
+}
+
+size_t DDSketch::serialize_size() const {
+    size_t size = sizeof(kDDSketchVersion) + varint_length(_zero_count) + _positive.serialize_size() +
+                  _negative.serialize_size();
+    if (!empty()) {
+        size += sizeof(_min) + sizeof(_max);
+    }
+    return size;
+}
+
+size_t DDSketch::serialize(uint8_t* dst) const {
+    uint8_t* start = dst;
+    *dst++ = kDDSketchVersion;
+    dst = encode_varint64(dst, _zero_count);
+    dst = _positive.serialize(dst);
+    dst = _negative.serialize(dst);
+    if (!empty()) {
+        memcpy(dst, &_min, sizeof(_min));
+        dst += sizeof(_min);
+        memcpy(dst, &_max, sizeof(_max));
+        dst += sizeof(_max);
+    }
+    return dst - start;
+}
+
+bool DDSketch::deserialize(const Slice& src) {
+    DCHECK(empty());
+    Slice input = src;
+    if (input.size < sizeof(kDDSketchVersion) || input.data[0] != kDDSketchVersion) {
+        return false;
+    }
+    input.remove_prefix(sizeof(kDDSketchVersion));
+    if (!get_varint64(&input, &_zero_count) || !_positive.deserialize(&input) || !_negative.deserialize(&input)) {
+        return false;
+    }
+    if (!empty()) {
+        if (input.size != sizeof(_min) + sizeof(_max)) {
+            return false;
+        }
+        memcpy(&_min, input.data, sizeof(_min));
+        memcpy(&_max, input.data + sizeof(_min), sizeof(_max));
+        input.remove_prefix(sizeof(_min) + sizeof(_max));
+    }
+    return input.size == 0;
+}
+
+} // namespace starrocks
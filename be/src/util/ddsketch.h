@@ -0,0 +1,103 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "util/slice.h"
+
+namespace starrocks {
+
+// DDSketch is a quantile sketch with a relative error guarantee, see "DDSketch: A Fast and Fully-Mergeable
+// Quantile Sketch with Relative-Error Guarantees" (VLDB 2019).
+//
+// A positive value v is counted in the bucket ceil(log(v) / log(gamma)), where gamma = (1 + a) / (1 - a) for the
+// relative accuracy a, so any quantile is estimated within a relative error of a. The negative values are counted by
+// their absolute values in a separate store, and the values closer to zero than kMinIndexableValue are counted as
+// zeros. NaN and infinities are ignored.
+//
+// The counts are integers and only the lowest buckets are collapsed when a store exceeds kMaxNumBuckets, so the
+// sketch only depends on the multiset of the added values: the merges are deterministic regardless of their order.
+class DDSketch {
+public:
+    static constexpr double kRelativeAccuracy = 0.01;
+    // 2048 buckets cover the values within a ratio of about 6e17 at the accuracy of 1%.
+    static constexpr int32_t kMaxNumBuckets = 2048;
+
+    DDSketch() = default;
+
+    void add(double value);
+    void add_batch(const double* values, size_t num_values);
+    void merge(const DDSketch& other);
+
+    uint64_t count() const { return _zero_count + _positive.count() + _negative.count(); }
+    bool empty() const { return count() == 0; }
+
+    // The estimated value of the quantile |q| in [0, 1], NaN if the sketch is empty.
+    double quantile(double q) const;
+
+    size_t serialize_size() const;
+    // Serialize the sketch into |dst| of serialize_size() bytes, return the number of written bytes.
+    size_t serialize(uint8_t* dst) const;
+    // Deserialize |src| into an empty sketch, return false if |src| is corrupted.
+    bool deserialize(const Slice& src);
+
+    size_t mem_usage() const { return sizeof(*this) + _positive.mem_usage() + _negative.mem_usage(); }
+
+private:
+    // The buckets of the consecutive indexes [_offset, _offset + _counts.size()).
+    class Store {
+    public:
+        bool empty() const { return _counts.empty(); }
+        uint64_t count() const { return _total; }
+        int32_t min_index() const { return _offset; }
+        int32_t max_index() const { return _offset + static_cast<int32_t>(_counts.size()) - 1; }
+        uint64_t bucket_count(int32_t index) const { return _counts[index - _offset]; }
+
+        void add_batch(const int32_t* indexes, size_t num_indexes);
+        void merge(const Store& other);
+
+        size_t serialize_size() const;
+        uint8_t* serialize(uint8_t* dst) const;
+        bool deserialize(Slice* src);
+
+        size_t mem_usage() const { return _counts.capacity() * sizeof(uint64_t); }
+
+    private:
+        // Make the store cover [min_index, max_index], the lowest buckets are collapsed into the lowest remaining
+        // one if there are more than kMaxNumBuckets buckets.
+        void _extend(int32_t min_index, int32_t max_index);
+        // The bucket of |index|, which is collapsed into the lowest bucket if it's lower.
+        uint64_t& _bucket(int32_t index) { return _counts[std::max(index, _offset) - _offset]; }
+
+        std::vector<uint64_t> _counts;
+        int32_t _offset = 0;
+        uint64_t _total = 0;
+    };
+
+    static int32_t _index(double value);
+    static double _value(int32_t index);
+
+    Store _positive;
+    Store _negative;
+    uint64_t _zero_count = 0;
+    double _min = 0;
+    double _max = 0;
+};
+
+} // namespace starrocks
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
@@ -23,6 +24,7 @@
 #include <optional>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "column/column_hash.h"
 #include "glog/logging.h"
@@ -202,4 +204,132 @@ private:
     uint8_t _hash_table[hash_table_size + 1];
 };
 
+// DenseRangeHashMap maps the integer keys in a small range to the values by a flat array indexed by key - low,
+// without hashing the keys, and other keys are mapped by |FallbackMap|.
+// The range of the array is decided by the min and max of the first keys by init_range, and never changes after
+// that, so it should be called before the first key is inserted.
+// |KeyToInteger| converts the key to a int64_t, the different keys must be converted to different integers.
+// value shouldn't be nullptr
+template <typename KeyType, typename ValueType, typename FallbackMap, typename KeyToInteger>
+class DenseRangeHashMap {
+public:
+    static_assert(std::is_pointer_v<ValueType>);
+    static constexpr size_t min_slots = 256;
+
+    using key_type = KeyType;
+    using key_to_integer = KeyToInteger;
+
+    struct PPair {
+        ValueType second;
+        PPair* operator->() { return this; }
+    };
+
+    class iterator {
+    public:
+        explicit iterator(ValueType* value) : _value(value) {}
+
+        PPair operator->() const { return {*_value}; }
+
+        friend bool operator==(const iterator& a, const iterator& b) { return a._value == b._value; }
+        friend bool operator!=(const iterator& a, const iterator& b) { return !(a == b); }
+
+    private:
+        ValueType* _value;
+    };
+
+    bool range_inited() const { return _range_inited; }
+
+    // The array covers at least [min_key, max_key] if max_key - min_key < max_slots, otherwise all the keys are
+    // mapped by the fallback map.
+    void init_range(int64_t min_key, int64_t max_key, size_t max_slots) {
+        DCHECK(!_range_inited);
+        DCHECK_LE(min_key, max_key);
+        DCHECK_EQ(size(), 0);
+        _range_inited = true;
+        // the number of the keys in the range may overflow int64_t, so compute it by uint64_t.
+        const uint64_t span = static_cast<uint64_t>(max_key) - static_cast<uint64_t>(min_key);
+        if (span >= max_slots) {
+            return;
+        }
+        // leave room for the later keys around the range
+        const size_t num_slots = std::min(max_slots, std::max<size_t>((span + 1) * 2, min_slots));
+        _low = static_cast<uint64_t>(min_key) - (num_slots - span - 1) / 2;
+        _slots.assign(num_slots, nullptr);
+    }
+
+    template <class F>
+    iterator lazy_emplace(const KeyType& key, F&& f) {
+        if (ValueType* slot = _find_slot(key); slot != nullptr) {
+            return _emplace_slot(key, slot, std::forward<F>(f));
+        }
+        return iterator(&_fallback_map.lazy_emplace(key, std::forward<F>(f))->second);
+    }
+
+    template <class F>
+    iterator lazy_emplace_with_hash(const KeyType& key, size_t hashval, F&& f) {
+        if (ValueType* slot = _find_slot(key); slot != nullptr) {
+            return _emplace_slot(key, slot, std::forward<F>(f));
+        }
+        return iterator(&_fallback_map.lazy_emplace_with_hash(key, hashval, std::forward<F>(f))->second);
+    }
+
+    iterator find(const KeyType& key) {
+        if (ValueType* slot = _find_slot(key); slot != nullptr) {
+            return *slot == nullptr ? end() : iterator(slot);
+        }
+        auto iter = _fallback_map.find(key);
+        return iter == _fallback_map.end() ? end() : iterator(&iter->second);
+    }
+
+    iterator find(const KeyType& key, size_t hashval) {
+        if (ValueType* slot = _find_slot(key); slot != nullptr) {
+            return *slot == nullptr ? end() : iterator(slot);
+        }
+        auto iter = _fallback_map.find(key, hashval);
+        return iter == _fallback_map.end() ? end() : iterator(&iter->second);
+    }
+
+    iterator end() { return iterator(nullptr); }
+
+    // The hash values are only used by the fallback map.
+    auto hash_function() { return _fallback_map.hash_function(); }
+
+    void prefetch_hash(size_t hashval) const { _fallback_map.prefetch_hash(hashval); }
+
+    // It decides whether to prefetch for the fallback map.
+    size_t bucket_count() const { return _fallback_map.bucket_count(); }
+
+    size_t size() const { return _num_used_slots + _fallback_map.size(); }
+
+    size_t capacity() const { return _slots.size() + _fallback_map.capacity(); }
+
+    size_t dump_bound() const { return _slots.size() * sizeof(ValueType) + _fallback_map.dump_bound(); }
+
+    size_t num_slots() const { return _slots.size(); }
+
+private:
+    template <class F>
+    iterator _emplace_slot(const KeyType& key, ValueType* slot, F&& f) {
+        if (*slot == nullptr) {
+            f([&](const KeyType&, ValueType value) {
+                DCHECK(value != nullptr);
+                *slot = value;
+            });
+            _num_used_slots++;
+        }
+        return iterator(slot);
+    }
+
+    ValueType* _find_slot(const KeyType& key) {
+        const uint64_t offset = static_cast<uint64_t>(KeyToInteger()(key)) - _low;
+        return offset < _slots.size() ? &_slots[offset] : nullptr;
+    }
+
+    bool _range_inited = false;
+    uint64_t _low = 0;
+    size_t _num_used_slots = 0;
+    std::vector<ValueType> _slots;
+    FallbackMap _fallback_map;
+};
+
 } // namespace starrocks
@@ -0,0 +1,160 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "common/compiler_util.h"
+
+namespace starrocks {
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "FixedLayoutParser loads the strings as little-endian words");
+
+// FixedLayoutParser parses the numbers and dates of the regular layouts in SWAR (SIMD within a register) way:
+// 8 digits are validated and converted at once in a 64-bit word loaded from the string, without a branch per
+// character.
+// They only accept a subset of the strings accepted by StringParser and date::from_string*, and return the same
+// results for them. The callers should fall back to those for the irregular strings, e.g. with whitespaces.
+class FixedLayoutParser {
+public:
+    // Parse an optional sign followed by 1 to 19 digits, return false if |s| is not of this layout or the value
+    // overflows T.
+    template <typename T>
+    static bool parse_int(const char* s, size_t len, T* value) {
+        bool negative = false;
+        size_t i = 0;
+        if (len > 0 && (s[0] == '-' || s[0] == '+')) {
+            negative = s[0] == '-';
+            i = 1;
+        }
+        const size_t num_digits = len - i;
+        if (UNLIKELY(num_digits == 0 || num_digits > 19)) {
+            return false;
+        }
+        // The leading partial word is padded with '0' on the left.
+        const size_t head = num_digits % 8;
+        uint64_t word = kZeros;
+        memcpy(reinterpret_cast<char*>(&word) + 8 - head, s + i, head);
+        if (!is_eight_digits(word)) {
+            return false;
+        }
+        uint64_t val = parse_eight_digits(word);
+        for (i += head; i < len; i += 8) {
+            memcpy(&word, s + i, 8);
+            if (!is_eight_digits(word)) {
+                return false;
+            }
+            val = val * 100000000 + parse_eight_digits(word);
+        }
+
+        // 19 digits always fit in int128_t.
+        if constexpr (sizeof(T) <= sizeof(int64_t)) {
+            if (val > static_cast<uint64_t>(std::numeric_limits<T>::max()) + negative) {
+                return false;
+            }
+        }
+        *value = negative ? static_cast<T>(-static_cast<__int128>(val)) : static_cast<T>(val);
+        return true;
+    }
+
+    // Parse the first 10 bytes of |s| like "%Y-%m-%d", where '-' is any non-digit character.
+    // The values are not validated.
+    static bool parse_date(const char* s, int* year, int* month, int* day) {
+        if (is_digit(s[4]) || is_digit(s[7])) {
+            return false;
+        }
+        uint64_t word;
+        memcpy(&word, s, 8);
+        // Replace the separators by '0' to validate all the digits at once.
+        word = (word & ~0xFF0000FF00000000ULL) | 0x3000003000000000ULL;
+        uint64_t day_word = kZeros;
+        memcpy(&day_word, s + 8, 2);
+        if (!is_eight_digits(word) || !is_eight_digits(day_word)) {
+            return false;
+        }
+        uint64_t pairs = to_two_digits(word);
+        *year = byte_at(pairs, 0) * 100 + byte_at(pairs, 2);
+        *month = byte_at(pairs, 5);
+        *day = byte_at(to_two_digits(day_word), 0);
+        return true;
+    }
+
+    // Parse the first 8 bytes of |s| like "%H:%i:%s", where ':' is any non-digit character.
+    // The values are not validated.
+    static bool parse_time(const char* s, int* hour, int* minute, int* second) {
+        if (is_digit(s[2]) || is_digit(s[5])) {
+            return false;
+        }
+        uint64_t word;
+        memcpy(&word, s, 8);
+        word = (word & ~0x0000FF0000FF0000ULL) | 0x0000300000300000ULL;
+        if (!is_eight_digits(word)) {
+            return false;
+        }
+        uint64_t pairs = to_two_digits(word);
+        *hour = byte_at(pairs, 0);
+        *minute = byte_at(pairs, 3);
+        *second = byte_at(pairs, 6);
+        return true;
+    }
+
+    // Parse 1 to 6 digits of the fraction of second as microseconds, e.g. "5" is 500000.
+    static bool parse_microsecond(const char* s, size_t len, int* microsecond) {
+        if (UNLIKELY(len == 0 || len > 6)) {
+            return false;
+        }
+        // The word is padded with '0' on the right.
+        uint64_t word = kZeros;
+        memcpy(&word, s, len);
+        if (!is_eight_digits(word)) {
+            return false;
+        }
+        *microsecond = parse_eight_digits(word) / 100;
+        return true;
+    }
+
+    static bool is_eight_digits(uint64_t word) {
+        return ((word & 0xF0F0F0F0F0F0F0F0ULL) | (((word + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+               0x3333333333333333ULL;
+    }
+
+    // Convert the 8 digits loaded as |word| to the number, the most significant digit is the first byte.
+    static uint32_t parse_eight_digits(uint64_t word) {
+        word -= kZeros;
+        word = word * 10 + (word >> 8);
+        word = (((word & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+                (((word >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >>
+               32;
+        return static_cast<uint32_t>(word);
+    }
+
+private:
+    static constexpr uint64_t kZeros = 0x3030303030303030ULL;
+
+    static bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+    // The i-th byte of the result is the number of the i-th and (i+1)-th digits of |word|.
+    static uint64_t to_two_digits(uint64_t word) {
+        word -= kZeros;
+        return word * 10 + (word >> 8);
+    }
+
+    static int byte_at(uint64_t word, int i) { return static_cast<int>((word >> (i * 8)) & 0xFF); }
+};
+
+} // namespace starrocks
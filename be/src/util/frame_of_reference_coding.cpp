@@ -37,6 +37,7 @@
 #include <algorithm>
 #include <cstring>
 
+#include "gutil/endian.h"
 #include "util/bit_util.h"
 #include "util/coding.h"
 
@@ -282,7 +283,6 @@ bool ForDecoder<T>::init() {
     return true;
 }
 
-// todo(kks): improve this method by SIMD instructions
 // The reverse of bit_pack method, get original integer data list from packed bits
 // param[in] input: the packed bits need to unpack
 // param[in] in_num: the integer number in packed bits
@@ -290,9 +290,39 @@ bool ForDecoder<T>::init() {
 // param[out] output: the original integer data list
 template <typename T>
 void ForDecoder<T>::bit_unpack(const uint8_t* input, uint8_t in_num, int bit_width, T* output) {
+    if (bit_width == 0) {
+        std::fill(output, output + in_num, static_cast<T>(0));
+        return;
+    }
+
+    // The packed bits are a big-endian bit stream, so each value can be extracted from the 64-bit big-endian
+    // word starting at the byte of its first bit, as long as the word covers the whole value and doesn't exceed
+    // the packed bits of this frame.
+    uint32_t num_unpacked = 0;
+    if (sizeof(T) <= 8 && bit_width <= 57) {
+        const size_t packed_bytes = (static_cast<size_t>(in_num) * bit_width + 7) / 8;
+        const int shift = 64 - bit_width;
+        for (; num_unpacked < in_num; num_unpacked++) {
+            size_t bit_offset = static_cast<size_t>(num_unpacked) * bit_width;
+            size_t byte_offset = bit_offset >> 3;
+            if (byte_offset + 8 > packed_bytes) {
+                break;
+            }
+            uint64_t word = BigEndian::Load64(input + byte_offset);
+            output[num_unpacked] = static_cast<T>((word << (bit_offset & 7)) >> shift);
+        }
+        if (num_unpacked == in_num) {
+            return;
+        }
+    }
+
+    // Unpack the remaining values bit by bit.
+    size_t bit_offset = static_cast<size_t>(num_unpacked) * bit_width;
+    input += bit_offset >> 3;
+    int bit_index = bit_offset & 7;
+    output += num_unpacked;
     unsigned char in_mask = 0x80;
-    int bit_index = 0;
-    while (in_num > 0) {
+    for (uint32_t n = num_unpacked; n < in_num; n++) {
         *output = 0;
         for (int i = 0; i < bit_width; i++) {
             if (bit_index > 7) {
@@ -303,7 +333,6 @@ void ForDecoder<T>::bit_unpack(const uint8_t* input, uint8_t in_num, int bit_wid
             bit_index++;
         }
         output++;
-        in_num--;
     }
 }
 
@@ -314,9 +343,14 @@ void ForDecoder<T>::decode_current_frame(T* output) {
         return; // current frame already decoded
     }
     _current_decoded_frame = frame_index;
+    decode_frame(frame_index, output);
+}
+
+template <typename T>
+void ForDecoder<T>::decode_frame(uint32_t frame_index, T* output) {
     uint8_t current_frame_size = frame_size(frame_index);
 
-    uint32_t base_offset = _frame_offsets[_current_decoded_frame];
+    uint32_t base_offset = _frame_offsets[frame_index];
     T min = 0;
     uint32_t delta_offset = 0;
     if (sizeof(T) == 16) {
@@ -330,27 +364,74 @@ void ForDecoder<T>::decode_current_frame(T* output) {
         delta_offset = base_offset + 4;
     }
 
-    uint8_t bit_width = _bit_widths[_current_decoded_frame];
+    uint8_t bit_width = _bit_widths[frame_index];
+
+    // Unpack the deltas into the output directly, and then restore the values in place.
+    bit_unpack(_buffer + delta_offset, current_frame_size, bit_width, output);
+    uint8_t storage_format = _storage_formats[frame_index];
+    if (storage_format == 1) {
+        // ascending: prefix sum of the deltas from the min value
+        T pre_value = min;
+        for (uint8_t i = 0; i < current_frame_size; i++) {
+            pre_value += output[i];
+            output[i] = pre_value;
+        }
+    } else if (storage_format == 0) {
+        for (uint8_t i = 0; i < current_frame_size; i++) {
+            output[i] += min;
+        }
+    }
+}
 
-    bool is_original_value = _storage_formats[_current_decoded_frame] == 2;
-    if (is_original_value) {
-        bit_unpack(_buffer + delta_offset, current_frame_size, bit_width, output);
-    } else {
-        bool is_ascending = _storage_formats[_current_decoded_frame] == 1;
-        std::vector<T> delta_values(current_frame_size);
-        bit_unpack(_buffer + delta_offset, current_frame_size, bit_width, delta_values.data());
-        if (is_ascending) {
-            T pre_value = min;
-            for (uint8_t i = 0; i < current_frame_size; i++) {
-                T value = delta_values[i] + pre_value;
-                output[i] = value;
-                pre_value = value;
+template <typename T>
+void ForDecoder<T>::evaluate_range(uint32_t from, uint32_t to, T lower, T upper, bool negate, uint8_t* selection) {
+    DCHECK_LE(to, _values_num);
+    T values[std::numeric_limits<uint8_t>::max()];
+    while (from < to) {
+        uint32_t frame_index = from / _max_frame_size;
+        uint32_t frame_begin = frame_index * _max_frame_size;
+        uint32_t end = std::min<uint32_t>(to, frame_begin + frame_size(frame_index));
+        uint32_t n = end - from;
+        bool evaluated = false;
+        if constexpr (std::is_integral_v<T> && sizeof(T) <= 8) {
+            if (_storage_formats[frame_index] == 0) {
+                using U = std::make_unsigned_t<T>;
+                // All the values of the frame are in [min, max], max is min + (2^bit_width - 1) saturated.
+                const T min = decode_frame_min_value(frame_index);
+                const uint8_t bit_width = _bit_widths[frame_index];
+                const U max_delta =
+                        bit_width >= sizeof(U) * 8 ? std::numeric_limits<U>::max() : (U(1) << bit_width) - 1;
+                const U room = static_cast<U>(std::numeric_limits<T>::max()) - static_cast<U>(min);
+                const T max = max_delta >= room ? std::numeric_limits<T>::max()
+                                                : static_cast<T>(static_cast<U>(min) + max_delta);
+                if (lower <= min && max <= upper) {
+                    memset(selection, !negate, n);
+                } else if (max < lower || upper < min) {
+                    memset(selection, negate, n);
+                } else {
+                    // Compare the deltas with [lower - min, upper - min] directly, the values are not restored.
+                    const U lower_delta = lower <= min ? 0 : static_cast<U>(lower) - static_cast<U>(min);
+                    const U upper_delta = upper >= max ? max_delta : static_cast<U>(upper) - static_cast<U>(min);
+                    const uint32_t delta_offset = _frame_offsets[frame_index] + (sizeof(T) == 8 ? 8 : 4);
+                    bit_unpack(_buffer + delta_offset, end - frame_begin, bit_width, values);
+                    const T* deltas = values + (from - frame_begin);
+                    for (uint32_t i = 0; i < n; i++) {
+                        const auto delta = static_cast<U>(deltas[i]);
+                        selection[i] = ((delta >= lower_delta) & (delta <= upper_delta)) ^ negate;
+                    }
+                }
+                evaluated = true;
             }
-        } else {
-            for (uint8_t i = 0; i < current_frame_size; i++) {
-                output[i] = delta_values[i] + min;
+        }
+        if (!evaluated) {
+            decode_frame(frame_index, values);
+            const T* frame_values = values + (from - frame_begin);
+            for (uint32_t i = 0; i < n; i++) {
+                selection[i] = ((frame_values[i] >= lower) & (frame_values[i] <= upper)) ^ negate;
             }
         }
+        selection += n;
+        from = end;
     }
 }
 
@@ -401,6 +482,10 @@ bool ForDecoder<T>::get_batch(T* val, size_t count) {
         _current_index += _max_frame_size;
         val += _max_frame_size;
     }
+    if (frame_count > 0) {
+        // The frame decoded into |val| directly is not in _out_buffer.
+        _current_decoded_frame = -1;
+    }
 
     // 3. process remaining value
     size_t remaining_num = (count - padding_num) % _max_frame_size;
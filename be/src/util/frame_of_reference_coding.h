@@ -159,6 +159,13 @@ public:
 
     bool seek_at_or_after_value(const void* value, bool* exact_match);
 
+    // Evaluate whether the values of [from, to) are in [lower, upper], the result is negated if |negate|
+    // is true. selection[i - from] is set to 1 if the value i matches, and 0 otherwise.
+    // The frames whose values are all inside or all outside of [lower, upper] are evaluated by the
+    // min value and bit width without unpacking, and the others are evaluated on the packed deltas
+    // when possible. The current position is not changed.
+    void evaluate_range(uint32_t from, uint32_t to, T lower, T upper, bool negate, uint8_t* selection);
+
     uint32_t current_index() const { return _current_index; }
 
     uint32_t count() const { return _values_num; }
@@ -172,6 +179,8 @@ private:
 
     void decode_current_frame(T* output);
 
+    void decode_frame(uint32_t frame_index, T* output);
+
     T decode_frame_min_value(uint32_t frame_index);
 
     // Return index of the last frame which contains value < target.
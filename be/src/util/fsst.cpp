@@ -0,0 +1,282 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "util/fsst.h"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+#include "common/logging.h"
+#include "gutil/port.h"
+
+namespace starrocks {
+
+// The table is refined by this number of rounds, each round compresses the sample
+// with the current table and picks the symbols of the most gain.
+static constexpr int BUILD_ROUNDS = 5;
+// At most this number of bytes are used to build the table.
+static constexpr size_t MAX_SAMPLE_BYTES = 16 * 1024;
+
+static inline uint64_t load_symbol(const uint8_t* p, size_t remain) {
+    uint64_t v = 0;
+    memcpy(&v, p, std::min(remain, FsstSymbolTable::MAX_SYMBOL_LENGTH));
+    return v;
+}
+
+static inline uint64_t symbol_mask(size_t len) {
+    return len >= FsstSymbolTable::MAX_SYMBOL_LENGTH ? ~0ULL : (1ULL << (len * 8)) - 1;
+}
+
+FsstSymbolTable::FsstSymbolTable(const std::vector<std::string>& symbols) {
+    _init(symbols);
+}
+
+void FsstSymbolTable::_init(const std::vector<std::string>& symbols) {
+    DCHECK_LE(symbols.size(), MAX_SYMBOLS);
+    _num_symbols = symbols.size();
+    for (size_t i = 0; i < _num_symbols; i++) {
+        DCHECK(!symbols[i].empty() && symbols[i].size() <= MAX_SYMBOL_LENGTH);
+        _lengths[i] = symbols[i].size();
+        _symbols[i] = 0;
+        memcpy(&_symbols[i], symbols[i].data(), symbols[i].size());
+    }
+
+    // Bucket the codes by the first byte, longer symbols first so the first match is the longest one.
+    std::vector<uint8_t> codes(_num_symbols);
+    for (size_t i = 0; i < _num_symbols; i++) {
+        codes[i] = i;
+    }
+    std::sort(codes.begin(), codes.end(), [&](uint8_t a, uint8_t b) {
+        auto first_a = static_cast<uint8_t>(_symbols[a]);
+        auto first_b = static_cast<uint8_t>(_symbols[b]);
+        if (first_a != first_b) {
+            return first_a < first_b;
+        }
+        return _lengths[a] > _lengths[b];
+    });
+    memset(_first_byte_begin, 0, sizeof(_first_byte_begin));
+    for (size_t i = 0; i < _num_symbols; i++) {
+        _codes_by_first_byte[i] = codes[i];
+        _first_byte_begin[static_cast<uint8_t>(_symbols[codes[i]]) + 1]++;
+    }
+    for (size_t b = 1; b <= 256; b++) {
+        _first_byte_begin[b] += _first_byte_begin[b - 1];
+    }
+}
+
+int FsstSymbolTable::_find_longest(const uint8_t* p, size_t remain) const {
+    uint64_t word = load_symbol(p, remain);
+    for (size_t i = _first_byte_begin[*p]; i < _first_byte_begin[*p + 1]; i++) {
+        uint8_t code = _codes_by_first_byte[i];
+        size_t len = _lengths[code];
+        if (len <= remain && (word & symbol_mask(len)) == _symbols[code]) {
+            return code;
+        }
+    }
+    return -1;
+}
+
+FsstSymbolTable FsstSymbolTable::build(const std::vector<Slice>& samples) {
+    // Take the samples evenly if there are too many bytes.
+    size_t total_bytes = 0;
+    for (const auto& s : samples) {
+        total_bytes += s.size;
+    }
+    size_t step = std::max<size_t>(1, total_bytes / MAX_SAMPLE_BYTES);
+    std::vector<Slice> sample;
+    for (size_t i = 0; i < samples.size(); i += step) {
+        sample.push_back(samples[i]);
+    }
+
+    std::vector<std::string> symbols;
+    FsstSymbolTable table;
+    std::vector<uint32_t> count1;
+    std::vector<uint32_t> count2;
+    for (int round = 0; round < BUILD_ROUNDS; round++) {
+        table._init(symbols);
+        // The ids of [0, n) are the symbols, and the ids of [n, n + 256) are the single bytes.
+        const size_t n = symbols.size();
+        const size_t num_ids = n + 256;
+        count1.assign(num_ids, 0);
+        count2.assign(num_ids * num_ids, 0);
+        for (const auto& s : sample) {
+            const auto* p = reinterpret_cast<const uint8_t*>(s.data);
+            const uint8_t* end = p + s.size;
+            int prev = -1;
+            while (p < end) {
+                int code = table._find_longest(p, end - p);
+                size_t id;
+                size_t len;
+                if (code >= 0) {
+                    id = code;
+                    len = table._lengths[code];
+                    if (len > 1) {
+                        // Also count the single byte, so it has a chance to be a symbol itself.
+                        count1[n + *p]++;
+                    }
+                } else {
+                    id = n + *p;
+                    len = 1;
+                }
+                count1[id]++;
+                if (prev >= 0) {
+                    count2[prev * num_ids + id]++;
+                }
+                prev = id;
+                p += len;
+            }
+        }
+
+        auto id_to_string = [&](size_t id) {
+            return id < n ? symbols[id] : std::string(1, static_cast<char>(id - n));
+        };
+        // The gain of a symbol is the number of bytes it covers.
+        std::unordered_map<std::string, uint64_t> gains;
+        for (size_t id = 0; id < num_ids; id++) {
+            if (count1[id] > 0) {
+                std::string s = id_to_string(id);
+                gains[s] += static_cast<uint64_t>(count1[id]) * s.size();
+            }
+        }
+        for (size_t a = 0; a < num_ids; a++) {
+            if (count1[a] == 0) {
+                continue;
+            }
+            std::string sa = id_to_string(a);
+            if (sa.size() == MAX_SYMBOL_LENGTH) {
+                continue;
+            }
+            for (size_t b = 0; b < num_ids; b++) {
+                uint32_t cnt = count2[a * num_ids + b];
+                if (cnt == 0) {
+                    continue;
+                }
+                std::string s = sa + id_to_string(b);
+                s.resize(std::min(s.size(), MAX_SYMBOL_LENGTH));
+                gains[s] += static_cast<uint64_t>(cnt) * s.size();
+            }
+        }
+
+        std::vector<std::pair<std::string, uint64_t>> candidates(gains.begin(), gains.end());
+        size_t num_selected = std::min(candidates.size(), MAX_SYMBOLS);
+        std::partial_sort(candidates.begin(), candidates.begin() + num_selected, candidates.end(),
+                          [](const auto& a, const auto& b) {
+                              return a.second != b.second ? a.second > b.second : a.first < b.first;
+                          });
+        symbols.clear();
+        for (size_t i = 0; i < num_selected; i++) {
+            symbols.emplace_back(std::move(candidates[i].first));
+        }
+    }
+    return FsstSymbolTable(symbols);
+}
+
+void FsstSymbolTable::serialize(faststring* dst) const {
+    dst->push_back(static_cast<char>(_num_symbols));
+    dst->append(_lengths, _num_symbols);
+    for (size_t i = 0; i < _num_symbols; i++) {
+        dst->append(&_symbols[i], _lengths[i]);
+    }
+}
+
+Status FsstSymbolTable::deserialize(const uint8_t* data, size_t size, size_t* consumed) {
+    if (size < 1 || size < 1 + data[0]) {
+        return Status::Corruption("not enough bytes for fsst symbol table");
+    }
+    size_t num_symbols = data[0];
+    if (num_symbols > MAX_SYMBOLS) {
+        return Status::Corruption("too many symbols in fsst symbol table");
+    }
+    const uint8_t* lengths = data + 1;
+    size_t pos = 1 + num_symbols;
+    std::vector<std::string> symbols(num_symbols);
+    for (size_t i = 0; i < num_symbols; i++) {
+        if (lengths[i] == 0 || lengths[i] > MAX_SYMBOL_LENGTH || pos + lengths[i] > size) {
+            return Status::Corruption("invalid symbol in fsst symbol table");
+        }
+        symbols[i].assign(reinterpret_cast<const char*>(data + pos), lengths[i]);
+        pos += lengths[i];
+    }
+    _init(symbols);
+    *consumed = pos;
+    return Status::OK();
+}
+
+void FsstSymbolTable::compress(const Slice& value, faststring* dst) const {
+    const auto* p = reinterpret_cast<const uint8_t*>(value.data);
+    const uint8_t* end = p + value.size;
+    size_t old_size = dst->size();
+    dst->resize(old_size + value.size * 2);
+    uint8_t* out = dst->data() + old_size;
+    while (p < end) {
+        int code = _find_longest(p, end - p);
+        if (code >= 0) {
+            *out++ = code;
+            p += _lengths[code];
+        } else {
+            *out++ = ESCAPE_CODE;
+            *out++ = *p++;
+        }
+    }
+    dst->resize(out - dst->data());
+}
+
+size_t FsstSymbolTable::decompress(const uint8_t* codes, size_t len, uint8_t* dst) const {
+    const uint8_t* end = codes + len;
+    uint8_t* out = dst;
+    while (codes < end) {
+        uint8_t code = *codes++;
+        if (PREDICT_TRUE(code != ESCAPE_CODE)) {
+            // Always copy 8 bytes and advance by the symbol length, which avoids a variable-length copy.
+            memcpy(out, &_symbols[code], MAX_SYMBOL_LENGTH);
+            out += _lengths[code];
+        } else {
+            if (PREDICT_FALSE(codes >= end)) {
+                break;
+            }
+            *out++ = *codes++;
+        }
+    }
+    return out - dst;
+}
+
+bool FsstSymbolTable::starts_with(const uint8_t* codes, size_t len, const Slice& prefix) const {
+    const uint8_t* end = codes + len;
+    const auto* expected = reinterpret_cast<const uint8_t*>(prefix.data);
+    size_t remain = prefix.size;
+    while (remain > 0) {
+        if (codes >= end) {
+            return false;
+        }
+        uint8_t code = *codes++;
+        if (code != ESCAPE_CODE) {
+            size_t n = std::min<size_t>(_lengths[code], remain);
+            if (memcmp(&_symbols[code], expected, n) != 0) {
+                return false;
+            }
+            expected += n;
+            remain -= n;
+        } else {
+            if (codes >= end || *codes++ != *expected) {
+                return false;
+            }
+            expected++;
+            remain--;
+        }
+    }
+    return true;
+}
+
+} // namespace starrocks
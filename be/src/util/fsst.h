@@ -0,0 +1,86 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "util/faststring.h"
+#include "util/slice.h"
+
+namespace starrocks {
+
+// FSST (Fast Static Symbol Table) string compression, see
+// "FSST: Fast Random Access String Compression" (Boncz, Neumann, Leis, VLDB 2020).
+//
+// A symbol table maps up to 255 one-byte codes to symbols of 1 to 8 bytes. A string is compressed
+// by replacing the longest symbol at each position with its code, the bytes not covered by any
+// symbol are written as ESCAPE_CODE followed by the byte itself. Every string can be decompressed
+// on its own, which makes random access cheap.
+//
+// Compression is deterministic for a given table, so two strings are equal if and only if
+// their compressed codes are equal.
+class FsstSymbolTable {
+public:
+    static constexpr size_t MAX_SYMBOLS = 255;
+    static constexpr uint8_t ESCAPE_CODE = 255;
+    static constexpr size_t MAX_SYMBOL_LENGTH = 8;
+
+    FsstSymbolTable() = default;
+
+    // Build a symbol table which compresses |samples| well.
+    static FsstSymbolTable build(const std::vector<Slice>& samples);
+
+    void serialize(faststring* dst) const;
+
+    // Parse the table written by `serialize`, |*consumed| is set to the number of bytes used.
+    Status deserialize(const uint8_t* data, size_t size, size_t* consumed);
+
+    // Append the compressed |value| to |dst|, which at most 2 * |value.size| bytes.
+    void compress(const Slice& value, faststring* dst) const;
+
+    // Decompress |codes| into |dst|, return the decompressed size.
+    // |dst| must have at least `decompress_bound(len)` bytes.
+    size_t decompress(const uint8_t* codes, size_t len, uint8_t* dst) const;
+
+    static size_t decompress_bound(size_t len) { return len * MAX_SYMBOL_LENGTH; }
+
+    // Return true if the string of |codes| starts with |prefix|, only the codes needed
+    // to cover the prefix are decompressed.
+    bool starts_with(const uint8_t* codes, size_t len, const Slice& prefix) const;
+
+    size_t num_symbols() const { return _num_symbols; }
+
+private:
+    explicit FsstSymbolTable(const std::vector<std::string>& symbols);
+
+    void _init(const std::vector<std::string>& symbols);
+
+    // Return the code of the longest symbol at |p|, or -1 if there is none.
+    int _find_longest(const uint8_t* p, size_t remain) const;
+
+    size_t _num_symbols{0};
+    uint8_t _lengths[MAX_SYMBOLS]{};
+    // Symbol bytes in little endian, padding with zero.
+    uint64_t _symbols[MAX_SYMBOLS]{};
+    // The codes of the symbols starting with byte b are
+    // _codes_by_first_byte[_first_byte_begin[b], _first_byte_begin[b + 1]), longest first.
+    uint16_t _first_byte_begin[257]{};
+    uint8_t _codes_by_first_byte[MAX_SYMBOLS]{};
+};
+
+} // namespace starrocks
@@ -0,0 +1,89 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace starrocks {
+
+// LatencyHistogram counts latencies into the exponential buckets
+// [0, 10us], (10us, 100us], (100us, 1ms], (1ms, 10ms], (10ms, 100ms], (100ms, 1s] and (1s, +Inf).
+// It is lock-free and can be updated by multiple threads concurrently.
+class LatencyHistogram {
+public:
+    static constexpr size_t NUM_BUCKETS = 7;
+
+    LatencyHistogram() = default;
+    ~LatencyHistogram() = default;
+
+    void add(int64_t latency_ns) { _counts[bucket_of(latency_ns)].fetch_add(1, std::memory_order_relaxed); }
+
+    int64_t count(size_t bucket) const { return _counts[bucket].load(std::memory_order_relaxed); }
+
+    int64_t total_count() const {
+        int64_t total = 0;
+        for (const auto& count : _counts) {
+            total += count.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    void merge(const LatencyHistogram& rhs) {
+        for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+            _counts[i].fetch_add(rhs.count(i), std::memory_order_relaxed);
+        }
+    }
+
+    static size_t bucket_of(int64_t latency_ns) {
+        size_t bucket = 0;
+        while (bucket < NUM_BUCKETS - 1 && latency_ns > BUCKET_UPPER_BOUNDS_NS[bucket]) {
+            ++bucket;
+        }
+        return bucket;
+    }
+
+    // The upper bound of the bucket, used as the "le" label of metrics.
+    static const char* bucket_name(size_t bucket) {
+        static constexpr const char* NAMES[NUM_BUCKETS] = {"10us", "100us", "1ms", "10ms", "100ms", "1s", "+Inf"};
+        return NAMES[bucket];
+    }
+
+    // Output the non-empty buckets, such as "<=10us:3, <=1ms:1, <=+Inf:2".
+    std::string to_string() const {
+        std::string res;
+        for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+            int64_t value = count(i);
+            if (value == 0) {
+                continue;
+            }
+            if (!res.empty()) {
+                res.append(", ");
+            }
+            res.append("<=").append(bucket_name(i)).append(":").append(std::to_string(value));
+        }
+        return res;
+    }
+
+private:
+    static constexpr std::array<int64_t, NUM_BUCKETS - 1> BUCKET_UPPER_BOUNDS_NS = {
+            10'000, 100'000, 1'000'000, 10'000'000, 100'000'000, 1'000'000'000};
+
+    std::array<std::atomic<int64_t>, NUM_BUCKETS> _counts{};
+};
+
+} // namespace starrocks
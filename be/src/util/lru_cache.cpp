@@ -6,6 +6,7 @@
 
 #include <rapidjson/document.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <sstream>
@@ -154,6 +155,8 @@ LRUCache::LRUCache() {
     // Make empty circular linked list
     _lru.next = &_lru;
     _lru.prev = &_lru;
+    _protected.next = &_protected;
+    _protected.prev = &_protected;
 }
 
 LRUCache::~LRUCache() noexcept {
@@ -185,6 +188,7 @@ void LRUCache::set_capacity(size_t capacity) {
     {
         std::lock_guard l(_mutex);
         _capacity = capacity;
+        _balance_protected();
         _evict_from_lru(0, &last_ref_list);
     }
 
@@ -193,6 +197,89 @@ void LRUCache::set_capacity(size_t capacity) {
     }
 }
 
+void LRUCache::set_protected_ratio(double ratio) {
+    std::lock_guard l(_mutex);
+    DCHECK_EQ(0, _usage);
+    _protected_ratio = (ratio > 0 && ratio < 1) ? ratio : 0;
+}
+
+void LRUCache::_sub_usage(LRUHandle* e) {
+    _usage -= e->charge;
+    if (e->in_protected) {
+        _protected_usage -= e->charge;
+    }
+    if (e->owner != kNoCacheOwner) {
+        _owners[e->owner].stats.usage -= e->charge;
+    }
+}
+
+void LRUCache::set_owner_quota(int64_t owner, double reserved_ratio, double limit_ratio) {
+    std::vector<LRUHandle*> last_ref_list;
+    {
+        std::lock_guard l(_mutex);
+        auto& state = _owners[owner];
+        state.reserved_ratio = std::max(0.0, reserved_ratio);
+        state.limit_ratio = std::max(0.0, limit_ratio);
+        _evict_owner_over_limit(owner, 0, &last_ref_list);
+    }
+    for (auto entry : last_ref_list) {
+        entry->free();
+    }
+}
+
+CacheOwnerStats LRUCache::get_owner_stats(int64_t owner) {
+    std::lock_guard l(_mutex);
+    auto it = _owners.find(owner);
+    return it == _owners.end() ? CacheOwnerStats() : it->second.stats;
+}
+
+bool LRUCache::_is_reserved(const LRUHandle* e, int64_t owner) const {
+    if (e->owner == kNoCacheOwner || e->owner == owner) {
+        return false;
+    }
+    auto it = _owners.find(e->owner);
+    if (it->second.reserved_ratio <= 0) {
+        return false;
+    }
+    const auto reserved = static_cast<size_t>(static_cast<double>(_capacity) * it->second.reserved_ratio);
+    return it->second.stats.usage <= reserved;
+}
+
+void LRUCache::_evict_owner_over_limit(int64_t owner, size_t charge, std::vector<LRUHandle*>* deleted) {
+    if (owner == kNoCacheOwner) {
+        return;
+    }
+    const auto& state = _owners[owner];
+    if (state.limit_ratio <= 0) {
+        return;
+    }
+    const auto limit = static_cast<size_t>(static_cast<double>(_capacity) * state.limit_ratio);
+    for (LRUHandle* list : {&_lru, &_protected}) {
+        LRUHandle* cur = list;
+        while (state.stats.usage + charge > limit && cur->next != list) {
+            LRUHandle* old = cur->next;
+            if (old->owner != owner) {
+                cur = cur->next;
+                continue;
+            }
+            _evict_one_entry(old);
+            deleted->push_back(old);
+        }
+    }
+}
+
+void LRUCache::_balance_protected() {
+    // Demote the oldest unused protected entries to the newest of probation.
+    const auto limit = static_cast<size_t>(static_cast<double>(_capacity) * _protected_ratio);
+    while (_protected_usage > limit && _protected.next != &_protected) {
+        LRUHandle* old = _protected.next;
+        _lru_remove(old);
+        old->in_protected = false;
+        _protected_usage -= old->charge;
+        _lru_append(&_lru, old);
+    }
+}
+
 uint64_t LRUCache::get_lookup_count() {
     std::lock_guard l(_mutex);
     return _lookup_count;
@@ -213,10 +300,15 @@ size_t LRUCache::get_capacity() {
     return _capacity;
 }
 
-Cache::Handle* LRUCache::lookup(const CacheKey& key, uint32_t hash) {
+Cache::Handle* LRUCache::lookup(const CacheKey& key, uint32_t hash, int64_t owner) {
     std::lock_guard l(_mutex);
     ++_lookup_count;
     LRUHandle* e = _table.lookup(key, hash);
+    if (owner != kNoCacheOwner) {
+        auto& stats = _owners[owner].stats;
+        stats.lookup_count++;
+        stats.hit_count += (e != nullptr);
+    }
     if (e != nullptr) {
         // we get it from _table, so in_cache must be true
         DCHECK(e->in_cache);
@@ -226,6 +318,11 @@ Cache::Handle* LRUCache::lookup(const CacheKey& key, uint32_t hash) {
         }
         e->refs++;
         ++_hit_count;
+        if (_protected_ratio > 0 && !e->in_protected) {
+            // hit again after admitted, promote it to protected segment when it is released
+            e->in_protected = true;
+            _protected_usage += e->charge;
+        }
     }
     return reinterpret_cast<Cache::Handle*>(e);
 }
@@ -240,7 +337,7 @@ void LRUCache::release(Cache::Handle* handle) {
         std::lock_guard l(_mutex);
         last_ref = _unref(e);
         if (last_ref) {
-            _usage -= e->charge;
+            _sub_usage(e);
         } else if (e->in_cache && e->refs == 1) {
             // only exists in cache
             if (_usage > _capacity) {
@@ -248,8 +345,11 @@ void LRUCache::release(Cache::Handle* handle) {
                 _table.remove(e->key(), e->hash);
                 e->in_cache = false;
                 _unref(e);
-                _usage -= e->charge;
+                _sub_usage(e);
                 last_ref = true;
+            } else if (e->in_protected) {
+                _lru_append(&_protected, e);
+                _balance_protected();
             } else {
                 // put it to LRU free list
                 _lru_append(&_lru, e);
@@ -263,24 +363,33 @@ void LRUCache::release(Cache::Handle* handle) {
     }
 }
 
-void LRUCache::_evict_from_lru(size_t charge, std::vector<LRUHandle*>* deleted) {
-    LRUHandle* cur = &_lru;
-    // 1. evict normal cache entries
-    while (_usage + charge > _capacity && cur->next != &_lru) {
-        LRUHandle* old = cur->next;
-        if (old->priority == CachePriority::DURABLE) {
-            cur = cur->next;
-            continue;
+void LRUCache::_evict_from_lru(size_t charge, std::vector<LRUHandle*>* deleted, int64_t owner) {
+    // The entries reserved by the other owners are never evicted for |owner|.
+    // 1. evict normal cache entries, from probation segment first
+    for (LRUHandle* list : {&_lru, &_protected}) {
+        LRUHandle* cur = list;
+        while (_usage + charge > _capacity && cur->next != list) {
+            LRUHandle* old = cur->next;
+            if (old->priority == CachePriority::DURABLE || _is_reserved(old, owner)) {
+                cur = cur->next;
+                continue;
+            }
+            _evict_one_entry(old);
+            deleted->push_back(old);
         }
-        _evict_one_entry(old);
-        deleted->push_back(old);
     }
     // 2. evict durable cache entries if need
-    while (_usage + charge > _capacity && _lru.next != &_lru) {
-        LRUHandle* old = _lru.next;
-        DCHECK(old->priority == CachePriority::DURABLE);
-        _evict_one_entry(old);
-        deleted->push_back(old);
+    for (LRUHandle* list : {&_lru, &_protected}) {
+        LRUHandle* cur = list;
+        while (_usage + charge > _capacity && cur->next != list) {
+            LRUHandle* old = cur->next;
+            if (_is_reserved(old, owner)) {
+                cur = cur->next;
+                continue;
+            }
+            _evict_one_entry(old);
+            deleted->push_back(old);
+        }
     }
 }
 
@@ -291,11 +400,12 @@ void LRUCache::_evict_one_entry(LRUHandle* e) {
     _table.remove(e->key(), e->hash);
     e->in_cache = false;
     _unref(e);
-    _usage -= e->charge;
+    _sub_usage(e);
 }
 
 Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value, size_t charge,
-                                void (*deleter)(const CacheKey& key, void* value), CachePriority priority) {
+                                void (*deleter)(const CacheKey& key, void* value), CachePriority priority,
+                                int64_t owner) {
     auto* e = reinterpret_cast<LRUHandle*>(malloc(sizeof(LRUHandle) - 1 + key.size()));
     e->value = value;
     e->deleter = deleter;
@@ -305,7 +415,9 @@ Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value,
     e->refs = 2; // one for the returned handle, one for LRUCache.
     e->next = e->prev = nullptr;
     e->in_cache = true;
+    e->in_protected = false;
     e->priority = priority;
+    e->owner = owner;
     memcpy(e->key_data, key.data(), key.size());
     std::vector<LRUHandle*> last_ref_list;
     {
@@ -313,17 +425,21 @@ Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value,
 
         // Free the space following strict LRU policy until enough space
         // is freed or the lru list is empty
-        _evict_from_lru(charge, &last_ref_list);
+        _evict_owner_over_limit(owner, charge, &last_ref_list);
+        _evict_from_lru(charge, &last_ref_list, owner);
 
         // insert into the cache
         // note that the cache might get larger than its capacity if not enough
         // space was freed
         auto old = _table.insert(e);
         _usage += charge;
+        if (owner != kNoCacheOwner) {
+            _owners[owner].stats.usage += charge;
+        }
         if (old != nullptr) {
             old->in_cache = false;
             if (_unref(old)) {
-                _usage -= old->charge;
+                _sub_usage(old);
                 // old is on LRU because it's in cache and its reference count
                 // was just 1 (Unref returned 0)
                 _lru_remove(old);
@@ -350,7 +466,7 @@ void LRUCache::erase(const CacheKey& key, uint32_t hash) {
         if (e != nullptr) {
             last_ref = _unref(e);
             if (last_ref) {
-                _usage -= e->charge;
+                _sub_usage(e);
                 if (e->in_cache) {
                     // locate in free list
                     _lru_remove(e);
@@ -369,16 +485,18 @@ int LRUCache::prune() {
     std::vector<LRUHandle*> last_ref_list;
     {
         std::lock_guard l(_mutex);
-        while (_lru.next != &_lru) {
-            LRUHandle* old = _lru.next;
-            DCHECK(old->in_cache);
-            DCHECK(old->refs == 1); // LRU list contains elements which may be evicted
-            _lru_remove(old);
-            _table.remove(old->key(), old->hash);
-            old->in_cache = false;
-            _unref(old);
-            _usage -= old->charge;
-            last_ref_list.push_back(old);
+        for (LRUHandle* list : {&_lru, &_protected}) {
+            while (list->next != list) {
+                LRUHandle* old = list->next;
+                DCHECK(old->in_cache);
+                DCHECK(old->refs == 1); // LRU list contains elements which may be evicted
+                _lru_remove(old);
+                _table.remove(old->key(), old->hash);
+                old->in_cache = false;
+                _unref(old);
+                _sub_usage(old);
+                last_ref_list.push_back(old);
+            }
         }
     }
     for (auto entry : last_ref_list) {
@@ -395,10 +513,11 @@ uint32_t ShardedLRUCache::_shard(uint32_t hash) {
     return hash >> (32 - kNumShardBits);
 }
 
-ShardedLRUCache::ShardedLRUCache(size_t capacity) : _last_id(0), _capacity(capacity) {
+ShardedLRUCache::ShardedLRUCache(size_t capacity, double protected_ratio) : _last_id(0), _capacity(capacity) {
     const size_t per_shard = (_capacity + (kNumShards - 1)) / kNumShards;
     for (auto& _shard : _shards) {
         _shard.set_capacity(per_shard);
+        _shard.set_protected_ratio(protected_ratio);
     }
 }
 
@@ -427,14 +546,15 @@ bool ShardedLRUCache::adjust_capacity(int64_t delta, size_t min_capacity) {
 }
 
 Cache::Handle* ShardedLRUCache::insert(const CacheKey& key, void* value, size_t charge,
-                                       void (*deleter)(const CacheKey& key, void* value), CachePriority priority) {
+                                       void (*deleter)(const CacheKey& key, void* value), CachePriority priority,
+                                       int64_t owner) {
     const uint32_t hash = _hash_slice(key);
-    return _shards[_shard(hash)].insert(key, hash, value, charge, deleter, priority);
+    return _shards[_shard(hash)].insert(key, hash, value, charge, deleter, priority, owner);
 }
 
-Cache::Handle* ShardedLRUCache::lookup(const CacheKey& key) {
+Cache::Handle* ShardedLRUCache::lookup(const CacheKey& key, int64_t owner) {
     const uint32_t hash = _hash_slice(key);
-    return _shards[_shard(hash)].lookup(key, hash);
+    return _shards[_shard(hash)].lookup(key, hash, owner);
 }
 
 void ShardedLRUCache::release(Handle* handle) {
@@ -480,6 +600,23 @@ void ShardedLRUCache::prune() {
     VLOG(7) << "Successfully prune cache, clean " << num_prune << " entries.";
 }
 
+void ShardedLRUCache::set_owner_quota(int64_t owner, double reserved_ratio, double limit_ratio) {
+    for (auto& shard : _shards) {
+        shard.set_owner_quota(owner, reserved_ratio, limit_ratio);
+    }
+}
+
+CacheOwnerStats ShardedLRUCache::get_owner_stats(int64_t owner) {
+    CacheOwnerStats total;
+    for (auto& shard : _shards) {
+        auto stats = shard.get_owner_stats(owner);
+        total.usage += stats.usage;
+        total.lookup_count += stats.lookup_count;
+        total.hit_count += stats.hit_count;
+    }
+    return total;
+}
+
 size_t ShardedLRUCache::get_memory_usage() {
     return _get_stat(&LRUCache::get_usage);
 }
@@ -526,8 +663,8 @@ void ShardedLRUCache::get_cache_status(rapidjson::Document* document) {
     }
 }
 
-Cache* new_lru_cache(size_t capacity) {
-    return new ShardedLRUCache(capacity);
+Cache* new_lru_cache(size_t capacity, double protected_ratio) {
+    return new ShardedLRUCache(capacity, protected_ratio);
 }
 
 } // namespace starrocks
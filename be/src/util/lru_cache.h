@@ -11,6 +11,7 @@
 #include <mutex>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include "util/slice.h"
@@ -22,7 +23,10 @@ class CacheKey;
 
 // Create a new cache with a fixed size capacity.  This implementation
 // of Cache uses a least-recently-used eviction policy.
-extern Cache* new_lru_cache(size_t capacity);
+// If |protected_ratio| is in (0, 1), the cache is a segmented LRU: new entries are admitted to a probation
+// segment and only promoted to the protected segment, of at most |protected_ratio| of the capacity, when they
+// are hit again, so the entries touched only once, e.g. by a large scan, can not flush the hot entries.
+extern Cache* new_lru_cache(size_t capacity, double protected_ratio = 0);
 
 class CacheKey {
 public:
@@ -112,6 +116,15 @@ private:
 // The entry with smaller CachePriority will evict firstly
 enum class CachePriority { NORMAL = 0, DURABLE = 1 };
 
+// The owner of the entries inserted without owner, see `Cache::set_owner_quota`.
+static constexpr int64_t kNoCacheOwner = -1;
+
+struct CacheOwnerStats {
+    size_t usage = 0;
+    uint64_t lookup_count = 0;
+    uint64_t hit_count = 0;
+};
+
 class Cache {
 public:
     Cache() = default;
@@ -132,16 +145,20 @@ public:
     //
     // When the inserted entry is no longer needed, the key and
     // value will be passed to "deleter".
+    //
+    // The charge of the entry is accounted to "owner", and evicted under the quota of "owner".
     virtual Handle* insert(const CacheKey& key, void* value, size_t charge,
                            void (*deleter)(const CacheKey& key, void* value),
-                           CachePriority priority = CachePriority::NORMAL) = 0;
+                           CachePriority priority = CachePriority::NORMAL, int64_t owner = kNoCacheOwner) = 0;
 
     // If the cache has no mapping for "key", returns NULL.
     //
     // Else return a handle that corresponds to the mapping.  The caller
     // must call this->release(handle) when the returned mapping is no
     // longer needed.
-    virtual Handle* lookup(const CacheKey& key) = 0;
+    //
+    // The lookup and hit are also counted to the stats of "owner".
+    virtual Handle* lookup(const CacheKey& key, int64_t owner = kNoCacheOwner) = 0;
 
     // Release a mapping returned by a previous Lookup().
     // REQUIRES: handle must not have been released yet.
@@ -187,6 +204,16 @@ public:
     //  Decrease or increase cache capacity.
     virtual bool adjust_capacity(int64_t delta, size_t min_capacity = 0) = 0;
 
+    // Set the quota of "owner" as the ratios of the capacity, 0 means no quota.
+    // - The entries of "owner" are not evicted by the insertions of the other owners as long as the usage of
+    //   "owner" is within "reserved_ratio", and the reserved capacity not used by "owner" can be borrowed
+    //   by the others.
+    // - The usage of "owner" never exceeds "limit_ratio", the oldest entries of "owner" are evicted first
+    //   once exceeded.
+    virtual void set_owner_quota(int64_t owner, double reserved_ratio, double limit_ratio) = 0;
+
+    virtual CacheOwnerStats get_owner_stats(int64_t owner) = 0;
+
 private:
     Cache(const Cache&) = delete;
     const Cache& operator=(const Cache&) = delete;
@@ -202,10 +229,12 @@ typedef struct LRUHandle {
     LRUHandle* prev;
     size_t charge;
     size_t key_length;
-    bool in_cache; // Whether entry is in the cache.
+    bool in_cache;     // Whether entry is in the cache.
+    bool in_protected; // Whether entry is in the protected segment, only used by segmented LRU.
     uint32_t refs;
     uint32_t hash; // Hash of key(); used for fast sharding and comparisons
     CachePriority priority = CachePriority::NORMAL;
+    int64_t owner = kNoCacheOwner;
     char key_data[1]; // Beginning of key
 
     CacheKey key() const {
@@ -266,11 +295,15 @@ public:
     // Separate from constructor so caller can easily make an array of LRUCache
     void set_capacity(size_t capacity);
 
+    // Enable the segmented LRU if |ratio| is in (0, 1), see `new_lru_cache`.
+    // Must be called before any entry is inserted.
+    void set_protected_ratio(double ratio);
+
     // Like Cache methods, but with an extra "hash" parameter.
     Cache::Handle* insert(const CacheKey& key, uint32_t hash, void* value, size_t charge,
                           void (*deleter)(const CacheKey& key, void* value),
-                          CachePriority priority = CachePriority::NORMAL);
-    Cache::Handle* lookup(const CacheKey& key, uint32_t hash);
+                          CachePriority priority = CachePriority::NORMAL, int64_t owner = kNoCacheOwner);
+    Cache::Handle* lookup(const CacheKey& key, uint32_t hash, int64_t owner = kNoCacheOwner);
     void release(Cache::Handle* handle);
     void erase(const CacheKey& key, uint32_t hash);
     int prune();
@@ -280,15 +313,29 @@ public:
     size_t get_usage();
     size_t get_capacity();
 
+    void set_owner_quota(int64_t owner, double reserved_ratio, double limit_ratio);
+    CacheOwnerStats get_owner_stats(int64_t owner);
+
 private:
+    struct OwnerState {
+        double reserved_ratio = 0;
+        double limit_ratio = 0;
+        CacheOwnerStats stats;
+    };
+
     void _lru_remove(LRUHandle* e);
     void _lru_append(LRUHandle* list, LRUHandle* e);
     bool _unref(LRUHandle* e);
-    void _evict_from_lru(size_t charge, std::vector<LRUHandle*>* deleted);
+    void _evict_from_lru(size_t charge, std::vector<LRUHandle*>* deleted, int64_t owner = kNoCacheOwner);
+    void _evict_owner_over_limit(int64_t owner, size_t charge, std::vector<LRUHandle*>* deleted);
+    bool _is_reserved(const LRUHandle* e, int64_t owner) const;
     void _evict_one_entry(LRUHandle* e);
+    void _sub_usage(LRUHandle* e);
+    void _balance_protected();
 
     // Initialized before use.
     size_t _capacity{0};
+    double _protected_ratio{0};
 
     // _mutex protects the following state.
     std::mutex _mutex;
@@ -299,6 +346,15 @@ private:
     // Entries have refs==1 and in_cache==true.
     LRUHandle _lru;
 
+    // Dummy head of the protected segment of segmented LRU, ordered the same as _lru.
+    // _lru is the probation segment if segmented LRU is enabled.
+    LRUHandle _protected;
+    // The charge of the entries with in_protected==true, including the ones in use.
+    size_t _protected_usage{0};
+
+    // The owners inserted entries or set quota.
+    std::unordered_map<int64_t, OwnerState> _owners;
+
     HandleTable _table;
 
     uint64_t _lookup_count{0};
@@ -310,11 +366,11 @@ static const int kNumShards = 1 << kNumShardBits;
 
 class ShardedLRUCache : public Cache {
 public:
-    explicit ShardedLRUCache(size_t capacity);
+    explicit ShardedLRUCache(size_t capacity, double protected_ratio = 0);
     ~ShardedLRUCache() override = default;
     Handle* insert(const CacheKey& key, void* value, size_t charge, void (*deleter)(const CacheKey& key, void* value),
-                   CachePriority priority = CachePriority::NORMAL) override;
-    Handle* lookup(const CacheKey& key) override;
+                   CachePriority priority = CachePriority::NORMAL, int64_t owner = kNoCacheOwner) override;
+    Handle* lookup(const CacheKey& key, int64_t owner = kNoCacheOwner) override;
     void release(Handle* handle) override;
     void erase(const CacheKey& key) override;
     void* value(Handle* handle) override;
@@ -328,6 +384,8 @@ public:
     uint64_t get_lookup_count() override;
     uint64_t get_hit_count() override;
     bool adjust_capacity(int64_t delta, size_t min_capacity = 0) override;
+    void set_owner_quota(int64_t owner, double reserved_ratio, double limit_ratio) override;
+    CacheOwnerStats get_owner_stats(int64_t owner) override;
 
 private:
     static uint32_t _hash_slice(const CacheKey& s);
@@ -240,6 +240,75 @@ void MysqlRowBuffer::_push_string_normal(const char* str, size_t length) {
     _data.resize(pos - _data.data());
 }
 
+template <typename T>
+static constexpr size_t max_number_width() {
+    if constexpr (std::is_same_v<T, float>) {
+        return MAX_FLOAT_STR_LENGTH;
+    } else if constexpr (std::is_same_v<T, double>) {
+        return MAX_DOUBLE_STR_LENGTH;
+    } else if constexpr (sizeof(T) == 1) {
+        return MAX_TINYINT_WIDTH;
+    } else if constexpr (sizeof(T) == 2) {
+        return MAX_SMALLINT_WIDTH;
+    } else if constexpr (sizeof(T) == 4) {
+        return MAX_INT_WIDTH;
+    } else if constexpr (sizeof(T) == 8) {
+        return MAX_BIGINT_WIDTH;
+    } else {
+        return 40;
+    }
+}
+
+template <typename T>
+void MysqlRowBuffer::push_number_column(const T* data, const uint8_t* nulls, size_t n, std::vector<size_t>* offsets) {
+    static_assert(std::is_arithmetic_v<T> || std::is_same_v<T, __int128>);
+    DCHECK_EQ(0, _array_level);
+    // Reserve the space of the widest cells once, 1 for length, 1 for sign, other for digits.
+    char* pos = _resize_extra(n * (2 + max_number_width<T>()));
+    const char* base = _data.data();
+    for (size_t i = 0; i < n; i++) {
+        if (nulls != nullptr && nulls[i]) {
+            *pos++ = static_cast<char>(0xfb);
+        } else {
+            int length;
+            if constexpr (std::is_same_v<T, float>) {
+                length = f2s_buffered_n(data[i], pos + 1);
+            } else if constexpr (std::is_same_v<T, double>) {
+                length = d2s_buffered_n(data[i], pos + 1);
+            } else {
+                length = fmt::format_to(pos + 1, FMT_COMPILE("{}"), data[i]) - (pos + 1);
+            }
+            int1store(pos, length);
+            pos += 1 + length;
+        }
+        offsets->push_back(pos - base);
+    }
+    DCHECK(pos >= _data.data() && pos <= _data.data() + _data.size());
+    _data.resize(pos - base);
+}
+
+template <typename Offset>
+void MysqlRowBuffer::push_string_column(const uint8_t* bytes, const Offset* str_offsets, const uint8_t* nulls,
+                                        size_t n, std::vector<size_t>* offsets) {
+    DCHECK_EQ(0, _array_level);
+    // At most 9 bytes for the length of every string.
+    char* pos = _resize_extra(9 * n + (str_offsets[n] - str_offsets[0]));
+    const char* base = _data.data();
+    for (size_t i = 0; i < n; i++) {
+        if (nulls != nullptr && nulls[i]) {
+            *pos++ = static_cast<char>(0xfb);
+        } else {
+            const size_t length = str_offsets[i + 1] - str_offsets[i];
+            pos = reinterpret_cast<char*>(pack_vlen(reinterpret_cast<uint8_t*>(pos), length));
+            strings::memcpy_inlined(pos, bytes + str_offsets[i], length);
+            pos += length;
+        }
+        offsets->push_back(pos - base);
+    }
+    DCHECK(pos >= _data.data() && pos <= _data.data() + _data.size());
+    _data.resize(pos - base);
+}
+
 template void MysqlRowBuffer::push_number<int8_t>(int8_t);
 template void MysqlRowBuffer::push_number<int16_t>(int16_t);
 template void MysqlRowBuffer::push_number<int32_t>(int32_t);
@@ -252,6 +321,24 @@ template void MysqlRowBuffer::push_number<__int128>(__int128);
 template void MysqlRowBuffer::push_number<float>(float);
 template void MysqlRowBuffer::push_number<double>(double);
 
+template void MysqlRowBuffer::push_number_column<int8_t>(const int8_t*, const uint8_t*, size_t, std::vector<size_t>*);
+template void MysqlRowBuffer::push_number_column<int16_t>(const int16_t*, const uint8_t*, size_t,
+                                                          std::vector<size_t>*);
+template void MysqlRowBuffer::push_number_column<int32_t>(const int32_t*, const uint8_t*, size_t,
+                                                          std::vector<size_t>*);
+template void MysqlRowBuffer::push_number_column<int64_t>(const int64_t*, const uint8_t*, size_t,
+                                                          std::vector<size_t>*);
+template void MysqlRowBuffer::push_number_column<uint8_t>(const uint8_t*, const uint8_t*, size_t,
+                                                          std::vector<size_t>*);
+template void MysqlRowBuffer::push_number_column<__int128>(const __int128*, const uint8_t*, size_t,
+                                                           std::vector<size_t>*);
+template void MysqlRowBuffer::push_number_column<float>(const float*, const uint8_t*, size_t, std::vector<size_t>*);
+template void MysqlRowBuffer::push_number_column<double>(const double*, const uint8_t*, size_t, std::vector<size_t>*);
+template void MysqlRowBuffer::push_string_column<uint32_t>(const uint8_t*, const uint32_t*, const uint8_t*, size_t,
+                                                           std::vector<size_t>*);
+template void MysqlRowBuffer::push_string_column<uint64_t>(const uint8_t*, const uint64_t*, const uint8_t*, size_t,
+                                                           std::vector<size_t>*);
+
 } // namespace starrocks
 
 /* vim: set ts=4 sw=4 sts=4 tw=100 */
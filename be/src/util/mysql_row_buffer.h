@@ -34,6 +34,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "storage/uint24.h"
 #include "util/raw_container.h"
 #include "util/slice.h"
@@ -65,6 +67,17 @@ public:
     void push_number(uint24_t data) { push_number((uint32_t)data); }
     void push_decimal(const Slice& s);
 
+    // Column-at-a-time versions of push_number and push_string, which push the cells of |n| rows in one pass,
+    // the cell of row i is NULL if |nulls| is not nullptr and nulls[i] is set. The end offset of every cell in
+    // this buffer is appended to |offsets|. They produce the same bytes as pushing the cells one by one,
+    // and must not be used inside an array.
+    template <typename T>
+    void push_number_column(const T* data, const uint8_t* nulls, size_t n, std::vector<size_t>* offsets);
+    // The string of row i is bytes[str_offsets[i], str_offsets[i + 1]).
+    template <typename Offset>
+    void push_string_column(const uint8_t* bytes, const Offset* str_offsets, const uint8_t* nulls, size_t n,
+                            std::vector<size_t>* offsets);
+
     void begin_push_array() { _enter_scope('['); }
     void finish_push_array() { _leave_scope(']'); }
 
@@ -73,7 +86,7 @@ public:
 
     void separator(char c);
 
-    int length() const { return _data.size(); }
+    size_t length() const { return _data.size(); }
 
     // move content into |dst| and clear this buffer.
     void move_content(std::string* dst) {
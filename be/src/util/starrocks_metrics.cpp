@@ -64,6 +64,9 @@ StarRocksMetrics::StarRocksMetrics() : _metrics(_s_registry_name) {
     REGISTER_STARROCKS_METRIC(update_rowset_commit_apply_duration_us);
     REGISTER_STARROCKS_METRIC(update_primary_index_num);
     REGISTER_STARROCKS_METRIC(update_primary_index_bytes_total);
+    REGISTER_STARROCKS_METRIC(update_primary_index_preload_total);
+    REGISTER_STARROCKS_METRIC(update_primary_index_preload_finished);
+    REGISTER_STARROCKS_METRIC(update_primary_index_preload_failed);
     REGISTER_STARROCKS_METRIC(update_del_vector_num);
     REGISTER_STARROCKS_METRIC(update_del_vector_dels_num);
     REGISTER_STARROCKS_METRIC(update_del_vector_bytes_total);
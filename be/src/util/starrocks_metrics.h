@@ -169,6 +169,10 @@ public:
     METRIC_DEFINE_INT_COUNTER(update_rowset_commit_apply_duration_us, MetricUnit::MICROSECONDS);
     METRIC_DEFINE_UINT_GAUGE(update_primary_index_num, MetricUnit::OPERATIONS);
     METRIC_DEFINE_UINT_GAUGE(update_primary_index_bytes_total, MetricUnit::BYTES);
+    // number of the primary indexes to load in background after BE starts, and those finished or failed
+    METRIC_DEFINE_INT_COUNTER(update_primary_index_preload_total, MetricUnit::OPERATIONS);
+    METRIC_DEFINE_INT_COUNTER(update_primary_index_preload_finished, MetricUnit::OPERATIONS);
+    METRIC_DEFINE_INT_COUNTER(update_primary_index_preload_failed, MetricUnit::OPERATIONS);
     METRIC_DEFINE_UINT_GAUGE(update_del_vector_num, MetricUnit::OPERATIONS);
     METRIC_DEFINE_UINT_GAUGE(update_del_vector_dels_num, MetricUnit::OPERATIONS);
     METRIC_DEFINE_UINT_GAUGE(update_del_vector_bytes_total, MetricUnit::BYTES);
@@ -0,0 +1,44 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "util/timezone_transitions.h"
+
+namespace starrocks {
+
+TimezoneTransitions::TimezoneTransitions(const cctz::time_zone& ctz) {
+    // Start one day earlier, so the civil seconds near kMinSeconds see the transitions before it.
+    auto tp = cctz::time_point<cctz::seconds>(cctz::seconds(kMinSeconds - 86400));
+    _offsets.emplace_back(ctz.lookup(tp).offset);
+
+    cctz::time_zone::civil_transition transition;
+    while (ctz.next_transition(tp, &transition)) {
+        tp = ctz.lookup(transition.to).trans;
+        int64_t utc = tp.time_since_epoch().count();
+        if (utc >= kMaxSeconds) {
+            break;
+        }
+        int64_t before = _offsets.back();
+        int64_t after = ctz.lookup(tp).offset;
+        if (before == after) {
+            continue;
+        }
+        _utc_transitions.emplace_back(utc);
+        _local_starts.emplace_back(utc + std::min(before, after));
+        _local_transitions.emplace_back(utc + std::max(before, after));
+        _offsets.emplace_back(after);
+    }
+}
+
+} // namespace starrocks
@@ -0,0 +1,84 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "cctz/time_zone.h"
+
+namespace starrocks {
+
+// TimezoneTransitions precomputes the UTC offsets of a time zone in [kMinSeconds, kMaxSeconds), so the conversions
+// between the unix seconds and the civil seconds of the time zone are binary searches instead of cctz lookups.
+//
+// The civil seconds are the seconds since 1970-01-01 00:00:00 of the civil time, as if it were in UTC.
+class TimezoneTransitions {
+public:
+    // [1900-01-01 00:00:00, 2100-01-01 00:00:00) in UTC.
+    static constexpr int64_t kMinSeconds = -2208988800L;
+    static constexpr int64_t kMaxSeconds = 4102444800L;
+
+    explicit TimezoneTransitions(const cctz::time_zone& ctz);
+
+    // Whether the conversions of the unix seconds |seconds| are precomputed.
+    static bool contains(int64_t seconds) { return seconds >= kMinSeconds && seconds < kMaxSeconds; }
+
+    // The offset to add to the unix seconds |utc| to get the civil seconds, same as cctz::convert(time_point, ctz).
+    int64_t utc_offset(int64_t utc) const { return _offsets[_index(_utc_transitions, utc)]; }
+
+    // Convert the civil seconds |local| to the unix seconds, same as cctz::convert(civil_second, ctz), which
+    // returns the transition for the skipped civil times, and uses the offset before the transition for the
+    // repeated ones.
+    int64_t to_utc(int64_t local) const {
+        size_t i = _index(_local_transitions, local);
+        int64_t utc = local - _offsets[i];
+        return i < _utc_transitions.size() ? std::min(utc, _utc_transitions[i]) : utc;
+    }
+
+    // Whether there is no transition in the unix seconds [min, max].
+    bool same_utc_offset(int64_t min, int64_t max) const {
+        return _index(_utc_transitions, min) == _index(_utc_transitions, max);
+    }
+
+    // Whether the civil seconds [min, max] are neither skipped nor repeated and have the same offset, so the unix
+    // seconds of them are local - local_offset(min).
+    bool same_local_offset(int64_t min, int64_t max) const {
+        size_t i = _index(_local_transitions, min);
+        return i == _index(_local_transitions, max) && i == _index(_local_starts, min) && i == _index(_local_starts, max);
+    }
+
+    int64_t local_offset(int64_t local) const { return _offsets[_index(_local_transitions, local)]; }
+
+    size_t num_transitions() const { return _utc_transitions.size(); }
+
+private:
+    static size_t _index(const std::vector<int64_t>& transitions, int64_t seconds) {
+        return std::upper_bound(transitions.begin(), transitions.end(), seconds) - transitions.begin();
+    }
+
+    // The unix seconds of the transitions.
+    std::vector<int64_t> _utc_transitions;
+    // The civil seconds of the transitions under the smaller offset, the skipped or the repeated ones start from it.
+    std::vector<int64_t> _local_starts;
+    // The civil seconds from which the offset after the transition is used.
+    std::vector<int64_t> _local_transitions;
+    // _offsets[i] is the offset before the i-th transition, the last one is the offset after all of them.
+    std::vector<int64_t> _offsets;
+};
+
+} // namespace starrocks
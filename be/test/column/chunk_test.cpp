@@ -410,4 +410,95 @@ TEST_F(ChunkTest, test_reset_with_extra_data) {
     ASSERT_TRUE(!chunk1->has_extra_data());
 }
 
+// NOLINTNEXTLINE
+TEST_F(ChunkTest, test_expr_results) {
+    auto chunk = std::make_unique<Chunk>(make_columns(2), make_schema(2));
+    ASSERT_EQ(nullptr, chunk->get_expr_result(1));
+
+    // the aliases of the columns of the chunk aren't kept
+    chunk->set_expr_result(1, chunk->get_column_by_index(0));
+    ASSERT_EQ(nullptr, chunk->get_expr_result(1));
+
+    ColumnPtr result = make_column(10);
+    chunk->set_expr_result(1, result);
+    ASSERT_EQ(result, *chunk->get_expr_result(1));
+    // and neither the results of different sizes
+    chunk->set_expr_result(2, make_column(10, 50));
+    ASSERT_EQ(nullptr, chunk->get_expr_result(2));
+
+    // filtered along with the chunk
+    Buffer<uint8_t> selection(100, 0);
+    selection[3] = 1;
+    selection[7] = 1;
+    ASSERT_EQ(2, chunk->filter(selection));
+    ASSERT_EQ(result, *chunk->get_expr_result(1));
+    check_column(down_cast<const FixedLengthColumn<int32_t>*>(result.get()), {13, 17});
+
+    // dropped by the other modifications
+    chunk->update_column_by_index(make_column(0, 2), 0);
+    ASSERT_EQ(nullptr, chunk->get_expr_result(1));
+}
+
+// NOLINTNEXTLINE
+TEST_F(ChunkTest, test_clone_with_shared_columns) {
+    Chunk::SlotHashMap slot_map{{1, 0}, {2, 1}};
+    auto chunk = std::make_shared<Chunk>(make_columns(2), slot_map);
+    auto shared = chunk->clone_with_shared_columns();
+    ASSERT_EQ(chunk->get_column_by_slot_id(1).get(), shared->get_column_by_slot_id(1).get());
+    ASSERT_EQ(100, shared->num_rows());
+
+    // the shared columns are copied on write
+    Buffer<uint8_t> selection(100, 0);
+    selection[3] = 1;
+    ASSERT_EQ(1, shared->filter(selection));
+    ASSERT_EQ(100, chunk->num_rows());
+    check_column(down_cast<const FixedLengthColumn<int32_t>*>(chunk->get_column_by_slot_id(2).get()), 1);
+    check_column(down_cast<const FixedLengthColumn<int32_t>*>(shared->get_column_by_slot_id(2).get()), {4});
+
+    shared->append(*chunk, 0, 2);
+    ASSERT_EQ(3, shared->num_rows());
+    ASSERT_EQ(100, chunk->num_rows());
+
+    // the columns only shared inside a chunk are modified in place
+    ColumnPtr column = make_column(0);
+    Chunk::SlotHashMap alias_slot_map{{1, 0}, {2, 1}};
+    auto alias = std::make_shared<Chunk>(Columns{column, column}, alias_slot_map);
+    column.reset();
+    alias->append_safe(*chunk, 0, 1);
+    ASSERT_EQ(alias->get_column_by_index(0).get(), alias->get_column_by_index(1).get());
+    ASSERT_EQ(101, alias->num_rows());
+}
+
+// NOLINTNEXTLINE
+TEST_F(ChunkTest, test_selection) {
+    Chunk::SlotHashMap slot_map{{1, 0}, {2, 1}, {3, 2}};
+    auto chunk = std::make_shared<Chunk>(make_columns(3), slot_map);
+    ASSERT_FALSE(chunk->has_selection());
+    ASSERT_EQ(100, chunk->num_selected_rows());
+
+    auto selection = std::make_shared<Filter>(100, 0);
+    (*selection)[3] = 1;
+    (*selection)[7] = 1;
+    (*selection)[99] = 1;
+    chunk->set_selection(selection);
+    ASSERT_TRUE(chunk->has_selection());
+    ASSERT_EQ(100, chunk->num_rows());
+    ASSERT_EQ(3, chunk->num_selected_rows());
+
+    // only the given columns are compacted, the selection of the chunk is kept
+    auto compacted = chunk->materialize_selection({3, 1, 4});
+    ASSERT_EQ(2, compacted->num_columns());
+    ASSERT_EQ(3, compacted->num_rows());
+    ASSERT_FALSE(compacted->is_slot_exist(2));
+    check_column(down_cast<const FixedLengthColumn<int32_t>*>(compacted->get_column_by_slot_id(1).get()), {3, 7, 99});
+    check_column(down_cast<const FixedLengthColumn<int32_t>*>(compacted->get_column_by_slot_id(3).get()), {5, 9, 101});
+    ASSERT_TRUE(chunk->has_selection());
+
+    chunk->materialize_selection();
+    ASSERT_FALSE(chunk->has_selection());
+    ASSERT_EQ(3, chunk->num_rows());
+    ASSERT_EQ(3, chunk->num_selected_rows());
+    check_column(down_cast<const FixedLengthColumn<int32_t>*>(chunk->get_column_by_slot_id(2).get()), {4, 8, 100});
+}
+
 } // namespace starrocks
@@ -88,4 +88,29 @@ TEST_F(ColumnPoolTest, single_thread) {
     delete c4;
 }
 
+// NOLINTNEXTLINE
+TEST_F(ColumnPoolTest, size_class) {
+    auto small = get_column<Int32Column>();
+    small->reserve(100);
+    auto large = get_column<Int32Column>();
+    large->reserve(4096);
+    return_column<Int32Column>(large, config::vector_chunk_size * 2);
+    return_column<Int32Column>(small, config::vector_chunk_size * 2);
+
+    // The column of the requested size class is preferred even if it's not returned last.
+    auto c1 = get_column<Int32Column>(4096);
+    ASSERT_EQ(large, c1);
+    // Fall back to a smaller column if there is no larger one.
+    auto c2 = get_column<Int32Column>(4096);
+    ASSERT_EQ(small, c2);
+    return_column<Int32Column>(c1, config::vector_chunk_size * 2);
+
+    // Fall back to a larger column if there is no column of the requested size class.
+    auto c3 = get_column<Int32Column>(10);
+    ASSERT_EQ(large, c3);
+
+    delete c2;
+    delete c3;
+}
+
 } // namespace starrocks
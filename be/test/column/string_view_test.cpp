@@ -0,0 +1,58 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "column/string_view.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace starrocks {
+
+// NOLINTNEXTLINE
+TEST(StringViewTest, compare) {
+    // the strings sharing the prefixes, the zero bytes and the inline boundary
+    std::vector<std::string> strings{"",
+                                     "a",
+                                     std::string("a\0", 2),
+                                     std::string("a\0b", 3),
+                                     "ab",
+                                     "abcd",
+                                     "abcde",
+                                     "abcdefghijkl",
+                                     "abcdefghijklm",
+                                     "abcdefghijklmn",
+                                     "abce",
+                                     "b",
+                                     "\xff",
+                                     "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff"};
+    for (const auto& lhs : strings) {
+        StringView lhs_view = Slice(lhs);
+        ASSERT_EQ(lhs.size(), lhs_view.size());
+        ASSERT_EQ(lhs.size() <= StringView::kInlineSize, lhs_view.is_inline());
+        ASSERT_EQ(Slice(lhs), lhs_view.to_slice());
+        for (const auto& rhs : strings) {
+            StringView rhs_view = Slice(rhs);
+            int expected = Slice(lhs).compare(Slice(rhs));
+            int actual = lhs_view.compare(rhs_view);
+            ASSERT_EQ(expected < 0, actual < 0) << lhs << " vs " << rhs;
+            ASSERT_EQ(expected > 0, actual > 0) << lhs << " vs " << rhs;
+            ASSERT_EQ(lhs == rhs, lhs_view == rhs_view) << lhs << " vs " << rhs;
+        }
+    }
+}
+
+} // namespace starrocks
@@ -304,6 +304,16 @@ TEST_F(AggHashMapKeyNotFoundsTest, TestAllocateAndComputeNonFounds_NullInt32AggH
     TestAggHashMapKeyWithIntType<TestAggHashMapKey>(true);
 }
 
+TEST_F(AggHashMapKeyNotFoundsTest, TestAllocateAndComputeNonFounds_Int32DenseAggHashMapWithOneNumberKey) {
+    using TestAggHashMapKey = Int32DenseAggHashMapWithOneNumberKey<PhmapSeed1>;
+    TestAggHashMapKeyWithIntType<TestAggHashMapKey>(false);
+}
+
+TEST_F(AggHashMapKeyNotFoundsTest, TestAllocateAndComputeNonFounds_NullInt32DenseAggHashMapWithOneNumberKey) {
+    using TestAggHashMapKey = NullInt32DenseAggHashMapWithOneNumberKey<PhmapSeed1>;
+    TestAggHashMapKeyWithIntType<TestAggHashMapKey>(true);
+}
+
 TEST_F(AggHashMapKeyNotFoundsTest, TestAllocateAndComputeNonFounds_OneStringAggHashMap) {
     using TestAggHashMapKey = OneStringAggHashMap<PhmapSeed1>;
     TestAggHashMapKeyWithStringType<TestAggHashMapKey>(false);
@@ -325,4 +335,60 @@ TEST_F(AggHashMapKeyNotFoundsTest, TestAllocateAndComputeNonFounds_FixedSize16Sl
     TestAggHashMapKeyWithIntType<TestAggHashMapKey>(true);
 }
 
+TEST(HashMapTest, DenseRangeKeys) {
+    RuntimeProfile profile("dummy");
+    AggStatistics statis(&profile);
+    MemPool pool;
+    const int chunk_size = 8;
+    Int64DenseAggHashMapWithOneNumberKey<PhmapSeed1> key(chunk_size, &statis);
+    auto allocate_func = [&pool](auto& key) {
+        auto* state = pool.allocate(sizeof(int64_t));
+        memcpy(state, &key, sizeof(int64_t));
+        return state;
+    };
+
+    // the range is decided by the first keys, and the keys out of it are mapped by the fallback hash map.
+    std::vector<std::vector<int64_t>> chunks = {{100, 101, 102, 100, 103, 101, 100, 102},
+                                                {100, 1000000, -1000000, 104, 1000000, 101, -1000000, 105}};
+    std::set<int64_t> distinct_keys;
+    for (const auto& chunk_keys : chunks) {
+        Columns key_columns{Int64Column::create()};
+        for (int64_t k : chunk_keys) {
+            key_columns[0]->append_datum(Datum(k));
+            distinct_keys.insert(k);
+        }
+        Buffer<AggDataPtr> agg_states(chunk_size);
+        key.build_hash_map(chunk_size, key_columns, &pool, allocate_func, &agg_states);
+        for (int i = 0; i < chunk_size; i++) {
+            ASSERT_EQ(chunk_keys[i], *reinterpret_cast<int64_t*>(agg_states[i]));
+        }
+    }
+    ASSERT_TRUE(key.hash_map.range_inited());
+    ASSERT_EQ(Int64DenseAggHashMap<PhmapSeed1>::min_slots, key.hash_map.num_slots());
+    ASSERT_EQ(distinct_keys.size(), key.hash_map.size());
+    ASSERT_EQ(key.hash_map.end(), key.hash_map.find(99999));
+    ASSERT_NE(key.hash_map.end(), key.hash_map.find(1000000));
+    ASSERT_NE(key.hash_map.end(), key.hash_map.find(105));
+}
+
+TEST(HashMapTest, DenseRangeWideKeys) {
+    RuntimeProfile profile("dummy");
+    AggStatistics statis(&profile);
+    MemPool pool;
+    const int chunk_size = 4;
+    Int32DenseAggHashMapWithOneNumberKey<PhmapSeed1> key(chunk_size, &statis);
+    auto allocate_func = [&pool](auto& key) { return pool.allocate(16); };
+
+    Columns key_columns{Int32Column::create()};
+    for (int32_t k : {std::numeric_limits<int32_t>::min(), 0, std::numeric_limits<int32_t>::max(), 0}) {
+        key_columns[0]->append_datum(Datum(k));
+    }
+    Buffer<AggDataPtr> agg_states(chunk_size);
+    key.build_hash_map(chunk_size, key_columns, &pool, allocate_func, &agg_states);
+    // the range is too large, so all the keys are mapped by the fallback hash map.
+    ASSERT_EQ(0, key.hash_map.num_slots());
+    ASSERT_EQ(3, key.hash_map.size());
+    ASSERT_EQ(agg_states[1], agg_states[3]);
+}
+
 } // namespace starrocks
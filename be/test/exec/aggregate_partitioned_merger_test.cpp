@@ -0,0 +1,76 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/aggregate/aggregate_partitioned_merger.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+
+#include "column/chunk.h"
+#include "column/fixed_length_column.h"
+
+namespace starrocks {
+
+static ChunkPtr create_chunk(const std::vector<int32_t>& keys) {
+    auto key_column = Int32Column::create();
+    auto value_column = Int64Column::create();
+    for (int32_t key : keys) {
+        key_column->append(key);
+        value_column->append(key * 10L);
+    }
+    auto chunk = std::make_shared<Chunk>();
+    chunk->append_column(std::move(key_column), 0);
+    chunk->append_column(std::move(value_column), 1);
+    return chunk;
+}
+
+TEST(AggregatePartitionedMergerTest, PartitionByKeys) {
+    const size_t num_sinks = 3;
+    const size_t chunk_size = 16;
+    AggregatePartitionedMerger merger(num_sinks, 1, chunk_size);
+
+    std::vector<int32_t> keys;
+    for (int32_t i = 0; i < 100; i++) {
+        keys.emplace_back(i);
+    }
+    for (int32_t sink = 0; sink < num_sinks; sink++) {
+        merger.add_chunk(sink, create_chunk(keys));
+        ASSERT_FALSE(merger.all_sinks_finished());
+        merger.finish_sink();
+    }
+    ASSERT_TRUE(merger.all_sinks_finished());
+
+    // every key is added by all the sinks, and all the rows of the same key are in the same partition.
+    std::map<int32_t, size_t> key_partitions;
+    std::map<int32_t, size_t> key_counts;
+    for (size_t partition = 0; partition < num_sinks; partition++) {
+        for (const auto& chunk : merger.take_partition(partition)) {
+            ASSERT_LE(chunk->num_rows(), chunk_size);
+            for (size_t i = 0; i < chunk->num_rows(); i++) {
+                int32_t key = chunk->get_column_by_index(0)->get(i).get_int32();
+                ASSERT_EQ(key * 10L, chunk->get_column_by_index(1)->get(i).get_int64());
+                auto [iter, inserted] = key_partitions.emplace(key, partition);
+                ASSERT_EQ(partition, iter->second);
+                key_counts[key]++;
+            }
+        }
+    }
+    ASSERT_EQ(keys.size(), key_counts.size());
+    for (const auto& [key, count] : key_counts) {
+        ASSERT_EQ(num_sinks, count);
+    }
+}
+
+} // namespace starrocks
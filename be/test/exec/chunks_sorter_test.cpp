@@ -506,6 +506,45 @@ TEST_F(ChunksSorterTest, rank_topn) {
     clear_sort_exprs(sort_exprs);
 }
 
+// NOLINTNEXTLINE
+TEST_F(ChunksSorterTest, topn_runtime_filter_publish_early) {
+    std::vector<bool> is_asc{true};
+    std::vector<bool> is_null_first{true};
+    std::vector<ExprContext*> sort_exprs;
+    sort_exprs.push_back(new ExprContext(_expr_cust_key.get()));
+    ASSERT_OK(Expr::prepare(sort_exprs, _runtime_state.get()));
+    ASSERT_OK(Expr::open(sort_exprs, _runtime_state.get()));
+
+    ObjectPool* pool = _runtime_state->obj_pool();
+    ChunksSorterTopn sorter(_runtime_state.get(), &sort_exprs, &is_asc, &is_null_first, "", 0, 2,
+                            TTopNType::ROW_NUMBER, 1024);
+
+    // Nothing is sorted yet, but the sorter knows the runtime filter is required from now on.
+    ASSERT_EQ(nullptr, sorter.runtime_filters(pool));
+
+    // The first chunk already contains enough rows, so it is sorted without waiting for more chunks.
+    ASSERT_OK(sorter.update(_runtime_state.get(), ChunkPtr(_chunk_1->clone_unique().release())));
+    auto* runtime_filters = sorter.runtime_filters(pool);
+    ASSERT_NE(nullptr, runtime_filters);
+    ASSERT_EQ(1, runtime_filters->size());
+
+    // The boundary is unchanged, so the runtime filter isn't published again.
+    ASSERT_EQ(nullptr, sorter.runtime_filters(pool));
+    ASSERT_OK(sorter.update(_runtime_state.get(), ChunkPtr(_chunk_2->clone_unique().release())));
+    ASSERT_EQ(nullptr, sorter.runtime_filters(pool));
+
+    ASSERT_OK(sorter.update(_runtime_state.get(), ChunkPtr(_chunk_3->clone_unique().release())));
+    ASSERT_OK(sorter.done(_runtime_state.get()));
+    ASSERT_EQ(runtime_filters, sorter.runtime_filters(pool));
+
+    ChunkPtr page_1 = consume_page_from_sorter(sorter);
+    ASSERT_EQ(2, page_1->num_rows());
+    ASSERT_EQ(2, page_1->get(0).get(0).get_int32());
+    ASSERT_EQ(4, page_1->get(1).get(0).get_int32());
+
+    clear_sort_exprs(sort_exprs);
+}
+
 // NOLINTNEXTLINE
 TEST_F(ChunksSorterTest, full_sort_by_2_columns_null_first) {
     std::vector<bool> is_asc, is_null_first;
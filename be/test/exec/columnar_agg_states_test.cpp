@@ -0,0 +1,137 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/aggregate/columnar_agg_states.h"
+
+#include <gtest/gtest.h>
+
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+
+namespace starrocks {
+
+class ColumnarAggStatesTest : public ::testing::Test {
+protected:
+    static constexpr size_t kNumGroups = 4;
+    static constexpr size_t kNumRows = 16;
+
+    void SetUp() override {
+        for (auto& blob : _blobs) {
+            blob.resize(ColumnarAggStates::kHeaderSize);
+        }
+        // row i belongs to group i % kNumGroups
+        for (size_t i = 0; i < kNumRows; i++) {
+            _agg_states.emplace_back(_blobs[i % kNumGroups].data());
+        }
+    }
+
+    std::vector<uint32_t> group_ids(const std::vector<uint8_t>* selection = nullptr) {
+        std::vector<uint32_t> ids(kNumRows);
+        ColumnarAggStates::get_group_ids(_agg_states.data(), kNumRows,
+                                         selection == nullptr ? nullptr : selection->data(), ids.data());
+        return ids;
+    }
+
+    std::vector<uint8_t> _blobs[kNumGroups];
+    std::vector<AggDataPtr> _agg_states;
+};
+
+TEST_F(ColumnarAggStatesTest, UnsupportedFunctions) {
+    ASSERT_EQ(nullptr, ColumnarAggStates::create_state("avg", TYPE_INT, TYPE_DOUBLE, TYPE_VARCHAR, false));
+    ASSERT_EQ(nullptr, ColumnarAggStates::create_state("sum", TYPE_DECIMAL64, TYPE_DECIMAL128, TYPE_DECIMAL128, false));
+    ASSERT_EQ(nullptr, ColumnarAggStates::create_state("max", TYPE_VARCHAR, TYPE_VARCHAR, TYPE_VARCHAR, false));
+    ASSERT_EQ(nullptr, ColumnarAggStates::create_state("min", TYPE_INT, TYPE_BIGINT, TYPE_BIGINT, false));
+    ASSERT_NE(nullptr, ColumnarAggStates::create_state("count", TYPE_NULL, TYPE_BIGINT, TYPE_BIGINT, false));
+}
+
+TEST_F(ColumnarAggStatesTest, UpdateAndOutput) {
+    ColumnarAggStates states(3);
+    states.set_state(0, ColumnarAggStates::create_state("sum", TYPE_INT, TYPE_BIGINT, TYPE_BIGINT, true));
+    states.set_state(1, ColumnarAggStates::create_state("count", TYPE_INT, TYPE_BIGINT, TYPE_BIGINT, false));
+    states.set_state(2, ColumnarAggStates::create_state("max", TYPE_DOUBLE, TYPE_DOUBLE, TYPE_DOUBLE, false));
+    ASSERT_FALSE(states.empty());
+    for (auto& blob : _blobs) {
+        states.add_group(blob.data());
+    }
+
+    // the rows of the last group are all null
+    auto data_column = Int32Column::create();
+    auto null_column = NullColumn::create();
+    auto double_column = DoubleColumn::create();
+    for (size_t i = 0; i < kNumRows; i++) {
+        data_column->append(i);
+        null_column->append(i % kNumGroups == kNumGroups - 1);
+        double_column->append(-static_cast<double>(i));
+    }
+    auto nullable_column = NullableColumn::create(std::move(data_column), std::move(null_column));
+
+    auto ids = group_ids();
+    states.state(0)->update(nullable_column.get(), ids.data(), kNumRows, nullptr);
+    states.state(1)->update(nullable_column.get(), ids.data(), kNumRows, nullptr);
+    states.state(2)->update(double_column.get(), ids.data(), kNumRows, nullptr);
+
+    auto sum_result = NullableColumn::create(Int64Column::create(), NullColumn::create());
+    auto count_result = Int64Column::create();
+    auto max_result = DoubleColumn::create();
+    states.state(0)->output_range(0, kNumGroups, sum_result.get());
+    states.state(1)->output(ids.data(), kNumGroups, count_result.get());
+    states.state(2)->output_range(0, kNumGroups, max_result.get());
+    for (size_t group = 0; group < kNumGroups; group++) {
+        if (group == kNumGroups - 1) {
+            ASSERT_TRUE(sum_result->is_null(group));
+            ASSERT_EQ(0, count_result->get_data()[group]);
+        } else {
+            ASSERT_EQ(4 * group + 24, sum_result->get(group).get_int64());
+            ASSERT_EQ(4, count_result->get_data()[group]);
+        }
+        ASSERT_EQ(-static_cast<double>(group), max_result->get_data()[group]);
+    }
+    ASSERT_GT(states.memory_usage(), 0);
+
+    states.reset();
+    ASSERT_EQ(0, states.memory_usage());
+}
+
+TEST_F(ColumnarAggStatesTest, MergeSelectively) {
+    ColumnarAggStates states(2);
+    states.set_state(0, ColumnarAggStates::create_state("count", TYPE_NULL, TYPE_BIGINT, TYPE_BIGINT, false));
+    states.set_state(1, ColumnarAggStates::create_state("min", TYPE_BIGINT, TYPE_BIGINT, TYPE_BIGINT, false));
+    for (auto& blob : _blobs) {
+        states.add_group(blob.data());
+    }
+
+    // the odd rows are not selected
+    std::vector<uint8_t> selection(kNumRows);
+    auto column = Int64Column::create();
+    for (size_t i = 0; i < kNumRows; i++) {
+        selection[i] = i % 2;
+        column->append(100 - i);
+    }
+    auto ids = group_ids(&selection);
+    states.state(0)->merge(column.get(), ids.data(), kNumRows, selection.data());
+    states.state(1)->merge(column.get(), ids.data(), kNumRows, selection.data());
+
+    auto count_result = Int64Column::create();
+    auto min_result = Int64Column::create();
+    uint32_t group_ids[] = {2, 0};
+    states.state(0)->output(group_ids, 2, count_result.get());
+    states.state(1)->output(group_ids, 2, min_result.get());
+    // group 0 merges the rows 0, 4, 8, 12, and group 2 merges the rows 2, 6, 10, 14
+    ASSERT_EQ(98 + 94 + 90 + 86, count_result->get_data()[0]);
+    ASSERT_EQ(100 + 96 + 92 + 88, count_result->get_data()[1]);
+    ASSERT_EQ(86, min_result->get_data()[0]);
+    ASSERT_EQ(88, min_result->get_data()[1]);
+}
+
+} // namespace starrocks
@@ -211,6 +211,33 @@ TEST_F(HdfsScannerTest, TestParquetGetNext) {
     scanner->close(_runtime_state);
 }
 
+TEST_F(HdfsScannerTest, TestParquetGetNextFromFileContents) {
+    auto scanner = std::make_shared<HdfsParquetScanner>();
+
+    auto* range = _create_scan_range(default_parquet_file, 4, 1024);
+    auto* tuple_desc = _create_tuple_desc(default_parquet_descs);
+    auto* param = _create_param(default_parquet_file, range, tuple_desc);
+
+    // the prefetched contents are read instead of the file.
+    ASSIGN_OR_ABORT(auto file, FileSystem::Default()->new_random_access_file(default_parquet_file));
+    auto contents = std::make_shared<std::string>(range->file_length, '\0');
+    ASSERT_OK(file->read_at_fully(0, contents->data(), contents->size()));
+    param->file_contents = contents;
+    param->fs = nullptr;
+
+    ASSERT_OK(scanner->init(_runtime_state, *param));
+    ASSERT_OK(scanner->open(_runtime_state));
+
+    ChunkPtr chunk = ChunkHelper::new_chunk(*tuple_desc, 0);
+    ASSERT_OK(scanner->get_next(_runtime_state, &chunk));
+    ASSERT_EQ(chunk->num_rows(), 4);
+
+    Status status = scanner->get_next(_runtime_state, &chunk);
+    ASSERT_TRUE(status.is_end_of_file());
+
+    scanner->close(_runtime_state);
+}
+
 // ========================= ORC SCANNER ============================
 
 static TTypeDesc create_primitive_type_desc(TPrimitiveType::type type) {
@@ -1081,6 +1108,8 @@ TEST_F(HdfsScannerTest, TestOrcLazyLoad) {
 
     EXPECT_EQ("[3, {Cc1:'hello'}]", chunk->debug_row(0));
     EXPECT_EQ("[4, {Cc1:'World'}]", chunk->debug_row(1));
+    // the first 2 rows of c1 are skipped
+    EXPECT_EQ(2, scanner->stats().late_materialize_skip_rows);
 
     status = scanner->get_next(_runtime_state, &chunk);
     // Should be end of file in next read.
@@ -1089,6 +1118,58 @@ TEST_F(HdfsScannerTest, TestOrcLazyLoad) {
     scanner->close(_runtime_state);
 }
 
+TEST_F(HdfsScannerTest, TestOrcLazyLoadSelectedRange) {
+    static const std::string input_orc_file = "./be/test/exec/test_data/orc_scanner/orc_test_struct_basic.orc";
+
+    SlotDesc c0{"c0", TypeDescriptor::from_logical_type(LogicalType::TYPE_INT)};
+    SlotDesc c1{"c1", TypeDescriptor::from_logical_type(LogicalType::TYPE_STRUCT)};
+    c1.type.children.push_back(TypeDescriptor::from_logical_type(LogicalType::TYPE_VARCHAR));
+    c1.type.field_names.emplace_back("Cc1");
+
+    SlotDesc slot_descs[] = {c0, c1, {""}};
+
+    auto scanner = std::make_shared<HdfsOrcScanner>();
+
+    auto* range = _create_scan_range(input_orc_file, 0, 0);
+    auto* tuple_desc = _create_tuple_desc(slot_descs);
+    auto* param = _create_param(input_orc_file, range, tuple_desc);
+
+    // c0 != 1 and c0 != 4
+    // so only the 2nd and 3rd rows of c1 are decoded.
+    for (int v : {1, 4}) {
+        std::vector<TExprNode> nodes;
+        TExprNode lit_node = create_int_literal_node(TPrimitiveType::INT, v);
+        push_binary_pred_texpr_node(nodes, TExprOpcode::NE, tuple_desc->slots()[0], TPrimitiveType::INT, lit_node);
+        ExprContext* ctx = create_expr_context(&_pool, nodes);
+        param->conjunct_ctxs_by_slot[0].push_back(ctx);
+    }
+
+    for (auto& it : param->conjunct_ctxs_by_slot) {
+        Expr::prepare(it.second, _runtime_state);
+        Expr::open(it.second, _runtime_state);
+    }
+
+    Status status = scanner->init(_runtime_state, *param);
+    EXPECT_TRUE(status.ok());
+
+    status = scanner->open(_runtime_state);
+    EXPECT_TRUE(status.ok());
+
+    ChunkPtr chunk = ChunkHelper::new_chunk(*tuple_desc, 0);
+    status = scanner->get_next(_runtime_state, &chunk);
+    EXPECT_TRUE(status.ok());
+
+    EXPECT_EQ(2, chunk->num_rows());
+    EXPECT_EQ("[2, {Cc1:'Cruise'}]", chunk->debug_row(0));
+    EXPECT_EQ("[3, {Cc1:'hello'}]", chunk->debug_row(1));
+    EXPECT_EQ(2, scanner->stats().late_materialize_skip_rows);
+
+    status = scanner->get_next(_runtime_state, &chunk);
+    EXPECT_TRUE(status.is_end_of_file());
+
+    scanner->close(_runtime_state);
+}
+
 // =============================================================================
 
 /*
@@ -16,9 +16,12 @@
 
 #include <gtest/gtest.h>
 
+#include "exec/join_hash_table_cache.h"
+#include "exprs/column_ref.h"
 #include "runtime/descriptor_helper.h"
 #include "runtime/exec_env.h"
 #include "runtime/mem_tracker.h"
+#include "testutil/assert.h"
 
 namespace starrocks {
 class JoinHashMapTest : public ::testing::Test {
@@ -70,9 +73,10 @@ protected:
     static void check_probe_state(const JoinHashTableItems& table_items, const HashTableProbeState& probe_state,
                                   JoinMatchFlag match_flag, uint32_t step, uint32_t match_count,
                                   uint32_t probe_row_count, bool has_null_build_tuple);
-    static void check_build_index(const Buffer<uint32_t>& first, const Buffer<uint32_t>& next, uint32_t row_count);
-    static void check_build_index(const Buffer<uint8_t>& nulls, const Buffer<uint32_t>& first,
-                                  const Buffer<uint32_t>& next, uint32_t row_count);
+    static void check_build_index(const HugePageBuffer<uint32_t>& first, const HugePageBuffer<uint32_t>& next,
+                                  uint32_t row_count);
+    static void check_build_index(const Buffer<uint8_t>& nulls, const HugePageBuffer<uint32_t>& first,
+                                  const HugePageBuffer<uint32_t>& next, uint32_t row_count);
     static void check_build_slice(const Buffer<Slice>& slices, uint32_t row_count);
     static void check_build_slice(const Buffer<uint8_t>& nulls, const Buffer<Slice>& slices, uint32_t row_count);
     static void check_build_column(const ColumnPtr& build_column, uint32_t row_count);
@@ -373,7 +377,7 @@ void JoinHashMapTest::check_build_column(const ColumnPtr& build_column, uint32_t
     }
 }
 
-void JoinHashMapTest::check_build_index(const Buffer<uint32_t>& first, const Buffer<uint32_t>& next,
+void JoinHashMapTest::check_build_index(const HugePageBuffer<uint32_t>& first, const HugePageBuffer<uint32_t>& next,
                                         uint32_t row_count) {
     ASSERT_EQ(first.size(), JoinHashMapHelper::calc_bucket_size(row_count));
     ASSERT_EQ(next.size(), row_count + 1);
@@ -398,8 +402,8 @@ void JoinHashMapTest::check_build_index(const Buffer<uint32_t>& first, const Buf
     }
 }
 
-void JoinHashMapTest::check_build_index(const Buffer<uint8_t>& nulls, const Buffer<uint32_t>& first,
-                                        const Buffer<uint32_t>& next, uint32_t row_count) {
+void JoinHashMapTest::check_build_index(const Buffer<uint8_t>& nulls, const HugePageBuffer<uint32_t>& first,
+                                        const HugePageBuffer<uint32_t>& next, uint32_t row_count) {
     ASSERT_EQ(first.size(), JoinHashMapHelper::calc_bucket_size(row_count));
     ASSERT_EQ(next.size(), row_count + 1);
     ASSERT_EQ(next[0], 0);
@@ -1095,6 +1099,69 @@ TEST_F(JoinHashMapTest, DirectMappingJoinBuildProbeFunc) {
     ASSERT_TRUE(result_data == check_data);
 }
 
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, DenseRangeDirectMappingJoinBuildProbeFunc) {
+    auto runtime_state = create_runtime_state();
+    TDescriptorTableBuilder row_desc_builder;
+    add_tuple_descriptor(&row_desc_builder, LogicalType::TYPE_BIGINT, false, 1);
+    add_tuple_descriptor(&row_desc_builder, LogicalType::TYPE_BIGINT, false, 1);
+
+    auto row_desc = create_row_desc(runtime_state.get(), _object_pool, &row_desc_builder, false);
+    auto probe_row_desc = create_probe_desc(runtime_state.get(), _object_pool, &row_desc_builder, false);
+    auto build_row_desc = create_build_desc(runtime_state.get(), _object_pool, &row_desc_builder, false);
+
+    auto bigint_type = TypeDescriptor::from_logical_type(TYPE_BIGINT);
+    HashTableParam param;
+    param.need_create_tuple_columns = false;
+    param.with_other_conjunct = false;
+    param.join_type = TJoinOp::INNER_JOIN;
+    param.row_desc = row_desc.get();
+    param.probe_row_desc = probe_row_desc.get();
+    param.build_row_desc = build_row_desc.get();
+    param.output_slots.emplace(1);
+    param.join_keys.emplace_back(JoinKeyDesc{&bigint_type, false, nullptr});
+    param.search_ht_timer = ADD_TIMER(_runtime_profile, "search_ht");
+    param.output_build_column_timer = ADD_TIMER(_runtime_profile, "output_build_column");
+    param.output_probe_column_timer = ADD_TIMER(_runtime_profile, "output_probe_column");
+    param.output_build_column_timer = ADD_TIMER(_runtime_profile, "output_tuple_column");
+
+    JoinHashTable ht;
+
+    // build chunk, the range of the keys is 9, within 2 times of the row count
+    auto build_chunk = std::make_shared<Chunk>();
+    auto build_column = Int64Column::create();
+    down_cast<Int64Column*>(build_column.get())->append({100, 102, 103, 103, 105, 107, 108});
+    build_chunk->append_column(build_column, 1);
+
+    // probe chunk
+    auto probe_chunk = std::make_shared<Chunk>();
+    auto probe_column = Int64Column::create();
+    down_cast<Int64Column*>(probe_column.get())
+            ->append({std::numeric_limits<int64_t>::lowest(), 99, 100, 103, 104, 108, 109,
+                      std::numeric_limits<int64_t>::max()});
+    probe_chunk->append_column(probe_column, 0);
+    Columns probe_key_columns = {probe_column};
+
+    // result chunk
+    ChunkPtr result_chunk = std::make_shared<Chunk>();
+    bool eos = false;
+
+    // build and probe
+    ht.create(param);
+    Columns key_columns{build_chunk->columns()[0]};
+    ht.append_chunk(_runtime_state.get(), build_chunk, key_columns);
+    ASSERT_OK(ht.build(_runtime_state.get()));
+    ASSERT_EQ(ht.get_bucket_size(), 9);
+    ASSERT_OK(ht.probe(_runtime_state.get(), probe_key_columns, &probe_chunk, &result_chunk, &eos));
+
+    // check
+    ASSERT_EQ(result_chunk->columns().size(), 2);
+    auto result_data = down_cast<Int64Column*>(result_chunk->get_column_by_slot_id(1).get())->get_data();
+    std::sort(result_data.begin(), result_data.end());
+    Buffer<int64_t> check_data = {100, 103, 103, 108};
+    ASSERT_TRUE(result_data == check_data);
+}
+
 // NOLINTNEXTLINE
 TEST_F(JoinHashMapTest, DirectMappingJoinBuildProbeFuncNullable) {
     auto runtime_state = create_runtime_state();
@@ -1805,6 +1872,146 @@ TEST_F(JoinHashMapTest, OneKeyJoinHashTable) {
     hash_table.close();
 }
 
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, AttachCachedBuildData) {
+    auto runtime_profile = create_runtime_profile();
+    auto runtime_state = create_runtime_state();
+    std::shared_ptr<ObjectPool> object_pool = std::make_shared<ObjectPool>();
+    config::vector_chunk_size = 4096;
+
+    TDescriptorTableBuilder row_desc_builder;
+    add_tuple_descriptor(&row_desc_builder, LogicalType::TYPE_INT, false);
+    add_tuple_descriptor(&row_desc_builder, LogicalType::TYPE_INT, false);
+
+    std::shared_ptr<RowDescriptor> row_desc =
+            create_row_desc(runtime_state.get(), object_pool, &row_desc_builder, false);
+    std::shared_ptr<RowDescriptor> probe_row_desc =
+            create_probe_desc(runtime_state.get(), object_pool, &row_desc_builder, false);
+    std::shared_ptr<RowDescriptor> build_row_desc =
+            create_build_desc(runtime_state.get(), object_pool, &row_desc_builder, false);
+
+    HashTableParam param;
+    param.with_other_conjunct = false;
+    param.join_type = TJoinOp::INNER_JOIN;
+    param.row_desc = row_desc.get();
+    param.join_keys.emplace_back(JoinKeyDesc{&_int_type, false, nullptr});
+    param.probe_row_desc = probe_row_desc.get();
+    param.build_row_desc = build_row_desc.get();
+    param.search_ht_timer = ADD_TIMER(runtime_profile, "SearchHashTableTime");
+    param.output_build_column_timer = ADD_TIMER(runtime_profile, "OutputBuildColumnTime");
+    param.output_probe_column_timer = ADD_TIMER(runtime_profile, "OutputProbeColumnTime");
+    param.output_tuple_column_timer = ADD_TIMER(runtime_profile, "OutputTupleColumnTime");
+
+    JoinHashTableCache cache(64 * 1024 * 1024);
+    {
+        JoinHashTable hash_table;
+        hash_table.create(param);
+        auto build_chunk = create_int32_build_chunk(10, false);
+        Columns build_keys_column{build_chunk->columns()[0]};
+        hash_table.append_chunk(runtime_state.get(), build_chunk, build_keys_column);
+        ASSERT_OK(hash_table.build(runtime_state.get()));
+        cache.populate("digest", hash_table.build_data(), hash_table.mem_usage());
+        hash_table.close();
+    }
+    ASSERT_EQ(cache.lookup("other_digest"), nullptr);
+    auto build_data = cache.lookup("digest");
+    ASSERT_NE(build_data, nullptr);
+
+    JoinHashTable hash_table;
+    hash_table.create(param);
+    ASSERT_TRUE(hash_table.is_compatible_build_data(*build_data));
+    ASSERT_OK(hash_table.attach_build_data(runtime_state.get(), std::move(build_data)));
+    ASSERT_EQ(hash_table.get_row_count(), 10);
+
+    auto probe_chunk = create_int32_probe_chunk(5, 1, false);
+    Columns probe_key_columns;
+    probe_key_columns.emplace_back(probe_chunk->columns()[0]);
+    ChunkPtr result_chunk = std::make_shared<Chunk>();
+    bool eos = false;
+    ASSERT_OK(hash_table.probe(runtime_state.get(), probe_key_columns, &probe_chunk, &result_chunk, &eos));
+
+    ASSERT_EQ(result_chunk->num_columns(), 6);
+    check_int32_column(result_chunk->get_column_by_slot_id(0), 5, 1);
+    check_int32_column(result_chunk->get_column_by_slot_id(3), 5, 1);
+    check_int32_column(result_chunk->get_column_by_slot_id(5), 5, 21);
+
+    hash_table.close();
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, KeyOnlyBuildForLeftSemiJoin) {
+    auto runtime_profile = create_runtime_profile();
+    auto runtime_state = create_runtime_state();
+    std::shared_ptr<ObjectPool> object_pool = std::make_shared<ObjectPool>();
+    config::vector_chunk_size = 4096;
+
+    TDescriptorTableBuilder row_desc_builder;
+    add_tuple_descriptor(&row_desc_builder, LogicalType::TYPE_INT, false);
+    add_tuple_descriptor(&row_desc_builder, LogicalType::TYPE_INT, false);
+
+    std::shared_ptr<RowDescriptor> row_desc =
+            create_row_desc(runtime_state.get(), object_pool, &row_desc_builder, false);
+    std::shared_ptr<RowDescriptor> probe_row_desc =
+            create_probe_desc(runtime_state.get(), object_pool, &row_desc_builder, false);
+    std::shared_ptr<RowDescriptor> build_row_desc =
+            create_build_desc(runtime_state.get(), object_pool, &row_desc_builder, false);
+
+    ColumnRef key_ref(_int_type, 3);
+    HashTableParam param;
+    param.with_other_conjunct = false;
+    param.join_type = TJoinOp::LEFT_SEMI_JOIN;
+    param.key_only_build = true;
+    param.row_desc = row_desc.get();
+    param.join_keys.emplace_back(JoinKeyDesc{&_int_type, false, &key_ref});
+    param.probe_row_desc = probe_row_desc.get();
+    param.build_row_desc = build_row_desc.get();
+    param.search_ht_timer = ADD_TIMER(runtime_profile, "SearchHashTableTime");
+    param.output_build_column_timer = ADD_TIMER(runtime_profile, "OutputBuildColumnTime");
+    param.output_probe_column_timer = ADD_TIMER(runtime_profile, "OutputProbeColumnTime");
+    param.output_tuple_column_timer = ADD_TIMER(runtime_profile, "OutputTupleColumnTime");
+
+    JoinHashTable hash_table;
+    hash_table.create(param);
+
+    // duplicated build keys
+    auto build_chunk = std::make_shared<Chunk>();
+    auto build_key_column = Int32Column::create();
+    down_cast<Int32Column*>(build_key_column.get())->append({1, 1, 2, 2, 2, 3});
+    build_chunk->append_column(build_key_column, 3);
+    build_chunk->append_column(create_int32_column(6, 10), 4);
+    build_chunk->append_column(create_int32_column(6, 20), 5);
+    Columns build_keys_column{build_key_column};
+    hash_table.append_chunk(runtime_state.get(), build_chunk, build_keys_column);
+    ASSERT_OK(hash_table.build(runtime_state.get()));
+
+    // only the key column and the placeholder rows of the other columns are kept
+    ASSERT_EQ(hash_table.get_row_count(), 6);
+    const auto& ht_build_chunk = hash_table.get_build_chunk();
+    ASSERT_EQ(ht_build_chunk->get_column_by_slot_id(3)->size(), 7);
+    ASSERT_EQ(ht_build_chunk->get_column_by_slot_id(4)->size(), 1);
+    ASSERT_EQ(ht_build_chunk->get_column_by_slot_id(5)->size(), 1);
+
+    auto probe_chunk = create_int32_probe_chunk(5, 1, false);
+    Columns probe_key_columns{probe_chunk->columns()[0]};
+    ChunkPtr result_chunk = std::make_shared<Chunk>();
+    bool eos = false;
+    ASSERT_OK(hash_table.probe(runtime_state.get(), probe_key_columns, &probe_chunk, &result_chunk, &eos));
+
+    ASSERT_EQ(result_chunk->num_rows(), 3);
+    check_int32_column(result_chunk->get_column_by_slot_id(0), 3, 1);
+    check_int32_column(result_chunk->get_column_by_slot_id(2), 3, 21);
+
+    // the key only build data can't be attached to the joins needing the build rows
+    JoinHashTable inner_table;
+    param.join_type = TJoinOp::INNER_JOIN;
+    param.key_only_build = false;
+    inner_table.create(param);
+    ASSERT_FALSE(inner_table.is_compatible_build_data(*hash_table.build_data()));
+
+    inner_table.close();
+    hash_table.close();
+}
+
 // NOLINTNEXTLINE
 TEST_F(JoinHashMapTest, OneNullableKeyJoinHashTable) {
     auto runtime_profile = create_runtime_profile();
@@ -2108,6 +2315,46 @@ TEST_F(JoinHashMapTest, FixedSizeJoinBuildFuncForPartialNullableColumn) {
     check_build_column(nulls, table_items.build_key_column, build_row_count);
 }
 
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, FixedSizeJoinBuildFuncRadixBuild) {
+    uint32_t build_row_count = 9000;
+    uint32_t probe_row_count = 10;
+    auto nulls = create_bools(build_row_count, 2);
+
+    auto build = [&](int64_t sub_table_bytes, JoinHashTableItems* table_items) {
+        config::join_hash_table_radix_build_sub_table_bytes = sub_table_bytes;
+        HashTableProbeState probe_state;
+        prepare_table_items(table_items, build_row_count);
+        prepare_probe_state(&probe_state, probe_row_count);
+
+        auto column_1 = create_nullable_column(TYPE_INT);
+        column_1->append_datum(0);
+        column_1->append(*create_nullable_column(TYPE_INT, nulls, 0, build_row_count));
+        table_items->key_columns.emplace_back(column_1);
+        table_items->join_keys.emplace_back(JoinKeyDesc{&_int_type, false, nullptr});
+
+        auto column_2 = create_column(TYPE_INT);
+        column_2->append_default();
+        column_2->append(*create_column(TYPE_INT, 0, build_row_count), 0, build_row_count);
+        table_items->key_columns.emplace_back(column_2);
+        table_items->join_keys.emplace_back(JoinKeyDesc{&_int_type, false, nullptr});
+
+        FixedSizeJoinBuildFunc<TYPE_BIGINT>::prepare(_runtime_state.get(), table_items);
+        FixedSizeJoinBuildFunc<TYPE_BIGINT>::construct_hash_table(_runtime_state.get(), table_items, &probe_state);
+    };
+
+    const int64_t origin_sub_table_bytes = config::join_hash_table_radix_build_sub_table_bytes;
+    JoinHashTableItems direct_items;
+    build(0, &direct_items);
+    JoinHashTableItems radix_items;
+    build(1024, &radix_items);
+    config::join_hash_table_radix_build_sub_table_bytes = origin_sub_table_bytes;
+
+    ASSERT_GT(JoinHashMapHelper::calc_radix_bits(radix_items.bucket_size), 0);
+    ASSERT_EQ(direct_items.first, radix_items.first);
+    ASSERT_EQ(direct_items.next, radix_items.next);
+}
+
 // NOLINTNEXTLINE
 TEST_F(JoinHashMapTest, SerializedJoinBuildFuncForNotNullableColumn) {
     JoinHashTableItems table_items;
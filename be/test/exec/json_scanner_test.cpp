@@ -581,6 +581,41 @@ TEST_F(JsonScannerTest, test_ndjson) {
     EXPECT_EQ("['v5', 'server', NULL, NULL]", chunk->debug_row(4));
 }
 
+TEST_F(JsonScannerTest, test_ndjson_changing_keys) {
+    std::vector<TypeDescriptor> types;
+    types.emplace_back(TypeDescriptor::create_varchar_type(20));
+    types.emplace_back(TYPE_INT);
+    types.emplace_back(TypeDescriptor::create_varchar_type(20));
+
+    std::vector<TBrokerRangeDesc> ranges;
+    TBrokerRangeDesc range;
+    range.format_type = TFileFormatType::FORMAT_JSON;
+    range.strip_outer_array = false;
+    range.__isset.strip_outer_array = false;
+    range.__isset.jsonpaths = false;
+    range.__isset.json_root = false;
+    range.__set_path("./be/test/exec/test_data/json_scanner/test_ndjson_changing_keys.json");
+    ranges.emplace_back(range);
+
+    auto scanner = create_json_scanner(types, ranges, {"k1", "k2", "k3"});
+
+    Status st;
+    st = scanner->open();
+    ASSERT_TRUE(st.ok());
+
+    ChunkPtr chunk = scanner->get_next().value();
+    EXPECT_EQ(3, chunk->num_columns());
+    EXPECT_EQ(7, chunk->num_rows());
+
+    EXPECT_EQ("['a', 1, NULL]", chunk->debug_row(0));
+    EXPECT_EQ("['b', 2, NULL]", chunk->debug_row(1));
+    EXPECT_EQ("['c', NULL, NULL]", chunk->debug_row(2));
+    EXPECT_EQ("['d', NULL, NULL]", chunk->debug_row(3));
+    EXPECT_EQ("['e', 5, NULL]", chunk->debug_row(4));
+    EXPECT_EQ("[NULL, 6, 'f']", chunk->debug_row(5));
+    EXPECT_EQ("['g', 7, 'h']", chunk->debug_row(6));
+}
+
 TEST_F(JsonScannerTest, test_ndjson_with_jsonpath) {
     std::vector<TypeDescriptor> types;
     types.emplace_back(TypeDescriptor::create_varchar_type(20));
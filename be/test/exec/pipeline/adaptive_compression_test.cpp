@@ -0,0 +1,105 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "exec/pipeline/exchange/adaptive_compression.h"
+
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+#include "testutil/assert.h"
+
+namespace starrocks::pipeline {
+
+class AdaptiveCompressionTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        _interval = config::exchange_adaptive_compression_interval_chunks;
+        config::exchange_adaptive_compression_interval_chunks = 2;
+    }
+    void TearDown() override { config::exchange_adaptive_compression_interval_chunks = _interval; }
+
+protected:
+    // Send one interval of chunks compressed by |ratio| if they are compressed.
+    bool send_interval(AdaptiveCompression* compression, double ratio) {
+        bool changed = false;
+        for (int i = 0; i < config::exchange_adaptive_compression_interval_chunks; i++) {
+            size_t sent = compression->codec() == nullptr ? 1000 : static_cast<size_t>(1000 / ratio);
+            changed = compression->update(1000, sent);
+        }
+        return changed;
+    }
+
+    int32_t _interval = 0;
+    double _pressure = 0;
+};
+
+TEST_F(AdaptiveCompressionTest, test_fixed) {
+    AdaptiveCompression compression;
+    ASSERT_OK(compression.init(CompressionTypePB::LZ4, false, [this]() { return _pressure; }));
+    ASSERT_EQ(CompressionTypePB::LZ4, compression.type());
+    ASSERT_NE(nullptr, compression.codec());
+    _pressure = 1;
+    ASSERT_FALSE(send_interval(&compression, 1));
+    ASSERT_EQ(CompressionTypePB::LZ4, compression.type());
+}
+
+TEST_F(AdaptiveCompressionTest, test_follow_pressure) {
+    AdaptiveCompression compression;
+    ASSERT_OK(compression.init(CompressionTypePB::NO_COMPRESSION, true, [this]() { return _pressure; }));
+    ASSERT_EQ(CompressionTypePB::NO_COMPRESSION, compression.type());
+    ASSERT_EQ(nullptr, compression.codec());
+
+    // the network is congested
+    _pressure = 1;
+    ASSERT_TRUE(send_interval(&compression, 3));
+    ASSERT_EQ(CompressionTypePB::LZ4, compression.type());
+    ASSERT_TRUE(send_interval(&compression, 3));
+    ASSERT_EQ(CompressionTypePB::ZSTD, compression.type());
+    ASSERT_FALSE(send_interval(&compression, 4));
+    ASSERT_EQ(CompressionTypePB::ZSTD, compression.type());
+
+    // neither congested nor idle
+    _pressure = 0.3;
+    ASSERT_FALSE(send_interval(&compression, 4));
+    ASSERT_EQ(CompressionTypePB::ZSTD, compression.type());
+
+    // the network is idle
+    _pressure = 0;
+    ASSERT_TRUE(send_interval(&compression, 4));
+    ASSERT_EQ(CompressionTypePB::LZ4, compression.type());
+    ASSERT_TRUE(send_interval(&compression, 3));
+    ASSERT_EQ(CompressionTypePB::NO_COMPRESSION, compression.type());
+    ASSERT_EQ(4, compression.num_switches());
+}
+
+TEST_F(AdaptiveCompressionTest, test_incompressible) {
+    AdaptiveCompression compression;
+    ASSERT_OK(compression.init(CompressionTypePB::LZ4, true, [this]() { return _pressure; }));
+    _pressure = 1;
+    // not compressible, fall back to no compression even if the network is congested
+    ASSERT_TRUE(send_interval(&compression, 1));
+    ASSERT_EQ(CompressionTypePB::NO_COMPRESSION, compression.type());
+    // LZ4 is known not to compress better
+    ASSERT_FALSE(send_interval(&compression, 1));
+    ASSERT_EQ(CompressionTypePB::NO_COMPRESSION, compression.type());
+}
+
+TEST_F(AdaptiveCompressionTest, test_unknown_type) {
+    AdaptiveCompression compression;
+    ASSERT_OK(compression.init(CompressionTypePB::SNAPPY, true, [this]() { return _pressure; }));
+    ASSERT_EQ(CompressionTypePB::LZ4, compression.type());
+}
+
+} // namespace starrocks::pipeline
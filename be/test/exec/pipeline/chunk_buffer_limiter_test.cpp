@@ -0,0 +1,74 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/pipeline/scan/chunk_buffer_limiter.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "common/config.h"
+
+namespace starrocks::pipeline {
+
+TEST(ChunkBufferLimiterTest, test_mem_capacity) {
+    DynamicChunkBufferLimiter limiter(100, 10, 1000 * 16, 16);
+    ASSERT_EQ(10u, limiter.capacity());
+
+    // Each chunk uses 16 * 10 bytes, so the memory limit allows 100 chunks.
+    limiter.update_avg_row_bytes(160, 16, 16);
+    ASSERT_EQ(100u, limiter.capacity());
+    // Each chunk uses 16 * 1000 bytes, so the memory limit allows 1 chunk.
+    limiter.update_avg_row_bytes(1000 * 16 * 100, 16 * 100, 16);
+    ASSERT_EQ(1u, limiter.capacity());
+
+    auto token = limiter.pin(1);
+    ASSERT_NE(nullptr, token);
+    ASSERT_TRUE(limiter.is_full());
+    ASSERT_EQ(nullptr, limiter.pin(1));
+    token.reset();
+    ASSERT_FALSE(limiter.is_full());
+}
+
+TEST(ChunkBufferLimiterTest, test_feedback_capacity) {
+    DynamicChunkBufferLimiter limiter(100, 100, 1000 * 16 * 100, 16);
+    limiter.update_avg_row_bytes(160, 16, 16);
+    ASSERT_EQ(100u, limiter.capacity());
+
+    // Without the consumption rate, the capacity is only limited by the memory usage.
+    limiter.update_io_time(1'000'000, 1);
+    ASSERT_EQ(100u, limiter.capacity());
+
+    // Drivers consume 16 chunks in at least 10ms, and it takes 1ms to read a chunk,
+    // so at most 16 * 1ms / 10ms * 2 chunks need to be buffered.
+    limiter.update_consumed_chunks(16);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    limiter.update_consumed_chunks(16);
+    ASSERT_GE(limiter.capacity(), 1u);
+    ASSERT_LE(limiter.capacity(), 4u);
+
+    // Slow io needs more buffered chunks.
+    for (int i = 0; i < 100; i++) {
+        limiter.update_io_time(1'000'000'000, 1);
+    }
+    ASSERT_EQ(100u, limiter.capacity());
+
+    config::enable_chunk_buffer_feedback_capacity = false;
+    limiter.update_io_time(1, 1);
+    ASSERT_EQ(100u, limiter.capacity());
+    config::enable_chunk_buffer_feedback_capacity = true;
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,89 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/pipeline/scan/morsel.h"
+
+#include <gtest/gtest.h>
+
+#include "testutil/parallel_test.h"
+
+namespace starrocks::pipeline {
+
+static MorselQueuePtr create_fixed_morsel_queue(const std::vector<int64_t>& tablet_ids) {
+    Morsels morsels;
+    for (int64_t tablet_id : tablet_ids) {
+        TScanRange scan_range;
+        scan_range.__set_internal_scan_range(TInternalScanRange());
+        scan_range.internal_scan_range.__set_tablet_id(tablet_id);
+        scan_range.internal_scan_range.__set_version("1");
+        morsels.emplace_back(std::make_unique<ScanMorsel>(0, scan_range));
+    }
+    return std::make_unique<FixedMorselQueue>(std::move(morsels));
+}
+
+static int64_t tablet_id_of(const MorselPtr& morsel) {
+    return std::get<0>(morsel->get_lane_owner_and_version());
+}
+
+PARALLEL_TEST(MorselQueueTest, test_morsel_stealing) {
+    std::map<int, MorselQueuePtr> queue_per_driver_seq;
+    queue_per_driver_seq.emplace(0, create_fixed_morsel_queue({1}));
+    queue_per_driver_seq.emplace(1, create_fixed_morsel_queue({2, 3, 4}));
+    queue_per_driver_seq.emplace(2, create_fixed_morsel_queue({5}));
+    IndividualMorselQueueFactory factory(std::move(queue_per_driver_seq), true);
+    factory.enable_morsel_stealing();
+
+    auto* queue0 = factory.create(0);
+    auto* queue1 = factory.create(1);
+    auto* queue2 = factory.create(2);
+
+    ASSERT_EQ(1, tablet_id_of(queue0->try_get().value()));
+    // The queue 1 hasn't started to get morsels, so its morsels cannot be stolen.
+    ASSERT_TRUE(queue0->empty());
+    ASSERT_EQ(nullptr, queue0->try_get().value());
+
+    ASSERT_EQ(2, tablet_id_of(queue1->try_get().value()));
+    ASSERT_FALSE(queue0->empty());
+    ASSERT_EQ(3, tablet_id_of(queue0->try_get().value()));
+
+    // The queue 2 tries the queue 0 first, which has been exhausted, and then steals from the queue 1.
+    ASSERT_EQ(5, tablet_id_of(queue2->try_get().value()));
+    ASSERT_EQ(4, tablet_id_of(queue2->try_get().value()));
+
+    ASSERT_TRUE(queue0->empty());
+    ASSERT_TRUE(queue1->empty());
+    ASSERT_TRUE(queue2->empty());
+    ASSERT_EQ(nullptr, queue1->try_get().value());
+
+    ASSERT_EQ(1, down_cast<FixedMorselQueue*>(queue0)->num_stolen_morsels());
+    ASSERT_EQ(0, down_cast<FixedMorselQueue*>(queue1)->num_stolen_morsels());
+    ASSERT_EQ(1, down_cast<FixedMorselQueue*>(queue2)->num_stolen_morsels());
+}
+
+PARALLEL_TEST(MorselQueueTest, test_morsel_stealing_disabled) {
+    std::map<int, MorselQueuePtr> queue_per_driver_seq;
+    queue_per_driver_seq.emplace(0, create_fixed_morsel_queue({1}));
+    queue_per_driver_seq.emplace(1, create_fixed_morsel_queue({2, 3}));
+    IndividualMorselQueueFactory factory(std::move(queue_per_driver_seq), true);
+
+    auto* queue0 = factory.create(0);
+    auto* queue1 = factory.create(1);
+    ASSERT_EQ(1, tablet_id_of(queue0->try_get().value()));
+    ASSERT_EQ(2, tablet_id_of(queue1->try_get().value()));
+    ASSERT_TRUE(queue0->empty());
+    ASSERT_EQ(nullptr, queue0->try_get().value());
+    ASSERT_EQ(3, tablet_id_of(queue1->try_get().value()));
+}
+
+} // namespace starrocks::pipeline
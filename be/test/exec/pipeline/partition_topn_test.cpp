@@ -0,0 +1,98 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "exec/pipeline/sort/partition_topn.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+#include "column/chunk.h"
+#include "column/fixed_length_column.h"
+#include "testutil/assert.h"
+
+namespace starrocks::pipeline {
+
+static ChunkPtr create_chunk(const std::vector<int32_t>& keys) {
+    auto key_column = Int32Column::create();
+    auto value_column = Int64Column::create();
+    for (int32_t key : keys) {
+        key_column->append(key);
+        value_column->append(key * 10L);
+    }
+    auto chunk = std::make_shared<Chunk>();
+    chunk->append_column(std::move(key_column), 0);
+    chunk->append_column(std::move(value_column), 1);
+    return chunk;
+}
+
+static std::vector<int32_t> kept_keys(const PartitionTopn& topn) {
+    std::vector<int32_t> keys;
+    for (size_t i = 0; i < topn.num_rows(); i++) {
+        keys.emplace_back(topn.chunk()->get_column_by_index(0)->get(i).get_int32());
+        EXPECT_EQ(keys.back() * 10L, topn.chunk()->get_column_by_index(1)->get(i).get_int64());
+    }
+    return keys;
+}
+
+static Status add(PartitionTopn* topn, const std::vector<int32_t>& keys, const SortDescs& sort_desc, size_t limit,
+                  bool limit_by_rank, size_t* rejected_rows) {
+    std::atomic<bool> cancel{false};
+    auto chunk = create_chunk(keys);
+    return topn->add(cancel, chunk, {chunk->get_column_by_index(0)}, sort_desc, limit, limit_by_rank, rejected_rows);
+}
+
+TEST(PartitionTopnTest, row_number) {
+    std::vector<int32_t> keys(100);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(0));
+
+    SortDescs sort_desc(std::vector<bool>{false}, std::vector<bool>{false});
+    PartitionTopn topn;
+    size_t rejected_rows = 0;
+    for (size_t i = 0; i < keys.size(); i += 10) {
+        std::vector<int32_t> part(keys.begin() + i, keys.begin() + i + 10);
+        ASSERT_OK(add(&topn, part, sort_desc, 5, false, &rejected_rows));
+        ASSERT_LE(topn.num_rows(), 5);
+    }
+    ASSERT_EQ((std::vector<int32_t>{99, 98, 97, 96, 95}), kept_keys(topn));
+    // the rows behind the 5th row are dropped once 5 rows are kept
+    ASSERT_GT(rejected_rows, 0);
+    ASSERT_LE(rejected_rows, 90);
+
+    topn.reset();
+    ASSERT_EQ(0, topn.num_rows());
+    ASSERT_EQ(nullptr, topn.chunk());
+}
+
+TEST(PartitionTopnTest, rank) {
+    SortDescs sort_desc(std::vector<bool>{true}, std::vector<bool>{true});
+    PartitionTopn topn;
+    size_t rejected_rows = 0;
+    ASSERT_OK(add(&topn, {3, 1, 2, 1}, sort_desc, 2, true, &rejected_rows));
+    ASSERT_EQ((std::vector<int32_t>{1, 1}), kept_keys(topn));
+    // the rows equal to the last kept row are kept
+    ASSERT_OK(add(&topn, {1, 0, 4, 2}, sort_desc, 2, true, &rejected_rows));
+    ASSERT_EQ((std::vector<int32_t>{0, 1, 1, 1}), kept_keys(topn));
+    ASSERT_EQ(2, rejected_rows);
+    ASSERT_OK(add(&topn, {0}, sort_desc, 2, true, &rejected_rows));
+    ASSERT_EQ((std::vector<int32_t>{0, 0}), kept_keys(topn));
+    ASSERT_OK(add(&topn, {}, sort_desc, 2, true, &rejected_rows));
+    ASSERT_EQ((std::vector<int32_t>{0, 0}), kept_keys(topn));
+}
+
+} // namespace starrocks::pipeline
@@ -88,6 +88,43 @@ PARALLEL_TEST(QuerySharedDriverQueueTest, test_basic) {
     }
 }
 
+PARALLEL_TEST(QuerySharedDriverQueueTest, test_short_query_lane) {
+    QuerySharedDriverQueue queue(true);
+
+    QueryContext long_query_ctx;
+    long_query_ctx.incr_cpu_cost(config::pipeline_short_query_lane_cpu_budget_ns);
+    QueryContext short_query_ctx;
+
+    auto long_driver = std::make_shared<PipelineDriver>(_gen_operators(), &long_query_ctx, nullptr, nullptr, -1);
+    _set_driver_level(long_driver.get(), 0);
+    auto short_driver = std::make_shared<PipelineDriver>(_gen_operators(), &short_query_ctx, nullptr, nullptr, -1);
+    _set_driver_level(short_driver.get(), 7);
+
+    // The driver of the short query is taken first, although it is in the lower level.
+    queue.put_back(long_driver.get());
+    queue.put_back(short_driver.get());
+    ASSERT_FALSE(long_driver->is_in_short_query_lane());
+    ASSERT_TRUE(short_driver->is_in_short_query_lane());
+    ASSERT_EQ(2, queue.size());
+
+    auto maybe_driver = queue.take();
+    ASSERT_TRUE(maybe_driver.ok());
+    ASSERT_EQ(short_driver.get(), maybe_driver.value());
+    maybe_driver = queue.take();
+    ASSERT_TRUE(maybe_driver.ok());
+    ASSERT_EQ(long_driver.get(), maybe_driver.value());
+
+    // The driver drops into the multi-level queues, after its query has used the CPU budget.
+    short_query_ctx.incr_cpu_cost(config::pipeline_short_query_lane_cpu_budget_ns);
+    queue.put_back(short_driver.get());
+    ASSERT_FALSE(short_driver->is_in_short_query_lane());
+    queue.cancel(short_driver.get());
+    maybe_driver = queue.take();
+    ASSERT_TRUE(maybe_driver.ok());
+    ASSERT_EQ(short_driver.get(), maybe_driver.value());
+    ASSERT_EQ(0, queue.size());
+}
+
 PARALLEL_TEST(QuerySharedDriverQueueTest, test_cancel) {
     QuerySharedDriverQueue queue;
 
@@ -165,6 +202,119 @@ PARALLEL_TEST(QuerySharedDriverQueueTest, test_take_close) {
     consumer_thread->join();
 }
 
+PARALLEL_TEST(WorkStealingDriverQueueTest, test_local_and_steal) {
+    WorkStealingDriverQueue queue(2);
+
+    QueryContext query_context;
+    auto driver1 = std::make_shared<PipelineDriver>(_gen_operators(), &query_context, nullptr, nullptr, -1);
+    auto driver2 = std::make_shared<PipelineDriver>(_gen_operators(), &query_context, nullptr, nullptr, -1);
+    driver1->set_driver_queue_shard(0);
+    driver2->set_driver_queue_shard(1);
+
+    queue.put_back(driver1.get());
+    queue.put_back(driver2.get());
+    ASSERT_EQ(2, queue.size());
+
+    // Each worker takes the driver of its own shard first.
+    auto maybe_driver = queue.take(1);
+    ASSERT_TRUE(maybe_driver.ok());
+    ASSERT_EQ(driver2.get(), maybe_driver.value());
+    ASSERT_EQ(1, driver2->driver_queue_shard());
+
+    // Worker 1 steals the driver from shard 0, and the driver moves to shard 1.
+    maybe_driver = queue.take(1);
+    ASSERT_TRUE(maybe_driver.ok());
+    ASSERT_EQ(driver1.get(), maybe_driver.value());
+    ASSERT_EQ(1, driver1->driver_queue_shard());
+    ASSERT_EQ(0, queue.size());
+
+    queue.update_statistics(driver1.get());
+    queue.put_back_from_executor(driver1.get());
+    maybe_driver = queue.take(1);
+    ASSERT_TRUE(maybe_driver.ok());
+    ASSERT_EQ(driver1.get(), maybe_driver.value());
+}
+
+PARALLEL_TEST(WorkStealingDriverQueueTest, test_cancel) {
+    WorkStealingDriverQueue queue(2);
+
+    QueryContext query_context;
+    auto driver1 = std::make_shared<PipelineDriver>(_gen_operators(), &query_context, nullptr, nullptr, -1);
+    auto driver2 = std::make_shared<PipelineDriver>(_gen_operators(), &query_context, nullptr, nullptr, -1);
+    driver1->set_driver_queue_shard(0);
+    driver2->set_driver_queue_shard(0);
+
+    queue.put_back(driver1.get());
+    queue.put_back(driver2.get());
+    // The cancelled driver is taken first.
+    queue.cancel(driver2.get());
+
+    auto maybe_driver = queue.take(0);
+    ASSERT_TRUE(maybe_driver.ok());
+    ASSERT_EQ(driver2.get(), maybe_driver.value());
+    maybe_driver = queue.take(0);
+    ASSERT_TRUE(maybe_driver.ok());
+    ASSERT_EQ(driver1.get(), maybe_driver.value());
+    ASSERT_EQ(0, queue.size());
+}
+
+PARALLEL_TEST(WorkStealingDriverQueueTest, test_numa_steal_order) {
+    // Shards 0 and 2 belong to node 0, and shards 1 and 3 belong to node 1.
+    WorkStealingDriverQueue queue(4, 2);
+    ASSERT_EQ(0, queue.numa_node_of_worker(0));
+    ASSERT_EQ(1, queue.numa_node_of_worker(1));
+    ASSERT_EQ(0, queue.numa_node_of_worker(6));
+
+    QueryContext query_context;
+    auto driver1 = std::make_shared<PipelineDriver>(_gen_operators(), &query_context, nullptr, nullptr, -1);
+    auto driver2 = std::make_shared<PipelineDriver>(_gen_operators(), &query_context, nullptr, nullptr, -1);
+    driver1->set_driver_queue_shard(1);
+    driver2->set_driver_queue_shard(2);
+    queue.put_back(driver1.get());
+    queue.put_back(driver2.get());
+
+    // Worker 0 steals from the shard of the same NUMA node first.
+    auto maybe_driver = queue.take(0);
+    ASSERT_TRUE(maybe_driver.ok());
+    ASSERT_EQ(driver2.get(), maybe_driver.value());
+    maybe_driver = queue.take(0);
+    ASSERT_TRUE(maybe_driver.ok());
+    ASSERT_EQ(driver1.get(), maybe_driver.value());
+}
+
+PARALLEL_TEST(WorkStealingDriverQueueTest, test_take_block) {
+    WorkStealingDriverQueue queue(4);
+
+    QueryContext query_context;
+    auto driver1 = std::make_shared<PipelineDriver>(_gen_operators(), &query_context, nullptr, nullptr, -1);
+    driver1->set_driver_queue_shard(3);
+
+    auto consumer_thread = std::make_shared<std::thread>([&queue, &driver1] {
+        auto maybe_driver = queue.take(0);
+        ASSERT_TRUE(maybe_driver.ok());
+        ASSERT_EQ(driver1.get(), maybe_driver.value());
+    });
+
+    sleep(1);
+    queue.put_back(driver1.get());
+
+    consumer_thread->join();
+}
+
+PARALLEL_TEST(WorkStealingDriverQueueTest, test_take_close) {
+    WorkStealingDriverQueue queue(4);
+
+    auto consumer_thread = std::make_shared<std::thread>([&queue] {
+        auto maybe_driver = queue.take(2);
+        ASSERT_TRUE(maybe_driver.status().is_cancelled());
+    });
+
+    sleep(1);
+    queue.close();
+
+    consumer_thread->join();
+}
+
 class WorkGroupDriverQueueTest : public ::testing::Test {
 public:
     void SetUp() override {
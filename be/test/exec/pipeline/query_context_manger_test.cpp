@@ -14,11 +14,15 @@
 
 #include <chrono>
 #include <random>
+#include <thread>
 
+#include "common/config.h"
 #include "exec/pipeline/query_context.h"
 #include "exec/workgroup/work_group.h"
 #include "gtest/gtest.h"
+#include "runtime/exec_env.h"
 #include "testutil/assert.h"
+#include "util/defer_op.h"
 
 namespace starrocks::pipeline {
 
@@ -294,4 +298,60 @@ TEST(QueryContextManagerTest, testSetWorkgroup) {
     ASSERT_EQ(0, wg->num_running_queries());
 }
 
+TEST(QueryContextManagerTest, testMemAdmission) {
+    const int64_t query_pool_limit = ExecEnv::GetInstance()->query_pool_mem_tracker()->limit();
+    ASSERT_GT(query_pool_limit, 0);
+    auto parent_mem_tracker = std::make_shared<MemTracker>(MemTracker::QUERY_POOL, query_pool_limit, "parent", nullptr);
+    auto query_ctx_mgr = std::make_shared<QueryContextManager>(6);
+    ASSERT_TRUE(query_ctx_mgr->init().ok());
+
+    workgroup::WorkGroupPtr wg = std::make_shared<workgroup::WorkGroup>("wg1", 1, 1, 1, 1, 10 /* concurrency_limit */,
+                                                                        workgroup::WorkGroupType::WG_NORMAL);
+
+    const bool prev_enable_admission = config::enable_query_mem_admission;
+    const double prev_reservation_ratio = config::query_admission_mem_reservation_ratio;
+    const int64_t prev_wait_timeout_ms = config::query_admission_wait_timeout_ms;
+    DeferOp defer([&]() {
+        config::enable_query_mem_admission = prev_enable_admission;
+        config::query_admission_mem_reservation_ratio = prev_reservation_ratio;
+        config::query_admission_wait_timeout_ms = prev_wait_timeout_ms;
+    });
+    config::enable_query_mem_admission = true;
+    config::query_admission_mem_reservation_ratio = 0.6;
+    config::query_admission_wait_timeout_ms = 100;
+
+    auto* query_ctx1 = gen_query_ctx(parent_mem_tracker.get(), query_ctx_mgr.get(), 0, 1, 1, 60, 300);
+    auto* query_ctx2 = gen_query_ctx(parent_mem_tracker.get(), query_ctx_mgr.get(), 0, 2, 1, 60, 300);
+
+    // The first query is always admitted.
+    ASSIGN_OR_ABORT(auto token1, query_ctx_mgr->admit_query(query_ctx1, wg.get()));
+    ASSERT_TRUE(token1 != nullptr);
+    ASSERT_EQ(static_cast<int64_t>(query_pool_limit * 0.6), query_ctx_mgr->total_mem_reservation());
+
+    // The second query waits in the queue and times out, since both of the reservations don't fit into the pool.
+    ASSERT_ERROR(query_ctx_mgr->admit_query(query_ctx2, wg.get()));
+    ASSERT_EQ(0, query_ctx_mgr->num_queued_queries());
+    ASSERT_EQ(0, wg->num_queued_queries());
+    ASSERT_GT(wg->acc_queue_wait_ns(), 0);
+
+    // The queued query is admitted after the first query releases its reservation.
+    config::query_admission_wait_timeout_ms = 10000;
+    std::thread release_thread([&token1]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        token1.reset();
+    });
+    ASSIGN_OR_ABORT(auto token2, query_ctx_mgr->admit_query(query_ctx2, wg.get()));
+    release_thread.join();
+    ASSERT_TRUE(token2 != nullptr);
+    ASSERT_EQ(static_cast<int64_t>(query_pool_limit * 0.6), query_ctx_mgr->total_mem_reservation());
+
+    token2.reset();
+    ASSERT_EQ(0, query_ctx_mgr->total_mem_reservation());
+
+    // No reservation when the admission is disabled.
+    config::enable_query_mem_admission = false;
+    ASSIGN_OR_ABORT(auto token3, query_ctx_mgr->admit_query(query_ctx1, wg.get()));
+    ASSERT_TRUE(token3 == nullptr);
+}
+
 } // namespace starrocks::pipeline
@@ -2,6 +2,11 @@
 
 #include <utility>
 
+#include "column/array_column.h"
+#include "column/chunk.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+
 #include "gen_cpp/RuntimeProfile_types.h"
 #include "gtest/gtest.h"
 
@@ -162,4 +167,72 @@ TEST_F(TableFunctionOperatorTest, check_mem_leak) {
     op.close(&_runtime_state);
 }
 
+TEST_F(TableFunctionOperatorTest, unnest) {
+    CounterPtr counter_ptr = std::make_shared<Counter>();
+    TestNormalOperatorFactory factory(1, 1, counter_ptr, &_tnode);
+    TableFunctionOperator op(&factory, 1, 1, 0, _tnode);
+    ASSERT_TRUE(op.prepare(&_runtime_state).ok());
+
+    // [1, 2, 3], NULL with the elements [7, 8], [], [4]
+    auto elements = Int32Column::create();
+    for (int32_t v : {1, 2, 3, 7, 8, 4}) {
+        elements->append(v);
+    }
+    auto offsets = UInt32Column::create();
+    for (uint32_t v : {0, 3, 5, 5, 6}) {
+        offsets->append(v);
+    }
+    auto nulls = NullColumn::create();
+    for (uint8_t v : {0, 1, 0, 0}) {
+        nulls->append(v);
+    }
+    auto array_column = NullableColumn::create(ArrayColumn::create(elements, offsets), nulls);
+    auto outer_column = Int32Column::create();
+    for (int32_t v : {10, 20, 30, 40}) {
+        outer_column->append(v);
+    }
+    auto chunk = std::make_shared<Chunk>();
+    chunk->append_column(array_column, 1);
+    chunk->append_column(outer_column, 2);
+
+    // The outputs of a row are split into several chunks
+    _runtime_state.set_chunk_size(2);
+    ASSERT_TRUE(op.need_input());
+    ASSERT_TRUE(op.push_chunk(&_runtime_state, chunk).ok());
+    std::vector<std::pair<int32_t, int32_t>> rows;
+    while (op.has_output()) {
+        auto output = op.pull_chunk(&_runtime_state);
+        ASSERT_TRUE(output.ok());
+        ASSERT_LE(output.value()->num_rows(), 2);
+        for (size_t i = 0; i < output.value()->num_rows(); i++) {
+            rows.emplace_back(output.value()->get_column_by_slot_id(2)->get(i).get_int32(),
+                              output.value()->get_column_by_slot_id(3)->get(i).get_int32());
+        }
+    }
+    std::vector<std::pair<int32_t, int32_t>> expected{{10, 1}, {10, 2}, {10, 3}, {40, 4}};
+    ASSERT_EQ(expected, rows);
+    ASSERT_TRUE(op.need_input());
+
+    // Every row is output once, the columns are output as is
+    _runtime_state.set_chunk_size(4096);
+    auto single_elements = Int32Column::create();
+    auto single_offsets = UInt32Column::create();
+    single_offsets->append(0);
+    for (int32_t v = 0; v < 4; v++) {
+        single_elements->append(v);
+        single_offsets->append(v + 1);
+    }
+    chunk = std::make_shared<Chunk>();
+    chunk->append_column(ArrayColumn::create(single_elements, single_offsets), 1);
+    chunk->append_column(outer_column, 2);
+    ASSERT_TRUE(op.push_chunk(&_runtime_state, chunk).ok());
+    auto output = op.pull_chunk(&_runtime_state);
+    ASSERT_TRUE(output.ok());
+    ASSERT_EQ(4, output.value()->num_rows());
+    ASSERT_EQ(outer_column.get(), output.value()->get_column_by_slot_id(2).get());
+    ASSERT_EQ(single_elements.get(), output.value()->get_column_by_slot_id(3).get());
+    ASSERT_FALSE(op.has_output());
+    op.close(&_runtime_state);
+}
+
 } // namespace starrocks::pipeline
@@ -22,6 +22,7 @@
 
 #include "column/fixed_length_column.h"
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
 #include "exec/pipeline/pipeline.h"
 #include "exec/pipeline/pipeline_driver.h"
 #include "exec/query_cache/cache_manager.h"
@@ -33,6 +34,7 @@
 #include "exec/query_cache/ticket_checker.h"
 #include "exec/query_cache/transform_operator.h"
 #include "gutil/strings/substitute.h"
+#include "util/defer_op.h"
 
 namespace starrocks {
 struct QueryCacheTest : public ::testing::Test {
@@ -95,6 +97,9 @@ TEST_F(QueryCacheTest, testLaneArbiter) {
 TEST_F(QueryCacheTest, testCacheManager) {
     static constexpr size_t CACHE_CAPACITY = 10240;
     auto cache_mgr = std::make_shared<query_cache::CacheManager>(CACHE_CAPACITY);
+    // the memory usage of the compressed entries is not exact.
+    config::query_cache_compress_entries = false;
+    DeferOp defer([]() { config::query_cache_compress_entries = true; });
 
     auto create_cache_value = [](size_t byte_size) {
         auto chk = std::make_shared<Chunk>();
@@ -154,6 +159,41 @@ TEST_F(QueryCacheTest, testCacheManager) {
     ASSERT_GE(cache_mgr->memory_usage(), 0);
 }
 
+TEST_F(QueryCacheTest, testCompressedCacheEntries) {
+    auto cache_mgr = std::make_shared<query_cache::CacheManager>(1 << 20);
+    config::query_cache_compress_entries = true;
+
+    auto chunk = std::make_shared<Chunk>();
+    auto col = Int32Column::create();
+    for (int i = 0; i < 4096; ++i) {
+        col->append(i % 7);
+    }
+    chunk->append_column(col, 1);
+    chunk->owner_info().set_owner_id(1001, true);
+    query_cache::CacheValue value(10, 2, {chunk});
+    auto uncompressed_size = value.size();
+
+    ASSERT_TRUE(cache_mgr->populate("key", value).ok());
+    ASSERT_LT(cache_mgr->memory_usage(), uncompressed_size);
+
+    for (int k = 0; k < 2; ++k) {
+        auto status = cache_mgr->probe("key");
+        ASSERT_TRUE(status.ok());
+        auto& cached = status.value();
+        ASSERT_EQ(cached.populate_time, 10);
+        ASSERT_EQ(cached.version, 2);
+        ASSERT_EQ(cached.result.size(), 1);
+        auto& cached_chunk = cached.result[0];
+        ASSERT_EQ(cached_chunk->owner_info().owner_id(), 1001);
+        ASSERT_TRUE(cached_chunk->owner_info().is_last_chunk());
+        ASSERT_EQ(cached_chunk->num_rows(), 4096);
+        for (int i = 0; i < 4096; ++i) {
+            ASSERT_EQ(cached_chunk->get_column_by_slot_id(1)->get(i).get_int32(), i % 7);
+        }
+    }
+    ASSERT_FALSE(cache_mgr->probe("missing").ok());
+}
+
 ChunkPtr create_test_chunk(query_cache::LaneOwnerType owner, long from, long to, bool is_last_chunk) {
     ChunkPtr chunk = std::make_shared<Chunk>();
     chunk->owner_info().set_owner_id(owner, is_last_chunk);
@@ -25,6 +25,7 @@
 #include "column/fixed_length_column.h"
 #include "common/object_pool.h"
 #include "exec/exec_node.h"
+#include "exec/pipeline/aggregate/repeat/repeat_operator.h"
 #include "gen_cpp/Descriptors_types.h"
 #include "gen_cpp/PlanNodes_types.h"
 #include "runtime/descriptors.h"
@@ -310,4 +311,59 @@ TEST_F(RepeatNodeTest, repeat_node_test) {
     ASSERT_TRUE(rows == 9);
 }
 
+TEST_F(RepeatNodeTest, repeat_operator_share_columns) {
+    std::vector<std::set<SlotId>> slot_id_set_list = _tnode.repeat_node.slot_id_set_list;
+    std::set<SlotId> all_slot_ids = _tnode.repeat_node.all_slot_ids;
+    std::vector<std::vector<SlotId>> null_slot_ids{{0, 1}, {1}, {}};
+    std::vector<int64_t> repeat_id_list = _tnode.repeat_node.repeat_id_list;
+    std::vector<std::vector<int64_t>> grouping_list = _tnode.repeat_node.grouping_list;
+    pipeline::RepeatOperatorFactory factory(1, 1, std::move(slot_id_set_list), std::move(all_slot_ids),
+                                            std::move(null_slot_ids), std::move(repeat_id_list), 3, 3,
+                                            ColumnHelper::create_const_null_column(1), {}, std::move(grouping_list), 1,
+                                            _desc_tbl->get_tuple_descriptor(1), {});
+    ASSERT_TRUE(factory.prepare(&_runtime_state).ok());
+    auto op = factory.create(1, 0);
+    ASSERT_TRUE(op->prepare(&_runtime_state).ok());
+
+    auto first_column = FixedLengthColumn<int32_t>::create();
+    auto second_column = FixedLengthColumn<int32_t>::create();
+    for (int32_t i = 0; i < 3; i++) {
+        first_column->append(i);
+        second_column->append(i * 11);
+    }
+    auto chunk = std::make_shared<Chunk>();
+    chunk->append_column(first_column, 0);
+    chunk->append_column(second_column, 1);
+
+    ASSERT_TRUE(op->need_input());
+    ASSERT_TRUE(op->push_chunk(&_runtime_state, chunk).ok());
+    std::vector<ChunkPtr> outputs;
+    while (op->has_output()) {
+        auto output = op->pull_chunk(&_runtime_state);
+        ASSERT_TRUE(output.ok());
+        outputs.emplace_back(std::move(output).value());
+    }
+    ASSERT_EQ(3, outputs.size());
+    ASSERT_TRUE(op->need_input());
+
+    // The needed columns are shared with the input chunk rather than copied
+    ASSERT_TRUE(outputs[0]->get_column_by_slot_id(0)->only_null());
+    ASSERT_TRUE(outputs[0]->get_column_by_slot_id(1)->only_null());
+    ASSERT_EQ(first_column.get(), outputs[1]->get_column_by_slot_id(0).get());
+    ASSERT_TRUE(outputs[1]->get_column_by_slot_id(1)->only_null());
+    ASSERT_EQ(first_column.get(), outputs[2]->get_column_by_slot_id(0).get());
+    ASSERT_EQ(second_column.get(), outputs[2]->get_column_by_slot_id(1).get());
+    const int64_t repeat_ids[] = {3, 1, 0};
+    for (size_t i = 0; i < outputs.size(); i++) {
+        ASSERT_EQ(3, outputs[i]->num_rows());
+        ASSERT_EQ(5, outputs[i]->num_columns());
+        auto repeat_id_column = outputs[i]->get_column_by_slot_id(2);
+        ASSERT_EQ(repeat_ids[i], ColumnHelper::get_const_value<TYPE_BIGINT>(repeat_id_column));
+    }
+    // The input chunk is not changed
+    ASSERT_EQ(2, chunk->num_columns());
+    ASSERT_EQ(3, chunk->num_rows());
+    op->close(&_runtime_state);
+}
+
 } // namespace starrocks
@@ -0,0 +1,73 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/serialized_set_key.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "util/phmap/phmap.h"
+
+namespace starrocks {
+
+TEST(SerializedSetKeyTest, inline_and_pooled_keys) {
+    MemPool pool;
+    std::string small = "0123456789";
+    std::string large = "0123456789a";
+
+    // the small key is stored inline, and the large one is copied to the pool
+    SerializedSetKey small_key(SerializedSetKey(reinterpret_cast<const uint8_t*>(small.data()), small.size()), &pool);
+    ASSERT_EQ(0, pool.total_allocated_bytes());
+    SerializedSetKey large_key(SerializedSetKey(reinterpret_cast<const uint8_t*>(large.data()), large.size()), &pool);
+    ASSERT_GE(pool.total_allocated_bytes(), static_cast<int64_t>(large.size()));
+    small[0] = 'x';
+    large[0] = 'x';
+    ASSERT_EQ("0123456789", small_key.slice().to_string());
+    ASSERT_EQ("0123456789a", large_key.slice().to_string());
+
+    small_key.set_flag(3);
+    ASSERT_EQ(3, small_key.flag());
+    ASSERT_EQ(0, large_key.flag());
+}
+
+TEST(SerializedSetKeyTest, hash_set) {
+    MemPool pool;
+    phmap::flat_hash_set<SerializedSetKey, SerializedSetKeyHash, SerializedSetKeyEqual> set;
+    for (int i = 0; i < 1000; i++) {
+        // the same keys referred and inlined
+        std::string value = std::to_string(i % 100) + std::string(i % 2 == 0 ? 1 : 20, 'v');
+        SerializedSetKey key(reinterpret_cast<const uint8_t*>(value.data()), value.size());
+        set.lazy_emplace(key, [&](const auto& ctor) { ctor(key, &pool); });
+    }
+    ASSERT_EQ(100, set.size());
+
+    std::string value = std::to_string(42) + "v";
+    auto iter = set.find(SerializedSetKey(reinterpret_cast<const uint8_t*>(value.data()), value.size()));
+    ASSERT_TRUE(iter != set.end());
+    iter->set_flag(1);
+    ASSERT_EQ(value, iter->slice().to_string());
+    value = std::to_string(43) + std::string(20, 'v');
+    ASSERT_TRUE(set.find(SerializedSetKey(reinterpret_cast<const uint8_t*>(value.data()), value.size())) != set.end());
+    value = std::to_string(43) + "v";
+    ASSERT_TRUE(set.find(SerializedSetKey(reinterpret_cast<const uint8_t*>(value.data()), value.size())) == set.end());
+
+    int flagged = 0;
+    for (const auto& key : set) {
+        flagged += key.flag();
+    }
+    ASSERT_EQ(1, flagged);
+}
+
+} // namespace starrocks
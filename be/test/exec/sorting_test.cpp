@@ -17,13 +17,19 @@
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <optional>
 #include <random>
+#include <string>
+#include <thread>
 #include <utility>
 
 #include "column/chunk.h"
 #include "column/column_helper.h"
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
 #include "exec/sorting/merge.h"
+#include "exec/sorting/parallel_merge.h"
+#include "exec/sorting/radix_sort.h"
 #include "exec/sorting/sort_helper.h"
 #include "exec/sorting/sort_permute.h"
 #include "exprs/column_ref.h"
@@ -33,6 +39,7 @@
 #include "runtime/types.h"
 #include "testutil/assert.h"
 #include "util/defer_op.h"
+#include "util/threadpool.h"
 
 namespace starrocks {
 
@@ -187,6 +194,123 @@ INSTANTIATE_TEST_SUITE_P(
 
                         ));
 
+TEST(SortingTest, radix_sort) {
+    std::mt19937 rng(0);
+    std::vector<InlinePermuteItem<int64_t>> items(10000);
+    for (uint32_t i = 0; i < items.size(); i++) {
+        items[i].inline_value = static_cast<int64_t>(rng() % 1000) - 500;
+        items[i].index_in_chunk = i;
+    }
+    auto expected = items;
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.inline_value < rhs.inline_value; });
+
+    radix_sort(items.data(), items.data() + items.size(),
+               [](const auto& item) { return RadixSortKey<int64_t>::to_key(item.inline_value); });
+    for (size_t i = 0; i < items.size(); i++) {
+        ASSERT_EQ(expected[i].inline_value, items[i].inline_value);
+        // the radix sort is stable
+        ASSERT_EQ(expected[i].index_in_chunk, items[i].index_in_chunk);
+    }
+}
+
+TEST(SortingTest, sort_and_tie_columns_by_radix_sort) {
+    const int64_t old_threshold = config::sort_radix_sort_threshold;
+    const bool old_normalized_keys = config::enable_sort_normalized_keys;
+    DeferOp defer([&]() {
+        config::sort_radix_sort_threshold = old_threshold;
+        config::enable_sort_normalized_keys = old_normalized_keys;
+    });
+    config::enable_sort_normalized_keys = false;
+
+    std::mt19937 rng(0);
+    const size_t num_rows = 20000;
+    auto col1 = Int32Column::create();
+    auto col2 = NullableColumn::create(Int64Column::create(), NullColumn::create());
+    for (size_t i = 0; i < num_rows; i++) {
+        col1->append(static_cast<int32_t>(rng() % 16) - 8);
+        if (rng() % 10 == 0) {
+            col2->append_nulls(1);
+        } else {
+            col2->append_datum(Datum(static_cast<int64_t>(rng()) - (1LL << 31)));
+        }
+    }
+    Columns columns{col1, col2};
+
+    for (bool asc : {true, false}) {
+        SortDescs sort_desc(std::vector<bool>{asc, !asc}, std::vector<bool>{true, false});
+        std::atomic<bool> cancel{false};
+
+        config::sort_radix_sort_threshold = 0;
+        Permutation expected;
+        ASSERT_OK(sort_and_tie_columns(cancel, columns, sort_desc, &expected));
+
+        config::sort_radix_sort_threshold = 16;
+        Permutation actual;
+        ASSERT_OK(sort_and_tie_columns(cancel, columns, sort_desc, &actual));
+
+        ASSERT_EQ(num_rows, actual.size());
+        for (size_t i = 0; i < num_rows; i++) {
+            for (const auto& column : columns) {
+                ASSERT_EQ(0, column->compare_at(expected[i].index_in_chunk, actual[i].index_in_chunk, *column, 1))
+                        << "row " << i;
+            }
+        }
+    }
+}
+
+TEST(SortingTest, sort_and_tie_columns_by_normalized_keys) {
+    const bool old_normalized_keys = config::enable_sort_normalized_keys;
+    const int64_t old_prefix = config::sort_normalized_key_string_prefix;
+    DeferOp defer([&]() {
+        config::enable_sort_normalized_keys = old_normalized_keys;
+        config::sort_normalized_key_string_prefix = old_prefix;
+    });
+
+    std::mt19937 rng(0);
+    const size_t num_rows = 5000;
+    auto col1 = Int32Column::create();
+    auto col2 = NullableColumn::create(BinaryColumn::create(), NullColumn::create());
+    auto col3 = Int64Column::create();
+    for (size_t i = 0; i < num_rows; i++) {
+        col1->append(static_cast<int32_t>(rng() % 4) - 2);
+        if (rng() % 10 == 0) {
+            col2->append_nulls(1);
+        } else {
+            // strings of a long shared prefix, some of them are prefixes of the others
+            std::string value(rng() % 12, 'a');
+            value.append(std::to_string(rng() % 8));
+            col2->append_datum(Datum(Slice(value)));
+        }
+        col3->append(static_cast<int64_t>(rng() % 8) - 4);
+    }
+    Columns columns{col1, col2, col3};
+
+    for (int64_t prefix : {0, 4, 16}) {
+        for (bool asc : {true, false}) {
+            SortDescs sort_desc(std::vector<bool>{asc, !asc, asc}, std::vector<bool>{true, asc, false});
+            std::atomic<bool> cancel{false};
+
+            config::enable_sort_normalized_keys = false;
+            Permutation expected;
+            ASSERT_OK(sort_and_tie_columns(cancel, columns, sort_desc, &expected));
+
+            config::enable_sort_normalized_keys = true;
+            config::sort_normalized_key_string_prefix = prefix;
+            Permutation actual;
+            ASSERT_OK(sort_and_tie_columns(cancel, columns, sort_desc, &actual));
+
+            ASSERT_EQ(num_rows, actual.size());
+            for (size_t i = 0; i < num_rows; i++) {
+                for (const auto& column : columns) {
+                    ASSERT_EQ(0, column->compare_at(expected[i].index_in_chunk, actual[i].index_in_chunk, *column, 1))
+                            << "prefix " << prefix << " row " << i;
+                }
+            }
+        }
+    }
+}
+
 TEST(SortingTest, materialize_by_permutation_binary) {
     BinaryColumn::Ptr input1 = BinaryColumn::create();
     BinaryColumn::Ptr input2 = BinaryColumn::create();
@@ -292,6 +416,89 @@ TEST(SortingTest, merge_sorted_chunks) {
     ASSERT_TRUE(output.is_sorted(sort_desc));
 }
 
+TEST(SortingTest, parallel_merge_sorted_runs) {
+    auto runtime_state = create_runtime_state();
+    std::vector<std::unique_ptr<ColumnRef>> exprs;
+    std::vector<ExprContext*> sort_exprs;
+    exprs.push_back(std::make_unique<ColumnRef>(TypeDescriptor(TYPE_INT), 0));
+    sort_exprs.push_back(new ExprContext(exprs.back().get()));
+    ASSERT_OK(Expr::prepare(sort_exprs, runtime_state.get()));
+    ASSERT_OK(Expr::open(sort_exprs, runtime_state.get()));
+    DeferOp defer([&]() { clear_exprs(sort_exprs); });
+    SortDescs sort_desc(std::vector<int>{1}, std::vector<int>{-1});
+
+    // every input consists of 3 sorted chunks of many duplicated keys
+    std::mt19937 rng(0);
+    constexpr int num_inputs = 4;
+    std::vector<SortedRuns> inputs(num_inputs);
+    std::vector<int32_t> expected;
+    for (auto& input : inputs) {
+        std::vector<int32_t> values(rng() % 3000 + 1);
+        for (auto& value : values) {
+            value = rng() % 1000;
+        }
+        std::sort(values.begin(), values.end());
+        expected.insert(expected.end(), values.begin(), values.end());
+        for (size_t i = 0; i < 3; i++) {
+            auto column = Int32Column::create();
+            column->get_data().assign(values.begin() + i * values.size() / 3,
+                                      values.begin() + (i + 1) * values.size() / 3);
+            auto chunk = std::make_shared<Chunk>(Columns{column}, Chunk::SlotHashMap{{0, 0}});
+            input.chunks.emplace_back(chunk, Columns{column});
+        }
+    }
+    std::sort(expected.begin(), expected.end());
+    std::vector<const SortedRuns*> input_ptrs;
+    for (const auto& input : inputs) {
+        input_ptrs.push_back(&input);
+    }
+
+    constexpr size_t num_slices = 8;
+    auto slices = split_sorted_runs(sort_desc, input_ptrs, num_slices);
+    ASSERT_EQ(num_slices, slices.size());
+    size_t num_rows = 0;
+    std::optional<int32_t> prev_max;
+    for (const auto& slice : slices) {
+        ASSERT_EQ(num_inputs, slice.size());
+        std::optional<int32_t> slice_min, slice_max;
+        for (const auto& runs : slice) {
+            num_rows += runs.num_rows();
+            for (const auto& run : runs.chunks) {
+                for (size_t i = run.start_index(); i < run.end_index(); i++) {
+                    int32_t value = run.get_column(0)->get(i).get_int32();
+                    slice_min = std::min(slice_min.value_or(value), value);
+                    slice_max = std::max(slice_max.value_or(value), value);
+                }
+            }
+        }
+        if (prev_max.has_value() && slice_min.has_value()) {
+            ASSERT_LT(prev_max.value(), slice_min.value());
+        }
+        if (slice_max.has_value()) {
+            prev_max = slice_max;
+        }
+    }
+    ASSERT_EQ(expected.size(), num_rows);
+
+    std::unique_ptr<ThreadPool> pool;
+    ASSERT_OK(ThreadPoolBuilder("test_sort_merge").set_max_threads(4).build(&pool));
+    ParallelMerger merger(sort_desc, &sort_exprs, 1000,
+                          [](size_t input, ChunkUniquePtr chunk) -> StatusOr<ChunkUniquePtr> { return chunk; });
+    ASSERT_OK(merger.init(pool.get(), runtime_state->instance_mem_tracker(), input_ptrs, num_slices, 2));
+    std::vector<int32_t> output;
+    while (!merger.is_eos()) {
+        ASSIGN_OR_ABORT(auto chunk, merger.try_get_next());
+        if (chunk == nullptr) {
+            std::this_thread::yield();
+            continue;
+        }
+        for (size_t i = 0; i < chunk->num_rows(); i++) {
+            output.push_back(chunk->get_column_by_index(0)->get(i).get_int32());
+        }
+    }
+    ASSERT_EQ(expected, output);
+}
+
 TEST(SortingTest, merge_sorted_stream) {
     auto runtime_state = create_runtime_state();
     constexpr int num_columns = 3;
@@ -0,0 +1,173 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/stream/state/kv_state_table.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "exec/stream/stream_test.h"
+#include "fs/fs_util.h"
+#include "testutil/desc_tbl_helper.h"
+
+namespace starrocks::stream {
+
+static const std::string kStateTableDir = "./kv_state_table_test";
+
+class KVStateTableTest : public StreamTestBase {
+public:
+    KVStateTableTest() = default;
+    ~KVStateTableTest() override = default;
+
+    void SetUp() override {
+        (void)fs::remove_all(kStateTableDir);
+        _runtime_state = _obj_pool.add(new RuntimeState(TUniqueId(), TQueryOptions(), TQueryGlobals(), nullptr));
+        std::vector<SlotTypeInfo> src_slots = std::vector<SlotTypeInfo>{
+                {"col1", TYPE_INT, false},
+                {"col2", TYPE_INT, false},
+                {"col3", TYPE_INT, false},
+                {"agg1", TYPE_INT, true},
+        };
+        auto slot_type_info_arrays = DescTblHelper::create_slot_type_desc_info_arrays({src_slots});
+        _tbl = DescTblHelper::generate_desc_tbl(_runtime_state, _obj_pool, slot_type_info_arrays);
+        _runtime_state->set_desc_tbl(_tbl);
+    }
+    void TearDown() override { (void)fs::remove_all(kStateTableDir); }
+
+protected:
+    std::unique_ptr<KVStateTable> open_state_table(size_t k_num) {
+        auto tuple_desc = _tbl->get_tuple_descriptor(0);
+        auto state_table = std::make_unique<KVStateTable>(tuple_desc->slots(), k_num, kStateTableDir);
+        EXPECT_TRUE(state_table->prepare(_runtime_state).ok());
+        EXPECT_TRUE(state_table->open(_runtime_state).ok());
+        return state_table;
+    }
+
+    void check_seek(StateTable* state_table, const std::vector<int32_t>& keys,
+                    const std::vector<std::vector<int32_t>>& expect_rows, const std::vector<bool>& expect_found) {
+        Columns key_cols;
+        key_cols.push_back(ColumnTestHelper::build_column<int32_t>(keys));
+        StateTableResult result;
+        ASSERT_TRUE(state_table->seek(key_cols, result).ok());
+        ASSERT_EQ(result.found, expect_found);
+        ASSERT_EQ(result.result_chunk->num_rows(), expect_rows.size());
+        for (size_t i = 0; i < expect_rows.size(); i++) {
+            _check_row(result.result_chunk, expect_rows[i], i);
+        }
+    }
+
+    void check_prefix_scan(StateTable* state_table, const std::vector<int32_t>& keys,
+                           const std::vector<std::vector<int32_t>>& expect_rows) {
+        Columns key_cols;
+        for (auto& key : keys) {
+            key_cols.push_back(ColumnTestHelper::build_column<int32_t>({key}));
+        }
+        auto chunk_iter_or = state_table->prefix_scan(key_cols, 0);
+        ASSERT_TRUE(chunk_iter_or.ok());
+        auto chunk_iter = chunk_iter_or.value();
+        ChunkPtr chunk = ChunkHelper::new_chunk(chunk_iter->schema(), 1);
+        ASSERT_TRUE(chunk_iter->get_next(chunk.get()).ok());
+        ASSERT_TRUE(chunk_iter->get_next(chunk.get()).is_end_of_file());
+        chunk_iter->close();
+        ASSERT_EQ(chunk->num_rows(), expect_rows.size());
+        for (size_t i = 0; i < expect_rows.size(); i++) {
+            _check_row(chunk, expect_rows[i], i);
+        }
+    }
+
+private:
+    void _check_row(const ChunkPtr& chunk, const std::vector<int32_t>& ans, size_t row_idx) {
+        ASSERT_EQ(chunk->num_columns(), ans.size());
+        for (size_t i = 0; i < ans.size(); i++) {
+            ASSERT_EQ(chunk->get_column_by_index(i)->get(row_idx).get_int32(), ans[i]);
+        }
+    }
+
+protected:
+    RuntimeState* _runtime_state;
+    ObjectPool _obj_pool;
+    DescriptorTbl* _tbl;
+};
+
+TEST_F(KVStateTableTest, TestSeekKey) {
+    auto state_table = open_state_table(1);
+    check_seek(state_table.get(), {1}, {}, {false});
+
+    auto chunk_ptr = MakeStreamChunk<int32_t>({{1, 2, 3}, {1, 2, 3}, {1, 2, 3}, {11, 12, 13}}, {0, 0, 0});
+    ASSERT_TRUE(state_table->write(_runtime_state, chunk_ptr).ok());
+    check_seek(state_table.get(), {3, 4, 1}, {{3, 3, 13}, {1, 1, 11}}, {true, false, true});
+
+    // committed rows are seeked from RocksDB.
+    ASSERT_TRUE(state_table->commit(_runtime_state).ok());
+    ASSERT_EQ(state_table->write_buffer_bytes(), 0);
+    check_seek(state_table.get(), {3, 4, 1}, {{3, 3, 13}, {1, 1, 11}}, {true, false, true});
+
+    // update and delete keys
+    auto chunk_ptr2 = MakeStreamChunk<int32_t>({{1, 2, 3}, {1, 2, 3}, {1, 2, 3}, {21, 22, 23}}, {3, 1, 0});
+    ASSERT_TRUE(state_table->write(_runtime_state, chunk_ptr2).ok());
+    check_seek(state_table.get(), {1, 2, 3}, {{1, 1, 21}, {3, 3, 23}}, {true, false, true});
+
+    // the selected keys only
+    Columns key_cols;
+    key_cols.push_back(ColumnTestHelper::build_column<int32_t>({1, 3}));
+    StateTableResult result;
+    ASSERT_TRUE(state_table->seek(key_cols, std::vector<uint8_t>{0, 1}, result).ok());
+    ASSERT_EQ(result.found, std::vector<bool>({false, true}));
+    ASSERT_EQ(result.result_chunk->num_rows(), 1);
+}
+
+TEST_F(KVStateTableTest, TestPrefixScan) {
+    auto state_table = open_state_table(3);
+    Columns key_cols;
+    key_cols.push_back(ColumnTestHelper::build_column<int32_t>({1}));
+    key_cols.push_back(ColumnTestHelper::build_column<int32_t>({1}));
+    ASSERT_TRUE(state_table->prefix_scan(key_cols, 0).status().is_end_of_file());
+
+    auto chunk_ptr = MakeStreamChunk<int32_t>({{1, 1, 1, 2}, {1, 1, 1, 1}, {1, 2, 3, 1}, {11, 12, 13, 14}},
+                                              {0, 0, 0, 0});
+    ASSERT_TRUE(state_table->write(_runtime_state, chunk_ptr).ok());
+    ASSERT_TRUE(state_table->commit(_runtime_state).ok());
+    check_prefix_scan(state_table.get(), {1, 1}, {{1, 11}, {2, 12}, {3, 13}});
+
+    // the rows in the write buffer override the committed ones.
+    auto chunk_ptr2 = MakeStreamChunk<int32_t>({{1, 1, 1}, {1, 1, 1}, {1, 2, 4}, {21, 22, 24}}, {0, 1, 0});
+    ASSERT_TRUE(state_table->write(_runtime_state, chunk_ptr2).ok());
+    check_prefix_scan(state_table.get(), {1, 1}, {{3, 13}, {1, 21}, {4, 24}});
+    check_prefix_scan(state_table.get(), {2}, {{1, 1, 14}});
+}
+
+TEST_F(KVStateTableTest, TestRecover) {
+    {
+        auto state_table = open_state_table(1);
+        auto chunk_ptr = MakeStreamChunk<int32_t>({{1, 2}, {1, 2}, {1, 2}, {11, 12}}, {0, 0});
+        ASSERT_TRUE(state_table->write(_runtime_state, chunk_ptr).ok());
+        ASSERT_TRUE(state_table->commit(_runtime_state).ok());
+
+        // the uncommitted rows are lost.
+        auto chunk_ptr2 = MakeStreamChunk<int32_t>({{3}, {3}, {3}, {13}}, {0});
+        ASSERT_TRUE(state_table->write(_runtime_state, chunk_ptr2).ok());
+    }
+    {
+        auto state_table = open_state_table(1);
+        check_seek(state_table.get(), {1, 2, 3}, {{1, 1, 11}, {2, 2, 12}}, {true, true, false});
+
+        auto chunk_ptr = MakeStreamChunk<int32_t>({{1}, {1}, {1}, {21}}, {0});
+        ASSERT_TRUE(state_table->write(_runtime_state, chunk_ptr).ok());
+        ASSERT_TRUE(state_table->reset_epoch(_runtime_state).ok());
+        check_seek(state_table.get(), {1}, {{1, 1, 11}}, {true});
+    }
+}
+
+} // namespace starrocks::stream
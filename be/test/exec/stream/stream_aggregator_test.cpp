@@ -661,6 +661,43 @@ TEST_F(MinMaxCountStreamAggregateTestWithRetract, TestWihRetracts_MultiRun2) {
     _stream_aggregator->close(_runtime_state);
 }
 
+TEST_F(MinMaxCountStreamAggregateTestWithRetract, TestWihRetracts_CancelledAndDuplicated) {
+    DCHECK_IF_ERROR(_stream_aggregator->prepare(_runtime_state, &_obj_pool, _runtime_profile));
+    DCHECK_IF_ERROR(_stream_aggregator->open(_runtime_state));
+
+    // Run 1
+    // Input:
+    // key  value
+    // 1    +5
+    // 1    +5
+    // 1    +3
+    // key  min max count op
+    // 1    3   5   3   0
+    RunBatchAndCheck(1, StreamRowData<int64_t>{{{1, 1, 1}, {5, 5, 3}}, {0, 0, 0}},
+                     StreamRowData<int64_t>{{{1}, {3}, {5}, {3}}, {0}});
+    // Run 2
+    // Input:
+    // key  value
+    // 1    -5   <---- the max is not changed because of the other 5
+    // 1    +7
+    // 1    -7   <---- cancelled with +7
+    // key  min max count op
+    // 1    3   5   3   UPDATE_BEFORE
+    // 1    3   5   2   UPDATE_AFTER
+    RunBatchAndCheck(2, StreamRowData<int64_t>{{{1, 1, 1}, {5, 7, 7}}, {1, 0, 1}},
+                     StreamRowData<int64_t>{{{1, 1}, {3, 3}, {5, 5}, {3, 2}}, {2, 3}});
+    // Run 3
+    // Input:
+    // key  value
+    // 1    -5
+    // key  min max count op
+    // 1    3   5   2   UPDATE_BEFORE
+    // 1    3   3   1   UPDATE_AFTER
+    RunBatchAndCheck(3, StreamRowData<int64_t>{{{1}, {5}}, {1}},
+                     StreamRowData<int64_t>{{{1, 1}, {3, 3}, {5, 3}, {2, 1}}, {2, 3}});
+    _stream_aggregator->close(_runtime_state);
+}
+
 ///////////////  All Aggregate Functions ///////////////
 class AllStreamAggregateFunctionsTestBase : public StreamAggregateTestBase {
 public:
@@ -0,0 +1,91 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/workgroup/scan_executor.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "exec/workgroup/scan_task_queue.h"
+#include "util/threadpool.h"
+
+namespace starrocks::workgroup {
+
+static std::unique_ptr<ScanExecutor> create_scan_executor(int num_threads, int max_elastic_threads) {
+    std::unique_ptr<ThreadPool> thread_pool;
+    CHECK(ThreadPoolBuilder("test_scan_io")
+                  .set_min_threads(0)
+                  .set_max_threads(num_threads + max_elastic_threads)
+                  .set_max_queue_size(1000)
+                  .build(&thread_pool)
+                  .ok());
+    auto executor = std::make_unique<ScanExecutor>(std::move(thread_pool), create_scan_task_queue());
+    executor->set_max_elastic_threads(max_elastic_threads);
+    executor->initialize(num_threads);
+    return executor;
+}
+
+static void run_sleep_tasks(ScanExecutor* executor, int num_tasks, std::atomic<int>* num_running,
+                            std::atomic<int>* max_num_running) {
+    std::atomic<int> num_finished = 0;
+    for (int i = 0; i < num_tasks; ++i) {
+        ASSERT_TRUE(executor->submit(ScanTask([&]() {
+            int curr = ++(*num_running);
+            int prev_max = max_num_running->load();
+            while (curr > prev_max && !max_num_running->compare_exchange_weak(prev_max, curr)) {
+            }
+            // Simulate the blocking IO.
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            --(*num_running);
+            ++num_finished;
+        })));
+    }
+    while (num_finished < num_tasks) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+}
+
+TEST(ScanExecutorTest, test_elastic_threads_for_io_bound_tasks) {
+    auto executor = create_scan_executor(1, 2);
+
+    std::atomic<int> num_running = 0;
+    std::atomic<int> max_num_running = 0;
+    // The first task marks the only worker thread as IO-bound.
+    run_sleep_tasks(executor.get(), 1, &num_running, &max_num_running);
+    ASSERT_EQ(1, max_num_running);
+    while (executor->num_io_bound_threads() == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    // Extra threads are started to run the queued tasks, but no more than the max elastic threads.
+    max_num_running = 0;
+    run_sleep_tasks(executor.get(), 8, &num_running, &max_num_running);
+    ASSERT_GE(max_num_running, 2);
+    ASSERT_LE(max_num_running, 3);
+    ASSERT_LE(executor->num_elastic_threads(), 2);
+}
+
+TEST(ScanExecutorTest, test_elastic_threads_disabled) {
+    auto executor = create_scan_executor(1, 0);
+
+    std::atomic<int> num_running = 0;
+    std::atomic<int> max_num_running = 0;
+    run_sleep_tasks(executor.get(), 1, &num_running, &max_num_running);
+    run_sleep_tasks(executor.get(), 4, &num_running, &max_num_running);
+    ASSERT_EQ(1, max_num_running);
+    ASSERT_EQ(0, executor->num_elastic_threads());
+}
+
+} // namespace starrocks::workgroup
@@ -21,6 +21,7 @@
 #include "exec/pipeline/pipeline_fwd.h"
 #include "exec/workgroup/work_group.h"
 #include "testutil/parallel_test.h"
+#include "util/defer_op.h"
 
 namespace starrocks::workgroup {
 
@@ -120,4 +121,50 @@ PARALLEL_TEST(MultiLevelFeedScanTaskQueueTest, test_take_close) {
     consumer_thread.join();
 }
 
+TEST(DiskAwareScanTaskQueueTest, test_max_in_flight_tasks_per_disk) {
+    const int64_t prev_max_in_flight_tasks = config::pipeline_scan_max_in_flight_tasks_per_disk;
+    config::pipeline_scan_max_in_flight_tasks_per_disk = 1;
+    DeferOp defer([&] { config::pipeline_scan_max_in_flight_tasks_per_disk = prev_max_in_flight_tasks; });
+
+    DiskAwareScanTaskQueue queue("test", std::make_unique<PriorityScanTaskQueue>(100));
+    auto create_task = [](int priority, int64_t io_device_id) {
+        ScanTask task;
+        task.priority = priority;
+        task.io_device_id = io_device_id;
+        return task;
+    };
+
+    ASSERT_TRUE(queue.try_offer(create_task(4, 1)));
+    ASSERT_TRUE(queue.try_offer(create_task(3, 1)));
+    ASSERT_TRUE(queue.try_offer(create_task(2, 2)));
+    ASSERT_TRUE(queue.try_offer(create_task(1, -1)));
+    ASSERT_EQ(4, queue.size());
+    ASSERT_EQ(2, queue.device_queue_depth(1));
+    ASSERT_EQ(1, queue.device_queue_depth(2));
+
+    // The second task of device 1 is pended, so the task of device 2 and the task without device go first.
+    std::vector<ScanTask> running_tasks;
+    for (int expected_priority : {4, 2, 1}) {
+        auto maybe_task = queue.take();
+        ASSERT_TRUE(maybe_task.ok());
+        ASSERT_EQ(expected_priority, maybe_task.value().priority);
+        running_tasks.emplace_back(std::move(maybe_task.value()));
+    }
+    ASSERT_EQ(1, queue.size());
+
+    // Finishing the task of device 1 releases its pending task.
+    queue.update_statistics(running_tasks[0], 1'000'000L);
+    ASSERT_EQ(1, queue.device_queue_depth(1));
+    auto maybe_task = queue.take();
+    ASSERT_TRUE(maybe_task.ok());
+    ASSERT_EQ(3, maybe_task.value().priority);
+
+    for (auto* task : {&maybe_task.value(), &running_tasks[1], &running_tasks[2]}) {
+        queue.update_statistics(*task, 1'000'000L);
+    }
+    ASSERT_EQ(0, queue.size());
+    ASSERT_EQ(0, queue.device_queue_depth(1));
+    ASSERT_EQ(0, queue.device_queue_depth(2));
+}
+
 } // namespace starrocks::workgroup
@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <optional>
 
 #include "column/array_column.h"
 #include "column/column_builder.h"
@@ -24,8 +25,10 @@
 #include "column/vectorized_fwd.h"
 #include "exprs/agg/aggregate_factory.h"
 #include "exprs/agg/any_value.h"
+#include "exprs/agg/distinct.h"
 #include "exprs/agg/maxmin.h"
 #include "exprs/agg/nullable_aggregate.h"
+#include "exprs/agg/percentile_ddsketch.h"
 #include "exprs/agg/sum.h"
 #include "exprs/anyval_util.h"
 #include "exprs/arithmetic_operation.h"
@@ -913,6 +916,70 @@ TEST_F(AggregateTest, test_sum_distinct) {
                                                       DecimalV2Value(21));
 }
 
+TEST_F(AggregateTest, test_count_distinct2) {
+    const AggregateFunction* func = get_aggregate_function("multi_distinct_count2", TYPE_SMALLINT, TYPE_BIGINT, false);
+    test_agg_function<int16_t, int64_t>(ctx, func, 1024, 1000, 2024);
+
+    func = get_aggregate_function("multi_distinct_count2", TYPE_INT, TYPE_BIGINT, false);
+    test_agg_function<int32_t, int64_t>(ctx, func, 1024, 1000, 2024);
+
+    func = get_aggregate_function("multi_distinct_count2", TYPE_BIGINT, TYPE_BIGINT, false);
+    test_agg_function<int64_t, int64_t>(ctx, func, 1024, 1000, 2024);
+
+    func = get_aggregate_function("multi_distinct_count2", TYPE_LARGEINT, TYPE_BIGINT, false);
+    test_agg_function<int128_t, int64_t>(ctx, func, 1024, 1000, 2024);
+}
+
+TEST_F(AggregateTest, test_sum_distinct2) {
+    const AggregateFunction* func = get_aggregate_function("multi_distinct_sum2", TYPE_SMALLINT, TYPE_BIGINT, false);
+    test_agg_function<int16_t, int64_t>(ctx, func, 523776, 2499500, 3023276);
+
+    func = get_aggregate_function("multi_distinct_sum2", TYPE_INT, TYPE_BIGINT, false);
+    test_agg_function<int32_t, int64_t>(ctx, func, 523776, 2499500, 3023276);
+
+    func = get_aggregate_function("multi_distinct_sum2", TYPE_BIGINT, TYPE_BIGINT, false);
+    test_agg_function<int64_t, int64_t>(ctx, func, 523776, 2499500, 3023276);
+}
+
+TEST_F(AggregateTest, test_bitmap_distinct_state) {
+    using BitmapState = BitmapDistinctAggregateState<TYPE_INT, TYPE_BIGINT>;
+    using HashSetState = DistinctAggregateStateV2<TYPE_INT, TYPE_BIGINT>;
+
+    // few values are kept in the sorted array, the negative ones are kept in the bitmap too
+    for (int32_t num_values : {10, 1000}) {
+        BitmapState bitmap_state;
+        HashSetState hash_set_state;
+        int64_t sum = 0;
+        for (int32_t i = 0; i < num_values; i++) {
+            int32_t value = (i % 2 == 0) ? i : -i;
+            bitmap_state.update(value);
+            bitmap_state.update(value);
+            hash_set_state.update(value);
+            sum += value;
+        }
+        ASSERT_EQ(num_values > BitmapState::kMaxSortedValues, bitmap_state.bitmap != nullptr);
+        ASSERT_EQ(num_values, bitmap_state.disctint_count());
+        ASSERT_EQ(sum, bitmap_state.sum_distinct());
+        ASSERT_EQ(hash_set_state.serialize_size(), bitmap_state.serialize_size());
+
+        // the serialized states are exchangeable
+        std::vector<uint8_t> buffer(bitmap_state.serialize_size());
+        bitmap_state.serialize(buffer.data());
+        HashSetState merged_hash_set_state;
+        merged_hash_set_state.deserialize_and_merge(buffer.data(), buffer.size());
+        ASSERT_EQ(num_values, merged_hash_set_state.disctint_count());
+        ASSERT_EQ(sum, merged_hash_set_state.sum_distinct());
+
+        buffer.assign(hash_set_state.serialize_size(), 0);
+        hash_set_state.serialize(buffer.data());
+        BitmapState merged_bitmap_state;
+        merged_bitmap_state.update(num_values);
+        merged_bitmap_state.deserialize_and_merge(buffer.data(), buffer.size());
+        ASSERT_EQ(num_values + 1, merged_bitmap_state.disctint_count());
+        ASSERT_EQ(sum + num_values, merged_bitmap_state.sum_distinct());
+    }
+}
+
 TEST_F(AggregateTest, test_decimal_multi_distinct_sum) {
     {
         const auto* func = get_aggregate_function("decimal_multi_distinct_sum", TYPE_DECIMAL32, TYPE_DECIMAL128, false,
@@ -1269,6 +1336,58 @@ TEST_F(AggregateTest, test_percentile_cont) {
     ASSERT_EQ(3, result_column->get_data()[0]);
 }
 
+TEST_F(AggregateTest, test_percentile_ddsketch) {
+    const AggregateFunction* func = get_aggregate_function("percentile_ddsketch", TYPE_DOUBLE, TYPE_DOUBLE, false);
+    const AggregateFunction* state_func = get_aggregate_function("ddsketch_state", TYPE_DOUBLE, TYPE_VARBINARY, false);
+    const AggregateFunction* union_func =
+            get_aggregate_function("ddsketch_union", TYPE_VARBINARY, TYPE_VARBINARY, false);
+    ASSERT_NE(nullptr, func);
+    ASSERT_NE(nullptr, state_func);
+    ASSERT_NE(nullptr, union_func);
+
+    auto data_column1 = DoubleColumn::create();
+    auto data_column2 = DoubleColumn::create();
+    for (int i = 1; i <= 1000; i++) {
+        data_column1->append(i);
+        data_column2->append(i + 1000);
+    }
+    auto const_column = ColumnHelper::create_const_column<TYPE_DOUBLE>(0.5, 1);
+    const Column* raw_columns1[] = {data_column1.get(), const_column.get()};
+    const Column* raw_columns2[] = {data_column2.get(), const_column.get()};
+
+    // percentile_ddsketch merged from two states
+    auto state1 = ManagedAggrState::create(ctx, func);
+    auto state2 = ManagedAggrState::create(ctx, func);
+    func->update_batch_single_state(ctx, data_column1->size(), raw_columns1, state1->state());
+    func->update_batch_single_state(ctx, data_column2->size(), raw_columns2, state2->state());
+    ColumnPtr serde_column = BinaryColumn::create();
+    func->serialize_to_column(ctx, state1->state(), serde_column.get());
+    func->merge(ctx, serde_column.get(), state2->state(), 0);
+    auto result_column = DoubleColumn::create();
+    func->finalize_to_column(ctx, state2->state(), result_column.get());
+    ASSERT_NEAR(1000, result_column->get_data()[0], 1000 * DDSketch::kRelativeAccuracy);
+
+    // the sketches of ddsketch_state merged by ddsketch_union are the same as the sketch of all the values
+    auto sketch_column = BinaryColumn::create();
+    for (const Column** columns : {raw_columns1, raw_columns2}) {
+        auto state = ManagedAggrState::create(ctx, state_func);
+        state_func->update_batch_single_state(ctx, data_column1->size(), columns, state->state());
+        state_func->finalize_to_column(ctx, state->state(), sketch_column.get());
+    }
+    const Column* union_columns[] = {sketch_column.get()};
+    auto union_state = ManagedAggrState::create(ctx, union_func);
+    union_func->update_batch_single_state(ctx, sketch_column->size(), union_columns, union_state->state());
+    auto union_column = BinaryColumn::create();
+    union_func->finalize_to_column(ctx, union_state->state(), union_column.get());
+
+    DDSketch sketch;
+    sketch.add_batch(data_column1->get_data().data(), data_column1->size());
+    sketch.add_batch(data_column2->get_data().data(), data_column2->size());
+    std::string expected(sketch.serialize_size(), '\0');
+    sketch.serialize((uint8_t*)expected.data());
+    ASSERT_EQ(expected, union_column->get_slice(0).to_string());
+}
+
 TEST_F(AggregateTest, test_intersect_count) {
     const AggregateFunction* group_concat_function =
             get_aggregate_function("intersect_count", TYPE_INT, TYPE_BIGINT, false);
@@ -1491,6 +1610,61 @@ void test_non_deterministic_agg_function(FunctionContext* ctx, const AggregateFu
     ASSERT_EQ(final_result_column->get_data()[0], result_column1->get_data()[0]);
 }
 
+TEST_F(AggregateTest, test_maxmin_sliding_window) {
+    // rows between 2 preceding and 1 following
+    const int64_t rows_start_offset = -2;
+    const int64_t rows_end_offset = 1;
+    const std::vector<int32_t> values = {5, 3, 3, 8, 1, 1, 7, 2, 9, 9, 4, 6, 0, 3, 3, 5};
+
+    auto data_column = Int32Column::create();
+    auto null_column = NullColumn::create();
+    for (size_t i = 0; i < values.size(); i++) {
+        data_column->append(values[i]);
+        // some of the frames have only null values
+        null_column->append(i % 5 == 2 || (i >= 12 && i <= 14));
+    }
+    auto column = NullableColumn::create(std::move(data_column), std::move(null_column));
+    const Column* raw_column = column.get();
+    const auto n = static_cast<int64_t>(values.size());
+
+    for (bool is_max : {true, false}) {
+        const AggregateFunction* func = get_window_function(is_max ? "max_sliding" : "min_sliding", TYPE_INT, TYPE_INT,
+                                                            true, TFunctionBinaryType::BUILTIN, 3);
+        ASSERT_NE(nullptr, func);
+        auto state = ManagedAggrState::create(ctx, func);
+        func->reset(ctx, {}, state->state());
+        auto result = NullableColumn::create(Int32Column::create(), NullColumn::create());
+        result->resize(n);
+
+        for (int64_t i = 0; i < n; i++) {
+            func->update_state_removable_cumulatively(ctx, state->state(), &raw_column, i, 0, n, rows_start_offset,
+                                                      rows_end_offset, false, false);
+            func->get_values(ctx, state->state(), result.get(), i, i + 1);
+
+            std::optional<int32_t> expected;
+            for (int64_t j = std::max<int64_t>(0, i + rows_start_offset); j <= std::min(n - 1, i + rows_end_offset);
+                 j++) {
+                if (column->is_null(j)) {
+                    continue;
+                }
+                if (!expected) {
+                    expected = values[j];
+                } else {
+                    expected = is_max ? std::max(*expected, values[j]) : std::min(*expected, values[j]);
+                }
+            }
+            ASSERT_EQ(!expected.has_value(), result->is_null(i)) << "row " << i;
+            if (expected) {
+                ASSERT_EQ(*expected, result->data_column()->get(i).get_int32()) << "row " << i;
+            }
+        }
+    }
+
+    // float types are evaluated frame by frame
+    ASSERT_EQ(nullptr, get_window_function("max_sliding", TYPE_DOUBLE, TYPE_DOUBLE, true,
+                                           TFunctionBinaryType::BUILTIN, 3));
+}
+
 TEST_F(AggregateTest, test_any_value) {
     const AggregateFunction* func = get_aggregate_function("any_value", TYPE_SMALLINT, TYPE_SMALLINT, false);
     test_non_deterministic_agg_function<int16_t, int16_t>(ctx, func);
@@ -4671,6 +4671,45 @@ TEST_F(ArrayFunctionsTest, array_filter_with_onlynull) {
     ASSERT_TRUE(null_data.data()[1]);
 }
 
+TEST_F(ArrayFunctionsTest, array_filter_aligned) {
+    auto src_column = ColumnHelper::create_column(TYPE_ARRAY_INT, true);
+    src_column->append_datum(DatumArray{1, 2});
+    src_column->append_datum(DatumArray{3});
+    src_column->append_datum(Datum());
+    src_column->append_datum(DatumArray{4, 5});
+
+    // the filter arrays of the same offsets as the source arrays
+    auto bool_column = ColumnHelper::create_column(TYPE_ARRAY_BOOLEAN, false);
+    bool_column->append_datum(DatumArray{true, Datum()});
+    bool_column->append_datum(DatumArray{false});
+    bool_column->append_datum(DatumArray{});
+    bool_column->append_datum(DatumArray{true, true});
+
+    ArrayFilter filter;
+    auto dest_column = filter.process(nullptr, {src_column, bool_column});
+    ASSERT_EQ(4, dest_column->size());
+    _check_array<int32_t>({1}, dest_column->get(0).get_array());
+    ASSERT_TRUE(dest_column->get(1).get_array().empty());
+    ASSERT_TRUE(dest_column->get(2).is_null());
+    _check_array<int32_t>({4, 5}, dest_column->get(3).get_array());
+
+    // all the elements are selected, the source elements are shared
+    auto all_true = ColumnHelper::create_column(TYPE_ARRAY_BOOLEAN, false);
+    all_true->append_datum(DatumArray{true, true});
+    all_true->append_datum(DatumArray{true});
+    all_true->append_datum(DatumArray{});
+    all_true->append_datum(DatumArray{true, true});
+    dest_column = filter.process(nullptr, {src_column, all_true});
+    ASSERT_EQ(4, dest_column->size());
+    _check_array<int32_t>({1, 2}, dest_column->get(0).get_array());
+    _check_array<int32_t>({3}, dest_column->get(1).get_array());
+    ASSERT_TRUE(dest_column->get(2).is_null());
+    _check_array<int32_t>({4, 5}, dest_column->get(3).get_array());
+    auto* src_array = down_cast<ArrayColumn*>(down_cast<NullableColumn*>(src_column.get())->data_column().get());
+    auto* dest_array = down_cast<ArrayColumn*>(down_cast<NullableColumn*>(dest_column.get())->data_column().get());
+    ASSERT_EQ(src_array->elements_column().get(), dest_array->elements_column().get());
+}
+
 TEST_F(ArrayFunctionsTest, array_distinct_only_null) {
     // test only null
     {
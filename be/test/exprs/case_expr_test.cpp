@@ -24,7 +24,9 @@
 #include "column/column_helper.h"
 #include "column/column_viewer.h"
 #include "column/fixed_length_column.h"
+#include "common/config.h"
 #include "common/object_pool.h"
+#include "exprs/column_ref.h"
 #include "exprs/mock_vectorized_expr.h"
 #include "runtime/mem_pool.h"
 #include "types/logical_type.h"
@@ -565,4 +567,47 @@ TEST_F(VectorizedCaseExprTest, NoCaseWhenNullReturnIntElse) {
     }
 }
 
+TEST_F(VectorizedCaseExprTest, NoCaseSelectiveThen) {
+    auto values = Int32Column::create();
+    auto conditions = BooleanColumn::create();
+    for (int i = 0; i < 10; ++i) {
+        values->append(i);
+        conditions->append(i % 4 == 0);
+    }
+    Chunk chunk;
+    chunk.append_column(values, 1);
+    chunk.append_column(conditions, 2);
+
+    expr_node.child_type = TPrimitiveType::INT;
+    expr_node.type = gen_type_desc(TPrimitiveType::INT);
+    expr_node.node_type = TExprNodeType::CASE_EXPR;
+    expr_node.case_expr.has_case_expr = false;
+    expr_node.case_expr.has_else_expr = true;
+    std::unique_ptr<Expr> expr(VectorizedCaseExprFactory::from_thrift(expr_node));
+
+    ColumnRef when(TypeDescriptor(TYPE_BOOLEAN), 2);
+    ColumnRef value(TypeDescriptor(TYPE_INT), 1);
+    expr_node.node_type = TExprNodeType::FUNCTION_CALL;
+    MockPlusOneExpr then(expr_node);
+    then.add_child(&value);
+    expr->_children.push_back(&when);
+    expr->_children.push_back(&then);
+    expr->_children.push_back(&value);
+
+    for (bool selective : {true, false}) {
+        config::enable_selective_branch_evaluation = selective;
+        then.evaluated_rows = 0;
+        ColumnPtr ptr = expr->evaluate(nullptr, &chunk);
+        ASSERT_EQ(selective ? 3 : 10, static_cast<int>(then.evaluated_rows));
+
+        ColumnViewer<TYPE_INT> viewer(ptr);
+        ASSERT_EQ(10, viewer.size());
+        for (int i = 0; i < 10; ++i) {
+            ASSERT_FALSE(viewer.is_null(i));
+            ASSERT_EQ(i % 4 == 0 ? i + 1 : i, viewer.value(i));
+        }
+    }
+    config::enable_selective_branch_evaluation = true;
+}
+
 } // namespace starrocks
@@ -19,11 +19,14 @@
 
 #include <random>
 
+#include "column/chunk.h"
 #include "column/column_helper.h"
 #include "column/column_viewer.h"
 #include "column/fixed_length_column.h"
 #include "column/type_traits.h"
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
+#include "exprs/column_ref.h"
 #include "exprs/mock_vectorized_expr.h"
 #include "gen_cpp/Exprs_types.h"
 #include "gutil/casts.h"
@@ -329,4 +332,47 @@ TEST_F(VectorizedConditionExprTest, ifExpr) {
     }
 }
 
+TEST_F(VectorizedConditionExprTest, ifSelectiveBranch) {
+    auto values = Int32Column::create();
+    auto conditions = NullableColumn::create(BooleanColumn::create(), NullColumn::create());
+    for (int i = 0; i < 10; ++i) {
+        values->append(i);
+        if (i == 9) {
+            conditions->append_nulls(1);
+        } else {
+            conditions->append_datum(Datum(static_cast<uint8_t>(i % 3 != 0)));
+        }
+    }
+    Chunk chunk;
+    chunk.append_column(values, 1);
+    chunk.append_column(conditions, 2);
+
+    expr_node.type = gen_type_desc(TPrimitiveType::INT);
+    auto expr = std::unique_ptr<Expr>(VectorizedConditionExprFactory::create_if_expr(expr_node));
+    ColumnRef condition(TypeDescriptor(TYPE_BOOLEAN), 2);
+    ColumnRef value(TypeDescriptor(TYPE_INT), 1);
+    expr_node.node_type = TExprNodeType::FUNCTION_CALL;
+    MockPlusOneExpr plus_one(expr_node);
+    plus_one.add_child(&value);
+    // IF(c, v, v + 1), the ELSE is of the rows 0, 3, 6 and 9.
+    expr->_children.push_back(&condition);
+    expr->_children.push_back(&value);
+    expr->_children.push_back(&plus_one);
+
+    for (bool selective : {true, false}) {
+        config::enable_selective_branch_evaluation = selective;
+        plus_one.evaluated_rows = 0;
+        ColumnPtr ptr = expr->evaluate(nullptr, &chunk);
+        ASSERT_EQ(selective ? 4 : 10, static_cast<int>(plus_one.evaluated_rows));
+
+        ColumnViewer<TYPE_INT> viewer(ptr);
+        ASSERT_EQ(10, viewer.size());
+        for (int i = 0; i < 10; ++i) {
+            ASSERT_FALSE(viewer.is_null(i));
+            ASSERT_EQ(i % 3 == 0 ? i + 1 : i, viewer.value(i));
+        }
+    }
+    config::enable_selective_branch_evaluation = true;
+}
+
 } // namespace starrocks
@@ -2971,6 +2971,44 @@ TEST_F(DecimalBinaryFunctionTest, test_decimal128p38s14_div_decimal128p38s14_eq_
                                                                      overflows);
 }
 
+TEST_F(DecimalBinaryFunctionTest, test_decimal128p38s0_add_sub_overflow) {
+    DecimalOverflowTestCaseArray add_cases = {
+            {"90000000000000000000000000000000000000", "90000000000000000000000000000000000000", "0", true},
+            {"-90000000000000000000000000000000000000", "-90000000000000000000000000000000000000", "0", true},
+            {"90000000000000000000000000000000000000", "-90000000000000000000000000000000000000", "0", false},
+            {"80000000000000000000000000000000000000", "10000000000000000000000000000000000000",
+             "90000000000000000000000000000000000000", false},
+            {"-1", "1", "0", false}};
+    DecimalOverflowTestCaseArray sub_cases = {
+            {"90000000000000000000000000000000000000", "-90000000000000000000000000000000000000", "0", true},
+            {"-90000000000000000000000000000000000000", "90000000000000000000000000000000000000", "0", true},
+            {"90000000000000000000000000000000000000", "90000000000000000000000000000000000000", "0", false},
+            {"-80000000000000000000000000000000000000", "10000000000000000000000000000000000000",
+             "-90000000000000000000000000000000000000", false},
+            {"-1", "1", "-2", false}};
+    auto split = [](const DecimalOverflowTestCaseArray& test_cases, DecimalTestCaseArray* test_case_array,
+                    std::vector<bool>* overflows) {
+        for (auto& tc : test_cases) {
+            test_case_array->emplace_back(std::get<0>(tc), std::get<1>(tc), std::get<2>(tc));
+            overflows->emplace_back(std::get<3>(tc));
+        }
+    };
+    {
+        DecimalTestCaseArray test_case_array;
+        std::vector<bool> overflows;
+        split(add_cases, &test_case_array, &overflows);
+        test_vector_vector_assert_overflow<TYPE_DECIMAL128, AddOp, true>(test_case_array, 38, 0, 38, 0, 38, 0,
+                                                                         overflows);
+    }
+    {
+        DecimalTestCaseArray test_case_array;
+        std::vector<bool> overflows;
+        split(sub_cases, &test_case_array, &overflows);
+        test_vector_vector_assert_overflow<TYPE_DECIMAL128, SubOp, true>(test_case_array, 38, 0, 38, 0, 38, 0,
+                                                                         overflows);
+    }
+}
+
 template <LogicalType LhsType, LogicalType RhsType, LogicalType ResultType, typename Op>
 void test_decimal_fast_mul_help(const DecimalTestCaseArray& test_cases, int lhs_precision, int lhs_scale,
                                 int rhs_precision, int rhs_scale, int result_precision, int result_scale) {
@@ -0,0 +1,169 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "exprs/fused_arithmetic_expr.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+
+#include "column/chunk.h"
+#include "column/column_helper.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "common/object_pool.h"
+#include "exprs/arithmetic_expr.h"
+#include "exprs/binary_predicate.h"
+#include "exprs/column_ref.h"
+#include "exprs/literal.h"
+#include "testutil/assert.h"
+
+namespace starrocks {
+
+class FusedArithmeticExprTest : public ::testing::Test {
+protected:
+    Expr* arithmetic(TExprOpcode::type op, TPrimitiveType::type type, Expr* lhs, Expr* rhs) {
+        TExprNode node;
+        node.node_type = TExprNodeType::ARITHMETIC_EXPR;
+        node.opcode = op;
+        node.__isset.opcode = true;
+        node.type = gen_type_desc(type);
+        node.num_children = 2;
+        Expr* expr = _pool.add(VectorizedArithmeticExprFactory::from_thrift(node));
+        expr->add_child(lhs);
+        expr->add_child(rhs);
+        return expr;
+    }
+
+    Expr* compare(TExprOpcode::type op, TPrimitiveType::type type, Expr* lhs, Expr* rhs) {
+        TExprNode node;
+        node.node_type = TExprNodeType::BINARY_PRED;
+        node.opcode = op;
+        node.__isset.opcode = true;
+        node.child_type = type;
+        node.__isset.child_type = true;
+        node.type = gen_type_desc(TPrimitiveType::BOOLEAN);
+        node.num_children = 2;
+        Expr* expr = _pool.add(VectorizedBinaryPredicateFactory::from_thrift(node));
+        expr->add_child(lhs);
+        expr->add_child(rhs);
+        return expr;
+    }
+
+    Expr* slot(LogicalType type, SlotId id) { return _pool.add(new ColumnRef(TypeDescriptor(type), id)); }
+
+    void assert_same_result(Expr* fused, Chunk* chunk) {
+        ASSERT_EQ(TExprNodeType::FUSED_EXPR, fused->node_type());
+        ASSERT_OK(fused->prepare(nullptr, nullptr));
+        ASSIGN_OR_ABORT(auto actual, fused->evaluate_checked(nullptr, chunk));
+        ASSIGN_OR_ABORT(auto expected, fused->get_child(0)->evaluate_checked(nullptr, chunk));
+        ASSERT_EQ(expected->size(), actual->size());
+        for (size_t i = 0; i < expected->size(); i++) {
+            ASSERT_EQ(expected->debug_item(i), actual->debug_item(i)) << "row " << i;
+        }
+    }
+
+    ObjectPool _pool;
+};
+
+// (a * b + c) / d > e
+// NOLINTNEXTLINE
+TEST_F(FusedArithmeticExprTest, test_double_predicate) {
+    const size_t num_rows = 1000;
+    auto chunk = std::make_shared<Chunk>();
+    for (SlotId id = 1; id <= 5; id++) {
+        auto data = DoubleColumn::create();
+        auto nulls = NullColumn::create();
+        for (size_t i = 0; i < num_rows; i++) {
+            // zeros to divide by and -0 products
+            data->append(static_cast<double>((i * id) % 7) - 2.5 * (id % 2));
+            nulls->append(id == 3 && i % 11 == 0);
+        }
+        if (id == 3) {
+            chunk->append_column(NullableColumn::create(std::move(data), std::move(nulls)), id);
+        } else {
+            chunk->append_column(std::move(data), id);
+        }
+    }
+
+    Expr* a_mul_b = arithmetic(TExprOpcode::MULTIPLY, TPrimitiveType::DOUBLE, slot(TYPE_DOUBLE, 1),
+                               slot(TYPE_DOUBLE, 2));
+    Expr* add_c = arithmetic(TExprOpcode::ADD, TPrimitiveType::DOUBLE, a_mul_b, slot(TYPE_DOUBLE, 3));
+    Expr* div_d = arithmetic(TExprOpcode::DIVIDE, TPrimitiveType::DOUBLE, add_c, slot(TYPE_DOUBLE, 4));
+    Expr* root = compare(TExprOpcode::GT, TPrimitiveType::DOUBLE, div_d, slot(TYPE_DOUBLE, 5));
+
+    Expr* fused = FusedArithmeticExpr::rewrite(&_pool, root);
+    assert_same_result(fused, chunk.get());
+    ASSIGN_OR_ABORT(auto result, fused->evaluate_checked(nullptr, chunk.get()));
+    ASSERT_TRUE(result->is_nullable());
+    ASSERT_TRUE(result->is_null(0));
+}
+
+// (a - 3) * b, with a constant and integer overflow
+// NOLINTNEXTLINE
+TEST_F(FusedArithmeticExprTest, test_int_arithmetic) {
+    const size_t num_rows = 600;
+    auto chunk = std::make_shared<Chunk>();
+    auto a = Int32Column::create();
+    auto b = Int32Column::create();
+    for (size_t i = 0; i < num_rows; i++) {
+        a->append(static_cast<int32_t>(i) * 1000003);
+        b->append(std::numeric_limits<int32_t>::max() - static_cast<int32_t>(i));
+    }
+    chunk->append_column(std::move(a), 1);
+    chunk->append_column(std::move(b), 2);
+
+    Expr* literal = _pool.add(new VectorizedLiteral(ColumnHelper::create_const_column<TYPE_INT>(3, 1),
+                                                    TypeDescriptor(TYPE_INT)));
+    Expr* sub = arithmetic(TExprOpcode::SUBTRACT, TPrimitiveType::INT, slot(TYPE_INT, 1), literal);
+    Expr* root = arithmetic(TExprOpcode::MULTIPLY, TPrimitiveType::INT, sub, slot(TYPE_INT, 2));
+
+    Expr* fused = FusedArithmeticExpr::rewrite(&_pool, root);
+    assert_same_result(fused, chunk.get());
+    ASSIGN_OR_ABORT(auto result, fused->evaluate_checked(nullptr, chunk.get()));
+    ASSERT_FALSE(result->is_nullable());
+}
+
+// A single node isn't fused, while the fusable subtrees of the leaves are.
+// NOLINTNEXTLINE
+TEST_F(FusedArithmeticExprTest, test_rewrite) {
+    Expr* single = arithmetic(TExprOpcode::ADD, TPrimitiveType::BIGINT, slot(TYPE_BIGINT, 1), slot(TYPE_BIGINT, 2));
+    ASSERT_EQ(single, FusedArithmeticExpr::rewrite(&_pool, single));
+
+    // (mod((a + b) * c, d) + e) * f, the mod isn't fusable, but its first child is.
+    Expr* add = arithmetic(TExprOpcode::ADD, TPrimitiveType::INT, slot(TYPE_INT, 1), slot(TYPE_INT, 2));
+    Expr* mul = arithmetic(TExprOpcode::MULTIPLY, TPrimitiveType::INT, add, slot(TYPE_INT, 3));
+    Expr* mod = arithmetic(TExprOpcode::MOD, TPrimitiveType::INT, mul, slot(TYPE_INT, 4));
+    Expr* root = arithmetic(TExprOpcode::MULTIPLY, TPrimitiveType::INT,
+                            arithmetic(TExprOpcode::ADD, TPrimitiveType::INT, mod, slot(TYPE_INT, 5)),
+                            slot(TYPE_INT, 6));
+    Expr* rewritten = FusedArithmeticExpr::rewrite(&_pool, root);
+    ASSERT_EQ(TExprNodeType::FUSED_EXPR, rewritten->node_type());
+    ASSERT_EQ(root, rewritten->get_child(0));
+    ASSERT_EQ(TExprNodeType::FUSED_EXPR, mod->get_child(0)->node_type());
+    ASSERT_EQ(mul, mod->get_child(0)->get_child(0));
+
+    auto chunk = std::make_shared<Chunk>();
+    for (SlotId id = 1; id <= 6; id++) {
+        auto data = Int32Column::create();
+        for (int32_t i = 0; i < 300; i++) {
+            data->append(i % (id + 3) - 1);
+        }
+        chunk->append_column(std::move(data), id);
+    }
+    assert_same_result(rewritten, chunk.get());
+}
+
+} // namespace starrocks
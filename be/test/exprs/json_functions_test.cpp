@@ -23,6 +23,7 @@
 
 #include "butil/time.h"
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
 #include "common/status.h"
 #include "common/statusor.h"
 #include "exprs/mock_vectorized_expr.h"
@@ -136,6 +137,56 @@ TEST_F(JsonFunctionsTest, get_json_string_casting) {
                         .ok());
 }
 
+TEST_F(JsonFunctionsTest, get_json_ondemand) {
+    std::string jsons[] = {R"({"k1": 1, "k2": {"k3": [1, {"k4": "v4"}]}})",
+                           R"(  {"k1": -12.5, "k2": {"k3": [], "k4": null}})",
+                           R"({"k2": {"k3": [{"k4": [1,2]}, {"k4": "a\"b"}]}, "k1": "18"})",
+                           R"({"k1": 9223372036854775808, "k2": {"k3": [true, {"k4": ""}]}})",
+                           R"({"k1": 1e30, "k2": [{"k3": 1}]})",
+                           R"([{"k1": 1}, {"k2": 2}])",
+                           R"({"k1": "\u4e2d\u6587", "k2": {"k3": {"k4": "中文"}}})",
+                           R"("k1")",
+                           R"(k1)",
+                           R"({"k1": 1, "k2": )",
+                           R"()"};
+    std::string paths[] = {"$.k1", "k1", "$.k2.k3[1].k4", "$.k2.k3[0]", "$.k2.k3[5]", "$.k2.k4", "$.k2", "$",
+                           "$[1].k2", "$.k2[0].k3", "$.$.k1"};
+
+    for (const auto& path : paths) {
+        auto json_column = BinaryColumn::create();
+        for (const auto& json : jsons) {
+            json_column->append(json);
+        }
+        auto path_column = ColumnHelper::create_const_column<TYPE_VARCHAR>(Slice(path), json_column->size());
+        Columns columns{json_column, path_column};
+
+        std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
+        ctx->set_constant_columns(columns);
+        ASSERT_OK(JsonFunctions::native_json_path_prepare(ctx.get(), FunctionContext::FRAGMENT_LOCAL));
+        DeferOp defer([&]() {
+            ASSERT_OK(JsonFunctions::native_json_path_close(ctx.get(), FunctionContext::FRAGMENT_LOCAL));
+        });
+
+        for (auto fn : {&JsonFunctions::get_json_int, &JsonFunctions::get_json_double,
+                        &JsonFunctions::get_json_string}) {
+            config::enable_json_ondemand_extract = true;
+            ASSIGN_OR_ABORT(auto ondemand, fn(ctx.get(), columns));
+            config::enable_json_ondemand_extract = false;
+            ASSIGN_OR_ABORT(auto parsed, fn(ctx.get(), columns));
+            config::enable_json_ondemand_extract = true;
+
+            ASSERT_EQ(parsed->size(), ondemand->size());
+            for (size_t i = 0; i < parsed->size(); i++) {
+                // Only the malformed json may differ, since the unrequested fields are not validated.
+                if (i == 9) {
+                    continue;
+                }
+                ASSERT_EQ(parsed->debug_item(i), ondemand->debug_item(i)) << "json: " << jsons[i] << ", path: " << path;
+            }
+        }
+    }
+}
+
 TEST_F(JsonFunctionsTest, get_json_string_array) {
     std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
     Columns columns;
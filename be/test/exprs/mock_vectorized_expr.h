@@ -196,4 +196,24 @@ public:
     ColumnPtr col;
 };
 
+// Add one to the INT child, and record the number of the rows it's evaluated on.
+class MockPlusOneExpr : public Expr {
+public:
+    explicit MockPlusOneExpr(const TExprNode& t) : Expr(t) {}
+
+    StatusOr<ColumnPtr> evaluate_checked(ExprContext* context, Chunk* ptr) override {
+        ASSIGN_OR_RETURN(ColumnPtr child, _children[0]->evaluate_checked(context, ptr));
+        auto res = Int32Column::create();
+        for (int32_t v : ColumnHelper::cast_to_raw<TYPE_INT>(child)->get_data()) {
+            res->append(v + 1);
+        }
+        evaluated_rows += res->size();
+        return res;
+    }
+    Expr* clone(ObjectPool* pool) const override { return pool->add(new MockPlusOneExpr(*this)); }
+
+public:
+    size_t evaluated_rows = 0;
+};
+
 } // namespace starrocks
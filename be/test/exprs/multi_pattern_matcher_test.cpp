@@ -0,0 +1,58 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "exprs/multi_pattern_matcher.h"
+
+#include <gtest/gtest.h>
+
+#include "column/binary_column.h"
+#include "column/nullable_column.h"
+#include "testutil/assert.h"
+
+namespace starrocks {
+
+// NOLINTNEXTLINE
+TEST(MultiPatternMatcherTest, match) {
+    ASSIGN_OR_ABORT(auto matcher, MultiPatternMatcher::create({"%error%", "warn_", "a\\%b"}, {"^time[0-9]+$"}));
+
+    auto data = BinaryColumn::create();
+    auto nulls = NullColumn::create();
+    std::vector<std::pair<std::string, bool>> values = {
+            {"an error occurs", true}, {"warn1", true},  {"warn12", false}, {"a%b", true},   {"axb", false},
+            {"time123", true},         {"time", false},  {"", false},       {"ERROR", false}, {"warn1\n", false}};
+    for (const auto& [value, _] : values) {
+        data->append(Slice(value));
+        nulls->append(0);
+    }
+    data->append(Slice("error"));
+    nulls->append(1);
+    auto column = NullableColumn::create(data, nulls);
+
+    ASSIGN_OR_ABORT(auto result, matcher->match(column));
+    ASSERT_EQ(values.size() + 1, result->size());
+    for (size_t i = 0; i < values.size(); i++) {
+        ASSERT_FALSE(result->is_null(i)) << values[i].first;
+        ASSERT_EQ(values[i].second, result->get(i).get_uint8() != 0) << values[i].first;
+    }
+    ASSERT_TRUE(result->is_null(values.size()));
+}
+
+// NOLINTNEXTLINE
+TEST(MultiPatternMatcherTest, invalid_pattern) {
+    // back references are not supported by hyperscan
+    ASSERT_FALSE(MultiPatternMatcher::create({"%a%"}, {"(a)\\1"}).ok());
+}
+
+} // namespace starrocks
@@ -202,6 +202,85 @@ TEST_F(RuntimeFilterTest, TestJoinRuntimeFilterSerialize) {
     EXPECT_TRUE(rf1->check_equal(*rf0));
 }
 
+TEST_F(RuntimeFilterTest, TestJoinRuntimeFilterSerializeSparse) {
+    RuntimeBloomFilter<TYPE_INT> bf0;
+    JoinRuntimeFilter* rf0 = &bf0;
+    // 1MB filter with only a few values, which is folded and encoded sparsely.
+    bf0.init(1 << 20);
+    std::vector<int> values;
+    for (int i = 0; i < 100; i++) {
+        values.emplace_back(i * 7919);
+        bf0.insert(&values.back());
+    }
+
+    size_t max_size = RuntimeFilterHelper::max_runtime_filter_serialized_size(rf0);
+    std::vector<uint8_t> buffer(max_size, 0);
+    size_t actual_size = RuntimeFilterHelper::serialize_runtime_filter(rf0, buffer.data());
+    EXPECT_LT(actual_size, 8192);
+    buffer.resize(actual_size);
+
+    JoinRuntimeFilter* rf1 = nullptr;
+    ObjectPool pool;
+    RuntimeFilterHelper::deserialize_runtime_filter(&pool, &rf1, buffer.data(), actual_size);
+    ASSERT_NE(rf1, nullptr);
+    auto* bf1 = down_cast<RuntimeBloomFilter<TYPE_INT>*>(rf1);
+    EXPECT_EQ(bf1->min_value(), bf0.min_value());
+    EXPECT_EQ(bf1->max_value(), bf0.max_value());
+    for (int v : values) {
+        EXPECT_TRUE(bf1->_test_data(v));
+    }
+    size_t false_positives = 0;
+    for (int v = 1; v < 10000; v += 2) {
+        false_positives += bf1->_test_data(v * 7919 + 1);
+    }
+    EXPECT_LT(false_positives, 50);
+}
+
+TEST_F(RuntimeFilterTest, TestDenseBitsetRuntimeFilter) {
+    // the range is too large to be a bitset.
+    {
+        RuntimeBloomFilter<TYPE_BIGINT> bf;
+        EXPECT_FALSE(bf.init_dense_bitset(100, -1, 100000));
+        EXPECT_FALSE(bf.is_dense_bitset());
+    }
+    RuntimeBloomFilter<TYPE_BIGINT> bf0;
+    ASSERT_TRUE(bf0.init_dense_bitset(100, -100, 300));
+    EXPECT_TRUE(bf0.is_dense_bitset());
+    for (int64_t v = -100; v <= 300; v += 4) {
+        bf0.insert(&v);
+    }
+    EXPECT_EQ(bf0.min_value(), -100);
+    EXPECT_EQ(bf0.max_value(), 300);
+    // no false positives.
+    for (int64_t v = -200; v <= 400; v++) {
+        EXPECT_EQ(bf0._test_data(v), v >= -100 && v <= 300 && (v + 100) % 4 == 0) << v;
+    }
+
+    JoinRuntimeFilter* rf0 = &bf0;
+    size_t max_size = RuntimeFilterHelper::max_runtime_filter_serialized_size(rf0);
+    std::vector<uint8_t> buffer(max_size, 0);
+    size_t actual_size = RuntimeFilterHelper::serialize_runtime_filter(rf0, buffer.data());
+    buffer.resize(actual_size);
+
+    JoinRuntimeFilter* rf1 = nullptr;
+    ObjectPool pool;
+    RuntimeFilterHelper::deserialize_runtime_filter(&pool, &rf1, buffer.data(), actual_size);
+    ASSERT_NE(rf1, nullptr);
+    EXPECT_TRUE(rf1->check_equal(*rf0));
+
+    auto column = Int64Column::create();
+    for (int64_t v = -150; v < 350; v++) {
+        column->append(v);
+    }
+    JoinRuntimeFilter::RunningContext ctx;
+    ctx.use_merged_selection = false;
+    rf1->evaluate(column.get(), &ctx);
+    for (size_t i = 0; i < column->size(); i++) {
+        int64_t v = column->get_data()[i];
+        EXPECT_EQ(ctx.selection[i], v >= -100 && v <= 300 && (v + 100) % 4 == 0) << v;
+    }
+}
+
 TEST_F(RuntimeFilterTest, TestJoinRuntimeFilterSerialize2) {
     RuntimeBloomFilter<TYPE_INT> bf0;
     JoinRuntimeFilter* rf0 = &bf0;
@@ -608,6 +687,43 @@ TEST_F(RuntimeFilterTest, TestGlobalRuntimeFilterMinMax) {
     EXPECT_EQ(global->max_value(), 33);
 }
 
+TEST_F(RuntimeFilterTest, TestConcatMergedPartitionedRuntimeFilters) {
+    RuntimeBloomFilter<TYPE_INT> prototype;
+    ObjectPool pool;
+    auto create_local = [](int i) {
+        auto local = std::make_unique<RuntimeBloomFilter<TYPE_INT>>();
+        local->init(10);
+        for (int j = 0; j < 4; j++) {
+            int value = (i + 1) * 10 + j;
+            local->insert(&value);
+        }
+        return local;
+    };
+
+    // concatenate the partitioned rfs directly.
+    RuntimeBloomFilter<TYPE_INT>* expected = prototype.create_empty(&pool);
+    for (int i = 0; i < 4; i++) {
+        auto local = create_local(i);
+        expected->concat(local.get());
+    }
+
+    // concatenate the partitioned rfs merged by two intermediate merge nodes.
+    RuntimeBloomFilter<TYPE_INT>* global = prototype.create_empty(&pool);
+    for (int k = 0; k < 2; k++) {
+        RuntimeBloomFilter<TYPE_INT>* merged = prototype.create_empty(&pool);
+        for (int i = k * 2; i < k * 2 + 2; i++) {
+            auto local = create_local(i);
+            merged->concat(local.get());
+        }
+        global->concat(merged);
+    }
+
+    EXPECT_EQ(global->num_hash_partitions(), 4);
+    EXPECT_EQ(global->min_value(), 10);
+    EXPECT_EQ(global->max_value(), 43);
+    EXPECT_TRUE(global->check_equal(*expected));
+}
+
 void TestMultiColumnsOnRuntimeFilter(TRuntimeFilterBuildJoinMode::type join_mode, std::vector<ColumnPtr> columns,
                                      int64_t num_rows, int64_t num_partitions,
                                      std::vector<int32_t> bucketseq_to_partition) {
@@ -1657,6 +1657,58 @@ TEST_F(TimeFunctionsTest, convertTzConstTest) {
                     .ok());
 }
 
+TEST_F(TimeFunctionsTest, convertTzConstAcrossTransitionsTest) {
+    auto tz_from = ColumnHelper::create_const_column<TYPE_VARCHAR>("America/New_York", 1);
+    auto tz_to = ColumnHelper::create_const_column<TYPE_VARCHAR>("UTC", 1);
+    _utils->get_fn_ctx()->set_constant_columns({nullptr, tz_from, tz_to});
+    _utils->get_fn_ctx()->_arg_types.clear();
+    _utils->get_fn_ctx()->_arg_types.emplace_back(FunctionContext::TypeDesc{TYPE_DATETIME});
+    _utils->get_fn_ctx()->_arg_types.emplace_back(FunctionContext::TypeDesc{TYPE_VARCHAR});
+    _utils->get_fn_ctx()->_arg_types.emplace_back(FunctionContext::TypeDesc{TYPE_VARCHAR});
+    ASSERT_TRUE(
+            TimeFunctions::convert_tz_prepare(_utils->get_fn_ctx(), FunctionContext::FunctionStateScope::FRAGMENT_LOCAL)
+                    .ok());
+
+    // the rows across the transitions
+    {
+        auto tc = TimestampColumn::create();
+        tc->append(TimestampValue::create(2023, 3, 12, 1, 30, 0));
+        // skipped
+        tc->append(TimestampValue::create(2023, 3, 12, 2, 30, 0));
+        tc->append(TimestampValue::create(2023, 3, 12, 3, 30, 0));
+        // repeated
+        tc->append(TimestampValue::create(2023, 11, 5, 1, 30, 0));
+        tc->append(TimestampValue::create(2023, 11, 5, 12, 0, 0));
+        TimestampValue res[] = {
+                TimestampValue::create(2023, 3, 12, 6, 30, 0), TimestampValue::create(2023, 3, 12, 7, 0, 0),
+                TimestampValue::create(2023, 3, 12, 7, 30, 0), TimestampValue::create(2023, 11, 5, 5, 30, 0),
+                TimestampValue::create(2023, 11, 5, 17, 0, 0)};
+
+        ColumnPtr result = TimeFunctions::convert_tz(_utils->get_fn_ctx(), {tc, tz_from, tz_to}).value();
+        auto datetimes = ColumnHelper::cast_to<TYPE_DATETIME>(result);
+        ASSERT_EQ(5, datetimes->size());
+        for (int i = 0; i < 5; ++i) ASSERT_EQ(res[i], datetimes->get_data()[i]);
+    }
+
+    // all the rows are in the summer time
+    {
+        auto tc = NullableColumn::create(TimestampColumn::create(), NullColumn::create());
+        tc->append_datum(TimestampValue::create(2023, 7, 1, 10, 0, 0));
+        tc->append_nulls(1);
+        tc->append_datum(TimestampValue::create(2023, 8, 31, 23, 59, 59));
+
+        ColumnPtr result = TimeFunctions::convert_tz(_utils->get_fn_ctx(), {tc, tz_from, tz_to}).value();
+        ASSERT_EQ(3, result->size());
+        ASSERT_EQ(TimestampValue::create(2023, 7, 1, 14, 0, 0), result->get(0).get_timestamp());
+        ASSERT_TRUE(result->is_null(1));
+        ASSERT_EQ(TimestampValue::create(2023, 9, 1, 3, 59, 59), result->get(2).get_timestamp());
+    }
+
+    ASSERT_TRUE(
+            TimeFunctions::convert_tz_close(_utils->get_fn_ctx(), FunctionContext::FunctionStateScope::FRAGMENT_LOCAL)
+                    .ok());
+}
+
 TEST_F(TimeFunctionsTest, utctimestampTest) {
     {
         ColumnPtr ptr = TimeFunctions::utc_timestamp(_utils->get_fn_ctx(), Columns()).value();
@@ -0,0 +1,139 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "formats/csv/csv_reader.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "formats/csv/csv_structural_index.h"
+
+namespace starrocks {
+
+class StringCSVReader : public CSVReader {
+public:
+    StringCSVReader(std::string data, const CSVParseOptions& options, size_t buffer_size, size_t read_size)
+            : CSVReader(options, buffer_size), _data(std::move(data)), _read_size(read_size) {}
+
+protected:
+    Status _fill_buffer() override {
+        size_t n = std::min({_read_size, _buff.free_space(), _data.size() - _offset});
+        memcpy(_buff.limit(), _data.data() + _offset, n);
+        _offset += n;
+        _buff.add_limit(n);
+        if (n == 0) {
+            if (_buff.available() == 0) {
+                return Status::EndOfFile("");
+            }
+            for (char ch : _parse_options.row_delimiter) {
+                _buff.append(ch);
+            }
+        }
+        return Status::OK();
+    }
+
+private:
+    std::string _data;
+    size_t _offset = 0;
+    size_t _read_size;
+};
+
+static std::vector<std::string> index_to_strings(const CSVStructuralIndexer& indexer, const std::string& data) {
+    std::vector<CSVStructural> structurals;
+    indexer.index(data.data(), 0, data.size(), &structurals);
+    std::vector<std::string> result;
+    for (const auto& s : structurals) {
+        result.emplace_back((s.row_delimiter ? "r" : "c") + std::to_string(s.offset));
+    }
+    return result;
+}
+
+// NOLINTNEXTLINE
+TEST(CSVReaderTest, test_structural_index) {
+    {
+        CSVStructuralIndexer indexer("\n", ",");
+        std::vector<std::string> expected{"c1", "c3", "r5", "c7", "c8", "r9"};
+        EXPECT_EQ(expected, index_to_strings(indexer, "a,b,c\nd,,\n"));
+    }
+    {
+        // Multi-char delimiters, and a column delimiter never crosses a row delimiter.
+        CSVStructuralIndexer indexer("\r\n", "||");
+        std::vector<std::string> expected{"c1", "c3", "r7", "c10", "r13"};
+        EXPECT_EQ(expected, index_to_strings(indexer, "a||||b|\r\nc|||\r\n"));
+        EXPECT_EQ(std::vector<std::string>{"r0"}, index_to_strings(indexer, "\r\n|"));
+    }
+    {
+        // The delimiters between the enclose characters are ignored.
+        CSVStructuralIndexer indexer("\n", ",", '"');
+        std::vector<std::string> expected{"c1", "c9", "r11"};
+        EXPECT_EQ(expected, index_to_strings(indexer, "a,\"b,\"\"\n\",c\n"));
+    }
+    {
+        // The delimiters across the blocks of 64 bytes.
+        std::string data;
+        std::vector<std::string> expected;
+        for (int i = 0; i < 100; i++) {
+            data.append("abc");
+            expected.emplace_back("c" + std::to_string(data.size()));
+            data.append("#$");
+            data.append(std::string(i, 'x'));
+            expected.emplace_back("r" + std::to_string(data.size()));
+            data.append("\t\t\t");
+        }
+        CSVStructuralIndexer indexer("\t\t\t", "#$");
+        EXPECT_EQ(expected, index_to_strings(indexer, data));
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(CSVReaderTest, test_next_record_with_fields) {
+    std::string data;
+    for (int i = 0; i < 1000; i++) {
+        data.append(std::to_string(i) + "<>" + std::string(i % 50, 'a') + "<> " + std::to_string(i * 2) + " \r\n");
+    }
+    data.append("\r\n");
+    data.append("last<>");
+
+    for (bool trim_space : {false, true}) {
+        CSVParseOptions options("\r\n", "<>", 0, trim_space);
+        StringCSVReader reader(data, options, 16, 100);
+        StringCSVReader expected_reader(data, options, 16, 100);
+        int num_records = 0;
+        while (true) {
+            CSVReader::Record record;
+            CSVReader::Fields fields;
+            Status st = reader.next_record(&record, &fields);
+
+            CSVReader::Record expected_record;
+            CSVReader::Fields expected_fields;
+            Status expected_st = expected_reader.next_record(&expected_record);
+            ASSERT_EQ(expected_st.ok(), st.ok()) << st;
+            if (!st.ok()) {
+                ASSERT_TRUE(st.is_end_of_file()) << st;
+                break;
+            }
+            expected_reader.split_record(expected_record, &expected_fields);
+            ASSERT_EQ(expected_record.to_string(), record.to_string());
+            ASSERT_EQ(expected_fields.size(), fields.size());
+            for (size_t i = 0; i < fields.size(); i++) {
+                ASSERT_EQ(expected_fields[i].to_string(), fields[i].to_string());
+            }
+            num_records++;
+        }
+        ASSERT_EQ(1002, num_records);
+    }
+}
+
+} // namespace starrocks
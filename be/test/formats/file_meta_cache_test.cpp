@@ -0,0 +1,91 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "formats/file_meta_cache.h"
+
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+#include "formats/parquet/metadata.h"
+#include "util/defer_op.h"
+
+namespace starrocks {
+
+TEST(FileMetaCacheTest, test_cache_key) {
+    ASSERT_EQ(FileMetaCache::cache_key("/a.parquet", 100, 1), FileMetaCache::cache_key("/a.parquet", 100, 1));
+    ASSERT_NE(FileMetaCache::cache_key("/a.parquet", 100, 1), FileMetaCache::cache_key("/b.parquet", 100, 1));
+    ASSERT_NE(FileMetaCache::cache_key("/a.parquet", 100, 1), FileMetaCache::cache_key("/a.parquet", 101, 1));
+    ASSERT_NE(FileMetaCache::cache_key("/a.parquet", 100, 1), FileMetaCache::cache_key("/a.parquet", 100, 2));
+}
+
+TEST(FileMetaCacheTest, test_lookup) {
+    // the capacity is divided among the shards of the lru cache
+    FileMetaCache cache(1024 * 1024);
+    std::string key = FileMetaCache::cache_key("/a", 100, 1);
+    ASSERT_EQ(nullptr, cache.lookup_parquet_meta(key, false));
+    ASSERT_EQ(nullptr, cache.lookup_orc_tail(key));
+
+    auto meta = std::make_shared<parquet::FileMetaData>();
+    cache.insert_parquet_meta(key, false, meta, 100);
+    ASSERT_EQ(meta, cache.lookup_parquet_meta(key, false));
+    // the schema depends on the case sensitivity
+    ASSERT_EQ(nullptr, cache.lookup_parquet_meta(key, true));
+    ASSERT_EQ(nullptr, cache.lookup_orc_tail(key));
+
+    cache.insert_orc_tail(key, "tail");
+    auto tail = cache.lookup_orc_tail(key);
+    ASSERT_NE(nullptr, tail);
+    ASSERT_EQ("tail", *tail);
+    ASSERT_EQ(meta, cache.lookup_parquet_meta(key, false));
+    ASSERT_EQ(104, cache.memory_usage());
+
+    cache.set_capacity(0);
+    ASSERT_FALSE(cache.enabled());
+    ASSERT_EQ(nullptr, cache.lookup_parquet_meta(key, false));
+    ASSERT_EQ(0, cache.memory_usage());
+}
+
+TEST(FileMetaCacheTest, test_position_deletes) {
+    FileMetaCache cache(1024 * 1024);
+    std::string key = "/data.orc";
+    ASSERT_EQ(nullptr, cache.lookup_position_deletes(key));
+
+    auto deletes = std::make_shared<Roaring>();
+    deletes->addRange(10, 20);
+    cache.insert_position_deletes(key, deletes);
+    auto cached = cache.lookup_position_deletes(key);
+    ASSERT_NE(nullptr, cached);
+    ASSERT_EQ(10, cached->cardinality());
+    ASSERT_EQ(nullptr, cache.lookup_orc_tail(key));
+    ASSERT_EQ(deletes->getSizeInBytes(), cache.memory_usage());
+}
+
+TEST(FileMetaCacheTest, test_global_capacity) {
+    int64_t capacity = config::file_meta_cache_capacity;
+    config::file_meta_cache_capacity = 0;
+    DeferOp defer([&]() { config::file_meta_cache_capacity = capacity; });
+
+    ASSERT_FALSE(FileMetaCache::instance()->enabled());
+    std::string key = FileMetaCache::cache_key("/a", 100, 1);
+    FileMetaCache::instance()->insert_orc_tail(key, "tail");
+    ASSERT_EQ(nullptr, FileMetaCache::instance()->lookup_orc_tail(key));
+
+    config::file_meta_cache_capacity = 1024 * 1024;
+    ASSERT_TRUE(FileMetaCache::instance()->enabled());
+    FileMetaCache::instance()->insert_orc_tail(key, "tail");
+    ASSERT_NE(nullptr, FileMetaCache::instance()->lookup_orc_tail(key));
+}
+
+} // namespace starrocks
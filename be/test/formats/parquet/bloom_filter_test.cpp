@@ -0,0 +1,77 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "formats/parquet/bloom_filter.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+
+namespace starrocks::parquet {
+
+TEST(SplitBlockBloomFilterTest, test_init) {
+    SplitBlockBloomFilter bloom_filter;
+    ASSERT_FALSE(bloom_filter.init(0).ok());
+    ASSERT_FALSE(bloom_filter.init(33).ok());
+    ASSERT_FALSE(bloom_filter.init(SplitBlockBloomFilter::kMaxBytes + SplitBlockBloomFilter::kBytesPerBlock).ok());
+    ASSERT_TRUE(bloom_filter.init(96).ok());
+    ASSERT_EQ(96, bloom_filter.size());
+}
+
+TEST(SplitBlockBloomFilterTest, test_hash) {
+    SplitBlockBloomFilter bloom_filter;
+    ASSERT_TRUE(bloom_filter.init(8192).ok());
+    for (int32_t i = 0; i < 1000; i++) {
+        bloom_filter.insert_hash(SplitBlockBloomFilter::hash(&i, sizeof(i)));
+    }
+    std::string value = "starrocks";
+    bloom_filter.insert_hash(SplitBlockBloomFilter::hash(value.data(), value.size()));
+
+    for (int32_t i = 0; i < 1000; i++) {
+        ASSERT_TRUE(bloom_filter.test_hash(SplitBlockBloomFilter::hash(&i, sizeof(i))));
+    }
+    ASSERT_TRUE(bloom_filter.test_hash(SplitBlockBloomFilter::hash(value.data(), value.size())));
+
+    int false_positives = 0;
+    for (int32_t i = 1000; i < 11000; i++) {
+        false_positives += bloom_filter.test_hash(SplitBlockBloomFilter::hash(&i, sizeof(i)));
+    }
+    ASSERT_LT(false_positives, 100);
+}
+
+TEST(SplitBlockBloomFilterTest, test_bitset) {
+    SplitBlockBloomFilter bloom_filter;
+    ASSERT_TRUE(bloom_filter.init(1024).ok());
+    int64_t v = 12345;
+    uint64_t hash = SplitBlockBloomFilter::hash(&v, sizeof(v));
+    ASSERT_FALSE(bloom_filter.test_hash(hash));
+
+    // a filter loaded from the bitset of another one
+    bloom_filter.insert_hash(hash);
+    SplitBlockBloomFilter loaded;
+    ASSERT_TRUE(loaded.init(bloom_filter.size()).ok());
+    memcpy(loaded.data(), bloom_filter.data(), bloom_filter.size());
+    ASSERT_TRUE(loaded.test_hash(hash));
+
+    // 8 bits are set in a block for every value
+    int num_bits = 0;
+    for (size_t i = 0; i < loaded.size(); i++) {
+        num_bits += __builtin_popcount(loaded.data()[i]);
+    }
+    ASSERT_EQ(8, num_bits);
+}
+
+} // namespace starrocks::parquet
@@ -18,6 +18,7 @@
 
 #include "column/binary_column.h"
 #include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
 #include "formats/parquet/encoding_dict.h"
 #include "formats/parquet/encoding_plain.h"
 
@@ -204,6 +205,15 @@ TEST_F(ParquetEncodingTest, Int32) {
         ASSERT_TRUE(st.ok());
 
         DecoderChecker<int32_t, true>::check(values, encoder->build(), decoder.get());
+
+        auto dict_values = NullableColumn::create(FixedLengthColumn<int32_t>::create(), NullColumn::create());
+        st = decoder->get_dict_values(dict_values.get());
+        ASSERT_TRUE(st.ok());
+        ASSERT_EQ(num_dicts, dict_values->size());
+        for (size_t i = 0; i < num_dicts; i++) {
+            ASSERT_FALSE(dict_values->is_null(i));
+            ASSERT_EQ(values[i], dict_values->get(i).get_int32());
+        }
     }
 }
 
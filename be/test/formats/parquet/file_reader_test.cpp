@@ -24,12 +24,14 @@
 #include "exec/hdfs_scanner.h"
 #include "exprs/binary_predicate.h"
 #include "exprs/expr_context.h"
+#include "formats/file_meta_cache.h"
 #include "formats/parquet/column_chunk_reader.h"
 #include "formats/parquet/metadata.h"
 #include "formats/parquet/page_reader.h"
 #include "fs/fs.h"
 #include "runtime/descriptor_helper.h"
 #include "runtime/mem_tracker.h"
+#include "util/defer_op.h"
 
 namespace starrocks::parquet {
 
@@ -841,6 +843,49 @@ TEST_F(FileReaderTest, TestMinMaxConjunct) {
     ASSERT_TRUE(status.is_end_of_file());
 }
 
+TEST_F(FileReaderTest, TestMinMaxConjunctWithoutPageIndex) {
+    bool page_index_enable = config::parquet_page_index_enable;
+    config::parquet_page_index_enable = false;
+    DeferOp defer([&]() { config::parquet_page_index_enable = page_index_enable; });
+
+    auto file = _create_file(_file2_path);
+    auto file_reader = std::make_shared<FileReader>(config::vector_chunk_size, file.get(),
+                                                    std::filesystem::file_size(_file2_path));
+    auto* ctx = _create_context_for_min_max();
+    int64_t page_index_filter_rows = ctx->stats->page_index_filter_rows;
+    Status status = file_reader->init(ctx);
+    ASSERT_TRUE(status.ok());
+
+    auto chunk = _create_chunk();
+    status = file_reader->get_next(&chunk);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(11, chunk->num_rows());
+    ASSERT_EQ(page_index_filter_rows, ctx->stats->page_index_filter_rows);
+
+    status = file_reader->get_next(&chunk);
+    ASSERT_TRUE(status.is_end_of_file());
+}
+
+TEST_F(FileReaderTest, TestFooterCache) {
+    std::string cache_key = FileMetaCache::cache_key(_file2_path, std::filesystem::file_size(_file2_path), 0);
+    for (int i = 0; i < 2; i++) {
+        auto file = _create_file(_file2_path);
+        auto file_reader = std::make_shared<FileReader>(config::vector_chunk_size, file.get(),
+                                                        std::filesystem::file_size(_file2_path));
+        auto* ctx = _create_context_for_min_max();
+        ctx->file_meta_cache_key = cache_key;
+        int64_t footer_cache_hit = ctx->stats->footer_cache_hit;
+        Status status = file_reader->init(ctx);
+        ASSERT_TRUE(status.ok());
+        ASSERT_EQ(footer_cache_hit + i, ctx->stats->footer_cache_hit);
+
+        auto chunk = _create_chunk();
+        status = file_reader->get_next(&chunk);
+        ASSERT_TRUE(status.ok());
+        ASSERT_EQ(11, chunk->num_rows());
+    }
+}
+
 TEST_F(FileReaderTest, TestFilterFile) {
     auto file = _create_file(_file2_path);
     auto file_reader = std::make_shared<FileReader>(config::vector_chunk_size, file.get(),
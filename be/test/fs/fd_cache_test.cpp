@@ -0,0 +1,112 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "fs/fd_cache.h"
+
+#include <fcntl.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace starrocks {
+
+static int open_fd() {
+    return ::open("/dev/null", O_RDONLY);
+}
+
+TEST(FdCacheTest, test_insert_and_lookup) {
+    FdCache cache(64);
+    ASSERT_EQ(nullptr, cache.lookup("/data/a.dat"));
+    int fd = open_fd();
+    auto* h = cache.insert("/data/a.dat", fd);
+    ASSERT_EQ(fd, FdCache::fd(h));
+    auto* h2 = cache.lookup("/data/a.dat");
+    ASSERT_EQ(h, h2);
+    cache.release(h2);
+
+    // The descriptor of a concurrent insert of the same file is closed.
+    auto* h3 = cache.insert("/data/a.dat", open_fd());
+    ASSERT_EQ(h, h3);
+    cache.release(h3);
+    ASSERT_EQ(1, cache.size());
+
+    // The erased entry is kept until the handle is released.
+    cache.erase("/data/a.dat");
+    ASSERT_EQ(nullptr, cache.lookup("/data/a.dat"));
+    ASSERT_EQ(0, cache.size());
+    ASSERT_EQ(fd, FdCache::fd(h));
+    cache.release(h);
+}
+
+TEST(FdCacheTest, test_pinned_entry_not_evicted) {
+    FdCache cache(64);
+    auto* pinned = cache.insert("/data/pinned.dat", open_fd());
+    for (int i = 0; i < 1000; i++) {
+        cache.release(cache.insert("/data/" + std::to_string(i) + ".dat", open_fd()));
+    }
+    ASSERT_LE(cache.size(), 65);
+    auto* h = cache.lookup("/data/pinned.dat");
+    ASSERT_EQ(pinned, h);
+    cache.release(h);
+    cache.release(pinned);
+
+    cache.prune();
+    ASSERT_EQ(0, cache.size());
+}
+
+TEST(FdCacheTest, test_partition) {
+    FdCache cache(64);
+    cache.add_partition("/data1/", 32);
+    cache.add_partition("/data1", 32);
+    for (int i = 0; i < 1000; i++) {
+        cache.release(cache.insert("/data1/" + std::to_string(i) + ".dat", open_fd()));
+    }
+    ASSERT_LE(cache.size(), 32);
+    // The files under the other directories are not evicted by the files of /data1.
+    for (int i = 0; i < 1000; i++) {
+        cache.release(cache.insert("/data10/" + std::to_string(i) + ".dat", open_fd()));
+    }
+    ASSERT_GT(cache.size(), 32);
+    ASSERT_LE(cache.size(), 96);
+}
+
+TEST(FdCacheTest, test_concurrent_access) {
+    FdCache cache(64);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 10000; i++) {
+                std::string path = "/data/" + std::to_string(i % 100) + ".dat";
+                auto* h = cache.lookup(path);
+                if (h == nullptr) {
+                    h = cache.insert(path, open_fd());
+                }
+                ASSERT_GE(FdCache::fd(h), 0);
+                if (i % 7 == 0) {
+                    cache.erase(path);
+                }
+                cache.release(h);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    cache.prune();
+    ASSERT_EQ(0, cache.size());
+}
+
+} // namespace starrocks
@@ -200,4 +200,33 @@ TEST_F(GeoTypesTest, circle) {
     }
 }
 
+// the index decides the same as the exact test
+TEST_F(GeoTypesTest, contains_index) {
+    const char* wkt = "POLYGON ((10 10, 50 10, 50 50, 10 50, 10 10), (20 20, 40 20, 40 40, 20 40, 20 20))";
+    GeoParseStatus status;
+    std::unique_ptr<GeoShape> polygon(GeoShape::from_wkt(wkt, strlen(wkt), &status));
+    ASSERT_EQ(GEO_PARSE_OK, status);
+    GeoCircle circle;
+    ASSERT_EQ(GEO_PARSE_OK, circle.init(30, 30, 1000000));
+
+    GeoPoint point;
+    ASSERT_EQ(GEO_PARSE_OK, point.from_coord(15, 15));
+    ASSERT_EQ(nullptr, GeoContainsIndex::create(&point, 64));
+
+    for (const GeoShape* shape : {static_cast<const GeoShape*>(polygon.get()), static_cast<const GeoShape*>(&circle)}) {
+        auto index = GeoContainsIndex::create(shape, 64);
+        ASSERT_NE(nullptr, index);
+        int num_contained = 0;
+        for (double x = 0; x <= 60; x += 0.7) {
+            for (double y = 0; y <= 60; y += 0.7) {
+                ASSERT_EQ(GEO_PARSE_OK, point.from_coord(x, y));
+                bool contained = shape->contains(&point);
+                ASSERT_EQ(contained, index->contains(point)) << x << "," << y;
+                num_contained += contained;
+            }
+        }
+        ASSERT_GT(num_contained, 0);
+    }
+}
+
 } // namespace starrocks
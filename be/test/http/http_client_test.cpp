@@ -19,12 +19,16 @@
 
 #include <gtest/gtest.h>
 
+#include <fstream>
+#include <iterator>
+
 #include "boost/algorithm/string.hpp"
 #include "common/logging.h"
 #include "http/ev_http_server.h"
 #include "http/http_channel.h"
 #include "http/http_handler.h"
 #include "http/http_request.h"
+#include "http/utils.h"
 
 namespace starrocks {
 
@@ -68,6 +72,15 @@ public:
     }
 };
 
+static const std::string kFileContent = "0123456789";
+static const std::string kFilePath = ".http_client_test_file.dat";
+
+class HttpClientTestFileHandler : public HttpHandler {
+public:
+    void handle(HttpRequest* req) override { do_file_response(kFilePath, req); }
+};
+
+static HttpClientTestFileHandler s_file_handler = HttpClientTestFileHandler();
 static HttpClientTestSimpleGetHandler s_simple_get_handler = HttpClientTestSimpleGetHandler();
 static HttpClientTestSimplePostHandler s_simple_post_handler = HttpClientTestSimplePostHandler();
 static EvHttpServer* s_server = nullptr;
@@ -84,6 +97,7 @@ public:
         s_server->register_handler(GET, "/simple_get", &s_simple_get_handler);
         s_server->register_handler(HEAD, "/simple_get", &s_simple_get_handler);
         s_server->register_handler(POST, "/simple_post", &s_simple_post_handler);
+        s_server->register_handler(GET, "/simple_file", &s_file_handler);
         s_server->start();
         real_port = s_server->get_real_port();
         ASSERT_NE(0, real_port);
@@ -133,6 +147,33 @@ TEST_F(HttpClientTest, download) {
     unlink(local_file.c_str());
 }
 
+TEST_F(HttpClientTest, resume_download) {
+    {
+        std::ofstream remote_file(kFilePath);
+        remote_file << kFileContent;
+    }
+    std::string local_file = ".http_client_test_resume.dat";
+    {
+        // the first 4 bytes and some wrong bytes written by an interrupted download
+        std::ofstream partial_file(local_file);
+        partial_file << "0123xx";
+    }
+    HttpClient client;
+    ASSERT_TRUE(client.init(hostname + "/simple_file").ok());
+    auto st = client.download(local_file, 4, nullptr);
+    ASSERT_TRUE(st.ok()) << st;
+    std::ifstream downloaded_file(local_file);
+    std::string content((std::istreambuf_iterator<char>(downloaded_file)), std::istreambuf_iterator<char>());
+    ASSERT_EQ(kFileContent, content);
+
+    // the handler without the ranges fails the resumed download
+    ASSERT_TRUE(client.init(hostname + "/simple_get").ok());
+    client.set_basic_auth("test1", "");
+    ASSERT_FALSE(client.download(local_file, 4, nullptr).ok());
+    unlink(local_file.c_str());
+    unlink(kFilePath.c_str());
+}
+
 TEST_F(HttpClientTest, get_failed) {
     HttpClient client;
     auto st = client.init(hostname + "/simple_get");
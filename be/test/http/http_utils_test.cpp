@@ -89,4 +89,31 @@ TEST_F(HttpUtilsTest, parse_basic_auth) {
     }
 }
 
+TEST_F(HttpUtilsTest, parse_byte_range) {
+    int64_t start = -1;
+    int64_t end = -1;
+    ASSERT_TRUE(parse_byte_range("bytes=3-", 10, &start, &end));
+    ASSERT_EQ(3, start);
+    ASSERT_EQ(10, end);
+    ASSERT_TRUE(parse_byte_range("bytes=2-5", 10, &start, &end));
+    ASSERT_EQ(2, start);
+    ASSERT_EQ(6, end);
+    ASSERT_TRUE(parse_byte_range("bytes=2-100", 10, &start, &end));
+    ASSERT_EQ(2, start);
+    ASSERT_EQ(10, end);
+    ASSERT_TRUE(parse_byte_range("bytes=-4", 10, &start, &end));
+    ASSERT_EQ(6, start);
+    ASSERT_EQ(10, end);
+    // the unsupported ranges are regarded as the whole file
+    ASSERT_TRUE(parse_byte_range("bytes=0-1,3-4", 10, &start, &end));
+    ASSERT_EQ(0, start);
+    ASSERT_EQ(10, end);
+    ASSERT_TRUE(parse_byte_range("items=1-2", 10, &start, &end));
+    ASSERT_EQ(0, start);
+    ASSERT_EQ(10, end);
+    // not satisfiable
+    ASSERT_FALSE(parse_byte_range("bytes=10-", 10, &start, &end));
+    ASSERT_FALSE(parse_byte_range("bytes=-0", 10, &start, &end));
+}
+
 } // namespace starrocks
@@ -42,9 +42,11 @@
 #include "gen_cpp/FrontendService_types.h"
 #include "gen_cpp/HeartbeatService_types.h"
 #include "http/http_channel.h"
+#include "http/http_common.h"
 #include "http/http_request.h"
 #include "runtime/exec_env.h"
 #include "runtime/stream_load/load_stream_mgr.h"
+#include "runtime/stream_load/stream_load_context.h"
 #include "runtime/stream_load/stream_load_executor.h"
 #include "util/brpc_stub_cache.h"
 #include "util/cpu_info.h"
@@ -234,6 +236,35 @@ TEST_F(StreamLoadActionTest, begin_fail) {
     ASSERT_STREQ("Fail", doc["Status"].GetString());
 }
 
+TEST_F(StreamLoadActionTest, group_commit_begin_fail) {
+    StreamLoadAction action(&_env);
+
+    HttpRequest request(_evhttp_req);
+    struct evhttp_request ev_req;
+    ev_req.remote_host = nullptr;
+    request._ev_req = &ev_req;
+    request._headers.emplace(HttpHeaders::AUTHORIZATION, "Basic cm9vdDo=");
+    request._headers.emplace(HttpHeaders::CONTENT_LENGTH, "16");
+    request._headers.emplace(HTTP_GROUP_COMMIT, "true");
+    Status status = Status::InternalError("TestFail");
+    status.to_thrift(&k_stream_load_begin_result.status);
+    request.set_handler(&action);
+    action.on_header(&request);
+
+    // the transaction is not begun until the body is received
+    auto* ctx = (StreamLoadContext*)request.handler_ctx();
+    ASSERT_TRUE(ctx->status.ok());
+    ASSERT_TRUE(ctx->group_commit);
+    ASSERT_EQ(-1, ctx->txn_id);
+    ctx->buffer->put_bytes("1,2\n3,4\n5,6\n7,8\n", 16);
+    ctx->receive_bytes = 16;
+    action.handle(&request);
+
+    rapidjson::Document doc;
+    doc.Parse(k_response_str.c_str());
+    ASSERT_STREQ("Fail", doc["Status"].GetString());
+}
+
 #if 0
 TEST_F(StreamLoadActionTest, receive_failed) {
     StreamLoadAction action(&_env);
@@ -158,4 +158,36 @@ TEST_F(CacheInputStreamTest, test_random_read) {
     ASSERT_EQ(stats.read_cache_count, 3);
 }
 
+TEST_F(CacheInputStreamTest, test_peek) {
+    const int64_t block_count = 2;
+
+    const int64_t data_size = block_size * block_count;
+    char data[data_size + 1];
+    gen_test_data(data, data_size, block_size);
+
+    std::shared_ptr<io::SeekableInputStream> stream(new MockSeekableInputStream(data, data_size));
+    io::CacheInputStream cache_stream("test_file3", stream);
+    cache_stream.set_enable_populate_cache(true);
+    ASSERT_TRUE(cache_stream.allows_peek());
+
+    // not cached yet
+    ASSERT_OK(cache_stream.seek(0));
+    ASSERT_TRUE(cache_stream.peek(100).status().is_not_found());
+
+    char buffer[block_size];
+    read_stream_data(&cache_stream, 0, block_size, buffer);
+
+    // the bytes are returned from cache without copy, and the position is not changed
+    int64_t off_in_block = 100;
+    ASSERT_OK(cache_stream.seek(off_in_block));
+    auto res = cache_stream.peek(1000);
+    ASSERT_TRUE(res.ok());
+    ASSERT_EQ(1000, res.value().size());
+    ASSERT_TRUE(check_data_content(const_cast<char*>(res.value().data()), 1000, 'a'));
+    ASSERT_EQ(off_in_block, cache_stream.position().value());
+
+    // the bytes span two blocks
+    ASSERT_TRUE(cache_stream.peek(block_size).status().is_not_supported());
+}
+
 } // namespace starrocks::io
@@ -0,0 +1,138 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "io/direct_io_input_stream.h"
+
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <thread>
+
+#include "common/config.h"
+#include "io/fd_input_stream.h"
+#include "testutil/assert.h"
+#include "util/defer_op.h"
+
+namespace starrocks::io {
+
+class DirectIoInputStreamTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        for (int i = 0; i < 100000; i++) {
+            _content.push_back('a' + i % 26);
+        }
+        int fd = ::open(_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        ASSERT_GE(fd, 0);
+        ASSERT_EQ(_content.size(), ::pwrite(fd, _content.data(), _content.size(), 0));
+        ::close(fd);
+    }
+
+    void TearDown() override { ::unlink(_path.c_str()); }
+
+    // Return nullptr if the file system does not support O_DIRECT.
+    std::unique_ptr<DirectIoInputStream> open_stream(AlignedBufferPool* pool) {
+        int direct_fd = ::open(_path.c_str(), O_RDONLY | O_DIRECT);
+        if (direct_fd < 0) {
+            return nullptr;
+        }
+        auto buffered = std::make_shared<FdInputStream>(::open(_path.c_str(), O_RDONLY));
+        buffered->set_close_on_delete(true);
+        return std::make_unique<DirectIoInputStream>(std::move(buffered), direct_fd, pool);
+    }
+
+    const std::string _path = "./direct_io_input_stream_test.dat";
+    std::string _content;
+};
+
+TEST_F(DirectIoInputStreamTest, test_read) {
+    AlignedBufferPool pool(8192, 16384);
+    auto stream = open_stream(&pool);
+    if (stream == nullptr) {
+        GTEST_SKIP() << "O_DIRECT is not supported";
+    }
+    auto old_min_read_size = config::direct_io_min_read_size;
+    config::direct_io_min_read_size = 1024;
+    DeferOp defer([&]() { config::direct_io_min_read_size = old_min_read_size; });
+
+    ASSERT_EQ(_content.size(), *stream->get_size());
+    std::string buff(30000, '\0');
+    // Unaligned offset and size, larger than a buffer.
+    ASSERT_OK(stream->read_at_fully(1234, buff.data(), 20000));
+    ASSERT_EQ(_content.substr(1234, 20000), buff.substr(0, 20000));
+    // Small read, by the buffered stream.
+    ASSERT_OK(stream->read_at_fully(7, buff.data(), 100));
+    ASSERT_EQ(_content.substr(7, 100), buff.substr(0, 100));
+    // Read to the end of file.
+    ASSERT_EQ(10000, *stream->read_at(_content.size() - 10000, buff.data(), 30000));
+    ASSERT_EQ(_content.substr(_content.size() - 10000), buff.substr(0, 10000));
+    ASSERT_ERROR(stream->read_at_fully(_content.size() - 10000, buff.data(), 30000));
+
+    ASSERT_OK(stream->seek(4096));
+    ASSERT_EQ(30000, *stream->read(buff.data(), 30000));
+    ASSERT_EQ(_content.substr(4096, 30000), buff);
+    ASSERT_EQ(4096 + 30000, *stream->position());
+
+    std::string buff2(2000, '\0');
+    ASSERT_OK(stream->read_ranges_fully({{10, buff.data(), 5000}, {50000, buff2.data(), 2000}}));
+    ASSERT_EQ(_content.substr(10, 5000), buff.substr(0, 5000));
+    ASSERT_EQ(_content.substr(50000, 2000), buff2);
+
+    // All the buffers are returned to the pool.
+    ASSERT_EQ(pool.num_allocated(), pool.num_free());
+}
+
+TEST_F(DirectIoInputStreamTest, test_aligned_read) {
+    AlignedBufferPool pool(4096, 4096);
+    auto stream = open_stream(&pool);
+    if (stream == nullptr) {
+        GTEST_SKIP() << "O_DIRECT is not supported";
+    }
+    auto old_min_read_size = config::direct_io_min_read_size;
+    config::direct_io_min_read_size = 1024;
+    DeferOp defer([&]() { config::direct_io_min_read_size = old_min_read_size; });
+
+    auto* data = static_cast<uint8_t*>(std::aligned_alloc(AlignedBufferPool::kAlignment, 8192));
+    DeferOp free_data([&]() { std::free(data); });
+    // Read into the destination directly, without any buffer of the pool.
+    ASSERT_OK(stream->read_at_fully(8192, data, 8192));
+    ASSERT_EQ(_content.substr(8192, 8192), std::string_view(reinterpret_cast<char*>(data), 8192));
+    ASSERT_EQ(0, pool.num_allocated());
+}
+
+TEST(AlignedBufferPoolTest, test_acquire) {
+    AlignedBufferPool pool(1000, 8192);
+    ASSERT_EQ(4096, pool.buffer_size());
+    auto b1 = pool.acquire();
+    auto b2 = pool.acquire();
+    ASSERT_EQ(0, reinterpret_cast<uintptr_t>(b1.data()) % AlignedBufferPool::kAlignment);
+    ASSERT_EQ(0, reinterpret_cast<uintptr_t>(b2.data()) % AlignedBufferPool::kAlignment);
+    ASSERT_NE(b1.data(), b2.data());
+    ASSERT_EQ(2, pool.num_allocated());
+
+    // The pool is exhausted, wait for a buffer released.
+    uint8_t* released = b1.data();
+    std::thread t([&]() {
+        auto b3 = pool.acquire();
+        ASSERT_EQ(released, b3.data());
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    b1.reset();
+    t.join();
+    ASSERT_EQ(2, pool.num_allocated());
+    b2.reset();
+    ASSERT_EQ(2, pool.num_free());
+}
+
+} // namespace starrocks::io
@@ -22,6 +22,7 @@
 #include <cstdlib>
 
 #include "common/logging.h"
+#include "io/io_uring.h"
 #include "testutil/assert.h"
 #include "testutil/parallel_test.h"
 
@@ -155,6 +156,65 @@ PARALLEL_TEST(FdInputStreamTest, test_skip) {
     ASSERT_EQ(0, in.get_errno());
 }
 
+static void test_read_ranges(bool use_io_uring) {
+    int fd = open_temp_file();
+    std::string content;
+    for (int i = 0; i < 100000; i++) {
+        content.push_back('a' + i % 26);
+    }
+    pwrite_or_die(fd, content.data(), content.size(), 0);
+
+    FdInputStream in(fd);
+    in.set_close_on_delete(true);
+    in.set_use_io_uring(use_io_uring);
+
+    const int num_ranges = 200;
+    std::vector<std::string> buffs(num_ranges, std::string(400, '\0'));
+    std::vector<ReadRange> ranges;
+    for (int i = 0; i < num_ranges; i++) {
+        ranges.push_back({i * 499, buffs[i].data(), static_cast<int64_t>(buffs[i].size())});
+    }
+    ASSERT_OK(in.read_ranges_fully(ranges));
+    for (int i = 0; i < num_ranges; i++) {
+        ASSERT_EQ(content.substr(i * 499, 400), buffs[i]);
+    }
+
+    // Read beyond the end of file.
+    ranges.push_back({static_cast<int64_t>(content.size()) - 10, buffs[0].data(), 20});
+    ASSERT_ERROR(in.read_ranges_fully(ranges));
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(FdInputStreamTest, test_read_ranges) {
+    test_read_ranges(false);
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(FdInputStreamTest, test_read_ranges_io_uring) {
+    if (!IoUring::is_supported()) {
+        GTEST_SKIP() << "io_uring is not supported";
+    }
+    test_read_ranges(true);
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(FdInputStreamTest, test_io_uring_registered_buffers) {
+    if (!IoUring::is_supported()) {
+        GTEST_SKIP() << "io_uring is not supported";
+    }
+    int fd = open_temp_file();
+    pwrite_or_die(fd, "0123456789", 10, 0);
+    ASSIGN_OR_ABORT(auto ring, IoUring::create(4));
+
+    char buff[10];
+    ASSERT_OK(ring->register_buffers({{buff, sizeof(buff)}}));
+    ASSERT_OK(ring->read_fully({{fd, 2, buff, 3}, {fd, 6, buff + 3, 4}}));
+    ASSERT_EQ("2346789", std::string_view(buff, 7));
+    ASSERT_OK(ring->unregister_buffers());
+    ASSERT_TRUE(ring->read_fully({{fd, 8, buff, 4}}).is_end_of_file());
+    ::close(fd);
+}
+
 // NOLINTNEXTLINE
 PARALLEL_TEST(FdInputStreamTest, test_op_after_close) {
     int fd = open_temp_file();
@@ -0,0 +1,146 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "io/hedged_read.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+#include "common/config.h"
+#include "testutil/assert.h"
+#include "util/defer_op.h"
+
+namespace starrocks::io {
+
+class HedgedReadTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        _enable = config::enable_hedged_read;
+        _min_threshold_ms = config::hedged_read_min_threshold_ms;
+        _budget_percent = config::hedged_read_budget_percent;
+        config::enable_hedged_read = true;
+        config::hedged_read_min_threshold_ms = 10;
+        config::hedged_read_budget_percent = 100;
+    }
+
+    void TearDown() override {
+        config::enable_hedged_read = _enable;
+        config::hedged_read_min_threshold_ms = _min_threshold_ms;
+        config::hedged_read_budget_percent = _budget_percent;
+    }
+
+    static void warm_up(HedgedReadPolicy* policy, int64_t latency_us) {
+        for (int i = 0; i < 1000; i++) {
+            policy->record(latency_us);
+        }
+    }
+
+    bool _enable = false;
+    int64_t _min_threshold_ms = 0;
+    int64_t _budget_percent = 0;
+};
+
+TEST_F(HedgedReadTest, test_threshold) {
+    HedgedReadPolicy policy("test");
+    ASSERT_EQ(-1, policy.threshold_us());
+    for (int i = 0; i < 950; i++) {
+        policy.record(1000);
+    }
+    for (int i = 0; i < 50; i++) {
+        policy.record(1000000);
+    }
+    // The 95th percentile falls in the bucket of 1ms, raised to the minimal threshold.
+    ASSERT_EQ(10000, policy.threshold_us());
+
+    config::hedged_read_percentile = 99;
+    DeferOp defer([]() { config::hedged_read_percentile = 95; });
+    ASSERT_GE(policy.threshold_us(), 512 * 1024);
+}
+
+TEST_F(HedgedReadTest, test_budget) {
+    config::hedged_read_budget_percent = 5;
+    HedgedReadPolicy policy("test");
+    warm_up(&policy, 1000);
+    int hedged = 0;
+    for (int i = 0; i < 100; i++) {
+        hedged += policy.try_acquire_hedge();
+    }
+    ASSERT_EQ(50, hedged);
+}
+
+TEST_F(HedgedReadTest, test_read_without_hedge) {
+    HedgedReadPolicy policy("test");
+    std::atomic<int> calls{0};
+    char buf[5];
+    ASSIGN_OR_ABORT(auto n, hedged_read(&policy, buf, sizeof(buf), [&](void* data) -> StatusOr<int64_t> {
+                        calls++;
+                        memcpy(data, "hello", 5);
+                        return 5;
+                    }));
+    ASSERT_EQ(5, n);
+    ASSERT_EQ(0, memcmp(buf, "hello", 5));
+    ASSERT_EQ(1, calls.load());
+}
+
+TEST_F(HedgedReadTest, test_hedge_slow_read) {
+    HedgedReadPolicy policy("test");
+    warm_up(&policy, 1000);
+    // Shared with the losing read, which finishes after hedged_read returns.
+    auto calls = std::make_shared<std::atomic<int>>(0);
+    char buf[5];
+    // The first attempt hangs, the duplicate wins.
+    ASSIGN_OR_ABORT(auto n, hedged_read(&policy, buf, sizeof(buf), [calls](void* data) -> StatusOr<int64_t> {
+                        if ((*calls)++ == 0) {
+                            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+                            memcpy(data, "slow!", 5);
+                        } else {
+                            memcpy(data, "quick", 5);
+                        }
+                        return 5;
+                    }));
+    ASSERT_EQ(5, n);
+    ASSERT_EQ(0, memcmp(buf, "quick", 5));
+    ASSERT_EQ(2, calls->load());
+    // The losing read records its latency to |policy| when it finishes.
+    std::this_thread::sleep_for(std::chrono::milliseconds(600));
+}
+
+TEST_F(HedgedReadTest, test_all_failed) {
+    HedgedReadPolicy policy("test");
+    warm_up(&policy, 1000);
+    char buf[5];
+    auto res = hedged_read(&policy, buf, sizeof(buf), [](void* data) -> StatusOr<int64_t> {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        return Status::IOError("injected");
+    });
+    ASSERT_TRUE(res.status().is_io_error());
+}
+
+TEST_F(HedgedReadTest, test_disabled) {
+    config::enable_hedged_read = false;
+    HedgedReadPolicy policy("test");
+    warm_up(&policy, 1000);
+    char buf[5];
+    auto tid = std::this_thread::get_id();
+    ASSIGN_OR_ABORT(auto n, hedged_read(&policy, buf, sizeof(buf), [&](void* data) -> StatusOr<int64_t> {
+                        EXPECT_EQ(tid, std::this_thread::get_id());
+                        return 0;
+                    }));
+    ASSERT_EQ(0, n);
+}
+
+} // namespace starrocks::io
@@ -0,0 +1,108 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "io/io_stats.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "fs/fs_memory.h"
+#include "fs/io_stats_file.h"
+#include "io/array_input_stream.h"
+#include "testutil/assert.h"
+#include "util/runtime_profile.h"
+
+namespace starrocks::io {
+
+TEST(IOStatsTest, test_add_and_to_profile) {
+    IOStats stats;
+    RuntimeProfile empty_profile("empty");
+    stats.to_profile(&empty_profile);
+    ASSERT_EQ(nullptr, empty_profile.get_counter("IOReadBytes"));
+    ASSERT_EQ(nullptr, empty_profile.get_info_string("IOByPurpose"));
+
+    stats.add(IOPurpose::SCAN, IOOp::READ, 100, 1000);
+    stats.add(IOPurpose::SCAN, IOOp::READ, 200, 2000);
+    stats.add(IOPurpose::SPILL, IOOp::WRITE, 50, 3000000);
+    ASSERT_EQ(300, stats.bytes(IOPurpose::SCAN, IOOp::READ));
+    ASSERT_EQ(2, stats.ops(IOPurpose::SCAN, IOOp::READ));
+    ASSERT_EQ(3000, stats.time_ns(IOPurpose::SCAN, IOOp::READ));
+    ASSERT_EQ(0, stats.ops(IOPurpose::SPILL, IOOp::READ));
+    ASSERT_EQ(1, stats.ops(IOPurpose::SPILL, IOOp::WRITE));
+
+    RuntimeProfile profile("test");
+    stats.to_profile(&profile);
+    ASSERT_EQ(300, profile.get_counter("IOReadBytes")->value());
+    ASSERT_EQ(2, profile.get_counter("IOReadCount")->value());
+    ASSERT_EQ(50, profile.get_counter("IOWriteBytes")->value());
+    ASSERT_EQ(1, profile.get_counter("IOWriteCount")->value());
+    ASSERT_NE(nullptr, profile.get_info_string("IOReadLatency"));
+    const std::string* purposes = profile.get_info_string("IOByPurpose");
+    ASSERT_NE(nullptr, purposes);
+    ASSERT_NE(std::string::npos, purposes->find("scan"));
+    ASSERT_NE(std::string::npos, purposes->find("spill"));
+    ASSERT_EQ(std::string::npos, purposes->find("compaction"));
+}
+
+TEST(IOStatsTest, test_targets) {
+    auto* registry = IOTargetRegistry::instance();
+    registry->register_local_path("/io_stats_test/disk1");
+    registry->register_local_path("/io_stats_test/disk1/sub");
+    ASSERT_EQ("/io_stats_test/disk1", registry->local_target("/io_stats_test/disk1/data/0/1.dat")->name());
+    ASSERT_EQ("/io_stats_test/disk1/sub", registry->local_target("/io_stats_test/disk1/sub/a.dat")->name());
+    ASSERT_EQ("local", registry->local_target("/io_stats_test/disk10/a.dat")->name());
+    ASSERT_EQ("s3://bucket", registry->remote_target("s3://bucket/path/to/object")->name());
+    ASSERT_EQ("hdfs://nn:9000", registry->remote_target("hdfs://nn:9000/warehouse/a.parquet")->name());
+    ASSERT_EQ(registry->get("s3://bucket"), registry->remote_target("s3://bucket/other"));
+}
+
+TEST(IOStatsTest, test_files) {
+    IOStats stats;
+    SCOPED_IO_STATS(&stats);
+    SCOPED_IO_PURPOSE(IOPurpose::COMPACTION);
+    auto* target = IOTargetRegistry::instance()->get("io_stats_test");
+
+    const std::string data = "0123456789";
+    auto stream = std::make_shared<IOStatsInputStream>(std::make_shared<ArrayInputStream>(data.data(), data.size()),
+                                                       target);
+    char buf[10];
+    ASSERT_OK(stream->read_fully(buf, 4));
+    ASSERT_OK(stream->read_at_fully(6, buf, 4));
+    ASSERT_EQ("6789", std::string(buf, 4));
+    ASSIGN_OR_ABORT(auto nread, stream->read_at(8, buf, 10));
+    ASSERT_EQ(2, nread);
+    ASSERT_EQ(3, stats.ops(IOPurpose::COMPACTION, IOOp::READ));
+    ASSERT_EQ(10, stats.bytes(IOPurpose::COMPACTION, IOOp::READ));
+
+    auto sequential = std::make_shared<IOStatsSequentialInputStream>(
+            std::make_shared<ArrayInputStream>(data.data(), data.size()), target);
+    ASSERT_OK(sequential->read_fully(buf, 10));
+    ASSERT_EQ(4, stats.ops(IOPurpose::COMPACTION, IOOp::READ));
+    ASSERT_EQ(20, stats.bytes(IOPurpose::COMPACTION, IOOp::READ));
+
+    MemoryFileSystem fs;
+    ASSERT_OK(fs.create_dir("/dir"));
+    ASSIGN_OR_ABORT(auto file, fs.new_writable_file("/dir/file"));
+    auto writable = std::make_unique<IOStatsWritableFile>(std::move(file), target);
+    ASSERT_OK(writable->append(Slice("abc")));
+    Slice slices[2] = {Slice("de"), Slice("fgh")};
+    ASSERT_OK(writable->appendv(slices, 2));
+    ASSERT_OK(writable->close());
+    ASSERT_EQ(3, stats.ops(IOPurpose::COMPACTION, IOOp::WRITE));
+    ASSERT_EQ(8, stats.bytes(IOPurpose::COMPACTION, IOOp::WRITE));
+    ASSERT_EQ(0, stats.ops(IOPurpose::OTHER, IOOp::WRITE));
+}
+
+} // namespace starrocks::io
@@ -27,6 +27,7 @@
 #include "common/config.h"
 #include "common/logging.h"
 #include "testutil/assert.h"
+#include "util/defer_op.h"
 
 namespace starrocks::io {
 
@@ -207,4 +208,22 @@ TEST_F(S3InputStreamTest, test_read_at) {
     ASSERT_FALSE(f->read_at(-1, buf, sizeof(buf)).ok());
 }
 
+TEST_F(S3InputStreamTest, test_read_parts_in_parallel) {
+    auto old_part_size = config::s3_read_part_size;
+    config::s3_read_part_size = 2;
+    DeferOp defer([&]() { config::s3_read_part_size = old_part_size; });
+
+    auto f = new_random_access_file();
+    char buf[9];
+    ASSERT_OK(f->read_at_fully(1, buf, sizeof(buf)));
+    ASSERT_EQ("123456789", std::string_view(buf, sizeof(buf)));
+    ASSERT_EQ(10, *f->position());
+    ASSERT_ERROR(f->read_at_fully(5, buf, sizeof(buf)));
+
+    char buf2[3];
+    ASSERT_OK(f->read_ranges_fully({{0, buf, 2}, {7, buf2, 3}, {4, buf + 2, 1}}));
+    ASSERT_EQ("014", std::string_view(buf, 3));
+    ASSERT_EQ("789", std::string_view(buf2, 3));
+}
+
 } // namespace starrocks::io
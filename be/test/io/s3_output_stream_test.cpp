@@ -27,6 +27,7 @@
 #include "common/logging.h"
 #include "io/s3_input_stream.h"
 #include "testutil/assert.h"
+#include "util/defer_op.h"
 
 namespace starrocks::io {
 
@@ -189,4 +190,34 @@ TEST_F(S3OutputStreamTest, test_get_direct_buffer_and_advance) {
     delete_object(kObjectName);
 }
 
+TEST_F(S3OutputStreamTest, test_parallel_multipart_upload) {
+    const char* kObjectName = "test_parallel_multipart_upload";
+    const int64_t kPartSize = 5 * 1024 * 1024;
+    const int kNumParts = 5;
+    delete_object(kObjectName);
+    auto old_inflight_bytes = config::s3_upload_max_inflight_bytes;
+    config::s3_upload_max_inflight_bytes = 2 * kPartSize;
+    DeferOp defer([&]() { config::s3_upload_max_inflight_bytes = old_inflight_bytes; });
+
+    std::string expected;
+    {
+        S3OutputStream os(g_s3client, kBucketName, kObjectName, kPartSize, kPartSize);
+        for (int i = 0; i < kNumParts; i++) {
+            std::string part(kPartSize, static_cast<char>('a' + i));
+            ASSERT_OK(os.write(part.data(), part.size()));
+            expected.append(part);
+        }
+        ASSERT_OK(os.write("end", 3));
+        expected.append("end");
+        ASSERT_OK(os.close());
+    }
+
+    S3InputStream is(g_s3client, kBucketName, kObjectName);
+    std::string content(expected.size(), '\0');
+    ASSERT_OK(is.read_at_fully(0, content.data(), content.size()));
+    ASSERT_EQ(expected, content);
+
+    delete_object(kObjectName);
+}
+
 } // namespace starrocks::io
@@ -35,6 +35,7 @@
 #include "exec/sorting/merge.h"
 #include "exec/sorting/sorting.h"
 #include "exec/spill/executor.h"
+#include "exec/spill/query_spill_manager.h"
 #include "exec/spill/spiller.h"
 #include "exec/spill/spiller.hpp"
 #include "exec/spill/spiller_factory.h"
@@ -413,6 +414,119 @@ TEST_F(SpillTest, order_by_process) {
     }
 }
 
+TEST_F(SpillTest, compressed_column_formater) {
+    auto chunk = std::make_shared<Chunk>();
+    auto ints = Int32Column::create();
+    auto strs = NullableColumn::create(BinaryColumn::create(), NullColumn::create());
+    for (int32_t i = 0; i < 4096; ++i) {
+        ints->append(i % 100);
+        if (i % 7 == 0) {
+            strs->append_nulls(1);
+        } else {
+            strs->append_datum(Slice(i % 2 ? "starrocks" : "spill"));
+        }
+    }
+    chunk->append_column(ints, 0);
+    chunk->append_column(strs, 1);
+
+    std::string dir = "spill-test-5";
+    auto fs = FileSystem::Default();
+    ASSERT_OK(fs->create_dir_recursive(dir));
+    auto defer = DeferOp([&]() { (void)fs->delete_dir_recursive(dir); });
+
+    auto old_compression = config::spill_compression_type;
+    auto restore_config = DeferOp([&]() { config::spill_compression_type = old_compression; });
+    for (std::string compression : {"lz4", "zstd", "none"}) {
+        config::spill_compression_type = compression;
+        auto formater_st = SpillFormater::create(SpillFormaterType::SPILL_BY_COMPRESSED_COLUMN,
+                                                 [&]() { return chunk->clone_empty(); });
+        ASSERT_OK(formater_st.status());
+        auto& formater = formater_st.value();
+
+        auto file = std::make_shared<SpillFile>(dir + "/" + compression, fs);
+        SpillFormatContext context;
+        {
+            ASSIGN_OR_ABORT(auto writable, file->as<WritableFile>());
+            ASSERT_OK(formater->spill_as_fmt(context, writable, chunk));
+            ASSERT_OK(formater->spill_as_fmt(context, writable, chunk));
+            ASSERT_OK(writable->close());
+        }
+        ASSIGN_OR_ABORT(auto file_size, file->file_size());
+        if (compression != "none") {
+            ASSERT_LT(file_size, static_cast<int64_t>(chunk->bytes_usage()));
+        }
+
+        ASSIGN_OR_ABORT(auto readable, file->as<RawInputStreamWrapper>());
+        for (size_t i = 0; i < 2; ++i) {
+            ASSIGN_OR_ABORT(auto restored, formater->restore_from_fmt(context, readable));
+            ASSERT_EQ(chunk->num_rows(), restored->num_rows());
+            for (size_t row = 0; row < chunk->num_rows(); ++row) {
+                ASSERT_EQ(chunk->debug_row(row), restored->debug_row(row));
+            }
+        }
+        ASSERT_TRUE(formater->restore_from_fmt(context, readable).status().is_end_of_file());
+    }
+}
+
+TEST_F(SpillTest, tiered_path_provider) {
+    SpillPaths local_paths = {"spill-test-6"};
+    std::string remote_path = "spill-test-7";
+    auto fs = FileSystem::Default();
+    auto clean_up = [&]() {
+        (void)fs->delete_dir_recursive(local_paths[0]);
+        (void)fs->delete_dir_recursive(remote_path);
+    };
+    clean_up();
+    auto defer = DeferOp(clean_up);
+
+    ASSIGN_OR_ABORT(auto remote_fs, FileSystem::CreateSharedFromString(remote_path));
+    auto local = std::make_shared<LocalPathProvider>(local_paths, "tiered", fs);
+    auto remote = std::make_shared<RemotePathProvider>(remote_path, "tiered", remote_fs);
+    auto local_usage = std::make_shared<std::atomic_int64_t>(0);
+    TieredPathProvider provider(local, remote, local_usage, 1024);
+    ASSERT_OK(provider.open(&dummy_rt_st));
+
+    ASSIGN_OR_ABORT(auto file1, provider.get_file());
+    ASSERT_TRUE(file1->path().find(local_paths[0]) == 0);
+    file1->update_written_bytes(2048);
+    ASSERT_EQ(2048, local_usage->load());
+
+    // the local quota is exceeded
+    ASSIGN_OR_ABORT(auto file2, provider.get_file());
+    ASSERT_TRUE(file2->path().find(remote_path) == 0);
+    {
+        ASSIGN_OR_ABORT(auto writable, file2->as<WritableFile>());
+        ASSERT_OK(writable->append("remote"));
+        ASSERT_OK(writable->close());
+    }
+    ASSIGN_OR_ABORT(auto remote_size, file2->file_size());
+    ASSERT_EQ(6, remote_size);
+    ASSERT_EQ(2048, local_usage->load());
+
+    // the local quota is released with the local file
+    file1.reset();
+    ASSERT_EQ(0, local_usage->load());
+    ASSIGN_OR_ABORT(auto file3, provider.get_file());
+    ASSERT_TRUE(file3->path().find(local_paths[0]) == 0);
+}
+
+TEST_F(SpillTest, spill_arbitration) {
+    QuerySpillManager manager;
+    int sort = 0, agg = 0, join = 0;
+    // the revocable bytes per cost: sort 100, agg 150, join 40
+    ASSERT_TRUE(manager.arbitrate_spill(&agg, 300, 2.0, 120));
+    ASSERT_FALSE(manager.arbitrate_spill(&sort, 100, 1.0, 120));
+    ASSERT_FALSE(manager.arbitrate_spill(&join, 80, 2.0, 120));
+    // the excess bytes are more than the agg frees
+    ASSERT_TRUE(manager.arbitrate_spill(&sort, 100, 1.0, 350));
+    ASSERT_FALSE(manager.arbitrate_spill(&join, 80, 2.0, 350));
+
+    // once the agg is marked to spill, the sort is the best one
+    manager.remove_spill_candidate(&agg);
+    ASSERT_TRUE(manager.arbitrate_spill(&sort, 100, 1.0, 50));
+    ASSERT_FALSE(manager.arbitrate_spill(&join, 80, 2.0, 50));
+}
+
 /*
 TEST_F(SpillTest, file_group_test) {
     auto chunk = std::make_unique<Chunk>();
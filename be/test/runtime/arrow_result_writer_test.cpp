@@ -0,0 +1,148 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "runtime/arrow_result_writer.h"
+
+#include <arrow/array.h>
+#include <arrow/buffer.h>
+#include <arrow/io/memory.h>
+#include <arrow/ipc/reader.h>
+#include <arrow/record_batch.h>
+#include <gtest/gtest.h>
+
+#include "column/chunk.h"
+#include "column/column_helper.h"
+#include "exprs/column_ref.h"
+#include "exprs/expr_context.h"
+#include "runtime/buffer_control_block.h"
+#include "runtime/runtime_state.h"
+#include "testutil/assert.h"
+#include "util/runtime_profile.h"
+
+namespace starrocks {
+
+class ArrowResultWriterTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        TUniqueId fragment_id;
+        TQueryOptions query_options;
+        TQueryGlobals query_globals;
+        _runtime_state = std::make_shared<RuntimeState>(fragment_id, query_options, query_globals, nullptr);
+        _runtime_state->init_instance_mem_tracker();
+
+        _exprs.emplace_back(new ColumnRef(TypeDescriptor(TYPE_INT), 0));
+        _exprs.emplace_back(new ColumnRef(TypeDescriptor::create_varchar_type(10), 1));
+        // the same column is output twice
+        _exprs.emplace_back(new ColumnRef(TypeDescriptor(TYPE_INT), 0));
+        for (auto& expr : _exprs) {
+            _expr_ctxs.emplace_back(new ExprContext(expr.get()));
+        }
+        ASSERT_OK(Expr::prepare(_expr_ctxs, _runtime_state.get()));
+        ASSERT_OK(Expr::open(_expr_ctxs, _runtime_state.get()));
+    }
+
+    void TearDown() override {
+        for (ExprContext* ctx : _expr_ctxs) {
+            delete ctx;
+        }
+    }
+
+protected:
+    ChunkPtr _create_chunk(int num_rows) {
+        auto ints = ColumnHelper::create_column(TypeDescriptor(TYPE_INT), false);
+        auto strings = ColumnHelper::create_column(TypeDescriptor::create_varchar_type(10), true);
+        for (int i = 0; i < num_rows; i++) {
+            ints->append_datum(Datum(i));
+            if (i % 2 == 0) {
+                strings->append_nulls(1);
+            } else {
+                std::string s = std::to_string(i);
+                strings->append_datum(Datum(Slice(s)));
+            }
+        }
+        auto chunk = std::make_shared<Chunk>();
+        chunk->append_column(std::move(ints), 0);
+        chunk->append_column(std::move(strings), 1);
+        return chunk;
+    }
+
+    std::shared_ptr<RuntimeState> _runtime_state;
+    std::vector<std::unique_ptr<Expr>> _exprs;
+    std::vector<ExprContext*> _expr_ctxs;
+};
+
+TEST_F(ArrowResultWriterTest, process_and_fetch) {
+    BufferControlBlock sinker(TUniqueId(), 16);
+    ASSERT_OK(sinker.init());
+    RuntimeProfile profile("result sink");
+    ArrowResultWriter writer(&sinker, _expr_ctxs, &profile);
+    ASSERT_OK(writer.init(_runtime_state.get()));
+
+    auto chunk = _create_chunk(5);
+    ASSIGN_OR_ABORT(auto results, writer.process_chunk(chunk.get()));
+    ASSERT_EQ(1U, results.size());
+    ASSERT_EQ(1U, results[0]->result_batch.rows.size());
+    std::string ipc_stream = results[0]->result_batch.rows[0];
+
+    ASSIGN_OR_ABORT(bool added, writer.try_add_batch(results));
+    ASSERT_TRUE(added);
+    ASSERT_TRUE(results.empty());
+    ASSERT_EQ(5, writer.get_written_rows());
+
+    TFetchDataResult fetched;
+    ASSERT_OK(sinker.get_batch(&fetched));
+    ASSERT_EQ(1U, fetched.result_batch.rows.size());
+    ASSERT_EQ(ipc_stream, fetched.result_batch.rows[0]);
+
+    auto input = std::make_shared<arrow::io::BufferReader>(arrow::Buffer::FromString(ipc_stream));
+    auto reader_res = arrow::ipc::RecordBatchStreamReader::Open(input);
+    ASSERT_TRUE(reader_res.ok());
+    std::shared_ptr<arrow::RecordBatch> batch;
+    ASSERT_TRUE(reader_res.ValueOrDie()->ReadNext(&batch).ok());
+    ASSERT_NE(nullptr, batch);
+    ASSERT_EQ(5, batch->num_rows());
+    ASSERT_EQ(3, batch->num_columns());
+    ASSERT_EQ("col_1", batch->schema()->field(1)->name());
+
+    auto ints = std::static_pointer_cast<arrow::Int32Array>(batch->column(0));
+    auto strings = std::static_pointer_cast<arrow::StringArray>(batch->column(1));
+    auto same_ints = std::static_pointer_cast<arrow::Int32Array>(batch->column(2));
+    for (int i = 0; i < 5; i++) {
+        ASSERT_EQ(i, ints->Value(i));
+        ASSERT_EQ(i, same_ints->Value(i));
+        if (i % 2 == 0) {
+            ASSERT_TRUE(strings->IsNull(i));
+        } else {
+            ASSERT_EQ(std::to_string(i), strings->GetString(i));
+        }
+    }
+
+    // the stream ends after the only batch
+    ASSERT_TRUE(reader_res.ValueOrDie()->ReadNext(&batch).ok());
+    ASSERT_EQ(nullptr, batch);
+    ASSERT_OK(writer.close());
+}
+
+TEST_F(ArrowResultWriterTest, empty_chunk) {
+    BufferControlBlock sinker(TUniqueId(), 16);
+    RuntimeProfile profile("result sink");
+    ArrowResultWriter writer(&sinker, _expr_ctxs, &profile);
+    ASSERT_OK(writer.init(_runtime_state.get()));
+
+    auto chunk = _create_chunk(0);
+    ASSIGN_OR_ABORT(auto results, writer.process_chunk(chunk.get()));
+    ASSERT_TRUE(results.empty());
+}
+
+} // namespace starrocks
@@ -139,6 +139,16 @@ TEST(MemPoolTest, Keep) {
     }
 }
 
+TEST(MemPoolTest, MaxChunkSize) {
+    // the chunks grow from 4K up to 2M
+    MemPool p(2 * 1024 * 1024);
+    for (int i = 0; i < 4096; i++) {
+        ASSERT_TRUE(p.allocate(1024) != nullptr);
+    }
+    EXPECT_EQ(4096 * 1024, p.total_allocated_bytes());
+    EXPECT_EQ(4096LL * 1023 + 2 * 1024 * 1024, p.total_reserved_bytes());
+}
+
 // Maximum allocation size which exceeds 32-bit.
 #define LARGE_ALLOC_SIZE (1LL << 32)
 
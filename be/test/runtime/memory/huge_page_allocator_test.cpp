@@ -0,0 +1,62 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "runtime/memory/huge_page_allocator.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <numeric>
+
+#include "common/config.h"
+
+namespace starrocks {
+
+TEST(HugePageAllocatorTest, Allocate) {
+    bool old_config = config::enable_hash_table_huge_pages;
+    config::enable_hash_table_huge_pages = true;
+    {
+        void* ptr = huge_page_allocate(100);
+        ASSERT_NE(nullptr, ptr);
+        huge_page_free(ptr);
+    }
+    {
+        void* ptr = huge_page_allocate(kHugePageSize + 1);
+        ASSERT_NE(nullptr, ptr);
+        ASSERT_EQ(0, (uintptr_t)ptr % kHugePageSize);
+        memset(ptr, 1, kHugePageSize + 1);
+        huge_page_free(ptr);
+    }
+    config::enable_hash_table_huge_pages = false;
+    {
+        void* ptr = huge_page_allocate(kHugePageSize);
+        ASSERT_NE(nullptr, ptr);
+        huge_page_free(ptr);
+    }
+    config::enable_hash_table_huge_pages = old_config;
+}
+
+TEST(HugePageAllocatorTest, Buffer) {
+    HugePageBuffer<uint32_t> buffer;
+    for (uint32_t i = 0; i < kHugePageSize; i++) {
+        buffer.push_back(i);
+    }
+    ASSERT_EQ(kHugePageSize, buffer.size());
+    ASSERT_EQ((kHugePageSize - 1) * kHugePageSize / 2, std::accumulate(buffer.begin(), buffer.end(), uint64_t(0)));
+
+    HugePageBuffer<uint32_t> copied = buffer;
+    ASSERT_EQ(buffer, copied);
+}
+
+} // namespace starrocks
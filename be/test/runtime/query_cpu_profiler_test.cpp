@@ -0,0 +1,180 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "runtime/query_cpu_profiler.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include "common/config.h"
+#include "runtime/current_thread.h"
+#include "util/runtime_profile.h"
+
+namespace starrocks {
+
+class QueryCpuProfilerTest : public testing::Test {
+protected:
+    static QueryCpuProfiler::Sample make_sample(const UniqueId& query_id, const UniqueId& fragment_instance_id,
+                                                int32_t driver_id, int32_t plan_node_id, const std::string& name,
+                                                const std::vector<uintptr_t>& frames) {
+        QueryCpuProfiler::Sample sample;
+        sample.query_id_hi = query_id.hi;
+        sample.query_id_lo = query_id.lo;
+        sample.fragment_instance_id_hi = fragment_instance_id.hi;
+        sample.fragment_instance_id_lo = fragment_instance_id.lo;
+        sample.driver_id = driver_id;
+        sample.plan_node_id = plan_node_id;
+        strncpy(sample.operator_name, name.c_str(), QueryCpuProfiler::kMaxOperatorNameSize - 1);
+        sample.depth = frames.size();
+        for (size_t i = 0; i < frames.size(); i++) {
+            sample.frames[i] = reinterpret_cast<void*>(frames[i]);
+        }
+        return sample;
+    }
+
+    static const QueryCpuProfiler::QuerySummary* find_query(const std::vector<QueryCpuProfiler::QuerySummary>& queries,
+                                                            const UniqueId& query_id) {
+        for (const auto& query : queries) {
+            if (query.query_id == query_id) {
+                return &query;
+            }
+        }
+        return nullptr;
+    }
+
+    QueryCpuProfiler* _profiler = QueryCpuProfiler::instance();
+};
+
+TEST_F(QueryCpuProfilerTest, test_aggregate_samples) {
+    const UniqueId query_id(1001, 1);
+    const UniqueId fragment_instance_id(1001, 2);
+    for (int i = 0; i < 3; i++) {
+        _profiler->add_sample(make_sample(query_id, fragment_instance_id, i, 1, "hash_join_probe", {0x20, 0x10}));
+    }
+    _profiler->add_sample(make_sample(query_id, fragment_instance_id, 0, 2, "aggregate_blocking_sink", {0x30}));
+    _profiler->add_sample(make_sample(query_id, fragment_instance_id, 0, -1, "", {0x40}));
+
+    const auto* query = find_query(_profiler->list_queries(), query_id);
+    ASSERT_NE(nullptr, query);
+    ASSERT_EQ(5, query->num_samples);
+    ASSERT_EQ(3, query->num_stacks);
+
+    const std::string stacks = _profiler->folded_stacks(query_id);
+    const std::string prefix = fragment_instance_id.to_string() + ";hash_join_probe(plan_node_id=1);";
+    // the stack of the most samples first
+    ASSERT_EQ(0, stacks.find(prefix)) << stacks;
+    ASSERT_NE(std::string::npos, stacks.find(" 3\n")) << stacks;
+    ASSERT_NE(std::string::npos, stacks.find(";aggregate_blocking_sink(plan_node_id=2);")) << stacks;
+    ASSERT_NE(std::string::npos, stacks.find(";[driver];")) << stacks;
+    ASSERT_EQ(3, std::count(stacks.begin(), stacks.end(), '\n')) << stacks;
+
+    ASSERT_EQ(stacks, _profiler->folded_stacks(query_id, fragment_instance_id));
+    ASSERT_EQ("", _profiler->folded_stacks(query_id, UniqueId(1001, 3)));
+    ASSERT_EQ("", _profiler->folded_stacks(UniqueId(1001, 4)));
+}
+
+TEST_F(QueryCpuProfilerTest, test_attach_to_profile) {
+    const UniqueId query_id(1002, 1);
+    const UniqueId fragment_instance_id(1002, 2);
+    for (int i = 0; i < 6; i++) {
+        _profiler->add_sample(make_sample(query_id, fragment_instance_id, i % 2, 1, "hash_join_probe", {0x10}));
+    }
+    for (int i = 0; i < 4; i++) {
+        _profiler->add_sample(make_sample(query_id, fragment_instance_id, 0, 2, "project", {0x20}));
+    }
+    _profiler->add_sample(make_sample(query_id, UniqueId(1002, 3), 0, 2, "project", {0x20}));
+
+    RuntimeProfile profile("fragment");
+    _profiler->attach_to_profile(query_id, fragment_instance_id, &profile);
+    ASSERT_EQ(10, profile.get_counter("CpuSamples")->value());
+    ASSERT_EQ("hash_join_probe(plan_node_id=1): 60.0%, project(plan_node_id=2): 40.0%",
+              *profile.get_info_string("CpuSampledOperators"));
+    ASSERT_EQ("drivers=2, avg=5.0, max=7(driver_id=0)", *profile.get_info_string("CpuSampledDrivers"));
+
+    RuntimeProfile empty_profile("fragment");
+    _profiler->attach_to_profile(UniqueId(1002, 4), fragment_instance_id, &empty_profile);
+    ASSERT_EQ(nullptr, empty_profile.get_counter("CpuSamples"));
+}
+
+TEST_F(QueryCpuProfilerTest, test_evict_queries) {
+    const int32_t max_queries = config::query_cpu_profiler_max_queries;
+    config::query_cpu_profiler_max_queries = 2;
+    for (int i = 0; i < 3; i++) {
+        _profiler->add_sample(make_sample(UniqueId(1003, i), UniqueId(1003, 100), 0, 1, "project", {0x10}));
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    const auto queries = _profiler->list_queries();
+    config::query_cpu_profiler_max_queries = max_queries;
+
+    ASSERT_EQ(2, queries.size());
+    ASSERT_EQ(nullptr, find_query(queries, UniqueId(1003, 0)));
+    ASSERT_NE(nullptr, find_query(queries, UniqueId(1003, 1)));
+    ASSERT_NE(nullptr, find_query(queries, UniqueId(1003, 2)));
+}
+
+TEST_F(QueryCpuProfilerTest, test_too_many_stacks) {
+    const int32_t max_stacks = config::query_cpu_profiler_max_stacks_per_query;
+    config::query_cpu_profiler_max_stacks_per_query = 1;
+    const UniqueId query_id(1004, 1);
+    const UniqueId fragment_instance_id(1004, 2);
+    _profiler->add_sample(make_sample(query_id, fragment_instance_id, 0, 1, "project", {0x10}));
+    _profiler->add_sample(make_sample(query_id, fragment_instance_id, 0, 1, "project", {0x20}));
+    _profiler->add_sample(make_sample(query_id, fragment_instance_id, 0, 1, "project", {0x30}));
+    _profiler->add_sample(make_sample(query_id, fragment_instance_id, 0, 1, "project", {0x10}));
+    const std::string stacks = _profiler->folded_stacks(query_id);
+    config::query_cpu_profiler_max_stacks_per_query = max_stacks;
+
+    ASSERT_NE(std::string::npos, stacks.find(";project(plan_node_id=1);[too many stacks] 2\n")) << stacks;
+    ASSERT_EQ(2, std::count(stacks.begin(), stacks.end(), '\n')) << stacks;
+}
+
+TEST_F(QueryCpuProfilerTest, test_sample_running_thread) {
+    const int32_t frequency = config::query_cpu_profiler_frequency;
+    config::query_cpu_profiler_frequency = 997;
+    ASSERT_TRUE(_profiler->start().ok());
+    // wait for the background thread to pick up the frequency
+    std::this_thread::sleep_for(std::chrono::milliseconds(3 * QueryCpuProfiler::kFlushIntervalMs));
+
+    const TUniqueId query_id = UniqueId(1005, 1).to_thrift();
+    const TUniqueId fragment_instance_id = UniqueId(1005, 2).to_thrift();
+    std::thread thread([&]() {
+        SCOPED_SET_TRACE_INFO(7, query_id, fragment_instance_id);
+        const std::string name = "busy_loop";
+        CurrentThreadOperatorSetter operator_setter(3, &name);
+        volatile uint64_t value = 0;
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (std::chrono::steady_clock::now() < deadline) {
+            for (int i = 0; i < 1000000; i++) {
+                value = value * 31 + i;
+            }
+            _profiler->flush();
+            if (find_query(_profiler->list_queries(), query_id) != nullptr) {
+                break;
+            }
+        }
+    });
+    thread.join();
+    config::query_cpu_profiler_frequency = frequency;
+
+    const std::string stacks = _profiler->folded_stacks(query_id);
+    const std::string prefix = UniqueId(fragment_instance_id).to_string() + ";busy_loop(plan_node_id=3);";
+    ASSERT_NE(std::string::npos, stacks.find(prefix)) << stacks;
+}
+
+} // namespace starrocks
@@ -17,9 +17,14 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <chrono>
 #include <filesystem>
+#include <thread>
 
+#include "common/config.h"
 #include "runtime/exec_env.h"
+#include "testutil/assert.h"
 #include "util/cpu_info.h"
 
 #define private public // hack complier
@@ -102,4 +107,62 @@ TEST_F(SnapshotLoaderTest, NormalCase) {
     ASSERT_EQ(10005, tablet_id);
 }
 
+TEST_F(SnapshotLoaderTest, run_transfers) {
+    SnapshotLoader loader(_exec_env, 1L, 2L);
+    auto old_parallelism = config::snapshot_loader_transfer_parallelism;
+    auto old_max_inflight_bytes = config::snapshot_loader_max_inflight_bytes;
+    config::snapshot_loader_transfer_parallelism = 3;
+    config::snapshot_loader_max_inflight_bytes = 100;
+
+    std::atomic<int> running{0};
+    std::atomic<int> max_running{0};
+    std::atomic<int64_t> running_bytes{0};
+    std::atomic<int64_t> max_running_bytes{0};
+    std::atomic<int> finished{0};
+    auto make_transfers = [&](const std::vector<int64_t>& sizes, int fail_index) {
+        std::vector<SnapshotLoader::FileTransfer> transfers;
+        for (int i = 0; i < static_cast<int>(sizes.size()); i++) {
+            int64_t size = sizes[i];
+            transfers.push_back({size, [&, i, size, fail_index]() -> Status {
+                                     max_running = std::max(max_running.load(), ++running);
+                                     max_running_bytes = std::max(max_running_bytes.load(), running_bytes += size);
+                                     std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                                     running_bytes -= size;
+                                     --running;
+                                     ++finished;
+                                     return i == fail_index ? Status::IOError("injected") : Status::OK();
+                                 }});
+        }
+        return transfers;
+    };
+
+    // at most 3 transfers of 30 bytes in flight
+    auto transfers = make_transfers(std::vector<int64_t>(8, 30), -1);
+    ASSERT_OK(loader._run_transfers(&transfers, TTaskType::type::UPLOAD));
+    ASSERT_EQ(8, finished);
+    ASSERT_LE(max_running, 3);
+    ASSERT_LE(max_running_bytes, 90);
+
+    // at most 100 bytes in flight, and the too large one runs alone
+    max_running = 0;
+    max_running_bytes = 0;
+    finished = 0;
+    transfers = make_transfers({60, 60, 200, 40, 40}, -1);
+    ASSERT_OK(loader._run_transfers(&transfers, TTaskType::type::DOWNLOAD));
+    ASSERT_EQ(5, finished);
+    ASSERT_LE(max_running, 2);
+    ASSERT_EQ(200, max_running_bytes);
+
+    // no more transfer starts after a failure
+    finished = 0;
+    config::snapshot_loader_transfer_parallelism = 1;
+    transfers = make_transfers(std::vector<int64_t>(5, 10), 1);
+    auto st = loader._run_transfers(&transfers, TTaskType::type::DOWNLOAD);
+    ASSERT_TRUE(st.is_io_error()) << st;
+    ASSERT_EQ(2, finished);
+
+    config::snapshot_loader_transfer_parallelism = old_parallelism;
+    config::snapshot_loader_max_inflight_bytes = old_max_inflight_bytes;
+}
+
 } // namespace starrocks
@@ -16,6 +16,10 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <deque>
+#include <random>
+
 #include "column/chunk.h"
 #include "column/column_helper.h"
 #include "column/datum_tuple.h"
@@ -23,6 +27,7 @@
 #include "exprs/expr_context.h"
 #include "runtime/runtime_state.h"
 #include "testutil/assert.h"
+#include "util/defer_op.h"
 
 namespace starrocks {
 
@@ -319,4 +324,112 @@ TEST_F(SortedChunksMergerTest, three_suppliers) {
     }
 }
 
+TEST_F(SortedChunksMergerTest, loser_tree_three_providers) {
+    std::vector<ChunkPtr> chunks = {_chunk_1, _chunk_2, _chunk_3};
+    std::vector<ChunkProvider> providers;
+    for (auto& chunk : chunks) {
+        providers.emplace_back([&chunk](ChunkUniquePtr* out_chunk, bool* eos) -> bool {
+            if (out_chunk == nullptr || eos == nullptr) {
+                return true;
+            }
+            if (chunk == nullptr) {
+                *eos = true;
+                return false;
+            }
+            *out_chunk = chunk->clone_unique();
+            chunk = nullptr;
+            return true;
+        });
+    }
+
+    LoserTreeChunkMerger merger(_runtime_state.get());
+    ASSERT_OK(merger.init(providers, &_sort_exprs, &_is_asc, &_is_null_first));
+    ASSERT_TRUE(merger.is_data_ready());
+
+    std::atomic<bool> eos = false;
+    bool should_exit = false;
+    ChunkUniquePtr page_1, page_2;
+    ASSERT_OK(merger.get_next(&page_1, &eos, &should_exit));
+    ASSERT_FALSE(eos);
+    ASSERT_TRUE(page_1 != nullptr);
+    ASSERT_OK(merger.get_next(&page_2, &eos, &should_exit));
+    ASSERT_TRUE(eos);
+    ASSERT_TRUE(page_2 == nullptr);
+
+    const size_t Size = 16;
+    ASSERT_EQ(Size, page_1->num_rows());
+    int32_t permutation[Size] = {71, 70, 69, 54, 4, 56, 55, 49, 41, 16, 52, 58, 24, 12, 2, 6};
+    for (size_t i = 0; i < Size; ++i) {
+        ASSERT_EQ(permutation[i], page_1->get(i).get(0).get_int32());
+    }
+}
+
+// The chunks of the senders arrive in small pieces, and sometimes they are not arrived yet.
+TEST_F(SortedChunksMergerTest, loser_tree_many_providers) {
+    auto* expr = new ColumnRef(TypeDescriptor(TYPE_INT), 0);
+    _exprs.push_back(expr);
+    std::vector<ExprContext*> sort_exprs{new ExprContext(expr)};
+    ASSERT_OK(Expr::prepare(sort_exprs, _runtime_state.get()));
+    ASSERT_OK(Expr::open(sort_exprs, _runtime_state.get()));
+    DeferOp defer([&]() { delete sort_exprs[0]; });
+    std::vector<bool> is_asc{true};
+    std::vector<bool> is_null_first{true};
+
+    constexpr size_t num_senders = 20;
+    std::mt19937 rng(0);
+    std::vector<std::deque<ChunkPtr>> sender_chunks(num_senders);
+    std::vector<size_t> num_calls(num_senders, 0);
+    std::vector<int32_t> expected;
+    for (auto& chunks : sender_chunks) {
+        std::vector<int32_t> values(rng() % 500);
+        for (auto& value : values) {
+            value = rng() % 100;
+        }
+        std::sort(values.begin(), values.end());
+        expected.insert(expected.end(), values.begin(), values.end());
+        for (size_t i = 0; i < values.size(); i += 37) {
+            auto column = Int32Column::create();
+            column->get_data().assign(values.begin() + i, values.begin() + std::min(i + 37, values.size()));
+            chunks.push_back(std::make_shared<Chunk>(Columns{column}, Chunk::SlotHashMap{{0, 0}}));
+        }
+    }
+    std::sort(expected.begin(), expected.end());
+
+    std::vector<ChunkProvider> providers;
+    for (size_t i = 0; i < num_senders; i++) {
+        providers.emplace_back([&, i](ChunkUniquePtr* out_chunk, bool* eos) -> bool {
+            if (out_chunk == nullptr || eos == nullptr) {
+                return true;
+            }
+            if (++num_calls[i] % 3 == 0) {
+                return false;
+            }
+            if (sender_chunks[i].empty()) {
+                *eos = true;
+                return false;
+            }
+            *out_chunk = sender_chunks[i].front()->clone_unique();
+            sender_chunks[i].pop_front();
+            return true;
+        });
+    }
+
+    LoserTreeChunkMerger merger(_runtime_state.get());
+    ASSERT_OK(merger.init(providers, &sort_exprs, &is_asc, &is_null_first));
+    std::vector<int32_t> output;
+    std::atomic<bool> eos = false;
+    for (size_t i = 0; i < 100000 && !eos; i++) {
+        bool should_exit = false;
+        ChunkUniquePtr chunk;
+        ASSERT_OK(merger.get_next(&chunk, &eos, &should_exit));
+        if (chunk != nullptr) {
+            for (size_t row = 0; row < chunk->num_rows(); row++) {
+                output.push_back(chunk->get(row).get(0).get_int32());
+            }
+        }
+    }
+    ASSERT_TRUE(eos);
+    ASSERT_EQ(expected, output);
+}
+
 } // namespace starrocks
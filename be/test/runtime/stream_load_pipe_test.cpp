@@ -36,6 +36,8 @@
 
 #include <gtest/gtest.h>
 
+#include <mutex>
+#include <set>
 #include <thread>
 
 #include "testutil/assert.h"
@@ -211,6 +213,66 @@ PARALLEL_TEST(StreamLoadPipeTest, append_and_read_buffer) {
     t1.join();
 }
 
+PARALLEL_TEST(StreamLoadPipeTest, read_records) {
+    StreamLoadPipe pipe(/*max_buffered_bytes=*/1024, /*min_chunk_size=*/16);
+
+    std::string data;
+    for (int i = 0; i < 1000; ++i) {
+        data.append(std::to_string(i)).append(i % 7, 'x').append("\r\n");
+    }
+    data.append("last");
+    auto producer = std::thread([&]() {
+        for (size_t pos = 0; pos < data.size(); pos += 10) {
+            ASSERT_OK(pipe.append(data.data() + pos, std::min<size_t>(10, data.size() - pos)));
+        }
+        pipe.finish();
+    });
+
+    std::mutex lock;
+    std::vector<std::string> records;
+    auto consumer = [&]() {
+        StreamLoadPipeInputStream stream(std::shared_ptr<StreamLoadPipe>(&pipe, [](StreamLoadPipe*) {}), false);
+        stream.set_record_delimiter("\r\n");
+        std::string bytes;
+        char buf[7];
+        while (true) {
+            auto res = stream.read(buf, sizeof(buf));
+            ASSERT_OK(res.status());
+            if (*res == 0) {
+                break;
+            }
+            bytes.append(buf, *res);
+        }
+        std::lock_guard<std::mutex> l(lock);
+        size_t start = 0;
+        while (start < bytes.size()) {
+            size_t end = bytes.find("\r\n", start);
+            if (end == std::string::npos) {
+                end = bytes.size();
+            }
+            records.emplace_back(bytes.substr(start, end - start));
+            start = end + 2;
+        }
+    };
+    std::vector<std::thread> consumers;
+    for (int i = 0; i < 4; ++i) {
+        consumers.emplace_back(consumer);
+    }
+    for (auto& t : consumers) {
+        t.join();
+    }
+    producer.join();
+
+    // Every consumer reads complete records.
+    ASSERT_EQ(1001, records.size());
+    std::set<std::string> expected;
+    for (int i = 0; i < 1000; ++i) {
+        expected.emplace(std::to_string(i) + std::string(i % 7, 'x'));
+    }
+    expected.emplace("last");
+    ASSERT_EQ(expected, std::set<std::string>(records.begin(), records.end()));
+}
+
 PARALLEL_TEST(StreamLoadPipeTest, append_large_chunk) {
     StreamLoadPipe pipe(/*max_buffered_bytes=*/6, /*min_chunk_size=*/4);
 
@@ -269,6 +269,101 @@ PARALLEL_TEST(ColumnArraySerdeTest, large_binary_column) {
     }
 }
 
+// NOLINTNEXTLINE
+PARALLEL_TEST(ColumnArraySerdeTest, nullable_column_null_bitmap) {
+    constexpr int kNullBitmapLevel = 16;
+    auto c1 = NullableColumn::create(Int32Column::create(), NullColumn::create());
+    for (int32_t i = 0; i < 1000; i++) {
+        if (i % 7 == 0) {
+            c1->append_nulls(1);
+        } else {
+            c1->append_datum(Datum(i));
+        }
+    }
+
+    for (auto level : {kNullBitmapLevel, kNullBitmapLevel | 2, kNullBitmapLevel | 7}) {
+        auto c2 = NullableColumn::create(Int32Column::create(), NullColumn::create());
+        std::vector<uint8_t> buffer(ColumnArraySerde::max_serialized_size(*c1, level));
+        // one bit per row
+        ASSERT_LT(buffer.size(), ColumnArraySerde::max_serialized_size(*c1->data_column(), level) + c1->size());
+        uint8_t* end = ColumnArraySerde::serialize(*c1, buffer.data(), false, level);
+        ASSERT_LE(end, buffer.data() + buffer.size());
+        ASSERT_EQ(end, ColumnArraySerde::deserialize(buffer.data(), c2.get(), false, level));
+        ASSERT_TRUE(c2->has_null());
+        ASSERT_EQ(c1->size(), c2->size());
+        for (size_t i = 0; i < c1->size(); i++) {
+            ASSERT_EQ(c1->debug_item(i), c2->debug_item(i));
+        }
+    }
+
+    // the null flags are omitted without null
+    auto c3 = NullableColumn::create(Int32Column::create(), NullColumn::create());
+    for (int32_t i = 0; i < 1000; i++) {
+        c3->append_datum(Datum(i));
+    }
+    auto c4 = NullableColumn::create(Int32Column::create(), NullColumn::create());
+    std::vector<uint8_t> buffer(ColumnArraySerde::max_serialized_size(*c3, kNullBitmapLevel));
+    uint8_t* end = ColumnArraySerde::serialize(*c3, buffer.data(), false, kNullBitmapLevel);
+    ASSERT_EQ(sizeof(uint32_t) * 2 + ColumnArraySerde::max_serialized_size(*c3->data_column()), end - buffer.data());
+    ASSERT_EQ(end, ColumnArraySerde::deserialize(buffer.data(), c4.get(), false, kNullBitmapLevel));
+    ASSERT_FALSE(c4->has_null());
+    ASSERT_EQ(c3->size(), c4->size());
+    for (size_t i = 0; i < c3->size(); i++) {
+        ASSERT_FALSE(c4->is_null(i));
+        ASSERT_EQ(c3->get(i).get_int32(), c4->get(i).get_int32());
+    }
+}
+
+template <typename ColumnType>
+void test_dict_encoded_binary_column(size_t num_words) {
+    constexpr int kDictLevel = 8;
+    auto c1 = ColumnType::create();
+    auto c2 = ColumnType::create();
+    for (size_t i = 0; i < 4096; i++) {
+        c1->append(Slice(strings::Substitute("dimension_$0", i % num_words)));
+    }
+
+    std::vector<uint8_t> buffer;
+    buffer.resize(ColumnArraySerde::max_serialized_size(*c1, kDictLevel));
+    uint8_t* end = ColumnArraySerde::serialize(*c1, buffer.data(), false, kDictLevel);
+    ASSERT_LE(end, buffer.data() + buffer.size());
+    ASSERT_EQ(end, ColumnArraySerde::deserialize(buffer.data(), c2.get(), false, kDictLevel));
+    ASSERT_EQ(c1->size(), c2->size());
+    for (size_t i = 0; i < c1->size(); i++) {
+        ASSERT_EQ(c1->get_slice(i), c2->get_slice(i));
+    }
+    if (num_words <= 256) {
+        // the dictionary plus 1 byte codes
+        ASSERT_LT(end - buffer.data(), c1->size() * 2);
+    }
+
+    // with the other encodings
+    for (auto level : {kDictLevel | 2, kDictLevel | 4, kDictLevel | 7}) {
+        c2 = ColumnType::create();
+        buffer.resize(ColumnArraySerde::max_serialized_size(*c1, level));
+        end = ColumnArraySerde::serialize(*c1, buffer.data(), false, level);
+        ASSERT_LE(end, buffer.data() + buffer.size());
+        ColumnArraySerde::deserialize(buffer.data(), c2.get(), false, level);
+        ASSERT_EQ(c1->size(), c2->size());
+        for (size_t i = 0; i < c1->size(); i++) {
+            ASSERT_EQ(c1->get_slice(i), c2->get_slice(i));
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(ColumnArraySerdeTest, dict_encoded_binary_column) {
+    // 1 byte codes
+    test_dict_encoded_binary_column<BinaryColumn>(10);
+    test_dict_encoded_binary_column<LargeBinaryColumn>(10);
+    // 2 bytes codes
+    test_dict_encoded_binary_column<BinaryColumn>(400);
+    test_dict_encoded_binary_column<LargeBinaryColumn>(400);
+    // not dictionary encoded
+    test_dict_encoded_binary_column<BinaryColumn>(4096);
+    test_dict_encoded_binary_column<LargeBinaryColumn>(4096);
+}
+
 // NOLINTNEXTLINE
 PARALLEL_TEST(ColumnArraySerdeTest, const_column) {
     auto create_const_column = [](int32_t value, size_t size) {
@@ -0,0 +1,71 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "simd/null_bitmap.h"
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace starrocks {
+
+// NOLINTNEXTLINE
+TEST(NullBitmapTest, pack_unpack_count_filter) {
+    std::mt19937 rand(0);
+    for (size_t n : {0, 1, 7, 8, 15, 16, 31, 33, 64, 100, 4095}) {
+        std::vector<uint8_t> nulls(n);
+        std::vector<uint8_t> filter(n);
+        size_t num_nulls = 0;
+        for (size_t i = 0; i < n; i++) {
+            // the nonzero flags other than 1 are nulls too
+            nulls[i] = rand() % 3 == 0 ? 1 + rand() % 4 : 0;
+            filter[i] = rand() % 2;
+            num_nulls += nulls[i] != 0;
+        }
+
+        std::vector<uint8_t> bitmap(SIMD::null_bitmap_size(n));
+        SIMD::pack_null_bitmap(nulls.data(), n, bitmap.data());
+        ASSERT_EQ(num_nulls, SIMD::count_null_bitmap(bitmap.data(), n));
+
+        std::vector<uint8_t> unpacked(n);
+        SIMD::unpack_null_bitmap(bitmap.data(), n, unpacked.data());
+        for (size_t i = 0; i < n; i++) {
+            ASSERT_EQ(nulls[i] != 0, unpacked[i]);
+        }
+
+        std::vector<uint8_t> filtered(SIMD::null_bitmap_size(n));
+        size_t num_kept = SIMD::filter_null_bitmap(bitmap.data(), n, filter.data(), filtered.data());
+        size_t j = 0;
+        for (size_t i = 0; i < n; i++) {
+            if (filter[i]) {
+                ASSERT_EQ(nulls[i] != 0, (filtered[j / 8] >> (j % 8)) & 1);
+                j++;
+            }
+        }
+        ASSERT_EQ(j, num_kept);
+        // the bits beyond the kept rows are zero
+        ASSERT_EQ(SIMD::count_null_bitmap(filtered.data(), n), SIMD::count_null_bitmap(filtered.data(), num_kept));
+
+        std::vector<uint8_t> merged = filtered;
+        SIMD::merge_null_bitmap(merged.data(), bitmap.data(), n);
+        for (size_t i = 0; i < n; i++) {
+            bool expected = nulls[i] != 0 || ((filtered[i / 8] >> (i % 8)) & 1);
+            ASSERT_EQ(expected, (merged[i / 8] >> (i % 8)) & 1);
+        }
+    }
+}
+
+} // namespace starrocks
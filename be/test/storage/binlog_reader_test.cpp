@@ -351,4 +351,50 @@ TEST_F(BinlogReaderTest, test_read_random_columns) {
     test_reader(schema, verifier);
 }
 
+// verify that the log entries of the small loads are read in one chunk
+TEST_F(BinlogReaderTest, test_coalesce_log_entries) {
+    std::vector<std::vector<RowsetInfo>> rowsets_per_binlog_file(2);
+    for (int i = 2; i < 32; i++) {
+        RowsetInfo rowset_info;
+        rowset_info.version = i;
+        rowset_info.total_rows = 7;
+        rowset_info.num_segments = 1 + i % 2;
+        rowsets_per_binlog_file[i < 17 ? 0 : 1].push_back(rowset_info);
+    }
+    ingestion_rowsets(rowsets_per_binlog_file);
+    std::vector<RowsetInfo> rowset_infos;
+    for (auto& vec : rowsets_per_binlog_file) {
+        rowset_infos.insert(rowset_infos.end(), vec.begin(), vec.end());
+    }
+    DataColumnsVerifier verifier;
+    verify_binlog_reader(_tablet, rowset_infos, 0, 0, _schema, &verifier);
+    verify_binlog_reader(_tablet, rowset_infos, 3, 5, _schema, &verifier);
+
+    BinlogReaderParams params;
+    params.chunk_size = 100;
+    params.output_schema = _schema;
+    BinlogReaderSharedPtr binlog_reader = std::make_shared<BinlogReader>(_tablet, params);
+    ASSERT_OK(binlog_reader->init());
+    ASSERT_OK(binlog_reader->seek(2, 0));
+    ChunkPtr chunk = ChunkHelper::new_chunk(_schema, 100);
+    int num_chunks = 0;
+    int64_t num_rows = 0;
+    Status st;
+    while (true) {
+        chunk->reset();
+        st = binlog_reader->get_next(&chunk, 32);
+        if (!st.ok()) {
+            break;
+        }
+        ASSERT_LE(chunk->num_rows(), 100);
+        num_chunks += 1;
+        num_rows += chunk->num_rows();
+    }
+    ASSERT_TRUE(st.is_end_of_file()) << st;
+    ASSERT_EQ(30 * 7, num_rows);
+    // a chunk is filled by the log entries of at most 7 rows until it has at least 94 rows
+    ASSERT_LE(num_chunks, 3);
+    binlog_reader->close();
+}
+
 } // namespace starrocks
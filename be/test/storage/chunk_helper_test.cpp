@@ -318,4 +318,121 @@ TEST_F(ChunkHelperTest, Accumulator) {
     EXPECT_TRUE(accumulator.reach_limit());
 }
 
+TEST_F(ChunkHelperTest, PipelineAccumulatorMaxBytes) {
+    auto* tuple_desc = _create_simple_desc();
+    auto new_chunk = [tuple_desc]() {
+        auto chunk = ChunkHelper::new_chunk(*tuple_desc, 100);
+        chunk->get_column_by_index(0)->append_default(100);
+        return chunk;
+    };
+    const size_t chunk_bytes = new_chunk()->bytes_usage();
+
+    ChunkPipelineAccumulator accumulator;
+    accumulator.set_max_size(4096);
+    accumulator.set_max_bytes(chunk_bytes * 2 + 1);
+
+    // The output chunk is limited by bytes rather than rows.
+    accumulator.push(new_chunk());
+    ASSERT_FALSE(accumulator.has_output());
+    accumulator.push(new_chunk());
+    ASSERT_TRUE(accumulator.has_output());
+    ChunkPtr output = std::move(accumulator.pull());
+    ASSERT_EQ(200, output->num_rows());
+
+    accumulator.push(new_chunk());
+    ASSERT_FALSE(accumulator.has_output());
+    accumulator.finalize();
+    ASSERT_TRUE(accumulator.has_output());
+    output = std::move(accumulator.pull());
+    ASSERT_EQ(100, output->num_rows());
+    ASSERT_TRUE(accumulator.is_finished());
+}
+
+TEST_F(ChunkHelperTest, PipelineAccumulatorSegments) {
+    auto* tuple_desc = _create_simple_desc();
+    auto new_chunk = [tuple_desc](size_t num_rows) {
+        ChunkPtr chunk = ChunkHelper::new_chunk(*tuple_desc, num_rows);
+        for (auto& column : chunk->columns()) {
+            column->append_default(num_rows);
+        }
+        return chunk;
+    };
+
+    ChunkPipelineAccumulator accumulator;
+    accumulator.set_max_size(1000);
+
+    // a large chunk is passed through without copying
+    auto large = new_chunk(900);
+    accumulator.push(large);
+    ASSERT_TRUE(accumulator.has_output());
+    ChunkPtr output = std::move(accumulator.pull());
+    ASSERT_EQ(large.get(), output.get());
+
+    // the small chunks are concatenated once they're enough
+    for (int i = 0; i < 7; i++) {
+        accumulator.push(new_chunk(100));
+        ASSERT_FALSE(accumulator.has_output());
+    }
+    accumulator.push(new_chunk(100));
+    ASSERT_TRUE(accumulator.has_output());
+    output = std::move(accumulator.pull());
+    ASSERT_EQ(800, output->num_rows());
+    output->check_or_die();
+
+    // the pending chunks exceeding the max size
+    accumulator.push(new_chunk(500));
+    accumulator.push(new_chunk(600));
+    ASSERT_TRUE(accumulator.has_output());
+    output = std::move(accumulator.pull());
+    ASSERT_EQ(500, output->num_rows());
+    accumulator.finalize();
+    ASSERT_TRUE(accumulator.has_output());
+    output = std::move(accumulator.pull());
+    ASSERT_EQ(600, output->num_rows());
+    ASSERT_TRUE(accumulator.is_finished());
+}
+
+// NOLINTNEXTLINE
+TEST_F(ChunkHelperTest, ChunkRecycler) {
+    auto schema = gen_v_schema(true);
+    auto recycler = std::make_shared<ChunkRecycler>(*schema, 1024, 1);
+
+    // the released chunk is reused with its columns
+    auto chunk = recycler->new_chunk();
+    chunk->get_column_by_index(0)->append_default(100);
+    auto* chunk_ptr = chunk.get();
+    auto* column_ptr = chunk->get_column_by_index(0).get();
+    chunk.reset();
+    ASSERT_EQ(1, recycler->num_recycled_chunks());
+    chunk = recycler->new_chunk();
+    ASSERT_EQ(chunk_ptr, chunk.get());
+    ASSERT_EQ(column_ptr, chunk->get_column_by_index(0).get());
+    ASSERT_EQ(0, chunk->get_column_by_index(0)->size());
+    ASSERT_EQ(0, recycler->num_recycled_chunks());
+
+    // the chunk whose columns are shared is not reused
+    ColumnPtr shared = chunk->get_column_by_index(1);
+    chunk.reset();
+    ASSERT_EQ(0, recycler->num_recycled_chunks());
+
+    // the chunk whose columns are changed is not reused
+    chunk = recycler->new_chunk();
+    chunk->update_column_by_index(Int32Column::create(), 0);
+    chunk.reset();
+    ASSERT_EQ(0, recycler->num_recycled_chunks());
+
+    // at most |capacity| chunks are kept
+    auto chunk1 = recycler->new_chunk();
+    auto chunk2 = recycler->new_chunk();
+    chunk1.reset();
+    chunk2.reset();
+    ASSERT_EQ(1, recycler->num_recycled_chunks());
+
+    // no chunk is kept after closed
+    chunk = recycler->new_chunk();
+    recycler->close();
+    chunk.reset();
+    ASSERT_EQ(0, recycler->num_recycled_chunks());
+}
+
 } // namespace starrocks
@@ -2162,6 +2162,53 @@ TEST(ColumnPredicateTest, zone_map_filter_varchar) {
     EXPECT_TRUE(not_in_xx_yy->ZMF(Datum("xy"), Datum("zz")));
 }
 
+#define ZMA(min, max, has_null) zone_map_all_match(ZoneMapDetail(min, max, has_null))
+
+// NOLINTNEXTLINE
+TEST(ColumnPredicateTest, zone_map_all_match) {
+    std::unique_ptr<ColumnPredicate> eq_100(new_column_eq_predicate(get_type_info(TYPE_INT), 0, "100"));
+    std::unique_ptr<ColumnPredicate> ne_100(new_column_ne_predicate(get_type_info(TYPE_INT), 0, "100"));
+    std::unique_ptr<ColumnPredicate> gt_100(new_column_gt_predicate(get_type_info(TYPE_INT), 0, "100"));
+    std::unique_ptr<ColumnPredicate> ge_100(new_column_ge_predicate(get_type_info(TYPE_INT), 0, "100"));
+    std::unique_ptr<ColumnPredicate> lt_100(new_column_lt_predicate(get_type_info(TYPE_INT), 0, "100"));
+    std::unique_ptr<ColumnPredicate> le_100(new_column_le_predicate(get_type_info(TYPE_INT), 0, "100"));
+    std::unique_ptr<ColumnPredicate> in_90_100(new_column_in_predicate(get_type_info(TYPE_INT), 0, {"90", "100"}));
+
+    EXPECT_TRUE(eq_100->ZMA(Datum(100), Datum(100), false));
+    EXPECT_FALSE(eq_100->ZMA(Datum(100), Datum(100), true));
+    EXPECT_FALSE(eq_100->ZMA(Datum(90), Datum(100), false));
+
+    EXPECT_FALSE(ne_100->ZMA(Datum(101), Datum(200), false));
+
+    EXPECT_TRUE(gt_100->ZMA(Datum(101), Datum(200), false));
+    EXPECT_FALSE(gt_100->ZMA(Datum(100), Datum(200), false));
+    EXPECT_FALSE(gt_100->ZMA(Datum(101), Datum(200), true));
+    EXPECT_FALSE(gt_100->ZMA(Datum(), Datum(), true));
+
+    EXPECT_TRUE(ge_100->ZMA(Datum(100), Datum(200), false));
+    EXPECT_FALSE(ge_100->ZMA(Datum(99), Datum(200), false));
+
+    EXPECT_TRUE(lt_100->ZMA(Datum(0), Datum(99), false));
+    EXPECT_FALSE(lt_100->ZMA(Datum(0), Datum(100), false));
+    EXPECT_FALSE(lt_100->ZMA(Datum(0), Datum(99), true));
+
+    EXPECT_TRUE(le_100->ZMA(Datum(0), Datum(100), false));
+    EXPECT_FALSE(le_100->ZMA(Datum(0), Datum(101), false));
+
+    EXPECT_FALSE(in_90_100->ZMA(Datum(90), Datum(90), false));
+
+    std::unique_ptr<ColumnPredicate> ge_xx(new_column_ge_predicate(get_type_info(TYPE_VARCHAR), 0, "xx"));
+    std::unique_ptr<ColumnPredicate> lt_xx(new_column_lt_predicate(get_type_info(TYPE_VARCHAR), 0, "xx"));
+    EXPECT_TRUE(ge_xx->ZMA(Datum("xx"), Datum("yy"), false));
+    EXPECT_FALSE(ge_xx->ZMA(Datum("x"), Datum("yy"), false));
+    EXPECT_TRUE(lt_xx->ZMA(Datum("ab"), Datum("xw"), false));
+    EXPECT_FALSE(lt_xx->ZMA(Datum("ab"), Datum("xx"), false));
+
+    // CHAR is padded with zeros in storage, never skip the evaluation.
+    std::unique_ptr<ColumnPredicate> ge_char_xx(new_column_ge_predicate(get_type_info(TYPE_CHAR), 0, "xx"));
+    EXPECT_FALSE(ge_char_xx->ZMA(Datum("xx"), Datum("yy"), false));
+}
+
 // NOLINTNEXTLINE
 TEST(ColumnPredicateTest, test_convert_cmp_predicate) {
     // clang-format off
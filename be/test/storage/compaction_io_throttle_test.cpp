@@ -0,0 +1,98 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "storage/compaction_io_throttle.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "common/config.h"
+
+namespace starrocks {
+
+class CompactionIOThrottleTest : public testing::Test {
+public:
+    void SetUp() override {
+        _bytes_per_second = config::compaction_io_bytes_per_second_per_disk;
+        _count_per_second = config::compaction_io_count_per_second_per_disk;
+        _latency_threshold_us = config::compaction_query_io_latency_threshold_us;
+    }
+
+    void TearDown() override {
+        config::compaction_io_bytes_per_second_per_disk = _bytes_per_second;
+        config::compaction_io_count_per_second_per_disk = _count_per_second;
+        config::compaction_query_io_latency_threshold_us = _latency_threshold_us;
+    }
+
+private:
+    int64_t _bytes_per_second = 0;
+    int64_t _count_per_second = 0;
+    int64_t _latency_threshold_us = 0;
+};
+
+TEST_F(CompactionIOThrottleTest, test_unlimited) {
+    config::compaction_io_bytes_per_second_per_disk = 0;
+    config::compaction_io_count_per_second_per_disk = 0;
+    CompactionIOThrottle throttle;
+    ASSERT_EQ(0, throttle.acquire(1L << 40, 1L << 20));
+    ASSERT_EQ(0, throttle.acquire(1L << 40, 1L << 20));
+}
+
+TEST_F(CompactionIOThrottleTest, test_bytes_budget) {
+    config::compaction_io_bytes_per_second_per_disk = 1 << 20;
+    config::compaction_io_count_per_second_per_disk = 0;
+    CompactionIOThrottle throttle;
+    // the budget of one second can be used at once
+    ASSERT_EQ(0, throttle.acquire(1 << 20, 1));
+    int64_t wait_ns = throttle.acquire(2 << 20, 1);
+    ASSERT_GT(wait_ns, 1500000000L);
+    ASSERT_LE(wait_ns, 2000000000L);
+}
+
+TEST_F(CompactionIOThrottleTest, test_count_budget) {
+    config::compaction_io_bytes_per_second_per_disk = 0;
+    config::compaction_io_count_per_second_per_disk = 100;
+    CompactionIOThrottle throttle;
+    ASSERT_EQ(0, throttle.acquire(1 << 20, 100));
+    int64_t wait_ns = throttle.acquire(1 << 20, 100);
+    ASSERT_GT(wait_ns, 500000000L);
+    ASSERT_LE(wait_ns, 1000000000L);
+}
+
+TEST_F(CompactionIOThrottleTest, test_query_latency) {
+    config::compaction_io_bytes_per_second_per_disk = 1 << 20;
+    config::compaction_query_io_latency_threshold_us = 100;
+    CompactionIOThrottle throttle;
+    // 1ms per io
+    throttle.add_query_io(100 * 1000 * 1000, 100);
+    ASSERT_TRUE(throttle.is_query_peak());
+    ASSERT_DOUBLE_EQ(0.5, throttle.budget_ratio());
+    // the budget is halved
+    ASSERT_EQ(0, throttle.acquire(512 << 10, 1));
+    ASSERT_GT(throttle.acquire(512 << 10, 1), 500000000L);
+
+    // no query io in the next interval
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    ASSERT_FALSE(throttle.is_query_peak());
+    ASSERT_DOUBLE_EQ(0.625, throttle.budget_ratio());
+
+    config::compaction_query_io_latency_threshold_us = 0;
+    ASSERT_FALSE(throttle.is_query_peak());
+    ASSERT_DOUBLE_EQ(1.0, throttle.budget_ratio());
+}
+
+} // namespace starrocks
@@ -65,6 +65,34 @@ public:
         tablet_meta->add_rs_meta(src_rowset->rowset_meta());
     }
 
+    // Write a version whose k1 are [version * 1024, version * 1024 + 1024) in order.
+    void write_sorted_version(const TabletMetaSharedPtr& tablet_meta) {
+        RowsetWriterContext rowset_writer_context;
+        create_rowset_writer_context(&rowset_writer_context, _version);
+        std::unique_ptr<RowsetWriter> rowset_writer;
+        ASSERT_TRUE(RowsetFactory::create_rowset_writer(rowset_writer_context, &rowset_writer).ok());
+
+        auto schema = ChunkHelper::convert_schema(*_tablet_schema);
+        for (size_t j = 0; j < 8; ++j) {
+            auto chunk = ChunkHelper::new_chunk(schema, 128);
+            auto& cols = chunk->columns();
+            for (size_t i = 0; i < 128; ++i) {
+                cols[0]->append_datum(Datum(static_cast<int32_t>(_version * 1024 + j * 128 + i)));
+                cols[1]->append_datum(Datum(Slice("well")));
+                cols[2]->append_datum(Datum(static_cast<int32_t>(i)));
+            }
+            ASSERT_OK(rowset_writer->add_chunk(*chunk));
+        }
+        _version++;
+
+        ASSERT_OK(rowset_writer->flush());
+        RowsetSharedPtr src_rowset = *rowset_writer->build();
+        ASSERT_TRUE(src_rowset != nullptr);
+        ASSERT_EQ(1024, src_rowset->num_rows());
+
+        tablet_meta->add_rs_meta(src_rowset->rowset_meta());
+    }
+
     void write_specify_version(const TabletSharedPtr& tablet, int64_t version) {
         RowsetWriterContext rowset_writer_context;
         create_rowset_writer_context(&rowset_writer_context, version);
@@ -354,6 +382,38 @@ TEST_F(DefaultCompactionPolicyTest, test_max_cumulative_compaction) {
     ASSERT_EQ(5, versions[1].second);
 }
 
+TEST_F(DefaultCompactionPolicyTest, test_trivial_move_cumulative_compaction) {
+    LOG(INFO) << "test_trivial_move_cumulative_compaction";
+    create_tablet_schema(DUP_KEYS);
+
+    config::compaction_trivial_move_min_segment_bytes = 0;
+    DeferOp defer([&] { config::compaction_trivial_move_min_segment_bytes = 67108864; });
+
+    TabletMetaSharedPtr tablet_meta = std::make_shared<TabletMeta>();
+    create_tablet_meta(tablet_meta.get());
+
+    for (int i = 0; i < 6; ++i) {
+        write_sorted_version(tablet_meta);
+    }
+
+    TabletSharedPtr tablet =
+            Tablet::create_tablet_from_meta(tablet_meta, starrocks::StorageEngine::instance()->get_stores()[0]);
+    tablet->init();
+    init_compaction_context(tablet);
+
+    auto res = compact(tablet);
+    ASSERT_TRUE(res.ok());
+
+    ASSERT_EQ(2, tablet->version_count());
+    ASSERT_EQ(5, tablet->cumulative_layer_point());
+    // the segments are linked into the output rowset instead of being merged into one
+    auto rowset = tablet->get_rowset_by_version(Version(0, 4));
+    ASSERT_TRUE(rowset != nullptr);
+    ASSERT_EQ(5, rowset->num_segments());
+    ASSERT_EQ(5 * 1024, rowset->num_rows());
+    ASSERT_EQ(NONOVERLAPPING, rowset->rowset_meta()->segments_overlap());
+}
+
 TEST_F(DefaultCompactionPolicyTest, test_tablet_not_running) {
     LOG(INFO) << "test_tablet_not_running";
     create_tablet_schema(UNIQUE_KEYS);
@@ -193,6 +193,32 @@ TEST_F(TestHll, Normal) {
     }
 }
 
+TEST_F(TestHll, UpdateBatch) {
+    // explicit, sparse and full
+    for (uint64_t num_values : {100, 1000, 100000}) {
+        std::vector<uint64_t> hash_values;
+        for (uint64_t i = 0; i < num_values; i++) {
+            hash_values.push_back(i % 10 == 0 ? 0 : hash(i));
+        }
+        HyperLogLog expected;
+        for (uint64_t hash_value : hash_values) {
+            if (hash_value != 0) {
+                expected.update(hash_value);
+            }
+        }
+        HyperLogLog actual;
+        actual.update_batch(hash_values.data(), hash_values.size() / 2);
+        actual.update_batch(hash_values.data() + hash_values.size() / 2, hash_values.size() - hash_values.size() / 2);
+        ASSERT_EQ(expected.estimate_cardinality(), actual.estimate_cardinality());
+
+        std::string expected_buf(expected.max_serialized_size(), '\0');
+        std::string actual_buf(actual.max_serialized_size(), '\0');
+        expected_buf.resize(expected.serialize((uint8_t*)expected_buf.data()));
+        actual_buf.resize(actual.serialize((uint8_t*)actual_buf.data()));
+        ASSERT_EQ(expected_buf, actual_buf);
+    }
+}
+
 TEST_F(TestHll, InvalidPtr) {
     {
         HyperLogLog hll(Slice((char*)nullptr, 0));
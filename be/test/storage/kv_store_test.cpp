@@ -39,7 +39,10 @@
 #include <filesystem>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
+#include "common/config.h"
 #include "fs/fs_util.h"
 #include "storage/olap_define.h"
 
@@ -127,4 +130,60 @@ TEST_F(KVStoreTest, TestIterate) {
     ASSERT_EQ(false, error_flag);
 }
 
+TEST_F(KVStoreTest, TestGroupCommit) {
+    auto old_sync = config::sync_tablet_meta;
+    auto old_window = config::tablet_meta_group_commit_window_us;
+    auto old_max_bytes = config::tablet_meta_group_commit_max_bytes;
+    config::sync_tablet_meta = true;
+    config::tablet_meta_group_commit_window_us = 1000;
+    config::tablet_meta_group_commit_max_bytes = 1024;
+
+    ASSERT_TRUE(_kv_store->put(META_COLUMN_FAMILY_INDEX, "removed_key_1", "value").ok());
+    ASSERT_TRUE(_kv_store->put(META_COLUMN_FAMILY_INDEX, "removed_key_2", "value").ok());
+
+    std::vector<std::thread> threads;
+    std::vector<Status> statuses(16);
+    for (int i = 0; i < 16; i++) {
+        threads.emplace_back([&, i] {
+            WriteBatch batch;
+            for (int j = 0; j < 10; j++) {
+                auto key = "key_" + std::to_string(i) + "_" + std::to_string(j);
+                batch.Put(_kv_store->handle(META_COLUMN_FAMILY_INDEX), key, std::to_string(i * 10 + j));
+                batch.Put(_kv_store->handle(DEFAULT_COLUMN_FAMILY_INDEX), key, "default");
+            }
+            if (i == 0) {
+                batch.DeleteRange(_kv_store->handle(META_COLUMN_FAMILY_INDEX), "removed_key_", "removed_key_~");
+            }
+            statuses[i] = _kv_store->write_batch(&batch);
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    ASSERT_TRUE(_kv_store->remove(META_COLUMN_FAMILY_INDEX, "key_0_0").ok());
+
+    for (int i = 0; i < 16; i++) {
+        ASSERT_TRUE(statuses[i].ok()) << statuses[i];
+        for (int j = 0; j < 10; j++) {
+            auto key = "key_" + std::to_string(i) + "_" + std::to_string(j);
+            std::string value;
+            if (i == 0 && j == 0) {
+                ASSERT_TRUE(_kv_store->get(META_COLUMN_FAMILY_INDEX, key, &value).is_not_found());
+                continue;
+            }
+            ASSERT_TRUE(_kv_store->get(META_COLUMN_FAMILY_INDEX, key, &value).ok());
+            ASSERT_EQ(std::to_string(i * 10 + j), value);
+            ASSERT_TRUE(_kv_store->get(DEFAULT_COLUMN_FAMILY_INDEX, key, &value).ok());
+            ASSERT_EQ("default", value);
+        }
+    }
+    std::string value;
+    ASSERT_TRUE(_kv_store->get(META_COLUMN_FAMILY_INDEX, "removed_key_1", &value).is_not_found());
+    ASSERT_TRUE(_kv_store->get(META_COLUMN_FAMILY_INDEX, "removed_key_2", &value).is_not_found());
+
+    config::sync_tablet_meta = old_sync;
+    config::tablet_meta_group_commit_window_us = old_window;
+    config::tablet_meta_group_commit_max_bytes = old_max_bytes;
+}
+
 } // namespace starrocks
@@ -25,6 +25,7 @@
 #include "column/fixed_length_column.h"
 #include "column/schema.h"
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
 #include "common/logging.h"
 #include "fs/fs_util.h"
 #include "runtime/mem_tracker.h"
@@ -38,6 +39,7 @@
 #include "storage/tablet_schema.h"
 #include "testutil/assert.h"
 #include "testutil/id_generator.h"
+#include "util/defer_op.h"
 
 namespace starrocks::lake {
 
@@ -205,6 +207,78 @@ TEST_F(DuplicateKeyHorizontalCompactionTest, test1) {
     ASSERT_EQ(1, new_tablet_metadata->rowsets_size());
 }
 
+TEST_F(DuplicateKeyHorizontalCompactionTest, test_sub_ranges) {
+    auto indexes = std::vector<uint32_t>(kChunkSize);
+    for (int i = 0; i < kChunkSize; i++) {
+        indexes[i] = i;
+    }
+
+    // The rowsets are loaded in the reverse order of the keys: [24, 36), [12, 24), [0, 12).
+    auto version = 1;
+    auto tablet_id = _tablet_metadata->id();
+    for (int i = 2; i >= 0; i--) {
+        auto chunk = generate_data(kChunkSize);
+        auto c0 = down_cast<Int32Column*>(chunk.get_column_by_index(0).get());
+        auto c1 = down_cast<Int32Column*>(chunk.get_column_by_index(1).get());
+        for (int j = 0; j < kChunkSize; j++) {
+            c0->get_data()[j] += i * kChunkSize;
+            c1->get_data()[j] = c0->get_data()[j] * 3;
+        }
+        _txn_id++;
+        auto delta_writer = DeltaWriter::create(_tablet_manager.get(), tablet_id, _txn_id, _partition_id, nullptr,
+                                                _mem_tracker.get());
+        ASSERT_OK(delta_writer->open());
+        ASSERT_OK(delta_writer->write(chunk, indexes.data(), indexes.size()));
+        ASSERT_OK(delta_writer->finish());
+        delta_writer->close();
+        ASSERT_OK(_tablet_manager->publish_version(tablet_id, version, version + 1, &_txn_id, 1).status());
+        version++;
+    }
+
+    auto old_max_sub_ranges = config::lake_compaction_max_sub_ranges;
+    auto old_min_sub_range_bytes = config::lake_compaction_min_sub_range_bytes;
+    config::lake_compaction_max_sub_ranges = 3;
+    config::lake_compaction_min_sub_range_bytes = 1;
+    DeferOp defer([&]() {
+        config::lake_compaction_max_sub_ranges = old_max_sub_ranges;
+        config::lake_compaction_min_sub_range_bytes = old_min_sub_range_bytes;
+    });
+
+    _txn_id++;
+    ASSIGN_OR_ABORT(auto task, _tablet_manager->compact(tablet_id, version, _txn_id));
+    ASSERT_OK(task->execute(nullptr));
+    ASSERT_OK(_tablet_manager->publish_version(tablet_id, version, version + 1, &_txn_id, 1).status());
+    version++;
+
+    // Every range is written into its own segment, in the order of the keys.
+    ASSIGN_OR_ABORT(auto new_tablet_metadata, _tablet_manager->get_tablet_metadata(tablet_id, version));
+    ASSERT_EQ(1, new_tablet_metadata->rowsets_size());
+    ASSERT_EQ(3, new_tablet_metadata->rowsets(0).segments_size());
+    ASSERT_EQ(kChunkSize * 3, new_tablet_metadata->rowsets(0).num_rows());
+    ASSERT_FALSE(new_tablet_metadata->rowsets(0).overlapped());
+
+    ASSIGN_OR_ABORT(auto tablet, _tablet_manager->get_tablet(tablet_id));
+    ASSIGN_OR_ABORT(auto reader, tablet.new_reader(version, *_schema));
+    ASSERT_OK(reader->prepare());
+    ASSERT_OK(reader->open(TabletReaderParams()));
+    auto chunk = ChunkHelper::new_chunk(*_schema, 128);
+    int expected = 0;
+    while (true) {
+        auto st = reader->get_next(chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        ASSERT_OK(st);
+        for (int i = 0; i < chunk->num_rows(); i++) {
+            ASSERT_EQ(expected, chunk->get(i)[0].get_int32());
+            ASSERT_EQ(expected * 3, chunk->get(i)[1].get_int32());
+            expected++;
+        }
+        chunk->reset();
+    }
+    ASSERT_EQ(kChunkSize * 3, expected);
+}
+
 class DuplicateKeyOverlapSegmentsHorizontalCompactionTest : public LakeCompactionTest {
 public:
     DuplicateKeyOverlapSegmentsHorizontalCompactionTest() : LakeCompactionTest(kTestGroupPath) {
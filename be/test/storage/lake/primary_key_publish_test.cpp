@@ -21,12 +21,14 @@
 #include "column/fixed_length_column.h"
 #include "column/schema.h"
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
 #include "common/logging.h"
 #include "fs/fs_util.h"
 #include "storage/chunk_helper.h"
 #include "storage/lake/delta_writer.h"
 #include "storage/lake/fixed_location_provider.h"
 #include "storage/lake/join_path.h"
+#include "storage/lake/lake_primary_index.h"
 #include "storage/lake/location_provider.h"
 #include "storage/lake/meta_file.h"
 #include "storage/lake/tablet.h"
@@ -39,6 +41,7 @@
 #include "storage/tablet_schema.h"
 #include "testutil/assert.h"
 #include "testutil/id_generator.h"
+#include "util/defer_op.h"
 
 namespace starrocks::lake {
 
@@ -370,6 +373,44 @@ TEST_F(PrimaryKeyPublishTest, test_publish_multi_times) {
     ASSERT_EQ(kChunkSize, read(version));
 }
 
+TEST_F(PrimaryKeyPublishTest, test_publish_with_local_persistent_index) {
+    auto tablet_id = _tablet_metadata->id();
+    auto index_path = LakePrimaryIndex::local_index_path(tablet_id);
+    if (index_path.empty()) {
+        GTEST_SKIP() << "no local store";
+    }
+    config::enable_lake_persistent_index = true;
+    DeferOp defer([&]() {
+        config::enable_lake_persistent_index = false;
+        (void)LakePrimaryIndex::remove_local_index(tablet_id);
+    });
+    auto indexes = std::vector<uint32_t>(kChunkSize);
+    for (int i = 0; i < kChunkSize; i++) {
+        indexes[i] = i;
+    }
+
+    auto version = 1;
+    for (int i = 0; i < 4; i++) {
+        auto chunk = generate_data(kChunkSize, i % 2);
+        _txn_id++;
+        auto delta_writer = DeltaWriter::create(_tablet_manager.get(), tablet_id, _txn_id, _partition_id, nullptr,
+                                                _mem_tracker.get());
+        ASSERT_OK(delta_writer->open());
+        ASSERT_OK(delta_writer->write(chunk, indexes.data(), indexes.size()));
+        ASSERT_OK(delta_writer->finish());
+        delta_writer->close();
+        // Publish version
+        ASSERT_OK(_tablet_manager->publish_version(tablet_id, version, version + 1, &_txn_id, 1).status());
+        version++;
+        ASSERT_TRUE(fs::path_exist(index_path + "/index.meta"));
+        // the index is loaded from the local files in the next publish
+        _update_manager->remove_primary_index_cache(tablet_id);
+        ASSERT_EQ(kChunkSize * std::min(i + 1, 2), read(version));
+    }
+    ASSIGN_OR_ABORT(auto new_tablet_metadata, _tablet_manager->get_tablet_metadata(tablet_id, version));
+    EXPECT_EQ(new_tablet_metadata->rowsets_size(), 4);
+}
+
 TEST_F(PrimaryKeyPublishTest, test_publish_concurrent) {
     auto chunk0 = generate_data(kChunkSize, 0);
     auto indexes = std::vector<uint32_t>(kChunkSize);
@@ -84,6 +84,38 @@ TEST_F(LakeTabletManagerTest, tablet_meta_write_and_read) {
     EXPECT_TRUE(res.status().is_not_found());
 }
 
+// NOLINTNEXTLINE
+TEST_F(LakeTabletManagerTest, get_cache_residency) {
+    starrocks::lake::TabletMetadata metadata;
+    metadata.set_id(12345);
+    metadata.set_version(2);
+    auto rowset = metadata.add_rowsets();
+    rowset->set_id(2);
+    rowset->set_data_size(1024);
+    rowset->add_segments("a.dat");
+    rowset->add_segments("b.dat");
+    // The rowset of delete predicate has no segments.
+    metadata.add_rowsets()->set_id(3);
+    EXPECT_OK(_tablet_manager->put_tablet_metadata(metadata));
+    for (const auto& name : {"a.dat", "b.dat"}) {
+        ASSIGN_OR_ABORT(auto wfile,
+                        FileSystem::Default()->new_writable_file(_tablet_manager->segment_location(12345, name)));
+        EXPECT_OK(wfile->append("data"));
+        EXPECT_OK(wfile->close());
+    }
+
+    ASSIGN_OR_ABORT(auto tablet, _tablet_manager->get_tablet(12345));
+    ASSIGN_OR_ABORT(auto residency, tablet.get_cache_residency(2));
+    EXPECT_EQ(2, residency.num_segments);
+    // The local file system has no local cache.
+    EXPECT_EQ(0, residency.num_cached_segments);
+    EXPECT_EQ(1024, residency.data_size);
+    EXPECT_EQ(0, residency.cached_data_size);
+    EXPECT_EQ(0, residency.cached_ratio());
+
+    EXPECT_TRUE(tablet.get_cache_residency(3).status().is_not_found());
+}
+
 // NOLINTNEXTLINE
 TEST_F(LakeTabletManagerTest, txnlog_write_and_read) {
     starrocks::lake::TxnLog txnLog;
@@ -35,6 +35,7 @@
 #include "storage/rowset/rowset_writer.h"
 #include "storage/rowset/rowset_writer_context.h"
 #include "testutil/assert.h"
+#include "util/defer_op.h"
 
 namespace starrocks {
 
@@ -288,6 +289,58 @@ TEST_F(MemTableTest, testDupKeysInsertFlushRead) {
     ASSERT_EQ(n, pkey_read);
 }
 
+TEST_F(MemTableTest, testDupKeysSortedRuns) {
+    const string path = "./ut_dir/MemTableTest_testDupKeysSortedRuns";
+    MySetUp(create_tablet_schema("pk int,name varchar,pv int", 1, KeysType::DUP_KEYS), "pk int,name varchar,pv int",
+            path);
+    const int64_t old_sorted_run_rows = config::memtable_sorted_run_rows;
+    config::memtable_sorted_run_rows = 1000;
+    DeferOp defer([&]() { config::memtable_sorted_run_rows = old_sorted_run_rows; });
+
+    const size_t n = 3500;
+    auto pchunk = gen_chunk(*_slots, n);
+    vector<uint32_t> indexes;
+    indexes.reserve(n);
+    for (int i = 0; i < n; i++) {
+        indexes.emplace_back(i);
+    }
+    std::shuffle(indexes.begin(), indexes.end(), std::mt19937(std::random_device()()));
+    // 3 sorted runs and 500 pending rows
+    for (int i = 0; i < 7; i++) {
+        _mem_table->insert(*pchunk, indexes.data(), i * 500, 500);
+    }
+    ASSERT_GT(_mem_table->write_buffer_size(), 0);
+    ASSERT_OK(_mem_table->finalize());
+    ASSERT_OK(_mem_table->flush());
+    RowsetSharedPtr rowset = *_writer->build();
+    unique_ptr<Schema> read_schema = create_schema("pk int", 1);
+    OlapReaderStatistics stats;
+    RowsetReadOptions rs_opts;
+    rs_opts.sorted = false;
+    rs_opts.use_page_cache = false;
+    rs_opts.stats = &stats;
+    auto itr = rowset->new_iterator(*read_schema, rs_opts);
+    ASSERT_TRUE(itr.ok()) << itr.status().to_string();
+    std::shared_ptr<Chunk> chunk = ChunkHelper::new_chunk(*read_schema, 4096);
+    size_t pkey_read = 0;
+    int last_value = 0;
+    while (true) {
+        Status st = (*itr)->get_next(chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        auto column = chunk->get_column_by_name("pk");
+        for (size_t i = 0; i < column->size(); i++) {
+            int new_value = column->get(i).get_int32();
+            ASSERT_LE(last_value, new_value);
+            last_value = new_value;
+        }
+        pkey_read += chunk->num_rows();
+        chunk->reset();
+    }
+    ASSERT_EQ(n, pkey_read);
+}
+
 TEST_F(MemTableTest, testUniqKeysInsertFlushRead) {
     const string path = "./ut_dir/MemTableTest_testUniqKeysInsertFlushRead";
     MySetUp(create_tablet_schema("pk int,name varchar,pv int", 1, KeysType::UNIQUE_KEYS), "pk int,name varchar,pv int",
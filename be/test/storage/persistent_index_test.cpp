@@ -18,6 +18,7 @@
 
 #include <cstdlib>
 
+#include "common/config.h"
 #include "fs/fs_memory.h"
 #include "fs/fs_util.h"
 #include "storage/chunk_helper.h"
@@ -1064,9 +1065,85 @@ PARALLEL_TEST(PersistentIndexTest, test_flush_fixlen_to_immutable) {
         check_not_exist_key_slices[i] = Slice((uint8_t*)(&check_not_exist_keys[i]), sizeof(Key));
     }
     ASSERT_TRUE(idx_loaded->check_not_exist(10, check_not_exist_key_slices.data(), sizeof(Key)).ok());
+
+    // The missing keys are filtered by the bloom filters of the shards.
+    ASSERT_GT(idx_loaded->memory_usage(), 0);
+    KeysInfo missing_keys_info;
+    for (size_t i = 0; i < 10; i++) {
+        missing_keys_info.key_infos.emplace_back(i, key_index_hash(&check_not_exist_keys[i], sizeof(Key)));
+    }
+    vector<IndexValue> missing_values(10, IndexValue(1));
+    KeysInfo missing_found_keys_info;
+    ASSERT_TRUE(idx_loaded
+                        ->get(10, check_not_exist_key_slices.data(), missing_keys_info, missing_values.data(),
+                              &missing_found_keys_info, sizeof(Key))
+                        .ok());
+    ASSERT_EQ(0, missing_found_keys_info.size());
+    for (size_t i = 0; i < 10; i++) {
+        ASSERT_EQ(NullIndexValue, missing_values[i].get_value());
+    }
     ASSERT_TRUE(fs::remove_all("./index.l1.1.1").ok());
 }
 
+TEST(PersistentIndexTest, test_parallel_probe_immutable_shards) {
+    using Key = uint64_t;
+    const int N = 100000;
+    vector<Key> keys(N);
+    vector<IndexValue> values(N);
+    vector<Slice> key_slices;
+    vector<size_t> idxes;
+    for (int i = 0; i < N; i++) {
+        keys[i] = i;
+        values[i] = i * 3;
+        idxes.push_back(i);
+    }
+    for (int i = 0; i < N; i++) {
+        key_slices.emplace_back((uint8_t*)(&keys[i]), sizeof(Key));
+    }
+    ASSIGN_OR_ABORT(auto idx, MutableIndex::create(sizeof(Key)));
+    ASSERT_TRUE(idx->insert(key_slices.data(), values.data(), idxes).ok());
+
+    const std::string file_name = "./index.l1.parallel_probe";
+    auto writer = std::make_unique<ImmutableIndexWriter>();
+    ASSERT_TRUE(writer->init(file_name, EditVersion(1, 1), false).ok());
+    const size_t nshard = 8;
+    auto npage_hint = (sizeof(Key) + 8) * N / nshard / 4096 + 1;
+    auto nbucket = MutableIndex::estimate_nbucket(sizeof(Key), N, nshard, npage_hint);
+    ASSERT_TRUE(idx->flush_to_immutable_index(writer, nshard, npage_hint, nbucket, true).ok());
+    ASSERT_TRUE(writer->finish().ok());
+
+    ASSIGN_OR_ABORT(auto fs, FileSystem::CreateSharedFromString("posix://"));
+    ASSIGN_OR_ABORT(auto rf, fs->new_random_access_file(file_name));
+    ASSIGN_OR_ABORT(auto idx_loaded, ImmutableIndex::load(std::move(rf)));
+
+    auto old_min_keys = config::pindex_parallel_probe_min_keys;
+    config::pindex_parallel_probe_min_keys = 1;
+    // Probe the existing keys and the same number of missing keys.
+    vector<Key> probe_keys(2 * N);
+    vector<Slice> probe_slices;
+    KeysInfo keys_info;
+    for (int i = 0; i < 2 * N; i++) {
+        probe_keys[i] = i;
+    }
+    for (int i = 0; i < 2 * N; i++) {
+        probe_slices.emplace_back((uint8_t*)(&probe_keys[i]), sizeof(Key));
+        keys_info.key_infos.emplace_back(i, key_index_hash(&probe_keys[i], sizeof(Key)));
+    }
+    vector<IndexValue> get_values(2 * N);
+    KeysInfo found_keys_info;
+    ASSERT_TRUE(idx_loaded->get(2 * N, probe_slices.data(), keys_info, get_values.data(), &found_keys_info,
+                                sizeof(Key))
+                        .ok());
+    ASSERT_EQ(N, found_keys_info.size());
+    for (int i = 0; i < 2 * N; i++) {
+        ASSERT_EQ(i < N ? values[i].get_value() : NullIndexValue, get_values[i].get_value());
+    }
+    ASSERT_TRUE(idx_loaded->check_not_exist(N, probe_slices.data(), sizeof(Key)).is_already_exist());
+    ASSERT_TRUE(idx_loaded->check_not_exist(N, probe_slices.data() + N, sizeof(Key)).ok());
+    config::pindex_parallel_probe_min_keys = old_min_keys;
+    ASSERT_TRUE(fs::remove_all(file_name).ok());
+}
+
 PARALLEL_TEST(PersistentIndexTest, test_flush_varlen_to_immutable) {
     const std::string kPersistentIndexDir = "./PersistentIndexTest_test_flush_varlen_to_immutable";
     ASSIGN_OR_ABORT(auto fs, FileSystem::CreateSharedFromString("posix://"));
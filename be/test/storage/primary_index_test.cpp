@@ -154,7 +154,7 @@ PARALLEL_TEST(PrimaryIndexTest, test_largeint) {
 }
 
 template <LogicalType field_type>
-void test_binary_pk() {
+void test_binary_pk(const std::string& prefix = "binary_pk_") {
     auto f = std::make_shared<Field>(0, "c0", field_type, false);
     f->set_is_key(true);
     auto schema = std::make_shared<Schema>(Fields{f}, PRIMARY_KEYS, std::vector<ColumnId>{0});
@@ -171,21 +171,21 @@ void test_binary_pk() {
     // [0, kSegmentSize)
     pk_col->resize(0);
     for (int i = 0; i < kSegmentSize; i++) {
-        pk_col->append(strings::Substitute("binary_pk_$0", pk_value++));
+        pk_col->append(prefix + std::to_string(pk_value++));
     }
     ASSERT_TRUE(pk_index->insert(0, 0, *pk_col).ok());
 
     // [kSegmentSize, 2*kSegmentSize)
     pk_col->resize(0);
     for (int i = 0; i < kSegmentSize; i++) {
-        pk_col->append(strings::Substitute("binary_pk_$0", pk_value++));
+        pk_col->append(prefix + std::to_string(pk_value++));
     }
     ASSERT_TRUE(pk_index->insert(1, 0, *pk_col).ok());
 
     // [2*kSegmentSize, 3*kSegmentSize)
     pk_col->resize(0);
     for (int i = 0; i < kSegmentSize; i++) {
-        pk_col->append(strings::Substitute("binary_pk_$0", pk_value++));
+        pk_col->append(prefix + std::to_string(pk_value++));
     }
     ASSERT_TRUE(pk_index->insert(2, 0, *pk_col).ok());
 
@@ -208,7 +208,7 @@ void test_binary_pk() {
     // [3*kSegmentSize, 4*kSegmentSize)
     pk_col->resize(0);
     for (int i = 0; i < kSegmentSize; i++) {
-        pk_col->append(strings::Substitute("binary_pk_$0", pk_value++));
+        pk_col->append(prefix + std::to_string(pk_value++));
     }
     pk_index->upsert(3, 0, *pk_col, &deletes);
     CHECK_EQ(0, deletes.size());
@@ -216,7 +216,7 @@ void test_binary_pk() {
     // upsert all the even numbers in range [0, 2 * kSegmentSize)
     pk_col->resize(0);
     for (int i = 0; i < kSegmentSize; i++) {
-        pk_col->append(strings::Substitute("binary_pk_$0", i * 2));
+        pk_col->append(prefix + std::to_string(i * 2));
     }
     pk_index->upsert(4, 0, *pk_col, &deletes);
     CHECK_EQ(2, deletes.size());
@@ -235,7 +235,7 @@ void test_binary_pk() {
     // remove all odd numbers in range [2 * kSegmentSize, 4 * kSegmentSize)
     pk_col->resize(0);
     for (int i = 0; i < kSegmentSize; i++) {
-        pk_col->append(strings::Substitute("binary_pk_$0", 2 * kSegmentSize + i * 2 + 1));
+        pk_col->append(prefix + std::to_string(2 * kSegmentSize + i * 2 + 1));
     }
     deletes.clear();
     pk_index->erase(*pk_col, &deletes);
@@ -267,6 +267,11 @@ PARALLEL_TEST(PrimaryIndexTest, test_varchar) {
     test_binary_pk<TYPE_VARCHAR>();
 }
 
+PARALLEL_TEST(PrimaryIndexTest, test_long_varchar) {
+    // keys longer than 40 bytes are stored in the compact index
+    test_binary_pk<TYPE_VARCHAR>(std::string(64, 'k'));
+}
+
 PARALLEL_TEST(PrimaryIndexTest, test_composite_key) {
     auto f1 = std::make_shared<Field>(0, "c0", TYPE_TINYINT, false);
     f1->set_is_key(true);
@@ -0,0 +1,151 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/rowset/alp_page.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "storage/chunk_helper.h"
+#include "storage/rowset/encoding_info.h"
+#include "storage/rowset/options.h"
+
+namespace starrocks {
+
+class AlpPageTest : public testing::Test {
+public:
+    template <LogicalType Type>
+    OwnedSlice encode(const std::vector<typename TypeTraits<Type>::CppType>& src) {
+        PageBuilderOptions builder_options;
+        builder_options.data_page_size = 256 * 1024;
+        AlpPageBuilder<Type> builder(builder_options);
+        size_t added = builder.add(reinterpret_cast<const uint8_t*>(src.data()), src.size());
+        EXPECT_EQ(src.size(), added);
+        OwnedSlice s = builder.finish()->build();
+        EXPECT_EQ(src.size(), builder.count());
+        return s;
+    }
+
+    template <LogicalType Type>
+    void test_encode_decode(const std::vector<typename TypeTraits<Type>::CppType>& src, uint8_t expected_mode) {
+        using CppType = typename TypeTraits<Type>::CppType;
+        OwnedSlice s = encode<Type>(src);
+        ASSERT_EQ(expected_mode, s.slice().data[sizeof(uint32_t)]);
+        if (expected_mode == ALP_PAGE_MODE_ALP) {
+            ASSERT_LT(s.slice().size, src.size() * sizeof(CppType));
+        }
+
+        PageDecoderOptions decoder_options;
+        AlpPageDecoder<Type> decoder(s.slice(), decoder_options);
+        ASSERT_TRUE(decoder.init().ok());
+        ASSERT_EQ(src.size(), decoder.count());
+        ASSERT_EQ(0, decoder.current_index());
+
+        auto column = ChunkHelper::column_from_field_type(Type, false);
+        size_t n = src.size();
+        ASSERT_TRUE(decoder.next_batch(&n, column.get()).ok());
+        ASSERT_EQ(src.size(), n);
+        const auto* values = reinterpret_cast<const CppType*>(column->raw_data());
+        for (size_t i = 0; i < src.size(); i++) {
+            ASSERT_EQ(0, memcmp(&src[i], &values[i], sizeof(CppType))) << "index " << i;
+        }
+
+        // Seek and read a range.
+        for (int i = 0; i < 100; i++) {
+            uint32_t pos = random() % src.size();
+            ASSERT_TRUE(decoder.seek_to_position_in_page(pos).ok());
+            ASSERT_EQ(pos, decoder.current_index());
+            column->reset_column();
+            n = 10;
+            ASSERT_TRUE(decoder.next_batch(&n, column.get()).ok());
+            ASSERT_EQ(std::min<size_t>(10, src.size() - pos), n);
+            values = reinterpret_cast<const CppType*>(column->raw_data());
+            for (size_t j = 0; j < n; j++) {
+                ASSERT_EQ(0, memcmp(&src[pos + j], &values[j], sizeof(CppType)));
+            }
+        }
+    }
+};
+
+TEST_F(AlpPageTest, TestDecimalDouble) {
+    std::vector<double> src;
+    for (int i = 0; i < 10000; i++) {
+        src.push_back((100000 + random() % 100000) / 100.0);
+    }
+    test_encode_decode<TYPE_DOUBLE>(src, ALP_PAGE_MODE_ALP);
+}
+
+TEST_F(AlpPageTest, TestIntegerDouble) {
+    std::vector<double> src;
+    for (int i = 0; i < 10000; i++) {
+        src.push_back(i * 3);
+    }
+    test_encode_decode<TYPE_DOUBLE>(src, ALP_PAGE_MODE_ALP);
+}
+
+TEST_F(AlpPageTest, TestExceptions) {
+    std::vector<double> src;
+    for (int i = 0; i < 10000; i++) {
+        src.push_back(i / 10.0);
+    }
+    src[1] = std::numeric_limits<double>::quiet_NaN();
+    src[100] = -0.0;
+    src[200] = std::numeric_limits<double>::infinity();
+    src[300] = -std::numeric_limits<double>::infinity();
+    src[400] = M_PI;
+    src[500] = std::numeric_limits<double>::max();
+    src[600] = std::numeric_limits<double>::denorm_min();
+    test_encode_decode<TYPE_DOUBLE>(src, ALP_PAGE_MODE_ALP);
+}
+
+TEST_F(AlpPageTest, TestRawFallback) {
+    std::vector<double> src;
+    for (int i = 0; i < 10000; i++) {
+        src.push_back(std::sqrt(static_cast<double>(i) + 0.5));
+    }
+    test_encode_decode<TYPE_DOUBLE>(src, ALP_PAGE_MODE_RAW);
+}
+
+TEST_F(AlpPageTest, TestFloat) {
+    std::vector<float> src;
+    for (int i = 0; i < 10000; i++) {
+        src.push_back(static_cast<float>(random() % 100000) / 100.0f);
+    }
+    src[7] = std::numeric_limits<float>::quiet_NaN();
+    src[77] = -0.0f;
+    test_encode_decode<TYPE_FLOAT>(src, ALP_PAGE_MODE_ALP);
+}
+
+TEST_F(AlpPageTest, TestEmptyPage) {
+    std::vector<double> src;
+    OwnedSlice s = encode<TYPE_DOUBLE>(src);
+    PageDecoderOptions decoder_options;
+    AlpPageDecoder<TYPE_DOUBLE> decoder(s.slice(), decoder_options);
+    ASSERT_TRUE(decoder.init().ok());
+    ASSERT_EQ(0, decoder.count());
+}
+
+TEST_F(AlpPageTest, TestEncodingInfo) {
+    const EncodingInfo* info = nullptr;
+    ASSERT_TRUE(EncodingInfo::get(TYPE_DOUBLE, ALP_ENCODING, &info).ok());
+    ASSERT_EQ(ALP_ENCODING, info->encoding());
+    ASSERT_TRUE(EncodingInfo::get(TYPE_DOUBLE, DEFAULT_ENCODING, &info).ok());
+    ASSERT_EQ(BIT_SHUFFLE, info->encoding());
+    ASSERT_FALSE(EncodingInfo::get(TYPE_INT, ALP_ENCODING, &info).ok());
+}
+
+} // namespace starrocks
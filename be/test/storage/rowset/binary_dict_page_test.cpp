@@ -47,8 +47,10 @@
 #include "storage/olap_common.h"
 #include "storage/rowset/binary_plain_page.h"
 #include "storage/rowset/page_decoder.h"
+#include "storage/rowset/shared_dictionary.h"
 #include "storage/rowset/storage_page_decoder.h"
 #include "storage/types.h"
+#include "testutil/assert.h"
 #include "util/debug_util.h"
 
 namespace starrocks {
@@ -305,4 +307,79 @@ TEST_F(BinaryDictPageTest, TestEncodingRatio) {
     test_with_large_data_size(slices);
 }
 
+// NOLINTNEXTLINE
+TEST_F(BinaryDictPageTest, TestSeedDictionary) {
+    PageBuilderOptions options;
+    options.data_page_size = 256 * 1024;
+    options.dict_page_size = 256 * 1024;
+    BinaryDictPageBuilder page_builder(options);
+    ASSERT_TRUE(page_builder.seed_dictionary({"a", "b", "c"}));
+
+    std::vector<Slice> slices{"c", "d", "a"};
+    ASSERT_EQ(slices.size(), page_builder.add(reinterpret_cast<const uint8_t*>(slices.data()), slices.size()));
+    ASSERT_EQ((std::vector<std::string>{"a", "b", "c", "d"}), page_builder.dictionary_words());
+    OwnedSlice data = page_builder.finish()->build();
+    ASSERT_TRUE(page_builder.all_dict_encoded());
+
+    OwnedSlice dict_slice = page_builder.get_dictionary_page()->build();
+    PageDecoderOptions decoder_options;
+    BinaryPlainPageDecoder<TYPE_VARCHAR> dict_decoder(dict_slice.slice(), decoder_options);
+    ASSERT_OK(dict_decoder.init());
+    ASSERT_EQ(4, dict_decoder.count());
+
+    Slice encoded_data = data.slice();
+    PageFooterPB footer;
+    footer.set_type(DATA_PAGE);
+    footer.mutable_data_page_footer()->set_nullmap_size(0);
+    std::unique_ptr<char[]> page = nullptr;
+    ASSERT_OK(StoragePageDecoder::decode_page(&footer, 0, starrocks::DICT_ENCODING, &page, &encoded_data));
+    BinaryDictPageDecoder<TYPE_VARCHAR> page_decoder(encoded_data, decoder_options);
+    page_decoder.set_dict_decoder(&dict_decoder);
+    ASSERT_OK(page_decoder.init());
+
+    auto codes = ChunkHelper::column_from_field_type(TYPE_INT, false);
+    size_t size = slices.size();
+    ASSERT_OK(page_decoder.next_dict_codes(&size, codes.get()));
+    ASSERT_EQ(3, size);
+    const auto* code_data = reinterpret_cast<const int32_t*>(codes->raw_data());
+    ASSERT_EQ(2, code_data[0]);
+    ASSERT_EQ(3, code_data[1]);
+    ASSERT_EQ(0, code_data[2]);
+}
+
+// NOLINTNEXTLINE
+TEST_F(BinaryDictPageTest, TestSeedDictionaryNotFit) {
+    PageBuilderOptions options;
+    options.data_page_size = 256 * 1024;
+    options.dict_page_size = 16;
+    BinaryDictPageBuilder page_builder(options);
+    ASSERT_FALSE(page_builder.seed_dictionary({"0123456789", "abcdefghij"}));
+    ASSERT_TRUE(page_builder.dictionary_words().empty());
+
+    BinaryDictPageBuilder page_builder2(options);
+    ASSERT_FALSE(page_builder2.seed_dictionary({"a", "a"}));
+    ASSERT_TRUE(page_builder2.dictionary_words().empty());
+}
+
+// NOLINTNEXTLINE
+TEST_F(BinaryDictPageTest, TestSharedDictionary) {
+    SharedDictionary dict;
+    std::vector<std::string> words;
+    uint64_t id = dict.snapshot(&words);
+    ASSERT_NE(0, id);
+    ASSERT_TRUE(words.empty());
+
+    ASSERT_TRUE(dict.update(id, 0, {"a", "b"}));
+    // the dictionary has been extended by others
+    ASSERT_FALSE(dict.update(id, 0, {"c"}));
+    ASSERT_EQ(id, dict.snapshot(&words));
+    ASSERT_EQ((std::vector<std::string>{"a", "b"}), words);
+    ASSERT_TRUE(dict.update(id, 2, {"a", "b", "c"}));
+
+    dict.reset();
+    ASSERT_NE(id, dict.snapshot(&words));
+    ASSERT_TRUE(words.empty());
+    ASSERT_FALSE(dict.update(id, 0, {"a"}));
+}
+
 } // namespace starrocks
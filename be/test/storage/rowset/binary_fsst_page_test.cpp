@@ -0,0 +1,135 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/rowset/binary_fsst_page.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "column/binary_column.h"
+#include "column/nullable_column.h"
+#include "storage/range.h"
+#include "storage/rowset/encoding_info.h"
+#include "testutil/assert.h"
+
+namespace starrocks {
+
+class BinaryFsstPageTest : public testing::Test {
+protected:
+    void SetUp() override {
+        for (int i = 0; i < 5000; i++) {
+            _values.push_back("Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 Chrome/" + std::to_string(i % 120) +
+                              ".0." + std::to_string(i * 31 % 10000));
+        }
+        _values.emplace_back("");
+        _values.emplace_back("\xfe\xff binary");
+        std::vector<Slice> slices(_values.begin(), _values.end());
+
+        PageBuilderOptions options;
+        options.data_page_size = 1024 * 1024;
+        BinaryFsstPageBuilder builder(options);
+        ASSERT_EQ(slices.size(), builder.add(reinterpret_cast<const uint8_t*>(slices.data()), slices.size()));
+        _page = builder.finish()->build();
+        // The raw values are about 70 bytes each.
+        ASSERT_LT(_page.slice().size, builder.count() * 40);
+
+        Slice first;
+        ASSERT_OK(builder.get_first_value(&first));
+        ASSERT_EQ(_values.front(), first.to_string());
+        Slice last;
+        ASSERT_OK(builder.get_last_value(&last));
+        ASSERT_EQ(_values.back(), last.to_string());
+    }
+
+    std::vector<std::string> _values;
+    OwnedSlice _page;
+};
+
+TEST_F(BinaryFsstPageTest, TestNextBatch) {
+    BinaryFsstPageDecoder<TYPE_VARCHAR> decoder(_page.slice(), PageDecoderOptions());
+    ASSERT_OK(decoder.init());
+    ASSERT_EQ(_values.size(), decoder.count());
+
+    auto column = BinaryColumn::create();
+    size_t n = _values.size() + 10;
+    ASSERT_OK(decoder.next_batch(&n, column.get()));
+    ASSERT_EQ(_values.size(), n);
+    for (size_t i = 0; i < _values.size(); i++) {
+        ASSERT_EQ(_values[i], column->get_slice(i).to_string());
+    }
+
+    // Seek and read a sparse range into a nullable column.
+    auto nullable = NullableColumn::create(BinaryColumn::create(), NullColumn::create());
+    ASSERT_OK(decoder.seek_to_position_in_page(100));
+    SparseRange range;
+    range.add(Range(100, 110));
+    range.add(Range(4000, 4005));
+    ASSERT_OK(decoder.next_batch(range, nullable.get()));
+    ASSERT_EQ(15, nullable->size());
+    ASSERT_EQ(4005, decoder.current_index());
+    for (size_t i = 0; i < 10; i++) {
+        ASSERT_EQ(_values[100 + i], nullable->get(i).get_slice().to_string());
+    }
+    for (size_t i = 0; i < 5; i++) {
+        ASSERT_EQ(_values[4000 + i], nullable->get(10 + i).get_slice().to_string());
+    }
+}
+
+TEST_F(BinaryFsstPageTest, TestMatch) {
+    BinaryFsstPageDecoder<TYPE_VARCHAR> decoder(_page.slice(), PageDecoderOptions());
+    ASSERT_OK(decoder.init());
+    uint32_t num_rows = decoder.count();
+    std::vector<uint8_t> selection(num_rows);
+
+    decoder.match_equal(Slice(_values[42]), 0, num_rows, selection.data());
+    for (uint32_t i = 0; i < num_rows; i++) {
+        ASSERT_EQ(_values[i] == _values[42], selection[i]) << i;
+    }
+    decoder.match_equal(Slice("not exist"), 0, num_rows, selection.data());
+    for (uint32_t i = 0; i < num_rows; i++) {
+        ASSERT_EQ(0, selection[i]);
+    }
+
+    std::string prefix = "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 Chrome/11";
+    decoder.match_prefix(Slice(prefix), 0, num_rows, selection.data());
+    for (uint32_t i = 0; i < num_rows; i++) {
+        ASSERT_EQ(Slice(_values[i]).starts_with(Slice(prefix)), selection[i]) << i;
+    }
+
+    // Only part of the page.
+    decoder.match_prefix(Slice("Mozilla"), 4998, num_rows, selection.data());
+    ASSERT_EQ(1, selection[0]);
+    ASSERT_EQ(1, selection[1]);
+    ASSERT_EQ(0, selection[2]);
+    ASSERT_EQ(0, selection[3]);
+}
+
+TEST_F(BinaryFsstPageTest, TestEncodingInfo) {
+    const EncodingInfo* info = nullptr;
+    ASSERT_OK(EncodingInfo::get(TYPE_VARCHAR, FSST_ENCODING, &info));
+    PageBuilder* builder = nullptr;
+    ASSERT_OK(info->create_page_builder(PageBuilderOptions(), &builder));
+    ASSERT_NE(nullptr, builder);
+    delete builder;
+    PageDecoder* decoder = nullptr;
+    ASSERT_OK(info->create_page_decoder(_page.slice(), PageDecoderOptions(), &decoder));
+    ASSERT_OK(decoder->init());
+    ASSERT_EQ(FSST_ENCODING, decoder->encoding_type());
+    ASSERT_EQ(_values.size(), decoder->count());
+    delete decoder;
+}
+
+} // namespace starrocks
@@ -37,9 +37,11 @@
 #include <string>
 #include <thread>
 
+#include "column/fixed_length_column.h"
 #include "fs/fs_memory.h"
 #include "runtime/mem_pool.h"
 #include "runtime/mem_tracker.h"
+#include "storage/chunk_helper.h"
 #include "storage/key_coder.h"
 #include "storage/olap_common.h"
 #include "storage/rowset/bitmap_index_reader.h"
@@ -238,6 +240,50 @@ TEST_F(BitmapIndexTest, test_null) {
     delete[] val;
 }
 
+TEST_F(BitmapIndexTest, test_read_dictionary) {
+    // Enough distinct values to make the dictionary span multiple pages.
+    size_t num_rows = 1024 * 256;
+    auto* val = new int64_t[num_rows];
+    for (int i = 0; i < num_rows; ++i) {
+        val[i] = (num_rows - i) / 2;
+    }
+
+    std::string file_name = kTestDir + "/dict";
+    ColumnIndexMetaPB meta;
+    write_index_file<TYPE_BIGINT>(file_name, val, num_rows, 30, &meta);
+    {
+        BitmapIndexReader* reader = nullptr;
+        BitmapIndexIterator* iter = nullptr;
+        get_bitmap_reader_iter(file_name, meta, &reader, &iter);
+
+        auto dict = ChunkHelper::column_from_field_type(TYPE_BIGINT, false);
+        ASSERT_OK(iter->read_dictionary(dict.get()));
+        ASSERT_EQ(num_rows / 2 + 1, dict->size());
+        ASSERT_EQ(iter->bitmap_nums() - 1, dict->size());
+        auto* data = down_cast<Int64Column*>(dict.get())->get_data().data();
+        for (size_t i = 0; i < dict->size(); i++) {
+            ASSERT_EQ((int64_t)i, data[i]);
+        }
+
+        // The i-th value of the dictionary corresponds to the i-th bitmap.
+        Roaring bitmap;
+        ASSERT_OK(iter->read_bitmap(1024, &bitmap));
+        ASSERT_TRUE(Roaring::bitmapOf(2, (uint32_t)(num_rows - 2049), (uint32_t)(num_rows - 2048)) == bitmap);
+
+        // Read again after seeking.
+        int64_t value = 2019;
+        bool exact_match;
+        ASSERT_OK(iter->seek_dictionary(&value, &exact_match));
+        auto dict2 = ChunkHelper::column_from_field_type(TYPE_BIGINT, false);
+        ASSERT_OK(iter->read_dictionary(dict2.get()));
+        ASSERT_EQ(dict->size(), dict2->size());
+
+        delete reader;
+        delete iter;
+    }
+    delete[] val;
+}
+
 TEST_F(BitmapIndexTest, test_concurrent_load) {
     size_t num_uint8_rows = 1024;
     auto* val = new int64_t[num_uint8_rows];
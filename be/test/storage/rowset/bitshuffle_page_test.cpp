@@ -40,6 +40,7 @@
 
 #include "column/datum_convert.h"
 #include "storage/chunk_helper.h"
+#include "storage/column_predicate.h"
 #include "storage/rowset/options.h"
 #include "storage/rowset/page_decoder.h"
 #include "storage/rowset/storage_page_decoder.h"
@@ -496,4 +497,41 @@ TEST_F(BitShufflePageTest, TestDecodeVectorized) {
                                        BitShufflePageDecoder<TYPE_BIGINT>>();
 }
 
+TEST_F(BitShufflePageTest, TestEvaluatePredicate) {
+    std::vector<int64_t> values;
+    for (int i = 0; i < 1000; i++) {
+        values.push_back(random() % 100 - 50);
+    }
+    PageBuilderOptions options;
+    options.data_page_size = 256 * 1024;
+    BitshufflePageBuilder<TYPE_BIGINT> page_builder(options);
+    page_builder.add(reinterpret_cast<const uint8_t*>(values.data()), values.size());
+    OwnedSlice s = page_builder.finish()->build();
+
+    Slice encoded_data = s.slice();
+    std::unique_ptr<char[]> page = nullptr;
+    starrocks::PageFooterPB footer;
+    footer.set_type(starrocks::DATA_PAGE);
+    footer.mutable_data_page_footer()->set_nullmap_size(0);
+    ASSERT_TRUE(StoragePageDecoder::decode_page(&footer, 0, starrocks::BIT_SHUFFLE, &page, &encoded_data).ok());
+    BitShufflePageDecoder<TYPE_BIGINT> page_decoder(encoded_data, PageDecoderOptions());
+    ASSERT_TRUE(page_decoder.init().ok());
+
+    std::string operand = "10";
+    std::unique_ptr<ColumnPredicate> lt(
+            new_column_cmp_predicate(PredicateType::kLT, get_type_info(TYPE_BIGINT), 0, Slice(operand)));
+    std::unique_ptr<ColumnPredicate> ne(
+            new_column_cmp_predicate(PredicateType::kNE, get_type_info(TYPE_BIGINT), 0, Slice(operand)));
+    std::vector<uint8_t> selection(900);
+    ASSERT_TRUE(page_decoder.evaluate(*lt, 100, 1000, selection.data()).ok());
+    for (int i = 100; i < 1000; i++) {
+        ASSERT_EQ(values[i] < 10, selection[i - 100]) << i;
+    }
+    ASSERT_TRUE(page_decoder.evaluate(*ne, 100, 1000, selection.data()).ok());
+    for (int i = 100; i < 1000; i++) {
+        ASSERT_EQ(values[i] != 10, selection[i - 100]) << i;
+    }
+    ASSERT_EQ(0, page_decoder.current_index());
+}
+
 } // namespace starrocks
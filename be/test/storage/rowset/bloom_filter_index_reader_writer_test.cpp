@@ -284,4 +284,62 @@ TEST_F(BloomFilterIndexReaderWriterTest, test_decimal) {
     delete[] val;
 }
 
+TEST_F(BloomFilterIndexReaderWriterTest, test_ngram_varchar) {
+    std::vector<std::string> page0{"GET /index.html 200", "POST /login 500 internal error", "GET /favicon.ico 404"};
+    std::vector<std::string> page1{"GET /about.html 200", "GET /images/logo.png 304"};
+    std::string fname = kTestDir + "/ngram_bloom_filter_varchar";
+    ColumnIndexMetaPB meta;
+    {
+        ASSIGN_OR_ABORT(auto wfile, _fs->new_writable_file(fname));
+        std::unique_ptr<BloomFilterIndexWriter> writer;
+        BloomFilterOptions bf_options;
+        bf_options.gram_size = 3;
+        ASSERT_OK(BloomFilterIndexWriter::create_ngram(bf_options, get_type_info(TYPE_VARCHAR), &writer));
+        for (const auto* page : {&page0, &page1}) {
+            std::vector<Slice> slices(page->begin(), page->end());
+            writer->add_values(slices.data(), slices.size());
+            ASSERT_OK(writer->flush());
+        }
+        ASSERT_OK(writer->finish(wfile.get(), &meta));
+        ASSERT_OK(wfile->close());
+    }
+    ASSERT_EQ(NGRAM_BLOOM_FILTER_INDEX, meta.type());
+    ASSERT_EQ(3, meta.ngram_bloom_filter_index().gram_size());
+
+    BloomFilterIndexReader reader;
+    ASSIGN_OR_ABORT(auto r, reader.load(_fs.get(), fname, meta.ngram_bloom_filter_index(), true, false));
+    ASSERT_TRUE(r);
+    std::unique_ptr<BloomFilterIndexIterator> iter;
+    ASSERT_OK(reader.new_iterator(&iter));
+
+    auto contains_all_grams = [](const BloomFilter* bf, const std::string& s) {
+        for (size_t i = 0; i + 3 <= s.size(); i++) {
+            if (!bf->test_bytes(s.data() + i, 3)) {
+                return false;
+            }
+        }
+        return true;
+    };
+    std::unique_ptr<BloomFilter> bf;
+    ASSERT_OK(iter->read_bloom_filter(0, &bf));
+    for (const auto& s : page0) {
+        ASSERT_TRUE(contains_all_grams(bf.get(), s));
+    }
+    ASSERT_TRUE(contains_all_grams(bf.get(), "internal"));
+    ASSERT_OK(iter->read_bloom_filter(1, &bf));
+    for (const auto& s : page1) {
+        ASSERT_TRUE(contains_all_grams(bf.get(), s));
+    }
+    ASSERT_FALSE(contains_all_grams(bf.get(), "internal error"));
+}
+
+TEST_F(BloomFilterIndexReaderWriterTest, test_ngram_not_supported_type) {
+    std::unique_ptr<BloomFilterIndexWriter> writer;
+    BloomFilterOptions bf_options;
+    bf_options.gram_size = 3;
+    ASSERT_FALSE(BloomFilterIndexWriter::create_ngram(bf_options, get_type_info(TYPE_INT), &writer).ok());
+    bf_options.gram_size = 0;
+    ASSERT_FALSE(BloomFilterIndexWriter::create_ngram(bf_options, get_type_info(TYPE_VARCHAR), &writer).ok());
+}
+
 } // namespace starrocks
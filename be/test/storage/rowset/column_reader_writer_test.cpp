@@ -61,7 +61,8 @@
 #include "storage/type_traits.h"
 #include "storage/types.h"
 #include "testutil/assert.h"
-#include "types/date_value.h"
+include "types/date_value.h"
+#include "util/defer_op.h"
 
 using std::string;
 
@@ -421,6 +422,24 @@ protected:
                 ASSERT_EQ("[4,5,6]", dst_column->debug_item(1));
             }
 
+            // read the lengths only
+            {
+                ASSIGN_OR_ABORT(auto lengths_iter, reader->new_iterator());
+                ColumnIteratorOptions lengths_opts = iter_opts;
+                lengths_opts.lengths_only = true;
+                ASSERT_OK(lengths_iter->init(lengths_opts));
+                ASSERT_OK(lengths_iter->seek_to_ordinal(1));
+
+                auto dst_offsets = UInt32Column::create();
+                auto dst_elements = NullableColumn::create(Int32Column::create(), NullColumn::create());
+                auto dst_column = ArrayColumn::create(dst_elements, dst_offsets);
+                size_t rows_read = 1;
+                ASSERT_OK(lengths_iter->next_batch(&rows_read, dst_column.get()));
+                ASSERT_EQ(1, rows_read);
+                ASSERT_EQ(3, dst_column->get_element_size(0));
+                ASSERT_EQ("[NULL,NULL,NULL]", dst_column->debug_item(0));
+            }
+
             ASSERT_EQ(2, meta.num_rows());
             ASSERT_EQ(42, reader->total_mem_footprint());
         }
@@ -722,4 +741,68 @@ TEST_F(ColumnReaderWriterTest, test_scalar_column_total_mem_footprint) {
     }
 }
 
+TEST_F(ColumnReaderWriterTest, test_zstd_dict_compression) {
+    auto old_enable = config::enable_zstd_dict_compression;
+    config::enable_zstd_dict_compression = true;
+    DeferOp defer([&]() { config::enable_zstd_dict_compression = old_enable; });
+
+    auto src = ChunkHelper::column_from_field_type(TYPE_VARCHAR, false);
+    std::vector<std::string> values;
+    for (int i = 0; i < 20000; i++) {
+        values.emplace_back(strings::Substitute("{\"user\": \"user_$0\", \"domain\": \"example.com\"}", i % 997));
+    }
+    for (const auto& v : values) {
+        src->append_datum(Datum(Slice(v)));
+    }
+
+    ColumnMetaPB meta;
+    auto fs = std::make_shared<MemoryFileSystem>();
+    ASSERT_TRUE(fs->create_dir(TEST_DIR).ok());
+    const std::string fname = strings::Substitute("$0/test_zstd_dict_compression.data", TEST_DIR);
+    auto segment = create_dummy_segment(fs, fname);
+    {
+        ASSIGN_OR_ABORT(auto wfile, fs->new_writable_file(fname));
+        ColumnWriterOptions writer_opts;
+        writer_opts.page_format = 2;
+        // Small pages compress poorly without a dictionary.
+        writer_opts.data_page_size = 1024;
+        writer_opts.meta = &meta;
+        writer_opts.meta->set_column_id(0);
+        writer_opts.meta->set_unique_id(0);
+        writer_opts.meta->set_type(TYPE_VARCHAR);
+        writer_opts.meta->set_length(128);
+        writer_opts.meta->set_encoding(PLAIN_ENCODING);
+        writer_opts.meta->set_compression(starrocks::ZSTD);
+        writer_opts.meta->set_is_nullable(false);
+
+        TabletColumn column = create_varchar_key(1, false, 128);
+        ASSIGN_OR_ABORT(auto writer, ColumnWriter::create(writer_opts, &column, wfile.get()));
+        ASSERT_OK(writer->init());
+        ASSERT_OK(writer->append(*src));
+        ASSERT_OK(writer->finish());
+        ASSERT_OK(writer->write_data());
+        ASSERT_OK(writer->write_ordinal_index());
+        ASSERT_OK(wfile->close());
+    }
+    ASSERT_TRUE(meta.has_compression_dict());
+    ASSERT_GT(meta.compression_dict().size(), 0);
+
+    ASSIGN_OR_ABORT(auto reader, ColumnReader::create(&meta, segment.get()));
+    ASSIGN_OR_ABORT(auto iter, reader->new_iterator());
+    ASSIGN_OR_ABORT(auto read_file, fs->new_random_access_file(fname));
+    ColumnIteratorOptions iter_opts;
+    OlapReaderStatistics stats;
+    iter_opts.stats = &stats;
+    iter_opts.read_file = read_file.get();
+    ASSERT_OK(iter->init(iter_opts));
+    ASSERT_OK(iter->seek_to_ordinal(12345));
+    auto dst = ChunkHelper::column_from_field_type(TYPE_VARCHAR, false);
+    size_t rows_read = 1000;
+    ASSERT_OK(iter->next_batch(&rows_read, dst.get()));
+    ASSERT_EQ(1000, rows_read);
+    for (size_t i = 0; i < rows_read; i++) {
+        ASSERT_EQ(values[12345 + i], dst->get(i).get_slice().to_string());
+    }
+}
+
 } // namespace starrocks
@@ -44,9 +44,11 @@
 #include "runtime/large_int_value.h"
 #include "runtime/mem_pool.h"
 #include "storage/chunk_helper.h"
+#include "storage/column_predicate.h"
 #include "storage/rowset/options.h"
 #include "storage/rowset/page_builder.h"
 #include "storage/rowset/page_decoder.h"
+#include "storage/types.h"
 #include "util/logging.h"
 
 using starrocks::PageBuilderOptions;
@@ -346,4 +348,61 @@ TEST_F(FrameOfReferencePageTest, TestFindBitsOfInt) {
     ASSERT_EQ(65, bits(bits_65));
 }
 
+TEST_F(FrameOfReferencePageTest, TestEvaluatePredicate) {
+    // Frames of the not ascending values, the ascending values and a partial frame.
+    std::vector<int32_t> values;
+    for (int i = 0; i < 128; i++) {
+        values.push_back(1000 + random() % 100);
+    }
+    for (int i = 0; i < 128; i++) {
+        values.push_back(i * 3);
+    }
+    for (int i = 0; i < 50; i++) {
+        values.push_back(-500 + random() % 1000);
+    }
+
+    PageBuilderOptions builder_options;
+    builder_options.data_page_size = 256 * 1024;
+    FrameOfReferencePageBuilder<TYPE_INT> builder(builder_options);
+    builder.add(reinterpret_cast<const uint8_t*>(values.data()), values.size());
+    OwnedSlice s = builder.finish()->build();
+    FrameOfReferencePageDecoder<TYPE_INT> decoder(s.slice(), PageDecoderOptions());
+    ASSERT_TRUE(decoder.init().ok());
+
+    TypeInfoPtr type_info = get_type_info(TYPE_INT);
+    std::vector<PredicateType> types = {PredicateType::kEQ, PredicateType::kNE, PredicateType::kLT,
+                                        PredicateType::kLE, PredicateType::kGT, PredicateType::kGE};
+    std::vector<int32_t> operands = {std::numeric_limits<int32_t>::min(), -1, 0, 99, 1000, 1050, 1099, 1200,
+                                     std::numeric_limits<int32_t>::max()};
+    std::vector<std::pair<uint32_t, uint32_t>> ranges = {{0, 306}, {10, 20}, {100, 200}, {250, 306}};
+    for (PredicateType type : types) {
+        for (int32_t operand : operands) {
+            std::string str = std::to_string(operand);
+            std::unique_ptr<ColumnPredicate> pred(new_column_cmp_predicate(type, type_info, 0, Slice(str)));
+            for (auto [from, to] : ranges) {
+                std::vector<uint8_t> selection(to - from);
+                ASSERT_TRUE(decoder.evaluate(*pred, from, to, selection.data()).ok());
+                for (uint32_t i = from; i < to; i++) {
+                    int32_t v = values[i];
+                    bool expected = (type == PredicateType::kEQ && v == operand) ||
+                                    (type == PredicateType::kNE && v != operand) ||
+                                    (type == PredicateType::kLT && v < operand) ||
+                                    (type == PredicateType::kLE && v <= operand) ||
+                                    (type == PredicateType::kGT && v > operand) ||
+                                    (type == PredicateType::kGE && v >= operand);
+                    ASSERT_EQ(expected, selection[i - from]) << type << " " << operand << " at " << i;
+                }
+            }
+        }
+    }
+    // The position is not changed.
+    ASSERT_EQ(0, decoder.current_index());
+
+    std::string str = "1";
+    std::unique_ptr<ColumnPredicate> pred(
+            new_column_cmp_predicate(PredicateType::kEQ, get_type_info(TYPE_BIGINT), 0, Slice(str)));
+    std::vector<uint8_t> selection(10);
+    ASSERT_TRUE(decoder.evaluate(*pred, 0, 10, selection.data()).is_not_supported());
+}
+
 } // namespace starrocks
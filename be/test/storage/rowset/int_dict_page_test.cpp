@@ -0,0 +1,164 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/rowset/int_dict_page.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "column/fixed_length_column.h"
+#include "storage/column_predicate.h"
+#include "storage/rowset/encoding_info.h"
+#include "storage/types.h"
+#include "testutil/assert.h"
+
+namespace starrocks {
+
+class IntDictPageTest : public testing::Test {
+public:
+    template <LogicalType Type>
+    OwnedSlice encode(const std::vector<typename TypeTraits<Type>::CppType>& src) {
+        PageBuilderOptions options;
+        options.data_page_size = 256 * 1024;
+        IntDictPageBuilder<Type> builder(options);
+        // Add in several batches.
+        size_t added = 0;
+        while (added < src.size()) {
+            size_t n = std::min<size_t>(1000, src.size() - added);
+            EXPECT_EQ(n, builder.add(reinterpret_cast<const uint8_t*>(src.data() + added), n));
+            added += n;
+        }
+        OwnedSlice s = builder.finish()->build();
+        EXPECT_EQ(src.size(), builder.count());
+        return s;
+    }
+
+    template <LogicalType Type>
+    void test_encode_decode(const std::vector<typename TypeTraits<Type>::CppType>& src, bool dict_encoded) {
+        using CppType = typename TypeTraits<Type>::CppType;
+        OwnedSlice s = encode<Type>(src);
+        IntDictPageDecoder<Type> decoder(s.slice(), PageDecoderOptions());
+        ASSERT_OK(decoder.init());
+        ASSERT_EQ(dict_encoded, decoder.is_dict_encoded());
+        ASSERT_EQ(src.size(), decoder.count());
+
+        auto column = ChunkHelper::column_from_field_type(Type, false);
+        size_t n = src.size();
+        ASSERT_OK(decoder.next_batch(&n, column.get()));
+        ASSERT_EQ(src.size(), n);
+        const auto* values = reinterpret_cast<const CppType*>(column->raw_data());
+        for (size_t i = 0; i < src.size(); i++) {
+            ASSERT_EQ(src[i], values[i]);
+        }
+
+        for (int i = 0; i < 100; i++) {
+            uint32_t pos = random() % src.size();
+            ASSERT_OK(decoder.seek_to_position_in_page(pos));
+            column->reset_column();
+            n = 1;
+            ASSERT_OK(decoder.next_batch(&n, column.get()));
+            ASSERT_EQ(1, n);
+            ASSERT_EQ(src[pos], *reinterpret_cast<const CppType*>(column->raw_data()));
+        }
+    }
+};
+
+TEST_F(IntDictPageTest, TestBigint) {
+    std::vector<int64_t> src;
+    for (int i = 0; i < 10000; i++) {
+        src.push_back((random() % 200) * 1000000007LL);
+    }
+    test_encode_decode<TYPE_BIGINT>(src, true);
+    // One byte code per value plus the dictionary.
+    ASSERT_LT(encode<TYPE_BIGINT>(src).slice().size, src.size() + 256 * sizeof(int64_t) + 16);
+}
+
+TEST_F(IntDictPageTest, TestDate) {
+    std::vector<int32_t> src;
+    for (int i = 0; i < 5000; i++) {
+        src.push_back(2459000 + i % 30);
+    }
+    test_encode_decode<TYPE_DATE>(src, true);
+}
+
+TEST_F(IntDictPageTest, TestPlainFallback) {
+    std::vector<int32_t> src;
+    for (int i = 0; i < 5000; i++) {
+        src.push_back(i);
+    }
+    test_encode_decode<TYPE_INT>(src, false);
+    // Exactly 256 distinct values can still be dictionary encoded.
+    src.clear();
+    for (int i = 0; i < 5000; i++) {
+        src.push_back(i % 256);
+    }
+    test_encode_decode<TYPE_INT>(src, true);
+}
+
+TEST_F(IntDictPageTest, TestEvaluate) {
+    for (int distinct : {100, 1000}) {
+        std::vector<int32_t> src;
+        for (int i = 0; i < 10000; i++) {
+            src.push_back(i % distinct);
+        }
+        OwnedSlice s = encode<TYPE_INT>(src);
+        IntDictPageDecoder<TYPE_INT> decoder(s.slice(), PageDecoderOptions());
+        ASSERT_OK(decoder.init());
+        ASSERT_EQ(distinct <= 256, decoder.is_dict_encoded());
+
+        std::unique_ptr<ColumnPredicate> pred(new_column_ge_predicate(get_type_info(TYPE_INT), 0, "50"));
+        std::vector<uint8_t> selection(src.size());
+        ASSERT_OK(decoder.evaluate(pred.get(), 0, src.size(), selection.data()));
+        for (size_t i = 0; i < src.size(); i++) {
+            ASSERT_EQ(src[i] >= 50, selection[i]) << i;
+        }
+        ASSERT_OK(decoder.evaluate(pred.get(), 120, 130, selection.data()));
+        for (size_t i = 0; i < 10; i++) {
+            ASSERT_EQ(src[120 + i] >= 50, selection[i]) << i;
+        }
+    }
+}
+
+TEST_F(IntDictPageTest, TestDictCodes) {
+    std::vector<int64_t> src;
+    for (int i = 0; i < 1000; i++) {
+        src.push_back(i % 7 * 100);
+    }
+    OwnedSlice s = encode<TYPE_BIGINT>(src);
+    IntDictPageDecoder<TYPE_BIGINT> decoder(s.slice(), PageDecoderOptions());
+    ASSERT_OK(decoder.init());
+    ASSERT_EQ(7, decoder.dict_size());
+
+    auto codes = Int32Column::create();
+    SparseRange range;
+    range.add(Range(10, 20));
+    range.add(Range(500, 510));
+    ASSERT_OK(decoder.next_dict_codes(range, codes.get()));
+    ASSERT_EQ(20, codes->size());
+    for (size_t i = 0; i < 10; i++) {
+        ASSERT_EQ(src[10 + i], decoder.dict_values()[codes->get_data()[i]]);
+        ASSERT_EQ(src[500 + i], decoder.dict_values()[codes->get_data()[10 + i]]);
+    }
+}
+
+TEST_F(IntDictPageTest, TestEncodingInfo) {
+    const EncodingInfo* info = nullptr;
+    ASSERT_OK(EncodingInfo::get(TYPE_BIGINT, INT_DICT_ENCODING, &info));
+    ASSERT_EQ(INT_DICT_ENCODING, info->encoding());
+    ASSERT_FALSE(EncodingInfo::get(TYPE_DOUBLE, INT_DICT_ENCODING, &info).ok());
+}
+
+} // namespace starrocks
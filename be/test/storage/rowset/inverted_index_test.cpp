@@ -0,0 +1,114 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "fs/fs_memory.h"
+#include "runtime/mem_tracker.h"
+#include "storage/page_cache.h"
+#include "storage/rowset/inverted_index_reader.h"
+#include "storage/rowset/inverted_index_writer.h"
+#include "storage/types.h"
+#include "testutil/assert.h"
+
+namespace starrocks {
+
+class InvertedIndexTest : public testing::Test {
+public:
+    const std::string kTestDir = "/inverted_index_test";
+
+protected:
+    void SetUp() override {
+        StoragePageCache::create_global_cache(&_tracker, 1000000000);
+        _fs = std::make_shared<MemoryFileSystem>();
+        ASSERT_OK(_fs->create_dir(kTestDir));
+    }
+    void TearDown() override { StoragePageCache::release_global_cache(); }
+
+    void write_index_file(const std::string& filename, const std::vector<std::string>& values, size_t null_count,
+                          ColumnIndexMetaPB* meta) {
+        ASSIGN_OR_ABORT(auto wfile, _fs->new_writable_file(filename));
+        std::unique_ptr<InvertedIndexWriter> writer;
+        ASSERT_OK(InvertedIndexWriter::create(get_type_info(TYPE_VARCHAR), SIMPLE_PARSER, &writer));
+        std::vector<Slice> slices(values.begin(), values.end());
+        writer->add_values(slices.data(), slices.size());
+        writer->add_nulls(null_count);
+        ASSERT_OK(writer->finish(wfile.get(), meta));
+        ASSERT_EQ(INVERTED_INDEX, meta->type());
+        ASSERT_OK(wfile->close());
+    }
+
+    std::shared_ptr<MemoryFileSystem> _fs = nullptr;
+    MemTracker _tracker;
+};
+
+TEST_F(InvertedIndexTest, test_tokenize) {
+    InvertedIndexTokenizer tokenizer(SIMPLE_PARSER);
+    std::vector<std::string> expected{"get", "index", "html", "http", "1", "1", "200"};
+    ASSERT_EQ(expected, tokenizer.tokenize("GET /index.html HTTP/1.1 200"));
+    ASSERT_TRUE(tokenizer.tokenize("  ,./ ").empty());
+    // multi-byte characters are kept in the terms
+    std::vector<std::string> expected_utf8{"数据库", "db"};
+    ASSERT_EQ(expected_utf8, tokenizer.tokenize("数据库-DB"));
+}
+
+TEST_F(InvertedIndexTest, test_match_all) {
+    std::vector<std::string> values;
+    for (int i = 0; i < 1000; i++) {
+        if (i % 10 == 0) {
+            values.emplace_back("ERROR connection refused by host-" + std::to_string(i));
+        } else {
+            values.emplace_back("INFO request served by host-" + std::to_string(i));
+        }
+    }
+    std::string file_name = kTestDir + "/match_all";
+    ColumnIndexMetaPB meta;
+    write_index_file(file_name, values, 10, &meta);
+
+    InvertedIndexReader reader(meta.inverted_index().parser());
+    ASSIGN_OR_ABORT(auto r, reader.load(_fs.get(), file_name, meta.inverted_index(), true, false));
+    ASSERT_TRUE(r);
+    std::unique_ptr<InvertedIndexIterator> iter;
+    ASSERT_OK(reader.new_iterator(&iter));
+
+    Roaring rows;
+    ASSERT_OK(iter->match_all({"error"}, &rows));
+    ASSERT_EQ(100, rows.cardinality());
+    ASSERT_TRUE(rows.contains(0));
+    ASSERT_TRUE(rows.contains(990));
+
+    ASSERT_OK(iter->match_all({"error", "host", "20"}, &rows));
+    ASSERT_EQ(1, rows.cardinality());
+    ASSERT_TRUE(rows.contains(20));
+
+    ASSERT_OK(iter->match_all({"request", "refused"}, &rows));
+    ASSERT_TRUE(rows.isEmpty());
+
+    ASSERT_OK(iter->match_all({"not_exist"}, &rows));
+    ASSERT_TRUE(rows.isEmpty());
+
+    ASSERT_OK(iter->match_all({"zzz"}, &rows));
+    ASSERT_TRUE(rows.isEmpty());
+}
+
+TEST_F(InvertedIndexTest, test_not_supported_type) {
+    std::unique_ptr<InvertedIndexWriter> writer;
+    ASSERT_FALSE(InvertedIndexWriter::create(get_type_info(TYPE_INT), SIMPLE_PARSER, &writer).ok());
+}
+
+} // namespace starrocks
@@ -0,0 +1,207 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include <map>
+
+#include "column/binary_column.h"
+#include "column/json_column.h"
+#include "column/nullable_column.h"
+#include "common/config.h"
+#include "fs/fs_memory.h"
+#include "storage/rowset/column_iterator.h"
+#include "storage/rowset/column_reader.h"
+#include "storage/rowset/column_writer.h"
+#include "storage/rowset/segment.h"
+#include "storage/tablet_schema.h"
+#include "testutil/assert.h"
+#include "types/constexpr.h"
+#include "util/defer_op.h"
+#include "util/json.h"
+
+namespace starrocks {
+
+// NOLINTNEXTLINE
+static const std::string TEST_DIR = "/json_column_rw_test";
+
+class JsonColumnRWTest : public testing::Test {
+protected:
+    void SetUp() override {
+        _fs = std::make_shared<MemoryFileSystem>();
+        ASSERT_OK(_fs->create_dir(TEST_DIR));
+    }
+
+    std::shared_ptr<Segment> create_dummy_segment(const std::string& fname) {
+        return std::make_shared<Segment>(Segment::private_type(0), _fs, fname, 1, _dummy_segment_schema.get());
+    }
+
+    // 1/100 of the rows are null and 1/100 are arrays, the others are objects with the
+    // fields "a", "b" and "c", and "a" is a string instead of an integer in 1/10 of them.
+    static ColumnPtr build_json_column(size_t num_rows) {
+        auto json_column = JsonColumn::create();
+        auto null_column = NullColumn::create();
+        for (size_t i = 0; i < num_rows; i++) {
+            std::string json_str;
+            if (i % 100 == 99) {
+                json_column->append_default();
+                null_column->append(1);
+                continue;
+            } else if (i % 100 == 98) {
+                json_str = "[1, 2]";
+            } else if (i % 10 == 5) {
+                json_str = fmt::format(R"({{"a": "{}", "b": "s{}", "c": {{"x": {}}}}})", i, i, i);
+            } else {
+                json_str = fmt::format(R"({{"a": {}, "b": "s{}", "c": {{"x": {}}}, "d": {}}})", i, i, i, i + 0.5);
+            }
+            json_column->append(JsonValue::parse(json_str).value());
+            null_column->append(0);
+        }
+        return NullableColumn::create(std::move(json_column), std::move(null_column));
+    }
+
+    void write_json_column(const std::string& fname, const Column& src, ColumnMetaPB* meta) {
+        ASSIGN_OR_ABORT(auto wfile, _fs->new_writable_file(fname));
+
+        TabletColumn json_tablet_column(STORAGE_AGGREGATE_NONE, TYPE_JSON, true);
+        ColumnWriterOptions writer_opts;
+        writer_opts.meta = meta;
+        writer_opts.meta->set_column_id(0);
+        writer_opts.meta->set_unique_id(0);
+        writer_opts.meta->set_type(TYPE_JSON);
+        writer_opts.meta->set_length(0);
+        writer_opts.meta->set_encoding(DEFAULT_ENCODING);
+        writer_opts.meta->set_compression(starrocks::LZ4_FRAME);
+        writer_opts.meta->set_is_nullable(true);
+        writer_opts.meta->mutable_json_meta()->set_format_version(kJsonMetaDefaultFormatVersion);
+        ASSIGN_OR_ABORT(auto writer, ColumnWriter::create(writer_opts, &json_tablet_column, wfile.get()));
+        ASSERT_OK(writer->init());
+        ASSERT_OK(writer->append(src));
+        ASSERT_OK(writer->finish());
+        ASSERT_OK(writer->write_data());
+        ASSERT_OK(writer->write_ordinal_index());
+        ASSERT_OK(writer->write_zone_map());
+        ASSERT_OK(wfile->close());
+    }
+
+    std::shared_ptr<MemoryFileSystem> _fs;
+    std::shared_ptr<TabletSchema> _dummy_segment_schema;
+};
+
+// NOLINTNEXTLINE
+TEST_F(JsonColumnRWTest, test_flat_json) {
+    auto old_enable = config::enable_json_flat_storage;
+    config::enable_json_flat_storage = true;
+    DeferOp defer([&]() { config::enable_json_flat_storage = old_enable; });
+
+    const size_t num_rows = 1000;
+    ColumnPtr src = build_json_column(num_rows);
+    ColumnMetaPB meta;
+    const std::string fname = TEST_DIR + "/test_flat_json.data";
+    write_json_column(fname, *src, &meta);
+
+    // "c" is an object, which is kept in the remainder.
+    ASSERT_EQ(kJsonMetaFlatFormatVersion, meta.json_meta().format_version());
+    ASSERT_EQ(3, meta.json_meta().flat_paths_size());
+    ASSERT_EQ(3, meta.children_columns_size());
+    std::map<std::string, std::pair<LogicalType, bool>> fields;
+    for (int i = 0; i < meta.json_meta().flat_paths_size(); i++) {
+        fields[meta.json_meta().flat_paths(i)] = {static_cast<LogicalType>(meta.children_columns(i).type()),
+                                                   meta.json_meta().flat_path_complete(i)};
+    }
+    ASSERT_EQ(std::make_pair(TYPE_BIGINT, false), fields["a"]);
+    ASSERT_EQ(std::make_pair(TYPE_VARCHAR, true), fields["b"]);
+    ASSERT_EQ(std::make_pair(TYPE_DOUBLE, true), fields["d"]);
+
+    auto segment = create_dummy_segment(fname);
+    ASSIGN_OR_ABORT(auto reader, ColumnReader::create(&meta, segment.get()));
+    ASSERT_TRUE(reader->is_flat_json());
+    ASSIGN_OR_ABORT(auto read_file, _fs->new_random_access_file(fname));
+    ColumnIteratorOptions iter_opts;
+    OlapReaderStatistics stats;
+    iter_opts.stats = &stats;
+    iter_opts.read_file = read_file.get();
+
+    // read the whole documents
+    {
+        ASSIGN_OR_ABORT(auto iter, reader->new_iterator());
+        ASSERT_OK(iter->init(iter_opts));
+        ASSERT_OK(iter->seek_to_first());
+        auto dst = NullableColumn::create(JsonColumn::create(), NullColumn::create());
+        size_t rows_read = num_rows;
+        ASSERT_OK(iter->next_batch(&rows_read, dst.get()));
+        ASSERT_EQ(num_rows, rows_read);
+        for (size_t i = 0; i < num_rows; i++) {
+            ASSERT_EQ(src->is_null(i), dst->is_null(i)) << i;
+            if (!src->is_null(i)) {
+                ASSERT_EQ(*src->get(i).get_json(), *dst->get(i).get_json()) << i;
+            }
+        }
+
+        // read by rowids
+        std::vector<rowid_t> rowids{0, 5, 98, 99, 500, 999};
+        dst->reset_column();
+        ASSERT_OK(iter->fetch_values_by_rowid(rowids.data(), rowids.size(), dst.get()));
+        ASSERT_EQ(rowids.size(), dst->size());
+        for (size_t i = 0; i < rowids.size(); i++) {
+            ASSERT_EQ(src->is_null(rowids[i]), dst->is_null(i));
+            if (!dst->is_null(i)) {
+                ASSERT_EQ(*src->get(rowids[i]).get_json(), *dst->get(i).get_json());
+            }
+        }
+    }
+
+    // read a single field
+    {
+        ASSERT_TRUE(reader->new_flat_json_field_iterator("a").status().is_not_found());
+        ASSERT_TRUE(reader->new_flat_json_field_iterator("c").status().is_not_found());
+        ASSIGN_OR_ABORT(auto iter, reader->new_flat_json_field_iterator("b"));
+        ASSERT_OK(iter->init(iter_opts));
+        ASSERT_OK(iter->seek_to_first());
+        auto dst = NullableColumn::create(BinaryColumn::create(), NullColumn::create());
+        size_t rows_read = num_rows;
+        ASSERT_OK(iter->next_batch(&rows_read, dst.get()));
+        ASSERT_EQ(num_rows, rows_read);
+        for (size_t i = 0; i < num_rows; i++) {
+            if (i % 100 >= 98) {
+                ASSERT_TRUE(dst->is_null(i));
+            } else {
+                ASSERT_EQ("s" + std::to_string(i), dst->get(i).get_slice().to_string());
+            }
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(JsonColumnRWTest, test_flat_json_disabled) {
+    auto old_enable = config::enable_json_flat_storage;
+    config::enable_json_flat_storage = false;
+    DeferOp defer([&]() { config::enable_json_flat_storage = old_enable; });
+
+    ColumnPtr src = build_json_column(100);
+    ColumnMetaPB meta;
+    const std::string fname = TEST_DIR + "/test_flat_json_disabled.data";
+    write_json_column(fname, *src, &meta);
+    ASSERT_EQ(kJsonMetaDefaultFormatVersion, meta.json_meta().format_version());
+    ASSERT_EQ(0, meta.children_columns_size());
+
+    auto segment = create_dummy_segment(fname);
+    ASSIGN_OR_ABORT(auto reader, ColumnReader::create(&meta, segment.get()));
+    ASSERT_FALSE(reader->is_flat_json());
+    ASSERT_TRUE(reader->new_flat_json_field_iterator("a").status().is_not_found());
+}
+
+} // namespace starrocks
@@ -0,0 +1,119 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "storage/rowset/segment_meta_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "fs/fs_util.h"
+#include "gen_cpp/segment.pb.h"
+#include "testutil/assert.h"
+
+namespace starrocks {
+
+class SegmentMetaCacheTest : public testing::Test {
+public:
+    void SetUp() override {
+        CHECK_OK(fs::remove_all(kTestDir));
+        CHECK_OK(fs::create_directories(kTestDir));
+    }
+
+    void TearDown() override { (void)fs::remove_all(kTestDir); }
+
+protected:
+    static SegmentFooterPB make_footer(uint32_t num_rows) {
+        SegmentFooterPB footer;
+        footer.set_version(2);
+        footer.set_num_rows(num_rows);
+        footer.add_columns()->set_unique_id(1);
+        return footer;
+    }
+
+    const std::string kTestDir = "./segment_meta_cache_test";
+};
+
+// NOLINTNEXTLINE
+TEST_F(SegmentMetaCacheTest, test_lookup_and_flush) {
+    const std::string seg_path = kTestDir + "/data/0/10001/0/a_0.dat";
+    {
+        SegmentMetaCache cache(kTestDir);
+        ASSERT_OK(cache.open());
+        ASSERT_EQ(0, cache.size());
+
+        SegmentFooterPB footer;
+        ASSERT_FALSE(cache.lookup(seg_path, 100, 1, &footer));
+        cache.insert(seg_path, 100, 1, make_footer(10));
+        cache.insert(kTestDir + "/data/0/10001/0/a_1.dat", 200, 1, make_footer(20));
+        ASSERT_TRUE(cache.lookup(seg_path, 100, 1, &footer));
+        ASSERT_EQ(10, footer.num_rows());
+        // the segment file has been changed
+        ASSERT_FALSE(cache.lookup(seg_path, 101, 1, &footer));
+        ASSERT_FALSE(cache.lookup(seg_path, 100, 2, &footer));
+
+        ASSERT_OK(cache.flush());
+        // looked up from the mapped file
+        ASSERT_TRUE(cache.lookup(seg_path, 100, 1, &footer));
+        ASSERT_EQ(10, footer.num_rows());
+        cache.erase(kTestDir + "/data/0/10001/0/a_1.dat");
+        ASSERT_OK(cache.flush());
+    }
+    {
+        SegmentMetaCache cache(kTestDir);
+        ASSERT_OK(cache.open());
+        ASSERT_EQ(1, cache.size());
+        SegmentFooterPB footer;
+        ASSERT_TRUE(cache.lookup(seg_path, 100, 1, &footer));
+        ASSERT_EQ(10, footer.num_rows());
+        ASSERT_EQ(1, footer.columns_size());
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(SegmentMetaCacheTest, test_corrupted_tail) {
+    std::string file_path;
+    {
+        SegmentMetaCache cache(kTestDir);
+        ASSERT_OK(cache.open());
+        cache.insert(kTestDir + "/a_0.dat", 100, 1, make_footer(10));
+        ASSERT_OK(cache.flush());
+        file_path = cache.file_path();
+    }
+    {
+        // append a partially written record
+        std::ofstream out(file_path, std::ios::app | std::ios::binary);
+        out.write("\x10\x00\x00\x00\x01", 5);
+    }
+    SegmentMetaCache cache(kTestDir);
+    ASSERT_OK(cache.open());
+    ASSERT_EQ(1, cache.size());
+    SegmentFooterPB footer;
+    ASSERT_TRUE(cache.lookup(kTestDir + "/a_0.dat", 100, 1, &footer));
+    ASSERT_EQ(10, footer.num_rows());
+}
+
+// NOLINTNEXTLINE
+TEST_F(SegmentMetaCacheTest, test_of) {
+    SegmentMetaCache cache(kTestDir);
+    ASSERT_EQ(nullptr, SegmentMetaCache::of(kTestDir + "/a_0.dat"));
+    SegmentMetaCache::register_cache(&cache);
+    ASSERT_EQ(&cache, SegmentMetaCache::of(kTestDir + "/a_0.dat"));
+    ASSERT_EQ(nullptr, SegmentMetaCache::of(kTestDir + "_other/a_0.dat"));
+    SegmentMetaCache::unregister_cache(&cache);
+    ASSERT_EQ(nullptr, SegmentMetaCache::of(kTestDir + "/a_0.dat"));
+}
+
+} // namespace starrocks
@@ -0,0 +1,57 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "storage/rowset/segment_piece_writable_file.h"
+
+#include <gtest/gtest.h>
+
+#include "fs/fs_memory.h"
+#include "testutil/assert.h"
+
+namespace starrocks {
+
+// NOLINTNEXTLINE
+TEST(SegmentPieceWritableFileTest, test_pieces) {
+    MemoryFileSystem fs;
+    ASSIGN_OR_ABORT(auto file, fs.new_writable_file("/0.dat"));
+
+    std::vector<std::pair<int64_t, std::string>> pieces;
+    SegmentPieceWritableFile wfile(std::move(file), 4, [&](int64_t offset, butil::IOBuf* piece) {
+        pieces.emplace_back(offset, piece->to_string());
+        piece->clear();
+    });
+
+    ASSERT_OK(wfile.append("abc"));
+    ASSERT_TRUE(pieces.empty());
+    Slice slices[] = {"defgh", "ij", "k"};
+    ASSERT_OK(wfile.appendv(slices, 3));
+    ASSERT_OK(wfile.append("l"));
+    ASSERT_OK(wfile.append("m"));
+    ASSERT_OK(wfile.close());
+
+    // the bytes after the last full piece are not passed
+    ASSERT_EQ(2, pieces.size());
+    ASSERT_EQ(0, pieces[0].first);
+    ASSERT_EQ("abcdefgh", pieces[0].second);
+    ASSERT_EQ(8, pieces[1].first);
+    ASSERT_EQ("ijkl", pieces[1].second);
+    ASSERT_EQ(13, wfile.size());
+
+    std::string content;
+    ASSERT_OK(fs.read_file("/0.dat", &content));
+    ASSERT_EQ("abcdefghijklm", content);
+}
+
+} // namespace starrocks
@@ -51,10 +51,12 @@
 #include "storage/rowset/column_iterator.h"
 #include "storage/rowset/column_reader.h"
 #include "storage/rowset/segment_options.h"
+#include "storage/rowset/segment_row_fetcher.h"
 #include "storage/rowset/segment_writer.h"
 #include "storage/tablet_schema.h"
 #include "storage/tablet_schema_helper.h"
 #include "testutil/assert.h"
+#include "util/defer_op.h"
 
 namespace starrocks {
 
@@ -247,6 +249,159 @@ TEST_F(SegmentReaderWriterTest, TestHorizontalWrite) {
     EXPECT_EQ(count, num_rows);
 }
 
+// NOLINTNEXTLINE
+TEST_F(SegmentReaderWriterTest, TestParallelColumnEncode) {
+    const int num_columns = 40;
+    std::vector<ColumnPB> columns;
+    columns.emplace_back(create_int_key_pb(0));
+    for (int cid = 1; cid < num_columns; ++cid) {
+        columns.emplace_back(create_int_value_pb(cid));
+    }
+    std::unique_ptr<TabletSchema> tablet_schema = TabletSchemaHelper::create_tablet_schema(columns);
+
+    auto old_enable = config::enable_segment_parallel_column_encode;
+    auto old_columns_per_task = config::segment_parallel_encode_columns_per_task;
+    config::enable_segment_parallel_column_encode = true;
+    config::segment_parallel_encode_columns_per_task = 3;
+    DeferOp defer([&]() {
+        config::enable_segment_parallel_column_encode = old_enable;
+        config::segment_parallel_encode_columns_per_task = old_columns_per_task;
+    });
+
+    SegmentWriterOptions opts;
+    opts.num_rows_per_block = 10;
+    size_t num_rows = 4096;
+    shared_ptr<Segment> segment;
+    build_segment(opts, *tablet_schema, *tablet_schema, num_rows, DefaultIntGenerator, &segment);
+
+    auto schema = ChunkHelper::convert_schema(*tablet_schema);
+    SegmentReadOptions seg_options;
+    seg_options.fs = _fs;
+    OlapReaderStatistics stats;
+    seg_options.stats = &stats;
+    ASSIGN_OR_ABORT(auto seg_iterator, segment->new_iterator(schema, seg_options));
+
+    auto chunk = ChunkHelper::new_chunk(schema, config::vector_chunk_size);
+    size_t count = 0;
+    while (true) {
+        chunk->reset();
+        auto st = seg_iterator->get_next(chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        ASSERT_OK(st);
+        for (size_t i = 0; i < chunk->num_rows(); ++i) {
+            auto row = chunk->get(i);
+            for (int cid = 0; cid < num_columns; ++cid) {
+                ASSERT_EQ(DefaultIntGenerator(count, cid, 0).get_int32(), row[cid].get_int32());
+            }
+            ++count;
+        }
+    }
+    ASSERT_EQ(num_rows, count);
+}
+
+// NOLINTNEXTLINE
+TEST_F(SegmentReaderWriterTest, TestPrefetch) {
+    std::unique_ptr<TabletSchema> tablet_schema =
+            TabletSchemaHelper::create_tablet_schema({create_int_key_pb(1), create_int_value_pb(2)});
+
+    SegmentWriterOptions opts;
+    opts.num_rows_per_block = 10;
+
+    std::string file_name = kSegmentDir + "/prefetch_case";
+    ASSIGN_OR_ABORT(auto wfile, _fs->new_writable_file(file_name));
+
+    SegmentWriter writer(std::move(wfile), 0, tablet_schema.get(), opts);
+    ASSERT_OK(writer.init());
+
+    size_t num_rows = 1000;
+    auto schema = ChunkHelper::convert_schema(*tablet_schema);
+    auto chunk = ChunkHelper::new_chunk(schema, num_rows);
+    auto& cols = chunk->columns();
+    for (auto i = 0; i < num_rows; ++i) {
+        cols[0]->append_datum(Datum(static_cast<int32_t>(i)));
+        cols[1]->append_datum(Datum(static_cast<int32_t>(i + 1)));
+    }
+    ASSERT_OK(writer.append_chunk(*chunk));
+
+    uint64_t file_size = 0;
+    uint64_t index_size;
+    uint64_t footer_position;
+    ASSERT_OK(writer.finalize(&file_size, &index_size, &footer_position));
+
+    auto segment = *Segment::open(_fs, file_name, 0, tablet_schema.get());
+    ASSERT_FALSE(segment->has_loaded_index());
+
+    // The non-existent column is skipped.
+    ASSERT_OK(segment->prefetch({0, 1, 100}));
+    ASSERT_TRUE(segment->has_loaded_index());
+    // Prefetching again is harmless.
+    ASSERT_OK(segment->prefetch({1}));
+}
+
+// NOLINTNEXTLINE
+TEST_F(SegmentReaderWriterTest, TestRowFetcher) {
+    std::unique_ptr<TabletSchema> tablet_schema = TabletSchemaHelper::create_tablet_schema(
+            {create_int_key_pb(1), create_int_value_pb(2), create_int_value_pb(3)});
+
+    SegmentWriterOptions opts;
+    opts.num_rows_per_block = 10;
+
+    std::string file_name = kSegmentDir + "/row_fetcher_case";
+    ASSIGN_OR_ABORT(auto wfile, _fs->new_writable_file(file_name));
+
+    SegmentWriter writer(std::move(wfile), 0, tablet_schema.get(), opts);
+    ASSERT_OK(writer.init());
+
+    size_t num_rows = 10000;
+    auto schema = ChunkHelper::convert_schema(*tablet_schema);
+    auto chunk = ChunkHelper::new_chunk(schema, num_rows);
+    auto& cols = chunk->columns();
+    for (auto i = 0; i < num_rows; ++i) {
+        cols[0]->append_datum(Datum(static_cast<int32_t>(i)));
+        cols[1]->append_datum(Datum(static_cast<int32_t>(i * 2)));
+        cols[2]->append_datum(Datum(static_cast<int32_t>(i * 3)));
+    }
+    ASSERT_OK(writer.append_chunk(*chunk));
+
+    uint64_t file_size = 0;
+    uint64_t index_size;
+    uint64_t footer_position;
+    ASSERT_OK(writer.finalize(&file_size, &index_size, &footer_position));
+
+    auto segment = *Segment::open(_fs, file_name, 0, tablet_schema.get());
+
+    // Only fetch the value columns.
+    auto fetch_schema = ChunkHelper::convert_schema(*tablet_schema, std::vector<ColumnId>{1, 2});
+    SegmentRowFetcher fetcher(segment, fetch_schema);
+    OlapReaderStatistics stats;
+    ASSERT_OK(fetcher.init(&stats, false));
+
+    // Ascending row ids.
+    {
+        std::vector<rowid_t> rowids{0, 5, 4096, 9999};
+        auto res = ChunkHelper::new_chunk(fetch_schema, rowids.size());
+        ASSERT_OK(fetcher.fetch(rowids.data(), rowids.size(), res.get()));
+        ASSERT_EQ(rowids.size(), res->num_rows());
+        for (size_t i = 0; i < rowids.size(); ++i) {
+            EXPECT_EQ(static_cast<int32_t>(rowids[i] * 2), res->get(i)[0].get_int32());
+            EXPECT_EQ(static_cast<int32_t>(rowids[i] * 3), res->get(i)[1].get_int32());
+        }
+    }
+    // Unordered row ids with duplicates, e.g. the output of a hash join.
+    {
+        std::vector<rowid_t> rowids{9000, 3, 9000, 1, 7777, 3};
+        auto res = ChunkHelper::new_chunk(fetch_schema, rowids.size());
+        ASSERT_OK(fetcher.fetch(rowids.data(), rowids.size(), res.get()));
+        ASSERT_EQ(rowids.size(), res->num_rows());
+        for (size_t i = 0; i < rowids.size(); ++i) {
+            EXPECT_EQ(static_cast<int32_t>(rowids[i] * 2), res->get(i)[0].get_int32());
+            EXPECT_EQ(static_cast<int32_t>(rowids[i] * 3), res->get(i)[1].get_int32());
+        }
+    }
+}
+
 // NOLINTNEXTLINE
 TEST_F(SegmentReaderWriterTest, TestVerticalWrite) {
     std::unique_ptr<TabletSchema> tablet_schema = TabletSchemaHelper::create_tablet_schema(
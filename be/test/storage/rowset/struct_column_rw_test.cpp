@@ -167,6 +167,99 @@ protected:
         }
     }
 
+    void test_subfield_zone_map() {
+        auto fs = std::make_shared<MemoryFileSystem>();
+        ASSERT_TRUE(fs->create_dir(TEST_DIR).ok());
+
+        TabletColumn struct_column = create_struct(0, false);
+        std::vector<std::string> names{"f1"};
+        TabletColumn f1_tablet_column = create_int_value(1, STORAGE_AGGREGATE_NONE, false);
+        struct_column.add_sub_column(f1_tablet_column);
+
+        const size_t num_rows = 1024;
+        auto f1_column = Int32Column::create();
+        for (size_t i = 0; i < num_rows; i++) {
+            f1_column->append(static_cast<int32_t>(i));
+        }
+        Columns columns;
+        columns.emplace_back(std::move(f1_column));
+        ColumnPtr src_column = StructColumn::create(columns, names);
+
+        ColumnMetaPB meta;
+        const std::string fname = TEST_DIR + "/test_struct_subfield_zone_map.data";
+        auto segment = create_dummy_segment(fs, fname);
+        // write data
+        {
+            ASSIGN_OR_ABORT(auto wfile, fs->new_writable_file(fname));
+
+            ColumnWriterOptions writer_opts;
+            writer_opts.meta = &meta;
+            writer_opts.meta->set_column_id(0);
+            writer_opts.meta->set_unique_id(0);
+            writer_opts.meta->set_type(TYPE_STRUCT);
+            writer_opts.meta->set_length(0);
+            writer_opts.meta->set_encoding(DEFAULT_ENCODING);
+            writer_opts.meta->set_compression(starrocks::LZ4_FRAME);
+            writer_opts.meta->set_is_nullable(false);
+            writer_opts.need_zone_map = false;
+            writer_opts.need_subfield_zone_map = true;
+
+            ColumnMetaPB* f1_meta = writer_opts.meta->add_children_columns();
+            f1_meta->set_column_id(0);
+            f1_meta->set_unique_id(0);
+            f1_meta->set_type(f1_tablet_column.type());
+            f1_meta->set_length(f1_tablet_column.length());
+            f1_meta->set_encoding(DEFAULT_ENCODING);
+            f1_meta->set_compression(LZ4_FRAME);
+            f1_meta->set_is_nullable(false);
+
+            ASSIGN_OR_ABORT(auto writer, ColumnWriter::create(writer_opts, &struct_column, wfile.get()));
+            ASSERT_OK(writer->init());
+            ASSERT_OK(writer->append(*src_column));
+            ASSERT_OK(writer->finish());
+            ASSERT_OK(writer->write_data());
+            ASSERT_OK(writer->write_ordinal_index());
+            ASSERT_OK(writer->write_zone_map());
+            ASSERT_OK(wfile->close());
+        }
+
+        // the zone map is written for the field
+        const ColumnMetaPB& field_meta = meta.children_columns(0);
+        bool has_zone_map = false;
+        for (const auto& index : field_meta.indexes()) {
+            has_zone_map |= index.type() == ZONE_MAP_INDEX;
+        }
+        ASSERT_TRUE(has_zone_map);
+
+        // read and check
+        {
+            ASSIGN_OR_ABORT(auto reader, ColumnReader::create(&meta, segment.get()));
+            ASSIGN_OR_ABORT(auto iter, reader->new_iterator());
+            ASSIGN_OR_ABORT(auto read_file, fs->new_random_access_file(fname));
+
+            ColumnIteratorOptions iter_opts;
+            OlapReaderStatistics stats;
+            iter_opts.stats = &stats;
+            iter_opts.read_file = read_file.get();
+            ASSERT_OK(iter->init(iter_opts));
+
+            // all the rows are selected without the predicates on the fields
+            SparseRange row_ranges;
+            ASSERT_OK(iter->get_row_ranges_by_zone_map({}, nullptr, &row_ranges));
+            ASSERT_EQ(num_rows, row_ranges.span_size());
+
+            ASSERT_OK(iter->seek_to_first());
+            auto dst_f1_column = Int32Column::create();
+            Columns dst_columns;
+            dst_columns.emplace_back(std::move(dst_f1_column));
+            ColumnPtr dst_column = StructColumn::create(dst_columns, names);
+            size_t rows_read = num_rows;
+            ASSERT_OK(iter->next_batch(&rows_read, dst_column.get()));
+            ASSERT_EQ(num_rows, rows_read);
+            ASSERT_EQ("{f1:1023}", dst_column->debug_item(num_rows - 1));
+        }
+    }
+
 private:
     std::shared_ptr<TabletSchema> _dummy_segment_schema;
 };
@@ -176,4 +269,8 @@ TEST_F(StructColumnRWTest, test_array_int) {
     test_int_struct();
 }
 
-} // namespace starrocks
\ No newline at end of file
+TEST_F(StructColumnRWTest, test_subfield_zone_map) {
+    test_subfield_zone_map();
+}
+
+} // namespace starrocks
@@ -535,6 +535,73 @@ TEST_F(SchemaChangeTest, schema_change_with_sorting) {
     (void)StorageEngine::instance()->tablet_manager()->drop_tablet(1004);
 }
 
+TEST_F(SchemaChangeTest, schema_change_with_sorted_input) {
+    CreateSrcTablet(1005);
+    StorageEngine* engine = StorageEngine::instance();
+    TCreateTabletReq create_tablet_req;
+    SetCreateTabletReq(&create_tablet_req, 1006, TKeysType::AGG_KEYS);
+    create_tablet_req.tablet_schema.short_key_column_count = 1;
+    AddColumn(&create_tablet_req, "k1", TPrimitiveType::INT, true, TKeysType::AGG_KEYS);
+    AddColumn(&create_tablet_req, "v1", TPrimitiveType::INT, false, TKeysType::AGG_KEYS);
+    AddColumn(&create_tablet_req, "v2", TPrimitiveType::INT, false, TKeysType::AGG_KEYS);
+    Status res = engine->create_tablet(create_tablet_req);
+    ASSERT_TRUE(res.ok()) << res.to_string();
+    TabletSharedPtr new_tablet = engine->tablet_manager()->get_tablet(create_tablet_req.tablet_id);
+    TabletSharedPtr base_tablet = engine->tablet_manager()->get_tablet(1005);
+
+    // the new key k1 is a prefix of the base keys k1, k2
+    ChunkChanger chunk_changer(new_tablet->tablet_schema());
+    auto indexs = chunk_changer.get_mutable_selected_column_indexes();
+    const int32_t ref_columns[] = {0, 2, 3};
+    for (size_t i = 0; i < 3; ++i) {
+        ColumnMapping* column_mapping = chunk_changer.get_mutable_column_mapping(i);
+        column_mapping->ref_column = ref_columns[i];
+        column_mapping->ref_base_reader_column_index = i;
+        indexs->emplace_back(ref_columns[i]);
+    }
+    auto sc_procedure = std::make_unique<SchemaChangeWithSorting>(
+            &chunk_changer, config::memory_limitation_per_thread_for_schema_change * 1024 * 1024 * 1024);
+    RowsetSharedPtr rowset = base_tablet->get_rowset_by_version(Version(3, 3));
+    ASSERT_TRUE(rowset != nullptr);
+    ASSERT_TRUE(sc_procedure->is_sorted_by_new_keys(new_tablet, base_tablet, rowset));
+
+    // the new key refers to the second base key
+    ChunkChanger reordered_chunk_changer(new_tablet->tablet_schema());
+    reordered_chunk_changer.get_mutable_column_mapping(0)->ref_column = 1;
+    SchemaChangeWithSorting reordered_sc_procedure(&reordered_chunk_changer, 1024 * 1024 * 1024);
+    ASSERT_FALSE(reordered_sc_procedure.is_sorted_by_new_keys(new_tablet, base_tablet, rowset));
+
+    TabletReaderParams read_params;
+    read_params.reader_type = ReaderType::READER_ALTER_TABLE;
+    read_params.skip_aggregation = false;
+    read_params.chunk_size = config::vector_chunk_size;
+    Schema base_schema = ChunkHelper::convert_schema(base_tablet->tablet_schema(), *indexs);
+    auto tablet_rowset_reader = std::make_unique<TabletReader>(base_tablet, rowset->version(), base_schema);
+    ASSERT_OK(tablet_rowset_reader->prepare());
+    ASSERT_OK(tablet_rowset_reader->open(read_params));
+
+    RowsetWriterContext writer_context;
+    writer_context.rowset_id = engine->next_rowset_id();
+    writer_context.tablet_uid = new_tablet->tablet_uid();
+    writer_context.tablet_id = new_tablet->tablet_id();
+    writer_context.tablet_schema_hash = new_tablet->schema_hash();
+    writer_context.rowset_path_prefix = new_tablet->schema_hash_path();
+    writer_context.tablet_schema = &(new_tablet->tablet_schema());
+    writer_context.rowset_state = VISIBLE;
+    writer_context.version = Version(3, 3);
+    std::unique_ptr<RowsetWriter> rowset_writer;
+    ASSERT_OK(RowsetFactory::create_rowset_writer(writer_context, &rowset_writer));
+
+    ASSERT_OK(sc_procedure->process_v2(tablet_rowset_reader.get(), rowset_writer.get(), new_tablet, base_tablet,
+                                       rowset));
+    ASSIGN_OR_ABORT(auto new_rowset, rowset_writer->build());
+    // all the 4 rows of k1 = 1 are aggregated into one row without sorting
+    ASSERT_EQ(1, new_rowset->num_rows());
+    tablet_rowset_reader.reset();
+    (void)StorageEngine::instance()->tablet_manager()->drop_tablet(1005);
+    (void)StorageEngine::instance()->tablet_manager()->drop_tablet(1006);
+}
+
 TEST_F(SchemaChangeTest, schema_change_with_directing_v2) {
     CreateSrcTablet(1101);
     StorageEngine* engine = StorageEngine::instance();
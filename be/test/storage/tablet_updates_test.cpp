@@ -1508,6 +1508,33 @@ TEST_F(TabletUpdatesTest, compaction_score_enough_normal) {
     test_compaction_score_enough_normal(false);
 }
 
+TEST_F(TabletUpdatesTest, compaction_score_with_scans) {
+    srand(GetCurrentTimeMicros());
+    _tablet = create_tablet(rand(), rand());
+    std::vector<int64_t> keys;
+    for (int i = 0; i < 100; i++) {
+        keys.push_back(i);
+    }
+    ASSERT_TRUE(_tablet->rowset_commit(2, create_rowset(_tablet, keys)).ok());
+    // Delete [0, 1, 2 ... 10)
+    Int64Column deletes;
+    deletes.append_numbers(keys.data(), sizeof(int64_t) * 10);
+    ASSERT_TRUE(_tablet->rowset_commit(3, create_rowset(_tablet, {}, &deletes)).ok());
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    auto score = _tablet->updates()->get_compaction_score();
+
+    // the deleted rows are read by every scan, which makes the compaction more valuable.
+    for (int i = 0; i < 10; i++) {
+        ASSERT_EQ(90, read_tablet(_tablet, 3));
+    }
+    EXPECT_GT(_tablet->updates()->get_compaction_score(), score);
+
+    auto old_cost = config::update_compaction_read_cost_per_scan;
+    config::update_compaction_read_cost_per_scan = 0;
+    DeferOp unset_config([&] { config::update_compaction_read_cost_per_scan = old_cost; });
+    EXPECT_EQ(score, _tablet->updates()->get_compaction_score());
+}
+
 // NOLINTNEXTLINE
 void TabletUpdatesTest::test_horizontal_compaction(bool enable_persistent_index) {
     auto orig = config::vertical_compaction_max_columns_per_group;
@@ -160,6 +160,38 @@ TEST_F(UpdateManagerTest, testDelVec) {
     ASSERT_EQ(5, tmp->version());
 }
 
+TEST_F(UpdateManagerTest, testVersionedDelVecCache) {
+    TabletSegmentId rssid;
+    rssid.tablet_id = 0;
+    rssid.segment_id = 0;
+    DelVector empty;
+    DelVectorPtr delvec3;
+    vector<uint32_t> dels3 = {1, 3, 5, 70, 9000};
+    empty.add_dels_as_new_version(dels3, 3, &delvec3);
+    _update_manager->set_del_vec_in_meta(_meta.get(), rssid, *delvec3);
+    DelVectorPtr delvec5;
+    vector<uint32_t> dels5 = {2, 4, 6, 80, 9000};
+    delvec3->add_dels_as_new_version(dels5, 5, &delvec5);
+    _update_manager->set_del_vec_in_meta(_meta.get(), rssid, *delvec5);
+    _update_manager->set_cached_del_vec(rssid, delvec5);
+    const int64_t latest_usage = _root_mem_tracker->consumption();
+
+    // the delvec of an older version is cached and shared by the later reads
+    DelVectorPtr tmp1;
+    ASSERT_TRUE(_update_manager->get_del_vec(_meta.get(), rssid, 4, &tmp1).ok());
+    ASSERT_EQ(3, tmp1->version());
+    ASSERT_GT(_root_mem_tracker->consumption(), latest_usage);
+    DelVectorPtr tmp2;
+    ASSERT_TRUE(_update_manager->get_del_vec(_meta.get(), rssid, 4, &tmp2).ok());
+    ASSERT_EQ(tmp1.get(), tmp2.get());
+
+    _update_manager->clear_cached_del_vec({rssid});
+    ASSERT_EQ(0, _root_mem_tracker->consumption());
+    ASSERT_TRUE(_update_manager->get_del_vec(_meta.get(), rssid, 4, &tmp2).ok());
+    ASSERT_EQ(3, tmp2->version());
+    ASSERT_NE(tmp1.get(), tmp2.get());
+}
+
 TEST_F(UpdateManagerTest, testExpireEntry) {
     srand(time(nullptr));
     create_tablet(rand(), rand());
@@ -0,0 +1,46 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "util/bandwidth_throttle.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+namespace starrocks {
+
+TEST(BandwidthThrottleTest, unlimited) {
+    BandwidthThrottle throttle([] { return 0; });
+    for (int i = 0; i < 10; i++) {
+        ASSERT_EQ(0, throttle.acquire(1L << 30));
+    }
+}
+
+TEST(BandwidthThrottleTest, limited) {
+    std::atomic<int64_t> rate{1000};
+    BandwidthThrottle throttle([&rate] { return rate.load(); });
+    // the burst of one second is free
+    ASSERT_EQ(0, throttle.acquire(1000));
+    int64_t wait_ns = throttle.acquire(500);
+    ASSERT_GT(wait_ns, 400 * 1000 * 1000L);
+    ASSERT_LE(wait_ns, 500 * 1000 * 1000L);
+    // the debt accumulates
+    ASSERT_GT(throttle.acquire(500), wait_ns);
+
+    // the limit is changed on the fly
+    rate = 0;
+    ASSERT_EQ(0, throttle.acquire(1000));
+}
+
+} // namespace starrocks
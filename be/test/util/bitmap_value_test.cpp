@@ -419,4 +419,45 @@ TEST(BitmapValueTest, bitmap_xor) {
     }
 }
 
+TEST(BitmapValueTest, bitmap_fast_union_and_intersect) {
+    // {0..99}, {50..149}, {1<<40, 1}, {7}, {}, {(1<<40) + 1, 2, 3}
+    std::vector<BitmapValue> bitmaps(6);
+    for (uint64_t i = 0; i < 100; i++) {
+        bitmaps[0].add(i);
+        bitmaps[1].add(i + 50);
+    }
+    bitmaps[2].add(1ULL << 40);
+    bitmaps[2].add(1);
+    bitmaps[3].add(7);
+    bitmaps[5].add((1ULL << 40) + 1);
+    bitmaps[5].add(2);
+    bitmaps[5].add(3);
+
+    std::vector<const BitmapValue*> values;
+    BitmapValue expected;
+    for (const auto& bitmap : bitmaps) {
+        values.emplace_back(&bitmap);
+        expected |= bitmap;
+    }
+    for (uint64_t init : {0, 1, 2}) {
+        BitmapValue actual;
+        BitmapValue expected_with_init = expected;
+        for (uint64_t i = 0; i < init; i++) {
+            actual.add(1000 + i);
+            expected_with_init.add(1000 + i);
+        }
+        actual.fast_union(values);
+        ASSERT_EQ(expected_with_init.to_string(), actual.to_string());
+    }
+    ASSERT_EQ(100, bitmaps[0].cardinality());
+
+    BitmapValue intersect = bitmaps[0];
+    intersect.fast_intersect({&bitmaps[1], &bitmaps[0]});
+    ASSERT_EQ(50, intersect.cardinality());
+    ASSERT_EQ(50, intersect.min());
+    ASSERT_EQ(99, intersect.max());
+    intersect.fast_intersect({&bitmaps[1], &bitmaps[3]});
+    ASSERT_EQ(0, intersect.cardinality());
+}
+
 } // namespace starrocks
@@ -40,6 +40,8 @@
 #include <thread>
 
 #include "gen_cpp/segment.pb.h"
+#include "gutil/strings/substitute.h"
+#include "testutil/assert.h"
 #include "util/faststring.h"
 #include "util/random.h"
 #include "util/raw_container.h"
@@ -224,6 +226,48 @@ TEST_F(BlockCompressionTest, multi) {
     test_multi_slices(starrocks::CompressionTypePB::GZIP);
 }
 
+TEST_F(BlockCompressionTest, zstd_dictionary) {
+    std::vector<std::string> pages;
+    for (int i = 0; i < 64; i++) {
+        std::string page;
+        for (int j = 0; j < 8; j++) {
+            page.append(strings::Substitute("{\"id\": $0, \"name\": \"name_$1\", \"tag\": \"starrocks\"}", i, j));
+        }
+        pages.emplace_back(std::move(page));
+    }
+    std::vector<Slice> samples(pages.begin(), pages.end());
+    ASSIGN_OR_ABORT(auto dict, train_zstd_dictionary(samples, 4096));
+    ASSERT_GT(dict.size(), 0);
+    ASSERT_LE(dict.size(), 4096);
+    ASSIGN_OR_ABORT(auto dict_codec, new_zstd_dict_codec(dict));
+    const BlockCompressionCodec* codec = nullptr;
+    ASSERT_OK(get_block_compression_codec(CompressionTypePB::ZSTD, &codec));
+
+    const std::string& page = pages[10];
+    std::string compressed(dict_codec->max_compressed_len(page.size()), '\0');
+    Slice compressed_slice(compressed);
+    ASSERT_OK(dict_codec->compress(std::vector<Slice>{Slice(page.data(), 100), Slice(page.data() + 100, page.size() - 100)},
+                                   &compressed_slice));
+    std::string plain_compressed(codec->max_compressed_len(page.size()), '\0');
+    Slice plain_slice(plain_compressed);
+    ASSERT_OK(codec->compress(Slice(page), &plain_slice));
+    ASSERT_LT(compressed_slice.size, plain_slice.size);
+
+    std::string uncompressed(page.size(), '\0');
+    Slice uncompressed_slice(uncompressed);
+    ASSERT_OK(dict_codec->decompress(compressed_slice, &uncompressed_slice));
+    ASSERT_EQ(page, uncompressed_slice.to_string());
+    // The pages compressed with a dictionary can not be decompressed without it.
+    uncompressed_slice = Slice(uncompressed);
+    ASSERT_FALSE(codec->decompress(compressed_slice, &uncompressed_slice).ok());
+    // The pooled contexts drop the dictionary when returned.
+    plain_slice = Slice(plain_compressed);
+    ASSERT_OK(codec->compress(Slice(page), &plain_slice));
+    uncompressed_slice = Slice(uncompressed);
+    ASSERT_OK(codec->decompress(plain_slice, &uncompressed_slice));
+    ASSERT_EQ(page, uncompressed_slice.to_string());
+}
+
 TEST_F(BlockCompressionTest, test_issue_10721) {
     std::string str = random_string(1024);
     const BlockCompressionCodec* codec = nullptr;
@@ -0,0 +1,107 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "util/bounded_mpmc_queue.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace starrocks {
+
+TEST(BoundedMPMCQueueTest, test_single_thread) {
+    BoundedMPMCQueue<std::unique_ptr<int>> queue(3);
+    ASSERT_EQ(4, queue.capacity());
+    ASSERT_TRUE(queue.empty());
+
+    std::unique_ptr<int> value;
+    ASSERT_FALSE(queue.try_get(&value));
+
+    for (int i = 0; i < 4; i++) {
+        ASSERT_TRUE(queue.try_put(std::make_unique<int>(i)));
+    }
+    ASSERT_EQ(4, queue.size());
+
+    // The value is not moved if the queue is full.
+    auto extra = std::make_unique<int>(4);
+    ASSERT_FALSE(queue.try_put(std::move(extra)));
+    ASSERT_NE(nullptr, extra);
+
+    for (int i = 0; i < 4; i++) {
+        ASSERT_TRUE(queue.try_get(&value));
+        ASSERT_EQ(i, *value);
+    }
+    ASSERT_TRUE(queue.empty());
+    ASSERT_FALSE(queue.try_get(&value));
+
+    // Wrap around.
+    for (int round = 0; round < 10; round++) {
+        ASSERT_TRUE(queue.try_put(std::make_unique<int>(round)));
+        ASSERT_TRUE(queue.try_get(&value));
+        ASSERT_EQ(round, *value);
+    }
+}
+
+TEST(BoundedMPMCQueueTest, test_multi_threads) {
+    constexpr int kNumProducers = 4;
+    constexpr int kNumConsumers = 4;
+    constexpr int64_t kNumValuesPerProducer = 100000;
+
+    BoundedMPMCQueue<int64_t> queue(64);
+    std::atomic<int64_t> num_got{0};
+    std::atomic<int64_t> sum{0};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < kNumProducers; p++) {
+        threads.emplace_back([&, p]() {
+            for (int64_t i = 0; i < kNumValuesPerProducer; i++) {
+                // Encode the producer in the value to check the order of each producer.
+                int64_t value = i * kNumProducers + p;
+                while (!queue.try_put(std::move(value))) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int c = 0; c < kNumConsumers; c++) {
+        threads.emplace_back([&]() {
+            std::vector<int64_t> last_values(kNumProducers, -1);
+            while (num_got.load() < kNumProducers * kNumValuesPerProducer) {
+                int64_t value;
+                if (!queue.try_get(&value)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                int64_t producer = value % kNumProducers;
+                ASSERT_GT(value, last_values[producer]);
+                last_values[producer] = value;
+                sum.fetch_add(value);
+                num_got.fetch_add(1);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    const int64_t n = kNumProducers * kNumValuesPerProducer;
+    ASSERT_EQ(n, num_got.load());
+    ASSERT_EQ(n * (n - 1) / 2, sum.load());
+    ASSERT_TRUE(queue.empty());
+}
+
+} // namespace starrocks
@@ -131,4 +131,51 @@ TEST_F(BufferedStreamTest, Large2) {
     }
 }
 
+class CountedStringInputStream : public io::SeekableInputStreamWrapper {
+public:
+    explicit CountedStringInputStream(std::string str)
+            : io::SeekableInputStreamWrapper(&_stream, kDontTakeOwnership), _stream(std::move(str)) {}
+
+    Status read_at_fully(int64_t offset, void* out, int64_t count) override {
+        num_reads++;
+        return _stream.read_at_fully(offset, out, count);
+    }
+
+    Status read_ranges_fully(const std::vector<io::ReadRange>& ranges) override {
+        num_reads++;
+        return _stream.read_ranges_fully(ranges);
+    }
+
+    int num_reads = 0;
+
+private:
+    io::StringInputStream _stream;
+};
+
+TEST_F(BufferedStreamTest, SharedPrefetch) {
+    std::string test_str;
+    for (int i = 0; i < 100; ++i) {
+        test_str.push_back(i);
+    }
+    auto counted = std::make_shared<CountedStringInputStream>(test_str);
+    RandomAccessFile file(counted, "string-file");
+
+    SharedBufferedInputStream stream(&file);
+    stream.set_coalesce_options({.max_dist_size = 0, .max_buffer_size = 10, .max_prefetch_size = 20});
+    // Not coalesced since far from each other, the last 2 are prefetched together with the first.
+    ASSERT_TRUE(stream.set_io_ranges({{0, 10}, {20, 10}, {40, 10}, {60, 10}}).ok());
+
+    const uint8_t* value;
+    size_t nbytes = 5;
+    ASSERT_TRUE(stream.get_bytes(&value, 2, &nbytes, false).ok());
+    ASSERT_EQ(2, *value);
+    ASSERT_EQ(1, counted->num_reads);
+    ASSERT_TRUE(stream.get_bytes(&value, 45, &nbytes, false).ok());
+    ASSERT_EQ(45, *value);
+    ASSERT_EQ(1, counted->num_reads);
+    ASSERT_TRUE(stream.get_bytes(&value, 61, &nbytes, false).ok());
+    ASSERT_EQ(61, *value);
+    ASSERT_EQ(2, counted->num_reads);
+}
+
 } // namespace starrocks
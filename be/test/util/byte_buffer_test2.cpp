@@ -49,4 +49,23 @@ TEST_F(ByteBufferTest, normal) {
     ASSERT_EQ(3, buf->remaining());
 }
 
+TEST_F(ByteBufferTest, wrap) {
+    char data[] = {1, 2, 3};
+    bool released = false;
+    {
+        auto buf = ByteBuffer::wrap(data, 3, [&]() { released = true; });
+        ASSERT_EQ(data, buf->ptr);
+        ASSERT_EQ(0, buf->pos);
+        ASSERT_EQ(3, buf->limit);
+        ASSERT_EQ(3, buf->remaining());
+
+        char out[3];
+        buf->get_bytes(out, 3);
+        ASSERT_EQ(0, memcmp(data, out, 3));
+        ASSERT_FALSE(buf->has_remaining());
+        ASSERT_FALSE(released);
+    }
+    ASSERT_TRUE(released);
+}
+
 } // namespace starrocks
@@ -0,0 +1,142 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "util/ddsketch.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace starrocks {
+
+class DDSketchTest : public testing::Test {
+protected:
+    static std::string serialize(const DDSketch& sketch) {
+        std::string buf(sketch.serialize_size(), '\0');
+        size_t size = sketch.serialize((uint8_t*)buf.data());
+        EXPECT_EQ(buf.size(), size);
+        return buf;
+    }
+};
+
+TEST_F(DDSketchTest, Empty) {
+    DDSketch sketch;
+    ASSERT_TRUE(sketch.empty());
+    ASSERT_TRUE(std::isnan(sketch.quantile(0.5)));
+
+    sketch.add(std::nan(""));
+    sketch.add(std::numeric_limits<double>::infinity());
+    ASSERT_TRUE(sketch.empty());
+
+    DDSketch other;
+    ASSERT_TRUE(other.deserialize(serialize(sketch)));
+    ASSERT_TRUE(other.empty());
+}
+
+TEST_F(DDSketchTest, RelativeError) {
+    std::mt19937_64 rng(0);
+    std::lognormal_distribution<double> dist(0, 2);
+    std::vector<double> values(100000);
+    for (auto& value : values) {
+        value = dist(rng);
+        if (rng() % 10 == 0) {
+            value = -value;
+        } else if (rng() % 50 == 0) {
+            value = 0;
+        }
+    }
+    DDSketch sketch;
+    sketch.add_batch(values.data(), values.size());
+    ASSERT_EQ(values.size(), sketch.count());
+
+    std::sort(values.begin(), values.end());
+    for (int i = 0; i <= 100; i++) {
+        double q = i / 100.0;
+        double expected = values[static_cast<size_t>(q * (values.size() - 1))];
+        double actual = sketch.quantile(q);
+        ASSERT_LE(std::fabs(actual - expected), std::fabs(expected) * (DDSketch::kRelativeAccuracy + 1e-9)) << q;
+    }
+    ASSERT_GE(sketch.quantile(0), values.front());
+    ASSERT_LE(sketch.quantile(1), values.back());
+}
+
+TEST_F(DDSketchTest, DeterministicMerge) {
+    std::mt19937_64 rng(1);
+    std::uniform_real_distribution<double> dist(-100, 1000);
+    std::vector<DDSketch> sketches(10);
+    DDSketch expected;
+    for (auto& sketch : sketches) {
+        for (int i = 0; i < 1000; i++) {
+            double value = dist(rng);
+            sketch.add(value);
+            expected.add(value);
+        }
+    }
+
+    DDSketch forward;
+    for (const auto& sketch : sketches) {
+        forward.merge(sketch);
+    }
+    DDSketch backward;
+    for (auto iter = sketches.rbegin(); iter != sketches.rend(); ++iter) {
+        backward.merge(*iter);
+    }
+    ASSERT_EQ(serialize(expected), serialize(forward));
+    ASSERT_EQ(serialize(expected), serialize(backward));
+}
+
+TEST_F(DDSketchTest, CollapseLowestBuckets) {
+    // the values span far more than kMaxNumBuckets buckets
+    std::vector<double> values;
+    for (int i = 0; i < 5000; i++) {
+        values.push_back(std::pow(10.0, i * 0.1 - 200));
+    }
+    DDSketch ascending;
+    ascending.add_batch(values.data(), values.size());
+    DDSketch descending;
+    for (auto iter = values.rbegin(); iter != values.rend(); ++iter) {
+        descending.add(*iter);
+    }
+    ASSERT_EQ(serialize(ascending), serialize(descending));
+    // the high quantiles are still accurate
+    ASSERT_NEAR(values[4949], ascending.quantile(0.99), values[4949] * DDSketch::kRelativeAccuracy);
+    ASSERT_LT(serialize(ascending).size(), DDSketch::kMaxNumBuckets * 4);
+}
+
+TEST_F(DDSketchTest, Serialize) {
+    DDSketch sketch;
+    for (int i = -1000; i <= 1000; i++) {
+        sketch.add(i * 0.5);
+    }
+    std::string buf = serialize(sketch);
+    DDSketch other;
+    ASSERT_TRUE(other.deserialize(buf));
+    ASSERT_EQ(sketch.count(), other.count());
+    ASSERT_EQ(buf, serialize(other));
+    for (double q : {0.0, 0.01, 0.5, 0.99, 1.0}) {
+        ASSERT_EQ(sketch.quantile(q), other.quantile(q));
+    }
+
+    // corrupted
+    ASSERT_FALSE(DDSketch().deserialize(Slice(buf.data(), buf.size() - 1)));
+    ASSERT_FALSE(DDSketch().deserialize(buf + "x"));
+    buf[0] = 0;
+    ASSERT_FALSE(DDSketch().deserialize(buf));
+}
+
+} // namespace starrocks
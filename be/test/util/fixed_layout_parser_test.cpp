@@ -0,0 +1,126 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "util/fixed_layout_parser.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "runtime/time_types.h"
+#include "util/string_parser.hpp"
+
+namespace starrocks {
+
+template <typename T>
+static void check_same_as_string_parser(const std::string& s) {
+    T value = 0;
+    bool ok = FixedLayoutParser::parse_int(s.data(), s.size(), &value);
+    StringParser::ParseResult result;
+    T expected = StringParser::string_to_int<T>(s.data(), s.size(), &result);
+    if (ok) {
+        ASSERT_EQ(StringParser::PARSE_SUCCESS, result) << s;
+        ASSERT_TRUE(expected == value) << s;
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(FixedLayoutParserTest, test_parse_int) {
+    int64_t value = 0;
+    ASSERT_TRUE(FixedLayoutParser::parse_int("0", 1, &value));
+    ASSERT_EQ(0, value);
+    ASSERT_TRUE(FixedLayoutParser::parse_int("-12345678", 9, &value));
+    ASSERT_EQ(-12345678, value);
+    ASSERT_TRUE(FixedLayoutParser::parse_int("+1234567890123", 14, &value));
+    ASSERT_EQ(1234567890123L, value);
+    ASSERT_TRUE(FixedLayoutParser::parse_int("9223372036854775807", 19, &value));
+    ASSERT_EQ(INT64_MAX, value);
+    ASSERT_TRUE(FixedLayoutParser::parse_int("-9223372036854775808", 20, &value));
+    ASSERT_EQ(INT64_MIN, value);
+
+    ASSERT_FALSE(FixedLayoutParser::parse_int("9223372036854775808", 19, &value));
+    ASSERT_FALSE(FixedLayoutParser::parse_int("12345678901234567890", 20, &value));
+    ASSERT_FALSE(FixedLayoutParser::parse_int("", 0, &value));
+    ASSERT_FALSE(FixedLayoutParser::parse_int("-", 1, &value));
+    ASSERT_FALSE(FixedLayoutParser::parse_int(" 1", 2, &value));
+    ASSERT_FALSE(FixedLayoutParser::parse_int("1 ", 2, &value));
+    ASSERT_FALSE(FixedLayoutParser::parse_int("12a45678", 8, &value));
+    ASSERT_FALSE(FixedLayoutParser::parse_int("1.5", 3, &value));
+
+    int8_t tiny = 0;
+    ASSERT_TRUE(FixedLayoutParser::parse_int("-128", 4, &tiny));
+    ASSERT_EQ(-128, tiny);
+    ASSERT_FALSE(FixedLayoutParser::parse_int("128", 3, &tiny));
+
+    std::vector<std::string> inputs = {"1",         "-1",          "+0",       "007",       "127",
+                                       "-129",      "32767",       "32768",    "2147483647", "-2147483649",
+                                       "99999999",  "100000000",   "-0000001", "1:2",        "/0123456",
+                                       "12345678901234567", "9` "};
+    for (const auto& s : inputs) {
+        check_same_as_string_parser<int8_t>(s);
+        check_same_as_string_parser<int16_t>(s);
+        check_same_as_string_parser<int32_t>(s);
+        check_same_as_string_parser<int64_t>(s);
+        check_same_as_string_parser<__int128>(s);
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(FixedLayoutParserTest, test_parse_date_time) {
+    int year, month, day, hour, minute, second, microsecond;
+    ASSERT_TRUE(FixedLayoutParser::parse_date("2023-09-28", &year, &month, &day));
+    ASSERT_EQ(2023, year);
+    ASSERT_EQ(9, month);
+    ASSERT_EQ(28, day);
+    ASSERT_TRUE(FixedLayoutParser::parse_date("0001/12/31", &year, &month, &day));
+    ASSERT_EQ(1, year);
+    ASSERT_EQ(12, month);
+    ASSERT_EQ(31, day);
+    ASSERT_FALSE(FixedLayoutParser::parse_date("2023009-28", &year, &month, &day));
+    ASSERT_FALSE(FixedLayoutParser::parse_date("2023-0a-28", &year, &month, &day));
+    ASSERT_FALSE(FixedLayoutParser::parse_date("2023-09-2 ", &year, &month, &day));
+
+    ASSERT_TRUE(FixedLayoutParser::parse_time("23:59:08", &hour, &minute, &second));
+    ASSERT_EQ(23, hour);
+    ASSERT_EQ(59, minute);
+    ASSERT_EQ(8, second);
+    ASSERT_FALSE(FixedLayoutParser::parse_time("23:5908", &hour, &minute, &second));
+
+    ASSERT_TRUE(FixedLayoutParser::parse_microsecond("5", 1, &microsecond));
+    ASSERT_EQ(500000, microsecond);
+    ASSERT_TRUE(FixedLayoutParser::parse_microsecond("000123", 6, &microsecond));
+    ASSERT_EQ(123, microsecond);
+    ASSERT_FALSE(FixedLayoutParser::parse_microsecond("1234567", 7, &microsecond));
+    ASSERT_FALSE(FixedLayoutParser::parse_microsecond("12a", 3, &microsecond));
+
+    // The fraction is parsed the same as the uncommon approach.
+    for (std::string s : {"2023-09-28 12:34:56.5", "2023-09-28T12:34:56.000123", "2023-09-28 12:34:56.123456"}) {
+        int expected[7];
+        ASSERT_TRUE(date::from_string(s.data(), s.size(), &expected[0], &expected[1], &expected[2], &expected[3],
+                                      &expected[4], &expected[5], &expected[6]));
+        ASSERT_TRUE(date::from_string_to_datetime(s.data(), s.size(), &year, &month, &day, &hour, &minute, &second,
+                                                  &microsecond));
+        ASSERT_EQ(expected[0], year);
+        ASSERT_EQ(expected[1], month);
+        ASSERT_EQ(expected[2], day);
+        ASSERT_EQ(expected[3], hour);
+        ASSERT_EQ(expected[4], minute);
+        ASSERT_EQ(expected[5], second);
+        ASSERT_EQ(expected[6], microsecond);
+    }
+}
+
+} // namespace starrocks
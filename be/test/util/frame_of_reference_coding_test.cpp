@@ -19,6 +19,8 @@
 
 #include <gtest/gtest.h>
 
+#include <random>
+
 namespace starrocks {
 class TestForCoding : public testing::Test {
 public:
@@ -243,4 +245,49 @@ TEST_F(TestForCoding, TestValueSeek) {
     ASSERT_EQ(found, false);
 }
 
+TEST_F(TestForCoding, TestAllBitWidths) {
+    std::mt19937_64 rng(0);
+    for (int bit_width = 0; bit_width < 64; ++bit_width) {
+        faststring buffer(1);
+        ForEncoder<int64_t> encoder(&buffer);
+
+        // Random values in [0, 2^bit_width) are not ascending, so each frame stores value - min.
+        std::vector<int64_t> data;
+        for (int64_t i = 0; i < 300; ++i) {
+            data.push_back(bit_width == 0 ? 0 : static_cast<int64_t>(rng() >> (64 - bit_width)));
+        }
+        encoder.put_batch(data.data(), data.size());
+        encoder.flush();
+
+        ForDecoder<int64_t> decoder(buffer.data(), buffer.length());
+        decoder.init();
+        std::vector<int64_t> actual_result(data.size());
+        ASSERT_TRUE(decoder.get_batch(actual_result.data(), data.size()));
+        ASSERT_EQ(data, actual_result) << "bit_width: " << bit_width;
+    }
+}
+
+TEST_F(TestForCoding, TestSkipBackAfterBatch) {
+    faststring buffer(1);
+    ForEncoder<int32_t> encoder(&buffer);
+
+    std::vector<int32_t> data;
+    for (int32_t i = 0; i < 512; ++i) {
+        data.push_back(i * 3);
+    }
+    encoder.put_batch(data.data(), data.size());
+    encoder.flush();
+
+    ForDecoder<int32_t> decoder(buffer.data(), buffer.length());
+    decoder.init();
+    // The second and third frames are decoded into the output directly.
+    std::vector<int32_t> actual_result(384);
+    ASSERT_TRUE(decoder.get_batch(actual_result.data(), 384));
+    // Skip back to the third frame, which must be decoded again.
+    ASSERT_TRUE(decoder.skip(-100));
+    int32_t value;
+    ASSERT_TRUE(decoder.get(&value));
+    ASSERT_EQ(284 * 3, value);
+}
+
 } // namespace starrocks
@@ -0,0 +1,108 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "util/fsst.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace starrocks {
+
+static std::vector<std::string> gen_urls(size_t n) {
+    const char* hosts[] = {"www.example.com", "api.starrocks.io", "cdn.images.net", "mail.google.com"};
+    std::vector<std::string> urls;
+    for (size_t i = 0; i < n; i++) {
+        urls.push_back(std::string("https://") + hosts[i % 4] + "/path/" + std::to_string(i * 7919 % 100000) +
+                       "/index.html?id=" + std::to_string(i));
+    }
+    return urls;
+}
+
+static std::string roundtrip(const FsstSymbolTable& table, const std::string& value) {
+    faststring codes;
+    table.compress(Slice(value), &codes);
+    EXPECT_LE(codes.size(), value.size() * 2);
+    std::string res(FsstSymbolTable::decompress_bound(codes.size()), '\0');
+    res.resize(table.decompress(codes.data(), codes.size(), reinterpret_cast<uint8_t*>(res.data())));
+    return res;
+}
+
+TEST(FsstTest, TestCompressDecompress) {
+    auto urls = gen_urls(10000);
+    std::vector<Slice> samples(urls.begin(), urls.end());
+    auto table = FsstSymbolTable::build(samples);
+    ASSERT_GT(table.num_symbols(), 0);
+
+    size_t raw_size = 0;
+    size_t compressed_size = 0;
+    for (const auto& url : urls) {
+        faststring codes;
+        table.compress(Slice(url), &codes);
+        raw_size += url.size();
+        compressed_size += codes.size();
+        ASSERT_EQ(url, roundtrip(table, url));
+    }
+    ASSERT_LT(compressed_size * 2, raw_size);
+
+    // Values not seen by the table are escaped.
+    std::string binary("\xff\x00\x01\x02zzzzzz", 10);
+    ASSERT_EQ(binary, roundtrip(table, binary));
+    ASSERT_EQ("", roundtrip(table, ""));
+}
+
+TEST(FsstTest, TestSerialize) {
+    auto urls = gen_urls(1000);
+    std::vector<Slice> samples(urls.begin(), urls.end());
+    auto table = FsstSymbolTable::build(samples);
+    faststring buf;
+    table.serialize(&buf);
+    buf.append("tail", 4);
+
+    FsstSymbolTable table2;
+    size_t consumed = 0;
+    ASSERT_TRUE(table2.deserialize(buf.data(), buf.size(), &consumed).ok());
+    ASSERT_EQ(buf.size() - 4, consumed);
+    ASSERT_EQ(table.num_symbols(), table2.num_symbols());
+    for (const auto& url : urls) {
+        faststring codes;
+        table.compress(Slice(url), &codes);
+        faststring codes2;
+        table2.compress(Slice(url), &codes2);
+        ASSERT_EQ(codes.size(), codes2.size());
+        ASSERT_EQ(0, memcmp(codes.data(), codes2.data(), codes.size()));
+    }
+
+    ASSERT_FALSE(table2.deserialize(buf.data(), 2, &consumed).ok());
+}
+
+TEST(FsstTest, TestStartsWith) {
+    auto urls = gen_urls(1000);
+    std::vector<Slice> samples(urls.begin(), urls.end());
+    auto table = FsstSymbolTable::build(samples);
+    for (const auto& url : urls) {
+        faststring codes;
+        table.compress(Slice(url), &codes);
+        for (size_t len : {size_t(0), size_t(1), size_t(5), url.size() / 2, url.size()}) {
+            ASSERT_TRUE(table.starts_with(codes.data(), codes.size(), Slice(url.data(), len)));
+        }
+        std::string longer = url + "x";
+        ASSERT_FALSE(table.starts_with(codes.data(), codes.size(), Slice(longer)));
+        std::string other = url.substr(0, 10) + "#";
+        ASSERT_FALSE(table.starts_with(codes.data(), codes.size(), Slice(other)));
+    }
+}
+
+} // namespace starrocks
@@ -0,0 +1,57 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "util/latency_histogram.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+
+#include "testutil/parallel_test.h"
+
+namespace starrocks {
+
+PARALLEL_TEST(LatencyHistogramTest, bucket_of) {
+    ASSERT_EQ(0, LatencyHistogram::bucket_of(0));
+    ASSERT_EQ(0, LatencyHistogram::bucket_of(10'000));
+    ASSERT_EQ(1, LatencyHistogram::bucket_of(10'001));
+    ASSERT_EQ(2, LatencyHistogram::bucket_of(1'000'000));
+    ASSERT_EQ(5, LatencyHistogram::bucket_of(1'000'000'000));
+    ASSERT_EQ(6, LatencyHistogram::bucket_of(1'000'000'001));
+    ASSERT_EQ(6, LatencyHistogram::bucket_of(std::numeric_limits<int64_t>::max()));
+}
+
+PARALLEL_TEST(LatencyHistogramTest, add_and_merge) {
+    LatencyHistogram hist;
+    ASSERT_EQ(0, hist.total_count());
+    ASSERT_EQ("", hist.to_string());
+
+    hist.add(1'000);
+    hist.add(5'000);
+    hist.add(500'000);
+    hist.add(2'000'000'000);
+    ASSERT_EQ(4, hist.total_count());
+    ASSERT_EQ(2, hist.count(0));
+    ASSERT_EQ(1, hist.count(2));
+    ASSERT_EQ(1, hist.count(6));
+    ASSERT_EQ("<=10us:2, <=1ms:1, <=+Inf:1", hist.to_string());
+
+    LatencyHistogram other;
+    other.add(50'000'000);
+    other.merge(hist);
+    ASSERT_EQ(5, other.total_count());
+    ASSERT_EQ("<=10us:2, <=1ms:1, <=100ms:1, <=+Inf:1", other.to_string());
+}
+
+} // namespace starrocks
@@ -239,6 +239,122 @@ static void insert_LRUCache(LRUCache& cache, const CacheKey& key, int value, Cac
     cache.release(cache.insert(key, hash, EncodeValue(value), value, &deleter, priority));
 }
 
+TEST_F(CacheTest, SegmentedLRUScanResistance) {
+    delete _cache;
+    _cache = new_lru_cache(kCacheSize, 0.5);
+
+    Insert(100, 101, 1);
+    ASSERT_EQ(101, Lookup(100));
+    Insert(200, 201, 1);
+
+    // Entries touched only once are evicted from probation segment, the hot entry is kept in protected segment
+    for (int i = 0; i < kCacheSize * 2; i++) {
+        Insert(1000 + i, 2000 + i, 1);
+    }
+    ASSERT_EQ(101, Lookup(100));
+    ASSERT_EQ(-1, Lookup(200));
+}
+
+TEST_F(CacheTest, SegmentedLRUDemoteProtected) {
+    LRUCache cache;
+    cache.set_capacity(10);
+    cache.set_protected_ratio(0.5);
+    std::vector<int> deleted;
+    auto insert = [&](int key) {
+        std::string result;
+        CacheKey k = EncodeKey(&result, key);
+        cache.release(cache.insert(k, k.hash(k.data(), k.size(), 0), EncodeValue(key), 1, &deleter));
+    };
+    auto lookup = [&](int key) {
+        std::string result;
+        CacheKey k = EncodeKey(&result, key);
+        Cache::Handle* h = cache.lookup(k, k.hash(k.data(), k.size(), 0));
+        int r = h == nullptr ? -1 : DecodeValue(reinterpret_cast<LRUHandle*>(h)->value);
+        cache.release(h);
+        return r;
+    };
+
+    // Promote 0..7, only the newest 5 are kept in protected segment, the others are demoted to probation
+    for (int i = 0; i < 8; i++) {
+        insert(i);
+        ASSERT_EQ(i, lookup(i));
+    }
+    ASSERT_EQ(8, cache.get_usage());
+    for (int i = 100; i < 120; i++) {
+        insert(i);
+    }
+    ASSERT_EQ(10, cache.get_usage());
+    for (int i = 0; i < 3; i++) {
+        ASSERT_EQ(-1, lookup(i));
+    }
+    for (int i = 3; i < 8; i++) {
+        ASSERT_EQ(i, lookup(i));
+    }
+    ASSERT_EQ(10, cache.prune());
+    ASSERT_EQ(0, cache.get_usage());
+}
+
+TEST_F(CacheTest, OwnerQuota) {
+    LRUCache cache;
+    cache.set_capacity(100);
+    auto insert = [&](int key, int64_t owner) {
+        std::string result;
+        CacheKey k = EncodeKey(&result, key);
+        cache.release(cache.insert(k, k.hash(k.data(), k.size(), 0), EncodeValue(key), 1,
+                                   [](const CacheKey& key, void* v) {}, CachePriority::NORMAL, owner));
+    };
+    auto lookup = [&](int key, int64_t owner) {
+        std::string result;
+        CacheKey k = EncodeKey(&result, key);
+        Cache::Handle* h = cache.lookup(k, k.hash(k.data(), k.size(), 0), owner);
+        int r = h == nullptr ? -1 : DecodeValue(reinterpret_cast<LRUHandle*>(h)->value);
+        cache.release(h);
+        return r;
+    };
+
+    // The reserved entries are not evicted by the others
+    cache.set_owner_quota(1, 0.5, 0);
+    for (int i = 0; i < 100; i++) {
+        insert(i, 2);
+    }
+    for (int i = 200; i < 240; i++) {
+        insert(i, 1);
+    }
+    for (int i = 100; i < 200; i++) {
+        insert(i, 2);
+    }
+    ASSERT_EQ(40, cache.get_owner_stats(1).usage);
+    ASSERT_EQ(60, cache.get_owner_stats(2).usage);
+    for (int i = 200; i < 240; i++) {
+        ASSERT_EQ(i, lookup(i, 1));
+    }
+    ASSERT_EQ(-1, lookup(0, 1));
+    ASSERT_EQ(41, cache.get_owner_stats(1).lookup_count);
+    ASSERT_EQ(40, cache.get_owner_stats(1).hit_count);
+
+    // The entries borrowing the capacity beyond the reservation can be evicted
+    for (int i = 240; i < 300; i++) {
+        insert(i, 1);
+    }
+    ASSERT_EQ(100, cache.get_owner_stats(1).usage);
+    for (int i = 300; i < 400; i++) {
+        insert(i, 2);
+    }
+    ASSERT_EQ(50, cache.get_owner_stats(1).usage);
+    ASSERT_EQ(50, cache.get_owner_stats(2).usage);
+
+    // The usage never exceeds the limit
+    cache.set_owner_quota(2, 0, 0.2);
+    ASSERT_EQ(20, cache.get_owner_stats(2).usage);
+    for (int i = 400; i < 500; i++) {
+        insert(i, 2);
+    }
+    ASSERT_EQ(20, cache.get_owner_stats(2).usage);
+    ASSERT_EQ(499, lookup(499, 2));
+    ASSERT_EQ(-1, lookup(479, 2));
+    ASSERT_EQ(70, cache.get_usage());
+}
+
 TEST_F(CacheTest, Usage) {
     LRUCache cache;
     cache.set_capacity(1000);
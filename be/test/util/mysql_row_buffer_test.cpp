@@ -14,6 +14,7 @@
 
 #include "util/mysql_row_buffer.h"
 
+#include <limits>
 #include <optional>
 
 #include "gtest/gtest.h"
@@ -411,4 +412,55 @@ TEST_F(MysqlRowBufferTest, test_array) {
     }
 }
 
+// NOLINTNEXTLINE
+TEST_F(MysqlRowBufferTest, test_push_column) {
+    // numbers
+    {
+        std::vector<int64_t> data{0, -1, 123456789, std::numeric_limits<int64_t>::min(), 7};
+        std::vector<uint8_t> nulls{0, 0, 1, 0, 0};
+        MysqlRowBuffer expected;
+        for (size_t i = 0; i < data.size(); i++) {
+            nulls[i] ? expected.push_null() : expected.push_bigint(data[i]);
+        }
+        MysqlRowBuffer row_buffer;
+        std::vector<size_t> offsets;
+        row_buffer.push_number_column(data.data(), nulls.data(), data.size(), &offsets);
+        ASSERT_EQ(expected.data(), row_buffer.data());
+        ASSERT_EQ(data.size(), offsets.size());
+        ASSERT_EQ(row_buffer.length(), offsets.back());
+        ASSERT_EQ(offsets[1] + 1, offsets[2]);
+    }
+    {
+        std::vector<double> data{0.1, -3.5, 1e100};
+        MysqlRowBuffer expected;
+        for (double v : data) {
+            expected.push_double(v);
+        }
+        MysqlRowBuffer row_buffer;
+        std::vector<size_t> offsets;
+        row_buffer.push_number_column(data.data(), nullptr, data.size(), &offsets);
+        ASSERT_EQ(expected.data(), row_buffer.data());
+    }
+    // strings, including the one of 3 bytes length
+    {
+        std::vector<std::string> strs{"", "abc", std::string(300, 'x'), "null"};
+        std::string bytes;
+        std::vector<uint32_t> str_offsets{0};
+        MysqlRowBuffer expected;
+        for (const auto& str : strs) {
+            bytes += str;
+            str_offsets.push_back(bytes.size());
+            expected.push_string(str.data(), str.size());
+        }
+        MysqlRowBuffer row_buffer;
+        std::vector<size_t> offsets;
+        row_buffer.push_string_column(reinterpret_cast<const uint8_t*>(bytes.data()), str_offsets.data(), nullptr,
+                                      strs.size(), &offsets);
+        ASSERT_EQ(expected.data(), row_buffer.data());
+        ASSERT_EQ(1U, offsets[0]);
+        ASSERT_EQ(5U, offsets[1]);
+        ASSERT_EQ(row_buffer.length(), offsets.back());
+    }
+}
+
 } // namespace starrocks
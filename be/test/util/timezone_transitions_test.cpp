@@ -0,0 +1,92 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "util/timezone_transitions.h"
+
+#include <gtest/gtest.h>
+
+#include "cctz/civil_time.h"
+
+namespace starrocks {
+
+static int64_t to_cctz_local(const cctz::time_zone& ctz, int64_t utc) {
+    auto cs = cctz::convert(cctz::time_point<cctz::seconds>(cctz::seconds(utc)), ctz);
+    return cs - cctz::civil_second(1970, 1, 1, 0, 0, 0);
+}
+
+static int64_t to_cctz_utc(const cctz::time_zone& ctz, int64_t local) {
+    return cctz::convert(cctz::civil_second(1970, 1, 1, 0, 0, 0) + local, ctz).time_since_epoch().count();
+}
+
+// NOLINTNEXTLINE
+TEST(TimezoneTransitionsTest, same_as_cctz) {
+    for (const char* name : {"America/New_York", "Europe/London", "Asia/Shanghai", "Australia/Lord_Howe"}) {
+        cctz::time_zone ctz;
+        ASSERT_TRUE(cctz::load_time_zone(name, &ctz));
+        TimezoneTransitions transitions(ctz);
+        ASSERT_GT(transitions.num_transitions(), 0);
+
+        // the seconds around the transitions, including the skipped and the repeated civil times
+        auto tp = cctz::time_point<cctz::seconds>(cctz::seconds(TimezoneTransitions::kMinSeconds));
+        cctz::time_zone::civil_transition transition;
+        while (ctz.next_transition(tp, &transition)) {
+            tp = ctz.lookup(transition.to).trans;
+            int64_t t = tp.time_since_epoch().count();
+            if (t >= TimezoneTransitions::kMaxSeconds) {
+                break;
+            }
+            for (int64_t s = t - 7200; s < t + 7200; s += 61) {
+                ASSERT_EQ(to_cctz_local(ctz, s), s + transitions.utc_offset(s)) << name << " " << s;
+                ASSERT_EQ(to_cctz_utc(ctz, s), transitions.to_utc(s)) << name << " " << s;
+            }
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(TimezoneTransitionsTest, same_offset) {
+    cctz::time_zone ctz;
+    ASSERT_TRUE(cctz::load_time_zone("America/New_York", &ctz));
+    TimezoneTransitions transitions(ctz);
+
+    // 2023-03-12 02:00:00 EST -> 03:00:00 EDT, 2023-11-05 02:00:00 EDT -> 01:00:00 EST
+    int64_t spring = 1678604400;
+    int64_t fall = 1699164000;
+    ASSERT_TRUE(transitions.same_utc_offset(spring, fall - 1));
+    ASSERT_FALSE(transitions.same_utc_offset(spring - 1, spring));
+    ASSERT_EQ(-4 * 3600, transitions.utc_offset(spring));
+    ASSERT_EQ(-5 * 3600, transitions.utc_offset(fall));
+
+    int64_t local_spring = spring - 5 * 3600;
+    ASSERT_TRUE(transitions.same_local_offset(local_spring - 3600, local_spring - 1));
+    // the skipped civil times
+    ASSERT_FALSE(transitions.same_local_offset(local_spring - 1, local_spring));
+    ASSERT_FALSE(transitions.same_local_offset(local_spring, local_spring + 1));
+    ASSERT_EQ(spring, transitions.to_utc(local_spring + 1800));
+    ASSERT_TRUE(transitions.same_local_offset(local_spring + 3600, local_spring + 7200));
+
+    // the repeated civil times use the offset before the transition
+    int64_t local_fall = fall - 4 * 3600;
+    ASSERT_FALSE(transitions.same_local_offset(local_fall - 3600, local_fall - 1));
+    ASSERT_EQ(fall - 1800, transitions.to_utc(local_fall - 1800));
+
+    cctz::time_zone utc = cctz::utc_time_zone();
+    TimezoneTransitions utc_transitions(utc);
+    ASSERT_EQ(0, utc_transitions.num_transitions());
+    ASSERT_TRUE(utc_transitions.same_local_offset(TimezoneTransitions::kMinSeconds, TimezoneTransitions::kMaxSeconds));
+    ASSERT_EQ(12345, utc_transitions.to_utc(12345));
+}
+
+} // namespace starrocks
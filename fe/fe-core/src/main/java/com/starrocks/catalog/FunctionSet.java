@@ -229,6 +229,9 @@ public class FunctionSet {
     public static final String MIN = "min";
     public static final String PERCENTILE_APPROX = "percentile_approx";
     public static final String PERCENTILE_CONT = "percentile_cont";
+    public static final String PERCENTILE_DDSKETCH = "percentile_ddsketch";
+    public static final String DDSKETCH_STATE = "ddsketch_state";
+    public static final String DDSKETCH_UNION = "ddsketch_union";
     public static final String RETENTION = "retention";
     public static final String STDDEV = "stddev";
     public static final String STDDEV_POP = "stddev_pop";
@@ -1080,6 +1083,17 @@ public class FunctionSet {
                 Lists.newArrayList(Type.PERCENTILE), Type.PERCENTILE, Type.PERCENTILE,
                 false, false, false));
 
+        // DDSketch
+        addBuiltin(AggregateFunction.createBuiltin(PERCENTILE_DDSKETCH,
+                Lists.newArrayList(Type.DOUBLE, Type.DOUBLE), Type.DOUBLE, Type.VARBINARY,
+                false, false, false));
+        addBuiltin(AggregateFunction.createBuiltin(DDSKETCH_STATE,
+                Lists.newArrayList(Type.DOUBLE), Type.VARBINARY, Type.VARBINARY,
+                false, false, false));
+        addBuiltin(AggregateFunction.createBuiltin(DDSKETCH_UNION,
+                Lists.newArrayList(Type.VARBINARY), Type.VARBINARY, Type.VARBINARY,
+                false, false, false));
+
         // PercentileCont
         addBuiltin(AggregateFunction.createBuiltin(FunctionSet.PERCENTILE_CONT,
                 Lists.newArrayList(Type.DATE, Type.DOUBLE), Type.DATE, Type.VARBINARY,
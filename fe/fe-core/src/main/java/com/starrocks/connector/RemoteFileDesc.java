@@ -31,6 +31,8 @@ public class RemoteFileDesc {
     private boolean splittable;
     private TextFileFormatDesc textFileFormatDesc;
     private ImmutableList<String> hudiDeltaLogs;
+    // 0 if unknown
+    private long modificationTime;
 
     // Only this single RemoteFileDesc instance is used to record all iceberg scanTask
     // to reduce the memory usage of RemoteFileInfo
@@ -83,6 +85,15 @@ public class RemoteFileDesc {
         return this;
     }
 
+    public long getModificationTime() {
+        return modificationTime;
+    }
+
+    public RemoteFileDesc setModificationTime(long modificationTime) {
+        this.modificationTime = modificationTime;
+        return this;
+    }
+
     public ImmutableList<String> getHudiDeltaLogs() {
         return hudiDeltaLogs;
     }
@@ -101,6 +112,7 @@ public class RemoteFileDesc {
         sb.append(", splittable=").append(splittable);
         sb.append(", textFileFormatDesc=").append(textFileFormatDesc);
         sb.append(", hudiDeltaLogs=").append(hudiDeltaLogs);
+        sb.append(", modificationTime=").append(modificationTime);
         sb.append('}');
         return sb.toString();
     }
@@ -355,6 +355,13 @@ public class FunctionAnalyzer {
             }
         }
 
+        if (fnName.getFunction().equals(FunctionSet.PERCENTILE_DDSKETCH)) {
+            if (!functionCallExpr.getChild(1).isConstant()) {
+                throw new SemanticException("percentile_ddsketch requires second parameter must be a constant : "
+                        + functionCallExpr.toSql(), functionCallExpr.getChild(1).getPos());
+            }
+        }
+
         if (fnName.getFunction().equals(FunctionSet.EXCHANGE_BYTES) ||
                 fnName.getFunction().equals(FunctionSet.EXCHANGE_SPEED)) {
             if (ConnectContext.get().getSessionVariable().getNewPlannerAggStage() != 1) {
@@ -621,6 +621,7 @@ vectorized_functions = [
     [130000, 'percentile_hash', 'PERCENTILE', ['DOUBLE'], 'PercentileFunctions::percentile_hash'],
     [130001, 'percentile_empty', 'PERCENTILE', [], 'PercentileFunctions::percentile_empty'],
     [130002, 'percentile_approx_raw', 'DOUBLE', ['PERCENTILE', 'DOUBLE'], 'PercentileFunctions::percentile_approx_raw'],
+    [130003, 'ddsketch_quantile', 'DOUBLE', ['VARBINARY', 'DOUBLE'], 'PercentileFunctions::ddsketch_quantile'],
 
     [140000, 'grouping_id', 'BIGINT', ['BIGINT'], 'GroupingSetsFunctions::grouping_id'],
     [140001, 'grouping', 'BIGINT', ['BIGINT'], 'GroupingSetsFunctions::grouping'],
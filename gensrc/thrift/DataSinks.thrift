@@ -57,7 +57,8 @@ enum TResultSinkType {
     MYSQL_PROTOCAL,
     FILE,
     STATISTIC,
-    VARIABLE
+    VARIABLE,
+    ARROW
 }
 
 struct TParquetOptions {
@@ -105,6 +106,17 @@ struct TPlanFragmentDestination {
 // Sink which forwards data to a remote plan fragment,
 // according to the given output partition specification
 // (ie, the m:1 part of an m:n data stream)
+// How a hash partitioned stream sink sends the rows of the skewed partition keys, it's used by the shuffle join
+// whose probe side has heavy hitter keys, and only valid for the joins preserving the probe rows, i.e. inner,
+// left outer, left semi and left anti join.
+enum TSkewShuffleMode {
+  // Send the rows of the skewed keys to all the destinations, used by the build side.
+  BROADCAST,
+  // Keep the rows of the skewed keys in the local destinations, or spread them over all the destinations
+  // if there is no local one, used by the probe side.
+  SPREAD
+}
+
 struct TDataStreamSink {
   // destination node id
   1: required Types.TPlanNodeId dest_node_id
@@ -129,6 +141,12 @@ struct TDataStreamSink {
 
   // Specify the columns which need to send
   6: optional list<i32> output_columns;
+
+  // Only useful in pipeline mode with HASH_PARTITIONED output partition.
+  // Each element of skew_values is a skewed key, which consists of one literal per partition expr
+  // of the same type.
+  7: optional TSkewShuffleMode skew_shuffle_mode
+  8: optional list<list<Exprs.TExpr>> skew_values
 }
 
 struct TMultiCastDataStreamSink {
@@ -82,6 +82,8 @@ enum TExprNodeType {
   MAP_ELEMENT_EXPR,
   BINARY_LITERAL,
   MAP_EXPR,
+  // Only created by BE, see FusedArithmeticExpr.
+  FUSED_EXPR,
 }
 
 //enum TAggregationOp {
@@ -179,6 +179,9 @@ struct TQueryOptions {
   75: optional i64 spill_operator_min_bytes;
   76: optional TSpillMode spill_mode;
 
+  // read the segment data of the olap scans with O_DIRECT
+  77: optional bool enable_scan_direct_io;
+
 }
 
 
@@ -326,6 +326,9 @@ struct THdfsScanRange {
 
     // number of lines at the start of the file to skip
     12: optional i64 skip_header
+
+    // the modification time of the file, used to identify the cached meta of the file
+    13: optional i64 modification_time
 }
 
 struct TBinlogScanRange {
@@ -547,6 +550,10 @@ struct THashJoinNode {
   52: optional TJoinDistributionMode distribution_mode;
   53: optional list<Exprs.TExpr> partition_exprs
   54: optional list<Types.TSlotId> output_columns
+
+  // The digest of the build side, including the plan of the build side, the build join keys, and the versions of
+  // the scanned tablets. The hash joins of the same digest can share the built hash table across queries.
+  55: optional string build_side_digest
 }
 
 struct TMergeJoinNode {
@@ -119,4 +119,9 @@ struct TRuntimeFilterParams {
   3: optional map<i32, i32> runtime_filter_builder_number
   // if aggregated runtime filter size exceeds it, merge node can stop merging.
   4: optional i64 runtime_filter_max_size;
+  // Runtime filter Id to the merge nodes to which the merged partitioned runtime filters are sent.
+  // It's only set on the intermediate merge nodes of the tree-based merging, each of them merges the
+  // partitioned runtime filters of a range of builders, and runtime_filter_builder_number is the number
+  // of the builders in the range rather than all the builders.
+  5: optional map<i32, list<Types.TNetworkAddress>> id_to_upstream_merge_nodes
 }
@@ -36,6 +36,11 @@ struct TWorkGroup {
   11: optional i64 big_query_mem_limit
   12: optional i64 big_query_scan_rows_limit
   13: optional i64 big_query_cpu_second_limit
+  // the ratios of the page cache capacity reserved for and limited to the workgroup
+  14: optional double page_cache_reserved_ratio
+  15: optional double page_cache_limit_ratio
+  // read the segment data of the scans with O_DIRECT
+  16: optional bool scan_direct_io
 }
 
 enum TWorkGroupOpType {
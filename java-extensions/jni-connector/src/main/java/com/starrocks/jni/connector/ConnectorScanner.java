@@ -15,6 +15,8 @@
 package com.starrocks.jni.connector;
 
 import java.io.IOException;
+import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
 
 /**
  * The parent class of JNI scanner, developers need to inherit this class and implement the following methods:
@@ -40,9 +42,14 @@ import java.io.IOException;
  * }
  * } while (true);
  * close();
+ * <p>
+ * BE may call {@link ConnectorScanner#getNextOffHeapChunk()} in another thread to prefetch the next chunk before the
+ * current one is consumed, then the off-heap tables are released by {@link ConnectorScanner#releaseOffHeapTable(long)}.
  */
 public abstract class ConnectorScanner {
     private OffHeapTable offHeapTable;
+    // the off-heap tables not released yet, keyed by their meta addresses
+    private final Map<Long, OffHeapTable> offHeapTables = new ConcurrentHashMap<>();
     private String[] fields;
     private ColumnType[] types;
     private int tableSize;
@@ -103,7 +110,9 @@ public abstract class ConnectorScanner {
             releaseOffHeapTable();
             throw e;
         }
-        return finishOffHeapTable(numRows);
+        long metaAddress = finishOffHeapTable(numRows);
+        offHeapTables.put(metaAddress, offHeapTable);
+        return metaAddress;
     }
 
     private void initOffHeapTable() {
@@ -121,7 +130,15 @@ public abstract class ConnectorScanner {
 
     protected void releaseOffHeapTable() {
         if (offHeapTable != null) {
+            offHeapTables.values().remove(offHeapTable);
             offHeapTable.close();
         }
     }
+
+    protected void releaseOffHeapTable(long metaAddress) {
+        OffHeapTable table = offHeapTables.remove(metaAddress);
+        if (table != null) {
+            table.close();
+        }
+    }
 }